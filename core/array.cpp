@@ -27,7 +27,6 @@
 /* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
 /* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
 /*************************************************************************/
-
 #include "array.h"
 
 #include "core/hashfuncs.h"
@@ -35,12 +34,199 @@
 #include "core/variant.h"
 #include "core/vector.h"
 
+//native element storage of typed arrays, so they don't pay for a Variant per element
+struct ArrayPackedStorage {
+
+	virtual int size() const = 0;
+	virtual Error resize(int p_size) = 0;
+	virtual Variant get(int p_idx) const = 0;
+	//values are converted to the element type before getting here
+	virtual void set(int p_idx, const Variant &p_value) = 0;
+	virtual Error insert(int p_pos, const Variant &p_value) = 0;
+	virtual void remove(int p_pos) = 0;
+	virtual void swap(int p_a, int p_b) = 0;
+	virtual int find(const Variant &p_value, int p_from) const = 0;
+	virtual int rfind(const Variant &p_value, int p_from) const = 0;
+	virtual int count(const Variant &p_value) const = 0;
+	virtual void sort() = 0;
+	virtual void invert() = 0;
+	virtual uint32_t hash() const = 0;
+	virtual void unpack(Vector<Variant> &r_array) const = 0;
+	virtual ArrayPackedStorage *duplicate() const = 0;
+
+	virtual ~ArrayPackedStorage() {}
+};
+
+template <class T>
+struct ArrayPackedType;
+
+#define MAKE_ARRAY_PACKED_TYPE(m_type, m_variant_type)            \
+	template <>                                                   \
+	struct ArrayPackedType<m_type> {                              \
+		static const Variant::Type VARIANT_TYPE = m_variant_type; \
+	};
+
+MAKE_ARRAY_PACKED_TYPE(int64_t, Variant::INT)
+MAKE_ARRAY_PACKED_TYPE(double, Variant::FLOAT)
+MAKE_ARRAY_PACKED_TYPE(String, Variant::STRING)
+MAKE_ARRAY_PACKED_TYPE(Vector2, Variant::VECTOR2)
+MAKE_ARRAY_PACKED_TYPE(Vector3, Variant::VECTOR3)
+MAKE_ARRAY_PACKED_TYPE(Color, Variant::COLOR)
+
+template <class T>
+struct ArrayPackedStorageT : public ArrayPackedStorage {
+
+	Vector<T> data;
+
+	virtual int size() const { return data.size(); }
+
+	virtual Error resize(int p_size) {
+
+		int from = data.size();
+		Error err = data.resize(p_size);
+		if (err == OK && p_size > from) {
+			T *w = data.ptrw();
+			for (int i = from; i < p_size; i++) {
+				w[i] = T();
+			}
+		}
+		return err;
+	}
+
+	virtual Variant get(int p_idx) const { return data[p_idx]; }
+	virtual void set(int p_idx, const Variant &p_value) { data.write[p_idx] = p_value; }
+	virtual Error insert(int p_pos, const Variant &p_value) { return data.insert(p_pos, p_value); }
+	virtual void remove(int p_pos) { data.remove(p_pos); }
+
+	virtual void swap(int p_a, int p_b) {
+
+		T *w = data.ptrw();
+		SWAP(w[p_a], w[p_b]);
+	}
+
+	//Variant equality never matches values of different types, so neither does this
+
+	virtual int find(const Variant &p_value, int p_from) const {
+
+		if (p_value.get_type() != ArrayPackedType<T>::VARIANT_TYPE) {
+			return -1;
+		}
+		return data.find(p_value, p_from);
+	}
+
+	virtual int rfind(const Variant &p_value, int p_from) const {
+
+		if (p_value.get_type() != ArrayPackedType<T>::VARIANT_TYPE) {
+			return -1;
+		}
+		T value = p_value;
+		for (int i = p_from; i >= 0; i--) {
+			if (data[i] == value) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	virtual int count(const Variant &p_value) const {
+
+		if (p_value.get_type() != ArrayPackedType<T>::VARIANT_TYPE) {
+			return 0;
+		}
+		T value = p_value;
+		int amount = 0;
+		for (int i = 0; i < data.size(); i++) {
+			if (data[i] == value) {
+				amount++;
+			}
+		}
+		return amount;
+	}
+
+	virtual void sort() { data.sort(); }
+	virtual void invert() { data.invert(); }
+
+	virtual uint32_t hash() const {
+
+		uint32_t h = hash_djb2_one_32(0);
+		for (int i = 0; i < data.size(); i++) {
+			h = hash_djb2_one_32(Variant(data[i]).hash(), h);
+		}
+		return h;
+	}
+
+	virtual void unpack(Vector<Variant> &r_array) const {
+
+		r_array.resize(data.size());
+		Variant *w = r_array.ptrw();
+		for (int i = 0; i < data.size(); i++) {
+			w[i] = data[i];
+		}
+	}
+
+	virtual ArrayPackedStorage *duplicate() const {
+
+		ArrayPackedStorageT<T> *storage = memnew(ArrayPackedStorageT<T>);
+		storage->data = data;
+		return storage;
+	}
+};
+
+static ArrayPackedStorage *_create_packed_storage(Variant::Type p_type) {
+
+	switch (p_type) {
+		case Variant::INT:
+			return memnew(ArrayPackedStorageT<int64_t>);
+		case Variant::FLOAT:
+			return memnew(ArrayPackedStorageT<double>);
+		case Variant::STRING:
+			return memnew(ArrayPackedStorageT<String>);
+		case Variant::VECTOR2:
+			return memnew(ArrayPackedStorageT<Vector2>);
+		case Variant::VECTOR3:
+			return memnew(ArrayPackedStorageT<Vector3>);
+		case Variant::COLOR:
+			return memnew(ArrayPackedStorageT<Color>);
+		default:
+			return NULL;
+	}
+}
+
 class ArrayPrivate {
 public:
 	SafeRefCount refcount;
 	Vector<Variant> array;
+	Variant::Type typed = Variant::NIL; //element type, NIL when untyped
+	ArrayPackedStorage *packed = NULL; //used instead of array while set
+
+	~ArrayPrivate() {
+		if (packed) {
+			memdelete(packed);
+		}
+	}
 };
 
+//returns p_value, or a copy converted to the element type; NULL if the array can't hold it
+static const Variant *_validate_value(const ArrayPrivate *p_p, const Variant &p_value, Variant &r_converted) {
+
+	if (p_p->typed == Variant::NIL || p_value.get_type() == p_p->typed) {
+		return &p_value;
+	}
+
+	ERR_FAIL_COND_V_MSG(!Variant::can_convert_strict(p_value.get_type(), p_p->typed), NULL, "Attempted to store a value of type '" + Variant::get_type_name(p_value.get_type()) + "' in an array of type '" + Variant::get_type_name(p_p->typed) + "'.");
+
+	if (p_value.get_type() == Variant::NIL) {
+		r_converted = (Object *)NULL;
+		return &r_converted;
+	}
+
+	const Variant *args[1] = { &p_value };
+	Callable::CallError ce;
+	r_converted = Variant::construct(p_p->typed, args, 1, ce);
+	ERR_FAIL_COND_V(ce.error != Callable::CallError::CALL_OK, NULL);
+	return &r_converted;
+}
+
 void Array::_ref(const Array &p_from) const {
 
 	ArrayPrivate *_fp = p_from._p;
@@ -70,26 +256,44 @@ void Array::_unref() const {
 	_p = NULL;
 }
 
+void Array::_unpack() const {
+
+	if (!_p->packed)
+		return;
+
+	_p->packed->unpack(_p->array);
+	memdelete(_p->packed);
+	_p->packed = NULL;
+}
+
 Variant &Array::operator[](int p_idx) {
 
+	_unpack();
 	return _p->array.write[p_idx];
 }
 
 const Variant &Array::operator[](int p_idx) const {
 
+	_unpack();
 	return _p->array[p_idx];
 }
 
 int Array::size() const {
 
+	if (_p->packed)
+		return _p->packed->size();
 	return _p->array.size();
 }
 bool Array::empty() const {
 
-	return _p->array.empty();
+	return size() == 0;
 }
 void Array::clear() {
 
+	if (_p->packed) {
+		_p->packed->resize(0);
+		return;
+	}
 	_p->array.clear();
 }
 
@@ -100,6 +304,9 @@ bool Array::operator==(const Array &p_array) const {
 
 uint32_t Array::hash() const {
 
+	if (_p->packed)
+		return _p->packed->hash();
+
 	uint32_t h = hash_djb2_one_32(0);
 
 	for (int i = 0; i < _p->array.size(); i++) {
@@ -114,53 +321,98 @@ void Array::operator=(const Array &p_array) {
 }
 void Array::push_back(const Variant &p_value) {
 
-	_p->array.push_back(p_value);
+	Variant converted;
+	const Variant *value = _validate_value(_p, p_value, converted);
+	if (!value)
+		return;
+
+	if (_p->packed) {
+		_p->packed->insert(_p->packed->size(), *value);
+		return;
+	}
+	_p->array.push_back(*value);
 }
 
 Error Array::resize(int p_new_size) {
 
-	return _p->array.resize(p_new_size);
+	if (_p->packed)
+		return _p->packed->resize(p_new_size);
+
+	int from = _p->array.size();
+	Error err = _p->array.resize(p_new_size);
+	if (err == OK && _p->typed != Variant::NIL && p_new_size > from) {
+		//new elements must be of the element type too
+		Callable::CallError ce;
+		Variant default_value = Variant::construct(_p->typed, NULL, 0, ce);
+		Variant *w = _p->array.ptrw();
+		for (int i = from; i < p_new_size; i++) {
+			w[i] = default_value;
+		}
+	}
+	return err;
 }
 
 void Array::insert(int p_pos, const Variant &p_value) {
 
-	_p->array.insert(p_pos, p_value);
+	Variant converted;
+	const Variant *value = _validate_value(_p, p_value, converted);
+	if (!value)
+		return;
+
+	if (_p->packed) {
+		_p->packed->insert(p_pos, *value);
+		return;
+	}
+	_p->array.insert(p_pos, *value);
 }
 
 void Array::erase(const Variant &p_value) {
 
+	if (_p->packed) {
+		int idx = _p->packed->find(p_value, 0);
+		if (idx >= 0) {
+			_p->packed->remove(idx);
+		}
+		return;
+	}
 	_p->array.erase(p_value);
 }
 
 Variant Array::front() const {
-	ERR_FAIL_COND_V_MSG(_p->array.size() == 0, Variant(), "Can't take value from empty array.");
-	return operator[](0);
+	ERR_FAIL_COND_V_MSG(size() == 0, Variant(), "Can't take value from empty array.");
+	return get_element(0);
 }
 
 Variant Array::back() const {
-	ERR_FAIL_COND_V_MSG(_p->array.size() == 0, Variant(), "Can't take value from empty array.");
-	return operator[](_p->array.size() - 1);
+	ERR_FAIL_COND_V_MSG(size() == 0, Variant(), "Can't take value from empty array.");
+	return get_element(size() - 1);
 }
 
 int Array::find(const Variant &p_value, int p_from) const {
 
+	if (_p->packed)
+		return _p->packed->find(p_value, p_from);
 	return _p->array.find(p_value, p_from);
 }
 
 int Array::rfind(const Variant &p_value, int p_from) const {
 
-	if (_p->array.size() == 0)
+	int array_size = size();
+	if (array_size == 0)
 		return -1;
 
 	if (p_from < 0) {
 		// Relative offset from the end
-		p_from = _p->array.size() + p_from;
+		p_from = array_size + p_from;
 	}
-	if (p_from < 0 || p_from >= _p->array.size()) {
+	if (p_from < 0 || p_from >= array_size) {
 		// Limit to array boundaries
-		p_from = _p->array.size() - 1;
+		p_from = array_size - 1;
 	}
 
+	if (_p->packed)
+		return _p->packed->rfind(p_value, p_from);
+
 	for (int i = p_from; i >= 0; i--) {
 
 		if (_p->array[i] == p_value) {
@@ -178,6 +430,9 @@ int Array::find_last(const Variant &p_value) const {
 
 int Array::count(const Variant &p_value) const {
 
+	if (_p->packed)
+		return _p->packed->count(p_value);
+
 	if (_p->array.size() == 0)
 		return 0;
 
@@ -193,17 +448,30 @@ int Array::count(const Variant &p_value) const {
 }
 
 bool Array::has(const Variant &p_value) const {
-	return _p->array.find(p_value, 0) != -1;
+	return find(p_value, 0) != -1;
 }
 
 void Array::remove(int p_pos) {
 
+	if (_p->packed) {
+		_p->packed->remove(p_pos);
+		return;
+	}
 	_p->array.remove(p_pos);
 }
 
 void Array::set(int p_idx, const Variant &p_value) {
 
-	operator[](p_idx) = p_value;
+	Variant converted;
+	const Variant *value = _validate_value(_p, p_value, converted);
+	if (!value)
+		return;
+
+	if (_p->packed) {
+		_p->packed->set(p_idx, *value);
+		return;
+	}
+	_p->array.write[p_idx] = *value;
 }
 
 const Variant &Array::get(int p_idx) const {
@@ -211,13 +479,66 @@ const Variant &Array::get(int p_idx) const {
 	return operator[](p_idx);
 }
 
+Variant Array::get_element(int p_idx) const {
+
+	if (_p->packed)
+		return _p->packed->get(p_idx);
+	return _p->array[p_idx];
+}
+
+void Array::set_typed(uint32_t p_type) {
+
+	ERR_FAIL_COND_MSG(p_type == Variant::NIL || p_type >= Variant::VARIANT_MAX, "Invalid array element type.");
+	ERR_FAIL_COND_MSG(_p->typed != Variant::NIL, "The element type of an array can only be set once.");
+	ERR_FAIL_COND_MSG(size() > 0, "The element type can only be set on empty arrays.");
+
+	_p->typed = Variant::Type(p_type);
+	_p->packed = _create_packed_storage(_p->typed);
+}
+
+bool Array::is_typed() const {
+
+	return _p->typed != Variant::NIL;
+}
+
+uint32_t Array::get_typed_builtin() const {
+
+	return _p->typed;
+}
+
+#define MAKE_ARRAY_GET_PACKED(m_type)                                          \
+	template <>                                                                \
+	Vector<m_type> *Array::_get_packed<m_type>() const {                       \
+		if (!_p->packed || _p->typed != ArrayPackedType<m_type>::VARIANT_TYPE) \
+			return NULL;                                                       \
+		return &static_cast<ArrayPackedStorageT<m_type> *>(_p->packed)->data;  \
+	}
+
+MAKE_ARRAY_GET_PACKED(int64_t)
+MAKE_ARRAY_GET_PACKED(double)
+MAKE_ARRAY_GET_PACKED(String)
+MAKE_ARRAY_GET_PACKED(Vector2)
+MAKE_ARRAY_GET_PACKED(Vector3)
+MAKE_ARRAY_GET_PACKED(Color)
+
 Array Array::duplicate(bool p_deep) const {
 
 	Array new_arr;
+	if (_p->typed != Variant::NIL) {
+		new_arr.set_typed(_p->typed);
+	}
+
+	if (_p->packed) {
+		//native elements have nothing to deep copy, and the copy shares the data until written
+		memdelete(new_arr._p->packed);
+		new_arr._p->packed = _p->packed->duplicate();
+		return new_arr;
+	}
+
 	int element_count = size();
-	new_arr.resize(element_count);
+	new_arr._p->array.resize(element_count);
 	for (int i = 0; i < element_count; i++) {
-		new_arr[i] = p_deep ? get(i).duplicate(p_deep) : get(i);
+		new_arr._p->array.write[i] = p_deep ? _p->array[i].duplicate(p_deep) : _p->array[i];
 	}
 
 	return new_arr;
@@ -235,10 +556,13 @@ int Array::_clamp_index(int p_index) const {
 	return CLAMP(p_index, -size() + 1, size() - 1);
 }
 
-#define ARRAY_GET_DEEP(idx, is_deep) is_deep ? get(idx).duplicate(is_deep) : get(idx)
+#define ARRAY_GET_DEEP(idx, is_deep) is_deep ? get_element(idx).duplicate(is_deep) : get_element(idx)
 
 Array Array::slice(int p_begin, int p_end, int p_step, bool p_deep) const { // like python, but inclusive on upper bound
 	Array new_arr;
+	if (_p->typed != Variant::NIL) {
+		new_arr.set_typed(_p->typed);
+	}
 
 	if (empty()) // Don't try to slice empty arrays.
 		return new_arr;
@@ -253,7 +577,7 @@ Array Array::slice(int p_begin, int p_end, int p_step, bool p_deep) const { // l
 	if (Array::_clamp_index(p_begin) == Array::_clamp_index(p_end)) { // don't include element twice
 		new_arr.resize(1);
 		// new_arr[0] = 1;
-		new_arr[0] = ARRAY_GET_DEEP(Array::_clamp_index(p_begin), p_deep);
+		new_arr.set(0, ARRAY_GET_DEEP(Array::_clamp_index(p_begin), p_deep));
 		return new_arr;
 	} else {
 		int element_count = ceil((int)MAX(0, (p_end - p_begin) / p_step)) + 1;
@@ -267,13 +591,13 @@ Array Array::slice(int p_begin, int p_end, int p_step, bool p_deep) const { // l
 	// if going backwards, have to have a different terminating condition
 	if (p_step < 0) {
 		while (x >= p_end) {
-			new_arr[new_arr_i] = ARRAY_GET_DEEP(Array::_clamp_index(x), p_deep);
+			new_arr.set(new_arr_i, ARRAY_GET_DEEP(Array::_clamp_index(x), p_deep));
 			x += p_step;
 			new_arr_i += 1;
 		}
 	} else if (p_step > 0) {
 		while (x <= p_end) {
-			new_arr[new_arr_i] = ARRAY_GET_DEEP(Array::_clamp_index(x), p_deep);
+			new_arr.set(new_arr_i, ARRAY_GET_DEEP(Array::_clamp_index(x), p_deep));
 			x += p_step;
 			new_arr_i += 1;
 		}
@@ -296,6 +620,10 @@ struct _ArrayVariantSort {
 
 Array &Array::sort() {
 
+	if (_p->packed) {
+		_p->packed->sort();
+		return *this;
+	}
 	_p->array.sort_custom<_ArrayVariantSort>();
 	return *this;
 }
@@ -322,15 +650,36 @@ Array &Array::sort_custom(Object *p_obj, const StringName &p_function) {
 	SortArray<Variant, _ArrayVariantSortCustom, true> avs;
 	avs.compare.obj = p_obj;
 	avs.compare.func = p_function;
+
+	if (_p->packed) {
+		//the comparator takes Variants, sort a copy and write it back
+		Vector<Variant> elements;
+		_p->packed->unpack(elements);
+		avs.sort(elements.ptrw(), elements.size());
+		for (int i = 0; i < elements.size(); i++) {
+			_p->packed->set(i, elements[i]);
+		}
+		return *this;
+	}
+
 	avs.sort(_p->array.ptrw(), _p->array.size());
 	return *this;
 }
 
 void Array::shuffle() {
 
-	const int n = _p->array.size();
+	const int n = size();
 	if (n < 2)
 		return;
+
+	if (_p->packed) {
+		for (int i = n - 1; i >= 1; i--) {
+			const int j = Math::rand() % (i + 1);
+			_p->packed->swap(i, j);
+		}
+		return;
+	}
+
 	Variant *data = _p->array.ptrw();
 	for (int i = n - 1; i >= 1; i--) {
 		const int j = Math::rand() % (i + 1);
@@ -340,15 +689,29 @@ void Array::shuffle() {
 	}
 }
 
-template <typename Less>
-_FORCE_INLINE_ int bisect(const Vector<Variant> &p_array, const Variant &p_value, bool p_before, const Less &p_less) {
+struct _ArrayGetVariant {
+
+	const Vector<Variant> *array;
+
+	_FORCE_INLINE_ const Variant &operator()(int p_idx) const { return (*array)[p_idx]; }
+};
+
+struct _ArrayGetPacked {
+
+	const ArrayPackedStorage *packed;
+
+	_FORCE_INLINE_ Variant operator()(int p_idx) const { return packed->get(p_idx); }
+};
+
+template <typename Getter, typename Less>
+_FORCE_INLINE_ int bisect(const Getter &p_get, int p_size, const Variant &p_value, bool p_before, const Less &p_less) {
 
 	int lo = 0;
-	int hi = p_array.size();
+	int hi = p_size;
 	if (p_before) {
 		while (lo < hi) {
 			const int mid = (lo + hi) / 2;
-			if (p_less(p_array.get(mid), p_value)) {
+			if (p_less(p_get(mid), p_value)) {
 				lo = mid + 1;
 			} else {
 				hi = mid;
@@ -357,7 +720,7 @@ _FORCE_INLINE_ int bisect(const Vector<Variant> &p_array, const Variant &p_value
 	} else {
 		while (lo < hi) {
 			const int mid = (lo + hi) / 2;
-			if (p_less(p_value, p_array.get(mid))) {
+			if (p_less(p_value, p_get(mid))) {
 				hi = mid;
 			} else {
 				lo = mid + 1;
@@ -367,9 +730,23 @@ _FORCE_INLINE_ int bisect(const Vector<Variant> &p_array, const Variant &p_value
 	return lo;
 }
 
+template <typename Less>
+static int _bisect_array(const ArrayPrivate *p_p, const Variant &p_value, bool p_before, const Less &p_less) {
+
+	if (p_p->packed) {
+		_ArrayGetPacked get;
+		get.packed = p_p->packed;
+		return bisect(get, p_p->packed->size(), p_value, p_before, p_less);
+	}
+
+	_ArrayGetVariant get;
+	get.array = &p_p->array;
+	return bisect(get, p_p->array.size(), p_value, p_before, p_less);
+}
+
 int Array::bsearch(const Variant &p_value, bool p_before) {
 
-	return bisect(_p->array, p_value, p_before, _ArrayVariantSort());
+	return _bisect_array(_p, p_value, p_before, _ArrayVariantSort());
 }
 
 int Array::bsearch_custom(const Variant &p_value, Object *p_obj, const StringName &p_function, bool p_before) {
@@ -380,26 +757,30 @@ int Array::bsearch_custom(const Variant &p_value, Object *p_obj, const StringNam
 	less.obj = p_obj;
 	less.func = p_function;
 
-	return bisect(_p->array, p_value, p_before, less);
+	return _bisect_array(_p, p_value, p_before, less);
 }
 
 Array &Array::invert() {
 
+	if (_p->packed) {
+		_p->packed->invert();
+		return *this;
+	}
 	_p->array.invert();
 	return *this;
 }
 
 void Array::push_front(const Variant &p_value) {
 
-	_p->array.insert(0, p_value);
+	insert(0, p_value);
 }
 
 Variant Array::pop_back() {
 
-	if (!_p->array.empty()) {
-		int n = _p->array.size() - 1;
-		Variant ret = _p->array.get(n);
-		_p->array.resize(n);
+	int n = size() - 1;
+	if (n >= 0) {
+		Variant ret = get_element(n);
+		resize(n);
 		return ret;
 	}
 	return Variant();
@@ -407,9 +788,9 @@ Variant Array::pop_back() {
 
 Variant Array::pop_front() {
 
-	if (!_p->array.empty()) {
-		Variant ret = _p->array.get(0);
-		_p->array.remove(0);
+	if (!empty()) {
+		Variant ret = get_element(0);
+		remove(0);
 		return ret;
 	}
 	return Variant();
@@ -420,11 +801,11 @@ Variant Array::min() const {
 	Variant minval;
 	for (int i = 0; i < size(); i++) {
 		if (i == 0) {
-			minval = get(i);
+			minval = get_element(i);
 		} else {
 			bool valid;
 			Variant ret;
-			Variant test = get(i);
+			Variant test = get_element(i);
 			Variant::evaluate(Variant::OP_LESS, test, minval, ret, valid);
 			if (!valid) {
 				return Variant(); //not a valid comparison
@@ -443,11 +824,11 @@ Variant Array::max() const {
 	Variant maxval;
 	for (int i = 0; i < size(); i++) {
 		if (i == 0) {
-			maxval = get(i);
+			maxval = get_element(i);
 		} else {
 			bool valid;
 			Variant ret;
-			Variant test = get(i);
+			Variant test = get_element(i);
 			Variant::evaluate(Variant::OP_GREATER, test, maxval, ret, valid);
 			if (!valid) {
 				return Variant(); //not a valid comparison
@@ -462,7 +843,7 @@ Variant Array::max() const {
 }
 
 const void *Array::id() const {
-	return _p->array.ptr();
+	return _p;
 }
 
 Array::Array(const Array &p_from) {
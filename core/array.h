@@ -37,22 +37,41 @@ class Variant;
 class ArrayPrivate;
 class Object;
 class StringName;
+class String;
+struct Vector2;
+struct Vector3;
+struct Color;
+
+template <class T>
+class Vector;
 
 class Array {
 
 	mutable ArrayPrivate *_p;
 	void _ref(const Array &p_from) const;
 	void _unref() const;
+	void _unpack() const;
 
 	int _clamp_index(int p_index) const;
 	static int _fix_slice_index(int p_index, int p_arr_len, int p_top_mod);
 
 public:
+	// typed arrays of int, float, String, Vector2, Vector3 and Color keep their elements as native values,
+	// handing out a Variant reference moves them to Variant storage for the rest of the array's life
 	Variant &operator[](int p_idx);
 	const Variant &operator[](int p_idx) const;
 
 	void set(int p_idx, const Variant &p_value);
 	const Variant &get(int p_idx) const;
+	Variant get_element(int p_idx) const; //by value, keeps native storage
+
+	void set_typed(uint32_t p_type);
+	bool is_typed() const;
+	uint32_t get_typed_builtin() const;
+
+	//native storage of a typed array, NULL if T is not the element type or the elements moved to Variant storage
+	template <class T>
+	Vector<T> *_get_packed() const { return NULL; }
 
 	int size() const;
 	bool empty() const;
@@ -106,4 +125,17 @@ public:
 	~Array();
 };
 
+template <>
+Vector<int64_t> *Array::_get_packed<int64_t>() const;
+template <>
+Vector<double> *Array::_get_packed<double>() const;
+template <>
+Vector<String> *Array::_get_packed<String>() const;
+template <>
+Vector<Vector2> *Array::_get_packed<Vector2>() const;
+template <>
+Vector<Vector3> *Array::_get_packed<Vector3>() const;
+template <>
+Vector<Color> *Array::_get_packed<Color>() const;
+
 #endif // ARRAY_H
@@ -64,9 +64,9 @@ static const unsigned int MONTH_DAYS_TABLE[2][12] = {
 
 _ResourceLoader *_ResourceLoader::singleton = NULL;
 
-Error _ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads) {
+Error _ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, LoadPriority p_priority) {
 
-	return ResourceLoader::load_threaded_request(p_path, p_type_hint, p_use_sub_threads);
+	return ResourceLoader::load_threaded_request(p_path, p_type_hint, p_use_sub_threads, String(), (ResourceLoader::LoadPriority)p_priority);
 }
 _ResourceLoader::ThreadLoadStatus _ResourceLoader::load_threaded_get_status(const String &p_path, Array r_progress) {
 	float progress = 0;
@@ -133,7 +133,7 @@ bool _ResourceLoader::exists(const String &p_path, const String &p_type_hint) {
 
 void _ResourceLoader::_bind_methods() {
 
-	ClassDB::bind_method(D_METHOD("load_threaded_request", "path", "type_hint", "use_sub_threads"), &_ResourceLoader::load_threaded_request, DEFVAL(""), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("load_threaded_request", "path", "type_hint", "use_sub_threads", "priority"), &_ResourceLoader::load_threaded_request, DEFVAL(""), DEFVAL(false), DEFVAL(LOAD_PRIORITY_NORMAL));
 	ClassDB::bind_method(D_METHOD("load_threaded_get_status", "path", "progress"), &_ResourceLoader::load_threaded_get_status, DEFVAL(Array()));
 	ClassDB::bind_method(D_METHOD("load_threaded_get", "path"), &_ResourceLoader::load_threaded_get);
 
@@ -148,6 +148,10 @@ void _ResourceLoader::_bind_methods() {
 	BIND_ENUM_CONSTANT(THREAD_LOAD_IN_PROGRESS);
 	BIND_ENUM_CONSTANT(THREAD_LOAD_FAILED);
 	BIND_ENUM_CONSTANT(THREAD_LOAD_LOADED);
+
+	BIND_ENUM_CONSTANT(LOAD_PRIORITY_HIGH);
+	BIND_ENUM_CONSTANT(LOAD_PRIORITY_NORMAL);
+	BIND_ENUM_CONSTANT(LOAD_PRIORITY_LOW);
 }
 
 _ResourceLoader::_ResourceLoader() {
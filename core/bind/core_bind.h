@@ -56,9 +56,15 @@ public:
 		THREAD_LOAD_LOADED
 	};
 
+	enum LoadPriority {
+		LOAD_PRIORITY_HIGH,
+		LOAD_PRIORITY_NORMAL,
+		LOAD_PRIORITY_LOW
+	};
+
 	static _ResourceLoader *get_singleton() { return singleton; }
 
-	Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false);
+	Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, LoadPriority p_priority = LOAD_PRIORITY_NORMAL);
 	ThreadLoadStatus load_threaded_get_status(const String &p_path, Array r_progress = Array());
 	RES load_threaded_get(const String &p_path);
 
@@ -73,6 +79,7 @@ public:
 };
 
 VARIANT_ENUM_CAST(_ResourceLoader::ThreadLoadStatus);
+VARIANT_ENUM_CAST(_ResourceLoader::LoadPriority);
 
 class _ResourceSaver : public Object {
 	GDCLASS(_ResourceSaver, Object);
@@ -263,6 +263,7 @@ ClassDB::ClassInfo::ClassInfo() {
 	api = API_NONE;
 	creation_func = NULL;
 	inherits_ptr = NULL;
+	lookup = NULL;
 	disabled = false;
 	exposed = false;
 }
@@ -560,6 +561,32 @@ Object *ClassDB::instance(const StringName &p_class) {
 #endif
 	return ti->creation_func();
 }
+
+//resolves what instance() would construct, without constructing it
+ClassDB::CreationFunc ClassDB::get_creation_func(const StringName &p_class, StringName *r_class) {
+
+	OBJTYPE_RLOCK;
+
+	ClassInfo *ti = classes.getptr(p_class);
+	if (!ti || ti->disabled || !ti->creation_func) {
+		if (compat_classes.has(p_class)) {
+			ti = classes.getptr(compat_classes[p_class]);
+		}
+	}
+	if (!ti || ti->disabled) {
+		return NULL;
+	}
+#ifdef TOOLS_ENABLED
+	if (ti->api == API_EDITOR && !Engine::get_singleton()->is_editor_hint()) {
+		return NULL;
+	}
+#endif
+	if (r_class) {
+		*r_class = ti->name;
+	}
+	return ti->creation_func;
+}
+
 bool ClassDB::can_instance(const StringName &p_class) {
 
 	OBJTYPE_RLOCK;
@@ -671,8 +698,118 @@ void ClassDB::get_method_list(StringName p_class, List<MethodInfo> *p_methods, b
 	}
 }
 
+ClassDB::Lookup *ClassDB::_build_lookup(const ClassInfo *p_type) {
+
+	Lookup *lookup = memnew(Lookup);
+
+	//walk from the class to its bases, so the nearest definition of a name wins
+	for (const ClassInfo *check = p_type; check; check = check->inherits_ptr) {
+
+		const StringName *K = NULL;
+		while ((K = check->method_map.next(K))) {
+			MethodBind *method = check->method_map[*K];
+			if (method && !lookup->methods.has(*K)) {
+				lookup->methods[*K] = method;
+			}
+		}
+
+		K = NULL;
+		while ((K = check->property_setget.next(K))) {
+			const PropertySetGet *psg = check->property_setget.getptr(*K);
+			if (!lookup->properties.has(*K)) {
+				lookup->properties[*K] = psg;
+			}
+			if (!lookup->members.has(*K)) {
+				Lookup::Member member;
+				member.type = Lookup::MEMBER_PROPERTY;
+				member.property = psg;
+				member.constant = 0;
+				lookup->members[*K] = member;
+			}
+		}
+
+		//same precedence get_property had when it walked the chain itself
+		K = NULL;
+		while ((K = check->constant_map.next(K))) {
+			if (!lookup->members.has(*K)) {
+				Lookup::Member member;
+				member.type = Lookup::MEMBER_CONSTANT;
+				member.property = NULL;
+				member.constant = check->constant_map[*K];
+				lookup->members[*K] = member;
+			}
+		}
+
+		K = NULL;
+		while ((K = check->method_map.next(K))) {
+			if (!lookup->members.has(*K)) {
+				Lookup::Member member;
+				member.type = Lookup::MEMBER_METHOD;
+				member.property = NULL;
+				member.constant = 0;
+				lookup->members[*K] = member;
+			}
+		}
+
+		K = NULL;
+		while ((K = check->signal_map.next(K))) {
+			if (!lookup->members.has(*K)) {
+				Lookup::Member member;
+				member.type = Lookup::MEMBER_SIGNAL;
+				member.property = NULL;
+				member.constant = 0;
+				lookup->members[*K] = member;
+			}
+		}
+	}
+
+	return lookup;
+}
+
+const ClassDB::Lookup *ClassDB::_get_lookup(ClassInfo *p_type) {
+
+	Lookup *lookup = p_type->lookup;
+	std::atomic_thread_fence(std::memory_order_acquire);
+	uint32_t version = lookup_version.load(std::memory_order_acquire);
+	if (likely(lookup && lookup->version == version)) {
+		return lookup;
+	}
+
+	//something was bound since the table was built (or it never was), build it again
+	OBJTYPE_WLOCK;
+
+	lookup = p_type->lookup;
+	version = lookup_version.load(std::memory_order_acquire);
+	if (lookup && lookup->version == version) {
+		return lookup; //another thread got here first
+	}
+
+	if (lookup) {
+		//other threads may still be reading it
+		retired_lookups.push_back(lookup);
+	}
+
+	lookup = _build_lookup(p_type);
+	lookup->version = version;
+	std::atomic_thread_fence(std::memory_order_release);
+	p_type->lookup = lookup;
+
+	return lookup;
+}
+
 MethodBind *ClassDB::get_method(StringName p_class, StringName p_name) {
 
+	if (registration_locked) {
+
+		ClassInfo *type = classes.getptr(p_class);
+		if (!type) {
+			return NULL;
+		}
+
+		MethodBind *const *method = _get_lookup(type)->methods.getptr(p_name);
+		return method ? *method : NULL;
+	}
+
 	OBJTYPE_RLOCK;
 
 	ClassInfo *type = classes.getptr(p_class);
@@ -687,9 +824,28 @@ MethodBind *ClassDB::get_method(StringName p_class, StringName p_name) {
 	return NULL;
 }
 
+int ClassDB::get_method_id(StringName p_class, StringName p_name) {
+
+	MethodBind *method = get_method(p_class, p_name);
+	return method ? method->get_method_id() : -1;
+}
+
+MethodBind *ClassDB::get_method_by_id(int p_id) {
+
+	ERR_FAIL_COND_V(p_id < 0, NULL);
+
+	int page = p_id >> METHOD_PAGE_SHIFT;
+	if (page >= METHOD_PAGE_MAX || !method_pages[page]) {
+		return NULL;
+	}
+
+	return method_pages[page][p_id & (METHOD_PAGE_SIZE - 1)];
+}
+
 void ClassDB::bind_integer_constant(const StringName &p_class, const StringName &p_enum, const StringName &p_name, int p_constant) {
 
 	OBJTYPE_WLOCK;
+	lookup_version++;
 
 	ClassInfo *type = classes.getptr(p_class);
 
@@ -861,6 +1017,7 @@ void ClassDB::add_signal(StringName p_class, const MethodInfo &p_signal) {
 	}
 #endif
 
+	lookup_version++;
 	type->signal_map[sname] = p_signal;
 }
 
@@ -985,6 +1142,7 @@ void ClassDB::add_property(StringName p_class, const PropertyInfo &p_pinfo, cons
 	psg.index = p_index;
 	psg.type = p_pinfo.type;
 
+	lookup_version++;
 	type->property_setget[p_pinfo.name] = psg;
 }
 
@@ -1019,45 +1177,85 @@ void ClassDB::get_property_list(StringName p_class, List<PropertyInfo> *p_list,
 		check = check->inherits_ptr;
 	}
 }
+
+static void _property_set(Object *p_object, const ClassDB::PropertySetGet *psg, const Variant &p_value, bool *r_valid) {
+
+	if (!psg->setter) {
+		if (r_valid)
+			*r_valid = false;
+		return; //do nothing
+	}
+
+	Callable::CallError ce;
+
+	if (psg->index >= 0) {
+		Variant index = psg->index;
+		const Variant *arg[2] = { &index, &p_value };
+		//p_object->call(psg->setter,arg,2,ce);
+		if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 2, ce);
+		} else {
+			p_object->call(psg->setter, arg, 2, ce);
+		}
+
+	} else {
+		const Variant *arg[1] = { &p_value };
+		if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 1, ce);
+		} else {
+			p_object->call(psg->setter, arg, 1, ce);
+		}
+	}
+
+	if (r_valid)
+		*r_valid = ce.error == Callable::CallError::CALL_OK;
+}
+
+static void _property_get(Object *p_object, const ClassDB::PropertySetGet *psg, Variant &r_value) {
+
+	if (!psg->getter)
+		return; //do nothing
+
+	if (psg->index >= 0) {
+		Variant index = psg->index;
+		const Variant *arg[1] = { &index };
+		Callable::CallError ce;
+		r_value = p_object->call(psg->getter, arg, 1, ce);
+
+	} else {
+
+		Callable::CallError ce;
+		if (psg->_getptr) {
+
+			r_value = psg->_getptr->call(p_object, NULL, 0, ce);
+		} else {
+			r_value = p_object->call(psg->getter, NULL, 0, ce);
+		}
+	}
+}
+
 bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
 
 	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
 
-			if (!psg->setter) {
-				if (r_valid)
-					*r_valid = false;
-				return true; //return true but do nothing
-			}
-
-			Callable::CallError ce;
+	if (registration_locked && type) {
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[2] = { &index, &p_value };
-				//p_object->call(psg->setter,arg,2,ce);
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 2, ce);
-				} else {
-					p_object->call(psg->setter, arg, 2, ce);
-				}
+		const PropertySetGet *const *psg = _get_lookup(type)->properties.getptr(p_property);
+		if (!psg) {
+			return false;
+		}
 
-			} else {
-				const Variant *arg[1] = { &p_value };
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 1, ce);
-				} else {
-					p_object->call(psg->setter, arg, 1, ce);
-				}
-			}
+		_property_set(p_object, *psg, p_value, r_valid);
+		return true; //return true even if there was no setter
+	}
 
-			if (r_valid)
-				*r_valid = ce.error == Callable::CallError::CALL_OK;
+	ClassInfo *check = type;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
 
-			return true;
+			_property_set(p_object, psg, p_value, r_valid);
+			return true; //return true even if there was no setter
 		}
 
 		check = check->inherits_ptr;
@@ -1068,30 +1266,38 @@ bool ClassDB::set_property(Object *p_object, const StringName &p_property, const
 bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
 
 	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (!psg->getter)
-				return true; //return true but do nothing
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[1] = { &index };
-				Callable::CallError ce;
-				r_value = p_object->call(psg->getter, arg, 1, ce);
+	if (registration_locked && type) {
 
-			} else {
+		const Lookup::Member *member = _get_lookup(type)->members.getptr(p_property);
+		if (!member) {
+			return false;
+		}
 
-				Callable::CallError ce;
-				if (psg->_getptr) {
+		switch (member->type) {
+			case Lookup::MEMBER_PROPERTY: {
+				_property_get(p_object, member->property, r_value);
+			} break;
+			case Lookup::MEMBER_CONSTANT: {
+				r_value = member->constant;
+			} break;
+			case Lookup::MEMBER_METHOD: {
+				r_value = Callable(p_object, p_property);
+			} break;
+			case Lookup::MEMBER_SIGNAL: {
+				r_value = Signal(p_object, p_property);
+			} break;
+		}
 
-					r_value = psg->_getptr->call(p_object, NULL, 0, ce);
-				} else {
-					r_value = p_object->call(psg->getter, NULL, 0, ce);
-				}
-			}
-			return true;
+		return true;
+	}
+
+	ClassInfo *check = type;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			_property_get(p_object, psg, r_value);
+			return true; //return true even if there was no getter
 		}
 
 		const int *c = check->constant_map.getptr(p_property); //constants count
@@ -1178,6 +1384,34 @@ StringName ClassDB::get_property_setter(StringName p_class, const StringName &p_
 	return StringName();
 }
 
+const ClassDB::PropertySetGet *ClassDB::get_property_setget(const StringName &p_class, const StringName &p_property) {
+
+	ClassInfo *type = classes.getptr(p_class);
+
+	if (registration_locked && type) {
+		const PropertySetGet *const *psg = _get_lookup(type)->properties.getptr(p_property);
+		return psg ? *psg : NULL;
+	}
+
+	ClassInfo *check = type;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			return psg;
+		}
+
+		check = check->inherits_ptr;
+	}
+
+	return NULL;
+}
+
+//same as set_property() with the name already resolved, skips scripts and _set()
+void ClassDB::set_property_direct(Object *p_object, const PropertySetGet *p_setget, const Variant &p_value, bool *r_valid) {
+
+	_property_set(p_object, p_setget, p_value, r_valid);
+}
+
 StringName ClassDB::get_property_getter(StringName p_class, const StringName &p_property) {
 
 	ClassInfo *type = classes.getptr(p_class);
@@ -1279,8 +1513,22 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, const c
 	type->method_order.push_back(mdname);
 #endif
 
+	lookup_version++;
 	type->method_map[mdname] = p_bind;
 
+	int page = p_bind->get_method_id() >> METHOD_PAGE_SHIFT;
+	if (page < METHOD_PAGE_MAX) {
+		if (!method_pages[page]) {
+			MethodBind **methods = memnew_arr(MethodBind *, METHOD_PAGE_SIZE);
+			for (int i = 0; i < METHOD_PAGE_SIZE; i++) {
+				methods[i] = NULL;
+			}
+			std::atomic_thread_fence(std::memory_order_release);
+			method_pages[page] = methods;
+		}
+		method_pages[page][p_bind->get_method_id() & (METHOD_PAGE_SIZE - 1)] = p_bind;
+	}
+
 	Vector<Variant> defvals;
 
 	defvals.resize(p_defcount);
@@ -1460,12 +1708,23 @@ Variant ClassDB::class_get_default_property_value(const StringName &p_class, con
 }
 
 RWLock *ClassDB::lock = NULL;
+bool ClassDB::registration_locked = false;
+std::atomic<uint32_t> ClassDB::lookup_version(0);
+Vector<ClassDB::Lookup *> ClassDB::retired_lookups;
+MethodBind **ClassDB::method_pages[METHOD_PAGE_MAX] = {};
 
 void ClassDB::init() {
 
 	lock = RWLock::create();
 }
 
+void ClassDB::lock_registration() {
+
+	//from now on methods and properties are resolved through flattened tables, without taking the lock
+	OBJTYPE_WLOCK;
+	registration_locked = true;
+}
+
 void ClassDB::cleanup_defaults() {
 
 	default_values.clear();
@@ -1487,8 +1746,25 @@ void ClassDB::cleanup() {
 
 			memdelete(ti.method_map[*m]);
 		}
+
+		if (ti.lookup) {
+			memdelete(ti.lookup);
+		}
 	}
 	classes.clear();
+
+	for (int i = 0; i < retired_lookups.size(); i++) {
+		memdelete(retired_lookups[i]);
+	}
+	retired_lookups.clear();
+
+	for (int i = 0; i < METHOD_PAGE_MAX; i++) {
+		if (method_pages[i]) {
+			memdelete_arr(method_pages[i]);
+			method_pages[i] = NULL;
+		}
+	}
+	registration_locked = false;
 	resource_base_extensions.clear();
 	compat_classes.clear();
 
@@ -35,6 +35,8 @@
 #include "core/object.h"
 #include "core/print_string.h"
 
+#include <atomic>
+
 /** To bind more then 6 parameters include this:
  *  #include "core/method_bind_ext.gen.inc"
  */
@@ -112,10 +114,33 @@ public:
 		Variant::Type type;
 	};
 
+	//what a class resolves each name to, with the inherited entries folded in
+	struct Lookup {
+
+		enum MemberType {
+			MEMBER_PROPERTY,
+			MEMBER_CONSTANT,
+			MEMBER_METHOD,
+			MEMBER_SIGNAL
+		};
+
+		struct Member {
+			MemberType type;
+			const PropertySetGet *property;
+			int constant;
+		};
+
+		uint32_t version;
+		HashMap<StringName, MethodBind *> methods;
+		HashMap<StringName, const PropertySetGet *> properties;
+		HashMap<StringName, Member> members;
+	};
+
 	struct ClassInfo {
 
 		APIType api;
 		ClassInfo *inherits_ptr;
+		Lookup *lookup;
 		void *class_ptr;
 		HashMap<StringName, MethodBind *> method_map;
 		HashMap<StringName, int> constant_map;
@@ -140,6 +165,8 @@ public:
 		~ClassInfo();
 	};
 
+	typedef Object *(*CreationFunc)();
+
 	template <class T>
 	static Object *creator() {
 		return memnew(T);
@@ -150,6 +177,22 @@ public:
 	static HashMap<StringName, StringName> resource_base_extensions;
 	static HashMap<StringName, StringName> compat_classes;
 
+	static bool registration_locked;
+	static std::atomic<uint32_t> lookup_version;
+	static Vector<Lookup *> retired_lookups;
+
+	enum {
+		METHOD_PAGE_SHIFT = 10,
+		METHOD_PAGE_SIZE = 1 << METHOD_PAGE_SHIFT,
+		METHOD_PAGE_MAX = 256
+	};
+
+	//bound methods by id, pages never move so they can be read without the lock
+	static MethodBind **method_pages[METHOD_PAGE_MAX];
+
+	static Lookup *_build_lookup(const ClassInfo *p_type);
+	static const Lookup *_get_lookup(ClassInfo *p_type);
+
 #ifdef DEBUG_METHODS_ENABLED
 	static MethodBind *bind_methodfi(uint32_t p_flags, MethodBind *p_bind, const MethodDefinition &method_name, const Variant **p_defs, int p_defcount);
 #else
@@ -225,6 +268,7 @@ public:
 	static bool is_parent_class(const StringName &p_class, const StringName &p_inherits);
 	static bool can_instance(const StringName &p_class);
 	static Object *instance(const StringName &p_class);
+	static CreationFunc get_creation_func(const StringName &p_class, StringName *r_class = NULL);
 	static APIType get_api_type(const StringName &p_class);
 
 	static uint64_t get_api_hash(APIType p_api);
@@ -359,12 +403,16 @@ public:
 	static Variant::Type get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid = NULL);
 	static StringName get_property_setter(StringName p_class, const StringName &p_property);
 	static StringName get_property_getter(StringName p_class, const StringName &p_property);
+	static const PropertySetGet *get_property_setget(const StringName &p_class, const StringName &p_property);
+	static void set_property_direct(Object *p_object, const PropertySetGet *p_setget, const Variant &p_value, bool *r_valid = NULL);
 
 	static bool has_method(StringName p_class, StringName p_method, bool p_no_inheritance = false);
 	static void set_method_flags(StringName p_class, StringName p_method, int p_flags);
 
 	static void get_method_list(StringName p_class, List<MethodInfo> *p_methods, bool p_no_inheritance = false, bool p_exclude_from_properties = false);
 	static MethodBind *get_method(StringName p_class, StringName p_name);
+	static int get_method_id(StringName p_class, StringName p_name);
+	static MethodBind *get_method_by_id(int p_id);
 
 	static void add_virtual_method(const StringName &p_class, const MethodInfo &p_method, bool p_virtual = true);
 	static void get_virtual_methods(const StringName &p_class, List<MethodInfo> *p_methods, bool p_no_inheritance = false);
@@ -392,6 +440,7 @@ public:
 
 	static void add_compatibility_class(const StringName &p_class, const StringName &p_fallback);
 	static void init();
+	static void lock_registration();
 
 	static void set_current_api(APIType p_api);
 	static APIType get_current_api();
@@ -32,6 +32,13 @@
 
 #include "core/os/os.h"
 
+thread_local CommandQueueMT::Batch CommandQueueMT::batches[CommandQueueMT::BATCH_SLOTS];
+
+uint64_t CommandQueueMT::frame_stall_usec = 0;
+uint32_t CommandQueueMT::frame_pending_max = 0;
+uint64_t CommandQueueMT::last_frame_stall_usec = 0;
+uint32_t CommandQueueMT::last_frame_pending_max = 0;
+
 void CommandQueueMT::lock() {
 
 	mutex.lock();
@@ -51,6 +58,7 @@ void CommandQueueMT::wait_for_flush() {
 CommandQueueMT::SyncSemaphore *CommandQueueMT::_alloc_sync_sem() {
 
 	int idx = -1;
+	uint64_t from = 0;
 
 	while (true) {
 
@@ -66,45 +74,163 @@ CommandQueueMT::SyncSemaphore *CommandQueueMT::_alloc_sync_sem() {
 		unlock();
 
 		if (idx == -1) {
+			if (from == 0) {
+				from = OS::get_singleton()->get_ticks_usec();
+			}
 			wait_for_flush();
 		} else {
 			break;
 		}
 	}
 
+	if (from) {
+		uint64_t stalled = OS::get_singleton()->get_ticks_usec() - from;
+		atomic_add(&stall_usec, stalled);
+		atomic_add(&frame_stall_usec, stalled);
+	}
+
 	return &sync_sems[idx];
 }
 
-bool CommandQueueMT::dealloc_one() {
-tryagain:
-	if (dealloc_ptr == write_ptr) {
-		// The queue is empty
-		return false;
+void CommandQueueMT::_wait_sync_sem(SyncSemaphore *p_sem) {
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	p_sem->sem.wait();
+	p_sem->in_use = false;
+
+	uint64_t stalled = OS::get_singleton()->get_ticks_usec() - from;
+	atomic_add(&stall_usec, stalled);
+	atomic_add(&frame_stall_usec, stalled);
+}
+
+CommandQueueMT::Page *CommandQueueMT::_alloc_page(uint32_t p_min_size) {
+
+	Page *page = NULL;
+
+	if (free_pages && p_min_size <= COMMAND_PAGE_SIZE) {
+		page = free_pages;
+		free_pages = page->next;
+		free_page_count--;
+	} else {
+		uint32_t size = MAX(p_min_size, (uint32_t)COMMAND_PAGE_SIZE);
+		page = (Page *)memalloc(sizeof(Page) + size);
+		page->size = size;
+	}
+
+	page->next = NULL;
+	page->write = 0;
+	page->read = 0;
+	page->pending = 0;
+
+	return page;
+}
+
+void CommandQueueMT::_recycle_pages() {
+
+	while (first_page != read_page && first_page->pending == 0) {
+
+		Page *page = first_page;
+		first_page = page->next;
+
+		if (page->size == COMMAND_PAGE_SIZE && free_page_count < FREE_PAGES_MAX) {
+			page->next = free_pages;
+			free_pages = page;
+			free_page_count++;
+		} else {
+			memfree(page);
+		}
+	}
+
+	if (read_page && read_page == write_page && read_page->read == read_page->write && read_page->pending == 0) {
+		// everything was run, start over
+		read_page->read = 0;
+		read_page->write = 0;
+	}
+}
+
+void CommandQueueMT::_publish_batch(Batch *p_batch) {
+
+	if (!p_batch || !p_batch->first) {
+		return;
+	}
+
+	lock();
+
+	if (write_page) {
+		write_page->next = p_batch->first;
+	} else {
+		first_page = p_batch->first;
+		read_page = p_batch->first;
+	}
+	write_page = p_batch->last;
+
+	pending_commands += p_batch->count;
+	if (pending_commands > pending_commands_max) {
+		pending_commands_max = pending_commands;
 	}
+	atomic_exchange_if_greater(&frame_pending_max, pending_commands);
 
-	uint32_t size = *(uint32_t *)&command_mem[dealloc_ptr];
+	unlock();
 
-	if (size == 0) {
-		// End of command buffer wrap down
-		dealloc_ptr = 0;
-		goto tryagain;
+	if (sync) {
+		sync->post();
 	}
 
-	if (size & 1) {
-		// Still used, nothing can be deallocated
-		return false;
+	p_batch->first = NULL;
+	p_batch->last = NULL;
+	p_batch->count = 0;
+}
+
+void CommandQueueMT::begin_batch() {
+
+	Batch *batch = _get_batch();
+	if (batch) {
+		batch->depth++;
+		return;
+	}
+
+	for (int i = 0; i < BATCH_SLOTS; i++) {
+		if (batches[i].queue == NULL) {
+			batches[i].queue = this;
+			batches[i].depth = 1;
+			return;
+		}
 	}
 
-	dealloc_ptr += (size >> 1) + 8;
-	return true;
+	ERR_FAIL_MSG("Too many command queues batched at once by the same thread.");
+}
+
+void CommandQueueMT::end_batch() {
+
+	Batch *batch = _get_batch();
+	ERR_FAIL_COND_MSG(!batch, "end_batch() called without begin_batch().");
+
+	batch->depth--;
+	if (batch->depth == 0) {
+		_publish_batch(batch);
+		batch->queue = NULL;
+	}
+}
+
+void CommandQueueMT::update_frame_statistics() {
+
+	last_frame_stall_usec = frame_stall_usec;
+	atomic_sub(&frame_stall_usec, last_frame_stall_usec);
+	last_frame_pending_max = frame_pending_max;
+	frame_pending_max = 0;
 }
 
 CommandQueueMT::CommandQueueMT(bool p_sync) {
 
-	read_ptr = 0;
-	write_ptr = 0;
-	dealloc_ptr = 0;
-	command_mem = (uint8_t *)memalloc(COMMAND_MEM_SIZE);
+	first_page = NULL;
+	read_page = NULL;
+	write_page = NULL;
+	free_pages = NULL;
+	free_page_count = 0;
+
+	pending_commands = 0;
+	pending_commands_max = 0;
+	stall_usec = 0;
 
 	for (int i = 0; i < SYNC_SEMAPHORES; i++) {
 
@@ -120,5 +246,15 @@ CommandQueueMT::~CommandQueueMT() {
 
 	if (sync)
 		memdelete(sync);
-	memfree(command_mem);
+
+	while (first_page) {
+		Page *next = first_page->next;
+		memfree(first_page);
+		first_page = next;
+	}
+	while (free_pages) {
+		Page *next = free_pages->next;
+		memfree(free_pages);
+		free_pages = next;
+	}
 }
@@ -248,12 +248,20 @@
 #define DECL_PUSH(N)                                                         \
 	template <class T, class M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>       \
 	void push(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
-		CMD_TYPE(N) *cmd = allocate_and_lock<CMD_TYPE(N)>();                 \
+		Batch *batch = _get_batch();                                         \
+		CMD_TYPE(N) *cmd;                                                    \
+		if (batch) {                                                         \
+			cmd = allocate_batched<CMD_TYPE(N)>(batch);                      \
+		} else {                                                             \
+			cmd = allocate_and_lock<CMD_TYPE(N)>();                          \
+		}                                                                    \
 		cmd->instance = p_instance;                                          \
 		cmd->method = p_method;                                              \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                 \
-		unlock();                                                            \
-		if (sync) sync->post();                                              \
+		if (!batch) {                                                        \
+			unlock();                                                        \
+			if (sync) sync->post();                                          \
+		}                                                                    \
 	}
 
 #define CMD_RET_TYPE(N) CommandRet##N<T, M, COMMA_SEP_LIST(TYPE_ARG, N) COMMA(N) R>
@@ -261,6 +269,7 @@
 #define DECL_PUSH_AND_RET(N)                                                                   \
 	template <class T, class M, COMMA_SEP_LIST(TYPE_PARAM, N) COMMA(N) class R>                \
 	void push_and_ret(T *p_instance, M p_method, COMMA_SEP_LIST(PARAM, N) COMMA(N) R *r_ret) { \
+		_publish_batch(_get_batch());                                                          \
 		SyncSemaphore *ss = _alloc_sync_sem();                                                 \
 		CMD_RET_TYPE(N) *cmd = allocate_and_lock<CMD_RET_TYPE(N)>();                           \
 		cmd->instance = p_instance;                                                            \
@@ -270,8 +279,7 @@
 		cmd->sync_sem = ss;                                                                    \
 		unlock();                                                                              \
 		if (sync) sync->post();                                                                \
-		ss->sem.wait();                                                                        \
-		ss->in_use = false;                                                                    \
+		_wait_sync_sem(ss);                                                                    \
 	}
 
 #define CMD_SYNC_TYPE(N) CommandSync##N<T, M COMMA(N) COMMA_SEP_LIST(TYPE_ARG, N)>
@@ -279,6 +287,7 @@
 #define DECL_PUSH_AND_SYNC(N)                                                         \
 	template <class T, class M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>                \
 	void push_and_sync(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
+		_publish_batch(_get_batch());                                                 \
 		SyncSemaphore *ss = _alloc_sync_sem();                                        \
 		CMD_SYNC_TYPE(N) *cmd = allocate_and_lock<CMD_SYNC_TYPE(N)>();                \
 		cmd->instance = p_instance;                                                   \
@@ -287,8 +296,7 @@
 		cmd->sync_sem = ss;                                                           \
 		unlock();                                                                     \
 		if (sync) sync->post();                                                       \
-		ss->sem.wait();                                                               \
-		ss->in_use = false;                                                           \
+		_wait_sync_sem(ss);                                                           \
 	}
 
 #define MAX_CMD_PARAMS 15
@@ -331,72 +339,95 @@ class CommandQueueMT {
 	/***** BASE *******/
 
 	enum {
-		COMMAND_MEM_SIZE_KB = 256,
-		COMMAND_MEM_SIZE = COMMAND_MEM_SIZE_KB * 1024,
+		COMMAND_PAGE_SIZE_KB = 64,
+		COMMAND_PAGE_SIZE = COMMAND_PAGE_SIZE_KB * 1024,
+		FREE_PAGES_MAX = 8,
+		BATCH_SLOTS = 4,
 		SYNC_SEMAPHORES = 8
 	};
 
-	uint8_t *command_mem;
-	uint32_t read_ptr;
-	uint32_t write_ptr;
-	uint32_t dealloc_ptr;
-	SyncSemaphore sync_sems[SYNC_SEMAPHORES];
-	Mutex mutex;
-	Semaphore *sync;
+	// Commands are stored in a chain of pages, new pages are added as
+	// needed so producers never wait for room. Pages are recycled once all
+	// their commands were run and destroyed.
+	struct Page {
+		Page *next;
+		uint32_t size;
+		uint32_t write;
+		uint32_t read;
+		uint32_t pending; //commands not yet destroyed
+
+		_FORCE_INLINE_ uint8_t *get_data() { return (uint8_t *)(this + 1); }
+	};
 
-	template <class T>
-	T *allocate() {
+	// Commands pushed between begin_batch() and end_batch() go to pages
+	// owned by the pushing thread, and are handed to the queue all at once.
+	struct Batch {
+		CommandQueueMT *queue = nullptr;
+		Page *first = nullptr;
+		Page *last = nullptr;
+		uint32_t count = 0;
+		uint32_t depth = 0;
+	};
 
-		// alloc size is size+T+safeguard
-		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1)) + 8;
+	static thread_local Batch batches[BATCH_SLOTS];
 
-	tryagain:
+	Page *first_page; //oldest page not yet recycled
+	Page *read_page;
+	Page *write_page;
+	Page *free_pages;
+	uint32_t free_page_count;
 
-		if (write_ptr < dealloc_ptr) {
-			// behind dealloc_ptr, check that there is room
-			if ((dealloc_ptr - write_ptr) <= alloc_size) {
+	uint32_t pending_commands;
+	uint32_t pending_commands_max;
+	uint64_t stall_usec;
 
-				// There is no more room, try to deallocate something
-				if (dealloc_one()) {
-					goto tryagain;
-				}
-				return NULL;
-			}
-		} else {
-			// ahead of dealloc_ptr, check that there is room
+	SyncSemaphore sync_sems[SYNC_SEMAPHORES];
+	Mutex mutex;
+	Semaphore *sync;
 
-			if ((COMMAND_MEM_SIZE - write_ptr) < alloc_size + sizeof(uint32_t)) {
-				// no room at the end, wrap down;
+	Page *_alloc_page(uint32_t p_min_size); //must be called with the lock held
+	void _recycle_pages(); //must be called with the lock held
 
-				if (dealloc_ptr == 0) { // don't want write_ptr to become dealloc_ptr
+	template <class T>
+	T *_allocate_in(Page *&r_first, Page *&r_last) {
 
-					// There is no more room, try to deallocate something
-					if (dealloc_one()) {
-						goto tryagain;
-					}
-					return NULL;
-				}
+		// command is preceded by its size, so it can be skipped when reading
+		uint32_t size = (sizeof(T) + 8 - 1) & ~(8 - 1);
+		uint32_t alloc_size = size + 8;
+
+		if (!r_last || r_last->write + alloc_size > r_last->size) {
+			Page *page = _alloc_page(alloc_size);
+			if (r_last) {
+				r_last->next = page;
+			} else {
+				r_first = page;
+			}
+			r_last = page;
+		}
 
-				// if this happens, it's a bug
-				ERR_FAIL_COND_V((COMMAND_MEM_SIZE - write_ptr) < 8, NULL);
-				// zero means, wrap to beginning
+		uint32_t *p = (uint32_t *)&r_last->get_data()[r_last->write];
+		*p = size;
+		T *cmd = memnew_placement(&r_last->get_data()[r_last->write + 8], T);
+		r_last->write += alloc_size;
+		r_last->pending++;
+		return cmd;
+	}
 
-				uint32_t *p = (uint32_t *)&command_mem[write_ptr];
-				*p = 0;
-				write_ptr = 0;
-				goto tryagain;
-			}
+	template <class T>
+	T *allocate() {
+
+		Page *first = NULL;
+		T *cmd = _allocate_in<T>(first, write_page);
+		if (first) {
+			// queue had no pages
+			first_page = first;
+			read_page = first;
 		}
-		// Allocate the size and the 'in use' bit.
-		// First bit used to mark if command is still in use (1)
-		// or if it has been destroyed and can be deallocated (0).
-		uint32_t size = (sizeof(T) + 8 - 1) & ~(8 - 1);
-		uint32_t *p = (uint32_t *)&command_mem[write_ptr];
-		*p = (size << 1) | 1;
-		write_ptr += 8;
-		// allocate the command
-		T *cmd = memnew_placement(&command_mem[write_ptr], T);
-		write_ptr += size;
+		pending_commands++;
+		if (pending_commands > pending_commands_max) {
+			pending_commands_max = pending_commands;
+		}
+		atomic_exchange_if_greater(&frame_pending_max, pending_commands);
 		return cmd;
 	}
 
@@ -404,43 +435,59 @@ class CommandQueueMT {
 	T *allocate_and_lock() {
 
 		lock();
-		T *ret;
+		return allocate<T>();
+	}
 
-		while ((ret = allocate<T>()) == NULL) {
+	template <class T>
+	T *allocate_batched(Batch *p_batch) {
 
-			unlock();
-			// sleep a little until fetch happened and some room is made
-			wait_for_flush();
+		if (!p_batch->last || p_batch->last->write + ((sizeof(T) + 8 - 1) & ~(8 - 1)) + 8 > p_batch->last->size) {
+			// new pages are taken from the queue, which needs the lock
 			lock();
+			T *cmd = _allocate_in<T>(p_batch->first, p_batch->last);
+			unlock();
+			p_batch->count++;
+			return cmd;
 		}
 
-		return ret;
+		p_batch->count++;
+		return _allocate_in<T>(p_batch->first, p_batch->last);
+	}
+
+	_FORCE_INLINE_ Batch *_get_batch() {
+
+		for (int i = 0; i < BATCH_SLOTS; i++) {
+			if (batches[i].queue == this) {
+				return &batches[i];
+			}
+		}
+		return NULL;
 	}
 
 	bool flush_one(bool p_lock = true) {
 		if (p_lock) lock();
-	tryagain:
 
 		// tried to read an empty queue
-		if (read_ptr == write_ptr) {
-			if (p_lock) unlock();
-			return false;
+		while (read_page && read_page->read == read_page->write) {
+			if (!read_page->next) {
+				if (p_lock) unlock();
+				return false;
+			}
+			read_page = read_page->next;
+			_recycle_pages();
 		}
 
-		uint32_t size_ptr = read_ptr;
-		uint32_t size = *(uint32_t *)&command_mem[read_ptr] >> 1;
-
-		if (size == 0) {
-			//end of ringbuffer, wrap
-			read_ptr = 0;
-			goto tryagain;
+		if (!read_page) {
+			if (p_lock) unlock();
+			return false;
 		}
 
-		read_ptr += 8;
-
-		CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[read_ptr]);
+		Page *page = read_page;
+		uint32_t size = *(uint32_t *)&page->get_data()[page->read];
+		CommandBase *cmd = reinterpret_cast<CommandBase *>(&page->get_data()[page->read + 8]);
 
-		read_ptr += size;
+		page->read += size + 8;
+		pending_commands--;
 
 		if (p_lock) unlock();
 		cmd->call();
@@ -448,7 +495,9 @@ class CommandQueueMT {
 
 		cmd->post();
 		cmd->~CommandBase();
-		*(uint32_t *)&command_mem[size_ptr] &= ~1;
+		page->pending--;
+
+		_recycle_pages();
 
 		if (p_lock) unlock();
 		return true;
@@ -458,7 +507,13 @@ class CommandQueueMT {
 	void unlock();
 	void wait_for_flush();
 	SyncSemaphore *_alloc_sync_sem();
-	bool dealloc_one();
+	void _wait_sync_sem(SyncSemaphore *p_sem);
+	void _publish_batch(Batch *p_batch);
+
+	static uint64_t frame_stall_usec;
+	static uint32_t frame_pending_max;
+	static uint64_t last_frame_stall_usec;
+	static uint32_t last_frame_pending_max;
 
 public:
 	/* NORMAL PUSH COMMANDS */
@@ -473,10 +528,17 @@ public:
 	DECL_PUSH_AND_SYNC(0)
 	SPACE_SEP_LIST(DECL_PUSH_AND_SYNC, 15)
 
-	void wait_and_flush_one() {
+	// Commands pushed by the calling thread until end_batch() are published
+	// together, with a single lock and semaphore post. Batches can nest.
+	void begin_batch();
+	void end_batch();
+
+	void wait_and_flush() {
 		ERR_FAIL_COND(!sync);
 		sync->wait();
-		flush_one();
+		// a batch is published with a single post, so run everything available
+		while (flush_one())
+			;
 	}
 
 	void flush_all() {
@@ -488,6 +550,15 @@ public:
 		unlock();
 	}
 
+	uint32_t get_pending_count() const { return pending_commands; }
+	uint32_t get_pending_count_max() const { return pending_commands_max; }
+	uint64_t get_stall_usec() const { return stall_usec; } //time producers spent waiting for results
+
+	// Statistics of all queues, for the last frame.
+	static void update_frame_statistics(); //called once per frame by Main::iteration()
+	static uint32_t get_frame_pending_max() { return last_frame_pending_max; }
+	static uint64_t get_frame_stall_usec() { return last_frame_stall_usec; }
+
 	CommandQueueMT(bool p_sync);
 	~CommandQueueMT();
 };
@@ -200,6 +200,10 @@ bool PHashTranslation::_set(const StringName &p_name, const Variant &p_value) {
 	} else
 		return false;
 
+	if (TranslationServer::get_singleton()) {
+		TranslationServer::get_singleton()->invalidate_cache();
+	}
+
 	return true;
 }
 
@@ -134,13 +134,21 @@ Array DebuggerMarshalls::ServersProfilerFrame::serialize() {
 		}
 	}
 
-	arr.push_back(script_functions.size() * 4);
+	// Script functions are the bulk of a frame, send them as two packed arrays rather than four Variants each.
+	PackedInt32Array func_ids;
+	PackedFloat32Array func_times;
+	func_ids.resize(script_functions.size() * 2);
+	func_times.resize(script_functions.size() * 2);
+	int32_t *ids = func_ids.ptrw();
+	float *times = func_times.ptrw();
 	for (int i = 0; i < script_functions.size(); i++) {
-		arr.push_back(script_functions[i].sig_id);
-		arr.push_back(script_functions[i].call_count);
-		arr.push_back(script_functions[i].self_time);
-		arr.push_back(script_functions[i].total_time);
+		ids[i * 2] = script_functions[i].sig_id;
+		ids[i * 2 + 1] = script_functions[i].call_count;
+		times[i * 2] = script_functions[i].self_time;
+		times[i * 2 + 1] = script_functions[i].total_time;
 	}
+	arr.push_back(func_ids);
+	arr.push_back(func_times);
 	return arr;
 }
 
@@ -171,18 +179,20 @@ bool DebuggerMarshalls::ServersProfilerFrame::deserialize(const Array &p_arr) {
 		}
 		servers.push_back(si);
 	}
-	CHECK_SIZE(p_arr, idx + 3, "ServersProfilerFrame");
-	int func_size = p_arr[idx];
-	idx += 1;
-	CHECK_SIZE(p_arr, idx + func_size, "ServersProfilerFrame");
-	for (int i = 0; i < func_size / 4; i++) {
-		ScriptFunctionInfo fi;
-		fi.sig_id = p_arr[idx];
-		fi.call_count = p_arr[idx + 1];
-		fi.self_time = p_arr[idx + 2];
-		fi.total_time = p_arr[idx + 3];
-		script_functions.push_back(fi);
-		idx += 4;
+	CHECK_SIZE(p_arr, idx + 2, "ServersProfilerFrame");
+	PackedInt32Array func_ids = p_arr[idx];
+	PackedFloat32Array func_times = p_arr[idx + 1];
+	idx += 2;
+	ERR_FAIL_COND_V_MSG(func_ids.size() != func_times.size() || func_ids.size() % 2, false, "Malformed ServersProfilerFrame message from script debugger, mismatched function data.");
+	script_functions.resize(func_ids.size() / 2);
+	const int32_t *ids = func_ids.ptr();
+	const float *times = func_times.ptr();
+	for (int i = 0; i < script_functions.size(); i++) {
+		ScriptFunctionInfo &fi = script_functions.write[i];
+		fi.sig_id = ids[i * 2];
+		fi.call_count = ids[i * 2 + 1];
+		fi.self_time = times[i * 2];
+		fi.total_time = times[i * 2 + 1];
 	}
 	CHECK_END(p_arr, idx, "ServersProfilerFrame");
 	return true;
@@ -299,31 +309,38 @@ bool DebuggerMarshalls::OutputError::deserialize(const Array &p_arr) {
 }
 
 Array DebuggerMarshalls::VisualProfilerFrame::serialize() {
-	Array arr;
-	arr.push_back(frame_number);
-	arr.push_back(areas.size() * 3);
+	PackedStringArray names;
+	PackedFloat32Array times;
+	names.resize(areas.size());
+	times.resize(areas.size() * 2);
+	String *n = names.ptrw();
+	float *t = times.ptrw();
 	for (int i = 0; i < areas.size(); i++) {
-		arr.push_back(areas[i].name);
-		arr.push_back(areas[i].cpu_msec);
-		arr.push_back(areas[i].gpu_msec);
+		n[i] = areas[i].name;
+		t[i * 2] = areas[i].cpu_msec;
+		t[i * 2 + 1] = areas[i].gpu_msec;
 	}
+
+	Array arr;
+	arr.push_back(frame_number);
+	arr.push_back(names);
+	arr.push_back(times);
 	return arr;
 }
 
 bool DebuggerMarshalls::VisualProfilerFrame::deserialize(const Array &p_arr) {
-	CHECK_SIZE(p_arr, 2, "VisualProfilerFrame");
+	CHECK_SIZE(p_arr, 3, "VisualProfilerFrame");
 	frame_number = p_arr[0];
-	int size = p_arr[1];
-	CHECK_SIZE(p_arr, size, "VisualProfilerFrame");
-	int idx = 2;
-	areas.resize(size / 3);
+	PackedStringArray names = p_arr[1];
+	PackedFloat32Array times = p_arr[2];
+	CHECK_END(p_arr, 3, "VisualProfilerFrame");
+	ERR_FAIL_COND_V_MSG(times.size() != names.size() * 2, false, "Malformed VisualProfilerFrame message from script debugger, mismatched area data.");
+	areas.resize(names.size());
 	RS::FrameProfileArea *w = areas.ptrw();
-	for (int i = 0; i < size / 3; i++) {
-		w[i].name = p_arr[idx];
-		w[i].cpu_msec = p_arr[idx + 1];
-		w[i].gpu_msec = p_arr[idx + 2];
-		idx += 3;
+	for (int i = 0; i < names.size(); i++) {
+		w[i].name = names[i];
+		w[i].cpu_msec = times[i * 2];
+		w[i].gpu_msec = times[i * 2 + 1];
 	}
-	CHECK_END(p_arr, idx, "VisualProfilerFrame");
 	return true;
 }
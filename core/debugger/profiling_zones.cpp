@@ -0,0 +1,134 @@
+/*************************************************************************/
+/*  profiling_zones.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#include "profiling_zones.h"
+
+#include "core/local_vector.h"
+#include "core/os/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+struct ProfilingZonesThreadBuffer {
+	Thread::ID thread_id = 0;
+	String thread_name;
+	ProfilingZones::Event *events = NULL;
+	uint64_t written = 0;
+};
+
+bool ProfilingZones::enabled = false;
+
+static Mutex thread_buffers_mutex;
+static LocalVector<ProfilingZonesThreadBuffer *> thread_buffers;
+static thread_local ProfilingZonesThreadBuffer *thread_buffer = NULL;
+
+static ProfilingZonesThreadBuffer *_get_thread_buffer() {
+
+	if (unlikely(!thread_buffer)) {
+		// Buffers are kept until exit, so events of finished threads can still be saved.
+		thread_buffer = memnew(ProfilingZonesThreadBuffer);
+		thread_buffer->thread_id = Thread::get_caller_id();
+		thread_buffer->events = memnew_arr(ProfilingZones::Event, ProfilingZones::THREAD_EVENT_CAPACITY);
+
+		MutexLock lock(thread_buffers_mutex);
+		thread_buffers.push_back(thread_buffer);
+	}
+	return thread_buffer;
+}
+
+void ProfilingZones::set_enabled(bool p_enabled) {
+	enabled = p_enabled;
+}
+
+uint64_t ProfilingZones::get_ticks() {
+	return OS::get_singleton()->get_ticks_usec();
+}
+
+void ProfilingZones::record(const char *p_name, uint64_t p_begin, uint64_t p_end) {
+
+	ProfilingZonesThreadBuffer *buffer = _get_thread_buffer();
+	Event &e = buffer->events[buffer->written % THREAD_EVENT_CAPACITY];
+	e.name = p_name;
+	e.begin = p_begin;
+	e.end = p_end;
+	buffer->written++;
+}
+
+void ProfilingZones::set_thread_name(const String &p_name) {
+
+	ProfilingZonesThreadBuffer *buffer = _get_thread_buffer();
+	MutexLock lock(thread_buffers_mutex);
+	buffer->thread_name = p_name;
+}
+
+void ProfilingZones::clear() {
+
+	MutexLock lock(thread_buffers_mutex);
+	for (uint32_t i = 0; i < thread_buffers.size(); i++) {
+		thread_buffers[i]->written = 0;
+	}
+}
+
+Error ProfilingZones::save_chrome_trace(const String &p_path) {
+
+	Error err;
+	FileAccessRef f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(!f, err, "Cannot save profiling trace to file '" + p_path + "'.");
+
+	MutexLock lock(thread_buffers_mutex);
+
+	f->store_string("{\"traceEvents\":[\n");
+	bool first = true;
+
+	for (uint32_t i = 0; i < thread_buffers.size(); i++) {
+
+		const ProfilingZonesThreadBuffer *buffer = thread_buffers[i];
+		String tid = itos(buffer->thread_id);
+
+		String thread_name = buffer->thread_name;
+		if (thread_name == String()) {
+			thread_name = buffer->thread_id == Thread::get_main_id() ? "Main" : "Thread " + itos(i);
+		}
+		f->store_string(String(first ? "" : ",\n") + "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":" + tid + ",\"args\":{\"name\":\"" + thread_name.json_escape() + "\"}}");
+		first = false;
+
+		uint64_t count = MIN(buffer->written, (uint64_t)THREAD_EVENT_CAPACITY);
+		for (uint64_t j = buffer->written - count; j < buffer->written; j++) {
+
+			const Event &e = buffer->events[j % THREAD_EVENT_CAPACITY];
+			f->store_string(",\n{\"ph\":\"X\",\"name\":\"" + String(e.name).json_escape() + "\",\"pid\":0,\"tid\":" + tid + ",\"ts\":" + itos(e.begin) + ",\"dur\":" + itos(e.end - e.begin) + "}");
+		}
+	}
+
+	f->store_string("\n]}\n");
+
+	return OK;
+}
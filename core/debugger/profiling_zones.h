@@ -0,0 +1,100 @@
+/*************************************************************************/
+/*  profiling_zones.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#ifndef PROFILING_ZONES_H
+#define PROFILING_ZONES_H
+
+#include "core/ustring.h"
+
+// Scoped CPU zones, recorded per thread into fixed size ring buffers (the oldest events are
+// overwritten) and saved as Chrome trace event JSON, which Perfetto and chrome://tracing open.
+// Zone names must be string literals. Without DEBUG_ENABLED the macros compile to nothing.
+
+class ProfilingZones {
+
+public:
+	enum {
+		THREAD_EVENT_CAPACITY = 1 << 16,
+	};
+
+	struct Event {
+		const char *name;
+		uint64_t begin;
+		uint64_t end;
+	};
+
+private:
+	static bool enabled;
+
+public:
+	_FORCE_INLINE_ static bool is_enabled() { return enabled; }
+	static void set_enabled(bool p_enabled);
+
+	static uint64_t get_ticks();
+	static void record(const char *p_name, uint64_t p_begin, uint64_t p_end);
+	static void set_thread_name(const String &p_name);
+
+	static void clear();
+	// Stop recording before saving, so no thread is writing to its buffer meanwhile.
+	static Error save_chrome_trace(const String &p_path);
+};
+
+class ProfilingZone {
+
+	const char *name;
+	uint64_t begin;
+
+public:
+	_FORCE_INLINE_ ProfilingZone(const char *p_name) {
+		name = ProfilingZones::is_enabled() ? p_name : NULL;
+		begin = name ? ProfilingZones::get_ticks() : 0;
+	}
+	_FORCE_INLINE_ ~ProfilingZone() {
+		if (name) {
+			ProfilingZones::record(name, begin, ProfilingZones::get_ticks());
+		}
+	}
+};
+
+#ifdef DEBUG_ENABLED
+
+#define _PROFILING_ZONE_CONCAT_IMPL(m_a, m_b) m_a##m_b
+#define _PROFILING_ZONE_CONCAT(m_a, m_b) _PROFILING_ZONE_CONCAT_IMPL(m_a, m_b)
+
+#define PROFILING_ZONE(m_name) ProfilingZone _PROFILING_ZONE_CONCAT(_profiling_zone_, __LINE__)(m_name)
+
+#else
+
+#define PROFILING_ZONE(m_name)
+
+#endif
+
+#endif // PROFILING_ZONES_H
@@ -283,8 +283,12 @@ struct RemoteDebugger::ServersProfiler {
 	float physics_time = 0;
 	float physics_frame_time = 0;
 
+	uint64_t frame_interval_usec = 0; // Sampling interval from max_profiler_frames_per_second, 0 sends every frame.
+	uint64_t last_frame_usec = 0;
+
 	void toggle(bool p_enable, const Array &p_opts) {
 		skip_profile_frame = false;
+		last_frame_usec = 0;
 		if (p_enable) {
 			server_data.clear(); // Clear old profiling data.
 		} else {
@@ -313,6 +317,16 @@ struct RemoteDebugger::ServersProfiler {
 		idle_time = p_idle_time;
 		physics_time = p_physics_time;
 		physics_frame_time = p_physics_frame_time;
+		if (frame_interval_usec) {
+			uint64_t now = OS::get_singleton()->get_ticks_usec();
+			if (last_frame_usec && now - last_frame_usec < frame_interval_usec) {
+				for (Map<StringName, ServerInfo>::Element *E = server_data.front(); E; E = E->next()) {
+					E->get().functions.clear();
+				}
+				return; // Not sampled this frame.
+			}
+			last_frame_usec = now;
+		}
 		_send_frame_data(false);
 	}
 
@@ -353,13 +367,24 @@ struct RemoteDebugger::VisualProfiler {
 
 	Map<StringName, ServerInfo> server_data;
 
+	uint64_t frame_interval_usec = 0;
+	uint64_t last_frame_usec = 0;
+
 	void toggle(bool p_enable, const Array &p_opts) {
 		RS::get_singleton()->set_frame_profiling_enabled(p_enable);
+		last_frame_usec = 0;
 	}
 
 	void add(const Array &p_data) {}
 
 	void tick(float p_frame_time, float p_idle_time, float p_physics_time, float p_physics_frame_time) {
+		if (frame_interval_usec) {
+			uint64_t now = OS::get_singleton()->get_ticks_usec();
+			if (last_frame_usec && now - last_frame_usec < frame_interval_usec) {
+				return;
+			}
+			last_frame_usec = now;
+		}
 		Vector<RS::FrameProfileArea> profile_areas = RS::get_singleton()->get_frame_profile();
 		DebuggerMarshalls::VisualProfilerFrame frame;
 		if (!profile_areas.size())
@@ -888,6 +913,12 @@ RemoteDebugger::RemoteDebugger(Ref<RemoteDebuggerPeer> p_peer) {
 	visual_profiler = memnew(VisualProfiler);
 	_bind_profiler("visual", visual_profiler);
 
+	int max_profiler_frames = GLOBAL_GET("network/limits/debugger/max_profiler_frames_per_second");
+	if (max_profiler_frames > 0) {
+		servers_profiler->frame_interval_usec = 1000000 / max_profiler_frames;
+		visual_profiler->frame_interval_usec = 1000000 / max_profiler_frames;
+	}
+
 	// Performance Profiler
 	Object *perf = Engine::get_singleton()->get_singleton_object("Performance");
 	if (perf) {
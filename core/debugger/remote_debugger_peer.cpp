@@ -30,6 +30,7 @@
 
 #include "remote_debugger_peer.h"
 
+#include "core/io/compression.h"
 #include "core/io/marshalls.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
@@ -107,11 +108,28 @@ void RemoteDebuggerPeerTCP::_write_out() {
 			mutex.unlock();
 			int size = 0;
 			Error err = encode_variant(var, NULL, size);
-			ERR_CONTINUE(err != OK || size > out_buf.size() - 4); // 4 bytes separator.
-			encode_uint32(size, buf);
-			encode_variant(var, buf + 4, size);
-			out_left = size + 4;
+			ERR_CONTINUE(err != OK || size > out_buf.size() - 8); // 4 bytes separator, 4 bytes raw size when compressed.
 			out_pos = 0;
+			if (compress && size >= int(COMPRESS_MIN_SIZE) && Compression::get_max_compressed_buffer_size(size, Compression::MODE_ZSTD) <= out_buf.size() - 8) {
+				if (encode_buf.size() < size) {
+					encode_buf.resize(size);
+				}
+				encode_variant(var, encode_buf.ptrw(), size);
+				int compressed = Compression::compress(buf + 8, encode_buf.ptr(), size, Compression::MODE_ZSTD);
+				if (compressed > 0 && compressed + 4 < size) {
+					encode_uint32((compressed + 4) | COMPRESSED_FLAG, buf);
+					encode_uint32(size, buf + 4);
+					out_left = compressed + 8;
+				} else {
+					encode_uint32(size, buf);
+					memcpy(buf + 4, encode_buf.ptr(), size);
+					out_left = size + 4;
+				}
+			} else {
+				encode_uint32(size, buf);
+				encode_variant(var, buf + 4, size);
+				out_left = size + 4;
+			}
 		}
 		int sent = 0;
 		tcp_client->put_partial_data(buf + out_pos, out_left, sent);
@@ -130,10 +148,13 @@ void RemoteDebuggerPeerTCP::_read_in() {
 			if (tcp_client->get_available_bytes() < 4) {
 				break; // Need 4 more bytes.
 			}
-			uint32_t size = 0;
+			uint8_t header[4];
 			int read = 0;
-			Error err = tcp_client->get_partial_data((uint8_t *)&size, 4, read);
-			ERR_CONTINUE(read != 4 || err != OK || size > (uint32_t)in_buf.size());
+			Error err = tcp_client->get_partial_data(header, 4, read);
+			uint32_t size = decode_uint32(header);
+			in_compressed = size & COMPRESSED_FLAG;
+			size &= ~COMPRESSED_FLAG;
+			ERR_CONTINUE(read != 4 || err != OK || size > (uint32_t)in_buf.size() || (in_compressed && size < 4));
 			in_left = size;
 			in_pos = 0;
 		}
@@ -142,9 +163,22 @@ void RemoteDebuggerPeerTCP::_read_in() {
 		in_left -= read;
 		in_pos += read;
 		if (in_left == 0) {
+			const uint8_t *data = buf;
+			int data_size = in_pos;
+			if (in_compressed) {
+				int raw_size = decode_uint32(buf);
+				ERR_CONTINUE_MSG(raw_size <= 0 || raw_size > get_max_message_size(), "Malformed packet received, invalid size.");
+				if (decode_buf.size() < raw_size) {
+					decode_buf.resize(raw_size);
+				}
+				int ret = Compression::decompress(decode_buf.ptrw(), raw_size, buf + 4, in_pos - 4, Compression::MODE_ZSTD);
+				ERR_CONTINUE_MSG(ret != raw_size, "Malformed packet received, decompression failed.");
+				data = decode_buf.ptr();
+				data_size = raw_size;
+			}
 			Variant var;
-			Error err = decode_variant(var, buf, in_pos, &read);
-			ERR_CONTINUE(read != in_pos || err != OK);
+			Error err = decode_variant(var, data, data_size, &read);
+			ERR_CONTINUE(read != data_size || err != OK);
 			ERR_CONTINUE_MSG(var.get_type() != Variant::ARRAY, "Malformed packet received, not an Array.");
 			mutex.lock();
 			in_queue.push_back(var);
@@ -239,4 +273,5 @@ Ref<RemoteDebuggerPeer> RemoteDebuggerPeer::create_from_uri(const String p_uri)
 
 RemoteDebuggerPeer::RemoteDebuggerPeer() {
 	max_queued_messages = (int)GLOBAL_GET("network/limits/debugger/max_queued_messages");
+	compress = GLOBAL_GET("network/limits/debugger/compress_messages");
 }
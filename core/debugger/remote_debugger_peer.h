@@ -40,6 +40,7 @@
 class RemoteDebuggerPeer : public Reference {
 protected:
 	int max_queued_messages = 4096;
+	bool compress = true;
 
 public:
 	static Ref<RemoteDebuggerPeer> create_from_uri(const String p_uri);
@@ -56,6 +57,11 @@ public:
 
 class RemoteDebuggerPeerTCP : public RemoteDebuggerPeer {
 private:
+	enum {
+		COMPRESS_MIN_SIZE = 1024, // Smaller messages are not worth compressing.
+		COMPRESSED_FLAG = 0x80000000, // Set in the size prefix, the payload is the raw size followed by zstd data.
+	};
+
 	Ref<StreamPeerTCP> tcp_client;
 	Mutex mutex;
 	Thread *thread = NULL;
@@ -67,6 +73,9 @@ private:
 	int in_left = 0;
 	int in_pos = 0;
 	Vector<uint8_t> in_buf;
+	Vector<uint8_t> encode_buf;
+	Vector<uint8_t> decode_buf;
+	bool in_compressed = false;
 	bool connected = false;
 	bool running = false;
 
@@ -30,86 +30,433 @@
 
 #include "dictionary.h"
 
-#include "core/ordered_hash_map.h"
+#include "core/local_vector.h"
 #include "core/safe_refcount.h"
 #include "core/variant.h"
 
 struct DictionaryPrivate {
 
+	//entries live in pages that never move, so pointers to keys and values stay valid while the dictionary
+	//changes, page 0 and 1 hold 4 entries and each following page doubles the size; erased entries go to a
+	//free list and are reused by later inserts, insertion order is kept as a separate array of entry ids;
+	//lookups go through a power of two index table with linear probing, kept at most 3/4 full;
+	//erasing leaves a gap in the order array, gaps are only closed when most of it is gone, which rewrites
+	//ids in that array but never moves an entry (callers may insert or erase while holding getptr() or next() pointers)
+
+	enum {
+		FIRST_PAGE_SIZE = 4,
+		EMPTY_SLOT = 0xFFFFFFFF,
+		MIN_SLOT_BITS = 3,
+	};
+
+	struct Entry {
+		Variant key;
+		Variant value;
+		uint32_t hash;
+		uint32_t order; //position in the order array, or the next free entry once erased
+	};
+
+	struct Slot {
+		uint32_t hash;
+		uint32_t entry;
+	};
+
 	SafeRefCount refcount;
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> variant_map;
+
+	LocalVector<Entry *> pages;
+	uint32_t entry_count; //entries constructed in the pages, free ones included
+	uint32_t free_entry;
+
+	LocalVector<uint32_t> order; //entry ids in insertion order, EMPTY_SLOT where one was erased
+	uint32_t erased_count;
+	bool has_erased; //entry ids may no longer match their order, since the last clear
+
+	Slot *slots;
+	uint32_t slot_bits;
+
+	static _FORCE_INLINE_ uint32_t _get_page(uint32_t p_entry) {
+		if (p_entry < uint32_t(FIRST_PAGE_SIZE)) {
+			return 0;
+		}
+#if defined(__GNUC__)
+		return 30 - __builtin_clz(p_entry);
+#else
+		return nearest_shift(p_entry) - 2;
+#endif
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_page_base(uint32_t p_page) {
+		return p_page == 0 ? 0 : (1U << (p_page + 1));
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_page_size(uint32_t p_page) {
+		return p_page == 0 ? uint32_t(FIRST_PAGE_SIZE) : (1U << (p_page + 1));
+	}
+
+	_FORCE_INLINE_ Entry &get_entry(uint32_t p_entry) const {
+		uint32_t page = _get_page(p_entry);
+		return pages[page][p_entry - _get_page_base(page)];
+	}
+
+	//entry at a position of the order array, NULL if it was erased
+	_FORCE_INLINE_ const Entry *get_ordered(uint32_t p_pos) const {
+		uint32_t entry = order[p_pos];
+		return entry == EMPTY_SLOT ? NULL : &get_entry(entry);
+	}
+
+	_FORCE_INLINE_ uint32_t size() const {
+		return order.size() - erased_count;
+	}
+
+	_FORCE_INLINE_ uint32_t _get_home_slot(uint32_t p_hash) const {
+		//fibonacci hashing, keys such as sequential integers have poor low bits
+		return (p_hash * 2654435769U) >> (32 - slot_bits);
+	}
+
+	uint32_t find(const Variant &p_key) const {
+
+		if (!slots) {
+			return EMPTY_SLOT;
+		}
+
+		uint32_t hash = VariantHasher::hash(p_key);
+		uint32_t mask = (1 << slot_bits) - 1;
+		uint32_t pos = _get_home_slot(hash);
+
+		while (true) {
+			const Slot &slot = slots[pos];
+			if (slot.entry == EMPTY_SLOT) {
+				return EMPTY_SLOT;
+			}
+			if (slot.hash == hash && VariantComparator::compare(get_entry(slot.entry).key, p_key)) {
+				return slot.entry;
+			}
+			pos = (pos + 1) & mask;
+		}
+	}
+
+	void _insert_slot(uint32_t p_hash, uint32_t p_entry) {
+
+		uint32_t mask = (1 << slot_bits) - 1;
+		uint32_t pos = _get_home_slot(p_hash);
+		while (slots[pos].entry != EMPTY_SLOT) {
+			pos = (pos + 1) & mask;
+		}
+		slots[pos].hash = p_hash;
+		slots[pos].entry = p_entry;
+	}
+
+	void _allocate_slots(uint32_t p_bits) {
+
+		if (slots) {
+			memfree(slots);
+		}
+
+		slot_bits = p_bits;
+		uint32_t capacity = 1 << slot_bits;
+		slots = (Slot *)memalloc(sizeof(Slot) * capacity);
+		for (uint32_t i = 0; i < capacity; i++) {
+			slots[i].entry = EMPTY_SLOT;
+		}
+	}
+
+	void _rebuild_slots(uint32_t p_bits) {
+
+		_allocate_slots(p_bits);
+		for (uint32_t i = 0; i < order.size(); i++) {
+			if (order[i] != EMPTY_SLOT) {
+				_insert_slot(get_entry(order[i]).hash, order[i]);
+			}
+		}
+	}
+
+	static uint32_t _get_slot_bits_for(uint32_t p_size) {
+
+		uint32_t bits = MIN_SLOT_BITS;
+		while ((p_size * 4) > ((1U << bits) * 3)) {
+			bits++;
+		}
+		return bits;
+	}
+
+	uint32_t _append_entry(const Variant &p_key, uint32_t p_hash) {
+
+		uint32_t id;
+		if (free_entry != EMPTY_SLOT) {
+			id = free_entry;
+			free_entry = get_entry(id).order;
+		} else {
+			id = entry_count;
+			uint32_t page = _get_page(id);
+			if (page == pages.size()) {
+				pages.push_back((Entry *)memalloc(sizeof(Entry) * _get_page_size(page)));
+			}
+			memnew_placement(&pages[page][id - _get_page_base(page)], Entry);
+			entry_count++;
+		}
+
+		Entry &e = get_entry(id);
+		e.key = p_key;
+		e.hash = p_hash;
+		e.order = order.size();
+		order.push_back(id);
+		return id;
+	}
+
+	void _compact_order() {
+
+		//only the ids move, entries stay where they are
+		uint32_t to = 0;
+		for (uint32_t i = 0; i < order.size(); i++) {
+			uint32_t entry = order[i];
+			if (entry == EMPTY_SLOT) {
+				continue;
+			}
+			order[to] = entry;
+			get_entry(entry).order = to;
+			to++;
+		}
+		order.resize(to);
+		erased_count = 0;
+	}
+
+	Variant &insert(const Variant &p_key) {
+
+		uint32_t new_size = size() + 1;
+		if (erased_count > size()) {
+			//most of the order array is gaps, close them so iteration stays proportional to the size
+			_compact_order();
+		}
+		if (!slots || new_size * 4 > (1U << slot_bits) * 3) {
+			_rebuild_slots(_get_slot_bits_for(new_size));
+		}
+
+		uint32_t hash = VariantHasher::hash(p_key);
+		uint32_t entry = _append_entry(p_key, hash);
+		_insert_slot(hash, entry);
+		return get_entry(entry).value;
+	}
+
+	bool erase(const Variant &p_key) {
+
+		if (!slots) {
+			return false;
+		}
+
+		uint32_t hash = VariantHasher::hash(p_key);
+		uint32_t mask = (1 << slot_bits) - 1;
+		uint32_t pos = _get_home_slot(hash);
+
+		while (true) {
+			const Slot &slot = slots[pos];
+			if (slot.entry == EMPTY_SLOT) {
+				return false;
+			}
+			if (slot.hash == hash && VariantComparator::compare(get_entry(slot.entry).key, p_key)) {
+				break;
+			}
+			pos = (pos + 1) & mask;
+		}
+
+		uint32_t entry = slots[pos].entry;
+		Entry &e = get_entry(entry);
+		order[e.order] = EMPTY_SLOT;
+		erased_count++;
+		has_erased = true;
+
+		e.key = Variant();
+		e.value = Variant();
+		e.order = free_entry;
+		free_entry = entry;
+
+		//backward shift deletion, so the table never needs tombstones
+		uint32_t hole = pos;
+		uint32_t next = (pos + 1) & mask;
+		while (slots[next].entry != EMPTY_SLOT) {
+			uint32_t home = _get_home_slot(slots[next].hash);
+			if (((next - home) & mask) >= ((next - hole) & mask)) {
+				slots[hole] = slots[next];
+				hole = next;
+			}
+			next = (next + 1) & mask;
+		}
+		slots[hole].entry = EMPTY_SLOT;
+
+		if (size() == 0) {
+			clear();
+		}
+
+		return true;
+	}
+
+	//first position of the order array from p_pos that is not erased
+	uint32_t get_next(uint32_t p_pos) const {
+
+		for (uint32_t i = p_pos; i < order.size(); i++) {
+			if (order[i] != EMPTY_SLOT) {
+				return i;
+			}
+		}
+		return EMPTY_SLOT;
+	}
+
+	uint32_t get_at_index(int p_index) const {
+
+		if (p_index < 0 || (uint32_t)p_index >= size()) {
+			return EMPTY_SLOT;
+		}
+		if (erased_count == 0) {
+			return order[p_index];
+		}
+
+		int index = 0;
+		for (uint32_t i = 0; i < order.size(); i++) {
+			if (order[i] == EMPTY_SLOT) {
+				continue;
+			}
+			if (index == p_index) {
+				return order[i];
+			}
+			index++;
+		}
+		return EMPTY_SLOT;
+	}
+
+	void copy_from(const DictionaryPrivate *p_from, bool p_deep) {
+
+		//copies are dense, hashes are reused so keys are never hashed again
+		order.reserve(p_from->size());
+		for (uint32_t i = 0; i < p_from->order.size(); i++) {
+			const Entry *src = p_from->get_ordered(i);
+			if (!src) {
+				continue;
+			}
+			Entry &dst = get_entry(_append_entry(src->key, src->hash));
+			dst.value = p_deep ? src->value.duplicate(true) : src->value;
+		}
+
+		if (!p_from->slots) {
+			return;
+		}
+
+		if (!p_from->has_erased) {
+			//entry ids match their order in both, so the index table can be copied as is
+			slot_bits = p_from->slot_bits;
+			slots = (Slot *)memalloc(sizeof(Slot) * (1 << slot_bits));
+			memcpy(slots, p_from->slots, sizeof(Slot) * (1 << slot_bits));
+		} else {
+			_rebuild_slots(_get_slot_bits_for(order.size()));
+		}
+	}
+
+	void clear() {
+
+		for (uint32_t i = 0; i < entry_count; i++) {
+			get_entry(i).~Entry();
+		}
+		for (uint32_t i = 0; i < pages.size(); i++) {
+			memfree(pages[i]);
+		}
+		pages.clear();
+		entry_count = 0;
+		free_entry = EMPTY_SLOT;
+
+		order.clear();
+		erased_count = 0;
+		has_erased = false;
+
+		if (slots) {
+			memfree(slots);
+			slots = NULL;
+		}
+		slot_bits = 0;
+	}
+
+	DictionaryPrivate() :
+			entry_count(0),
+			free_entry(EMPTY_SLOT),
+			erased_count(0),
+			has_erased(false),
+			slots(NULL),
+			slot_bits(0) {
+	}
+
+	~DictionaryPrivate() {
+		clear();
+	}
 };
 
 void Dictionary::get_key_list(List<Variant> *p_keys) const {
 
-	if (_p->variant_map.empty())
-		return;
-
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		p_keys->push_back(E.key());
+	for (uint32_t i = 0; i < _p->order.size(); i++) {
+		const DictionaryPrivate::Entry *e = _p->get_ordered(i);
+		if (e) {
+			p_keys->push_back(e->key);
+		}
 	}
 }
 
 Variant Dictionary::get_key_at_index(int p_index) const {
 
-	int index = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		if (index == p_index) {
-			return E.key();
-		}
-		index++;
+	uint32_t entry = _p->get_at_index(p_index);
+	if (entry == DictionaryPrivate::EMPTY_SLOT) {
+		return Variant();
 	}
 
-	return Variant();
+	return _p->get_entry(entry).key;
 }
 
 Variant Dictionary::get_value_at_index(int p_index) const {
 
-	int index = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		if (index == p_index) {
-			return E.value();
-		}
-		index++;
+	uint32_t entry = _p->get_at_index(p_index);
+	if (entry == DictionaryPrivate::EMPTY_SLOT) {
+		return Variant();
 	}
 
-	return Variant();
+	return _p->get_entry(entry).value;
 }
 
 Variant &Dictionary::operator[](const Variant &p_key) {
 
-	return _p->variant_map[p_key];
+	uint32_t entry = _p->find(p_key);
+	if (entry == DictionaryPrivate::EMPTY_SLOT) {
+		return _p->insert(p_key);
+	}
+
+	return _p->get_entry(entry).value;
 }
 
 const Variant &Dictionary::operator[](const Variant &p_key) const {
 
-	return _p->variant_map[p_key];
+	uint32_t entry = _p->find(p_key);
+	CRASH_COND(entry == DictionaryPrivate::EMPTY_SLOT);
+	return _p->get_entry(entry).value;
 }
 const Variant *Dictionary::getptr(const Variant &p_key) const {
 
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::ConstElement E = ((const OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> *)&_p->variant_map)->find(p_key);
+	uint32_t entry = _p->find(p_key);
 
-	if (!E)
+	if (entry == DictionaryPrivate::EMPTY_SLOT)
 		return NULL;
-	return &E.get();
+	return &_p->get_entry(entry).value;
 }
 
 Variant *Dictionary::getptr(const Variant &p_key) {
 
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.find(p_key);
+	uint32_t entry = _p->find(p_key);
 
-	if (!E)
+	if (entry == DictionaryPrivate::EMPTY_SLOT)
 		return NULL;
-	return &E.get();
+	return &_p->get_entry(entry).value;
 }
 
 Variant Dictionary::get_valid(const Variant &p_key) const {
 
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::ConstElement E = ((const OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator> *)&_p->variant_map)->find(p_key);
+	const Variant *result = getptr(p_key);
 
-	if (!E)
+	if (!result)
 		return Variant();
-	return E.get();
+	return *result;
 }
 
 Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
@@ -123,16 +470,16 @@ Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
 
 int Dictionary::size() const {
 
-	return _p->variant_map.size();
+	return _p->size();
 }
 bool Dictionary::empty() const {
 
-	return !_p->variant_map.size();
+	return !_p->size();
 }
 
 bool Dictionary::has(const Variant &p_key) const {
 
-	return _p->variant_map.has(p_key);
+	return _p->find(p_key) != DictionaryPrivate::EMPTY_SLOT;
 }
 
 bool Dictionary::has_all(const Array &p_keys) const {
@@ -146,7 +493,7 @@ bool Dictionary::has_all(const Array &p_keys) const {
 
 bool Dictionary::erase(const Variant &p_key) {
 
-	return _p->variant_map.erase(p_key);
+	return _p->erase(p_key);
 }
 
 bool Dictionary::operator==(const Dictionary &p_dictionary) const {
@@ -177,7 +524,7 @@ void Dictionary::_ref(const Dictionary &p_from) const {
 
 void Dictionary::clear() {
 
-	_p->variant_map.clear();
+	_p->clear();
 }
 
 void Dictionary::_unref() const {
@@ -192,9 +539,13 @@ uint32_t Dictionary::hash() const {
 
 	uint32_t h = hash_djb2_one_32(Variant::DICTIONARY);
 
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		h = hash_djb2_one_32(E.key().hash(), h);
-		h = hash_djb2_one_32(E.value().hash(), h);
+	for (uint32_t i = 0; i < _p->order.size(); i++) {
+		const DictionaryPrivate::Entry *e = _p->get_ordered(i);
+		if (!e) {
+			continue;
+		}
+		h = hash_djb2_one_32(e->key.hash(), h);
+		h = hash_djb2_one_32(e->value.hash(), h);
 	}
 
 	return h;
@@ -203,15 +554,18 @@ uint32_t Dictionary::hash() const {
 Array Dictionary::keys() const {
 
 	Array varr;
-	if (_p->variant_map.empty())
+	if (_p->size() == 0)
 		return varr;
 
 	varr.resize(size());
 
 	int i = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		varr[i] = E.key();
-		i++;
+	for (uint32_t j = 0; j < _p->order.size(); j++) {
+		const DictionaryPrivate::Entry *e = _p->get_ordered(j);
+		if (e) {
+			varr[i] = e->key;
+			i++;
+		}
 	}
 
 	return varr;
@@ -220,15 +574,18 @@ Array Dictionary::keys() const {
 Array Dictionary::values() const {
 
 	Array varr;
-	if (_p->variant_map.empty())
+	if (_p->size() == 0)
 		return varr;
 
 	varr.resize(size());
 
 	int i = 0;
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		varr[i] = E.get();
-		i++;
+	for (uint32_t j = 0; j < _p->order.size(); j++) {
+		const DictionaryPrivate::Entry *e = _p->get_ordered(j);
+		if (e) {
+			varr[i] = e->value;
+			i++;
+		}
 	}
 
 	return varr;
@@ -236,27 +593,26 @@ Array Dictionary::values() const {
 
 const Variant *Dictionary::next(const Variant *p_key) const {
 
+	uint32_t pos;
 	if (p_key == NULL) {
 		// caller wants to get the first element
-		if (_p->variant_map.front())
-			return &_p->variant_map.front().key();
-		return NULL;
+		pos = _p->get_next(0);
+	} else {
+		uint32_t entry = _p->find(*p_key);
+		if (entry == DictionaryPrivate::EMPTY_SLOT)
+			return NULL;
+		pos = _p->get_next(_p->get_entry(entry).order + 1);
 	}
-	OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.find(*p_key);
 
-	if (E && E.next())
-		return &E.next().key();
-	return NULL;
+	if (pos == DictionaryPrivate::EMPTY_SLOT)
+		return NULL;
+	return &_p->get_ordered(pos)->key;
 }
 
 Dictionary Dictionary::duplicate(bool p_deep) const {
 
 	Dictionary n;
-
-	for (OrderedHashMap<Variant, Variant, VariantHasher, VariantComparator>::Element E = _p->variant_map.front(); E; E = E.next()) {
-		n[E.key()] = p_deep ? E.value().duplicate(true) : E.value();
-	}
-
+	n._p->copy_from(_p, p_deep);
 	return n;
 }
 
@@ -266,7 +622,7 @@ void Dictionary::operator=(const Dictionary &p_dictionary) {
 }
 
 const void *Dictionary::id() const {
-	return _p->variant_map.id();
+	return _p;
 }
 
 Dictionary::Dictionary(const Dictionary &p_from) {
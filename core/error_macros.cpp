@@ -31,6 +31,7 @@
 #include "error_macros.h"
 
 #include "core/io/logger.h"
+#include "core/os/mutex.h"
 #include "core/ustring.h"
 #include "os/os.h"
 
@@ -76,7 +77,65 @@ void _err_print_error(const char *p_function, const char *p_file, int p_line, co
 	_err_print_error(p_function, p_file, p_line, p_error.utf8().get_data(), "", p_type);
 }
 
-void _err_print_error(const char *p_function, const char *p_file, int p_line, const char *p_error, const char *p_message, ErrorHandlerType p_type) {
+// Errors and warnings repeated from the same place are rate limited, so spam
+// doesn't stall the frame. The amount skipped comes with the next one printed.
+static const int ERR_RATE_SLOTS = 256;
+static const uint32_t ERR_RATE_MAX_PER_WINDOW = 10;
+static const uint64_t ERR_RATE_WINDOW_USEC = 1000000;
+
+struct ErrorRateSlot {
+	const char *file = NULL;
+	int line = 0;
+	uint64_t window_begin = 0;
+	uint32_t count = 0;
+	uint32_t suppressed = 0;
+};
+
+static ErrorRateSlot err_rate_slots[ERR_RATE_SLOTS];
+static BinaryMutex err_rate_mutex;
+
+static bool _err_rate_check(const char *p_file, int p_line, ErrorHandlerType p_type, uint32_t &r_suppressed) {
+
+	r_suppressed = 0;
+	if (p_type == ERR_HANDLER_SCRIPT || p_type == ERR_HANDLER_SHADER || !p_file) {
+		return true; // file names of these are not string literals
+	}
+
+	uint64_t now = OS::get_singleton()->get_ticks_usec();
+	uint32_t hash = (uint32_t)(((uintptr_t)p_file >> 3) * 31 + p_line);
+
+	MutexLock lock(err_rate_mutex);
+	ErrorRateSlot &slot = err_rate_slots[hash % ERR_RATE_SLOTS];
+
+	if (slot.file != p_file || slot.line != p_line) {
+		slot.file = p_file;
+		slot.line = p_line;
+		slot.window_begin = now;
+		slot.count = 0;
+		slot.suppressed = 0;
+	} else if (now - slot.window_begin > ERR_RATE_WINDOW_USEC) {
+		slot.window_begin = now;
+		slot.count = 0;
+	}
+
+	if (slot.count >= ERR_RATE_MAX_PER_WINDOW) {
+		slot.suppressed++;
+		return false;
+	}
+
+	slot.count++;
+	r_suppressed = slot.suppressed;
+	slot.suppressed = 0;
+	return true;
+}
+
+static void _err_print_error_unlimited(const char *p_function, const char *p_file, int p_line, const char *p_error, const char *p_message, uint32_t p_suppressed, ErrorHandlerType p_type) {
+
+	CharString counted_message;
+	if (p_suppressed) {
+		counted_message = (String::utf8(p_message) + " (" + itos(p_suppressed) + " more like this were skipped)").utf8();
+		p_message = counted_message.get_data();
+	}
 
 	OS::get_singleton()->print_error(p_function, p_file, p_line, p_error, p_message, (Logger::ErrorType)p_type);
 
@@ -91,6 +150,15 @@ void _err_print_error(const char *p_function, const char *p_file, int p_line, co
 	_global_unlock();
 }
 
+void _err_print_error(const char *p_function, const char *p_file, int p_line, const char *p_error, const char *p_message, ErrorHandlerType p_type) {
+
+	uint32_t suppressed;
+	if (!_err_rate_check(p_file, p_line, p_type, suppressed)) {
+		return;
+	}
+	_err_print_error_unlimited(p_function, p_file, p_line, p_error, p_message, suppressed, p_type);
+}
+
 void _err_print_error(const char *p_function, const char *p_file, int p_line, const String &p_error, const char *p_message, ErrorHandlerType p_type) {
 	_err_print_error(p_function, p_file, p_line, p_error.utf8().get_data(), p_message, p_type);
 }
@@ -105,9 +173,14 @@ void _err_print_error(const char *p_function, const char *p_file, int p_line, co
 
 void _err_print_index_error(const char *p_function, const char *p_file, int p_line, int64_t p_index, int64_t p_size, const char *p_index_str, const char *p_size_str, const char *p_message, bool fatal) {
 
+	uint32_t suppressed;
+	if (!fatal && !_err_rate_check(p_file, p_line, ERR_HANDLER_ERROR, suppressed)) {
+		return; // skipped before formatting anything
+	}
+
 	String fstr(fatal ? "FATAL: " : "");
 	String err(fstr + "Index " + p_index_str + " = " + itos(p_index) + " is out of bounds (" + p_size_str + " = " + itos(p_size) + ").");
-	_err_print_error(p_function, p_file, p_line, err.utf8().get_data(), p_message);
+	_err_print_error_unlimited(p_function, p_file, p_line, err.utf8().get_data(), p_message, fatal ? 0 : suppressed, ERR_HANDLER_ERROR);
 }
 
 void _err_print_index_error(const char *p_function, const char *p_file, int p_line, int64_t p_index, int64_t p_size, const char *p_index_str, const char *p_size_str, const String &p_message, bool fatal) {
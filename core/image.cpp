@@ -36,11 +36,25 @@
 #include "core/math/math_funcs.h"
 #include "core/os/copymem.h"
 #include "core/print_string.h"
+#include "core/thread_work_pool.h"
 
 #include "thirdparty/misc/hq2x.h"
 
 #include <stdio.h>
 
+// Vector paths for the RGBA8 and RGBAF mipmap kernels. SSE2 is always there on
+// x86_64 and NEON on arm64, so they are picked at build time. Build with
+// NO_IMAGE_SIMD to always use the scalar loops.
+#ifndef NO_IMAGE_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define IMAGE_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
 const char *Image::format_names[Image::FORMAT_MAX] = {
 	"Lum8", //luminance
 	"LumAlpha8", //luminance-alpha
@@ -389,17 +403,71 @@ int Image::get_mipmap_count() const {
 		return 0;
 }
 
+// Per pixel kernels write rows [p_from_row, p_to_row) of the destination and
+// only read the source, so bands of rows can run on the work pool at once.
+typedef void (*ImageRowsFunc)(const uint8_t *p_src, uint8_t *p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row);
+
+#define IMAGE_PARALLEL_MIN_PIXELS (256 * 256)
+#define IMAGE_BAND_PIXELS 16384
+
+struct ImageRowsJob {
+
+	ImageRowsFunc func;
+	const uint8_t *src;
+	uint8_t *dst;
+	uint32_t src_width;
+	uint32_t src_height;
+	uint32_t dst_width;
+	uint32_t dst_height;
+	uint32_t band_rows;
+
+	void process_band(uint32_t p_band, void *p_unused) {
+
+		uint32_t from = p_band * band_rows;
+		func(src, dst, src_width, src_height, dst_width, dst_height, from, MIN(from + band_rows, dst_height));
+	}
+};
+
+static void _process_rows(ImageRowsFunc p_func, const uint8_t *p_src, uint8_t *p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+
+	if (pool && pool->get_thread_count() > 0 && p_dst_height > 1 && p_dst_width * p_dst_height >= IMAGE_PARALLEL_MIN_PIXELS) {
+
+		ImageRowsJob job;
+		job.func = p_func;
+		job.src = p_src;
+		job.dst = p_dst;
+		job.src_width = p_src_width;
+		job.src_height = p_src_height;
+		job.dst_width = p_dst_width;
+		job.dst_height = p_dst_height;
+		job.band_rows = MAX(1u, IMAGE_BAND_PIXELS / p_dst_width);
+
+		uint32_t bands = (p_dst_height + job.band_rows - 1) / job.band_rows;
+		pool->do_work(bands, &job, &ImageRowsJob::process_band, (void *)NULL);
+	} else {
+		p_func(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height, 0, p_dst_height);
+	}
+}
+
+//halves the size, like the mipmap chain does
+static void _process_mipmap(ImageRowsFunc p_func, const uint8_t *p_src, uint8_t *p_dst, uint32_t p_width, uint32_t p_height) {
+
+	_process_rows(p_func, p_src, p_dst, p_width, p_height, MAX(p_width >> 1, 1u), MAX(p_height >> 1, 1u));
+}
+
 //using template generates perfectly optimized code due to constant expression reduction and unused variable removal present in all compilers
 template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
-static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
+static void _convert(const uint8_t *p_src, uint8_t *p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 
 	uint32_t max_bytes = MAX(read_bytes, write_bytes);
 
-	for (int y = 0; y < p_height; y++) {
-		for (int x = 0; x < p_width; x++) {
+	for (uint32_t y = p_from_row; y < p_to_row; y++) {
+		for (uint32_t x = 0; x < p_dst_width; x++) {
 
-			const uint8_t *rofs = &p_src[((y * p_width) + x) * (read_bytes + (read_alpha ? 1 : 0))];
-			uint8_t *wofs = &p_dst[((y * p_width) + x) * (write_bytes + (write_alpha ? 1 : 0))];
+			const uint8_t *rofs = &p_src[((y * p_dst_width) + x) * (read_bytes + (read_alpha ? 1 : 0))];
+			uint8_t *wofs = &p_dst[((y * p_dst_width) + x) * (write_bytes + (write_alpha ? 1 : 0))];
 
 			uint8_t rgba[4];
 
@@ -478,36 +546,36 @@ void Image::convert(Format p_new_format) {
 
 	switch (conversion_type) {
 
-		case FORMAT_L8 | (FORMAT_LA8 << 8): _convert<1, false, 1, true, true, true>(width, height, rptr, wptr); break;
-		case FORMAT_L8 | (FORMAT_R8 << 8): _convert<1, false, 1, false, true, false>(width, height, rptr, wptr); break;
-		case FORMAT_L8 | (FORMAT_RG8 << 8): _convert<1, false, 2, false, true, false>(width, height, rptr, wptr); break;
-		case FORMAT_L8 | (FORMAT_RGB8 << 8): _convert<1, false, 3, false, true, false>(width, height, rptr, wptr); break;
-		case FORMAT_L8 | (FORMAT_RGBA8 << 8): _convert<1, false, 3, true, true, false>(width, height, rptr, wptr); break;
-		case FORMAT_LA8 | (FORMAT_L8 << 8): _convert<1, true, 1, false, true, true>(width, height, rptr, wptr); break;
-		case FORMAT_LA8 | (FORMAT_R8 << 8): _convert<1, true, 1, false, true, false>(width, height, rptr, wptr); break;
-		case FORMAT_LA8 | (FORMAT_RG8 << 8): _convert<1, true, 2, false, true, false>(width, height, rptr, wptr); break;
-		case FORMAT_LA8 | (FORMAT_RGB8 << 8): _convert<1, true, 3, false, true, false>(width, height, rptr, wptr); break;
-		case FORMAT_LA8 | (FORMAT_RGBA8 << 8): _convert<1, true, 3, true, true, false>(width, height, rptr, wptr); break;
-		case FORMAT_R8 | (FORMAT_L8 << 8): _convert<1, false, 1, false, false, true>(width, height, rptr, wptr); break;
-		case FORMAT_R8 | (FORMAT_LA8 << 8): _convert<1, false, 1, true, false, true>(width, height, rptr, wptr); break;
-		case FORMAT_R8 | (FORMAT_RG8 << 8): _convert<1, false, 2, false, false, false>(width, height, rptr, wptr); break;
-		case FORMAT_R8 | (FORMAT_RGB8 << 8): _convert<1, false, 3, false, false, false>(width, height, rptr, wptr); break;
-		case FORMAT_R8 | (FORMAT_RGBA8 << 8): _convert<1, false, 3, true, false, false>(width, height, rptr, wptr); break;
-		case FORMAT_RG8 | (FORMAT_L8 << 8): _convert<2, false, 1, false, false, true>(width, height, rptr, wptr); break;
-		case FORMAT_RG8 | (FORMAT_LA8 << 8): _convert<2, false, 1, true, false, true>(width, height, rptr, wptr); break;
-		case FORMAT_RG8 | (FORMAT_R8 << 8): _convert<2, false, 1, false, false, false>(width, height, rptr, wptr); break;
-		case FORMAT_RG8 | (FORMAT_RGB8 << 8): _convert<2, false, 3, false, false, false>(width, height, rptr, wptr); break;
-		case FORMAT_RG8 | (FORMAT_RGBA8 << 8): _convert<2, false, 3, true, false, false>(width, height, rptr, wptr); break;
-		case FORMAT_RGB8 | (FORMAT_L8 << 8): _convert<3, false, 1, false, false, true>(width, height, rptr, wptr); break;
-		case FORMAT_RGB8 | (FORMAT_LA8 << 8): _convert<3, false, 1, true, false, true>(width, height, rptr, wptr); break;
-		case FORMAT_RGB8 | (FORMAT_R8 << 8): _convert<3, false, 1, false, false, false>(width, height, rptr, wptr); break;
-		case FORMAT_RGB8 | (FORMAT_RG8 << 8): _convert<3, false, 2, false, false, false>(width, height, rptr, wptr); break;
-		case FORMAT_RGB8 | (FORMAT_RGBA8 << 8): _convert<3, false, 3, true, false, false>(width, height, rptr, wptr); break;
-		case FORMAT_RGBA8 | (FORMAT_L8 << 8): _convert<3, true, 1, false, false, true>(width, height, rptr, wptr); break;
-		case FORMAT_RGBA8 | (FORMAT_LA8 << 8): _convert<3, true, 1, true, false, true>(width, height, rptr, wptr); break;
-		case FORMAT_RGBA8 | (FORMAT_R8 << 8): _convert<3, true, 1, false, false, false>(width, height, rptr, wptr); break;
-		case FORMAT_RGBA8 | (FORMAT_RG8 << 8): _convert<3, true, 2, false, false, false>(width, height, rptr, wptr); break;
-		case FORMAT_RGBA8 | (FORMAT_RGB8 << 8): _convert<3, true, 3, false, false, false>(width, height, rptr, wptr); break;
+		case FORMAT_L8 | (FORMAT_LA8 << 8): _process_rows(_convert<1, false, 1, true, true, true>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_L8 | (FORMAT_R8 << 8): _process_rows(_convert<1, false, 1, false, true, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_L8 | (FORMAT_RG8 << 8): _process_rows(_convert<1, false, 2, false, true, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_L8 | (FORMAT_RGB8 << 8): _process_rows(_convert<1, false, 3, false, true, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_L8 | (FORMAT_RGBA8 << 8): _process_rows(_convert<1, false, 3, true, true, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_LA8 | (FORMAT_L8 << 8): _process_rows(_convert<1, true, 1, false, true, true>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_LA8 | (FORMAT_R8 << 8): _process_rows(_convert<1, true, 1, false, true, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_LA8 | (FORMAT_RG8 << 8): _process_rows(_convert<1, true, 2, false, true, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_LA8 | (FORMAT_RGB8 << 8): _process_rows(_convert<1, true, 3, false, true, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_LA8 | (FORMAT_RGBA8 << 8): _process_rows(_convert<1, true, 3, true, true, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_R8 | (FORMAT_L8 << 8): _process_rows(_convert<1, false, 1, false, false, true>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_R8 | (FORMAT_LA8 << 8): _process_rows(_convert<1, false, 1, true, false, true>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_R8 | (FORMAT_RG8 << 8): _process_rows(_convert<1, false, 2, false, false, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_R8 | (FORMAT_RGB8 << 8): _process_rows(_convert<1, false, 3, false, false, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_R8 | (FORMAT_RGBA8 << 8): _process_rows(_convert<1, false, 3, true, false, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_RG8 | (FORMAT_L8 << 8): _process_rows(_convert<2, false, 1, false, false, true>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_RG8 | (FORMAT_LA8 << 8): _process_rows(_convert<2, false, 1, true, false, true>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_RG8 | (FORMAT_R8 << 8): _process_rows(_convert<2, false, 1, false, false, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_RG8 | (FORMAT_RGB8 << 8): _process_rows(_convert<2, false, 3, false, false, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_RG8 | (FORMAT_RGBA8 << 8): _process_rows(_convert<2, false, 3, true, false, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_RGB8 | (FORMAT_L8 << 8): _process_rows(_convert<3, false, 1, false, false, true>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_RGB8 | (FORMAT_LA8 << 8): _process_rows(_convert<3, false, 1, true, false, true>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_RGB8 | (FORMAT_R8 << 8): _process_rows(_convert<3, false, 1, false, false, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_RGB8 | (FORMAT_RG8 << 8): _process_rows(_convert<3, false, 2, false, false, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_RGB8 | (FORMAT_RGBA8 << 8): _process_rows(_convert<3, false, 3, true, false, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_RGBA8 | (FORMAT_L8 << 8): _process_rows(_convert<3, true, 1, false, false, true>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_RGBA8 | (FORMAT_LA8 << 8): _process_rows(_convert<3, true, 1, true, false, true>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_RGBA8 | (FORMAT_R8 << 8): _process_rows(_convert<3, true, 1, false, false, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_RGBA8 | (FORMAT_RG8 << 8): _process_rows(_convert<3, true, 2, false, false, false>, rptr, wptr, width, height, width, height); break;
+		case FORMAT_RGBA8 | (FORMAT_RGB8 << 8): _process_rows(_convert<3, true, 3, false, false, false>, rptr, wptr, width, height, width, height); break;
 	}
 
 	bool gen_mipmaps = mipmaps;
@@ -538,7 +606,7 @@ static double _bicubic_interp_kernel(double x) {
 }
 
 template <int CC, class T>
-static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 
 	// get source image size
 	int width = p_src_width;
@@ -554,7 +622,7 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 	int xmax = width - 1;
 	// temporary pointer
 
-	for (uint32_t y = 0; y < p_dst_height; y++) {
+	for (uint32_t y = p_from_row; y < p_to_row; y++) {
 		// Y coordinates
 		oy = (double)y * yfac - 0.5f;
 		oy1 = (int)oy;
@@ -622,7 +690,7 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 }
 
 template <int CC, class T>
-static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 
 	enum {
 		FRAC_BITS = 8,
@@ -631,7 +699,22 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 
 	};
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+	//column coordinates are the same for every row
+	uint32_t *columns = memnew_arr(uint32_t, p_dst_width * 3);
+
+	for (uint32_t j = 0; j < p_dst_width; j++) {
+
+		uint32_t src_xofs_left_fp = (j * p_src_width * FRAC_LEN / p_dst_width);
+		uint32_t src_xofs_right = (j + 1) * p_src_width / p_dst_width;
+		if (src_xofs_right >= p_src_width)
+			src_xofs_right = p_src_width - 1;
+
+		columns[j * 3 + 0] = (src_xofs_left_fp >> FRAC_BITS) * CC;
+		columns[j * 3 + 1] = src_xofs_right * CC;
+		columns[j * 3 + 2] = src_xofs_left_fp & FRAC_MASK;
+	}
+
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
 
 		uint32_t src_yofs_up_fp = (i * p_src_height * FRAC_LEN / p_dst_height);
 		uint32_t src_yofs_frac = src_yofs_up_fp & FRAC_MASK;
@@ -649,15 +732,9 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 
 		for (uint32_t j = 0; j < p_dst_width; j++) {
 
-			uint32_t src_xofs_left_fp = (j * p_src_width * FRAC_LEN / p_dst_width);
-			uint32_t src_xofs_frac = src_xofs_left_fp & FRAC_MASK;
-			uint32_t src_xofs_left = src_xofs_left_fp >> FRAC_BITS;
-			uint32_t src_xofs_right = (j + 1) * p_src_width / p_dst_width;
-			if (src_xofs_right >= p_src_width)
-				src_xofs_right = p_src_width - 1;
-
-			src_xofs_left *= CC;
-			src_xofs_right *= CC;
+			uint32_t src_xofs_left = columns[j * 3 + 0];
+			uint32_t src_xofs_right = columns[j * 3 + 1];
+			uint32_t src_xofs_frac = columns[j * 3 + 2];
 
 			for (uint32_t l = 0; l < CC; l++) {
 
@@ -710,12 +787,14 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 			}
 		}
 	}
+
+	memdelete_arr(columns);
 }
 
 template <int CC, class T>
-static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
 
 		uint32_t src_yofs = i * p_src_height / p_dst_height;
 		uint32_t y_ofs = src_yofs * p_src_width * CC;
@@ -946,25 +1025,25 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 
 			if (format >= FORMAT_L8 && format <= FORMAT_RGBA8) {
 				switch (get_format_pixel_size(format)) {
-					case 1: _scale_nearest<1, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 2: _scale_nearest<2, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 3: _scale_nearest<3, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 4: _scale_nearest<4, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 1: _process_rows(_scale_nearest<1, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 2: _process_rows(_scale_nearest<2, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 3: _process_rows(_scale_nearest<3, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _process_rows(_scale_nearest<4, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 			} else if (format >= FORMAT_RF && format <= FORMAT_RGBAF) {
 				switch (get_format_pixel_size(format)) {
-					case 4: _scale_nearest<1, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 8: _scale_nearest<2, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 12: _scale_nearest<3, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 16: _scale_nearest<4, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _process_rows(_scale_nearest<1, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 8: _process_rows(_scale_nearest<2, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 12: _process_rows(_scale_nearest<3, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 16: _process_rows(_scale_nearest<4, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 
 			} else if (format >= FORMAT_RH && format <= FORMAT_RGBAH) {
 				switch (get_format_pixel_size(format)) {
-					case 2: _scale_nearest<1, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 4: _scale_nearest<2, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 6: _scale_nearest<3, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 8: _scale_nearest<4, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 2: _process_rows(_scale_nearest<1, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _process_rows(_scale_nearest<2, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 6: _process_rows(_scale_nearest<3, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 8: _process_rows(_scale_nearest<4, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 			}
 
@@ -1010,24 +1089,24 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 
 				if (format >= FORMAT_L8 && format <= FORMAT_RGBA8) {
 					switch (get_format_pixel_size(format)) {
-						case 1: _scale_bilinear<1, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 2: _scale_bilinear<2, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 3: _scale_bilinear<3, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 4: _scale_bilinear<4, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 1: _process_rows(_scale_bilinear<1, uint8_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 2: _process_rows(_scale_bilinear<2, uint8_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 3: _process_rows(_scale_bilinear<3, uint8_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 4: _process_rows(_scale_bilinear<4, uint8_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
 					}
 				} else if (format >= FORMAT_RF && format <= FORMAT_RGBAF) {
 					switch (get_format_pixel_size(format)) {
-						case 4: _scale_bilinear<1, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 8: _scale_bilinear<2, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 12: _scale_bilinear<3, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 16: _scale_bilinear<4, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 4: _process_rows(_scale_bilinear<1, float>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 8: _process_rows(_scale_bilinear<2, float>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 12: _process_rows(_scale_bilinear<3, float>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 16: _process_rows(_scale_bilinear<4, float>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
 					}
 				} else if (format >= FORMAT_RH && format <= FORMAT_RGBAH) {
 					switch (get_format_pixel_size(format)) {
-						case 2: _scale_bilinear<1, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 4: _scale_bilinear<2, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 6: _scale_bilinear<3, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
-						case 8: _scale_bilinear<4, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 2: _process_rows(_scale_bilinear<1, uint16_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 4: _process_rows(_scale_bilinear<2, uint16_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 6: _process_rows(_scale_bilinear<3, uint16_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
+						case 8: _process_rows(_scale_bilinear<4, uint16_t>, src_ptr, w_ptr, src_width, src_height, p_width, p_height); break;
 					}
 				}
 			}
@@ -1043,24 +1122,24 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 
 			if (format >= FORMAT_L8 && format <= FORMAT_RGBA8) {
 				switch (get_format_pixel_size(format)) {
-					case 1: _scale_cubic<1, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 2: _scale_cubic<2, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 3: _scale_cubic<3, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 4: _scale_cubic<4, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 1: _process_rows(_scale_cubic<1, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 2: _process_rows(_scale_cubic<2, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 3: _process_rows(_scale_cubic<3, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _process_rows(_scale_cubic<4, uint8_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 			} else if (format >= FORMAT_RF && format <= FORMAT_RGBAF) {
 				switch (get_format_pixel_size(format)) {
-					case 4: _scale_cubic<1, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 8: _scale_cubic<2, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 12: _scale_cubic<3, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 16: _scale_cubic<4, float>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _process_rows(_scale_cubic<1, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 8: _process_rows(_scale_cubic<2, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 12: _process_rows(_scale_cubic<3, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 16: _process_rows(_scale_cubic<4, float>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 			} else if (format >= FORMAT_RH && format <= FORMAT_RGBAH) {
 				switch (get_format_pixel_size(format)) {
-					case 2: _scale_cubic<1, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 4: _scale_cubic<2, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 6: _scale_cubic<3, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
-					case 8: _scale_cubic<4, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 2: _process_rows(_scale_cubic<1, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 4: _process_rows(_scale_cubic<2, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 6: _process_rows(_scale_cubic<3, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
+					case 8: _process_rows(_scale_cubic<4, uint16_t>, r_ptr, w_ptr, width, height, p_width, p_height); break;
 				}
 			}
 		} break;
@@ -1284,16 +1363,17 @@ bool Image::_can_modify(Format p_format) const {
 template <class Component, int CC, bool renormalize,
 		void (*average_func)(Component &, const Component &, const Component &, const Component &, const Component &),
 		void (*renormalize_func)(Component *)>
-static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height) {
+static void _generate_po2_mipmap(const uint8_t *p_src_bytes, uint8_t *p_dst_bytes, uint32_t p_width, uint32_t p_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
 
 	//fast power of 2 mipmap generation
-	uint32_t dst_w = MAX(p_width >> 1, 1);
-	uint32_t dst_h = MAX(p_height >> 1, 1);
+	const Component *p_src = reinterpret_cast<const Component *>(p_src_bytes);
+	Component *p_dst = reinterpret_cast<Component *>(p_dst_bytes);
+	uint32_t dst_w = p_dst_width;
 
 	int right_step = (p_width == 1) ? 0 : CC;
 	int down_step = (p_height == 1) ? 0 : (p_width * CC);
 
-	for (uint32_t i = 0; i < dst_h; i++) {
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
 
 		const Component *rup_ptr = &p_src[i * 2 * down_step];
 		const Component *rdown_ptr = rup_ptr + down_step;
@@ -1317,6 +1397,147 @@ static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint3
 	}
 }
 
+static void _generate_po2_mipmap_rgba8(const uint8_t *p_src, uint8_t *p_dst, uint32_t p_width, uint32_t p_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
+
+	int right_step = (p_width == 1) ? 0 : 4;
+	int down_step = (p_height == 1) ? 0 : (p_width * 4);
+
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
+
+		const uint8_t *rup_ptr = &p_src[i * 2 * down_step];
+		const uint8_t *rdown_ptr = rup_ptr + down_step;
+		uint8_t *dst_ptr = &p_dst[i * p_dst_width * 4];
+		uint32_t x = 0;
+
+#if defined(IMAGE_SIMD_SSE2) || defined(IMAGE_SIMD_NEON)
+		//two destination pixels from four source pixels of each row, rounded like average_4_uint8()
+		for (; right_step && x + 2 <= p_dst_width; x += 2) {
+#ifdef IMAGE_SIMD_SSE2
+			__m128i zero = _mm_setzero_si128();
+			__m128i up = _mm_loadu_si128((const __m128i *)&rup_ptr[x * 8]);
+			__m128i down = _mm_loadu_si128((const __m128i *)&rdown_ptr[x * 8]);
+			__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(up, zero), _mm_unpacklo_epi8(down, zero));
+			__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(up, zero), _mm_unpackhi_epi8(down, zero));
+			__m128i sum = _mm_unpacklo_epi64(_mm_add_epi16(lo, _mm_srli_si128(lo, 8)), _mm_add_epi16(hi, _mm_srli_si128(hi, 8)));
+			sum = _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(2)), 2);
+			_mm_storel_epi64((__m128i *)&dst_ptr[x * 4], _mm_packus_epi16(sum, sum));
+#else
+			uint8x16_t up = vld1q_u8(&rup_ptr[x * 8]);
+			uint8x16_t down = vld1q_u8(&rdown_ptr[x * 8]);
+			uint16x8_t lo = vaddl_u8(vget_low_u8(up), vget_low_u8(down));
+			uint16x8_t hi = vaddl_u8(vget_high_u8(up), vget_high_u8(down));
+			uint16x8_t sum = vcombine_u16(vadd_u16(vget_low_u16(lo), vget_high_u16(lo)), vadd_u16(vget_low_u16(hi), vget_high_u16(hi)));
+			vst1_u8(&dst_ptr[x * 4], vrshrn_n_u16(sum, 2));
+#endif
+		}
+#endif
+
+		for (; x < p_dst_width; x++) {
+
+			const uint8_t *up = &rup_ptr[x * right_step * 2];
+			const uint8_t *down = &rdown_ptr[x * right_step * 2];
+			for (int j = 0; j < 4; j++) {
+				dst_ptr[x * 4 + j] = (up[j] + up[j + right_step] + down[j] + down[j + right_step] + 2) >> 2;
+			}
+		}
+	}
+}
+
+static void _generate_po2_mipmap_rgbaf(const uint8_t *p_src_bytes, uint8_t *p_dst_bytes, uint32_t p_width, uint32_t p_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
+
+	const float *p_src = reinterpret_cast<const float *>(p_src_bytes);
+	float *p_dst = reinterpret_cast<float *>(p_dst_bytes);
+
+	int right_step = (p_width == 1) ? 0 : 4;
+	int down_step = (p_height == 1) ? 0 : (p_width * 4);
+
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
+
+		const float *rup_ptr = &p_src[i * 2 * down_step];
+		const float *rdown_ptr = rup_ptr + down_step;
+		float *dst_ptr = &p_dst[i * p_dst_width * 4];
+
+		//summed in the same order as average_4_float()
+		for (uint32_t x = 0; x < p_dst_width; x++) {
+
+			const float *up = &rup_ptr[x * right_step * 2];
+			const float *down = &rdown_ptr[x * right_step * 2];
+#ifdef IMAGE_SIMD_SSE2
+			__m128 sum = _mm_add_ps(_mm_loadu_ps(up), _mm_loadu_ps(up + right_step));
+			sum = _mm_add_ps(_mm_add_ps(sum, _mm_loadu_ps(down)), _mm_loadu_ps(down + right_step));
+			_mm_storeu_ps(&dst_ptr[x * 4], _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#elif defined(IMAGE_SIMD_NEON)
+			float32x4_t sum = vaddq_f32(vld1q_f32(up), vld1q_f32(up + right_step));
+			sum = vaddq_f32(vaddq_f32(sum, vld1q_f32(down)), vld1q_f32(down + right_step));
+			vst1q_f32(&dst_ptr[x * 4], vmulq_n_f32(sum, 0.25f));
+#else
+			for (int j = 0; j < 4; j++) {
+				dst_ptr[x * 4 + j] = (up[j] + up[j + right_step] + down[j] + down[j + right_step]) * 0.25f;
+			}
+#endif
+		}
+	}
+}
+
+//sRGB <-> linear lookups, linear is 16 bits and is looked back up with 14 bits, enough for all 8 bit sRGB values to come back unchanged
+struct ImageSRGBTables {
+
+	uint16_t to_linear[256];
+	uint8_t to_srgb[16384];
+
+	ImageSRGBTables() {
+
+		for (int i = 0; i < 256; i++) {
+			float c = i / 255.0;
+			float l = c < 0.04045 ? c * (1.0 / 12.92) : Math::pow((c + 0.055) * (1.0 / 1.055), 2.4);
+			to_linear[i] = CLAMP(Math::fast_ftoi(l * 65535.0), 0, 65535);
+		}
+		for (int i = 0; i < 16384; i++) {
+			float l = (i * 4 + 2) / 65535.0;
+			float c = l < 0.0031308 ? 12.92 * l : (1.055) * Math::pow(l, 1.0f / 2.4f) - 0.055;
+			to_srgb[i] = CLAMP(Math::fast_ftoi(c * 255.0), 0, 255);
+		}
+	}
+};
+
+static const ImageSRGBTables &_get_srgb_tables() {
+
+	static const ImageSRGBTables tables;
+	return tables;
+}
+
+//averages the color channels in linear space, alpha stays as is
+template <int CC>
+static void _generate_po2_mipmap_srgb(const uint8_t *p_src, uint8_t *p_dst, uint32_t p_width, uint32_t p_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_row, uint32_t p_to_row) {
+
+	const ImageSRGBTables &tables = _get_srgb_tables();
+
+	int right_step = (p_width == 1) ? 0 : CC;
+	int down_step = (p_height == 1) ? 0 : (p_width * CC);
+
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
+
+		const uint8_t *rup_ptr = &p_src[i * 2 * down_step];
+		const uint8_t *rdown_ptr = rup_ptr + down_step;
+		uint8_t *dst_ptr = &p_dst[i * p_dst_width * CC];
+
+		for (uint32_t x = 0; x < p_dst_width; x++) {
+
+			for (int j = 0; j < 3; j++) {
+				uint32_t sum = tables.to_linear[rup_ptr[j]] + tables.to_linear[rup_ptr[j + right_step]] + tables.to_linear[rdown_ptr[j]] + tables.to_linear[rdown_ptr[j + right_step]];
+				dst_ptr[j] = tables.to_srgb[sum >> 4];
+			}
+			if (CC == 4) {
+				dst_ptr[3] = (rup_ptr[3] + rup_ptr[3 + right_step] + rdown_ptr[3] + rdown_ptr[3 + right_step] + 2) >> 2;
+			}
+
+			dst_ptr += CC;
+			rup_ptr += right_step * 2;
+			rdown_ptr += right_step * 2;
+		}
+	}
+}
+
 void Image::expand_x2_hq2x() {
 
 	ERR_FAIL_COND(!_can_modify(format));
@@ -1400,23 +1621,23 @@ void Image::shrink_x2() {
 			switch (format) {
 
 				case FORMAT_L8:
-				case FORMAT_R8: _generate_po2_mipmap<uint8_t, 1, false, Image::average_4_uint8, Image::renormalize_uint8>(r, w, width, height); break;
-				case FORMAT_LA8: _generate_po2_mipmap<uint8_t, 2, false, Image::average_4_uint8, Image::renormalize_uint8>(r, w, width, height); break;
-				case FORMAT_RG8: _generate_po2_mipmap<uint8_t, 2, false, Image::average_4_uint8, Image::renormalize_uint8>(r, w, width, height); break;
-				case FORMAT_RGB8: _generate_po2_mipmap<uint8_t, 3, false, Image::average_4_uint8, Image::renormalize_uint8>(r, w, width, height); break;
-				case FORMAT_RGBA8: _generate_po2_mipmap<uint8_t, 4, false, Image::average_4_uint8, Image::renormalize_uint8>(r, w, width, height); break;
-
-				case FORMAT_RF: _generate_po2_mipmap<float, 1, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(r), reinterpret_cast<float *>(w), width, height); break;
-				case FORMAT_RGF: _generate_po2_mipmap<float, 2, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(r), reinterpret_cast<float *>(w), width, height); break;
-				case FORMAT_RGBF: _generate_po2_mipmap<float, 3, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(r), reinterpret_cast<float *>(w), width, height); break;
-				case FORMAT_RGBAF: _generate_po2_mipmap<float, 4, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(r), reinterpret_cast<float *>(w), width, height); break;
-
-				case FORMAT_RH: _generate_po2_mipmap<uint16_t, 1, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(r), reinterpret_cast<uint16_t *>(w), width, height); break;
-				case FORMAT_RGH: _generate_po2_mipmap<uint16_t, 2, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(r), reinterpret_cast<uint16_t *>(w), width, height); break;
-				case FORMAT_RGBH: _generate_po2_mipmap<uint16_t, 3, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(r), reinterpret_cast<uint16_t *>(w), width, height); break;
-				case FORMAT_RGBAH: _generate_po2_mipmap<uint16_t, 4, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(r), reinterpret_cast<uint16_t *>(w), width, height); break;
-
-				case FORMAT_RGBE9995: _generate_po2_mipmap<uint32_t, 1, false, Image::average_4_rgbe9995, Image::renormalize_rgbe9995>(reinterpret_cast<const uint32_t *>(r), reinterpret_cast<uint32_t *>(w), width, height); break;
+				case FORMAT_R8: _process_mipmap(_generate_po2_mipmap<uint8_t, 1, false, Image::average_4_uint8, Image::renormalize_uint8>, r, w, width, height); break;
+				case FORMAT_LA8: _process_mipmap(_generate_po2_mipmap<uint8_t, 2, false, Image::average_4_uint8, Image::renormalize_uint8>, r, w, width, height); break;
+				case FORMAT_RG8: _process_mipmap(_generate_po2_mipmap<uint8_t, 2, false, Image::average_4_uint8, Image::renormalize_uint8>, r, w, width, height); break;
+				case FORMAT_RGB8: _process_mipmap(_generate_po2_mipmap<uint8_t, 3, false, Image::average_4_uint8, Image::renormalize_uint8>, r, w, width, height); break;
+				case FORMAT_RGBA8: _process_mipmap(_generate_po2_mipmap_rgba8, r, w, width, height); break;
+
+				case FORMAT_RF: _process_mipmap(_generate_po2_mipmap<float, 1, false, Image::average_4_float, Image::renormalize_float>, r, w, width, height); break;
+				case FORMAT_RGF: _process_mipmap(_generate_po2_mipmap<float, 2, false, Image::average_4_float, Image::renormalize_float>, r, w, width, height); break;
+				case FORMAT_RGBF: _process_mipmap(_generate_po2_mipmap<float, 3, false, Image::average_4_float, Image::renormalize_float>, r, w, width, height); break;
+				case FORMAT_RGBAF: _process_mipmap(_generate_po2_mipmap_rgbaf, r, w, width, height); break;
+
+				case FORMAT_RH: _process_mipmap(_generate_po2_mipmap<uint16_t, 1, false, Image::average_4_half, Image::renormalize_half>, r, w, width, height); break;
+				case FORMAT_RGH: _process_mipmap(_generate_po2_mipmap<uint16_t, 2, false, Image::average_4_half, Image::renormalize_half>, r, w, width, height); break;
+				case FORMAT_RGBH: _process_mipmap(_generate_po2_mipmap<uint16_t, 3, false, Image::average_4_half, Image::renormalize_half>, r, w, width, height); break;
+				case FORMAT_RGBAH: _process_mipmap(_generate_po2_mipmap<uint16_t, 4, false, Image::average_4_half, Image::renormalize_half>, r, w, width, height); break;
+
+				case FORMAT_RGBE9995: _process_mipmap(_generate_po2_mipmap<uint32_t, 1, false, Image::average_4_rgbe9995, Image::renormalize_rgbe9995>, r, w, width, height); break;
 				default: {
 				}
 			}
@@ -1454,7 +1675,7 @@ void Image::normalize() {
 	}
 }
 
-Error Image::generate_mipmaps(bool p_renormalize) {
+Error Image::generate_mipmaps(bool p_renormalize, bool p_srgb) {
 
 	ERR_FAIL_COND_V_MSG(!_can_modify(format), ERR_UNAVAILABLE, "Cannot generate mipmaps in compressed or custom image formats.");
 
@@ -1482,67 +1703,71 @@ Error Image::generate_mipmaps(bool p_renormalize) {
 		switch (format) {
 
 			case FORMAT_L8:
-			case FORMAT_R8: _generate_po2_mipmap<uint8_t, 1, false, Image::average_4_uint8, Image::renormalize_uint8>(&wp[prev_ofs], &wp[ofs], prev_w, prev_h); break;
+			case FORMAT_R8: _process_mipmap(_generate_po2_mipmap<uint8_t, 1, false, Image::average_4_uint8, Image::renormalize_uint8>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h); break;
 			case FORMAT_LA8:
-			case FORMAT_RG8: _generate_po2_mipmap<uint8_t, 2, false, Image::average_4_uint8, Image::renormalize_uint8>(&wp[prev_ofs], &wp[ofs], prev_w, prev_h); break;
+			case FORMAT_RG8: _process_mipmap(_generate_po2_mipmap<uint8_t, 2, false, Image::average_4_uint8, Image::renormalize_uint8>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h); break;
 			case FORMAT_RGB8:
 				if (p_renormalize)
-					_generate_po2_mipmap<uint8_t, 3, true, Image::average_4_uint8, Image::renormalize_uint8>(&wp[prev_ofs], &wp[ofs], prev_w, prev_h);
+					_process_mipmap(_generate_po2_mipmap<uint8_t, 3, true, Image::average_4_uint8, Image::renormalize_uint8>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
+				else if (p_srgb)
+					_process_mipmap(_generate_po2_mipmap_srgb<3>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 				else
-					_generate_po2_mipmap<uint8_t, 3, false, Image::average_4_uint8, Image::renormalize_uint8>(&wp[prev_ofs], &wp[ofs], prev_w, prev_h);
+					_process_mipmap(_generate_po2_mipmap<uint8_t, 3, false, Image::average_4_uint8, Image::renormalize_uint8>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 
 				break;
 			case FORMAT_RGBA8:
 				if (p_renormalize)
-					_generate_po2_mipmap<uint8_t, 4, true, Image::average_4_uint8, Image::renormalize_uint8>(&wp[prev_ofs], &wp[ofs], prev_w, prev_h);
+					_process_mipmap(_generate_po2_mipmap<uint8_t, 4, true, Image::average_4_uint8, Image::renormalize_uint8>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
+				else if (p_srgb)
+					_process_mipmap(_generate_po2_mipmap_srgb<4>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 				else
-					_generate_po2_mipmap<uint8_t, 4, false, Image::average_4_uint8, Image::renormalize_uint8>(&wp[prev_ofs], &wp[ofs], prev_w, prev_h);
+					_process_mipmap(_generate_po2_mipmap_rgba8, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 				break;
 			case FORMAT_RF:
-				_generate_po2_mipmap<float, 1, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h);
+				_process_mipmap(_generate_po2_mipmap<float, 1, false, Image::average_4_float, Image::renormalize_float>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 				break;
 			case FORMAT_RGF:
-				_generate_po2_mipmap<float, 2, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h);
+				_process_mipmap(_generate_po2_mipmap<float, 2, false, Image::average_4_float, Image::renormalize_float>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 				break;
 			case FORMAT_RGBF:
 				if (p_renormalize)
-					_generate_po2_mipmap<float, 3, true, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h);
+					_process_mipmap(_generate_po2_mipmap<float, 3, true, Image::average_4_float, Image::renormalize_float>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 				else
-					_generate_po2_mipmap<float, 3, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h);
+					_process_mipmap(_generate_po2_mipmap<float, 3, false, Image::average_4_float, Image::renormalize_float>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 
 				break;
 			case FORMAT_RGBAF:
 				if (p_renormalize)
-					_generate_po2_mipmap<float, 4, true, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h);
+					_process_mipmap(_generate_po2_mipmap<float, 4, true, Image::average_4_float, Image::renormalize_float>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 				else
-					_generate_po2_mipmap<float, 4, false, Image::average_4_float, Image::renormalize_float>(reinterpret_cast<const float *>(&wp[prev_ofs]), reinterpret_cast<float *>(&wp[ofs]), prev_w, prev_h);
+					_process_mipmap(_generate_po2_mipmap_rgbaf, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 
 				break;
 			case FORMAT_RH:
-				_generate_po2_mipmap<uint16_t, 1, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h);
+				_process_mipmap(_generate_po2_mipmap<uint16_t, 1, false, Image::average_4_half, Image::renormalize_half>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 				break;
 			case FORMAT_RGH:
-				_generate_po2_mipmap<uint16_t, 2, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h);
+				_process_mipmap(_generate_po2_mipmap<uint16_t, 2, false, Image::average_4_half, Image::renormalize_half>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 				break;
 			case FORMAT_RGBH:
 				if (p_renormalize)
-					_generate_po2_mipmap<uint16_t, 3, true, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h);
+					_process_mipmap(_generate_po2_mipmap<uint16_t, 3, true, Image::average_4_half, Image::renormalize_half>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 				else
-					_generate_po2_mipmap<uint16_t, 3, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h);
+					_process_mipmap(_generate_po2_mipmap<uint16_t, 3, false, Image::average_4_half, Image::renormalize_half>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 
 				break;
 			case FORMAT_RGBAH:
 				if (p_renormalize)
-					_generate_po2_mipmap<uint16_t, 4, true, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h);
+					_process_mipmap(_generate_po2_mipmap<uint16_t, 4, true, Image::average_4_half, Image::renormalize_half>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 				else
-					_generate_po2_mipmap<uint16_t, 4, false, Image::average_4_half, Image::renormalize_half>(reinterpret_cast<const uint16_t *>(&wp[prev_ofs]), reinterpret_cast<uint16_t *>(&wp[ofs]), prev_w, prev_h);
+					_process_mipmap(_generate_po2_mipmap<uint16_t, 4, false, Image::average_4_half, Image::renormalize_half>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 
 				break;
 			case FORMAT_RGBE9995:
 				if (p_renormalize)
-					_generate_po2_mipmap<uint32_t, 1, true, Image::average_4_rgbe9995, Image::renormalize_rgbe9995>(reinterpret_cast<const uint32_t *>(&wp[prev_ofs]), reinterpret_cast<uint32_t *>(&wp[ofs]), prev_w, prev_h);
+					_process_mipmap(_generate_po2_mipmap<uint32_t, 1, true, Image::average_4_rgbe9995, Image::renormalize_rgbe9995>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 				else
-					_generate_po2_mipmap<uint32_t, 1, false, Image::average_4_rgbe9995, Image::renormalize_rgbe9995>(reinterpret_cast<const uint32_t *>(&wp[prev_ofs]), reinterpret_cast<uint32_t *>(&wp[ofs]), prev_w, prev_h);
+					_process_mipmap(_generate_po2_mipmap<uint32_t, 1, false, Image::average_4_rgbe9995, Image::renormalize_rgbe9995>, &wp[prev_ofs], &wp[ofs], prev_w, prev_h);
 
 				break;
 			default: {
@@ -2928,7 +3153,7 @@ void Image::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("crop", "width", "height"), &Image::crop);
 	ClassDB::bind_method(D_METHOD("flip_x"), &Image::flip_x);
 	ClassDB::bind_method(D_METHOD("flip_y"), &Image::flip_y);
-	ClassDB::bind_method(D_METHOD("generate_mipmaps", "renormalize"), &Image::generate_mipmaps, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("generate_mipmaps", "renormalize", "srgb"), &Image::generate_mipmaps, DEFVAL(false), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("clear_mipmaps"), &Image::clear_mipmaps);
 
 	ClassDB::bind_method(D_METHOD("create", "width", "height", "use_mipmaps", "format"), &Image::_create_empty);
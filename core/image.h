@@ -249,7 +249,7 @@ public:
 	/**
 	 * Generate a mipmap to an image (creates an image 1/4 the size, with averaging of 4->1)
 	 */
-	Error generate_mipmaps(bool p_renormalize = false);
+	Error generate_mipmaps(bool p_renormalize = false, bool p_srgb = false);
 
 	enum RoughnessChannel {
 		ROUGHNESS_CHANNEL_R,
@@ -784,6 +784,20 @@ void InputFilter::accumulate_input_event(const Ref<InputEvent> &p_event) {
 		return; //event was accumulated, exit
 	}
 
+	Ref<InputEventScreenDrag> drag = p_event;
+	if (drag.is_valid()) {
+		//drags of several fingers arrive interleaved, skip over the other fingers' drags to find the last one of this finger
+		for (List<Ref<InputEvent>>::Element *E = accumulated_events.back(); E; E = E->prev()) {
+			Ref<InputEventScreenDrag> prev_drag = E->get();
+			if (prev_drag.is_null()) {
+				break; //never merge across other events, they must see the position the finger had
+			}
+			if (prev_drag->accumulate(p_event)) {
+				return;
+			}
+		}
+	}
+
 	accumulated_events.push_back(p_event);
 }
 void InputFilter::flush_accumulated_events() {
@@ -39,6 +39,42 @@
 #include <zlib.h>
 #include <zstd.h>
 
+// Zstandard contexts are large to create, so every thread keeps its own to reuse
+// (compressed files and packs decompress blocks on whichever thread loads them).
+struct ZstdThreadContexts {
+
+	ZSTD_CCtx *cctx;
+	ZSTD_DCtx *dctx;
+
+	ZSTD_CCtx *get_cctx() {
+		if (!cctx) {
+			cctx = ZSTD_createCCtx();
+		}
+		return cctx;
+	}
+
+	ZSTD_DCtx *get_dctx() {
+		if (!dctx) {
+			dctx = ZSTD_createDCtx();
+		}
+		return dctx;
+	}
+
+	ZstdThreadContexts() :
+			cctx(NULL),
+			dctx(NULL) {}
+	~ZstdThreadContexts() {
+		if (cctx) {
+			ZSTD_freeCCtx(cctx);
+		}
+		if (dctx) {
+			ZSTD_freeDCtx(dctx);
+		}
+	}
+};
+
+static thread_local ZstdThreadContexts zstd_contexts;
+
 int Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, Mode p_mode) {
 
 	switch (p_mode) {
@@ -80,16 +116,16 @@ int Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size,
 
 		} break;
 		case MODE_ZSTD: {
-			ZSTD_CCtx *cctx = ZSTD_createCCtx();
+			ZSTD_CCtx *cctx = zstd_contexts.get_cctx();
+			ZSTD_CCtx_reset(cctx, ZSTD_reset_session_and_parameters);
 			ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, zstd_level);
 			if (zstd_long_distance_matching) {
 				ZSTD_CCtx_setParameter(cctx, ZSTD_c_enableLongDistanceMatching, 1);
 				ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, zstd_window_log_size);
 			}
 			int max_dst_size = get_max_compressed_buffer_size(p_src_size, MODE_ZSTD);
-			int ret = ZSTD_compressCCtx(cctx, p_dst, max_dst_size, p_src, p_src_size, zstd_level);
-			ZSTD_freeCCtx(cctx);
-			return ret;
+			size_t ret = ZSTD_compressCCtx(cctx, p_dst, max_dst_size, p_src, p_src_size, zstd_level);
+			return ZSTD_isError(ret) ? -1 : int(ret);
 		} break;
 	}
 
@@ -174,13 +210,13 @@ int Compression::decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p
 			return total;
 		} break;
 		case MODE_ZSTD: {
-			ZSTD_DCtx *dctx = ZSTD_createDCtx();
+			ZSTD_DCtx *dctx = zstd_contexts.get_dctx();
+			ZSTD_DCtx_reset(dctx, ZSTD_reset_session_and_parameters);
 			if (zstd_long_distance_matching) {
 				ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, zstd_window_log_size);
 			}
-			int ret = ZSTD_decompressDCtx(dctx, p_dst, p_dst_max_size, p_src, p_src_size);
-			ZSTD_freeDCtx(dctx);
-			return ret;
+			size_t ret = ZSTD_decompressDCtx(dctx, p_dst, p_dst_max_size, p_src, p_src_size);
+			return ZSTD_isError(ret) ? -1 : int(ret);
 		} break;
 	}
 
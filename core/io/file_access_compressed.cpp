@@ -30,6 +30,7 @@
 
 #include "file_access_compressed.h"
 
+#include "core/io/marshalls.h"
 #include "core/print_string.h"
 
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, int p_block_size) {
@@ -84,19 +85,72 @@ Error FileAccessCompressed::open_after_magic(FileAccess *p_base) {
 	comp_buffer.resize(max_bs);
 	buffer.resize(block_size);
 	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
-	at_end = false;
+	at_end = read_total == 0;
 	read_eof = false;
 	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
-
-	Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
 	read_block = 0;
+	decoded_block = -1;
+	read_block_size = _get_block_size(0);
 	read_pos = 0;
 
 	return OK;
 }
 
+void FileAccessCompressed::_decode_block() const {
+
+	const ReadBlock &rb = read_blocks[read_block];
+	f->seek(rb.offset);
+	f->get_buffer(comp_buffer.ptrw(), rb.csize);
+	Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), rb.csize, cmode);
+	decoded_block = read_block;
+}
+
+void FileAccessCompressed::_next_block() const {
+
+	//the last block is empty when the size is a multiple of the block size
+	if (read_block + 1 < read_block_count && _get_block_size(read_block + 1) > 0) {
+		read_block++;
+		read_block_size = _get_block_size(read_block);
+		read_pos = 0;
+	} else {
+		at_end = true;
+	}
+}
+
+Vector<uint8_t> FileAccessCompressed::compress_buffer(const uint8_t *p_data, int p_size, const String &p_magic, Compression::Mode p_mode, int p_block_size) {
+
+	ERR_FAIL_COND_V(p_block_size <= 0, Vector<uint8_t>());
+
+	CharString mgc = p_magic.ascii();
+	ERR_FAIL_COND_V(mgc.length() != 4, Vector<uint8_t>());
+
+	int bc = (p_size / p_block_size) + 1;
+	int header_size = 4 + 4 + 4 + 4 + bc * 4;
+
+	Vector<uint8_t> ret;
+	ret.resize(header_size + bc * Compression::get_max_compressed_buffer_size(p_block_size, p_mode) + 4);
+	uint8_t *w = ret.ptrw();
+
+	copymem(w, mgc.get_data(), 4);
+	encode_uint32(p_mode, &w[4]);
+	encode_uint32(p_block_size, &w[8]);
+	encode_uint32(p_size, &w[12]);
+
+	int ofs = header_size;
+	for (int i = 0; i < bc; i++) {
+
+		int bl = i == (bc - 1) ? p_size % p_block_size : p_block_size;
+		int s = Compression::compress(&w[ofs], &p_data[i * p_block_size], bl, p_mode);
+		ERR_FAIL_COND_V(s < 0, Vector<uint8_t>());
+		encode_uint32(s, &w[16 + i * 4]);
+		ofs += s;
+	}
+
+	copymem(&w[ofs], mgc.get_data(), 4); //magic at the end too
+	ret.resize(ofs + 4);
+	return ret;
+}
+
 Error FileAccessCompressed::_open(const String &p_path, int p_mode_flags) {
 
 	ERR_FAIL_COND_V(p_mode_flags == READ_WRITE, ERR_UNAVAILABLE);
@@ -207,21 +261,17 @@ void FileAccessCompressed::seek(size_t p_position) {
 	} else {
 
 		ERR_FAIL_COND(p_position > read_total);
+		read_eof = false;
 		if (p_position == read_total) {
 			at_end = true;
+			read_block = read_total ? (read_total - 1) / block_size : 0;
+			read_block_size = _get_block_size(read_block);
+			read_pos = read_total - read_block * block_size;
 		} else {
+			//only remember where to read from, the block is decompressed when read
 			at_end = false;
-			read_eof = false;
-			int block_idx = p_position / block_size;
-			if (block_idx != read_block) {
-
-				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-			}
-
+			read_block = p_position / block_size;
+			read_block_size = _get_block_size(read_block);
 			read_pos = p_position % block_size;
 		}
 	}
@@ -280,23 +330,15 @@ uint8_t FileAccessCompressed::get_8() const {
 		return 0;
 	}
 
+	if (decoded_block != read_block) {
+		_decode_block();
+	}
+
 	uint8_t ret = read_ptr[read_pos];
 
 	read_pos++;
 	if (read_pos >= read_block_size) {
-		read_block++;
-
-		if (read_block < read_block_count) {
-			//read another block of compressed data
-			f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-			Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-			read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-			read_pos = 0;
-
-		} else {
-			read_block--;
-			at_end = true;
-		}
+		_next_block();
 	}
 
 	return ret;
@@ -306,36 +348,29 @@ int FileAccessCompressed::get_buffer(uint8_t *p_dst, int p_length) const {
 	ERR_FAIL_COND_V_MSG(!f, 0, "File must be opened before use.");
 	ERR_FAIL_COND_V_MSG(writing, 0, "File has not been opened in read mode.");
 
-	if (at_end) {
-		read_eof = true;
-		return 0;
-	}
+	int done = 0;
+	while (done < p_length) {
+
+		if (at_end) {
+			read_eof = true;
+			return done;
+		}
+
+		if (decoded_block != read_block) {
+			_decode_block();
+		}
 
-	for (int i = 0; i < p_length; i++) {
+		int amount = MIN(p_length - done, read_block_size - read_pos);
+		copymem(&p_dst[done], &read_ptr[read_pos], amount);
+		done += amount;
+		read_pos += amount;
 
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
 		if (read_pos >= read_block_size) {
-			read_block++;
-
-			if (read_block < read_block_count) {
-				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-				read_pos = 0;
-
-			} else {
-				read_block--;
-				at_end = true;
-				if (i < p_length - 1)
-					read_eof = true;
-				return i;
-			}
+			_next_block();
 		}
 	}
 
-	return p_length;
+	return done;
 }
 
 Error FileAccessCompressed::get_error() const {
@@ -400,6 +435,7 @@ FileAccessCompressed::FileAccessCompressed() :
 		at_end(false),
 		read_ptr(NULL),
 		read_block(0),
+		decoded_block(-1),
 		read_block_count(0),
 		read_block_size(0),
 		read_pos(0),
@@ -54,6 +54,7 @@ class FileAccessCompressed : public FileAccess {
 	mutable Vector<uint8_t> comp_buffer;
 	uint8_t *read_ptr;
 	mutable int read_block;
+	mutable int decoded_block; //blocks are only decompressed once something is read from them
 	int read_block_count;
 	mutable int read_block_size;
 	mutable int read_pos;
@@ -64,9 +65,16 @@ class FileAccessCompressed : public FileAccess {
 	mutable Vector<uint8_t> buffer;
 	FileAccess *f;
 
+	_FORCE_INLINE_ int _get_block_size(int p_block) const { return p_block == read_block_count - 1 ? read_total - p_block * block_size : block_size; }
+	void _decode_block() const;
+	void _next_block() const;
+
 public:
 	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, int p_block_size = 4096);
 
+	// Compresses p_size bytes in the format read by open_after_magic(), with p_magic in front.
+	static Vector<uint8_t> compress_buffer(const uint8_t *p_data, int p_size, const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, int p_block_size = 4096);
+
 	Error open_after_magic(FileAccess *p_base);
 
 	virtual Error _open(const String &p_path, int p_mode_flags); ///< open a file
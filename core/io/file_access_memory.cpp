@@ -153,19 +153,36 @@ int FileAccessMemory::get_buffer(uint8_t *p_dst, int p_length) const {
 
 	ERR_FAIL_COND_V(!data, -1);
 
-	int left = length - pos;
+	//reading less than requested near the end is fine, the amount read is returned
+	int left = MAX(length - pos, 0);
 	int read = MIN(p_length, left);
 
-	if (read < p_length) {
-		WARN_PRINT("Reading less data than requested");
-	};
-
 	copymem(p_dst, &data[pos], read);
-	pos += p_length;
+	pos += read;
+	if (read < p_length) {
+		pos = length + 1; //tried to read past the end, like get_8 does
+	}
 
 	return read;
 }
 
+const uint8_t *FileAccessMemory::get_buffer_view(int p_length, int &r_length) const {
+
+	ERR_FAIL_COND_V(!data, NULL);
+	ERR_FAIL_COND_V(p_length < 0, NULL);
+
+	int left = MAX(length - pos, 0);
+	r_length = MIN(p_length, left);
+
+	const uint8_t *view = &data[MIN(pos, length)];
+	pos += r_length;
+	if (r_length < p_length) {
+		pos = length + 1;
+	}
+
+	return view;
+}
+
 Error FileAccessMemory::get_error() const {
 
 	return pos >= length ? ERR_FILE_EOF : OK;
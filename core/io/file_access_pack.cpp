@@ -30,12 +30,16 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/file_access_compressed.h"
+#include "core/io/marshalls.h"
 #include "core/version.h"
 
 #include <stdio.h>
 
 Error PackedData::add_pack(const String &p_path, bool p_replace_files) {
 
+	layer_count++;
+
 	for (int i = 0; i < sources.size(); i++) {
 
 		if (sources[i]->try_open_pack(p_path, p_replace_files)) {
@@ -61,39 +65,103 @@ void PackedData::add_path(const String &pkg_path, const String &path, uint64_t o
 	for (int i = 0; i < 16; i++)
 		pf.md5[i] = p_md5[i];
 	pf.src = p_src;
+	pf.layer = layer_count;
+	pf.replace = p_replace_files;
+	pf.flags = 0;
 
 	if (!exists || p_replace_files)
 		files[pmd5] = pf;
 
 	if (!exists) {
-		//search for dir
-		String p = path.replace_first("res://", "");
-		PackedDir *cd = root;
+		_add_dirs(path);
+	}
+}
+
+void PackedData::_add_dirs(const String &p_path) {
 
-		if (p.find("/") != -1) { //in a subdir
+	//search for dir
+	String p = p_path.replace_first("res://", "");
+	PackedDir *cd = root;
 
-			Vector<String> ds = p.get_base_dir().split("/");
+	if (p.find("/") != -1) { //in a subdir
 
-			for (int j = 0; j < ds.size(); j++) {
+		Vector<String> ds = p.get_base_dir().split("/");
 
-				if (!cd->subdirs.has(ds[j])) {
+		for (int j = 0; j < ds.size(); j++) {
 
-					PackedDir *pd = memnew(PackedDir);
-					pd->name = ds[j];
-					pd->parent = cd;
-					cd->subdirs[pd->name] = pd;
-					cd = pd;
-				} else {
-					cd = cd->subdirs[ds[j]];
-				}
+			if (!cd->subdirs.has(ds[j])) {
+
+				PackedDir *pd = memnew(PackedDir);
+				pd->name = ds[j];
+				pd->parent = cd;
+				cd->subdirs[pd->name] = pd;
+				cd = pd;
+			} else {
+				cd = cd->subdirs[ds[j]];
 			}
 		}
-		String filename = path.get_file();
-		// Don't add as a file if the path points to a directory
-		if (!filename.empty()) {
-			cd->files.insert(filename);
+	}
+	String filename = p_path.get_file();
+	// Don't add as a file if the path points to a directory
+	if (!filename.empty()) {
+		cd->files.insert(filename);
+	}
+}
+
+void PackedData::_add_index_dirs() {
+
+	for (int i = indices_in_dirs; i < indices.size(); i++) {
+
+		const PackIndex *index = indices[i];
+		for (uint32_t j = 0; j < index->count; j++) {
+			_add_dirs(index->get_path(j));
 		}
 	}
+	indices_in_dirs = indices.size();
+}
+
+void PackedData::add_pack_index(PackIndex *p_index, bool p_replace_files) {
+
+	p_index->layer = layer_count;
+	p_index->replace_files = p_replace_files;
+	indices.push_back(p_index);
+}
+
+bool PackedData::_find_file(const String &p_path, PackedFile &r_file) const {
+
+	Vector<uint8_t> md5 = p_path.md5_buffer();
+	const Map<PathMD5, PackedFile>::Element *E = files.find(PathMD5(md5));
+	if (likely(indices.empty())) {
+		if (E) {
+			r_file = E->get();
+		}
+		return E != NULL;
+	}
+
+	//go through the packs in the order they were added, a later pack only takes a file over if it replaces files
+	bool found = false;
+	for (int i = 0; i < indices.size(); i++) {
+
+		const PackIndex *index = indices[i];
+		if (E && E->get().layer < index->layer) {
+			if (!found || E->get().replace) {
+				r_file = E->get();
+				found = true;
+			}
+			E = NULL;
+		}
+
+		if ((!found || index->replace_files) && index->find(md5.ptr(), r_file)) {
+			found = true;
+		}
+	}
+
+	if (E && (!found || E->get().replace)) {
+		r_file = E->get();
+		found = true;
+	}
+
+	return found;
 }
 
 void PackedData::add_pack_source(PackSource *p_source) {
@@ -108,8 +176,10 @@ PackedData *PackedData::singleton = NULL;
 PackedData::PackedData() {
 
 	singleton = this;
+	layer_count = 0;
 	root = memnew(PackedDir);
 	root->parent = NULL;
+	indices_in_dirs = 0;
 	disabled = false;
 
 	add_pack_source(memnew(PackedSourcePCK));
@@ -127,11 +197,167 @@ PackedData::~PackedData() {
 	for (int i = 0; i < sources.size(); i++) {
 		memdelete(sources[i]);
 	}
+	for (int i = 0; i < indices.size(); i++) {
+		memdelete(indices[i]);
+	}
 	_free_packed_dirs(root);
 }
 
 //////////////////////////////////////////////////////////////////
 
+bool PackedData::PackIndex::find(const uint8_t *p_path_md5, PackedFile &r_file) const {
+
+	uint32_t low = 0;
+	uint32_t high = count;
+
+	while (low < high) {
+
+		uint32_t middle = low + (high - low) / 2;
+		const uint8_t *entry = &entries[middle * ENTRY_SIZE];
+		int cmp = memcmp(entry, p_path_md5, 16);
+
+		if (cmp < 0) {
+			low = middle + 1;
+		} else if (cmp > 0) {
+			high = middle;
+		} else {
+			r_file.pack = pack;
+			r_file.offset = decode_uint64(&entry[16]);
+			r_file.size = decode_uint64(&entry[24]);
+			copymem(r_file.md5, &entry[32], 16);
+			r_file.src = src;
+			r_file.layer = layer;
+			r_file.replace = replace_files;
+			r_file.flags = decode_uint32(&entry[56]);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+String PackedData::PackIndex::get_path(uint32_t p_index) const {
+
+	ERR_FAIL_COND_V(p_index >= count, String());
+
+	const uint8_t *entry = &entries[p_index * ENTRY_SIZE];
+	uint32_t ofs = decode_uint32(&entry[48]);
+	uint32_t len = decode_uint32(&entry[52]);
+	ERR_FAIL_COND_V(uint64_t(ofs) + len > strings_size, String());
+
+	String path;
+	path.parse_utf8((const char *)&strings[ofs], len);
+	return path;
+}
+
+PackedData::PackIndex::~PackIndex() {
+
+	if (f) {
+		memdelete(f);
+	}
+}
+
+void PackedData::PackIndexWriter::add_file(const String &p_path, uint64_t p_offset, uint64_t p_size, const uint8_t *p_md5, uint32_t p_flags) {
+
+	Entry e;
+	Vector<uint8_t> path_md5 = p_path.md5_buffer();
+	copymem(e.path_md5, path_md5.ptr(), 16);
+	e.offset = p_offset;
+	e.size = p_size;
+	if (p_md5) {
+		copymem(e.md5, p_md5, 16);
+	} else {
+		zeromem(e.md5, 16);
+	}
+	e.path = p_path.utf8();
+	e.flags = p_flags;
+	entries.push_back(e);
+}
+
+void PackedData::PackIndexWriter::store(FileAccess *p_file, uint64_t p_pack_start) {
+
+	entries.sort();
+
+	uint64_t index_ofs = p_file->get_position();
+
+	p_file->store_32(entries.size());
+	uint32_t strings_size = 0;
+	for (int i = 0; i < entries.size(); i++) {
+		strings_size += entries[i].path.length();
+	}
+	p_file->store_32(strings_size);
+
+	bool compressed = false;
+	uint32_t string_ofs = 0;
+	for (int i = 0; i < entries.size(); i++) {
+
+		const Entry &e = entries[i];
+		p_file->store_buffer(e.path_md5, 16);
+		p_file->store_64(e.offset);
+		p_file->store_64(e.size);
+		p_file->store_buffer(e.md5, 16);
+		p_file->store_32(string_ofs);
+		p_file->store_32(e.path.length());
+		p_file->store_32(e.flags);
+		p_file->store_32(0); //reserved
+		string_ofs += e.path.length();
+		compressed = compressed || (e.flags & PACK_FILE_COMPRESSED);
+	}
+
+	for (int i = 0; i < entries.size(); i++) {
+		p_file->store_buffer((const uint8_t *)entries[i].path.get_data(), entries[i].path.length());
+	}
+
+	uint64_t end = p_file->get_position();
+
+	if (compressed) {
+		p_file->seek(p_pack_start + 4);
+		p_file->store_32(PACK_FORMAT_VERSION_COMPRESSED);
+	}
+
+	//point the header to the index, the reserved fields come after magic, format version and engine version
+	p_file->seek(p_pack_start + 5 * 4);
+	p_file->store_32(PACK_FLAG_INDEX);
+	p_file->store_32(index_ofs & 0xFFFFFFFF);
+	p_file->store_32(index_ofs >> 32);
+	p_file->seek(end);
+}
+
+//////////////////////////////////////////////////////////////////
+
+static PackedData::PackIndex *_open_pack_index(FileAccess *f, uint64_t p_ofs) {
+
+	f->seek(p_ofs);
+	uint32_t count = f->get_32();
+	uint32_t strings_size = f->get_32();
+
+	uint64_t size = uint64_t(count) * PackedData::PackIndex::ENTRY_SIZE + strings_size;
+	ERR_FAIL_COND_V_MSG(f->eof_reached() || size > 0x7FFFFFFF || p_ofs + 8 + size > f->get_len(), NULL, "Invalid pack file index.");
+
+	PackedData::PackIndex *index = memnew(PackedData::PackIndex);
+	index->count = count;
+	index->strings_size = strings_size;
+
+	//mapped packs are searched in place, only the pages that are looked at get loaded
+	int viewed = 0;
+	const uint8_t *view = f->get_buffer_view(size, viewed);
+	if (view && uint64_t(viewed) == size) {
+		index->f = f;
+		index->entries = view;
+	} else {
+		f->seek(p_ofs + 8);
+		index->data.resize(size);
+		if (uint64_t(f->get_buffer(index->data.ptrw(), size)) != size) {
+			memdelete(index);
+			ERR_FAIL_V_MSG(NULL, "Invalid pack file index.");
+		}
+		index->entries = index->data.ptr();
+	}
+	index->strings = index->entries + uint64_t(count) * PackedData::PackIndex::ENTRY_SIZE;
+
+	return index;
+}
+
 bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files) {
 
 	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
@@ -170,7 +396,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files)
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	if (version != PACK_FORMAT_VERSION) {
+	if (version != PACK_FORMAT_VERSION && version != PACK_FORMAT_VERSION_COMPRESSED) {
 		f->close();
 		memdelete(f);
 		ERR_FAIL_V_MSG(false, "Pack version unsupported: " + itos(version) + ".");
@@ -181,9 +407,34 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files)
 		ERR_FAIL_V_MSG(false, "Pack created with a newer version of the engine: " + itos(ver_major) + "." + itos(ver_minor) + ".");
 	}
 
+	uint32_t reserved[16];
 	for (int i = 0; i < 16; i++) {
-		//reserved
-		f->get_32();
+		reserved[i] = f->get_32();
+	}
+
+	if (reserved[0] & PACK_FLAG_INDEX) {
+
+		size_t list_pos = f->get_position();
+		PackedData::PackIndex *index = _open_pack_index(f, reserved[1] | (uint64_t(reserved[2]) << 32));
+		if (index) {
+			index->pack = p_path;
+			index->src = this;
+			PackedData::get_singleton()->add_pack_index(index, p_replace_files);
+			if (!index->f) {
+				f->close();
+				memdelete(f);
+			}
+			return true;
+		}
+
+		if (version == PACK_FORMAT_VERSION_COMPRESSED) {
+			f->close();
+			memdelete(f);
+			ERR_FAIL_V_MSG(false, "Can't read the file index of pack: " + p_path + ".");
+		}
+
+		//broken index, the file list can still be used
+		f->seek(list_pos);
 	}
 
 	int file_count = f->get_32();
@@ -213,7 +464,27 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files)
 
 FileAccess *PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
 
-	return memnew(FileAccessPack(p_path, *p_file));
+	FileAccess *f = memnew(FileAccessPack(p_path, *p_file));
+	if (!(p_file->flags & PACK_FILE_COMPRESSED)) {
+		return f;
+	}
+
+	uint8_t magic[4];
+	if (f->get_buffer(magic, 4) != 4 || memcmp(magic, PACK_FILE_COMPRESSED_MAGIC, 4) != 0) {
+		memdelete(f);
+		ERR_FAIL_V_MSG(NULL, "Compressed file in pack is corrupted: " + p_path + ".");
+	}
+
+	//blocks are decompressed on the thread that reads them
+	FileAccessCompressed *fac = memnew(FileAccessCompressed);
+	fac->configure(PACK_FILE_COMPRESSED_MAGIC);
+	Error err = fac->open_after_magic(f);
+	if (err != OK) {
+		memdelete(fac);
+		memdelete(f);
+		ERR_FAIL_V_MSG(NULL, "Compressed file in pack is corrupted: " + p_path + ".");
+	}
+	return fac;
 };
 
 //////////////////////////////////////////////////////////////////
@@ -294,6 +565,25 @@ int FileAccessPack::get_buffer(uint8_t *p_dst, int p_length) const {
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_buffer_view(int p_length, int &r_length) const {
+
+	ERR_FAIL_COND_V(p_length < 0, NULL);
+
+	int64_t left = eof ? 0 : MAX(int64_t(pf.size) - int64_t(pos), 0);
+	int to_view = MIN(int64_t(p_length), left);
+
+	const uint8_t *view = f->get_buffer_view(to_view, r_length);
+	if (!view) {
+		return NULL; //the pack isn't mapped, nothing was read
+	}
+
+	pos += r_length;
+	if (r_length < p_length) {
+		eof = true;
+	}
+	return view;
+}
+
 void FileAccessPack::set_endian_swap(bool p_swap) {
 	FileAccess::set_endian_swap(p_swap);
 	f->set_endian_swap(p_swap);
@@ -348,6 +638,8 @@ FileAccessPack::~FileAccessPack() {
 
 Error DirAccessPack::list_dir_begin() {
 
+	PackedData::get_singleton()->_ensure_dirs();
+
 	list_dirs.clear();
 	list_files.clear();
 
@@ -405,6 +697,8 @@ String DirAccessPack::get_drive(int p_drive) {
 
 Error DirAccessPack::change_dir(String p_dir) {
 
+	PackedData::get_singleton()->_ensure_dirs();
+
 	String nd = p_dir.replace("\\", "/");
 	bool absolute = false;
 	if (nd.begins_with("res://")) {
@@ -471,6 +765,7 @@ bool DirAccessPack::file_exists(String p_file) {
 
 	p_file = fix_path(p_file);
 
+	PackedData::get_singleton()->_ensure_dirs();
 	return current->files.has(p_file);
 }
 
@@ -478,6 +773,7 @@ bool DirAccessPack::dir_exists(String p_dir) {
 
 	p_dir = fix_path(p_dir);
 
+	PackedData::get_singleton()->_ensure_dirs();
 	return current->subdirs.has(p_dir);
 }
 
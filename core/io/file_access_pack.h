@@ -41,6 +41,17 @@
 #define PACK_HEADER_MAGIC 0x43504447
 // The current packed file format version number.
 #define PACK_FORMAT_VERSION 1
+// Set in the first reserved header field when the pack has a sorted file index, the next two fields hold its offset.
+// Older versions ignore the reserved fields and read the file list that follows the header, which is still stored.
+#define PACK_FLAG_INDEX 1
+// Packs with compressed files use this version instead, so older versions refuse them rather than read compressed data.
+#define PACK_FORMAT_VERSION_COMPRESSED 2
+
+// Flag of files stored compressed, in the FileAccessCompressed format with this magic. Only packs with an index have them.
+#define PACK_FILE_COMPRESSED 1
+#define PACK_FILE_COMPRESSED_MAGIC "GCPF"
+// Compressed files are split in blocks of this size, seeking only decompresses the block that is read.
+#define PACK_FILE_COMPRESSED_BLOCK_SIZE (64 * 1024)
 
 class PackSource;
 
@@ -57,6 +68,68 @@ public:
 		uint64_t size;
 		uint8_t md5[16];
 		PackSource *src;
+		uint32_t layer; //order of the pack it comes from, for packs that don't replace files
+		bool replace;
+		uint32_t flags;
+	};
+
+	// Sorted index of a pack, searched in place instead of loading every file into the map.
+	// Entries are sorted by the MD5 of their path and stored as:
+	// path MD5 (16 bytes), offset (64 bits), size (64 bits), file MD5 (16 bytes), path offset and length in the string table,
+	// flags and a reserved field (32 bits each).
+	struct PackIndex {
+
+		enum {
+			ENTRY_SIZE = 64
+		};
+
+		String pack;
+		PackSource *src;
+		uint32_t layer;
+		bool replace_files;
+
+		FileAccess *f; //kept open while the index is a view of it
+		Vector<uint8_t> data; //copy of the index, when it couldn't be viewed
+		const uint8_t *entries;
+		const uint8_t *strings;
+		uint32_t count;
+		uint32_t strings_size;
+
+		bool find(const uint8_t *p_path_md5, PackedFile &r_file) const;
+		String get_path(uint32_t p_index) const;
+
+		PackIndex() :
+				src(NULL),
+				layer(0),
+				replace_files(false),
+				f(NULL),
+				entries(NULL),
+				strings(NULL),
+				count(0),
+				strings_size(0) {}
+		~PackIndex();
+	};
+
+	// Collects the files of a pack while it's written, then stores its PackIndex.
+	class PackIndexWriter {
+
+		struct Entry {
+			uint8_t path_md5[16];
+			uint64_t offset;
+			uint64_t size;
+			uint8_t md5[16];
+			CharString path;
+			uint32_t flags;
+
+			bool operator<(const Entry &p_entry) const { return memcmp(path_md5, p_entry.path_md5, 16) < 0; }
+		};
+
+		Vector<Entry> entries;
+
+	public:
+		void add_file(const String &p_path, uint64_t p_offset, uint64_t p_size, const uint8_t *p_md5, uint32_t p_flags = 0);
+		// Stores the index at the current position and points the header of the pack starting at p_pack_start to it.
+		void store(FileAccess *p_file, uint64_t p_pack_start);
 	};
 
 private:
@@ -94,20 +167,32 @@ private:
 	};
 
 	Map<PathMD5, PackedFile> files;
+	Vector<PackIndex *> indices;
+	uint32_t layer_count;
 
 	Vector<PackSource *> sources;
 
 	PackedDir *root;
+	int indices_in_dirs; //directories of indexed packs are only added when listed
 	//Map<String,PackedDir*> dirs;
 
 	static PackedData *singleton;
 	bool disabled;
 
 	void _free_packed_dirs(PackedDir *p_dir);
+	void _add_dirs(const String &p_path);
+	void _add_index_dirs();
+	_FORCE_INLINE_ void _ensure_dirs() {
+		if (unlikely(indices_in_dirs < indices.size())) {
+			_add_index_dirs();
+		}
+	}
+	bool _find_file(const String &p_path, PackedFile &r_file) const;
 
 public:
 	void add_pack_source(PackSource *p_source);
 	void add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files); // for PackSource
+	void add_pack_index(PackIndex *p_index, bool p_replace_files); // for PackSource, takes ownership
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
@@ -164,6 +249,7 @@ public:
 	virtual uint8_t get_8() const;
 
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
+	virtual const uint8_t *get_buffer_view(int p_length, int &r_length) const;
 
 	virtual void set_endian_swap(bool p_swap);
 
@@ -182,19 +268,19 @@ public:
 
 FileAccess *PackedData::try_open_path(const String &p_path) {
 
-	PathMD5 pmd5(p_path.md5_buffer());
-	Map<PathMD5, PackedFile>::Element *E = files.find(pmd5);
-	if (!E)
+	PackedFile pf;
+	if (!_find_file(p_path, pf))
 		return NULL; //not found
-	if (E->get().offset == 0)
+	if (pf.offset == 0)
 		return NULL; //was erased
 
-	return E->get().src->get_file(p_path, &E->get());
+	return pf.src->get_file(p_path, &pf);
 }
 
 bool PackedData::has_path(const String &p_path) {
 
-	return files.has(PathMD5(p_path.md5_buffer()));
+	PackedFile pf;
+	return _find_file(p_path, pf);
 }
 
 class DirAccessPack : public DirAccess {
@@ -31,6 +31,7 @@
 #include "image_loader.h"
 
 #include "core/print_string.h"
+#include "core/thread_work_pool.h"
 
 bool ImageFormatLoader::recognize(const String &p_extension) const {
 
@@ -46,6 +47,7 @@ bool ImageFormatLoader::recognize(const String &p_extension) const {
 }
 
 Error ImageLoader::load_image(String p_file, Ref<Image> p_image, FileAccess *p_custom, bool p_force_linear, float p_scale) {
+	MemoryTagScope memory_tag(Memory::TAG_TEXTURES);
 	ERR_FAIL_COND_V_MSG(p_image.is_null(), ERR_INVALID_PARAMETER, "It's not a reference to a valid Image object.");
 
 	FileAccess *f = p_custom;
@@ -84,6 +86,51 @@ Error ImageLoader::load_image(String p_file, Ref<Image> p_image, FileAccess *p_c
 	return ERR_FILE_UNRECOGNIZED;
 }
 
+struct ImageLoaderBatch {
+	const String *files;
+	Ref<Image> *images;
+	bool force_linear;
+	float scale;
+
+	void load(uint32_t p_index, void *p_userdata) {
+		Ref<Image> image;
+		image.instance();
+		if (ImageLoader::load_image(files[p_index], image, NULL, force_linear, scale) == OK) {
+			images[p_index] = image;
+		}
+	}
+};
+
+Error ImageLoader::load_images(const Vector<String> &p_files, Vector<Ref<Image>> &r_images, bool p_force_linear, float p_scale) {
+
+	r_images.clear();
+	r_images.resize(p_files.size());
+
+	ImageLoaderBatch batch;
+	batch.files = p_files.ptr();
+	batch.images = r_images.ptrw();
+	batch.force_linear = p_force_linear;
+	batch.scale = p_scale;
+
+	//each file is opened and decoded by its own task, loaders keep no shared state
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (p_files.size() > 1 && pool && pool->get_thread_count() > 0) {
+		pool->do_work(p_files.size(), &batch, &ImageLoaderBatch::load, (void *)NULL);
+	} else {
+		for (int i = 0; i < p_files.size(); i++) {
+			batch.load(i, NULL);
+		}
+	}
+
+	for (int i = 0; i < r_images.size(); i++) {
+		if (r_images[i].is_null()) {
+			return FAILED;
+		}
+	}
+
+	return OK;
+}
+
 void ImageLoader::get_recognized_extensions(List<String> *p_extensions) {
 
 	for (int i = 0; i < loader.size(); i++) {
@@ -60,6 +60,8 @@ class ImageLoader {
 protected:
 public:
 	static Error load_image(String p_file, Ref<Image> p_image, FileAccess *p_custom = NULL, bool p_force_linear = false, float p_scale = 1.0);
+	// Decodes independent files concurrently on the ThreadWorkPool, r_images gets a null entry for each one that failed.
+	static Error load_images(const Vector<String> &p_files, Vector<Ref<Image>> &r_images, bool p_force_linear = false, float p_scale = 1.0);
 	static void get_recognized_extensions(List<String> *p_extensions);
 	static ImageFormatLoader *recognize(const String &p_extension);
 
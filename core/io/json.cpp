@@ -31,6 +31,7 @@
 #include "json.h"
 
 #include "core/print_string.h"
+#include "core/string_builder.h"
 
 const char *JSON::tk_name[TK_MAX] = {
 	"'{'",
@@ -45,32 +46,27 @@ const char *JSON::tk_name[TK_MAX] = {
 	"EOF",
 };
 
-static String _make_indent(const String &p_indent, int p_size) {
+static void _append_indent(StringBuilder &r_out, const String &p_indent, int p_size) {
 
-	String indent_text = "";
 	if (!p_indent.empty()) {
 		for (int i = 0; i < p_size; i++)
-			indent_text += p_indent;
+			r_out.append(p_indent);
 	}
-	return indent_text;
 }
 
-String JSON::_print_var(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys) {
+void JSON::_print_var(StringBuilder &r_out, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys) {
 
-	String colon = ":";
-	String end_statement = "";
-
-	if (!p_indent.empty()) {
-		colon += " ";
-		end_statement += "\n";
-	}
+	//everything is appended to one builder and joined once at the end, instead of concatenated per level
+	const char *colon = p_indent.empty() ? ":" : ": ";
+	const char *separator = p_indent.empty() ? "," : ",\n";
+	const char *end_statement = p_indent.empty() ? "" : "\n";
 
 	switch (p_var.get_type()) {
 
-		case Variant::NIL: return "null";
-		case Variant::BOOL: return p_var.operator bool() ? "true" : "false";
-		case Variant::INT: return itos(p_var);
-		case Variant::FLOAT: return rtos(p_var);
+		case Variant::NIL: r_out.append("null"); return;
+		case Variant::BOOL: r_out.append(p_var.operator bool() ? "true" : "false"); return;
+		case Variant::INT: r_out.append(itos(p_var)); return;
+		case Variant::FLOAT: r_out.append(rtos(p_var)); return;
 		case Variant::PACKED_INT32_ARRAY:
 		case Variant::PACKED_INT64_ARRAY:
 		case Variant::PACKED_FLOAT32_ARRAY:
@@ -78,23 +74,25 @@ String JSON::_print_var(const Variant &p_var, const String &p_indent, int p_cur_
 		case Variant::PACKED_STRING_ARRAY:
 		case Variant::ARRAY: {
 
-			String s = "[";
-			s += end_statement;
+			r_out.append("[");
+			r_out.append(end_statement);
 			Array a = p_var;
 			for (int i = 0; i < a.size(); i++) {
 				if (i > 0) {
-					s += ",";
-					s += end_statement;
+					r_out.append(separator);
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _print_var(a[i], p_indent, p_cur_indent + 1, p_sort_keys);
+				_append_indent(r_out, p_indent, p_cur_indent + 1);
+				_print_var(r_out, a[i], p_indent, p_cur_indent + 1, p_sort_keys);
 			}
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "]";
-			return s;
+			r_out.append(end_statement);
+			_append_indent(r_out, p_indent, p_cur_indent);
+			r_out.append("]");
+			return;
 		};
 		case Variant::DICTIONARY: {
 
-			String s = "{";
-			s += end_statement;
+			r_out.append("{");
+			r_out.append(end_statement);
 			Dictionary d = p_var;
 			List<Variant> keys;
 			d.get_key_list(&keys);
@@ -105,24 +103,33 @@ String JSON::_print_var(const Variant &p_var, const String &p_indent, int p_cur_
 			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
 
 				if (E != keys.front()) {
-					s += ",";
-					s += end_statement;
+					r_out.append(separator);
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _print_var(String(E->get()), p_indent, p_cur_indent + 1, p_sort_keys);
-				s += colon;
-				s += _print_var(d[E->get()], p_indent, p_cur_indent + 1, p_sort_keys);
+				_append_indent(r_out, p_indent, p_cur_indent + 1);
+				_print_var(r_out, String(E->get()), p_indent, p_cur_indent + 1, p_sort_keys);
+				r_out.append(colon);
+				_print_var(r_out, d[E->get()], p_indent, p_cur_indent + 1, p_sort_keys);
 			}
 
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "}";
-			return s;
+			r_out.append(end_statement);
+			_append_indent(r_out, p_indent, p_cur_indent);
+			r_out.append("}");
+			return;
 		};
-		default: return "\"" + String(p_var).json_escape() + "\"";
+		default: {
+			r_out.append("\"");
+			r_out.append(String(p_var).json_escape());
+			r_out.append("\"");
+			return;
+		}
 	}
 }
 
 String JSON::print(const Variant &p_var, const String &p_indent, bool p_sort_keys) {
 
-	return _print_var(p_var, p_indent, 0, p_sort_keys);
+	StringBuilder out;
+	_print_var(out, p_var, p_indent, 0, p_sort_keys);
+	return out.as_string();
 }
 
 Error JSON::_get_token(const CharType *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str) {
@@ -245,9 +252,15 @@ Error JSON::_get_token(const CharType *p_str, int &index, int p_len, Token &r_to
 						str += res;
 
 					} else {
-						if (p_str[index] == '\n')
-							line++;
-						str += p_str[index];
+						//append runs of plain characters at once, instead of one at a time
+						int from = index;
+						while (p_str[index] != 0 && p_str[index] != '"' && p_str[index] != '\\') {
+							if (p_str[index] == '\n')
+								line++;
+							index++;
+						}
+						str += String(&p_str[from], index - from);
+						continue;
 					}
 					index++;
 				}
@@ -275,16 +288,27 @@ Error JSON::_get_token(const CharType *p_str, int &index, int p_len, Token &r_to
 
 				} else if ((p_str[index] >= 'A' && p_str[index] <= 'Z') || (p_str[index] >= 'a' && p_str[index] <= 'z')) {
 
-					String id;
+					int from = index;
 
 					while ((p_str[index] >= 'A' && p_str[index] <= 'Z') || (p_str[index] >= 'a' && p_str[index] <= 'z')) {
-
-						id += p_str[index];
 						index++;
 					}
 
-					r_token.type = TK_IDENTIFIER;
-					r_token.value = id;
+					//the only valid identifiers become their values right away, without building a String
+					int id_len = index - from;
+					if (id_len == 4 && p_str[from] == 't' && p_str[from + 1] == 'r' && p_str[from + 2] == 'u' && p_str[from + 3] == 'e') {
+						r_token.type = TK_IDENTIFIER;
+						r_token.value = true;
+					} else if (id_len == 5 && p_str[from] == 'f' && p_str[from + 1] == 'a' && p_str[from + 2] == 'l' && p_str[from + 3] == 's' && p_str[from + 4] == 'e') {
+						r_token.type = TK_IDENTIFIER;
+						r_token.value = false;
+					} else if (id_len == 4 && p_str[from] == 'n' && p_str[from + 1] == 'u' && p_str[from + 2] == 'l' && p_str[from + 3] == 'l') {
+						r_token.type = TK_IDENTIFIER;
+						r_token.value = Variant();
+					} else {
+						r_err_str = "Expected 'true','false' or 'null', got '" + String(&p_str[from], id_len) + "'.";
+						return ERR_PARSE_ERROR;
+					}
 					return OK;
 				} else {
 					r_err_str = "Unexpected character.";
@@ -318,17 +342,7 @@ Error JSON::_parse_value(Variant &value, Token &token, const CharType *p_str, in
 
 	} else if (token.type == TK_IDENTIFIER) {
 
-		String id = token.value;
-		if (id == "true")
-			value = true;
-		else if (id == "false")
-			value = false;
-		else if (id == "null")
-			value = Variant();
-		else {
-			r_err_str = "Expected 'true','false' or 'null', got '" + id + "'.";
-			return ERR_PARSE_ERROR;
-		}
+		value = token.value; //already resolved to true, false or null by the tokenizer
 		return OK;
 
 	} else if (token.type == TK_NUMBER) {
@@ -33,6 +33,8 @@
 
 #include "core/variant.h"
 
+class StringBuilder;
+
 class JSON {
 
 	enum TokenType {
@@ -65,7 +67,7 @@ class JSON {
 
 	static const char *tk_name[TK_MAX];
 
-	static String _print_var(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys);
+	static void _print_var(StringBuilder &r_out, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys);
 
 	static Error _get_token(const CharType *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str);
 	static Error _parse_value(Variant &value, Token &token, const CharType *p_str, int &index, int p_len, int &line, String &r_err_str);
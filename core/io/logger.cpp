@@ -208,9 +208,9 @@ void RotatedFileLogger::logv(const char *p_format, va_list p_list, bool p_err) {
 			Memory::free_static(buf);
 		}
 #ifdef DEBUG_ENABLED
-		const bool need_flush = true;
+		const bool need_flush = !buffered;
 #else
-		bool need_flush = p_err;
+		bool need_flush = p_err && !buffered;
 #endif
 		if (need_flush) {
 			file->flush();
@@ -218,6 +218,12 @@ void RotatedFileLogger::logv(const char *p_format, va_list p_list, bool p_err) {
 	}
 }
 
+void RotatedFileLogger::flush() {
+	if (file) {
+		file->flush();
+	}
+}
+
 RotatedFileLogger::~RotatedFileLogger() {
 	close_file();
 }
@@ -232,22 +238,129 @@ void StdLogger::logv(const char *p_format, va_list p_list, bool p_err) {
 	} else {
 		vprintf(p_format, p_list);
 #ifdef DEBUG_ENABLED
-		fflush(stdout);
+		if (!buffered) {
+			fflush(stdout);
+		}
 #endif
 	}
 }
 
+void StdLogger::flush() {
+	fflush(stdout);
+	fflush(stderr);
+}
+
 StdLogger::~StdLogger() {}
 
 CompositeLogger::CompositeLogger(Vector<Logger *> p_loggers) :
 		loggers(p_loggers) {
 }
 
+static CharString _format_message(const char *p_format, va_list p_list) {
+	const int static_buf_size = 512;
+	char static_buf[static_buf_size];
+	va_list list_copy;
+	va_copy(list_copy, p_list);
+	int len = vsnprintf(static_buf, static_buf_size, p_format, p_list);
+
+	CharString text;
+	if (len >= 0) {
+		text.resize(len + 1);
+		if (len < static_buf_size) {
+			memcpy(text.ptrw(), static_buf, len + 1);
+		} else {
+			vsnprintf(text.ptrw(), len + 1, p_format, list_copy);
+		}
+	}
+	va_end(list_copy);
+	return text;
+}
+
+void CompositeLogger::_thread_func(void *p_self) {
+	CompositeLogger *self = (CompositeLogger *)p_self;
+
+	while (true) {
+		self->semaphore.wait();
+		self->_write_queued();
+		if (self->exit_thread) {
+			break;
+		}
+	}
+}
+
+void CompositeLogger::_queue(const Message &p_message) {
+	queue_mutex.lock();
+	LocalVector<Message> &queue = queues[queue_index];
+	if (queue.size() >= max_queued) {
+		dropped++;
+		queue_mutex.unlock();
+		return;
+	}
+	queue.push_back(p_message);
+	// the thread writes everything it finds, so it only needs waking once per batch
+	bool wake = queue.size() == 1;
+	queue_mutex.unlock();
+
+	if (wake) {
+		semaphore.post();
+	}
+}
+
+void CompositeLogger::_dispatch(const Message &p_message) {
+	for (int i = 0; i < loggers.size(); ++i) {
+		if (p_message.error_report) {
+			loggers[i]->log_error(p_message.function.get_data(), p_message.file.get_data(), p_message.line, p_message.code.get_data(), p_message.rationale.get_data(), p_message.type);
+		} else if (p_message.err) {
+			loggers[i]->logf_error("%s", p_message.text.get_data());
+		} else {
+			loggers[i]->logf("%s", p_message.text.get_data());
+		}
+	}
+}
+
+void CompositeLogger::_write_queued() {
+	MutexLock write_lock(write_mutex);
+
+	queue_mutex.lock();
+	LocalVector<Message> &queue = queues[queue_index];
+	queue_index = 1 - queue_index;
+	uint32_t lost = dropped;
+	dropped = 0;
+	queue_mutex.unlock();
+
+	if (queue.size() == 0 && lost == 0) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < queue.size(); i++) {
+		_dispatch(queue[i]);
+	}
+	queue.clear();
+
+	if (lost) {
+		for (int i = 0; i < loggers.size(); ++i) {
+			loggers[i]->logf_error("WARNING: %u log messages were dropped, as they were issued faster than they could be written.\n", lost);
+		}
+	}
+
+	for (int i = 0; i < loggers.size(); ++i) {
+		loggers[i]->flush();
+	}
+}
+
 void CompositeLogger::logv(const char *p_format, va_list p_list, bool p_err) {
 	if (!should_log(p_err)) {
 		return;
 	}
 
+	if (thread) {
+		Message message;
+		message.text = _format_message(p_format, p_list);
+		message.err = p_err;
+		_queue(message);
+		return;
+	}
+
 	for (int i = 0; i < loggers.size(); ++i) {
 		va_list list_copy;
 		va_copy(list_copy, p_list);
@@ -261,16 +374,69 @@ void CompositeLogger::log_error(const char *p_function, const char *p_file, int
 		return;
 	}
 
+	if (thread) {
+		Message message;
+		message.error_report = true;
+		message.function = p_function;
+		message.file = p_file;
+		message.code = p_code;
+		message.rationale = p_rationale;
+		message.line = p_line;
+		message.type = p_type;
+		_queue(message);
+		return;
+	}
+
 	for (int i = 0; i < loggers.size(); ++i) {
 		loggers[i]->log_error(p_function, p_file, p_line, p_code, p_rationale, p_type);
 	}
 }
 
 void CompositeLogger::add_logger(Logger *p_logger) {
+	MutexLock write_lock(write_mutex);
+	p_logger->set_buffered(thread != NULL);
 	loggers.push_back(p_logger);
 }
 
+void CompositeLogger::set_async(bool p_async, uint32_t p_max_queued) {
+	if (p_async == (thread != NULL)) {
+		return;
+	}
+
+	if (p_async) {
+		max_queued = MAX(p_max_queued, 1u);
+		exit_thread = false;
+		for (int i = 0; i < loggers.size(); ++i) {
+			loggers[i]->set_buffered(true);
+		}
+		thread = Thread::create(_thread_func, this);
+	} else {
+		exit_thread = true;
+		semaphore.post();
+		Thread::wait_to_finish(thread);
+		memdelete(thread);
+		thread = NULL;
+		// anything queued after the thread's last batch
+		_write_queued();
+		for (int i = 0; i < loggers.size(); ++i) {
+			loggers[i]->set_buffered(false);
+		}
+	}
+}
+
+void CompositeLogger::flush() {
+	if (thread) {
+		_write_queued();
+		return;
+	}
+
+	for (int i = 0; i < loggers.size(); ++i) {
+		loggers[i]->flush();
+	}
+}
+
 CompositeLogger::~CompositeLogger() {
+	set_async(false);
 	for (int i = 0; i < loggers.size(); ++i) {
 		memdelete(loggers[i]);
 	}
@@ -31,7 +31,11 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include "core/local_vector.h"
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/ustring.h"
 #include "core/vector.h"
 
@@ -41,6 +45,8 @@ class Logger {
 protected:
 	bool should_log(bool p_err);
 
+	bool buffered = false; //if true, flushing is left to flush()
+
 public:
 	enum ErrorType {
 		ERR_ERROR,
@@ -55,6 +61,9 @@ public:
 	void logf(const char *p_format, ...) _PRINTF_FORMAT_ATTRIBUTE_2_3;
 	void logf_error(const char *p_format, ...) _PRINTF_FORMAT_ATTRIBUTE_2_3;
 
+	virtual void flush() {}
+	void set_buffered(bool p_buffered) { buffered = p_buffered; }
+
 	virtual ~Logger();
 };
 
@@ -65,6 +74,7 @@ class StdLogger : public Logger {
 
 public:
 	virtual void logv(const char *p_format, va_list p_list, bool p_err) _PRINTF_FORMAT_ATTRIBUTE_2_0;
+	virtual void flush();
 	virtual ~StdLogger();
 };
 
@@ -89,13 +99,45 @@ public:
 	RotatedFileLogger(const String &p_base_path, int p_max_files = 10);
 
 	virtual void logv(const char *p_format, va_list p_list, bool p_err) _PRINTF_FORMAT_ATTRIBUTE_2_0;
+	virtual void flush();
 
 	virtual ~RotatedFileLogger();
 };
 
+/**
+ * Sends messages to all its loggers. When asynchronous, messages are queued and
+ * a background thread writes them in batches, so callers never wait for the sinks.
+ */
 class CompositeLogger : public Logger {
 	Vector<Logger *> loggers;
 
+	struct Message {
+		CharString text;
+		bool err = false;
+		bool error_report = false; //from log_error(), replayed as such to keep the loggers' formatting
+		CharString function;
+		CharString file;
+		CharString code;
+		CharString rationale;
+		int line = 0;
+		ErrorType type = ERR_ERROR;
+	};
+
+	LocalVector<Message> queues[2];
+	uint32_t queue_index = 0; //queue being filled, the other one is being written
+	uint32_t max_queued = 0;
+	uint32_t dropped = 0;
+	Mutex queue_mutex;
+	Mutex write_mutex;
+	Semaphore semaphore;
+	Thread *thread = NULL;
+	bool exit_thread = false;
+
+	static void _thread_func(void *p_self);
+	void _queue(const Message &p_message);
+	void _write_queued();
+	void _dispatch(const Message &p_message);
+
 public:
 	CompositeLogger(Vector<Logger *> p_loggers);
 
@@ -104,6 +146,11 @@ public:
 
 	void add_logger(Logger *p_logger);
 
+	// Messages over p_max_queued, while the thread is behind, are dropped and counted.
+	void set_async(bool p_async, uint32_t p_max_queued = 4096);
+	bool is_async() const { return thread != NULL; }
+	virtual void flush(); //writes everything queued so far, from the calling thread
+
 	virtual ~CompositeLogger();
 };
 
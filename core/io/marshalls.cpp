@@ -870,16 +870,20 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 static void _encode_string(const String &p_string, uint8_t *&buf, int &r_len) {
 
-	CharString utf8 = p_string.utf8();
-
+	int len;
 	if (buf) {
-		encode_uint32(utf8.length(), buf);
+		CharString utf8 = p_string.utf8();
+		len = utf8.length();
+		encode_uint32(len, buf);
 		buf += 4;
-		copymem(buf, utf8.get_data(), utf8.length());
-		buf += utf8.length();
+		copymem(buf, utf8.get_data(), len);
+		buf += len;
+	} else {
+		//sizing pass, no need to convert
+		len = p_string.utf8_length();
 	}
 
-	r_len += 4 + utf8.length();
+	r_len += 4 + len;
 	while (r_len % 4) {
 		r_len++; //pad
 		if (buf) {
@@ -1018,21 +1022,29 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				else
 					str = np.get_subname(i - np.get_name_count());
 
-				CharString utf8 = str.utf8();
+				int len;
+				if (buf) {
+					CharString utf8 = str.utf8();
+					len = utf8.length();
+					encode_uint32(len, buf);
+					buf += 4;
+					copymem(buf, utf8.get_data(), len);
+					buf += len;
+				} else {
+					len = str.utf8_length();
+				}
 
 				int pad = 0;
 
-				if (utf8.length() % 4)
-					pad = 4 - utf8.length() % 4;
+				if (len % 4)
+					pad = 4 - len % 4;
 
 				if (buf) {
-					encode_uint32(utf8.length(), buf);
-					buf += 4;
-					copymem(buf, utf8.get_data(), utf8.length());
-					buf += pad + utf8.length();
+					zeromem(buf, pad);
+					buf += pad;
 				}
 
-				r_len += 4 + utf8.length() + pad;
+				r_len += 4 + len + pad;
 			}
 
 		} break;
@@ -1307,13 +1319,11 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			}
 			r_len += 4;
 
-			List<Variant> keys;
-			d.get_key_list(&keys);
-
-			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+			//walk the keys in place, copying them to a list would allocate on both passes
+			for (const Variant *K = d.next(); K; K = d.next(K)) {
 
 				/*
-				CharString utf8 = E->->utf8();
+				CharString utf8 = K->utf8();
 
 				if (buf) {
 					encode_uint32(utf8.length()+1,buf);
@@ -1326,12 +1336,12 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 					r_len++; //pad
 				*/
 				int len;
-				encode_variant(E->get(), buf, len, p_full_objects);
+				encode_variant(*K, buf, len, p_full_objects);
 				ERR_FAIL_COND_V(len % 4, ERR_BUG);
 				r_len += len;
 				if (buf)
 					buf += len;
-				Variant *v = d.getptr(E->get());
+				const Variant *v = d.getptr(*K);
 				ERR_FAIL_COND_V(!v, ERR_BUG);
 				encode_variant(*v, buf, len, p_full_objects);
 				ERR_FAIL_COND_V(len % 4, ERR_BUG);
@@ -1457,27 +1467,31 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 		case Variant::PACKED_STRING_ARRAY: {
 
 			Vector<String> data = p_variant;
-			int len = data.size();
+			int count = data.size();
+			const String *r = data.ptr();
 
 			if (buf) {
-				encode_uint32(len, buf);
+				encode_uint32(count, buf);
 				buf += 4;
 			}
 
 			r_len += 4;
 
-			for (int i = 0; i < len; i++) {
-
-				CharString utf8 = data.get(i).utf8();
+			for (int i = 0; i < count; i++) {
 
+				int len;
 				if (buf) {
-					encode_uint32(utf8.length() + 1, buf);
+					CharString utf8 = r[i].utf8();
+					len = utf8.length();
+					encode_uint32(len + 1, buf);
 					buf += 4;
-					copymem(buf, utf8.get_data(), utf8.length() + 1);
-					buf += utf8.length() + 1;
+					copymem(buf, utf8.get_data(), len + 1);
+					buf += len + 1;
+				} else {
+					len = r[i].utf8_length();
 				}
 
-				r_len += 4 + utf8.length() + 1;
+				r_len += 4 + len + 1;
 				while (r_len % 4) {
 					r_len++; //pad
 					if (buf)
@@ -1577,3 +1591,28 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 	return OK;
 }
+
+Error encode_variants(const Variant *p_variants, int p_count, Vector<uint8_t> &r_buffer, bool p_full_objects) {
+
+	//size everything first, so the buffer is resized (and copied) only once
+	int total = 0;
+	for (int i = 0; i < p_count; i++) {
+		int len;
+		Error err = encode_variant(p_variants[i], NULL, len, p_full_objects);
+		ERR_FAIL_COND_V(err != OK, err);
+		total += len;
+	}
+
+	int ofs = r_buffer.size();
+	ERR_FAIL_COND_V(r_buffer.resize(ofs + total) != OK, ERR_OUT_OF_MEMORY);
+	uint8_t *w = r_buffer.ptrw() + ofs;
+
+	for (int i = 0; i < p_count; i++) {
+		int len;
+		Error err = encode_variant(p_variants[i], w, len, p_full_objects);
+		ERR_FAIL_COND_V(err != OK, err);
+		w += len;
+	}
+
+	return OK;
+}
@@ -201,5 +201,7 @@ public:
 
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = NULL, bool p_allow_objects = false);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false);
+// Appends the encoding of each variant to r_buffer, growing it once for the whole batch.
+Error encode_variants(const Variant *p_variants, int p_count, Vector<uint8_t> &r_buffer, bool p_full_objects = false);
 
 #endif // MARSHALLS_H
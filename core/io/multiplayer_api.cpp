@@ -98,11 +98,36 @@ _FORCE_INLINE_ bool _can_call_mode(Node *p_node, MultiplayerAPI::RPCMode mode, i
 	return false;
 }
 
+#ifdef DEBUG_ENABLED
+void _profile_node_data(const String &p_what, ObjectID p_id) {
+	if (EngineDebugger::is_profiling("multiplayer")) {
+		Array values;
+		values.push_back("node");
+		values.push_back(p_id);
+		values.push_back(p_what);
+		EngineDebugger::profiler_add_frame_data("multiplayer", values);
+	}
+}
+void _profile_bandwidth_data(const String &p_inout, int p_size) {
+	if (EngineDebugger::is_profiling("multiplayer")) {
+		Array values;
+		values.push_back("bandwidth");
+		values.push_back(p_inout);
+		values.push_back(OS::get_singleton()->get_ticks_msec());
+		values.push_back(p_size);
+		EngineDebugger::profiler_add_frame_data("multiplayer", values);
+	}
+}
+#endif
+
 void MultiplayerAPI::poll() {
 
 	if (!network_peer.is_valid() || network_peer->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED)
 		return;
 
+	replicator->send();
+	_flush_batches();
+
 	network_peer->poll();
 
 	if (!network_peer.is_valid()) // It's possible that polling might have resulted in a disconnection, so check here.
@@ -120,6 +145,10 @@ void MultiplayerAPI::poll() {
 			break; // Something is wrong!
 		}
 
+#ifdef DEBUG_ENABLED
+		_profile_bandwidth_data("in", len);
+#endif
+
 		rpc_sender_id = sender;
 		_process_packet(sender, packet, len);
 		rpc_sender_id = 0;
@@ -135,6 +164,8 @@ void MultiplayerAPI::clear() {
 	path_get_cache.clear();
 	path_send_cache.clear();
 	packet_cache.clear();
+	peer_batches.clear();
+	replicator->clear();
 	last_send_cache_id = 1;
 }
 
@@ -173,28 +204,6 @@ Ref<NetworkedMultiplayerPeer> MultiplayerAPI::get_network_peer() const {
 	return network_peer;
 }
 
-#ifdef DEBUG_ENABLED
-void _profile_node_data(const String &p_what, ObjectID p_id) {
-	if (EngineDebugger::is_profiling("multiplayer")) {
-		Array values;
-		values.push_back("node");
-		values.push_back(p_id);
-		values.push_back(p_what);
-		EngineDebugger::profiler_add_frame_data("multiplayer", values);
-	}
-}
-void _profile_bandwidth_data(const String &p_inout, int p_size) {
-	if (EngineDebugger::is_profiling("multiplayer")) {
-		Array values;
-		values.push_back("bandwidth");
-		values.push_back(p_inout);
-		values.push_back(OS::get_singleton()->get_ticks_msec());
-		values.push_back(p_size);
-		EngineDebugger::profiler_add_frame_data("multiplayer", values);
-	}
-}
-#endif
-
 // Returns the packet size stripping the node path added when the node is not yet cached.
 int get_packet_len(uint32_t p_node_target, int p_packet_len) {
 	if (p_node_target & 0x80000000) {
@@ -210,10 +219,6 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 	ERR_FAIL_COND_MSG(root_node == NULL, "Multiplayer root node was not initialized. If you are using custom multiplayer, remember to set the root node via MultiplayerAPI.set_root_node before using it.");
 	ERR_FAIL_COND_MSG(p_packet_len < 1, "Invalid packet received. Size too small.");
 
-#ifdef DEBUG_ENABLED
-	_profile_bandwidth_data("in", p_packet_len);
-#endif
-
 	// Extract the `packet_type` from the LSB three bits:
 	uint8_t packet_type = p_packet[0] & 7;
 
@@ -316,6 +321,21 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 
 			_process_raw(p_from, p_packet, p_packet_len);
 		} break;
+
+		case NETWORK_COMMAND_BATCH: {
+
+			_process_batch(p_from, p_packet, p_packet_len);
+		} break;
+
+		case NETWORK_COMMAND_REPLICATE: {
+
+			replicator->process_snapshot(p_from, p_packet, p_packet_len);
+		} break;
+
+		case NETWORK_COMMAND_REPLICATE_ACK: {
+
+			replicator->process_ack(p_from, p_packet, p_packet_len);
+		} break;
 	}
 }
 
@@ -513,9 +533,7 @@ void MultiplayerAPI::_process_simplify_path(int p_from, const uint8_t *p_packet,
 	packet.write[1] = valid_rpc_checksum;
 	encode_cstring(pname.get_data(), &packet.write[2]);
 
-	network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
-	network_peer->set_target_peer(p_from);
-	network_peer->put_packet(packet.ptr(), packet.size());
+	_send_packet(p_from, NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE, packet.ptr(), packet.size());
 }
 
 void MultiplayerAPI::_process_confirm_path(int p_from, const uint8_t *p_packet, int p_packet_len) {
@@ -533,7 +551,7 @@ void MultiplayerAPI::_process_confirm_path(int p_from, const uint8_t *p_packet,
 		ERR_PRINT("The rpc node checksum failed. Make sure to have the same methods on both nodes. Node path: " + path);
 	}
 
-	PathSentCache *psc = path_send_cache.getptr(path);
+	PathSentCache *psc = path_send_cache.lookup_ptr(path);
 	ERR_FAIL_COND_MSG(!psc, "Invalid packet received. Tries to confirm a path which was not found in cache.");
 
 	Map<int, bool>::Element *E = psc->confirmed_peers.find(p_from);
@@ -593,9 +611,7 @@ bool MultiplayerAPI::_send_confirm_path(Node *p_node, NodePath p_path, PathSentC
 
 		for (List<int>::Element *E = peers_to_add.front(); E; E = E->next()) {
 
-			network_peer->set_target_peer(E->get()); // To all of you.
-			network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
-			network_peer->put_packet(packet.ptr(), packet.size());
+			_send_packet(E->get(), NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE, packet.ptr(), packet.size()); // To all of you.
 
 			psc->confirmed_peers.insert(E->get(), false); // Insert into confirmed, but as false since it was not confirmed.
 		}
@@ -604,21 +620,176 @@ bool MultiplayerAPI::_send_confirm_path(Node *p_node, NodePath p_path, PathSentC
 	return has_all_peers;
 }
 
+bool MultiplayerAPI::_get_path_id_for_peer(Node *p_node, const NodePath &p_path, int p_peer, uint32_t &r_id) {
+
+	PathSentCache *psc = path_send_cache.lookup_ptr(p_path);
+	if (!psc) {
+		// Path is not cached, create.
+		path_send_cache.set(p_path, PathSentCache());
+		psc = path_send_cache.lookup_ptr(p_path);
+		psc->id = last_send_cache_id++;
+	}
+
+	r_id = psc->id;
+	Map<int, bool>::Element *F = psc->confirmed_peers.find(p_peer);
+	if (F) {
+		return F->get(); // Either confirmed, or still waiting for it.
+	}
+
+	return _send_confirm_path(p_node, p_path, psc, p_peer);
+}
+
+Node *MultiplayerAPI::_get_cached_node(int p_from, uint32_t p_id) {
+
+	Map<int, PathGetCache>::Element *E = path_get_cache.find(p_from);
+	ERR_FAIL_COND_V_MSG(!E, NULL, "Invalid packet received. Requests invalid peer cache.");
+
+	Map<int, PathGetCache::NodeInfo>::Element *F = E->get().nodes.find(p_id);
+	ERR_FAIL_COND_V_MSG(!F, NULL, "Invalid packet received. Unabled to find requested cached node.");
+
+	return root_node->get_node(F->get().path);
+}
+
 // The variant is compressed and encoded; The first byte contains all the meta
 // information and the format is:
-// - The first LSB 5 bits are used for the variant type.
-// - The next two bits are used to store the encoding mode.
-// - The most significant is used to store the boolean value.
-#define VARIANT_META_TYPE_MASK 0x1F
-#define VARIANT_META_EMODE_MASK 0x60
-#define VARIANT_META_BOOL_MASK 0x80
-#define ENCODE_8 0 << 5
-#define ENCODE_16 1 << 5
-#define ENCODE_32 2 << 5
-#define ENCODE_64 3 << 5
+// - The first LSB 6 bits are used for the variant type.
+// - The two most significant bits are used to store the encoding mode (or the boolean value).
+// Types without a compact form are marshalled with `encode_variant`, whose header starts
+// with the type in the first byte, so the same meta byte (with mode 0) identifies them.
+#define VARIANT_META_TYPE_MASK 0x3F
+#define VARIANT_META_EMODE_MASK 0xC0
+#define ENCODE_8 0 << 6
+#define ENCODE_16 1 << 6
+#define ENCODE_32 2 << 6
+#define ENCODE_64 3 << 6
+
+// Lengths are stored 7 bits at a time, the high bit tells if more bytes follow.
+static int _encode_varint(uint32_t p_value, uint8_t *r_buffer) {
+
+	int len = 0;
+	do {
+		uint8_t byte = p_value & 0x7F;
+		p_value >>= 7;
+		if (p_value) {
+			byte |= 0x80;
+		}
+		if (r_buffer) {
+			r_buffer[len] = byte;
+		}
+		len++;
+	} while (p_value);
+
+	return len;
+}
+
+static int _decode_varint(const uint8_t *p_buffer, int p_len, uint32_t &r_value) {
+
+	r_value = 0;
+	for (int i = 0; i < 5 && i < p_len; i++) {
+		r_value |= uint32_t(p_buffer[i] & 0x7F) << (7 * i);
+		if (!(p_buffer[i] & 0x80)) {
+			return i + 1;
+		}
+	}
+
+	return -1; // Truncated or too long.
+}
+
+// Number of real components for the math types sent as plain arrays of reals.
+static int _get_real_component_count(Variant::Type p_type) {
+
+	switch (p_type) {
+		case Variant::FLOAT:
+			return 1;
+		case Variant::VECTOR2:
+			return 2;
+		case Variant::VECTOR3:
+			return 3;
+		case Variant::RECT2:
+		case Variant::PLANE:
+		case Variant::QUAT:
+		case Variant::COLOR:
+			return 4;
+		default:
+			return 0;
+	}
+}
+
+static void _get_real_components(const Variant &p_variant, double *r_components) {
+
+	switch (p_variant.get_type()) {
+		case Variant::FLOAT: {
+			r_components[0] = p_variant.operator double();
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 v = p_variant;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 v = p_variant;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+			r_components[2] = v.z;
+		} break;
+		case Variant::RECT2: {
+			Rect2 r = p_variant;
+			r_components[0] = r.position.x;
+			r_components[1] = r.position.y;
+			r_components[2] = r.size.x;
+			r_components[3] = r.size.y;
+		} break;
+		case Variant::PLANE: {
+			Plane p = p_variant;
+			r_components[0] = p.normal.x;
+			r_components[1] = p.normal.y;
+			r_components[2] = p.normal.z;
+			r_components[3] = p.d;
+		} break;
+		case Variant::QUAT: {
+			Quat q = p_variant;
+			r_components[0] = q.x;
+			r_components[1] = q.y;
+			r_components[2] = q.z;
+			r_components[3] = q.w;
+		} break;
+		case Variant::COLOR: {
+			Color c = p_variant;
+			r_components[0] = c.r;
+			r_components[1] = c.g;
+			r_components[2] = c.b;
+			r_components[3] = c.a;
+		} break;
+		default: {
+		}
+	}
+}
+
+static Variant _make_from_real_components(Variant::Type p_type, const double *p_components) {
+
+	switch (p_type) {
+		case Variant::FLOAT:
+			return p_components[0];
+		case Variant::VECTOR2:
+			return Vector2(p_components[0], p_components[1]);
+		case Variant::VECTOR3:
+			return Vector3(p_components[0], p_components[1], p_components[2]);
+		case Variant::RECT2:
+			return Rect2(p_components[0], p_components[1], p_components[2], p_components[3]);
+		case Variant::PLANE:
+			return Plane(p_components[0], p_components[1], p_components[2], p_components[3]);
+		case Variant::QUAT:
+			return Quat(p_components[0], p_components[1], p_components[2], p_components[3]);
+		case Variant::COLOR:
+			return Color(p_components[0], p_components[1], p_components[2], p_components[3]);
+		default:
+			return Variant();
+	}
+}
+
 Error MultiplayerAPI::_encode_and_compress_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len) {
 
-	// Unreachable because `VARIANT_MAX` == 27 and `ENCODE_VARIANT_MASK` == 31
+	// Unreachable because `VARIANT_MAX` == 35 and `VARIANT_META_TYPE_MASK` == 63
 	CRASH_COND(p_variant.get_type() > VARIANT_META_TYPE_MASK);
 
 	uint8_t *buf = r_buffer;
@@ -628,9 +799,9 @@ Error MultiplayerAPI::_encode_and_compress_variant(const Variant &p_variant, uin
 	switch (p_variant.get_type()) {
 		case Variant::BOOL: {
 			if (buf) {
-				// We still have 1 free bit in the meta, so let's use it.
-				buf[0] = (p_variant.operator bool()) ? (1 << 7) : 0;
-				buf[0] |= encode_mode | p_variant.get_type();
+				// The encoding mode is not needed, so let's use it for the value.
+				buf[0] = (p_variant.operator bool()) ? (1 << 6) : 0;
+				buf[0] |= p_variant.get_type();
 			}
 			r_len += 1;
 		} break;
@@ -676,20 +847,76 @@ Error MultiplayerAPI::_encode_and_compress_variant(const Variant &p_variant, uin
 				buf[0] = encode_mode | p_variant.get_type();
 			}
 		} break;
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR3:
+		case Variant::RECT2:
+		case Variant::PLANE:
+		case Variant::QUAT:
+		case Variant::COLOR: {
+			// Unpadded components, as narrow as they can be without losing precision
+			// (or as narrow as the float compression allows).
+			int count = _get_real_component_count(p_variant.get_type());
+			double components[4];
+			_get_real_components(p_variant, components);
+
+			if (rpc_float_compression == RPC_FLOAT_COMPRESSION_16) {
+				encode_mode = ENCODE_16;
+			} else if (rpc_float_compression == RPC_FLOAT_COMPRESSION_32) {
+				encode_mode = ENCODE_32;
+			} else {
+				encode_mode = ENCODE_32;
+				for (int i = 0; i < count; i++) {
+					if (double(float(components[i])) != components[i]) {
+						encode_mode = ENCODE_64;
+						break;
+					}
+				}
+			}
+
+			int size = encode_mode == ENCODE_16 ? 2 : (encode_mode == ENCODE_32 ? 4 : 8);
+			r_len += 1 + count * size;
+
+			if (buf) {
+				buf[0] = encode_mode | p_variant.get_type();
+				buf += 1;
+				for (int i = 0; i < count; i++) {
+					if (encode_mode == ENCODE_16) {
+						encode_uint16(Math::make_half_float(components[i]), buf);
+					} else if (encode_mode == ENCODE_32) {
+						encode_float(components[i], buf);
+					} else {
+						encode_double(components[i], buf);
+					}
+					buf += size;
+				}
+			}
+		} break;
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			// Length as a varint, and no padding.
+			CharString utf8 = p_variant.operator String().utf8();
+			int len = utf8.length();
+			r_len += 1 + _encode_varint(len, NULL) + len;
+
+			if (buf) {
+				buf[0] = p_variant.get_type();
+				buf += 1;
+				buf += _encode_varint(len, buf);
+				copymem(buf, utf8.get_data(), len);
+			}
+		} break;
 		default:
 			// Any other case is not yet compressed.
 			Error err = encode_variant(p_variant, r_buffer, r_len, allow_object_decoding);
 			if (err != OK)
 				return err;
-			if (r_buffer) {
-				// The first byte is not used by the marshaling, so store the type
-				// so we know how to decompress and decode this variant.
-				r_buffer[0] = p_variant.get_type();
-			}
+			// The first byte of the marshaling header holds the type already.
 	}
 
 	return OK;
 }
+
 Error MultiplayerAPI::_decode_and_decompress_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len) {
 
 	const uint8_t *buf = p_buffer;
@@ -703,7 +930,7 @@ Error MultiplayerAPI::_decode_and_decompress_variant(Variant &r_variant, const u
 
 	switch (type) {
 		case Variant::BOOL: {
-			bool val = (buf[0] & VARIANT_META_BOOL_MASK) > 0;
+			bool val = encode_mode != 0;
 			r_variant = val;
 			if (r_len)
 				*r_len = 1;
@@ -743,6 +970,56 @@ Error MultiplayerAPI::_decode_and_decompress_variant(Variant &r_variant, const u
 					(*r_len) += 8;
 			}
 		} break;
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR3:
+		case Variant::RECT2:
+		case Variant::PLANE:
+		case Variant::QUAT:
+		case Variant::COLOR: {
+			ERR_FAIL_COND_V(encode_mode == ENCODE_8, ERR_INVALID_DATA);
+			int count = _get_real_component_count(Variant::Type(type));
+			int size = encode_mode == ENCODE_16 ? 2 : (encode_mode == ENCODE_32 ? 4 : 8);
+			ERR_FAIL_COND_V(len < 1 + count * size, ERR_INVALID_DATA);
+
+			buf += 1;
+			double components[4];
+			for (int i = 0; i < count; i++) {
+				if (encode_mode == ENCODE_16) {
+					components[i] = Math::half_to_float(decode_uint16(buf));
+				} else if (encode_mode == ENCODE_32) {
+					components[i] = decode_float(buf);
+				} else {
+					components[i] = decode_double(buf);
+				}
+				buf += size;
+			}
+
+			r_variant = _make_from_real_components(Variant::Type(type), components);
+			if (r_len)
+				*r_len = 1 + count * size;
+		} break;
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			buf += 1;
+			len -= 1;
+			uint32_t str_len = 0;
+			int varint_len = _decode_varint(buf, len, str_len);
+			ERR_FAIL_COND_V(varint_len < 0, ERR_INVALID_DATA);
+			buf += varint_len;
+			len -= varint_len;
+			ERR_FAIL_COND_V(str_len > uint32_t(len), ERR_INVALID_DATA);
+
+			String str;
+			str.parse_utf8((const char *)buf, str_len);
+			if (type == Variant::STRING_NAME) {
+				r_variant = StringName(str);
+			} else {
+				r_variant = str;
+			}
+			if (r_len)
+				*r_len = 1 + varint_len + str_len;
+		} break;
 		default:
 			Error err = decode_variant(r_variant, p_buffer, p_len, r_len, allow_object_decoding);
 			if (err != OK)
@@ -772,11 +1049,11 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 	ERR_FAIL_COND_MSG(from_path.is_empty(), "Unable to send RPC. Relative path is empty. THIS IS LIKELY A BUG IN THE ENGINE!");
 
 	// See if the path is cached.
-	PathSentCache *psc = path_send_cache.getptr(from_path);
+	PathSentCache *psc = path_send_cache.lookup_ptr(from_path);
 	if (!psc) {
 		// Path is not cached, create.
-		path_send_cache[from_path] = PathSentCache();
-		psc = path_send_cache.getptr(from_path);
+		path_send_cache.set(from_path, PathSentCache());
+		psc = path_send_cache.lookup_ptr(from_path);
 		psc->id = last_send_cache_id++;
 	}
 
@@ -927,14 +1204,12 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 	_profile_bandwidth_data("out", ofs);
 #endif
 
-	// Take chance and set transfer mode, since all send methods will use it.
-	network_peer->set_transfer_mode(p_unreliable ? NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
+	const NetworkedMultiplayerPeer::TransferMode transfer_mode = p_unreliable ? NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE;
 
 	if (has_all_peers) {
 
 		// They all have verified paths, so send fast.
-		network_peer->set_target_peer(p_to); // To all of you.
-		network_peer->put_packet(packet_cache.ptr(), ofs); // A message with love.
+		_send_packet(p_to, transfer_mode, packet_cache.ptr(), ofs); // A message with love.
 	} else {
 		// Unreachable because the node ID is never compressed if the peers doesn't know it.
 		CRASH_COND(node_id_compression != NETWORK_NODE_ID_COMPRESSION_32);
@@ -958,38 +1233,134 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 			Map<int, bool>::Element *F = psc->confirmed_peers.find(E->get());
 			ERR_CONTINUE(!F); // Should never happen.
 
-			network_peer->set_target_peer(E->get()); // To this one specifically.
-
+			// To this one specifically.
 			if (F->get()) {
 				// This one confirmed path, so use id.
 				encode_uint32(psc->id, &(packet_cache.write[1]));
-				network_peer->put_packet(packet_cache.ptr(), ofs);
+				_send_packet(E->get(), transfer_mode, packet_cache.ptr(), ofs);
 			} else {
 				// This one did not confirm path yet, so use entire path (sorry!).
 				encode_uint32(0x80000000 | ofs, &(packet_cache.write[1])); // Offset to path and flag.
-				network_peer->put_packet(packet_cache.ptr(), ofs + path_len);
+				_send_packet(E->get(), transfer_mode, packet_cache.ptr(), ofs + path_len);
 			}
 		}
 	}
 }
 
+void MultiplayerAPI::_send_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_packet, int p_packet_len) {
+
+	if (!rpc_batching) {
+		network_peer->set_transfer_mode(p_mode);
+		network_peer->set_target_peer(p_to);
+		network_peer->put_packet(p_packet, p_packet_len);
+		return;
+	}
+
+	if (p_to > 0) {
+		_queue_packet(p_to, p_mode, p_packet, p_packet_len);
+		return;
+	}
+
+	// Batches are per peer, so broadcasts are queued for each of them.
+	for (Set<int>::Element *E = connected_peers.front(); E; E = E->next()) {
+
+		if (p_to < 0 && E->get() == -p_to)
+			continue; // Continue, excluded.
+
+		_queue_packet(E->get(), p_mode, p_packet, p_packet_len);
+	}
+}
+
+void MultiplayerAPI::_queue_packet(int p_peer, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_packet, int p_packet_len) {
+
+	PeerBatch &batch = peer_batches[p_peer];
+
+	// Every packet in the batch is prefixed by its size in 16 bits.
+	if (batch.size[p_mode] > 0 && batch.size[p_mode] + 2 + p_packet_len > rpc_batch_max_size) {
+		_flush_batch(p_peer, p_mode, batch);
+	}
+
+	if (1 + 2 + p_packet_len > rpc_batch_max_size) {
+		// Too large to be batched, the queue is empty now so it's still sent in order.
+		network_peer->set_transfer_mode(p_mode);
+		network_peer->set_target_peer(p_peer);
+		network_peer->put_packet(p_packet, p_packet_len);
+		return;
+	}
+
+	Vector<uint8_t> &data = batch.data[p_mode];
+	int ofs = batch.size[p_mode];
+	if (ofs == 0) {
+		if (data.size() < rpc_batch_max_size) {
+			data.resize(rpc_batch_max_size);
+		}
+		data.write[0] = NETWORK_COMMAND_BATCH;
+		ofs = 1;
+	}
+
+	encode_uint16(p_packet_len, &data.write[ofs]);
+	copymem(&data.write[ofs + 2], p_packet, p_packet_len);
+	batch.size[p_mode] = ofs + 2 + p_packet_len;
+}
+
+void MultiplayerAPI::_flush_batch(int p_peer, NetworkedMultiplayerPeer::TransferMode p_mode, PeerBatch &p_batch) {
+
+	if (p_batch.size[p_mode] == 0) {
+		return;
+	}
+
+	network_peer->set_transfer_mode(p_mode);
+	network_peer->set_target_peer(p_peer);
+	network_peer->put_packet(p_batch.data[p_mode].ptr(), p_batch.size[p_mode]);
+	p_batch.size[p_mode] = 0;
+}
+
+void MultiplayerAPI::_flush_batches() {
+
+	for (Map<int, PeerBatch>::Element *E = peer_batches.front(); E; E = E->next()) {
+		for (int i = 0; i < 3; i++) {
+			_flush_batch(E->key(), NetworkedMultiplayerPeer::TransferMode(i), E->get());
+		}
+	}
+}
+
+void MultiplayerAPI::_process_batch(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+	int ofs = 1;
+	while (ofs < p_packet_len) {
+
+		ERR_FAIL_COND_MSG(ofs + 2 > p_packet_len, "Invalid packet received. Size too small.");
+		int len = decode_uint16(&p_packet[ofs]);
+		ofs += 2;
+		ERR_FAIL_COND_MSG(len < 1 || ofs + len > p_packet_len, "Invalid packet received. Size too small.");
+		ERR_FAIL_COND_MSG((p_packet[ofs] & 7) == NETWORK_COMMAND_BATCH, "Invalid packet received. Batches can't be nested.");
+
+		_process_packet(p_from, &p_packet[ofs], len);
+		ofs += len;
+
+		if (!network_peer.is_valid()) {
+			break; // A packet or RPC caused a disconnection.
+		}
+	}
+}
+
 void MultiplayerAPI::_add_peer(int p_id) {
 	connected_peers.insert(p_id);
+	replicator->add_peer(p_id);
 	path_get_cache.insert(p_id, PathGetCache());
 	emit_signal("network_peer_connected", p_id);
 }
 
 void MultiplayerAPI::_del_peer(int p_id) {
 	connected_peers.erase(p_id);
+	peer_batches.erase(p_id);
+	replicator->remove_peer(p_id);
 	// Cleanup get cache.
 	path_get_cache.erase(p_id);
 	// Cleanup sent cache.
-	// Some refactoring is needed to make this faster and do paths GC.
-	List<NodePath> keys;
-	path_send_cache.get_key_list(&keys);
-	for (List<NodePath>::Element *E = keys.front(); E; E = E->next()) {
-		PathSentCache *psc = path_send_cache.getptr(E->get());
-		psc->confirmed_peers.erase(p_id);
+	// Some refactoring is needed to do paths GC.
+	for (OAHashMap<NodePath, PathSentCache>::Iterator it = path_send_cache.iter(); it.valid; it = path_send_cache.next_iter(it)) {
+		it.value->confirmed_peers.erase(p_id);
 	}
 	emit_signal("network_peer_disconnected", p_id);
 }
@@ -1153,6 +1524,12 @@ Error MultiplayerAPI::send_bytes(Vector<uint8_t> p_data, int p_to, NetworkedMult
 	packet_cache.write[0] = NETWORK_COMMAND_RAW;
 	memcpy(&packet_cache.write[1], &r[0], p_data.size());
 
+	if (rpc_batching) {
+		// Goes in the same batches as RPCs, so it keeps its order with them.
+		_send_packet(p_to, p_mode, packet_cache.ptr(), p_data.size() + 1);
+		return OK;
+	}
+
 	network_peer->set_target_peer(p_to);
 	network_peer->set_transfer_mode(p_mode);
 
@@ -1220,6 +1597,89 @@ bool MultiplayerAPI::is_object_decoding_allowed() const {
 	return allow_object_decoding;
 }
 
+void MultiplayerAPI::replicate_node(Node *p_node, const Vector<String> &p_properties) {
+
+	Vector<StringName> properties;
+	for (int i = 0; i < p_properties.size(); i++) {
+		properties.push_back(p_properties[i]);
+	}
+	replicator->add_node(p_node, properties);
+}
+
+void MultiplayerAPI::stop_replicating_node(Node *p_node) {
+
+	replicator->remove_node(p_node);
+}
+
+bool MultiplayerAPI::is_node_replicated(const Node *p_node) const {
+
+	return replicator->is_node_replicated(p_node);
+}
+
+void MultiplayerAPI::set_replication_observer(int p_peer_id, Node *p_observer) {
+
+	replicator->set_observer(p_peer_id, p_observer);
+}
+
+void MultiplayerAPI::set_replication_max_distance(float p_distance) {
+
+	replicator->set_max_distance(p_distance);
+}
+
+float MultiplayerAPI::get_replication_max_distance() const {
+
+	return replicator->get_max_distance();
+}
+
+void MultiplayerAPI::set_replication_peer_budget(int p_bytes) {
+
+	ERR_FAIL_COND(p_bytes < 0);
+	replicator->set_peer_budget(p_bytes);
+}
+
+int MultiplayerAPI::get_replication_peer_budget() const {
+
+	return replicator->get_peer_budget();
+}
+
+void MultiplayerAPI::set_rpc_float_compression(RPCFloatCompression p_compression) {
+
+	ERR_FAIL_INDEX(p_compression, 3);
+	rpc_float_compression = p_compression;
+}
+
+MultiplayerAPI::RPCFloatCompression MultiplayerAPI::get_rpc_float_compression() const {
+
+	return rpc_float_compression;
+}
+
+void MultiplayerAPI::set_rpc_batching_enabled(bool p_enable) {
+
+	if (rpc_batching && !p_enable && network_peer.is_valid() && network_peer->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_CONNECTED) {
+		_flush_batches(); // Don't lose what was already queued.
+	}
+	rpc_batching = p_enable;
+}
+
+bool MultiplayerAPI::is_rpc_batching_enabled() const {
+
+	return rpc_batching;
+}
+
+void MultiplayerAPI::set_rpc_batch_max_size(int p_size) {
+
+	ERR_FAIL_COND_MSG(p_size < 64 || p_size > 65535, "The RPC batch size must be between 64 and 65535 bytes.");
+	if (network_peer.is_valid() && network_peer->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_CONNECTED) {
+		_flush_batches();
+	}
+	rpc_batch_max_size = p_size;
+}
+
+int MultiplayerAPI::get_rpc_batch_max_size() const {
+
+	return rpc_batch_max_size;
+}
+
 void MultiplayerAPI::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_root_node", "node"), &MultiplayerAPI::set_root_node);
 	ClassDB::bind_method(D_METHOD("send_bytes", "bytes", "id", "mode"), &MultiplayerAPI::send_bytes, DEFVAL(NetworkedMultiplayerPeer::TARGET_PEER_BROADCAST), DEFVAL(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE));
@@ -1237,9 +1697,28 @@ void MultiplayerAPI::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_refusing_new_network_connections"), &MultiplayerAPI::is_refusing_new_network_connections);
 	ClassDB::bind_method(D_METHOD("set_allow_object_decoding", "enable"), &MultiplayerAPI::set_allow_object_decoding);
 	ClassDB::bind_method(D_METHOD("is_object_decoding_allowed"), &MultiplayerAPI::is_object_decoding_allowed);
+	ClassDB::bind_method(D_METHOD("replicate_node", "node", "properties"), &MultiplayerAPI::replicate_node);
+	ClassDB::bind_method(D_METHOD("stop_replicating_node", "node"), &MultiplayerAPI::stop_replicating_node);
+	ClassDB::bind_method(D_METHOD("is_node_replicated", "node"), &MultiplayerAPI::is_node_replicated);
+	ClassDB::bind_method(D_METHOD("set_replication_observer", "peer_id", "observer"), &MultiplayerAPI::set_replication_observer);
+	ClassDB::bind_method(D_METHOD("set_replication_max_distance", "distance"), &MultiplayerAPI::set_replication_max_distance);
+	ClassDB::bind_method(D_METHOD("get_replication_max_distance"), &MultiplayerAPI::get_replication_max_distance);
+	ClassDB::bind_method(D_METHOD("set_replication_peer_budget", "bytes"), &MultiplayerAPI::set_replication_peer_budget);
+	ClassDB::bind_method(D_METHOD("get_replication_peer_budget"), &MultiplayerAPI::get_replication_peer_budget);
+	ClassDB::bind_method(D_METHOD("set_rpc_float_compression", "compression"), &MultiplayerAPI::set_rpc_float_compression);
+	ClassDB::bind_method(D_METHOD("get_rpc_float_compression"), &MultiplayerAPI::get_rpc_float_compression);
+	ClassDB::bind_method(D_METHOD("set_rpc_batching_enabled", "enable"), &MultiplayerAPI::set_rpc_batching_enabled);
+	ClassDB::bind_method(D_METHOD("is_rpc_batching_enabled"), &MultiplayerAPI::is_rpc_batching_enabled);
+	ClassDB::bind_method(D_METHOD("set_rpc_batch_max_size", "size"), &MultiplayerAPI::set_rpc_batch_max_size);
+	ClassDB::bind_method(D_METHOD("get_rpc_batch_max_size"), &MultiplayerAPI::get_rpc_batch_max_size);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "allow_object_decoding"), "set_allow_object_decoding", "is_object_decoding_allowed");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "refuse_new_network_connections"), "set_refuse_new_network_connections", "is_refusing_new_network_connections");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "replication_max_distance", PROPERTY_HINT_RANGE, "0,10000,0.01,or_greater"), "set_replication_max_distance", "get_replication_max_distance");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "replication_peer_budget", PROPERTY_HINT_RANGE, "0,65536,1,or_greater"), "set_replication_peer_budget", "get_replication_peer_budget");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "rpc_float_compression", PROPERTY_HINT_ENUM, "None,32 Bits,16 Bits"), "set_rpc_float_compression", "get_rpc_float_compression");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "rpc_batching"), "set_rpc_batching_enabled", "is_rpc_batching_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "rpc_batch_max_size", PROPERTY_HINT_RANGE, "64,65535,1"), "set_rpc_batch_max_size", "get_rpc_batch_max_size");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "network_peer", PROPERTY_HINT_RESOURCE_TYPE, "NetworkedMultiplayerPeer", 0), "set_network_peer", "get_network_peer");
 	ADD_PROPERTY_DEFAULT("refuse_new_network_connections", false);
 
@@ -1257,15 +1736,24 @@ void MultiplayerAPI::_bind_methods() {
 	BIND_ENUM_CONSTANT(RPC_MODE_REMOTESYNC);
 	BIND_ENUM_CONSTANT(RPC_MODE_MASTERSYNC);
 	BIND_ENUM_CONSTANT(RPC_MODE_PUPPETSYNC);
+
+	BIND_ENUM_CONSTANT(RPC_FLOAT_COMPRESSION_NONE);
+	BIND_ENUM_CONSTANT(RPC_FLOAT_COMPRESSION_32);
+	BIND_ENUM_CONSTANT(RPC_FLOAT_COMPRESSION_16);
 }
 
 MultiplayerAPI::MultiplayerAPI() :
 		allow_object_decoding(false) {
 	rpc_sender_id = 0;
+	rpc_batching = false;
+	rpc_batch_max_size = 1200;
+	rpc_float_compression = RPC_FLOAT_COMPRESSION_NONE;
+	replicator = memnew(MultiplayerReplicator(this));
 	root_node = NULL;
 	clear();
 }
 
 MultiplayerAPI::~MultiplayerAPI() {
 	clear();
+	memdelete(replicator);
 }
@@ -31,13 +31,24 @@
 #ifndef MULTIPLAYER_API_H
 #define MULTIPLAYER_API_H
 
+#include "core/io/multiplayer_replicator.h"
 #include "core/io/networked_multiplayer_peer.h"
+#include "core/oa_hash_map.h"
 #include "core/reference.h"
 
 class MultiplayerAPI : public Reference {
 
 	GDCLASS(MultiplayerAPI, Reference);
 
+	friend class MultiplayerReplicator;
+
+public:
+	enum RPCFloatCompression {
+		RPC_FLOAT_COMPRESSION_NONE, // Reals are sent in 32 bits when it loses no precision, 64 otherwise
+		RPC_FLOAT_COMPRESSION_32, // Reals are always sent in 32 bits
+		RPC_FLOAT_COMPRESSION_16, // Reals are sent as half floats
+	};
+
 private:
 	//path sent caches
 	struct PathSentCache {
@@ -58,13 +69,25 @@ private:
 	Ref<NetworkedMultiplayerPeer> network_peer;
 	int rpc_sender_id;
 	Set<int> connected_peers;
-	HashMap<NodePath, PathSentCache> path_send_cache;
+	OAHashMap<NodePath, PathSentCache> path_send_cache;
 	Map<int, PathGetCache> path_get_cache;
 	int last_send_cache_id;
 	Vector<uint8_t> packet_cache;
 	Node *root_node;
 	bool allow_object_decoding;
 
+	//packets waiting to be sent coalesced on the next poll, per peer and transfer mode
+	struct PeerBatch {
+		Vector<uint8_t> data[3];
+		int size[3] = { 0, 0, 0 };
+	};
+
+	Map<int, PeerBatch> peer_batches;
+	bool rpc_batching;
+	int rpc_batch_max_size;
+	RPCFloatCompression rpc_float_compression;
+	MultiplayerReplicator *replicator;
+
 protected:
 	static void _bind_methods();
 
@@ -75,9 +98,17 @@ protected:
 	void _process_rpc(Node *p_node, const uint16_t p_rpc_method_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 	void _process_rset(Node *p_node, const uint16_t p_rpc_property_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 	void _process_raw(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_batch(int p_from, const uint8_t *p_packet, int p_packet_len);
+
+	void _send_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_packet, int p_packet_len);
+	void _queue_packet(int p_peer, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_packet, int p_packet_len);
+	void _flush_batch(int p_peer, NetworkedMultiplayerPeer::TransferMode p_mode, PeerBatch &p_batch);
+	void _flush_batches();
 
 	void _send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p_set, const StringName &p_name, const Variant **p_arg, int p_argcount);
 	bool _send_confirm_path(Node *p_node, NodePath p_path, PathSentCache *psc, int p_target);
+	bool _get_path_id_for_peer(Node *p_node, const NodePath &p_path, int p_peer, uint32_t &r_id);
+	Node *_get_cached_node(int p_from, uint32_t p_id);
 
 	Error _encode_and_compress_variant(const Variant &p_variant, uint8_t *p_buffer, int &r_len);
 	Error _decode_and_decompress_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len);
@@ -89,6 +120,9 @@ public:
 		NETWORK_COMMAND_SIMPLIFY_PATH,
 		NETWORK_COMMAND_CONFIRM_PATH,
 		NETWORK_COMMAND_RAW,
+		NETWORK_COMMAND_BATCH,
+		NETWORK_COMMAND_REPLICATE,
+		NETWORK_COMMAND_REPLICATE_ACK,
 	};
 
 	enum NetworkNodeIdCompression {
@@ -142,10 +176,28 @@ public:
 	void set_allow_object_decoding(bool p_enable);
 	bool is_object_decoding_allowed() const;
 
+	void replicate_node(Node *p_node, const Vector<String> &p_properties);
+	void stop_replicating_node(Node *p_node);
+	bool is_node_replicated(const Node *p_node) const;
+	void set_replication_observer(int p_peer_id, Node *p_observer);
+	void set_replication_max_distance(float p_distance);
+	float get_replication_max_distance() const;
+	void set_replication_peer_budget(int p_bytes);
+	int get_replication_peer_budget() const;
+
+	void set_rpc_float_compression(RPCFloatCompression p_compression);
+	RPCFloatCompression get_rpc_float_compression() const;
+
+	void set_rpc_batching_enabled(bool p_enable);
+	bool is_rpc_batching_enabled() const;
+	void set_rpc_batch_max_size(int p_size);
+	int get_rpc_batch_max_size() const;
+
 	MultiplayerAPI();
 	~MultiplayerAPI();
 };
 
 VARIANT_ENUM_CAST(MultiplayerAPI::RPCMode);
+VARIANT_ENUM_CAST(MultiplayerAPI::RPCFloatCompression);
 
 #endif // MULTIPLAYER_API_H
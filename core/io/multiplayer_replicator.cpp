@@ -0,0 +1,409 @@
+/*************************************************************************/
+/*  multiplayer_replicator.cpp                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "multiplayer_replicator.h"
+
+#include "core/io/marshalls.h"
+#include "core/io/multiplayer_api.h"
+#include "scene/main/node.h"
+
+// Snapshot packets are laid out as:
+// - The command byte and the snapshot number in 32 bits.
+// - For every node, the size of its entry in 16 bits (so unknown nodes can be skipped),
+//   the confirmed path id in 32 bits, the mask of properties sent in 32 bits and
+//   then the values of those properties, in order.
+#define SNAPSHOT_HEADER_SIZE 5
+#define SNAPSHOT_ENTRY_HEADER_SIZE 10
+
+bool MultiplayerReplicator::_get_position(Object *p_object, Vector3 &r_position) {
+
+	bool valid = false;
+	Variant xform = p_object->get("global_transform", &valid);
+	if (!valid) {
+		return false;
+	}
+
+	if (xform.get_type() == Variant::TRANSFORM) {
+		r_position = Transform(xform).origin;
+		return true;
+	} else if (xform.get_type() == Variant::TRANSFORM2D) {
+		Vector2 origin = Transform2D(xform).get_origin();
+		r_position = Vector3(origin.x, origin.y, 0);
+		return true;
+	}
+
+	return false;
+}
+
+void MultiplayerReplicator::add_node(Node *p_node, const Vector<StringName> &p_properties) {
+
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(p_properties.size() == 0, "No properties to replicate.");
+	ERR_FAIL_COND_MSG(p_properties.size() > MAX_PROPERTIES, "Can't replicate more than " + itos(MAX_PROPERTIES) + " properties per node.");
+
+	ObjectID id = p_node->get_instance_id();
+	Map<ObjectID, int>::Element *E = node_indices.find(id);
+	if (E) {
+		// Registered again, the properties may differ so the peers must get everything again.
+		nodes.write[E->get()].properties = p_properties;
+		for (Map<int, PeerState>::Element *F = peers.front(); F; F = F->next()) {
+			F->get().nodes.erase(id);
+		}
+		return;
+	}
+
+	ReplicatedNode rn;
+	rn.id = id;
+	rn.properties = p_properties;
+	node_indices[id] = nodes.size();
+	nodes.push_back(rn);
+}
+
+void MultiplayerReplicator::_remove_node_index(int p_index) {
+
+	ObjectID id = nodes[p_index].id;
+	node_indices.erase(id);
+	for (Map<int, PeerState>::Element *E = peers.front(); E; E = E->next()) {
+		E->get().nodes.erase(id);
+	}
+
+	// Swap with the last one, order only matters for the budget rotation.
+	int last = nodes.size() - 1;
+	if (p_index != last) {
+		nodes.write[p_index] = nodes[last];
+		node_indices[nodes[p_index].id] = p_index;
+	}
+	nodes.resize(last);
+}
+
+void MultiplayerReplicator::remove_node(Node *p_node) {
+
+	ERR_FAIL_NULL(p_node);
+	Map<ObjectID, int>::Element *E = node_indices.find(p_node->get_instance_id());
+	ERR_FAIL_COND_MSG(!E, "Node is not replicated.");
+	_remove_node_index(E->get());
+}
+
+bool MultiplayerReplicator::is_node_replicated(const Node *p_node) const {
+
+	ERR_FAIL_NULL_V(p_node, false);
+	return node_indices.has(p_node->get_instance_id());
+}
+
+void MultiplayerReplicator::set_observer(int p_peer, Node *p_observer) {
+
+	peers[p_peer].observer = p_observer ? p_observer->get_instance_id() : ObjectID();
+}
+
+void MultiplayerReplicator::add_peer(int p_peer) {
+
+	peers[p_peer] = PeerState();
+}
+
+void MultiplayerReplicator::remove_peer(int p_peer) {
+
+	peers.erase(p_peer);
+}
+
+void MultiplayerReplicator::clear() {
+
+	peers.clear();
+}
+
+void MultiplayerReplicator::_send_packet(int p_peer, PeerState &p_state, Vector<uint8_t> &p_packet, Snapshot &p_snapshot) {
+
+	multiplayer->_send_packet(p_peer, NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE, p_packet.ptr(), p_packet.size());
+
+	p_state.pending.push_back(p_snapshot);
+	if (p_state.pending.size() > MAX_PENDING_SNAPSHOTS) {
+		// Never acknowledged, what it had is still different from the acked state so it will be sent again.
+		p_state.pending.pop_front();
+	}
+	p_state.next_snapshot++;
+
+	p_snapshot.id = p_state.next_snapshot;
+	p_snapshot.entries.clear();
+	p_packet.resize(SNAPSHOT_HEADER_SIZE);
+	encode_uint32(p_snapshot.id, &p_packet.write[1]);
+}
+
+void MultiplayerReplicator::_send_peer(int p_peer, PeerState &p_state) {
+
+	Vector3 observer_pos;
+	bool use_distance = false;
+	if (max_distance > 0 && p_state.observer.is_valid()) {
+		Object *observer = ObjectDB::get_instance(p_state.observer);
+		use_distance = observer && _get_position(observer, observer_pos);
+	}
+
+	const int max_packet_size = multiplayer->rpc_batch_max_size;
+	int budget = peer_budget > 0 ? peer_budget : INT32_MAX;
+
+	Snapshot snapshot;
+	snapshot.id = p_state.next_snapshot;
+	Vector<uint8_t> packet;
+	packet.resize(SNAPSHOT_HEADER_SIZE);
+	packet.write[0] = MultiplayerAPI::NETWORK_COMMAND_REPLICATE;
+	encode_uint32(snapshot.id, &packet.write[1]);
+
+	Vector<uint8_t> entry;
+	const int count = nodes.size();
+	int start = count ? p_state.next_node % count : 0;
+
+	for (int k = 0; k < count; k++) {
+
+		int idx = (start + k) % count;
+		const ReplicatedNode &rn = nodes[idx];
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(rn.id));
+		if (!node || !node->is_inside_tree() || !node->is_network_master()) {
+			continue;
+		}
+
+		if (use_distance && rn.has_position && rn.position.distance_to(observer_pos) > max_distance) {
+			continue; // Out of interest for this peer, the delta is kept for when it comes back.
+		}
+
+		uint32_t path_id = 0;
+		if (!multiplayer->_get_path_id_for_peer(node, rn.path, p_peer, path_id)) {
+			continue; // Waiting for the peer to confirm the path.
+		}
+
+		NodeState &state = p_state.nodes[rn.id];
+		if (state.acked.size() != rn.properties.size()) {
+			state.acked.resize(rn.properties.size());
+			state.acked_snapshot.resize(rn.properties.size());
+			state.acked_mask = 0;
+		}
+
+		SentEntry sent;
+		sent.id = rn.id;
+		entry.resize(SNAPSHOT_ENTRY_HEADER_SIZE);
+		int ofs = SNAPSHOT_ENTRY_HEADER_SIZE;
+
+		for (int i = 0; i < rn.properties.size(); i++) {
+
+			const Variant &value = rn.values[i];
+			if ((state.acked_mask & (1u << i)) && state.acked[i] == value) {
+				continue;
+			}
+
+			int len = 0;
+			Error err = multiplayer->_encode_and_compress_variant(value, NULL, len);
+			ERR_CONTINUE_MSG(err != OK, "Unable to encode replicated property '" + String(rn.properties[i]) + "'.");
+			entry.resize(ofs + len);
+			multiplayer->_encode_and_compress_variant(value, &entry.write[ofs], len);
+			ofs += len;
+
+			sent.mask |= 1u << i;
+			sent.values.push_back(value);
+		}
+
+		if (sent.mask == 0) {
+			continue; // The peer is up to date.
+		}
+
+		ERR_CONTINUE_MSG(ofs > UINT16_MAX || SNAPSHOT_HEADER_SIZE + ofs > max_packet_size, "Replicated state of node '" + String(node->get_path()) + "' doesn't fit in a packet.");
+
+		if (ofs > budget) {
+			p_state.next_node = idx; // Continue from this one on the next poll.
+			break;
+		}
+		budget -= ofs;
+
+		if (packet.size() + ofs > max_packet_size) {
+			_send_packet(p_peer, p_state, packet, snapshot);
+		}
+
+		encode_uint16(ofs, &entry.write[0]);
+		encode_uint32(path_id, &entry.write[2]);
+		encode_uint32(sent.mask, &entry.write[6]);
+
+		int packet_ofs = packet.size();
+		packet.resize(packet_ofs + ofs);
+		copymem(&packet.write[packet_ofs], entry.ptr(), ofs);
+		snapshot.entries.push_back(sent);
+	}
+
+	if (snapshot.entries.size()) {
+		_send_packet(p_peer, p_state, packet, snapshot);
+	}
+}
+
+void MultiplayerReplicator::send() {
+
+	if (nodes.size() == 0 || !multiplayer->root_node) {
+		return;
+	}
+
+	// Forget the nodes that were freed without being removed.
+	for (int i = nodes.size() - 1; i >= 0; i--) {
+
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(nodes[i].id));
+		if (!node) {
+			_remove_node_index(i);
+			continue;
+		}
+
+		ReplicatedNode &rn = nodes.write[i];
+		if (node->is_inside_tree()) {
+			rn.path = multiplayer->root_node->get_path().rel_path_to(node->get_path());
+			rn.has_position = max_distance > 0 && _get_position(node, rn.position);
+			if (node->is_network_master()) {
+				rn.values.resize(rn.properties.size());
+				for (int j = 0; j < rn.properties.size(); j++) {
+					rn.values.write[j] = node->get(rn.properties[j]);
+				}
+			}
+		}
+	}
+
+	for (Set<int>::Element *E = multiplayer->connected_peers.front(); E; E = E->next()) {
+
+		Map<int, PeerState>::Element *F = peers.find(E->get());
+		if (!F) {
+			F = peers.insert(E->get(), PeerState());
+		}
+		_send_peer(E->get(), F->get());
+	}
+}
+
+void MultiplayerReplicator::process_snapshot(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+	ERR_FAIL_COND_MSG(p_packet_len < SNAPSHOT_HEADER_SIZE, "Invalid packet received. Size too small.");
+
+	uint32_t snapshot_id = decode_uint32(&p_packet[1]);
+	PeerState &state = peers[p_from];
+	if (snapshot_id <= state.last_received) {
+		return; // Older than what was applied, the newer one has anything still relevant.
+	}
+	state.last_received = snapshot_id;
+
+	uint8_t ack[SNAPSHOT_HEADER_SIZE];
+	ack[0] = MultiplayerAPI::NETWORK_COMMAND_REPLICATE_ACK;
+	encode_uint32(snapshot_id, &ack[1]);
+	multiplayer->_send_packet(p_from, NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE, ack, SNAPSHOT_HEADER_SIZE);
+
+	int ofs = SNAPSHOT_HEADER_SIZE;
+	while (ofs < p_packet_len) {
+
+		ERR_FAIL_COND_MSG(ofs + SNAPSHOT_ENTRY_HEADER_SIZE > p_packet_len, "Invalid packet received. Size too small.");
+		int entry_len = decode_uint16(&p_packet[ofs]);
+		ERR_FAIL_COND_MSG(entry_len < SNAPSHOT_ENTRY_HEADER_SIZE || ofs + entry_len > p_packet_len, "Invalid packet received. Size too small.");
+
+		const uint8_t *entry = &p_packet[ofs];
+		ofs += entry_len;
+
+		uint32_t path_id = decode_uint32(&entry[2]);
+		uint32_t mask = decode_uint32(&entry[6]);
+
+		Node *node = multiplayer->_get_cached_node(p_from, path_id);
+		if (!node) {
+			continue;
+		}
+
+		Map<ObjectID, int>::Element *E = node_indices.find(node->get_instance_id());
+		ERR_CONTINUE_MSG(!E, "Received replicated state for node '" + String(node->get_path()) + "', which is not replicated here.");
+		ERR_CONTINUE_MSG(p_from != node->get_network_master(), "Received replicated state for node '" + String(node->get_path()) + "' from a peer which is not its network master.");
+
+		const ReplicatedNode &rn = nodes[E->get()];
+		int value_ofs = SNAPSHOT_ENTRY_HEADER_SIZE;
+		for (int i = 0; i < MAX_PROPERTIES; i++) {
+
+			if (!(mask & (1u << i))) {
+				continue;
+			}
+			ERR_BREAK_MSG(i >= rn.properties.size(), "Received more replicated properties than are registered for node '" + String(node->get_path()) + "'.");
+
+			Variant value;
+			int len = 0;
+			Error err = multiplayer->_decode_and_decompress_variant(value, &entry[value_ofs], entry_len - value_ofs, &len);
+			ERR_BREAK_MSG(err != OK, "Invalid packet received. Unable to decode replicated property.");
+			value_ofs += len;
+
+			node->set(rn.properties[i], value);
+		}
+	}
+}
+
+void MultiplayerReplicator::process_ack(int p_from, const uint8_t *p_packet, int p_packet_len) {
+
+	ERR_FAIL_COND_MSG(p_packet_len < SNAPSHOT_HEADER_SIZE, "Invalid packet received. Size too small.");
+
+	uint32_t snapshot_id = decode_uint32(&p_packet[1]);
+	Map<int, PeerState>::Element *P = peers.find(p_from);
+	if (!P) {
+		return;
+	}
+
+	PeerState &state = P->get();
+	for (List<Snapshot>::Element *E = state.pending.front(); E; E = E->next()) {
+
+		const Snapshot &snapshot = E->get();
+		if (snapshot.id != snapshot_id) {
+			continue;
+		}
+
+		for (int i = 0; i < snapshot.entries.size(); i++) {
+
+			const SentEntry &sent = snapshot.entries[i];
+			Map<ObjectID, NodeState>::Element *N = state.nodes.find(sent.id);
+			if (!N) {
+				continue; // Removed or registered again meanwhile.
+			}
+
+			NodeState &ns = N->get();
+			int value_idx = 0;
+			for (int j = 0; j < ns.acked.size(); j++) {
+
+				if (!(sent.mask & (1u << j))) {
+					continue;
+				}
+
+				// Acks can arrive out of order, don't go back to an older value.
+				if (!(ns.acked_mask & (1u << j)) || ns.acked_snapshot[j] < snapshot.id) {
+					ns.acked.write[j] = sent.values[value_idx];
+					ns.acked_snapshot.write[j] = snapshot.id;
+					ns.acked_mask |= 1u << j;
+				}
+				value_idx++;
+			}
+		}
+
+		state.pending.erase(E);
+		break;
+	}
+}
+
+MultiplayerReplicator::MultiplayerReplicator(MultiplayerAPI *p_multiplayer) {
+
+	multiplayer = p_multiplayer;
+	max_distance = 0;
+	peer_budget = 0;
+}
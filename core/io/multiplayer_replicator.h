@@ -0,0 +1,128 @@
+/*************************************************************************/
+/*  multiplayer_replicator.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef MULTIPLAYER_REPLICATOR_H
+#define MULTIPLAYER_REPLICATOR_H
+
+#include "core/list.h"
+#include "core/map.h"
+#include "core/node_path.h"
+#include "core/object.h"
+#include "core/string_name.h"
+#include "core/variant.h"
+#include "core/vector.h"
+
+class MultiplayerAPI;
+class Node;
+
+// Sends the registered properties of nodes from their network master to the other peers.
+//
+// Every packet is a numbered snapshot that only carries the properties whose value differs
+// from the last one the peer acknowledged, so lost packets are healed by the next snapshots
+// without needing reliable transfer. Nodes far from the peer's observer are skipped, and
+// each peer gets at most a given amount of bytes per poll, rotating through the nodes.
+
+class MultiplayerReplicator {
+
+	static const int MAX_PROPERTIES = 32;
+	static const int MAX_PENDING_SNAPSHOTS = 64;
+
+	struct ReplicatedNode {
+		ObjectID id;
+		Vector<StringName> properties;
+		// Taken once per send, for all peers.
+		NodePath path; // Relative to the multiplayer root.
+		Vector<Variant> values;
+		Vector3 position;
+		bool has_position = false;
+	};
+
+	// What a peer is known to have, per node.
+	struct NodeState {
+		Vector<Variant> acked;
+		Vector<uint32_t> acked_snapshot;
+		uint32_t acked_mask = 0;
+	};
+
+	struct SentEntry {
+		ObjectID id;
+		uint32_t mask = 0;
+		Vector<Variant> values; // Only the ones in the mask, in order.
+	};
+
+	struct Snapshot {
+		uint32_t id = 0;
+		Vector<SentEntry> entries;
+	};
+
+	struct PeerState {
+		ObjectID observer;
+		uint32_t next_snapshot = 1;
+		uint32_t last_received = 0; // Newest snapshot applied from this peer.
+		int next_node = 0; // Where to continue when the budget ran out.
+		Map<ObjectID, NodeState> nodes;
+		List<Snapshot> pending; // Oldest first.
+	};
+
+	MultiplayerAPI *multiplayer;
+	Vector<ReplicatedNode> nodes;
+	Map<ObjectID, int> node_indices;
+	Map<int, PeerState> peers;
+	float max_distance;
+	int peer_budget;
+
+	static bool _get_position(Object *p_object, Vector3 &r_position);
+	void _remove_node_index(int p_index);
+	void _send_packet(int p_peer, PeerState &p_state, Vector<uint8_t> &p_packet, Snapshot &p_snapshot);
+	void _send_peer(int p_peer, PeerState &p_state);
+
+public:
+	void add_node(Node *p_node, const Vector<StringName> &p_properties);
+	void remove_node(Node *p_node);
+	bool is_node_replicated(const Node *p_node) const;
+	void set_observer(int p_peer, Node *p_observer);
+
+	void set_max_distance(float p_distance) { max_distance = p_distance; }
+	float get_max_distance() const { return max_distance; }
+	void set_peer_budget(int p_bytes) { peer_budget = p_bytes; }
+	int get_peer_budget() const { return peer_budget; }
+
+	void add_peer(int p_peer);
+	void remove_peer(int p_peer);
+	void clear();
+
+	void send();
+	void process_snapshot(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void process_ack(int p_from, const uint8_t *p_packet, int p_packet_len);
+
+	MultiplayerReplicator(MultiplayerAPI *p_multiplayer);
+};
+
+#endif // MULTIPLAYER_REPLICATOR_H
@@ -40,3 +40,51 @@ NetSocket *NetSocket::create() {
 	ERR_PRINT("Unable to create network socket, platform not supported");
 	return NULL;
 }
+
+Error NetSocket::recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_count) {
+
+	r_count = 0;
+	while (r_count < p_count) {
+		Datagram &d = p_datagrams[r_count];
+		int read = 0;
+		Error err = recvfrom(d.buffer, d.size, read, d.ip, d.port);
+		if (err != OK) {
+			if (r_count > 0) {
+				break; // Report what we have, the error will show up again next time.
+			}
+			return err;
+		}
+		d.size = read;
+		r_count++;
+	}
+	return OK;
+}
+
+Error NetSocket::sendto_batch(const Datagram *p_datagrams, int p_count, int &r_count) {
+
+	r_count = 0;
+	while (r_count < p_count) {
+		const Datagram &d = p_datagrams[r_count];
+		int sent = 0;
+		Error err = sendto(d.buffer, d.size, sent, d.ip, d.port);
+		if (err != OK) {
+			if (r_count > 0) {
+				break;
+			}
+			return err;
+		}
+		r_count++;
+	}
+	return OK;
+}
+
+NetSocketPoller *(*NetSocketPoller::_create)() = NULL;
+
+NetSocketPoller *NetSocketPoller::create() {
+
+	if (_create)
+		return _create();
+
+	ERR_PRINT("Unable to create network socket poller, platform not supported");
+	return NULL;
+}
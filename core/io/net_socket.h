@@ -66,6 +66,27 @@ public:
 	virtual Error sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IP_Address p_ip, uint16_t p_port) = 0;
 	virtual Ref<NetSocket> accept(IP_Address &r_ip, uint16_t &r_port) = 0;
 
+	// One datagram of a batch. When receiving, size is the capacity of buffer on input and the received length on output.
+	struct Datagram {
+		uint8_t *buffer;
+		int size;
+		IP_Address ip;
+		uint16_t port;
+
+		Datagram() {
+			buffer = NULL;
+			size = 0;
+			port = 0;
+		}
+	};
+
+	// Several datagrams per call. The default implementations loop over recvfrom()/sendto(),
+	// has_native_batch_io() tells whether the platform does it with fewer system calls.
+	// Like recvfrom(), receiving returns ERR_BUSY when nothing is pending. r_count may be less than p_count.
+	virtual Error recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_count);
+	virtual Error sendto_batch(const Datagram *p_datagrams, int p_count, int &r_count);
+	virtual bool has_native_batch_io() const { return false; }
+
 	virtual bool is_open() const = 0;
 	virtual int get_available_bytes() const = 0;
 
@@ -78,4 +99,37 @@ public:
 	virtual Error leave_multicast_group(const IP_Address &p_multi_address, String p_if_name) = 0;
 };
 
+// Waits on many sockets at once, so servers with lots of peers only need to touch the ones that are ready.
+// Readiness is level triggered, errors and hang ups are reported as readable so the next read notices them.
+class NetSocketPoller : public Reference {
+
+protected:
+	static NetSocketPoller *(*_create)();
+
+public:
+	static NetSocketPoller *create();
+
+	struct Event {
+		void *userdata;
+		bool readable;
+		bool writable;
+
+		Event() {
+			userdata = NULL;
+			readable = false;
+			writable = false;
+		}
+	};
+
+	virtual Error add_socket(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type, void *p_userdata) = 0;
+	virtual Error modify_socket(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type, void *p_userdata) = 0;
+	virtual void remove_socket(const Ref<NetSocket> &p_socket) = 0;
+	virtual bool has_socket(const Ref<NetSocket> &p_socket) const = 0;
+	virtual int get_socket_count() const = 0;
+
+	// Fills r_events with up to p_max_events ready sockets, waiting at most p_timeout msec (-1 to wait forever).
+	// Returns the number of events, or -1 on error.
+	virtual int wait(Event *r_events, int p_max_events, int p_timeout) = 0;
+};
+
 #endif // NET_SOCKET_H
@@ -249,6 +249,7 @@ void PacketPeerUDP::close() {
 	if (_sock.is_valid())
 		_sock->close();
 	rb.resize(16);
+	batch_buffer.clear();
 	queue_count = 0;
 	connected = false;
 }
@@ -259,6 +260,23 @@ Error PacketPeerUDP::wait() {
 	return _sock->poll(NetSocket::POLL_TYPE_IN, -1);
 }
 
+void PacketPeerUDP::_store_packet(const uint8_t *p_data, int p_size, const IP_Address &p_ip, uint16_t p_port) {
+
+	if (rb.space_left() < p_size + 24) {
+#ifdef TOOLS_ENABLED
+		WARN_PRINT("Buffer full, dropping packets!");
+#endif
+		return;
+	}
+
+	uint32_t port32 = p_port;
+	rb.write(p_ip.get_ipv6(), 16);
+	rb.write((uint8_t *)&port32, 4);
+	rb.write((uint8_t *)&p_size, 4);
+	rb.write(p_data, p_size);
+	++queue_count;
+}
+
 Error PacketPeerUDP::_poll() {
 
 	ERR_FAIL_COND_V(!_sock.is_valid(), ERR_UNAVAILABLE);
@@ -268,6 +286,36 @@ Error PacketPeerUDP::_poll() {
 	}
 
 	Error err;
+
+	if (!connected && _sock->has_native_batch_io()) {
+		// Several datagrams per system call.
+		if (batch_buffer.empty()) {
+			batch_buffer.resize(RECV_BATCH_SIZE * PACKET_BUFFER_SIZE);
+		}
+		NetSocket::Datagram datagrams[RECV_BATCH_SIZE];
+		while (true) {
+			for (int i = 0; i < RECV_BATCH_SIZE; i++) {
+				datagrams[i].buffer = batch_buffer.ptrw() + i * PACKET_BUFFER_SIZE;
+				datagrams[i].size = PACKET_BUFFER_SIZE;
+			}
+
+			int count = 0;
+			err = _sock->recvfrom_batch(datagrams, RECV_BATCH_SIZE, count);
+			if (err != OK) {
+				if (err == ERR_BUSY)
+					break;
+				return FAILED;
+			}
+
+			for (int i = 0; i < count; i++) {
+				_store_packet(datagrams[i].buffer, datagrams[i].size, datagrams[i].ip, datagrams[i].port);
+			}
+			if (count < RECV_BATCH_SIZE)
+				break;
+		}
+		return OK;
+	}
+
 	int read;
 	IP_Address ip;
 	uint16_t port;
@@ -287,19 +335,7 @@ Error PacketPeerUDP::_poll() {
 			return FAILED;
 		}
 
-		if (rb.space_left() < read + 24) {
-#ifdef TOOLS_ENABLED
-			WARN_PRINT("Buffer full, dropping packets!");
-#endif
-			continue;
-		}
-
-		uint32_t port32 = port;
-		rb.write(ip.get_ipv6(), 16);
-		rb.write((uint8_t *)&port32, 4);
-		rb.write((uint8_t *)&read, 4);
-		rb.write(recv_buffer, read);
-		++queue_count;
+		_store_packet(recv_buffer, read, ip, port);
 	}
 
 	return OK;
@@ -40,12 +40,14 @@ class PacketPeerUDP : public PacketPeer {
 
 protected:
 	enum {
-		PACKET_BUFFER_SIZE = 65536
+		PACKET_BUFFER_SIZE = 65536,
+		RECV_BATCH_SIZE = 8
 	};
 
 	RingBuffer<uint8_t> rb;
 	uint8_t recv_buffer[PACKET_BUFFER_SIZE];
 	uint8_t packet_buffer[PACKET_BUFFER_SIZE];
+	Vector<uint8_t> batch_buffer; // RECV_BATCH_SIZE datagrams, only allocated when the socket can batch.
 	IP_Address packet_ip;
 	int packet_port;
 	int queue_count;
@@ -63,6 +65,7 @@ protected:
 
 	Error _set_dest_address(const String &p_address, int p_port);
 	Error _poll();
+	void _store_packet(const uint8_t *p_data, int p_size, const IP_Address &p_ip, uint16_t p_port);
 
 public:
 	void set_blocking_mode(bool p_enable);
@@ -30,7 +30,7 @@
 
 #include "pck_packer.h"
 
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION, PackedData::PackIndexWriter
 #include "core/os/file_access.h"
 #include "core/version.h"
 
@@ -140,6 +140,8 @@ Error PCKPacker::flush(bool p_verbose) {
 	const uint32_t buf_max = 65536;
 	uint8_t *buf = memnew_arr(uint8_t, buf_max);
 
+	PackedData::PackIndexWriter index;
+
 	int count = 0;
 	for (int i = 0; i < files.size(); i++) {
 
@@ -157,6 +159,8 @@ Error PCKPacker::flush(bool p_verbose) {
 		file->store_64(ofs);
 		file->seek(pos);
 
+		index.add_file(files[i].path, ofs, files[i].size, NULL);
+
 		ofs = _align(ofs + files[i].size, alignment);
 		_pad(file, ofs - pos);
 
@@ -174,6 +178,8 @@ Error PCKPacker::flush(bool p_verbose) {
 	if (p_verbose)
 		printf("\n");
 
+	index.store(file, 0);
+
 	file->close();
 	memdelete_arr(buf);
 
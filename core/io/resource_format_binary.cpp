@@ -107,13 +107,19 @@ StringName ResourceLoaderBinary::_get_string() {
 	uint32_t id = f->get_32();
 	if (id & 0x80000000) {
 		uint32_t len = id & 0x7FFFFFFF;
+		if (len == 0)
+			return StringName();
+		String s;
+		int view_len;
+		const uint8_t *view = f->get_buffer_view(len, view_len);
+		if (view) {
+			s.parse_utf8((const char *)view, view_len); //stops at the terminating zero
+			return s;
+		}
 		if ((int)len > str_buf.size()) {
 			str_buf.resize(len);
 		}
-		if (len == 0)
-			return StringName();
 		f->get_buffer((uint8_t *)&str_buf[0], len);
-		String s;
 		s.parse_utf8(&str_buf[0]);
 		return s;
 	}
@@ -338,7 +344,16 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 				case OBJECT_INTERNAL_RESOURCE: {
 					uint32_t index = f->get_32();
 					String path = res_path + "::" + itos(index);
-					RES res = ResourceLoader::load(path);
+					RES res;
+					Map<int, int>::Element *E = internal_index.find(index);
+					if (E) {
+						Error err = _load_internal_resource(E->get(), res);
+						if (err != OK) {
+							return err;
+						}
+					} else {
+						res = ResourceLoader::load(path);
+					}
 					if (res.is_null()) {
 						WARN_PRINT(String("Couldn't load resource: " + path).utf8().get_data());
 					}
@@ -451,6 +466,13 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 			uint32_t len = f->get_32();
 
+			if (skip_raw_arrays) {
+				f->seek(f->get_position() + len);
+				_advance_padding(len);
+				r_v = Vector<uint8_t>();
+				break;
+			}
+
 			Vector<uint8_t> array;
 			array.resize(len);
 			uint8_t *w = array.ptrw();
@@ -653,6 +675,116 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 
 	return resource;
 }
+Error ResourceLoaderBinary::_load_internal_resource(int p_index, RES &r_res) {
+
+	IntResource &ir = internal_resources.write[p_index];
+
+	if (ir.loaded) {
+		r_res = ir.cache;
+		return OK;
+	}
+
+	ERR_FAIL_COND_V_MSG(ir.loading, ERR_CYCLIC_LINK, local_path + ": Subresource references itself: " + ir.path + ".");
+
+	bool main = p_index == (internal_resources.size() - 1);
+
+	//maybe it is loaded already
+	String path;
+	int subindex = 0;
+
+	if (!main) {
+
+		path = ir.path;
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			subindex = path.to_int();
+			path = res_path + "::" + path;
+		}
+
+		if (ResourceCache::has(path)) {
+			//already loaded, don't do anything
+			ir.cache = RES(ResourceCache::get(path));
+			ir.loaded = true;
+			r_res = ir.cache;
+			return OK;
+		}
+	} else {
+
+		if (!ResourceCache::has(res_path))
+			path = res_path;
+	}
+
+	//may be called while in the middle of another resource's properties
+	uint64_t return_pos = f->get_position();
+
+	f->seek(ir.offset);
+
+	String t = get_unicode_string();
+
+	Object *obj = ClassDB::instance(t);
+	if (!obj) {
+		error = ERR_FILE_CORRUPT;
+		ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
+	}
+
+	Resource *r = Object::cast_to<Resource>(obj);
+	if (!r) {
+		String obj_class = obj->get_class();
+		error = ERR_FILE_CORRUPT;
+		memdelete(obj); //bye
+		ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
+	}
+
+	RES res = RES(r);
+
+	r->set_path(path);
+	r->set_subindex(subindex);
+
+	ir.loading = true;
+
+	int pc = f->get_32();
+
+	//set properties
+
+	for (int j = 0; j < pc; j++) {
+
+		StringName name = _get_string();
+
+		if (name == StringName()) {
+			error = ERR_FILE_CORRUPT;
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
+
+		Variant value;
+
+		bool parent_skip_raw_arrays = skip_raw_arrays; //sub-resources can be parsed in the middle of a property
+		skip_raw_arrays = ResourceLoader::is_headless() && ResourceLoader::is_headless_stripped_property(t, name);
+		error = parse_variant(value);
+		skip_raw_arrays = parent_skip_raw_arrays;
+		if (error)
+			return error;
+
+		res->set(name, value);
+	}
+#ifdef TOOLS_ENABLED
+	res->set_edited(false);
+#endif
+
+	ir.loading = false;
+	ir.loaded = true;
+	ir.cache = res;
+	internal_loaded++;
+
+	if (progress) {
+		*progress = internal_loaded / float(internal_resources.size());
+	}
+
+	f->seek(return_pos);
+
+	r_res = res;
+	return OK;
+}
+
 Error ResourceLoaderBinary::load() {
 
 	if (error != OK)
@@ -706,103 +838,36 @@ Error ResourceLoaderBinary::load() {
 		stage++;
 	}
 
-	for (int i = 0; i < internal_resources.size(); i++) {
-
-		bool main = i == (internal_resources.size() - 1);
-
-		//maybe it is loaded already
-		String path;
-		int subindex = 0;
-
-		if (!main) {
-
-			path = internal_resources[i].path;
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				subindex = path.to_int();
-				path = res_path + "::" + path;
-			}
-
-			if (ResourceCache::has(path)) {
-				//already loaded, don't do anything
-				stage++;
-				error = OK;
-				continue;
-			}
-		} else {
-
-			if (!ResourceCache::has(res_path))
-				path = res_path;
-		}
-
-		uint64_t offset = internal_resources[i].offset;
-
-		f->seek(offset);
-
-		String t = get_unicode_string();
-
-		Object *obj = ClassDB::instance(t);
-		if (!obj) {
-			error = ERR_FILE_CORRUPT;
-			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
-		}
-
-		Resource *r = Object::cast_to<Resource>(obj);
-		if (!r) {
-			String obj_class = obj->get_class();
-			error = ERR_FILE_CORRUPT;
-			memdelete(obj); //bye
-			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
-		}
-
-		RES res = RES(r);
-
-		r->set_path(path);
-		r->set_subindex(subindex);
-
-		int pc = f->get_32();
-
-		//set properties
-
-		for (int j = 0; j < pc; j++) {
-
-			StringName name = _get_string();
+	//subresources are parsed when first referenced, the main resource pulls in the ones it uses
+	for (int i = 0; i < internal_resources.size() - 1; i++) {
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
-
-			Variant value;
-
-			error = parse_variant(value);
+		if (!internal_resources[i].path.begins_with("local://")) {
+			//old style path, can only be referenced through the cache
+			RES res;
+			error = _load_internal_resource(i, res);
 			if (error)
 				return error;
-
-			res->set(name, value);
-		}
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
-		stage++;
-
-		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
 		}
+	}
 
-		resource_cache.push_back(res);
+	if (internal_resources.empty()) {
+		return ERR_FILE_EOF;
+	}
 
-		if (main) {
+	RES res;
+	error = _load_internal_resource(internal_resources.size() - 1, res);
+	if (error)
+		return error;
 
-			f->close();
-			resource = res;
-			resource->set_as_translation_remapped(translation_remapped);
-			error = OK;
-			return OK;
-		}
+	if (progress) {
+		*progress = 1.0;
 	}
 
-	return ERR_FILE_EOF;
+	f->close();
+	resource = res;
+	resource->set_as_translation_remapped(translation_remapped);
+	error = OK;
+	return OK;
 }
 
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
@@ -831,13 +896,19 @@ static String get_ustring(FileAccess *f) {
 String ResourceLoaderBinary::get_unicode_string() {
 
 	int len = f->get_32();
+	if (len == 0)
+		return String();
+	String s;
+	int view_len;
+	const uint8_t *view = f->get_buffer_view(len, view_len);
+	if (view) {
+		s.parse_utf8((const char *)view, view_len); //stops at the terminating zero
+		return s;
+	}
 	if (len > str_buf.size()) {
 		str_buf.resize(len);
 	}
-	if (len == 0)
-		return String();
 	f->get_buffer((uint8_t *)&str_buf[0], len);
-	String s;
 	s.parse_utf8(&str_buf[0]);
 	return s;
 }
@@ -948,6 +1019,9 @@ void ResourceLoaderBinary::open(FileAccess *p_f) {
 		IntResource ir;
 		ir.path = get_unicode_string();
 		ir.offset = f->get_64();
+		if (ir.path.begins_with("local://")) {
+			internal_index[ir.path.replace_first("local://", "").to_int()] = i;
+		}
 		internal_resources.push_back(ir);
 	}
 
@@ -1015,6 +1089,7 @@ ResourceLoaderBinary::ResourceLoaderBinary() :
 
 	progress = nullptr;
 	use_sub_threads = false;
+	skip_raw_arrays = false;
 }
 
 ResourceLoaderBinary::~ResourceLoaderBinary() {
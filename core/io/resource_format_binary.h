@@ -49,10 +49,11 @@ class ResourceLoaderBinary {
 	uint64_t importmd_ofs;
 
 	Vector<char> str_buf;
-	List<RES> resource_cache;
 
 	Vector<StringName> string_map;
 
+	bool skip_raw_arrays; //set while parsing a property stripped in headless mode
+
 	StringName _get_string();
 
 	struct ExtResource {
@@ -68,9 +69,14 @@ class ResourceLoaderBinary {
 	struct IntResource {
 		String path;
 		uint64_t offset;
+		RES cache;
+		bool loading = false;
+		bool loaded = false;
 	};
 
 	Vector<IntResource> internal_resources;
+	Map<int, int> internal_index; //subindex -> internal_resources
+	int internal_loaded = 0;
 
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
@@ -81,6 +87,7 @@ class ResourceLoaderBinary {
 	friend class ResourceFormatLoaderBinary;
 
 	Error parse_variant(Variant &r_v);
+	Error _load_internal_resource(int p_index, RES &r_res);
 
 	Map<String, RES> dependency_cache;
 
@@ -30,12 +30,14 @@
 
 #include "resource_loader.h"
 
+#include "core/debugger/profiling_zones.h"
 #include "core/io/resource_importer.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "core/path_remap.h"
 #include "core/print_string.h"
 #include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 #include "core/translation.h"
 #include "core/variant_parser.h"
 
@@ -218,15 +220,49 @@ RES ResourceLoader::_load(const String &p_path, const String &p_original_path, c
 	ERR_FAIL_V_MSG(RES(), "No loader found for resource: " + p_path + ".");
 }
 
+// Adapter so the work pool can run loads, every call takes one task from the queues.
+class ResourceLoaderWorker {
+public:
+	void run(void *p_userdata) {
+		ResourceLoader::_thread_load_run_next();
+	}
+};
+
+static ResourceLoaderWorker resource_loader_worker;
+
+//what keeping a resource alive costs is not known, the size of the file it comes from is a fair estimate
+static uint64_t _get_retain_size(const String &p_path) {
+
+	String path = p_path;
+	if (ResourceFormatImporter::get_singleton()) {
+		String internal_path = ResourceFormatImporter::get_singleton()->get_internal_resource_path(p_path);
+		if (internal_path != String()) {
+			path = internal_path;
+		}
+	}
+
+	FileAccess *f = FileAccess::open(path, FileAccess::READ);
+	if (!f) {
+		return 0;
+	}
+	uint64_t size = f->get_len();
+	memdelete(f);
+	return size;
+}
+
+static bool _thread_load_has_workers() {
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	return pool && pool->get_thread_count() > 0;
+}
+
 void ResourceLoader::_thread_load_function(void *p_userdata) {
 
 	ThreadLoadTask &load_task = *(ThreadLoadTask *)p_userdata;
 	load_task.loader_id = Thread::get_caller_id();
 
-	if (load_task.semaphore) {
-		//this is an actual thread, so wait for Ok fom semaphore
-		thread_load_semaphore->wait(); //wait until its ok to start loading
-	}
+	ResourceCache::notify_miss();
+
 	load_task.resource = _load(load_task.remapped_path, load_task.remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, false, &load_task.error, load_task.use_sub_threads, &load_task.progress);
 
 	load_task.progress = 1.0; //it was fully loaded at this point, so force progress to 1.0
@@ -239,20 +275,14 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	}
 	if (load_task.semaphore) {
 
-		if (load_task.start_next && thread_waiting_count > 0) {
-			thread_waiting_count--;
-			//thread loading count remains constant, this ends but another one begins
-			thread_load_semaphore->post();
-		} else {
-			thread_loading_count--; //no threads waiting, just reduce loading count
-		}
-
-		print_lt("END: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
+		print_lt("END: " + load_task.local_path + " / polls: " + itos(load_task.poll_requests));
 
 		for (int i = 0; i < load_task.poll_requests; i++) {
 			load_task.semaphore->post();
 		}
-		memdelete(load_task.semaphore);
+		if (load_task.poll_requests == 0) {
+			memdelete(load_task.semaphore);
+		} //otherwise the last thread to wake up frees it, as they may still be using it
 		load_task.semaphore = nullptr;
 	}
 
@@ -277,9 +307,228 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 		}
 	}
 
+	//requested ahead of time, by now they are either referenced by the resource or not needed
+	Vector<String> dependencies = load_task.dependencies;
+	load_task.dependencies.clear();
+	for (int i = 0; i < dependencies.size(); i++) {
+		_thread_load_release(dependencies[i]);
+	}
+
+	if (load_task.parent != String()) {
+		ThreadLoadTask *parent = thread_load_tasks.getptr(load_task.parent);
+		if (parent && !parent->started) {
+			parent->pending_dependencies--;
+			if (parent->pending_dependencies == 0) {
+				_thread_load_queue(*parent);
+			}
+		}
+	}
+
+	RES resource = load_task.resource;
+	String remapped_path = load_task.remapped_path;
+
+	if (load_task.requests == 0) {
+		//every request was released while loading
+		String local_path = load_task.local_path;
+		thread_load_tasks.erase(local_path);
+	}
+
+	thread_load_mutex->unlock();
+
+	if (resource.is_valid() && ResourceCache::get_retain_budget() > 0) {
+		ResourceCache::retain(resource, _get_retain_size(remapped_path));
+	}
+}
+
+void ResourceLoader::_thread_load_queue(ThreadLoadTask &p_load_task) {
+
+	if (!_thread_load_has_workers()) {
+		return; //nothing runs it in the background, the first thread to poll or wait for it loads it
+	}
+
+	p_load_task.queued = true;
+	thread_load_queues[p_load_task.priority].push_back(p_load_task.local_path);
+	thread_load_workers.push_back(ThreadWorkPool::get_singleton()->add_task(&resource_loader_worker, &ResourceLoaderWorker::run, (void *)nullptr));
+}
+
+void ResourceLoader::_thread_load_run_next() {
+
+	thread_load_mutex->lock();
+
+	//there is one call per queued task, so tasks are never left behind even if
+	//this one takes another (more urgent) task instead of the one it was queued for
+	ThreadLoadTask *load_task = nullptr;
+	for (int i = 0; i < LOAD_PRIORITY_MAX && !load_task; i++) {
+		List<String> &queue = thread_load_queues[i];
+		while (queue.size() && !load_task) {
+			ThreadLoadTask *candidate = thread_load_tasks.getptr(queue.front()->get());
+			queue.pop_front();
+			//entries may be stale: released, taken by a thread that needed it, or queued again with another priority
+			if (candidate && candidate->queued && !candidate->started) {
+				load_task = candidate;
+			}
+		}
+	}
+
+	if (!load_task) {
+		thread_load_mutex->unlock();
+		return;
+	}
+
+	load_task->queued = false;
+
+	if (!load_task->scanned && load_task->use_sub_threads) {
+		load_task->scanned = true;
+		String local_path = load_task->local_path;
+		thread_load_mutex->unlock();
+
+		_thread_load_scan(local_path);
+		return;
+	}
+
+	load_task->started = true;
+	thread_load_mutex->unlock();
+
+	_thread_load_function(load_task);
+}
+
+void ResourceLoader::_thread_load_scan(const String &p_path) {
+
+	//only reads the file header, so the resources it uses can be loaded first and in parallel
+	List<String> dependencies;
+	get_dependencies(p_path, &dependencies);
+
+	thread_load_mutex->lock();
+
+	ThreadLoadTask *load_task = thread_load_tasks.getptr(p_path);
+	if (!load_task || load_task->started) {
+		//released, or a thread needed it and is loading it already
+		thread_load_mutex->unlock();
+		return;
+	}
+
+	for (List<String>::Element *E = dependencies.front(); E; E = E->next()) {
+
+		String path = E->get().get_slice("::", 0);
+		String local_path;
+		if (path.is_rel_path())
+			local_path = "res://" + path;
+		else
+			local_path = ProjectSettings::get_singleton()->localize_path(path);
+
+		if (local_path == p_path || thread_load_tasks.has(local_path) || ResourceCache::has(local_path)) {
+			//don't wait for tasks in flight, they may be waiting for this one
+			continue;
+		}
+
+		ThreadLoadTask dependency;
+		dependency.requests = 1;
+		dependency.remapped_path = _path_remap(local_path, &dependency.xl_remapped);
+		dependency.local_path = local_path;
+		dependency.priority = load_task->priority;
+		dependency.use_sub_threads = true;
+		dependency.semaphore = memnew(Semaphore);
+		dependency.parent = p_path;
+		thread_load_tasks[local_path] = dependency;
+
+		load_task->dependencies.push_back(local_path);
+		load_task->pending_dependencies++;
+
+		_thread_load_queue(thread_load_tasks[local_path]);
+	}
+
+	print_lt("SCAN: " + p_path + " / dependencies: " + itos(load_task->pending_dependencies));
+
+	if (load_task->pending_dependencies == 0) {
+		_thread_load_queue(*load_task);
+	}
+
 	thread_load_mutex->unlock();
 }
-Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, const String &p_source_resource) {
+
+void ResourceLoader::_thread_load_release(const String &p_path) {
+
+	ThreadLoadTask *load_task = thread_load_tasks.getptr(p_path);
+	if (!load_task) {
+		return;
+	}
+
+	load_task->requests--;
+	if (load_task->requests > 0) {
+		return;
+	}
+
+	if (load_task->started && load_task->status == THREAD_LOAD_IN_PROGRESS) {
+		return; //erased by the loading thread once done
+	}
+
+	Vector<String> dependencies = load_task->dependencies;
+	if (load_task->semaphore) {
+		memdelete(load_task->semaphore); //never loaded, so nobody waits on it
+	}
+	thread_load_tasks.erase(p_path);
+
+	for (int i = 0; i < dependencies.size(); i++) {
+		_thread_load_release(dependencies[i]);
+	}
+}
+
+void ResourceLoader::_thread_load_raise_priority(ThreadLoadTask &p_load_task, LoadPriority p_priority) {
+
+	if (p_priority >= p_load_task.priority) {
+		return;
+	}
+
+	p_load_task.priority = p_priority;
+	if (p_load_task.queued) {
+		//the old entry goes stale, the call queued for it takes this one
+		thread_load_queues[p_priority].push_back(p_load_task.local_path);
+	}
+
+	for (int i = 0; i < p_load_task.dependencies.size(); i++) {
+		ThreadLoadTask *dependency = thread_load_tasks.getptr(p_load_task.dependencies[i]);
+		if (dependency) {
+			_thread_load_raise_priority(*dependency, p_priority);
+		}
+	}
+}
+
+void ResourceLoader::_thread_load_reap_workers(bool p_wait_all) {
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (!pool) {
+		return;
+	}
+
+	while (true) {
+		Vector<uint64_t> finished;
+
+		thread_load_mutex->lock();
+		for (int i = 0; i < thread_load_workers.size(); i++) {
+			if (p_wait_all || pool->is_task_completed(thread_load_workers[i])) {
+				finished.push_back(thread_load_workers[i]);
+				thread_load_workers.write[i] = thread_load_workers[thread_load_workers.size() - 1];
+				thread_load_workers.resize(thread_load_workers.size() - 1);
+				i--;
+			}
+		}
+		thread_load_mutex->unlock();
+
+		if (finished.empty()) {
+			break;
+		}
+
+		for (int i = 0; i < finished.size(); i++) {
+			pool->wait_for_task(finished[i]);
+		}
+
+		if (!p_wait_all) {
+			break;
+		}
+	}
+}
+
+Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, const String &p_source_resource, LoadPriority p_priority) {
 
 	String local_path;
 	if (p_path.is_rel_path())
@@ -310,6 +559,7 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 
 	if (thread_load_tasks.has(local_path)) {
 		thread_load_tasks[local_path].requests++;
+		_thread_load_raise_priority(thread_load_tasks[local_path], p_priority);
 		if (p_source_resource != String()) {
 			thread_load_tasks[p_source_resource].sub_tasks.insert(local_path);
 		}
@@ -327,6 +577,7 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 		load_task.local_path = local_path;
 		load_task.type_hint = p_type_hint;
 		load_task.use_sub_threads = p_use_sub_threads;
+		load_task.priority = p_priority;
 
 		{ //must check if resource is already loaded before attempting to load it in a thread
 
@@ -340,13 +591,14 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 			}
 
 			//get ptr
-			Resource **rptr = ResourceCache::resources.getptr(local_path);
+			Resource **rptr = ResourceCache::resources.lookup_ptr(local_path);
 
 			if (rptr) {
 				RES res(*rptr);
 				//it is possible this resource was just freed in a thread. If so, this referencing will not work and resource is considered not cached
 				if (res.is_valid()) {
 					//referencing is fine
+					ResourceCache::notify_hit(res);
 					load_task.resource = res;
 					load_task.status = THREAD_LOAD_LOADED;
 					load_task.progress = 1.0;
@@ -369,17 +621,10 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 	if (load_task.resource.is_null()) { //needs  to be loaded in thread
 
 		load_task.semaphore = memnew(Semaphore);
-		if (thread_loading_count < thread_load_max) {
-			thread_loading_count++;
-			thread_load_semaphore->post(); //we have free threads, so allow one
-		} else {
-			thread_waiting_count++;
-		}
 
-		print_lt("REQUEST: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
+		print_lt("REQUEST: " + local_path + " / priority: " + itos(p_priority));
 
-		load_task.thread = Thread::create(_thread_load_function, &thread_load_tasks[local_path]);
-		load_task.loader_id = load_task.thread->get_id();
+		_thread_load_queue(load_task);
 	}
 
 	thread_load_mutex->unlock();
@@ -392,11 +637,18 @@ float ResourceLoader::_dependency_get_progress(const String &p_path) {
 	if (thread_load_tasks.has(p_path)) {
 		ThreadLoadTask &load_task = thread_load_tasks[p_path];
 		int dep_count = load_task.sub_tasks.size();
-		if (dep_count > 0) {
-			float dep_progress = 0;
-			for (Set<String>::Element *E = load_task.sub_tasks.front(); E; E = E->next()) {
-				dep_progress += _dependency_get_progress(E->get());
+		float dep_progress = 0;
+		for (Set<String>::Element *E = load_task.sub_tasks.front(); E; E = E->next()) {
+			dep_progress += _dependency_get_progress(E->get());
+		}
+		for (int i = 0; i < load_task.dependencies.size(); i++) {
+			//requested ahead of time, but not by the loader yet
+			if (!load_task.sub_tasks.has(load_task.dependencies[i])) {
+				dep_progress += _dependency_get_progress(load_task.dependencies[i]);
+				dep_count++;
 			}
+		}
+		if (dep_count > 0) {
 			dep_progress /= float(dep_count);
 			dep_progress *= 0.5;
 			dep_progress += load_task.progress * 0.5;
@@ -423,9 +675,24 @@ ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(const
 		thread_load_mutex->unlock();
 		return THREAD_LOAD_INVALID_RESOURCE;
 	}
-	ThreadLoadTask &load_task = thread_load_tasks[local_path];
+	ThreadLoadTask *load_task = &thread_load_tasks[local_path];
+	if (load_task->semaphore && !load_task->started && !_thread_load_has_workers()) {
+		//nothing loads it in the background, so do it now
+		load_task->started = true;
+
+		thread_load_mutex->unlock();
+		_thread_load_function(load_task);
+		thread_load_mutex->lock();
+
+		load_task = thread_load_tasks.getptr(local_path);
+		if (!load_task) {
+			thread_load_mutex->unlock();
+			return THREAD_LOAD_INVALID_RESOURCE;
+		}
+	}
+
 	ThreadLoadStatus status;
-	status = load_task.status;
+	status = load_task->status;
 	if (r_progress) {
 		*r_progress = _dependency_get_progress(local_path);
 	}
@@ -453,41 +720,34 @@ RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
 
 	ThreadLoadTask &load_task = thread_load_tasks[local_path];
 
-	//semaphore still exists, meaning its still loading, request poll
+	//semaphore still exists, meaning its still loading
 	Semaphore *semaphore = load_task.semaphore;
-	if (semaphore) {
-		load_task.poll_requests++;
+	if (semaphore && !load_task.started) {
+		//no worker took it yet (or it is waiting for its dependencies), load it in this thread instead of blocking
+		load_task.started = true;
+		load_task.queued = false;
 
-		{
-			// As we got a semaphore, this means we are going to have to wait
-			// until the sub-resource is done loading
-			//
-			// As this thread will become 'blocked' we should "echange" its
-			// active status with a waiting one, to ensure load continues.
-			//
-			// This ensures loading is never blocked and that is also within
-			// the maximum number of active threads.
-
-			if (thread_waiting_count > 0) {
-				thread_waiting_count--;
-				thread_loading_count++;
-				thread_load_semaphore->post();
-
-				load_task.start_next = false; //do not start next since we are doing it here
-			}
+		print_lt("GET: " + local_path + " / loading in caller");
+
+		thread_load_mutex->unlock();
+		_thread_load_function(&load_task);
+		thread_load_mutex->lock();
 
-			thread_suspended_count++;
+	} else if (semaphore) {
+		load_task.poll_requests++;
 
-			print_lt("GET: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
-		}
+		print_lt("GET: " + local_path + " / waiting");
 
 		thread_load_mutex->unlock();
 		semaphore->wait();
 		thread_load_mutex->lock();
 
-		thread_suspended_count--;
-
-		if (!thread_load_tasks.has(local_path)) { //may have been erased during unlock and this was always an invalid call
+		if (thread_load_tasks.has(local_path)) {
+			load_task.poll_requests--;
+			if (load_task.poll_requests == 0) {
+				memdelete(semaphore);
+			}
+		} else { //may have been erased during unlock and this was always an invalid call
 			thread_load_mutex->unlock();
 			if (r_error) {
 				*r_error = ERR_INVALID_PARAMETER;
@@ -501,23 +761,20 @@ RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
 		*r_error = load_task.error;
 	}
 
-	load_task.requests--;
-
-	if (load_task.requests == 0) {
-		if (load_task.thread) { //thread may not have been used
-			Thread::wait_to_finish(load_task.thread);
-			memdelete(load_task.thread);
-		}
-		thread_load_tasks.erase(local_path);
-	}
+	_thread_load_release(local_path);
 
 	thread_load_mutex->unlock();
 
+	_thread_load_reap_workers(false);
+
 	return resource;
 }
 
 RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p_no_cache, Error *r_error) {
 
+	PROFILING_ZONE("ResourceLoader::load");
+	MemoryTagScope memory_tag(Memory::TAG_RESOURCES);
+
 	if (r_error)
 		*r_error = ERR_CANT_OPEN;
 
@@ -551,7 +808,7 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 			ResourceCache::lock->read_lock();
 		}
 
-		Resource **rptr = ResourceCache::resources.getptr(local_path);
+		Resource **rptr = ResourceCache::resources.lookup_ptr(local_path);
 
 		if (rptr) {
 			RES res(*rptr);
@@ -567,6 +824,8 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 					*r_error = OK;
 				}
 
+				ResourceCache::notify_hit(res);
+
 				return res; //use cached
 			}
 		}
@@ -583,6 +842,8 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 		load_task.remapped_path = _path_remap(local_path, &load_task.xl_remapped);
 		load_task.type_hint = p_type_hint;
 		load_task.loader_id = Thread::get_caller_id();
+		load_task.started = true;
+		load_task.semaphore = memnew(Semaphore); //other threads may request it meanwhile and wait on it
 
 		thread_load_tasks[local_path] = load_task;
 
@@ -969,6 +1230,17 @@ String ResourceLoader::import_remap(const String &p_path) {
 	return p_path;
 }
 
+void ResourceLoader::add_headless_stripped_property(const StringName &p_type, const StringName &p_property) {
+
+	headless_stripped_properties[p_type].insert(p_property);
+}
+
+bool ResourceLoader::is_headless_stripped_property(const StringName &p_type, const StringName &p_property) {
+
+	const Set<StringName> *properties = headless_stripped_properties.getptr(p_type);
+	return properties && properties->has(p_property);
+}
+
 String ResourceLoader::path_remap(const String &p_path) {
 	return _path_remap(p_path);
 }
@@ -1127,17 +1399,13 @@ void ResourceLoader::remove_custom_loaders() {
 
 void ResourceLoader::initialize() {
 	thread_load_mutex = memnew(Mutex);
-	thread_load_max = OS::get_singleton()->get_processor_count();
-	thread_loading_count = 0;
-	thread_waiting_count = 0;
-	thread_suspended_count = 0;
-	thread_load_semaphore = memnew(Semaphore);
 }
 
 void ResourceLoader::finalize() {
 
+	_thread_load_reap_workers(true);
 	memdelete(thread_load_mutex);
-	memdelete(thread_load_semaphore);
+	headless_stripped_properties.clear();
 }
 
 ResourceLoadErrorNotify ResourceLoader::err_notify = NULL;
@@ -1147,16 +1415,14 @@ DependencyErrorNotify ResourceLoader::dep_err_notify = NULL;
 void *ResourceLoader::dep_err_notify_ud = NULL;
 
 bool ResourceLoader::abort_on_missing_resource = true;
+bool ResourceLoader::headless = false;
+HashMap<StringName, Set<StringName>> ResourceLoader::headless_stripped_properties;
 bool ResourceLoader::timestamp_on_load = false;
 
 Mutex *ResourceLoader::thread_load_mutex = nullptr;
 HashMap<String, ResourceLoader::ThreadLoadTask> ResourceLoader::thread_load_tasks;
-Semaphore *ResourceLoader::thread_load_semaphore = nullptr;
-
-int ResourceLoader::thread_loading_count = 0;
-int ResourceLoader::thread_waiting_count = 0;
-int ResourceLoader::thread_suspended_count = 0;
-int ResourceLoader::thread_load_max = 0;
+List<String> ResourceLoader::thread_load_queues[ResourceLoader::LOAD_PRIORITY_MAX];
+Vector<uint64_t> ResourceLoader::thread_load_workers;
 
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
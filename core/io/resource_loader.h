@@ -80,6 +80,13 @@ public:
 		THREAD_LOAD_LOADED
 	};
 
+	enum LoadPriority {
+		LOAD_PRIORITY_HIGH, //needed right away, e.g. the level being entered
+		LOAD_PRIORITY_NORMAL,
+		LOAD_PRIORITY_LOW, //background streaming
+		LOAD_PRIORITY_MAX
+	};
+
 private:
 	static Ref<ResourceFormatLoader> loader[MAX_LOADERS];
 	static int loader_count;
@@ -90,6 +97,8 @@ private:
 	static void *dep_err_notify_ud;
 	static DependencyErrorNotify dep_err_notify;
 	static bool abort_on_missing_resource;
+	static bool headless;
+	static HashMap<StringName, Set<StringName>> headless_stripped_properties;
 	static HashMap<String, Vector<String>> translation_remaps;
 	static HashMap<String, String> path_remaps;
 
@@ -108,7 +117,6 @@ private:
 	static Ref<ResourceFormatLoader> _find_custom_resource_format_loader(String path);
 
 	struct ThreadLoadTask {
-		Thread *thread = nullptr;
 		Thread::ID loader_id = 0;
 		Semaphore *semaphore = nullptr;
 		String local_path;
@@ -116,29 +124,40 @@ private:
 		String type_hint;
 		float progress = 0.0;
 		ThreadLoadStatus status = THREAD_LOAD_IN_PROGRESS;
+		LoadPriority priority = LOAD_PRIORITY_NORMAL;
 		Error error = OK;
 		RES resource;
 		bool xl_remapped = false;
 		bool use_sub_threads = false;
-		bool start_next = true;
+		bool started = false; //claimed by a worker, or by a thread that could not wait for one
+		bool scanned = false; //dependencies were already looked up
+		bool queued = false;
 		int requests = 0;
 		int poll_requests = 0;
+		int pending_dependencies = 0;
+		String parent; //task that requested this one ahead of time, notified once loaded
+		Vector<String> dependencies; //requested ahead of time, released once loaded
 		Set<String> sub_tasks;
 	};
 
+	friend class ResourceLoaderWorker;
+
 	static void _thread_load_function(void *p_userdata);
+	static void _thread_load_queue(ThreadLoadTask &p_load_task);
+	static void _thread_load_run_next();
+	static void _thread_load_scan(const String &p_path);
+	static void _thread_load_release(const String &p_path);
+	static void _thread_load_raise_priority(ThreadLoadTask &p_load_task, LoadPriority p_priority);
+	static void _thread_load_reap_workers(bool p_wait_all);
 	static Mutex *thread_load_mutex;
 	static HashMap<String, ThreadLoadTask> thread_load_tasks;
-	static Semaphore *thread_load_semaphore;
-	static int thread_waiting_count;
-	static int thread_loading_count;
-	static int thread_suspended_count;
-	static int thread_load_max;
+	static List<String> thread_load_queues[LOAD_PRIORITY_MAX];
+	static Vector<uint64_t> thread_load_workers; //ThreadWorkPool::TaskID, waited for once done
 
 	static float _dependency_get_progress(const String &p_path);
 
 public:
-	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, const String &p_source_resource = String());
+	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, const String &p_source_resource = String(), LoadPriority p_priority = LOAD_PRIORITY_NORMAL);
 	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = nullptr);
 	static RES load_threaded_get(const String &p_path, Error *r_error = NULL);
 
@@ -178,6 +197,14 @@ public:
 	static void set_abort_on_missing_resources(bool p_abort) { abort_on_missing_resource = p_abort; }
 	static bool get_abort_on_missing_resources() { return abort_on_missing_resource; }
 
+	// Headless mode is for dedicated servers running on the dummy rasterizer:
+	// loaders skip the payloads only the GPU needs, and keep the metadata
+	// (sizes, formats, AABBs) gameplay code may still query.
+	static void set_headless(bool p_headless) { headless = p_headless; }
+	static bool is_headless() { return headless; }
+	static void add_headless_stripped_property(const StringName &p_type, const StringName &p_property); //raw byte arrays in it are not read when headless
+	static bool is_headless_stripped_property(const StringName &p_type, const StringName &p_property);
+
 	static String path_remap(const String &p_path);
 	static String import_remap(const String &p_path);
 
@@ -77,6 +77,7 @@ public:
 	Status get_status();
 
 	void set_no_delay(bool p_enabled);
+	Ref<NetSocket> get_socket() const { return _sock; }
 
 	// Poll functions (wait or check for writable, readable)
 	Error poll(NetSocket::PollType p_type, int timeout = 0);
@@ -0,0 +1,210 @@
+/*************************************************************************/
+/*  local_vector.h                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef LOCAL_VECTOR_H
+#define LOCAL_VECTOR_H
+
+#include "core/error_macros.h"
+#include "core/list.h"
+#include "core/os/memory.h"
+#include "core/sort_array.h"
+#include "core/vector.h"
+
+/**
+ * Non copy-on-write vector, meant for temporary arrays in hot code.
+ * Storage comes from the allocator, so with FrameAllocator it must
+ * not be kept beyond the current frame (see FrameVector below).
+ */
+
+template <class T, class U = uint32_t, class A = DefaultAllocator>
+class LocalVector {
+
+	U count = 0;
+	U capacity = 0;
+	T *data = nullptr;
+
+public:
+	_FORCE_INLINE_ T *ptr() { return data; }
+	_FORCE_INLINE_ const T *ptr() const { return data; }
+
+	_FORCE_INLINE_ void push_back(const T &p_elem) {
+		if (unlikely(count == capacity)) {
+			reserve(capacity ? capacity * 2 : 4);
+		}
+		memnew_placement(&data[count++], T(p_elem));
+	}
+
+	void remove(U p_index) {
+		ERR_FAIL_UNSIGNED_INDEX(p_index, count);
+		for (U i = p_index; i < count - 1; i++) {
+			data[i] = data[i + 1];
+		}
+		count--;
+		data[count].~T();
+	}
+
+	// Removes the item copying the last value into the position of the one to
+	// remove. It's generally faster than `remove`.
+	void remove_unordered(U p_index) {
+		ERR_FAIL_UNSIGNED_INDEX(p_index, count);
+		count--;
+		if (count > p_index) {
+			data[p_index] = data[count];
+		}
+		data[count].~T();
+	}
+
+	void erase(const T &p_val) {
+		int64_t idx = find(p_val);
+		if (idx >= 0) {
+			remove(idx);
+		}
+	}
+
+	int64_t find(const T &p_val, U p_from = 0) const {
+		for (U i = p_from; i < count; i++) {
+			if (data[i] == p_val) {
+				return int64_t(i);
+			}
+		}
+		return -1;
+	}
+
+	_FORCE_INLINE_ void clear() { resize(0); }
+	_FORCE_INLINE_ void reset() {
+		clear();
+		if (data) {
+			A::free(data);
+			data = nullptr;
+			capacity = 0;
+		}
+	}
+	_FORCE_INLINE_ bool empty() const { return count == 0; }
+	_FORCE_INLINE_ U size() const { return count; }
+
+	void reserve(U p_size) {
+		if (p_size <= capacity) {
+			return;
+		}
+		T *new_data = (T *)A::alloc(p_size * sizeof(T));
+		CRASH_COND_MSG(!new_data, "Out of memory");
+		for (U i = 0; i < count; i++) {
+			memnew_placement(&new_data[i], T(data[i]));
+			data[i].~T();
+		}
+		if (data) {
+			A::free(data);
+		}
+		data = new_data;
+		capacity = p_size;
+	}
+
+	void resize(U p_size) {
+		if (p_size < count) {
+			if (!__has_trivial_destructor(T)) {
+				for (U i = p_size; i < count; i++) {
+					data[i].~T();
+				}
+			}
+			count = p_size;
+		} else if (p_size > count) {
+			reserve(MAX(p_size, capacity * 2));
+			if (!__has_trivial_constructor(T)) {
+				for (U i = count; i < p_size; i++) {
+					memnew_placement(&data[i], T);
+				}
+			}
+			count = p_size;
+		}
+	}
+
+	_FORCE_INLINE_ const T &operator[](U p_index) const {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, count);
+		return data[p_index];
+	}
+	_FORCE_INLINE_ T &operator[](U p_index) {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, count);
+		return data[p_index];
+	}
+
+	template <class C>
+	void sort_custom() {
+		if (count > 1) {
+			SortArray<T, C> sorter;
+			sorter.sort(data, count);
+		}
+	}
+
+	void sort() {
+		sort_custom<_DefaultComparator<T>>();
+	}
+
+	operator Vector<T>() const {
+		Vector<T> ret;
+		ret.resize(count);
+		T *w = ret.ptrw();
+		for (U i = 0; i < count; i++) {
+			w[i] = data[i];
+		}
+		return ret;
+	}
+
+	_FORCE_INLINE_ LocalVector() {}
+	_FORCE_INLINE_ LocalVector(const LocalVector &p_from) {
+		reserve(p_from.size());
+		for (U i = 0; i < p_from.count; i++) {
+			push_back(p_from.data[i]);
+		}
+	}
+	inline LocalVector &operator=(const LocalVector &p_from) {
+		if (this == &p_from) {
+			return *this;
+		}
+		clear();
+		reserve(p_from.size());
+		for (U i = 0; i < p_from.count; i++) {
+			push_back(p_from.data[i]);
+		}
+		return *this;
+	}
+
+	_FORCE_INLINE_ ~LocalVector() {
+		reset();
+	}
+};
+
+// Vector and List for temporary data that is discarded before the frame ends.
+template <class T>
+using FrameVector = LocalVector<T, uint32_t, FrameAllocator>;
+
+template <class T>
+using FrameList = List<T, FrameAllocator>;
+
+#endif // LOCAL_VECTOR_H
@@ -32,6 +32,7 @@
 
 #include "core/math/geometry.h"
 #include "core/script_language.h"
+#include "core/thread_work_pool.h"
 #include "scene/scene_string_names.h"
 
 int AStar::get_available_point_id() const {
@@ -66,11 +67,10 @@ void AStar::add_point(int p_id, const Vector3 &p_pos, real_t p_weight_scale) {
 		pt->id = p_id;
 		pt->pos = p_pos;
 		pt->weight_scale = p_weight_scale;
-		pt->prev_point = NULL;
-		pt->open_pass = 0;
-		pt->closed_pass = 0;
 		pt->enabled = true;
+		pt->index = point_list.size();
 		points.set(p_id, pt);
+		point_list.push_back(pt);
 	} else {
 		found_pt->pos = p_pos;
 		found_pt->weight_scale = p_weight_scale;
@@ -138,6 +138,12 @@ void AStar::remove_point(int p_id) {
 		(*it.value)->unlinked_neighbours.remove(p->id);
 	}
 
+	// The last point takes its place, so the list stays dense.
+	Point *last = point_list[point_list.size() - 1];
+	last->index = p->index;
+	point_list[p->index] = last;
+	point_list.resize(point_list.size() - 1);
+
 	memdelete(p);
 	points.remove(p_id);
 	last_free_id = p_id;
@@ -267,6 +273,7 @@ void AStar::clear() {
 	}
 	segments.clear();
 	points.clear();
+	point_list.clear();
 }
 
 int AStar::get_point_count() const {
@@ -281,6 +288,7 @@ void AStar::reserve_space(int p_num_nodes) {
 	ERR_FAIL_COND_MSG(p_num_nodes <= 0, "New capacity must be greater than 0, was: " + itos(p_num_nodes) + ".");
 	ERR_FAIL_COND_MSG((uint32_t)p_num_nodes < points.get_capacity(), "New capacity must be greater than current capacity: " + itos(points.get_capacity()) + ", new was: " + itos(p_num_nodes) + ".");
 	points.reserve(p_num_nodes);
+	point_list.reserve(p_num_nodes);
 }
 
 int AStar::get_closest_point(const Vector3 &p_point, bool p_include_disabled) const {
@@ -336,67 +344,212 @@ Vector3 AStar::get_closest_position_in_segment(const Vector3 &p_point) const {
 	return closest_point;
 }
 
-bool AStar::_solve(Point *begin_point, Point *end_point) {
+AStar::SearchContext *AStar::_acquire_context() {
+
+	SearchContext *context = NULL;
+	{
+		MutexLock lock(context_mutex);
+		if (free_contexts.size()) {
+			context = free_contexts[free_contexts.size() - 1];
+			free_contexts.resize(free_contexts.size() - 1);
+		}
+	}
+	if (!context) {
+		context = memnew(SearchContext);
+	}
+
+	// Grown to fit the points added since, new entries are unmarked.
+	uint32_t from = context->g_score.size();
+	if (from < point_list.size()) {
+		context->g_score.resize(point_list.size());
+		context->prev_point.resize(point_list.size());
+		context->open_pass.resize(point_list.size());
+		context->closed_pass.resize(point_list.size());
+		for (uint32_t i = from; i < point_list.size(); i++) {
+			context->open_pass[i] = 0;
+			context->closed_pass[i] = 0;
+		}
+	}
 
-	pass++;
+	context->pass++;
+	if (context->pass == 0) { // Wrapped around, old marks would look current.
+		for (uint32_t i = 0; i < context->open_pass.size(); i++) {
+			context->open_pass[i] = 0;
+			context->closed_pass[i] = 0;
+		}
+		context->pass = 1;
+	}
+
+	return context;
+}
+
+void AStar::_release_context(SearchContext *p_context) {
+
+	MutexLock lock(context_mutex);
+	free_contexts.push_back(p_context);
+}
+
+template <class C>
+bool AStar::_solve(SearchContext &r_context, Point *begin_point, Point *end_point, C *p_costs) {
 
 	if (!end_point->enabled) return false;
 
-	bool found_route = false;
+	uint32_t pass = r_context.pass;
+	LocalVector<OpenPoint> &open_list = r_context.open_list;
+	SortArray<OpenPoint, SortPoints> sorter;
+
+	open_list.clear();
 
-	Vector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	r_context.g_score[begin_point->index] = 0;
+	r_context.open_pass[begin_point->index] = pass;
 
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
+	OpenPoint begin;
+	begin.point = begin_point;
+	begin.g_score = 0;
+	begin.f_score = p_costs->_estimate_cost(begin_point->id, end_point->id);
+	open_list.push_back(begin);
 
-	while (!open_list.empty()) {
+	while (open_list.size()) {
 
-		Point *p = open_list[0]; // The currently processed point
+		OpenPoint current = open_list[0]; // The currently processed point
+		Point *p = current.point;
+
+		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list
+		open_list.resize(open_list.size() - 1);
+
+		// Points are pushed again when a better path reaches them, the older entries are skipped.
+		if (r_context.closed_pass[p->index] == pass) {
+			continue;
+		}
 
 		if (p == end_point) {
-			found_route = true;
-			break;
+			return true;
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptrw()); // Remove the current point from the open list
-		open_list.remove(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed
+		r_context.closed_pass[p->index] = pass; // Mark the point as closed
 
 		for (OAHashMap<int, Point *>::Iterator it = p->neighbours.iter(); it.valid; it = p->neighbours.next_iter(it)) {
 
 			Point *e = *(it.value); // The neighbour point
 
-			if (!e->enabled || e->closed_pass == pass) {
+			if (!e->enabled || r_context.closed_pass[e->index] == pass) {
 				continue;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
-
-			bool new_point = false;
+			real_t tentative_g_score = current.g_score + p_costs->_compute_cost(p->id, e->id) * e->weight_scale;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
-				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
-				continue;
+			if (r_context.open_pass[e->index] == pass && tentative_g_score >= r_context.g_score[e->index]) {
+				continue; // The new path is worse than the previous.
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
+			r_context.open_pass[e->index] = pass;
+			r_context.prev_point[e->index] = p->index;
+			r_context.g_score[e->index] = tentative_g_score;
 
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptrw());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptrw());
-			}
+			OpenPoint open;
+			open.point = e;
+			open.g_score = tentative_g_score;
+			open.f_score = tentative_g_score + p_costs->_estimate_cost(e->id, end_point->id);
+			open_list.push_back(open);
+			sorter.push_heap(0, open_list.size() - 1, 0, open, open_list.ptr());
 		}
 	}
 
-	return found_route;
+	return false;
+}
+
+void AStar::_get_path_points(const SearchContext &p_context, Point *begin_point, Point *end_point, LocalVector<Point *> &r_points) const {
+
+	Point *p = end_point;
+	r_points.push_back(p);
+	while (p != begin_point) {
+		p = point_list[p_context.prev_point[p->index]];
+		r_points.push_back(p);
+	}
+
+	// Walked back from the end, reverse so the path starts at the begin point.
+	uint32_t count = r_points.size();
+	for (uint32_t i = 0; i < count / 2; i++) {
+		SWAP(r_points[i], r_points[count - i - 1]);
+	}
+}
+
+template <class C>
+Vector<int> AStar::_find_id_path(int p_from_id, int p_to_id, C *p_costs) {
+
+	Point *a;
+	bool from_exists = points.lookup(p_from_id, a);
+	ERR_FAIL_COND_V(!from_exists, Vector<int>());
+
+	Point *b;
+	bool to_exists = points.lookup(p_to_id, b);
+	ERR_FAIL_COND_V(!to_exists, Vector<int>());
+
+	if (a == b) {
+		Vector<int> ret;
+		ret.push_back(a->id);
+		return ret;
+	}
+
+	Vector<int> path;
+
+	SearchContext *context = _acquire_context();
+	if (_solve(*context, a, b, p_costs)) {
+		LocalVector<Point *> path_points;
+		_get_path_points(*context, a, b, path_points);
+
+		path.resize(path_points.size());
+		int *w = path.ptrw();
+		for (uint32_t i = 0; i < path_points.size(); i++) {
+			w[i] = path_points[i]->id;
+		}
+	}
+	_release_context(context);
+
+	return path;
+}
+
+template <class C>
+void AStar::PathBatch<C>::solve(uint32_t p_index, void *p_unused) {
+
+	paths[p_index] = astar->_find_id_path(from_ids[p_index], to_ids[p_index], costs);
+}
+
+template <class C>
+Array AStar::_find_id_paths(const Vector<int> &p_from_ids, const Vector<int> &p_to_ids, C *p_costs) {
+
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), Array(), "Both arrays of points must have the same size.");
+
+	int count = p_from_ids.size();
+	Vector<Vector<int>> paths;
+	paths.resize(count);
+
+	PathBatch<C> batch;
+	batch.astar = this;
+	batch.costs = p_costs;
+	batch.from_ids = p_from_ids.ptr();
+	batch.to_ids = p_to_ids.ptr();
+	batch.paths = paths.ptrw();
+
+	// Scripts can't be called from several threads at once.
+	ScriptInstance *si = p_costs->get_script_instance();
+	bool scripted_costs = si && (si->has_method(SceneStringNames::get_singleton()->_estimate_cost) || si->has_method(SceneStringNames::get_singleton()->_compute_cost));
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (!scripted_costs && pool && pool->get_thread_count() > 0 && count > 1) {
+		pool->do_work(count, &batch, &PathBatch<C>::solve, (void *)NULL);
+	} else {
+		for (int i = 0; i < count; i++) {
+			batch.solve(i, NULL);
+		}
+	}
+
+	Array ret;
+	ret.resize(count);
+	for (int i = 0; i < count; i++) {
+		ret[i] = paths[i];
+	}
+	return ret;
 }
 
 real_t AStar::_estimate_cost(int p_from_id, int p_to_id) {
@@ -447,84 +600,32 @@ Vector<Vector3> AStar::get_point_path(int p_from_id, int p_to_id) {
 		return ret;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) return Vector<Vector3>();
-
-	Point *p = end_point;
-	int pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
 	Vector<Vector3> path;
-	path.resize(pc);
 
-	{
-		Vector3 *w = path.ptrw();
+	SearchContext *context = _acquire_context();
+	if (_solve(*context, a, b, this)) {
+		LocalVector<Point *> path_points;
+		_get_path_points(*context, a, b, path_points);
 
-		Point *p2 = end_point;
-		int idx = pc - 1;
-		while (p2 != begin_point) {
-			w[idx--] = p2->pos;
-			p2 = p2->prev_point;
+		path.resize(path_points.size());
+		Vector3 *w = path.ptrw();
+		for (uint32_t i = 0; i < path_points.size(); i++) {
+			w[i] = path_points[i]->pos;
 		}
-
-		w[0] = p2->pos; // Assign first
 	}
+	_release_context(context);
 
 	return path;
 }
 
 Vector<int> AStar::get_id_path(int p_from_id, int p_to_id) {
 
-	Point *a;
-	bool from_exists = points.lookup(p_from_id, a);
-	ERR_FAIL_COND_V(!from_exists, Vector<int>());
-
-	Point *b;
-	bool to_exists = points.lookup(p_to_id, b);
-	ERR_FAIL_COND_V(!to_exists, Vector<int>());
-
-	if (a == b) {
-		Vector<int> ret;
-		ret.push_back(a->id);
-		return ret;
-	}
-
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) return Vector<int>();
-
-	Point *p = end_point;
-	int pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
-	Vector<int> path;
-	path.resize(pc);
-
-	{
-		int *w = path.ptrw();
+	return _find_id_path(p_from_id, p_to_id, this);
+}
 
-		p = end_point;
-		int idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->id;
-			p = p->prev_point;
-		}
+Array AStar::get_id_paths(const Vector<int> &p_from_ids, const Vector<int> &p_to_ids) {
 
-		w[0] = p->id; // Assign first
-	}
-
-	return path;
+	return _find_id_paths(p_from_ids, p_to_ids, this);
 }
 
 void AStar::set_point_disabled(int p_id, bool p_disabled) {
@@ -575,6 +676,7 @@ void AStar::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStar::get_point_path);
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStar::get_id_path);
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids"), &AStar::get_id_paths);
 
 	BIND_VMETHOD(MethodInfo(Variant::FLOAT, "_estimate_cost", PropertyInfo(Variant::INT, "from_id"), PropertyInfo(Variant::INT, "to_id")));
 	BIND_VMETHOD(MethodInfo(Variant::FLOAT, "_compute_cost", PropertyInfo(Variant::INT, "from_id"), PropertyInfo(Variant::INT, "to_id")));
@@ -582,11 +684,13 @@ void AStar::_bind_methods() {
 
 AStar::AStar() {
 	last_free_id = 0;
-	pass = 1;
 }
 
 AStar::~AStar() {
 	clear();
+	for (uint32_t i = 0; i < free_contexts.size(); i++) {
+		memdelete(free_contexts[i]);
+	}
 }
 
 /////////////////////////////////////////////////////////////
@@ -725,147 +829,32 @@ Vector<Vector2> AStar2D::get_point_path(int p_from_id, int p_to_id) {
 		return ret;
 	}
 
-	AStar::Point *begin_point = a;
-	AStar::Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) return Vector<Vector2>();
-
-	AStar::Point *p = end_point;
-	int pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
 	Vector<Vector2> path;
-	path.resize(pc);
 
-	{
-		Vector2 *w = path.ptrw();
+	AStar::SearchContext *context = astar._acquire_context();
+	if (astar._solve(*context, a, b, this)) {
+		LocalVector<AStar::Point *> path_points;
+		astar._get_path_points(*context, a, b, path_points);
 
-		AStar::Point *p2 = end_point;
-		int idx = pc - 1;
-		while (p2 != begin_point) {
-			w[idx--] = Vector2(p2->pos.x, p2->pos.y);
-			p2 = p2->prev_point;
+		path.resize(path_points.size());
+		Vector2 *w = path.ptrw();
+		for (uint32_t i = 0; i < path_points.size(); i++) {
+			w[i] = Vector2(path_points[i]->pos.x, path_points[i]->pos.y);
 		}
-
-		w[0] = Vector2(p2->pos.x, p2->pos.y); // Assign first
 	}
+	astar._release_context(context);
 
 	return path;
 }
 
 Vector<int> AStar2D::get_id_path(int p_from_id, int p_to_id) {
 
-	AStar::Point *a;
-	bool from_exists = astar.points.lookup(p_from_id, a);
-	ERR_FAIL_COND_V(!from_exists, Vector<int>());
-
-	AStar::Point *b;
-	bool to_exists = astar.points.lookup(p_to_id, b);
-	ERR_FAIL_COND_V(!to_exists, Vector<int>());
-
-	if (a == b) {
-		Vector<int> ret;
-		ret.push_back(a->id);
-		return ret;
-	}
-
-	AStar::Point *begin_point = a;
-	AStar::Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) return Vector<int>();
-
-	AStar::Point *p = end_point;
-	int pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
-	Vector<int> path;
-	path.resize(pc);
-
-	{
-		int *w = path.ptrw();
-
-		p = end_point;
-		int idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->id;
-			p = p->prev_point;
-		}
-
-		w[0] = p->id; // Assign first
-	}
-
-	return path;
+	return astar._find_id_path(p_from_id, p_to_id, this);
 }
 
-bool AStar2D::_solve(AStar::Point *begin_point, AStar::Point *end_point) {
-
-	astar.pass++;
-
-	if (!end_point->enabled) return false;
-
-	bool found_route = false;
-
-	Vector<AStar::Point *> open_list;
-	SortArray<AStar::Point *, AStar::SortPoints> sorter;
-
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
-
-	while (!open_list.empty()) {
-
-		AStar::Point *p = open_list[0]; // The currently processed point
-
-		if (p == end_point) {
-			found_route = true;
-			break;
-		}
-
-		sorter.pop_heap(0, open_list.size(), open_list.ptrw()); // Remove the current point from the open list
-		open_list.remove(open_list.size() - 1);
-		p->closed_pass = astar.pass; // Mark the point as closed
-
-		for (OAHashMap<int, AStar::Point *>::Iterator it = p->neighbours.iter(); it.valid; it = p->neighbours.next_iter(it)) {
-
-			AStar::Point *e = *(it.value); // The neighbour point
-
-			if (!e->enabled || e->closed_pass == astar.pass) {
-				continue;
-			}
-
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
-
-			bool new_point = false;
-
-			if (e->open_pass != astar.pass) { // The point wasn't inside the open list.
-				e->open_pass = astar.pass;
-				open_list.push_back(e);
-				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
-				continue;
-			}
-
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptrw());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptrw());
-			}
-		}
-	}
+Array AStar2D::get_id_paths(const Vector<int> &p_from_ids, const Vector<int> &p_to_ids) {
 
-	return found_route;
+	return astar._find_id_paths(p_from_ids, p_to_ids, this);
 }
 
 void AStar2D::_bind_methods() {
@@ -898,6 +887,7 @@ void AStar2D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStar2D::get_point_path);
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStar2D::get_id_path);
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids"), &AStar2D::get_id_paths);
 
 	BIND_VMETHOD(MethodInfo(Variant::FLOAT, "_estimate_cost", PropertyInfo(Variant::INT, "from_id"), PropertyInfo(Variant::INT, "to_id")));
 	BIND_VMETHOD(MethodInfo(Variant::FLOAT, "_compute_cost", PropertyInfo(Variant::INT, "from_id"), PropertyInfo(Variant::INT, "to_id")));
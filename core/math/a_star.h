@@ -31,7 +31,9 @@
 #ifndef A_STAR_H
 #define A_STAR_H
 
+#include "core/local_vector.h"
 #include "core/oa_hash_map.h"
+#include "core/os/mutex.h"
 #include "core/reference.h"
 
 /**
@@ -52,33 +54,55 @@ class AStar : public Reference {
 				unlinked_neighbours(4u) {}
 
 		int id;
+		uint32_t index; // Position in point_list, used to index the search state.
 		Vector3 pos;
 		real_t weight_scale;
 		bool enabled;
 
 		OAHashMap<int, Point *> neighbours;
 		OAHashMap<int, Point *> unlinked_neighbours;
+	};
 
-		// Used for pathfinding.
-		Point *prev_point;
+	struct OpenPoint {
+		Point *point;
 		real_t g_score;
 		real_t f_score;
-		uint64_t open_pass;
-		uint64_t closed_pass;
 	};
 
 	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
+		_FORCE_INLINE_ bool operator()(const OpenPoint &A, const OpenPoint &B) const { // Returns true when the Point A is worse than Point B.
+			if (A.f_score > B.f_score) {
 				return true;
-			} else if (A->f_score < B->f_score) {
+			} else if (A.f_score < B.f_score) {
 				return false;
 			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+				return A.g_score < B.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 			}
 		}
 	};
 
+	// State of one search, kept apart from the points so searches can run at the same time.
+	// Entries are only valid when stamped with the current pass, so nothing is cleared between searches.
+	struct SearchContext {
+		LocalVector<real_t> g_score;
+		LocalVector<uint32_t> prev_point;
+		LocalVector<uint32_t> open_pass;
+		LocalVector<uint32_t> closed_pass;
+		LocalVector<OpenPoint> open_list;
+		uint32_t pass = 0;
+	};
+
+	template <class C>
+	struct PathBatch {
+		AStar *astar;
+		C *costs;
+		const int *from_ids;
+		const int *to_ids;
+		Vector<int> *paths;
+
+		void solve(uint32_t p_index, void *p_unused);
+	};
+
 	struct Segment {
 		union {
 			struct {
@@ -115,12 +139,24 @@ class AStar : public Reference {
 	};
 
 	int last_free_id;
-	uint64_t pass;
 
 	OAHashMap<int, Point *> points;
+	LocalVector<Point *> point_list;
 	Set<Segment> segments;
 
-	bool _solve(Point *begin_point, Point *end_point);
+	Mutex context_mutex;
+	LocalVector<SearchContext *> free_contexts;
+
+	SearchContext *_acquire_context();
+	void _release_context(SearchContext *p_context);
+
+	template <class C>
+	bool _solve(SearchContext &r_context, Point *begin_point, Point *end_point, C *p_costs);
+	template <class C>
+	Vector<int> _find_id_path(int p_from_id, int p_to_id, C *p_costs);
+	template <class C>
+	Array _find_id_paths(const Vector<int> &p_from_ids, const Vector<int> &p_to_ids, C *p_costs);
+	void _get_path_points(const SearchContext &p_context, Point *begin_point, Point *end_point, LocalVector<Point *> &r_points) const;
 
 protected:
 	static void _bind_methods();
@@ -158,6 +194,7 @@ public:
 
 	Vector<Vector3> get_point_path(int p_from_id, int p_to_id);
 	Vector<int> get_id_path(int p_from_id, int p_to_id);
+	Array get_id_paths(const Vector<int> &p_from_ids, const Vector<int> &p_to_ids);
 
 	AStar();
 	~AStar();
@@ -165,10 +202,9 @@ public:
 
 class AStar2D : public Reference {
 	GDCLASS(AStar2D, Reference);
+	friend class AStar;
 	AStar astar;
 
-	bool _solve(AStar::Point *begin_point, AStar::Point *end_point);
-
 protected:
 	static void _bind_methods();
 
@@ -205,6 +241,7 @@ public:
 
 	Vector<Vector2> get_point_path(int p_from_id, int p_to_id);
 	Vector<int> get_id_path(int p_from_id, int p_to_id);
+	Array get_id_paths(const Vector<int> &p_from_ids, const Vector<int> &p_to_ids);
 
 	AStar2D();
 	~AStar2D();
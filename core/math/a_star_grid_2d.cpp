@@ -0,0 +1,722 @@
+/*************************************************************************/
+/*  a_star_grid_2d.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "a_star_grid_2d.h"
+
+#include "core/sort_array.h"
+
+void AStarGrid2D::set_size(const Vector2i &p_size) {
+
+	ERR_FAIL_COND_MSG(p_size.x < 0 || p_size.y < 0, "Grid size can't be negative.");
+	ERR_FAIL_COND_MSG(int64_t(p_size.x) * int64_t(p_size.y) >= int64_t(UINT32_MAX), "Grid is too large.");
+	_finish_path_queries();
+
+	size = p_size;
+	uint32_t cell_count = uint32_t(size.x) * uint32_t(size.y);
+
+	// Resizing clears the grid, cells would not keep their coordinates anyway.
+	solid.resize((cell_count + 31) / 32);
+	for (uint32_t i = 0; i < solid.size(); i++) {
+		solid[i] = 0;
+	}
+	weight_scales.reset();
+}
+
+Vector2i AStarGrid2D::get_size() const {
+
+	return size;
+}
+
+void AStarGrid2D::set_offset(const Vector2 &p_offset) {
+
+	offset = p_offset;
+}
+
+Vector2 AStarGrid2D::get_offset() const {
+
+	return offset;
+}
+
+void AStarGrid2D::set_cell_size(const Vector2 &p_cell_size) {
+
+	cell_size = p_cell_size;
+}
+
+Vector2 AStarGrid2D::get_cell_size() const {
+
+	return cell_size;
+}
+
+void AStarGrid2D::set_diagonal_mode(DiagonalMode p_diagonal_mode) {
+
+	ERR_FAIL_INDEX((int)p_diagonal_mode, (int)DIAGONAL_MODE_MAX);
+	_finish_path_queries();
+	diagonal_mode = p_diagonal_mode;
+}
+
+AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
+
+	return diagonal_mode;
+}
+
+void AStarGrid2D::set_default_heuristic(Heuristic p_heuristic) {
+
+	ERR_FAIL_INDEX((int)p_heuristic, (int)HEURISTIC_MAX);
+	_finish_path_queries();
+	default_heuristic = p_heuristic;
+}
+
+AStarGrid2D::Heuristic AStarGrid2D::get_default_heuristic() const {
+
+	return default_heuristic;
+}
+
+void AStarGrid2D::set_jumping_enabled(bool p_enabled) {
+
+	_finish_path_queries();
+	jumping_enabled = p_enabled;
+}
+
+bool AStarGrid2D::is_jumping_enabled() const {
+
+	return jumping_enabled;
+}
+
+bool AStarGrid2D::is_in_bounds(int p_x, int p_y) const {
+
+	return p_x >= 0 && p_y >= 0 && p_x < size.x && p_y < size.y;
+}
+
+bool AStarGrid2D::is_in_boundsv(const Vector2i &p_id) const {
+
+	return is_in_bounds(p_id.x, p_id.y);
+}
+
+void AStarGrid2D::set_point_solid(const Vector2i &p_id, bool p_solid) {
+
+	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set if point is solid. Point out of bounds (%s/%s, %s/%s).", p_id.x, size.x, p_id.y, size.y));
+	_finish_path_queries();
+
+	uint32_t cell = _get_cell(p_id.x, p_id.y);
+	if (p_solid) {
+		solid[cell >> 5] |= 1u << (cell & 31);
+	} else {
+		solid[cell >> 5] &= ~(1u << (cell & 31));
+	}
+}
+
+bool AStarGrid2D::is_point_solid(const Vector2i &p_id) const {
+
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), false, vformat("Can't get if point is solid. Point out of bounds (%s/%s, %s/%s).", p_id.x, size.x, p_id.y, size.y));
+	return !_is_walkable(p_id.x, p_id.y);
+}
+
+void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
+
+	_finish_path_queries();
+
+	int from_x = MAX(p_region.position.x, 0);
+	int from_y = MAX(p_region.position.y, 0);
+	int to_x = MIN(p_region.position.x + p_region.size.x, size.x);
+	int to_y = MIN(p_region.position.y + p_region.size.y, size.y);
+
+	for (int y = from_y; y < to_y; y++) {
+		for (int x = from_x; x < to_x; x++) {
+			uint32_t cell = _get_cell(x, y);
+			if (p_solid) {
+				solid[cell >> 5] |= 1u << (cell & 31);
+			} else {
+				solid[cell >> 5] &= ~(1u << (cell & 31));
+			}
+		}
+	}
+}
+
+void AStarGrid2D::set_point_weight_scale(const Vector2i &p_id, real_t p_weight_scale) {
+
+	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set point's weight scale. Point out of bounds (%s/%s, %s/%s).", p_id.x, size.x, p_id.y, size.y));
+	ERR_FAIL_COND_MSG(p_weight_scale < 1, vformat("Can't set point's weight scale less than one: %f.", p_weight_scale));
+	_finish_path_queries();
+
+	if (weight_scales.empty()) {
+		if (p_weight_scale == 1) {
+			return;
+		}
+		uint32_t cell_count = uint32_t(size.x) * uint32_t(size.y);
+		weight_scales.resize(cell_count);
+		for (uint32_t i = 0; i < cell_count; i++) {
+			weight_scales[i] = 1;
+		}
+	}
+	weight_scales[_get_cell(p_id.x, p_id.y)] = p_weight_scale;
+}
+
+real_t AStarGrid2D::get_point_weight_scale(const Vector2i &p_id) const {
+
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), 0, vformat("Can't get point's weight scale. Point out of bounds (%s/%s, %s/%s).", p_id.x, size.x, p_id.y, size.y));
+	if (weight_scales.empty()) {
+		return 1;
+	}
+	return weight_scales[_get_cell(p_id.x, p_id.y)];
+}
+
+Vector2 AStarGrid2D::get_point_position(const Vector2i &p_id) const {
+
+	return offset + Vector2(p_id.x, p_id.y) * cell_size;
+}
+
+void AStarGrid2D::clear() {
+
+	set_size(Vector2i());
+
+	MutexLock lock(state_mutex);
+	for (uint32_t i = 0; i < free_states.size(); i++) {
+		memdelete(free_states[i]);
+	}
+	free_states.clear();
+}
+
+bool AStarGrid2D::_can_move(int p_x, int p_y, int p_dx, int p_dy) const {
+
+	if (!_is_walkable(p_x + p_dx, p_y + p_dy)) {
+		return false;
+	}
+	if (p_dx == 0 || p_dy == 0) {
+		return true;
+	}
+
+	switch (diagonal_mode) {
+		case DIAGONAL_MODE_ALWAYS:
+			return true;
+		case DIAGONAL_MODE_NEVER:
+			return false;
+		case DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE:
+			return _is_walkable(p_x + p_dx, p_y) || _is_walkable(p_x, p_y + p_dy);
+		default:
+			return _is_walkable(p_x + p_dx, p_y) && _is_walkable(p_x, p_y + p_dy);
+	}
+}
+
+real_t AStarGrid2D::_estimate_cost(uint32_t p_from, uint32_t p_to) const {
+
+	real_t dx = Math::abs(int(p_from % size.x) - int(p_to % size.x));
+	real_t dy = Math::abs(int(p_from / size.x) - int(p_to / size.x));
+
+	switch (default_heuristic) {
+		case HEURISTIC_MANHATTAN:
+			return dx + dy;
+		case HEURISTIC_OCTILE: {
+			const real_t F = Math_SQRT2 - 1;
+			return (dx < dy) ? F * dx + dy : F * dy + dx;
+		}
+		case HEURISTIC_CHEBYSHEV:
+			return MAX(dx, dy);
+		default:
+			return Math::sqrt(dx * dx + dy * dy);
+	}
+}
+
+// Walks from a cell in one direction until reaching a jump point: the end, or a cell
+// a shortest path may have to turn at. Returns -1 if the walk runs into an obstacle.
+// Diagonal walks look for jump points along both straight directions at every step.
+int64_t AStarGrid2D::_jump(int p_x, int p_y, int p_dx, int p_dy, uint32_t p_end) const {
+
+	int x = p_x;
+	int y = p_y;
+	int dx = p_dx;
+	int dy = p_dy;
+
+	while (true) {
+
+		if (!_can_move(x, y, dx, dy)) {
+			return -1;
+		}
+		x += dx;
+		y += dy;
+
+		uint32_t cell = _get_cell(x, y);
+		if (cell == p_end) {
+			return cell;
+		}
+
+		switch (diagonal_mode) {
+			case DIAGONAL_MODE_ALWAYS:
+			case DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE: {
+				if (dx != 0 && dy != 0) {
+					if ((_is_walkable(x - dx, y + dy) && !_is_walkable(x - dx, y)) || (_is_walkable(x + dx, y - dy) && !_is_walkable(x, y - dy))) {
+						return cell;
+					}
+					if (_jump(x, y, dx, 0, p_end) != -1 || _jump(x, y, 0, dy, p_end) != -1) {
+						return cell;
+					}
+				} else if (dx != 0) {
+					if ((_is_walkable(x + dx, y + 1) && !_is_walkable(x, y + 1)) || (_is_walkable(x + dx, y - 1) && !_is_walkable(x, y - 1))) {
+						return cell;
+					}
+				} else {
+					if ((_is_walkable(x + 1, y + dy) && !_is_walkable(x + 1, y)) || (_is_walkable(x - 1, y + dy) && !_is_walkable(x - 1, y))) {
+						return cell;
+					}
+				}
+			} break;
+			case DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES: {
+				// No corner cutting, so neighbours are forced by the obstacles behind.
+				if (dx != 0 && dy != 0) {
+					if (_jump(x, y, dx, 0, p_end) != -1 || _jump(x, y, 0, dy, p_end) != -1) {
+						return cell;
+					}
+				} else if (dx != 0) {
+					if ((_is_walkable(x, y + 1) && !_is_walkable(x - dx, y + 1)) || (_is_walkable(x, y - 1) && !_is_walkable(x - dx, y - 1))) {
+						return cell;
+					}
+				} else {
+					if ((_is_walkable(x + 1, y) && !_is_walkable(x + 1, y - dy)) || (_is_walkable(x - 1, y) && !_is_walkable(x - 1, y - dy))) {
+						return cell;
+					}
+				}
+			} break;
+			default: {
+				// Four directions, paths go vertically first so vertical walks look for horizontal turns.
+				if (dx != 0) {
+					if ((_is_walkable(x, y + 1) && !_is_walkable(x - dx, y + 1)) || (_is_walkable(x, y - 1) && !_is_walkable(x - dx, y - 1))) {
+						return cell;
+					}
+				} else {
+					if ((_is_walkable(x + 1, y) && !_is_walkable(x + 1, y - dy)) || (_is_walkable(x - 1, y) && !_is_walkable(x - 1, y - dy))) {
+						return cell;
+					}
+					if (_jump(x, y, 1, 0, p_end) != -1 || _jump(x, y, -1, 0, p_end) != -1) {
+						return cell;
+					}
+				}
+			} break;
+		}
+	}
+}
+
+AStarGrid2D::SolveState *AStarGrid2D::_acquire_state() {
+
+	SolveState *state = NULL;
+	{
+		MutexLock lock(state_mutex);
+		if (free_states.size()) {
+			state = free_states[free_states.size() - 1];
+			free_states.resize(free_states.size() - 1);
+		}
+	}
+	if (!state) {
+		state = memnew(SolveState);
+	}
+
+	uint32_t cell_count = uint32_t(size.x) * uint32_t(size.y);
+	if (state->g_score.size() != cell_count) {
+		state->g_score.resize(cell_count);
+		state->prev_cell.resize(cell_count);
+		state->open_pass.resize(cell_count);
+		state->closed_pass.resize(cell_count);
+		for (uint32_t i = 0; i < cell_count; i++) {
+			state->open_pass[i] = 0;
+			state->closed_pass[i] = 0;
+		}
+		state->pass = 0;
+	}
+	return state;
+}
+
+void AStarGrid2D::_release_state(SolveState *p_state) {
+
+	MutexLock lock(state_mutex);
+	free_states.push_back(p_state);
+}
+
+bool AStarGrid2D::_solve(SolveState *p_state, uint32_t p_from, uint32_t p_to) const {
+
+	static const int directions[8][2] = {
+		{ 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 }, // Straight first, so ties prefer them.
+		{ 1, -1 }, { 1, 1 }, { -1, 1 }, { -1, -1 },
+	};
+	int direction_count = diagonal_mode == DIAGONAL_MODE_NEVER ? 4 : 8;
+
+	SolveState &s = *p_state;
+	s.pass++;
+	if (s.pass == 0) { // Wrapped around, old marks would look current.
+		for (uint32_t i = 0; i < s.open_pass.size(); i++) {
+			s.open_pass[i] = 0;
+			s.closed_pass[i] = 0;
+		}
+		s.pass = 1;
+	}
+	uint32_t pass = s.pass;
+
+	int to_x = p_to % size.x;
+	int to_y = p_to / size.x;
+	if (!_is_walkable(to_x, to_y)) {
+		return false;
+	}
+
+	SortArray<OpenCell, SortOpenCells> sorter;
+	s.open_list.clear();
+
+	s.g_score[p_from] = 0;
+	s.prev_cell[p_from] = p_from;
+	s.open_pass[p_from] = pass;
+	OpenCell begin;
+	begin.f_score = _estimate_cost(p_from, p_to);
+	begin.g_score = 0;
+	begin.cell = p_from;
+	s.open_list.push_back(begin);
+
+	while (s.open_list.size()) {
+
+		OpenCell current = s.open_list[0];
+		sorter.pop_heap(0, s.open_list.size(), s.open_list.ptr());
+		s.open_list.resize(s.open_list.size() - 1);
+
+		// Cells are pushed again when a better path reaches them, the older entries are skipped.
+		if (s.closed_pass[current.cell] == pass) {
+			continue;
+		}
+		if (current.cell == p_to) {
+			return true;
+		}
+		s.closed_pass[current.cell] = pass;
+
+		int x = current.cell % size.x;
+		int y = current.cell / size.x;
+
+		for (int i = 0; i < direction_count; i++) {
+
+			int dx = directions[i][0];
+			int dy = directions[i][1];
+
+			int64_t next;
+			real_t cost;
+			if (jumping_enabled) {
+				next = _jump(x, y, dx, dy, p_to);
+				if (next == -1) {
+					continue;
+				}
+				// Jumps are straight or diagonal lines, weights don't apply.
+				int jx = Math::abs(int(next % size.x) - x);
+				int jy = Math::abs(int(next / size.x) - y);
+				cost = MIN(jx, jy) * Math_SQRT2 + Math::abs(jx - jy);
+			} else {
+				if (!_can_move(x, y, dx, dy)) {
+					continue;
+				}
+				next = _get_cell(x + dx, y + dy);
+				cost = (dx != 0 && dy != 0) ? Math_SQRT2 : 1;
+				if (weight_scales.size()) {
+					cost *= weight_scales[next];
+				}
+			}
+
+			if (s.closed_pass[next] == pass) {
+				continue;
+			}
+
+			real_t g_score = current.g_score + cost;
+			if (s.open_pass[next] == pass && g_score >= s.g_score[next]) {
+				continue; // The new path is worse than the previous.
+			}
+
+			s.open_pass[next] = pass;
+			s.g_score[next] = g_score;
+			s.prev_cell[next] = current.cell;
+
+			OpenCell open;
+			open.f_score = g_score + _estimate_cost(next, p_to);
+			open.g_score = g_score;
+			open.cell = next;
+			s.open_list.push_back(open);
+			sorter.push_heap(0, s.open_list.size() - 1, 0, open, s.open_list.ptr());
+		}
+	}
+
+	return false;
+}
+
+void AStarGrid2D::_get_path_cells(const SolveState *p_state, uint32_t p_from, uint32_t p_to, LocalVector<uint32_t> &r_cells) const {
+
+	// Walked back from the end, every step goes in a straight or diagonal line to the previous cell.
+	uint32_t cell = p_to;
+	r_cells.push_back(cell);
+	while (cell != p_from) {
+		uint32_t prev = p_state->prev_cell[cell];
+		int x = cell % size.x;
+		int y = cell / size.x;
+		int px = prev % size.x;
+		int py = prev / size.x;
+		int dx = SGN(px - x);
+		int dy = SGN(py - y);
+		while (x != px || y != py) {
+			x += dx;
+			y += dy;
+			r_cells.push_back(_get_cell(x, y));
+		}
+		cell = prev;
+	}
+
+	// Reverse, so the path starts at p_from.
+	uint32_t count = r_cells.size();
+	for (uint32_t i = 0; i < count / 2; i++) {
+		SWAP(r_cells[i], r_cells[count - i - 1]);
+	}
+}
+
+Vector<Vector2> AStarGrid2D::_find_point_path(uint32_t p_from, uint32_t p_to) {
+
+	Vector<Vector2> path;
+
+	SolveState *state = _acquire_state();
+	if (_solve(state, p_from, p_to)) {
+		LocalVector<uint32_t> cells;
+		_get_path_cells(state, p_from, p_to, cells);
+
+		path.resize(cells.size());
+		Vector2 *w = path.ptrw();
+		for (uint32_t i = 0; i < cells.size(); i++) {
+			w[i] = offset + Vector2(cells[i] % size.x, cells[i] / size.x) * cell_size;
+		}
+	}
+	_release_state(state);
+
+	return path;
+}
+
+Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vector2i &p_to_id) {
+
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), Vector<Vector2>(), vformat("Can't get path. Point out of bounds (%s/%s, %s/%s).", p_from_id.x, size.x, p_from_id.y, size.y));
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), Vector<Vector2>(), vformat("Can't get path. Point out of bounds (%s/%s, %s/%s).", p_to_id.x, size.x, p_to_id.y, size.y));
+
+	return _find_point_path(_get_cell(p_from_id.x, p_from_id.y), _get_cell(p_to_id.x, p_to_id.y));
+}
+
+Array AStarGrid2D::get_id_path(const Vector2i &p_from_id, const Vector2i &p_to_id) {
+
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), Array(), vformat("Can't get id path. Point out of bounds (%s/%s, %s/%s).", p_from_id.x, size.x, p_from_id.y, size.y));
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), Array(), vformat("Can't get id path. Point out of bounds (%s/%s, %s/%s).", p_to_id.x, size.x, p_to_id.y, size.y));
+
+	Array path;
+	uint32_t from = _get_cell(p_from_id.x, p_from_id.y);
+	uint32_t to = _get_cell(p_to_id.x, p_to_id.y);
+
+	SolveState *state = _acquire_state();
+	if (_solve(state, from, to)) {
+		LocalVector<uint32_t> cells;
+		_get_path_cells(state, from, to, cells);
+
+		path.resize(cells.size());
+		for (uint32_t i = 0; i < cells.size(); i++) {
+			path[i] = Vector2i(cells[i] % size.x, cells[i] / size.x);
+		}
+	}
+	_release_state(state);
+
+	return path;
+}
+
+void AStarGrid2D::_run_batch_query(uint32_t p_index, LocalVector<PathQuery> *p_queries) {
+
+	PathQuery &query = (*p_queries)[p_index];
+	query.path = _find_point_path(query.from, query.to);
+}
+
+Array AStarGrid2D::get_point_paths(const Array &p_from_ids, const Array &p_to_ids) {
+
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), Array(), "Both arrays of points must have the same size.");
+
+	LocalVector<PathQuery> queries;
+	queries.resize(p_from_ids.size());
+	for (int i = 0; i < p_from_ids.size(); i++) {
+		Vector2i from = p_from_ids[i];
+		Vector2i to = p_to_ids[i];
+		ERR_FAIL_COND_V_MSG(!is_in_boundsv(from) || !is_in_boundsv(to), Array(), vformat("Can't get paths. Points of query %d out of bounds.", i));
+		queries[i].from = _get_cell(from.x, from.y);
+		queries[i].to = _get_cell(to.x, to.y);
+	}
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0 && queries.size() > 1) {
+		pool->do_work(queries.size(), this, &AStarGrid2D::_run_batch_query, &queries);
+	} else {
+		for (uint32_t i = 0; i < queries.size(); i++) {
+			_run_batch_query(i, &queries);
+		}
+	}
+
+	Array paths;
+	paths.resize(queries.size());
+	for (uint32_t i = 0; i < queries.size(); i++) {
+		paths[i] = queries[i].path;
+	}
+	return paths;
+}
+
+void AStarGrid2D::_run_path_query(PathQuery *p_query) {
+
+	p_query->path = _find_point_path(p_query->from, p_query->to);
+}
+
+// The grid can't change under a running search, so anything modifying it waits for them first.
+void AStarGrid2D::_finish_path_queries() {
+
+	MutexLock lock(query_mutex);
+	for (Map<int64_t, PathQuery *>::Element *E = path_queries.front(); E; E = E->next()) {
+		PathQuery *query = E->get();
+		if (query->task != ThreadWorkPool::INVALID_TASK_ID) {
+			ThreadWorkPool::get_singleton()->wait_for_task(query->task);
+			query->task = ThreadWorkPool::INVALID_TASK_ID;
+		}
+	}
+}
+
+int64_t AStarGrid2D::get_point_path_async(const Vector2i &p_from_id, const Vector2i &p_to_id) {
+
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), -1, vformat("Can't get path. Point out of bounds (%s/%s, %s/%s).", p_from_id.x, size.x, p_from_id.y, size.y));
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), -1, vformat("Can't get path. Point out of bounds (%s/%s, %s/%s).", p_to_id.x, size.x, p_to_id.y, size.y));
+
+	PathQuery *query = memnew(PathQuery);
+	query->from = _get_cell(p_from_id.x, p_from_id.y);
+	query->to = _get_cell(p_to_id.x, p_to_id.y);
+
+	MutexLock lock(query_mutex);
+	int64_t id = ++last_query_id;
+	path_queries[id] = query;
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0) {
+		query->task = pool->add_task(this, &AStarGrid2D::_run_path_query, query);
+	} else {
+		_run_path_query(query); // No threads, the result is ready right away.
+	}
+	return id;
+}
+
+bool AStarGrid2D::is_path_query_done(int64_t p_query) const {
+
+	AStarGrid2D *mut_this = const_cast<AStarGrid2D *>(this);
+	MutexLock lock(mut_this->query_mutex);
+
+	const Map<int64_t, PathQuery *>::Element *E = path_queries.find(p_query);
+	ERR_FAIL_COND_V_MSG(!E, false, "Invalid path query: " + itos(p_query) + ".");
+	return E->get()->task == ThreadWorkPool::INVALID_TASK_ID || ThreadWorkPool::get_singleton()->is_task_completed(E->get()->task);
+}
+
+Vector<Vector2> AStarGrid2D::get_path_query_result(int64_t p_query) {
+
+	MutexLock lock(query_mutex);
+
+	Map<int64_t, PathQuery *>::Element *E = path_queries.find(p_query);
+	ERR_FAIL_COND_V_MSG(!E, Vector<Vector2>(), "Invalid path query: " + itos(p_query) + ".");
+
+	PathQuery *query = E->get();
+	if (query->task != ThreadWorkPool::INVALID_TASK_ID) {
+		ThreadWorkPool::get_singleton()->wait_for_task(query->task);
+	}
+	Vector<Vector2> path = query->path;
+
+	memdelete(query);
+	path_queries.erase(E);
+	return path;
+}
+
+void AStarGrid2D::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("set_size", "size"), &AStarGrid2D::set_size);
+	ClassDB::bind_method(D_METHOD("get_size"), &AStarGrid2D::get_size);
+	ClassDB::bind_method(D_METHOD("set_offset", "offset"), &AStarGrid2D::set_offset);
+	ClassDB::bind_method(D_METHOD("get_offset"), &AStarGrid2D::get_offset);
+	ClassDB::bind_method(D_METHOD("set_cell_size", "cell_size"), &AStarGrid2D::set_cell_size);
+	ClassDB::bind_method(D_METHOD("get_cell_size"), &AStarGrid2D::get_cell_size);
+	ClassDB::bind_method(D_METHOD("set_diagonal_mode", "mode"), &AStarGrid2D::set_diagonal_mode);
+	ClassDB::bind_method(D_METHOD("get_diagonal_mode"), &AStarGrid2D::get_diagonal_mode);
+	ClassDB::bind_method(D_METHOD("set_default_heuristic", "heuristic"), &AStarGrid2D::set_default_heuristic);
+	ClassDB::bind_method(D_METHOD("get_default_heuristic"), &AStarGrid2D::get_default_heuristic);
+	ClassDB::bind_method(D_METHOD("set_jumping_enabled", "enabled"), &AStarGrid2D::set_jumping_enabled);
+	ClassDB::bind_method(D_METHOD("is_jumping_enabled"), &AStarGrid2D::is_jumping_enabled);
+
+	ClassDB::bind_method(D_METHOD("is_in_bounds", "x", "y"), &AStarGrid2D::is_in_bounds);
+	ClassDB::bind_method(D_METHOD("is_in_boundsv", "id"), &AStarGrid2D::is_in_boundsv);
+	ClassDB::bind_method(D_METHOD("set_point_solid", "id", "solid"), &AStarGrid2D::set_point_solid, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("is_point_solid", "id"), &AStarGrid2D::is_point_solid);
+	ClassDB::bind_method(D_METHOD("fill_solid_region", "region", "solid"), &AStarGrid2D::fill_solid_region, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("set_point_weight_scale", "id", "weight_scale"), &AStarGrid2D::set_point_weight_scale);
+	ClassDB::bind_method(D_METHOD("get_point_weight_scale", "id"), &AStarGrid2D::get_point_weight_scale);
+	ClassDB::bind_method(D_METHOD("get_point_position", "id"), &AStarGrid2D::get_point_position);
+	ClassDB::bind_method(D_METHOD("clear"), &AStarGrid2D::clear);
+
+	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStarGrid2D::get_point_path);
+	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStarGrid2D::get_id_path);
+	ClassDB::bind_method(D_METHOD("get_point_paths", "from_ids", "to_ids"), &AStarGrid2D::get_point_paths);
+
+	ClassDB::bind_method(D_METHOD("get_point_path_async", "from_id", "to_id"), &AStarGrid2D::get_point_path_async);
+	ClassDB::bind_method(D_METHOD("is_path_query_done", "query"), &AStarGrid2D::is_path_query_done);
+	ClassDB::bind_method(D_METHOD("get_path_query_result", "query"), &AStarGrid2D::get_path_query_result);
+
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2I, "size"), "set_size", "get_size");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "offset"), "set_offset", "get_offset");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "cell_size"), "set_cell_size", "get_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "diagonal_mode", PROPERTY_HINT_ENUM, "Always,Never,At Least One Walkable,Only If No Obstacles"), "set_diagonal_mode", "get_diagonal_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "default_heuristic", PROPERTY_HINT_ENUM, "Euclidean,Manhattan,Octile,Chebyshev"), "set_default_heuristic", "get_default_heuristic");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "jumping_enabled"), "set_jumping_enabled", "is_jumping_enabled");
+
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_ALWAYS);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_NEVER);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_MAX);
+
+	BIND_ENUM_CONSTANT(HEURISTIC_EUCLIDEAN);
+	BIND_ENUM_CONSTANT(HEURISTIC_MANHATTAN);
+	BIND_ENUM_CONSTANT(HEURISTIC_OCTILE);
+	BIND_ENUM_CONSTANT(HEURISTIC_CHEBYSHEV);
+	BIND_ENUM_CONSTANT(HEURISTIC_MAX);
+}
+
+AStarGrid2D::AStarGrid2D() {
+
+	cell_size = Vector2(1, 1);
+	diagonal_mode = DIAGONAL_MODE_ALWAYS;
+	default_heuristic = HEURISTIC_EUCLIDEAN;
+	jumping_enabled = false;
+	last_query_id = 0;
+}
+
+AStarGrid2D::~AStarGrid2D() {
+
+	_finish_path_queries();
+	for (Map<int64_t, PathQuery *>::Element *E = path_queries.front(); E; E = E->next()) {
+		memdelete(E->get());
+	}
+	for (uint32_t i = 0; i < free_states.size(); i++) {
+		memdelete(free_states[i]);
+	}
+}
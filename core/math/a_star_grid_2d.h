@@ -0,0 +1,195 @@
+/*************************************************************************/
+/*  a_star_grid_2d.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef A_STAR_GRID_2D_H
+#define A_STAR_GRID_2D_H
+
+#include "core/local_vector.h"
+#include "core/map.h"
+#include "core/os/mutex.h"
+#include "core/reference.h"
+#include "core/thread_work_pool.h"
+
+/**
+	A* pathfinding on a dense grid of cells.
+
+	Unlike AStar, cells are not objects: solidity is one bit per cell and the
+	per-query scores live in flat arrays indexed by cell, so large tile maps take
+	a few bytes per cell and no graph has to be built.
+*/
+
+class AStarGrid2D : public Reference {
+
+	GDCLASS(AStarGrid2D, Reference);
+
+public:
+	enum DiagonalMode {
+		DIAGONAL_MODE_ALWAYS,
+		DIAGONAL_MODE_NEVER,
+		DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE,
+		DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES,
+		DIAGONAL_MODE_MAX,
+	};
+
+	enum Heuristic {
+		HEURISTIC_EUCLIDEAN,
+		HEURISTIC_MANHATTAN,
+		HEURISTIC_OCTILE,
+		HEURISTIC_CHEBYSHEV,
+		HEURISTIC_MAX,
+	};
+
+private:
+	Vector2i size;
+	Vector2 offset;
+	Vector2 cell_size;
+	DiagonalMode diagonal_mode;
+	Heuristic default_heuristic;
+	bool jumping_enabled;
+
+	LocalVector<uint32_t> solid; // One bit per cell.
+	LocalVector<real_t> weight_scales; // Empty while every cell weighs 1.
+
+	struct OpenCell {
+		real_t f_score;
+		real_t g_score;
+		uint32_t cell;
+	};
+
+	struct SortOpenCells {
+		_FORCE_INLINE_ bool operator()(const OpenCell &A, const OpenCell &B) const { // Returns true when A is worse than B.
+			if (A.f_score > B.f_score) {
+				return true;
+			} else if (A.f_score < B.f_score) {
+				return false;
+			} else {
+				return A.g_score < B.g_score;
+			}
+		}
+	};
+
+	// Scratch memory of a search, one per search running at the same time.
+	struct SolveState {
+		LocalVector<real_t> g_score;
+		LocalVector<uint32_t> prev_cell;
+		LocalVector<uint32_t> open_pass;
+		LocalVector<uint32_t> closed_pass;
+		LocalVector<OpenCell> open_list;
+		uint32_t pass = 0;
+	};
+
+	Mutex state_mutex;
+	LocalVector<SolveState *> free_states;
+
+	struct PathQuery {
+		uint32_t from = 0;
+		uint32_t to = 0;
+		Vector<Vector2> path;
+		ThreadWorkPool::TaskID task = ThreadWorkPool::INVALID_TASK_ID;
+	};
+
+	Mutex query_mutex;
+	int64_t last_query_id;
+	Map<int64_t, PathQuery *> path_queries;
+
+	_FORCE_INLINE_ uint32_t _get_cell(int p_x, int p_y) const { return uint32_t(p_y) * uint32_t(size.x) + uint32_t(p_x); }
+	_FORCE_INLINE_ bool _is_walkable(int p_x, int p_y) const {
+		if (p_x < 0 || p_y < 0 || p_x >= size.x || p_y >= size.y) {
+			return false;
+		}
+		uint32_t cell = _get_cell(p_x, p_y);
+		return !(solid[cell >> 5] & (1u << (cell & 31)));
+	}
+	_FORCE_INLINE_ bool _can_move(int p_x, int p_y, int p_dx, int p_dy) const;
+
+	real_t _estimate_cost(uint32_t p_from, uint32_t p_to) const;
+	int64_t _jump(int p_x, int p_y, int p_dx, int p_dy, uint32_t p_end) const;
+
+	SolveState *_acquire_state();
+	void _release_state(SolveState *p_state);
+	bool _solve(SolveState *p_state, uint32_t p_from, uint32_t p_to) const;
+	void _get_path_cells(const SolveState *p_state, uint32_t p_from, uint32_t p_to, LocalVector<uint32_t> &r_cells) const;
+	Vector<Vector2> _find_point_path(uint32_t p_from, uint32_t p_to);
+
+	void _run_path_query(PathQuery *p_query);
+	void _run_batch_query(uint32_t p_index, LocalVector<PathQuery> *p_queries);
+	void _finish_path_queries();
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_size(const Vector2i &p_size);
+	Vector2i get_size() const;
+
+	void set_offset(const Vector2 &p_offset);
+	Vector2 get_offset() const;
+
+	void set_cell_size(const Vector2 &p_cell_size);
+	Vector2 get_cell_size() const;
+
+	void set_diagonal_mode(DiagonalMode p_diagonal_mode);
+	DiagonalMode get_diagonal_mode() const;
+
+	void set_default_heuristic(Heuristic p_heuristic);
+	Heuristic get_default_heuristic() const;
+
+	void set_jumping_enabled(bool p_enabled);
+	bool is_jumping_enabled() const;
+
+	bool is_in_bounds(int p_x, int p_y) const;
+	bool is_in_boundsv(const Vector2i &p_id) const;
+
+	void set_point_solid(const Vector2i &p_id, bool p_solid = true);
+	bool is_point_solid(const Vector2i &p_id) const;
+	void fill_solid_region(const Rect2i &p_region, bool p_solid = true);
+
+	void set_point_weight_scale(const Vector2i &p_id, real_t p_weight_scale);
+	real_t get_point_weight_scale(const Vector2i &p_id) const;
+
+	Vector2 get_point_position(const Vector2i &p_id) const;
+	void clear();
+
+	Vector<Vector2> get_point_path(const Vector2i &p_from_id, const Vector2i &p_to_id);
+	Array get_id_path(const Vector2i &p_from_id, const Vector2i &p_to_id);
+	Array get_point_paths(const Array &p_from_ids, const Array &p_to_ids);
+
+	int64_t get_point_path_async(const Vector2i &p_from_id, const Vector2i &p_to_id);
+	bool is_path_query_done(int64_t p_query) const;
+	Vector<Vector2> get_path_query_result(int64_t p_query);
+
+	AStarGrid2D();
+	~AStarGrid2D();
+};
+
+VARIANT_ENUM_CAST(AStarGrid2D::DiagonalMode);
+VARIANT_ENUM_CAST(AStarGrid2D::Heuristic);
+
+#endif // A_STAR_GRID_2D_H
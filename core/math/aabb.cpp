@@ -396,6 +396,31 @@ void AABB::get_edge(int p_edge, Vector3 &r_from, Vector3 &r_to) const {
 	}
 }
 
+void AABB::create_from_points(const Vector3 *p_points, int p_count) {
+
+	if (p_count <= 0) {
+		position = Vector3();
+		size = Vector3();
+		return;
+	}
+
+	Vector3 min = p_points[0];
+	Vector3 max = p_points[0];
+
+	for (int i = 1; i < p_count; i++) {
+		const Vector3 &v = p_points[i];
+		min.x = MIN(min.x, v.x);
+		min.y = MIN(min.y, v.y);
+		min.z = MIN(min.z, v.z);
+		max.x = MAX(max.x, v.x);
+		max.y = MAX(max.y, v.y);
+		max.z = MAX(max.z, v.z);
+	}
+
+	position = min;
+	size = max - min;
+}
+
 AABB::operator String() const {
 
 	return String() + position + " - " + size;
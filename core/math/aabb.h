@@ -100,6 +100,7 @@ public:
 	AABB expand(const Vector3 &p_vector) const;
 	_FORCE_INLINE_ void project_range_in_plane(const Plane &p_plane, real_t &r_min, real_t &r_max) const;
 	_FORCE_INLINE_ void expand_to(const Vector3 &p_vector); /** expand to contain a point if necessary */
+	void create_from_points(const Vector3 *p_points, int p_count); /** smallest AABB containing all the points */
 
 	operator String() const;
 
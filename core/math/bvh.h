@@ -0,0 +1,969 @@
+/*************************************************************************/
+/*  bvh.h                                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef BVH_H
+#define BVH_H
+
+#include "core/hash_map.h"
+#include "core/math/aabb.h"
+#include "core/math/plane.h"
+#include "core/vector.h"
+
+typedef uint32_t BVHElementID;
+
+#define BVH_ELEMENT_INVALID_ID 0
+
+/**
+ * Dynamic AABB tree with the same interface as Octree.
+ *
+ * Leaves are inserted incrementally, picking the sibling with the lowest
+ * surface area cost, and ancestors are refit and rebalanced on the way up.
+ *
+ * Elements start in a static tree that stores exact bounds and never changes
+ * unless they are removed. The first move() migrates an element to a dynamic
+ * tree whose leaves are expanded by a margin, so small movements only update
+ * the element bounds. Pairable and non-pairable elements are kept in separate
+ * trees so that pairing a non-pairable element only visits pairable ones.
+ */
+template <class T, bool use_pairs = false>
+class BVH {
+public:
+	typedef void *(*PairCallback)(void *, BVHElementID, T *, int, BVHElementID, T *, int);
+	typedef void (*UnpairCallback)(void *, BVHElementID, T *, int, BVHElementID, T *, int, void *);
+
+private:
+	enum {
+		INVALID_INDEX = 0xFFFFFFFF,
+		TREE_FLAG_DYNAMIC = 1,
+		TREE_FLAG_PAIRABLE = 2,
+		TREE_MAX = 4,
+		STACK_MAX = 128 // trees are balanced, so this is plenty
+	};
+
+	struct Node {
+
+		AABB aabb;
+		uint32_t parent; // next free node when in the free list
+		uint32_t children[2];
+		uint32_t element; // INVALID_INDEX for internal nodes
+		int height; // 0 for leaves
+
+		_FORCE_INLINE_ bool is_leaf() const { return children[0] == INVALID_INDEX; }
+	};
+
+	struct Tree {
+
+		Vector<Node> nodes;
+		uint32_t root;
+		uint32_t free_list;
+		uint32_t leaf_count;
+
+		Tree() {
+			root = INVALID_INDEX;
+			free_list = INVALID_INDEX;
+			leaf_count = 0;
+		}
+	};
+
+	struct Element {
+
+		T *userdata;
+		int subindex;
+		bool pairable;
+		bool dynamic;
+		bool used;
+		uint32_t pairable_type;
+		uint32_t pairable_mask;
+
+		AABB aabb;
+		int tree; // -1 when not inserted (no surface)
+		uint32_t leaf;
+
+		Vector<uint32_t> pairs;
+
+		Element() {
+			userdata = NULL;
+			subindex = 0;
+			pairable = false;
+			dynamic = false;
+			used = false;
+			pairable_type = 0;
+			pairable_mask = 0;
+			tree = -1;
+			leaf = INVALID_INDEX;
+		}
+	};
+
+	struct PairData {
+
+		BVHElementID A;
+		BVHElementID B;
+		void *ud;
+		uint32_t index_A; // position in the pair list of A
+		uint32_t index_B;
+	};
+
+	Tree trees[TREE_MAX];
+
+	Vector<Element> elements;
+	Vector<uint32_t> free_elements;
+
+	Vector<PairData> pairs;
+	Vector<uint32_t> free_pairs;
+	HashMap<uint64_t, uint32_t> pair_map;
+	int pair_count;
+
+	PairCallback pair_callback;
+	UnpairCallback unpair_callback;
+	void *pair_callback_userdata;
+	void *unpair_callback_userdata;
+
+	real_t node_expansion;
+
+	static _FORCE_INLINE_ real_t _get_cost(const AABB &p_aabb) {
+		// half the surface area, only used for comparisons
+		const Vector3 &s = p_aabb.size;
+		return s.x * s.y + s.y * s.z + s.z * s.x;
+	}
+
+	static _FORCE_INLINE_ uint64_t _get_pair_key(BVHElementID p_A, BVHElementID p_B) {
+		if (p_A > p_B) {
+			SWAP(p_A, p_B);
+		}
+		return (uint64_t(p_A) << 32) | uint64_t(p_B);
+	}
+
+	_FORCE_INLINE_ Element &_get_element(BVHElementID p_id) { return elements.write[p_id - 1]; }
+	_FORCE_INLINE_ const Element &_get_element(BVHElementID p_id) const { return elements[p_id - 1]; }
+	_FORCE_INLINE_ bool _is_valid_id(BVHElementID p_id) const { return p_id != BVH_ELEMENT_INVALID_ID && p_id <= (uint32_t)elements.size() && elements[p_id - 1].used; }
+
+	_FORCE_INLINE_ int _get_tree_index(const Element &p_element) const {
+		return (p_element.dynamic ? int(TREE_FLAG_DYNAMIC) : 0) | ((use_pairs && p_element.pairable) ? int(TREE_FLAG_PAIRABLE) : 0);
+	}
+
+	uint32_t _node_alloc(Tree &p_tree);
+	void _node_free(Tree &p_tree, uint32_t p_node);
+	uint32_t _balance(Tree &p_tree, uint32_t p_node);
+	void _insert_leaf(Tree &p_tree, uint32_t p_leaf);
+	void _remove_leaf(Tree &p_tree, uint32_t p_leaf);
+
+	void _element_insert(BVHElementID p_id);
+	void _element_remove(BVHElementID p_id);
+
+	_FORCE_INLINE_ bool _can_pair(const Element &p_A, const Element &p_B) const {
+
+		if (&p_A == &p_B || (p_A.userdata == p_B.userdata && p_A.userdata))
+			return false;
+		if (!p_A.pairable && !p_B.pairable)
+			return false;
+		if (!(p_A.pairable_type & p_B.pairable_mask) && !(p_B.pairable_type & p_A.pairable_mask))
+			return false; // none can pair with none
+		return true;
+	}
+
+	void _pair_add(BVHElementID p_A, BVHElementID p_B);
+	void _pair_remove(uint32_t p_pair);
+	void _element_check_pairs(BVHElementID p_id);
+	void _element_clear_pairs(BVHElementID p_id);
+
+	enum CullResult {
+		CULL_OUTSIDE,
+		CULL_INTERSECT,
+		CULL_INSIDE,
+	};
+
+	struct _CullConvex {
+		const Plane *planes;
+		int plane_count;
+		_FORCE_INLINE_ CullResult test(const AABB &p_aabb) const {
+			if (!p_aabb.intersects_convex_shape(planes, plane_count))
+				return CULL_OUTSIDE;
+			return p_aabb.inside_convex_shape(planes, plane_count) ? CULL_INSIDE : CULL_INTERSECT;
+		}
+	};
+
+	struct _CullAABB {
+		AABB aabb;
+		_FORCE_INLINE_ CullResult test(const AABB &p_aabb) const {
+			if (!p_aabb.intersects_inclusive(aabb))
+				return CULL_OUTSIDE;
+			return aabb.encloses(p_aabb) ? CULL_INSIDE : CULL_INTERSECT;
+		}
+	};
+
+	struct _CullSegment {
+		Vector3 from;
+		Vector3 to;
+		_FORCE_INLINE_ CullResult test(const AABB &p_aabb) const {
+			return p_aabb.intersects_segment(from, to) ? CULL_INTERSECT : CULL_OUTSIDE;
+		}
+	};
+
+	struct _CullPoint {
+		Vector3 point;
+		_FORCE_INLINE_ CullResult test(const AABB &p_aabb) const {
+			return p_aabb.has_point(point) ? CULL_INTERSECT : CULL_OUTSIDE;
+		}
+	};
+
+	template <class C>
+	int _cull(const C &p_test, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) const;
+
+public:
+	BVHElementID create(T *p_userdata, const AABB &p_aabb = AABB(), int p_subindex = 0, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t pairable_mask = 1);
+	void move(BVHElementID p_id, const AABB &p_aabb);
+	void set_pairable(BVHElementID p_id, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t pairable_mask = 1);
+	void erase(BVHElementID p_id);
+
+	bool is_pairable(BVHElementID p_id) const;
+	T *get(BVHElementID p_id) const;
+	int get_subindex(BVHElementID p_id) const;
+
+	int cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF);
+	int cull_aabb(const AABB &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+	int cull_segment(const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+	int cull_point(const Vector3 &p_point, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
+
+	void set_pair_callback(PairCallback p_callback, void *p_userdata);
+	void set_unpair_callback(UnpairCallback p_callback, void *p_userdata);
+
+	// margin added around elements in the dynamic trees, only affects elements inserted afterwards
+	void set_node_expansion(real_t p_expansion) { node_expansion = MAX(p_expansion, 0.0); }
+	real_t get_node_expansion() const { return node_expansion; }
+
+	int get_pair_count() const { return pair_count; }
+	int get_element_count() const { return elements.size() - free_elements.size(); }
+
+	BVH();
+};
+
+/* TREE */
+
+template <class T, bool use_pairs>
+uint32_t BVH<T, use_pairs>::_node_alloc(Tree &p_tree) {
+
+	uint32_t index;
+	if (p_tree.free_list != INVALID_INDEX) {
+		index = p_tree.free_list;
+		p_tree.free_list = p_tree.nodes[index].parent;
+	} else {
+		index = p_tree.nodes.size();
+		p_tree.nodes.push_back(Node());
+	}
+
+	Node &n = p_tree.nodes.write[index];
+	n.parent = INVALID_INDEX;
+	n.children[0] = INVALID_INDEX;
+	n.children[1] = INVALID_INDEX;
+	n.element = INVALID_INDEX;
+	n.height = 0;
+	return index;
+}
+
+template <class T, bool use_pairs>
+void BVH<T, use_pairs>::_node_free(Tree &p_tree, uint32_t p_node) {
+
+	Node &n = p_tree.nodes.write[p_node];
+	n.parent = p_tree.free_list;
+	n.height = -1;
+	p_tree.free_list = p_node;
+}
+
+// Performs a left or right rotation if p_node is imbalanced, returns the new subtree root.
+template <class T, bool use_pairs>
+uint32_t BVH<T, use_pairs>::_balance(Tree &p_tree, uint32_t p_node) {
+
+	Node *nodes = p_tree.nodes.ptrw();
+	Node &A = nodes[p_node];
+
+	if (A.is_leaf() || A.height < 2)
+		return p_node;
+
+	uint32_t iB = A.children[0];
+	uint32_t iC = A.children[1];
+	Node &B = nodes[iB];
+	Node &C = nodes[iC];
+
+	int balance = C.height - B.height;
+
+	if (balance > 1) {
+		// rotate C up
+		uint32_t iF = C.children[0];
+		uint32_t iG = C.children[1];
+		Node &F = nodes[iF];
+		Node &G = nodes[iG];
+
+		C.children[0] = p_node;
+		C.parent = A.parent;
+		A.parent = iC;
+
+		if (C.parent != INVALID_INDEX) {
+			Node &P = nodes[C.parent];
+			P.children[P.children[0] == p_node ? 0 : 1] = iC;
+		} else {
+			p_tree.root = iC;
+		}
+
+		if (F.height > G.height) {
+			C.children[1] = iF;
+			A.children[1] = iG;
+			G.parent = p_node;
+			A.aabb = B.aabb.merge(G.aabb);
+			C.aabb = A.aabb.merge(F.aabb);
+			A.height = 1 + MAX(B.height, G.height);
+			C.height = 1 + MAX(A.height, F.height);
+		} else {
+			C.children[1] = iG;
+			A.children[1] = iF;
+			F.parent = p_node;
+			A.aabb = B.aabb.merge(F.aabb);
+			C.aabb = A.aabb.merge(G.aabb);
+			A.height = 1 + MAX(B.height, F.height);
+			C.height = 1 + MAX(A.height, G.height);
+		}
+
+		return iC;
+	}
+
+	if (balance < -1) {
+		// rotate B up
+		uint32_t iD = B.children[0];
+		uint32_t iE = B.children[1];
+		Node &D = nodes[iD];
+		Node &E = nodes[iE];
+
+		B.children[0] = p_node;
+		B.parent = A.parent;
+		A.parent = iB;
+
+		if (B.parent != INVALID_INDEX) {
+			Node &P = nodes[B.parent];
+			P.children[P.children[0] == p_node ? 0 : 1] = iB;
+		} else {
+			p_tree.root = iB;
+		}
+
+		if (D.height > E.height) {
+			B.children[1] = iD;
+			A.children[0] = iE;
+			E.parent = p_node;
+			A.aabb = C.aabb.merge(E.aabb);
+			B.aabb = A.aabb.merge(D.aabb);
+			A.height = 1 + MAX(C.height, E.height);
+			B.height = 1 + MAX(A.height, D.height);
+		} else {
+			B.children[1] = iE;
+			A.children[0] = iD;
+			D.parent = p_node;
+			A.aabb = C.aabb.merge(D.aabb);
+			B.aabb = A.aabb.merge(E.aabb);
+			A.height = 1 + MAX(C.height, D.height);
+			B.height = 1 + MAX(A.height, E.height);
+		}
+
+		return iB;
+	}
+
+	return p_node;
+}
+
+template <class T, bool use_pairs>
+void BVH<T, use_pairs>::_insert_leaf(Tree &p_tree, uint32_t p_leaf) {
+
+	p_tree.leaf_count++;
+
+	if (p_tree.root == INVALID_INDEX) {
+		p_tree.root = p_leaf;
+		p_tree.nodes.write[p_leaf].parent = INVALID_INDEX;
+		return;
+	}
+
+	// find the sibling with the lowest surface area cost, descending greedily
+	uint32_t sibling;
+	AABB leaf_aabb = p_tree.nodes[p_leaf].aabb;
+	{
+		const Node *nodes = p_tree.nodes.ptr();
+		uint32_t index = p_tree.root;
+
+		while (!nodes[index].is_leaf()) {
+
+			const Node &n = nodes[index];
+			real_t area = _get_cost(n.aabb);
+			real_t combined_area = _get_cost(n.aabb.merge(leaf_aabb));
+
+			// cost of creating a new parent for this node and the leaf
+			real_t cost = 2.0 * combined_area;
+			// minimum cost of pushing the leaf further down the tree
+			real_t inheritance_cost = 2.0 * (combined_area - area);
+
+			real_t child_cost[2];
+			for (int i = 0; i < 2; i++) {
+				const Node &c = nodes[n.children[i]];
+				child_cost[i] = _get_cost(c.aabb.merge(leaf_aabb)) + inheritance_cost;
+				if (!c.is_leaf()) {
+					child_cost[i] -= _get_cost(c.aabb);
+				}
+			}
+
+			if (cost < child_cost[0] && cost < child_cost[1])
+				break;
+
+			index = child_cost[0] < child_cost[1] ? n.children[0] : n.children[1];
+		}
+
+		sibling = index;
+	}
+
+	uint32_t old_parent = p_tree.nodes[sibling].parent;
+	uint32_t new_parent = _node_alloc(p_tree);
+
+	Node *nodes = p_tree.nodes.ptrw();
+	nodes[new_parent].parent = old_parent;
+	nodes[new_parent].aabb = leaf_aabb.merge(nodes[sibling].aabb);
+	nodes[new_parent].height = nodes[sibling].height + 1;
+	nodes[new_parent].children[0] = sibling;
+	nodes[new_parent].children[1] = p_leaf;
+	nodes[sibling].parent = new_parent;
+	nodes[p_leaf].parent = new_parent;
+
+	if (old_parent != INVALID_INDEX) {
+		Node &p = nodes[old_parent];
+		p.children[p.children[0] == sibling ? 0 : 1] = new_parent;
+	} else {
+		p_tree.root = new_parent;
+	}
+
+	// refit and rebalance the ancestors
+	uint32_t index = new_parent;
+	while (index != INVALID_INDEX) {
+
+		index = _balance(p_tree, index);
+
+		Node &n = nodes[index];
+		const Node &c0 = nodes[n.children[0]];
+		const Node &c1 = nodes[n.children[1]];
+		n.height = 1 + MAX(c0.height, c1.height);
+		n.aabb = c0.aabb.merge(c1.aabb);
+
+		index = n.parent;
+	}
+}
+
+template <class T, bool use_pairs>
+void BVH<T, use_pairs>::_remove_leaf(Tree &p_tree, uint32_t p_leaf) {
+
+	p_tree.leaf_count--;
+
+	if (p_leaf == p_tree.root) {
+		p_tree.root = INVALID_INDEX;
+		return;
+	}
+
+	Node *nodes = p_tree.nodes.ptrw();
+
+	uint32_t parent = nodes[p_leaf].parent;
+	uint32_t grand_parent = nodes[parent].parent;
+	uint32_t sibling = nodes[parent].children[0] == p_leaf ? nodes[parent].children[1] : nodes[parent].children[0];
+
+	_node_free(p_tree, parent);
+
+	if (grand_parent == INVALID_INDEX) {
+		p_tree.root = sibling;
+		nodes[sibling].parent = INVALID_INDEX;
+		return;
+	}
+
+	Node &gp = nodes[grand_parent];
+	gp.children[gp.children[0] == parent ? 0 : 1] = sibling;
+	nodes[sibling].parent = grand_parent;
+
+	uint32_t index = grand_parent;
+	while (index != INVALID_INDEX) {
+
+		index = _balance(p_tree, index);
+
+		Node &n = nodes[index];
+		const Node &c0 = nodes[n.children[0]];
+		const Node &c1 = nodes[n.children[1]];
+		n.height = 1 + MAX(c0.height, c1.height);
+		n.aabb = c0.aabb.merge(c1.aabb);
+
+		index = n.parent;
+	}
+}
+
+/* ELEMENTS */
+
+template <class T, bool use_pairs>
+void BVH<T, use_pairs>::_element_insert(BVHElementID p_id) {
+
+	Element &e = _get_element(p_id);
+	int tree_index = _get_tree_index(e);
+	Tree &tree = trees[tree_index];
+
+	uint32_t leaf = _node_alloc(tree);
+	Node &n = tree.nodes.write[leaf];
+	n.element = p_id;
+	n.aabb = e.aabb;
+	if (e.dynamic) {
+		n.aabb.grow_by(node_expansion);
+	}
+
+	e.tree = tree_index;
+	e.leaf = leaf;
+	_insert_leaf(tree, leaf);
+}
+
+template <class T, bool use_pairs>
+void BVH<T, use_pairs>::_element_remove(BVHElementID p_id) {
+
+	Element &e = _get_element(p_id);
+	ERR_FAIL_COND(e.tree < 0);
+
+	Tree &tree = trees[e.tree];
+	_remove_leaf(tree, e.leaf);
+	_node_free(tree, e.leaf);
+	e.tree = -1;
+	e.leaf = INVALID_INDEX;
+}
+
+/* PAIRS */
+
+template <class T, bool use_pairs>
+void BVH<T, use_pairs>::_pair_add(BVHElementID p_A, BVHElementID p_B) {
+
+	uint32_t index;
+	if (free_pairs.size()) {
+		index = free_pairs[free_pairs.size() - 1];
+		free_pairs.resize(free_pairs.size() - 1);
+	} else {
+		index = pairs.size();
+		pairs.push_back(PairData());
+	}
+
+	Element &A = _get_element(p_A);
+	Element &B = _get_element(p_B);
+
+	PairData &p = pairs.write[index];
+	p.A = p_A;
+	p.B = p_B;
+	p.index_A = A.pairs.size();
+	p.index_B = B.pairs.size();
+	A.pairs.push_back(index);
+	B.pairs.push_back(index);
+	pair_map.set(_get_pair_key(p_A, p_B), index);
+
+	p.ud = pair_callback ? pair_callback(pair_callback_userdata, p_A, A.userdata, A.subindex, p_B, B.userdata, B.subindex) : NULL;
+	pair_count++;
+}
+
+template <class T, bool use_pairs>
+void BVH<T, use_pairs>::_pair_remove(uint32_t p_pair) {
+
+	PairData p = pairs[p_pair];
+	Element &A = _get_element(p.A);
+	Element &B = _get_element(p.B);
+
+	if (unpair_callback) {
+		unpair_callback(unpair_callback_userdata, p.A, A.userdata, A.subindex, p.B, B.userdata, B.subindex, p.ud);
+	}
+	pair_count--;
+
+	// swap-remove from both pair lists, fixing the index of the moved pair
+	Element *owners[2] = { &A, &B };
+	uint32_t positions[2] = { p.index_A, p.index_B };
+	BVHElementID ids[2] = { p.A, p.B };
+	for (int i = 0; i < 2; i++) {
+
+		Vector<uint32_t> &list = owners[i]->pairs;
+		uint32_t last = list.size() - 1;
+		if (positions[i] != last) {
+			uint32_t moved = list[last];
+			list.write[positions[i]] = moved;
+			PairData &m = pairs.write[moved];
+			if (m.A == ids[i]) {
+				m.index_A = positions[i];
+			} else {
+				m.index_B = positions[i];
+			}
+		}
+		list.resize(last);
+	}
+
+	pair_map.erase(_get_pair_key(p.A, p.B));
+	free_pairs.push_back(p_pair);
+}
+
+template <class T, bool use_pairs>
+void BVH<T, use_pairs>::_element_clear_pairs(BVHElementID p_id) {
+
+	Element &e = _get_element(p_id);
+	while (e.pairs.size()) {
+		_pair_remove(e.pairs[e.pairs.size() - 1]);
+	}
+}
+
+template <class T, bool use_pairs>
+void BVH<T, use_pairs>::_element_check_pairs(BVHElementID p_id) {
+
+	Element &e = _get_element(p_id);
+
+	if (e.tree < 0) {
+		_element_clear_pairs(p_id);
+		return;
+	}
+
+	// drop the pairs that no longer apply; walking backwards keeps swap-removal safe
+	for (int i = e.pairs.size() - 1; i >= 0; i--) {
+
+		const PairData &p = pairs[e.pairs[i]];
+		const Element &other = _get_element(p.A == p_id ? p.B : p.A);
+		if (!_can_pair(e, other) || !e.aabb.intersects_inclusive(other.aabb)) {
+			_pair_remove(e.pairs[i]);
+		}
+	}
+
+	// non-pairable elements only pair with pairable ones
+	uint32_t stack[STACK_MAX];
+
+	for (uint32_t t = 0; t < TREE_MAX; t++) {
+
+		if (!e.pairable && !(t & TREE_FLAG_PAIRABLE))
+			continue;
+
+		const Tree &tree = trees[t];
+		if (tree.root == INVALID_INDEX)
+			continue;
+
+		uint32_t stack_size = 0;
+		stack[stack_size++] = tree.root;
+
+		while (stack_size) {
+
+			const Node &n = tree.nodes[stack[--stack_size]];
+			if (!n.aabb.intersects_inclusive(e.aabb))
+				continue;
+
+			if (n.is_leaf()) {
+				if (n.element == p_id)
+					continue;
+				const Element &other = _get_element(n.element);
+				if (_can_pair(e, other) && e.aabb.intersects_inclusive(other.aabb) && !pair_map.has(_get_pair_key(p_id, n.element))) {
+					_pair_add(p_id, n.element);
+				}
+				continue;
+			}
+
+			ERR_FAIL_COND(stack_size + 2 > STACK_MAX);
+			stack[stack_size++] = n.children[0];
+			stack[stack_size++] = n.children[1];
+		}
+	}
+}
+
+/* CULLING */
+
+template <class T, bool use_pairs>
+template <class C>
+int BVH<T, use_pairs>::_cull(const C &p_test, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) const {
+
+	int result_count = 0;
+
+	// the top bit marks subtrees that are fully inside and need no more tests
+	const uint32_t INSIDE_BIT = 0x80000000;
+	uint32_t stack[STACK_MAX];
+
+	for (uint32_t t = 0; t < TREE_MAX; t++) {
+
+		const Tree &tree = trees[t];
+		if (tree.root == INVALID_INDEX)
+			continue;
+
+		const Node *nodes = tree.nodes.ptr();
+		uint32_t stack_size = 0;
+		stack[stack_size++] = tree.root;
+
+		while (stack_size) {
+
+			uint32_t entry = stack[--stack_size];
+			bool inside = entry & INSIDE_BIT;
+			const Node &n = nodes[entry & ~INSIDE_BIT];
+
+			if (n.is_leaf()) {
+
+				const Element &e = _get_element(n.element);
+				if (use_pairs && !(e.pairable_type & p_mask))
+					continue;
+				// leaves of dynamic trees are expanded, so test the real bounds
+				if (!inside && p_test.test(e.aabb) == CULL_OUTSIDE)
+					continue;
+
+				if (result_count == p_result_max)
+					return result_count; // pointless to continue
+
+				p_result_array[result_count] = e.userdata;
+				if (p_subindex_array)
+					p_subindex_array[result_count] = e.subindex;
+				result_count++;
+				continue;
+			}
+
+			if (!inside) {
+				CullResult res = p_test.test(n.aabb);
+				if (res == CULL_OUTSIDE)
+					continue;
+				inside = res == CULL_INSIDE;
+			}
+
+			ERR_FAIL_COND_V(stack_size + 2 > STACK_MAX, result_count);
+			uint32_t flag = inside ? INSIDE_BIT : 0;
+			stack[stack_size++] = n.children[0] | flag;
+			stack[stack_size++] = n.children[1] | flag;
+		}
+	}
+
+	return result_count;
+}
+
+template <class T, bool use_pairs>
+int BVH<T, use_pairs>::cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask) {
+
+	_CullConvex cull;
+	cull.planes = p_convex.ptr();
+	cull.plane_count = p_convex.size();
+	return _cull(cull, p_result_array, p_result_max, NULL, p_mask);
+}
+
+template <class T, bool use_pairs>
+int BVH<T, use_pairs>::cull_aabb(const AABB &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+
+	_CullAABB cull;
+	cull.aabb = p_aabb;
+	return _cull(cull, p_result_array, p_result_max, p_subindex_array, p_mask);
+}
+
+template <class T, bool use_pairs>
+int BVH<T, use_pairs>::cull_segment(const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+
+	_CullSegment cull;
+	cull.from = p_from;
+	cull.to = p_to;
+	return _cull(cull, p_result_array, p_result_max, p_subindex_array, p_mask);
+}
+
+template <class T, bool use_pairs>
+int BVH<T, use_pairs>::cull_point(const Vector3 &p_point, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
+
+	_CullPoint cull;
+	cull.point = p_point;
+	return _cull(cull, p_result_array, p_result_max, p_subindex_array, p_mask);
+}
+
+/* PUBLIC API */
+
+template <class T, bool use_pairs>
+BVHElementID BVH<T, use_pairs>::create(T *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+
+#ifdef DEBUG_ENABLED
+	// check for AABB validity
+	ERR_FAIL_COND_V(p_aabb.position.x > 1e15 || p_aabb.position.x < -1e15, BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(p_aabb.position.y > 1e15 || p_aabb.position.y < -1e15, BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(p_aabb.position.z > 1e15 || p_aabb.position.z < -1e15, BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(p_aabb.size.x > 1e15 || p_aabb.size.x < 0.0, BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(p_aabb.size.y > 1e15 || p_aabb.size.y < 0.0, BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(p_aabb.size.z > 1e15 || p_aabb.size.z < 0.0, BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(Math::is_nan(p_aabb.size.x), BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(Math::is_nan(p_aabb.size.y), BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(Math::is_nan(p_aabb.size.z), BVH_ELEMENT_INVALID_ID);
+#endif
+
+	BVHElementID id;
+	if (free_elements.size()) {
+		id = free_elements[free_elements.size() - 1];
+		free_elements.resize(free_elements.size() - 1);
+	} else {
+		elements.push_back(Element());
+		id = elements.size();
+	}
+
+	Element &e = _get_element(id);
+	e = Element();
+	e.used = true;
+	e.userdata = p_userdata;
+	e.subindex = p_subindex;
+	e.pairable = p_pairable;
+	e.pairable_type = p_pairable_type;
+	e.pairable_mask = p_pairable_mask;
+	e.aabb = p_aabb;
+
+	if (!p_aabb.has_no_surface()) {
+		_element_insert(id);
+		if (use_pairs)
+			_element_check_pairs(id);
+	}
+
+	return id;
+}
+
+template <class T, bool use_pairs>
+void BVH<T, use_pairs>::move(BVHElementID p_id, const AABB &p_aabb) {
+
+#ifdef DEBUG_ENABLED
+	// check for AABB validity
+	ERR_FAIL_COND(p_aabb.position.x > 1e15 || p_aabb.position.x < -1e15);
+	ERR_FAIL_COND(p_aabb.position.y > 1e15 || p_aabb.position.y < -1e15);
+	ERR_FAIL_COND(p_aabb.position.z > 1e15 || p_aabb.position.z < -1e15);
+	ERR_FAIL_COND(p_aabb.size.x > 1e15 || p_aabb.size.x < 0.0);
+	ERR_FAIL_COND(p_aabb.size.y > 1e15 || p_aabb.size.y < 0.0);
+	ERR_FAIL_COND(p_aabb.size.z > 1e15 || p_aabb.size.z < 0.0);
+	ERR_FAIL_COND(Math::is_nan(p_aabb.size.x));
+	ERR_FAIL_COND(Math::is_nan(p_aabb.size.y));
+	ERR_FAIL_COND(Math::is_nan(p_aabb.size.z));
+#endif
+	ERR_FAIL_COND(!_is_valid_id(p_id));
+
+	Element &e = _get_element(p_id);
+	if (e.aabb == p_aabb)
+		return;
+
+	bool has_surf = !p_aabb.has_no_surface();
+
+	if (e.tree >= 0) {
+
+		if (!has_surf || !e.dynamic) {
+			// static elements that move are migrated to the dynamic trees
+			_element_remove(p_id);
+		} else if (!trees[e.tree].nodes[e.leaf].aabb.encloses(p_aabb)) {
+			// left its expanded bounds, reinsert
+			_element_remove(p_id);
+		}
+	}
+
+	e.dynamic = true;
+	e.aabb = p_aabb;
+
+	if (has_surf && e.tree < 0) {
+		_element_insert(p_id);
+	}
+
+	if (use_pairs)
+		_element_check_pairs(p_id);
+}
+
+template <class T, bool use_pairs>
+void BVH<T, use_pairs>::set_pairable(BVHElementID p_id, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+
+	ERR_FAIL_COND(!_is_valid_id(p_id));
+	Element &e = _get_element(p_id);
+
+	if (p_pairable == e.pairable && e.pairable_type == p_pairable_type && e.pairable_mask == p_pairable_mask)
+		return; // no changes, return
+
+	bool inserted = e.tree >= 0;
+	if (inserted) {
+		_element_remove(p_id);
+	}
+
+	e.pairable = p_pairable;
+	e.pairable_type = p_pairable_type;
+	e.pairable_mask = p_pairable_mask;
+
+	if (inserted) {
+		_element_insert(p_id);
+	}
+
+	if (use_pairs)
+		_element_check_pairs(p_id);
+}
+
+template <class T, bool use_pairs>
+void BVH<T, use_pairs>::erase(BVHElementID p_id) {
+
+	ERR_FAIL_COND(!_is_valid_id(p_id));
+
+	if (use_pairs)
+		_element_clear_pairs(p_id);
+
+	Element &e = _get_element(p_id);
+	if (e.tree >= 0) {
+		_element_remove(p_id);
+	}
+
+	e = Element();
+	free_elements.push_back(p_id);
+}
+
+template <class T, bool use_pairs>
+bool BVH<T, use_pairs>::is_pairable(BVHElementID p_id) const {
+
+	ERR_FAIL_COND_V(!_is_valid_id(p_id), false);
+	return _get_element(p_id).pairable;
+}
+
+template <class T, bool use_pairs>
+T *BVH<T, use_pairs>::get(BVHElementID p_id) const {
+
+	ERR_FAIL_COND_V(!_is_valid_id(p_id), NULL);
+	return _get_element(p_id).userdata;
+}
+
+template <class T, bool use_pairs>
+int BVH<T, use_pairs>::get_subindex(BVHElementID p_id) const {
+
+	ERR_FAIL_COND_V(!_is_valid_id(p_id), -1);
+	return _get_element(p_id).subindex;
+}
+
+template <class T, bool use_pairs>
+void BVH<T, use_pairs>::set_pair_callback(PairCallback p_callback, void *p_userdata) {
+
+	pair_callback = p_callback;
+	pair_callback_userdata = p_userdata;
+}
+
+template <class T, bool use_pairs>
+void BVH<T, use_pairs>::set_unpair_callback(UnpairCallback p_callback, void *p_userdata) {
+
+	unpair_callback = p_callback;
+	unpair_callback_userdata = p_userdata;
+}
+
+template <class T, bool use_pairs>
+BVH<T, use_pairs>::BVH() {
+
+	pair_count = 0;
+	pair_callback = NULL;
+	unpair_callback = NULL;
+	pair_callback_userdata = NULL;
+	unpair_callback_userdata = NULL;
+	node_expansion = 0.1;
+}
+
+#endif // BVH_H
@@ -1920,71 +1920,255 @@ bool Expression::_compile_expression() {
 	return false;
 }
 
-bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression::ENode *p_node, Variant &r_ret, String &r_error_str) {
+const Variant *Expression::_get_operand(int p_address, const Array &p_inputs, const Variant &p_self) const {
+
+	int index = p_address >> ADDR_TYPE_BITS;
+	switch (p_address & ADDR_TYPE_MASK) {
+		case ADDR_REGISTER:
+			return &registers[index];
+		case ADDR_CONSTANT:
+			return &constants[index];
+		case ADDR_INPUT:
+			return &p_inputs[index];
+		default:
+			return &p_self;
+	}
+}
+
+void Expression::_clear_program() {
+
+	program.clear();
+	operands.clear();
+	constants.clear();
+	names.clear();
+	registers.clear();
+	argptrs.clear();
+	result_address = _make_address(ADDR_CONSTANT, 0);
+	max_input_index = -1;
+	uses_self = false;
+}
+
+int Expression::_add_constant(const Variant &p_value) {
+
+	//formulas tend to repeat the same literals, don't store them twice
+	for (int i = 0; i < constants.size(); i++) {
+		if (constants[i].get_type() == p_value.get_type() && constants[i] == p_value) {
+			return i;
+		}
+	}
+
+	constants.push_back(p_value);
+	return constants.size() - 1;
+}
+
+int Expression::_compile_node(ENode *p_node, int p_stack, int &r_register_count) {
+
+	Instruction instruction;
+	LocalVector<ENode *> children;
 
 	switch (p_node->type) {
-		case Expression::ENode::TYPE_INPUT: {
+		case ENode::TYPE_INPUT: {
 
-			const Expression::InputNode *in = static_cast<const Expression::InputNode *>(p_node);
-			if (in->index < 0 || in->index >= p_inputs.size()) {
-				r_error_str = vformat(RTR("Invalid input %i (not passed) in expression"), in->index);
-				return true;
+			const InputNode *in = static_cast<const InputNode *>(p_node);
+			max_input_index = MAX(max_input_index, in->index);
+			return _make_address(ADDR_INPUT, in->index);
+		}
+		case ENode::TYPE_CONSTANT: {
+
+			const ConstantNode *c = static_cast<const ConstantNode *>(p_node);
+			return _make_address(ADDR_CONSTANT, _add_constant(c->value));
+		}
+		case ENode::TYPE_SELF: {
+
+			uses_self = true;
+			return _make_address(ADDR_SELF, 0);
+		}
+		case ENode::TYPE_OPERATOR: {
+
+			const OperatorNode *op = static_cast<const OperatorNode *>(p_node);
+			instruction.opcode = Instruction::OPCODE_OPERATOR;
+			instruction.arg = op->op;
+			children.push_back(op->nodes[0]);
+			if (op->nodes[1]) {
+				children.push_back(op->nodes[1]);
 			}
-			r_ret = p_inputs[in->index];
 		} break;
-		case Expression::ENode::TYPE_CONSTANT: {
+		case ENode::TYPE_INDEX: {
 
-			const Expression::ConstantNode *c = static_cast<const Expression::ConstantNode *>(p_node);
-			r_ret = c->value;
+			const IndexNode *index = static_cast<const IndexNode *>(p_node);
+			instruction.opcode = Instruction::OPCODE_INDEX;
+			instruction.arg = 0;
+			children.push_back(index->base);
+			children.push_back(index->index);
+		} break;
+		case ENode::TYPE_NAMED_INDEX: {
 
+			const NamedIndexNode *index = static_cast<const NamedIndexNode *>(p_node);
+			instruction.opcode = Instruction::OPCODE_NAMED_INDEX;
+			instruction.arg = names.size();
+			names.push_back(index->name);
+			children.push_back(index->base);
 		} break;
-		case Expression::ENode::TYPE_SELF: {
+		case ENode::TYPE_ARRAY: {
 
-			if (!p_instance) {
-				r_error_str = RTR("self can't be used because instance is null (not passed)");
-				return true;
+			const ArrayNode *array = static_cast<const ArrayNode *>(p_node);
+			instruction.opcode = Instruction::OPCODE_ARRAY;
+			instruction.arg = 0;
+			for (int i = 0; i < array->array.size(); i++) {
+				children.push_back(array->array[i]);
 			}
-			r_ret = p_instance;
 		} break;
-		case Expression::ENode::TYPE_OPERATOR: {
-
-			const Expression::OperatorNode *op = static_cast<const Expression::OperatorNode *>(p_node);
+		case ENode::TYPE_DICTIONARY: {
 
-			Variant a;
-			bool ret = _execute(p_inputs, p_instance, op->nodes[0], a, r_error_str);
-			if (ret)
-				return true;
+			const DictionaryNode *dictionary = static_cast<const DictionaryNode *>(p_node);
+			instruction.opcode = Instruction::OPCODE_DICTIONARY;
+			instruction.arg = 0;
+			for (int i = 0; i < dictionary->dict.size(); i++) {
+				children.push_back(dictionary->dict[i]);
+			}
+		} break;
+		case ENode::TYPE_CONSTRUCTOR: {
 
-			Variant b;
+			const ConstructorNode *constructor = static_cast<const ConstructorNode *>(p_node);
+			instruction.opcode = Instruction::OPCODE_CONSTRUCTOR;
+			instruction.arg = constructor->data_type;
+			for (int i = 0; i < constructor->arguments.size(); i++) {
+				children.push_back(constructor->arguments[i]);
+			}
+		} break;
+		case ENode::TYPE_BUILTIN_FUNC: {
 
-			if (op->nodes[1]) {
-				ret = _execute(p_inputs, p_instance, op->nodes[1], b, r_error_str);
-				if (ret)
-					return true;
+			const BuiltinFuncNode *bifunc = static_cast<const BuiltinFuncNode *>(p_node);
+			instruction.opcode = Instruction::OPCODE_BUILTIN_FUNC;
+			instruction.arg = bifunc->func;
+			for (int i = 0; i < bifunc->arguments.size(); i++) {
+				children.push_back(bifunc->arguments[i]);
 			}
+		} break;
+		case ENode::TYPE_CALL: {
 
-			bool valid = true;
-			Variant::evaluate(op->op, a, b, r_ret, valid);
-			if (!valid) {
-				r_error_str = vformat(RTR("Invalid operands to operator %s, %s and %s."), Variant::get_operator_name(op->op), Variant::get_type_name(a.get_type()), Variant::get_type_name(b.get_type()));
-				return true;
+			const CallNode *call = static_cast<const CallNode *>(p_node);
+			instruction.opcode = Instruction::OPCODE_CALL;
+			instruction.arg = names.size();
+			names.push_back(call->method);
+			children.push_back(call->base);
+			for (int i = 0; i < call->arguments.size(); i++) {
+				children.push_back(call->arguments[i]);
 			}
+		} break;
+	}
 
+	//each operand gets its own register above this one, so nothing computed later overwrites it
+	LocalVector<int> addresses;
+	addresses.resize(children.size());
+	bool all_constant = true;
+	for (uint32_t i = 0; i < children.size(); i++) {
+		addresses[i] = _compile_node(children[i], p_stack + 1 + i, r_register_count);
+		if ((addresses[i] & ADDR_TYPE_MASK) != ADDR_CONSTANT) {
+			all_constant = false;
+		}
+	}
+
+	instruction.dest = p_stack;
+	instruction.operand_from = operands.size();
+	instruction.operand_count = addresses.size();
+	for (uint32_t i = 0; i < addresses.size(); i++) {
+		operands.push_back(addresses[i]);
+	}
+
+	if (all_constant) {
+		Variant value;
+		if (_fold_instruction(instruction, value)) {
+			operands.resize(instruction.operand_from);
+			return _make_address(ADDR_CONSTANT, _add_constant(value));
+		}
+	}
+
+	r_register_count = MAX(r_register_count, p_stack + 1);
+	program.push_back(instruction);
+	return _make_address(ADDR_REGISTER, p_stack);
+}
+
+bool Expression::_fold_instruction(const Instruction &p_instruction, Variant &r_value) {
+
+	switch (p_instruction.opcode) {
+		case Instruction::OPCODE_OPERATOR:
+		case Instruction::OPCODE_INDEX:
+		case Instruction::OPCODE_NAMED_INDEX:
+		case Instruction::OPCODE_CONSTRUCTOR: {
 		} break;
-		case Expression::ENode::TYPE_INDEX: {
+		case Instruction::OPCODE_BUILTIN_FUNC: {
 
-			const Expression::IndexNode *index = static_cast<const Expression::IndexNode *>(p_node);
+			//only functions without side effects whose result depends on the arguments alone
+			BuiltinFunc func = BuiltinFunc(p_instruction.arg);
+			bool pure = (func >= MATH_SIN && func <= MATH_DECTIME) || (func >= MATH_DEG2RAD && func <= LOGIC_NEAREST_PO2) || func == TYPE_OF || func == TEXT_CHAR || func == TEXT_ORD || func == TEXT_STR || func == COLORN;
+			if (!pure) {
+				return false;
+			}
+		} break;
+		default: {
+			//arrays and dictionaries are shared, each execution must build its own
+			return false;
+		}
+	}
 
-			Variant base;
-			bool ret = _execute(p_inputs, p_instance, index->base, base, r_error_str);
-			if (ret)
-				return true;
+	//the operands are all constants, so the instruction can run right away
+	Instruction instruction = p_instruction;
+	instruction.dest = registers.size();
+	registers.push_back(Variant());
+	if (argptrs.size() < (uint32_t)instruction.operand_count) {
+		argptrs.resize(instruction.operand_count);
+	}
+
+	String error_str;
+	bool failed = _run_instruction(instruction, Array(), Variant(), error_str);
+	r_value = registers[instruction.dest];
+	registers.resize(instruction.dest);
+
+	//errors are left for execution to report, and shared values can't become constants either
+	return !failed && r_value.get_type() < Variant::_RID;
+}
+
+void Expression::_compile_program() {
+
+	_clear_program();
+
+	int register_count = 0;
+	result_address = _compile_node(root, 0, register_count);
+	registers.resize(register_count);
+
+	uint32_t max_operands = 0;
+	for (uint32_t i = 0; i < program.size(); i++) {
+		max_operands = MAX(max_operands, (uint32_t)program[i].operand_count);
+	}
+	argptrs.resize(max_operands);
+}
+
+bool Expression::_run_instruction(const Instruction &p_instruction, const Array &p_inputs, const Variant &p_self, String &r_error_str) {
 
-			Variant idx;
+	const int *addresses = operands.ptr() + p_instruction.operand_from;
+	Variant &r_ret = registers[p_instruction.dest];
 
-			ret = _execute(p_inputs, p_instance, index->index, idx, r_error_str);
-			if (ret)
+	switch (p_instruction.opcode) {
+		case Instruction::OPCODE_OPERATOR: {
+
+			static const Variant nil;
+			Variant::Operator op = Variant::Operator(p_instruction.arg);
+			const Variant &a = *_get_operand(addresses[0], p_inputs, p_self);
+			const Variant &b = p_instruction.operand_count > 1 ? *_get_operand(addresses[1], p_inputs, p_self) : nil;
+
+			bool valid = true;
+			Variant::evaluate(op, a, b, r_ret, valid);
+			if (!valid) {
+				r_error_str = vformat(RTR("Invalid operands to operator %s, %s and %s."), Variant::get_operator_name(op), Variant::get_type_name(a.get_type()), Variant::get_type_name(b.get_type()));
 				return true;
+			}
+
+		} break;
+		case Instruction::OPCODE_INDEX: {
+
+			const Variant &base = *_get_operand(addresses[0], p_inputs, p_self);
+			const Variant &idx = *_get_operand(addresses[1], p_inputs, p_self);
 
 			bool valid;
 			r_ret = base.get(idx, &valid);
@@ -1994,113 +2178,64 @@ bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression:
 			}
 
 		} break;
-		case Expression::ENode::TYPE_NAMED_INDEX: {
+		case Instruction::OPCODE_NAMED_INDEX: {
 
-			const Expression::NamedIndexNode *index = static_cast<const Expression::NamedIndexNode *>(p_node);
-
-			Variant base;
-			bool ret = _execute(p_inputs, p_instance, index->base, base, r_error_str);
-			if (ret)
-				return true;
+			const Variant &base = *_get_operand(addresses[0], p_inputs, p_self);
+			const StringName &name = names[p_instruction.arg];
 
 			bool valid;
-			r_ret = base.get_named(index->name, &valid);
+			r_ret = base.get_named(name, &valid);
 			if (!valid) {
-				r_error_str = vformat(RTR("Invalid named index '%s' for base type %s"), String(index->name), Variant::get_type_name(base.get_type()));
+				r_error_str = vformat(RTR("Invalid named index '%s' for base type %s"), String(name), Variant::get_type_name(base.get_type()));
 				return true;
 			}
 
 		} break;
-		case Expression::ENode::TYPE_ARRAY: {
-			const Expression::ArrayNode *array = static_cast<const Expression::ArrayNode *>(p_node);
+		case Instruction::OPCODE_ARRAY: {
 
 			Array arr;
-			arr.resize(array->array.size());
-			for (int i = 0; i < array->array.size(); i++) {
-
-				Variant value;
-				bool ret = _execute(p_inputs, p_instance, array->array[i], value, r_error_str);
-
-				if (ret)
-					return true;
-				arr[i] = value;
+			arr.resize(p_instruction.operand_count);
+			for (int i = 0; i < p_instruction.operand_count; i++) {
+				arr[i] = *_get_operand(addresses[i], p_inputs, p_self);
 			}
 
 			r_ret = arr;
 
 		} break;
-		case Expression::ENode::TYPE_DICTIONARY: {
-			const Expression::DictionaryNode *dictionary = static_cast<const Expression::DictionaryNode *>(p_node);
+		case Instruction::OPCODE_DICTIONARY: {
 
 			Dictionary d;
-			for (int i = 0; i < dictionary->dict.size(); i += 2) {
-
-				Variant key;
-				bool ret = _execute(p_inputs, p_instance, dictionary->dict[i + 0], key, r_error_str);
-
-				if (ret)
-					return true;
-
-				Variant value;
-				ret = _execute(p_inputs, p_instance, dictionary->dict[i + 1], value, r_error_str);
-				if (ret)
-					return true;
-
-				d[key] = value;
+			for (int i = 0; i < p_instruction.operand_count; i += 2) {
+				d[*_get_operand(addresses[i + 0], p_inputs, p_self)] = *_get_operand(addresses[i + 1], p_inputs, p_self);
 			}
 
 			r_ret = d;
-		} break;
-		case Expression::ENode::TYPE_CONSTRUCTOR: {
-
-			const Expression::ConstructorNode *constructor = static_cast<const Expression::ConstructorNode *>(p_node);
-
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
-			arr.resize(constructor->arguments.size());
-			argp.resize(constructor->arguments.size());
-
-			for (int i = 0; i < constructor->arguments.size(); i++) {
 
-				Variant value;
-				bool ret = _execute(p_inputs, p_instance, constructor->arguments[i], value, r_error_str);
+		} break;
+		case Instruction::OPCODE_CONSTRUCTOR: {
 
-				if (ret)
-					return true;
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
+			Variant::Type data_type = Variant::Type(p_instruction.arg);
+			for (int i = 0; i < p_instruction.operand_count; i++) {
+				argptrs[i] = _get_operand(addresses[i], p_inputs, p_self);
 			}
 
 			Callable::CallError ce;
-			r_ret = Variant::construct(constructor->data_type, (const Variant **)argp.ptr(), argp.size(), ce);
+			r_ret = Variant::construct(data_type, argptrs.ptr(), p_instruction.operand_count, ce);
 
 			if (ce.error != Callable::CallError::CALL_OK) {
-				r_error_str = vformat(RTR("Invalid arguments to construct '%s'"), Variant::get_type_name(constructor->data_type));
+				r_error_str = vformat(RTR("Invalid arguments to construct '%s'"), Variant::get_type_name(data_type));
 				return true;
 			}
 
 		} break;
-		case Expression::ENode::TYPE_BUILTIN_FUNC: {
-
-			const Expression::BuiltinFuncNode *bifunc = static_cast<const Expression::BuiltinFuncNode *>(p_node);
+		case Instruction::OPCODE_BUILTIN_FUNC: {
 
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
-			arr.resize(bifunc->arguments.size());
-			argp.resize(bifunc->arguments.size());
-
-			for (int i = 0; i < bifunc->arguments.size(); i++) {
-
-				Variant value;
-				bool ret = _execute(p_inputs, p_instance, bifunc->arguments[i], value, r_error_str);
-				if (ret)
-					return true;
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
+			for (int i = 0; i < p_instruction.operand_count; i++) {
+				argptrs[i] = _get_operand(addresses[i], p_inputs, p_self);
 			}
 
 			Callable::CallError ce;
-			exec_func(bifunc->func, (const Variant **)argp.ptr(), &r_ret, ce, r_error_str);
+			exec_func(BuiltinFunc(p_instruction.arg), argptrs.ptr(), &r_ret, ce, r_error_str);
 
 			if (ce.error != Callable::CallError::CALL_OK) {
 				r_error_str = "Builtin Call Failed. " + r_error_str;
@@ -2108,37 +2243,19 @@ bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression:
 			}
 
 		} break;
-		case Expression::ENode::TYPE_CALL: {
-
-			const Expression::CallNode *call = static_cast<const Expression::CallNode *>(p_node);
-
-			Variant base;
-			bool ret = _execute(p_inputs, p_instance, call->base, base, r_error_str);
-
-			if (ret)
-				return true;
-
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
-			arr.resize(call->arguments.size());
-			argp.resize(call->arguments.size());
-
-			for (int i = 0; i < call->arguments.size(); i++) {
+		case Instruction::OPCODE_CALL: {
 
-				Variant value;
-				ret = _execute(p_inputs, p_instance, call->arguments[i], value, r_error_str);
-
-				if (ret)
-					return true;
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
+			Variant base = *_get_operand(addresses[0], p_inputs, p_self);
+			const StringName &method = names[p_instruction.arg];
+			for (int i = 1; i < p_instruction.operand_count; i++) {
+				argptrs[i - 1] = _get_operand(addresses[i], p_inputs, p_self);
 			}
 
 			Callable::CallError ce;
-			r_ret = base.call(call->method, (const Variant **)argp.ptr(), argp.size(), ce);
+			r_ret = base.call(method, argptrs.ptr(), p_instruction.operand_count - 1, ce);
 
 			if (ce.error != Callable::CallError::CALL_OK) {
-				r_error_str = vformat(RTR("On call to '%s':"), String(call->method));
+				r_error_str = vformat(RTR("On call to '%s':"), String(method));
 				return true;
 			}
 
@@ -2147,6 +2264,43 @@ bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression:
 	return false;
 }
 
+bool Expression::_run(const Array &p_inputs, Object *p_instance, Variant &r_ret, String &r_error_str) {
+
+	//every input and self are always evaluated, so they can be validated once up front
+	if (max_input_index >= p_inputs.size()) {
+		r_error_str = vformat(RTR("Invalid input %i (not passed) in expression"), max_input_index);
+		return true;
+	}
+
+	if (uses_self && !p_instance) {
+		r_error_str = RTR("self can't be used because instance is null (not passed)");
+		return true;
+	}
+
+	Variant self = p_instance;
+	bool failed = false;
+
+	for (uint32_t i = 0; i < program.size(); i++) {
+		if (_run_instruction(program[i], p_inputs, self, r_error_str)) {
+			failed = true;
+			break;
+		}
+	}
+
+	if (!failed) {
+		r_ret = *_get_operand(result_address, p_inputs, self);
+	}
+
+	//don't keep objects alive until the next execution
+	for (uint32_t i = 0; i < registers.size(); i++) {
+		if (registers[i].get_type() == Variant::OBJECT) {
+			registers[i] = Variant();
+		}
+	}
+
+	return failed;
+}
+
 Error Expression::parse(const String &p_expression, const Vector<String> &p_input_names) {
 
 	if (nodes) {
@@ -2169,9 +2323,12 @@ Error Expression::parse(const String &p_expression, const Vector<String> &p_inpu
 			memdelete(nodes);
 		}
 		nodes = NULL;
+		_clear_program();
 		return ERR_INVALID_PARAMETER;
 	}
 
+	_compile_program();
+
 	return OK;
 }
 
@@ -2182,7 +2339,7 @@ Variant Expression::execute(Array p_inputs, Object *p_base, bool p_show_error) {
 	execution_error = false;
 	Variant output;
 	String error_txt;
-	bool err = _execute(p_inputs, p_base, root, output, error_txt);
+	bool err = _run(p_inputs, p_base, output, error_txt);
 	if (err) {
 		execution_error = true;
 		error_str = error_txt;
@@ -2192,6 +2349,34 @@ Variant Expression::execute(Array p_inputs, Object *p_base, bool p_show_error) {
 	return output;
 }
 
+Array Expression::execute_batch(const Array &p_input_sets, Object *p_base, bool p_show_error) {
+
+	ERR_FAIL_COND_V_MSG(error_set, Array(), "There was previously a parse error: " + error_str + ".");
+
+	execution_error = false;
+	Array results;
+	results.resize(p_input_sets.size());
+	String error_txt;
+
+	for (int i = 0; i < p_input_sets.size(); i++) {
+
+		const Variant &inputs = p_input_sets[i];
+		ERR_FAIL_COND_V_MSG(inputs.get_type() != Variant::ARRAY, Array(), vformat("Input set %d is not an Array.", i));
+
+		Variant output;
+		bool err = _run(inputs, p_base, output, error_txt);
+		if (err) {
+			execution_error = true;
+			error_str = error_txt;
+			ERR_FAIL_COND_V_MSG(p_show_error, Array(), error_str);
+			return Array();
+		}
+		results[i] = output;
+	}
+
+	return results;
+}
+
 bool Expression::has_execute_failed() const {
 	return execution_error;
 }
@@ -2204,6 +2389,7 @@ void Expression::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("parse", "expression", "input_names"), &Expression::parse, DEFVAL(Vector<String>()));
 	ClassDB::bind_method(D_METHOD("execute", "inputs", "base_instance", "show_error"), &Expression::execute, DEFVAL(Array()), DEFVAL(Variant()), DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("execute_batch", "input_sets", "base_instance", "show_error"), &Expression::execute_batch, DEFVAL(Variant()), DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("has_execute_failed"), &Expression::has_execute_failed);
 	ClassDB::bind_method(D_METHOD("get_error_text"), &Expression::get_error_text);
 }
@@ -2214,6 +2400,9 @@ Expression::Expression() :
 		error_set(true),
 		root(NULL),
 		nodes(NULL),
+		result_address(0),
+		max_input_index(-1),
+		uses_self(false),
 		execution_error(false) {
 }
 
@@ -31,6 +31,7 @@
 #ifndef EXPRESSION_H
 #define EXPRESSION_H
 
+#include "core/local_vector.h"
 #include "core/reference.h"
 
 class Expression : public Reference {
@@ -344,8 +345,65 @@ private:
 
 	Vector<String> input_names;
 
+	//the node tree is lowered to a flat program after parsing, operands are addresses
+	//into the register file, the constant pool, the inputs or self
+
+	enum {
+		ADDR_TYPE_BITS = 2,
+		ADDR_TYPE_MASK = (1 << ADDR_TYPE_BITS) - 1,
+	};
+
+	enum AddressType {
+		ADDR_REGISTER,
+		ADDR_CONSTANT,
+		ADDR_INPUT,
+		ADDR_SELF,
+	};
+
+	struct Instruction {
+
+		enum Opcode {
+			OPCODE_OPERATOR,
+			OPCODE_INDEX,
+			OPCODE_NAMED_INDEX,
+			OPCODE_ARRAY,
+			OPCODE_DICTIONARY,
+			OPCODE_CONSTRUCTOR,
+			OPCODE_BUILTIN_FUNC,
+			OPCODE_CALL
+		};
+
+		Opcode opcode;
+		int dest; //register written
+		int arg; //operator, type, builtin function or name, depending on the opcode
+		int operand_from; //first entry in operands
+		int operand_count;
+	};
+
+	LocalVector<Instruction> program;
+	LocalVector<int> operands;
+	Vector<Variant> constants;
+	Vector<StringName> names;
+	int result_address;
+	int max_input_index;
+	bool uses_self;
+
+	//reused by every execution so running the same expression does not allocate
+	LocalVector<Variant> registers;
+	LocalVector<const Variant *> argptrs;
+
+	_FORCE_INLINE_ static int _make_address(AddressType p_type, int p_index) { return (p_index << ADDR_TYPE_BITS) | p_type; }
+	_FORCE_INLINE_ const Variant *_get_operand(int p_address, const Array &p_inputs, const Variant &p_self) const;
+
+	void _clear_program();
+	int _add_constant(const Variant &p_value);
+	int _compile_node(ENode *p_node, int p_stack, int &r_register_count);
+	bool _fold_instruction(const Instruction &p_instruction, Variant &r_value);
+	bool _run_instruction(const Instruction &p_instruction, const Array &p_inputs, const Variant &p_self, String &r_error_str);
+	void _compile_program();
+
 	bool execution_error;
-	bool _execute(const Array &p_inputs, Object *p_instance, Expression::ENode *p_node, Variant &r_ret, String &r_error_str);
+	bool _run(const Array &p_inputs, Object *p_instance, Variant &r_ret, String &r_error_str);
 
 protected:
 	static void _bind_methods();
@@ -353,6 +411,7 @@ protected:
 public:
 	Error parse(const String &p_expression, const Vector<String> &p_input_names = Vector<String>());
 	Variant execute(Array p_inputs, Object *p_base = NULL, bool p_show_error = true);
+	Array execute_batch(const Array &p_input_sets, Object *p_base = NULL, bool p_show_error = true);
 	bool has_execute_failed() const;
 	String get_error_text() const;
 
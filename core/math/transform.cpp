@@ -209,6 +209,51 @@ Transform Transform::operator*(const Transform &p_transform) const {
 	return t;
 }
 
+void Transform::xform(const Vector3 *p_src, Vector3 *r_dst, int p_count) const {
+
+	// Kept in locals so the loop doesn't reload them for every point.
+	const real_t xx = basis.elements[0][0], xy = basis.elements[0][1], xz = basis.elements[0][2];
+	const real_t yx = basis.elements[1][0], yy = basis.elements[1][1], yz = basis.elements[1][2];
+	const real_t zx = basis.elements[2][0], zy = basis.elements[2][1], zz = basis.elements[2][2];
+	const real_t ox = origin.x, oy = origin.y, oz = origin.z;
+
+	for (int i = 0; i < p_count; i++) {
+		const Vector3 v = p_src[i];
+		r_dst[i] = Vector3(
+				xx * v.x + xy * v.y + xz * v.z + ox,
+				yx * v.x + yy * v.y + yz * v.z + oy,
+				zx * v.x + zy * v.y + zz * v.z + oz);
+	}
+}
+
+void Transform::xform_normals(const Vector3 *p_src, Vector3 *r_dst, int p_count) const {
+
+	// Normals use the inverse transpose, so they stay perpendicular under non uniform scale.
+	Basis b = basis.inverse().transposed();
+
+	const real_t xx = b.elements[0][0], xy = b.elements[0][1], xz = b.elements[0][2];
+	const real_t yx = b.elements[1][0], yy = b.elements[1][1], yz = b.elements[1][2];
+	const real_t zx = b.elements[2][0], zy = b.elements[2][1], zz = b.elements[2][2];
+
+	for (int i = 0; i < p_count; i++) {
+		const Vector3 v = p_src[i];
+		Vector3 n(
+				xx * v.x + xy * v.y + xz * v.z,
+				yx * v.x + yy * v.y + yz * v.z,
+				zx * v.x + zy * v.y + zz * v.z);
+		n.normalize();
+		r_dst[i] = n;
+	}
+}
+
+void Transform::xform(const Transform *p_src, Transform *r_dst, int p_count) const {
+
+	for (int i = 0; i < p_count; i++) {
+		const Transform &t = p_src[i];
+		r_dst[i] = Transform(basis * t.basis, xform(t.origin));
+	}
+}
+
 Transform::operator String() const {
 
 	return basis.operator String() + " - " + origin.operator String();
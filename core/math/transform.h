@@ -86,6 +86,11 @@ public:
 	_FORCE_INLINE_ Vector<Vector3> xform(const Vector<Vector3> &p_array) const;
 	_FORCE_INLINE_ Vector<Vector3> xform_inv(const Vector<Vector3> &p_array) const;
 
+	// Bulk versions that work on whole arrays, r_dst can be the same array as p_src.
+	void xform(const Vector3 *p_src, Vector3 *r_dst, int p_count) const;
+	void xform_normals(const Vector3 *p_src, Vector3 *r_dst, int p_count) const;
+	void xform(const Transform *p_src, Transform *r_dst, int p_count) const;
+
 	void operator*=(const Transform &p_transform);
 	Transform operator*(const Transform &p_transform) const;
 
@@ -213,13 +218,7 @@ Vector<Vector3> Transform::xform(const Vector<Vector3> &p_array) const {
 
 	Vector<Vector3> array;
 	array.resize(p_array.size());
-
-	const Vector3 *r = p_array.ptr();
-	Vector3 *w = array.ptrw();
-
-	for (int i = 0; i < p_array.size(); ++i) {
-		w[i] = xform(r[i]);
-	}
+	xform(p_array.ptr(), array.ptrw(), p_array.size());
 	return array;
 }
 
@@ -31,62 +31,157 @@
 #include "triangle_mesh.h"
 
 #include "core/sort_array.h"
+#include "core/thread_work_pool.h"
 
-int TriangleMesh::_create_bvh(BVH *p_bvh, BVH **p_bb, int p_from, int p_size, int p_depth, int &max_depth, int &max_alloc) {
+#define BVH_SAH_BINS 16
+// Subtrees smaller than this are built whole by one thread.
+#define BVH_TASK_SIZE 4096
 
-	if (p_depth > max_depth) {
-		max_depth = p_depth;
-	}
+static _FORCE_INLINE_ real_t _bvh_surface(const AABB &p_aabb) {
 
-	if (p_size == 1) {
+	const Vector3 &s = p_aabb.size;
+	return s.x * s.y + s.y * s.z + s.z * s.x;
+}
 
-		return p_bb[p_from] - p_bvh;
-	} else if (p_size == 0) {
+int TriangleMesh::BVHBuilder::split(int p_from, int p_size, AABB &r_aabb) {
 
-		return -1;
-	}
+	BVH **list = &bb[p_from];
 
-	AABB aabb;
-	aabb = p_bb[p_from]->aabb;
+	r_aabb = list[0]->aabb;
+	AABB centers(list[0]->center, Vector3());
 	for (int i = 1; i < p_size; i++) {
-
-		aabb.merge_with(p_bb[p_from + i]->aabb);
+		r_aabb.merge_with(list[i]->aabb);
+		centers.expand_to(list[i]->center);
 	}
 
-	int li = aabb.get_longest_axis_index();
+	int axis = centers.get_longest_axis_index();
+	real_t extent = centers.size[axis];
+
+	if (extent > CMP_EPSILON) {
+
+		// Bin the faces by center and pick the split with the lowest surface area cost.
+		int counts[BVH_SAH_BINS] = {};
+		AABB bounds[BVH_SAH_BINS];
+		real_t scale = BVH_SAH_BINS / extent;
+		real_t begin = centers.position[axis];
 
-	switch (li) {
+		for (int i = 0; i < p_size; i++) {
+			int bin = MIN(int((list[i]->center[axis] - begin) * scale), BVH_SAH_BINS - 1);
+			if (counts[bin] == 0) {
+				bounds[bin] = list[i]->aabb;
+			} else {
+				bounds[bin].merge_with(list[i]->aabb);
+			}
+			counts[bin]++;
+		}
+
+		real_t right_cost[BVH_SAH_BINS];
+		AABB right;
+		int right_count = 0;
+		for (int i = BVH_SAH_BINS - 1; i > 0; i--) {
+			if (counts[i]) {
+				right = right_count ? right.merge(bounds[i]) : bounds[i];
+				right_count += counts[i];
+			}
+			right_cost[i] = right_count ? _bvh_surface(right) * right_count : 0;
+		}
+
+		int best_bin = -1;
+		real_t best_cost = 0;
+		AABB left;
+		int left_count = 0;
+		for (int i = 1; i < BVH_SAH_BINS; i++) {
+			if (counts[i - 1]) {
+				left = left_count ? left.merge(bounds[i - 1]) : bounds[i - 1];
+				left_count += counts[i - 1];
+			}
+			if (left_count == 0 || left_count == p_size) {
+				continue;
+			}
+			real_t cost = _bvh_surface(left) * left_count + right_cost[i];
+			if (best_bin < 0 || cost < best_cost) {
+				best_bin = i;
+				best_cost = cost;
+			}
+		}
+
+		if (best_bin > 0) {
+			int l = 0;
+			int r = p_size - 1;
+			while (l <= r) {
+				if (MIN(int((list[l]->center[axis] - begin) * scale), BVH_SAH_BINS - 1) < best_bin) {
+					l++;
+				} else {
+					SWAP(list[l], list[r]);
+					r--;
+				}
+			}
+			if (l > 0 && l < p_size) {
+				return l;
+			}
+		}
+	}
+
+	// All centers in the same bin, split at the median instead.
+	switch (axis) {
 
 		case Vector3::AXIS_X: {
 			SortArray<BVH *, BVHCmpX> sort_x;
-			sort_x.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
-			//sort_x.sort(&p_bb[p_from],p_size);
+			sort_x.nth_element(0, p_size, p_size / 2, list);
 		} break;
 		case Vector3::AXIS_Y: {
 			SortArray<BVH *, BVHCmpY> sort_y;
-			sort_y.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
-			//sort_y.sort(&p_bb[p_from],p_size);
+			sort_y.nth_element(0, p_size, p_size / 2, list);
 		} break;
 		case Vector3::AXIS_Z: {
 			SortArray<BVH *, BVHCmpZ> sort_z;
-			sort_z.nth_element(0, p_size, p_size / 2, &p_bb[p_from]);
-			//sort_z.sort(&p_bb[p_from],p_size);
-
+			sort_z.nth_element(0, p_size, p_size / 2, list);
 		} break;
 	}
 
-	int left = _create_bvh(p_bvh, p_bb, p_from, p_size / 2, p_depth + 1, max_depth, max_alloc);
-	int right = _create_bvh(p_bvh, p_bb, p_from + p_size / 2, p_size - p_size / 2, p_depth + 1, max_depth, max_alloc);
+	return p_size / 2;
+}
+
+void TriangleMesh::BVHBuilder::build(int p_from, int p_size, int p_node_from, int p_depth, int &r_max_depth, bool p_defer) {
+
+	if (p_depth > r_max_depth) {
+		r_max_depth = p_depth;
+	}
+
+	if (p_size <= 1) {
+		return;
+	}
 
-	int index = max_alloc++;
-	BVH *_new = &p_bvh[index];
-	_new->aabb = aabb;
-	_new->center = aabb.position + aabb.size * 0.5;
-	_new->face_index = -1;
-	_new->left = left;
-	_new->right = right;
+	if (p_defer && p_size <= BVH_TASK_SIZE) {
+		Task task;
+		task.from = p_from;
+		task.size = p_size;
+		task.node_from = p_node_from;
+		task.depth = p_depth;
+		task.max_depth = p_depth;
+		tasks.push_back(task);
+		return;
+	}
 
-	return index;
+	AABB aabb;
+	int left_size = split(p_from, p_size, aabb);
+
+	// The left subtree takes the first nodes of the range, the right one the next, and this node the last.
+	BVH &node = bvh[node_index(p_from, p_size, p_node_from)];
+	node.aabb = aabb;
+	node.center = aabb.position + aabb.size * 0.5;
+	node.face_index = -1;
+	node.left = node_index(p_from, left_size, p_node_from);
+	node.right = node_index(p_from + left_size, p_size - left_size, p_node_from + left_size - 1);
+
+	build(p_from, left_size, p_node_from, p_depth + 1, r_max_depth, p_defer);
+	build(p_from + left_size, p_size - left_size, p_node_from + left_size - 1, p_depth + 1, r_max_depth, p_defer);
+}
+
+void TriangleMesh::BVHBuilder::build_task(uint32_t p_index, void *p_userdata) {
+
+	Task &task = tasks[p_index];
+	build(task.from, task.size, task.node_from, task.depth, task.max_depth, false);
 }
 
 void TriangleMesh::get_indices(Vector<int> *r_triangles_indices) const {
@@ -118,7 +213,7 @@ void TriangleMesh::create(const Vector<Vector3> &p_faces) {
 	fc /= 3;
 	triangles.resize(fc);
 
-	bvh.resize(fc * 3); //will never be larger than this (todo make better)
+	bvh.resize(fc * 2 - 1); //each split adds one node
 	BVH *bw = bvh.ptrw();
 
 	{
@@ -178,11 +273,24 @@ void TriangleMesh::create(const Vector<Vector3> &p_faces) {
 		bwp[i] = &bw[i];
 	}
 
+	BVHBuilder builder;
+	builder.bvh = bw;
+	builder.bb = bwp;
+	builder.face_count = fc;
+
 	max_depth = 0;
-	int max_alloc = fc;
-	_create_bvh(bw, bwp, 0, fc, 1, max_depth, max_alloc);
 
-	bvh.resize(max_alloc); //resize back
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	bool threaded = pool && pool->get_thread_count() > 0 && fc > BVH_TASK_SIZE;
+
+	builder.build(0, fc, 0, 1, max_depth, threaded);
+
+	if (builder.tasks.size()) {
+		pool->do_work(builder.tasks.size(), &builder, &BVHBuilder::build_task, (void *)NULL);
+		for (uint32_t i = 0; i < builder.tasks.size(); i++) {
+			max_depth = MAX(max_depth, builder.tasks[i].max_depth);
+		}
+	}
 
 	valid = true;
 }
@@ -280,228 +388,115 @@ Vector3 TriangleMesh::get_area_normal(const AABB &p_aabb) const {
 	return n;
 }
 
-bool TriangleMesh::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
-
-	uint32_t *stack = (uint32_t *)alloca(sizeof(int) * max_depth);
-
-	enum {
-		TEST_AABB_BIT = 0,
-		VISIT_LEFT_BIT = 1,
-		VISIT_RIGHT_BIT = 2,
-		VISIT_DONE_BIT = 3,
-		VISITED_BIT_SHIFT = 29,
-		NODE_IDX_MASK = (1 << VISITED_BIT_SHIFT) - 1,
-		VISITED_BIT_MASK = ~NODE_IDX_MASK,
-
-	};
-
-	Vector3 n = (p_end - p_begin).normalized();
-	real_t d = 1e10;
-	bool inters = false;
-
-	int level = 0;
-
-	const Triangle *triangleptr = triangles.ptr();
-	const Vector3 *vertexptr = vertices.ptr();
-	const BVH *bvhptr = bvh.ptr();
-
-	int pos = bvh.size() - 1;
-
-	stack[0] = pos;
-	while (true) {
-
-		uint32_t node = stack[level] & NODE_IDX_MASK;
-		const BVH &b = bvhptr[node];
-		bool done = false;
-
-		switch (stack[level] >> VISITED_BIT_SHIFT) {
-			case TEST_AABB_BIT: {
-
-				bool valid = b.aabb.intersects_segment(p_begin, p_end);
-				//bool valid = b.aabb.intersects(ray_aabb);
-
-				if (!valid) {
-
-					stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-
-				} else {
-
-					if (b.face_index >= 0) {
+// Slab test against the inverse direction, limited to the closest hit found so far.
+static _FORCE_INLINE_ bool _bvh_ray_aabb(const AABB &p_aabb, const Vector3 &p_from, const Vector3 &p_dir, const Vector3 &p_inv_dir, real_t p_max) {
 
-						const Triangle &s = triangleptr[b.face_index];
-						Face3 f3(vertexptr[s.indices[0]], vertexptr[s.indices[1]], vertexptr[s.indices[2]]);
-
-						Vector3 res;
-
-						if (f3.intersects_segment(p_begin, p_end, &res)) {
-
-							real_t nd = n.dot(res);
-							if (nd < d) {
-
-								d = nd;
-								r_point = res;
-								r_normal = f3.get_plane().get_normal();
-								inters = true;
-							}
-						}
+	real_t t_near = 0;
+	real_t t_far = p_max;
 
-						stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-
-					} else {
-
-						stack[level] = (VISIT_LEFT_BIT << VISITED_BIT_SHIFT) | node;
-					}
-				}
-				continue;
-			}
-			case VISIT_LEFT_BIT: {
-
-				stack[level] = (VISIT_RIGHT_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.left | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_RIGHT_BIT: {
-
-				stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.right | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_DONE_BIT: {
-
-				if (level == 0) {
-					done = true;
-					break;
-				} else
-					level--;
-				continue;
+	for (int i = 0; i < 3; i++) {
+		if (p_dir[i] == 0) {
+			// Parallel to the slab, only the origin decides.
+			if (p_from[i] < p_aabb.position[i] - CMP_EPSILON || p_from[i] > p_aabb.position[i] + p_aabb.size[i] + CMP_EPSILON) {
+				return false;
 			}
+			continue;
+		}
+		real_t t1 = (p_aabb.position[i] - CMP_EPSILON - p_from[i]) * p_inv_dir[i];
+		real_t t2 = (p_aabb.position[i] + p_aabb.size[i] + CMP_EPSILON - p_from[i]) * p_inv_dir[i];
+		if (t1 > t2) {
+			SWAP(t1, t2);
+		}
+		t_near = MAX(t_near, t1);
+		t_far = MIN(t_far, t2);
+		if (t_near > t_far) {
+			return false;
 		}
-
-		if (done)
-			break;
-	}
-
-	if (inters) {
-
-		if (n.dot(r_normal) > 0)
-			r_normal = -r_normal;
 	}
 
-	return inters;
+	return true;
 }
 
-bool TriangleMesh::intersect_ray(const Vector3 &p_begin, const Vector3 &p_dir, Vector3 &r_point, Vector3 &r_normal) const {
+bool TriangleMesh::_intersect(const Vector3 &p_begin, const Vector3 &p_dir, real_t p_max, bool p_segment, Vector3 &r_point, Vector3 &r_normal) const {
 
-	uint32_t *stack = (uint32_t *)alloca(sizeof(int) * max_depth);
-
-	enum {
-		TEST_AABB_BIT = 0,
-		VISIT_LEFT_BIT = 1,
-		VISIT_RIGHT_BIT = 2,
-		VISIT_DONE_BIT = 3,
-		VISITED_BIT_SHIFT = 29,
-		NODE_IDX_MASK = (1 << VISITED_BIT_SHIFT) - 1,
-		VISITED_BIT_MASK = ~NODE_IDX_MASK,
+	if (!valid)
+		return false;
 
-	};
+	// Nearest child first, so nodes behind the closest hit are skipped early.
+	int *stack = (int *)alloca(sizeof(int) * (max_depth + 1));
+	int level = 0;
 
-	Vector3 n = p_dir;
-	real_t d = 1e20;
+	real_t dir_length_squared = p_dir.length_squared();
+	if (dir_length_squared == 0)
+		return false;
+	Vector3 inv_dir(p_dir.x != 0 ? 1.0 / p_dir.x : 0, p_dir.y != 0 ? 1.0 / p_dir.y : 0, p_dir.z != 0 ? 1.0 / p_dir.z : 0);
+	real_t d = p_max;
 	bool inters = false;
 
-	int level = 0;
-
 	const Triangle *triangleptr = triangles.ptr();
 	const Vector3 *vertexptr = vertices.ptr();
 	const BVH *bvhptr = bvh.ptr();
 
-	int pos = bvh.size() - 1;
+	stack[level++] = bvh.size() - 1;
 
-	stack[0] = pos;
-	while (true) {
+	while (level > 0) {
 
-		uint32_t node = stack[level] & NODE_IDX_MASK;
-		const BVH &b = bvhptr[node];
-		bool done = false;
+		const BVH &b = bvhptr[stack[--level]];
 
-		switch (stack[level] >> VISITED_BIT_SHIFT) {
-			case TEST_AABB_BIT: {
-
-				bool valid = b.aabb.intersects_ray(p_begin, p_dir);
-				if (!valid) {
-
-					stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-
-				} else {
-
-					if (b.face_index >= 0) {
+		if (!_bvh_ray_aabb(b.aabb, p_begin, p_dir, inv_dir, d)) {
+			continue;
+		}
 
-						const Triangle &s = triangleptr[b.face_index];
-						Face3 f3(vertexptr[s.indices[0]], vertexptr[s.indices[1]], vertexptr[s.indices[2]]);
+		if (b.face_index >= 0) {
 
-						Vector3 res;
+			const Triangle &s = triangleptr[b.face_index];
+			Face3 f3(vertexptr[s.indices[0]], vertexptr[s.indices[1]], vertexptr[s.indices[2]]);
 
-						if (f3.intersects_ray(p_begin, p_dir, &res)) {
+			Vector3 res;
+			bool hit = p_segment ? f3.intersects_segment(p_begin, p_begin + p_dir, &res) : f3.intersects_ray(p_begin, p_dir, &res);
 
-							real_t nd = n.dot(res);
-							if (nd < d) {
+			if (hit) {
 
-								d = nd;
-								r_point = res;
-								r_normal = f3.get_plane().get_normal();
-								inters = true;
-							}
-						}
-
-						stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
+				real_t nd = (res - p_begin).dot(p_dir) / dir_length_squared;
+				if (nd < d) {
 
-					} else {
-
-						stack[level] = (VISIT_LEFT_BIT << VISITED_BIT_SHIFT) | node;
-					}
+					d = nd;
+					r_point = res;
+					r_normal = f3.get_plane().get_normal();
+					inters = true;
 				}
-				continue;
-			}
-			case VISIT_LEFT_BIT: {
-
-				stack[level] = (VISIT_RIGHT_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.left | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_RIGHT_BIT: {
-
-				stack[level] = (VISIT_DONE_BIT << VISITED_BIT_SHIFT) | node;
-				stack[level + 1] = b.right | TEST_AABB_BIT;
-				level++;
-				continue;
-			}
-			case VISIT_DONE_BIT: {
-
-				if (level == 0) {
-					done = true;
-					break;
-				} else
-					level--;
-				continue;
 			}
+			continue;
 		}
 
-		if (done)
-			break;
+		if ((bvhptr[b.left].center - bvhptr[b.right].center).dot(p_dir) > 0) {
+			stack[level++] = b.left;
+			stack[level++] = b.right;
+		} else {
+			stack[level++] = b.right;
+			stack[level++] = b.left;
+		}
 	}
 
 	if (inters) {
 
-		if (n.dot(r_normal) > 0)
+		if (p_dir.dot(r_normal) > 0)
 			r_normal = -r_normal;
 	}
 
 	return inters;
 }
 
+bool TriangleMesh::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
+
+	return _intersect(p_begin, p_end - p_begin, 1.0, true, r_point, r_normal);
+}
+
+bool TriangleMesh::intersect_ray(const Vector3 &p_begin, const Vector3 &p_dir, Vector3 &r_point, Vector3 &r_normal) const {
+
+	return _intersect(p_begin, p_dir, 1e20, false, r_point, r_normal);
+}
+
 bool TriangleMesh::intersect_convex_shape(const Plane *p_planes, int p_plane_count) const {
 	uint32_t *stack = (uint32_t *)alloca(sizeof(int) * max_depth);
 
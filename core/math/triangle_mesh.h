@@ -31,6 +31,7 @@
 #ifndef TRIANGLE_MESH_H
 #define TRIANGLE_MESH_H
 
+#include "core/local_vector.h"
 #include "core/math/face3.h"
 #include "core/reference.h"
 
@@ -80,12 +81,38 @@ class TriangleMesh : public Reference {
 		}
 	};
 
-	int _create_bvh(BVH *p_bvh, BVH **p_bb, int p_from, int p_size, int p_depth, int &max_depth, int &max_alloc);
+	// Builds the tree with binned SAH splits. Every subtree owns a fixed range of
+	// nodes, so once the top levels are split the subtrees are built in parallel.
+	struct BVHBuilder {
+
+		struct Task {
+			int from;
+			int size;
+			int node_from;
+			int depth;
+			int max_depth;
+		};
+
+		BVH *bvh;
+		BVH **bb;
+		int face_count;
+		LocalVector<Task> tasks;
+
+		_FORCE_INLINE_ int node_index(int p_from, int p_size, int p_node_from) const {
+			return p_size == 1 ? bb[p_from] - bvh : face_count + p_node_from + p_size - 2;
+		}
+
+		int split(int p_from, int p_size, AABB &r_aabb);
+		void build(int p_from, int p_size, int p_node_from, int p_depth, int &r_max_depth, bool p_defer);
+		void build_task(uint32_t p_index, void *p_userdata);
+	};
 
 	Vector<BVH> bvh;
 	int max_depth;
 	bool valid;
 
+	bool _intersect(const Vector3 &p_begin, const Vector3 &p_dir, real_t p_max, bool p_segment, Vector3 &r_point, Vector3 &r_normal) const;
+
 public:
 	bool is_valid() const;
 	bool intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const;
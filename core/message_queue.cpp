@@ -31,16 +31,116 @@
 #include "message_queue.h"
 
 #include "core/core_string_names.h"
+#include "core/os/thread.h"
 #include "core/project_settings.h"
 #include "core/script_language.h"
 
 MessageQueue *MessageQueue::singleton = NULL;
+uint64_t MessageQueue::last_generation = 0;
+
+// Cached per thread, the generation check makes it invalid once the MessageQueue it came from is gone.
+struct MessageQueueThreadCache {
+	uint64_t generation = 0;
+	void *queue = nullptr;
+};
+
+static thread_local MessageQueueThreadCache thread_queue_cache;
 
 MessageQueue *MessageQueue::get_singleton() {
 
 	return singleton;
 }
 
+MessageQueue::ThreadQueue *MessageQueue::_get_thread_queue() {
+
+	if (likely(thread_queue_cache.generation == generation)) {
+		return (ThreadQueue *)thread_queue_cache.queue;
+	}
+
+	_THREAD_SAFE_METHOD_
+
+	uint64_t thread_id = Thread::get_caller_id();
+	ThreadQueue *queue = NULL;
+
+	//thread IDs can be reused, in which case the queue of the finished thread is taken over
+	for (int i = 0; i < thread_queues.size(); i++) {
+		if (thread_queues[i]->thread_id == thread_id) {
+			queue = thread_queues[i];
+			break;
+		}
+	}
+
+	if (!queue) {
+		queue = memnew(ThreadQueue);
+		queue->thread_id = thread_id;
+		thread_queues.push_back(queue);
+	}
+
+	thread_queue_cache.generation = generation;
+	thread_queue_cache.queue = queue;
+
+	return queue;
+}
+
+uint8_t *MessageQueue::_alloc_message(ThreadQueue *p_queue, uint32_t p_room) {
+
+	//must be called with the queue locked
+	if (buffer_limit && p_queue->used + p_room > buffer_limit) {
+		return NULL;
+	}
+
+	if (!p_queue->last || p_queue->last->end + p_room > p_queue->last->size) {
+
+		Segment *segment = NULL;
+		if (p_queue->spare && p_queue->spare->size >= p_room) {
+			segment = p_queue->spare;
+			p_queue->spare = segment->next;
+		} else {
+			uint32_t size = MAX(p_room, (uint32_t)SEGMENT_SIZE);
+			segment = (Segment *)memalloc(sizeof(Segment) + size);
+			segment->size = size;
+		}
+
+		segment->next = NULL;
+		segment->end = 0;
+
+		if (p_queue->last) {
+			p_queue->last->next = segment;
+		} else {
+			p_queue->first = segment;
+		}
+		p_queue->last = segment;
+	}
+
+	uint8_t *ptr = p_queue->last->get_data() + p_queue->last->end;
+	p_queue->last->end += p_room;
+	p_queue->used += p_room;
+	p_queue->message_count++;
+
+	return ptr;
+}
+
+void MessageQueue::_free_message(Message *p_message) {
+
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int i = 0; i < p_message->args; i++) {
+			args[i].~Variant();
+		}
+	}
+
+	p_message->~Message();
+}
+
+void MessageQueue::_free_segments(Segment *p_segment) {
+
+	while (p_segment) {
+		Segment *next = p_segment->next;
+		memfree(p_segment);
+		p_segment = next;
+	}
+}
+
 Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
 
 	return push_callable(Callable(p_id, p_method), p_args, p_argcount, p_show_error);
@@ -63,11 +163,16 @@ Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, VARIANT
 
 Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
 
-	_THREAD_SAFE_METHOD_
+	ThreadQueue *queue = _get_thread_queue();
+
+	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
+
+	queue->lock.lock();
 
-	uint8_t room_needed = sizeof(Message) + sizeof(Variant);
+	uint8_t *buffer = _alloc_message(queue, room_needed);
 
-	if ((buffer_end + room_needed) >= buffer_size) {
+	if (!buffer) {
+		queue->lock.unlock();
 		String type;
 		if (ObjectDB::get_instance(p_id))
 			type = ObjectDB::get_instance(p_id)->get_class();
@@ -76,42 +181,46 @@ Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Vari
 		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Message *msg = memnew_placement(buffer, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
 	msg->type = TYPE_SET;
 
-	buffer_end += sizeof(Message);
-
-	Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-	buffer_end += sizeof(Variant);
+	Variant *v = memnew_placement(buffer + sizeof(Message), Variant);
 	*v = p_value;
 
+	queue->lock.unlock();
+
 	return OK;
 }
 
 Error MessageQueue::push_notification(ObjectID p_id, int p_notification) {
 
-	_THREAD_SAFE_METHOD_
-
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
 
-	uint8_t room_needed = sizeof(Message);
+	ThreadQueue *queue = _get_thread_queue();
+
+	uint32_t room_needed = sizeof(Message);
+
+	queue->lock.lock();
 
-	if ((buffer_end + room_needed) >= buffer_size) {
+	uint8_t *buffer = _alloc_message(queue, room_needed);
+
+	if (!buffer) {
+		queue->lock.unlock();
 		print_line("Failed notification: " + itos(p_notification) + " target ID: " + itos(p_id));
 		statistics();
 		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Message *msg = memnew_placement(buffer, Message);
 
 	msg->type = TYPE_NOTIFICATION;
 	msg->callable = Callable(p_id, CoreStringNames::get_singleton()->notification); //name is meaningless but callable needs it
 	//msg->target;
 	msg->notification = p_notification;
 
-	buffer_end += sizeof(Message);
+	queue->lock.unlock();
 
 	return OK;
 }
@@ -132,32 +241,38 @@ Error MessageQueue::push_set(Object *p_object, const StringName &p_prop, const V
 
 Error MessageQueue::push_callable(const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
 
-	_THREAD_SAFE_METHOD_
+	ThreadQueue *queue = _get_thread_queue();
+
+	uint32_t room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
+
+	queue->lock.lock();
 
-	int room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
+	uint8_t *buffer = _alloc_message(queue, room_needed);
 
-	if ((buffer_end + room_needed) >= buffer_size) {
+	if (!buffer) {
+		queue->lock.unlock();
 		print_line("Failed method: " + p_callable);
 		statistics();
 		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Message *msg = memnew_placement(buffer, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
 	msg->type = TYPE_CALL;
 	if (p_show_error)
 		msg->type |= FLAG_SHOW_ERROR;
 
-	buffer_end += sizeof(Message);
+	Variant *args = (Variant *)(buffer + sizeof(Message));
 
 	for (int i = 0; i < p_argcount; i++) {
 
-		Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-		buffer_end += sizeof(Variant);
+		Variant *v = memnew_placement(&args[i], Variant);
 		*v = *p_args[i];
 	}
 
+	queue->lock.unlock();
+
 	return OK;
 }
 
@@ -167,57 +282,75 @@ void MessageQueue::statistics() {
 	Map<int, int> notify_count;
 	Map<Callable, int> call_count;
 	int null_count = 0;
+	uint32_t total_bytes = 0;
 
-	uint32_t read_pos = 0;
-	while (read_pos < buffer_end) {
-		Message *message = (Message *)&buffer[read_pos];
+	_THREAD_SAFE_LOCK_
+	Vector<ThreadQueue *> queues = thread_queues;
+	_THREAD_SAFE_UNLOCK_
 
-		Object *target = message->callable.get_object();
+	for (int i = 0; i < queues.size(); i++) {
 
-		if (target != NULL) {
+		ThreadQueue *queue = queues[i];
+		queue->lock.lock();
 
-			switch (message->type & FLAG_MASK) {
+		total_bytes += queue->used;
 
-				case TYPE_CALL: {
+		for (Segment *segment = queue->first; segment; segment = segment->next) {
 
-					if (!call_count.has(message->callable))
-						call_count[message->callable] = 0;
+			uint32_t read_pos = 0;
+			while (read_pos < segment->end) {
+				Message *message = (Message *)&segment->get_data()[read_pos];
 
-					call_count[message->callable]++;
+				Object *target = message->callable.get_object();
 
-				} break;
-				case TYPE_NOTIFICATION: {
+				if (target != NULL) {
 
-					if (!notify_count.has(message->notification))
-						notify_count[message->notification] = 0;
+					switch (message->type & FLAG_MASK) {
 
-					notify_count[message->notification]++;
+						case TYPE_CALL: {
 
-				} break;
-				case TYPE_SET: {
+							if (!call_count.has(message->callable))
+								call_count[message->callable] = 0;
 
-					StringName t = message->callable.get_method();
-					if (!set_count.has(t))
-						set_count[t] = 0;
+							call_count[message->callable]++;
 
-					set_count[t]++;
+						} break;
+						case TYPE_NOTIFICATION: {
 
-				} break;
-			}
+							if (!notify_count.has(message->notification))
+								notify_count[message->notification] = 0;
 
-		} else {
-			//object was deleted
-			print_line("Object was deleted while awaiting a callback");
+							notify_count[message->notification]++;
+
+						} break;
+						case TYPE_SET: {
+
+							StringName t = message->callable.get_method();
+							if (!set_count.has(t))
+								set_count[t] = 0;
+
+							set_count[t]++;
+
+						} break;
+					}
 
-			null_count++;
+				} else {
+					//object was deleted
+					print_line("Object was deleted while awaiting a callback");
+
+					null_count++;
+				}
+
+				read_pos += sizeof(Message);
+				if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
+					read_pos += sizeof(Variant) * message->args;
+			}
 		}
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-			read_pos += sizeof(Variant) * message->args;
+		queue->lock.unlock();
 	}
 
-	print_line("TOTAL BYTES: " + itos(buffer_end));
+	print_line("TOTAL BYTES: " + itos(total_bytes));
 	print_line("NULL count: " + itos(null_count));
 
 	for (Map<StringName, int>::Element *E = set_count.front(); E; E = E->next()) {
@@ -238,6 +371,11 @@ int MessageQueue::get_max_buffer_usage() const {
 	return buffer_max_used;
 }
 
+int MessageQueue::get_max_message_count() const {
+
+	return message_count_max;
+}
+
 void MessageQueue::_call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error) {
 
 	const Variant **argptrs = NULL;
@@ -259,13 +397,6 @@ void MessageQueue::_call_function(const Callable &p_callable, const Variant *p_a
 
 void MessageQueue::flush() {
 
-	if (buffer_end > buffer_max_used) {
-		buffer_max_used = buffer_end;
-	}
-
-	uint32_t read_pos = 0;
-
-	//using reverse locking strategy
 	_THREAD_SAFE_LOCK_
 
 	if (flushing) {
@@ -274,64 +405,106 @@ void MessageQueue::flush() {
 	}
 	flushing = true;
 
-	while (read_pos < buffer_end) {
+	_THREAD_SAFE_UNLOCK_
+
+	//each thread queue is drained in order, messages pushed while flushing are run in the next pass
+	bool pending = true;
+	while (pending) {
+
+		pending = false;
 
-		//lock on each iteration, so a call can re-add itself to the message queue
+		_THREAD_SAFE_LOCK_
+		Vector<ThreadQueue *> queues = thread_queues;
+		_THREAD_SAFE_UNLOCK_
 
-		Message *message = (Message *)&buffer[read_pos];
+		uint32_t used = 0;
+		uint32_t message_count = 0;
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-			advance += sizeof(Variant) * message->args;
+		for (int i = 0; i < queues.size(); i++) {
 
-		//pre-advance so this function is reentrant
-		read_pos += advance;
+			ThreadQueue *queue = queues[i];
 
-		_THREAD_SAFE_UNLOCK_
+			//take the whole chain, so the thread can keep pushing while it's processed
+			queue->lock.lock();
+			Segment *chain = queue->first;
+			used += queue->used;
+			message_count += queue->message_count;
+			queue->first = NULL;
+			queue->last = NULL;
+			queue->used = 0;
+			queue->message_count = 0;
+			queue->lock.unlock();
 
-		Object *target = message->callable.get_object();
+			if (!chain) {
+				continue;
+			}
 
-		if (target != NULL) {
+			pending = true;
 
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
+			Segment *last = chain;
+			for (Segment *segment = chain; segment; segment = segment->next) {
 
-					Variant *args = (Variant *)(message + 1);
+				last = segment;
 
-					// messages don't expect a return value
+				uint32_t read_pos = 0;
+				while (read_pos < segment->end) {
 
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+					Message *message = (Message *)&segment->get_data()[read_pos];
 
-				} break;
-				case TYPE_NOTIFICATION: {
+					read_pos += sizeof(Message);
+					if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
+						read_pos += sizeof(Variant) * message->args;
 
-					// messages don't expect a return value
-					target->notification(message->notification);
+					Object *target = message->callable.get_object();
 
-				} break;
-				case TYPE_SET: {
+					if (target != NULL) {
 
-					Variant *arg = (Variant *)(message + 1);
-					// messages don't expect a return value
-					target->set(message->callable.get_method(), *arg);
+						switch (message->type & FLAG_MASK) {
+							case TYPE_CALL: {
 
-				} break;
-			}
-		}
+								Variant *args = (Variant *)(message + 1);
+
+								// messages don't expect a return value
+
+								_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+
+							} break;
+							case TYPE_NOTIFICATION: {
+
+								// messages don't expect a return value
+								target->notification(message->notification);
+
+							} break;
+							case TYPE_SET: {
+
+								Variant *arg = (Variant *)(message + 1);
+								// messages don't expect a return value
+								target->set(message->callable.get_method(), *arg);
+
+							} break;
+						}
+					}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int i = 0; i < message->args; i++) {
-				args[i].~Variant();
+					_free_message(message);
+				}
 			}
-		}
 
-		message->~Message();
+			//give the segments back for reuse
+			queue->lock.lock();
+			last->next = queue->spare;
+			queue->spare = chain;
+			queue->lock.unlock();
+		}
 
-		_THREAD_SAFE_LOCK_
+		if (used > buffer_max_used) {
+			buffer_max_used = used;
+		}
+		if (message_count > message_count_max) {
+			message_count_max = message_count;
+		}
 	}
 
-	buffer_end = 0; // reset buffer
+	_THREAD_SAFE_LOCK_
 	flushing = false;
 	_THREAD_SAFE_UNLOCK_
 }
@@ -347,34 +520,40 @@ MessageQueue::MessageQueue() {
 	singleton = this;
 	flushing = false;
 
-	buffer_end = 0;
+	generation = ++last_generation;
+
 	buffer_max_used = 0;
-	buffer_size = GLOBAL_DEF_RST("memory/limits/message_queue/max_size_kb", DEFAULT_QUEUE_SIZE_KB);
-	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/message_queue/max_size_kb", PropertyInfo(Variant::INT, "memory/limits/message_queue/max_size_kb", PROPERTY_HINT_RANGE, "1024,4096,1,or_greater"));
-	buffer_size *= 1024;
-	buffer = memnew_arr(uint8_t, buffer_size);
+	message_count_max = 0;
+	buffer_limit = GLOBAL_DEF_RST("memory/limits/message_queue/max_size_kb", DEFAULT_QUEUE_SIZE_KB);
+	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/message_queue/max_size_kb", PropertyInfo(Variant::INT, "memory/limits/message_queue/max_size_kb", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"));
+	buffer_limit *= 1024;
 }
 
 MessageQueue::~MessageQueue() {
 
-	uint32_t read_pos = 0;
+	for (int i = 0; i < thread_queues.size(); i++) {
+
+		ThreadQueue *queue = thread_queues[i];
+
+		for (Segment *segment = queue->first; segment; segment = segment->next) {
 
-	while (read_pos < buffer_end) {
+			uint32_t read_pos = 0;
+			while (read_pos < segment->end) {
 
-		Message *message = (Message *)&buffer[read_pos];
-		Variant *args = (Variant *)(message + 1);
-		int argc = message->args;
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			for (int i = 0; i < argc; i++)
-				args[i].~Variant();
+				Message *message = (Message *)&segment->get_data()[read_pos];
+
+				read_pos += sizeof(Message);
+				if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
+					read_pos += sizeof(Variant) * message->args;
+
+				_free_message(message);
+			}
 		}
-		message->~Message();
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-			read_pos += sizeof(Variant) * message->args;
+		_free_segments(queue->first);
+		_free_segments(queue->spare);
+		memdelete(queue);
 	}
 
 	singleton = NULL;
-	memdelete_arr(buffer);
 }
@@ -33,6 +33,7 @@
 
 #include "core/object.h"
 #include "core/os/thread_safe.h"
+#include "core/spin_lock.h"
 
 class MessageQueue {
 
@@ -40,7 +41,8 @@ class MessageQueue {
 
 	enum {
 
-		DEFAULT_QUEUE_SIZE_KB = 1024
+		DEFAULT_QUEUE_SIZE_KB = 0, //no limit
+		SEGMENT_SIZE = 64 * 1024
 	};
 
 	enum {
@@ -62,14 +64,43 @@ class MessageQueue {
 		};
 	};
 
-	uint8_t *buffer;
-	uint32_t buffer_end;
+	// Messages are stored in chains of segments, which grow as needed.
+	struct Segment {
+		Segment *next;
+		uint32_t size;
+		uint32_t end;
+
+		_FORCE_INLINE_ uint8_t *get_data() { return (uint8_t *)(this + 1); }
+	};
+
+	// Every thread pushing messages gets its own queue, so producers only
+	// contend with flush() taking their chain, never with each other.
+	struct ThreadQueue {
+		SpinLock lock;
+		uint64_t thread_id = 0;
+		Segment *first = nullptr;
+		Segment *last = nullptr;
+		Segment *spare = nullptr; //flushed segments, kept for reuse
+		uint32_t used = 0;
+		uint32_t message_count = 0;
+	};
+
+	Vector<ThreadQueue *> thread_queues; //only modified with the mutex held
+	uint64_t generation;
+
 	uint32_t buffer_max_used;
-	uint32_t buffer_size;
+	uint32_t message_count_max;
+	uint32_t buffer_limit;
+
+	ThreadQueue *_get_thread_queue();
+	uint8_t *_alloc_message(ThreadQueue *p_queue, uint32_t p_room);
+	void _free_message(Message *p_message);
+	void _free_segments(Segment *p_segment);
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
 	static MessageQueue *singleton;
+	static uint64_t last_generation;
 
 	bool flushing;
 
@@ -92,6 +123,7 @@ public:
 	bool is_flushing() const;
 
 	int get_max_buffer_usage() const;
+	int get_max_message_count() const;
 
 	MessageQueue();
 	~MessageQueue();
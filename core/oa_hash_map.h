@@ -43,8 +43,13 @@
  * and enables faster lookups. Backward shift deletion is employed to further
  * improve the performance and to avoid infinite loops in rare cases.
  *
+ * Hashes, keys and values are kept in separate arrays, so probing only touches
+ * the hashes until one matches. The capacity is always a power of two. Only
+ * occupied slots hold constructed keys and values.
+ *
  * The entries are stored inplace, so huge keys or values might fill cache lines
- * a lot faster.
+ * a lot faster. Entries move while the map is modified, so pointers returned by
+ * lookup_ptr() are only valid until the next insertion or removal.
  */
 template <class TKey, class TValue,
 		class Hasher = HashMapHasherDefault,
@@ -61,6 +66,7 @@ private:
 	uint32_t num_elements;
 
 	static const uint32_t EMPTY_HASH = 0;
+	static const uint32_t MIN_CAPACITY = 4;
 
 	_FORCE_INLINE_ uint32_t _hash(const TKey &p_key) const {
 		uint32_t hash = Hasher::hash(p_key);
@@ -73,8 +79,8 @@ private:
 	}
 
 	_FORCE_INLINE_ uint32_t _get_probe_length(uint32_t p_pos, uint32_t p_hash) const {
-		uint32_t original_pos = p_hash % capacity;
-		return (p_pos - original_pos + capacity) % capacity;
+		uint32_t original_pos = p_hash & (capacity - 1);
+		return (p_pos - original_pos) & (capacity - 1);
 	}
 
 	_FORCE_INLINE_ void _construct(uint32_t p_pos, uint32_t p_hash, const TKey &p_key, const TValue &p_value) {
@@ -87,24 +93,27 @@ private:
 
 	bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
 		uint32_t hash = _hash(p_key);
-		uint32_t pos = hash % capacity;
+		uint32_t mask = capacity - 1;
+		uint32_t pos = hash & mask;
 		uint32_t distance = 0;
 
 		while (42) {
-			if (hashes[pos] == EMPTY_HASH) {
+			uint32_t existing = hashes[pos];
+			if (existing == EMPTY_HASH) {
 				return false;
 			}
 
-			if (distance > _get_probe_length(pos, hashes[pos])) {
+			// entries are sorted by probing distance, once this one is closer to home the key can't be further on
+			if (distance > ((pos - existing) & mask)) {
 				return false;
 			}
 
-			if (hashes[pos] == hash && Comparator::compare(keys[pos], p_key)) {
+			if (existing == hash && Comparator::compare(keys[pos], p_key)) {
 				r_pos = pos;
 				return true;
 			}
 
-			pos = (pos + 1) % capacity;
+			pos = (pos + 1) & mask;
 			distance++;
 		}
 	}
@@ -113,8 +122,26 @@ private:
 
 		uint32_t hash = p_hash;
 		uint32_t distance = 0;
-		uint32_t pos = hash % capacity;
+		uint32_t pos = hash & (capacity - 1);
+
+		while (42) {
+			if (hashes[pos] == EMPTY_HASH) {
+				_construct(pos, hash, p_key, p_value);
+
+				return;
+			}
+
+			// not an empty slot, let's check the probing length of the existing one
+			uint32_t existing_probe_len = _get_probe_length(pos, hashes[pos]);
+			if (existing_probe_len < distance) {
+				break;
+			}
+
+			pos = (pos + 1) & (capacity - 1);
+			distance++;
+		}
 
+		// the new entry takes this slot, what was there moves further, only copied once evicted
 		TKey key = p_key;
 		TValue value = p_value;
 
@@ -125,7 +152,6 @@ private:
 				return;
 			}
 
-			// not an empty slot, let's check the probing length of the existing one
 			uint32_t existing_probe_len = _get_probe_length(pos, hashes[pos]);
 			if (existing_probe_len < distance) {
 				SWAP(hash, hashes[pos]);
@@ -134,28 +160,38 @@ private:
 				distance = existing_probe_len;
 			}
 
-			pos = (pos + 1) % capacity;
+			pos = (pos + 1) & (capacity - 1);
 			distance++;
 		}
 	}
 
+	static uint32_t _get_capacity_for(uint32_t p_capacity) {
+		return next_power_of_2(MAX(p_capacity, MIN_CAPACITY));
+	}
+
+	void _allocate(uint32_t p_capacity) {
+
+		capacity = p_capacity;
+		num_elements = 0;
+
+		keys = (TKey *)Memory::alloc_static(sizeof(TKey) * capacity);
+		values = (TValue *)Memory::alloc_static(sizeof(TValue) * capacity);
+		hashes = (uint32_t *)Memory::alloc_static(sizeof(uint32_t) * capacity);
+
+		for (uint32_t i = 0; i < capacity; i++) {
+			hashes[i] = EMPTY_HASH;
+		}
+	}
+
 	void _resize_and_rehash(uint32_t p_new_capacity) {
 
 		uint32_t old_capacity = capacity;
-		capacity = p_new_capacity;
 
 		TKey *old_keys = keys;
 		TValue *old_values = values;
 		uint32_t *old_hashes = hashes;
 
-		num_elements = 0;
-		keys = memnew_arr(TKey, capacity);
-		values = memnew_arr(TValue, capacity);
-		hashes = memnew_arr(uint32_t, capacity);
-
-		for (uint32_t i = 0; i < capacity; i++) {
-			hashes[i] = 0;
-		}
+		_allocate(p_new_capacity);
 
 		for (uint32_t i = 0; i < old_capacity; i++) {
 			if (old_hashes[i] == EMPTY_HASH) {
@@ -163,11 +199,13 @@ private:
 			}
 
 			_insert_with_hash(old_hashes[i], old_keys[i], old_values[i]);
+			old_keys[i].~TKey();
+			old_values[i].~TValue();
 		}
 
-		memdelete_arr(old_keys);
-		memdelete_arr(old_values);
-		memdelete_arr(old_hashes);
+		Memory::free_static(old_keys);
+		Memory::free_static(old_values);
+		Memory::free_static(old_hashes);
 	}
 
 	void _resize_and_rehash() {
@@ -200,7 +238,8 @@ public:
 
 	void insert(const TKey &p_key, const TValue &p_value) {
 
-		if (num_elements + 1 > 0.9 * capacity) {
+		// at most 3/4 full, probe sequences stay short
+		if ((num_elements + 1) * 4 > capacity * 3) {
 			_resize_and_rehash();
 		}
 
@@ -214,8 +253,7 @@ public:
 		bool exists = _lookup_pos(p_key, pos);
 
 		if (exists) {
-			values[pos].~TValue();
-			memnew_placement(&values[pos], TValue(p_data));
+			values[pos] = p_data;
 		} else {
 			insert(p_key, p_data);
 		}
@@ -232,8 +270,7 @@ public:
 		bool exists = _lookup_pos(p_key, pos);
 
 		if (exists) {
-			r_data.~TValue();
-			memnew_placement(&r_data, TValue(values[pos]));
+			r_data = values[pos];
 			return true;
 		}
 
@@ -269,14 +306,14 @@ public:
 			return;
 		}
 
-		uint32_t next_pos = (pos + 1) % capacity;
+		uint32_t next_pos = (pos + 1) & (capacity - 1);
 		while (hashes[next_pos] != EMPTY_HASH &&
 				_get_probe_length(next_pos, hashes[next_pos]) != 0) {
 			SWAP(hashes[next_pos], hashes[pos]);
 			SWAP(keys[next_pos], keys[pos]);
 			SWAP(values[next_pos], values[pos]);
 			pos = next_pos;
-			next_pos = (pos + 1) % capacity;
+			next_pos = (pos + 1) & (capacity - 1);
 		}
 
 		hashes[pos] = EMPTY_HASH;
@@ -293,14 +330,24 @@ public:
 	 **/
 	void reserve(uint32_t p_new_capacity) {
 		ERR_FAIL_COND(p_new_capacity < capacity);
-		_resize_and_rehash(p_new_capacity);
+		_resize_and_rehash(_get_capacity_for(p_new_capacity));
+	}
+
+	/**
+	 * makes sure that p_count elements fit without rehashing.
+	 **/
+	void reserve_elements(uint32_t p_count) {
+		uint32_t new_capacity = _get_capacity_for((p_count * 4 + 2) / 3);
+		if (new_capacity > capacity) {
+			_resize_and_rehash(new_capacity);
+		}
 	}
 
 	struct Iterator {
 		bool valid;
 
 		const TKey *key;
-		const TValue *value;
+		TValue *value;
 
 	private:
 		uint32_t pos;
@@ -349,23 +396,16 @@ public:
 
 	OAHashMap(uint32_t p_initial_capacity = 64) {
 
-		capacity = p_initial_capacity;
-		num_elements = 0;
-
-		keys = memnew_arr(TKey, p_initial_capacity);
-		values = memnew_arr(TValue, p_initial_capacity);
-		hashes = memnew_arr(uint32_t, p_initial_capacity);
-
-		for (uint32_t i = 0; i < p_initial_capacity; i++) {
-			hashes[i] = EMPTY_HASH;
-		}
+		_allocate(_get_capacity_for(p_initial_capacity));
 	}
 
 	~OAHashMap() {
 
-		memdelete_arr(keys);
-		memdelete_arr(values);
-		memdelete_arr(hashes);
+		clear();
+
+		Memory::free_static(keys);
+		Memory::free_static(values);
+		Memory::free_static(hashes);
 	}
 };
 
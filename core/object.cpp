@@ -1097,12 +1097,6 @@ bool Object::_has_user_signal(const StringName &p_name) const {
 	return signal_map[p_name].user.name.length() > 0;
 }
 
-struct _ObjectSignalDisconnectData {
-
-	StringName signal;
-	Callable callable;
-};
-
 Variant Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 
 	r_error.error = Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
@@ -1147,14 +1141,18 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 		return ERR_UNAVAILABLE;
 	}
 
-	List<_ObjectSignalDisconnectData> disconnect_data;
-
-	//copy on write will ensure that disconnecting the signal or even deleting the object will not affect the signal calling.
-	//this happens automatically and will not change the performance of calling.
-	//awesome, isn't it?
-	VMap<Callable, SignalData::Slot> slot_map = s->slot_map;
+	//slots are walked in place, no copy is made. while this runs, disconnected slots are only
+	//marked as removed, and slots connected meanwhile are marked so this emission skips them.
+	if (s->emitting == 0) {
+		s->emit_serial = 0;
+	}
+	uint32_t serial = ++s->emit_serial;
+	s->emitting++;
 
-	int ssize = slot_map.size();
+	SignalEmission emission;
+	emission.prev = _signal_emission;
+	emission.freed = false;
+	_signal_emission = &emission;
 
 	OBJ_DEBUG_LOCK
 
@@ -1162,84 +1160,143 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 
 	Error err = OK;
 
+	int ssize = s->slot_map.size();
+	int visited = 0;
+
 	for (int i = 0; i < ssize; i++) {
 
-		const Connection &c = slot_map.getv(i).conn;
+		SignalData::Slot *slot = &s->slot_map.getv(i);
+		if (slot->connected_at >= serial) {
+			continue; //connected after this emission started
+		}
+		visited++;
 
-		Object *target = c.callable.get_object();
+		if (slot->removed) {
+			continue;
+		}
+
+		Object *target = slot->conn.callable.get_object();
 		if (!target) {
 			// Target might have been deleted during signal callback, this is expected and OK.
 			continue;
 		}
 
+		uint32_t flags = slot->conn.flags;
 		const Variant **args = p_args;
 		int argc = p_argcount;
 
-		if (c.binds.size()) {
+		//keep the binds alive even if the slot is replaced during the call
+		Vector<Variant> binds = slot->conn.binds;
+
+		if (binds.size()) {
 			//handle binds
-			bind_mem.resize(p_argcount + c.binds.size());
+			bind_mem.resize(p_argcount + binds.size());
 
 			for (int j = 0; j < p_argcount; j++) {
 				bind_mem.write[j] = p_args[j];
 			}
-			for (int j = 0; j < c.binds.size(); j++) {
-				bind_mem.write[p_argcount + j] = &c.binds[j];
+			for (int j = 0; j < binds.size(); j++) {
+				bind_mem.write[p_argcount + j] = &binds[j];
 			}
 
 			args = (const Variant **)bind_mem.ptr();
 			argc = bind_mem.size();
 		}
 
-		if (c.flags & CONNECT_DEFERRED) {
-			MessageQueue::get_singleton()->push_callable(c.callable, args, argc, true);
+		if (flags & CONNECT_DEFERRED) {
+			MessageQueue::get_singleton()->push_callable(slot->conn.callable, args, argc, true);
 		} else {
 			Callable::CallError ce;
-			_emitting = true;
-			Variant ret;
-			c.callable.call(args, argc, ret, ce);
-			_emitting = false;
+
+			if (slot->method && !target->script_instance) {
+				//a bound method nothing can override, skip the lookups Callable::call would do
+#ifdef DEBUG_ENABLED
+				_ObjectDebugLock target_lock(target);
+#endif
+				slot->method->call(target, args, argc, ce);
+			} else {
+				Variant ret;
+				slot->conn.callable.call(args, argc, ret, ce);
+			}
+
+			if (emission.freed) {
+				//the callback freed this object, nothing left to emit from
+				return err;
+			}
+
+			if (s->slot_map.size() != ssize) {
+				//slots were connected during the call, find this one again
+				ssize = s->slot_map.size();
+				int seen = 0;
+				for (i = 0; seen < visited; i++) {
+					if (s->slot_map.getv(i).connected_at < serial) {
+						seen++;
+					}
+				}
+				i--;
+				slot = &s->slot_map.getv(i);
+			}
 
 			if (ce.error != Callable::CallError::CALL_OK) {
 #ifdef DEBUG_ENABLED
-				if (c.flags & CONNECT_PERSIST && Engine::get_singleton()->is_editor_hint() && (script.is_null() || !Ref<Script>(script)->is_tool()))
+				if (flags & CONNECT_PERSIST && Engine::get_singleton()->is_editor_hint() && (script.is_null() || !Ref<Script>(script)->is_tool()))
 					continue;
 #endif
 				if (ce.error == Callable::CallError::CALL_ERROR_INVALID_METHOD && !ClassDB::class_exists(target->get_class_name())) {
 					//most likely object is not initialized yet, do not throw error.
 				} else {
-					ERR_PRINT("Error calling from signal '" + String(p_name) + "' to callable: " + Variant::get_callable_error_text(c.callable, args, argc, ce) + ".");
+					ERR_PRINT("Error calling from signal '" + String(p_name) + "' to callable: " + Variant::get_callable_error_text(slot->conn.callable, args, argc, ce) + ".");
 					err = ERR_METHOD_NOT_FOUND;
 				}
 			}
 		}
 
-		bool disconnect = c.flags & CONNECT_ONESHOT;
+		bool disconnect = flags & CONNECT_ONESHOT;
 #ifdef TOOLS_ENABLED
-		if (disconnect && (c.flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+		if (disconnect && (flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
 			//this signal was connected from the editor, and is being edited. just don't disconnect for now
 			disconnect = false;
 		}
 #endif
-		if (disconnect) {
+		if (disconnect && !slot->removed) {
 
-			_ObjectSignalDisconnectData dd;
-			dd.signal = p_name;
-			dd.callable = c.callable;
-			disconnect_data.push_back(dd);
+			Callable callable = slot->conn.callable;
+			_disconnect(p_name, callable);
 		}
 	}
 
-	while (!disconnect_data.empty()) {
+	_signal_emission = emission.prev;
+	s->emitting--;
 
-		const _ObjectSignalDisconnectData &dd = disconnect_data.front()->get();
-
-		_disconnect(dd.signal, dd.callable);
-		disconnect_data.pop_front();
+	if (s->emitting == 0 && (s->removed_count || s->added_count)) {
+		_finish_signal_emission(p_name, s);
 	}
 
 	return err;
 }
 
+void Object::_finish_signal_emission(const StringName &p_signal, SignalData *s) {
+
+	for (int i = s->slot_map.size() - 1; i >= 0; i--) {
+
+		SignalData::Slot &slot = s->slot_map.getv(i);
+		if (slot.removed) {
+			Callable key = s->slot_map.get_array()[i].key;
+			s->slot_map.erase(key);
+		} else {
+			slot.connected_at = 0;
+		}
+	}
+
+	s->removed_count = 0;
+	s->added_count = 0;
+
+	if (s->slot_map.empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
+		//not user signal, delete
+		signal_map.erase(p_signal);
+	}
+}
+
 Error Object::emit_signal(const StringName &p_name, VARIANT_ARG_DECLARE) {
 
 	VARIANT_ARGPTRS;
@@ -1375,6 +1432,8 @@ void Object::get_all_signal_connections(List<Connection> *p_connections) const {
 
 		for (int i = 0; i < s->slot_map.size(); i++) {
 
+			if (s->slot_map.getv(i).removed)
+				continue;
 			p_connections->push_back(s->slot_map.getv(i).conn);
 		}
 	}
@@ -1386,8 +1445,11 @@ void Object::get_signal_connection_list(const StringName &p_signal, List<Connect
 	if (!s)
 		return; //nothing
 
-	for (int i = 0; i < s->slot_map.size(); i++)
+	for (int i = 0; i < s->slot_map.size(); i++) {
+		if (s->slot_map.getv(i).removed)
+			continue;
 		p_connections->push_back(s->slot_map.getv(i).conn);
+	}
 }
 
 int Object::get_persistent_signal_connection_count() const {
@@ -1400,7 +1462,7 @@ int Object::get_persistent_signal_connection_count() const {
 		const SignalData *s = &signal_map[*S];
 
 		for (int i = 0; i < s->slot_map.size(); i++) {
-			if (s->slot_map.getv(i).conn.flags & CONNECT_PERSIST) {
+			if (!s->slot_map.getv(i).removed && s->slot_map.getv(i).conn.flags & CONNECT_PERSIST) {
 				count += 1;
 			}
 		}
@@ -1454,9 +1516,10 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, co
 
 	Callable target = p_callable;
 
-	if (s->slot_map.has(target)) {
+	int existing = s->slot_map.find(target);
+	if (existing != -1 && !s->slot_map.getv(existing).removed) {
 		if (p_flags & CONNECT_REFERENCE_COUNTED) {
-			s->slot_map[target].reference_count++;
+			s->slot_map.getv(existing).reference_count++;
 			return OK;
 		} else {
 			ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Signal '" + p_signal + "' is already connected to given callable '" + p_callable + "' in that object.");
@@ -1475,6 +1538,22 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, co
 	if (p_flags & CONNECT_REFERENCE_COUNTED) {
 		slot.reference_count = 1;
 	}
+	if (!target.is_custom()) {
+		slot.method = ClassDB::get_method(target_object->get_class_name(), target.get_method());
+	}
+
+	if (existing != -1) {
+		//disconnected during an emission that is still running, reuse the entry
+		slot.connected_at = s->slot_map.getv(existing).connected_at;
+		s->slot_map.getv(existing) = slot;
+		s->removed_count--;
+		return OK;
+	}
+
+	if (s->emitting) {
+		slot.connected_at = s->emit_serial;
+		s->added_count++;
+	}
 
 	s->slot_map[target] = slot;
 
@@ -1503,7 +1582,8 @@ bool Object::is_connected(const StringName &p_signal, const Callable &p_callable
 
 	Callable target = p_callable;
 
-	return s->slot_map.has(target);
+	int idx = s->slot_map.find(target);
+	return idx != -1 && !s->slot_map.getv(idx).removed;
 	//const Map<Signal::Target,Signal::Slot>::Element *E = s->slot_map.find(target);
 	//return (E!=NULL);
 }
@@ -1527,9 +1607,10 @@ void Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	SignalData *s = signal_map.getptr(p_signal);
 	ERR_FAIL_COND_MSG(!s, vformat("Nonexistent signal '%s' in %s.", p_signal, to_string()));
 
-	ERR_FAIL_COND_MSG(!s->slot_map.has(p_callable), "Disconnecting nonexistent signal '" + p_signal + "', callable: " + p_callable + ".");
+	int idx = s->slot_map.find(p_callable);
+	ERR_FAIL_COND_MSG(idx == -1 || s->slot_map.getv(idx).removed, "Disconnecting nonexistent signal '" + p_signal + "', callable: " + p_callable + ".");
 
-	SignalData::Slot *slot = &s->slot_map[p_callable];
+	SignalData::Slot *slot = &s->slot_map.getv(idx);
 
 	if (!p_force) {
 		slot->reference_count--; // by default is zero, if it was not referenced it will go below it
@@ -1539,6 +1620,15 @@ void Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	target_object->connections.erase(slot->cE);
+
+	if (s->emitting) {
+		//emit_signal is walking the slots, it erases this one when done
+		slot->removed = true;
+		slot->cE = NULL;
+		s->removed_count++;
+		return;
+	}
+
 	s->slot_map.erase(p_callable);
 
 	if (s->slot_map.empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
@@ -1928,7 +2018,7 @@ void Object::_construct_object(bool p_reference) {
 	_instance_id = ObjectDB::add_instance(this);
 	_can_translate = true;
 	_is_queued_for_deletion = false;
-	_emitting = false;
+	_signal_emission = NULL;
 	instance_binding_count = 0;
 	memset(_script_instance_bindings, 0, sizeof(void *) * MAX_SCRIPT_INSTANCE_BINDINGS);
 	script_instance = NULL;
@@ -1959,7 +2049,11 @@ Object::~Object() {
 
 	const StringName *S = NULL;
 
-	if (_emitting) {
+	if (_signal_emission) {
+		//tell the emissions to stop, they can't touch this object anymore
+		for (SignalEmission *emission = _signal_emission; emission; emission = emission->prev) {
+			emission->freed = true;
+		}
 		//@todo this may need to actually reach the debugger prioritarily somehow because it may crash before
 		ERR_PRINT("Object " + to_string() + " was freed or unreferenced while a signal is being emitted from it. Try connecting to the signal using 'CONNECT_DEFERRED' flag, or use queue_free() to free the object (if this object is a Node) to avoid this error and potential crashes.");
 	}
@@ -1974,6 +2068,9 @@ Object::~Object() {
 
 		for (int i = 0; i < slot_count; i++) {
 
+			if (slot_list[i].value.removed) {
+				continue; //already gone from the target
+			}
 			slot_list[i].value.conn.callable.get_object()->connections.erase(slot_list[i].value.cE);
 		}
 
@@ -2013,9 +2110,12 @@ void postinitialize_handler(Object *p_object) {
 void ObjectDB::debug_objects(DebugFunc p_func) {
 
 	spin_lock.lock();
-	for (uint32_t i = 0; i < slot_count; i++) {
-		uint32_t slot = object_slots[i].next_free;
-		p_func(object_slots[slot].object);
+	uint32_t max = slot_max.load(std::memory_order_acquire);
+	for (uint32_t i = 0; i < max; i++) {
+		Object *object = _get_slot(i).object.load(std::memory_order_acquire);
+		if (object) {
+			p_func(object);
+		}
 	}
 	spin_lock.unlock();
 }
@@ -2025,47 +2125,103 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 
 SpinLock ObjectDB::spin_lock;
 uint32_t ObjectDB::slot_count = 0;
-uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
-uint64_t ObjectDB::validator_counter = 0;
+std::atomic<uint32_t> ObjectDB::slot_max(0);
+std::atomic<ObjectDB::ObjectSlot *> ObjectDB::object_pages[OBJECTDB_MAX_PAGES];
+std::atomic<uint64_t> ObjectDB::validator_counter(0);
+std::atomic<int> ObjectDB::object_count(0);
+bool ObjectDB::initialized = false;
+uint32_t ObjectDB::generation = 1;
+
+#define OBJECTDB_THREAD_CACHE_SIZE 64
+#define OBJECTDB_THREAD_CACHE_BATCH 32
+
+// Free slots reserved by a thread, so creating and freeing objects does not touch the global free list every time.
+struct ObjectDBThreadCache {
+	uint32_t slots[OBJECTDB_THREAD_CACHE_SIZE];
+	uint32_t count = 0;
+	uint32_t generation = 0;
+
+	~ObjectDBThreadCache() {
+		if (count && ObjectDB::initialized && generation == ObjectDB::generation) {
+			ObjectDB::_release_slots(slots, count);
+		}
+	}
+};
+
+static thread_local ObjectDBThreadCache objectdb_thread_cache;
 
 int ObjectDB::get_object_count() {
 
-	return slot_count;
+	return object_count.load(std::memory_order_relaxed);
 }
 
-ObjectID ObjectDB::add_instance(Object *p_object) {
+void ObjectDB::_reserve_slots(uint32_t *r_slots, uint32_t p_count) {
 
 	spin_lock.lock();
-	if (unlikely(slot_count == slot_max)) {
 
-		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
+	uint32_t max = slot_max.load(std::memory_order_relaxed);
+	if (unlikely(slot_count + p_count > max)) {
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_reference = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+		CRASH_COND(max == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
+
+		//add a page, existing slots stay where they are
+		ObjectSlot *page = memnew_arr(ObjectSlot, OBJECTDB_PAGE_SIZE);
+		for (uint32_t i = 0; i < OBJECTDB_PAGE_SIZE; i++) {
+			page[i].validator.store(0, std::memory_order_relaxed);
+			page[i].object.store(nullptr, std::memory_order_relaxed);
+			page[i].next_free = max + i;
+			page[i].is_reference = false;
 		}
-		slot_max = new_slot_max;
+		object_pages[max >> OBJECTDB_PAGE_BITS].store(page, std::memory_order_release);
+		slot_max.store(max + OBJECTDB_PAGE_SIZE, std::memory_order_release);
+		initialized = true;
+	}
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_slots[i] = _get_slot(slot_count).next_free;
+		slot_count++;
 	}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
-		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
+	spin_lock.unlock();
+}
+
+void ObjectDB::_release_slots(const uint32_t *p_slots, uint32_t p_count) {
+
+	spin_lock.lock();
+	for (uint32_t i = 0; i < p_count; i++) {
+		slot_count--;
+		_get_slot(slot_count).next_free = p_slots[i];
+	}
+	spin_lock.unlock();
+}
+
+ObjectID ObjectDB::add_instance(Object *p_object) {
+
+	ObjectDBThreadCache &cache = objectdb_thread_cache;
+	if (unlikely(cache.generation != generation)) {
+		cache.count = 0;
+		cache.generation = generation;
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_reference = p_object->is_reference();
-	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
-	if (unlikely(validator_counter == 0)) {
-		validator_counter = 1;
+	if (unlikely(cache.count == 0)) {
+		_reserve_slots(cache.slots, OBJECTDB_THREAD_CACHE_BATCH);
+		cache.count = OBJECTDB_THREAD_CACHE_BATCH;
 	}
-	object_slots[slot].validator = validator_counter;
 
-	uint64_t id = validator_counter;
+	uint32_t slot = cache.slots[--cache.count];
+	ObjectSlot &object_slot = _get_slot(slot);
+
+	ERR_FAIL_COND_V(object_slot.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
+
+	uint64_t validator;
+	do {
+		validator = (validator_counter.fetch_add(1, std::memory_order_relaxed) + 1) & OBJECTDB_VALIDATOR_MASK;
+	} while (unlikely(validator == 0));
+
+	object_slot.is_reference = p_object->is_reference();
+	object_slot.object.store(p_object, std::memory_order_release);
+	object_slot.validator.store(validator, std::memory_order_release);
+
+	uint64_t id = validator;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
 	id |= uint64_t(slot);
 
@@ -2073,9 +2229,7 @@ ObjectID ObjectDB::add_instance(Object *p_object) {
 		id |= OBJECTDB_REFERENCE_BIT;
 	}
 
-	slot_count++;
-
-	spin_lock.unlock();
+	object_count.fetch_add(1, std::memory_order_relaxed);
 
 	return ObjectID(id);
 }
@@ -2084,33 +2238,35 @@ void ObjectDB::remove_instance(Object *p_object) {
 	uint64_t t = p_object->get_instance_id();
 	uint32_t slot = t & OBJECTDB_SLOT_MAX_COUNT_MASK; //slot is always valid on valid object
 
-	spin_lock.lock();
+	ObjectSlot &object_slot = _get_slot(slot);
 
 #ifdef DEBUG_ENABLED
 
-	if (object_slots[slot].object != p_object) {
-		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
-	}
+	ERR_FAIL_COND(object_slot.object.load(std::memory_order_relaxed) != p_object);
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
-			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
-		}
+		ERR_FAIL_COND(object_slot.validator.load(std::memory_order_relaxed) != validator);
 	}
 
 #endif
-	//decrease slot count
-	slot_count--;
-	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
-	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_reference = false;
-	object_slots[slot].object = nullptr;
+	//invalidate first, so lookups fail before the pointer goes away
+	object_slot.validator.store(0, std::memory_order_release);
+	object_slot.is_reference = false;
+	object_slot.object.store(nullptr, std::memory_order_release);
 
-	spin_lock.unlock();
+	object_count.fetch_sub(1, std::memory_order_relaxed);
+
+	ObjectDBThreadCache &cache = objectdb_thread_cache;
+	if (unlikely(cache.generation != generation)) {
+		cache.count = 0;
+		cache.generation = generation;
+	}
+	if (unlikely(cache.count == OBJECTDB_THREAD_CACHE_SIZE)) {
+		//give half back, so other threads can use them
+		cache.count -= OBJECTDB_THREAD_CACHE_BATCH;
+		_release_slots(&cache.slots[cache.count], OBJECTDB_THREAD_CACHE_BATCH);
+	}
+	cache.slots[cache.count++] = slot;
 }
 
 void ObjectDB::setup() {
@@ -2120,14 +2276,20 @@ void ObjectDB::setup() {
 
 void ObjectDB::cleanup() {
 
-	if (slot_count > 0) {
-		spin_lock.lock();
+	spin_lock.lock();
+
+	uint32_t max = slot_max.load(std::memory_order_acquire);
+
+	if (get_object_count() > 0) {
 
 		WARN_PRINT("ObjectDB Instances still exist!");
 		if (OS::get_singleton()->is_stdout_verbose()) {
-			for (uint32_t i = 0; i < slot_count; i++) {
-				uint32_t slot = object_slots[i].next_free;
-				Object *obj = object_slots[slot].object;
+			for (uint32_t slot = 0; slot < max; slot++) {
+				ObjectSlot &object_slot = _get_slot(slot);
+				Object *obj = object_slot.object.load(std::memory_order_acquire);
+				if (!obj) {
+					continue;
+				}
 
 				String node_name;
 				if (obj->is_class("Node"))
@@ -2135,14 +2297,21 @@ void ObjectDB::cleanup() {
 				if (obj->is_class("Resource"))
 					node_name = " - Resource name: " + String(obj->call("get_name")) + " Path: " + String(obj->call("get_path"));
 
-				uint64_t id = uint64_t(slot) | (uint64_t(object_slots[slot].validator) << OBJECTDB_VALIDATOR_BITS) | (object_slots[slot].is_reference ? OBJECTDB_REFERENCE_BIT : 0);
+				uint64_t id = uint64_t(slot) | (uint64_t(object_slot.validator.load(std::memory_order_relaxed)) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slot.is_reference ? OBJECTDB_REFERENCE_BIT : 0);
 				print_line("Leaked instance: " + String(obj->get_class()) + ":" + itos(id) + node_name);
 			}
 		}
-		spin_lock.unlock();
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
+	initialized = false; //thread caches must not hand their slots back anymore
+	generation++;
+
+	for (uint32_t i = 0; i < max; i += OBJECTDB_PAGE_SIZE) {
+		memdelete_arr(object_pages[i >> OBJECTDB_PAGE_BITS].load(std::memory_order_relaxed));
+		object_pages[i >> OBJECTDB_PAGE_BITS].store(nullptr, std::memory_order_relaxed);
 	}
+	slot_max.store(0, std::memory_order_release);
+	slot_count = 0;
+
+	spin_lock.unlock();
 }
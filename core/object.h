@@ -401,6 +401,7 @@ public:                                                        \
 private:
 
 class ScriptInstance;
+class MethodBind;
 
 class Object {
 public:
@@ -446,12 +447,35 @@ private:
 			int reference_count;
 			Connection conn;
 			List<Connection>::Element *cE;
-			Slot() { reference_count = 0; }
+			MethodBind *method; //bound method of the target, called directly when no script is in the way
+			uint32_t connected_at; //emission that was running when connected, or zero
+			bool removed; //disconnected while emitting, erased once the emission ends
+			Slot() {
+				reference_count = 0;
+				cE = NULL;
+				method = NULL;
+				connected_at = 0;
+				removed = false;
+			}
 		};
 
 		MethodInfo user;
 		VMap<Callable, Slot> slot_map;
-		SignalData() {}
+		uint32_t emit_serial;
+		int emitting;
+		int removed_count;
+		int added_count;
+		SignalData() {
+			emit_serial = 0;
+			emitting = 0;
+			removed_count = 0;
+			added_count = 0;
+		}
+	};
+
+	struct SignalEmission {
+		SignalEmission *prev;
+		bool freed;
 	};
 
 	HashMap<StringName, SignalData> signal_map;
@@ -466,7 +490,7 @@ private:
 	bool _predelete();
 	void _postinitialize();
 	bool _can_translate;
-	bool _emitting;
+	SignalEmission *_signal_emission; //innermost emit_signal running on this object
 #ifdef TOOLS_ENABLED
 	bool _edited;
 	uint32_t _edited_version;
@@ -557,6 +581,7 @@ protected:
 	virtual void _validate_property(PropertyInfo &property) const;
 
 	void _disconnect(const StringName &p_signal, const Callable &p_callable, bool p_force = false);
+	void _finish_signal_emission(const StringName &p_signal, SignalData *s);
 
 public: //should be protected, but bug in clang++
 	static void initialize_class();
@@ -761,19 +786,29 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_BITS 24
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
-
-	struct ObjectSlot { //128 bits per slot
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_reference : 1;
-		Object *object;
+//slots live in pages that never move, so they can be read without locking
+#define OBJECTDB_PAGE_BITS 12
+#define OBJECTDB_PAGE_SIZE (1 << OBJECTDB_PAGE_BITS)
+#define OBJECTDB_PAGE_MASK (OBJECTDB_PAGE_SIZE - 1)
+#define OBJECTDB_MAX_PAGES (1 << (OBJECTDB_SLOT_MAX_COUNT_BITS - OBJECTDB_PAGE_BITS))
+
+	struct ObjectSlot {
+		//validator is cleared before the object is, and set after it, so a reader that sees the same
+		//validator before and after loading the object knows the pointer belongs to that ID
+		std::atomic<uint64_t> validator;
+		std::atomic<Object *> object;
+		uint32_t next_free; //free list, indexed by allocation count rather than slot
+		bool is_reference;
 	};
 
-	static SpinLock spin_lock;
+	static SpinLock spin_lock; //only taken to grow or to move slots between the free list and thread caches
 	static uint32_t slot_count;
-	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
-	static uint64_t validator_counter;
+	static std::atomic<uint32_t> slot_max;
+	static std::atomic<ObjectSlot *> object_pages[OBJECTDB_MAX_PAGES];
+	static std::atomic<uint64_t> validator_counter;
+	static std::atomic<int> object_count;
+	static bool initialized;
+	static uint32_t generation; //increased on cleanup, thread caches from before are dropped
 
 	friend class Object;
 	friend void unregister_core_types();
@@ -782,6 +817,14 @@ class ObjectDB {
 	static ObjectID add_instance(Object *p_object);
 	static void remove_instance(Object *p_object);
 
+	friend struct ObjectDBThreadCache;
+	static void _reserve_slots(uint32_t *r_slots, uint32_t p_count);
+	static void _release_slots(const uint32_t *p_slots, uint32_t p_count);
+
+	_ALWAYS_INLINE_ static ObjectSlot &_get_slot(uint32_t p_slot) {
+		return object_pages[p_slot >> OBJECTDB_PAGE_BITS].load(std::memory_order_acquire)[p_slot & OBJECTDB_PAGE_MASK];
+	}
+
 	friend void register_core_types();
 	static void setup();
 
@@ -793,20 +836,22 @@ public:
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
 
-		ERR_FAIL_COND_V(slot >= slot_max, nullptr); //this should never happen unless RID is corrupted
-
-		spin_lock.lock();
+		ERR_FAIL_COND_V(slot >= slot_max.load(std::memory_order_acquire), nullptr); //this should never happen unless RID is corrupted
 
 		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
 
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		ObjectSlot &object_slot = _get_slot(slot);
+
+		if (unlikely(object_slot.validator.load(std::memory_order_acquire) != validator)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
+		Object *object = object_slot.object.load(std::memory_order_acquire);
 
-		spin_lock.unlock();
+		//the slot may have been freed and reused while loading, validators are never reused so this catches it
+		if (unlikely(object_slot.validator.load(std::memory_order_acquire) != validator)) {
+			return nullptr;
+		}
 
 		return object;
 	}
@@ -35,6 +35,7 @@
 #include "core/io/marshalls.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 
 FileAccess::CreateFunc FileAccess::create_func[ACCESS_MAX] = { 0, 0 };
 
@@ -627,27 +628,40 @@ String FileAccess::get_file_as_string(const String &p_path, Error *r_error) {
 	return ret;
 }
 
-String FileAccess::get_md5(const String &p_file) {
+//large reads keep the per call overhead of the file access low next to the hashing itself
+#define HASH_READ_BUFFER_SIZE (1 << 20)
 
-	FileAccess *f = FileAccess::open(p_file, READ);
-	if (!f)
-		return String();
-
-	CryptoCore::MD5Context ctx;
-	ctx.start();
+template <class C>
+static void _hash_file_contents(C &p_ctx, FileAccess *p_file, Vector<uint8_t> &r_buffer) {
 
-	unsigned char step[32768];
+	if (r_buffer.size() != HASH_READ_BUFFER_SIZE) {
+		r_buffer.resize(HASH_READ_BUFFER_SIZE);
+	}
+	uint8_t *w = r_buffer.ptrw();
 
 	while (true) {
 
-		int br = f->get_buffer(step, 32768);
+		int br = p_file->get_buffer(w, HASH_READ_BUFFER_SIZE);
 		if (br > 0) {
 
-			ctx.update(step, br);
+			p_ctx.update(w, br);
 		}
-		if (br < 4096)
+		if (br <= 0 || p_file->eof_reached())
 			break;
 	}
+}
+
+String FileAccess::get_md5(const String &p_file) {
+
+	FileAccess *f = FileAccess::open(p_file, READ);
+	if (!f)
+		return String();
+
+	CryptoCore::MD5Context ctx;
+	ctx.start();
+
+	Vector<uint8_t> buffer;
+	_hash_file_contents(ctx, f, buffer);
 
 	unsigned char hash[16];
 	ctx.finish(hash);
@@ -662,22 +676,14 @@ String FileAccess::get_multiple_md5(const Vector<String> &p_file) {
 	CryptoCore::MD5Context ctx;
 	ctx.start();
 
+	Vector<uint8_t> buffer;
+
 	for (int i = 0; i < p_file.size(); i++) {
 		FileAccess *f = FileAccess::open(p_file[i], READ);
 		ERR_CONTINUE(!f);
 
-		unsigned char step[32768];
+		_hash_file_contents(ctx, f, buffer);
 
-		while (true) {
-
-			int br = f->get_buffer(step, 32768);
-			if (br > 0) {
-
-				ctx.update(step, br);
-			}
-			if (br < 4096)
-				break;
-		}
 		memdelete(f);
 	}
 
@@ -696,24 +702,57 @@ String FileAccess::get_sha256(const String &p_file) {
 	CryptoCore::SHA256Context ctx;
 	ctx.start();
 
-	unsigned char step[32768];
+	Vector<uint8_t> buffer;
+	_hash_file_contents(ctx, f, buffer);
 
-	while (true) {
+	unsigned char hash[32];
+	ctx.finish(hash);
 
-		int br = f->get_buffer(step, 32768);
-		if (br > 0) {
+	memdelete(f);
+	return String::hex_encode_buffer(hash, 32);
+}
+
+struct FileAccessHashBatch {
+
+	const String *files;
+	String *hashes;
+	String (*hash_func)(const String &);
+
+	void hash_file(uint32_t p_index, void *p_userdata) {
+		hashes[p_index] = hash_func(files[p_index]);
+	}
+};
+
+static Vector<String> _hash_file_batch(const Vector<String> &p_files, String (*p_hash_func)(const String &)) {
+
+	Vector<String> hashes;
+	hashes.resize(p_files.size());
 
-			ctx.update(step, br);
+	FileAccessHashBatch batch;
+	batch.files = p_files.ptr();
+	batch.hashes = hashes.ptrw();
+	batch.hash_func = p_hash_func;
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0 && p_files.size() > 1) {
+		pool->do_work(p_files.size(), &batch, &FileAccessHashBatch::hash_file, (void *)NULL);
+	} else {
+		for (int i = 0; i < p_files.size(); i++) {
+			batch.hash_file(i, NULL);
 		}
-		if (br < 4096)
-			break;
 	}
 
-	unsigned char hash[32];
-	ctx.finish(hash);
+	return hashes;
+}
 
-	memdelete(f);
-	return String::hex_encode_buffer(hash, 32);
+Vector<String> FileAccess::get_md5_batch(const Vector<String> &p_files) {
+
+	return _hash_file_batch(p_files, &FileAccess::get_md5);
+}
+
+Vector<String> FileAccess::get_sha256_batch(const Vector<String> &p_files) {
+
+	return _hash_file_batch(p_files, &FileAccess::get_sha256);
 }
 
 FileAccess::FileAccess() {
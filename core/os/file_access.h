@@ -113,6 +113,7 @@ public:
 	virtual real_t get_real() const;
 
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const; ///< get an array of bytes
+	virtual const uint8_t *get_buffer_view(int p_length, int &r_length) const { return NULL; } ///< read-only view of the next bytes, advancing like get_buffer (NULL if not supported, use get_buffer then). Valid until the file is closed
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -166,6 +167,9 @@ public:
 	static String get_md5(const String &p_file);
 	static String get_sha256(const String &p_file);
 	static String get_multiple_md5(const Vector<String> &p_file);
+	// Hash of each file, computed on the ThreadWorkPool. Files that can't be opened get an empty string.
+	static Vector<String> get_md5_batch(const Vector<String> &p_files);
+	static Vector<String> get_sha256_batch(const Vector<String> &p_files);
 
 	static Vector<uint8_t> get_file_as_array(const String &p_path, Error *r_error = NULL);
 	static String get_file_as_string(const String &p_path, Error *r_error = NULL);
@@ -47,6 +47,11 @@ void *operator new(size_t p_size, void *(*p_allocfunc)(size_t p_size)) {
 	return p_allocfunc(p_size);
 }
 
+void *operator new(size_t p_size, Memory::Tag p_tag) {
+
+	return Memory::alloc_static_tagged(p_size, p_tag, false);
+}
+
 #ifdef _MSC_VER
 void operator delete(void *p_mem, const char *p_description) {
 
@@ -62,24 +67,138 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 
 	CRASH_NOW_MSG("Call to placement delete should not happen.");
 }
+
+void operator delete(void *p_mem, Memory::Tag p_tag) {
+
+	CRASH_NOW_MSG("Call to placement delete should not happen.");
+}
 #endif
 
+// The size header of padded blocks has room to spare, so its top byte holds
+// the tag of the block, and its top bit whether the block was sampled.
+#define HEADER_TAG_SHIFT 56
+#define HEADER_TAG_MASK 0x7F
+#define HEADER_SIZE_MASK ((uint64_t(1) << HEADER_TAG_SHIFT) - 1)
+#define HEADER_SAMPLED_BIT (uint64_t(1) << 63)
+
 #ifdef DEBUG_ENABLED
 uint64_t Memory::mem_usage = 0;
 uint64_t Memory::max_usage = 0;
+
+Memory::TagStats Memory::tag_stats[Memory::TAG_MAX] = {};
+thread_local Memory::Tag Memory::current_tag = Memory::TAG_GENERAL;
+
+uint32_t Memory::sample_interval = 0;
+uint64_t Memory::sample_counter = 0;
+Memory::AllocSampleFunc Memory::alloc_sample_func = NULL;
+Memory::FreeSampleFunc Memory::free_sample_func = NULL;
+
+static thread_local bool in_alloc_sampler = false;
+
+static_assert(Memory::TAG_MAX <= HEADER_TAG_MASK + 1, "Memory tags don't fit in the allocation header.");
 #endif
 
 uint64_t Memory::alloc_count = 0;
 
+// Padded allocations are what CowData uses, so short strings and small vectors
+// are created and dropped all the time. Blocks of the small power of two sizes
+// CowData asks for are kept per thread and handed out again instead of going
+// back to malloc. They are still plain malloc blocks, so realloc() and free()
+// keep working on them wherever they end up.
+
+struct SmallBlockCache {
+
+	enum {
+		MIN_SHIFT = 3,
+		MAX_SHIFT = 7,
+		CLASS_COUNT = MAX_SHIFT - MIN_SHIFT + 1,
+		MAX_BLOCKS = 64, //per size
+	};
+
+	void *blocks[CLASS_COUNT];
+	uint32_t counts[CLASS_COUNT];
+	bool disabled;
+};
+
+// trivially destructible, so it can still be used (as disabled) by destructors that run after the flush below
+static thread_local SmallBlockCache small_block_cache;
+
+struct SmallBlockCacheFlush {
+
+	~SmallBlockCacheFlush() {
+		for (int i = 0; i < SmallBlockCache::CLASS_COUNT; i++) {
+			while (small_block_cache.blocks[i]) {
+				void *next = *(void **)small_block_cache.blocks[i];
+				free(small_block_cache.blocks[i]);
+				small_block_cache.blocks[i] = next;
+			}
+			small_block_cache.counts[i] = 0;
+		}
+		small_block_cache.disabled = true;
+	}
+};
+
+static thread_local SmallBlockCacheFlush small_block_cache_flush;
+
+static _FORCE_INLINE_ int _get_small_block_class(size_t p_bytes) {
+
+	if (p_bytes < (1 << SmallBlockCache::MIN_SHIFT) || p_bytes > (1 << SmallBlockCache::MAX_SHIFT) || (p_bytes & (p_bytes - 1))) {
+		return -1;
+	}
+
+	int shift = SmallBlockCache::MIN_SHIFT;
+	while ((size_t(1) << shift) != p_bytes) {
+		shift++;
+	}
+	return shift - SmallBlockCache::MIN_SHIFT;
+}
+
+static _FORCE_INLINE_ void *_pop_small_block(int p_class) {
+
+	void *block = small_block_cache.blocks[p_class];
+	if (block) {
+		small_block_cache.blocks[p_class] = *(void **)block;
+		small_block_cache.counts[p_class]--;
+	}
+	return block;
+}
+
+static _FORCE_INLINE_ bool _push_small_block(int p_class, void *p_block) {
+
+	if (small_block_cache.disabled || small_block_cache.counts[p_class] >= SmallBlockCache::MAX_BLOCKS) {
+		return false;
+	}
+
+	(void)&small_block_cache_flush; //make sure this thread flushes its cache on exit
+
+	*(void **)p_block = small_block_cache.blocks[p_class];
+	small_block_cache.blocks[p_class] = p_block;
+	small_block_cache.counts[p_class]++;
+	return true;
+}
+
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 
+#ifdef DEBUG_ENABLED
+	return alloc_static_tagged(p_bytes, current_tag, p_pad_align);
+#else
+	return alloc_static_tagged(p_bytes, TAG_GENERAL, p_pad_align);
+#endif
+}
+
+void *Memory::alloc_static_tagged(size_t p_bytes, Tag p_tag, bool p_pad_align) {
+
 #ifdef DEBUG_ENABLED
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
-	void *mem = malloc(p_bytes + (prepad ? PAD_ALIGN : 0));
+	int small_class = p_pad_align ? _get_small_block_class(p_bytes) : -1;
+	void *mem = small_class >= 0 ? _pop_small_block(small_class) : NULL;
+	if (!mem) {
+		mem = malloc(p_bytes + (prepad ? PAD_ALIGN : 0));
+	}
 
 	ERR_FAIL_COND_V(!mem, NULL);
 
@@ -94,6 +213,21 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 #ifdef DEBUG_ENABLED
 		atomic_add(&mem_usage, p_bytes);
 		atomic_exchange_if_greater(&max_usage, mem_usage);
+
+		TagStats &stats = tag_stats[p_tag];
+		atomic_add(&stats.usage, p_bytes);
+		atomic_exchange_if_greater(&stats.max_usage, stats.usage);
+		atomic_increment(&stats.count);
+
+		*s |= uint64_t(p_tag) << HEADER_TAG_SHIFT;
+
+		uint32_t interval = sample_interval;
+		if (interval && !in_alloc_sampler && atomic_increment(&sample_counter) % interval == 0) {
+			*s |= HEADER_SAMPLED_BIT;
+			in_alloc_sampler = true;
+			alloc_sample_func(s8 + PAD_ALIGN, p_bytes, p_tag);
+			in_alloc_sampler = false;
+		}
 #endif
 		return s8 + PAD_ALIGN;
 	} else {
@@ -118,28 +252,50 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	if (prepad) {
 		mem -= PAD_ALIGN;
 		uint64_t *s = (uint64_t *)mem;
+		uint64_t bytes = *s & HEADER_SIZE_MASK;
+		uint64_t header_bits = *s & ~HEADER_SIZE_MASK;
 
 #ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			atomic_add(&mem_usage, p_bytes - *s);
+		TagStats &stats = tag_stats[(*s >> HEADER_TAG_SHIFT) & HEADER_TAG_MASK];
+		if (p_bytes > bytes) {
+			atomic_add(&mem_usage, p_bytes - bytes);
 			atomic_exchange_if_greater(&max_usage, mem_usage);
+			atomic_add(&stats.usage, p_bytes - bytes);
+			atomic_exchange_if_greater(&stats.max_usage, stats.usage);
 		} else {
-			atomic_sub(&mem_usage, *s - p_bytes);
+			atomic_sub(&mem_usage, bytes - p_bytes);
+			atomic_sub(&stats.usage, bytes - p_bytes);
+		}
+
+		bool sampled = header_bits & HEADER_SAMPLED_BIT;
+		if (sampled && free_sample_func) {
+			free_sample_func(p_memory); //the block may move, it is reported again below
 		}
 #endif
 
 		if (p_bytes == 0) {
+#ifdef DEBUG_ENABLED
+			atomic_decrement(&stats.count);
+#endif
 			free(mem);
 			return NULL;
 		} else {
-			*s = p_bytes;
+			*s = p_bytes | header_bits;
 
 			mem = (uint8_t *)realloc(mem, p_bytes + PAD_ALIGN);
 			ERR_FAIL_COND_V(!mem, NULL);
 
 			s = (uint64_t *)mem;
 
-			*s = p_bytes;
+			*s = p_bytes | header_bits;
+
+#ifdef DEBUG_ENABLED
+			if (sampled && alloc_sample_func && !in_alloc_sampler) {
+				in_alloc_sampler = true;
+				alloc_sample_func(mem + PAD_ALIGN, p_bytes, Tag((*s >> HEADER_TAG_SHIFT) & HEADER_TAG_MASK));
+				in_alloc_sampler = false;
+			}
+#endif
 
 			return mem + PAD_ALIGN;
 		}
@@ -169,19 +325,123 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	if (prepad) {
 		mem -= PAD_ALIGN;
+		uint64_t *s = (uint64_t *)mem;
+		uint64_t bytes = *s & HEADER_SIZE_MASK;
 
 #ifdef DEBUG_ENABLED
-		uint64_t *s = (uint64_t *)mem;
-		atomic_sub(&mem_usage, *s);
+		atomic_sub(&mem_usage, bytes);
+
+		TagStats &stats = tag_stats[(*s >> HEADER_TAG_SHIFT) & HEADER_TAG_MASK];
+		atomic_sub(&stats.usage, bytes);
+		atomic_decrement(&stats.count);
+
+		if ((*s & HEADER_SAMPLED_BIT) && free_sample_func) {
+			free_sample_func(p_ptr);
+		}
 #endif
 
-		free(mem);
+		//the header holds the size the block was last allocated or reallocated to
+		int small_class = p_pad_align ? _get_small_block_class(bytes) : -1;
+		if (small_class < 0 || !_push_small_block(small_class, mem)) {
+			free(mem);
+		}
 	} else {
 
 		free(mem);
 	}
 }
 
+thread_local FrameArena::ThreadArena FrameArena::arena;
+
+uint64_t FrameArena::epoch = 1;
+uint64_t FrameArena::frame_usage = 0;
+uint64_t FrameArena::last_frame_usage = 0;
+uint64_t FrameArena::max_frame_usage = 0;
+uint64_t FrameArena::reserved = 0;
+
+FrameArena::ThreadArena::~ThreadArena() {
+
+	_release(*this);
+}
+
+void FrameArena::_release(ThreadArena &p_arena) {
+
+	while (p_arena.blocks) {
+		Block *next = p_arena.blocks->next;
+		atomic_sub(&reserved, (uint64_t)p_arena.blocks->size);
+		Memory::free_static(p_arena.blocks, false);
+		p_arena.blocks = next;
+	}
+}
+
+FrameArena::Block *FrameArena::_alloc_block(size_t p_size, Block *p_next) {
+
+	Block *block = (Block *)Memory::alloc_static(HEADER_SIZE + p_size, false);
+	ERR_FAIL_COND_V(!block, NULL);
+	block->next = p_next;
+	block->size = p_size;
+	block->used = 0;
+	atomic_add(&reserved, (uint64_t)p_size);
+	return block;
+}
+
+void FrameArena::_rewind(ThreadArena &p_arena) {
+
+	if (p_arena.blocks && p_arena.blocks->next) {
+		//the last frame needed more than one block, replace them with a single one big enough for all of it
+		size_t total = 0;
+		for (Block *b = p_arena.blocks; b; b = b->next) {
+			total += b->size;
+		}
+		_release(p_arena);
+		p_arena.blocks = _alloc_block(total, NULL);
+	} else if (p_arena.blocks) {
+		p_arena.blocks->used = 0;
+	}
+}
+
+void *FrameArena::alloc(size_t p_bytes) {
+
+	ThreadArena &a = arena;
+
+	if (a.epoch != epoch) {
+		_rewind(a);
+		a.epoch = epoch;
+	}
+
+	p_bytes = (p_bytes + ALIGNMENT - 1) & ~size_t(ALIGNMENT - 1);
+
+	if (!a.blocks || a.blocks->used + p_bytes > a.blocks->size) {
+		size_t size = MAX(p_bytes, a.blocks ? a.blocks->size * 2 : size_t(BLOCK_SIZE_MIN));
+		Block *block = _alloc_block(size, a.blocks);
+		ERR_FAIL_COND_V(!block, NULL);
+		a.blocks = block;
+	}
+
+	uint8_t *ptr = (uint8_t *)a.blocks + HEADER_SIZE + a.blocks->used;
+	a.blocks->used += p_bytes;
+	atomic_add(&frame_usage, (uint64_t)p_bytes);
+
+	return ptr;
+}
+
+void FrameArena::end_frame() {
+
+	uint64_t usage = frame_usage;
+	atomic_sub(&frame_usage, usage);
+	last_frame_usage = usage;
+	if (usage > max_frame_usage) {
+		max_frame_usage = usage;
+	}
+
+	atomic_increment(&epoch);
+}
+
+void FrameArena::free_thread_memory() {
+
+	_release(arena);
+}
+
 uint64_t Memory::get_mem_available() {
 
 	return -1; // 0xFFFF...
@@ -203,6 +463,62 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+const char *Memory::get_tag_name(Tag p_tag) {
+
+	static const char *names[TAG_MAX] = {
+		"general",
+		"strings",
+		"nodes",
+		"resources",
+		"textures",
+		"meshes",
+		"scripts",
+		"physics",
+		"audio",
+		"rendering",
+	};
+
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, "");
+	return names[p_tag];
+}
+
+uint64_t Memory::get_tag_usage(Tag p_tag) {
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+	return tag_stats[p_tag].usage;
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_tag_max_usage(Tag p_tag) {
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+	return tag_stats[p_tag].max_usage;
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_tag_alloc_count(Tag p_tag) {
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+	return tag_stats[p_tag].count;
+#else
+	return 0;
+#endif
+}
+
+void Memory::set_alloc_sampler(uint32_t p_interval, AllocSampleFunc p_alloc_func, FreeSampleFunc p_free_func) {
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_MSG(p_interval && !p_alloc_func, "An allocation callback is required to enable sampling.");
+	sample_interval = 0;
+	alloc_sample_func = p_alloc_func;
+	free_sample_func = p_free_func;
+	sample_interval = p_interval;
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 
 	color = 1;
@@ -41,23 +41,102 @@
 #endif
 
 class Memory {
-
+public:
+	// Subsystem an allocation is accounted to. Allocations take the tag on
+	// top of the calling thread's tag stack (see MemoryTagScope) unless one
+	// is passed explicitly. Only tracked when DEBUG_ENABLED is set.
+	enum Tag {
+		TAG_GENERAL,
+		TAG_STRINGS,
+		TAG_NODES,
+		TAG_RESOURCES,
+		TAG_TEXTURES,
+		TAG_MESHES,
+		TAG_SCRIPTS,
+		TAG_PHYSICS,
+		TAG_AUDIO,
+		TAG_RENDERING,
+		TAG_MAX
+	};
+
+	// Called for every Nth tagged allocation when sampling is enabled, and
+	// again when a sampled block is freed. Meant for platform code to record
+	// a native callstack per block, for leak and bloat hunting. Allocating
+	// from inside the callbacks is allowed, those allocations are not sampled.
+	typedef void (*AllocSampleFunc)(void *p_ptr, size_t p_bytes, Tag p_tag);
+	typedef void (*FreeSampleFunc)(void *p_ptr);
+
+private:
 	Memory();
 #ifdef DEBUG_ENABLED
 	static uint64_t mem_usage;
 	static uint64_t max_usage;
+
+	struct TagStats {
+		uint64_t usage;
+		uint64_t max_usage;
+		uint64_t count;
+	};
+
+	static TagStats tag_stats[TAG_MAX];
+	static thread_local Tag current_tag;
+
+	static uint32_t sample_interval;
+	static uint64_t sample_counter;
+	static AllocSampleFunc alloc_sample_func;
+	static FreeSampleFunc free_sample_func;
 #endif
 
 	static uint64_t alloc_count;
 
 public:
 	static void *alloc_static(size_t p_bytes, bool p_pad_align = false);
+	static void *alloc_static_tagged(size_t p_bytes, Tag p_tag, bool p_pad_align = false);
 	static void *realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align = false);
 	static void free_static(void *p_ptr, bool p_pad_align = false);
 
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+
+	//returns the previous tag, to be passed to pop_tag()
+	_FORCE_INLINE_ static Tag push_tag(Tag p_tag) {
+#ifdef DEBUG_ENABLED
+		Tag previous = current_tag;
+		current_tag = p_tag;
+		return previous;
+#else
+		return TAG_GENERAL;
+#endif
+	}
+	_FORCE_INLINE_ static void pop_tag(Tag p_previous) {
+#ifdef DEBUG_ENABLED
+		current_tag = p_previous;
+#endif
+	}
+	_FORCE_INLINE_ static Tag get_current_tag() {
+#ifdef DEBUG_ENABLED
+		return current_tag;
+#else
+		return TAG_GENERAL;
+#endif
+	}
+	static const char *get_tag_name(Tag p_tag);
+
+	static uint64_t get_tag_usage(Tag p_tag);
+	static uint64_t get_tag_max_usage(Tag p_tag);
+	static uint64_t get_tag_alloc_count(Tag p_tag);
+
+	static void set_alloc_sampler(uint32_t p_interval, AllocSampleFunc p_alloc_func, FreeSampleFunc p_free_func); //interval 0 disables sampling
+};
+
+class MemoryTagScope {
+
+	Memory::Tag previous;
+
+public:
+	_FORCE_INLINE_ MemoryTagScope(Memory::Tag p_tag) { previous = Memory::push_tag(p_tag); }
+	_FORCE_INLINE_ ~MemoryTagScope() { Memory::pop_tag(previous); }
 };
 
 class DefaultAllocator {
@@ -66,10 +145,67 @@ public:
 	_FORCE_INLINE_ static void free(void *p_ptr) { Memory::free_static(p_ptr, false); }
 };
 
+// Linear allocator for memory that only lives until the end of the current
+// frame. Every thread has its own arena, so no locking is needed. Arenas are
+// rewound lazily (on the first allocation after Main::iteration() ends the
+// frame), and freeing is a no-op. Containers using FrameAllocator must never
+// be kept across frames.
+
+class FrameArena {
+
+	struct Block {
+		Block *next;
+		size_t size;
+		size_t used;
+	};
+
+	struct ThreadArena {
+		Block *blocks = nullptr; //most recent first
+		uint64_t epoch = 0;
+
+		~ThreadArena();
+	};
+
+	enum {
+		BLOCK_SIZE_MIN = 64 * 1024,
+		ALIGNMENT = 16,
+		HEADER_SIZE = (sizeof(Block) + ALIGNMENT - 1) & ~(ALIGNMENT - 1), //keeps allocations aligned
+	};
+
+	static thread_local ThreadArena arena;
+
+	static uint64_t epoch;
+	static uint64_t frame_usage;
+	static uint64_t last_frame_usage;
+	static uint64_t max_frame_usage;
+	static uint64_t reserved;
+
+	static Block *_alloc_block(size_t p_size, Block *p_next);
+	static void _release(ThreadArena &p_arena);
+	static void _rewind(ThreadArena &p_arena);
+
+public:
+	static void *alloc(size_t p_bytes);
+
+	static void end_frame(); //called once per frame by Main::iteration()
+	static void free_thread_memory();
+
+	static uint64_t get_frame_usage() { return last_frame_usage; }
+	static uint64_t get_max_frame_usage() { return max_frame_usage; }
+	static uint64_t get_reserved() { return reserved; }
+};
+
+class FrameAllocator {
+public:
+	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return FrameArena::alloc(p_memory); }
+	_FORCE_INLINE_ static void free(void *p_ptr) {}
+};
+
 void *operator new(size_t p_size, const char *p_description); ///< operator new that takes a description and uses MemoryStaticPool
 void *operator new(size_t p_size, void *(*p_allocfunc)(size_t p_size)); ///< operator new that takes a description and uses MemoryStaticPool
 
 void *operator new(size_t p_size, void *p_pointer, size_t check, const char *p_description); ///< operator new that takes a description and uses a pointer to the preallocated memory
+void *operator new(size_t p_size, Memory::Tag p_tag); ///< operator new that accounts the allocation to the given tag
 
 #ifdef _MSC_VER
 // When compiling with VC++ 2017, the above declarations of placement new generate many irrelevant warnings (C4291).
@@ -77,11 +213,13 @@ void *operator new(size_t p_size, void *p_pointer, size_t check, const char *p_d
 void operator delete(void *p_mem, const char *p_description);
 void operator delete(void *p_mem, void *(*p_allocfunc)(size_t p_size));
 void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_description);
+void operator delete(void *p_mem, Memory::Tag p_tag);
 #endif
 
 #define memalloc(m_size) Memory::alloc_static(m_size)
 #define memrealloc(m_mem, m_size) Memory::realloc_static(m_mem, m_size)
 #define memfree(m_size) Memory::free_static(m_size)
+#define memalloc_tagged(m_size, m_tag) Memory::alloc_static_tagged(m_size, m_tag)
 
 _ALWAYS_INLINE_ void postinitialize_handler(void *) {}
 
@@ -93,6 +231,7 @@ _ALWAYS_INLINE_ T *_post_initialize(T *p_obj) {
 }
 
 #define memnew(m_class) _post_initialize(new ("") m_class)
+#define memnew_tagged(m_tag, m_class) _post_initialize(new (m_tag) m_class)
 
 _ALWAYS_INLINE_ void *operator new(size_t p_size, void *p_pointer, size_t check, const char *p_description) {
 	//void *failptr=0;
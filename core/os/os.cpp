@@ -115,6 +115,12 @@ void OS::add_logger(Logger *p_logger) {
 	}
 }
 
+void OS::set_async_logging(bool p_enabled, uint32_t p_max_queued) {
+	if (_logger) {
+		_logger->set_async(p_enabled, p_max_queued);
+	}
+}
+
 void OS::print_error(const char *p_function, const char *p_file, int p_line, const char *p_code, const char *p_rationale, Logger::ErrorType p_type) {
 
 	_logger->log_error(p_function, p_file, p_line, p_code, p_rationale, p_type);
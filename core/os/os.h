@@ -91,6 +91,7 @@ protected:
 
 	// functions used by main to initialize/deinitialize the OS
 	void add_logger(Logger *p_logger);
+	void set_async_logging(bool p_enabled, uint32_t p_max_queued = 4096);
 
 	virtual void initialize() = 0;
 	virtual void initialize_joypads() = 0;
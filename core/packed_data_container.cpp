@@ -184,21 +184,25 @@ Variant PackedDataContainer::_key_at_ofs(uint32_t p_ofs, const Variant &p_key, b
 		uint32_t hash = p_key.hash();
 		uint32_t len = decode_uint32(r + 4);
 
-		bool found = false;
-		for (uint32_t i = 0; i < len; i++) {
-			uint32_t khash = decode_uint32(r + 8 + i * 12 + 0);
-			if (khash == hash) {
-				Variant key = _get_at_ofs(decode_uint32(r + 8 + i * 12 + 4), rd, err);
-				if (err)
-					return Variant();
-				if (key == p_key) {
-					//key matches, return value
-					return _get_at_ofs(decode_uint32(r + 8 + i * 12 + 8), rd, err);
-				}
-				found = true;
+		//entries are sorted by hash when packing, so binary search for the first one with a matching hash
+		uint32_t lo = 0;
+		uint32_t hi = len;
+		while (lo < hi) {
+			uint32_t mid = (lo + hi) >> 1;
+			if (decode_uint32(r + 8 + mid * 12 + 0) < hash) {
+				lo = mid + 1;
 			} else {
-				if (found)
-					break;
+				hi = mid;
+			}
+		}
+
+		for (uint32_t i = lo; i < len && decode_uint32(r + 8 + i * 12 + 0) == hash; i++) {
+			Variant key = _get_at_ofs(decode_uint32(r + 8 + i * 12 + 4), rd, err);
+			if (err)
+				return Variant();
+			if (key == p_key) {
+				//key matches, return value
+				return _get_at_ofs(decode_uint32(r + 8 + i * 12 + 8), rd, err);
 			}
 		}
 
@@ -276,29 +280,28 @@ uint32_t PackedDataContainer::_pack(const Variant &p_data, Vector<uint8_t> &tmpd
 			encode_uint32(TYPE_DICT, &tmpdata.write[pos + 0]);
 			encode_uint32(len, &tmpdata.write[pos + 4]);
 
-			List<Variant> keys;
-			d.get_key_list(&keys);
-			List<DictKey> sortk;
-
-			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
-
-				DictKey dk;
-				dk.hash = E->get().hash();
-				dk.key = E->get();
-				sortk.push_back(dk);
+			Vector<DictKey> sortk;
+			sortk.resize(len);
+			{
+				DictKey *w = sortk.ptrw();
+				int idx = 0;
+				for (const Variant *K = d.next(); K; K = d.next(K)) {
+					w[idx].hash = K->hash();
+					w[idx].key = *K;
+					idx++;
+				}
 			}
 
 			sortk.sort();
 
-			int idx = 0;
-			for (List<DictKey>::Element *E = sortk.front(); E; E = E->next()) {
+			for (int idx = 0; idx < len; idx++) {
 
-				encode_uint32(E->get().hash, &tmpdata.write[pos + 8 + idx * 12 + 0]);
-				uint32_t ofs = _pack(E->get().key, tmpdata, string_cache);
+				const DictKey &dk = sortk[idx];
+				encode_uint32(dk.hash, &tmpdata.write[pos + 8 + idx * 12 + 0]);
+				uint32_t ofs = _pack(dk.key, tmpdata, string_cache);
 				encode_uint32(ofs, &tmpdata.write[pos + 8 + idx * 12 + 4]);
-				ofs = _pack(d[E->get().key], tmpdata, string_cache);
+				ofs = _pack(d[dk.key], tmpdata, string_cache);
 				encode_uint32(ofs, &tmpdata.write[pos + 8 + idx * 12 + 8]);
-				idx++;
 			}
 
 			return pos;
@@ -337,9 +340,7 @@ Error PackedDataContainer::pack(const Variant &p_data) {
 	Map<String, uint32_t> string_cache;
 	_pack(p_data, tmpdata, string_cache);
 	datalen = tmpdata.size();
-	data.resize(tmpdata.size());
-	uint8_t *w = data.ptrw();
-	copymem(w, tmpdata.ptr(), tmpdata.size());
+	data = tmpdata; //shares the buffer, no need to copy it
 
 	return OK;
 }
@@ -59,6 +59,7 @@
 #include "core/io/udp_server.h"
 #include "core/io/xml_parser.h"
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
 #include "core/math/expression.h"
 #include "core/math/geometry.h"
 #include "core/math/random_number_generator.h"
@@ -67,6 +68,7 @@
 #include "core/packed_data_container.h"
 #include "core/path_remap.h"
 #include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 #include "core/translation.h"
 #include "core/undo_redo.h"
 
@@ -90,6 +92,8 @@ static IP *ip = NULL;
 
 static _Geometry *_geometry = NULL;
 
+static ThreadWorkPool *thread_work_pool = NULL;
+
 extern Mutex _global_mutex;
 
 extern void register_global_constants();
@@ -105,6 +109,9 @@ void register_core_types() {
 	ObjectDB::setup();
 	ResourceCache::setup();
 
+	thread_work_pool = memnew(ThreadWorkPool);
+	thread_work_pool->init();
+
 	StringName::setup();
 	ResourceLoader::initialize();
 
@@ -205,6 +212,7 @@ void register_core_types() {
 	ClassDB::register_virtual_class<PackedDataContainerRef>();
 	ClassDB::register_class<AStar>();
 	ClassDB::register_class<AStar2D>();
+	ClassDB::register_class<AStarGrid2D>();
 	ClassDB::register_class<EncodedObjectAsID>();
 	ClassDB::register_class<RandomNumberGenerator>();
 
@@ -305,6 +313,9 @@ void unregister_core_types() {
 
 	ResourceLoader::finalize();
 
+	thread_work_pool->finish();
+	memdelete(thread_work_pool);
+
 	ClassDB::cleanup_defaults();
 	ObjectDB::cleanup();
 
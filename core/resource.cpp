@@ -54,7 +54,7 @@ void Resource::set_path(const String &p_path, bool p_take_over) {
 	if (path_cache != "") {
 
 		ResourceCache::lock->write_lock();
-		ResourceCache::resources.erase(path_cache);
+		ResourceCache::resources.remove(path_cache);
 		ResourceCache::lock->write_unlock();
 	}
 
@@ -68,7 +68,7 @@ void Resource::set_path(const String &p_path, bool p_take_over) {
 		if (p_take_over) {
 
 			ResourceCache::lock->write_lock();
-			Resource **res = ResourceCache::resources.getptr(p_path);
+			Resource **res = ResourceCache::resources.lookup_ptr(p_path);
 			if (res) {
 				(*res)->set_name("");
 			}
@@ -86,7 +86,7 @@ void Resource::set_path(const String &p_path, bool p_take_over) {
 	if (path_cache != "") {
 
 		ResourceCache::lock->write_lock();
-		ResourceCache::resources[path_cache] = this;
+		ResourceCache::resources.set(path_cache, this);
 		ResourceCache::lock->write_unlock();
 	}
 
@@ -445,7 +445,7 @@ Resource::~Resource() {
 
 	if (path_cache != "") {
 		ResourceCache::lock->write_lock();
-		ResourceCache::resources.erase(path_cache);
+		ResourceCache::resources.remove(path_cache);
 		ResourceCache::lock->write_unlock();
 	}
 	if (owners.size()) {
@@ -453,7 +453,7 @@ Resource::~Resource() {
 	}
 }
 
-HashMap<String, Resource *> ResourceCache::resources;
+OAHashMap<String, Resource *> ResourceCache::resources;
 #ifdef TOOLS_ENABLED
 HashMap<String, HashMap<String, int>> ResourceCache::resource_path_cache;
 #endif
@@ -463,20 +463,170 @@ RWLock *ResourceCache::lock = NULL;
 RWLock *ResourceCache::path_cache_lock = NULL;
 #endif
 
+Mutex *ResourceCache::retained_mutex = NULL;
+List<ResourceCache::Retained> ResourceCache::retained;
+HashMap<String, List<ResourceCache::Retained>::Element *> ResourceCache::retained_paths;
+HashMap<StringName, uint64_t> ResourceCache::retained_type_sizes;
+uint64_t ResourceCache::retained_size = 0;
+uint64_t ResourceCache::retain_budget = 0;
+uint64_t ResourceCache::hits = 0;
+uint64_t ResourceCache::misses = 0;
+
 void ResourceCache::setup() {
 
 	lock = RWLock::create();
 #ifdef TOOLS_ENABLED
 	path_cache_lock = RWLock::create();
 #endif
+	retained_mutex = memnew(Mutex);
 }
 
 void ResourceCache::clear() {
-	if (resources.size())
+
+	clear_retained();
+
+	if (resources.get_num_elements())
 		ERR_PRINT("Resources Still in use at Exit!");
 
 	resources.clear();
 	memdelete(lock);
+	memdelete(retained_mutex);
+	retained_mutex = NULL;
+}
+
+void ResourceCache::_trim_retained(Vector<Ref<Resource>> *r_evicted) {
+
+	//only resources nobody else references count towards the budget, the rest would stay alive anyway
+	uint64_t released_size = 0;
+	List<Retained>::Element *E = retained.front();
+	while (E) {
+		List<Retained>::Element *next = E->next();
+		Retained &r = E->get();
+
+		if (r.resource->reference_get_count() == 1) {
+			released_size += r.size;
+			if (released_size > retain_budget) {
+				released_size -= r.size;
+				retained_size -= r.size;
+				retained_type_sizes[r.type] -= r.size;
+				retained_paths.erase(r.path);
+				r_evicted->push_back(r.resource); //freed outside the lock
+				retained.erase(E);
+			}
+		}
+
+		E = next;
+	}
+}
+
+void ResourceCache::set_retain_budget(uint64_t p_bytes) {
+
+	Vector<Ref<Resource>> evicted;
+
+	retained_mutex->lock();
+	retain_budget = p_bytes;
+	_trim_retained(&evicted);
+	retained_mutex->unlock();
+}
+
+uint64_t ResourceCache::get_retain_budget() {
+
+	return retain_budget;
+}
+
+void ResourceCache::retain(const Ref<Resource> &p_resource, uint64_t p_size) {
+
+	if (retain_budget == 0 || p_resource.is_null() || p_resource->get_path() == "") {
+		return;
+	}
+
+	Vector<Ref<Resource>> evicted;
+
+	retained_mutex->lock();
+
+	List<Retained>::Element **E = retained_paths.getptr(p_resource->get_path());
+	if (E && (*E)->get().resource == p_resource) {
+		retained.move_to_front(*E);
+	} else {
+		if (E) {
+			//another resource took over the path
+			Retained &r = (*E)->get();
+			retained_size -= r.size;
+			retained_type_sizes[r.type] -= r.size;
+			evicted.push_back(r.resource);
+			retained.erase(*E);
+		}
+
+		Retained r;
+		r.resource = p_resource;
+		r.path = p_resource->get_path();
+		r.type = p_resource->get_class_name();
+		r.size = p_size;
+		retained.push_front(r);
+		retained_paths[r.path] = retained.front();
+
+		retained_size += p_size;
+		if (!retained_type_sizes.has(r.type)) {
+			retained_type_sizes[r.type] = 0;
+		}
+		retained_type_sizes[r.type] += p_size;
+	}
+
+	_trim_retained(&evicted);
+
+	retained_mutex->unlock();
+}
+
+void ResourceCache::notify_hit(const Ref<Resource> &p_resource) {
+
+	atomic_increment(&hits);
+
+	if (retain_budget == 0) {
+		return;
+	}
+
+	retained_mutex->lock();
+	List<Retained>::Element **E = retained_paths.getptr(p_resource->get_path());
+	if (E && (*E)->get().resource == p_resource) {
+		retained.move_to_front(*E);
+	}
+	retained_mutex->unlock();
+}
+
+void ResourceCache::clear_retained() {
+
+	if (!retained_mutex) {
+		return;
+	}
+
+	Vector<Ref<Resource>> evicted;
+
+	retained_mutex->lock();
+	for (List<Retained>::Element *E = retained.front(); E; E = E->next()) {
+		evicted.push_back(E->get().resource);
+	}
+	retained.clear();
+	retained_paths.clear();
+	retained_type_sizes.clear();
+	retained_size = 0;
+	retained_mutex->unlock();
+}
+
+uint64_t ResourceCache::get_retained_size() {
+
+	return retained_size;
+}
+
+void ResourceCache::get_retained_type_sizes(Map<StringName, uint64_t> *r_sizes) {
+
+	retained_mutex->lock();
+	const StringName *K = NULL;
+	while ((K = retained_type_sizes.next(K))) {
+		if (retained_type_sizes[*K] > 0) {
+			r_sizes->insert(*K, retained_type_sizes[*K]);
+		}
+	}
+	retained_mutex->unlock();
 }
 
 void ResourceCache::reload_externals() {
@@ -501,24 +651,21 @@ Resource *ResourceCache::get(const String &p_path) {
 
 	lock->read_lock();
 
-	Resource **res = resources.getptr(p_path);
+	//copy out while locked, entries move when other threads insert or erase
+	Resource **res = resources.lookup_ptr(p_path);
+	Resource *r = res ? *res : NULL;
 
 	lock->read_unlock();
 
-	if (!res) {
-		return NULL;
-	}
-
-	return *res;
+	return r;
 }
 
 void ResourceCache::get_cached_resources(List<Ref<Resource>> *p_resources) {
 
 	lock->read_lock();
-	const String *K = NULL;
-	while ((K = resources.next(K))) {
+	for (OAHashMap<String, Resource *>::Iterator it = resources.iter(); it.valid; it = resources.next_iter(it)) {
 
-		Resource *r = resources[*K];
+		Resource *r = *it.value;
 		p_resources->push_back(Ref<Resource>(r));
 	}
 	lock->read_unlock();
@@ -527,7 +674,7 @@ void ResourceCache::get_cached_resources(List<Ref<Resource>> *p_resources) {
 int ResourceCache::get_cached_resource_count() {
 
 	lock->read_lock();
-	int rc = resources.size();
+	int rc = resources.get_num_elements();
 	lock->read_unlock();
 
 	return rc;
@@ -545,10 +692,9 @@ void ResourceCache::dump(const char *p_file, bool p_short) {
 		ERR_FAIL_COND_MSG(!f, "Cannot create file at path '" + String(p_file) + "'.");
 	}
 
-	const String *K = NULL;
-	while ((K = resources.next(K))) {
+	for (OAHashMap<String, Resource *>::Iterator it = resources.iter(); it.valid; it = resources.next_iter(it)) {
 
-		Resource *r = resources[*K];
+		Resource *r = *it.value;
 
 		if (!type_count.has(r->get_class())) {
 			type_count[r->get_class()] = 0;
@@ -567,6 +713,14 @@ void ResourceCache::dump(const char *p_file, bool p_short) {
 		if (f)
 			f->store_line(E->key() + " count: " + itos(E->get()));
 	}
+
+	Map<StringName, uint64_t> retained_sizes;
+	get_retained_type_sizes(&retained_sizes);
+	for (Map<StringName, uint64_t>::Element *E = retained_sizes.front(); E; E = E->next()) {
+
+		if (f)
+			f->store_line(String(E->key()) + " retained: " + itos(E->get()));
+	}
 	if (f) {
 		f->close();
 		memdelete(f);
@@ -32,7 +32,9 @@
 #define RESOURCE_H
 
 #include "core/class_db.h"
+#include "core/oa_hash_map.h"
 #include "core/object.h"
+#include "core/os/mutex.h"
 #include "core/reference.h"
 #include "core/safe_refcount.h"
 #include "core/self_list.h"
@@ -148,7 +150,26 @@ class ResourceCache {
 	friend class Resource;
 	friend class ResourceLoader; //need the lock
 	static RWLock *lock;
-	static HashMap<String, Resource *> resources;
+	static OAHashMap<String, Resource *> resources;
+
+	//optional tier keeping recently used resources alive after they are released, see retain()
+	struct Retained {
+		Ref<Resource> resource;
+		String path;
+		StringName type;
+		uint64_t size = 0;
+	};
+
+	static Mutex *retained_mutex;
+	static List<Retained> retained; //most recently used first
+	static HashMap<String, List<Retained>::Element *> retained_paths;
+	static HashMap<StringName, uint64_t> retained_type_sizes;
+	static uint64_t retained_size;
+	static uint64_t retain_budget;
+	static uint64_t hits;
+	static uint64_t misses;
+
+	static void _trim_retained(Vector<Ref<Resource>> *r_evicted);
 #ifdef TOOLS_ENABLED
 	static HashMap<String, HashMap<String, int>> resource_path_cache; // each tscn has a set of resource paths and IDs
 	static RWLock *path_cache_lock;
@@ -165,6 +186,18 @@ public:
 	static void dump(const char *p_file = NULL, bool p_short = false);
 	static void get_cached_resources(List<Ref<Resource>> *p_resources);
 	static int get_cached_resource_count();
+
+	static void set_retain_budget(uint64_t p_bytes);
+	static uint64_t get_retain_budget();
+	static void retain(const Ref<Resource> &p_resource, uint64_t p_size);
+	static void clear_retained();
+	static uint64_t get_retained_size();
+	static void get_retained_type_sizes(Map<StringName, uint64_t> *r_sizes);
+
+	static void notify_hit(const Ref<Resource> &p_resource);
+	static void notify_miss() { atomic_increment(&misses); }
+	static uint64_t get_hit_count() { return hits; }
+	static uint64_t get_miss_count() { return misses; }
 };
 
 #endif // RESOURCE_H
@@ -31,10 +31,14 @@
 #ifndef RID_OWNER_H
 #define RID_OWNER_H
 
+#include "core/os/memory.h"
+#include "core/os/thread.h"
 #include "core/print_string.h"
 #include "core/rid.h"
 #include "core/spin_lock.h"
+
 #include <stdio.h>
+#include <atomic>
 #include <typeinfo>
 
 class RID_AllocBase {
@@ -63,56 +67,145 @@ public:
 template <class T, bool THREAD_SAFE = false>
 class RID_Alloc : public RID_AllocBase {
 
-	T **chunks;
+	// Lookups (getornull/owns) never lock. Chunks never move once allocated,
+	// and the arrays pointing to them are only replaced by bigger copies, with
+	// the old ones kept alive until destruction, so readers can never see a
+	// freed array. Validators are atomic, and they are written after the
+	// element is constructed (and before it's destroyed).
+
+	std::atomic<T **> chunks;
+	std::atomic<std::atomic<uint32_t> **> validator_chunks;
 	uint32_t **free_list_chunks;
-	uint32_t **validator_chunks;
+	uint32_t chunk_capacity;
+
+	void **retired_arrays;
+	uint32_t retired_count;
 
 	uint32_t elements_in_chunk;
-	uint32_t max_alloc;
-	uint32_t alloc_count;
+	std::atomic<uint32_t> max_alloc;
+	uint32_t free_list_pos; //elements in free_list_chunks below this position are taken
+	std::atomic<uint32_t> alloc_count;
 
 	const char *description;
 
-	SpinLock spin_lock;
+	SpinLock spin_lock; //protects growth and the shared free list
 
-public:
-	RID make_rid(const T &p_value) {
+	// In thread safe mode, allocation and free go through small free lists
+	// picked by thread ID, so threads mostly don't touch the shared one.
+	enum {
+		FREE_CACHE_COUNT = 16,
+		FREE_CACHE_SIZE = 64,
+	};
 
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
+	struct FreeCache {
+		SpinLock lock;
+		uint32_t count = 0;
+		uint32_t indices[FREE_CACHE_SIZE];
+	};
+
+	FreeCache *free_caches;
+
+	_FORCE_INLINE_ FreeCache *_get_free_cache() {
+		uint64_t thread_id = Thread::get_caller_id();
+		return &free_caches[(thread_id * 0x9E3779B97F4A7C15ULL) >> 60];
+	}
+
+	void _grow() {
+		//allocate a new chunk, must be called with spin_lock held (in thread safe mode)
+		uint32_t chunk_count = max_alloc.load(std::memory_order_relaxed) / elements_in_chunk;
+
+		T **chunks_ptr = chunks.load(std::memory_order_relaxed);
+		std::atomic<uint32_t> **validators_ptr = validator_chunks.load(std::memory_order_relaxed);
+
+		if (chunk_count == chunk_capacity) {
+			//grow pointer arrays, but keep the old ones around since readers may be using them
+			uint32_t new_capacity = chunk_capacity == 0 ? 16 : chunk_capacity * 2;
 
-		if (alloc_count == max_alloc) {
-			//allocate a new chunk
-			uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
-
-			//grow chunks
-			chunks = (T **)memrealloc(chunks, sizeof(T *) * (chunk_count + 1));
-			chunks[chunk_count] = (T *)memalloc(sizeof(T) * elements_in_chunk); //but don't initialize
-
-			//grow validators
-			validator_chunks = (uint32_t **)memrealloc(validator_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			validator_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
-			//grow free lists
-			free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
-
-			//initialize
-			for (uint32_t i = 0; i < elements_in_chunk; i++) {
-				//dont initialize chunk
-				validator_chunks[chunk_count][i] = 0xFFFFFFFF;
-				free_list_chunks[chunk_count][i] = alloc_count + i;
+			T **new_chunks = (T **)memalloc(sizeof(T *) * new_capacity);
+			std::atomic<uint32_t> **new_validators = (std::atomic<uint32_t> **)memalloc(sizeof(std::atomic<uint32_t> *) * new_capacity);
+			for (uint32_t i = 0; i < chunk_count; i++) {
+				new_chunks[i] = chunks_ptr[i];
+				new_validators[i] = validators_ptr[i];
 			}
 
-			max_alloc += elements_in_chunk;
+			if (chunks_ptr) {
+				retired_arrays = (void **)memrealloc(retired_arrays, sizeof(void *) * (retired_count + 2));
+				retired_arrays[retired_count++] = chunks_ptr;
+				retired_arrays[retired_count++] = validators_ptr;
+			}
+
+			//only the allocator uses the free list, so it can be reallocated normally
+			free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * new_capacity);
+
+			chunks_ptr = new_chunks;
+			validators_ptr = new_validators;
+			chunk_capacity = new_capacity;
+		}
+
+		chunks_ptr[chunk_count] = (T *)memalloc(sizeof(T) * elements_in_chunk); //but don't initialize
+		validators_ptr[chunk_count] = (std::atomic<uint32_t> *)memalloc(sizeof(std::atomic<uint32_t>) * elements_in_chunk);
+		free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
+
+		uint32_t first = chunk_count * elements_in_chunk;
+		for (uint32_t i = 0; i < elements_in_chunk; i++) {
+			//dont initialize chunk
+			memnew_placement(&validators_ptr[chunk_count][i], std::atomic<uint32_t>(0xFFFFFFFF));
+			free_list_chunks[chunk_count][i] = first + i;
 		}
 
-		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+		//publish arrays before the new size, so readers passing the bounds check see them
+		chunks.store(chunks_ptr, std::memory_order_release);
+		validator_chunks.store(validators_ptr, std::memory_order_release);
+		max_alloc.store(first + elements_in_chunk, std::memory_order_release);
+	}
+
+	_FORCE_INLINE_ uint32_t _pop_free_index() {
+		//must be called with spin_lock held (in thread safe mode)
+		if (free_list_pos == max_alloc.load(std::memory_order_relaxed)) {
+			_grow();
+		}
+		uint32_t index = free_list_chunks[free_list_pos / elements_in_chunk][free_list_pos % elements_in_chunk];
+		free_list_pos++;
+		return index;
+	}
+
+	_FORCE_INLINE_ void _push_free_index(uint32_t p_index) {
+		//must be called with spin_lock held (in thread safe mode)
+		free_list_pos--;
+		free_list_chunks[free_list_pos / elements_in_chunk][free_list_pos % elements_in_chunk] = p_index;
+	}
+
+	_FORCE_INLINE_ std::atomic<uint32_t> *_get_validator(uint32_t p_index) const {
+		//caller must have checked p_index against max_alloc
+		return &validator_chunks.load(std::memory_order_acquire)[p_index / elements_in_chunk][p_index % elements_in_chunk];
+	}
+
+public:
+	RID make_rid(const T &p_value) {
+
+		uint32_t free_index;
+
+		if (THREAD_SAFE) {
+			FreeCache *cache = _get_free_cache();
+			cache->lock.lock();
+			if (cache->count == 0) {
+				//refill half of the cache from the shared list
+				spin_lock.lock();
+				for (uint32_t i = 0; i < FREE_CACHE_SIZE / 2; i++) {
+					cache->indices[cache->count++] = _pop_free_index();
+				}
+				spin_lock.unlock();
+			}
+			free_index = cache->indices[--cache->count];
+			cache->lock.unlock();
+		} else {
+			free_index = _pop_free_index();
+		}
 
 		uint32_t free_chunk = free_index / elements_in_chunk;
 		uint32_t free_element = free_index % elements_in_chunk;
 
-		T *ptr = &chunks[free_chunk][free_element];
+		T *ptr = &chunks.load(std::memory_order_acquire)[free_chunk][free_element];
 		memnew_placement(ptr, T(p_value));
 
 		uint32_t validator = (uint32_t)(_gen_id() & 0xFFFFFFFF);
@@ -120,162 +213,101 @@ public:
 		id <<= 32;
 		id |= free_index;
 
-		validator_chunks[free_chunk][free_element] = validator;
-		alloc_count++;
-
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
+		_get_validator(free_index)->store(validator, std::memory_order_release);
+		alloc_count.fetch_add(1, std::memory_order_relaxed);
 
 		return _make_from_id(id);
 	}
 
 	_FORCE_INLINE_ T *getornull(const RID &p_rid) {
 
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		if (unlikely(idx >= max_alloc.load(std::memory_order_acquire))) {
 			return NULL;
 		}
 
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
-
 		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(validator_chunks[idx_chunk][idx_element] != validator)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		if (unlikely(_get_validator(idx)->load(std::memory_order_acquire) != validator)) {
 			return NULL;
 		}
 
-		T *ptr = &chunks[idx_chunk][idx_element];
-
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-
-		return ptr;
+		return &chunks.load(std::memory_order_acquire)[idx / elements_in_chunk][idx % elements_in_chunk];
 	}
 
 	_FORCE_INLINE_ bool owns(const RID &p_rid) {
 
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		if (unlikely(idx >= max_alloc.load(std::memory_order_acquire))) {
 			return false;
 		}
 
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
-
 		uint32_t validator = uint32_t(id >> 32);
 
-		bool owned = validator_chunks[idx_chunk][idx_element] == validator;
-
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-
-		return owned;
+		return _get_validator(idx)->load(std::memory_order_acquire) == validator;
 	}
 
 	_FORCE_INLINE_ void free(const RID &p_rid) {
 
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		if (unlikely(idx >= max_alloc.load(std::memory_order_acquire))) {
 			ERR_FAIL();
 		}
 
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
-
 		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(validator_chunks[idx_chunk][idx_element] != validator)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		//invalidate first, so lookups stop returning it before it's destroyed, and a concurrent free of the same RID fails
+		if (unlikely(!_get_validator(idx)->compare_exchange_strong(validator, 0xFFFFFFFF, std::memory_order_acq_rel))) {
 			ERR_FAIL();
 		}
 
-		chunks[idx_chunk][idx_element].~T();
-		validator_chunks[idx_chunk][idx_element] = 0xFFFFFFFF; // go invalid
-
-		alloc_count--;
-		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
+		chunks.load(std::memory_order_acquire)[idx / elements_in_chunk][idx % elements_in_chunk].~T();
+		alloc_count.fetch_sub(1, std::memory_order_relaxed);
 
 		if (THREAD_SAFE) {
-			spin_lock.unlock();
+			FreeCache *cache = _get_free_cache();
+			cache->lock.lock();
+			if (cache->count == FREE_CACHE_SIZE) {
+				//return half of the cache to the shared list
+				spin_lock.lock();
+				for (uint32_t i = 0; i < FREE_CACHE_SIZE / 2; i++) {
+					_push_free_index(cache->indices[--cache->count]);
+				}
+				spin_lock.unlock();
+			}
+			cache->indices[cache->count++] = idx;
+			cache->lock.unlock();
+		} else {
+			_push_free_index(idx);
 		}
 	}
 
 	_FORCE_INLINE_ uint32_t get_rid_count() const {
-		return alloc_count;
+		return alloc_count.load(std::memory_order_relaxed);
 	}
 
 	_FORCE_INLINE_ T *get_ptr_by_index(uint32_t p_index) {
-		ERR_FAIL_INDEX_V(p_index, alloc_count, NULL);
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-		uint64_t idx = free_list_chunks[p_index / elements_in_chunk][p_index % elements_in_chunk];
-		T *ptr = &chunks[idx / elements_in_chunk][idx % elements_in_chunk];
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-		return ptr;
+		uint32_t idx = _find_index(p_index);
+		ERR_FAIL_COND_V(idx == 0xFFFFFFFF, NULL);
+		return &chunks.load(std::memory_order_acquire)[idx / elements_in_chunk][idx % elements_in_chunk];
 	}
 
 	_FORCE_INLINE_ RID get_rid_by_index(uint32_t p_index) {
-		ERR_FAIL_INDEX_V(p_index, alloc_count, RID());
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-		uint64_t idx = free_list_chunks[p_index / elements_in_chunk][p_index % elements_in_chunk];
-		uint64_t validator = validator_chunks[idx / elements_in_chunk][idx % elements_in_chunk];
-
-		RID rid = _make_from_id((validator << 32) | idx);
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-		return rid;
+		uint32_t idx = _find_index(p_index);
+		ERR_FAIL_COND_V(idx == 0xFFFFFFFF, RID());
+		uint64_t validator = _get_validator(idx)->load(std::memory_order_acquire);
+		return _make_from_id((validator << 32) | idx);
 	}
 
 	void get_owned_list(List<RID> *p_owned) {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+		uint32_t max = max_alloc.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < max; i++) {
+			uint64_t validator = _get_validator(i)->load(std::memory_order_acquire);
 			if (validator != 0xFFFFFFFF) {
 				p_owned->push_back(_make_from_id((validator << 32) | i));
 			}
 		}
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
 	}
 
 	void set_description(const char *p_descrption) {
@@ -283,48 +315,84 @@ public:
 	}
 
 	RID_Alloc(uint32_t p_target_chunk_byte_size = 4096) {
-		chunks = NULL;
+		chunks.store(NULL);
+		validator_chunks.store(NULL);
 		free_list_chunks = NULL;
-		validator_chunks = NULL;
+		chunk_capacity = 0;
+		retired_arrays = NULL;
+		retired_count = 0;
 
 		elements_in_chunk = sizeof(T) > p_target_chunk_byte_size ? 1 : (p_target_chunk_byte_size / sizeof(T));
-		max_alloc = 0;
-		alloc_count = 0;
+		max_alloc.store(0);
+		free_list_pos = 0;
+		alloc_count.store(0);
 		description = NULL;
+
+		free_caches = THREAD_SAFE ? memnew_arr(FreeCache, FREE_CACHE_COUNT) : NULL;
 	}
 
 	~RID_Alloc() {
-		if (alloc_count) {
+		uint32_t max = max_alloc.load();
+		T **chunks_ptr = chunks.load();
+		std::atomic<uint32_t> **validators_ptr = validator_chunks.load();
+
+		if (alloc_count.load()) {
 			if (description) {
-				print_error("ERROR: " + itos(alloc_count) + " RID allocations of type '" + description + "' were leaked at exit.");
+				print_error("ERROR: " + itos(alloc_count.load()) + " RID allocations of type '" + description + "' were leaked at exit.");
 			} else {
 #ifdef NO_SAFE_CAST
-				print_error("ERROR: " + itos(alloc_count) + " RID allocations of type 'unknown' were leaked at exit.");
+				print_error("ERROR: " + itos(alloc_count.load()) + " RID allocations of type 'unknown' were leaked at exit.");
 #else
-				print_error("ERROR: " + itos(alloc_count) + " RID allocations of type '" + typeid(T).name() + "' were leaked at exit.");
+				print_error("ERROR: " + itos(alloc_count.load()) + " RID allocations of type '" + typeid(T).name() + "' were leaked at exit.");
 #endif
 			}
 
-			for (size_t i = 0; i < max_alloc; i++) {
-				uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+			for (size_t i = 0; i < max; i++) {
+				uint64_t validator = validators_ptr[i / elements_in_chunk][i % elements_in_chunk].load();
 				if (validator != 0xFFFFFFFF) {
-					chunks[i / elements_in_chunk][i % elements_in_chunk].~T();
+					chunks_ptr[i / elements_in_chunk][i % elements_in_chunk].~T();
 				}
 			}
 		}
 
-		uint32_t chunk_count = max_alloc / elements_in_chunk;
+		uint32_t chunk_count = max / elements_in_chunk;
 		for (uint32_t i = 0; i < chunk_count; i++) {
-			memfree(chunks[i]);
-			memfree(validator_chunks[i]);
+			memfree(chunks_ptr[i]);
+			memfree(validators_ptr[i]);
 			memfree(free_list_chunks[i]);
 		}
 
-		if (chunks) {
-			memfree(chunks);
+		if (chunks_ptr) {
+			memfree(chunks_ptr);
 			memfree(free_list_chunks);
-			memfree(validator_chunks);
+			memfree(validators_ptr);
+		}
+
+		for (uint32_t i = 0; i < retired_count; i++) {
+			memfree(retired_arrays[i]);
+		}
+		if (retired_arrays) {
+			memfree(retired_arrays);
+		}
+
+		if (free_caches) {
+			memdelete_arr(free_caches);
+		}
+	}
+
+private:
+	uint32_t _find_index(uint32_t p_index) {
+		//index of the p_index-th allocated element, slow, meant for debugging
+		uint32_t max = max_alloc.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < max; i++) {
+			if (_get_validator(i)->load(std::memory_order_acquire) != 0xFFFFFFFF) {
+				if (p_index == 0) {
+					return i;
+				}
+				p_index--;
+			}
 		}
+		return 0xFFFFFFFF;
 	}
 };
 
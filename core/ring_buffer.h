@@ -129,6 +129,15 @@ public:
 		return -1;
 	}
 
+	// The next p_size elements in place, or NULL when they wrap around the end of the buffer.
+	inline const T *peek_contiguous(int p_size) const {
+		ERR_FAIL_COND_V(p_size < 0 || data_left() < p_size, NULL);
+		if (read_pos + p_size > size()) {
+			return NULL;
+		}
+		return data.ptr() + read_pos;
+	}
+
 	inline int advance_read(int p_n) {
 		p_n = MIN(p_n, data_left());
 		inc(read_pos, p_n);
@@ -70,6 +70,10 @@ public:
 
 	int length() const;
 
+	_FORCE_INLINE_ const CharType *ptr() {
+		return current_buffer_ptr();
+	}
+
 	String as_string();
 
 	double as_double();
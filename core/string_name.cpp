@@ -39,23 +39,191 @@ StaticCString StaticCString::create(const char *p_ptr) {
 	return scs;
 }
 
-StringName::_Data *StringName::_table[STRING_TABLE_LEN];
+std::atomic<StringName::_Table *> StringName::table(NULL);
+uint32_t StringName::count = 0;
+std::atomic<uint32_t> StringName::epoch(0);
+std::atomic<uint32_t> StringName::readers[2];
+StringName::_Data *StringName::retired_data[2] = { NULL, NULL };
+StringName::_Table *StringName::retired_tables[2] = { NULL, NULL };
 
-StringName _scs_create(const char *p_chr) {
+StringName _scs_create(const char *p_chr, bool p_static) {
 
-	return (p_chr[0] ? StringName(StaticCString::create(p_chr)) : StringName());
+	return (p_chr[0] ? StringName(StaticCString::create(p_chr), p_static) : StringName());
 }
 
 bool StringName::configured = false;
 Mutex StringName::mutex;
 
-void StringName::setup() {
+StringName::_Table *StringName::_allocate_table(uint32_t p_len) {
 
-	ERR_FAIL_COND(configured);
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
+	_Table *t = memnew(_Table);
+	t->mask = p_len - 1;
+	t->buckets = memnew_arr(std::atomic<_Data *>, p_len);
+	for (uint32_t i = 0; i < p_len; i++) {
+		t->buckets[i].store(NULL, std::memory_order_relaxed);
+	}
+	t->next_retired = NULL;
+	return t;
+}
+
+void StringName::_grow_table() {
+
+	//called with the mutex held, readers still walking the old table may follow a moved node into
+	//a chain of the new one and miss their name, which only sends them to the locked path
+	_Table *old = table.load(std::memory_order_relaxed);
+	_Table *t = _allocate_table((old->mask + 1) * 2);
+
+	for (uint32_t i = 0; i <= old->mask; i++) {
+
+		_Data *d = old->buckets[i].load(std::memory_order_relaxed);
+		while (d) {
+			_Data *next = d->next.load(std::memory_order_relaxed);
+			std::atomic<_Data *> &bucket = t->buckets[d->hash & t->mask];
+			_Data *head = bucket.load(std::memory_order_relaxed);
+			d->prev = NULL;
+			d->next.store(head, std::memory_order_release);
+			if (head) {
+				head->prev = d;
+			}
+			bucket.store(d, std::memory_order_release);
+			d = next;
+		}
+	}
+
+	table.store(t, std::memory_order_release);
+
+	old->next_retired = retired_tables[epoch.load()];
+	retired_tables[epoch.load()] = old;
+	_reclaim();
+}
+
+void StringName::_reclaim() {
+
+	//called with the mutex held, whatever was retired before the last epoch flip can go once
+	//the readers that entered before it are done, then the epoch flips again
+	uint32_t previous = epoch.load() ^ 1;
+	if (readers[previous].load() != 0) {
+		return;
+	}
+
+	while (retired_data[previous]) {
+		_Data *d = retired_data[previous];
+		retired_data[previous] = d->prev;
+		memdelete(d);
+	}
+
+	while (retired_tables[previous]) {
+		_Table *t = retired_tables[previous];
+		retired_tables[previous] = t->next_retired;
+		memdelete_arr(t->buckets);
+		memdelete(t);
+	}
+
+	epoch.store(previous);
+}
+
+uint32_t StringName::_enter_read() {
+
+	while (true) {
+		uint32_t e = epoch.load();
+		readers[e].fetch_add(1);
+		if (epoch.load() == e) {
+			return e;
+		}
+		//flipped in between, this epoch may be getting reclaimed already
+		readers[e].fetch_sub(1);
+	}
+}
+
+void StringName::_exit_read(uint32_t p_epoch) {
+
+	readers[p_epoch].fetch_sub(1);
+}
+
+bool StringName::_compare(const _Data *p_data, const char *p_name) {
+
+	if (p_data->cname) {
+		return strcmp(p_data->cname, p_name) == 0;
+	}
+	return p_data->name == p_name;
+}
+
+bool StringName::_compare(const _Data *p_data, const CharType *p_name) {
+
+	if (p_data->cname) {
+		return String(p_data->cname) == p_name;
+	}
+	return p_data->name == p_name;
+}
+
+bool StringName::_compare(const _Data *p_data, const String &p_name) {
+
+	if (p_data->cname) {
+		return p_name == p_data->cname;
+	}
+	return p_data->name == p_name;
+}
+
+template <class T>
+StringName::_Data *StringName::_find(const T &p_name, uint32_t p_hash) {
+
+	_Table *t = table.load(std::memory_order_acquire);
+	_Data *d = t->buckets[p_hash & t->mask].load(std::memory_order_acquire);
+
+	while (d) {
+
+		// compare hash first
+		if (d->hash == p_hash && _compare(d, p_name))
+			break;
+		d = d->next.load(std::memory_order_acquire);
+	}
+
+	return d;
+}
+
+template <class T>
+StringName::_Data *StringName::_find_and_ref(const T &p_name, uint32_t p_hash) {
+
+	uint32_t e = _enter_read();
+	_Data *d = _find(p_name, p_hash);
+	if (d && !d->refcount.ref()) {
+		d = NULL; //being freed
+	}
+	_exit_read(e);
+
+	return d;
+}
+
+StringName::_Data *StringName::_insert(uint32_t p_hash, const char *p_cname, const String &p_name) {
 
-		_table[i] = NULL;
+	//called with the mutex held
+	if (count >= table.load(std::memory_order_relaxed)->mask + 1) {
+		_grow_table();
 	}
+
+	_Table *t = table.load(std::memory_order_relaxed);
+	std::atomic<_Data *> &bucket = t->buckets[p_hash & t->mask];
+	_Data *head = bucket.load(std::memory_order_relaxed);
+
+	_Data *d = memnew(_Data);
+	d->name = p_name;
+	d->refcount.init();
+	d->hash = p_hash;
+	d->cname = p_cname;
+	d->next.store(head, std::memory_order_relaxed);
+	d->prev = NULL;
+	if (head)
+		head->prev = d;
+	bucket.store(d, std::memory_order_release);
+	count++;
+
+	return d;
+}
+
+void StringName::setup() {
+
+	ERR_FAIL_COND(configured);
+	table.store(_allocate_table(1 << STRING_TABLE_BITS));
 	configured = true;
 }
 
@@ -64,50 +232,88 @@ void StringName::cleanup() {
 	MutexLock lock(mutex);
 
 	int lost_strings = 0;
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-
-		while (_table[i]) {
-
-			_Data *d = _table[i];
-			lost_strings++;
-			if (OS::get_singleton()->is_stdout_verbose()) {
-				if (d->cname) {
-					print_line("Orphan StringName: " + String(d->cname));
-				} else {
-					print_line("Orphan StringName: " + String(d->name));
+	_Table *t = table.load();
+	for (uint32_t i = 0; i <= t->mask; i++) {
+
+		_Data *d = t->buckets[i].load();
+		while (d) {
+
+			_Data *next = d->next.load();
+			if (d->refcount.get() > d->static_count) {
+				lost_strings++;
+				if (OS::get_singleton()->is_stdout_verbose()) {
+					if (d->cname) {
+						print_line("Orphan StringName: " + String(d->cname));
+					} else {
+						print_line("Orphan StringName: " + String(d->name));
+					}
 				}
 			}
 
-			_table[i] = _table[i]->next;
 			memdelete(d);
+			d = next;
 		}
 	}
 	if (lost_strings) {
 		print_verbose("StringName: " + itos(lost_strings) + " unclaimed string names at exit.");
 	}
+
+	for (int i = 0; i < 2; i++) {
+		while (retired_data[i]) {
+			_Data *d = retired_data[i];
+			retired_data[i] = d->prev;
+			memdelete(d);
+		}
+		while (retired_tables[i]) {
+			_Table *rt = retired_tables[i];
+			retired_tables[i] = rt->next_retired;
+			memdelete_arr(rt->buckets);
+			memdelete(rt);
+		}
+	}
+
+	memdelete_arr(t->buckets);
+	memdelete(t);
+	table.store(NULL);
+	count = 0;
+
+	//names cached by SNAME() are released by static destructors, after this
+	configured = false;
 }
 
 void StringName::unref() {
 
-	ERR_FAIL_COND(!configured);
+	if (!configured) {
+		_data = NULL;
+		return;
+	}
 
 	if (_data && _data->refcount.unref()) {
 
 		MutexLock lock(mutex);
 
+		_Table *t = table.load(std::memory_order_relaxed);
+		_Data *next = _data->next.load(std::memory_order_relaxed);
+
 		if (_data->prev) {
-			_data->prev->next = _data->next;
+			_data->prev->next.store(next, std::memory_order_release);
 		} else {
-			if (_table[_data->idx] != _data) {
+			std::atomic<_Data *> &bucket = t->buckets[_data->hash & t->mask];
+			if (bucket.load(std::memory_order_relaxed) != _data) {
 				ERR_PRINT("BUG!");
 			}
-			_table[_data->idx] = _data->next;
+			bucket.store(next, std::memory_order_release);
 		}
 
-		if (_data->next) {
-			_data->next->prev = _data->prev;
+		if (next) {
+			next->prev = _data->prev;
 		}
-		memdelete(_data);
+		count--;
+
+		//readers may still be on it, its next pointer is left intact so they can go on
+		_data->prev = retired_data[epoch.load()];
+		retired_data[epoch.load()] = _data;
+		_reclaim();
 	}
 
 	_data = NULL;
@@ -178,43 +384,26 @@ StringName::StringName(const char *p_name) {
 	if (!p_name || p_name[0] == 0)
 		return; //empty, ignore
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
+	_data = _find_and_ref(p_name, hash);
+	if (_data) {
+		// exists
+		return;
 	}
 
-	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			return;
-		}
+	MutexLock lock(mutex);
+
+	_data = _find(p_name, hash);
+	if (_data && _data->refcount.ref()) {
+		// created in the meantime
+		return;
 	}
 
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = NULL;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
+	_data = _insert(hash, NULL, p_name);
 }
 
-StringName::StringName(const StaticCString &p_static_string) {
+StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 
 	_data = NULL;
 
@@ -222,40 +411,22 @@ StringName::StringName(const StaticCString &p_static_string) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_static_string.ptr);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
+	_data = _find_and_ref(p_static_string.ptr, hash);
 
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_static_string.ptr)
-			break;
-		_data = _data->next;
-	}
+	MutexLock lock(mutex);
 
-	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			return;
+	if (!_data) {
+		_data = _find(p_static_string.ptr, hash);
+		if (!_data || !_data->refcount.ref()) {
+			_data = _insert(hash, p_static_string.ptr, String());
 		}
 	}
 
-	_data = memnew(_Data);
-
-	_data->refcount.init();
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
+	if (p_static) {
+		_data->static_count++;
+	}
 }
 
 StringName::StringName(const String &p_name) {
@@ -267,38 +438,23 @@ StringName::StringName(const String &p_name) {
 	if (p_name == String())
 		return;
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
 
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
+	_data = _find_and_ref(p_name, hash);
+	if (_data) {
+		// exists
+		return;
 	}
 
-	if (_data) {
-		if (_data->refcount.ref()) {
-			// exists
-			return;
-		}
+	MutexLock lock(mutex);
+
+	_data = _find(p_name, hash);
+	if (_data && _data->refcount.ref()) {
+		// created in the meantime
+		return;
 	}
 
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = NULL;
-	_data->next = _table[idx];
-	_data->prev = NULL;
-	if (_table[idx])
-		_table[idx]->prev = _data;
-	_table[idx] = _data;
+	_data = _insert(hash, NULL, p_name);
 }
 
 StringName StringName::search(const char *p_name) {
@@ -309,21 +465,17 @@ StringName StringName::search(const char *p_name) {
 	if (!p_name[0])
 		return StringName();
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
 
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
+	_Data *_data = _find_and_ref(p_name, hash);
+	if (_data) {
+		return StringName(_data);
 	}
 
+	//the lookup above can miss while the table grows, make sure
+	MutexLock lock(mutex);
+
+	_data = _find(p_name, hash);
 	if (_data && _data->refcount.ref()) {
 		return StringName(_data);
 	}
@@ -339,22 +491,17 @@ StringName StringName::search(const CharType *p_name) {
 	if (!p_name[0])
 		return StringName();
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name)
-			break;
-		_data = _data->next;
+	_Data *_data = _find_and_ref(p_name, hash);
+	if (_data) {
+		return StringName(_data);
 	}
 
+	//the lookup above can miss while the table grows, make sure
+	MutexLock lock(mutex);
+
+	_data = _find(p_name, hash);
 	if (_data && _data->refcount.ref()) {
 		return StringName(_data);
 	}
@@ -365,22 +512,17 @@ StringName StringName::search(const String &p_name) {
 
 	ERR_FAIL_COND_V(p_name == "", StringName());
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-
-		// compare hash first
-		if (_data->hash == hash && p_name == _data->get_name())
-			break;
-		_data = _data->next;
+	_Data *_data = _find_and_ref(p_name, hash);
+	if (_data) {
+		return StringName(_data);
 	}
 
+	//the lookup above can miss while the table grows, make sure
+	MutexLock lock(mutex);
+
+	_data = _find(p_name, hash);
 	if (_data && _data->refcount.ref()) {
 		return StringName(_data);
 	}
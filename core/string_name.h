@@ -35,6 +35,8 @@
 #include "core/safe_refcount.h"
 #include "core/ustring.h"
 
+#include <atomic>
+
 struct StaticCString {
 
 	const char *ptr;
@@ -45,9 +47,7 @@ class StringName {
 
 	enum {
 
-		STRING_TABLE_BITS = 12,
-		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_BITS = 12, //initial size, the table grows with the amount of names
 	};
 
 	struct _Data {
@@ -56,19 +56,33 @@ class StringName {
 		String name;
 
 		String get_name() const { return cname ? String(cname) : name; }
-		int idx;
 		uint32_t hash;
+		uint32_t static_count; //references held by SNAME() call sites, which are released after cleanup
 		_Data *prev;
-		_Data *next;
+		std::atomic<_Data *> next;
 		_Data() {
 			cname = NULL;
-			next = prev = NULL;
-			idx = 0;
+			next = NULL;
+			prev = NULL;
 			hash = 0;
+			static_count = 0;
 		}
 	};
 
-	static _Data *_table[STRING_TABLE_LEN];
+	struct _Table {
+		uint32_t mask;
+		std::atomic<_Data *> *buckets;
+		_Table *next_retired;
+	};
+
+	//lookups walk the table without locking, anything unlinked from it while they may still be reading
+	//is retired and only freed once every reader that started before that has left, see _reclaim()
+	static std::atomic<_Table *> table;
+	static uint32_t count;
+	static std::atomic<uint32_t> epoch;
+	static std::atomic<uint32_t> readers[2];
+	static _Data *retired_data[2];
+	static _Table *retired_tables[2];
 
 	_Data *_data;
 
@@ -87,6 +101,22 @@ class StringName {
 	static void cleanup();
 	static bool configured;
 
+	static _Table *_allocate_table(uint32_t p_len);
+	static void _grow_table();
+	static void _reclaim();
+	static uint32_t _enter_read();
+	static void _exit_read(uint32_t p_epoch);
+
+	static bool _compare(const _Data *p_data, const char *p_name);
+	static bool _compare(const _Data *p_data, const CharType *p_name);
+	static bool _compare(const _Data *p_data, const String &p_name);
+
+	template <class T>
+	static _Data *_find(const T &p_name, uint32_t p_hash);
+	template <class T>
+	static _Data *_find_and_ref(const T &p_name, uint32_t p_hash);
+	static _Data *_insert(uint32_t p_hash, const char *p_cname, const String &p_name);
+
 	StringName(_Data *p_data) { _data = p_data; }
 
 public:
@@ -159,11 +189,15 @@ public:
 	StringName(const char *p_name);
 	StringName(const StringName &p_name);
 	StringName(const String &p_name);
-	StringName(const StaticCString &p_static_string);
+	StringName(const StaticCString &p_static_string, bool p_static = false);
 	StringName();
 	~StringName();
 };
 
-StringName _scs_create(const char *p_chr);
+StringName _scs_create(const char *p_chr, bool p_static = false);
+
+// creates the StringName once per call site and returns the cached handle afterwards,
+// use it with string literals in code that runs often
+#define SNAME(m_arg) ([]() -> const StringName & { static StringName sname = _scs_create(m_arg, true); return sname; })()
 
 #endif // STRING_NAME_H
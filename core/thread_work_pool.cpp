@@ -31,15 +31,290 @@
 #include "thread_work_pool.h"
 #include "core/os/os.h"
 
+ThreadWorkPool *ThreadWorkPool::singleton = nullptr;
+
+static thread_local ThreadWorkPool *current_pool = nullptr;
+static thread_local int current_thread_index = -1;
+
+// Failed attempts to find work before a waiting thread blocks.
+static const uint32_t WAIT_SPIN_COUNT = 64;
+
+void ThreadWorkPool::WorkQueue::push_back(const WorkItem &p_item) {
+
+	lock.lock();
+	if (count == capacity) {
+		uint32_t new_capacity = capacity ? capacity * 2 : 16;
+		WorkItem *new_items = (WorkItem *)memalloc(sizeof(WorkItem) * new_capacity);
+		for (uint32_t i = 0; i < count; i++) {
+			new_items[i] = items[(head + i) & (capacity - 1)];
+		}
+		if (items) {
+			memfree(items);
+		}
+		items = new_items;
+		capacity = new_capacity;
+		head = 0;
+	}
+	items[(head + count) & (capacity - 1)] = p_item;
+	count++;
+	lock.unlock();
+}
+
+bool ThreadWorkPool::WorkQueue::pop_back(WorkItem &r_item) {
+
+	lock.lock();
+	if (count == 0) {
+		lock.unlock();
+		return false;
+	}
+	count--;
+	r_item = items[(head + count) & (capacity - 1)];
+	lock.unlock();
+	return true;
+}
+
+bool ThreadWorkPool::WorkQueue::pop_front(WorkItem &r_item) {
+
+	lock.lock();
+	if (count == 0) {
+		lock.unlock();
+		return false;
+	}
+	r_item = items[head];
+	head = (head + 1) & (capacity - 1);
+	count--;
+	lock.unlock();
+	return true;
+}
+
+ThreadWorkPool::WorkQueue::~WorkQueue() {
+
+	if (items) {
+		memfree(items);
+	}
+}
+
+int ThreadWorkPool::_get_current_thread_index() const {
+
+	return current_pool == this ? current_thread_index : -1;
+}
+
+bool ThreadWorkPool::_pop_item(int p_thread_index, WorkItem &r_item) {
+
+	if (queued_items.load() == 0) {
+		return false;
+	}
+
+	bool found = false;
+
+	if (p_thread_index >= 0) {
+		found = threads[p_thread_index].queue.pop_back(r_item);
+	}
+
+	if (!found) {
+		found = injection_queue.pop_front(r_item);
+	}
+
+	if (!found) {
+		// Steal from the other threads, starting from the next one to spread contention.
+		uint32_t from = p_thread_index >= 0 ? p_thread_index + 1 : 0;
+		for (uint32_t i = 0; i < thread_count && !found; i++) {
+			uint32_t victim = (from + i) % thread_count;
+			if (int(victim) == p_thread_index) {
+				continue;
+			}
+			found = threads[victim].queue.pop_front(r_item);
+		}
+	}
+
+	if (found) {
+		queued_items.fetch_sub(1);
+	}
+
+	return found;
+}
+
+bool ThreadWorkPool::_process_item(int p_thread_index) {
+
+	WorkItem item;
+	if (!_pop_item(p_thread_index, item)) {
+		return false;
+	}
+
+	BaseTask *task = item.task;
+	task->work(item.from, item.to);
+
+	if (task->pending_chunks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		_task_completed(task);
+	}
+
+	return true;
+}
+
+void ThreadWorkPool::_push_items(BaseTask *p_task) {
+
+	uint32_t chunks = (p_task->elements + p_task->chunk_size - 1) / p_task->chunk_size;
+	if (chunks == 0) {
+		_task_completed(p_task);
+		return;
+	}
+
+	p_task->pending_chunks.store(chunks);
+
+	int thread_index = _get_current_thread_index();
+	WorkQueue &queue = thread_index >= 0 ? threads[thread_index].queue : injection_queue;
+
+	for (uint32_t i = 0; i < chunks; i++) {
+		WorkItem item;
+		item.task = p_task;
+		item.from = i * p_task->chunk_size;
+		item.to = MIN(item.from + p_task->chunk_size, p_task->elements);
+		queue.push_back(item);
+	}
+
+	queued_items.fetch_add(chunks);
+
+	// Only wake up as many threads as there is work for.
+	uint32_t to_wake = MIN(sleeping_threads.load(), chunks);
+	for (uint32_t i = 0; i < to_wake; i++) {
+		work_available.post();
+	}
+	to_wake = MIN(waiting_threads.load(), chunks);
+	for (uint32_t i = 0; i < to_wake; i++) {
+		waiter_wake.post();
+	}
+}
+
+void ThreadWorkPool::_task_completed(BaseTask *p_task) {
+
+	Vector<BaseTask *> dependents;
+	task_mutex.lock();
+	p_task->completed.store(true);
+	dependents = p_task->dependents;
+	p_task->dependents.clear();
+	task_mutex.unlock();
+
+	for (int i = 0; i < dependents.size(); i++) {
+		BaseTask *dependent = dependents[i];
+		if (dependent->pending_dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			_push_items(dependent);
+		}
+	}
+
+	// Blocked waiters don't know which task they are woken for, let them all check.
+	uint32_t to_wake = waiting_threads.load();
+	for (uint32_t i = 0; i < to_wake; i++) {
+		waiter_wake.post();
+	}
+
+	// Must be the last access to the task, the waiter frees it right after.
+	p_task->done.post();
+}
+
+ThreadWorkPool::TaskID ThreadWorkPool::_add_task(BaseTask *p_task, const Vector<TaskID> &p_dependencies) {
+
+	p_task->completed.store(false);
+	p_task->pending_chunks.store(0);
+	// Hold an extra dependency so the task can't be scheduled while being registered.
+	p_task->pending_dependencies.store(1);
+
+	task_mutex.lock();
+	TaskID id = ++last_task_id;
+	p_task->id = id;
+	tasks.set(id, p_task);
+	for (int i = 0; i < p_dependencies.size(); i++) {
+		BaseTask **dependency = tasks.getptr(p_dependencies[i]);
+		if (!dependency) {
+			// Already waited for, hence completed.
+			continue;
+		}
+		if (!(*dependency)->completed.load(std::memory_order_acquire)) {
+			(*dependency)->dependents.push_back(p_task);
+			p_task->pending_dependencies.fetch_add(1);
+		}
+	}
+	task_mutex.unlock();
+
+	if (p_task->pending_dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		_push_items(p_task);
+	}
+
+	return id;
+}
+
+bool ThreadWorkPool::is_task_completed(TaskID p_task) const {
+
+	MutexLock<BinaryMutex> lock(task_mutex);
+	BaseTask *const *task = tasks.getptr(p_task);
+	ERR_FAIL_COND_V_MSG(!task, false, "Invalid task ID, or task was already waited for.");
+	return (*task)->completed.load(std::memory_order_acquire);
+}
+
+void ThreadWorkPool::wait_for_task(TaskID p_task) {
+
+	BaseTask *task = nullptr;
+	{
+		MutexLock<BinaryMutex> lock(task_mutex);
+		BaseTask **task_ptr = tasks.getptr(p_task);
+		ERR_FAIL_COND_MSG(!task_ptr, "Invalid task ID, or task was already waited for.");
+		task = *task_ptr;
+		ERR_FAIL_COND_MSG(task->waiting, "Task is already being waited for by another thread.");
+		task->waiting = true;
+	}
+
+	int thread_index = _get_current_thread_index();
+
+	// Help with the pending work instead of blocking, this is what makes nested tasks possible.
+	// Keep trying until the task completes: chunks of dependents are pushed as dependencies
+	// finish, and every worker may be in a nested wait like this one when that happens.
+	// When there is nothing to do for a while, block until work is pushed or a task completes.
+	uint32_t idle = 0;
+	while (!task->completed.load()) {
+		if (_process_item(thread_index)) {
+			idle = 0;
+			continue;
+		}
+		if (idle < WAIT_SPIN_COUNT) {
+			idle++;
+			std::this_thread::yield();
+			continue;
+		}
+
+		waiting_threads.fetch_add(1);
+		// Check again after announcing, so a push or completion in between is not missed.
+		if (!task->completed.load() && queued_items.load() == 0) {
+			waiter_wake.wait();
+		}
+		waiting_threads.fetch_sub(1);
+	}
+
+	// Completion is flagged before the last access to the task, wait for it before freeing.
+	task->done.wait();
+
+	task_mutex.lock();
+	tasks.erase(p_task);
+	task_mutex.unlock();
+
+	memdelete(task);
+}
+
 void ThreadWorkPool::_thread_function(ThreadData *p_thread) {
 
-	while (true) {
-		p_thread->start.wait();
-		if (p_thread->exit.load()) {
-			break;
+	ThreadWorkPool *pool = p_thread->pool;
+	current_pool = pool;
+	current_thread_index = p_thread->index;
+
+	while (!pool->exit_threads.load()) {
+		if (pool->_process_item(p_thread->index)) {
+			continue;
 		}
-		p_thread->work->work();
-		p_thread->completed.post();
+
+		pool->sleeping_threads.fetch_add(1);
+		// Check again after announcing, so work pushed in between is not missed.
+		if (pool->queued_items.load() == 0 && !pool->exit_threads.load()) {
+			pool->work_available.wait();
+		}
+		pool->sleeping_threads.fetch_sub(1);
 	}
 }
 
@@ -48,36 +323,70 @@ void ThreadWorkPool::init(int p_thread_count) {
 	if (p_thread_count < 0) {
 		p_thread_count = OS::get_singleton()->get_processor_count();
 	}
+#ifdef NO_THREADS
+	p_thread_count = 0; // Waiting threads process all the work.
+#endif
 
 	thread_count = p_thread_count;
+	exit_threads.store(false);
 	threads = memnew_arr(ThreadData, thread_count);
 
 	for (uint32_t i = 0; i < thread_count; i++) {
-		threads[i].exit.store(false);
+		threads[i].pool = this;
+		threads[i].index = i;
 		threads[i].thread = memnew(std::thread(ThreadWorkPool::_thread_function, &threads[i]));
 	}
 }
 
 void ThreadWorkPool::finish() {
 
-	if (threads == nullptr) {
-		return;
+	if (threads != nullptr) {
+		exit_threads.store(true);
+		for (uint32_t i = 0; i < thread_count; i++) {
+			work_available.post();
+		}
+		for (uint32_t i = 0; i < thread_count; i++) {
+			threads[i].thread->join();
+			memdelete(threads[i].thread);
+		}
+
+		memdelete_arr(threads);
+		threads = nullptr;
 	}
+	thread_count = 0;
 
-	for (uint32_t i = 0; i < thread_count; i++) {
-		threads[i].exit.store(true);
-		threads[i].start.post();
+	task_mutex.lock();
+	if (tasks.size()) {
+		WARN_PRINT(itos(tasks.size()) + " task(s) were never waited for.");
+		const TaskID *key = nullptr;
+		while ((key = tasks.next(key))) {
+			memdelete(tasks[*key]);
+		}
+		tasks.clear();
 	}
-	for (uint32_t i = 0; i < thread_count; i++) {
-		threads[i].thread->join();
-		memdelete(threads[i].thread);
+	task_mutex.unlock();
+
+	WorkItem item;
+	while (injection_queue.pop_front(item)) {
 	}
+	queued_items.store(0);
+}
 
-	memdelete_arr(threads);
-	threads = nullptr;
+ThreadWorkPool::ThreadWorkPool() {
+
+	queued_items.store(0);
+	sleeping_threads.store(0);
+	exit_threads.store(false);
+	waiting_threads.store(0);
+	if (singleton == nullptr) {
+		singleton = this;
+	}
 }
 
 ThreadWorkPool::~ThreadWorkPool() {
 
 	finish();
+	if (singleton == this) {
+		singleton = nullptr;
+	}
 }
@@ -31,81 +31,173 @@
 #ifndef THREAD_WORK_POOL_H
 #define THREAD_WORK_POOL_H
 
+#include "core/hash_map.h"
 #include "core/os/memory.h"
+#include "core/os/mutex.h"
 #include "core/os/semaphore.h"
+#include "core/spin_lock.h"
+#include "core/vector.h"
 #include <atomic>
 #include <thread>
-class ThreadWorkPool {
 
-	std::atomic<uint32_t> index;
+// Work stealing task scheduler.
+//
+// Tasks are split into chunks which are pushed to per-thread deques. Workers
+// pop from their own deque (LIFO, for cache locality) and steal from the front
+// of the other deques when they run dry. Threads waiting on a task help
+// processing pending work, so tasks can be nested and issued concurrently from
+// any thread, including from within other tasks.
+//
+// Every task added must be waited on exactly once with wait_for_task(), which
+// also releases it.
+
+class ThreadWorkPool {
+public:
+	typedef uint64_t TaskID;
+	static const TaskID INVALID_TASK_ID = 0;
+
+private:
+	struct BaseTask {
+		TaskID id = INVALID_TASK_ID;
+		uint32_t elements = 0;
+		uint32_t chunk_size = 1;
+		std::atomic<uint32_t> pending_chunks;
+		std::atomic<uint32_t> pending_dependencies;
+		std::atomic<bool> completed;
+		bool waiting = false;
+		Vector<BaseTask *> dependents; // Protected by task_mutex.
+		Semaphore done;
+
+		virtual void work(uint32_t p_from, uint32_t p_to) = 0;
+		virtual ~BaseTask() = default;
+	};
 
-	struct BaseWork {
-		std::atomic<uint32_t> *index;
-		uint32_t max_elements;
-		virtual void work() = 0;
-		virtual ~BaseWork() = default;
+	template <class C, class M, class U>
+	struct Task : public BaseTask {
+		C *instance;
+		M method;
+		U userdata;
+		virtual void work(uint32_t p_from, uint32_t p_to) {
+			(instance->*method)(userdata);
+		}
 	};
 
 	template <class C, class M, class U>
-	struct Work : public BaseWork {
+	struct GroupTask : public BaseTask {
 		C *instance;
 		M method;
 		U userdata;
-		virtual void work() {
-
-			while (true) {
-				uint32_t work_index = index->fetch_add(1, std::memory_order_relaxed);
-				if (work_index >= max_elements) {
-					break;
-				}
-				(instance->*method)(work_index, userdata);
+		virtual void work(uint32_t p_from, uint32_t p_to) {
+			for (uint32_t i = p_from; i < p_to; i++) {
+				(instance->*method)(i, userdata);
 			}
 		}
 	};
 
+	struct WorkItem {
+		BaseTask *task = nullptr;
+		uint32_t from = 0;
+		uint32_t to = 0;
+	};
+
+	// Double ended queue, the owner thread works on the back, thieves on the front.
+	struct WorkQueue {
+		SpinLock lock;
+		WorkItem *items = nullptr;
+		uint32_t capacity = 0; // Always a power of two.
+		uint32_t head = 0;
+		uint32_t count = 0;
+
+		void push_back(const WorkItem &p_item);
+		bool pop_back(WorkItem &r_item);
+		bool pop_front(WorkItem &r_item);
+		~WorkQueue();
+	};
+
 	struct ThreadData {
-		std::thread *thread;
-		Semaphore start;
-		Semaphore completed;
-		std::atomic<bool> exit;
-		BaseWork *work;
+		ThreadWorkPool *pool = nullptr;
+		int index = -1;
+		std::thread *thread = nullptr;
+		WorkQueue queue;
 	};
 
 	ThreadData *threads = nullptr;
 	uint32_t thread_count = 0;
 
+	WorkQueue injection_queue; // Work issued from threads outside the pool.
+	std::atomic<uint32_t> queued_items;
+	std::atomic<uint32_t> sleeping_threads;
+	std::atomic<bool> exit_threads;
+	Semaphore work_available;
+	std::atomic<uint32_t> waiting_threads; // Blocked in wait_for_task().
+	Semaphore waiter_wake;
+
+	BinaryMutex task_mutex;
+	HashMap<TaskID, BaseTask *> tasks;
+	TaskID last_task_id = INVALID_TASK_ID;
+
+	static ThreadWorkPool *singleton;
+
 	static void _thread_function(ThreadData *p_thread);
 
+	int _get_current_thread_index() const;
+	bool _pop_item(int p_thread_index, WorkItem &r_item);
+	bool _process_item(int p_thread_index);
+	void _push_items(BaseTask *p_task);
+	void _task_completed(BaseTask *p_task);
+	TaskID _add_task(BaseTask *p_task, const Vector<TaskID> &p_dependencies);
+
 public:
+	// Runs (p_instance->*p_method)(p_userdata) once all p_dependencies are completed.
 	template <class C, class M, class U>
-	void do_work(uint32_t p_elements, C *p_instance, M p_method, U p_userdata) {
-
-		ERR_FAIL_COND(!threads); //never initialized
+	TaskID add_task(C *p_instance, M p_method, U p_userdata, const Vector<TaskID> &p_dependencies = Vector<TaskID>()) {
 
-		index.store(0);
+		Task<C, M, U> *task = memnew((Task<C, M, U>));
+		task->instance = p_instance;
+		task->method = p_method;
+		task->userdata = p_userdata;
+		task->elements = 1;
+		task->chunk_size = 1;
 
-		Work<C, M, U> *w = memnew((Work<C, M, U>));
-		w->instance = p_instance;
-		w->userdata = p_userdata;
-		w->method = p_method;
-		w->index = &index;
-		w->max_elements = p_elements;
+		return _add_task(task, p_dependencies);
+	}
 
-		for (uint32_t i = 0; i < thread_count; i++) {
-			threads[i].work = w;
-			threads[i].start.post();
-		}
-		for (uint32_t i = 0; i < thread_count; i++) {
-			threads[i].completed.wait();
-			threads[i].work = nullptr;
+	// Runs (p_instance->*p_method)(index, p_userdata) for every index in [0, p_elements),
+	// in chunks of p_chunk_size consecutive elements (0 picks a size based on the thread count).
+	template <class C, class M, class U>
+	TaskID add_group_task(uint32_t p_elements, C *p_instance, M p_method, U p_userdata, uint32_t p_chunk_size = 0, const Vector<TaskID> &p_dependencies = Vector<TaskID>()) {
+
+		GroupTask<C, M, U> *task = memnew((GroupTask<C, M, U>));
+		task->instance = p_instance;
+		task->method = p_method;
+		task->userdata = p_userdata;
+		task->elements = p_elements;
+		if (p_chunk_size == 0) {
+			p_chunk_size = MAX(1u, p_elements / ((thread_count + 1) * 4));
 		}
+		task->chunk_size = p_chunk_size;
 
-		memdelete(w);
+		return _add_task(task, p_dependencies);
 	}
 
+	bool is_task_completed(TaskID p_task) const;
+	void wait_for_task(TaskID p_task);
+
+	// Blocking parallel for, the calling thread helps processing the work.
+	template <class C, class M, class U>
+	void do_work(uint32_t p_elements, C *p_instance, M p_method, U p_userdata) {
+
+		wait_for_task(add_group_task(p_elements, p_instance, p_method, p_userdata));
+	}
+
+	uint32_t get_thread_count() const { return thread_count; }
+
+	static ThreadWorkPool *get_singleton() { return singleton; }
+
 	void init(int p_thread_count = -1);
 	void finish();
+	ThreadWorkPool();
 	~ThreadWorkPool();
 };
 
-#endif // THREAD_POOL_H
+#endif // THREAD_WORK_POOL_H
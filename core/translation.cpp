@@ -850,6 +850,10 @@ void Translation::set_locale(const String &p_locale) {
 		locale = univ_locale;
 	}
 
+	if (TranslationServer::get_singleton()) {
+		TranslationServer::get_singleton()->invalidate_cache();
+	}
+
 	if (OS::get_singleton()->get_main_loop()) {
 		OS::get_singleton()->get_main_loop()->notification(MainLoop::NOTIFICATION_TRANSLATION_CHANGED);
 	}
@@ -858,6 +862,9 @@ void Translation::set_locale(const String &p_locale) {
 void Translation::add_message(const StringName &p_src_text, const StringName &p_xlated_text) {
 
 	translation_map[p_src_text] = p_xlated_text;
+	if (TranslationServer::get_singleton()) {
+		TranslationServer::get_singleton()->invalidate_cache();
+	}
 }
 StringName Translation::get_message(const StringName &p_src_text) const {
 
@@ -871,6 +878,9 @@ StringName Translation::get_message(const StringName &p_src_text) const {
 void Translation::erase_message(const StringName &p_src_text) {
 
 	translation_map.erase(p_src_text);
+	if (TranslationServer::get_singleton()) {
+		TranslationServer::get_singleton()->invalidate_cache();
+	}
 }
 
 void Translation::get_message_list(List<StringName> *r_messages) const {
@@ -975,6 +985,8 @@ void TranslationServer::set_locale(const String &p_locale) {
 		locale = univ_locale;
 	}
 
+	invalidate_cache();
+
 	if (OS::get_singleton()->get_main_loop()) {
 		OS::get_singleton()->get_main_loop()->notification(MainLoop::NOTIFICATION_TRANSLATION_CHANGED);
 	}
@@ -1038,105 +1050,109 @@ Vector<String> TranslationServer::get_all_locale_names() {
 void TranslationServer::add_translation(const Ref<Translation> &p_translation) {
 
 	translations.insert(p_translation);
+	invalidate_cache();
 }
 void TranslationServer::remove_translation(const Ref<Translation> &p_translation) {
 
 	translations.erase(p_translation);
+	invalidate_cache();
 }
 
 void TranslationServer::clear() {
 
 	translations.clear();
+	invalidate_cache();
 };
 
-StringName TranslationServer::translate(const StringName &p_message) const {
-
-	// Match given message against the translation catalog for the project locale.
+void TranslationServer::invalidate_cache() {
 
-	if (!enabled)
-		return p_message;
+	MutexLock lock(cache_mutex);
+	cache_dirty = true;
+	lookup_chain.clear(); //don't keep removed translations alive until the next lookup
+}
 
-	ERR_FAIL_COND_V_MSG(locale.length() < 2, p_message, "Could not translate message as configured locale '" + locale + "' is invalid.");
+void TranslationServer::_append_lookup_chain(const String &p_locale) const {
 
 	// Locale can be of the form 'll_CC', i.e. language code and regional code,
 	// e.g. 'en_US', 'en_GB', etc. It might also be simply 'll', e.g. 'en'.
-	// To find the relevant translation, we look for those with locale starting
-	// with the language code, and then if any is an exact match for the long
-	// form. If not found, we fall back to a near match (another locale with
-	// same language code).
+	// Translations whose locale is an exact match are tried first, then the
+	// first near match (another locale with same language code) that has the
+	// message.
 
 	// Note: ResourceLoader::_path_remap reproduces this locale near matching
 	// logic, so be sure to propagate changes there when changing things here.
 
-	StringName res;
-	String lang = get_language_code(locale);
-	bool near_match = false;
+	String lang = get_language_code(p_locale);
+	Vector<Ref<Translation>> near;
 
 	for (const Set<Ref<Translation>>::Element *E = translations.front(); E; E = E->next()) {
 		const Ref<Translation> &t = E->get();
-		ERR_FAIL_COND_V(t.is_null(), p_message);
+		ERR_CONTINUE(t.is_null());
 		String l = t->get_locale();
 
-		bool exact_match = (l == locale);
-		if (!exact_match) {
-			if (near_match) {
-				continue; // Only near-match once, but keep looking for exact matches.
-			}
-			if (get_language_code(l) != lang) {
-				continue; // Language code does not match.
-			}
+		if (l == p_locale) {
+			lookup_chain.push_back(t);
+		} else if (get_language_code(l) == lang) {
+			near.push_back(t);
 		}
+	}
 
-		StringName r = t->get_message(p_message);
-		if (!r) {
-			continue;
-		}
-		res = r;
+	lookup_chain.append_array(near);
+}
 
-		if (exact_match) {
-			break;
-		} else {
-			near_match = true;
-		}
+void TranslationServer::_update_lookup_chain() const {
+
+	lookup_chain.clear();
+	message_cache.clear();
+	cache_dirty = false;
+
+	if (locale.length() < 2) {
+		return;
 	}
 
-	if (!res && fallback.length() >= 2) {
+	_append_lookup_chain(locale);
+	if (fallback.length() >= 2) {
 		// Try again with the fallback locale.
-		String fallback_lang = get_language_code(fallback);
-		near_match = false;
-
-		for (const Set<Ref<Translation>>::Element *E = translations.front(); E; E = E->next()) {
-			const Ref<Translation> &t = E->get();
-			ERR_FAIL_COND_V(t.is_null(), p_message);
-			String l = t->get_locale();
-
-			bool exact_match = (l == fallback);
-			if (!exact_match) {
-				if (near_match) {
-					continue; // Only near-match once, but keep looking for exact matches.
-				}
-				if (get_language_code(l) != fallback_lang) {
-					continue; // Language code does not match.
-				}
-			}
+		_append_lookup_chain(fallback);
+	}
+}
 
-			StringName r = t->get_message(p_message);
-			if (!r) {
-				continue;
-			}
-			res = r;
+StringName TranslationServer::translate(const StringName &p_message) const {
 
-			if (exact_match) {
-				break;
-			} else {
-				near_match = true;
-			}
+	// Match given message against the translation catalog for the project locale.
+
+	if (!enabled)
+		return p_message;
+
+	ERR_FAIL_COND_V_MSG(locale.length() < 2, p_message, "Could not translate message as configured locale '" + locale + "' is invalid.");
+
+	// The order in which translations are tried only depends on the locales,
+	// so it's resolved once when they change, and each message is looked up once.
+
+	MutexLock lock(cache_mutex);
+
+	if (cache_dirty) {
+		_update_lookup_chain();
+	}
+
+	const StringName *cached = message_cache.getptr(p_message);
+	if (cached) {
+		return *cached;
+	}
+
+	StringName res = p_message;
+	for (int i = 0; i < lookup_chain.size(); i++) {
+		StringName r = lookup_chain[i]->get_message(p_message);
+		if (r) {
+			res = r;
+			break;
 		}
 	}
 
-	if (!res) {
-		return p_message;
+	if (message_cache.size() >= MAX_CACHED_MESSAGES) {
+		message_cache.clear();
 	}
+	message_cache.set(p_message, res);
 
 	return res;
 }
@@ -1175,6 +1191,7 @@ void TranslationServer::setup() {
 	else
 		set_locale(OS::get_singleton()->get_locale());
 	fallback = GLOBAL_DEF("locale/fallback", "en");
+	invalidate_cache();
 #ifdef TOOLS_ENABLED
 	{
 		String options = "";
@@ -1250,6 +1267,7 @@ TranslationServer::TranslationServer() :
 		locale("en"),
 		enabled(true) {
 	singleton = this;
+	cache_dirty = true;
 
 	for (int i = 0; locale_list[i]; ++i) {
 
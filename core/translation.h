@@ -31,6 +31,8 @@
 #ifndef TRANSLATION_H
 #define TRANSLATION_H
 
+#include "core/hash_map.h"
+#include "core/os/mutex.h"
 #include "core/resource.h"
 
 class Translation : public Resource {
@@ -79,6 +81,19 @@ class TranslationServer : public Object {
 
 	bool enabled;
 
+	enum {
+		MAX_CACHED_MESSAGES = 16384
+	};
+
+	//translations to try in order for the current locale and fallback, plus the results already looked up
+	mutable Mutex cache_mutex;
+	mutable bool cache_dirty;
+	mutable Vector<Ref<Translation>> lookup_chain;
+	mutable HashMap<StringName, StringName> message_cache;
+
+	void _append_lookup_chain(const String &p_locale) const;
+	void _update_lookup_chain() const;
+
 	static TranslationServer *singleton;
 	bool _load_translations(const String &p_from);
 
@@ -101,6 +116,7 @@ public:
 	void remove_translation(const Ref<Translation> &p_translation);
 
 	StringName translate(const StringName &p_message) const;
+	void invalidate_cache(); //called when a translation changes its locale or messages
 
 	static Vector<String> get_all_locales();
 	static Vector<String> get_all_locale_names();
@@ -0,0 +1,109 @@
+/*************************************************************************/
+/*  typed_array.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TYPED_ARRAY_H
+#define TYPED_ARRAY_H
+
+#include "core/array.h"
+#include "core/variant.h"
+#include "core/vector.h"
+
+template <class T>
+struct TypedArrayType;
+
+#define MAKE_TYPED_ARRAY_TYPE(m_type, m_variant_type)             \
+	template <>                                                   \
+	struct TypedArrayType<m_type> {                               \
+		static const Variant::Type VARIANT_TYPE = m_variant_type; \
+	};
+
+MAKE_TYPED_ARRAY_TYPE(int64_t, Variant::INT)
+MAKE_TYPED_ARRAY_TYPE(double, Variant::FLOAT)
+MAKE_TYPED_ARRAY_TYPE(String, Variant::STRING)
+MAKE_TYPED_ARRAY_TYPE(Vector2, Variant::VECTOR2)
+MAKE_TYPED_ARRAY_TYPE(Vector3, Variant::VECTOR3)
+MAKE_TYPED_ARRAY_TYPE(Color, Variant::COLOR)
+
+// An Array whose elements are all T, read and written as T without going through Variant.
+// It is still an Array, so it can be passed anywhere one is expected.
+template <class T>
+class TypedArray : public Array {
+
+public:
+	_FORCE_INLINE_ void operator=(const Array &p_array) {
+		ERR_FAIL_COND_MSG(p_array.get_typed_builtin() != uint32_t(TypedArrayType<T>::VARIANT_TYPE), "Cannot assign an array with a different element type.");
+		Array::operator=(p_array);
+	}
+
+	_FORCE_INLINE_ T get(int p_idx) const {
+		const Vector<T> *packed = Array::_get_packed<T>();
+		if (packed) {
+			return (*packed)[p_idx];
+		}
+		return Array::get(p_idx);
+	}
+
+	_FORCE_INLINE_ void set(int p_idx, const T &p_value) {
+		Vector<T> *packed = Array::_get_packed<T>();
+		if (packed) {
+			packed->write[p_idx] = p_value;
+			return;
+		}
+		Array::set(p_idx, p_value);
+	}
+
+	_FORCE_INLINE_ void push_back(const T &p_value) {
+		Vector<T> *packed = Array::_get_packed<T>();
+		if (packed) {
+			packed->push_back(p_value);
+			return;
+		}
+		Array::push_back(p_value);
+	}
+
+	//contiguous elements, NULL if they were moved to Variant storage
+	_FORCE_INLINE_ const T *ptr() const {
+		const Vector<T> *packed = Array::_get_packed<T>();
+		return packed ? packed->ptr() : NULL;
+	}
+
+	_FORCE_INLINE_ TypedArray(const Array &p_array) {
+		set_typed(TypedArrayType<T>::VARIANT_TYPE);
+		operator=(p_array);
+	}
+	_FORCE_INLINE_ TypedArray(const TypedArray &p_array) :
+			Array(p_array) {
+	}
+	_FORCE_INLINE_ TypedArray() {
+		set_typed(TypedArrayType<T>::VARIANT_TYPE);
+	}
+};
+
+#endif // TYPED_ARRAY_H
@@ -32,6 +32,304 @@
 
 #include "core/os/os.h"
 
+//arrays smaller than this are cheaper to keep whole
+#define PROPERTY_DELTA_MIN_SIZE 64
+
+//changes are kept as [size, indices, values], and only when they touch a small part of the array
+template <class T>
+static Variant _make_packed_delta(const Vector<T> &p_base, const Vector<T> &p_value) {
+
+	int size = p_value.size();
+	if (size < PROPERTY_DELTA_MIN_SIZE) {
+		return Variant();
+	}
+
+	int base_size = p_base.size();
+	int max_changes = size / 4;
+	const T *b = p_base.ptr();
+	const T *v = p_value.ptr();
+
+	Vector<int32_t> indices;
+	Vector<T> values;
+
+	for (int i = 0; i < size; i++) {
+		if (i < base_size && b[i] == v[i]) {
+			continue;
+		}
+		if (indices.size() >= max_changes) {
+			return Variant();
+		}
+		indices.push_back(i);
+		values.push_back(v[i]);
+	}
+
+	Array delta;
+	delta.push_back(size);
+	delta.push_back(indices);
+	delta.push_back(values);
+	return delta;
+}
+
+template <class T>
+static Variant _apply_packed_delta(const Vector<T> &p_base, const Array &p_delta) {
+
+	Vector<T> value = p_base;
+	value.resize(p_delta[0]);
+
+	Vector<int32_t> indices = p_delta[1];
+	Vector<T> values = p_delta[2];
+	T *w = value.ptrw();
+	for (int i = 0; i < indices.size(); i++) {
+		w[indices[i]] = values[i];
+	}
+
+	return value;
+}
+
+Variant UndoRedo::_make_property_delta(const Variant &p_base, const Variant &p_value) {
+
+	if (p_base.get_type() != p_value.get_type()) {
+		return Variant();
+	}
+
+	switch (p_value.get_type()) {
+		case Variant::PACKED_BYTE_ARRAY:
+			return _make_packed_delta<uint8_t>(p_base, p_value);
+		case Variant::PACKED_INT32_ARRAY:
+			return _make_packed_delta<int32_t>(p_base, p_value);
+		case Variant::PACKED_INT64_ARRAY:
+			return _make_packed_delta<int64_t>(p_base, p_value);
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return _make_packed_delta<float>(p_base, p_value);
+		case Variant::PACKED_FLOAT64_ARRAY:
+			return _make_packed_delta<double>(p_base, p_value);
+		case Variant::PACKED_STRING_ARRAY:
+			return _make_packed_delta<String>(p_base, p_value);
+		case Variant::PACKED_VECTOR2_ARRAY:
+			return _make_packed_delta<Vector2>(p_base, p_value);
+		case Variant::PACKED_VECTOR3_ARRAY:
+			return _make_packed_delta<Vector3>(p_base, p_value);
+		case Variant::PACKED_COLOR_ARRAY:
+			return _make_packed_delta<Color>(p_base, p_value);
+		case Variant::DICTIONARY: {
+
+			//changes are kept as [changed or added pairs, removed keys]
+			Dictionary base = p_base;
+			Dictionary value = p_value;
+			if (value.size() < PROPERTY_DELTA_MIN_SIZE) {
+				return Variant();
+			}
+
+			int max_changes = value.size() / 4;
+			Dictionary changed;
+			Array removed;
+
+			for (const Variant *K = value.next(); K; K = value.next(K)) {
+				if (base.has(*K) && base[*K] == value[*K]) {
+					continue;
+				}
+				if (changed.size() >= max_changes) {
+					return Variant();
+				}
+				changed[*K] = value[*K];
+			}
+
+			for (const Variant *K = base.next(); K; K = base.next(K)) {
+				if (value.has(*K)) {
+					continue;
+				}
+				if (changed.size() + removed.size() >= max_changes) {
+					return Variant();
+				}
+				removed.push_back(*K);
+			}
+
+			Array delta;
+			delta.push_back(changed);
+			delta.push_back(removed);
+			return delta;
+		}
+		default: {
+		}
+	}
+
+	return Variant();
+}
+
+Variant UndoRedo::_apply_property_delta(const Variant &p_base, const Variant &p_delta) {
+
+	switch (p_base.get_type()) {
+		case Variant::PACKED_BYTE_ARRAY:
+			return _apply_packed_delta<uint8_t>(p_base, p_delta);
+		case Variant::PACKED_INT32_ARRAY:
+			return _apply_packed_delta<int32_t>(p_base, p_delta);
+		case Variant::PACKED_INT64_ARRAY:
+			return _apply_packed_delta<int64_t>(p_base, p_delta);
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return _apply_packed_delta<float>(p_base, p_delta);
+		case Variant::PACKED_FLOAT64_ARRAY:
+			return _apply_packed_delta<double>(p_base, p_delta);
+		case Variant::PACKED_STRING_ARRAY:
+			return _apply_packed_delta<String>(p_base, p_delta);
+		case Variant::PACKED_VECTOR2_ARRAY:
+			return _apply_packed_delta<Vector2>(p_base, p_delta);
+		case Variant::PACKED_VECTOR3_ARRAY:
+			return _apply_packed_delta<Vector3>(p_base, p_delta);
+		case Variant::PACKED_COLOR_ARRAY:
+			return _apply_packed_delta<Color>(p_base, p_delta);
+		case Variant::DICTIONARY: {
+
+			Array delta = p_delta;
+			Dictionary value = Dictionary(p_base).duplicate();
+			Dictionary changed = delta[0];
+			Array removed = delta[1];
+
+			for (int i = 0; i < removed.size(); i++) {
+				value.erase(removed[i]);
+			}
+			for (const Variant *K = changed.next(); K; K = changed.next(K)) {
+				value[*K] = changed[*K];
+			}
+			return value;
+		}
+		default: {
+		}
+	}
+
+	ERR_FAIL_V_MSG(Variant(), "Unsupported type for an undo/redo property delta.");
+}
+
+uint64_t UndoRedo::_get_variant_memory(const Variant &p_value) {
+
+	uint64_t memory = sizeof(Variant);
+
+	switch (p_value.get_type()) {
+		case Variant::STRING: {
+			memory += String(p_value).length() * sizeof(CharType);
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_value;
+			for (int i = 0; i < array.size(); i++) {
+				memory += _get_variant_memory(array[i]);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dict = p_value;
+			for (const Variant *K = dict.next(); K; K = dict.next(K)) {
+				memory += _get_variant_memory(*K) + _get_variant_memory(dict[*K]);
+			}
+		} break;
+		case Variant::PACKED_BYTE_ARRAY: {
+			memory += PackedByteArray(p_value).size();
+		} break;
+		case Variant::PACKED_INT32_ARRAY: {
+			memory += PackedInt32Array(p_value).size() * sizeof(int32_t);
+		} break;
+		case Variant::PACKED_INT64_ARRAY: {
+			memory += PackedInt64Array(p_value).size() * sizeof(int64_t);
+		} break;
+		case Variant::PACKED_FLOAT32_ARRAY: {
+			memory += PackedFloat32Array(p_value).size() * sizeof(float);
+		} break;
+		case Variant::PACKED_FLOAT64_ARRAY: {
+			memory += PackedFloat64Array(p_value).size() * sizeof(double);
+		} break;
+		case Variant::PACKED_STRING_ARRAY: {
+			PackedStringArray strings = p_value;
+			for (int i = 0; i < strings.size(); i++) {
+				memory += sizeof(String) + strings[i].length() * sizeof(CharType);
+			}
+		} break;
+		case Variant::PACKED_VECTOR2_ARRAY: {
+			memory += PackedVector2Array(p_value).size() * sizeof(Vector2);
+		} break;
+		case Variant::PACKED_VECTOR3_ARRAY: {
+			memory += PackedVector3Array(p_value).size() * sizeof(Vector3);
+		} break;
+		case Variant::PACKED_COLOR_ARRAY: {
+			memory += PackedColorArray(p_value).size() * sizeof(Color);
+		} break;
+		default: {
+		}
+	}
+
+	return memory;
+}
+
+UndoRedo::Operation *UndoRedo::_find_property_op(List<Operation> &p_ops, ObjectID p_object, const StringName &p_property) {
+
+	for (List<Operation>::Element *E = p_ops.back(); E; E = E->prev()) {
+
+		Operation &op = E->get();
+		if ((op.type == Operation::TYPE_PROPERTY || op.type == Operation::TYPE_PROPERTY_DELTA) && op.object == p_object && op.name == p_property) {
+			return &op;
+		}
+	}
+
+	return NULL;
+}
+
+void UndoRedo::_encode_undo_deltas(Action &p_action) {
+
+	for (List<Operation>::Element *E = p_action.undo_ops.front(); E; E = E->next()) {
+
+		Operation &undo_op = E->get();
+		if (undo_op.type != Operation::TYPE_PROPERTY) {
+			continue;
+		}
+
+		Operation *do_op = _find_property_op(p_action.do_ops, undo_op.object, undo_op.name);
+		if (!do_op || do_op->type != Operation::TYPE_PROPERTY) {
+			continue;
+		}
+
+		//the do value is kept whole anyway, so the undo one only needs what differs from it
+		Variant delta = _make_property_delta(do_op->args[0], undo_op.args[0]);
+		if (delta.get_type() == Variant::NIL) {
+			continue;
+		}
+
+		undo_op.type = Operation::TYPE_PROPERTY_DELTA;
+		undo_op.args[0] = do_op->args[0];
+		undo_op.args[1] = delta;
+	}
+}
+
+void UndoRedo::_update_action_memory(Action &p_action) {
+
+	uint64_t memory = 0;
+
+	for (List<Operation>::Element *E = p_action.do_ops.front(); E; E = E->next()) {
+		for (int i = 0; i < VARIANT_ARG_MAX; i++) {
+			memory += _get_variant_memory(E->get().args[i]);
+		}
+	}
+
+	for (List<Operation>::Element *E = p_action.undo_ops.front(); E; E = E->next()) {
+		//the base of a delta shares its data with the do value
+		int from = E->get().type == Operation::TYPE_PROPERTY_DELTA ? 1 : 0;
+		for (int i = from; i < VARIANT_ARG_MAX; i++) {
+			memory += _get_variant_memory(E->get().args[i]);
+		}
+	}
+
+	history_memory -= p_action.memory_usage;
+	p_action.memory_usage = memory;
+	history_memory += memory;
+}
+
+void UndoRedo::_trim_history() {
+
+	if (max_history_memory == 0) {
+		return;
+	}
+
+	//oldest actions go first, but the last committed one is always kept
+	while (history_memory > max_history_memory && current_action > 0) {
+		_pop_history_tail();
+	}
+}
+
 void UndoRedo::_discard_redo() {
 
 	if (current_action == actions.size() - 1)
@@ -39,6 +337,8 @@ void UndoRedo::_discard_redo() {
 
 	for (int i = current_action + 1; i < actions.size(); i++) {
 
+		history_memory -= actions[i].memory_usage;
+
 		for (List<Operation>::Element *E = actions.write[i].do_ops.front(); E; E = E->next()) {
 
 			if (E->get().type == Operation::TYPE_REFERENCE) {
@@ -96,6 +396,7 @@ void UndoRedo::create_action(const String &p_name, MergeMode p_mode) {
 			Action new_action;
 			new_action.name = p_name;
 			new_action.last_tick = ticks;
+			new_action.memory_usage = 0;
 			actions.push_back(new_action);
 
 			merge_mode = MERGE_DISABLE;
@@ -159,6 +460,15 @@ void UndoRedo::add_do_property(Object *p_object, const StringName &p_property, c
 	if (Object::cast_to<Resource>(p_object))
 		do_op.resref = Ref<Resource>(Object::cast_to<Resource>(p_object));
 
+	if (merging && merge_mode == MERGE_ALL) {
+		//only the latest value matters, so don't pile up a copy per merged action
+		Operation *prev_op = _find_property_op(actions.write[current_action + 1].do_ops, do_op.object, p_property);
+		if (prev_op && prev_op->type == Operation::TYPE_PROPERTY) {
+			prev_op->args[0] = p_value;
+			return;
+		}
+	}
+
 	do_op.type = Operation::TYPE_PROPERTY;
 	do_op.name = p_property;
 	do_op.args[0] = p_value;
@@ -174,6 +484,10 @@ void UndoRedo::add_undo_property(Object *p_object, const StringName &p_property,
 	if (merge_mode == MERGE_ENDS)
 		return;
 
+	// The value from before the first merged action is already stored
+	if (merging && _find_property_op(actions.write[current_action + 1].undo_ops, p_object->get_instance_id(), p_property))
+		return;
+
 	Operation undo_op;
 	undo_op.object = p_object->get_instance_id();
 	if (Object::cast_to<Resource>(p_object))
@@ -233,6 +547,7 @@ void UndoRedo::_pop_history_tail() {
 		}
 	}
 
+	history_memory -= actions[0].memory_usage;
 	actions.remove(0);
 	if (current_action >= 0) {
 		current_action--;
@@ -255,12 +570,18 @@ void UndoRedo::commit_action() {
 		merging = false;
 	}
 
+	Action &action = actions.write[current_action + 1];
+	_encode_undo_deltas(action);
+	_update_action_memory(action);
+
 	committing++;
 	redo(); // perform action
 	committing--;
 	if (callback && actions.size() > 0) {
 		callback(callback_ud, actions[actions.size() - 1].name);
 	}
+
+	_trim_history();
 }
 
 void UndoRedo::_process_operation_list(List<Operation>::Element *E) {
@@ -306,16 +627,19 @@ void UndoRedo::_process_operation_list(List<Operation>::Element *E) {
 					method_callback(method_callbck_ud, obj, op.name, VARIANT_ARGS_FROM_ARRAY(op.args));
 				}
 			} break;
-			case Operation::TYPE_PROPERTY: {
+			case Operation::TYPE_PROPERTY:
+			case Operation::TYPE_PROPERTY_DELTA: {
+
+				Variant value = op.type == Operation::TYPE_PROPERTY_DELTA ? _apply_property_delta(op.args[0], op.args[1]) : op.args[0];
 
-				obj->set(op.name, op.args[0]);
+				obj->set(op.name, value);
 #ifdef TOOLS_ENABLED
 				Resource *res = Object::cast_to<Resource>(obj);
 				if (res)
 					res->set_edited(true);
 #endif
 				if (property_callback) {
-					property_callback(prop_callback_ud, obj, op.name, op.args[0]);
+					property_callback(prop_callback_ud, obj, op.name, value);
 				}
 			} break;
 			case Operation::TYPE_REFERENCE: {
@@ -391,6 +715,21 @@ uint64_t UndoRedo::get_version() const {
 	return version;
 }
 
+void UndoRedo::set_max_history_memory(uint64_t p_bytes) {
+
+	max_history_memory = p_bytes; //applied on the next commit, so redo history is not lost here
+}
+
+uint64_t UndoRedo::get_max_history_memory() const {
+
+	return max_history_memory;
+}
+
+uint64_t UndoRedo::get_history_memory() const {
+
+	return history_memory;
+}
+
 void UndoRedo::set_commit_notify_callback(CommitNotifyCallback p_callback, void *p_ud) {
 
 	callback = p_callback;
@@ -417,6 +756,8 @@ UndoRedo::UndoRedo() {
 	current_action = -1;
 	merge_mode = MERGE_DISABLE;
 	merging = false;
+	max_history_memory = 0;
+	history_memory = 0;
 	callback = NULL;
 	callback_ud = NULL;
 
@@ -543,6 +884,11 @@ void UndoRedo::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_version"), &UndoRedo::get_version);
 	ClassDB::bind_method(D_METHOD("redo"), &UndoRedo::redo);
 	ClassDB::bind_method(D_METHOD("undo"), &UndoRedo::undo);
+	ClassDB::bind_method(D_METHOD("set_max_history_memory", "bytes"), &UndoRedo::set_max_history_memory);
+	ClassDB::bind_method(D_METHOD("get_max_history_memory"), &UndoRedo::get_max_history_memory);
+	ClassDB::bind_method(D_METHOD("get_history_memory"), &UndoRedo::get_history_memory);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_history_memory"), "set_max_history_memory", "get_max_history_memory");
 
 	ADD_SIGNAL(MethodInfo("version_changed"));
 
@@ -59,6 +59,7 @@ private:
 		enum Type {
 			TYPE_METHOD,
 			TYPE_PROPERTY,
+			TYPE_PROPERTY_DELTA, //args[0] is the base value, args[1] the changes that turn it into the stored one
 			TYPE_REFERENCE
 		};
 
@@ -74,6 +75,7 @@ private:
 		List<Operation> do_ops;
 		List<Operation> undo_ops;
 		uint64_t last_tick;
+		uint64_t memory_usage;
 	};
 
 	Vector<Action> actions;
@@ -82,7 +84,17 @@ private:
 	MergeMode merge_mode;
 	bool merging;
 	uint64_t version;
+	uint64_t max_history_memory;
+	uint64_t history_memory;
 
+	static Variant _make_property_delta(const Variant &p_base, const Variant &p_value);
+	static Variant _apply_property_delta(const Variant &p_base, const Variant &p_delta);
+	static uint64_t _get_variant_memory(const Variant &p_value);
+	static Operation *_find_property_op(List<Operation> &p_ops, ObjectID p_object, const StringName &p_property);
+
+	void _encode_undo_deltas(Action &p_action);
+	void _update_action_memory(Action &p_action);
+	void _trim_history();
 	void _pop_history_tail();
 	void _process_operation_list(List<Operation>::Element *E);
 	void _discard_redo();
@@ -123,6 +135,10 @@ public:
 
 	uint64_t get_version() const;
 
+	void set_max_history_memory(uint64_t p_bytes);
+	uint64_t get_max_history_memory() const;
+	uint64_t get_history_memory() const;
+
 	void set_commit_notify_callback(CommitNotifyCallback p_callback, void *p_ud);
 
 	void set_method_notify_callback(MethodNotifyCallback p_method_callback, void *p_ud);
@@ -58,6 +58,230 @@
 #define MAX_DIGITS 6
 #define UPPERCASE(m_c) (((m_c) >= 'a' && (m_c) <= 'z') ? ((m_c) - ('a' - 'A')) : (m_c))
 #define LOWERCASE(m_c) (((m_c) >= 'A' && (m_c) <= 'Z') ? ((m_c) + ('a' - 'A')) : (m_c))
+
+// Vector paths for searching, case conversion and UTF-8 conversion, working on
+// four 32 bit characters or sixteen bytes at a time. SSE2 is always there on
+// x86_64 and NEON on arm64, so they are picked at build time. Build with
+// NO_STRING_SIMD to always use the scalar loops. Windows has 16 bit CharType
+// and always uses the scalar loops.
+#if !defined(NO_STRING_SIMD) && WCHAR_MAX > 0xFFFF
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STRING_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define STRING_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(STRING_SIMD_SSE2) || defined(STRING_SIMD_NEON)
+#define STRING_SIMD
+
+// lanes of the four characters at p_src equal to p_char, as a 4 bit mask
+static _FORCE_INLINE_ uint32_t _simd_match4(const CharType *p_src, CharType p_char) {
+#ifdef STRING_SIMD_SSE2
+	__m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)p_src), _mm_set1_epi32(p_char));
+	return _mm_movemask_ps(_mm_castsi128_ps(eq));
+#else
+	static const uint32_t bits[4] = { 1, 2, 4, 8 };
+	uint32x4_t eq = vceqq_u32(vld1q_u32((const uint32_t *)p_src), vdupq_n_u32(p_char));
+	return vaddvq_u32(vandq_u32(eq, vld1q_u32(bits)));
+#endif
+}
+
+// lanes whose ASCII lowercase is p_char, which must be ASCII lowercase already
+static _FORCE_INLINE_ uint32_t _simd_match4_lower(const CharType *p_src, CharType p_char) {
+#ifdef STRING_SIMD_SSE2
+	__m128i v = _mm_loadu_si128((const __m128i *)p_src);
+	__m128i upper = _mm_and_si128(_mm_cmpgt_epi32(v, _mm_set1_epi32('A' - 1)), _mm_cmplt_epi32(v, _mm_set1_epi32('Z' + 1)));
+	v = _mm_add_epi32(v, _mm_and_si128(upper, _mm_set1_epi32('a' - 'A')));
+	__m128i eq = _mm_cmpeq_epi32(v, _mm_set1_epi32(p_char));
+	return _mm_movemask_ps(_mm_castsi128_ps(eq));
+#else
+	static const uint32_t bits[4] = { 1, 2, 4, 8 };
+	uint32x4_t v = vld1q_u32((const uint32_t *)p_src);
+	uint32x4_t upper = vandq_u32(vcgeq_u32(v, vdupq_n_u32('A')), vcleq_u32(v, vdupq_n_u32('Z')));
+	v = vaddq_u32(v, vandq_u32(upper, vdupq_n_u32('a' - 'A')));
+	uint32x4_t eq = vceqq_u32(v, vdupq_n_u32(p_char));
+	return vaddvq_u32(vandq_u32(eq, vld1q_u32(bits)));
+#endif
+}
+
+// true if the four characters at p_src are all in 0-127
+static _FORCE_INLINE_ bool _simd_is_ascii4(const CharType *p_src) {
+#ifdef STRING_SIMD_SSE2
+	__m128i high = _mm_and_si128(_mm_loadu_si128((const __m128i *)p_src), _mm_set1_epi32(~0x7F));
+	return _mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) == 0xFFFF;
+#else
+	return vmaxvq_u32(vld1q_u32((const uint32_t *)p_src)) < 0x80;
+#endif
+}
+
+// converts four ASCII characters to upper or lowercase
+static _FORCE_INLINE_ void _simd_change_case4(CharType *p_dst, const CharType *p_src, bool p_upper) {
+	CharType from = p_upper ? 'a' : 'A';
+	CharType to = p_upper ? 'z' : 'Z';
+	int32_t delta = p_upper ? ('A' - 'a') : ('a' - 'A');
+#ifdef STRING_SIMD_SSE2
+	__m128i v = _mm_loadu_si128((const __m128i *)p_src);
+	__m128i in_range = _mm_and_si128(_mm_cmpgt_epi32(v, _mm_set1_epi32(from - 1)), _mm_cmplt_epi32(v, _mm_set1_epi32(to + 1)));
+	_mm_storeu_si128((__m128i *)p_dst, _mm_add_epi32(v, _mm_and_si128(in_range, _mm_set1_epi32(delta))));
+#else
+	uint32x4_t v = vld1q_u32((const uint32_t *)p_src);
+	uint32x4_t in_range = vandq_u32(vcgeq_u32(v, vdupq_n_u32(from)), vcleq_u32(v, vdupq_n_u32(to)));
+	vst1q_u32((uint32_t *)p_dst, vaddq_u32(v, vandq_u32(in_range, vdupq_n_u32((uint32_t)delta))));
+#endif
+}
+
+// true if any of the four characters at p_src is an ASCII letter of the case that p_upper converts from
+static _FORCE_INLINE_ bool _simd_has_case4(const CharType *p_src, bool p_upper) {
+	CharType from = p_upper ? 'a' : 'A';
+	CharType to = p_upper ? 'z' : 'Z';
+#ifdef STRING_SIMD_SSE2
+	__m128i v = _mm_loadu_si128((const __m128i *)p_src);
+	__m128i in_range = _mm_and_si128(_mm_cmpgt_epi32(v, _mm_set1_epi32(from - 1)), _mm_cmplt_epi32(v, _mm_set1_epi32(to + 1)));
+	return _mm_movemask_epi8(in_range) != 0;
+#else
+	uint32x4_t v = vld1q_u32((const uint32_t *)p_src);
+	uint32x4_t in_range = vandq_u32(vcgeq_u32(v, vdupq_n_u32(from)), vcleq_u32(v, vdupq_n_u32(to)));
+	return vmaxvq_u32(in_range) != 0;
+#endif
+}
+
+// narrows sixteen ASCII characters to bytes, returns false (writing nothing) if any isn't ASCII
+static _FORCE_INLINE_ bool _simd_narrow_ascii16(uint8_t *p_dst, const CharType *p_src) {
+#ifdef STRING_SIMD_SSE2
+	__m128i a = _mm_loadu_si128((const __m128i *)p_src);
+	__m128i b = _mm_loadu_si128((const __m128i *)(p_src + 4));
+	__m128i c = _mm_loadu_si128((const __m128i *)(p_src + 8));
+	__m128i d = _mm_loadu_si128((const __m128i *)(p_src + 12));
+	__m128i high = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), _mm_set1_epi32(~0x7F));
+	if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) != 0xFFFF) {
+		return false;
+	}
+	_mm_storeu_si128((__m128i *)p_dst, _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+	return true;
+#else
+	uint32x4_t a = vld1q_u32((const uint32_t *)p_src);
+	uint32x4_t b = vld1q_u32((const uint32_t *)(p_src + 4));
+	uint32x4_t c = vld1q_u32((const uint32_t *)(p_src + 8));
+	uint32x4_t d = vld1q_u32((const uint32_t *)(p_src + 12));
+	if (vmaxvq_u32(vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d))) >= 0x80) {
+		return false;
+	}
+	uint16x8_t ab = vcombine_u16(vmovn_u32(a), vmovn_u32(b));
+	uint16x8_t cd = vcombine_u16(vmovn_u32(c), vmovn_u32(d));
+	vst1q_u8(p_dst, vcombine_u8(vmovn_u16(ab), vmovn_u16(cd)));
+	return true;
+#endif
+}
+
+// true if the sixteen bytes at p_src are all ASCII and none is zero
+static _FORCE_INLINE_ bool _simd_is_ascii16_bytes(const char *p_src) {
+#ifdef STRING_SIMD_SSE2
+	__m128i v = _mm_loadu_si128((const __m128i *)p_src);
+	return _mm_movemask_epi8(v) == 0 && _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) == 0;
+#else
+	uint8x16_t v = vld1q_u8((const uint8_t *)p_src);
+	return vmaxvq_u8(v) < 0x80 && vminvq_u8(v) != 0;
+#endif
+}
+
+// widens sixteen ASCII bytes to characters
+static _FORCE_INLINE_ void _simd_widen_ascii16(CharType *p_dst, const char *p_src) {
+#ifdef STRING_SIMD_SSE2
+	__m128i v = _mm_loadu_si128((const __m128i *)p_src);
+	__m128i zero = _mm_setzero_si128();
+	__m128i lo = _mm_unpacklo_epi8(v, zero);
+	__m128i hi = _mm_unpackhi_epi8(v, zero);
+	_mm_storeu_si128((__m128i *)p_dst, _mm_unpacklo_epi16(lo, zero));
+	_mm_storeu_si128((__m128i *)(p_dst + 4), _mm_unpackhi_epi16(lo, zero));
+	_mm_storeu_si128((__m128i *)(p_dst + 8), _mm_unpacklo_epi16(hi, zero));
+	_mm_storeu_si128((__m128i *)(p_dst + 12), _mm_unpackhi_epi16(hi, zero));
+#else
+	uint8x16_t v = vld1q_u8((const uint8_t *)p_src);
+	uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+	uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+	vst1q_u32((uint32_t *)p_dst, vmovl_u16(vget_low_u16(lo)));
+	vst1q_u32((uint32_t *)(p_dst + 4), vmovl_u16(vget_high_u16(lo)));
+	vst1q_u32((uint32_t *)(p_dst + 8), vmovl_u16(vget_low_u16(hi)));
+	vst1q_u32((uint32_t *)(p_dst + 12), vmovl_u16(vget_high_u16(hi)));
+#endif
+}
+
+#endif // STRING_SIMD
+
+// first match of p_str (p_len characters, compared as CharType) in p_src at or after p_from,
+// candidates are filtered on the first and last character before comparing the rest
+template <class T>
+static int _find_substring(const CharType *p_src, int p_src_len, const T *p_str, int p_len, int p_from) {
+
+	const int last = p_src_len - p_len;
+	const CharType first_char = p_str[0];
+	const CharType last_char = p_str[p_len - 1];
+	int i = p_from;
+
+#ifdef STRING_SIMD
+	for (; i + 3 <= last; i += 4) {
+
+		uint32_t mask = _simd_match4(&p_src[i], first_char) & _simd_match4(&p_src[i + p_len - 1], last_char);
+		while (mask) {
+			int k = 0;
+			while (!(mask & (1 << k))) {
+				k++;
+			}
+			mask &= ~(1 << k);
+
+			int j = 1;
+			while (j < p_len - 1 && p_src[i + k + j] == CharType(p_str[j])) {
+				j++;
+			}
+			if (j >= p_len - 1) {
+				return i + k;
+			}
+		}
+	}
+#endif
+
+	for (; i <= last; i++) {
+
+		if (p_src[i] != first_char || p_src[i + p_len - 1] != last_char) {
+			continue;
+		}
+
+		int j = 1;
+		while (j < p_len - 1 && p_src[i + j] == CharType(p_str[j])) {
+			j++;
+		}
+		if (j >= p_len - 1) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static _FORCE_INLINE_ CharType _fold_char(CharType p_char) {
+
+	return p_char < 128 ? LOWERCASE(p_char) : _find_lower(p_char);
+}
+
+static _FORCE_INLINE_ int _get_utf8_length(uint32_t c) {
+
+	if (c <= 0x7f) // 7 bits.
+		return 1;
+	else if (c <= 0x7ff) // 11 bits
+		return 2;
+	else if (c <= 0xffff) // 16 bits
+		return 3;
+	else if (c <= 0x001fffff) // 21 bits
+		return 4;
+	else if (c <= 0x03ffffff) // 26 bits
+		return 5;
+	else if (c <= 0x7fffffff) // 31 bits
+		return 6;
+	return 0;
+}
 #define IS_DIGIT(m_d) ((m_d) >= '0' && (m_d) <= '9')
 #define IS_HEX_DIGIT(m_d) (((m_d) >= '0' && (m_d) <= '9') || ((m_d) >= 'a' && (m_d) <= 'f') || ((m_d) >= 'A' && (m_d) <= 'F'))
 
@@ -982,32 +1206,52 @@ CharType String::char_lowercase(CharType p_char) {
 
 String String::to_upper() const {
 
-	String upper = *this;
-
-	for (int i = 0; i < upper.size(); i++) {
+	return _change_case(true);
+}
 
-		const CharType s = upper[i];
-		const CharType t = _find_upper(s);
-		if (s != t) // avoid copy on write
-			upper[i] = t;
-	}
+String String::to_lower() const {
 
-	return upper;
+	return _change_case(false);
 }
 
-String String::to_lower() const {
+String String::_change_case(bool p_upper) const {
 
-	String lower = *this;
+	const int len = length();
+	const CharType *src = c_str();
 
-	for (int i = 0; i < lower.size(); i++) {
+	//skip what doesn't change, so unchanged strings are shared instead of copied
+	int i = 0;
+#ifdef STRING_SIMD
+	while (i + 4 <= len && _simd_is_ascii4(&src[i]) && !_simd_has_case4(&src[i], p_upper)) {
+		i += 4;
+	}
+#endif
+	for (; i < len; i++) {
+		if ((p_upper ? _find_upper(src[i]) : _find_lower(src[i])) != src[i]) {
+			break;
+		}
+	}
+
+	if (i == len) {
+		return *this;
+	}
 
-		const CharType s = lower[i];
-		const CharType t = _find_lower(s);
-		if (s != t) // avoid copy on write
-			lower[i] = t;
+	String ret = *this;
+	CharType *dst = ret.ptrw();
+
+	while (i < len) {
+#ifdef STRING_SIMD
+		if (i + 4 <= len && _simd_is_ascii4(&dst[i])) {
+			_simd_change_case4(&dst[i], &dst[i], p_upper);
+			i += 4;
+			continue;
+		}
+#endif
+		dst[i] = p_upper ? _find_upper(dst[i]) : _find_lower(dst[i]);
+		i++;
 	}
 
-	return lower;
+	return ret;
 }
 
 const CharType *String::c_str() const {
@@ -1407,6 +1651,10 @@ bool String::parse_utf8(const char *p_utf8, int p_len) {
 	if (!p_utf8)
 		return true;
 
+	//knowing the length lets the ASCII runs below be read in blocks
+	if (p_len < 0)
+		p_len = strlen(p_utf8);
+
 	String aux;
 
 	int cstr_size = 0;
@@ -1431,6 +1679,15 @@ bool String::parse_utf8(const char *p_utf8, int p_len) {
 		int skip = 0;
 		while (ptrtmp != ptrtmp_limit && *ptrtmp) {
 
+#ifdef STRING_SIMD
+			if (skip == 0 && ptrtmp_limit - ptrtmp >= 16 && _simd_is_ascii16_bytes(ptrtmp)) {
+				str_size += 16;
+				cstr_size += 16;
+				ptrtmp += 16;
+				continue;
+			}
+#endif
+
 			if (skip == 0) {
 
 				uint8_t c = *ptrtmp >= 0 ? *ptrtmp : uint8_t(256 + *ptrtmp);
@@ -1487,6 +1744,16 @@ bool String::parse_utf8(const char *p_utf8, int p_len) {
 
 	while (cstr_size) {
 
+#ifdef STRING_SIMD
+		if (cstr_size >= 16 && _simd_is_ascii16_bytes(p_utf8)) {
+			_simd_widen_ascii16(dst, p_utf8);
+			dst += 16;
+			p_utf8 += 16;
+			cstr_size -= 16;
+			continue;
+		}
+#endif
+
 		int len = 0;
 
 		/* Determine the number of characters in sequence */
@@ -1556,31 +1823,43 @@ bool String::parse_utf8(const char *p_utf8, int p_len) {
 	return false;
 }
 
-CharString String::utf8() const {
+int String::utf8_length() const {
 
 	int l = length();
 	if (!l)
-		return CharString();
+		return 0;
 
 	const CharType *d = &operator[](0);
 	int fl = 0;
-	for (int i = 0; i < l; i++) {
+	int i = 0;
+#ifdef STRING_SIMD
+	for (; i + 4 <= l && _simd_is_ascii4(&d[i]); i += 4) {
+		fl += 4;
+	}
+#endif
+	for (; i < l; i++) {
+		fl += _get_utf8_length(d[i]);
+	}
 
-		uint32_t c = d[i];
-		if (c <= 0x7f) // 7 bits.
-			fl += 1;
-		else if (c <= 0x7ff) { // 11 bits
-			fl += 2;
-		} else if (c <= 0xffff) { // 16 bits
-			fl += 3;
-		} else if (c <= 0x001fffff) { // 21 bits
-			fl += 4;
+	return fl;
+}
 
-		} else if (c <= 0x03ffffff) { // 26 bits
-			fl += 5;
-		} else if (c <= 0x7fffffff) { // 31 bits
-			fl += 6;
-		}
+CharString String::utf8() const {
+
+	int l = length();
+	if (!l)
+		return CharString();
+
+	const CharType *d = &operator[](0);
+	int fl = 0;
+	int i = 0;
+#ifdef STRING_SIMD
+	for (; i + 4 <= l && _simd_is_ascii4(&d[i]); i += 4) {
+		fl += 4;
+	}
+#endif
+	for (; i < l; i++) {
+		fl += _get_utf8_length(d[i]);
 	}
 
 	CharString utf8s;
@@ -1593,7 +1872,18 @@ CharString String::utf8() const {
 
 #define APPEND_CHAR(m_c) *(cdst++) = m_c
 
-	for (int i = 0; i < l; i++) {
+	for (i = 0; i < l; i++) {
+
+#ifdef STRING_SIMD
+		//runs of ASCII are copied sixteen at a time
+		while (i + 16 <= l && _simd_narrow_ascii16(cdst, &d[i])) {
+			cdst += 16;
+			i += 16;
+		}
+		if (i == l) {
+			break;
+		}
+#endif
 
 		uint32_t c = d[i];
 
@@ -2422,33 +2712,7 @@ int String::find(const String &p_str, int p_from) const {
 	if (src_len == 0 || len == 0)
 		return -1; // won't find anything!
 
-	const CharType *src = c_str();
-	const CharType *str = p_str.c_str();
-
-	for (int i = p_from; i <= (len - src_len); i++) {
-
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-
-			int read_pos = i + j;
-
-			if (read_pos >= len) {
-
-				ERR_PRINT("read_pos>=len");
-				return -1;
-			};
-
-			if (src[read_pos] != str[j]) {
-				found = false;
-				break;
-			}
-		}
-
-		if (found)
-			return i;
-	}
-
-	return -1;
+	return _find_substring(c_str(), len, p_str.c_str(), src_len, p_from);
 }
 
 int String::find(const char *p_str, int p_from) const {
@@ -2461,50 +2725,14 @@ int String::find(const char *p_str, int p_from) const {
 	if (len == 0)
 		return -1; // won't find anything!
 
-	const CharType *src = c_str();
-
 	int src_len = 0;
 	while (p_str[src_len] != '\0')
 		src_len++;
 
-	if (src_len == 1) {
-
-		const char needle = p_str[0];
-
-		for (int i = p_from; i < len; i++) {
-
-			if (src[i] == needle) {
-				return i;
-			}
-		}
-
-	} else {
-
-		for (int i = p_from; i <= (len - src_len); i++) {
-
-			bool found = true;
-			for (int j = 0; j < src_len; j++) {
-
-				int read_pos = i + j;
-
-				if (read_pos >= len) {
-
-					ERR_PRINT("read_pos>=len");
-					return -1;
-				};
-
-				if (src[read_pos] != p_str[j]) {
-					found = false;
-					break;
-				}
-			}
-
-			if (found)
-				return i;
-		}
-	}
+	if (src_len == 0)
+		return -1;
 
-	return -1;
+	return _find_substring(c_str(), len, p_str, src_len, p_from);
 }
 
 int String::find_char(const CharType &p_char, int p_from) const {
@@ -2571,36 +2799,56 @@ int String::findn(const String &p_str, int p_from) const {
 		return -1;
 
 	int src_len = p_str.length();
+	int len = length();
 
-	if (src_len == 0 || length() == 0)
+	if (src_len == 0 || len == 0)
 		return -1; // won't find anything!
 
 	const CharType *srcd = c_str();
+	const CharType *str = p_str.c_str();
+	const CharType first = _fold_char(str[0]);
+	const int last = len - src_len;
+	int i = p_from;
+
+#ifdef STRING_SIMD
+	//nothing outside ASCII lowercases into it, so an ASCII first character only has to be compared
+	//against ASCII folded characters
+	if (first < 128 && first >= 0) {
+		for (; i + 3 <= last; i += 4) {
+
+			uint32_t mask = _simd_match4_lower(&srcd[i], first);
+			while (mask) {
+				int k = 0;
+				while (!(mask & (1 << k))) {
+					k++;
+				}
+				mask &= ~(1 << k);
 
-	for (int i = p_from; i <= (length() - src_len); i++) {
-
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-
-			int read_pos = i + j;
-
-			if (read_pos >= length()) {
-
-				ERR_PRINT("read_pos>=length()");
-				return -1;
-			};
+				int j = 1;
+				while (j < src_len && _fold_char(srcd[i + k + j]) == _fold_char(str[j])) {
+					j++;
+				}
+				if (j == src_len) {
+					return i + k;
+				}
+			}
+		}
+	}
+#endif
 
-			CharType src = _find_lower(srcd[read_pos]);
-			CharType dst = _find_lower(p_str[j]);
+	for (; i <= last; i++) {
 
-			if (src != dst) {
-				found = false;
-				break;
-			}
+		if (_fold_char(srcd[i]) != first) {
+			continue;
 		}
 
-		if (found)
+		int j = 1;
+		while (j < src_len && _fold_char(srcd[i + j]) == _fold_char(str[j])) {
+			j++;
+		}
+		if (j == src_len) {
 			return i;
+		}
 	}
 
 	return -1;
@@ -134,6 +134,7 @@ class String {
 	void copy_from_unchecked(const CharType *p_char, const int p_length);
 	bool _base_is_subsequence_of(const String &p_string, bool case_insensitive) const;
 	int _count(const String &p_string, int p_from, int p_to, bool p_case_insensitive) const;
+	String _change_case(bool p_upper) const;
 
 public:
 	enum {
@@ -151,7 +152,10 @@ public:
 	_FORCE_INLINE_ CharType get(int p_index) const { return _cowdata.get(p_index); }
 	_FORCE_INLINE_ void set(int p_index, const CharType &p_elem) { _cowdata.set(p_index, p_elem); }
 	_FORCE_INLINE_ int size() const { return _cowdata.size(); }
-	Error resize(int p_size) { return _cowdata.resize(p_size); }
+	Error resize(int p_size) {
+		MemoryTagScope memory_tag(Memory::TAG_STRINGS);
+		return _cowdata.resize(p_size);
+	}
 
 	_FORCE_INLINE_ const CharType &operator[](int p_index) const {
 		if (unlikely(p_index == _cowdata.size()))
@@ -297,6 +301,7 @@ public:
 
 	CharString ascii(bool p_allow_extended = false) const;
 	CharString utf8() const;
+	int utf8_length() const; //bytes utf8() would produce, not counting the terminator
 	bool parse_utf8(const char *p_utf8, int p_len = -1); //return true on error
 	static String utf8(const char *p_utf8, int p_len = -1);
 
@@ -1995,7 +1995,7 @@ String Variant::stringify(List<const void *> &stack) const {
 				if (i)
 					str += ", ";
 
-				str += arr[i].stringify(stack);
+				str += arr.get_element(i).stringify(stack);
 			}
 
 			str += "]";
@@ -2302,6 +2302,15 @@ Variant::operator Signal() const {
 		return Signal();
 }
 
+template <class SA>
+inline Variant _convert_array_get(const SA &p_array, int p_idx) {
+	return p_array.get(p_idx);
+}
+
+inline Variant _convert_array_get(const Array &p_array, int p_idx) {
+	return p_array.get_element(p_idx); //keeps typed arrays native
+}
+
 template <class DA, class SA>
 inline DA _convert_array(const SA &p_array) {
 
@@ -2310,19 +2319,34 @@ inline DA _convert_array(const SA &p_array) {
 
 	for (int i = 0; i < p_array.size(); i++) {
 
-		da.set(i, Variant(p_array.get(i)));
+		da.set(i, _convert_array_get(p_array, i));
 	}
 
 	return da;
 }
 
+template <class DA>
+struct _TypedArrayStorage {
+	static _FORCE_INLINE_ const DA *get(const Array &p_array) { return NULL; }
+};
+
+template <class T>
+struct _TypedArrayStorage<Vector<T>> {
+	static _FORCE_INLINE_ const Vector<T> *get(const Array &p_array) { return p_array._get_packed<T>(); }
+};
+
 template <class DA>
 inline DA _convert_array_from_variant(const Variant &p_variant) {
 
 	switch (p_variant.get_type()) {
 
 		case Variant::ARRAY: {
-			return _convert_array<DA, Array>(p_variant.operator Array());
+			Array array = p_variant.operator Array();
+			const DA *packed = _TypedArrayStorage<DA>::get(array);
+			if (packed) {
+				return *packed; //shares the data
+			}
+			return _convert_array<DA, Array>(array);
 		}
 		case Variant::PACKED_BYTE_ARRAY: {
 			return _convert_array<DA, Vector<uint8_t>>(p_variant.operator Vector<uint8_t>());
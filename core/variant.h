@@ -426,6 +426,14 @@ public:
 	Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Variant call(const StringName &p_method, const Variant &p_arg1 = Variant(), const Variant &p_arg2 = Variant(), const Variant &p_arg3 = Variant(), const Variant &p_arg4 = Variant(), const Variant &p_arg5 = Variant());
 
+	// builtin methods by id, so callers that resolved the name once skip the lookup
+	typedef void (*ValidatedBuiltInMethod)(Variant &r_ret, Variant &p_self, const Variant **p_args);
+
+	static int get_builtin_method_id(Variant::Type p_type, const StringName &p_method);
+	void call_builtin(int p_method_id, const Variant **p_args, int p_argcount, Variant *r_ret, Callable::CallError &r_error);
+	// no argument count or type checks, only for arguments known to match get_method_argument_types() exactly
+	static ValidatedBuiltInMethod get_validated_builtin_method(Variant::Type p_type, int p_method_id);
+
 	static String get_call_error_text(Object *p_base, const StringName &p_method, const Variant **p_argptrs, int p_argcount, const Callable::CallError &ce);
 	static String get_callable_error_text(const Callable &p_callable, const Variant **p_argptrs, int p_argcount, const Callable::CallError &ce);
 
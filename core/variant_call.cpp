@@ -50,6 +50,7 @@ struct _VariantCall {
 
 	struct FuncData {
 
+		StringName name;
 		int arg_count;
 		Vector<Variant> default_args;
 		Vector<Variant::Type> arg_types;
@@ -61,7 +62,7 @@ struct _VariantCall {
 
 		VariantFunc func;
 
-		_FORCE_INLINE_ bool verify_arguments(const Variant **p_args, Callable::CallError &r_error) {
+		_FORCE_INLINE_ bool verify_arguments(const Variant **p_args, Callable::CallError &r_error) const {
 
 			if (arg_count == 0)
 				return true;
@@ -82,7 +83,7 @@ struct _VariantCall {
 			return true;
 		}
 
-		_FORCE_INLINE_ void call(Variant &r_ret, Variant &p_self, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+		_FORCE_INLINE_ void call(Variant &r_ret, Variant &p_self, const Variant **p_args, int p_argcount, Callable::CallError &r_error) const {
 #ifdef DEBUG_ENABLED
 			if (p_argcount > arg_count) {
 				r_error.error = Callable::CallError::CALL_ERROR_TOO_MANY_ARGUMENTS;
@@ -125,7 +126,13 @@ struct _VariantCall {
 
 	struct TypeFunc {
 
-		Map<StringName, FuncData> functions;
+		Vector<FuncData> functions; //indexed by method id
+		HashMap<StringName, int> function_ids;
+
+		_FORCE_INLINE_ const FuncData *find(const StringName &p_name) const {
+			const int *id = function_ids.getptr(p_name);
+			return id ? &functions[*id] : NULL;
+		}
 	};
 
 	static TypeFunc *type_funcs;
@@ -145,13 +152,16 @@ struct _VariantCall {
 	static void make_func_return_variant(Variant::Type p_type, const StringName &p_name) {
 
 #ifdef DEBUG_ENABLED
-		type_funcs[p_type].functions[p_name].returns = true;
+		const int *id = type_funcs[p_type].function_ids.getptr(p_name);
+		ERR_FAIL_COND(!id);
+		type_funcs[p_type].functions.write[*id].returns = true;
 #endif
 	}
 
 	static void addfunc(bool p_const, Variant::Type p_type, Variant::Type p_return, bool p_has_return, const StringName &p_name, VariantFunc p_func, const Vector<Variant> &p_defaultarg, const Arg &p_argtype1 = Arg(), const Arg &p_argtype2 = Arg(), const Arg &p_argtype3 = Arg(), const Arg &p_argtype4 = Arg(), const Arg &p_argtype5 = Arg()) {
 
 		FuncData funcdata;
+		funcdata.name = p_name;
 		funcdata.func = p_func;
 		funcdata.default_args = p_defaultarg;
 		funcdata._const = p_const;
@@ -204,7 +214,15 @@ struct _VariantCall {
 	end:
 
 		funcdata.arg_count = funcdata.arg_types.size();
-		type_funcs[p_type].functions[p_name] = funcdata;
+
+		TypeFunc &tf = type_funcs[p_type];
+		const int *id = tf.function_ids.getptr(p_name);
+		if (id) {
+			tf.functions.write[*id] = funcdata;
+		} else {
+			tf.function_ids[p_name] = tf.functions.size();
+			tf.functions.push_back(funcdata);
+		}
 	}
 
 #define VCALL_LOCALMEM0(m_type, m_method) \
@@ -788,6 +806,28 @@ struct _VariantCall {
 	VCALL_PARRMEM1(PackedVector3Array, Vector3, append_array);
 	VCALL_PARRMEM0(PackedVector3Array, Vector3, invert);
 
+	static void _call_PackedVector3Array_transform(Variant &r_ret, Variant &p_self, const Variant **p_args) {
+
+		Vector<Vector3> *array = Variant::PackedArrayRef<Vector3>::get_array_ptr(p_self._data.packed_array);
+		Transform xform = *p_args[0];
+		xform.xform(array->ptr(), array->ptrw(), array->size());
+	}
+
+	static void _call_PackedVector3Array_transform_normals(Variant &r_ret, Variant &p_self, const Variant **p_args) {
+
+		Vector<Vector3> *array = Variant::PackedArrayRef<Vector3>::get_array_ptr(p_self._data.packed_array);
+		Transform xform = *p_args[0];
+		xform.xform_normals(array->ptr(), array->ptrw(), array->size());
+	}
+
+	static void _call_PackedVector3Array_get_aabb(Variant &r_ret, Variant &p_self, const Variant **p_args) {
+
+		const Vector<Vector3> *array = Variant::PackedArrayRef<Vector3>::get_array_ptr(p_self._data.packed_array);
+		AABB aabb;
+		aabb.create_from_points(array->ptr(), array->size());
+		r_ret = aabb;
+	}
+
 	VCALL_PARRMEM0R(PackedColorArray, Color, size);
 	VCALL_PARRMEM0R(PackedColorArray, Color, empty);
 	VCALL_PARRMEM2(PackedColorArray, Color, set);
@@ -1227,12 +1267,11 @@ void Variant::call_ptr(const StringName &p_method, const Variant **p_args, int p
 
 		r_error.error = Callable::CallError::CALL_OK;
 
-		Map<StringName, _VariantCall::FuncData>::Element *E = _VariantCall::type_funcs[type].functions.find(p_method);
+		const _VariantCall::FuncData *funcdata = _VariantCall::type_funcs[type].find(p_method);
 
-		if (E) {
+		if (funcdata) {
 
-			_VariantCall::FuncData &funcdata = E->get();
-			funcdata.call(ret, *this, p_args, p_argcount, r_error);
+			funcdata->call(ret, *this, p_args, p_argcount, r_error);
 
 		} else {
 			//handle vararg functions manually
@@ -1268,6 +1307,38 @@ void Variant::call_ptr(const StringName &p_method, const Variant **p_args, int p
 		*r_ret = ret;
 }
 
+int Variant::get_builtin_method_id(Variant::Type p_type, const StringName &p_method) {
+
+	ERR_FAIL_INDEX_V(p_type, VARIANT_MAX, -1);
+	const int *id = _VariantCall::type_funcs[p_type].function_ids.getptr(p_method);
+	return id ? *id : -1;
+}
+
+Variant::ValidatedBuiltInMethod Variant::get_validated_builtin_method(Variant::Type p_type, int p_method_id) {
+
+	ERR_FAIL_INDEX_V(p_type, VARIANT_MAX, NULL);
+	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
+	ERR_FAIL_INDEX_V(p_method_id, tf.functions.size(), NULL);
+	return tf.functions[p_method_id].func;
+}
+
+void Variant::call_builtin(int p_method_id, const Variant **p_args, int p_argcount, Variant *r_ret, Callable::CallError &r_error) {
+
+	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[type];
+	if (unlikely(p_method_id < 0 || p_method_id >= tf.functions.size())) {
+		r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
+		return;
+	}
+
+	r_error.error = Callable::CallError::CALL_OK;
+
+	Variant ret;
+	tf.functions[p_method_id].call(ret, *this, p_args, p_argcount, r_error);
+
+	if (r_error.error == Callable::CallError::CALL_OK && r_ret)
+		*r_ret = ret;
+}
+
 #define VCALL(m_type, m_method) _VariantCall::_call_##m_type##_##m_method
 
 Variant Variant::construct(const Variant::Type p_type, const Variant **p_args, int p_argcount, Callable::CallError &r_error, bool p_strict) {
@@ -1436,77 +1507,67 @@ bool Variant::has_method(const StringName &p_method) const {
 	}
 
 	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[type];
-	return tf.functions.has(p_method);
+	return tf.function_ids.has(p_method);
 }
 
 Vector<Variant::Type> Variant::get_method_argument_types(Variant::Type p_type, const StringName &p_method) {
 
-	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
-
-	const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.find(p_method);
-	if (!E)
+	const _VariantCall::FuncData *fd = _VariantCall::type_funcs[p_type].find(p_method);
+	if (!fd)
 		return Vector<Variant::Type>();
 
-	return E->get().arg_types;
+	return fd->arg_types;
 }
 
 bool Variant::is_method_const(Variant::Type p_type, const StringName &p_method) {
 
-	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
-
-	const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.find(p_method);
-	if (!E)
+	const _VariantCall::FuncData *fd = _VariantCall::type_funcs[p_type].find(p_method);
+	if (!fd)
 		return false;
 
-	return E->get()._const;
+	return fd->_const;
 }
 
 Vector<StringName> Variant::get_method_argument_names(Variant::Type p_type, const StringName &p_method) {
 
-	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
-
-	const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.find(p_method);
-	if (!E)
+	const _VariantCall::FuncData *fd = _VariantCall::type_funcs[p_type].find(p_method);
+	if (!fd)
 		return Vector<StringName>();
 
-	return E->get().arg_names;
+	return fd->arg_names;
 }
 
 Variant::Type Variant::get_method_return_type(Variant::Type p_type, const StringName &p_method, bool *r_has_return) {
 
-	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
-
-	const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.find(p_method);
-	if (!E)
+	const _VariantCall::FuncData *fd = _VariantCall::type_funcs[p_type].find(p_method);
+	if (!fd)
 		return Variant::NIL;
 
 	if (r_has_return)
-		*r_has_return = E->get().returns;
+		*r_has_return = fd->returns;
 
-	return E->get().return_type;
+	return fd->return_type;
 }
 
 Vector<Variant> Variant::get_method_default_arguments(Variant::Type p_type, const StringName &p_method) {
 
-	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[p_type];
-
-	const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.find(p_method);
-	if (!E)
+	const _VariantCall::FuncData *fd = _VariantCall::type_funcs[p_type].find(p_method);
+	if (!fd)
 		return Vector<Variant>();
 
-	return E->get().default_args;
+	return fd->default_args;
 }
 
 void Variant::get_method_list(List<MethodInfo> *p_list) const {
 
 	const _VariantCall::TypeFunc &tf = _VariantCall::type_funcs[type];
 
-	for (const Map<StringName, _VariantCall::FuncData>::Element *E = tf.functions.front(); E; E = E->next()) {
+	for (int i = 0; i < tf.functions.size(); i++) {
 
-		const _VariantCall::FuncData &fd = E->get();
+		const _VariantCall::FuncData &fd = tf.functions[i];
 
 		MethodInfo mi;
-		mi.name = E->key();
+		mi.name = fd.name;
 
 		if (fd._const) {
 			mi.flags |= METHOD_FLAG_CONST;
@@ -2108,6 +2169,9 @@ void register_variant_methods() {
 	ADDFUNC2R(PACKED_VECTOR3_ARRAY, INT, PackedVector3Array, insert, INT, "idx", VECTOR3, "vector3", varray());
 	ADDFUNC1(PACKED_VECTOR3_ARRAY, NIL, PackedVector3Array, resize, INT, "idx", varray());
 	ADDFUNC0(PACKED_VECTOR3_ARRAY, NIL, PackedVector3Array, invert, varray());
+	ADDFUNC1(PACKED_VECTOR3_ARRAY, NIL, PackedVector3Array, transform, TRANSFORM, "transform", varray());
+	ADDFUNC1(PACKED_VECTOR3_ARRAY, NIL, PackedVector3Array, transform_normals, TRANSFORM, "transform", varray());
+	ADDFUNC0R(PACKED_VECTOR3_ARRAY, AABB, PackedVector3Array, get_aabb, varray());
 
 	ADDFUNC0R(PACKED_COLOR_ARRAY, INT, PackedColorArray, size, varray());
 	ADDFUNC0R(PACKED_COLOR_ARRAY, BOOL, PackedColorArray, empty, varray());
@@ -491,7 +491,7 @@ void Variant::evaluate(const Operator &p_op, const Variant &p_a,
 				if (arr_b->size() != l)
 					_RETURN(false);
 				for (int i = 0; i < l; i++) {
-					if (!((*arr_a)[i] == (*arr_b)[i])) {
+					if (!(arr_a->get_element(i) == arr_b->get_element(i))) {
 						_RETURN(false);
 					}
 				}
@@ -590,7 +590,7 @@ void Variant::evaluate(const Operator &p_op, const Variant &p_a,
 				if (arr_b->size() != l)
 					_RETURN(true);
 				for (int i = 0; i < l; i++) {
-					if (((*arr_a)[i] != (*arr_b)[i])) {
+					if ((arr_a->get_element(i) != arr_b->get_element(i))) {
 						_RETURN(true);
 					}
 				}
@@ -663,7 +663,7 @@ void Variant::evaluate(const Operator &p_op, const Variant &p_a,
 				if (arr_b->size() < l)
 					_RETURN(false);
 				for (int i = 0; i < l; i++) {
-					if (!((*arr_a)[i] < (*arr_b)[i])) {
+					if (!(arr_a->get_element(i) < arr_b->get_element(i))) {
 						_RETURN(true);
 					}
 				}
@@ -782,7 +782,7 @@ void Variant::evaluate(const Operator &p_op, const Variant &p_a,
 				if (arr_b->size() > l)
 					_RETURN(false);
 				for (int i = 0; i < l; i++) {
-					if (((*arr_a)[i] < (*arr_b)[i])) {
+					if ((arr_a->get_element(i) < arr_b->get_element(i))) {
 						_RETURN(false);
 					}
 				}
@@ -885,9 +885,9 @@ void Variant::evaluate(const Operator &p_op, const Variant &p_a,
 				int bsize = array_b.size();
 				sum.resize(asize + bsize);
 				for (int i = 0; i < asize; i++)
-					sum[i] = array_a[i];
+					sum[i] = array_a.get_element(i);
 				for (int i = 0; i < bsize; i++)
-					sum[i + asize] = array_b[i];
+					sum[i + asize] = array_b.get_element(i);
 				_RETURN(sum);
 			}
 
@@ -2580,7 +2580,7 @@ void Variant::set(const Variant &p_index, const Variant &p_value, bool *r_valid)
 			valid = true; //always valid, i guess? should this really be ok?
 			return;
 		} break;
-			DEFAULT_OP_ARRAY_CMD(ARRAY, Array, ;, (*arr)[index] = p_value; return )
+			DEFAULT_OP_ARRAY_CMD(ARRAY, Array, ;, arr->set(index, p_value); return )
 			DEFAULT_OP_DVECTOR_SET(PACKED_BYTE_ARRAY, uint8_t, p_value.type != Variant::FLOAT && p_value.type != Variant::INT)
 			DEFAULT_OP_DVECTOR_SET(PACKED_INT32_ARRAY, int32_t, p_value.type != Variant::FLOAT && p_value.type != Variant::INT)
 			DEFAULT_OP_DVECTOR_SET(PACKED_INT64_ARRAY, int64_t, p_value.type != Variant::FLOAT && p_value.type != Variant::INT)
@@ -3034,7 +3034,7 @@ Variant Variant::get(const Variant &p_index, bool *r_valid) const {
 				return *res;
 			}
 		} break;
-			DEFAULT_OP_ARRAY_CMD(ARRAY, const Array, ;, return (*arr)[index])
+			DEFAULT_OP_ARRAY_CMD(ARRAY, const Array, ;, return arr->get_element(index))
 			DEFAULT_OP_DVECTOR_GET(PACKED_BYTE_ARRAY, uint8_t)
 			DEFAULT_OP_DVECTOR_GET(PACKED_INT32_ARRAY, int32_t)
 			DEFAULT_OP_DVECTOR_GET(PACKED_INT64_ARRAY, int64_t)
@@ -3111,7 +3111,7 @@ bool Variant::in(const Variant &p_index, bool *r_valid) const {
 			if (l) {
 				for (int i = 0; i < l; i++) {
 
-					if (evaluate(OP_EQUAL, (*arr)[i], p_index))
+					if (evaluate(OP_EQUAL, arr->get_element(i), p_index))
 						return true;
 				}
 			}
@@ -3896,7 +3896,7 @@ Variant Variant::iter_get(const Variant &r_iter, bool &r_valid) const {
 				return Variant();
 			}
 #endif
-			return arr->get(idx);
+			return arr->get_element(idx);
 		} break;
 		case PACKED_BYTE_ARRAY: {
 			const Vector<uint8_t> *arr = &PackedArrayRef<uint8_t>::get_array(_data.packed_array);
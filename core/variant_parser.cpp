@@ -32,12 +32,28 @@
 
 #include "core/input/input_event.h"
 #include "core/io/resource_loader.h"
+#include "core/local_vector.h"
 #include "core/os/keyboard.h"
 #include "core/string_buffer.h"
 
 CharType VariantParser::StreamFile::get_char() {
 
-	return f->get_8();
+	if (unlikely(readahead_pos == readahead_filled)) {
+		chars = f->get_buffer_view(VIEW_SIZE, readahead_filled);
+		if (!chars) {
+			chars = readahead;
+			readahead_filled = f->get_buffer(readahead, READAHEAD_SIZE);
+		}
+		readahead_pos = 0;
+		if (readahead_filled <= 0) {
+			// Like FileAccess::get_8, EOF is only reported after trying to read past the end.
+			readahead_filled = 0;
+			eof = true;
+			return 0;
+		}
+	}
+
+	return chars[readahead_pos++];
 }
 
 bool VariantParser::StreamFile::is_utf8() const {
@@ -46,7 +62,12 @@ bool VariantParser::StreamFile::is_utf8() const {
 }
 bool VariantParser::StreamFile::is_eof() const {
 
-	return f->eof_reached();
+	return eof;
+}
+
+uint64_t VariantParser::StreamFile::get_position() const {
+
+	return f->get_position() - (readahead_filled - readahead_pos);
 }
 
 CharType VariantParser::StreamString::get_char() {
@@ -92,6 +113,180 @@ const char *VariantParser::tk_name[TK_MAX] = {
 	"ERROR"
 };
 
+// Identifiers that appear over and over in resource files. Their tokens share one String
+// instead of allocating a new one each time.
+static const char *_common_identifiers[] = {
+	"true", "false", "null", "nil", "inf", "nan",
+	"Vector2", "Vector2i", "Rect2", "Rect2i", "Vector3", "Vector3i", "Transform2D", "Plane", "Quat",
+	"AABB", "Basis", "Transform", "Color", "NodePath", "RID", "Object", "Resource", "SubResource", "ExtResource",
+	"PackedByteArray", "PackedInt32Array", "PackedInt64Array", "PackedFloat32Array", "PackedFloat64Array",
+	"PackedStringArray", "PackedVector2Array", "PackedVector3Array", "PackedColorArray",
+	"gd_scene", "gd_resource", "ext_resource", "sub_resource", "node", "connection", "editable", "resource",
+	"load_steps", "format", "path", "type", "id", "name", "parent", "instance", "instance_placeholder",
+	"owner", "index", "groups", "signal", "from", "to", "method", "flags", "binds",
+	NULL
+};
+
+struct _VariantParserIdentifiers {
+
+	enum {
+		TABLE_SIZE = 256 // power of two, well above the amount of identifiers
+	};
+
+	String strings[TABLE_SIZE];
+	uint32_t hashes[TABLE_SIZE];
+
+	const String *find(const CharType *p_str, int p_len, uint32_t p_hash) const {
+
+		for (uint32_t i = p_hash & (TABLE_SIZE - 1);; i = (i + 1) & (TABLE_SIZE - 1)) {
+
+			if (strings[i].empty()) {
+				return NULL;
+			}
+			if (hashes[i] == p_hash && strings[i].length() == p_len && memcmp(strings[i].ptr(), p_str, p_len * sizeof(CharType)) == 0) {
+				return &strings[i];
+			}
+		}
+	}
+
+	_VariantParserIdentifiers() {
+
+		for (int i = 0; _common_identifiers[i]; i++) {
+
+			String str = _common_identifiers[i];
+			uint32_t hash = 5381;
+			for (int j = 0; j < str.length(); j++) {
+				hash = hash_djb2_one_32(str[j], hash);
+			}
+
+			uint32_t pos = hash & (TABLE_SIZE - 1);
+			while (!strings[pos].empty()) {
+				pos = (pos + 1) & (TABLE_SIZE - 1);
+			}
+			strings[pos] = str;
+			hashes[pos] = hash;
+		}
+	}
+};
+
+// Bytes of a quoted string read from an UTF-8 stream, so they can be decoded in one go.
+// Stays on the stack unless the string is long.
+class _VariantParserUTF8Buffer {
+
+	enum {
+		SHORT_BUFFER_SIZE = 256
+	};
+
+	char short_buffer[SHORT_BUFFER_SIZE];
+	LocalVector<char> buffer;
+	int length;
+
+public:
+	_FORCE_INLINE_ void push_back(char p_byte) {
+
+		if (likely(length < SHORT_BUFFER_SIZE)) {
+			short_buffer[length++] = p_byte;
+			return;
+		}
+		if (buffer.empty()) {
+			buffer.resize(SHORT_BUFFER_SIZE);
+			memcpy(buffer.ptr(), short_buffer, SHORT_BUFFER_SIZE);
+		}
+		buffer.push_back(p_byte);
+		length++;
+	}
+
+	_FORCE_INLINE_ const char *ptr() const { return buffer.empty() ? short_buffer : buffer.ptr(); }
+	_FORCE_INLINE_ int size() const { return length; }
+
+	_VariantParserUTF8Buffer() {
+		length = 0;
+	}
+};
+
+void VariantParser::_read_number(Stream *p_stream, CharType p_first, Variant &r_value) {
+
+	StringBuffer<> num;
+#define READING_SIGN 0
+#define READING_INT 1
+#define READING_DEC 2
+#define READING_EXP 3
+#define READING_DONE 4
+	int reading = READING_INT;
+
+	CharType c = p_first;
+	if (c == '-') {
+		num += '-';
+		c = p_stream->get_char();
+	}
+
+	bool exp_sign = false;
+	bool exp_beg = false;
+	bool is_float = false;
+
+	while (true) {
+
+		switch (reading) {
+			case READING_INT: {
+
+				if (c >= '0' && c <= '9') {
+					//pass
+				} else if (c == '.') {
+					reading = READING_DEC;
+					is_float = true;
+				} else if (c == 'e') {
+					reading = READING_EXP;
+					is_float = true;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_DEC: {
+
+				if (c >= '0' && c <= '9') {
+
+				} else if (c == 'e') {
+					reading = READING_EXP;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_EXP: {
+
+				if (c >= '0' && c <= '9') {
+					exp_beg = true;
+
+				} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
+					exp_sign = true;
+
+				} else {
+					reading = READING_DONE;
+				}
+			} break;
+		}
+
+		if (reading == READING_DONE)
+			break;
+		num += c;
+		c = p_stream->get_char();
+	}
+
+#undef READING_SIGN
+#undef READING_INT
+#undef READING_DEC
+#undef READING_EXP
+#undef READING_DONE
+
+	p_stream->saved = c;
+
+	if (is_float)
+		r_value = num.as_double();
+	else
+		r_value = num.as_int();
+}
+
 Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, String &r_err_str) {
 
 	bool string_name = false;
@@ -220,7 +415,10 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 			}
 			case '"': {
 
-				String str;
+				// UTF-8 streams hand out bytes, keep them apart and decode once at the end.
+				bool utf8 = p_stream->is_utf8();
+				_VariantParserUTF8Buffer utf8_str;
+				StringBuffer<> str;
 				while (true) {
 
 					CharType ch = p_stream->get_char();
@@ -287,25 +485,44 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 							} break;
 						}
 
-						str += res;
+						if (utf8) {
+							utf8_str.push_back(char(res));
+						} else {
+							str += res;
+						}
 
 					} else {
 						if (ch == '\n')
 							line++;
-						str += ch;
+						if (utf8) {
+							utf8_str.push_back(char(ch));
+						} else {
+							str += ch;
+						}
 					}
 				}
 
-				if (p_stream->is_utf8()) {
-					str.parse_utf8(str.ascii(true).get_data());
+				String value;
+				if (utf8) {
+					if (value.parse_utf8(utf8_str.ptr(), utf8_str.size())) {
+						//not valid UTF-8, keep the bytes as they are
+						value.resize(utf8_str.size() + 1);
+						CharType *w = value.ptrw();
+						for (int i = 0; i < utf8_str.size(); i++) {
+							w[i] = uint8_t(utf8_str.ptr()[i]);
+						}
+						w[utf8_str.size()] = 0;
+					}
+				} else {
+					value = str.as_string();
 				}
 				if (string_name) {
 					r_token.type = TK_STRING_NAME;
-					r_token.value = StringName(str);
+					r_token.value = StringName(value);
 					string_name = false; //reset
 				} else {
 					r_token.type = TK_STRING;
-					r_token.value = str;
+					r_token.value = value;
 				}
 				return OK;
 
@@ -319,91 +536,22 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 				if (cchar == '-' || (cchar >= '0' && cchar <= '9')) {
 					//a number
 
-					StringBuffer<> num;
-#define READING_SIGN 0
-#define READING_INT 1
-#define READING_DEC 2
-#define READING_EXP 3
-#define READING_DONE 4
-					int reading = READING_INT;
-
-					if (cchar == '-') {
-						num += '-';
-						cchar = p_stream->get_char();
-					}
-
-					CharType c = cchar;
-					bool exp_sign = false;
-					bool exp_beg = false;
-					bool is_float = false;
-
-					while (true) {
-
-						switch (reading) {
-							case READING_INT: {
-
-								if (c >= '0' && c <= '9') {
-									//pass
-								} else if (c == '.') {
-									reading = READING_DEC;
-									is_float = true;
-								} else if (c == 'e') {
-									reading = READING_EXP;
-									is_float = true;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_DEC: {
-
-								if (c >= '0' && c <= '9') {
-
-								} else if (c == 'e') {
-									reading = READING_EXP;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_EXP: {
-
-								if (c >= '0' && c <= '9') {
-									exp_beg = true;
-
-								} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
-									exp_sign = true;
-
-								} else {
-									reading = READING_DONE;
-								}
-							} break;
-						}
-
-						if (reading == READING_DONE)
-							break;
-						num += c;
-						c = p_stream->get_char();
-					}
-
-					p_stream->saved = c;
-
+					_read_number(p_stream, cchar, r_token.value);
 					r_token.type = TK_NUMBER;
-
-					if (is_float)
-						r_token.value = num.as_double();
-					else
-						r_token.value = num.as_int();
 					return OK;
 
 				} else if ((cchar >= 'A' && cchar <= 'Z') || (cchar >= 'a' && cchar <= 'z') || cchar == '_') {
 
+					static const _VariantParserIdentifiers common_identifiers;
+
 					StringBuffer<> id;
+					uint32_t hash = 5381;
 					bool first = true;
 
 					while ((cchar >= 'A' && cchar <= 'Z') || (cchar >= 'a' && cchar <= 'z') || cchar == '_' || (!first && cchar >= '0' && cchar <= '9')) {
 
 						id += cchar;
+						hash = hash_djb2_one_32(cchar, hash);
 						cchar = p_stream->get_char();
 						first = false;
 					}
@@ -411,7 +559,13 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					p_stream->saved = cchar;
 
 					r_token.type = TK_IDENTIFIER;
-					r_token.value = id.as_string();
+
+					const String *common = common_identifiers.find(id.ptr(), id.length(), hash);
+					if (common) {
+						r_token.value = *common;
+					} else {
+						r_token.value = id.as_string();
+					}
 					return OK;
 				} else {
 					r_err_str = "Unexpected character.";
@@ -482,6 +636,34 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 				return ERR_PARSE_ERROR;
 			}
 		}
+
+		// Numbers are by far the most common thing here, read them straight from the stream.
+		CharType c = p_stream->saved;
+		p_stream->saved = 0;
+		if (!c) {
+			c = p_stream->get_char();
+		}
+		while (c > 0 && c <= 32 && !p_stream->is_eof()) {
+			if (c == '\n') {
+				line++;
+			}
+			c = p_stream->get_char();
+		}
+
+		if (c == '-' || (c >= '0' && c <= '9')) {
+			Variant number;
+			_read_number(p_stream, c, number);
+			r_construct.push_back(number);
+			first = false;
+			continue;
+		}
+
+		if (c == 0) {
+			r_err_str = "Expected float in constructor";
+			return ERR_PARSE_ERROR;
+		}
+
+		p_stream->saved = c;
 		get_token(p_stream, token, line, r_err_str);
 
 		if (first && token.type == TK_PARENTHESIS_CLOSE) {
@@ -926,107 +1108,59 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 
 		} else if (id == "PackedByteArray" || id == "PoolByteArray" || id == "ByteArray") {
 
-			Vector<uint8_t> args;
-			Error err = _parse_construct<uint8_t>(p_stream, args, line, r_err_str);
+			Vector<uint8_t> arr;
+			Error err = _parse_construct<uint8_t>(p_stream, arr, line, r_err_str);
 			if (err)
 				return err;
 
-			Vector<uint8_t> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				uint8_t *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
 			value = arr;
 
 			return OK;
 
 		} else if (id == "PackedInt32Array" || id == "PackedIntArray" || id == "PoolIntArray" || id == "IntArray") {
 
-			Vector<int32_t> args;
-			Error err = _parse_construct<int32_t>(p_stream, args, line, r_err_str);
+			Vector<int32_t> arr;
+			Error err = _parse_construct<int32_t>(p_stream, arr, line, r_err_str);
 			if (err)
 				return err;
 
-			Vector<int32_t> arr;
-			{
-				int32_t len = args.size();
-				arr.resize(len);
-				int32_t *w = arr.ptrw();
-				for (int32_t i = 0; i < len; i++) {
-					w[i] = int32_t(args[i]);
-				}
-			}
-
 			value = arr;
 
 			return OK;
 
 		} else if (id == "PackedInt64Array") {
 
-			Vector<int64_t> args;
-			Error err = _parse_construct<int64_t>(p_stream, args, line, r_err_str);
+			Vector<int64_t> arr;
+			Error err = _parse_construct<int64_t>(p_stream, arr, line, r_err_str);
 			if (err)
 				return err;
 
-			Vector<int64_t> arr;
-			{
-				int64_t len = args.size();
-				arr.resize(len);
-				int64_t *w = arr.ptrw();
-				for (int64_t i = 0; i < len; i++) {
-					w[i] = int64_t(args[i]);
-				}
-			}
-
 			value = arr;
 
 			return OK;
 
 		} else if (id == "PackedFloat32Array" || id == "PackedRealArray" || id == "PoolRealArray" || id == "FloatArray") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<float> arr;
+			Error err = _parse_construct<float>(p_stream, arr, line, r_err_str);
 			if (err)
 				return err;
 
-			Vector<float> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				float *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
 			value = arr;
 
 			return OK;
+
 		} else if (id == "PackedFloat64Array") {
 
-			Vector<double> args;
-			Error err = _parse_construct<double>(p_stream, args, line, r_err_str);
+			Vector<double> arr;
+			Error err = _parse_construct<double>(p_stream, arr, line, r_err_str);
 			if (err)
 				return err;
 
-			Vector<double> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				double *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
 			value = arr;
 
 			return OK;
+
 		} else if (id == "PackedStringArray" || id == "PoolStringArray" || id == "StringArray") {
 
 			get_token(p_stream, token, line, r_err_str);
@@ -1080,8 +1214,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 
 		} else if (id == "PackedVector2Array" || id == "PoolVector2Array" || id == "Vector2Array") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -1090,8 +1224,9 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				int len = args.size() / 2;
 				arr.resize(len);
 				Vector2 *w = arr.ptrw();
+				const real_t *r = args.ptr();
 				for (int i = 0; i < len; i++) {
-					w[i] = Vector2(args[i * 2 + 0], args[i * 2 + 1]);
+					w[i] = Vector2(r[i * 2 + 0], r[i * 2 + 1]);
 				}
 			}
 
@@ -1101,8 +1236,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 
 		} else if (id == "PackedVector3Array" || id == "PoolVector3Array" || id == "Vector3Array") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -1111,8 +1246,9 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				int len = args.size() / 3;
 				arr.resize(len);
 				Vector3 *w = arr.ptrw();
+				const real_t *r = args.ptr();
 				for (int i = 0; i < len; i++) {
-					w[i] = Vector3(args[i * 3 + 0], args[i * 3 + 1], args[i * 3 + 2]);
+					w[i] = Vector3(r[i * 3 + 0], r[i * 3 + 1], r[i * 3 + 2]);
 				}
 			}
 
@@ -1132,14 +1268,16 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				int len = args.size() / 4;
 				arr.resize(len);
 				Color *w = arr.ptrw();
+				const float *r = args.ptr();
 				for (int i = 0; i < len; i++) {
-					w[i] = Color(args[i * 4 + 0], args[i * 4 + 1], args[i * 4 + 2], args[i * 4 + 3]);
+					w[i] = Color(r[i * 4 + 0], r[i * 4 + 1], r[i * 4 + 2], r[i * 4 + 3]);
 				}
 			}
 
 			value = arr;
 
 			return OK;
+
 		} else {
 			r_err_str = "Unexpected identifier: '" + id + "'.";
 			return ERR_PARSE_ERROR;
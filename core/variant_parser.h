@@ -52,13 +52,34 @@ public:
 
 	struct StreamFile : public Stream {
 
+		enum {
+			READAHEAD_SIZE = 4096,
+			VIEW_SIZE = 1024 * 1024 //mapped files are viewed in place, in larger steps
+		};
+
 		FileAccess *f;
 
 		virtual CharType get_char();
 		virtual bool is_utf8() const;
 		virtual bool is_eof() const;
 
-		StreamFile() { f = NULL; }
+		// f is read ahead in blocks, this is the position of the next character the stream returns.
+		uint64_t get_position() const;
+
+		StreamFile() {
+			f = NULL;
+			chars = readahead;
+			readahead_pos = 0;
+			readahead_filled = 0;
+			eof = false;
+		}
+
+	private:
+		uint8_t readahead[READAHEAD_SIZE];
+		const uint8_t *chars; //either readahead or a view of f
+		int readahead_pos;
+		int readahead_filled;
+		bool eof;
 	};
 
 	struct StreamString : public Stream {
@@ -127,6 +148,8 @@ public:
 private:
 	static const char *tk_name[TK_MAX];
 
+	static void _read_number(Stream *p_stream, CharType p_first, Variant &r_value);
+
 	template <class T>
 	static Error _parse_construct(Stream *p_stream, Vector<T> &r_construct, int &line, String &r_err_str);
 	static Error _parse_enginecfg(Stream *p_stream, Vector<String> &strings, int &line, String &r_err_str);
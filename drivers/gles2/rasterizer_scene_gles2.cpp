@@ -3585,7 +3585,7 @@ void RasterizerSceneGLES2::render_scene(const Transform &p_cam_transform, const
 #endif
 }
 
-void RasterizerSceneGLES2::render_shadow(RID p_light, RID p_shadow_atlas, int p_pass, InstanceBase **p_cull_result, int p_cull_count) {
+void RasterizerSceneGLES2::render_shadow(RID p_light, RID p_shadow_atlas, int p_pass, InstanceBase **p_cull_result, int p_cull_count, int p_static_count, uint64_t p_static_version) {
 
 	state.render_no_shadows = false;
 
@@ -44,6 +44,11 @@
 #include <unistd.h>
 #endif
 
+#if defined(UNIX_ENABLED) && !defined(JAVASCRIPT_ENABLED)
+#include <sys/mman.h>
+#define MMAP_ENABLED
+#endif
+
 #ifndef ANDROID_ENABLED
 #include <sys/statvfs.h>
 #endif
@@ -72,11 +77,43 @@ void FileAccessUnix::check_errors() const {
 	}
 }
 
+void FileAccessUnix::_map(int p_fd) {
+
+#ifdef MMAP_ENABLED
+	struct stat st;
+	if (fstat(p_fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < MAP_MIN_SIZE) {
+		return;
+	}
+
+	void *addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, p_fd, 0);
+	if (addr == MAP_FAILED) {
+		return; //not an error, reads go through stdio instead
+	}
+
+	map = (uint8_t *)addr;
+	map_len = st.st_size;
+	map_pos = 0;
+#endif
+}
+
+void FileAccessUnix::_unmap() {
+
+#ifdef MMAP_ENABLED
+	if (map) {
+		munmap(map, map_len);
+	}
+#endif
+	map = NULL;
+	map_len = 0;
+	map_pos = 0;
+}
+
 Error FileAccessUnix::_open(const String &p_path, int p_mode_flags) {
 
 	if (f)
 		fclose(f);
 	f = NULL;
+	_unmap();
 
 	path_src = p_path;
 	path = fix_path(p_path);
@@ -142,6 +179,9 @@ Error FileAccessUnix::_open(const String &p_path, int p_mode_flags) {
 		int opts = fcntl(fd, F_GETFD);
 		fcntl(fd, F_SETFD, opts | FD_CLOEXEC);
 #endif
+		if (p_mode_flags == READ) {
+			_map(fd);
+		}
 	}
 
 	last_error = OK;
@@ -156,6 +196,7 @@ void FileAccessUnix::close() {
 
 	fclose(f);
 	f = NULL;
+	_unmap();
 
 	if (close_notification_func) {
 		close_notification_func(path, flags);
@@ -193,6 +234,11 @@ void FileAccessUnix::seek(size_t p_position) {
 	ERR_FAIL_COND_MSG(!f, "File must be opened before use.");
 
 	last_error = OK;
+	if (map) {
+		map_pos = p_position;
+		return;
+	}
+
 	if (fseek(f, p_position, SEEK_SET))
 		check_errors();
 }
@@ -201,6 +247,12 @@ void FileAccessUnix::seek_end(int64_t p_position) {
 
 	ERR_FAIL_COND_MSG(!f, "File must be opened before use.");
 
+	if (map) {
+		ERR_FAIL_COND(int64_t(map_len) + p_position < 0);
+		map_pos = map_len + p_position;
+		return;
+	}
+
 	if (fseek(f, p_position, SEEK_END))
 		check_errors();
 }
@@ -209,6 +261,10 @@ size_t FileAccessUnix::get_position() const {
 
 	ERR_FAIL_COND_V_MSG(!f, 0, "File must be opened before use.");
 
+	if (map) {
+		return map_pos;
+	}
+
 	long pos = ftell(f);
 	if (pos < 0) {
 		check_errors();
@@ -221,6 +277,10 @@ size_t FileAccessUnix::get_len() const {
 
 	ERR_FAIL_COND_V_MSG(!f, 0, "File must be opened before use.");
 
+	if (map) {
+		return map_len;
+	}
+
 	long pos = ftell(f);
 	ERR_FAIL_COND_V(pos < 0, 0);
 	ERR_FAIL_COND_V(fseek(f, 0, SEEK_END), 0);
@@ -239,6 +299,15 @@ bool FileAccessUnix::eof_reached() const {
 uint8_t FileAccessUnix::get_8() const {
 
 	ERR_FAIL_COND_V_MSG(!f, 0, "File must be opened before use.");
+
+	if (map) {
+		if (map_pos >= map_len) {
+			last_error = ERR_FILE_EOF;
+			return 0;
+		}
+		return map[map_pos++];
+	}
+
 	uint8_t b;
 	if (fread(&b, 1, 1, f) == 0) {
 		check_errors();
@@ -250,11 +319,40 @@ uint8_t FileAccessUnix::get_8() const {
 int FileAccessUnix::get_buffer(uint8_t *p_dst, int p_length) const {
 
 	ERR_FAIL_COND_V_MSG(!f, -1, "File must be opened before use.");
+
+	if (map) {
+		int read = 0;
+		const uint8_t *src = get_buffer_view(p_length, read);
+		ERR_FAIL_COND_V(!src, -1);
+		copymem(p_dst, src, read);
+		return read;
+	}
+
 	int read = fread(p_dst, 1, p_length, f);
 	check_errors();
 	return read;
 };
 
+const uint8_t *FileAccessUnix::get_buffer_view(int p_length, int &r_length) const {
+
+	ERR_FAIL_COND_V_MSG(!f, NULL, "File must be opened before use.");
+	ERR_FAIL_COND_V(p_length < 0, NULL);
+
+	if (!map) {
+		return NULL;
+	}
+
+	size_t left = map_pos < map_len ? map_len - map_pos : 0;
+	r_length = MIN(size_t(p_length), left);
+	if (r_length < p_length) {
+		last_error = ERR_FILE_EOF; //like fread, only reported when reading past the end
+	}
+
+	const uint8_t *view = map + MIN(map_pos, map_len);
+	map_pos += r_length;
+	return view;
+}
+
 Error FileAccessUnix::get_error() const {
 
 	return last_error;
@@ -357,6 +455,9 @@ CloseNotificationFunc FileAccessUnix::close_notification_func = NULL;
 FileAccessUnix::FileAccessUnix() :
 		f(NULL),
 		flags(0),
+		map(NULL),
+		map_len(0),
+		map_pos(0),
 		last_error(OK) {
 }
 
@@ -56,6 +56,13 @@
 
 #include <netinet/tcp.h>
 
+#if defined(NET_POLLER_EPOLL)
+#include <sys/epoll.h>
+#elif defined(NET_POLLER_KQUEUE)
+#include <sys/event.h>
+#include <sys/time.h>
+#endif
+
 // BSD calls this flag IPV6_JOIN_GROUP
 #if !defined(IPV6_ADD_MEMBERSHIP) && defined(IPV6_JOIN_GROUP)
 #define IPV6_ADD_MEMBERSHIP IPV6_JOIN_GROUP
@@ -71,6 +78,7 @@
 #define SOCK_IOCTL ioctl
 #define SOCK_CLOSE ::close
 #define SOCK_CONNECT(p_sock, p_addr, p_addr_len) ::connect(p_sock, p_addr, p_addr_len)
+#define SOCK_POLL ::poll
 
 /* Windows */
 #elif defined(WINDOWS_ENABLED)
@@ -87,6 +95,7 @@
 // connect is broken on windows under certain conditions, reasons unknown:
 // See https://github.com/godotengine/webrtc-native/issues/6
 #define SOCK_CONNECT(p_sock, p_addr, p_addr_len) ::WSAConnect(p_sock, p_addr, p_addr_len, NULL, NULL, NULL, NULL)
+#define SOCK_POLL WSAPoll
 
 // Workaround missing flag in MinGW
 #if defined(__MINGW32__) && !defined(SIO_UDP_NETRESET)
@@ -161,6 +170,7 @@ void NetSocketPosix::make_default() {
 	}
 #endif
 	_create = _create_func;
+	NetSocketPollerPosix::make_default();
 }
 
 void NetSocketPosix::cleanup() {
@@ -616,6 +626,86 @@ Error NetSocketPosix::sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IP
 	return OK;
 }
 
+#ifdef NET_SOCKET_MMSG
+#define MMSG_MAX_BATCH 32
+
+Error NetSocketPosix::recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_count) {
+	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
+
+	r_count = 0;
+	int count = MIN(p_count, MMSG_MAX_BATCH);
+	if (count <= 0) {
+		return OK;
+	}
+
+	struct mmsghdr msgs[MMSG_MAX_BATCH];
+	struct iovec iovs[MMSG_MAX_BATCH];
+	struct sockaddr_storage addrs[MMSG_MAX_BATCH];
+	memset(msgs, 0, sizeof(struct mmsghdr) * count);
+	for (int i = 0; i < count; i++) {
+		iovs[i].iov_base = p_datagrams[i].buffer;
+		iovs[i].iov_len = p_datagrams[i].size;
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	int ret = ::recvmmsg(_sock, msgs, count, 0, NULL);
+	if (ret < 0) {
+		NetError err = _get_socket_error();
+		if (err == ERR_NET_WOULD_BLOCK)
+			return ERR_BUSY;
+
+		return FAILED;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		Datagram &d = p_datagrams[i];
+		d.size = msgs[i].msg_len;
+		_set_ip_port(&addrs[i], d.ip, d.port);
+	}
+	r_count = ret;
+	return OK;
+}
+
+Error NetSocketPosix::sendto_batch(const Datagram *p_datagrams, int p_count, int &r_count) {
+	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
+
+	r_count = 0;
+	int count = MIN(p_count, MMSG_MAX_BATCH);
+	if (count <= 0) {
+		return OK;
+	}
+
+	struct mmsghdr msgs[MMSG_MAX_BATCH];
+	struct iovec iovs[MMSG_MAX_BATCH];
+	struct sockaddr_storage addrs[MMSG_MAX_BATCH];
+	memset(msgs, 0, sizeof(struct mmsghdr) * count);
+	for (int i = 0; i < count; i++) {
+		const Datagram &d = p_datagrams[i];
+		iovs[i].iov_base = d.buffer;
+		iovs[i].iov_len = d.size;
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = _set_addr_storage(&addrs[i], d.ip, d.port, _ip_type);
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	int ret = ::sendmmsg(_sock, msgs, count, 0);
+	if (ret < 0) {
+		NetError err = _get_socket_error();
+		if (err == ERR_NET_WOULD_BLOCK)
+			return ERR_BUSY;
+
+		return FAILED;
+	}
+
+	r_count = ret;
+	return OK;
+}
+#endif
+
 Error NetSocketPosix::set_broadcasting_enabled(bool p_enabled) {
 	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
 	// IPv6 has no broadcast support.
@@ -743,4 +833,284 @@ Error NetSocketPosix::join_multicast_group(const IP_Address &p_multi_address, St
 Error NetSocketPosix::leave_multicast_group(const IP_Address &p_multi_address, String p_if_name) {
 	return _change_multicast_group(p_multi_address, p_if_name, false);
 }
+
+/* NetSocketPollerPosix */
+
+SOCKET_TYPE NetSocketPollerPosix::_get_fd(const Ref<NetSocket> &p_socket) {
+
+	// Every socket on these platforms is created by NetSocketPosix::_create_func.
+	return static_cast<const NetSocketPosix *>(p_socket.ptr())->_sock;
+}
+
+NetSocketPoller *NetSocketPollerPosix::_create_func() {
+	return memnew(NetSocketPollerPosix);
+}
+
+void NetSocketPollerPosix::make_default() {
+	_create = _create_func;
+}
+
+#if defined(NET_POLLER_EPOLL) || defined(NET_POLLER_KQUEUE)
+
+Error NetSocketPollerPosix::_register(const Entry &p_entry, bool p_modify, NetSocket::PollType p_old_type) {
+
+	ERR_FAIL_COND_V(_queue == -1, ERR_UNCONFIGURED);
+
+#if defined(NET_POLLER_EPOLL)
+	struct epoll_event ev;
+	memset(&ev, 0, sizeof(ev));
+	if (p_entry.type != NetSocket::POLL_TYPE_OUT) {
+		ev.events |= EPOLLIN;
+	}
+	if (p_entry.type != NetSocket::POLL_TYPE_IN) {
+		ev.events |= EPOLLOUT;
+	}
+	ev.data.ptr = p_entry.userdata;
+	if (epoll_ctl(_queue, p_modify ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, p_entry.fd, &ev) != 0) {
+		print_verbose("Unable to register socket in epoll, errno: " + itos(errno));
+		return FAILED;
+	}
+#else
+	// kqueue has one filter per direction, drop the ones no longer wanted.
+	struct kevent changes[4];
+	int count = 0;
+	bool want_in = p_entry.type != NetSocket::POLL_TYPE_OUT;
+	bool want_out = p_entry.type != NetSocket::POLL_TYPE_IN;
+	if (p_modify) {
+		if (p_old_type != NetSocket::POLL_TYPE_OUT && !want_in) {
+			EV_SET(&changes[count++], p_entry.fd, EVFILT_READ, EV_DELETE, 0, 0, NULL);
+		}
+		if (p_old_type != NetSocket::POLL_TYPE_IN && !want_out) {
+			EV_SET(&changes[count++], p_entry.fd, EVFILT_WRITE, EV_DELETE, 0, 0, NULL);
+		}
+	}
+	if (want_in) {
+		EV_SET(&changes[count++], p_entry.fd, EVFILT_READ, EV_ADD, 0, 0, p_entry.userdata);
+	}
+	if (want_out) {
+		EV_SET(&changes[count++], p_entry.fd, EVFILT_WRITE, EV_ADD, 0, 0, p_entry.userdata);
+	}
+	if (kevent(_queue, changes, count, NULL, 0, NULL) == -1) {
+		print_verbose("Unable to register socket in kqueue, errno: " + itos(errno));
+		return FAILED;
+	}
+#endif
+	return OK;
+}
+
+#else
+
+static _FORCE_INLINE_ short _get_poll_events(NetSocket::PollType p_type) {
+
+	switch (p_type) {
+		case NetSocket::POLL_TYPE_IN:
+			return POLLIN;
+		case NetSocket::POLL_TYPE_OUT:
+			return POLLOUT;
+		case NetSocket::POLL_TYPE_IN_OUT:
+			return POLLIN | POLLOUT;
+	}
+	return 0;
+}
+
+#endif
+
+Error NetSocketPollerPosix::add_socket(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type, void *p_userdata) {
+
+	ERR_FAIL_COND_V(p_socket.is_null() || !p_socket->is_open(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(entries.has(p_socket.ptr()), ERR_ALREADY_EXISTS);
+
+	Entry e;
+	e.fd = _get_fd(p_socket);
+	e.userdata = p_userdata;
+	e.type = p_type;
+	e.index = -1;
+
+#if defined(NET_POLLER_EPOLL) || defined(NET_POLLER_KQUEUE)
+	Error err = _register(e, false, p_type);
+	ERR_FAIL_COND_V(err != OK, err);
+#else
+	e.index = _fds.size();
+	_fds.resize(e.index + 1);
+	_fds.write[e.index].fd = e.fd;
+	_fds.write[e.index].events = _get_poll_events(p_type);
+	_fds.write[e.index].revents = 0;
+	_owners.push_back(p_socket.ptr());
+#endif
+
+	entries[p_socket.ptr()] = e;
+	return OK;
+}
+
+Error NetSocketPollerPosix::modify_socket(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type, void *p_userdata) {
+
+	Map<const NetSocket *, Entry>::Element *E = entries.find(p_socket.ptr());
+	ERR_FAIL_COND_V(!E, ERR_DOES_NOT_EXIST);
+
+	NetSocket::PollType old_type = E->get().type;
+	E->get().type = p_type;
+	E->get().userdata = p_userdata;
+
+#if defined(NET_POLLER_EPOLL) || defined(NET_POLLER_KQUEUE)
+	return _register(E->get(), true, old_type);
+#else
+	_fds.write[E->get().index].events = _get_poll_events(p_type);
+	return OK;
+#endif
+}
+
+void NetSocketPollerPosix::remove_socket(const Ref<NetSocket> &p_socket) {
+
+	Map<const NetSocket *, Entry>::Element *E = entries.find(p_socket.ptr());
+	if (!E) {
+		return;
+	}
+
+#if defined(NET_POLLER_EPOLL) || defined(NET_POLLER_KQUEUE)
+	// A closed socket already left the queue, and its fd might now belong to someone else.
+	const Entry &e = E->get();
+	if (p_socket->is_open() && _get_fd(p_socket) == e.fd) {
+#if defined(NET_POLLER_EPOLL)
+		struct epoll_event ev;
+		memset(&ev, 0, sizeof(ev));
+		epoll_ctl(_queue, EPOLL_CTL_DEL, e.fd, &ev);
+#else
+		struct kevent changes[2];
+		int count = 0;
+		if (e.type != NetSocket::POLL_TYPE_OUT) {
+			EV_SET(&changes[count++], e.fd, EVFILT_READ, EV_DELETE, 0, 0, NULL);
+		}
+		if (e.type != NetSocket::POLL_TYPE_IN) {
+			EV_SET(&changes[count++], e.fd, EVFILT_WRITE, EV_DELETE, 0, 0, NULL);
+		}
+		kevent(_queue, changes, count, NULL, 0, NULL);
+#endif
+	}
+#else
+	// Move the last one into the hole.
+	int idx = E->get().index;
+	int last = _fds.size() - 1;
+	if (idx != last) {
+		_fds.write[idx] = _fds[last];
+		_owners.write[idx] = _owners[last];
+		entries[_owners[idx]].index = idx;
+	}
+	_fds.resize(last);
+	_owners.resize(last);
+#endif
+
+	entries.erase(E);
+}
+
+bool NetSocketPollerPosix::has_socket(const Ref<NetSocket> &p_socket) const {
+	return entries.has(p_socket.ptr());
+}
+
+int NetSocketPollerPosix::get_socket_count() const {
+	return entries.size();
+}
+
+int NetSocketPollerPosix::wait(Event *r_events, int p_max_events, int p_timeout) {
+
+	ERR_FAIL_COND_V(!r_events || p_max_events <= 0, -1);
+
+#if defined(NET_POLLER_EPOLL)
+	ERR_FAIL_COND_V(_queue == -1, -1);
+
+	_buffer.resize(p_max_events * sizeof(struct epoll_event));
+	struct epoll_event *evs = (struct epoll_event *)_buffer.ptrw();
+	int ret = epoll_wait(_queue, evs, p_max_events, p_timeout);
+	if (ret < 0) {
+		return errno == EINTR ? 0 : -1;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		r_events[i].userdata = evs[i].data.ptr;
+		r_events[i].readable = evs[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP);
+		r_events[i].writable = evs[i].events & EPOLLOUT;
+	}
+	return ret;
+
+#elif defined(NET_POLLER_KQUEUE)
+	ERR_FAIL_COND_V(_queue == -1, -1);
+
+	struct timespec ts;
+	struct timespec *tp = NULL;
+	if (p_timeout >= 0) {
+		ts.tv_sec = p_timeout / 1000;
+		ts.tv_nsec = (p_timeout % 1000) * 1000000;
+		tp = &ts;
+	}
+
+	_buffer.resize(p_max_events * sizeof(struct kevent));
+	struct kevent *evs = (struct kevent *)_buffer.ptrw();
+	int ret = kevent(_queue, NULL, 0, evs, p_max_events, tp);
+	if (ret < 0) {
+		return errno == EINTR ? 0 : -1;
+	}
+
+	// A socket waiting on both directions gets one event per filter.
+	for (int i = 0; i < ret; i++) {
+		r_events[i].userdata = evs[i].udata;
+		r_events[i].readable = evs[i].filter == EVFILT_READ || (evs[i].flags & (EV_EOF | EV_ERROR));
+		r_events[i].writable = evs[i].filter == EVFILT_WRITE;
+	}
+	return ret;
+
+#else
+	int size = _fds.size();
+	if (size == 0) {
+		return 0;
+	}
+
+	int ret = SOCK_POLL(_fds.ptrw(), size, p_timeout);
+	if (ret < 0) {
+#if defined(WINDOWS_ENABLED)
+		return -1;
+#else
+		return errno == EINTR ? 0 : -1;
+#endif
+	}
+
+	// Start where the previous call stopped, so sockets at the end are not starved when more are ready than fit.
+	int count = 0;
+	int i = _next % size;
+	for (int n = 0; n < size && ret > 0 && count < p_max_events; n++, i = (i + 1) % size) {
+		short revents = _fds[i].revents;
+		if (!revents) {
+			continue;
+		}
+		ret--;
+
+		Event &ev = r_events[count++];
+		ev.userdata = entries[_owners[i]].userdata;
+		ev.readable = revents & (POLLIN | POLLERR | POLLHUP | POLLNVAL);
+		ev.writable = revents & POLLOUT;
+	}
+	_next = i;
+	return count;
+#endif
+}
+
+NetSocketPollerPosix::NetSocketPollerPosix() {
+
+#if defined(NET_POLLER_EPOLL)
+	_queue = epoll_create(64); // Size is only a hint.
+	ERR_FAIL_COND_MSG(_queue == -1, "Unable to create epoll instance.");
+#elif defined(NET_POLLER_KQUEUE)
+	_queue = kqueue();
+	ERR_FAIL_COND_MSG(_queue == -1, "Unable to create kqueue.");
+#else
+	_next = 0;
+#endif
+}
+
+NetSocketPollerPosix::~NetSocketPollerPosix() {
+
+#if defined(NET_POLLER_EPOLL) || defined(NET_POLLER_KQUEUE)
+	if (_queue != -1) {
+		::close(_queue);
+	}
+#endif
+}
 #endif
@@ -32,6 +32,7 @@
 #define NET_SOCKET_UNIX_H
 
 #include "core/io/net_socket.h"
+#include "core/map.h"
 
 #if defined(WINDOWS_ENABLED)
 #include <winsock2.h>
@@ -44,8 +45,22 @@
 
 #endif
 
+#if defined(__linux__) && !defined(ANDROID_ENABLED)
+#define NET_SOCKET_MMSG
+#endif
+
+#if defined(__linux__)
+#define NET_POLLER_EPOLL
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__DragonFly__)
+#define NET_POLLER_KQUEUE
+#elif !defined(WINDOWS_ENABLED)
+#include <poll.h>
+#endif
+
 class NetSocketPosix : public NetSocket {
 
+	friend class NetSocketPollerPosix;
+
 private:
 	SOCKET_TYPE _sock;
 	IP::Type _ip_type;
@@ -85,6 +100,11 @@ public:
 	virtual Error send(const uint8_t *p_buffer, int p_len, int &r_sent);
 	virtual Error sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IP_Address p_ip, uint16_t p_port);
 	virtual Ref<NetSocket> accept(IP_Address &r_ip, uint16_t &r_port);
+#ifdef NET_SOCKET_MMSG
+	virtual Error recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_count);
+	virtual Error sendto_batch(const Datagram *p_datagrams, int p_count, int &r_count);
+	virtual bool has_native_batch_io() const { return true; }
+#endif
 
 	virtual bool is_open() const;
 	virtual int get_available_bytes() const;
@@ -102,4 +122,51 @@ public:
 	~NetSocketPosix();
 };
 
+// epoll on Linux, kqueue on macOS and the BSDs, WSAPoll on Windows and poll() elsewhere.
+class NetSocketPollerPosix : public NetSocketPoller {
+
+private:
+	struct Entry {
+		SOCKET_TYPE fd;
+		void *userdata;
+		NetSocket::PollType type;
+		int index;
+	};
+
+	Map<const NetSocket *, Entry> entries;
+
+#if defined(NET_POLLER_EPOLL) || defined(NET_POLLER_KQUEUE)
+	int _queue;
+	Vector<uint8_t> _buffer;
+
+	Error _register(const Entry &p_entry, bool p_modify, NetSocket::PollType p_old_type);
+#else
+#if defined(WINDOWS_ENABLED)
+	Vector<WSAPOLLFD> _fds;
+#else
+	Vector<struct pollfd> _fds;
+#endif
+	Vector<const NetSocket *> _owners;
+	int _next;
+#endif
+
+	static SOCKET_TYPE _get_fd(const Ref<NetSocket> &p_socket);
+
+protected:
+	static NetSocketPoller *_create_func();
+
+public:
+	static void make_default();
+
+	virtual Error add_socket(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type, void *p_userdata);
+	virtual Error modify_socket(const Ref<NetSocket> &p_socket, NetSocket::PollType p_type, void *p_userdata);
+	virtual void remove_socket(const Ref<NetSocket> &p_socket);
+	virtual bool has_socket(const Ref<NetSocket> &p_socket) const;
+	virtual int get_socket_count() const;
+	virtual int wait(Event *r_events, int p_max_events, int p_timeout);
+
+	NetSocketPollerPosix();
+	~NetSocketPollerPosix();
+};
+
 #endif
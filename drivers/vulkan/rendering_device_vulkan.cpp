@@ -30,6 +30,8 @@
 
 #include "rendering_device_vulkan.h"
 #include "core/hashfuncs.h"
+#include "core/io/marshalls.h"
+#include "core/os/dir_access.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
@@ -1242,6 +1244,14 @@ Error RenderingDeviceVulkan::_buffer_allocate(Buffer *p_buffer, uint32_t p_size,
 	bufferInfo.queueFamilyIndexCount = 0;
 	bufferInfo.pQueueFamilyIndices = 0;
 
+	uint32_t queue_families[2] = { context->get_graphics_queue(), context->get_transfer_queue() };
+	if (context->has_separate_transfer_queue()) {
+		//async uploads write buffers from the transfer queue, share them instead of transferring ownership back and forth
+		bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+		bufferInfo.queueFamilyIndexCount = 2;
+		bufferInfo.pQueueFamilyIndices = queue_families;
+	}
+
 	VmaAllocationCreateInfo allocInfo;
 	allocInfo.flags = 0;
 	allocInfo.usage = p_mapping;
@@ -4629,6 +4639,33 @@ bool RenderingDeviceVulkan::uniform_set_is_valid(RID p_uniform_set) {
 	return uniform_set_owner.owns(p_uniform_set);
 }
 
+RenderingDeviceVulkan::Buffer *RenderingDeviceVulkan::_get_buffer_from_rid(RID p_buffer, VkPipelineStageFlags &r_stage_mask, VkAccessFlags &r_access) {
+
+	if (vertex_buffer_owner.owns(p_buffer)) {
+		r_stage_mask = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+		r_access = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+		return vertex_buffer_owner.getornull(p_buffer);
+	} else if (index_buffer_owner.owns(p_buffer)) {
+		r_stage_mask = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+		r_access = VK_ACCESS_INDEX_READ_BIT;
+		return index_buffer_owner.getornull(p_buffer);
+	} else if (uniform_buffer_owner.owns(p_buffer)) {
+		r_stage_mask = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		r_access = VK_ACCESS_UNIFORM_READ_BIT;
+		return uniform_buffer_owner.getornull(p_buffer);
+	} else if (texture_buffer_owner.owns(p_buffer)) {
+		r_stage_mask = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		r_access = VK_ACCESS_SHADER_READ_BIT;
+		return &texture_buffer_owner.getornull(p_buffer)->buffer;
+	} else if (storage_buffer_owner.owns(p_buffer)) {
+		r_stage_mask = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		r_access = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+		return storage_buffer_owner.getornull(p_buffer);
+	}
+
+	return NULL;
+}
+
 Error RenderingDeviceVulkan::buffer_update(RID p_buffer, uint32_t p_offset, uint32_t p_size, const void *p_data, bool p_sync_with_draw) {
 	_THREAD_SAFE_METHOD_
 
@@ -4638,30 +4675,8 @@ Error RenderingDeviceVulkan::buffer_update(RID p_buffer, uint32_t p_offset, uint
 	VkPipelineStageFlags dst_stage_mask;
 	VkAccessFlags dst_access;
 
-	Buffer *buffer = NULL;
-	if (vertex_buffer_owner.owns(p_buffer)) {
-		dst_stage_mask = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
-		dst_access = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
-		buffer = vertex_buffer_owner.getornull(p_buffer);
-	} else if (index_buffer_owner.owns(p_buffer)) {
-		dst_stage_mask = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
-		dst_access = VK_ACCESS_INDEX_READ_BIT;
-		buffer = index_buffer_owner.getornull(p_buffer);
-	} else if (uniform_buffer_owner.owns(p_buffer)) {
-		dst_stage_mask = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-		dst_access = VK_ACCESS_UNIFORM_READ_BIT;
-		buffer = uniform_buffer_owner.getornull(p_buffer);
-	} else if (texture_buffer_owner.owns(p_buffer)) {
-		dst_stage_mask = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-		dst_access = VK_ACCESS_SHADER_READ_BIT;
-		buffer = &texture_buffer_owner.getornull(p_buffer)->buffer;
-	} else if (storage_buffer_owner.owns(p_buffer)) {
-		dst_stage_mask = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-		dst_access = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
-		buffer = storage_buffer_owner.getornull(p_buffer);
-	} else {
-		ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Buffer argument is not a valid buffer of any type.");
-	}
+	Buffer *buffer = _get_buffer_from_rid(p_buffer, dst_stage_mask, dst_access);
+	ERR_FAIL_COND_V_MSG(!buffer, ERR_INVALID_PARAMETER, "Buffer argument is not a valid buffer of any type.");
 
 	ERR_FAIL_COND_V_MSG(p_offset + p_size > buffer->size, ERR_INVALID_PARAMETER,
 			"Attempted to write buffer (" + itos((p_offset + p_size) - buffer->size) + " bytes) past the end.");
@@ -4727,6 +4742,538 @@ Vector<uint8_t> RenderingDeviceVulkan::buffer_get_data(RID p_buffer) {
 	return buffer_data;
 }
 
+/**************************/
+/**** READBACK BUFFERS ****/
+/**************************/
+
+RID RenderingDeviceVulkan::readback_buffer_create(uint32_t p_size_bytes) {
+
+	_THREAD_SAFE_METHOD_
+
+	ERR_FAIL_COND_V(p_size_bytes == 0, RID());
+
+	ReadbackBuffer readback;
+	readback.size = p_size_bytes;
+	readback.buffers.resize(frame_count);
+	readback.frames_written.resize(frame_count);
+
+	for (int i = 0; i < frame_count; i++) {
+		Error err = _buffer_allocate(&readback.buffers.write[i], p_size_bytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU);
+		if (err != OK) {
+			for (int j = 0; j < i; j++) {
+				_buffer_free(&readback.buffers.write[j]);
+			}
+			ERR_FAIL_V(RID());
+		}
+		readback.frames_written.write[i] = 0;
+	}
+
+	return readback_buffer_owner.make_rid(readback);
+}
+
+Error RenderingDeviceVulkan::buffer_copy_to_readback(RID p_buffer, RID p_readback_buffer) {
+
+	_THREAD_SAFE_METHOD_
+
+	ERR_FAIL_COND_V_MSG(draw_list, ERR_INVALID_PARAMETER,
+			"Copying buffers is forbidden during creation of a draw list");
+	ERR_FAIL_COND_V_MSG(compute_list, ERR_INVALID_PARAMETER,
+			"Copying buffers is forbidden during creation of a compute list");
+
+	Buffer *buffer = NULL;
+	VkPipelineStageFlags src_stage_mask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	VkAccessFlags src_access_mask = VK_ACCESS_SHADER_WRITE_BIT;
+	if (vertex_buffer_owner.owns(p_buffer)) {
+		src_stage_mask = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+		src_access_mask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+		buffer = vertex_buffer_owner.getornull(p_buffer);
+	} else if (storage_buffer_owner.owns(p_buffer)) {
+		buffer = storage_buffer_owner.getornull(p_buffer);
+	} else {
+		ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Buffer argument is not a valid buffer. Only vertex and storage buffers can be copied to a readback buffer.");
+	}
+
+	ReadbackBuffer *readback = readback_buffer_owner.getornull(p_readback_buffer);
+	ERR_FAIL_COND_V(!readback, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(buffer->size > readback->size, ERR_INVALID_PARAMETER,
+			"Readback buffer (" + itos(readback->size) + " bytes) is smaller than the source buffer (" + itos(buffer->size) + " bytes).");
+
+	Buffer *dst = &readback->buffers.write[frame];
+	VkCommandBuffer command_buffer = frames[frame].draw_command_buffer;
+
+	_buffer_memory_barrier(buffer->buffer, 0, buffer->size, src_stage_mask, VK_PIPELINE_STAGE_TRANSFER_BIT, src_access_mask, VK_ACCESS_TRANSFER_READ_BIT, true);
+
+	VkBufferCopy region;
+	region.srcOffset = 0;
+	region.dstOffset = 0;
+	region.size = buffer->size;
+	vkCmdCopyBuffer(command_buffer, buffer->buffer, dst->buffer, 1, &region);
+
+	_buffer_memory_barrier(dst->buffer, 0, buffer->size, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_HOST_READ_BIT, true);
+	//the source may be written again right after, make sure it waits for the copy
+	_buffer_memory_barrier(buffer->buffer, 0, buffer->size, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, true);
+
+	readback->frames_written.write[frame] = Engine::get_singleton()->get_frames_drawn();
+
+	return OK;
+}
+
+Vector<uint8_t> RenderingDeviceVulkan::readback_buffer_get_data(RID p_readback_buffer, uint64_t *r_frame) {
+
+	_THREAD_SAFE_METHOD_
+
+	ReadbackBuffer *readback = readback_buffer_owner.getornull(p_readback_buffer);
+	ERR_FAIL_COND_V(!readback, Vector<uint8_t>());
+
+	//the buffer for the current frame index was last used frame_count frames ago, so the GPU is done with it
+	uint64_t written = readback->frames_written[frame];
+	if (written == 0 || written == Engine::get_singleton()->get_frames_drawn()) {
+		//nothing was copied yet, or the copy was recorded this frame and has not been submitted
+		return Vector<uint8_t>();
+	}
+
+	Buffer *buffer = &readback->buffers.write[frame];
+
+	void *buffer_mem;
+	VkResult vkerr = vmaMapMemory(allocator, buffer->allocation, &buffer_mem);
+	ERR_FAIL_COND_V_MSG(vkerr, Vector<uint8_t>(), "vmaMapMemory failed with error " + itos(vkerr) + ".");
+	vmaInvalidateAllocation(allocator, buffer->allocation, 0, buffer->size);
+
+	Vector<uint8_t> buffer_data;
+	{
+
+		buffer_data.resize(buffer->size);
+		uint8_t *w = buffer_data.ptrw();
+		copymem(w, buffer_mem, buffer->size);
+	}
+
+	vmaUnmapMemory(allocator, buffer->allocation);
+
+	if (r_frame) {
+		*r_frame = written;
+	}
+
+	return buffer_data;
+}
+
+/***********************/
+/**** ASYNC UPLOADS ****/
+/***********************/
+
+uint64_t RenderingDeviceVulkan::buffer_update_async(RID p_buffer, uint32_t p_offset, uint32_t p_size, const void *p_data, const Callable &p_callback) {
+
+	{
+		_THREAD_SAFE_METHOD_
+
+		VkPipelineStageFlags dst_stage_mask;
+		VkAccessFlags dst_access;
+		Buffer *buffer = _get_buffer_from_rid(p_buffer, dst_stage_mask, dst_access);
+		ERR_FAIL_COND_V_MSG(!buffer, 0, "Buffer argument is not a valid buffer of any type.");
+		ERR_FAIL_COND_V_MSG(p_offset + p_size > buffer->size, 0,
+				"Attempted to write buffer (" + itos((p_offset + p_size) - buffer->size) + " bytes) past the end.");
+	}
+
+	ERR_FAIL_COND_V_MSG(p_size > upload_ring_size, 0,
+			"Upload of " + itos(p_size) + " bytes does not fit in the async upload ring, increase 'rendering/vulkan/async_upload/ring_size_mb'.");
+
+	//copy now, the caller can reuse its data as soon as this returns
+	AsyncUpload upload;
+	upload.resource = p_buffer;
+	upload.texture = false;
+	upload.layer = 0;
+	upload.offset = p_offset;
+	upload.data.resize(p_size);
+	copymem(upload.data.ptrw(), p_data, p_size);
+	upload.callback = p_callback;
+
+	MutexLock lock(upload_mutex);
+	upload.id = ++upload_last_id;
+	upload_queue.push_back(upload);
+	return upload.id;
+}
+
+uint64_t RenderingDeviceVulkan::texture_update_async(RID p_texture, uint32_t p_layer, const Vector<uint8_t> &p_data, const Callable &p_callback) {
+
+	uint32_t required_size;
+	uint32_t mipmaps;
+
+	{
+		_THREAD_SAFE_METHOD_
+
+		Texture *texture = texture_owner.getornull(p_texture);
+		ERR_FAIL_COND_V(!texture, 0);
+
+		if (texture->owner != RID()) {
+			p_texture = texture->owner;
+			texture = texture_owner.getornull(texture->owner);
+			ERR_FAIL_COND_V(!texture, 0); //this is a bug
+		}
+
+		ERR_FAIL_COND_V_MSG(!(texture->usage_flags & TEXTURE_USAGE_CAN_UPDATE_BIT), 0,
+				"Texture requires the TEXTURE_USAGE_CAN_UPDATE_BIT in order to be updatable.");
+
+		uint32_t layer_count = texture->layers;
+		if (texture->type == TEXTURE_TYPE_CUBE || texture->type == TEXTURE_TYPE_CUBE_ARRAY) {
+			layer_count *= 6;
+		}
+		ERR_FAIL_COND_V(p_layer >= layer_count, 0);
+
+		required_size = get_image_format_required_size(texture->format, texture->width, texture->height, texture->depth, texture->mipmaps);
+		mipmaps = texture->mipmaps;
+	}
+
+	ERR_FAIL_COND_V_MSG(required_size != (uint32_t)p_data.size(), 0,
+			"Required size for texture update (" + itos(required_size) + ") does not match data supplied size (" + itos(p_data.size()) + ").");
+	//every mipmap is aligned separately in the ring, leave room for it
+	ERR_FAIL_COND_V_MSG(required_size + mipmaps * 64 > upload_ring_size, 0,
+			"Upload of " + itos(required_size) + " bytes does not fit in the async upload ring, increase 'rendering/vulkan/async_upload/ring_size_mb'.");
+
+	AsyncUpload upload;
+	upload.resource = p_texture;
+	upload.texture = true;
+	upload.layer = p_layer;
+	upload.offset = 0;
+	upload.data = p_data;
+	upload.callback = p_callback;
+
+	MutexLock lock(upload_mutex);
+	upload.id = ++upload_last_id;
+	upload_queue.push_back(upload);
+	return upload.id;
+}
+
+bool RenderingDeviceVulkan::upload_is_done(uint64_t p_upload) {
+
+	return p_upload <= upload_done_id;
+}
+
+bool RenderingDeviceVulkan::_upload_ring_allocate(uint32_t p_size, uint32_t p_align, uint32_t &r_offset) {
+
+	uint64_t begin = upload_ring_write;
+	uint32_t offset = begin % upload_ring_size;
+	uint32_t aligned = offset;
+	if (aligned % p_align) {
+		aligned += p_align - (aligned % p_align);
+	}
+
+	if (aligned + p_size > upload_ring_size) {
+		//does not fit until the end, wrap around to the beginning
+		begin += upload_ring_size - offset;
+		aligned = 0;
+	} else {
+		begin += aligned - offset;
+	}
+
+	if (begin + p_size - upload_ring_read > upload_ring_size) {
+		return false; //still in use by batches in flight
+	}
+
+	upload_ring_write = begin + p_size;
+	r_offset = aligned;
+	return true;
+}
+
+void RenderingDeviceVulkan::_upload_texture_barrier(VkCommandBuffer p_command_buffer, Texture *p_texture, uint32_t p_layer, bool p_acquire) {
+
+	//on a separate queue family, the transfer queue releases the ownership and the graphics queue acquires it with the same barrier
+	bool separate_queue = context->has_separate_transfer_queue();
+
+	VkImageMemoryBarrier image_memory_barrier;
+	image_memory_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	image_memory_barrier.pNext = NULL;
+	image_memory_barrier.srcAccessMask = p_acquire ? 0 : VK_ACCESS_TRANSFER_WRITE_BIT;
+	image_memory_barrier.dstAccessMask = (separate_queue && !p_acquire) ? 0 : VK_ACCESS_SHADER_READ_BIT;
+	image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	image_memory_barrier.newLayout = p_texture->layout;
+	image_memory_barrier.srcQueueFamilyIndex = separate_queue ? context->get_transfer_queue() : VK_QUEUE_FAMILY_IGNORED;
+	image_memory_barrier.dstQueueFamilyIndex = separate_queue ? context->get_graphics_queue() : VK_QUEUE_FAMILY_IGNORED;
+	image_memory_barrier.image = p_texture->image;
+	image_memory_barrier.subresourceRange.aspectMask = p_texture->barrier_aspect_mask;
+	image_memory_barrier.subresourceRange.baseMipLevel = 0;
+	image_memory_barrier.subresourceRange.levelCount = p_texture->mipmaps;
+	image_memory_barrier.subresourceRange.baseArrayLayer = p_layer;
+	image_memory_barrier.subresourceRange.layerCount = 1;
+
+	VkPipelineStageFlags src_stage_mask = p_acquire ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT : VK_PIPELINE_STAGE_TRANSFER_BIT;
+	VkPipelineStageFlags dst_stage_mask = (separate_queue && !p_acquire) ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : (VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+
+	vkCmdPipelineBarrier(p_command_buffer, src_stage_mask, dst_stage_mask, 0, 0, NULL, 0, NULL, 1, &image_memory_barrier);
+}
+
+Error RenderingDeviceVulkan::_upload_record(VkCommandBuffer p_command_buffer, AsyncUpload &p_upload) {
+
+	const uint8_t *r = p_upload.data.ptr();
+
+	if (!p_upload.texture) {
+
+		VkPipelineStageFlags dst_stage_mask;
+		VkAccessFlags dst_access;
+		Buffer *buffer = _get_buffer_from_rid(p_upload.resource, dst_stage_mask, dst_access);
+		if (!buffer || p_upload.offset + p_upload.data.size() > buffer->size) {
+			return ERR_INVALID_PARAMETER; //freed since it was queued
+		}
+
+		uint32_t ring_offset;
+		if (!_upload_ring_allocate(p_upload.data.size(), 4, ring_offset)) {
+			return ERR_BUSY;
+		}
+		copymem(upload_ring_ptr + ring_offset, r, p_upload.data.size());
+
+		VkBufferCopy region;
+		region.srcOffset = ring_offset;
+		region.dstOffset = p_upload.offset;
+		region.size = p_upload.data.size();
+		vkCmdCopyBuffer(p_command_buffer, upload_ring_buffer, buffer->buffer, 1, &region);
+
+		if (!context->has_separate_transfer_queue()) {
+			//same queue as the frames, a barrier makes the copy visible to them (otherwise, the batch semaphore does)
+			VkBufferMemoryBarrier buffer_mem_barrier;
+			buffer_mem_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			buffer_mem_barrier.pNext = NULL;
+			buffer_mem_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			buffer_mem_barrier.dstAccessMask = dst_access;
+			buffer_mem_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			buffer_mem_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			buffer_mem_barrier.buffer = buffer->buffer;
+			buffer_mem_barrier.offset = p_upload.offset;
+			buffer_mem_barrier.size = p_upload.data.size();
+			vkCmdPipelineBarrier(p_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dst_stage_mask, 0, 0, NULL, 1, &buffer_mem_barrier, 0, NULL);
+		}
+
+		return OK;
+	}
+
+	Texture *texture = texture_owner.getornull(p_upload.resource);
+	if (!texture) {
+		return ERR_INVALID_PARAMETER; //freed since it was queued
+	}
+
+	uint32_t required_align = get_compressed_image_format_block_byte_size(texture->format);
+	if (required_align == 1) {
+		required_align = get_image_format_pixel_size(texture->format);
+	}
+	if ((required_align % 4) != 0) { //alignment rules are really strange
+		required_align *= 4;
+	}
+
+	//the whole layer is written, so every mipmap goes to the ring in a single region
+	uint64_t ring_write = upload_ring_write;
+	Vector<VkBufferImageCopy> copies;
+	copies.resize(texture->mipmaps);
+
+	uint32_t mipmap_offset = 0;
+	for (uint32_t mm_i = 0; mm_i < texture->mipmaps; mm_i++) {
+
+		uint32_t width, height, depth;
+		uint32_t image_total = get_image_format_required_size(texture->format, texture->width, texture->height, texture->depth, mm_i + 1, &width, &height, &depth);
+		uint32_t image_size = image_total - mipmap_offset;
+
+		uint32_t ring_offset;
+		if (!_upload_ring_allocate(image_size, required_align, ring_offset)) {
+			upload_ring_write = ring_write; //nothing was recorded, give back what was taken
+			return ERR_BUSY;
+		}
+		copymem(upload_ring_ptr + ring_offset, r + mipmap_offset, image_size);
+
+		VkBufferImageCopy &buffer_image_copy = copies.write[mm_i];
+		buffer_image_copy.bufferOffset = ring_offset;
+		buffer_image_copy.bufferRowLength = 0; //tigthly packed
+		buffer_image_copy.bufferImageHeight = 0; //tigthly packed
+		buffer_image_copy.imageSubresource.aspectMask = texture->read_aspect_mask;
+		buffer_image_copy.imageSubresource.mipLevel = mm_i;
+		buffer_image_copy.imageSubresource.baseArrayLayer = p_upload.layer;
+		buffer_image_copy.imageSubresource.layerCount = 1;
+		buffer_image_copy.imageOffset.x = 0;
+		buffer_image_copy.imageOffset.y = 0;
+		buffer_image_copy.imageOffset.z = 0;
+		buffer_image_copy.imageExtent.width = MAX(1u, texture->width >> mm_i); //block padding is implied for compressed formats
+		buffer_image_copy.imageExtent.height = MAX(1u, texture->height >> mm_i);
+		buffer_image_copy.imageExtent.depth = depth;
+
+		mipmap_offset = image_total;
+	}
+
+	//previous contents are discarded, so there is no need to transfer ownership to the transfer queue first
+	{
+		VkImageMemoryBarrier image_memory_barrier;
+		image_memory_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		image_memory_barrier.pNext = NULL;
+		image_memory_barrier.srcAccessMask = 0;
+		image_memory_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		image_memory_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		image_memory_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		image_memory_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		image_memory_barrier.image = texture->image;
+		image_memory_barrier.subresourceRange.aspectMask = texture->barrier_aspect_mask;
+		image_memory_barrier.subresourceRange.baseMipLevel = 0;
+		image_memory_barrier.subresourceRange.levelCount = texture->mipmaps;
+		image_memory_barrier.subresourceRange.baseArrayLayer = p_upload.layer;
+		image_memory_barrier.subresourceRange.layerCount = 1;
+
+		vkCmdPipelineBarrier(p_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, NULL, 0, NULL, 1, &image_memory_barrier);
+	}
+
+	vkCmdCopyBufferToImage(p_command_buffer, upload_ring_buffer, texture->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, copies.size(), copies.ptr());
+
+	_upload_texture_barrier(p_command_buffer, texture, p_upload.layer, false);
+
+	return OK;
+}
+
+void RenderingDeviceVulkan::_process_async_uploads() {
+
+	bool separate_queue = context->has_separate_transfer_queue();
+	List<Callable> callbacks;
+
+	//retire finished batches, they finish in the same order they were submitted
+	while (upload_batches[upload_batch_current].state == UploadBatch::STATE_SUBMITTED) {
+
+		UploadBatch &batch = upload_batches.write[upload_batch_current];
+		if (vkGetFenceStatus(device, batch.fence) != VK_SUCCESS) {
+			break;
+		}
+
+		if (separate_queue) {
+			for (List<AsyncUpload>::Element *E = batch.uploads.front(); E; E = E->next()) {
+				Texture *texture = E->get().texture ? texture_owner.getornull(E->get().resource) : NULL;
+				if (texture) {
+					_upload_texture_barrier(frames[frame].setup_command_buffer, texture, E->get().layer, true);
+				}
+			}
+			context->append_wait_semaphore(batch.semaphore, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+		}
+
+		for (List<AsyncUpload>::Element *E = batch.uploads.front(); E; E = E->next()) {
+			if (E->get().resource.is_valid() && !E->get().callback.is_null()) {
+				callbacks.push_back(E->get().callback);
+			}
+			upload_done_id = E->get().id;
+		}
+
+		batch.uploads.clear();
+		upload_ring_read = batch.ring_end;
+		batch.frame_released = frames_drawn;
+		batch.state = UploadBatch::STATE_RELEASED;
+		upload_batch_current = (upload_batch_current + 1) % upload_batches.size();
+	}
+
+	if (upload_batches[upload_batch_current].state != UploadBatch::STATE_SUBMITTED) {
+		//nothing in flight, start again from the beginning so the whole ring is available
+		upload_ring_read = 0;
+		upload_ring_write = 0;
+	}
+
+	//batches can be reused once the frame that waited for their semaphore is done
+	for (int i = 0; i < upload_batches.size(); i++) {
+		if (upload_batches[i].state == UploadBatch::STATE_RELEASED && upload_batches[i].frame_released + frame_count <= frames_drawn) {
+			upload_batches.write[i].state = UploadBatch::STATE_FREE;
+		}
+	}
+
+	//record as many queued uploads as the frame budget allows
+	int batch_index = upload_batch_current;
+	while (upload_batches[batch_index].state == UploadBatch::STATE_SUBMITTED) {
+		batch_index = (batch_index + 1) % upload_batches.size();
+		if (batch_index == upload_batch_current) {
+			break;
+		}
+	}
+
+	UploadBatch &batch = upload_batches.write[batch_index];
+	bool recording = false;
+	uint64_t ring_start = upload_ring_write;
+
+	if (batch.state == UploadBatch::STATE_FREE) {
+
+		uint32_t budget_used = 0;
+
+		while (true) {
+
+			//only this thread pops, so the front element stays valid while other threads push
+			upload_mutex.lock();
+			List<AsyncUpload>::Element *E = upload_queue.front();
+			upload_mutex.unlock();
+
+			if (!E) {
+				break;
+			}
+
+			AsyncUpload &upload = E->get();
+			uint32_t size = upload.data.size();
+			if (budget_used > 0 && budget_used + size > upload_frame_budget) {
+				break; //the first one always goes, so uploads larger than the budget still happen
+			}
+
+			if (!recording) {
+				VkCommandBufferBeginInfo cmdbuf_begin;
+				cmdbuf_begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+				cmdbuf_begin.pNext = NULL;
+				cmdbuf_begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+				cmdbuf_begin.pInheritanceInfo = NULL;
+
+				VkResult err = vkResetCommandBuffer(batch.command_buffer, 0);
+				ERR_FAIL_COND_MSG(err, "vkResetCommandBuffer failed with error " + itos(err) + ".");
+				err = vkBeginCommandBuffer(batch.command_buffer, &cmdbuf_begin);
+				ERR_FAIL_COND_MSG(err, "vkBeginCommandBuffer failed with error " + itos(err) + ".");
+				recording = true;
+			}
+
+			Error err = _upload_record(batch.command_buffer, upload);
+			if (err == ERR_BUSY) {
+				break; //ring is full, wait for batches in flight to finish
+			}
+
+			if (err != OK) {
+				upload.resource = RID(); //dropped, but still goes through the batch so it's reported as done
+			}
+			upload.data = Vector<uint8_t>();
+			batch.uploads.push_back(upload);
+			budget_used += size;
+
+			upload_mutex.lock();
+			upload_queue.pop_front();
+			upload_mutex.unlock();
+		}
+	}
+
+	if (recording) {
+
+		vkEndCommandBuffer(batch.command_buffer);
+
+		VkSubmitInfo submit_info;
+		submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submit_info.pNext = NULL;
+		submit_info.pWaitDstStageMask = NULL;
+		submit_info.waitSemaphoreCount = 0;
+		submit_info.pWaitSemaphores = NULL;
+		submit_info.commandBufferCount = 1;
+		submit_info.pCommandBuffers = &batch.command_buffer;
+		submit_info.signalSemaphoreCount = separate_queue ? 1 : 0;
+		submit_info.pSignalSemaphores = &batch.semaphore;
+
+		vkResetFences(device, 1, &batch.fence);
+		VkResult err = vkQueueSubmit(context->get_transfer_queue_handle(), 1, &submit_info, batch.fence);
+		if (err) {
+			ERR_PRINT("vkQueueSubmit failed with error " + itos(err) + ".");
+			batch.uploads.clear();
+			upload_ring_write = ring_start;
+		} else {
+			batch.ring_end = upload_ring_write;
+			batch.state = UploadBatch::STATE_SUBMITTED;
+		}
+	}
+
+	for (List<Callable>::Element *E = callbacks.front(); E; E = E->next()) {
+		Variant ret;
+		Callable::CallError ce;
+		E->get().call(NULL, 0, ret, ce);
+		if (ce.error != Callable::CallError::CALL_OK) {
+			ERR_PRINT("Error calling async upload callback: " + Variant::get_callable_error_text(E->get(), NULL, 0, ce));
+		}
+	}
+}
+
 /*************************/
 /**** RENDER PIPELINE ****/
 /*************************/
@@ -5052,8 +5599,9 @@ RID RenderingDeviceVulkan::render_pipeline_create(RID p_shader, FramebufferForma
 	graphics_pipeline_create_info.basePipelineIndex = 0;
 
 	RenderPipeline pipeline;
-	VkResult err = vkCreateGraphicsPipelines(device, NULL, 1, &graphics_pipeline_create_info, NULL, &pipeline.pipeline);
+	VkResult err = vkCreateGraphicsPipelines(device, pipeline_cache, 1, &graphics_pipeline_create_info, NULL, &pipeline.pipeline);
 	ERR_FAIL_COND_V_MSG(err, RID(), "vkCreateGraphicsPipelines failed with error " + itos(err) + ".");
+	pipeline_cache_dirty = true;
 
 	pipeline.set_formats = shader->set_formats;
 	pipeline.push_constant_stages = shader->push_constant.push_constants_vk_stage;
@@ -5125,8 +5673,9 @@ RID RenderingDeviceVulkan::compute_pipeline_create(RID p_shader) {
 	compute_pipeline_create_info.basePipelineIndex = 0;
 
 	ComputePipeline pipeline;
-	VkResult err = vkCreateComputePipelines(device, NULL, 1, &compute_pipeline_create_info, NULL, &pipeline.pipeline);
+	VkResult err = vkCreateComputePipelines(device, pipeline_cache, 1, &compute_pipeline_create_info, NULL, &pipeline.pipeline);
 	ERR_FAIL_COND_V_MSG(err, RID(), "vkCreateComputePipelines failed with error " + itos(err) + ".");
+	pipeline_cache_dirty = true;
 
 	pipeline.set_formats = shader->set_formats;
 	pipeline.push_constant_stages = shader->push_constant.push_constants_vk_stage;
@@ -5495,6 +6044,9 @@ Error RenderingDeviceVulkan::draw_list_begin_split(RID p_framebuffer, uint32_t p
 
 	_THREAD_SAFE_METHOD_
 
+	ERR_FAIL_COND_V_MSG(draw_list != NULL, ERR_BUSY, "Only one draw list can be active at the same time.");
+	ERR_FAIL_COND_V_MSG(compute_list != NULL, ERR_BUSY, "Only one draw/compute list can be active at the same time.");
+
 	ERR_FAIL_COND_V(p_splits < 1, ERR_INVALID_DECLARATION);
 
 	Framebuffer *framebuffer = framebuffer_owner.getornull(p_framebuffer);
@@ -5535,10 +6087,11 @@ Error RenderingDeviceVulkan::draw_list_begin_split(RID p_framebuffer, uint32_t p
 				"Clear color values supplied (" + itos(p_clear_color_values.size()) + ") differ from the amount required for framebuffer (" + itos(color_attachments) + ").");
 	}
 
-	if (p_splits > (uint32_t)split_draw_list_allocators.size()) {
+	uint32_t allocators_needed = split_draw_list_allocators_used + p_splits;
+	if (allocators_needed > (uint32_t)split_draw_list_allocators.size()) {
 		uint32_t from = split_draw_list_allocators.size();
-		split_draw_list_allocators.resize(p_splits);
-		for (uint32_t i = from; i < p_splits; i++) {
+		split_draw_list_allocators.resize(allocators_needed);
+		for (uint32_t i = from; i < allocators_needed; i++) {
 
 			VkCommandPoolCreateInfo cmd_pool_info;
 			cmd_pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
@@ -5586,10 +6139,13 @@ Error RenderingDeviceVulkan::draw_list_begin_split(RID p_framebuffer, uint32_t p
 	draw_list_count = p_splits;
 	draw_list_split = true;
 
+	uint32_t allocator_base = split_draw_list_allocators_used;
+	split_draw_list_allocators_used += p_splits;
+
 	for (uint32_t i = 0; i < p_splits; i++) {
 
 		//take a command buffer and initialize it
-		VkCommandBuffer command_buffer = split_draw_list_allocators[p_splits].command_buffers[frame];
+		VkCommandBuffer command_buffer = split_draw_list_allocators[allocator_base + i].command_buffers[frame];
 
 		VkCommandBufferInheritanceInfo inheritance_info;
 		inheritance_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
@@ -5647,7 +6203,7 @@ Error RenderingDeviceVulkan::draw_list_begin_split(RID p_framebuffer, uint32_t p
 		scissor.extent.height = viewport_size.height;
 
 		vkCmdSetScissor(command_buffer, 0, 1, &scissor);
-		r_split_ids[i] = (DrawListID(1) << DrawListID(ID_TYPE_SPLIT_DRAW_LIST)) + i;
+		r_split_ids[i] = (DrawListID(ID_TYPE_SPLIT_DRAW_LIST) << DrawListID(ID_BASE_SHIFT)) + i;
 
 		draw_list[i].viewport = Rect2i(viewport_offset, viewport_size);
 	}
@@ -6039,8 +6595,8 @@ void RenderingDeviceVulkan::draw_list_end() {
 		//send all command buffers
 		VkCommandBuffer *command_buffers = (VkCommandBuffer *)alloca(sizeof(VkCommandBuffer) * draw_list_count);
 		for (uint32_t i = 0; i < draw_list_count; i++) {
-			vkEndCommandBuffer(draw_list->command_buffer);
-			command_buffers[i] = draw_list->command_buffer;
+			vkEndCommandBuffer(draw_list[i].command_buffer);
+			command_buffers[i] = draw_list[i].command_buffer;
 		}
 
 		vkCmdExecuteCommands(frames[frame].draw_command_buffer, draw_list_count, command_buffers);
@@ -6488,6 +7044,12 @@ void RenderingDeviceVulkan::_free_internal(RID p_id) {
 		Buffer *storage_buffer = storage_buffer_owner.getornull(p_id);
 		frames[frame].buffers_to_dispose_of.push_back(*storage_buffer);
 		storage_buffer_owner.free(p_id);
+	} else if (readback_buffer_owner.owns(p_id)) {
+		ReadbackBuffer *readback = readback_buffer_owner.getornull(p_id);
+		for (int i = 0; i < readback->buffers.size(); i++) {
+			frames[frame].buffers_to_dispose_of.push_back(readback->buffers[i]);
+		}
+		readback_buffer_owner.free(p_id);
 	} else if (uniform_set_owner.owns(p_id)) {
 		UniformSet *uniform_set = uniform_set_owner.getornull(p_id);
 		frames[frame].uniform_sets_to_dispose_of.push_back(*uniform_set);
@@ -6538,6 +7100,7 @@ void RenderingDeviceVulkan::swap_buffers() {
 	{ //advance frame
 
 		frame = (frame + 1) % frame_count;
+		split_draw_list_allocators_used = 0;
 
 		//erase pending resources
 		_free_pending_resources(frame);
@@ -6570,6 +7133,9 @@ void RenderingDeviceVulkan::swap_buffers() {
 			staging_buffer_used = false;
 		}
 
+		//retire and submit async uploads, now that the setup buffer can take their ownership barriers
+		_process_async_uploads();
+
 		if (frames[frame].timestamp_count) {
 			vkGetQueryPoolResults(device, frames[frame].timestamp_pool, 0, frames[frame].timestamp_count, sizeof(uint64_t) * max_timestamp_query_elements, frames[frame].timestamp_result_values, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
 			SWAP(frames[frame].timestamp_names, frames[frame].timestamp_result_names);
@@ -6848,6 +7414,89 @@ void RenderingDeviceVulkan::initialize(VulkanContext *p_context) {
 		ERR_CONTINUE(err != OK);
 	}
 
+	{ //async uploads
+
+		upload_ring_size = GLOBAL_DEF("rendering/vulkan/async_upload/ring_size_mb", 32);
+		upload_ring_size = MAX(1, upload_ring_size);
+		upload_ring_size *= 1024 * 1024;
+		upload_frame_budget = GLOBAL_DEF("rendering/vulkan/async_upload/frame_budget_kb", 4096);
+		upload_frame_budget = MAX(64, upload_frame_budget);
+		upload_frame_budget *= 1024;
+
+		upload_last_id = 0;
+		upload_done_id = 0;
+		upload_ring_write = 0;
+		upload_ring_read = 0;
+		upload_batch_current = 0;
+
+		VkBufferCreateInfo bufferInfo;
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.pNext = NULL;
+		bufferInfo.flags = 0;
+		bufferInfo.size = upload_ring_size;
+		bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+		bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE; //only the transfer queue reads it
+		bufferInfo.queueFamilyIndexCount = 0;
+		bufferInfo.pQueueFamilyIndices = NULL;
+
+		VmaAllocationCreateInfo allocInfo;
+		allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT; //stays mapped
+		allocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+		allocInfo.requiredFlags = 0;
+		allocInfo.preferredFlags = 0;
+		allocInfo.memoryTypeBits = 0;
+		allocInfo.pool = NULL;
+		allocInfo.pUserData = NULL;
+
+		VmaAllocationInfo alloc_info;
+		VkResult err = vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &upload_ring_buffer, &upload_ring_allocation, &alloc_info);
+		ERR_FAIL_COND_MSG(err, "Can't create async upload ring of size: " + itos(upload_ring_size) + ", error " + itos(err) + ".");
+		upload_ring_ptr = (uint8_t *)alloc_info.pMappedData;
+
+		VkCommandPoolCreateInfo cmd_pool_info;
+		cmd_pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		cmd_pool_info.pNext = NULL;
+		cmd_pool_info.queueFamilyIndex = p_context->get_transfer_queue();
+		cmd_pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+
+		err = vkCreateCommandPool(device, &cmd_pool_info, NULL, &upload_command_pool);
+		ERR_FAIL_COND_MSG(err, "vkCreateCommandPool failed with error " + itos(err) + ".");
+
+		//enough to keep uploading while previous batches are in flight
+		upload_batches.resize(frame_count * 2);
+		for (int i = 0; i < upload_batches.size(); i++) {
+			UploadBatch &batch = upload_batches.write[i];
+
+			VkCommandBufferAllocateInfo cmdbuf;
+			cmdbuf.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			cmdbuf.pNext = NULL;
+			cmdbuf.commandPool = upload_command_pool;
+			cmdbuf.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			cmdbuf.commandBufferCount = 1;
+
+			err = vkAllocateCommandBuffers(device, &cmdbuf, &batch.command_buffer);
+			ERR_CONTINUE_MSG(err, "vkAllocateCommandBuffers failed with error " + itos(err) + ".");
+
+			VkFenceCreateInfo fence_create_info;
+			fence_create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+			fence_create_info.pNext = NULL;
+			fence_create_info.flags = 0;
+			err = vkCreateFence(device, &fence_create_info, NULL, &batch.fence);
+			ERR_CONTINUE_MSG(err, "vkCreateFence failed with error " + itos(err) + ".");
+
+			VkSemaphoreCreateInfo semaphore_create_info;
+			semaphore_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+			semaphore_create_info.pNext = NULL;
+			semaphore_create_info.flags = 0;
+			err = vkCreateSemaphore(device, &semaphore_create_info, NULL, &batch.semaphore);
+			ERR_CONTINUE_MSG(err, "vkCreateSemaphore failed with error " + itos(err) + ".");
+
+			batch.ring_end = 0;
+			batch.frame_released = 0;
+			batch.state = UploadBatch::STATE_FREE;
+		}
+	}
+
 	max_descriptors_per_pool = GLOBAL_DEF("rendering/vulkan/descriptor_pools/max_descriptors_per_pool", 64);
 
 	//check to make sure DescriptorPoolKey is good
@@ -6858,6 +7507,15 @@ void RenderingDeviceVulkan::initialize(VulkanContext *p_context) {
 	draw_list_split = false;
 
 	compute_list = NULL;
+
+	device_properties = p_context->get_device_properties();
+	pipeline_cache = NULL;
+	pipeline_cache_dirty = false;
+	pipeline_cache_enabled = GLOBAL_DEF("rendering/vulkan/pipeline_cache/enable", true);
+	if (pipeline_cache_enabled) {
+		pipeline_cache_path = OS::get_singleton()->get_user_data_dir().plus_file("vulkan").plus_file("pipelines." + String::num_int64(device_properties.vendorID, 16) + "." + String::num_int64(device_properties.deviceID, 16) + ".cache");
+		_pipeline_cache_load();
+	}
 }
 
 template <class T>
@@ -6984,17 +7642,231 @@ int RenderingDeviceVulkan::limit_get(Limit p_limit) {
 	return 0;
 }
 
+/************************/
+/**** PIPELINE CACHE ****/
+/************************/
+
+#define PIPELINE_CACHE_MAGIC 0x43504447 // "GDPC"
+#define PIPELINE_CACHE_VERSION 1
+
+bool RenderingDeviceVulkan::_pipeline_cache_is_data_valid(const uint8_t *p_data, uint32_t p_size) const {
+
+	// Data starts with the header defined by the Vulkan spec (VkPipelineCacheHeaderVersionOne).
+	const uint32_t vk_header_size = sizeof(uint32_t) * 4 + VK_UUID_SIZE;
+	if (p_size < vk_header_size) {
+		return false;
+	}
+
+	uint32_t header_size = decode_uint32(&p_data[0]);
+	uint32_t header_version = decode_uint32(&p_data[4]);
+	uint32_t vendor_id = decode_uint32(&p_data[8]);
+	uint32_t device_id = decode_uint32(&p_data[12]);
+
+	if (header_size < vk_header_size || header_size > p_size) {
+		return false;
+	}
+	if (header_version != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+		return false;
+	}
+	if (vendor_id != device_properties.vendorID || device_id != device_properties.deviceID) {
+		return false;
+	}
+	if (memcmp(&p_data[16], device_properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+		return false;
+	}
+
+	return true;
+}
+
+void RenderingDeviceVulkan::_pipeline_cache_create(const uint8_t *p_data, uint32_t p_size) {
+
+	VkPipelineCacheCreateInfo cache_create_info;
+	cache_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	cache_create_info.pNext = NULL;
+	cache_create_info.flags = 0;
+	cache_create_info.initialDataSize = p_size;
+	cache_create_info.pInitialData = p_data;
+
+	VkResult err = vkCreatePipelineCache(device, &cache_create_info, NULL, &pipeline_cache);
+	if (err && p_size) {
+		WARN_PRINT("vkCreatePipelineCache failed with error " + itos(err) + ", discarding cached data.");
+		cache_create_info.initialDataSize = 0;
+		cache_create_info.pInitialData = NULL;
+		err = vkCreatePipelineCache(device, &cache_create_info, NULL, &pipeline_cache);
+	}
+	if (err) {
+		ERR_PRINT("vkCreatePipelineCache failed with error " + itos(err) + ".");
+		pipeline_cache = NULL;
+	}
+	pipeline_cache_dirty = false;
+}
+
+void RenderingDeviceVulkan::_pipeline_cache_load() {
+
+	Vector<uint8_t> data;
+
+	FileAccess *f = FileAccess::open(pipeline_cache_path, FileAccess::READ);
+	if (f) {
+		PipelineCacheHeader header;
+		header.magic = f->get_32();
+		header.version = f->get_32();
+		header.vendor_id = f->get_32();
+		header.device_id = f->get_32();
+		header.driver_version = f->get_32();
+		f->get_buffer(header.uuid, VK_UUID_SIZE);
+		header.data_size = f->get_32();
+		header.data_hash = f->get_32();
+
+		bool valid = !f->eof_reached() && header.magic == PIPELINE_CACHE_MAGIC && header.version == PIPELINE_CACHE_VERSION;
+		valid = valid && header.vendor_id == device_properties.vendorID && header.device_id == device_properties.deviceID;
+		valid = valid && header.driver_version == device_properties.driverVersion;
+		valid = valid && memcmp(header.uuid, device_properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+		valid = valid && header.data_size > 0 && header.data_size <= f->get_len() - f->get_position();
+
+		if (valid) {
+			data.resize(header.data_size);
+			uint32_t read = f->get_buffer(data.ptrw(), header.data_size);
+			valid = read == header.data_size && hash_djb2_buffer(data.ptr(), data.size()) == header.data_hash;
+			valid = valid && _pipeline_cache_is_data_valid(data.ptr(), data.size());
+		}
+
+		if (!valid) {
+			print_verbose("Vulkan: Discarding invalid or outdated pipeline cache: " + pipeline_cache_path);
+			data.clear();
+		}
+
+		f->close();
+		memdelete(f);
+	}
+
+	_pipeline_cache_create(data.ptr(), data.size());
+
+	if (data.size()) {
+		print_verbose("Vulkan: Loaded pipeline cache (" + itos(data.size()) + " bytes): " + pipeline_cache_path);
+	}
+}
+
+Vector<uint8_t> RenderingDeviceVulkan::pipeline_cache_get_data() {
+
+	_THREAD_SAFE_METHOD_
+
+	Vector<uint8_t> data;
+	ERR_FAIL_COND_V(!pipeline_cache, data);
+
+	size_t data_size = 0;
+	VkResult err = vkGetPipelineCacheData(device, pipeline_cache, &data_size, NULL);
+	ERR_FAIL_COND_V_MSG(err, data, "vkGetPipelineCacheData failed with error " + itos(err) + ".");
+
+	data.resize(data_size);
+	if (data_size) {
+		err = vkGetPipelineCacheData(device, pipeline_cache, &data_size, data.ptrw());
+		ERR_FAIL_COND_V_MSG(err, Vector<uint8_t>(), "vkGetPipelineCacheData failed with error " + itos(err) + ".");
+		data.resize(data_size);
+	}
+
+	return data;
+}
+
+Error RenderingDeviceVulkan::pipeline_cache_prewarm(const Vector<uint8_t> &p_data) {
+
+	_THREAD_SAFE_METHOD_
+
+	ERR_FAIL_COND_V(!pipeline_cache, ERR_UNAVAILABLE);
+	ERR_FAIL_COND_V_MSG(!_pipeline_cache_is_data_valid(p_data.ptr(), p_data.size()), ERR_INVALID_DATA, "Pipeline cache data was not generated by this device or driver.");
+
+	VkPipelineCacheCreateInfo cache_create_info;
+	cache_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	cache_create_info.pNext = NULL;
+	cache_create_info.flags = 0;
+	cache_create_info.initialDataSize = p_data.size();
+	cache_create_info.pInitialData = p_data.ptr();
+
+	VkPipelineCache src_cache;
+	VkResult err = vkCreatePipelineCache(device, &cache_create_info, NULL, &src_cache);
+	ERR_FAIL_COND_V_MSG(err, ERR_INVALID_DATA, "vkCreatePipelineCache failed with error " + itos(err) + ".");
+
+	err = vkMergePipelineCaches(device, pipeline_cache, 1, &src_cache);
+	vkDestroyPipelineCache(device, src_cache, NULL);
+	ERR_FAIL_COND_V_MSG(err, ERR_CANT_CREATE, "vkMergePipelineCaches failed with error " + itos(err) + ".");
+
+	pipeline_cache_dirty = true;
+	return OK;
+}
+
+Error RenderingDeviceVulkan::pipeline_cache_save() {
+
+	_THREAD_SAFE_METHOD_
+
+	ERR_FAIL_COND_V(!pipeline_cache, ERR_UNAVAILABLE);
+
+	Vector<uint8_t> data = pipeline_cache_get_data();
+	ERR_FAIL_COND_V(data.size() == 0, ERR_CANT_CREATE);
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	da->make_dir_recursive(pipeline_cache_path.get_base_dir());
+	memdelete(da);
+
+	FileAccess *f = FileAccess::open(pipeline_cache_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(!f, ERR_FILE_CANT_WRITE, "Can't open pipeline cache for writing: " + pipeline_cache_path);
+
+	f->store_32(PIPELINE_CACHE_MAGIC);
+	f->store_32(PIPELINE_CACHE_VERSION);
+	f->store_32(device_properties.vendorID);
+	f->store_32(device_properties.deviceID);
+	f->store_32(device_properties.driverVersion);
+	f->store_buffer(device_properties.pipelineCacheUUID, VK_UUID_SIZE);
+	f->store_32(data.size());
+	f->store_32(hash_djb2_buffer(data.ptr(), data.size()));
+	f->store_buffer(data.ptr(), data.size());
+
+	f->close();
+	memdelete(f);
+
+	pipeline_cache_dirty = false;
+	return OK;
+}
+
+void RenderingDeviceVulkan::pipeline_cache_clear() {
+
+	_THREAD_SAFE_METHOD_
+
+	if (!pipeline_cache_enabled) {
+		return;
+	}
+
+	// Pipelines created from the cache remain valid, as they don't reference it.
+	if (pipeline_cache) {
+		vkDestroyPipelineCache(device, pipeline_cache, NULL);
+	}
+	_pipeline_cache_create(NULL, 0);
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	if (da->file_exists(pipeline_cache_path)) {
+		da->remove(pipeline_cache_path);
+	}
+	memdelete(da);
+}
+
 void RenderingDeviceVulkan::finalize() {
 
 	//free all resources
 
 	_flush(false);
 
+	if (pipeline_cache) {
+		if (pipeline_cache_dirty) {
+			pipeline_cache_save();
+		}
+		vkDestroyPipelineCache(device, pipeline_cache, NULL);
+		pipeline_cache = NULL;
+	}
+
 	_free_rids(render_pipeline_owner, "Pipeline");
 	_free_rids(compute_pipeline_owner, "Compute");
 	_free_rids(uniform_set_owner, "UniformSet");
 	_free_rids(texture_buffer_owner, "TextureBuffer");
 	_free_rids(storage_buffer_owner, "StorageBuffer");
+	_free_rids(readback_buffer_owner, "ReadbackBuffer");
 	_free_rids(uniform_buffer_owner, "UniformBuffer");
 	_free_rids(shader_owner, "Shader");
 	_free_rids(index_array_owner, "IndexArray");
@@ -7045,6 +7917,16 @@ void RenderingDeviceVulkan::finalize() {
 
 	memdelete_arr(frames);
 
+	//the flush above waited for the transfer queue too
+	for (int i = 0; i < upload_batches.size(); i++) {
+		vkDestroyFence(device, upload_batches[i].fence, NULL);
+		vkDestroySemaphore(device, upload_batches[i].semaphore, NULL);
+	}
+	upload_batches.clear();
+	upload_queue.clear();
+	vkDestroyCommandPool(device, upload_command_pool, NULL);
+	vmaDestroyBuffer(allocator, upload_ring_buffer, upload_ring_allocation);
+
 	for (int i = 0; i < staging_buffer_blocks.size(); i++) {
 		vmaDestroyBuffer(allocator, staging_buffer_blocks[i].buffer, staging_buffer_blocks[i].allocation);
 	}
@@ -7057,4 +7939,12 @@ void RenderingDeviceVulkan::finalize() {
 
 RenderingDeviceVulkan::RenderingDeviceVulkan() {
 	screen_prepared = false;
+	pipeline_cache = NULL;
+	pipeline_cache_enabled = false;
+	pipeline_cache_dirty = false;
+	upload_ring_buffer = VK_NULL_HANDLE;
+	upload_ring_allocation = NULL;
+	upload_ring_ptr = NULL;
+	upload_ring_size = 0;
+	upload_command_pool = VK_NULL_HANDLE;
 }
@@ -199,6 +199,69 @@ class RenderingDeviceVulkan : public RenderingDevice {
 	Error _staging_buffer_allocate(uint32_t p_amount, uint32_t p_required_align, uint32_t &r_alloc_offset, uint32_t &r_alloc_size, bool p_can_segment = true, bool p_on_draw_command_buffer = false);
 	Error _insert_staging_block();
 
+	/***********************/
+	/**** ASYNC UPLOADS ****/
+	/***********************/
+
+	// Async uploads don't go through the staging blocks above. Any
+	// thread can queue them (the data is kept until processed), and
+	// at the beginning of every frame the rendering thread copies as
+	// many as fit in the frame budget to a persistent ring buffer and
+	// records them in a batch, that is submitted to the transfer queue
+	// (a DMA-only queue family when available, else the graphics queue).
+	//
+	// Batches are polled with their fence: once done, their ring space
+	// is reclaimed and, when using a separate queue family, texture
+	// ownership is acquired in the setup buffer and the batch semaphore
+	// is waited for by the next frame submission. Callbacks are called
+	// afterwards, so the resources can be used from then on.
+
+	struct AsyncUpload {
+		uint64_t id;
+		RID resource;
+		bool texture;
+		uint32_t layer; //textures
+		uint32_t offset; //buffers
+		Vector<uint8_t> data; //released once copied to the ring
+		Callable callback;
+	};
+
+	struct UploadBatch {
+		VkCommandBuffer command_buffer;
+		VkFence fence;
+		VkSemaphore semaphore;
+		List<AsyncUpload> uploads;
+		uint64_t ring_end;
+		uint64_t frame_released; //semaphore waits must be consumed before the batch is reused
+		enum State {
+			STATE_FREE,
+			STATE_SUBMITTED,
+			STATE_RELEASED,
+		};
+		State state;
+	};
+
+	Mutex upload_mutex;
+	List<AsyncUpload> upload_queue; //protected by upload_mutex
+	uint64_t upload_last_id; //protected by upload_mutex
+	volatile uint64_t upload_done_id; //uploads complete in order
+
+	VkCommandPool upload_command_pool;
+	Vector<UploadBatch> upload_batches;
+	int upload_batch_current; //oldest submitted batch
+	VkBuffer upload_ring_buffer;
+	VmaAllocation upload_ring_allocation;
+	uint8_t *upload_ring_ptr;
+	uint32_t upload_ring_size;
+	uint64_t upload_ring_write; //ring positions grow forever, wrap with the size
+	uint64_t upload_ring_read;
+	uint32_t upload_frame_budget;
+
+	bool _upload_ring_allocate(uint32_t p_size, uint32_t p_align, uint32_t &r_offset);
+	Error _upload_record(VkCommandBuffer p_command_buffer, AsyncUpload &p_upload);
+	void _upload_texture_barrier(VkCommandBuffer p_command_buffer, Texture *p_texture, uint32_t p_layer, bool p_acquire);
+	void _process_async_uploads();
+
 	struct Buffer {
 
 		uint32_t size;
@@ -213,6 +276,7 @@ class RenderingDeviceVulkan : public RenderingDevice {
 	};
 
 	Error _buffer_allocate(Buffer *p_buffer, uint32_t p_size, uint32_t p_usage, VmaMemoryUsage p_mapping);
+	Buffer *_get_buffer_from_rid(RID p_buffer, VkPipelineStageFlags &r_stage_mask, VkAccessFlags &r_access); //any buffer type, with how it's read
 	Error _buffer_free(Buffer *p_buffer);
 	Error _buffer_update(Buffer *p_buffer, size_t p_offset, const uint8_t *p_data, size_t p_data_size, bool p_use_draw_command_buffer = false, uint32_t p_required_align = 32);
 
@@ -619,6 +683,16 @@ class RenderingDeviceVulkan : public RenderingDevice {
 
 	RID_Owner<TextureBuffer, true> texture_buffer_owner;
 
+	//readback buffers keep one host visible buffer per frame, and each frame copies into its own one,
+	//so by the time a frame index is processed again its copy is complete and can be mapped
+	struct ReadbackBuffer {
+		uint32_t size;
+		Vector<Buffer> buffers;
+		Vector<uint64_t> frames_written; //0 means nothing was copied yet
+	};
+
+	RID_Owner<ReadbackBuffer, true> readback_buffer_owner;
+
 	// This structure contains the descriptor set. They _need_ to be allocated
 	// for a shader (and will be erased when this shader is erased), but should
 	// work for other shaders as long as the hash matches. This covers using
@@ -713,6 +787,7 @@ class RenderingDeviceVulkan : public RenderingDevice {
 	};
 
 	Vector<SplitDrawListAllocator> split_draw_list_allocators;
+	uint32_t split_draw_list_allocators_used = 0; //every split in a frame needs its own buffers, reset when the frame advances
 
 	struct DrawList {
 
@@ -948,6 +1023,39 @@ class RenderingDeviceVulkan : public RenderingDevice {
 
 	uint32_t max_timestamp_query_elements;
 
+	/************************/
+	/**** PIPELINE CACHE ****/
+	/************************/
+
+	// Pipelines are created through a VkPipelineCache, which is
+	// serialized to the user data dir on exit, so pipelines don't
+	// need to be compiled again by the driver on the next launch.
+	//
+	// The file is prefixed with this header so it can be validated
+	// before handing it to the driver: stale or corrupt caches, or
+	// caches from another device or driver version are discarded.
+
+	struct PipelineCacheHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint32_t vendor_id;
+		uint32_t device_id;
+		uint32_t driver_version;
+		uint8_t uuid[VK_UUID_SIZE];
+		uint32_t data_size;
+		uint32_t data_hash;
+	};
+
+	VkPipelineCache pipeline_cache;
+	bool pipeline_cache_enabled;
+	bool pipeline_cache_dirty;
+	String pipeline_cache_path;
+	VkPhysicalDeviceProperties device_properties;
+
+	bool _pipeline_cache_is_data_valid(const uint8_t *p_data, uint32_t p_size) const;
+	void _pipeline_cache_create(const uint8_t *p_data, uint32_t p_size);
+	void _pipeline_cache_load();
+
 	Frame *frames; //frames available, they are cycled (usually 3)
 	int frame; //current frame
 	int frame_count; //total amount of frames
@@ -1034,6 +1142,14 @@ public:
 	virtual Error buffer_update(RID p_buffer, uint32_t p_offset, uint32_t p_size, const void *p_data, bool p_sync_with_draw = false); //works for any buffer
 	virtual Vector<uint8_t> buffer_get_data(RID p_buffer);
 
+	virtual RID readback_buffer_create(uint32_t p_size_bytes);
+	virtual Error buffer_copy_to_readback(RID p_buffer, RID p_readback_buffer);
+	virtual Vector<uint8_t> readback_buffer_get_data(RID p_readback_buffer, uint64_t *r_frame = nullptr);
+
+	virtual uint64_t buffer_update_async(RID p_buffer, uint32_t p_offset, uint32_t p_size, const void *p_data, const Callable &p_callback = Callable());
+	virtual uint64_t texture_update_async(RID p_texture, uint32_t p_layer, const Vector<uint8_t> &p_data, const Callable &p_callback = Callable());
+	virtual bool upload_is_done(uint64_t p_upload);
+
 	/*************************/
 	/**** RENDER PIPELINE ****/
 	/*************************/
@@ -1115,6 +1231,15 @@ public:
 
 	virtual int limit_get(Limit p_limit);
 
+	/************************/
+	/**** PIPELINE CACHE ****/
+	/************************/
+
+	virtual Vector<uint8_t> pipeline_cache_get_data();
+	virtual Error pipeline_cache_prewarm(const Vector<uint8_t> &p_data);
+	virtual Error pipeline_cache_save();
+	virtual void pipeline_cache_clear();
+
 	virtual void prepare_screen_for_drawing();
 	void initialize(VulkanContext *p_context);
 	void finalize();
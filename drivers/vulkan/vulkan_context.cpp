@@ -509,7 +509,7 @@ Error VulkanContext::_create_device() {
 
 	VkResult err;
 	float queue_priorities[1] = { 0.0 };
-	VkDeviceQueueCreateInfo queues[2];
+	VkDeviceQueueCreateInfo queues[3];
 	queues[0].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
 	queues[0].pNext = NULL;
 	queues[0].queueFamilyIndex = graphics_queue_family_index;
@@ -539,6 +539,16 @@ Error VulkanContext::_create_device() {
 		queues[1].flags = 0;
 		sdevice.queueCreateInfoCount = 2;
 	}
+	if (separate_transfer_queue) {
+		uint32_t idx = sdevice.queueCreateInfoCount;
+		queues[idx].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+		queues[idx].pNext = NULL;
+		queues[idx].queueFamilyIndex = transfer_queue_family_index;
+		queues[idx].queueCount = 1;
+		queues[idx].pQueuePriorities = queue_priorities;
+		queues[idx].flags = 0;
+		sdevice.queueCreateInfoCount = idx + 1;
+	}
 	err = vkCreateDevice(gpu, &sdevice, NULL, &device);
 	ERR_FAIL_COND_V(err, ERR_CANT_CREATE);
 	return OK;
@@ -591,6 +601,18 @@ Error VulkanContext::_initialize_queues(VkSurfaceKHR surface) {
 	present_queue_family_index = presentQueueFamilyIndex;
 	separate_present_queue = (graphics_queue_family_index != present_queue_family_index);
 
+	// Look for a queue family that can only do transfers, these map to the
+	// DMA engines and can copy while the graphics queue keeps rendering.
+	transfer_queue_family_index = graphics_queue_family_index;
+	for (uint32_t i = 0; i < queue_family_count; i++) {
+		VkQueueFlags flags = queue_props[i].queueFlags;
+		if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) && i != present_queue_family_index) {
+			transfer_queue_family_index = i;
+			break;
+		}
+	}
+	separate_transfer_queue = (transfer_queue_family_index != graphics_queue_family_index);
+
 	_create_device();
 
 	static PFN_vkGetDeviceProcAddr g_gdpa = NULL;
@@ -620,6 +642,12 @@ Error VulkanContext::_initialize_queues(VkSurfaceKHR surface) {
 		vkGetDeviceQueue(device, present_queue_family_index, 0, &present_queue);
 	}
 
+	if (!separate_transfer_queue) {
+		transfer_queue = graphics_queue;
+	} else {
+		vkGetDeviceQueue(device, transfer_queue_family_index, 0, &transfer_queue);
+	}
+
 	// Get the list of VkFormat's that are supported:
 	uint32_t formatCount;
 	VkResult err = fpGetPhysicalDeviceSurfaceFormatsKHR(gpu, surface, &formatCount, NULL);
@@ -1151,6 +1179,12 @@ void VulkanContext::append_command_buffer(const VkCommandBuffer &pCommandBuffer)
 	command_buffer_count++;
 }
 
+void VulkanContext::append_wait_semaphore(VkSemaphore p_semaphore, VkPipelineStageFlags p_stage) {
+
+	wait_semaphores.push_back(p_semaphore);
+	wait_semaphore_stages.push_back(p_stage);
+}
+
 void VulkanContext::flush(bool p_flush_setup, bool p_flush_pending) {
 
 	// ensure everything else pending is executed
@@ -1164,15 +1198,17 @@ void VulkanContext::flush(bool p_flush_setup, bool p_flush_pending) {
 		VkSubmitInfo submit_info;
 		submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 		submit_info.pNext = NULL;
-		submit_info.pWaitDstStageMask = NULL;
-		submit_info.waitSemaphoreCount = 0;
-		submit_info.pWaitSemaphores = NULL;
+		submit_info.pWaitDstStageMask = wait_semaphore_stages.ptr();
+		submit_info.waitSemaphoreCount = wait_semaphores.size();
+		submit_info.pWaitSemaphores = wait_semaphores.ptr();
 		submit_info.commandBufferCount = 1;
 		submit_info.pCommandBuffers = command_buffer_queue.ptr();
 		submit_info.signalSemaphoreCount = 0;
 		submit_info.pSignalSemaphores = NULL;
 		VkResult err = vkQueueSubmit(graphics_queue, 1, &submit_info, VK_NULL_HANDLE);
 		command_buffer_queue.write[0] = NULL;
+		wait_semaphores.clear();
+		wait_semaphore_stages.clear();
 		ERR_FAIL_COND(err);
 		vkDeviceWaitIdle(device);
 	}
@@ -1288,19 +1324,24 @@ Error VulkanContext::swap_buffers() {
 		commands_to_submit = command_buffer_count;
 	}
 
+	//the image acquired semaphore goes first, followed by any pending waits (such as finished uploads)
+	wait_semaphores.insert(0, image_acquired_semaphores[frame_index]);
+	wait_semaphore_stages.insert(0, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+
 	VkPipelineStageFlags pipe_stage_flags;
 	VkSubmitInfo submit_info;
 	submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 	submit_info.pNext = NULL;
-	submit_info.pWaitDstStageMask = &pipe_stage_flags;
-	pipe_stage_flags = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-	submit_info.waitSemaphoreCount = 1;
-	submit_info.pWaitSemaphores = &image_acquired_semaphores[frame_index];
+	submit_info.pWaitDstStageMask = wait_semaphore_stages.ptr();
+	submit_info.waitSemaphoreCount = wait_semaphores.size();
+	submit_info.pWaitSemaphores = wait_semaphores.ptr();
 	submit_info.commandBufferCount = commands_to_submit;
 	submit_info.pCommandBuffers = commands_ptr;
 	submit_info.signalSemaphoreCount = 1;
 	submit_info.pSignalSemaphores = &draw_complete_semaphores[frame_index];
 	err = vkQueueSubmit(graphics_queue, 1, &submit_info, fences[frame_index]);
+	wait_semaphores.clear();
+	wait_semaphore_stages.clear();
 	ERR_FAIL_COND_V(err, ERR_CANT_CREATE);
 
 	command_buffer_queue.write[0] = NULL;
@@ -1312,6 +1353,7 @@ Error VulkanContext::swap_buffers() {
 		// semaphore and signalling the ownership released semaphore when finished
 		VkFence nullFence = VK_NULL_HANDLE;
 		pipe_stage_flags = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		submit_info.pWaitDstStageMask = &pipe_stage_flags;
 		submit_info.waitSemaphoreCount = 1;
 		submit_info.pWaitSemaphores = &draw_complete_semaphores[frame_index];
 		submit_info.commandBufferCount = 0;
@@ -1474,6 +1516,18 @@ uint32_t VulkanContext::get_graphics_queue() const {
 	return graphics_queue_family_index;
 }
 
+uint32_t VulkanContext::get_transfer_queue() const {
+	return transfer_queue_family_index;
+}
+
+bool VulkanContext::has_separate_transfer_queue() const {
+	return separate_transfer_queue;
+}
+
+VkQueue VulkanContext::get_transfer_queue_handle() const {
+	return transfer_queue;
+}
+
 VkFormat VulkanContext::get_screen_format() const {
 	return format;
 }
@@ -1482,6 +1536,10 @@ VkPhysicalDeviceLimits VulkanContext::get_device_limits() const {
 	return gpu_props.limits;
 }
 
+VkPhysicalDeviceProperties VulkanContext::get_device_properties() const {
+	return gpu_props;
+}
+
 VulkanContext::VulkanContext() {
 	queue_props = NULL;
 	command_buffer_count = 0;
@@ -1494,6 +1552,9 @@ VulkanContext::VulkanContext() {
 	command_buffer_queue.write[0] = NULL;
 	command_buffer_count = 1;
 	queues_initialized = false;
+	separate_transfer_queue = false;
+	transfer_queue_family_index = 0;
+	transfer_queue = VK_NULL_HANDLE;
 
 	buffers_prepared = false;
 	swapchainImageCount = 0;
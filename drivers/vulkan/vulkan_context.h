@@ -62,6 +62,11 @@ class VulkanContext {
 	bool separate_present_queue;
 	VkQueue graphics_queue;
 	VkQueue present_queue;
+
+	//uploads, a queue family only capable of transfers is used when available (DMA engine)
+	uint32_t transfer_queue_family_index;
+	bool separate_transfer_queue;
+	VkQueue transfer_queue;
 	VkColorSpaceKHR color_space;
 	VkFormat format;
 	VkSemaphore image_acquired_semaphores[FRAME_LAG];
@@ -169,6 +174,9 @@ class VulkanContext {
 	Vector<VkCommandBuffer> command_buffer_queue;
 	int command_buffer_count;
 
+	Vector<VkSemaphore> wait_semaphores;
+	Vector<VkPipelineStageFlags> wait_semaphore_stages;
+
 protected:
 	virtual const char *_get_platform_surface_extension() const = 0;
 	//	virtual VkResult _create_surface(VkSurfaceKHR *surface, VkInstance p_instance) = 0;
@@ -186,6 +194,9 @@ public:
 	VkPhysicalDevice get_physical_device();
 	int get_swapchain_image_count() const;
 	uint32_t get_graphics_queue() const;
+	uint32_t get_transfer_queue() const;
+	bool has_separate_transfer_queue() const;
+	VkQueue get_transfer_queue_handle() const;
 
 	void window_resize(DisplayServer::WindowID p_window_id, int p_width, int p_height);
 	int window_get_width(DisplayServer::WindowID p_window = 0);
@@ -196,9 +207,11 @@ public:
 
 	VkFormat get_screen_format() const;
 	VkPhysicalDeviceLimits get_device_limits() const;
+	VkPhysicalDeviceProperties get_device_properties() const;
 
 	void set_setup_buffer(const VkCommandBuffer &pCommandBuffer);
 	void append_command_buffer(const VkCommandBuffer &pCommandBuffer);
+	void append_wait_semaphore(VkSemaphore p_semaphore, VkPipelineStageFlags p_stage); //waited for by the next submission of the setup buffer or the frame
 	void resize_notify();
 	void flush(bool p_flush_setup = false, bool p_flush_pending = false);
 	Error prepare_buffers();
@@ -39,6 +39,7 @@
 #include <windows.h>
 
 #include <errno.h>
+#include <io.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <tchar.h>
@@ -58,6 +59,48 @@ void FileAccessWindows::check_errors() const {
 	}
 }
 
+void FileAccessWindows::_map() {
+
+#ifndef UWP_ENABLED
+	HANDLE file = (HANDLE)_get_osfhandle(_fileno(f));
+	if (file == INVALID_HANDLE_VALUE) {
+		return;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart < MAP_MIN_SIZE) {
+		return;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!mapping) {
+		return; //not an error, reads go through stdio instead
+	}
+
+	void *addr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping); //the view keeps the mapping alive
+	if (!addr) {
+		return;
+	}
+
+	map = (uint8_t *)addr;
+	map_len = size.QuadPart;
+	map_pos = 0;
+#endif
+}
+
+void FileAccessWindows::_unmap() {
+
+#ifndef UWP_ENABLED
+	if (map) {
+		UnmapViewOfFile(map);
+	}
+#endif
+	map = NULL;
+	map_len = 0;
+	map_pos = 0;
+}
+
 Error FileAccessWindows::_open(const String &p_path, int p_mode_flags) {
 
 	path_src = p_path;
@@ -130,6 +173,9 @@ Error FileAccessWindows::_open(const String &p_path, int p_mode_flags) {
 	} else {
 		last_error = OK;
 		flags = p_mode_flags;
+		if (p_mode_flags == READ) {
+			_map();
+		}
 		return OK;
 	}
 }
@@ -141,6 +187,7 @@ void FileAccessWindows::close() {
 
 	fclose(f);
 	f = NULL;
+	_unmap();
 
 	if (save_path != "") {
 
@@ -202,6 +249,11 @@ void FileAccessWindows::seek(size_t p_position) {
 
 	ERR_FAIL_COND(!f);
 	last_error = OK;
+	if (map) {
+		map_pos = p_position;
+		return;
+	}
+
 	if (fseek(f, p_position, SEEK_SET))
 		check_errors();
 	prev_op = 0;
@@ -209,12 +261,22 @@ void FileAccessWindows::seek(size_t p_position) {
 void FileAccessWindows::seek_end(int64_t p_position) {
 
 	ERR_FAIL_COND(!f);
+	if (map) {
+		ERR_FAIL_COND(int64_t(map_len) + p_position < 0);
+		map_pos = map_len + p_position;
+		return;
+	}
+
 	if (fseek(f, p_position, SEEK_END))
 		check_errors();
 	prev_op = 0;
 }
 size_t FileAccessWindows::get_position() const {
 
+	if (map) {
+		return map_pos;
+	}
+
 	size_t aux_position = 0;
 	aux_position = ftell(f);
 	if (!aux_position) {
@@ -226,6 +288,10 @@ size_t FileAccessWindows::get_len() const {
 
 	ERR_FAIL_COND_V(!f, 0);
 
+	if (map) {
+		return map_len;
+	}
+
 	size_t pos = get_position();
 	fseek(f, 0, SEEK_END);
 	int size = get_position();
@@ -243,6 +309,14 @@ bool FileAccessWindows::eof_reached() const {
 uint8_t FileAccessWindows::get_8() const {
 
 	ERR_FAIL_COND_V(!f, 0);
+	if (map) {
+		if (map_pos >= map_len) {
+			last_error = ERR_FILE_EOF;
+			return 0;
+		}
+		return map[map_pos++];
+	}
+
 	if (flags == READ_WRITE || flags == WRITE_READ) {
 		if (prev_op == WRITE) {
 			fflush(f);
@@ -261,6 +335,14 @@ uint8_t FileAccessWindows::get_8() const {
 int FileAccessWindows::get_buffer(uint8_t *p_dst, int p_length) const {
 
 	ERR_FAIL_COND_V(!f, -1);
+	if (map) {
+		int read = 0;
+		const uint8_t *src = get_buffer_view(p_length, read);
+		ERR_FAIL_COND_V(!src, -1);
+		copymem(p_dst, src, read);
+		return read;
+	}
+
 	if (flags == READ_WRITE || flags == WRITE_READ) {
 		if (prev_op == WRITE) {
 			fflush(f);
@@ -272,6 +354,26 @@ int FileAccessWindows::get_buffer(uint8_t *p_dst, int p_length) const {
 	return read;
 };
 
+const uint8_t *FileAccessWindows::get_buffer_view(int p_length, int &r_length) const {
+
+	ERR_FAIL_COND_V(!f, NULL);
+	ERR_FAIL_COND_V(p_length < 0, NULL);
+
+	if (!map) {
+		return NULL;
+	}
+
+	size_t left = map_pos < map_len ? map_len - map_pos : 0;
+	r_length = MIN(size_t(p_length), left);
+	if (r_length < p_length) {
+		last_error = ERR_FILE_EOF; //like fread, only reported when reading past the end
+	}
+
+	const uint8_t *view = map + MIN(map_pos, map_len);
+	map_pos += r_length;
+	return view;
+}
+
 Error FileAccessWindows::get_error() const {
 
 	return last_error;
@@ -356,6 +458,9 @@ Error FileAccessWindows::_set_unix_permissions(const String &p_file, uint32_t p_
 FileAccessWindows::FileAccessWindows() :
 		f(NULL),
 		flags(0),
+		map(NULL),
+		map_len(0),
+		map_pos(0),
 		prev_op(0),
 		last_error(OK) {
 }
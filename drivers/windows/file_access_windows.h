@@ -40,8 +40,20 @@
 
 class FileAccessWindows : public FileAccess {
 
+	enum {
+		MAP_MIN_SIZE = 16 * 1024 // smaller files read just as fast through stdio
+	};
+
 	FILE *f;
 	int flags;
+
+	//files opened for reading only are mapped when possible, reads then come straight from the mapping
+	uint8_t *map;
+	size_t map_len;
+	mutable size_t map_pos;
+	void _map();
+	void _unmap();
+
 	void check_errors() const;
 	mutable int prev_op;
 	mutable Error last_error;
@@ -66,6 +78,7 @@ public:
 
 	virtual uint8_t get_8() const; ///< get a byte
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
+	virtual const uint8_t *get_buffer_view(int p_length, int &r_length) const;
 
 	virtual Error get_error() const; ///< get last error
 
@@ -32,7 +32,8 @@
 
 #include "core/crypto/crypto_core.h"
 #include "core/io/config_file.h"
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/file_access_compressed.h"
+#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION, PackedData::PackIndexWriter
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/io/zip_io.h"
@@ -323,8 +324,21 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 	sd.path_utf8 = p_path.utf8();
 	sd.ofs = pd->f->get_position();
 	sd.size = p_data.size();
+	sd.compressed = false;
 
-	pd->f->store_buffer(p_data.ptr(), p_data.size());
+	Vector<uint8_t> compressed;
+	if (pd->compress && p_data.size() >= 256) {
+		//kept only when it actually saves space, already compressed formats won't
+		compressed = FileAccessCompressed::compress_buffer(p_data.ptr(), p_data.size(), PACK_FILE_COMPRESSED_MAGIC, Compression::MODE_ZSTD, PACK_FILE_COMPRESSED_BLOCK_SIZE);
+		sd.compressed = compressed.size() > 0 && compressed.size() < p_data.size() - p_data.size() / 16;
+	}
+
+	if (sd.compressed) {
+		sd.size = compressed.size();
+		pd->f->store_buffer(compressed.ptr(), compressed.size());
+	} else {
+		pd->f->store_buffer(p_data.ptr(), p_data.size());
+	}
 	int pad = _get_pad(PCK_PADDING, sd.size);
 	for (int i = 0; i < pad; i++) {
 		pd->f->store_8(0);
@@ -935,6 +949,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 	pd.ep = &ep;
 	pd.f = ftmp;
 	pd.so_files = p_so_files;
+	pd.compress = GLOBAL_GET("compression/pck/compress_files");
 
 	Error err = export_project_files(p_preset, _save_pack_file, &pd, _add_shared_object);
 
@@ -1008,6 +1023,8 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 
 	int header_padding = _get_pad(PCK_PADDING, header_size);
 
+	PackedData::PackIndexWriter index;
+
 	for (int i = 0; i < pd.file_ofs.size(); i++) {
 
 		int string_len = pd.file_ofs[i].path_utf8.length();
@@ -1022,6 +1039,8 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 		f->store_64(pd.file_ofs[i].ofs + header_padding + header_size);
 		f->store_64(pd.file_ofs[i].size); // pay attention here, this is where file is
 		f->store_buffer(pd.file_ofs[i].md5.ptr(), 16); //also save md5 for file
+
+		index.add_file(String::utf8(pd.file_ofs[i].path_utf8.get_data()), pd.file_ofs[i].ofs + header_padding + header_size, pd.file_ofs[i].size, pd.file_ofs[i].md5.ptr(), pd.file_ofs[i].compressed ? PACK_FILE_COMPRESSED : 0);
 	}
 
 	for (int i = 0; i < header_padding; i++) {
@@ -1050,6 +1069,8 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 
 	memdelete(ftmp);
 
+	index.store(f, pck_start_pos);
+
 	if (p_embed) {
 		// Ensure embedded data ends at a 64-bit multiple
 		int64_t embed_end = f->get_position() - embed_pos + 12;
@@ -57,6 +57,7 @@ public:
 		MODE_SCRIPT_TEXT,
 		MODE_SCRIPT_COMPILED,
 		MODE_SCRIPT_ENCRYPTED,
+		MODE_SCRIPT_PRECOMPILED,
 	};
 
 private:
@@ -166,6 +167,7 @@ private:
 		uint64_t size;
 		Vector<uint8_t> md5;
 		CharString path_utf8;
+		bool compressed;
 
 		bool operator<(const SavedData &p_data) const {
 			return path_utf8 < p_data.path_utf8;
@@ -178,6 +180,7 @@ private:
 		Vector<SavedData> file_ofs;
 		EditorProgress *ep;
 		Vector<SharedObject> *so_files;
+		bool compress;
 	};
 
 	struct ZipData {
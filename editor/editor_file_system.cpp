@@ -30,12 +30,14 @@
 
 #include "editor_file_system.h"
 
+#include "core/io/marshalls.h"
 #include "core/io/resource_importer.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 #include "core/variant_parser.h"
 #include "editor_node.h"
 #include "editor_resource_preview.h"
@@ -43,7 +45,8 @@
 
 EditorFileSystem *EditorFileSystem::singleton = NULL;
 //the name is the version, to keep compatibility with different versions of Godot
-#define CACHE_FILE_NAME "filesystem_cache6"
+#define CACHE_FILE_NAME "filesystem_cache7"
+#define CACHE_FILE_MAGIC "GDFC"
 
 void EditorFileSystemDirectory::sort_files() {
 
@@ -197,83 +200,12 @@ void EditorFileSystem::_scan_filesystem() {
 
 	ERR_FAIL_COND(!scanning || new_filesystem);
 
-	//read .fscache
-	String cpath;
-
 	sources_changed.clear();
 	file_cache.clear();
 
 	String project = ProjectSettings::get_singleton()->get_resource_path();
 
-	String fscache = EditorSettings::get_singleton()->get_project_settings_dir().plus_file(CACHE_FILE_NAME);
-	FileAccess *f = FileAccess::open(fscache, FileAccess::READ);
-
-	bool first = true;
-	if (f) {
-		//read the disk cache
-		while (!f->eof_reached()) {
-
-			String l = f->get_line().strip_edges();
-			if (first) {
-				if (first_scan) {
-					// only use this on first scan, afterwards it gets ignored
-					// this is so on first reimport we synchronize versions, then
-					// we don't care until editor restart. This is for usability mainly so
-					// your workflow is not killed after changing a setting by forceful reimporting
-					// everything there is.
-					filesystem_settings_version_for_import = l.strip_edges();
-					if (filesystem_settings_version_for_import != ResourceFormatImporter::get_singleton()->get_import_settings_hash()) {
-						revalidate_import_files = true;
-					}
-				}
-				first = false;
-				continue;
-			}
-			if (l == String())
-				continue;
-
-			if (l.begins_with("::")) {
-				Vector<String> split = l.split("::");
-				ERR_CONTINUE(split.size() != 3);
-				String name = split[1];
-
-				cpath = name;
-
-			} else {
-				Vector<String> split = l.split("::");
-				ERR_CONTINUE(split.size() != 8);
-				String name = split[0];
-				String file;
-
-				file = name;
-				name = cpath.plus_file(name);
-
-				FileCache fc;
-				fc.type = split[1];
-				fc.modification_time = split[2].to_int64();
-				fc.import_modification_time = split[3].to_int64();
-				fc.import_valid = split[4].to_int64() != 0;
-				fc.import_group_file = split[5].strip_edges();
-				fc.script_class_name = split[6].get_slice("<>", 0);
-				fc.script_class_extends = split[6].get_slice("<>", 1);
-				fc.script_class_icon_path = split[6].get_slice("<>", 2);
-
-				String deps = split[7].strip_edges();
-				if (deps.length()) {
-					Vector<String> dp = deps.split("<>");
-					for (int i = 0; i < dp.size(); i++) {
-						String path = dp[i];
-						fc.deps.push_back(path);
-					}
-				}
-
-				file_cache[name] = fc;
-			}
-		}
-
-		f->close();
-		memdelete(f);
-	}
+	_load_filesystem_cache();
 
 	String update_cache = EditorSettings::get_singleton()->get_project_settings_dir().plus_file("filesystem_update4");
 
@@ -307,6 +239,7 @@ void EditorFileSystem::_scan_filesystem() {
 	_scan_new_dir(new_filesystem, d, sp);
 
 	file_cache.clear(); //clear caches, no longer needed
+	dir_cache.clear();
 
 	memdelete(d);
 
@@ -318,6 +251,160 @@ void EditorFileSystem::_scan_filesystem() {
 	scanning = false;
 }
 
+//binary, so it can be parsed in place from a mapped file instead of being split in lines
+struct EditorFileSystemCacheReader {
+
+	const uint8_t *data = NULL;
+	int len = 0;
+	int pos = 0;
+	bool error = false;
+
+	bool has(int p_bytes) {
+		if (error || p_bytes < 0 || pos + p_bytes > len) {
+			error = true;
+			return false;
+		}
+		return true;
+	}
+	uint8_t get_8() {
+		if (!has(1)) {
+			return 0;
+		}
+		return data[pos++];
+	}
+	uint32_t get_32() {
+		if (!has(4)) {
+			return 0;
+		}
+		uint32_t v = decode_uint32(&data[pos]);
+		pos += 4;
+		return v;
+	}
+	uint64_t get_64() {
+		if (!has(8)) {
+			return 0;
+		}
+		uint64_t v = decode_uint64(&data[pos]);
+		pos += 8;
+		return v;
+	}
+	String get_string() {
+		uint32_t sl = get_32();
+		if (sl == 0 || !has(sl)) {
+			return String();
+		}
+		String s;
+		s.parse_utf8((const char *)&data[pos], sl);
+		pos += sl;
+		return s;
+	}
+};
+
+String EditorFileSystem::_get_extensions_signature() const {
+
+	String sig;
+	for (Set<String>::Element *E = valid_extensions.front(); E; E = E->next()) {
+		sig += E->get() + ",";
+	}
+	return sig;
+}
+
+void EditorFileSystem::_load_filesystem_cache() {
+
+	dir_cache.clear();
+	dir_cache_time = 0;
+
+	String fscache = EditorSettings::get_singleton()->get_project_settings_dir().plus_file(CACHE_FILE_NAME);
+	FileAccessRef f = FileAccess::open(fscache, FileAccess::READ);
+	if (!f) {
+		return;
+	}
+
+	int len = f->get_len();
+	Vector<uint8_t> buffer;
+	int view_len = 0;
+	const uint8_t *data = f->get_buffer_view(len, view_len);
+	if (!data || view_len != len) {
+		buffer.resize(len);
+		ERR_FAIL_COND(f->get_buffer(buffer.ptrw(), len) != len);
+		data = buffer.ptr();
+	}
+
+	EditorFileSystemCacheReader r;
+	r.data = data;
+	r.len = len;
+	if (!r.has(4) || memcmp(data, CACHE_FILE_MAGIC, 4) != 0) {
+		return;
+	}
+	r.pos = 4;
+
+	String settings_version = r.get_string();
+	if (first_scan) {
+		// only use this on first scan, afterwards it gets ignored
+		// this is so on first reimport we synchronize versions, then
+		// we don't care until editor restart. This is for usability mainly so
+		// your workflow is not killed after changing a setting by forceful reimporting
+		// everything there is.
+		filesystem_settings_version_for_import = settings_version;
+		if (filesystem_settings_version_for_import != ResourceFormatImporter::get_singleton()->get_import_settings_hash()) {
+			revalidate_import_files = true;
+		}
+	}
+
+	//directory listings can only be trusted if the same extensions were scanned for
+	bool use_dirs = r.get_string() == _get_extensions_signature() && !using_fat32_or_exfat;
+	uint64_t saved_time = r.get_64();
+
+	uint32_t dir_count = r.get_32();
+	for (uint32_t i = 0; i < dir_count && !r.error; i++) {
+
+		String cpath = r.get_string();
+		DirCache dc;
+		dc.modification_time = r.get_64();
+
+		uint32_t subdir_count = r.get_32();
+		for (uint32_t j = 0; j < subdir_count && !r.error; j++) {
+			dc.subdirs.push_back(r.get_string());
+		}
+
+		uint32_t file_count = r.get_32();
+		for (uint32_t j = 0; j < file_count && !r.error; j++) {
+
+			String file = r.get_string();
+			FileCache fc;
+			fc.type = r.get_string();
+			fc.modification_time = r.get_64();
+			fc.import_modification_time = r.get_64();
+			fc.import_valid = r.get_8() != 0;
+			fc.import_group_file = r.get_string();
+			fc.script_class_name = r.get_string();
+			fc.script_class_extends = r.get_string();
+			fc.script_class_icon_path = r.get_string();
+
+			uint32_t dep_count = r.get_32();
+			for (uint32_t k = 0; k < dep_count && !r.error; k++) {
+				fc.deps.push_back(r.get_string());
+			}
+
+			dc.files.push_back(file);
+			file_cache[cpath.plus_file(file)] = fc;
+		}
+
+		if (use_dirs) {
+			dir_cache[cpath] = dc;
+		}
+	}
+
+	if (r.error) {
+		ERR_PRINT("Filesystem cache '" + fscache + "' is corrupt, rescanning everything.");
+		file_cache.clear();
+		dir_cache.clear();
+		return;
+	}
+
+	dir_cache_time = saved_time;
+}
+
 void EditorFileSystem::_save_filesystem_cache() {
 
 	group_file_cache.clear();
@@ -327,8 +414,18 @@ void EditorFileSystem::_save_filesystem_cache() {
 	FileAccess *f = FileAccess::open(fscache, FileAccess::WRITE);
 	ERR_FAIL_COND_MSG(!f, "Cannot create file '" + fscache + "'. Check user write permissions.");
 
-	f->store_line(filesystem_settings_version_for_import);
-	_save_filesystem_cache(filesystem, f);
+	f->store_buffer((const uint8_t *)CACHE_FILE_MAGIC, 4);
+	f->store_pascal_string(filesystem_settings_version_for_import);
+	f->store_pascal_string(_get_extensions_signature());
+	f->store_64(OS::get_singleton()->get_unix_time());
+
+	uint32_t dir_count = 0;
+	size_t count_pos = f->get_position();
+	f->store_32(0); //filled once known
+	_save_filesystem_cache(filesystem, f, dir_count);
+
+	f->seek(count_pos);
+	f->store_32(dir_count);
 	f->close();
 	memdelete(f);
 }
@@ -339,7 +436,7 @@ void EditorFileSystem::_thread_func(void *_userdata) {
 	sd->_scan_filesystem();
 }
 
-bool EditorFileSystem::_test_for_reimport(const String &p_path, bool p_only_imported_files) {
+bool EditorFileSystem::_test_for_reimport(const String &p_path, bool p_only_imported_files, const String &p_source_md5) {
 
 	if (!reimport_on_missing_imported_files && p_only_imported_files)
 		return false;
@@ -469,7 +566,7 @@ bool EditorFileSystem::_test_for_reimport(const String &p_path, bool p_only_impo
 			return true; //lacks md5, so just reimport
 		}
 
-		String md5 = FileAccess::get_md5(p_path);
+		String md5 = p_source_md5 != String() ? p_source_md5 : FileAccess::get_md5(p_path);
 		if (md5 != source_md5) {
 			return true;
 		}
@@ -494,6 +591,27 @@ bool EditorFileSystem::_update_scan_actions() {
 	Vector<String> reimports;
 	Vector<String> reloads;
 
+	//hash the sources to test all at once, so it's spread over the available cores
+	Vector<String> test_paths;
+	for (List<ItemAction>::Element *E = scan_actions.front(); E; E = E->next()) {
+
+		ItemAction &ia = E->get();
+		if (ia.action == ItemAction::ACTION_FILE_TEST_REIMPORT) {
+			int idx = ia.dir->find_file_index(ia.file);
+			if (idx != -1) {
+				test_paths.push_back(ia.dir->get_file_path(idx));
+			}
+		}
+	}
+
+	Map<String, String> test_md5s;
+	if (test_paths.size() > 1) {
+		Vector<String> md5s = FileAccess::get_md5_batch(test_paths);
+		for (int i = 0; i < test_paths.size(); i++) {
+			test_md5s[test_paths[i]] = md5s[i];
+		}
+	}
+
 	for (List<ItemAction>::Element *E = scan_actions.front(); E; E = E->next()) {
 
 		ItemAction &ia = E->get();
@@ -560,7 +678,8 @@ bool EditorFileSystem::_update_scan_actions() {
 				int idx = ia.dir->find_file_index(ia.file);
 				ERR_CONTINUE(idx == -1);
 				String full_path = ia.dir->get_file_path(idx);
-				if (_test_for_reimport(full_path, false)) {
+				Map<String, String>::Element *md5 = test_md5s.find(full_path);
+				if (_test_for_reimport(full_path, false, md5 ? md5->get() : String())) {
 					//must reimport
 					reimports.push_back(full_path);
 				} else {
@@ -668,35 +787,55 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 
 	p_dir->modified_time = FileAccess::get_modified_time(cd);
 
-	da->list_dir_begin();
-	while (true) {
+	Vector<String> subdir_names;
 
-		String f = da->get_next();
-		if (f == "")
-			break;
+	const DirCache *dc = dir_cache.getptr(cd.plus_file(""));
+	if (dc && dc->modification_time == p_dir->modified_time && dc->modification_time < dir_cache_time) {
+		//nothing was added, removed or renamed here since the cache was saved, so the listing is still good
+		subdir_names = dc->subdirs;
+		for (int i = 0; i < dc->files.size(); i++) {
+			files.push_back(dc->files[i]);
+		}
+	} else {
 
-		if (da->current_is_hidden())
-			continue;
+		da->list_dir_begin();
+		while (true) {
 
-		if (da->current_is_dir()) {
+			String f = da->get_next();
+			if (f == "")
+				break;
 
-			if (f.begins_with(".")) // Ignore special and . / ..
+			if (da->current_is_hidden())
 				continue;
 
-			if (FileAccess::exists(cd.plus_file(f).plus_file("project.godot"))) // skip if another project inside this
-				continue;
-			if (FileAccess::exists(cd.plus_file(f).plus_file(".gdignore"))) // skip if another project inside this
-				continue;
+			if (da->current_is_dir()) {
 
-			dirs.push_back(f);
+				if (f.begins_with(".")) // Ignore special and . / ..
+					continue;
 
-		} else {
+				subdir_names.push_back(f);
+
+			} else {
 
-			files.push_back(f);
+				files.push_back(f);
+			}
 		}
+
+		da->list_dir_end();
 	}
 
-	da->list_dir_end();
+	for (int i = 0; i < subdir_names.size(); i++) {
+
+		const String &f = subdir_names[i];
+		//kept so the cached listing notices when they stop being ignored
+		if (FileAccess::exists(cd.plus_file(f).plus_file("project.godot")) || // skip if another project inside this
+				FileAccess::exists(cd.plus_file(f).plus_file(".gdignore"))) {
+			p_dir->ignored_subdirs.push_back(f);
+			continue;
+		}
+
+		dirs.push_back(f);
+	}
 
 	dirs.sort_custom<NaturalNoCaseComparator>();
 	files.sort_custom<NaturalNoCaseComparator>();
@@ -862,6 +1001,8 @@ void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const
 			p_dir->get_subdir(i)->verified = false;
 		}
 
+		p_dir->ignored_subdirs.clear();
+
 		//then scan files and directories and check what's different
 
 		DirAccess *da = DirAccess::create(DirAccess::ACCESS_RESOURCES);
@@ -885,10 +1026,11 @@ void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const
 				int idx = p_dir->find_dir_index(f);
 				if (idx == -1) {
 
-					if (FileAccess::exists(cd.plus_file(f).plus_file("project.godot"))) // skip if another project inside this
-						continue;
-					if (FileAccess::exists(cd.plus_file(f).plus_file(".gdignore"))) // skip if another project inside this
+					if (FileAccess::exists(cd.plus_file(f).plus_file("project.godot")) || // skip if another project inside this
+							FileAccess::exists(cd.plus_file(f).plus_file(".gdignore"))) {
+						p_dir->ignored_subdirs.push_back(f);
 						continue;
+					}
 
 					EditorFileSystemDirectory *efd = memnew(EditorFileSystemDirectory);
 
@@ -1200,32 +1342,50 @@ EditorFileSystemDirectory *EditorFileSystem::get_filesystem() {
 	return filesystem;
 }
 
-void EditorFileSystem::_save_filesystem_cache(EditorFileSystemDirectory *p_dir, FileAccess *p_file) {
+void EditorFileSystem::_save_filesystem_cache(EditorFileSystemDirectory *p_dir, FileAccess *p_file, uint32_t &r_dir_count) {
 
 	if (!p_dir)
 		return; //none
-	p_file->store_line("::" + p_dir->get_path() + "::" + String::num(p_dir->modified_time));
 
+	r_dir_count++;
+	p_file->store_pascal_string(p_dir->get_path());
+	p_file->store_64(p_dir->modified_time);
+
+	p_file->store_32(p_dir->subdirs.size() + p_dir->ignored_subdirs.size());
+	for (int i = 0; i < p_dir->subdirs.size(); i++) {
+		p_file->store_pascal_string(p_dir->subdirs[i]->name);
+	}
+	for (int i = 0; i < p_dir->ignored_subdirs.size(); i++) {
+		p_file->store_pascal_string(p_dir->ignored_subdirs[i]);
+	}
+
+	p_file->store_32(p_dir->files.size());
 	for (int i = 0; i < p_dir->files.size(); i++) {
 
-		if (p_dir->files[i]->import_group_file != String()) {
-			group_file_cache.insert(p_dir->files[i]->import_group_file);
+		const EditorFileSystemDirectory::FileInfo *fi = p_dir->files[i];
+		if (fi->import_group_file != String()) {
+			group_file_cache.insert(fi->import_group_file);
 		}
-		String s = p_dir->files[i]->file + "::" + p_dir->files[i]->type + "::" + itos(p_dir->files[i]->modified_time) + "::" + itos(p_dir->files[i]->import_modified_time) + "::" + itos(p_dir->files[i]->import_valid) + "::" + p_dir->files[i]->import_group_file + "::" + p_dir->files[i]->script_class_name + "<>" + p_dir->files[i]->script_class_extends + "<>" + p_dir->files[i]->script_class_icon_path;
-		s += "::";
-		for (int j = 0; j < p_dir->files[i]->deps.size(); j++) {
 
-			if (j > 0)
-				s += "<>";
-			s += p_dir->files[i]->deps[j];
+		p_file->store_pascal_string(fi->file);
+		p_file->store_pascal_string(fi->type);
+		p_file->store_64(fi->modified_time);
+		p_file->store_64(fi->import_modified_time);
+		p_file->store_8(fi->import_valid ? 1 : 0);
+		p_file->store_pascal_string(fi->import_group_file);
+		p_file->store_pascal_string(fi->script_class_name);
+		p_file->store_pascal_string(fi->script_class_extends);
+		p_file->store_pascal_string(fi->script_class_icon_path);
+
+		p_file->store_32(fi->deps.size());
+		for (int j = 0; j < fi->deps.size(); j++) {
+			p_file->store_pascal_string(fi->deps[j]);
 		}
-
-		p_file->store_line(s);
 	}
 
 	for (int i = 0; i < p_dir->subdirs.size(); i++) {
 
-		_save_filesystem_cache(p_dir->subdirs[i], p_file);
+		_save_filesystem_cache(p_dir->subdirs[i], p_file, r_dir_count);
 	}
 }
 
@@ -1716,16 +1876,15 @@ Error EditorFileSystem::_reimport_group(const String &p_group_file, const Vector
 	return err;
 }
 
-void EditorFileSystem::_reimport_file(const String &p_file) {
+bool EditorFileSystem::_reimport_file_begin(const String &p_file, ReimportData &r_data) {
 
-	EditorFileSystemDirectory *fs = NULL;
-	int cpos = -1;
-	bool found = _find_file(p_file, &fs, cpos);
-	ERR_FAIL_COND_MSG(!found, "Can't find file '" + p_file + "'.");
+	r_data.path = p_file;
+	bool found = _find_file(p_file, &r_data.fs, r_data.cpos);
+	ERR_FAIL_COND_V_MSG(!found, false, "Can't find file '" + p_file + "'.");
 
 	//try to obtain existing params
 
-	Map<StringName, Variant> params;
+	Map<StringName, Variant> &params = r_data.params;
 	String importer_name;
 
 	if (FileAccess::exists(p_file + ".import")) {
@@ -1750,7 +1909,7 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 		late_added_files.insert(p_file); //imported files do not call update_file(), but just in case..
 	}
 
-	Ref<ResourceImporter> importer;
+	Ref<ResourceImporter> &importer = r_data.importer;
 	bool load_default = false;
 	//find the importer
 	if (importer_name != "") {
@@ -1763,13 +1922,13 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 		load_default = true;
 		if (importer.is_null()) {
 			ERR_PRINT("BUG: File queued for import, but can't be imported!");
-			ERR_FAIL();
+			return false;
 		}
 	}
 
 	//mix with default params, in case a parameter is missing
 
-	List<ResourceImporter::ImportOption> opts;
+	List<ResourceImporter::ImportOption> &opts = r_data.opts;
 	importer->get_import_options(&opts);
 	for (List<ResourceImporter::ImportOption>::Element *E = opts.front(); E; E = E->next()) {
 		if (!params.has(E->get().option.name)) { //this one is not present
@@ -1788,13 +1947,42 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 		}
 	}
 
+	r_data.base_path = ResourceFormatImporter::get_singleton()->get_import_base_path(p_file);
+
+	return true;
+}
+
+void EditorFileSystem::_reimport_file_import(uint32_t p_index, ReimportData **p_data) {
+
 	//finally, perform import!!
-	String base_path = ResourceFormatImporter::get_singleton()->get_import_base_path(p_file);
+	ReimportData &data = *p_data[p_index];
+	data.err = data.importer->import(data.path, data.base_path, data.params, &data.import_variants, &data.gen_files, &data.metadata);
+}
 
-	List<String> import_variants;
-	List<String> gen_files;
-	Variant metadata;
-	Error err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &metadata);
+void EditorFileSystem::_reimport_queue_worker(uint32_t p_index, ReimportQueue *p_queue) {
+
+	while (true) {
+		uint32_t idx = p_queue->next.fetch_add(1);
+		if (idx >= p_queue->count) {
+			break;
+		}
+		_reimport_file_import(idx, p_queue->items);
+	}
+}
+
+void EditorFileSystem::_reimport_file_end(ReimportData &p_data) {
+
+	const String &p_file = p_data.path;
+	Ref<ResourceImporter> importer = p_data.importer;
+	String base_path = p_data.base_path;
+	List<String> &import_variants = p_data.import_variants;
+	List<String> &gen_files = p_data.gen_files;
+	Variant &metadata = p_data.metadata;
+	List<ResourceImporter::ImportOption> &opts = p_data.opts;
+	Map<StringName, Variant> &params = p_data.params;
+	Error err = p_data.err;
+	EditorFileSystemDirectory *fs = p_data.fs;
+	int cpos = p_data.cpos;
 
 	if (err != OK) {
 		ERR_PRINT("Error importing '" + p_file + "'.");
@@ -1921,6 +2109,18 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 	EditorResourcePreview::get_singleton()->check_for_invalidation(p_file);
 }
 
+void EditorFileSystem::_reimport_file(const String &p_file) {
+
+	ReimportData data;
+	if (!_reimport_file_begin(p_file, data)) {
+		return;
+	}
+
+	ReimportData *datap = &data;
+	_reimport_file_import(0, &datap);
+	_reimport_file_end(data);
+}
+
 void EditorFileSystem::_find_group_files(EditorFileSystemDirectory *efd, Map<String, Vector<String>> &group_files, Set<String> &groups_to_reimport) {
 
 	int fc = efd->files.size();
@@ -1990,9 +2190,72 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 
 	files.sort();
 
-	for (int i = 0; i < files.size(); i++) {
-		pr.step(files[i].path.get_file(), i);
-		_reimport_file(files[i].path);
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+
+	if (import_threaded && pool && pool->get_thread_count() > 0) {
+
+		//files of the same import order are imported together, the ones whose importer allows it in the work pool
+		int from = 0;
+		while (from < files.size()) {
+
+			int to = from + 1;
+			while (to < files.size() && files[to].order == files[from].order) {
+				to++;
+			}
+
+			Vector<ReimportData> batch;
+			batch.resize(to - from);
+			ReimportData *batchw = batch.ptrw();
+			Vector<ReimportData *> threaded;
+
+			for (int i = from; i < to; i++) {
+
+				ReimportData &data = batchw[i - from];
+				if (!_reimport_file_begin(files[i].path, data)) {
+					continue;
+				}
+
+				if (data.importer->can_import_threaded()) {
+					threaded.push_back(&data);
+				} else {
+					pr.step(files[i].path.get_file(), i);
+					ReimportData *datap = &data;
+					_reimport_file_import(0, &datap);
+				}
+			}
+
+			if (threaded.size()) {
+				pr.step(threaded[0]->path.get_file(), from);
+
+				ReimportQueue queue;
+				queue.items = threaded.ptrw();
+				queue.count = threaded.size();
+				queue.next = 0;
+
+				//importers can use a lot of memory each, so only run as many at once as allowed
+				uint32_t workers = pool->get_thread_count() + 1;
+				if (import_max_threads > 0) {
+					workers = MIN(workers, uint32_t(import_max_threads));
+				}
+				workers = MIN(workers, queue.count);
+				pool->wait_for_task(pool->add_group_task(workers, this, &EditorFileSystem::_reimport_queue_worker, &queue, 1));
+			}
+
+			for (int i = from; i < to; i++) {
+				if (batchw[i - from].importer.is_valid()) {
+					pr.step(files[i].path.get_file(), i);
+					_reimport_file_end(batchw[i - from]);
+				}
+			}
+
+			from = to;
+		}
+	} else {
+
+		for (int i = 0; i < files.size(); i++) {
+			pr.step(files[i].path.get_file(), i);
+			_reimport_file(files[i].path);
+		}
 	}
 
 	//reimport groups
@@ -2128,6 +2391,9 @@ EditorFileSystem::EditorFileSystem() {
 
 	ResourceLoader::import = _resource_import;
 	reimport_on_missing_imported_files = GLOBAL_DEF("editor/reimport_missing_imported_files", true);
+	import_threaded = GLOBAL_DEF("editor/import/use_multiple_threads", true);
+	import_max_threads = GLOBAL_DEF("editor/import/max_threads", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("editor/import/max_threads", PropertyInfo(Variant::INT, "editor/import/max_threads", PROPERTY_HINT_RANGE, "0,256,1,or_greater"));
 
 	singleton = this;
 	filesystem = memnew(EditorFileSystemDirectory); //like, empty
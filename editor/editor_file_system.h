@@ -31,11 +31,14 @@
 #ifndef EDITOR_FILE_SYSTEM_H
 #define EDITOR_FILE_SYSTEM_H
 
+#include "core/io/resource_importer.h"
 #include "core/os/dir_access.h"
 #include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/set.h"
 #include "scene/main/node.h"
+
+#include <atomic>
 class FileAccess;
 
 struct EditorProgressBG;
@@ -49,6 +52,7 @@ class EditorFileSystemDirectory : public Object {
 
 	EditorFileSystemDirectory *parent;
 	Vector<EditorFileSystemDirectory *> subdirs;
+	Vector<String> ignored_subdirs; //with a project.godot or .gdignore inside
 
 	struct FileInfo {
 		String file;
@@ -177,6 +181,17 @@ class EditorFileSystem : public Node {
 
 	HashMap<String, FileCache> file_cache;
 
+	/* Directory listings from the cache, reused while the directory is not modified */
+	struct DirCache {
+
+		uint64_t modification_time = 0;
+		Vector<String> subdirs;
+		Vector<String> files;
+	};
+
+	HashMap<String, DirCache> dir_cache;
+	uint64_t dir_cache_time = 0;
+
 	struct ScanProgress {
 
 		float low;
@@ -186,8 +201,10 @@ class EditorFileSystem : public Node {
 		ScanProgress get_sub(int p_current, int p_total) const;
 	};
 
+	String _get_extensions_signature() const;
+	void _load_filesystem_cache();
 	void _save_filesystem_cache();
-	void _save_filesystem_cache(EditorFileSystemDirectory *p_dir, FileAccess *p_file);
+	void _save_filesystem_cache(EditorFileSystemDirectory *p_dir, FileAccess *p_file, uint32_t &r_dir_count);
 
 	bool _find_file(const String &p_file, EditorFileSystemDirectory **r_d, int &r_file_pos) const;
 
@@ -213,12 +230,39 @@ class EditorFileSystem : public Node {
 
 	void _update_extensions();
 
+	struct ReimportData {
+		String path;
+		EditorFileSystemDirectory *fs = NULL;
+		int cpos = -1;
+		Ref<ResourceImporter> importer;
+		Map<StringName, Variant> params;
+		List<ResourceImporter::ImportOption> opts;
+		String base_path;
+		List<String> import_variants;
+		List<String> gen_files;
+		Variant metadata;
+		Error err = OK;
+	};
+
+	//imports are pulled from here by a bounded number of pool workers
+	struct ReimportQueue {
+		ReimportData **items = NULL;
+		uint32_t count = 0;
+		std::atomic<uint32_t> next;
+	};
+
+	bool _reimport_file_begin(const String &p_file, ReimportData &r_data);
+	void _reimport_file_import(uint32_t p_index, ReimportData **p_data);
+	void _reimport_queue_worker(uint32_t p_index, ReimportQueue *p_queue);
+	void _reimport_file_end(ReimportData &p_data);
 	void _reimport_file(const String &p_file);
 	Error _reimport_group(const String &p_group_file, const Vector<String> &p_files);
 
-	bool _test_for_reimport(const String &p_path, bool p_only_imported_files);
+	bool _test_for_reimport(const String &p_path, bool p_only_imported_files, const String &p_source_md5 = String());
 
 	bool reimport_on_missing_imported_files;
+	bool import_threaded;
+	int import_max_threads;
 
 	Vector<String> _get_dependencies(const String &p_path);
 
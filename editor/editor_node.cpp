@@ -42,6 +42,7 @@
 #include "core/os/file_access.h"
 #include "core/os/keyboard.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
 #include "core/path_remap.h"
 #include "core/print_string.h"
 #include "core/project_settings.h"
@@ -377,6 +378,7 @@ void EditorNode::_notification(int p_what) {
 			Engine::get_singleton()->set_editor_hint(true);
 
 			OS::get_singleton()->set_low_processor_usage_mode_sleep_usec(int(EDITOR_GET("interface/editor/low_processor_mode_sleep_usec")));
+			editor_data.get_undo_redo().set_max_history_memory(uint64_t(int(EDITOR_GET("interface/editor/undo_redo_max_memory_mb"))) << 20);
 			get_tree()->get_root()->set_as_audio_listener(false);
 			get_tree()->get_root()->set_as_audio_listener_2d(false);
 			get_tree()->set_auto_accept_quit(false);
@@ -447,6 +449,7 @@ void EditorNode::_notification(int p_what) {
 		} break;
 
 		case EditorSettings::NOTIFICATION_EDITOR_SETTINGS_CHANGED: {
+			editor_data.get_undo_redo().set_max_history_memory(uint64_t(int(EDITOR_GET("interface/editor/undo_redo_max_memory_mb"))) << 20);
 			scene_tabs->set_tab_close_display_policy((bool(EDITOR_GET("interface/scene_tabs/always_show_close_button")) ? Tabs::CLOSE_BUTTON_SHOW_ALWAYS : Tabs::CLOSE_BUTTON_SHOW_ACTIVE_ONLY));
 			theme = create_editor_theme(theme_base->get_theme());
 
@@ -3552,9 +3555,22 @@ void EditorNode::notify_all_debug_sessions_exited() {
 }
 
 void EditorNode::add_io_error(const String &p_error) {
+
+	if (Thread::get_caller_id() != Thread::get_main_id()) {
+		//importers may run on worker threads, the dialog can only be touched from the main one
+		Variant error = p_error;
+		const Variant *args[1] = { &error };
+		callable_mp(singleton, &EditorNode::_add_io_error_deferred).call_deferred(args, 1);
+		return;
+	}
 	_load_error_notify(singleton, p_error);
 }
 
+void EditorNode::_add_io_error_deferred(const String &p_error) {
+
+	_load_error_notify(this, p_error);
+}
+
 void EditorNode::_load_error_notify(void *p_ud, const String &p_text) {
 
 	EditorNode *en = (EditorNode *)p_ud;
@@ -511,6 +511,7 @@ private:
 	void _unhandled_input(const Ref<InputEvent> &p_event);
 
 	static void _load_error_notify(void *p_ud, const String &p_text);
+	void _add_io_error_deferred(const String &p_error);
 
 	bool has_main_screen() const { return true; }
 
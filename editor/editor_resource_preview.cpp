@@ -87,6 +87,11 @@ bool EditorResourcePreviewGenerator::can_generate_small_preview() const {
 	return false;
 }
 
+bool EditorResourcePreviewGenerator::is_thread_safe() const {
+
+	return false;
+}
+
 void EditorResourcePreviewGenerator::_bind_methods() {
 
 	ClassDB::add_virtual_method(get_class_static(), MethodInfo(Variant::BOOL, "handles", PropertyInfo(Variant::STRING, "type")));
@@ -160,6 +165,12 @@ void EditorResourcePreview::_generate_preview(Ref<ImageTexture> &r_texture, Ref<
 		if (!preview_generators[i]->handles(type))
 			continue;
 
+		//most generators render through a shared viewport, so only let through the ones that allow it
+		bool serialize = !preview_generators[i]->is_thread_safe();
+		if (serialize) {
+			generator_mutex.lock();
+		}
+
 		Ref<Texture2D> generated;
 		if (p_item.resource.is_valid()) {
 			generated = preview_generators[i]->generate(p_item.resource, Vector2(thumbnail_size, thumbnail_size));
@@ -181,6 +192,10 @@ void EditorResourcePreview::_generate_preview(Ref<ImageTexture> &r_texture, Ref<
 			r_small_texture = generated_small;
 		}
 
+		if (serialize) {
+			generator_mutex.unlock();
+		}
+
 		if (!r_small_texture.is_valid() && r_texture.is_valid() && preview_generators[i]->generate_small_preview_automatically()) {
 			Ref<Image> small_image = r_texture->get_data();
 			small_image = small_image->duplicate();
@@ -215,7 +230,6 @@ void EditorResourcePreview::_generate_preview(Ref<ImageTexture> &r_texture, Ref<
 
 void EditorResourcePreview::_thread() {
 
-	exited = false;
 	while (!exit) {
 
 		preview_sem.wait();
@@ -348,7 +362,7 @@ void EditorResourcePreview::_thread() {
 			preview_mutex.unlock();
 		}
 	}
-	exited = true;
+	atomic_increment(&threads_exited);
 }
 
 void EditorResourcePreview::queue_edited_resource_preview(const Ref<Resource> &p_res, Object *p_receiver, const StringName &p_receiver_func, const Variant &p_userdata) {
@@ -455,30 +469,41 @@ void EditorResourcePreview::check_for_invalidation(const String &p_path) {
 }
 
 void EditorResourcePreview::start() {
-	ERR_FAIL_COND_MSG(thread, "Thread already started.");
-	thread = Thread::create(_thread_func, this);
+	ERR_FAIL_COND_MSG(threads.size(), "Threads already started.");
+
+	exit = false;
+	threads_exited = 0;
+
+	//loading cached thumbnails is mostly disk and image decoding, so it pays to do several at once
+	int thread_count = CLAMP(OS::get_singleton()->get_processor_count() - 1, 1, int(MAX_PREVIEW_THREADS));
+	for (int i = 0; i < thread_count; i++) {
+		threads.push_back(Thread::create(_thread_func, this));
+	}
 }
 
 void EditorResourcePreview::stop() {
-	if (thread) {
+	if (threads.size()) {
 		exit = true;
-		preview_sem.post();
-		while (!exited) {
+		for (int i = 0; i < threads.size(); i++) {
+			preview_sem.post();
+		}
+		while (threads_exited < uint32_t(threads.size())) {
 			OS::get_singleton()->delay_usec(10000);
 			RenderingServer::get_singleton()->sync(); //sync pending stuff, as thread may be blocked on visual server
 		}
-		Thread::wait_to_finish(thread);
-		memdelete(thread);
-		thread = NULL;
+		for (int i = 0; i < threads.size(); i++) {
+			Thread::wait_to_finish(threads[i]);
+			memdelete(threads[i]);
+		}
+		threads.clear();
 	}
 }
 
 EditorResourcePreview::EditorResourcePreview() {
-	thread = NULL;
 	singleton = this;
 	order = 0;
 	exit = false;
-	exited = false;
+	threads_exited = 0;
 }
 
 EditorResourcePreview::~EditorResourcePreview() {
@@ -33,6 +33,7 @@
 
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
+#include "core/safe_refcount.h"
 #include "scene/main/node.h"
 #include "scene/resources/texture.h"
 
@@ -50,6 +51,8 @@ public:
 
 	virtual bool generate_small_preview_automatically() const;
 	virtual bool can_generate_small_preview() const;
+	//if true, the preview workers may call this generator concurrently instead of one at a time
+	virtual bool is_thread_safe() const;
 
 	EditorResourcePreviewGenerator();
 };
@@ -70,11 +73,16 @@ class EditorResourcePreview : public Node {
 
 	List<QueueItem> queue;
 
+	enum {
+		MAX_PREVIEW_THREADS = 4
+	};
+
 	Mutex preview_mutex;
+	Mutex generator_mutex; //held while calling generators that are not thread safe
 	Semaphore preview_sem;
-	Thread *thread;
+	Vector<Thread *> threads;
 	volatile bool exit;
-	volatile bool exited;
+	volatile uint32_t threads_exited;
 
 	struct Item {
 		Ref<Texture2D> preview;
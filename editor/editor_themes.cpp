@@ -31,6 +31,7 @@
 #include "editor_themes.h"
 
 #include "core/io/resource_loader.h"
+#include "core/thread_work_pool.h"
 #include "editor_fonts.h"
 #include "editor_icons.gen.h"
 #include "editor_scale.h"
@@ -85,21 +86,56 @@ static Ref<StyleBoxLine> make_line_stylebox(Color p_color, int p_thickness = 1,
 	return style;
 }
 
-Ref<ImageTexture> editor_generate_icon(int p_index, bool p_convert_color, float p_scale = EDSCALE, bool p_force_filter = false) {
+#ifdef MODULE_SVG_ENABLED
+struct EditorIconGenerator {
+	struct Icon {
+		int index;
+		bool convert_color;
+		float scale;
+		Ref<Image> image;
+	};
+
+	Vector<Icon> icons;
+
+	void add(int p_index, bool p_convert_color, float p_scale = EDSCALE) {
+		Icon icon;
+		icon.index = p_index;
+		icon.convert_color = p_convert_color;
+		icon.scale = p_scale;
+		icons.push_back(icon);
+	}
 
-	Ref<ImageTexture> icon = memnew(ImageTexture);
-	Ref<Image> img = memnew(Image);
+	void rasterize(uint32_t p_icon, void *p_userdata) {
+		Icon &icon = icons.write[p_icon];
+		icon.image.instance();
 
-	// Upsample icon generation only if the editor scale isn't an integer multiplier.
-	// Generating upsampled icons is slower, and the benefit is hardly visible
-	// with integer editor scales.
-	const bool upsample = !Math::is_equal_approx(Math::round(p_scale), p_scale);
-	ImageLoaderSVG::create_image_from_string(img, editor_icons_sources[p_index], p_scale, upsample, p_convert_color);
+		// Upsample icon generation only if the editor scale isn't an integer multiplier.
+		// Generating upsampled icons is slower, and the benefit is hardly visible
+		// with integer editor scales.
+		const bool upsample = !Math::is_equal_approx(Math::round(icon.scale), icon.scale);
+		ImageLoaderSVG::create_image_from_string(icon.image, editor_icons_sources[icon.index], icon.scale, upsample, icon.convert_color);
+	}
 
-	icon->create_from_image(img); // in this case filter really helps
+	// Rasterizes all icons on the work pool, then creates the textures and adds them to the theme.
+	void generate(Ref<Theme> p_theme) {
+		ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+		if (pool && pool->get_thread_count() > 0) {
+			icons.ptrw(); // Make sure the array is not shared while the tasks write to it.
+			pool->do_work(icons.size(), this, &EditorIconGenerator::rasterize, (void *)NULL);
+		} else {
+			for (int i = 0; i < icons.size(); i++) {
+				rasterize(i, NULL);
+			}
+		}
 
-	return icon;
-}
+		for (int i = 0; i < icons.size(); i++) {
+			Ref<ImageTexture> texture = memnew(ImageTexture);
+			texture->create_from_image(icons[i].image); // in this case filter really helps
+			p_theme->set_icon(editor_icons_names[icons[i].index], "EditorIcons", texture);
+		}
+	}
+};
+#endif
 
 #ifndef ADD_CONVERT_COLOR
 #define ADD_CONVERT_COLOR(dictionary, old_color, new_color) dictionary[Color::html(old_color)] = Color::html(new_color)
@@ -215,39 +251,36 @@ void editor_register_and_generate_icons(Ref<Theme> p_theme, bool p_dark_theme =
 
 	ImageLoaderSVG::set_convert_colors(&dark_icon_color_dictionary);
 
+	EditorIconGenerator generator;
+
 	// Generate icons.
 	if (!p_only_thumbs) {
 		for (int i = 0; i < editor_icons_count; i++) {
 			const int is_exception = exceptions.has(editor_icons_names[i]);
-			const Ref<ImageTexture> icon = editor_generate_icon(i, !is_exception);
-
-			p_theme->set_icon(editor_icons_names[i], "EditorIcons", icon);
+			generator.add(i, !is_exception);
 		}
 	}
 
 	// Generate thumbnail icons with the given thumbnail size.
-	// We don't need filtering when generating at one of the default resolutions.
-	const bool force_filter = p_thumb_size != 64 && p_thumb_size != 32;
 	if (p_thumb_size >= 64) {
 		const float scale = (float)p_thumb_size / 64.0 * EDSCALE;
 		for (int i = 0; i < editor_bg_thumbs_count; i++) {
 			const int index = editor_bg_thumbs_indices[i];
 			const int is_exception = exceptions.has(editor_icons_names[index]);
-			const Ref<ImageTexture> icon = editor_generate_icon(index, !p_dark_theme && !is_exception, scale, force_filter);
-
-			p_theme->set_icon(editor_icons_names[index], "EditorIcons", icon);
+			generator.add(index, !p_dark_theme && !is_exception, scale);
 		}
 	} else {
 		const float scale = (float)p_thumb_size / 32.0 * EDSCALE;
 		for (int i = 0; i < editor_md_thumbs_count; i++) {
 			const int index = editor_md_thumbs_indices[i];
 			const bool is_exception = exceptions.has(editor_icons_names[index]);
-			const Ref<ImageTexture> icon = editor_generate_icon(index, !p_dark_theme && !is_exception, scale, force_filter);
-
-			p_theme->set_icon(editor_icons_names[index], "EditorIcons", icon);
+			generator.add(index, !p_dark_theme && !is_exception, scale);
 		}
 	}
 
+	// The color replacements must stay the same until all icons are rasterized.
+	generator.generate(p_theme);
+
 	ImageLoaderSVG::set_convert_colors(NULL);
 #else
 	WARN_PRINT("SVG support disabled, editor icons won't be rendered.");
@@ -32,10 +32,12 @@
 
 #include "core/crypto/crypto_core.h"
 #include "core/io/json.h"
+#include "core/local_vector.h"
 #include "core/math/disjoint_set.h"
 #include "core/math/math_defs.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
+#include "core/thread_work_pool.h"
 #include "modules/regex/regex.h"
 #include "scene/3d/bone_attachment_3d.h"
 #include "scene/3d/camera_3d.h"
@@ -564,7 +566,31 @@ String EditorSceneImporterGLTF::_get_type_name(const GLTFType p_component) {
 	return names[p_component];
 }
 
-Error EditorSceneImporterGLTF::_decode_buffer_view(GLTFState &state, double *dst, const GLTFBufferViewIndex p_buffer_view, const int skip_every, const int skip_bytes, const int element_size, const int count, const GLTFType type, const int component_count, const int component_type, const int component_size, const bool normalized, const int byte_offset, const bool for_vertex) {
+template <class S, class T>
+static void _decode_components(const uint8_t *p_src, T *p_dst, int p_count, int p_stride, int p_component_count, int p_skip_every, int p_skip_bytes, double p_normalize) {
+
+	for (int i = 0; i < p_count; i++) {
+
+		const uint8_t *src = p_src + i * p_stride;
+
+		for (int j = 0; j < p_component_count; j++) {
+
+			if (p_skip_every && j > 0 && (j % p_skip_every) == 0) {
+				src += p_skip_bytes;
+			}
+
+			S s;
+			memcpy(&s, src, sizeof(S));
+			double d = p_normalize > 0 ? double(s) / p_normalize : double(s);
+
+			*p_dst++ = T(d);
+			src += sizeof(S);
+		}
+	}
+}
+
+template <class T>
+Error EditorSceneImporterGLTF::_decode_buffer_view(GLTFState &state, T *dst, const GLTFBufferViewIndex p_buffer_view, const int skip_every, const int skip_bytes, const int element_size, const int count, const GLTFType type, const int component_count, const int component_type, const int component_size, const bool normalized, const int byte_offset, const bool for_vertex) {
 
 	const GLTFBufferView &bv = state.buffer_views[p_buffer_view];
 
@@ -576,7 +602,7 @@ Error EditorSceneImporterGLTF::_decode_buffer_view(GLTFState &state, double *dst
 	ERR_FAIL_INDEX_V(bv.buffer, state.buffers.size(), ERR_PARSE_ERROR);
 
 	const uint32_t offset = bv.byte_offset + byte_offset;
-	Vector<uint8_t> buffer = state.buffers[bv.buffer]; //copy on write, so no performance hit
+	const Vector<uint8_t> &buffer = state.buffers[bv.buffer];
 	const uint8_t *bufptr = buffer.ptr();
 
 	//use to debug
@@ -588,65 +614,29 @@ Error EditorSceneImporterGLTF::_decode_buffer_view(GLTFState &state, double *dst
 
 	ERR_FAIL_COND_V((int)(offset + buffer_end) > buffer.size(), ERR_PARSE_ERROR);
 
-	//fill everything as doubles
-
-	for (int i = 0; i < count; i++) {
-
-		const uint8_t *src = &bufptr[offset + i * stride];
-
-		for (int j = 0; j < component_count; j++) {
-
-			if (skip_every && j > 0 && (j % skip_every) == 0) {
-				src += skip_bytes;
-			}
+	//values still go through double, so they convert exactly as before, but straight into the destination type
 
-			double d = 0;
+	const uint8_t *src = &bufptr[offset];
 
-			switch (component_type) {
-				case COMPONENT_TYPE_BYTE: {
-					int8_t b = int8_t(*src);
-					if (normalized) {
-						d = (double(b) / 128.0);
-					} else {
-						d = double(b);
-					}
-				} break;
-				case COMPONENT_TYPE_UNSIGNED_BYTE: {
-					uint8_t b = *src;
-					if (normalized) {
-						d = (double(b) / 255.0);
-					} else {
-						d = double(b);
-					}
-				} break;
-				case COMPONENT_TYPE_SHORT: {
-					int16_t s = *(int16_t *)src;
-					if (normalized) {
-						d = (double(s) / 32768.0);
-					} else {
-						d = double(s);
-					}
-				} break;
-				case COMPONENT_TYPE_UNSIGNED_SHORT: {
-					uint16_t s = *(uint16_t *)src;
-					if (normalized) {
-						d = (double(s) / 65535.0);
-					} else {
-						d = double(s);
-					}
-
-				} break;
-				case COMPONENT_TYPE_INT: {
-					d = *(int *)src;
-				} break;
-				case COMPONENT_TYPE_FLOAT: {
-					d = *(float *)src;
-				} break;
-			}
-
-			*dst++ = d;
-			src += component_size;
-		}
+	switch (component_type) {
+		case COMPONENT_TYPE_BYTE: {
+			_decode_components<int8_t>(src, dst, count, stride, component_count, skip_every, skip_bytes, normalized ? 128.0 : 0.0);
+		} break;
+		case COMPONENT_TYPE_UNSIGNED_BYTE: {
+			_decode_components<uint8_t>(src, dst, count, stride, component_count, skip_every, skip_bytes, normalized ? 255.0 : 0.0);
+		} break;
+		case COMPONENT_TYPE_SHORT: {
+			_decode_components<int16_t>(src, dst, count, stride, component_count, skip_every, skip_bytes, normalized ? 32768.0 : 0.0);
+		} break;
+		case COMPONENT_TYPE_UNSIGNED_SHORT: {
+			_decode_components<uint16_t>(src, dst, count, stride, component_count, skip_every, skip_bytes, normalized ? 65535.0 : 0.0);
+		} break;
+		case COMPONENT_TYPE_INT: {
+			_decode_components<int32_t>(src, dst, count, stride, component_count, skip_every, skip_bytes, 0.0);
+		} break;
+		case COMPONENT_TYPE_FLOAT: {
+			_decode_components<float>(src, dst, count, stride, component_count, skip_every, skip_bytes, 0.0);
+		} break;
 	}
 
 	return OK;
@@ -668,12 +658,13 @@ int EditorSceneImporterGLTF::_get_component_type_size(const int component_type)
 	return 0;
 }
 
-Vector<double> EditorSceneImporterGLTF::_decode_accessor(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
+template <class E, class T>
+Vector<E> EditorSceneImporterGLTF::_decode_accessor(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
 	//spec, for reference:
 	//https://github.com/KhronosGroup/glTF/tree/master/specification/2.0#data-alignment
 
-	ERR_FAIL_INDEX_V(p_accessor, state.accessors.size(), Vector<double>());
+	ERR_FAIL_INDEX_V(p_accessor, state.accessors.size(), Vector<E>());
 
 	const GLTFAccessor &a = state.accessors[p_accessor];
 
@@ -683,7 +674,7 @@ Vector<double> EditorSceneImporterGLTF::_decode_accessor(GLTFState &state, const
 
 	const int component_count = component_count_for_type[a.type];
 	const int component_size = _get_component_type_size(a.component_type);
-	ERR_FAIL_COND_V(component_size == 0, Vector<double>());
+	ERR_FAIL_COND_V(component_size == 0, Vector<E>());
 	int element_size = component_count * component_size;
 
 	int skip_every = 0;
@@ -717,43 +708,48 @@ Vector<double> EditorSceneImporterGLTF::_decode_accessor(GLTFState &state, const
 		}
 	}
 
-	Vector<double> dst_buffer;
-	dst_buffer.resize(component_count * a.count);
-	double *dst = dst_buffer.ptrw();
+	//components are written straight into the returned array, each element of E takes sizeof(E) / sizeof(T) of them
+	const int total_components = component_count * a.count;
+	ERR_FAIL_COND_V((total_components * sizeof(T)) % sizeof(E) != 0, Vector<E>());
+
+	Vector<E> dst_buffer;
+	dst_buffer.resize(total_components * sizeof(T) / sizeof(E));
+	T *dst = (T *)dst_buffer.ptrw();
 
 	if (a.buffer_view >= 0) {
 
-		ERR_FAIL_INDEX_V(a.buffer_view, state.buffer_views.size(), Vector<double>());
+		ERR_FAIL_INDEX_V(a.buffer_view, state.buffer_views.size(), Vector<E>());
 
 		const Error err = _decode_buffer_view(state, dst, a.buffer_view, skip_every, skip_bytes, element_size, a.count, a.type, component_count, a.component_type, component_size, a.normalized, a.byte_offset, p_for_vertex);
 		if (err != OK)
-			return Vector<double>();
+			return Vector<E>();
 
 	} else {
 		//fill with zeros, as bufferview is not defined.
-		for (int i = 0; i < (a.count * component_count); i++) {
-			dst_buffer.write[i] = 0;
+		for (int i = 0; i < total_components; i++) {
+			dst[i] = 0;
 		}
 	}
 
 	if (a.sparse_count > 0) {
 		// I could not find any file using this, so this code is so far untested
-		Vector<double> indices;
+		Vector<int> indices;
 		indices.resize(a.sparse_count);
 		const int indices_component_size = _get_component_type_size(a.sparse_indices_component_type);
 
 		Error err = _decode_buffer_view(state, indices.ptrw(), a.sparse_indices_buffer_view, 0, 0, indices_component_size, a.sparse_count, TYPE_SCALAR, 1, a.sparse_indices_component_type, indices_component_size, false, a.sparse_indices_byte_offset, false);
 		if (err != OK)
-			return Vector<double>();
+			return Vector<E>();
 
-		Vector<double> data;
+		Vector<T> data;
 		data.resize(component_count * a.sparse_count);
 		err = _decode_buffer_view(state, data.ptrw(), a.sparse_values_buffer_view, skip_every, skip_bytes, element_size, a.sparse_count, a.type, component_count, a.component_type, component_size, a.normalized, a.sparse_values_byte_offset, p_for_vertex);
 		if (err != OK)
-			return Vector<double>();
+			return Vector<E>();
 
 		for (int i = 0; i < indices.size(); i++) {
-			const int write_offset = int(indices[i]) * component_count;
+			ERR_CONTINUE(indices[i] < 0 || indices[i] >= a.count);
+			const int write_offset = indices[i] * component_count;
 
 			for (int j = 0; j < component_count; j++) {
 				dst[write_offset + j] = data[i * component_count + j];
@@ -766,109 +762,49 @@ Vector<double> EditorSceneImporterGLTF::_decode_accessor(GLTFState &state, const
 
 Vector<int> EditorSceneImporterGLTF::_decode_accessor_as_ints(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
-	Vector<int> ret;
-
-	if (attribs.size() == 0)
-		return ret;
-
-	const double *attribs_ptr = attribs.ptr();
-	const int ret_size = attribs.size();
-	ret.resize(ret_size);
-	{
-		int *w = ret.ptrw();
-		for (int i = 0; i < ret_size; i++) {
-			w[i] = int(attribs_ptr[i]);
-		}
-	}
-	return ret;
+	return _decode_accessor<int, int>(state, p_accessor, p_for_vertex);
 }
 
 Vector<float> EditorSceneImporterGLTF::_decode_accessor_as_floats(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
-	Vector<float> ret;
-
-	if (attribs.size() == 0)
-		return ret;
-
-	const double *attribs_ptr = attribs.ptr();
-	const int ret_size = attribs.size();
-	ret.resize(ret_size);
-	{
-		float *w = ret.ptrw();
-		for (int i = 0; i < ret_size; i++) {
-			w[i] = float(attribs_ptr[i]);
-		}
-	}
-	return ret;
+	return _decode_accessor<float, float>(state, p_accessor, p_for_vertex);
 }
 
 Vector<Vector2> EditorSceneImporterGLTF::_decode_accessor_as_vec2(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
-	Vector<Vector2> ret;
-
-	if (attribs.size() == 0)
-		return ret;
-
-	ERR_FAIL_COND_V(attribs.size() % 2 != 0, ret);
-	const double *attribs_ptr = attribs.ptr();
-	const int ret_size = attribs.size() / 2;
-	ret.resize(ret_size);
-	{
-		Vector2 *w = ret.ptrw();
-		for (int i = 0; i < ret_size; i++) {
-			w[i] = Vector2(attribs_ptr[i * 2 + 0], attribs_ptr[i * 2 + 1]);
-		}
-	}
-	return ret;
+	return _decode_accessor<Vector2, real_t>(state, p_accessor, p_for_vertex);
 }
 
 Vector<Vector3> EditorSceneImporterGLTF::_decode_accessor_as_vec3(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
-	Vector<Vector3> ret;
-
-	if (attribs.size() == 0)
-		return ret;
-
-	ERR_FAIL_COND_V(attribs.size() % 3 != 0, ret);
-	const double *attribs_ptr = attribs.ptr();
-	const int ret_size = attribs.size() / 3;
-	ret.resize(ret_size);
-	{
-		Vector3 *w = ret.ptrw();
-		for (int i = 0; i < ret_size; i++) {
-			w[i] = Vector3(attribs_ptr[i * 3 + 0], attribs_ptr[i * 3 + 1], attribs_ptr[i * 3 + 2]);
-		}
-	}
-	return ret;
+	return _decode_accessor<Vector3, real_t>(state, p_accessor, p_for_vertex);
 }
 
 Vector<Color> EditorSceneImporterGLTF::_decode_accessor_as_color(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
 	Vector<Color> ret;
 
-	if (attribs.size() == 0)
-		return ret;
-
+	ERR_FAIL_INDEX_V(p_accessor, state.accessors.size(), ret);
 	const int type = state.accessors[p_accessor].type;
 	ERR_FAIL_COND_V(!(type == TYPE_VEC3 || type == TYPE_VEC4), ret);
-	int vec_len = 3;
+
 	if (type == TYPE_VEC4) {
-		vec_len = 4;
+		return _decode_accessor<Color, float>(state, p_accessor, p_for_vertex);
 	}
 
-	ERR_FAIL_COND_V(attribs.size() % vec_len != 0, ret);
-	const double *attribs_ptr = attribs.ptr();
-	const int ret_size = attribs.size() / vec_len;
+	const Vector<float> attribs = _decode_accessor<float, float>(state, p_accessor, p_for_vertex);
+
+	if (attribs.size() == 0)
+		return ret;
+
+	ERR_FAIL_COND_V(attribs.size() % 3 != 0, ret);
+	const float *attribs_ptr = attribs.ptr();
+	const int ret_size = attribs.size() / 3;
 	ret.resize(ret_size);
 	{
 		Color *w = ret.ptrw();
 		for (int i = 0; i < ret_size; i++) {
-			w[i] = Color(attribs_ptr[i * vec_len + 0], attribs_ptr[i * vec_len + 1], attribs_ptr[i * vec_len + 2], vec_len == 4 ? attribs_ptr[i * 4 + 3] : 1.0);
+			w[i] = Color(attribs_ptr[i * 3 + 0], attribs_ptr[i * 3 + 1], attribs_ptr[i * 3 + 2], 1.0);
 		}
 	}
 	return ret;
@@ -876,26 +812,17 @@ Vector<Color> EditorSceneImporterGLTF::_decode_accessor_as_color(GLTFState &stat
 
 Vector<Quat> EditorSceneImporterGLTF::_decode_accessor_as_quat(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
-	Vector<Quat> ret;
-
-	if (attribs.size() == 0)
-		return ret;
+	Vector<Quat> ret = _decode_accessor<Quat, real_t>(state, p_accessor, p_for_vertex);
 
-	ERR_FAIL_COND_V(attribs.size() % 4 != 0, ret);
-	const double *attribs_ptr = attribs.ptr();
-	const int ret_size = attribs.size() / 4;
-	ret.resize(ret_size);
-	{
-		for (int i = 0; i < ret_size; i++) {
-			ret.write[i] = Quat(attribs_ptr[i * 4 + 0], attribs_ptr[i * 4 + 1], attribs_ptr[i * 4 + 2], attribs_ptr[i * 4 + 3]).normalized();
-		}
+	Quat *w = ret.ptrw();
+	for (int i = 0; i < ret.size(); i++) {
+		w[i] = w[i].normalized();
 	}
 	return ret;
 }
 Vector<Transform2D> EditorSceneImporterGLTF::_decode_accessor_as_xform2d(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
+	const Vector<real_t> attribs = _decode_accessor<real_t, real_t>(state, p_accessor, p_for_vertex);
 	Vector<Transform2D> ret;
 
 	if (attribs.size() == 0)
@@ -912,7 +839,7 @@ Vector<Transform2D> EditorSceneImporterGLTF::_decode_accessor_as_xform2d(GLTFSta
 
 Vector<Basis> EditorSceneImporterGLTF::_decode_accessor_as_basis(GLTFState &state, const GLTFAccessorIndex p_accessor, bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
+	const Vector<real_t> attribs = _decode_accessor<real_t, real_t>(state, p_accessor, p_for_vertex);
 	Vector<Basis> ret;
 
 	if (attribs.size() == 0)
@@ -930,7 +857,7 @@ Vector<Basis> EditorSceneImporterGLTF::_decode_accessor_as_basis(GLTFState &stat
 
 Vector<Transform> EditorSceneImporterGLTF::_decode_accessor_as_xform(GLTFState &state, const GLTFAccessorIndex p_accessor, const bool p_for_vertex) {
 
-	const Vector<double> attribs = _decode_accessor(state, p_accessor, p_for_vertex);
+	const Vector<real_t> attribs = _decode_accessor<real_t, real_t>(state, p_accessor, p_for_vertex);
 	Vector<Transform> ret;
 
 	if (attribs.size() == 0)
@@ -1222,7 +1149,7 @@ Error EditorSceneImporterGLTF::_parse_meshes(GLTFState &state) {
 			}
 
 			//just add it
-			mesh.mesh->add_surface_from_arrays(primitive, array, morphs);
+			mesh.mesh->add_surface_from_arrays(primitive, array, morphs, Dictionary(), state.use_compression ? IMPORT_MESH_COMPRESS_FLAGS : 0);
 
 			if (p.has("material")) {
 				const int material = p["material"];
@@ -1250,39 +1177,62 @@ Error EditorSceneImporterGLTF::_parse_meshes(GLTFState &state) {
 	return OK;
 }
 
+struct _GLTFImageDecoder {
+
+	struct Item {
+		Vector<uint8_t> data;
+		const uint8_t *data_ptr = NULL;
+		int data_size = 0;
+		ImageMemLoadFunc loader = NULL;
+		Ref<Image> image;
+		Ref<Texture2D> texture;
+	};
+
+	LocalVector<Item> items;
+
+	void decode(uint32_t p_index, void *p_userdata) {
+		Item &item = items[p_index];
+		if (item.loader) {
+			item.image = item.loader(item.data_ptr, item.data_size);
+		}
+	}
+};
+
 Error EditorSceneImporterGLTF::_parse_images(GLTFState &state, const String &p_base_path) {
 
 	if (!state.json.has("images"))
 		return OK;
 
+	//find the data of every image first, then decode them all at once
+
+	_GLTFImageDecoder decoder;
+
 	const Array &images = state.json["images"];
+	decoder.items.resize(images.size());
+
 	for (int i = 0; i < images.size(); i++) {
 
 		const Dictionary &d = images[i];
+		_GLTFImageDecoder::Item &item = decoder.items[i];
 
 		String mimetype;
 		if (d.has("mimeType")) {
 			mimetype = d["mimeType"];
 		}
 
-		Vector<uint8_t> data;
-		const uint8_t *data_ptr = NULL;
-		int data_size = 0;
-
 		if (d.has("uri")) {
 			String uri = d["uri"];
 
 			if (uri.findn("data:application/octet-stream;base64") == 0 ||
 					uri.findn("data:" + mimetype + ";base64") == 0) {
 				//embedded data
-				data = _parse_base64_uri(uri);
-				data_ptr = data.ptr();
-				data_size = data.size();
+				item.data = _parse_base64_uri(uri);
+				item.data_ptr = item.data.ptr();
+				item.data_size = item.data.size();
 			} else {
 
 				uri = p_base_path.plus_file(uri).replace("\\", "/"); //fix for windows
-				Ref<Texture2D> texture = ResourceLoader::load(uri);
-				state.images.push_back(texture);
+				item.texture = ResourceLoader::load(uri);
 				continue;
 			}
 		}
@@ -1299,8 +1249,8 @@ Error EditorSceneImporterGLTF::_parse_images(GLTFState &state, const String &p_b
 
 			ERR_FAIL_COND_V(bv.byte_offset + bv.byte_length > state.buffers[bi].size(), ERR_FILE_CORRUPT);
 
-			data_ptr = &state.buffers[bi][bv.byte_offset];
-			data_size = bv.byte_length;
+			item.data_ptr = &state.buffers[bi][bv.byte_offset];
+			item.data_size = bv.byte_length;
 		}
 
 		ERR_FAIL_COND_V(mimetype == "", ERR_FILE_CORRUPT);
@@ -1308,37 +1258,47 @@ Error EditorSceneImporterGLTF::_parse_images(GLTFState &state, const String &p_b
 		if (mimetype.findn("png") != -1) {
 			//is a png
 			ERR_FAIL_COND_V(Image::_png_mem_loader_func == NULL, ERR_UNAVAILABLE);
-
-			const Ref<Image> img = Image::_png_mem_loader_func(data_ptr, data_size);
-
-			ERR_FAIL_COND_V(img.is_null(), ERR_FILE_CORRUPT);
-
-			Ref<ImageTexture> t;
-			t.instance();
-			t->create_from_image(img);
-
-			state.images.push_back(t);
+			item.loader = Image::_png_mem_loader_func;
 			continue;
 		}
 
 		if (mimetype.findn("jpeg") != -1) {
 			//is a jpg
 			ERR_FAIL_COND_V(Image::_jpg_mem_loader_func == NULL, ERR_UNAVAILABLE);
+			item.loader = Image::_jpg_mem_loader_func;
+			continue;
+		}
+
+		ERR_FAIL_V(ERR_FILE_CORRUPT);
+	}
 
-			const Ref<Image> img = Image::_jpg_mem_loader_func(data_ptr, data_size);
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0 && decoder.items.size() > 1) {
+		pool->do_work(decoder.items.size(), &decoder, &_GLTFImageDecoder::decode, (void *)NULL);
+	} else {
+		for (uint32_t i = 0; i < decoder.items.size(); i++) {
+			decoder.decode(i, NULL);
+		}
+	}
 
-			ERR_FAIL_COND_V(img.is_null(), ERR_FILE_CORRUPT);
+	//textures are created here, as they allocate rendering server resources
 
-			Ref<ImageTexture> t;
-			t.instance();
-			t->create_from_image(img);
+	for (uint32_t i = 0; i < decoder.items.size(); i++) {
 
-			state.images.push_back(t);
+		_GLTFImageDecoder::Item &item = decoder.items[i];
 
+		if (!item.loader) {
+			state.images.push_back(item.texture);
 			continue;
 		}
 
-		ERR_FAIL_V(ERR_FILE_CORRUPT);
+		ERR_FAIL_COND_V(item.image.is_null(), ERR_FILE_CORRUPT);
+
+		Ref<ImageTexture> t;
+		t.instance();
+		t->create_from_image(item.image);
+
+		state.images.push_back(t);
 	}
 
 	print_verbose("Total images: " + itos(state.images.size()));
@@ -3004,6 +2964,7 @@ Node *EditorSceneImporterGLTF::import_scene(const String &p_path, uint32_t p_fla
 	state.major_version = version.get_slice(".", 0).to_int();
 	state.minor_version = version.get_slice(".", 1).to_int();
 	state.use_named_skin_binds = p_flags & IMPORT_USE_NAMED_SKIN_BINDS;
+	state.use_compression = p_flags & IMPORT_USE_COMPRESSION;
 
 	/* STEP 0 PARSE SCENE */
 	Error err = _parse_scenes(state);
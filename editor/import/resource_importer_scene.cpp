@@ -31,6 +31,8 @@
 #include "resource_importer_scene.h"
 
 #include "core/io/resource_saver.h"
+#include "core/local_vector.h"
+#include "core/thread_work_pool.h"
 #include "editor/editor_node.h"
 #include "scene/3d/collision_shape_3d.h"
 #include "scene/3d/mesh_instance_3d.h"
@@ -276,7 +278,7 @@ static String _fixstr(const String &p_what, const String &p_str) {
 	return what;
 }
 
-static void _gen_shape_list(const Ref<Mesh> &mesh, List<Ref<Shape3D>> &r_shape_list, bool p_convex) {
+static void _gen_shape_list(const Ref<Mesh> &mesh, List<Ref<Shape3D>> &r_shape_list, bool p_convex, const Map<Ref<Mesh>, Vector<Ref<Shape3D>>> &p_convex_shapes) {
 
 	if (!p_convex) {
 
@@ -284,7 +286,8 @@ static void _gen_shape_list(const Ref<Mesh> &mesh, List<Ref<Shape3D>> &r_shape_l
 		r_shape_list.push_back(shape);
 	} else {
 
-		Vector<Ref<Shape3D>> cd = mesh->convex_decompose();
+		const Map<Ref<Mesh>, Vector<Ref<Shape3D>>>::Element *E = p_convex_shapes.find(mesh);
+		Vector<Ref<Shape3D>> cd = E ? E->get() : mesh->convex_decompose();
 		if (cd.size()) {
 			for (int i = 0; i < cd.size(); i++) {
 				r_shape_list.push_back(cd[i]);
@@ -293,12 +296,103 @@ static void _gen_shape_list(const Ref<Mesh> &mesh, List<Ref<Shape3D>> &r_shape_l
 	}
 }
 
-Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<Mesh>, List<Ref<Shape3D>>> &collision_map, LightBakeMode p_light_bake_mode) {
+static void _find_convex_meshes(Node *p_node, Set<Ref<Mesh>> &r_meshes) {
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_find_convex_meshes(p_node->get_child(i), r_meshes);
+	}
+
+	MeshInstance3D *mi = Object::cast_to<MeshInstance3D>(p_node);
+	if (!mi || mi->get_mesh().is_null()) {
+		return;
+	}
+
+	// Same suffixes _fix_node() decomposes for. Overlapping matches only cost time, as
+	// _fix_node() still decides which shapes are used.
+	String name = p_node->get_name();
+	if (_teststr(name, "convcolonly") || _teststr(name, "convcol") || _teststr(name, "rigid") || _teststr(mi->get_mesh()->get_name(), "convcol")) {
+		r_meshes.insert(mi->get_mesh());
+	}
+}
+
+struct _ConvexDecomposer {
+
+	LocalVector<Vector<Face3>> faces;
+	LocalVector<Vector<Vector<Face3>>> hulls;
+
+	void decompose(uint32_t p_index, void *p_userdata) {
+		hulls[p_index] = Mesh::convex_composition_function(faces[p_index]);
+	}
+};
+
+void ResourceImporterScene::_generate_convex_shapes(Node *p_scene, Map<Ref<Mesh>, Vector<Ref<Shape3D>>> &r_convex_shapes) {
+
+	if (!Mesh::convex_composition_function) {
+		return;
+	}
+
+	Set<Ref<Mesh>> meshes;
+	_find_convex_meshes(p_scene, meshes);
+	if (meshes.empty()) {
+		return;
+	}
+
+	// Meshes with the same faces (duplicated resources, instanced sub scenes) are decomposed once.
+	_ConvexDecomposer decomposer;
+	Map<uint32_t, uint32_t> face_hashes;
+	Map<Ref<Mesh>, uint32_t> mesh_jobs;
+
+	for (Set<Ref<Mesh>>::Element *E = meshes.front(); E; E = E->next()) {
+
+		Vector<Face3> faces = E->get()->get_faces();
+		uint32_t hash = hash_djb2_buffer((const uint8_t *)faces.ptr(), faces.size() * sizeof(Face3));
+
+		const Map<uint32_t, uint32_t>::Element *F = face_hashes.find(hash);
+		if (F) {
+			const Vector<Face3> &other = decomposer.faces[F->get()];
+			if (other.size() == faces.size() && memcmp(other.ptr(), faces.ptr(), faces.size() * sizeof(Face3)) == 0) {
+				mesh_jobs[E->get()] = F->get();
+				continue;
+			}
+		}
+
+		uint32_t job = decomposer.faces.size();
+		decomposer.faces.push_back(faces);
+		if (!F) {
+			face_hashes[hash] = job;
+		}
+		mesh_jobs[E->get()] = job;
+	}
+
+	decomposer.hulls.resize(decomposer.faces.size());
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0 && decomposer.faces.size() > 1) {
+		pool->do_work(decomposer.faces.size(), &decomposer, &_ConvexDecomposer::decompose, (void *)NULL);
+	} else {
+		for (uint32_t i = 0; i < decomposer.faces.size(); i++) {
+			decomposer.decompose(i, NULL);
+		}
+	}
+
+	// Shapes are created here, as they allocate physics server resources.
+	LocalVector<Vector<Ref<Shape3D>>> shapes;
+	shapes.resize(decomposer.hulls.size());
+	for (uint32_t i = 0; i < decomposer.hulls.size(); i++) {
+		shapes[i] = Mesh::create_convex_shapes(decomposer.hulls[i]);
+	}
+
+	for (Map<Ref<Mesh>, uint32_t>::Element *E = mesh_jobs.front(); E; E = E->next()) {
+		r_convex_shapes[E->key()] = shapes[E->get()];
+	}
+}
+
+Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<Mesh>, List<Ref<Shape3D>>> &collision_map, const Map<Ref<Mesh>, Vector<Ref<Shape3D>>> &p_convex_shapes, LightBakeMode p_light_bake_mode) {
 
 	// children first
 	for (int i = 0; i < p_node->get_child_count(); i++) {
 
-		Node *r = _fix_node(p_node->get_child(i), p_root, collision_map, p_light_bake_mode);
+		Node *r = _fix_node(p_node->get_child(i), p_root, collision_map, p_convex_shapes, p_light_bake_mode);
 		if (!r) {
 			i--; //was erased
 		}
@@ -387,10 +481,10 @@ Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<Mesh>
 				if (collision_map.has(mesh)) {
 					shapes = collision_map[mesh];
 				} else if (_teststr(name, "colonly")) {
-					_gen_shape_list(mesh, shapes, false);
+					_gen_shape_list(mesh, shapes, false, p_convex_shapes);
 					collision_map[mesh] = shapes;
 				} else if (_teststr(name, "convcolonly")) {
-					_gen_shape_list(mesh, shapes, true);
+					_gen_shape_list(mesh, shapes, true, p_convex_shapes);
 					collision_map[mesh] = shapes;
 				}
 
@@ -472,7 +566,7 @@ Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<Mesh>
 			if (collision_map.has(mesh)) {
 				shapes = collision_map[mesh];
 			} else {
-				_gen_shape_list(mesh, shapes, true);
+				_gen_shape_list(mesh, shapes, true, p_convex_shapes);
 			}
 
 			RigidBody3D *rigid_body = memnew(RigidBody3D);
@@ -510,10 +604,10 @@ Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<Mesh>
 			if (collision_map.has(mesh)) {
 				shapes = collision_map[mesh];
 			} else if (_teststr(name, "col")) {
-				_gen_shape_list(mesh, shapes, false);
+				_gen_shape_list(mesh, shapes, false, p_convex_shapes);
 				collision_map[mesh] = shapes;
 			} else if (_teststr(name, "convcol")) {
-				_gen_shape_list(mesh, shapes, true);
+				_gen_shape_list(mesh, shapes, true, p_convex_shapes);
 				collision_map[mesh] = shapes;
 			}
 
@@ -622,11 +716,11 @@ Node *ResourceImporterScene::_fix_node(Node *p_node, Node *p_root, Map<Ref<Mesh>
 			if (collision_map.has(mesh)) {
 				shapes = collision_map[mesh];
 			} else if (_teststr(mesh->get_name(), "col")) {
-				_gen_shape_list(mesh, shapes, false);
+				_gen_shape_list(mesh, shapes, false, p_convex_shapes);
 				collision_map[mesh] = shapes;
 				mesh->set_name(_fixstr(mesh->get_name(), "col"));
 			} else if (_teststr(mesh->get_name(), "convcol")) {
-				_gen_shape_list(mesh, shapes, true);
+				_gen_shape_list(mesh, shapes, true, p_convex_shapes);
 				collision_map[mesh] = shapes;
 				mesh->set_name(_fixstr(mesh->get_name(), "convcol"));
 			}
@@ -913,6 +1007,24 @@ void ResourceImporterScene::_optimize_animations(Node *scene, float p_max_lin_er
 	}
 }
 
+void ResourceImporterScene::_compress_animations(Node *scene) {
+
+	if (!scene->has_node(String("AnimationPlayer")))
+		return;
+	Node *n = scene->get_node(String("AnimationPlayer"));
+	ERR_FAIL_COND(!n);
+	AnimationPlayer *anim = Object::cast_to<AnimationPlayer>(n);
+	ERR_FAIL_COND(!anim);
+
+	List<StringName> anim_names;
+	anim->get_animation_list(&anim_names);
+	for (List<StringName>::Element *E = anim_names.front(); E; E = E->next()) {
+
+		Ref<Animation> a = anim->get_animation(E->get());
+		a->compress();
+	}
+}
+
 static String _make_extname(const String &p_str) {
 
 	String ext_name = p_str.replace(".", "_");
@@ -1168,6 +1280,7 @@ void ResourceImporterScene::get_import_options(List<ImportOption> *r_options, in
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "materials/keep_on_reimport"), materials_out));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "meshes/compress"), true));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "meshes/ensure_tangents"), true));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "meshes/generate_lods"), true));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "meshes/storage", PROPERTY_HINT_ENUM, "Built-In,Files (.mesh),Files (.tres)"), meshes_out ? 1 : 0));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "meshes/light_baking", PROPERTY_HINT_ENUM, "Disabled,Enable,Gen Lightmaps", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), 0));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "meshes/lightmap_texel_size", PROPERTY_HINT_RANGE, "0.001,100,0.001"), 0.1));
@@ -1183,6 +1296,7 @@ void ResourceImporterScene::get_import_options(List<ImportOption> *r_options, in
 	r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "animation/optimizer/max_angular_error"), 0.01));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "animation/optimizer/max_angle"), 22));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "animation/optimizer/remove_unused_tracks"), true));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "animation/compression/enabled"), false));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "animation/clips/amount", PROPERTY_HINT_RANGE, "0,256,1", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), 0));
 	for (int i = 0; i < 256; i++) {
 		r_options->push_back(ImportOption(PropertyInfo(Variant::STRING, "animation/clip_" + itos(i + 1) + "/name"), ""));
@@ -1369,8 +1483,10 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 	int light_bake_mode = p_options["meshes/light_baking"];
 
 	Map<Ref<Mesh>, List<Ref<Shape3D>>> collision_map;
+	Map<Ref<Mesh>, Vector<Ref<Shape3D>>> convex_shapes;
 
-	scene = _fix_node(scene, scene, collision_map, LightBakeMode(light_bake_mode));
+	_generate_convex_shapes(scene, convex_shapes);
+	scene = _fix_node(scene, scene, collision_map, convex_shapes, LightBakeMode(light_bake_mode));
 
 	if (use_optimizer) {
 		_optimize_animations(scene, anim_optimizer_linerr, anim_optimizer_angerr, anim_optimizer_maxang);
@@ -1401,6 +1517,10 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 		_filter_tracks(scene, animation_filter);
 	}
 
+	if (bool(p_options["animation/compression/enabled"])) {
+		_compress_animations(scene);
+	}
+
 	bool external_animations = int(p_options["animation/storage"]) == 1 || int(p_options["animation/storage"]) == 2;
 	bool external_animations_as_text = int(p_options["animation/storage"]) == 2;
 	bool keep_custom_tracks = p_options["animation/keep_custom_tracks"];
@@ -1424,7 +1544,9 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 		}
 	}
 
-	if (light_bake_mode == 2 /* || generate LOD */) {
+	bool generate_lods = p_options["meshes/generate_lods"];
+
+	if (light_bake_mode == 2 || generate_lods) {
 
 		Map<Ref<ArrayMesh>, Transform> meshes;
 		_find_meshes(scene, meshes);
@@ -1453,6 +1575,25 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 				step++;
 			}
 		}
+
+		if (generate_lods) {
+
+			EditorProgress progress2("gen_lods", TTR("Generating LODs"), meshes.size());
+			int step = 0;
+			for (Map<Ref<ArrayMesh>, Transform>::Element *E = meshes.front(); E; E = E->next()) {
+
+				Ref<ArrayMesh> mesh = E->key();
+				String name = mesh->get_name();
+				if (name == "") { //should not happen but..
+					name = "Mesh " + itos(step);
+				}
+
+				progress2.step(TTR("Generating for Mesh: ") + name + " (" + itos(step) + "/" + itos(meshes.size()) + ")", step);
+
+				mesh->generate_lods();
+				step++;
+			}
+		}
 	}
 
 	if (external_animations || external_materials || external_meshes) {
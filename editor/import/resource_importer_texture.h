@@ -109,6 +109,7 @@ public:
 	void update_imports();
 
 	virtual bool are_import_settings_valid(const String &p_path) const;
+	virtual bool can_import_threaded() const { return true; }
 	virtual String get_import_settings_string() const;
 
 	ResourceImporterTexture();
@@ -163,6 +163,7 @@ public:
 	}
 
 	virtual Error import(const String &p_source_file, const String &p_save_path, const Map<StringName, Variant> &p_options, List<String> *r_platform_variants, List<String> *r_gen_files = NULL, Variant *r_metadata = NULL);
+	virtual bool can_import_threaded() const { return true; }
 
 	ResourceImporterWAV();
 };
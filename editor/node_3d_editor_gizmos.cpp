@@ -1479,9 +1479,7 @@ void CameraNode3DGizmoPlugin::redraw(EditorNode3DGizmo *p_gizmo) {
 		}
 
 		Transform local = camera->get_global_transform().affine_inverse();
-		for (int i = 0; i < lines.size(); i++) {
-			lines.write[i] = local.xform(lines[i]);
-		}
+		local.xform(lines.ptr(), lines.ptrw(), lines.size());
 
 		p_gizmo->add_lines(lines, material);
 	}
@@ -30,8 +30,10 @@
 
 #include "main.h"
 
+#include "core/command_queue_mt.h"
 #include "core/crypto/crypto.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/profiling_zones.h"
 #include "core/input/input_filter.h"
 #include "core/input/input_map.h"
 #include "core/io/file_access_network.h"
@@ -40,6 +42,7 @@
 #include "core/io/image_loader.h"
 #include "core/io/ip.h"
 #include "core/io/resource_loader.h"
+#include "core/local_vector.h"
 #include "core/message_queue.h"
 #include "core/os/dir_access.h"
 #include "core/os/os.h"
@@ -154,9 +157,12 @@ static bool use_debug_profiler = false;
 #ifdef DEBUG_ENABLED
 static bool debug_collisions = false;
 static bool debug_navigation = false;
+static String profiling_trace_file;
 #endif
 static int frame_delay = 0;
 static bool disable_render_loop = false;
+static bool headless_resources = false;
+static uint32_t low_processor_idle_sleep_usec = 0;
 static int fixed_fps = -1;
 static bool print_fps = false;
 
@@ -241,6 +247,42 @@ void finalize_navigation_server() {
 #define MAIN_PRINT(m_txt)
 #endif
 
+// Time spent in each startup phase, printed with --verbose once Main::start() is done.
+
+struct StartupPhase {
+	const char *name;
+	uint64_t usec;
+};
+
+static LocalVector<StartupPhase> startup_phases;
+static uint64_t startup_phase_begin = 0;
+
+static void _startup_phase_end(const char *p_name) {
+
+	uint64_t now = OS::get_singleton()->get_ticks_usec();
+	StartupPhase phase;
+	phase.name = p_name;
+	phase.usec = now - startup_phase_begin;
+	startup_phases.push_back(phase);
+	startup_phase_begin = now;
+}
+
+static void _print_startup_report() {
+
+	if (!OS::get_singleton()->is_stdout_verbose()) {
+		return;
+	}
+
+	uint64_t total = 0;
+	print_line("Startup phases:");
+	for (uint32_t i = 0; i < startup_phases.size(); i++) {
+		print_line(vformat("  %-28s %9.2f ms", startup_phases[i].name, startup_phases[i].usec / 1000.0));
+		total += startup_phases[i].usec;
+	}
+	print_line(vformat("  %-28s %9.2f ms", "Total", total / 1000.0));
+	startup_phases.reset();
+}
+
 void Main::print_help(const char *p_binary) {
 
 	print_line(String(VERSION_NAME) + " v" + get_full_version_string() + " - " + String(VERSION_WEBSITE));
@@ -325,10 +367,14 @@ void Main::print_help(const char *p_binary) {
 #if defined(DEBUG_ENABLED) && !defined(SERVER_ENABLED)
 	OS::get_singleton()->print("  --debug-collisions               Show collision shapes when running the scene.\n");
 	OS::get_singleton()->print("  --debug-navigation               Show navigation polygons when running the scene.\n");
+#endif
+#ifdef DEBUG_ENABLED
+	OS::get_singleton()->print("  --profiling-trace <file>         Record profiling zones of all threads and save them on exit as a Chrome trace (JSON, also opened by Perfetto).\n");
 #endif
 	OS::get_singleton()->print("  --frame-delay <ms>               Simulate high CPU load (delay each frame by <ms> milliseconds).\n");
 	OS::get_singleton()->print("  --time-scale <scale>             Force time scale (higher values are faster, 1.0 is normal speed).\n");
 	OS::get_singleton()->print("  --disable-render-loop            Disable render loop so rendering only occurs when called explicitly from script.\n");
+	OS::get_singleton()->print("  --headless-resources             Skip loading texture and mesh data only needed for rendering (for dedicated servers running without a renderer).\n");
 	OS::get_singleton()->print("  --disable-crash-handler          Disable crash handler when supported by the platform code.\n");
 	OS::get_singleton()->print("  --fixed-fps <fps>                Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
 	OS::get_singleton()->print("  --print-fps                      Print the frames per second to the stdout.\n");
@@ -357,6 +403,10 @@ void Main::print_help(const char *p_binary) {
 		comma = ", ";
 	}
 	OS::get_singleton()->print("].\n");
+	OS::get_singleton()->print("  --benchmark                      Run the built-in engine benchmarks and print the results as JSON (same as --test benchmark).\n");
+	OS::get_singleton()->print("  --benchmark-output <file>        Write the benchmark results to <file> instead of stdout.\n");
+	OS::get_singleton()->print("  --benchmark-samples <count>      Number of timed samples per benchmark (default: 30).\n");
+	OS::get_singleton()->print("  --benchmark-filter <pattern>     Only run the benchmarks whose name matches the wildcard <pattern>.\n");
 #endif
 }
 
@@ -389,6 +439,7 @@ void Main::print_help(const char *p_binary) {
 Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_phase) {
 
 	OS::get_singleton()->initialize();
+	startup_phase_begin = OS::get_singleton()->get_ticks_usec();
 
 	engine = memnew(Engine);
 
@@ -399,6 +450,8 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	register_core_types();
 	register_core_driver_types();
 
+	_startup_phase_end("Core types");
+
 	MAIN_PRINT("Main: Initialize Globals");
 
 	Thread::_main_thread_id = Thread::get_caller_id();
@@ -825,6 +878,17 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			debug_collisions = true;
 		} else if (I->get() == "--debug-navigation") {
 			debug_navigation = true;
+#endif
+#ifdef DEBUG_ENABLED
+		} else if (I->get() == "--profiling-trace") {
+			if (I->next()) {
+				profiling_trace_file = I->next()->get();
+				ProfilingZones::set_enabled(true);
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing profiling trace file argument, aborting.\n");
+				goto error;
+			}
 #endif
 		} else if (I->get() == "--remote-debug") {
 			if (I->next()) {
@@ -851,6 +915,8 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			}
 		} else if (I->get() == "--disable-render-loop") {
 			disable_render_loop = true;
+		} else if (I->get() == "--headless-resources") {
+			headless_resources = true;
 		} else if (I->get() == "--fixed-fps") {
 			if (I->next()) {
 				fixed_fps = I->next()->get().to_int();
@@ -921,6 +987,12 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 
 	GLOBAL_DEF("memory/limits/multithreaded_server/rid_pool_prealloc", 60);
 	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/multithreaded_server/rid_pool_prealloc", PropertyInfo(Variant::INT, "memory/limits/multithreaded_server/rid_pool_prealloc", PROPERTY_HINT_RANGE, "0,500,1")); // No negative and limit to 500 due to crashes
+	GLOBAL_DEF("memory/limits/resource_cache/retain_budget_mb", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/resource_cache/retain_budget_mb", PropertyInfo(Variant::INT, "memory/limits/resource_cache/retain_budget_mb", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"));
+	if (!editor) {
+		//the editor reloads resources as they change, keeping old copies around would be wrong
+		ResourceCache::set_retain_budget(uint64_t(int(GLOBAL_GET("memory/limits/resource_cache/retain_budget_mb"))) * 1024 * 1024);
+	}
 	GLOBAL_DEF("network/limits/debugger/max_chars_per_second", 32768);
 	ProjectSettings::get_singleton()->set_custom_property_info("network/limits/debugger/max_chars_per_second", PropertyInfo(Variant::INT, "network/limits/debugger/max_chars_per_second", PROPERTY_HINT_RANGE, "0, 4096, 1, or_greater"));
 	GLOBAL_DEF("network/limits/debugger/max_queued_messages", 2048);
@@ -929,6 +1001,9 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	ProjectSettings::get_singleton()->set_custom_property_info("network/limits/debugger/max_errors_per_second", PropertyInfo(Variant::INT, "network/limits/debugger/max_errors_per_second", PROPERTY_HINT_RANGE, "0, 200, 1, or_greater"));
 	GLOBAL_DEF("network/limits/debugger/max_warnings_per_second", 400);
 	ProjectSettings::get_singleton()->set_custom_property_info("network/limits/debugger/max_warnings_per_second", PropertyInfo(Variant::INT, "network/limits/debugger/max_warnings_per_second", PROPERTY_HINT_RANGE, "0, 200, 1, or_greater"));
+	GLOBAL_DEF("network/limits/debugger/max_profiler_frames_per_second", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("network/limits/debugger/max_profiler_frames_per_second", PropertyInfo(Variant::INT, "network/limits/debugger/max_profiler_frames_per_second", PROPERTY_HINT_RANGE, "0, 240, 1, or_greater"));
+	GLOBAL_DEF("network/limits/debugger/compress_messages", true);
 
 	EngineDebugger::initialize(debug_uri, skip_breakpoints, breakpoints);
 
@@ -950,6 +1025,13 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		OS::get_singleton()->add_logger(memnew(RotatedFileLogger(base_path, max_files)));
 	}
 
+	GLOBAL_DEF("logging/async_logging/enabled", false);
+	GLOBAL_DEF("logging/async_logging/max_queued_messages", 4096);
+	ProjectSettings::get_singleton()->set_custom_property_info("logging/async_logging/max_queued_messages", PropertyInfo(Variant::INT, "logging/async_logging/max_queued_messages", PROPERTY_HINT_RANGE, "1,65536,1,or_greater"));
+	if (GLOBAL_GET("logging/async_logging/enabled")) {
+		OS::get_singleton()->set_async_logging(true, int(GLOBAL_GET("logging/async_logging/max_queued_messages")));
+	}
+
 #ifdef TOOLS_ENABLED
 	if (editor) {
 		Engine::get_singleton()->set_editor_hint(true);
@@ -1150,6 +1232,10 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	Engine::get_singleton()->set_iterations_per_second(GLOBAL_DEF("physics/common/physics_fps", 60));
 	ProjectSettings::get_singleton()->set_custom_property_info("physics/common/physics_fps", PropertyInfo(Variant::INT, "physics/common/physics_fps", PROPERTY_HINT_RANGE, "1,120,1,or_greater"));
 	Engine::get_singleton()->set_physics_jitter_fix(GLOBAL_DEF("physics/common/physics_jitter_fix", 0.5));
+	if (GLOBAL_DEF("physics/common/physics_interpolation", false)) {
+		//interpolation needs the real fraction through the tick, which jitter fix would snap
+		Engine::get_singleton()->set_physics_jitter_fix(0);
+	}
 	Engine::get_singleton()->set_target_fps(GLOBAL_DEF("debug/settings/fps/force_fps", 0));
 	ProjectSettings::get_singleton()->set_custom_property_info("debug/settings/fps/force_fps", PropertyInfo(Variant::INT, "debug/settings/fps/force_fps", PROPERTY_HINT_RANGE, "0,120,1,or_greater"));
 
@@ -1166,13 +1252,28 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	OS::get_singleton()->set_low_processor_usage_mode(GLOBAL_DEF("application/run/low_processor_mode", false));
 	OS::get_singleton()->set_low_processor_usage_mode_sleep_usec(GLOBAL_DEF("application/run/low_processor_mode_sleep_usec", 6900)); // Roughly 144 FPS
 	ProjectSettings::get_singleton()->set_custom_property_info("application/run/low_processor_mode_sleep_usec", PropertyInfo(Variant::INT, "application/run/low_processor_mode_sleep_usec", PROPERTY_HINT_RANGE, "0,33200,1,or_greater")); // No negative numbers
+	low_processor_idle_sleep_usec = GLOBAL_DEF("application/run/low_processor_mode_idle_sleep_usec", 20000); // 50 FPS once nothing has been drawn for a while
+	ProjectSettings::get_singleton()->set_custom_property_info("application/run/low_processor_mode_idle_sleep_usec", PropertyInfo(Variant::INT, "application/run/low_processor_mode_idle_sleep_usec", PROPERTY_HINT_RANGE, "0,100000,1,or_greater"));
 
 	GLOBAL_DEF("display/window/ios/hide_home_indicator", true);
 
+	// usually enabled for the server export preset through a feature override
+	if (bool(GLOBAL_DEF("application/run/headless_resources", false))) {
+		headless_resources = true;
+	}
+#ifdef TOOLS_ENABLED
+	if (editor || project_manager) {
+		headless_resources = false; //resources would be saved back without their data
+	}
+#endif
+	ResourceLoader::set_headless(headless_resources);
+
 	Engine::get_singleton()->set_frame_delay(frame_delay);
 
 	message_queue = memnew(MessageQueue);
 
+	_startup_phase_end("Settings and command line");
+
 	if (p_second_phase)
 		return setup2();
 
@@ -1223,7 +1324,6 @@ error:
 Error Main::setup2(Thread::ID p_main_tid_override) {
 
 	preregister_module_types();
-	preregister_server_types();
 
 	// Print engine name and version
 	print_line(String(VERSION_NAME) + " v" + get_full_version_string() + " - " + String(VERSION_WEBSITE));
@@ -1271,6 +1371,8 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 		display_server->screen_set_orientation(window_orientation);
 	}
 
+	_startup_phase_end("Display server");
+
 	/* Initialize Visual Server */
 
 	rendering_server = memnew(RenderingServerRaster);
@@ -1282,6 +1384,8 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 
 	OS::get_singleton()->initialize_joypads();
 
+	_startup_phase_end("Rendering server");
+
 	/* Initialize Audio Driver */
 
 	AudioDriverManager::initialize(audio_driver_idx);
@@ -1302,6 +1406,8 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 
 	register_core_singletons();
 
+	_startup_phase_end("Audio server");
+
 	MAIN_PRINT("Main: Setup Logo");
 
 #ifdef JAVASCRIPT_ENABLED
@@ -1330,6 +1436,8 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 
 	register_server_types();
 
+	_startup_phase_end("Server types");
+
 	MAIN_PRINT("Main: Load Remaps");
 
 	Color clear = GLOBAL_DEF("rendering/environment/default_clear_color", Color(0.3, 0.3, 0.3));
@@ -1383,6 +1491,8 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 	RenderingServer::get_singleton()->set_default_clear_color(GLOBAL_DEF("rendering/environment/default_clear_color", Color(0.3, 0.3, 0.3)));
 	MAIN_PRINT("Main: END");
 
+	_startup_phase_end("Boot splash");
+
 	GLOBAL_DEF("application/config/icon", String());
 	ProjectSettings::get_singleton()->set_custom_property_info("application/config/icon", PropertyInfo(Variant::STRING, "application/config/icon", PROPERTY_HINT_FILE, "*.png,*.webp"));
 
@@ -1417,6 +1527,8 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 
 	register_scene_types();
 
+	_startup_phase_end("Scene types");
+
 	GLOBAL_DEF("display/mouse_cursor/custom_image", String());
 	GLOBAL_DEF("display/mouse_cursor/custom_image_hotspot", Vector2());
 	GLOBAL_DEF("display/mouse_cursor/tooltip_position_offset", Point2(10, 10));
@@ -1436,6 +1548,7 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 
 	ClassDB::set_current_api(ClassDB::API_CORE);
 
+	_startup_phase_end("Editor types");
 #endif
 
 	MAIN_PRINT("Main: Load Modules, Physics, Drivers, Scripts");
@@ -1443,6 +1556,8 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 	register_platform_apis();
 	register_module_types();
 
+	_startup_phase_end("Modules");
+
 	camera_server = CameraServer::create();
 
 	initialize_physics();
@@ -1451,9 +1566,13 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 
 	register_driver_types();
 
+	_startup_phase_end("Physics and navigation");
+
 	// This loads global classes, so it must happen before custom loaders and savers are registered
 	ScriptServer::init_languages();
 
+	_startup_phase_end("Script languages");
+
 	MAIN_PRINT("Main: Load Translations");
 
 	translation_server->setup(); //register translations, load them, etc.
@@ -1477,9 +1596,15 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 	locale = String();
 
 	ClassDB::set_current_api(ClassDB::API_NONE); //no more api is registered at this point
+	ClassDB::lock_registration();
+
+	_startup_phase_end("Translations and remaps");
 
-	print_verbose("CORE API HASH: " + uitos(ClassDB::get_api_hash(ClassDB::API_CORE)));
-	print_verbose("EDITOR API HASH: " + uitos(ClassDB::get_api_hash(ClassDB::API_EDITOR)));
+	if (OS::get_singleton()->is_stdout_verbose()) {
+		// hashing the whole API is not cheap, don't do it just to drop the result
+		print_line("CORE API HASH: " + uitos(ClassDB::get_api_hash(ClassDB::API_CORE)));
+		print_line("EDITOR API HASH: " + uitos(ClassDB::get_api_hash(ClassDB::API_EDITOR)));
+	}
 	MAIN_PRINT("Main: Done");
 
 	return OK;
@@ -1487,6 +1612,7 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 
 // everything the main loop needs to know about frame timings
 static MainTimerSync main_timer_sync;
+static MainFramePacer main_frame_pacer;
 
 bool Main::start() {
 
@@ -1522,6 +1648,8 @@ bool Main::start() {
 			editor = true;
 		} else if (args[i] == "-p" || args[i] == "--project-manager") {
 			project_manager = true;
+		} else if (args[i] == "--benchmark") {
+			test = "benchmark";
 #endif
 		} else if (args[i].length() && args[i][0] != '-' && positional_arg == "") {
 			positional_arg = args[i];
@@ -1961,6 +2089,8 @@ bool Main::start() {
 			Crypto::load_default_certificates(GLOBAL_DEF("network/ssl/certificates", ""));
 
 			if (game_path != "") {
+				_startup_phase_end("Main loop");
+
 				Node *scene = NULL;
 				Ref<PackedScene> scenedata = ResourceLoader::load(local_game_path);
 				if (scenedata.is_valid())
@@ -1969,6 +2099,8 @@ bool Main::start() {
 				ERR_FAIL_COND_V_MSG(!scene, false, "Failed loading scene: " + local_game_path);
 				sml->add_current_scene(scene);
 
+				_startup_phase_end("Main scene");
+
 #ifdef OSX_ENABLED
 				String mac_iconpath = GLOBAL_DEF("application/config/macos_native_icon", "Variant()");
 				if (mac_iconpath != "") {
@@ -2027,6 +2159,9 @@ bool Main::start() {
 
 	OS::get_singleton()->set_main_loop(main_loop);
 
+	_startup_phase_end("Finalize");
+	_print_startup_report();
+
 	return true;
 }
 
@@ -2061,6 +2196,8 @@ bool Main::iteration() {
 
 	iterating++;
 
+	PROFILING_ZONE("Main::iteration");
+
 	uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	Engine::get_singleton()->_frame_ticks = ticks;
 	main_timer_sync.set_cpu_ticks_usec(ticks);
@@ -2099,8 +2236,12 @@ bool Main::iteration() {
 
 	for (int iters = 0; iters < advance.physics_steps; ++iters) {
 
+		PROFILING_ZONE("Main::iteration physics");
+
 		uint64_t physics_begin = OS::get_singleton()->get_ticks_usec();
 
+		RenderingServer::get_singleton()->tick();
+
 		PhysicsServer3D::get_singleton()->sync();
 		PhysicsServer3D::get_singleton()->flush_queries();
 
@@ -2132,24 +2273,31 @@ bool Main::iteration() {
 
 	uint64_t idle_begin = OS::get_singleton()->get_ticks_usec();
 
-	if (OS::get_singleton()->get_main_loop()->idle(step * time_scale)) {
-		exit = true;
+	{
+		PROFILING_ZONE("Main::iteration idle");
+
+		if (OS::get_singleton()->get_main_loop()->idle(step * time_scale)) {
+			exit = true;
+		}
+		message_queue->flush();
 	}
-	message_queue->flush();
 
 	RenderingServer::get_singleton()->sync(); //sync if still drawing from previous frames.
 
+	bool frame_drawn = false;
 	if (DisplayServer::get_singleton()->can_any_window_draw() && !disable_render_loop) {
 
 		if ((!force_redraw_requested) && OS::get_singleton()->is_in_low_processor_usage_mode()) {
 			if (RenderingServer::get_singleton()->has_changed()) {
 				RenderingServer::get_singleton()->draw(true, scaled_step); // flush visual commands
 				Engine::get_singleton()->frames_drawn++;
+				frame_drawn = true;
 			}
 		} else {
 			RenderingServer::get_singleton()->draw(true, scaled_step); // flush visual commands
 			Engine::get_singleton()->frames_drawn++;
 			force_redraw_requested = false;
+			frame_drawn = true;
 		}
 	}
 
@@ -2189,14 +2337,23 @@ bool Main::iteration() {
 		frames = 0;
 	}
 
+	FrameArena::end_frame();
+	CommandQueueMT::update_frame_statistics();
+
 	iterating--;
 
 	if (fixed_fps != -1)
 		return exit;
 
-	if (OS::get_singleton()->is_in_low_processor_usage_mode() || !DisplayServer::get_singleton()->can_any_window_draw())
-		OS::get_singleton()->delay_usec(OS::get_singleton()->get_low_processor_usage_mode_sleep_usec()); //apply some delay to force idle time
-	else {
+	if (!DisplayServer::get_singleton()->can_any_window_draw()) {
+		// nothing can be presented (dedicated servers, minimized windows), so only wake up for the next physics step
+		uint64_t next_step_usec = main_timer_sync.get_time_to_next_physics_step(frame_slice) * 1000000.0;
+		main_frame_pacer.sleep_until(ticks + next_step_usec);
+	} else if (OS::get_singleton()->is_in_low_processor_usage_mode()) {
+		// the sleep time is a frame period, so the frame rate doesn't depend on how long frames take
+		uint32_t sleep_usec = main_frame_pacer.get_low_processor_sleep_usec(frame_drawn, OS::get_singleton()->get_low_processor_usage_mode_sleep_usec(), low_processor_idle_sleep_usec);
+		main_frame_pacer.sleep_until(ticks + sleep_usec);
+	} else {
 		uint32_t frame_delay = Engine::get_singleton()->get_frame_delay();
 		if (frame_delay)
 			OS::get_singleton()->delay_usec(Engine::get_singleton()->get_frame_delay() * 1000);
@@ -2206,9 +2363,8 @@ bool Main::iteration() {
 	if (target_fps > 0 && !Engine::get_singleton()->is_editor_hint()) {
 		uint64_t time_step = 1000000L / target_fps;
 		target_ticks += time_step;
+		main_frame_pacer.sleep_until(target_ticks);
 		uint64_t current_ticks = OS::get_singleton()->get_ticks_usec();
-		if (current_ticks < target_ticks) OS::get_singleton()->delay_usec(target_ticks - current_ticks);
-		current_ticks = OS::get_singleton()->get_ticks_usec();
 		target_ticks = MIN(MAX(target_ticks, current_ticks - time_step), current_ticks + time_step);
 	}
 
@@ -2242,6 +2398,13 @@ void Main::cleanup() {
 
 	ERR_FAIL_COND(!_start_success);
 
+#ifdef DEBUG_ENABLED
+	if (profiling_trace_file != String()) {
+		ProfilingZones::set_enabled(false);
+		ProfilingZones::save_chrome_trace(profiling_trace_file);
+	}
+#endif
+
 	EngineDebugger::deinitialize();
 
 	ResourceLoader::remove_custom_loaders();
@@ -2252,6 +2415,8 @@ void Main::cleanup() {
 
 	OS::get_singleton()->delete_main_loop();
 
+	ResourceCache::clear_retained();
+
 	OS::get_singleton()->_cmdline.clear();
 	OS::get_singleton()->_execpath = "";
 	OS::get_singleton()->_local_clipboard = "";
@@ -2325,6 +2490,10 @@ void Main::cleanup() {
 	}
 
 	unregister_core_driver_types();
+	FrameArena::free_thread_memory();
+
+	OS::get_singleton()->set_async_logging(false); //write what is left
+
 	unregister_core_types();
 
 	OS::get_singleton()->finalize_core();
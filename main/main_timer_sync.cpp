@@ -30,6 +30,8 @@
 
 #include "main_timer_sync.h"
 
+#include "core/os/os.h"
+
 void MainFrameTime::clamp_idle(float min_idle_step, float max_idle_step) {
 	if (idle_step < min_idle_step) {
 		idle_step = min_idle_step;
@@ -225,3 +227,64 @@ MainFrameTime MainTimerSync::advance(float p_frame_slice, int p_iterations_per_s
 
 	return advance_checked(p_frame_slice, p_iterations_per_second, cpu_idle_step);
 }
+
+float MainTimerSync::get_time_to_next_physics_step(float p_frame_slice) const {
+	return MAX(p_frame_slice - time_accum, 0.0f);
+}
+
+/////////////////////////////////
+
+MainFramePacer::MainFramePacer() :
+		overshoot_pos(0),
+		spin_usec(0),
+		idle_frames(0) {
+	for (int i = 0; i < OVERSHOOT_HISTORY; i++) {
+		overshoot_usec[i] = 0;
+	}
+}
+
+void MainFramePacer::sleep_until(uint64_t p_deadline_usec) {
+	OS *os = OS::get_singleton();
+	uint64_t now = os->get_ticks_usec();
+	if (now >= p_deadline_usec) {
+		return;
+	}
+
+	uint64_t remaining = p_deadline_usec - now;
+	if (remaining > spin_usec) {
+		uint64_t requested = remaining - spin_usec;
+		os->delay_usec(requested);
+		uint64_t after = os->get_ticks_usec();
+		uint64_t slept = after - now;
+
+		overshoot_usec[overshoot_pos] = slept > requested ? slept - requested : 0;
+		overshoot_pos = (overshoot_pos + 1) % OVERSHOOT_HISTORY;
+		spin_usec = 0;
+		for (int i = 0; i < OVERSHOOT_HISTORY; i++) {
+			spin_usec = MAX(spin_usec, overshoot_usec[i]);
+		}
+		spin_usec = MIN(spin_usec, MAX_SPIN_USEC);
+
+		now = after;
+	}
+
+	// the rest is too short to trust the OS with
+	while (now < p_deadline_usec) {
+		os->yield();
+		now = os->get_ticks_usec();
+	}
+}
+
+uint32_t MainFramePacer::get_low_processor_sleep_usec(bool p_frame_drawn, uint32_t p_sleep_usec, uint32_t p_idle_sleep_usec) {
+	if (p_frame_drawn) {
+		idle_frames = 0;
+		return p_sleep_usec;
+	}
+
+	if (idle_frames < IDLE_FRAMES_BEFORE_IDLE_SLEEP) {
+		idle_frames++;
+		return p_sleep_usec;
+	}
+
+	return MAX(p_sleep_usec, p_idle_sleep_usec);
+}
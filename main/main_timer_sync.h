@@ -97,6 +97,35 @@ public:
 
 	// advance one frame, return timesteps to take
 	MainFrameTime advance(float p_frame_slice, int p_iterations_per_second);
+
+	// wall clock time left until the next physics step is due, in seconds
+	float get_time_to_next_physics_step(float p_frame_slice) const;
+};
+
+// Decides how long the main loop waits between iterations, and waits without
+// overshooting. OS sleeps wake up late by an amount that depends on the
+// platform and the load, so the overshoot of recent sleeps is measured and
+// that much of each wait is spent yielding instead.
+class MainFramePacer {
+	static const int OVERSHOOT_HISTORY = 16;
+	static const uint64_t MAX_SPIN_USEC = 2000;
+
+	// frames in a row that drew nothing before low processor mode idles deeper
+	static const int IDLE_FRAMES_BEFORE_IDLE_SLEEP = 60;
+
+	uint64_t overshoot_usec[OVERSHOOT_HISTORY];
+	int overshoot_pos;
+	uint64_t spin_usec;
+	int idle_frames;
+
+public:
+	MainFramePacer();
+
+	// wait until p_deadline_usec, as given by OS::get_ticks_usec()
+	void sleep_until(uint64_t p_deadline_usec);
+
+	// time between iterations in low processor mode, p_idle_sleep_usec once nothing has been drawn for a while
+	uint32_t get_low_processor_sleep_usec(bool p_frame_drawn, uint32_t p_sleep_usec, uint32_t p_idle_sleep_usec);
 };
 
 #endif // MAIN_TIMER_SYNC_H
@@ -30,6 +30,7 @@
 
 #include "performance.h"
 
+#include "core/command_queue_mt.h"
 #include "core/message_queue.h"
 #include "core/os/os.h"
 #include "scene/main/node.h"
@@ -44,6 +45,7 @@ Performance *Performance::singleton = NULL;
 void Performance::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_monitor", "monitor"), &Performance::get_monitor);
+	ClassDB::bind_method(D_METHOD("get_memory_tag_stats"), &Performance::get_memory_tag_stats);
 
 	BIND_ENUM_CONSTANT(TIME_FPS);
 	BIND_ENUM_CONSTANT(TIME_PROCESS);
@@ -51,6 +53,9 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(MEMORY_STATIC);
 	BIND_ENUM_CONSTANT(MEMORY_STATIC_MAX);
 	BIND_ENUM_CONSTANT(MEMORY_MESSAGE_BUFFER_MAX);
+	BIND_ENUM_CONSTANT(MEMORY_MESSAGE_COUNT_MAX);
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA);
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA_MAX);
 	BIND_ENUM_CONSTANT(OBJECT_COUNT);
 	BIND_ENUM_CONSTANT(OBJECT_RESOURCE_COUNT);
 	BIND_ENUM_CONSTANT(OBJECT_NODE_COUNT);
@@ -72,6 +77,26 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
 	BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+	BIND_ENUM_CONSTANT(SERVER_COMMAND_QUEUE_DEPTH);
+	BIND_ENUM_CONSTANT(SERVER_COMMAND_QUEUE_STALL);
+	BIND_ENUM_CONSTANT(RENDER_TEXTURE_STREAMING_MEM_USED);
+	BIND_ENUM_CONSTANT(RENDER_TEXTURE_STREAMING_TEXTURE_COUNT);
+	BIND_ENUM_CONSTANT(RENDER_TEXTURE_STREAMING_PENDING_REQUESTS);
+	BIND_ENUM_CONSTANT(RENDER_2D_DRAW_CALLS_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDER_2D_BATCHES_IN_FRAME);
+	BIND_ENUM_CONSTANT(RESOURCE_CACHE_HITS);
+	BIND_ENUM_CONSTANT(RESOURCE_CACHE_MISSES);
+	BIND_ENUM_CONSTANT(RESOURCE_CACHE_RETAINED_MEM);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_GENERAL);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_STRINGS);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_NODES);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_RESOURCES);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_TEXTURES);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_MESHES);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_SCRIPTS);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_PHYSICS);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_AUDIO);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_RENDERING);
 
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -95,6 +120,9 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"memory/static",
 		"memory/static_max",
 		"memory/msg_buf_max",
+		"memory/msg_count_max",
+		"memory/frame_arena",
+		"memory/frame_arena_max",
 		"object/objects",
 		"object/resources",
 		"object/nodes",
@@ -116,6 +144,26 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
 		"audio/output_latency",
+		"server/command_queue_depth",
+		"server/command_queue_stall",
+		"video/texture_streaming_mem",
+		"video/texture_streaming_textures",
+		"video/texture_streaming_pending",
+		"raster/2d_draw_calls",
+		"raster/2d_batches",
+		"resource_cache/hits",
+		"resource_cache/misses",
+		"resource_cache/retained_mem",
+		"memory_tags/general",
+		"memory_tags/strings",
+		"memory_tags/nodes",
+		"memory_tags/resources",
+		"memory_tags/textures",
+		"memory_tags/meshes",
+		"memory_tags/scripts",
+		"memory_tags/physics",
+		"memory_tags/audio",
+		"memory_tags/rendering",
 
 	};
 
@@ -131,6 +179,9 @@ float Performance::get_monitor(Monitor p_monitor) const {
 		case MEMORY_STATIC: return Memory::get_mem_usage();
 		case MEMORY_STATIC_MAX: return Memory::get_mem_max_usage();
 		case MEMORY_MESSAGE_BUFFER_MAX: return MessageQueue::get_singleton()->get_max_buffer_usage();
+		case MEMORY_MESSAGE_COUNT_MAX: return MessageQueue::get_singleton()->get_max_message_count();
+		case MEMORY_FRAME_ARENA: return FrameArena::get_frame_usage();
+		case MEMORY_FRAME_ARENA_MAX: return FrameArena::get_max_frame_usage();
 		case OBJECT_COUNT: return ObjectDB::get_object_count();
 		case OBJECT_RESOURCE_COUNT: return ResourceCache::get_cached_resource_count();
 		case OBJECT_NODE_COUNT: return _get_node_count();
@@ -152,6 +203,26 @@ float Performance::get_monitor(Monitor p_monitor) const {
 		case PHYSICS_3D_COLLISION_PAIRS: return PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_COLLISION_PAIRS);
 		case PHYSICS_3D_ISLAND_COUNT: return PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT);
 		case AUDIO_OUTPUT_LATENCY: return AudioServer::get_singleton()->get_output_latency();
+		case SERVER_COMMAND_QUEUE_DEPTH: return CommandQueueMT::get_frame_pending_max();
+		case SERVER_COMMAND_QUEUE_STALL: return CommandQueueMT::get_frame_stall_usec() / 1000000.0;
+		case RENDER_TEXTURE_STREAMING_MEM_USED: return RS::get_singleton()->get_render_info(RS::INFO_TEXTURE_STREAMING_MEM_USED);
+		case RENDER_TEXTURE_STREAMING_TEXTURE_COUNT: return RS::get_singleton()->get_render_info(RS::INFO_TEXTURE_STREAMING_TEXTURE_COUNT);
+		case RENDER_TEXTURE_STREAMING_PENDING_REQUESTS: return RS::get_singleton()->get_render_info(RS::INFO_TEXTURE_STREAMING_PENDING_REQUESTS);
+		case RENDER_2D_DRAW_CALLS_IN_FRAME: return RS::get_singleton()->get_render_info(RS::INFO_2D_DRAW_CALLS_IN_FRAME);
+		case RENDER_2D_BATCHES_IN_FRAME: return RS::get_singleton()->get_render_info(RS::INFO_2D_BATCHES_IN_FRAME);
+		case RESOURCE_CACHE_HITS: return ResourceCache::get_hit_count();
+		case RESOURCE_CACHE_MISSES: return ResourceCache::get_miss_count();
+		case RESOURCE_CACHE_RETAINED_MEM: return ResourceCache::get_retained_size();
+		case MEMORY_TAG_GENERAL:
+		case MEMORY_TAG_STRINGS:
+		case MEMORY_TAG_NODES:
+		case MEMORY_TAG_RESOURCES:
+		case MEMORY_TAG_TEXTURES:
+		case MEMORY_TAG_MESHES:
+		case MEMORY_TAG_SCRIPTS:
+		case MEMORY_TAG_PHYSICS:
+		case MEMORY_TAG_AUDIO:
+		case MEMORY_TAG_RENDERING: return Memory::get_tag_usage(Memory::Tag(p_monitor - MEMORY_TAG_GENERAL));
 
 		default: {
 		}
@@ -172,6 +243,9 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_MEMORY,
 		MONITOR_TYPE_MEMORY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
@@ -192,12 +266,46 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 
 	return types[p_monitor];
 }
 
+Dictionary Performance::get_memory_tag_stats() const {
+
+	Dictionary stats;
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		Memory::Tag tag = Memory::Tag(i);
+		Dictionary d;
+		d["usage"] = Memory::get_tag_usage(tag);
+		d["max_usage"] = Memory::get_tag_max_usage(tag);
+		d["alloc_count"] = Memory::get_tag_alloc_count(tag);
+		stats[Memory::get_tag_name(tag)] = d;
+	}
+	return stats;
+}
+
 void Performance::set_process_time(float p_pt) {
 
 	_process_time = p_pt;
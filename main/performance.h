@@ -57,6 +57,9 @@ public:
 		MEMORY_STATIC,
 		MEMORY_STATIC_MAX,
 		MEMORY_MESSAGE_BUFFER_MAX,
+		MEMORY_MESSAGE_COUNT_MAX,
+		MEMORY_FRAME_ARENA,
+		MEMORY_FRAME_ARENA_MAX,
 		OBJECT_COUNT,
 		OBJECT_RESOURCE_COUNT,
 		OBJECT_NODE_COUNT,
@@ -79,6 +82,26 @@ public:
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
 		AUDIO_OUTPUT_LATENCY,
+		SERVER_COMMAND_QUEUE_DEPTH,
+		SERVER_COMMAND_QUEUE_STALL,
+		RENDER_TEXTURE_STREAMING_MEM_USED,
+		RENDER_TEXTURE_STREAMING_TEXTURE_COUNT,
+		RENDER_TEXTURE_STREAMING_PENDING_REQUESTS,
+		RENDER_2D_DRAW_CALLS_IN_FRAME,
+		RENDER_2D_BATCHES_IN_FRAME,
+		RESOURCE_CACHE_HITS,
+		RESOURCE_CACHE_MISSES,
+		RESOURCE_CACHE_RETAINED_MEM,
+		MEMORY_TAG_GENERAL,
+		MEMORY_TAG_STRINGS,
+		MEMORY_TAG_NODES,
+		MEMORY_TAG_RESOURCES,
+		MEMORY_TAG_TEXTURES,
+		MEMORY_TAG_MESHES,
+		MEMORY_TAG_SCRIPTS,
+		MEMORY_TAG_PHYSICS,
+		MEMORY_TAG_AUDIO,
+		MEMORY_TAG_RENDERING,
 		MONITOR_MAX
 	};
 
@@ -93,6 +116,8 @@ public:
 
 	MonitorType get_monitor_type(Monitor p_monitor) const;
 
+	Dictionary get_memory_tag_stats() const;
+
 	void set_process_time(float p_pt);
 	void set_physics_process_time(float p_pt);
 
@@ -31,6 +31,7 @@
 #include "test_astar.h"
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
 #include "core/math/math_funcs.h"
 #include "core/os/os.h"
 
@@ -344,6 +345,190 @@ bool test_solutions() {
 	return true;
 }
 
+bool test_id_paths() {
+	// Batched searches run in parallel, they must match the ones run one at a time
+
+	const int N = 200;
+	Math::seed(0);
+
+	AStar a;
+	for (int u = 0; u < N; u++)
+		a.add_point(u, Vector3(Math::rand() % 100, Math::rand() % 100, Math::rand() % 100));
+	for (int i = 0; i < N * 3; i++) {
+		int u = Math::rand() % N;
+		int v = Math::rand() % N;
+		if (u != v) a.connect_points(u, v, Math::rand() % 2);
+	}
+
+	Vector<int> from_ids;
+	Vector<int> to_ids;
+	for (int i = 0; i < 100; i++) {
+		from_ids.push_back(Math::rand() % N);
+		to_ids.push_back(Math::rand() % N);
+	}
+
+	Array paths = a.get_id_paths(from_ids, to_ids);
+	if (paths.size() != from_ids.size()) return false;
+
+	for (int i = 0; i < from_ids.size(); i++) {
+		Vector<int> path = paths[i];
+		Vector<int> expected = a.get_id_path(from_ids[i], to_ids[i]);
+		bool match = path.size() == expected.size();
+		for (int j = 0; match && j < path.size(); j++)
+			match = path[j] == expected[j];
+		if (!match) {
+			printf("From %d to %d: batched path differs\n", from_ids[i], to_ids[i]);
+			return false;
+		}
+	}
+	return true;
+}
+
+static float grid_path_length(const Array &p_path) {
+	float length = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		Vector2i a = p_path[i - 1];
+		Vector2i b = p_path[i];
+		length += Vector2(a.x, a.y).distance_to(Vector2(b.x, b.y));
+	}
+	return length;
+}
+
+bool test_grid_jumping() {
+	// Jump point search must find paths as short as plain A*, for every diagonal mode
+
+	Math::seed(0);
+
+	for (int test = 0; test < 200; test++) {
+		AStarGrid2D grid;
+		Vector2i size(Math::rand() % 30 + 2, Math::rand() % 30 + 2);
+		grid.set_size(size);
+		int density = Math::rand() % 45;
+		for (int y = 0; y < size.y; y++)
+			for (int x = 0; x < size.x; x++)
+				if (int(Math::rand() % 100) < density) grid.set_point_solid(Vector2i(x, y));
+
+		for (int mode = 0; mode < AStarGrid2D::DIAGONAL_MODE_MAX; mode++) {
+			grid.set_diagonal_mode(AStarGrid2D::DiagonalMode(mode));
+			for (int i = 0; i < 20; i++) {
+				Vector2i from(Math::rand() % size.x, Math::rand() % size.y);
+				Vector2i to(Math::rand() % size.x, Math::rand() % size.y);
+				grid.set_point_solid(from, false);
+
+				grid.set_jumping_enabled(false);
+				Array path = grid.get_id_path(from, to);
+				grid.set_jumping_enabled(true);
+				Array jump_path = grid.get_id_path(from, to);
+
+				if (path.size() == 0 || jump_path.size() == 0) {
+					if (path.size() != jump_path.size()) {
+						printf("Grid #%d, mode %d: only one search found a path\n", test, mode);
+						return false;
+					}
+					continue;
+				}
+
+				if (!Math::is_equal_approx(grid_path_length(path), grid_path_length(jump_path))) {
+					printf("Grid #%d, mode %d: A* gives %.6f, JPS gives %.6f\n", test, mode, grid_path_length(path), grid_path_length(jump_path));
+					return false;
+				}
+
+				// Every step must be a single, allowed move
+				for (int j = 1; j < jump_path.size(); j++) {
+					Vector2i a = jump_path[j - 1];
+					Vector2i b = jump_path[j];
+					Vector2i d = b - a;
+					bool diagonal = d.x != 0 && d.y != 0;
+					if (MAX(ABS(d.x), ABS(d.y)) != 1 || grid.is_point_solid(b) || (diagonal && mode == AStarGrid2D::DIAGONAL_MODE_NEVER)) {
+						printf("Grid #%d, mode %d: invalid step (%d, %d) -> (%d, %d)\n", test, mode, a.x, a.y, b.x, b.y);
+						return false;
+					}
+				}
+			}
+		}
+	}
+	return true;
+}
+
+bool test_grid_benchmark() {
+	// Same map as a graph and as a grid, the grid has to build faster and answer as fast
+
+	const int N = 300;
+	Math::seed(0);
+
+	AStarGrid2D grid;
+	AStar graph;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	grid.set_size(Vector2i(N, N));
+	for (int y = 0; y < N; y++)
+		for (int x = 0; x < N; x++)
+			if (Math::rand() % 100 < 20 && x + y > 0) grid.set_point_solid(Vector2i(x, y));
+	uint64_t grid_build_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	graph.reserve_space(N * N);
+	for (int y = 0; y < N; y++)
+		for (int x = 0; x < N; x++)
+			graph.add_point(y * N + x, Vector3(x, y, 0));
+	for (int y = 0; y < N; y++)
+		for (int x = 0; x < N; x++) {
+			if (grid.is_point_solid(Vector2i(x, y))) continue;
+			if (x + 1 < N && !grid.is_point_solid(Vector2i(x + 1, y))) graph.connect_points(y * N + x, y * N + x + 1);
+			if (y + 1 < N && !grid.is_point_solid(Vector2i(x, y + 1))) graph.connect_points(y * N + x, (y + 1) * N + x);
+		}
+	uint64_t graph_build_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	grid.set_diagonal_mode(AStarGrid2D::DIAGONAL_MODE_NEVER);
+	grid.set_default_heuristic(AStarGrid2D::HEURISTIC_MANHATTAN);
+
+	const int QUERIES = 50;
+	Array from_ids;
+	Array to_ids;
+	for (int i = 0; i < QUERIES; i++) {
+		Vector2i to(Math::rand() % N, Math::rand() % N);
+		from_ids.push_back(Vector2i());
+		to_ids.push_back(to);
+	}
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	int graph_found = 0;
+	for (int i = 0; i < QUERIES; i++) {
+		Vector2i to = to_ids[i];
+		if (graph.get_id_path(0, to.y * N + to.x).size()) graph_found++;
+	}
+	uint64_t graph_query_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	int grid_found = 0;
+	for (int i = 0; i < QUERIES; i++) {
+		if (grid.get_point_path(from_ids[i], to_ids[i]).size()) grid_found++;
+	}
+	uint64_t grid_query_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	grid.set_jumping_enabled(true);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < QUERIES; i++) {
+		grid.get_point_path(from_ids[i], to_ids[i]);
+	}
+	uint64_t jump_query_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	Array batch = grid.get_point_paths(from_ids, to_ids);
+	uint64_t batch_query_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	printf("%dx%d cells, %d queries\n", N, N, QUERIES);
+	printf("AStar:       build %8.2f ms, queries %8.2f ms\n", graph_build_usec / 1000.0, graph_query_usec / 1000.0);
+	printf("AStarGrid2D: build %8.2f ms, queries %8.2f ms (jumping %.2f ms, batch %.2f ms)\n", grid_build_usec / 1000.0, grid_query_usec / 1000.0, jump_query_usec / 1000.0, batch_query_usec / 1000.0);
+
+	int batch_found = 0;
+	for (int i = 0; i < batch.size(); i++) {
+		if (Vector<Vector2>(batch[i]).size()) batch_found++;
+	}
+
+	return grid_found == graph_found && batch_found == grid_found;
+}
+
 typedef bool (*TestFunc)(void);
 
 TestFunc test_funcs[] = {
@@ -351,6 +536,9 @@ TestFunc test_funcs[] = {
 	test_abcx,
 	test_add_remove,
 	test_solutions,
+	test_id_paths,
+	test_grid_jumping,
+	test_grid_benchmark,
 	NULL
 };
 
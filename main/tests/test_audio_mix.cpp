@@ -0,0 +1,176 @@
+/*************************************************************************/
+/*  test_audio_mix.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_audio_mix.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/vector.h"
+#include "servers/audio/audio_mix.h"
+
+namespace TestAudioMix {
+
+#define VOICE_COUNT 256
+#define BUFFER_SIZE 512
+#define ITERATIONS 16
+
+static bool _frames_match(const Vector<AudioFrame> &p_a, const Vector<AudioFrame> &p_b) {
+
+	for (int i = 0; i < p_a.size(); i++) {
+		if (!Math::is_equal_approx(p_a[i].l, p_b[i].l, 1e-4f) || !Math::is_equal_approx(p_a[i].r, p_b[i].r, 1e-4f)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+MainLoop *test() {
+
+	Vector<AudioFrame> voice;
+	voice.resize(BUFFER_SIZE);
+	for (int i = 0; i < BUFFER_SIZE; i++) {
+		voice.write[i] = AudioFrame(Math::random(-1.0, 1.0), Math::random(-1.0, 1.0));
+	}
+
+	Vector<AudioFrame> target;
+	Vector<AudioFrame> reference;
+	target.resize(BUFFER_SIZE);
+	reference.resize(BUFFER_SIZE);
+	AudioMix::clear(target.ptrw(), BUFFER_SIZE);
+	AudioMix::clear(reference.ptrw(), BUFFER_SIZE);
+
+	const AudioFrame *src = voice.ptr();
+	const AudioFrame vol_from(0.25, 0.75);
+	const AudioFrame vol_to(0.5, 0.125);
+
+	//the plain loop the players used before, as a reference
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+
+	for (int n = 0; n < ITERATIONS * VOICE_COUNT; n++) {
+
+		AudioFrame *dst = reference.ptrw();
+		AudioFrame vol_inc = (vol_to - vol_from) / float(BUFFER_SIZE);
+		AudioFrame vol = vol_from;
+		for (int j = 0; j < BUFFER_SIZE; j++) {
+			dst[j] += src[j] * vol;
+			vol += vol_inc;
+		}
+	}
+
+	uint64_t scalar_ramp_usec = OS::get_singleton()->get_ticks_usec() - from;
+	from = OS::get_singleton()->get_ticks_usec();
+
+	for (int n = 0; n < ITERATIONS * VOICE_COUNT; n++) {
+		AudioMix::add_ramp(target.ptrw(), src, BUFFER_SIZE, vol_from, vol_to);
+	}
+
+	uint64_t ramp_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	//check a single pass, the timed loops accumulate the rounding differences
+	AudioMix::clear(target.ptrw(), BUFFER_SIZE);
+	AudioMix::clear(reference.ptrw(), BUFFER_SIZE);
+	AudioMix::add_ramp(target.ptrw(), src, BUFFER_SIZE, vol_from, vol_to);
+	{
+		AudioFrame *dst = reference.ptrw();
+		AudioFrame vol_inc = (vol_to - vol_from) / float(BUFFER_SIZE);
+		AudioFrame vol = vol_from;
+		for (int j = 0; j < BUFFER_SIZE; j++) {
+			dst[j] += src[j] * vol;
+			vol += vol_inc;
+		}
+	}
+	bool ramp_match = _frames_match(target, reference);
+
+	//bus volume and peak
+	from = OS::get_singleton()->get_ticks_usec();
+	AudioFrame peak_reference(0, 0);
+
+	for (int n = 0; n < ITERATIONS; n++) {
+
+		AudioFrame *buf = reference.ptrw();
+		AudioFrame peak(0, 0);
+		for (int j = 0; j < BUFFER_SIZE; j++) {
+			buf[j] *= 0.5;
+			peak.l = MAX(peak.l, ABS(buf[j].l));
+			peak.r = MAX(peak.r, ABS(buf[j].r));
+		}
+		peak_reference = peak;
+	}
+
+	uint64_t scalar_peak_usec = OS::get_singleton()->get_ticks_usec() - from;
+	from = OS::get_singleton()->get_ticks_usec();
+	AudioFrame peak(0, 0);
+
+	for (int n = 0; n < ITERATIONS; n++) {
+		peak = AudioMix::scale_peak(target.ptrw(), BUFFER_SIZE, 0.5);
+	}
+
+	uint64_t peak_usec = OS::get_singleton()->get_ticks_usec() - from;
+	bool peak_match = _frames_match(target, reference) && Math::is_equal_approx(peak.l, peak_reference.l, 1e-4f) && Math::is_equal_approx(peak.r, peak_reference.r, 1e-4f);
+
+	//conversion to the driver format
+	Vector<int32_t> out;
+	out.resize(BUFFER_SIZE * 2);
+
+	from = OS::get_singleton()->get_ticks_usec();
+
+	for (int n = 0; n < ITERATIONS; n++) {
+		AudioMix::convert_to_int32(out.ptrw(), 2, src, BUFFER_SIZE);
+	}
+
+	uint64_t convert_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	int convert_mismatches = 0;
+	for (int j = 0; j < BUFFER_SIZE; j++) {
+
+		float l = CLAMP(src[j].l, -1.0, 1.0);
+		int32_t vl = l * ((1 << 20) - 1);
+		float r = CLAMP(src[j].r, -1.0, 1.0);
+		int32_t vr = r * ((1 << 20) - 1);
+		if (out[j * 2 + 0] != (vl < 0 ? -1 : 1) * (ABS(vl) << 11) || out[j * 2 + 1] != (vr < 0 ? -1 : 1) * (ABS(vr) << 11)) {
+			convert_mismatches++;
+		}
+	}
+
+#if defined(AUDIO_SIMD_SSE2)
+	String kernel = "SSE2";
+#elif defined(AUDIO_SIMD_NEON)
+	String kernel = "NEON";
+#else
+	String kernel = "scalar";
+#endif
+
+	print_line(itos(VOICE_COUNT) + " voices of " + itos(BUFFER_SIZE) + " frames (" + kernel + "): ramped mix " + itos(ramp_usec / ITERATIONS) + " usec per buffer (plain loop " + itos(scalar_ramp_usec / ITERATIONS) + "), " + (ramp_match ? "match." : "MISMATCH."));
+	print_line("Bus volume and peak (" + kernel + "): " + itos(peak_usec) + " usec (plain loop " + itos(scalar_peak_usec) + "), " + (peak_match ? "match." : "MISMATCH."));
+	print_line("Conversion to int32 (" + kernel + "): " + itos(convert_usec) + " usec, " + itos(convert_mismatches) + " mismatches.");
+
+	return NULL;
+}
+} // namespace TestAudioMix
@@ -0,0 +1,442 @@
+/*************************************************************************/
+/*  test_benchmark.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_benchmark.h"
+
+#include "core/io/json.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "core/version.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/resources/packed_scene.h"
+#include "scene/resources/primitive_meshes.h"
+#include "servers/physics_server_3d.h"
+#include "servers/rendering_server.h"
+
+#include "modules/modules_enabled.gen.h"
+#ifdef MODULE_GDSCRIPT_ENABLED
+#include "modules/gdscript/gdscript.h"
+#endif
+
+namespace TestBenchmark {
+
+// Every benchmark has a setup (not timed), a body run once per sample and a cleanup.
+struct Benchmark {
+
+	const char *name;
+	bool (*setup)(void **r_userdata);
+	void (*run)(void *p_userdata);
+	void (*cleanup)(void *p_userdata);
+};
+
+/* Variant */
+
+static bool _variant_setup(void **r_userdata) {
+
+	*r_userdata = NULL;
+	return true;
+}
+
+static void _variant_run(void *p_userdata) {
+
+	Variant sum = 0;
+	Variant factor = 1.5;
+	Dictionary dict;
+	Array array;
+
+	for (int i = 0; i < 10000; i++) {
+		Variant value = i;
+		bool valid;
+		Variant product;
+		Variant::evaluate(Variant::OP_MULTIPLY, value, factor, product, valid);
+		Variant::evaluate(Variant::OP_ADD, sum, product, sum, valid);
+		dict[value] = product;
+		array.push_back(dict[value]);
+	}
+}
+
+static void _no_cleanup(void *p_userdata) {
+}
+
+/* GDScript */
+
+#ifdef MODULE_GDSCRIPT_ENABLED
+
+static bool _gdscript_setup(void **r_userdata) {
+
+	Ref<GDScript> script;
+	script.instance();
+	script->set_source_code(
+			"extends Object\n"
+			"func run():\n"
+			"\tvar s = 0\n"
+			"\tvar v = Vector3()\n"
+			"\tfor i in range(10000):\n"
+			"\t\ts += i * 2 - 1\n"
+			"\t\tv += Vector3(i, s, 1.0)\n"
+			"\treturn v\n");
+	Error err = script->reload();
+	ERR_FAIL_COND_V_MSG(err != OK, false, "Failed to compile the GDScript benchmark.");
+
+	Object *obj = memnew(Object);
+	obj->set_script(script);
+	*r_userdata = obj;
+	return true;
+}
+
+static void _gdscript_run(void *p_userdata) {
+
+	static_cast<Object *>(p_userdata)->call("run");
+}
+
+static void _gdscript_cleanup(void *p_userdata) {
+
+	memdelete(static_cast<Object *>(p_userdata));
+}
+
+#endif
+
+/* Physics */
+
+struct PhysicsWorld {
+
+	RID space;
+	Vector<RID> bodies;
+	Vector<RID> shapes;
+};
+
+static PhysicsWorld *_physics_create_world() {
+
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	if (!ps) {
+		return NULL;
+	}
+
+	PhysicsWorld *world = memnew(PhysicsWorld);
+	world->space = ps->space_create();
+	ps->space_set_active(world->space, true);
+	return world;
+}
+
+static RID _physics_add_body(PhysicsWorld *p_world, RID p_shape, PhysicsServer3D::BodyMode p_mode, const Vector3 &p_origin) {
+
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID body = ps->body_create(p_mode);
+	ps->body_set_space(body, p_world->space);
+	ps->body_add_shape(body, p_shape);
+	ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform(Basis(), p_origin));
+	p_world->bodies.push_back(body);
+	return body;
+}
+
+static void _physics_run(void *p_userdata) {
+
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	for (int i = 0; i < 10; i++) {
+		ps->sync();
+		ps->flush_queries();
+		ps->step(1.0 / 60.0);
+	}
+}
+
+static void _physics_cleanup(void *p_userdata) {
+
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	PhysicsWorld *world = static_cast<PhysicsWorld *>(p_userdata);
+	for (int i = 0; i < world->bodies.size(); i++) {
+		ps->free(world->bodies[i]);
+	}
+	for (int i = 0; i < world->shapes.size(); i++) {
+		ps->free(world->shapes[i]);
+	}
+	ps->free(world->space);
+	memdelete(world);
+}
+
+static bool _physics_stack_setup(void **r_userdata) {
+
+	PhysicsWorld *world = _physics_create_world();
+	ERR_FAIL_COND_V(!world, false);
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+
+	RID plane = ps->shape_create(PhysicsServer3D::SHAPE_PLANE);
+	ps->shape_set_data(plane, Plane(Vector3(0, 1, 0), 0));
+	world->shapes.push_back(plane);
+	_physics_add_body(world, plane, PhysicsServer3D::BODY_MODE_STATIC, Vector3());
+
+	RID box = ps->shape_create(PhysicsServer3D::SHAPE_BOX);
+	ps->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+	world->shapes.push_back(box);
+
+	// 10 columns of 10 boxes resting on each other.
+	for (int x = 0; x < 10; x++) {
+		for (int y = 0; y < 10; y++) {
+			_physics_add_body(world, box, PhysicsServer3D::BODY_MODE_RIGID, Vector3(x * 3, 0.5 + y * 1.01, 0));
+		}
+	}
+
+	*r_userdata = world;
+	return true;
+}
+
+static bool _physics_broadphase_setup(void **r_userdata) {
+
+	PhysicsWorld *world = _physics_create_world();
+	ERR_FAIL_COND_V(!world, false);
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+
+	RID sphere = ps->shape_create(PhysicsServer3D::SHAPE_SPHERE);
+	ps->shape_set_data(sphere, 0.5);
+	world->shapes.push_back(sphere);
+
+	// A dense cloud of spheres, so most of the time goes into pair management.
+	uint32_t seed = 12345;
+	for (int i = 0; i < 2000; i++) {
+		Vector3 origin;
+		for (int j = 0; j < 3; j++) {
+			seed = seed * 1103515245 + 12345;
+			origin[j] = ((seed >> 16) & 0x7FFF) / 32767.0 * 40.0;
+		}
+		_physics_add_body(world, sphere, PhysicsServer3D::BODY_MODE_RIGID, origin);
+	}
+
+	*r_userdata = world;
+	return true;
+}
+
+/* Canvas */
+
+static bool _canvas_setup(void **r_userdata) {
+
+	RenderingServer *rs = RenderingServer::get_singleton();
+	ERR_FAIL_COND_V(!rs, false);
+	*r_userdata = memnew(RID(rs->canvas_item_create()));
+	return true;
+}
+
+static void _canvas_run(void *p_userdata) {
+
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID item = *static_cast<RID *>(p_userdata);
+	rs->canvas_item_clear(item);
+	for (int i = 0; i < 10000; i++) {
+		rs->canvas_item_add_rect(item, Rect2((i % 100) * 10, (i / 100) * 10, 8, 8), Color(1, 1, 1));
+	}
+}
+
+static void _canvas_cleanup(void *p_userdata) {
+
+	RID *item = static_cast<RID *>(p_userdata);
+	RenderingServer::get_singleton()->free(*item);
+	memdelete(item);
+}
+
+/* Scenes and resources */
+
+static Ref<PackedScene> _create_scene() {
+
+	Ref<PrimitiveMesh> mesh = memnew(CubeMesh);
+
+	Node3D *root = memnew(Node3D);
+	root->set_name("Root");
+	for (int i = 0; i < 200; i++) {
+		MeshInstance3D *mi = memnew(MeshInstance3D);
+		mi->set_name("Mesh" + itos(i));
+		mi->set_mesh(mesh);
+		mi->set_transform(Transform(Basis(), Vector3(i, 0, 0)));
+		root->add_child(mi);
+		mi->set_owner(root);
+	}
+
+	Ref<PackedScene> scene;
+	scene.instance();
+	Error err = scene->pack(root);
+	memdelete(root);
+	ERR_FAIL_COND_V(err != OK, Ref<PackedScene>());
+	return scene;
+}
+
+static bool _instance_setup(void **r_userdata) {
+
+	Ref<PackedScene> scene = _create_scene();
+	ERR_FAIL_COND_V(scene.is_null(), false);
+	*r_userdata = memnew(Ref<PackedScene>(scene));
+	return true;
+}
+
+static void _instance_run(void *p_userdata) {
+
+	Node *node = (*static_cast<Ref<PackedScene> *>(p_userdata))->instance();
+	memdelete(node);
+}
+
+static void _instance_cleanup(void *p_userdata) {
+
+	memdelete(static_cast<Ref<PackedScene> *>(p_userdata));
+}
+
+static bool _resource_load_setup(void **r_userdata) {
+
+	Ref<PackedScene> scene = _create_scene();
+	ERR_FAIL_COND_V(scene.is_null(), false);
+
+	String path = OS::get_singleton()->get_cache_path().plus_file("godot_benchmark.scn");
+	Error err = ResourceSaver::save(path, scene);
+	ERR_FAIL_COND_V_MSG(err != OK, false, "Can't save the benchmark scene to: " + path + ".");
+
+	*r_userdata = memnew(String(path));
+	return true;
+}
+
+static void _resource_load_run(void *p_userdata) {
+
+	RES res = ResourceLoader::load(*static_cast<String *>(p_userdata), "", true);
+	ERR_FAIL_COND(res.is_null());
+}
+
+static void _resource_load_cleanup(void *p_userdata) {
+
+	String *path = static_cast<String *>(p_userdata);
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	da->remove(*path);
+	memdelete(da);
+	memdelete(path);
+}
+
+static const Benchmark benchmarks[] = {
+	{ "variant_ops", _variant_setup, _variant_run, _no_cleanup },
+#ifdef MODULE_GDSCRIPT_ENABLED
+	{ "gdscript_loop", _gdscript_setup, _gdscript_run, _gdscript_cleanup },
+#endif
+	{ "physics_3d_stack", _physics_stack_setup, _physics_run, _physics_cleanup },
+	{ "physics_3d_broadphase", _physics_broadphase_setup, _physics_run, _physics_cleanup },
+	{ "canvas_commands", _canvas_setup, _canvas_run, _canvas_cleanup },
+	{ "scene_instance", _instance_setup, _instance_run, _instance_cleanup },
+	{ "resource_load", _resource_load_setup, _resource_load_run, _resource_load_cleanup },
+	{ NULL, NULL, NULL, NULL }
+};
+
+static Dictionary _run_benchmark(const Benchmark &p_benchmark, int p_warmup, int p_samples) {
+
+	void *userdata = NULL;
+	if (!p_benchmark.setup(&userdata)) {
+		return Dictionary();
+	}
+
+	for (int i = 0; i < p_warmup; i++) {
+		p_benchmark.run(userdata);
+	}
+
+	Vector<uint64_t> times;
+	times.resize(p_samples);
+	uint64_t total = 0;
+	for (int i = 0; i < p_samples; i++) {
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		p_benchmark.run(userdata);
+		times.write[i] = OS::get_singleton()->get_ticks_usec() - from;
+		total += times[i];
+	}
+
+	p_benchmark.cleanup(userdata);
+
+	times.sort();
+
+	Dictionary result;
+	result["name"] = p_benchmark.name;
+	result["samples"] = p_samples;
+	result["min_usec"] = times[0];
+	result["median_usec"] = times[p_samples / 2];
+	result["p99_usec"] = times[MIN(p_samples - 1, (p_samples * 99) / 100)];
+	result["mean_usec"] = double(total) / p_samples;
+	return result;
+}
+
+MainLoop *test(const List<String> &p_args) {
+
+	int warmup = 3;
+	int samples = 30;
+	String filter;
+	String output;
+
+	for (const List<String>::Element *E = p_args.front(); E; E = E->next()) {
+		if (!E->next()) {
+			break;
+		}
+		if (E->get() == "--benchmark-samples") {
+			samples = MAX(1, E->next()->get().to_int());
+		} else if (E->get() == "--benchmark-warmup") {
+			warmup = MAX(0, E->next()->get().to_int());
+		} else if (E->get() == "--benchmark-filter") {
+			filter = E->next()->get();
+		} else if (E->get() == "--benchmark-output") {
+			output = E->next()->get();
+		}
+	}
+
+	Array results;
+	for (int i = 0; benchmarks[i].name; i++) {
+		if (filter != "" && !String(benchmarks[i].name).match(filter)) {
+			continue;
+		}
+
+		OS::get_singleton()->print("Running benchmark: %s\n", benchmarks[i].name);
+		Dictionary result = _run_benchmark(benchmarks[i], warmup, samples);
+		if (result.empty()) {
+			ERR_PRINT("Benchmark failed to set up: " + String(benchmarks[i].name) + ".");
+			OS::get_singleton()->set_exit_code(1);
+			continue;
+		}
+		results.push_back(result);
+	}
+
+	Dictionary report;
+	report["engine_version"] = VERSION_FULL_BUILD;
+	report["warmup"] = warmup;
+	report["benchmarks"] = results;
+	String json = JSON::print(report, "\t");
+
+	if (output != "") {
+		Error err;
+		FileAccess *f = FileAccess::open(output, FileAccess::WRITE, &err);
+		ERR_FAIL_COND_V_MSG(err != OK, NULL, "Can't write benchmark results to: " + output + ".");
+		f->store_string(json);
+		f->close();
+		memdelete(f);
+	} else {
+		OS::get_singleton()->print("%s\n", json.utf8().get_data());
+	}
+
+	return NULL;
+}
+
+} // namespace TestBenchmark
@@ -0,0 +1,199 @@
+/*************************************************************************/
+/*  test_dictionary.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_dictionary.h"
+
+#include "core/dictionary.h"
+#include "core/os/os.h"
+#include "core/variant.h"
+
+namespace TestDictionary {
+
+bool test_insert() {
+	Dictionary dict;
+	dict[42] = 84;
+	dict["key"] = "value";
+	dict[42] = 1234;
+
+	return dict.size() == 2 && int(dict[42]) == 1234 && String(dict["key"]) == "value" && dict.has("key") && !dict.has(0);
+}
+
+bool test_erase() {
+	Dictionary dict;
+	dict[42] = 84;
+	dict[123] = 12385;
+
+	bool erased = dict.erase(42);
+	bool erased_again = dict.erase(42);
+
+	return erased && !erased_again && dict.size() == 1 && !dict.has(42) && int(dict[123]) == 12385;
+}
+
+bool test_iteration_order() {
+	Dictionary dict;
+	for (int i = 0; i < 100; i++) {
+		dict[(i * 7919) % 100] = i;
+	}
+	//erase some in the middle, then add new keys and put back an erased one
+	for (int i = 0; i < 100; i += 3) {
+		dict.erase((i * 7919) % 100);
+	}
+	dict[1000] = 1000;
+	dict[0] = -1;
+
+	const Variant *K = NULL;
+	int last = -1;
+	while ((K = dict.next(K))) {
+		int value = dict[*K];
+		if (value == 1000 || value == -1) {
+			continue;
+		}
+		if (value <= last || value % 3 == 0) {
+			return false;
+		}
+		last = value;
+	}
+
+	Array keys = dict.keys();
+	return keys.size() == dict.size() && int(keys[keys.size() - 2]) == 1000 && int(keys[keys.size() - 1]) == 0;
+}
+
+bool test_erase_while_iterating() {
+	Dictionary dict;
+	for (int i = 0; i < 64; i++) {
+		dict[i] = i;
+	}
+
+	//erasing other keys must not move the one being visited, nor the ones after it
+	const Variant *K = NULL;
+	int visited = 0;
+	while ((K = dict.next(K))) {
+		int key = *K;
+		Variant *value = dict.getptr(key);
+		if (key + 1 < 64) {
+			dict.erase(key + 1);
+		}
+		if (!value || int(*value) != key || int(*K) != key) {
+			return false;
+		}
+		visited++;
+	}
+
+	return visited == 32 && dict.size() == 32;
+}
+
+bool test_erase_all_and_reuse() {
+	Dictionary dict;
+	for (int i = 0; i < 1000; i++) {
+		dict[i] = i;
+	}
+	for (int i = 0; i < 990; i++) {
+		dict.erase(i);
+	}
+	dict["new"] = true;
+
+	Array keys = dict.keys();
+	if (keys.size() != 11 || int(keys[0]) != 990 || String(keys[10]) != "new") {
+		return false;
+	}
+
+	for (int i = 990; i < 1000; i++) {
+		if (!dict.has(i) || int(dict[i]) != i) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool test_reference_across_compaction() {
+	Dictionary dict;
+	for (int i = 0; i < 100; i++) {
+		dict[i] = i;
+	}
+	Variant *value = dict.getptr(99);
+	const Variant *key = dict.next(NULL);
+	while (key && int(*key) != 98) {
+		key = dict.next(key);
+	}
+
+	//erase most keys, so the next inserts close the gaps and grow the index table
+	for (int i = 0; i < 90; i++) {
+		dict.erase(i);
+	}
+	for (int i = 100; i < 200; i++) {
+		dict[i] = i;
+	}
+
+	if (!key || value != dict.getptr(99) || int(*value) != 99 || int(*key) != 98) {
+		return false;
+	}
+	return int(*dict.next(key)) == 99 && int(dict.keys()[0]) == 90 && dict.size() == 110;
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+
+	test_insert,
+	test_erase,
+	test_iteration_order,
+	test_erase_while_iterating,
+	test_erase_all_and_reuse,
+	test_reference_across_compaction,
+	0
+
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return NULL;
+}
+} // namespace TestDictionary
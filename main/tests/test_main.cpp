@@ -35,6 +35,9 @@
 #ifdef DEBUG_ENABLED
 
 #include "test_astar.h"
+#include "test_audio_mix.h"
+#include "test_benchmark.h"
+#include "test_dictionary.h"
 #include "test_gdscript.h"
 #include "test_gui.h"
 #include "test_math.h"
@@ -45,6 +48,7 @@
 #include "test_render.h"
 #include "test_shader_lang.h"
 #include "test_string.h"
+#include "test_variant_parser.h"
 
 const char **tests_get_names() {
 
@@ -53,6 +57,8 @@ const char **tests_get_names() {
 		"math",
 		"physics_2d",
 		"physics_3d",
+		"physics_3d_broadphase",
+		"physics_3d_narrowphase",
 		"render",
 		"oa_hash_map",
 		"gui",
@@ -63,6 +69,10 @@ const char **tests_get_names() {
 		"gd_bytecode",
 		"ordered_hash_map",
 		"astar",
+		"variant_parser",
+		"audio_mix",
+		"benchmark",
+		"dictionary",
 		NULL
 	};
 
@@ -91,6 +101,16 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestPhysics3D::test();
 	}
 
+	if (p_test == "physics_3d_broadphase") {
+
+		return TestPhysics3D::test_broadphase();
+	}
+
+	if (p_test == "physics_3d_narrowphase") {
+
+		return TestPhysics3D::test_narrowphase();
+	}
+
 	if (p_test == "render") {
 
 		return TestRender::test();
@@ -143,6 +163,26 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestAStar::test();
 	}
 
+	if (p_test == "variant_parser") {
+
+		return TestVariantParser::test();
+	}
+
+	if (p_test == "audio_mix") {
+
+		return TestAudioMix::test();
+	}
+
+	if (p_test == "benchmark") {
+
+		return TestBenchmark::test(p_args);
+	}
+
+	if (p_test == "dictionary") {
+
+		return TestDictionary::test();
+	}
+
 	print_line("Unknown test: " + p_test);
 	return NULL;
 }
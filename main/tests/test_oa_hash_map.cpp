@@ -30,6 +30,7 @@
 
 #include "test_oa_hash_map.h"
 
+#include "core/hash_map.h"
 #include "core/oa_hash_map.h"
 #include "core/os/os.h"
 
@@ -152,6 +153,52 @@ MainLoop *test() {
 		map.set(5, 1);
 	}
 
+	// compare against HashMap, lookups of missing keys are where long probes would show
+	{
+		const int N = 100000;
+		String *keys = new String[N];
+
+		for (int i = 0; i < N; i++) {
+			keys[i] = "res://key_" + itos(i);
+		}
+
+		HashMap<String, int> hash_map;
+		OAHashMap<String, int> oa_map;
+
+		uint64_t t = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < N; i++) {
+			hash_map.set(keys[i], i);
+		}
+		uint64_t hash_map_insert = OS::get_singleton()->get_ticks_usec() - t;
+
+		t = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < N; i++) {
+			oa_map.set(keys[i], i);
+		}
+		uint64_t oa_map_insert = OS::get_singleton()->get_ticks_usec() - t;
+
+		int found = 0;
+		t = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < N * 2; i++) {
+			found += hash_map.has(keys[i % N]) ? 1 : 0;
+			found += hash_map.has(keys[i % N] + "_missing") ? 1 : 0;
+		}
+		uint64_t hash_map_lookup = OS::get_singleton()->get_ticks_usec() - t;
+
+		t = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < N * 2; i++) {
+			found += oa_map.has(keys[i % N]) ? 1 : 0;
+			found += oa_map.has(keys[i % N] + "_missing") ? 1 : 0;
+		}
+		uint64_t oa_map_lookup = OS::get_singleton()->get_ticks_usec() - t;
+
+		OS::get_singleton()->print("found %d of %d\n", found, N * 4);
+		OS::get_singleton()->print("HashMap insert %d usec, lookup %d usec\n", int(hash_map_insert), int(hash_map_lookup));
+		OS::get_singleton()->print("OAHashMap insert %d usec, lookup %d usec\n", int(oa_map_insert), int(oa_map_lookup));
+
+		delete[] keys;
+	}
+
 	return NULL;
 }
 } // namespace TestOAHashMap
@@ -37,6 +37,11 @@
 #include "core/os/os.h"
 #include "core/print_string.h"
 #include "servers/display_server.h"
+#include "servers/physics_3d/broad_phase_bvh.h"
+#include "servers/physics_3d/broad_phase_octree.h"
+#include "servers/physics_3d/collision_object_3d_sw.h"
+#include "servers/physics_3d/collision_solver_3d_sw.h"
+#include "servers/physics_3d/shape_3d_sw.h"
 #include "servers/physics_server_3d.h"
 #include "servers/rendering_server.h"
 
@@ -430,10 +435,275 @@ public:
 	}
 };
 
+class TestBroadPhaseObject3D : public CollisionObject3DSW {
+
+	virtual void _shapes_changed() {}
+
+public:
+	virtual void set_space(Space3DSW *p_space) {}
+
+	TestBroadPhaseObject3D() :
+			CollisionObject3DSW(TYPE_BODY) {}
+};
+
+static void *_broadphase_pair(CollisionObject3DSW *, int, CollisionObject3DSW *, int, void *p_userdata) {
+
+	(*(int *)p_userdata)++;
+	return NULL;
+}
+
+static void _broadphase_unpair(CollisionObject3DSW *, int, CollisionObject3DSW *, int, void *, void *p_userdata) {
+
+	(*(int *)p_userdata)--;
+}
+
+static void _benchmark_broadphase(const char *p_name, BroadPhase3DSW *p_broadphase) {
+
+	enum {
+		STATIC_COUNT = 4000,
+		DYNAMIC_COUNT = 4000,
+		FRAME_COUNT = 120,
+		CULL_MAX = 256,
+	};
+
+	int pair_count = 0;
+	p_broadphase->set_pair_callback(_broadphase_pair, &pair_count);
+	p_broadphase->set_unpair_callback(_broadphase_unpair, &pair_count);
+
+	TestBroadPhaseObject3D *objects = memnew_arr(TestBroadPhaseObject3D, STATIC_COUNT + DYNAMIC_COUNT);
+	Vector<BroadPhase3DSW::ID> ids;
+	Vector<Vector3> positions;
+	Vector<Vector3> velocities;
+
+	Math::seed(1234);
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+
+	//a static floor of boxes, with a cloud of bodies moving above it
+	for (int i = 0; i < STATIC_COUNT + DYNAMIC_COUNT; i++) {
+
+		bool is_static = i < STATIC_COUNT;
+		BroadPhase3DSW::ID id = p_broadphase->create(&objects[i]);
+		p_broadphase->set_static(id, is_static);
+
+		Vector3 pos = Vector3(Math::random(-100.0, 100.0), is_static ? 0.0 : Math::random(0.0, 50.0), Math::random(-100.0, 100.0));
+		p_broadphase->move(id, AABB(pos, Vector3(1, 1, 1)));
+
+		ids.push_back(id);
+		positions.push_back(pos);
+		velocities.push_back(is_static ? Vector3() : Vector3(Math::random(-1.0, 1.0), Math::random(-1.0, 1.0), Math::random(-1.0, 1.0)) * 0.1);
+	}
+
+	uint64_t create_usec = OS::get_singleton()->get_ticks_usec() - from;
+	from = OS::get_singleton()->get_ticks_usec();
+
+	for (int f = 0; f < FRAME_COUNT; f++) {
+
+		for (int i = STATIC_COUNT; i < STATIC_COUNT + DYNAMIC_COUNT; i++) {
+
+			Vector3 pos = positions[i] + velocities[i];
+			if (pos.y < 0.0 || pos.y > 50.0) {
+				velocities.write[i].y = -velocities[i].y;
+			}
+			positions.write[i] = pos;
+			p_broadphase->move(ids[i], AABB(pos, Vector3(1, 1, 1)));
+		}
+		p_broadphase->update();
+	}
+
+	uint64_t move_usec = OS::get_singleton()->get_ticks_usec() - from;
+	from = OS::get_singleton()->get_ticks_usec();
+
+	CollisionObject3DSW *results[CULL_MAX];
+	int result_count = 0;
+	for (int i = 0; i < 10000; i++) {
+
+		Vector3 pos = Vector3(Math::random(-100.0, 100.0), Math::random(0.0, 50.0), Math::random(-100.0, 100.0));
+		result_count += p_broadphase->cull_aabb(AABB(pos, Vector3(5, 5, 5)), results, CULL_MAX);
+	}
+
+	uint64_t cull_usec = OS::get_singleton()->get_ticks_usec() - from;
+	from = OS::get_singleton()->get_ticks_usec();
+
+	for (int i = 0; i < ids.size(); i++) {
+		p_broadphase->remove(ids[i]);
+	}
+
+	uint64_t remove_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	memdelete_arr(objects);
+
+	print_line(String(p_name) + ": create " + itos(create_usec) + " usec, move " + itos(move_usec / FRAME_COUNT) + " usec/frame, cull " + itos(cull_usec) + " usec (" + itos(result_count) + " results), remove " + itos(remove_usec) + " usec, " + itos(pair_count) + " pairs left.");
+}
+
+static void _narrowphase_contact(const Vector3 &p_point_A, const Vector3 &p_point_B, void *p_userdata) {
+
+	(*(int *)p_userdata)++;
+}
+
+static void _benchmark_narrowphase(int p_vertex_count) {
+
+	enum {
+		QUERY_COUNT = 100000,
+		PAIR_COUNT = 10000,
+	};
+
+	Math::seed(1234);
+
+	Vector<Vector3> points;
+	for (int i = 0; i < p_vertex_count; i++) {
+		points.push_back(Vector3(Math::random(-1.0, 1.0), Math::random(-1.0, 1.0), Math::random(-1.0, 1.0)).normalized());
+	}
+
+	ConvexPolygonShape3DSW shape_A;
+	shape_A.set_data(points);
+	ConvexPolygonShape3DSW shape_B;
+	shape_B.set_data(points);
+
+	const Vector<Vector3> &vertices = shape_A.get_mesh().vertices;
+	const Vector3 *vrts = vertices.ptr();
+	int vertex_count = vertices.size();
+
+	Vector<Vector3> normals;
+	Vector<Transform> transforms;
+	for (int i = 0; i < QUERY_COUNT; i++) {
+		normals.push_back(Vector3(Math::random(-1.0, 1.0), Math::random(-1.0, 1.0), Math::random(-1.0, 1.0)).normalized());
+		transforms.push_back(Transform(Basis(normals[i], Math::random(0.0, Math_TAU)), normals[i] * 1.5));
+	}
+
+	//the plain loops the convex shape used before, as a reference
+	int mismatches = 0;
+	real_t sum = 0;
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+
+	for (int i = 0; i < QUERY_COUNT; i++) {
+
+		int support = 0;
+		real_t support_max = 0;
+		for (int j = 0; j < vertex_count; j++) {
+			real_t d = normals[i].dot(vrts[j]);
+			if (j == 0 || d > support_max) {
+				support_max = d;
+				support = j;
+			}
+		}
+		sum += vrts[support].x;
+	}
+
+	uint64_t scalar_support_usec = OS::get_singleton()->get_ticks_usec() - from;
+	from = OS::get_singleton()->get_ticks_usec();
+
+	for (int i = 0; i < QUERY_COUNT; i++) {
+
+		real_t min = 0, max = 0;
+		for (int j = 0; j < vertex_count; j++) {
+			real_t d = normals[i].dot(transforms[i].xform(vrts[j]));
+			if (j == 0 || d > max)
+				max = d;
+			if (j == 0 || d < min)
+				min = d;
+		}
+		sum += max - min;
+	}
+
+	uint64_t scalar_range_usec = OS::get_singleton()->get_ticks_usec() - from;
+	from = OS::get_singleton()->get_ticks_usec();
+
+	for (int i = 0; i < QUERY_COUNT; i++) {
+		sum += shape_A.get_support(normals[i]).x;
+	}
+
+	uint64_t support_usec = OS::get_singleton()->get_ticks_usec() - from;
+	from = OS::get_singleton()->get_ticks_usec();
+
+	for (int i = 0; i < QUERY_COUNT; i++) {
+
+		real_t min, max;
+		shape_A.project_range(normals[i], transforms[i], min, max);
+		sum += max - min;
+	}
+
+	uint64_t range_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	//check the results outside of the timed loops
+	for (int i = 0; i < QUERY_COUNT; i++) {
+
+		real_t support_max = 0, ref_min = 0, ref_max = 0;
+		for (int j = 0; j < vertex_count; j++) {
+			real_t d = normals[i].dot(vrts[j]);
+			support_max = j == 0 ? d : MAX(support_max, d);
+			real_t pd = normals[i].dot(transforms[i].xform(vrts[j]));
+			ref_min = j == 0 ? pd : MIN(ref_min, pd);
+			ref_max = j == 0 ? pd : MAX(ref_max, pd);
+		}
+
+		real_t min, max;
+		shape_A.project_range(normals[i], transforms[i], min, max);
+		if (!Math::is_equal_approx(normals[i].dot(shape_A.get_support(normals[i])), support_max) || !Math::is_equal_approx(min, ref_min) || !Math::is_equal_approx(max, ref_max)) {
+			mismatches++;
+		}
+	}
+
+	//overlapping pairs, solved with SAT and with GJK
+	int contact_count = 0;
+	from = OS::get_singleton()->get_ticks_usec();
+
+	for (int i = 0; i < PAIR_COUNT; i++) {
+		CollisionSolver3DSW::solve_static(&shape_A, Transform(), &shape_B, transforms[i], _narrowphase_contact, &contact_count);
+	}
+
+	uint64_t sat_usec = OS::get_singleton()->get_ticks_usec() - from;
+	from = OS::get_singleton()->get_ticks_usec();
+
+	for (int i = 0; i < PAIR_COUNT; i++) {
+
+		Vector3 point_A, point_B;
+		Transform apart = transforms[i];
+		apart.origin *= 2.0;
+		CollisionSolver3DSW::solve_distance(&shape_A, Transform(), &shape_B, apart, point_A, point_B, AABB());
+		sum += point_A.x;
+	}
+
+	uint64_t gjk_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+#if defined(PHYSICS_SIMD_SSE)
+	String kernel = "SSE";
+#elif defined(PHYSICS_SIMD_NEON)
+	String kernel = "NEON";
+#else
+	String kernel = "scalar";
+#endif
+
+	print_line(itos(vertex_count) + " vertices (" + kernel + "): support " + itos(support_usec) + " usec (plain loop " + itos(scalar_support_usec) + "), project_range " + itos(range_usec) + " usec (plain loop " + itos(scalar_range_usec) + "), " + itos(mismatches) + " mismatches.");
+	print_line(itos(vertex_count) + " vertices (" + kernel + "): SAT " + itos(sat_usec) + " usec (" + itos(contact_count) + " contacts), GJK " + itos(gjk_usec) + " usec, checksum " + rtos(sum) + ".");
+}
+
 namespace TestPhysics3D {
 
 MainLoop *test() {
 
 	return memnew(TestPhysics3DMainLoop);
 }
+
+MainLoop *test_broadphase() {
+
+	BroadPhase3DSW *octree = BroadPhaseOctree::_create();
+	_benchmark_broadphase("Octree", octree);
+	memdelete(octree);
+
+	BroadPhase3DSW *bvh = BroadPhaseBVH::_create();
+	_benchmark_broadphase("BVH", bvh);
+	memdelete(bvh);
+
+	return NULL;
+}
+
+MainLoop *test_narrowphase() {
+
+	_benchmark_narrowphase(16);
+	_benchmark_narrowphase(64);
+	_benchmark_narrowphase(256);
+
+	return NULL;
+}
 } // namespace TestPhysics3D
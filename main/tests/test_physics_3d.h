@@ -36,6 +36,8 @@
 namespace TestPhysics3D {
 
 MainLoop *test();
+MainLoop *test_broadphase();
+MainLoop *test_narrowphase();
 }
 
 #endif
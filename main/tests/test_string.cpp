@@ -1125,6 +1125,56 @@ bool test_35() {
 	return state;
 }
 
+bool test_36() {
+
+	OS::get_singleton()->print("\n\nTest 36: search, case and UTF-8 on long strings (benchmark)\n");
+
+	String ascii;
+	String wide;
+	for (int i = 0; i < 100000; i++) {
+		ascii += CharType('a' + (i % 23));
+		wide += (i % 7) ? CharType('a' + (i % 23)) : CharType(0x3B1 + (i % 17));
+	}
+	ascii += "needle";
+	wide += String::utf8("nééd");
+
+	bool state = true;
+	const int runs = 20;
+	uint64_t from;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < runs; i++) {
+		state = state && ascii.find("needle") == 100000;
+		state = state && wide.find(String::utf8("nééd")) == 100000;
+	}
+	OS::get_singleton()->print("\tfind: %i usec\n", int(OS::get_singleton()->get_ticks_usec() - from));
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < runs; i++) {
+		state = state && ascii.findn("NEEDLE") == 100000;
+		state = state && wide.findn(String::utf8("NÉÉD")) == 100000;
+	}
+	OS::get_singleton()->print("\tfindn: %i usec\n", int(OS::get_singleton()->get_ticks_usec() - from));
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < runs; i++) {
+		String upper = wide.to_upper();
+		state = state && upper.to_lower() == wide;
+	}
+	OS::get_singleton()->print("\tto_upper/to_lower: %i usec\n", int(OS::get_singleton()->get_ticks_usec() - from));
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < runs; i++) {
+		CharString utf8 = wide.utf8();
+		String back;
+		back.parse_utf8(utf8.get_data(), utf8.length());
+		state = state && back == wide;
+	}
+	OS::get_singleton()->print("\tutf8/parse_utf8: %i usec\n", int(OS::get_singleton()->get_ticks_usec() - from));
+
+	return state;
+}
+
 typedef bool (*TestFunc)(void);
 
 TestFunc test_funcs[] = {
@@ -1164,6 +1214,7 @@ TestFunc test_funcs[] = {
 	test_33,
 	test_34,
 	test_35,
+	test_36,
 	0
 
 };
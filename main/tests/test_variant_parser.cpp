@@ -0,0 +1,142 @@
+/*************************************************************************/
+/*  test_variant_parser.cpp                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_variant_parser.h"
+
+#include "core/io/file_access_memory.h"
+#include "core/os/os.h"
+#include "core/variant_parser.h"
+
+namespace TestVariantParser {
+
+//reads one character per call, like the parser used to
+struct StreamUnbuffered : public VariantParser::Stream {
+
+	FileAccess *f;
+
+	virtual CharType get_char() { return f->get_8(); }
+	virtual bool is_utf8() const { return true; }
+	virtual bool is_eof() const { return f->eof_reached(); }
+
+	StreamUnbuffered() { f = NULL; }
+};
+
+static CharString _make_scene(int p_nodes) {
+
+	String text = "[gd_scene load_steps=2 format=2]\n\n";
+	for (int i = 0; i < p_nodes; i++) {
+		text += "[node name=\"Node" + itos(i) + "\" type=\"MeshInstance\" parent=\".\"]\n";
+		text += "transform = Transform( 1, 0, 0, 0, 1, 0, 0, 0, 1, " + rtos(i * 0.5) + ", 2.25, -3 )\n";
+		text += "visible = true\n";
+		text += "text = \"Nod" + String::chr(0xE9) + " " + itos(i) + " \\\"quoted\\\"\"\n";
+		text += "points = PackedVector3Array( 0, 1, 2, 3.5, 4.5, 5.5, -6, -7, -8e-2 )\n";
+		text += "indices = PackedInt32Array( 0, 1, 2, 2, 3, 0, 4, 5, 6, 6, 7, 4 )\n";
+		text += "colors = PackedColorArray( 1, 0, 0, 1, 0, 1, 0, 0.5 )\n\n";
+	}
+	return text.utf8();
+}
+
+static int _parse_all(VariantParser::Stream *p_stream, uint64_t &r_hash) {
+
+	int count = 0;
+	int line = 1;
+	while (true) {
+
+		VariantParser::Tag tag;
+		String assign;
+		Variant value;
+		String err;
+		Error error = VariantParser::parse_tag_assign_eof(p_stream, line, err, tag, assign, value, NULL, true);
+		if (error == ERR_FILE_EOF) {
+			break;
+		}
+		if (error != OK) {
+			OS::get_singleton()->print("parse error at line %d: %s\n", line, err.utf8().get_data());
+			return -1;
+		}
+
+		r_hash = hash_djb2_one_64((tag.name + assign).hash(), r_hash);
+		r_hash = hash_djb2_one_64(value.hash(), r_hash);
+		count++;
+	}
+	return count;
+}
+
+MainLoop *test() {
+
+	List<String> args = OS::get_singleton()->get_cmdline_args();
+	int nodes = 20000;
+	if (args.size() && args.back()->get().is_valid_integer()) {
+		nodes = args.back()->get().to_int();
+	}
+
+	CharString scene = _make_scene(nodes);
+	OS::get_singleton()->print("scene with %d nodes, %d bytes\n", nodes, scene.length());
+
+	uint64_t unbuffered_hash = 0;
+	uint64_t unbuffered_time;
+	int unbuffered_count;
+	{
+		FileAccessMemory fa;
+		fa.open_custom((const uint8_t *)scene.get_data(), scene.length());
+		StreamUnbuffered stream;
+		stream.f = &fa;
+
+		uint64_t t = OS::get_singleton()->get_ticks_usec();
+		unbuffered_count = _parse_all(&stream, unbuffered_hash);
+		unbuffered_time = OS::get_singleton()->get_ticks_usec() - t;
+	}
+
+	uint64_t buffered_hash = 0;
+	uint64_t buffered_time;
+	int buffered_count;
+	{
+		FileAccessMemory fa;
+		fa.open_custom((const uint8_t *)scene.get_data(), scene.length());
+		VariantParser::StreamFile stream;
+		stream.f = &fa;
+
+		uint64_t t = OS::get_singleton()->get_ticks_usec();
+		buffered_count = _parse_all(&stream, buffered_hash);
+		buffered_time = OS::get_singleton()->get_ticks_usec() - t;
+	}
+
+	OS::get_singleton()->print("unbuffered: %d entries in %d usec\n", unbuffered_count, int(unbuffered_time));
+	OS::get_singleton()->print("buffered:   %d entries in %d usec\n", buffered_count, int(buffered_time));
+
+	if (unbuffered_count != buffered_count || unbuffered_hash != buffered_hash) {
+		OS::get_singleton()->print("FAIL: buffered stream parsed different values\n");
+	} else {
+		OS::get_singleton()->print("PASS\n");
+	}
+
+	return NULL;
+}
+} // namespace TestVariantParser
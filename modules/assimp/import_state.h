@@ -60,6 +60,7 @@ struct ImportState {
 	Node3D *root;
 	const aiScene *assimp_scene;
 	uint32_t max_bone_weights;
+	bool use_compression;
 
 	Map<String, Ref<Mesh>> mesh_cache;
 	Map<int, Ref<Material>> material_cache;
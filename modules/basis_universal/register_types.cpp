@@ -31,6 +31,7 @@
 #include "register_types.h"
 
 #include "core/os/os.h"
+#include "core/thread_work_pool.h"
 #include "servers/rendering_server.h"
 #include "texture_basisu.h"
 
@@ -151,6 +152,27 @@ static Vector<uint8_t> basis_universal_packer(const Ref<Image> &p_image, Image::
 }
 #endif // TOOLS_ENABLED
 
+struct BasisTranscodeLevel {
+	uint32_t offset = 0; // In bytes, into the final image data.
+	uint32_t size = 0; // In blocks, or pixels for uncompressed formats.
+	basist::basisu_transcoder_state state; // Each level has its own, so levels can be transcoded concurrently.
+	bool ok = false;
+};
+
+struct BasisTranscodeJob {
+	const basist::basisu_transcoder *transcoder;
+	const uint8_t *data;
+	uint32_t data_size;
+	basist::transcoder_texture_format format;
+	uint8_t *dst;
+	BasisTranscodeLevel *levels;
+
+	void transcode_level(uint32_t p_level, void *p_userdata) {
+		BasisTranscodeLevel &level = levels[p_level];
+		level.ok = transcoder->transcode_image_level(data, data_size, 0, p_level, dst + level.offset, level.size, format, 0, 0, &level.state);
+	}
+};
+
 static Ref<Image> basis_universal_unpacker(const Vector<uint8_t> &p_buffer) {
 	Ref<Image> image;
 
@@ -229,39 +251,58 @@ static Ref<Image> basis_universal_unpacker(const Vector<uint8_t> &p_buffer) {
 	ptr += 4;
 	size -= 4;
 
-	basist::basisu_transcoder tr(NULL);
+	basist::basisu_transcoder tr(sel_codebook);
 
 	ERR_FAIL_COND_V(!tr.validate_header(ptr, size), image);
 
 	basist::basisu_image_info info;
 	tr.get_image_info(ptr, size, info, 0);
 
-	int block_size = basist::basis_get_bytes_per_block(format);
-	Vector<uint8_t> gpudata;
-	gpudata.resize(info.m_total_blocks * block_size);
+	bool uncompressed = basist::basis_transcoder_format_is_uncompressed(format);
+	uint32_t unit_size = uncompressed ? basist::basis_get_uncompressed_bytes_per_pixel(format) : basist::basis_get_bytes_per_block(format);
 
-	{
-		uint8_t *w = gpudata.ptrw();
-		uint8_t *dst = w;
-		for (int i = 0; i < gpudata.size(); i++)
-			dst[i] = 0x00;
+	//lay out all levels first, so each one is transcoded straight into its place in the final image data
+	Vector<BasisTranscodeLevel> levels;
+	levels.resize(info.m_total_levels);
+	uint32_t total_size = 0;
 
-		int ofs = 0;
-		tr.start_transcoding(ptr, size);
-		for (uint32_t i = 0; i < info.m_total_levels; i++) {
+	for (uint32_t i = 0; i < info.m_total_levels; i++) {
 
-			basist::basisu_image_level_info level;
-			tr.get_image_level_info(ptr, size, level, 0, i);
+		basist::basisu_image_level_info level_info;
+		ERR_FAIL_COND_V(!tr.get_image_level_info(ptr, size, level_info, 0, i), image);
 
-			bool ret = tr.transcode_image_level(ptr, size, 0, i, dst + ofs, level.m_total_blocks - i, format);
-			if (!ret) {
-				printf("failed! on level %i\n", i);
-				break;
-			};
+		BasisTranscodeLevel &level = levels.write[i];
+		level.offset = total_size;
+		level.size = uncompressed ? level_info.m_orig_width * level_info.m_orig_height : level_info.m_total_blocks;
+		total_size += level.size * unit_size;
+	}
 
-			ofs += level.m_total_blocks * block_size;
-		};
-	};
+	Vector<uint8_t> gpudata;
+	gpudata.resize(total_size);
+
+	ERR_FAIL_COND_V(!tr.start_transcoding(ptr, size), image);
+
+	BasisTranscodeJob job;
+	job.transcoder = &tr;
+	job.data = ptr;
+	job.data_size = size;
+	job.format = format;
+	job.dst = gpudata.ptrw();
+	job.levels = levels.ptrw();
+
+	//the codebooks are decoded once above, levels only read them
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (info.m_total_levels > 1 && pool && pool->get_thread_count() > 0) {
+		pool->do_work(info.m_total_levels, &job, &BasisTranscodeJob::transcode_level, (void *)NULL);
+	} else {
+		for (uint32_t i = 0; i < info.m_total_levels; i++) {
+			job.transcode_level(i, NULL);
+		}
+	}
+
+	for (uint32_t i = 0; i < info.m_total_levels; i++) {
+		ERR_FAIL_COND_V_MSG(!levels[i].ok, image, "Failed transcoding Basis Universal mipmap level " + itos(i) + ".");
+	}
 
 	image.instance();
 	image->create(info.m_width, info.m_height, info.m_total_levels > 1, imgfmt, gpudata);
@@ -270,8 +311,10 @@ static Ref<Image> basis_universal_unpacker(const Vector<uint8_t> &p_buffer) {
 }
 
 void register_basis_universal_types() {
-#ifdef TOOLS_ENABLED
+	//set up the transcoder tables and global codebook once, instead of on every loader thread
+	basist::basisu_transcoder_init();
 	sel_codebook = new basist::etc1_global_selector_codebook(basist::g_global_selector_cb_size, basist::g_global_selector_cb);
+#ifdef TOOLS_ENABLED
 	Image::basis_universal_packer = basis_universal_packer;
 #endif
 	Image::basis_universal_unpacker = basis_universal_unpacker;
@@ -281,8 +324,9 @@ void register_basis_universal_types() {
 void unregister_basis_universal_types() {
 
 #ifdef TOOLS_ENABLED
-	delete sel_codebook;
 	Image::basis_universal_packer = NULL;
 #endif
+	delete sel_codebook;
+	sel_codebook = nullptr;
 	Image::basis_universal_unpacker = NULL;
 }
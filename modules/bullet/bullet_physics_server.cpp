@@ -81,7 +81,8 @@ void BulletPhysicsServer3D::_bind_methods() {
 BulletPhysicsServer3D::BulletPhysicsServer3D() :
 		PhysicsServer3D(),
 		active(true),
-		active_spaces_count(0) {}
+		active_spaces_count(0),
+		task_scheduler(NULL) {}
 
 BulletPhysicsServer3D::~BulletPhysicsServer3D() {}
 
@@ -1554,6 +1555,10 @@ void BulletPhysicsServer3D::free(RID p_rid) {
 
 void BulletPhysicsServer3D::init() {
 	BulletPhysicsDirectBodyState3D::initSingleton();
+
+	// used by the multithreaded worlds, must be set from the thread stepping the spaces
+	task_scheduler = bulletnew(GodotTaskScheduler);
+	btSetTaskScheduler(task_scheduler);
 }
 
 void BulletPhysicsServer3D::step(float p_deltaTime) {
@@ -1576,6 +1581,9 @@ void BulletPhysicsServer3D::flush_queries() {
 
 void BulletPhysicsServer3D::finish() {
 	BulletPhysicsDirectBodyState3D::destroySingleton();
+
+	btSetTaskScheduler(NULL);
+	bulletdelete(task_scheduler);
 }
 
 int BulletPhysicsServer3D::get_process_info(ProcessInfo p_info) {
@@ -34,6 +34,7 @@
 #include "area_bullet.h"
 #include "core/rid.h"
 #include "core/rid_owner.h"
+#include "godot_task_scheduler.h"
 #include "joint_bullet.h"
 #include "rigid_body_bullet.h"
 #include "servers/physics_server_3d.h"
@@ -53,6 +54,8 @@ class BulletPhysicsServer3D : public PhysicsServer3D {
 	char active_spaces_count;
 	Vector<SpaceBullet *> active_spaces;
 
+	GodotTaskScheduler *task_scheduler;
+
 	mutable RID_PtrOwner<SpaceBullet> space_owner;
 	mutable RID_PtrOwner<ShapeBullet> shape_owner;
 	mutable RID_PtrOwner<AreaBullet> area_owner;
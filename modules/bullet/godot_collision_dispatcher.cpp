@@ -38,11 +38,15 @@
 
 const int GodotCollisionDispatcher::CASTED_TYPE_AREA = static_cast<int>(CollisionObjectBullet::TYPE_AREA);
 
+bool GodotCollisionDispatcher::is_area_pair(const btCollisionObject *body0, const btCollisionObject *body1) {
+	return body0->getUserIndex() == CASTED_TYPE_AREA || body1->getUserIndex() == CASTED_TYPE_AREA;
+}
+
 GodotCollisionDispatcher::GodotCollisionDispatcher(btCollisionConfiguration *collisionConfiguration) :
 		btCollisionDispatcher(collisionConfiguration) {}
 
 bool GodotCollisionDispatcher::needsCollision(const btCollisionObject *body0, const btCollisionObject *body1) {
-	if (body0->getUserIndex() == CASTED_TYPE_AREA || body1->getUserIndex() == CASTED_TYPE_AREA) {
+	if (is_area_pair(body0, body1)) {
 		// Avoide area narrow phase
 		return false;
 	}
@@ -50,9 +54,28 @@ bool GodotCollisionDispatcher::needsCollision(const btCollisionObject *body0, co
 }
 
 bool GodotCollisionDispatcher::needsResponse(const btCollisionObject *body0, const btCollisionObject *body1) {
-	if (body0->getUserIndex() == CASTED_TYPE_AREA || body1->getUserIndex() == CASTED_TYPE_AREA) {
+	if (is_area_pair(body0, body1)) {
 		// Avoide area narrow phase
 		return false;
 	}
 	return btCollisionDispatcher::needsResponse(body0, body1);
 }
+
+GodotCollisionDispatcherMt::GodotCollisionDispatcherMt(btCollisionConfiguration *collisionConfiguration) :
+		btCollisionDispatcherMt(collisionConfiguration) {}
+
+bool GodotCollisionDispatcherMt::needsCollision(const btCollisionObject *body0, const btCollisionObject *body1) {
+	if (GodotCollisionDispatcher::is_area_pair(body0, body1)) {
+		// Avoide area narrow phase
+		return false;
+	}
+	return btCollisionDispatcherMt::needsCollision(body0, body1);
+}
+
+bool GodotCollisionDispatcherMt::needsResponse(const btCollisionObject *body0, const btCollisionObject *body1) {
+	if (GodotCollisionDispatcher::is_area_pair(body0, body1)) {
+		// Avoide area narrow phase
+		return false;
+	}
+	return btCollisionDispatcherMt::needsResponse(body0, body1);
+}
@@ -33,6 +33,7 @@
 
 #include "core/int_types.h"
 
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <btBulletDynamicsCommon.h>
 
 /**
@@ -45,8 +46,18 @@ private:
 	static const int CASTED_TYPE_AREA;
 
 public:
+	static bool is_area_pair(const btCollisionObject *body0, const btCollisionObject *body1);
+
 	GodotCollisionDispatcher(btCollisionConfiguration *collisionConfiguration);
 	virtual bool needsCollision(const btCollisionObject *body0, const btCollisionObject *body1);
 	virtual bool needsResponse(const btCollisionObject *body0, const btCollisionObject *body1);
 };
+
+/// Same as GodotCollisionDispatcher, for the multithreaded world
+class GodotCollisionDispatcherMt : public btCollisionDispatcherMt {
+public:
+	GodotCollisionDispatcherMt(btCollisionConfiguration *collisionConfiguration);
+	virtual bool needsCollision(const btCollisionObject *body0, const btCollisionObject *body1);
+	virtual bool needsResponse(const btCollisionObject *body0, const btCollisionObject *body1);
+};
 #endif
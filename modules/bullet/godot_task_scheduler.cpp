@@ -0,0 +1,141 @@
+/*************************************************************************/
+/*  godot_task_scheduler.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "godot_task_scheduler.h"
+
+#include "core/os/memory.h"
+#include "core/thread_work_pool.h"
+
+// defined in btThreads.cpp, lets Bullet avoid nesting its own parallel loops
+void btPushThreadsAreRunning();
+void btPopThreadsAreRunning();
+
+int GodotTaskScheduler::_get_chunk_count(int p_begin, int p_end, int p_grain_size, int &r_chunk_size) const {
+
+	int count = p_end - p_begin;
+	int grain_size = MAX(p_grain_size, 1);
+
+	// never make more chunks than threads allowed for this step
+	int chunk_count = MIN((count + grain_size - 1) / grain_size, thread_count);
+	if (chunk_count <= 1) {
+		r_chunk_size = count;
+		return 1;
+	}
+
+	r_chunk_size = (count + chunk_count - 1) / chunk_count;
+	return (count + r_chunk_size - 1) / r_chunk_size;
+}
+
+void GodotTaskScheduler::_for_chunk(uint32_t p_index, ForData *p_data) {
+
+	int from = p_data->begin + p_index * p_data->chunk_size;
+	p_data->body->forLoop(from, MIN(from + p_data->chunk_size, p_data->end));
+}
+
+void GodotTaskScheduler::_sum_chunk(uint32_t p_index, SumData *p_data) {
+
+	int from = p_data->begin + p_index * p_data->chunk_size;
+	p_data->sums[p_index] = p_data->body->sumLoop(from, MIN(from + p_data->chunk_size, p_data->end));
+}
+
+int GodotTaskScheduler::getMaxNumThreads() const {
+
+	// the thread waiting for the loop also works on it
+	return MIN((int)ThreadWorkPool::get_singleton()->get_thread_count() + 1, (int)BT_MAX_THREAD_COUNT);
+}
+
+int GodotTaskScheduler::getNumThreads() const {
+
+	return thread_count;
+}
+
+void GodotTaskScheduler::setNumThreads(int p_thread_count) {
+
+	thread_count = CLAMP(p_thread_count, 1, getMaxNumThreads());
+}
+
+void GodotTaskScheduler::parallelFor(int p_begin, int p_end, int p_grain_size, const btIParallelForBody &p_body) {
+
+	if (p_begin >= p_end) {
+		return;
+	}
+
+	ForData data;
+	data.body = &p_body;
+	data.begin = p_begin;
+	data.end = p_end;
+
+	int chunk_count = _get_chunk_count(p_begin, p_end, p_grain_size, data.chunk_size);
+	if (chunk_count == 1) {
+		p_body.forLoop(p_begin, p_end);
+		return;
+	}
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	btPushThreadsAreRunning();
+	pool->wait_for_task(pool->add_group_task(chunk_count, this, &GodotTaskScheduler::_for_chunk, &data, 1));
+	btPopThreadsAreRunning();
+}
+
+btScalar GodotTaskScheduler::parallelSum(int p_begin, int p_end, int p_grain_size, const btIParallelSumBody &p_body) {
+
+	if (p_begin >= p_end) {
+		return 0;
+	}
+
+	SumData data;
+	data.body = &p_body;
+	data.begin = p_begin;
+	data.end = p_end;
+
+	int chunk_count = _get_chunk_count(p_begin, p_end, p_grain_size, data.chunk_size);
+	if (chunk_count == 1) {
+		return p_body.sumLoop(p_begin, p_end);
+	}
+
+	data.sums = (btScalar *)alloca(sizeof(btScalar) * chunk_count);
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	btPushThreadsAreRunning();
+	pool->wait_for_task(pool->add_group_task(chunk_count, this, &GodotTaskScheduler::_sum_chunk, &data, 1));
+	btPopThreadsAreRunning();
+
+	btScalar sum = 0;
+	for (int i = 0; i < chunk_count; i++) {
+		sum += data.sums[i];
+	}
+	return sum;
+}
+
+GodotTaskScheduler::GodotTaskScheduler() :
+		btITaskScheduler("Godot") {
+
+	thread_count = getMaxNumThreads();
+}
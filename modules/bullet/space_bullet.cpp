@@ -38,6 +38,7 @@
 #include "core/ustring.h"
 #include "godot_collision_configuration.h"
 #include "godot_collision_dispatcher.h"
+#include "godot_task_scheduler.h"
 #include "rigid_body_bullet.h"
 #include "servers/physics_server_3d.h"
 #include "soft_body_bullet.h"
@@ -49,6 +50,8 @@
 #include <BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h>
 #include <BulletCollision/NarrowPhaseCollision/btPointCollector.h>
 #include <BulletSoftBody/btSoftBodyRigidBodyCollisionConfiguration.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include <BulletSoftBody/btSoftRigidDynamicsWorld.h>
 #include <btBulletDynamicsCommon.h>
 
@@ -336,6 +339,7 @@ SpaceBullet::SpaceBullet() :
 		collisionConfiguration(NULL),
 		dispatcher(NULL),
 		solver(NULL),
+		solver_mt(NULL),
 		dynamicsWorld(NULL),
 		soft_body_world_info(NULL),
 		ghostPairCallback(NULL),
@@ -343,9 +347,19 @@ SpaceBullet::SpaceBullet() :
 		gravityDirection(0, -1, 0),
 		gravityMagnitude(10),
 		contactDebugCount(0),
-		delta_time(0.) {
+		delta_time(0.),
+		multithreaded(false),
+		thread_count(0) {
+
+	bool soft_world = GLOBAL_DEF("physics/3d/active_soft_world", true);
+	bool multithreaded_world = GLOBAL_GET("physics/3d/bullet/multithreaded_world");
+	if (soft_world && multithreaded_world) {
+		WARN_PRINT("Bullet's soft body world can't be multithreaded, disable \"physics/3d/active_soft_world\" to use \"physics/3d/bullet/multithreaded_world\".");
+		multithreaded_world = false;
+	}
+	thread_count = GLOBAL_GET("physics/3d/bullet/thread_count");
 
-	create_empty_world(GLOBAL_DEF("physics/3d/active_soft_world", true));
+	create_empty_world(soft_world, multithreaded_world);
 	direct_access = memnew(BulletPhysicsDirectSpaceState(this));
 }
 
@@ -363,6 +377,11 @@ void SpaceBullet::flush_queries() {
 
 void SpaceBullet::step(real_t p_delta_time) {
 	delta_time = p_delta_time;
+	if (multithreaded) {
+		// the task scheduler is shared by all spaces
+		btITaskScheduler *task_scheduler = btGetTaskScheduler();
+		task_scheduler->setNumThreads(thread_count > 0 ? thread_count : task_scheduler->getMaxNumThreads());
+	}
 	dynamicsWorld->stepSimulation(p_delta_time, 0, 0);
 }
 
@@ -426,6 +445,9 @@ void SpaceBullet::set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_va
 		case PhysicsServer3D::SPACE_PARAM_BODY_ANGULAR_VELOCITY_SLEEP_THRESHOLD:
 		case PhysicsServer3D::SPACE_PARAM_BODY_TIME_TO_SLEEP:
 		case PhysicsServer3D::SPACE_PARAM_BODY_ANGULAR_VELOCITY_DAMP_RATIO:
+		case PhysicsServer3D::SPACE_PARAM_THREAD_COUNT:
+			thread_count = MAX((int)p_value, 0);
+			break;
 		case PhysicsServer3D::SPACE_PARAM_CONSTRAINT_DEFAULT_BIAS:
 		default:
 			WARN_PRINT("This set parameter (" + itos(p_param) + ") is ignored, the SpaceBullet doesn't support it.");
@@ -442,6 +464,8 @@ real_t SpaceBullet::get_param(PhysicsServer3D::SpaceParameter p_param) {
 		case PhysicsServer3D::SPACE_PARAM_BODY_ANGULAR_VELOCITY_SLEEP_THRESHOLD:
 		case PhysicsServer3D::SPACE_PARAM_BODY_TIME_TO_SLEEP:
 		case PhysicsServer3D::SPACE_PARAM_BODY_ANGULAR_VELOCITY_DAMP_RATIO:
+		case PhysicsServer3D::SPACE_PARAM_THREAD_COUNT:
+			return thread_count;
 		case PhysicsServer3D::SPACE_PARAM_CONSTRAINT_DEFAULT_BIAS:
 		default:
 			WARN_PRINT("The SpaceBullet  doesn't support this get parameter (" + itos(p_param) + "), 0 is returned.");
@@ -579,7 +603,7 @@ btScalar calculateGodotCombinedFriction(const btCollisionObject *body0, const bt
 	return ABS(MIN(body0->getFriction(), body1->getFriction()));
 }
 
-void SpaceBullet::create_empty_world(bool p_create_soft_world) {
+void SpaceBullet::create_empty_world(bool p_create_soft_world, bool p_multithreaded) {
 
 	gjk_epa_pen_solver = bulletnew(btGjkEpaPenetrationDepthSolver);
 	gjk_simplex_solver = bulletnew(btVoronoiSimplexSolver);
@@ -587,6 +611,8 @@ void SpaceBullet::create_empty_world(bool p_create_soft_world) {
 	void *world_mem;
 	if (p_create_soft_world) {
 		world_mem = malloc(sizeof(btSoftRigidDynamicsWorld));
+	} else if (p_multithreaded) {
+		world_mem = malloc(sizeof(btDiscreteDynamicsWorldMt));
 	} else {
 		world_mem = malloc(sizeof(btDiscreteDynamicsWorld));
 	}
@@ -599,14 +625,27 @@ void SpaceBullet::create_empty_world(bool p_create_soft_world) {
 		collisionConfiguration = bulletnew(GodotCollisionConfiguration(static_cast<btDiscreteDynamicsWorld *>(world_mem)));
 	}
 
-	dispatcher = bulletnew(GodotCollisionDispatcher(collisionConfiguration));
+	multithreaded = p_multithreaded && !p_create_soft_world;
+
+	if (multithreaded) {
+		dispatcher = bulletnew(GodotCollisionDispatcherMt(collisionConfiguration));
+	} else {
+		dispatcher = bulletnew(GodotCollisionDispatcher(collisionConfiguration));
+	}
 	broadphase = bulletnew(btDbvtBroadphase);
-	solver = bulletnew(btSequentialImpulseConstraintSolver);
 
 	if (p_create_soft_world) {
+		solver = bulletnew(btSequentialImpulseConstraintSolver);
 		dynamicsWorld = new (world_mem) btSoftRigidDynamicsWorld(dispatcher, broadphase, solver, collisionConfiguration);
 		soft_body_world_info = bulletnew(btSoftBodyWorldInfo);
+	} else if (multithreaded) {
+		// one solver per thread for the islands, and a multithreaded one for the large islands
+		btConstraintSolverPoolMt *solver_pool = bulletnew(btConstraintSolverPoolMt(btGetTaskScheduler()->getMaxNumThreads()));
+		solver = solver_pool;
+		solver_mt = bulletnew(btSequentialImpulseConstraintSolverMt);
+		dynamicsWorld = new (world_mem) btDiscreteDynamicsWorldMt(dispatcher, broadphase, solver_pool, solver_mt, collisionConfiguration);
 	} else {
+		solver = bulletnew(btSequentialImpulseConstraintSolver);
 		dynamicsWorld = new (world_mem) btDiscreteDynamicsWorld(dispatcher, broadphase, solver, collisionConfiguration);
 	}
 
@@ -648,6 +687,7 @@ void SpaceBullet::destroy_world() {
 	dynamicsWorld = NULL;
 
 	bulletdelete(solver);
+	bulletdelete(solver_mt);
 	bulletdelete(broadphase);
 	bulletdelete(dispatcher);
 	bulletdelete(collisionConfiguration);
@@ -96,6 +96,7 @@ class SpaceBullet : public RIDBullet {
 	btDefaultCollisionConfiguration *collisionConfiguration;
 	btCollisionDispatcher *dispatcher;
 	btConstraintSolver *solver;
+	btConstraintSolver *solver_mt; // solves large islands with several threads in multithreaded worlds
 	btDiscreteDynamicsWorld *dynamicsWorld;
 	btSoftBodyWorldInfo *soft_body_world_info;
 	btGhostPairCallback *ghostPairCallback;
@@ -114,6 +115,9 @@ class SpaceBullet : public RIDBullet {
 	int contactDebugCount;
 	real_t delta_time;
 
+	bool multithreaded;
+	int thread_count; // threads used to step a multithreaded world, 0 uses all of them
+
 public:
 	SpaceBullet();
 	virtual ~SpaceBullet();
@@ -181,7 +185,7 @@ public:
 	int test_ray_separation(RigidBodyBullet *p_body, const Transform &p_transform, bool p_infinite_inertia, Vector3 &r_recover_motion, PhysicsServer3D::SeparationResult *r_results, int p_result_max, float p_margin);
 
 private:
-	void create_empty_world(bool p_create_soft_world);
+	void create_empty_world(bool p_create_soft_world, bool p_multithreaded);
 	void destroy_world();
 	void check_ghost_overlaps();
 	void check_body_collision();
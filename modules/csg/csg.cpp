@@ -33,6 +33,7 @@
 #include "core/math/geometry.h"
 #include "core/math/math_funcs.h"
 #include "core/sort_array.h"
+#include "core/thread_work_pool.h"
 
 // Static helper functions.
 
@@ -41,6 +42,13 @@ inline static bool is_snapable(const Vector3 &p_point1, const Vector3 &p_point2,
 	return (p_point1 - p_point2).length_squared() < p_distance * p_distance;
 }
 
+inline static bool is_face_degenerate(const Vector3 p_vertices[3], real_t p_distance) {
+
+	return is_snapable(p_vertices[0], p_vertices[1], p_distance) ||
+		   is_snapable(p_vertices[0], p_vertices[2], p_distance) ||
+		   is_snapable(p_vertices[1], p_vertices[2], p_distance);
+}
+
 inline static Vector2 interpolate_segment_uv(const Vector2 p_segement_points[2], const Vector2 p_uvs[2], const Vector2 &p_interpolation_point) {
 
 	float segment_length = (p_segement_points[1] - p_segement_points[0]).length();
@@ -271,28 +279,107 @@ void CSGBrush::copy_from(const CSGBrush &p_brush, const Transform &p_xform) {
 void CSGBrushOperation::merge_brushes(Operation p_operation, const CSGBrush &p_brush_a, const CSGBrush &p_brush_b, CSGBrush &r_merged_brush, float p_vertex_snap) {
 
 	// Check for face collisions and add necessary faces.
-	Build2DFaceCollection build2DFaceCollection;
-	for (int i = 0; i < p_brush_a.faces.size(); i++) {
-		for (int j = 0; j < p_brush_b.faces.size(); j++) {
-			if (p_brush_a.faces[i].aabb.intersects_inclusive(p_brush_b.faces[j].aabb)) {
-				update_faces(p_brush_a, i, p_brush_b, j, build2DFaceCollection, p_vertex_snap);
+	int face_count_a = p_brush_a.faces.size();
+	int face_count_b = p_brush_b.faces.size();
+
+	Build2DFaceCollection collection;
+	collection.brush_a = &p_brush_a;
+	collection.brush_b = &p_brush_b;
+	collection.vertex_snap = p_vertex_snap;
+
+	// Degenerate faces can't be clipped, so resolve them once per face instead of once per pair.
+	collection.degenerate_a.resize(face_count_a);
+	for (int i = 0; i < face_count_a; i++) {
+		collection.degenerate_a[i] = is_face_degenerate(p_brush_a.faces[i].vertices, p_vertex_snap);
+	}
+	collection.degenerate_b.resize(face_count_b);
+	for (int i = 0; i < face_count_b; i++) {
+		collection.degenerate_b[i] = is_face_degenerate(p_brush_b.faces[i].vertices, p_vertex_snap);
+		if (i == 0) {
+			collection.aabb_b = p_brush_b.faces[i].aabb;
+		} else {
+			collection.aabb_b.merge_with(p_brush_b.faces[i].aabb);
+		}
+	}
+
+	collection.intersections_a.resize(face_count_a);
+	collection.intersections_b.resize(face_count_b);
+	collection.dropped_a.resize(face_count_a);
+	collection.dropped_b.resize(face_count_b);
+	for (int i = 0; i < face_count_b; i++) {
+		collection.dropped_b[i] = false;
+	}
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	bool threaded = pool && pool->get_thread_count() > 0;
+
+	if (face_count_b > 0) {
+		if (threaded && face_count_a > 1) {
+			pool->do_work(face_count_a, &collection, &Build2DFaceCollection::find_intersections, (void *)NULL);
+		} else {
+			for (int i = 0; i < face_count_a; i++) {
+				collection.find_intersections(i, NULL);
+			}
+		}
+	} else {
+		for (int i = 0; i < face_count_a; i++) {
+			collection.dropped_a[i] = false;
+		}
+	}
+
+	// B faces are clipped against A faces in the same order as A faces are walked.
+	for (int i = 0; i < face_count_a; i++) {
+		const LocalVector<int> &intersections = collection.intersections_a[i];
+		for (uint32_t j = 0; j < intersections.size(); j++) {
+			collection.intersections_b[intersections[j]].push_back(i);
+		}
+	}
+
+	// Degenerate B faces are dropped when they touch any face of A.
+	for (int i = 0; i < face_count_b; i++) {
+		if (!collection.degenerate_b[i]) {
+			continue;
+		}
+		for (int j = 0; j < face_count_a; j++) {
+			if (p_brush_a.faces[j].aabb.intersects_inclusive(p_brush_b.faces[i].aabb)) {
+				collection.dropped_b[i] = true;
+				break;
 			}
 		}
 	}
 
+	collection.build2DFacesA.resize(face_count_a);
+	collection.build2DFacesB.resize(face_count_b);
+
+	if (threaded) {
+		pool->do_work(face_count_a, &collection, &Build2DFaceCollection::build_faces_a, (void *)NULL);
+		pool->do_work(face_count_b, &collection, &Build2DFaceCollection::build_faces_b, (void *)NULL);
+	} else {
+		for (int i = 0; i < face_count_a; i++) {
+			collection.build_faces_a(i, NULL);
+		}
+		for (int i = 0; i < face_count_b; i++) {
+			collection.build_faces_b(i, NULL);
+		}
+	}
+
 	// Add faces to MeshMerge.
 	MeshMerge mesh_merge;
 	mesh_merge.vertex_snap = p_vertex_snap;
 
-	for (int i = 0; i < p_brush_a.faces.size(); i++) {
+	for (int i = 0; i < face_count_a; i++) {
+
+		if (collection.dropped_a[i]) {
+			continue;
+		}
 
 		Ref<Material> material;
 		if (p_brush_a.faces[i].material != -1) {
 			material = p_brush_a.materials[p_brush_a.faces[i].material];
 		}
 
-		if (build2DFaceCollection.build2DFacesA.has(i)) {
-			build2DFaceCollection.build2DFacesA[i].addFacesToMesh(mesh_merge, p_brush_a.faces[i].smooth, p_brush_a.faces[i].invert, material, false);
+		if (collection.intersections_a[i].size()) {
+			collection.build2DFacesA[i].addFacesToMesh(mesh_merge, p_brush_a.faces[i].smooth, p_brush_a.faces[i].invert, material, false);
 		} else {
 			Vector3 points[3];
 			Vector2 uvs[3];
@@ -304,15 +391,19 @@ void CSGBrushOperation::merge_brushes(Operation p_operation, const CSGBrush &p_b
 		}
 	}
 
-	for (int i = 0; i < p_brush_b.faces.size(); i++) {
+	for (int i = 0; i < face_count_b; i++) {
+
+		if (collection.dropped_b[i]) {
+			continue;
+		}
 
 		Ref<Material> material;
 		if (p_brush_b.faces[i].material != -1) {
 			material = p_brush_b.materials[p_brush_b.faces[i].material];
 		}
 
-		if (build2DFaceCollection.build2DFacesB.has(i)) {
-			build2DFaceCollection.build2DFacesB[i].addFacesToMesh(mesh_merge, p_brush_b.faces[i].smooth, p_brush_b.faces[i].invert, material, true);
+		if (collection.intersections_b[i].size()) {
+			collection.build2DFacesB[i].addFacesToMesh(mesh_merge, p_brush_b.faces[i].smooth, p_brush_b.faces[i].invert, material, true);
 		} else {
 			Vector3 points[3];
 			Vector2 uvs[3];
@@ -715,15 +806,39 @@ void CSGBrushOperation::MeshMerge::mark_inside_faces() {
 	int max_alloc = faces.size();
 	_create_bvh(facebvh, bvhptr, 0, faces.size(), 1, max_depth, max_alloc);
 
+	// Every face casts its own ray against the shared BVH, so they can be tested in parallel.
+	InsideTest test;
+	test.mesh_merge = this;
+	test.facebvh = facebvh;
+	test.max_depth = max_depth;
+	test.bvh_first = max_alloc - 1;
+	test.intersection_aabb = intersection_aabb;
+	test.inside.resize(faces.size());
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0 && faces.size() > 1) {
+		pool->do_work(faces.size(), &test, &InsideTest::test_face, (void *)NULL);
+	} else {
+		for (int i = 0; i < faces.size(); i++) {
+			test.test_face(i, NULL);
+		}
+	}
+
 	for (int i = 0; i < faces.size(); i++) {
+		if (test.inside[i])
+			faces.write[i].inside = true;
+	}
+}
 
-		// Check if face AABB intersects the intersection AABB.
-		if (!intersection_aabb.intersects_inclusive(facebvh[i].aabb))
-			continue;
+void CSGBrushOperation::MeshMerge::InsideTest::test_face(uint32_t p_face, void *p_userdata) {
 
-		if (_bvh_inside(facebvh, max_depth, max_alloc - 1, i))
-			faces.write[i].inside = true;
+	// Check if face AABB intersects the intersection AABB.
+	if (!intersection_aabb.intersects_inclusive(facebvh[p_face].aabb)) {
+		inside[p_face] = false;
+		return;
 	}
+
+	inside[p_face] = mesh_merge->_bvh_inside(facebvh, max_depth, bvh_first, p_face);
 }
 
 void CSGBrushOperation::MeshMerge::add_face(const Vector3 p_points[], const Vector2 p_uvs[], bool p_smooth, bool p_invert, const Ref<Material> &p_material, bool p_from_b) {
@@ -1355,7 +1470,67 @@ CSGBrushOperation::Build2DFaces::Build2DFaces(const CSGBrush &p_brush, int p_fac
 	faces.push_back(face);
 }
 
-void CSGBrushOperation::update_faces(const CSGBrush &p_brush_a, const int p_face_idx_a, const CSGBrush &p_brush_b, const int p_face_idx_b, Build2DFaceCollection &p_collection, float p_vertex_snap) {
+void CSGBrushOperation::Build2DFaceCollection::find_intersections(uint32_t p_face_a, void *p_userdata) {
+
+	const CSGBrush::Face &face_a = brush_a->faces[p_face_a];
+	LocalVector<int> &intersections = intersections_a[p_face_a];
+	dropped_a[p_face_a] = false;
+
+	if (!aabb_b.intersects_inclusive(face_a.aabb)) {
+		return;
+	}
+
+	int face_count_b = brush_b->faces.size();
+	for (int j = 0; j < face_count_b; j++) {
+
+		if (!face_a.aabb.intersects_inclusive(brush_b->faces[j].aabb)) {
+			continue;
+		}
+
+		// Don't use degenerate faces.
+		if (degenerate_a[p_face_a]) {
+			dropped_a[p_face_a] = true;
+			return;
+		}
+		if (degenerate_b[j]) {
+			continue;
+		}
+
+		if (faces_intersect(*brush_a, p_face_a, *brush_b, j)) {
+			intersections.push_back(j);
+		}
+	}
+}
+
+void CSGBrushOperation::Build2DFaceCollection::build_faces_a(uint32_t p_face_a, void *p_userdata) {
+
+	const LocalVector<int> &intersections = intersections_a[p_face_a];
+	if (intersections.empty()) {
+		return;
+	}
+
+	Build2DFaces &build = build2DFacesA[p_face_a];
+	build = Build2DFaces(*brush_a, p_face_a, vertex_snap);
+	for (uint32_t i = 0; i < intersections.size(); i++) {
+		build.insert(*brush_b, intersections[i]);
+	}
+}
+
+void CSGBrushOperation::Build2DFaceCollection::build_faces_b(uint32_t p_face_b, void *p_userdata) {
+
+	const LocalVector<int> &intersections = intersections_b[p_face_b];
+	if (intersections.empty()) {
+		return;
+	}
+
+	Build2DFaces &build = build2DFacesB[p_face_b];
+	build = Build2DFaces(*brush_b, p_face_b, vertex_snap);
+	for (uint32_t i = 0; i < intersections.size(); i++) {
+		build.insert(*brush_a, intersections[i]);
+	}
+}
+
+bool CSGBrushOperation::faces_intersect(const CSGBrush &p_brush_a, int p_face_idx_a, const CSGBrush &p_brush_b, int p_face_idx_b) {
 
 	Vector3 vertices_a[3] = {
 		p_brush_a.faces[p_face_idx_a].vertices[0],
@@ -1369,27 +1544,10 @@ void CSGBrushOperation::update_faces(const CSGBrush &p_brush_a, const int p_face
 		p_brush_b.faces[p_face_idx_b].vertices[2],
 	};
 
-	// Don't use degenerate faces.
-	bool has_degenerate = false;
-	if (is_snapable(vertices_a[0], vertices_a[1], p_vertex_snap) ||
-			is_snapable(vertices_a[0], vertices_a[2], p_vertex_snap) ||
-			is_snapable(vertices_a[1], vertices_a[2], p_vertex_snap)) {
-		p_collection.build2DFacesA[p_face_idx_a] = Build2DFaces();
-		has_degenerate = true;
-	}
-
-	if (is_snapable(vertices_b[0], vertices_b[1], p_vertex_snap) ||
-			is_snapable(vertices_b[0], vertices_b[2], p_vertex_snap) ||
-			is_snapable(vertices_b[1], vertices_b[2], p_vertex_snap)) {
-		p_collection.build2DFacesB[p_face_idx_b] = Build2DFaces();
-		has_degenerate = true;
-	}
-	if (has_degenerate) return;
-
 	// Ensure B has points either side of or in the plane of A.
 	int in_plane_count = 0, over_count = 0, under_count = 0;
 	Plane plane_a(vertices_a[0], vertices_a[1], vertices_a[2]);
-	ERR_FAIL_COND_MSG(plane_a.normal == Vector3(), "Couldn't form plane from Brush A face.");
+	ERR_FAIL_COND_V_MSG(plane_a.normal == Vector3(), false, "Couldn't form plane from Brush A face.");
 
 	for (int i = 0; i < 3; i++) {
 		if (plane_a.has_point(vertices_b[i]))
@@ -1400,14 +1558,14 @@ void CSGBrushOperation::update_faces(const CSGBrush &p_brush_a, const int p_face
 			under_count++;
 	}
 	// If all points under or over the plane, there is no intesection.
-	if (over_count == 3 || under_count == 3) return;
+	if (over_count == 3 || under_count == 3) return false;
 
 	// Ensure A has points either side of or in the plane of B.
 	in_plane_count = 0;
 	over_count = 0;
 	under_count = 0;
 	Plane plane_b(vertices_b[0], vertices_b[1], vertices_b[2]);
-	ERR_FAIL_COND_MSG(plane_b.normal == Vector3(), "Couldn't form plane from Brush B face.");
+	ERR_FAIL_COND_V_MSG(plane_b.normal == Vector3(), false, "Couldn't form plane from Brush B face.");
 
 	for (int i = 0; i < 3; i++) {
 		if (plane_b.has_point(vertices_a[i]))
@@ -1418,7 +1576,7 @@ void CSGBrushOperation::update_faces(const CSGBrush &p_brush_a, const int p_face
 			under_count++;
 	}
 	// If all points under or over the plane, there is no intesection.
-	if (over_count == 3 || under_count == 3) return;
+	if (over_count == 3 || under_count == 3) return false;
 
 	// Check for intersection using the SAT theorem.
 	{
@@ -1456,20 +1614,12 @@ void CSGBrushOperation::update_faces(const CSGBrush &p_brush_a, const int p_face
 				real_t dmax = max_b - (min_a + max_a) * 0.5;
 
 				if (dmin > CMP_EPSILON || dmax < -CMP_EPSILON) {
-					return; // Does not contain zero, so they don't overlap.
+					return false; // Does not contain zero, so they don't overlap.
 				}
 			}
 		}
 	}
 
-	// If we're still here, the faces probably intersect, so add new faces.
-	if (!p_collection.build2DFacesA.has(p_face_idx_a)) {
-		p_collection.build2DFacesA[p_face_idx_a] = Build2DFaces(p_brush_a, p_face_idx_a, p_vertex_snap);
-	}
-	p_collection.build2DFacesA[p_face_idx_a].insert(p_brush_b, p_face_idx_b);
-
-	if (!p_collection.build2DFacesB.has(p_face_idx_b)) {
-		p_collection.build2DFacesB[p_face_idx_b] = Build2DFaces(p_brush_b, p_face_idx_b, p_vertex_snap);
-	}
-	p_collection.build2DFacesB[p_face_idx_b].insert(p_brush_a, p_face_idx_a);
+	// If we're still here, the faces probably intersect.
+	return true;
 }
@@ -32,6 +32,7 @@
 #define CSG_H
 
 #include "core/list.h"
+#include "core/local_vector.h"
 #include "core/map.h"
 #include "core/math/aabb.h"
 #include "core/math/plane.h"
@@ -153,6 +154,17 @@ struct CSGBrushOperation {
 
 		void add_face(const Vector3 p_points[3], const Vector2 p_uvs[3], bool p_smooth, bool p_invert, const Ref<Material> &p_material, bool p_from_b);
 		void mark_inside_faces();
+
+		struct InsideTest {
+			const MeshMerge *mesh_merge;
+			FaceBVH *facebvh;
+			int max_depth;
+			int bvh_first;
+			AABB intersection_aabb;
+			LocalVector<uint8_t> inside;
+
+			void test_face(uint32_t p_face, void *p_userdata);
+		};
 	};
 
 	struct Build2DFaces {
@@ -187,12 +199,30 @@ struct CSGBrushOperation {
 		Build2DFaces(const CSGBrush &p_brush, int p_brush_face, float p_vertex_snap2);
 	};
 
+	// Clipping state for one merge. Each face of A and B is clipped against
+	// its own list of intersecting faces, so faces can be built in parallel.
 	struct Build2DFaceCollection {
-		Map<int, Build2DFaces> build2DFacesA;
-		Map<int, Build2DFaces> build2DFacesB;
+		const CSGBrush *brush_a = nullptr;
+		const CSGBrush *brush_b = nullptr;
+		float vertex_snap = 0;
+		AABB aabb_b;
+
+		LocalVector<uint8_t> degenerate_a;
+		LocalVector<uint8_t> degenerate_b;
+		LocalVector<LocalVector<int>> intersections_a;
+		LocalVector<LocalVector<int>> intersections_b;
+		// Faces that collide with the other brush but can't be clipped (degenerate), skipped.
+		LocalVector<uint8_t> dropped_a;
+		LocalVector<uint8_t> dropped_b;
+		LocalVector<Build2DFaces> build2DFacesA;
+		LocalVector<Build2DFaces> build2DFacesB;
+
+		void find_intersections(uint32_t p_face_a, void *p_userdata);
+		void build_faces_a(uint32_t p_face_a, void *p_userdata);
+		void build_faces_b(uint32_t p_face_b, void *p_userdata);
 	};
 
-	void update_faces(const CSGBrush &p_brush_a, const int p_face_idx_a, const CSGBrush &p_brush_b, const int p_face_idx_b, Build2DFaceCollection &p_collection, float p_vertex_snap);
+	static bool faces_intersect(const CSGBrush &p_brush_a, int p_face_idx_a, const CSGBrush &p_brush_b, int p_face_idx_b);
 };
 
 #endif // CSG_H
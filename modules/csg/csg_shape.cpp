@@ -50,7 +50,7 @@ void CSGShape3D::set_use_collision(bool p_enable) {
 		PhysicsServer3D::get_singleton()->body_attach_object_instance_id(root_collision_instance, get_instance_id());
 		set_collision_layer(collision_layer);
 		set_collision_mask(collision_mask);
-		_make_dirty(); //force update
+		_make_dirty(false); //force update
 	} else {
 		PhysicsServer3D::get_singleton()->free(root_collision_instance);
 		root_collision_instance = RID();
@@ -131,11 +131,16 @@ float CSGShape3D::get_snap() const {
 	return snap;
 }
 
-void CSGShape3D::_make_dirty() {
+void CSGShape3D::_make_dirty(bool p_own_brush) {
 
 	if (!is_inside_tree())
 		return;
 
+	if (p_own_brush) {
+		own_brush_dirty = true;
+	}
+	merge_dirty = true;
+
 	if (dirty) {
 		return;
 	}
@@ -143,22 +148,40 @@ void CSGShape3D::_make_dirty() {
 	dirty = true;
 
 	if (parent) {
-		parent->_make_dirty();
+		parent->_make_dirty(false);
 	} else {
 		//only parent will do
 		call_deferred("_update_shape");
 	}
 }
 
+void CSGShape3D::_clear_merge_steps(uint32_t p_from) {
+
+	for (uint32_t i = p_from; i < merge_steps.size(); i++) {
+		memdelete(merge_steps[i].brush);
+	}
+	if (p_from < merge_steps.size()) {
+		merge_steps.resize(p_from);
+	}
+}
+
 CSGBrush *CSGShape3D::_get_brush() {
 
 	if (dirty) {
-		if (brush) {
-			memdelete(brush);
+
+		if (own_brush_dirty) {
+			if (own_brush) {
+				memdelete(own_brush);
+			}
+			own_brush = _build_brush();
+			own_brush_dirty = false;
+			//every merge step starts from it
+			_clear_merge_steps();
 		}
-		brush = NULL;
 
-		CSGBrush *n = _build_brush();
+		CSGBrush *n = own_brush;
+		uint32_t step = 0;
+		bool reuse = true;
 
 		for (int i = 0; i < get_child_count(); i++) {
 
@@ -171,14 +194,29 @@ CSGBrush *CSGShape3D::_get_brush() {
 			CSGBrush *n2 = child->_get_brush();
 			if (!n2)
 				continue;
+
+			if (reuse && step < merge_steps.size() && merge_steps[step].child == child->get_instance_id() && !child->merge_dirty) {
+				//nothing changed up to this child, keep the previous result
+				n = merge_steps[step].brush;
+				step++;
+				continue;
+			}
+
+			//from here on, everything is merged again
+			if (reuse) {
+				_clear_merge_steps(step);
+				reuse = false;
+			}
+			child->merge_dirty = false;
+
+			CSGBrush *nn = memnew(CSGBrush);
+
 			if (!n) {
-				n = memnew(CSGBrush);
 
-				n->copy_from(*n2, child->get_transform());
+				nn->copy_from(*n2, child->get_transform());
 
 			} else {
 
-				CSGBrush *nn = memnew(CSGBrush);
 				CSGBrush *nn2 = memnew(CSGBrush);
 				nn2->copy_from(*n2, child->get_transform());
 
@@ -189,12 +227,20 @@ CSGBrush *CSGShape3D::_get_brush() {
 					case CSGShape3D::OPERATION_INTERSECTION: bop.merge_brushes(CSGBrushOperation::OPERATION_INTERSECTION, *n, *nn2, *nn, snap); break;
 					case CSGShape3D::OPERATION_SUBTRACTION: bop.merge_brushes(CSGBrushOperation::OPERATION_SUBSTRACTION, *n, *nn2, *nn, snap); break;
 				}
-				memdelete(n);
 				memdelete(nn2);
-				n = nn;
 			}
+
+			MergeStep ms;
+			ms.child = child->get_instance_id();
+			ms.brush = nn;
+			merge_steps.push_back(ms);
+			step++;
+			n = nn;
 		}
 
+		//children removed from the end
+		_clear_merge_steps(step);
+
 		if (n) {
 			AABB aabb;
 			for (int i = 0; i < n->faces.size(); i++) {
@@ -210,6 +256,7 @@ CSGBrush *CSGShape3D::_get_brush() {
 			node_aabb = AABB();
 		}
 
+		//owned by own_brush or merge_steps
 		brush = n;
 
 		dirty = false;
@@ -521,21 +568,23 @@ void CSGShape3D::_notification(int p_what) {
 	if (p_what == NOTIFICATION_LOCAL_TRANSFORM_CHANGED) {
 
 		if (parent) {
-			parent->_make_dirty();
+			merge_dirty = true;
+			parent->_make_dirty(false);
 		}
 	}
 
 	if (p_what == NOTIFICATION_VISIBILITY_CHANGED) {
 
 		if (parent) {
-			parent->_make_dirty();
+			merge_dirty = true;
+			parent->_make_dirty(false);
 		}
 	}
 
 	if (p_what == NOTIFICATION_EXIT_TREE) {
 
 		if (parent)
-			parent->_make_dirty();
+			parent->_make_dirty(false);
 		parent = NULL;
 
 		if (use_collision && is_root_shape() && root_collision_instance.is_valid()) {
@@ -550,7 +599,7 @@ void CSGShape3D::_notification(int p_what) {
 void CSGShape3D::set_operation(Operation p_operation) {
 
 	operation = p_operation;
-	_make_dirty();
+	_make_dirty(false);
 	update_gizmo();
 }
 
@@ -560,7 +609,7 @@ CSGShape3D::Operation CSGShape3D::get_operation() const {
 
 void CSGShape3D::set_calculate_tangents(bool p_calculate_tangents) {
 	calculate_tangents = p_calculate_tangents;
-	_make_dirty();
+	_make_dirty(false);
 }
 
 bool CSGShape3D::is_calculating_tangents() const {
@@ -638,7 +687,10 @@ CSGShape3D::CSGShape3D() {
 	operation = OPERATION_UNION;
 	parent = NULL;
 	brush = NULL;
+	own_brush = NULL;
 	dirty = false;
+	own_brush_dirty = true;
+	merge_dirty = true;
 	snap = 0.001;
 	use_collision = false;
 	collision_layer = 1;
@@ -648,10 +700,12 @@ CSGShape3D::CSGShape3D() {
 }
 
 CSGShape3D::~CSGShape3D() {
-	if (brush) {
-		memdelete(brush);
-		brush = NULL;
+	_clear_merge_steps();
+	if (own_brush) {
+		memdelete(own_brush);
+		own_brush = NULL;
 	}
+	brush = NULL;
 }
 //////////////////////////////////
 
@@ -54,10 +54,22 @@ private:
 	CSGShape3D *parent;
 
 	CSGBrush *brush;
+	//what this node builds by itself, before merging children
+	CSGBrush *own_brush;
+
+	//result after merging each contributing child, so an edit only remerges from the changed child on
+	struct MergeStep {
+		ObjectID child;
+		CSGBrush *brush;
+	};
+	LocalVector<MergeStep> merge_steps;
 
 	AABB node_aabb;
 
 	bool dirty;
+	bool own_brush_dirty;
+	//set when the result of this node changed since the parent last merged it
+	bool merge_dirty;
 	float snap;
 
 	bool use_collision;
@@ -107,7 +119,8 @@ private:
 protected:
 	void _notification(int p_what);
 	virtual CSGBrush *_build_brush() = 0;
-	void _make_dirty();
+	void _make_dirty(bool p_own_brush = true);
+	void _clear_merge_steps(uint32_t p_from = 0);
 
 	static void _bind_methods();
 
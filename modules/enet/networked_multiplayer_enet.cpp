@@ -32,6 +32,7 @@
 #include "core/io/ip.h"
 #include "core/io/marshalls.h"
 #include "core/os/os.h"
+#include "core/project_settings.h"
 
 void NetworkedMultiplayerENet::set_transfer_mode(TransferMode p_mode) {
 
@@ -118,6 +119,9 @@ Error NetworkedMultiplayerENet::create_server(int p_port, int p_max_clients, int
 	refuse_connections = false;
 	unique_id = 1;
 	connection_status = CONNECTION_CONNECTED;
+	if (use_threads) {
+		_start_io_thread();
+	}
 	return OK;
 }
 Error NetworkedMultiplayerENet::create_client(const String &p_address, int p_port, int p_in_bandwidth, int p_out_bandwidth, int p_client_port) {
@@ -208,6 +212,9 @@ Error NetworkedMultiplayerENet::create_client(const String &p_address, int p_por
 	active = true;
 	server = false;
 	refuse_connections = false;
+	if (use_threads) {
+		_start_io_thread();
+	}
 
 	return OK;
 }
@@ -218,6 +225,37 @@ void NetworkedMultiplayerENet::poll() {
 
 	_pop_current_packet();
 
+	if (io_thread) {
+		// The I/O thread already serviced the host, handle what it collected.
+		List<ENetEvent> events;
+		host_mutex.lock();
+		for (List<ENetEvent>::Element *E = io_events.front(); E; E = E->next()) {
+			events.push_back(E->get());
+		}
+		io_events.clear();
+		host_mutex.unlock();
+
+		for (List<ENetEvent>::Element *E = events.front(); E; E = E->next()) {
+
+			if (!host || !active) { // Might have been disconnected while emitting a notification
+				if (E->get().type == ENET_EVENT_TYPE_RECEIVE) {
+					enet_packet_destroy(E->get().packet);
+				}
+				continue;
+			}
+
+			host_mutex.lock();
+			bool closed = _process_event(E->get());
+			host_mutex.unlock();
+
+			_emit_queued_signals();
+			if (closed && active) {
+				close_connection();
+			}
+		}
+		return;
+	}
+
 	ENetEvent event;
 	/* Keep servicing until there are no available events left in queue. */
 	while (true) {
@@ -234,217 +272,295 @@ void NetworkedMultiplayerENet::poll() {
 			break;
 		}
 
-		switch (event.type) {
-			case ENET_EVENT_TYPE_CONNECT: {
-				// Store any relevant client information here.
+		bool closed = _process_event(event);
+		_emit_queued_signals();
+		if (closed) {
+			if (active) {
+				close_connection();
+			}
+			return;
+		}
+	}
+}
 
-				if (server && refuse_connections) {
-					enet_peer_reset(event.peer);
-					break;
-				}
+bool NetworkedMultiplayerENet::_process_event(ENetEvent &event) {
 
-				// A client joined with an invalid ID (negative values, 0, and 1 are reserved).
-				// Probably trying to exploit us.
-				if (server && ((int)event.data < 2 || peer_map.has((int)event.data))) {
-					enet_peer_reset(event.peer);
-					ERR_CONTINUE(true);
-				}
+	switch (event.type) {
+		case ENET_EVENT_TYPE_CONNECT: {
+			// Store any relevant client information here.
+
+			if (server && refuse_connections) {
+				enet_peer_reset(event.peer);
+				break;
+			}
 
-				int *new_id = memnew(int);
-				*new_id = event.data;
+			// A client joined with an invalid ID (negative values, 0, and 1 are reserved).
+			// Probably trying to exploit us.
+			if (server && ((int)event.data < 2 || peer_map.has((int)event.data))) {
+				enet_peer_reset(event.peer);
+				ERR_FAIL_COND_V(true, false);
+			}
 
-				if (*new_id == 0) { // Data zero is sent by server (enet won't let you configure this). Server is always 1.
-					*new_id = 1;
-				}
+			int *new_id = memnew(int);
+			*new_id = event.data;
 
-				event.peer->data = new_id;
+			if (*new_id == 0) { // Data zero is sent by server (enet won't let you configure this). Server is always 1.
+				*new_id = 1;
+			}
 
-				peer_map[*new_id] = event.peer;
+			event.peer->data = new_id;
 
-				connection_status = CONNECTION_CONNECTED; // If connecting, this means it connected to something!
+			peer_map[*new_id] = event.peer;
 
-				emit_signal("peer_connected", *new_id);
+			connection_status = CONNECTION_CONNECTED; // If connecting, this means it connected to something!
 
-				if (server) {
-					// Do not notify other peers when server_relay is disabled.
-					if (!server_relay)
-						break;
-
-					// Someone connected, notify all the peers available
-					for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
-
-						if (E->key() == *new_id)
-							continue;
-						// Send existing peers to new peer
-						ENetPacket *packet = enet_packet_create(NULL, 8, ENET_PACKET_FLAG_RELIABLE);
-						encode_uint32(SYSMSG_ADD_PEER, &packet->data[0]);
-						encode_uint32(E->key(), &packet->data[4]);
-						enet_peer_send(event.peer, SYSCH_CONFIG, packet);
-						// Send the new peer to existing peers
-						packet = enet_packet_create(NULL, 8, ENET_PACKET_FLAG_RELIABLE);
-						encode_uint32(SYSMSG_ADD_PEER, &packet->data[0]);
-						encode_uint32(*new_id, &packet->data[4]);
-						enet_peer_send(E->get(), SYSCH_CONFIG, packet);
-					}
-				} else {
+			_queue_signal("peer_connected", *new_id);
 
-					emit_signal("connection_succeeded");
+			if (server) {
+				// Do not notify other peers when server_relay is disabled.
+				if (!server_relay)
+					break;
+
+				// Someone connected, notify all the peers available
+				for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
+
+					if (E->key() == *new_id)
+						continue;
+					// Send existing peers to new peer
+					ENetPacket *packet = enet_packet_create(NULL, 8, ENET_PACKET_FLAG_RELIABLE);
+					encode_uint32(SYSMSG_ADD_PEER, &packet->data[0]);
+					encode_uint32(E->key(), &packet->data[4]);
+					enet_peer_send(event.peer, SYSCH_CONFIG, packet);
+					// Send the new peer to existing peers
+					packet = enet_packet_create(NULL, 8, ENET_PACKET_FLAG_RELIABLE);
+					encode_uint32(SYSMSG_ADD_PEER, &packet->data[0]);
+					encode_uint32(*new_id, &packet->data[4]);
+					enet_peer_send(E->get(), SYSCH_CONFIG, packet);
 				}
+			} else {
 
-			} break;
-			case ENET_EVENT_TYPE_DISCONNECT: {
+				_queue_signal("connection_succeeded");
+			}
 
-				// Reset the peer's client information.
+		} break;
+		case ENET_EVENT_TYPE_DISCONNECT: {
 
-				int *id = (int *)event.peer->data;
+			// Reset the peer's client information.
 
-				if (!id) {
-					if (!server) {
-						emit_signal("connection_failed");
-					}
-					// Never fully connected.
-					break;
-				}
+			int *id = (int *)event.peer->data;
 
+			if (!id) {
 				if (!server) {
+					_queue_signal("connection_failed");
+				}
+				// Never fully connected.
+				break;
+			}
 
-					// Client just disconnected from server.
-					emit_signal("server_disconnected");
-					close_connection();
-					return;
-				} else if (server_relay) {
+			if (!server) {
 
-					// Server just received a client disconnect and is in relay mode, notify everyone else.
-					for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
+				// Client just disconnected from server.
+				_queue_signal("server_disconnected");
+				return true;
+			} else if (server_relay) {
 
-						if (E->key() == *id)
-							continue;
+				// Server just received a client disconnect and is in relay mode, notify everyone else.
+				for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
 
-						ENetPacket *packet = enet_packet_create(NULL, 8, ENET_PACKET_FLAG_RELIABLE);
-						encode_uint32(SYSMSG_REMOVE_PEER, &packet->data[0]);
-						encode_uint32(*id, &packet->data[4]);
-						enet_peer_send(E->get(), SYSCH_CONFIG, packet);
-					}
-				}
+					if (E->key() == *id)
+						continue;
 
-				emit_signal("peer_disconnected", *id);
-				peer_map.erase(*id);
-				memdelete(id);
-			} break;
-			case ENET_EVENT_TYPE_RECEIVE: {
+					ENetPacket *packet = enet_packet_create(NULL, 8, ENET_PACKET_FLAG_RELIABLE);
+					encode_uint32(SYSMSG_REMOVE_PEER, &packet->data[0]);
+					encode_uint32(*id, &packet->data[4]);
+					enet_peer_send(E->get(), SYSCH_CONFIG, packet);
+				}
+			}
 
-				if (event.channelID == SYSCH_CONFIG) {
-					// Some config message
-					ERR_CONTINUE(event.packet->dataLength < 8);
+			_queue_signal("peer_disconnected", *id);
+			peer_map.erase(*id);
+			memdelete(id);
+			event.peer->data = NULL;
+		} break;
+		case ENET_EVENT_TYPE_RECEIVE: {
 
-					// Only server can send config messages
-					ERR_CONTINUE(server);
+			if (event.channelID == SYSCH_CONFIG) {
+				// Some config message
+				ERR_FAIL_COND_V(event.packet->dataLength < 8, false);
 
-					int msg = decode_uint32(&event.packet->data[0]);
-					int id = decode_uint32(&event.packet->data[4]);
+				// Only server can send config messages
+				ERR_FAIL_COND_V(server, false);
 
-					switch (msg) {
-						case SYSMSG_ADD_PEER: {
+				int msg = decode_uint32(&event.packet->data[0]);
+				int id = decode_uint32(&event.packet->data[4]);
 
-							peer_map[id] = NULL;
-							emit_signal("peer_connected", id);
+				switch (msg) {
+					case SYSMSG_ADD_PEER: {
 
-						} break;
-						case SYSMSG_REMOVE_PEER: {
+						peer_map[id] = NULL;
+						_queue_signal("peer_connected", id);
 
-							peer_map.erase(id);
-							emit_signal("peer_disconnected", id);
-						} break;
-					}
+					} break;
+					case SYSMSG_REMOVE_PEER: {
 
-					enet_packet_destroy(event.packet);
-				} else if (event.channelID < channel_count) {
+						peer_map.erase(id);
+						_queue_signal("peer_disconnected", id);
+					} break;
+				}
 
-					Packet packet;
-					packet.packet = event.packet;
+				enet_packet_destroy(event.packet);
+			} else if (event.channelID < channel_count) {
 
-					uint32_t *id = (uint32_t *)event.peer->data;
+				Packet packet;
+				packet.packet = event.packet;
 
-					ERR_CONTINUE(event.packet->dataLength < 8);
+				uint32_t *id = (uint32_t *)event.peer->data;
 
-					uint32_t source = decode_uint32(&event.packet->data[0]);
-					int target = decode_uint32(&event.packet->data[4]);
+				ERR_FAIL_COND_V(event.packet->dataLength < 8, false);
 
-					packet.from = source;
-					packet.channel = event.channelID;
+				uint32_t source = decode_uint32(&event.packet->data[0]);
+				int target = decode_uint32(&event.packet->data[4]);
 
-					if (server) {
-						// Someone is cheating and trying to fake the source!
-						ERR_CONTINUE(source != *id);
+				packet.from = source;
+				packet.channel = event.channelID;
 
-						packet.from = *id;
+				if (server) {
+					// Someone is cheating and trying to fake the source!
+					ERR_FAIL_COND_V(source != *id, false);
 
-						if (target == 1) {
-							// To myself and only myself
-							incoming_packets.push_back(packet);
-						} else if (!server_relay) {
-							// No other destination is allowed when server is not relaying
-							continue;
-						} else if (target == 0) {
-							// Re-send to everyone but sender :|
+					packet.from = *id;
 
-							incoming_packets.push_back(packet);
-							// And make copies for sending
-							for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
+					if (target == 1) {
+						// To myself and only myself
+						incoming_packets.push_back(packet);
+					} else if (!server_relay) {
+						// No other destination is allowed when server is not relaying
+						return false;
+					} else if (target == 0) {
+						// Re-send to everyone but sender :|
 
-								if (uint32_t(E->key()) == source) // Do not resend to self
-									continue;
+						incoming_packets.push_back(packet);
+						// And make copies for sending
+						for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
 
-								ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
+							if (uint32_t(E->key()) == source) // Do not resend to self
+								continue;
 
-								enet_peer_send(E->get(), event.channelID, packet2);
-							}
+							ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
 
-						} else if (target < 0) {
-							// To all but one
+							enet_peer_send(E->get(), event.channelID, packet2);
+						}
 
-							// And make copies for sending
-							for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
+					} else if (target < 0) {
+						// To all but one
 
-								if (uint32_t(E->key()) == source || E->key() == -target) // Do not resend to self, also do not send to excluded
-									continue;
+						// And make copies for sending
+						for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
 
-								ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
+							if (uint32_t(E->key()) == source || E->key() == -target) // Do not resend to self, also do not send to excluded
+								continue;
 
-								enet_peer_send(E->get(), event.channelID, packet2);
-							}
+							ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
 
-							if (-target != 1) {
-								// Server is not excluded
-								incoming_packets.push_back(packet);
-							} else {
-								// Server is excluded, erase packet
-								enet_packet_destroy(packet.packet);
-							}
+							enet_peer_send(E->get(), event.channelID, packet2);
+						}
 
+						if (-target != 1) {
+							// Server is not excluded
+							incoming_packets.push_back(packet);
 						} else {
-							// To someone else, specifically
-							ERR_CONTINUE(!peer_map.has(target));
-							enet_peer_send(peer_map[target], event.channelID, packet.packet);
+							// Server is excluded, erase packet
+							enet_packet_destroy(packet.packet);
 						}
-					} else {
 
-						incoming_packets.push_back(packet);
+					} else {
+						// To someone else, specifically
+						ERR_FAIL_COND_V(!peer_map.has(target), false);
+						enet_peer_send(peer_map[target], event.channelID, packet.packet);
 					}
-
-					// Destroy packet later
 				} else {
-					ERR_CONTINUE(true);
+
+					incoming_packets.push_back(packet);
 				}
 
-			} break;
-			case ENET_EVENT_TYPE_NONE: {
-				// Do nothing
-			} break;
+				// Destroy packet later
+			} else {
+				ERR_FAIL_COND_V(true, false);
+			}
+
+		} break;
+		case ENET_EVENT_TYPE_NONE: {
+			// Do nothing
+		} break;
+	}
+
+	return false;
+}
+
+void NetworkedMultiplayerENet::_queue_signal(const StringName &p_signal, int p_peer) {
+
+	queued_signals.push_back(Pair<StringName, int>(p_signal, p_peer));
+}
+
+void NetworkedMultiplayerENet::_emit_queued_signals() {
+
+	while (queued_signals.size()) {
+		Pair<StringName, int> sig = queued_signals.front()->get();
+		queued_signals.pop_front();
+		if (sig.second) {
+			emit_signal(sig.first, sig.second);
+		} else {
+			emit_signal(sig.first);
+		}
+	}
+}
+
+void NetworkedMultiplayerENet::_io_thread_func(void *p_userdata) {
+
+	NetworkedMultiplayerENet *enet = (NetworkedMultiplayerENet *)p_userdata;
+
+	while (!enet->io_thread_quit) {
+
+		enet->host_mutex.lock();
+		ENetEvent event;
+		while (enet_host_service(enet->host, &event, 0) > 0) {
+			enet->io_events.push_back(event);
 		}
+		// Sends (and compresses) whatever poll() and put_packet() queued.
+		enet_host_flush(enet->host);
+		enet->host_mutex.unlock();
+
+		OS::get_singleton()->delay_usec(enet->io_thread_interval_usec);
 	}
 }
 
+void NetworkedMultiplayerENet::_start_io_thread() {
+
+	io_thread_quit = false;
+	io_thread_interval_usec = MAX(1, (int)GLOBAL_GET("network/limits/enet/io_thread_interval_usec"));
+	io_thread = Thread::create(_io_thread_func, this);
+}
+
+void NetworkedMultiplayerENet::_stop_io_thread() {
+
+	if (!io_thread) {
+		return;
+	}
+
+	io_thread_quit = true;
+	Thread::wait_to_finish(io_thread);
+	memdelete(io_thread);
+	io_thread = NULL;
+
+	// Nobody will read these anymore.
+	for (List<ENetEvent>::Element *E = io_events.front(); E; E = E->next()) {
+		if (E->get().type == ENET_EVENT_TYPE_RECEIVE) {
+			enet_packet_destroy(E->get().packet);
+		}
+	}
+	io_events.clear();
+}
+
 bool NetworkedMultiplayerENet::is_server() const {
 	ERR_FAIL_COND_V_MSG(!active, false, "The multiplayer instance isn't currently active.");
 
@@ -455,7 +571,9 @@ void NetworkedMultiplayerENet::close_connection(uint32_t wait_usec) {
 
 	ERR_FAIL_COND_MSG(!active, "The multiplayer instance isn't currently active.");
 
+	_stop_io_thread();
 	_pop_current_packet();
+	queued_signals.clear();
 
 	bool peers_disconnected = false;
 	for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
@@ -489,6 +607,8 @@ void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
 	ERR_FAIL_COND_MSG(!is_server(), "Can't disconnect a peer when not acting as a server.");
 	ERR_FAIL_COND_MSG(!peer_map.has(p_peer), vformat("Peer ID %d not found in the list of peers.", p_peer));
 
+	host_mutex.lock();
+
 	if (now) {
 		int *id = (int *)peer_map[p_peer]->data;
 		enet_peer_disconnect_now(peer_map[p_peer], 0);
@@ -511,11 +631,14 @@ void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
 
 		if (id)
 			memdelete(id);
+		peer_map[p_peer]->data = NULL;
+		host_mutex.unlock();
 
 		emit_signal("peer_disconnected", p_peer);
 		peer_map.erase(p_peer);
 	} else {
 		enet_peer_disconnect_later(peer_map[p_peer], 0);
+		host_mutex.unlock();
 	}
 }
 
@@ -581,6 +704,8 @@ Error NetworkedMultiplayerENet::put_packet(const uint8_t *p_buffer, int p_buffer
 	encode_uint32(target_peer, &packet->data[4]); // Dest ID
 	copymem(&packet->data[8], p_buffer, p_buffer_size);
 
+	MutexLock lock(host_mutex);
+
 	if (server) {
 
 		if (target_peer == 0) {
@@ -611,7 +736,9 @@ Error NetworkedMultiplayerENet::put_packet(const uint8_t *p_buffer, int p_buffer
 		enet_peer_send(peer_map[1], channel, packet); // Send to server for broadcast
 	}
 
-	enet_host_flush(host);
+	if (!io_thread) {
+		enet_host_flush(host); // Otherwise the I/O thread flushes on its next pass.
+	}
 
 	return OK;
 }
@@ -858,6 +985,16 @@ bool NetworkedMultiplayerENet::is_server_relay_enabled() const {
 	return server_relay;
 }
 
+void NetworkedMultiplayerENet::set_use_threads(bool p_use) {
+	ERR_FAIL_COND_MSG(active, "Threaded I/O can't be toggled while the multiplayer instance is active.");
+
+	use_threads = p_use;
+}
+
+bool NetworkedMultiplayerENet::is_using_threads() const {
+	return use_threads;
+}
+
 void NetworkedMultiplayerENet::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("create_server", "port", "max_clients", "in_bandwidth", "out_bandwidth"), &NetworkedMultiplayerENet::create_server, DEFVAL(32), DEFVAL(0), DEFVAL(0));
@@ -886,6 +1023,8 @@ void NetworkedMultiplayerENet::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_always_ordered"), &NetworkedMultiplayerENet::is_always_ordered);
 	ClassDB::bind_method(D_METHOD("set_server_relay_enabled", "enabled"), &NetworkedMultiplayerENet::set_server_relay_enabled);
 	ClassDB::bind_method(D_METHOD("is_server_relay_enabled"), &NetworkedMultiplayerENet::is_server_relay_enabled);
+	ClassDB::bind_method(D_METHOD("set_use_threads", "enable"), &NetworkedMultiplayerENet::set_use_threads);
+	ClassDB::bind_method(D_METHOD("is_using_threads"), &NetworkedMultiplayerENet::is_using_threads);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "compression_mode", PROPERTY_HINT_ENUM, "None,Range Coder,FastLZ,ZLib,ZStd"), "set_compression_mode", "get_compression_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "transfer_channel"), "set_transfer_channel", "get_transfer_channel");
@@ -894,6 +1033,7 @@ void NetworkedMultiplayerENet::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_relay"), "set_server_relay_enabled", "is_server_relay_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "dtls_verify"), "set_dtls_verify_enabled", "is_dtls_verify_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_dtls"), "set_dtls_enabled", "is_dtls_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_threads"), "set_use_threads", "is_using_threads");
 
 	BIND_ENUM_CONSTANT(COMPRESS_NONE);
 	BIND_ENUM_CONSTANT(COMPRESS_RANGE_CODER);
@@ -926,6 +1066,11 @@ NetworkedMultiplayerENet::NetworkedMultiplayerENet() {
 
 	dtls_enabled = false;
 	dtls_verify = true;
+
+	use_threads = false;
+	io_thread = NULL;
+	io_thread_quit = false;
+	io_thread_interval_usec = 1000;
 }
 
 NetworkedMultiplayerENet::~NetworkedMultiplayerENet() {
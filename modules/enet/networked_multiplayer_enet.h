@@ -34,6 +34,11 @@
 #include "core/crypto/crypto.h"
 #include "core/io/compression.h"
 #include "core/io/networked_multiplayer_peer.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/pair.h"
+
+#include <atomic>
 
 #include <enet/enet.h>
 
@@ -117,6 +122,23 @@ private:
 	Ref<X509Certificate> dtls_cert;
 	bool dtls_verify;
 
+	// With use_threads, the host is serviced and flushed (so compressed) on io_thread.
+	// host_mutex guards the host and io_events, signals are emitted with it released.
+	bool use_threads;
+	Thread *io_thread;
+	std::atomic<bool> io_thread_quit;
+	uint32_t io_thread_interval_usec;
+	Mutex host_mutex;
+	List<ENetEvent> io_events;
+	List<Pair<StringName, int>> queued_signals;
+
+	static void _io_thread_func(void *p_userdata);
+	void _start_io_thread();
+	void _stop_io_thread();
+	bool _process_event(ENetEvent &event);
+	void _queue_signal(const StringName &p_signal, int p_peer = 0);
+	void _emit_queued_signals();
+
 protected:
 	static void _bind_methods();
 
@@ -167,6 +189,8 @@ public:
 	bool is_always_ordered() const;
 	void set_server_relay_enabled(bool p_enabled);
 	bool is_server_relay_enabled() const;
+	void set_use_threads(bool p_use);
+	bool is_using_threads() const;
 
 	NetworkedMultiplayerENet();
 	~NetworkedMultiplayerENet();
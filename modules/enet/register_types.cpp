@@ -30,6 +30,7 @@
 
 #include "register_types.h"
 #include "core/error_macros.h"
+#include "core/project_settings.h"
 #include "networked_multiplayer_enet.h"
 
 static bool enet_ok = false;
@@ -42,6 +43,9 @@ void register_enet_types() {
 		enet_ok = true;
 	}
 
+	GLOBAL_DEF("network/limits/enet/io_thread_interval_usec", 1000);
+	ProjectSettings::get_singleton()->set_custom_property_info("network/limits/enet/io_thread_interval_usec", PropertyInfo(Variant::INT, "network/limits/enet/io_thread_interval_usec", PROPERTY_HINT_RANGE, "100,100000,1,or_greater"));
+
 	ClassDB::register_class<NetworkedMultiplayerENet>();
 }
 
@@ -35,6 +35,7 @@
 #include "core/os/copymem.h"
 #include "core/os/os.h"
 #include "core/print_string.h"
+#include "core/thread_work_pool.h"
 
 static Image::Format _get_etc2_mode(Image::UsedChannels format) {
 	switch (format) {
@@ -88,6 +89,44 @@ static Etc::Image::Format _image_format_to_etc2comp_format(Image::Format format)
 	}
 }
 
+struct ETCMipmapTask {
+	const uint8_t *src;
+	int width;
+	int height;
+	unsigned char *etc_data = NULL;
+	unsigned int etc_data_len = 0;
+};
+
+struct ETCCompressionJob {
+	ETCMipmapTask *tasks;
+	Etc::Image::Format format;
+	Etc::ErrorMetric error_metric;
+	float effort;
+
+	void encode_mipmap(uint32_t p_index, int p_jobs) {
+
+		ETCMipmapTask &task = tasks[p_index];
+
+		// convert source image to internal etc2comp format (which is equivalent to Image::FORMAT_RGBAF)
+		// NOTE: We can alternatively add a case to Image::convert to handle Image::FORMAT_RGBAF conversion.
+		Etc::ColorFloatRGBA *src_rgba_f = new Etc::ColorFloatRGBA[task.width * task.height];
+		for (int j = 0; j < task.width * task.height; j++) {
+			int si = j * 4; // RGBA8
+			src_rgba_f[j] = Etc::ColorFloatRGBA::ConvertFromRGBA8(task.src[si], task.src[si + 1], task.src[si + 2], task.src[si + 3]);
+		}
+
+		unsigned int extended_width = 0, extended_height = 0;
+		int encoding_time = 0;
+		Etc::Encode((float *)src_rgba_f, task.width, task.height, format, error_metric, effort, p_jobs, p_jobs, &task.etc_data, &task.etc_data_len, &extended_width, &extended_height, &encoding_time);
+
+		delete[] src_rgba_f;
+	}
+
+	void encode_small_mipmap(uint32_t p_index, void *p_unused) {
+		encode_mipmap(p_index + 1, 1);
+	}
+};
+
 static void _compress_etc(Image *p_img, float p_lossy_quality, bool force_etc1_format, Image::UsedChannels p_channels) {
 	Image::Format img_format = p_img->get_format();
 
@@ -162,7 +201,6 @@ static void _compress_etc(Image *p_img, float p_lossy_quality, bool force_etc1_f
 
 	// prepare parameters to be passed to etc2comp
 	int num_cpus = OS::get_singleton()->get_processor_count();
-	int encoding_time = 0;
 	float effort = 0.0; //default, reasonable time
 
 	if (p_lossy_quality > 0.75)
@@ -172,37 +210,52 @@ static void _compress_etc(Image *p_img, float p_lossy_quality, bool force_etc1_f
 	else if (p_lossy_quality > 0.95)
 		effort = 0.8;
 
-	Etc::ErrorMetric error_metric = Etc::ErrorMetric::RGBX; // NOTE: we can experiment with other error metrics
-	Etc::Image::Format etc2comp_etc_format = _image_format_to_etc2comp_format(etc_format);
-
-	int wofs = 0;
+	Vector<ETCMipmapTask> tasks;
+	tasks.resize(mmc);
 
-	print_verbose("ETC: Begin encoding, format: " + Image::get_format_name(etc_format));
-	uint64_t t = OS::get_singleton()->get_ticks_msec();
 	for (int i = 0; i < mmc; i++) {
-		// convert source image to internal etc2comp format (which is equivalent to Image::FORMAT_RGBAF)
-		// NOTE: We can alternatively add a case to Image::convert to handle Image::FORMAT_RGBAF conversion.
 		int mipmap_ofs = 0, mipmap_size = 0, mipmap_w = 0, mipmap_h = 0;
 		img->get_mipmap_offset_size_and_dimensions(i, mipmap_ofs, mipmap_size, mipmap_w, mipmap_h);
-		const uint8_t *src = &r[mipmap_ofs];
+		tasks.write[i].src = &r[mipmap_ofs];
+		tasks.write[i].width = mipmap_w;
+		tasks.write[i].height = mipmap_h;
+	}
 
-		Etc::ColorFloatRGBA *src_rgba_f = new Etc::ColorFloatRGBA[mipmap_w * mipmap_h];
-		for (int j = 0; j < mipmap_w * mipmap_h; j++) {
-			int si = j * 4; // RGBA8
-			src_rgba_f[j] = Etc::ColorFloatRGBA::ConvertFromRGBA8(src[si], src[si + 1], src[si + 2], src[si + 3]);
+	ETCCompressionJob job;
+	job.tasks = tasks.ptrw();
+	job.format = _image_format_to_etc2comp_format(etc_format);
+	job.error_metric = Etc::ErrorMetric::RGBX; // NOTE: we can experiment with other error metrics
+	job.effort = effort;
+
+	print_verbose("ETC: Begin encoding, format: " + Image::get_format_name(etc_format));
+	uint64_t t = OS::get_singleton()->get_ticks_msec();
+
+	//etc2comp already splits a mipmap across threads, but each call waits for all of them.
+	//The smaller mipmaps, a third of the work together, are encoded on the work pool meanwhile.
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	ThreadWorkPool::TaskID small_mipmaps = ThreadWorkPool::INVALID_TASK_ID;
+	if (mmc > 1 && pool && pool->get_thread_count() > 0) {
+		small_mipmaps = pool->add_group_task(mmc - 1, &job, &ETCCompressionJob::encode_small_mipmap, (void *)NULL, 1);
+	}
+
+	job.encode_mipmap(0, num_cpus);
+
+	if (small_mipmaps != ThreadWorkPool::INVALID_TASK_ID) {
+		pool->wait_for_task(small_mipmaps);
+	} else {
+		for (int i = 1; i < mmc; i++) {
+			job.encode_mipmap(i, num_cpus);
 		}
+	}
 
-		unsigned char *etc_data = NULL;
-		unsigned int etc_data_len = 0;
-		unsigned int extended_width = 0, extended_height = 0;
-		Etc::Encode((float *)src_rgba_f, mipmap_w, mipmap_h, etc2comp_etc_format, error_metric, effort, num_cpus, num_cpus, &etc_data, &etc_data_len, &extended_width, &extended_height, &encoding_time);
+	int wofs = 0;
 
-		CRASH_COND(wofs + etc_data_len > target_size);
-		memcpy(&w[wofs], etc_data, etc_data_len);
-		wofs += etc_data_len;
+	for (int i = 0; i < mmc; i++) {
+		CRASH_COND(wofs + tasks[i].etc_data_len > target_size);
+		memcpy(&w[wofs], tasks[i].etc_data, tasks[i].etc_data_len);
+		wofs += tasks[i].etc_data_len;
 
-		delete[] etc_data;
-		delete[] src_rgba_f;
+		delete[] tasks[i].etc_data;
 	}
 
 	print_verbose("ETC: Time encoding: " + rtos(OS::get_singleton()->get_ticks_msec() - t));
@@ -241,6 +241,34 @@ void GDAPI *godot_nativescript_get_instance_binding_data(int p_idx, godot_object
 
 void GDAPI godot_nativescript_profiling_add_data(const char *p_signature, uint64_t p_time);
 
+/*
+ *
+ *
+ * NativeScript 1.2
+ *
+ *
+ */
+
+// ptrcall methods, called from native code without any Variant in between
+
+typedef struct {
+	// instance pointer, method data, user data, args, return value
+	// args and return value point to the native types, as in godot_method_bind_ptrcall
+	GDCALLINGCONV void (*method)(godot_object *, void *, void *, const void **, void *);
+	void *method_data;
+	GDCALLINGCONV void (*free_func)(void *);
+} godot_instance_ptrcall_method;
+
+// the method must have been registered with godot_nativescript_register_method first
+void GDAPI godot_nativescript_set_method_ptrcall(void *p_gdnative_handle, const char *p_name, const char *p_function_name, godot_instance_ptrcall_method p_method);
+
+// the same index is valid for every class, -1 if no class has a ptrcall method of that name yet
+godot_int GDAPI godot_nativescript_get_method_index(const godot_string_name *p_function_name);
+
+// return false (batch: skip the instance) if it is not a NativeScript instance with that ptrcall method
+godot_bool GDAPI godot_nativescript_ptrcall(godot_object *p_instance, godot_int p_method_index, const void **p_args, void *r_ret);
+godot_int GDAPI godot_nativescript_ptrcall_batch(godot_object **p_instances, godot_int p_instance_count, godot_int p_method_index, const void **p_args);
+
 #ifdef __cplusplus
 }
 #endif
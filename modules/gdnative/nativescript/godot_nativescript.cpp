@@ -127,6 +127,7 @@ void GDAPI godot_nativescript_register_method(void *p_gdnative_handle, const cha
 
 	NativeScriptDesc::Method method;
 	method.method = p_method;
+	zeromem(&method.ptrcall, sizeof(godot_instance_ptrcall_method));
 	method.rpc_mode = p_attr.rpc_type;
 	method.rpc_method_id = UINT16_MAX;
 	if (p_attr.rpc_type != GODOT_METHOD_RPC_MODE_DISABLED) {
@@ -349,6 +350,81 @@ void GDAPI godot_nativescript_profiling_add_data(const char *p_signature, uint64
 	NativeScriptLanguage::get_singleton()->profiling_add_data(StringName(p_signature), p_time);
 }
 
+/*
+ *
+ *
+ * NativeScript 1.2
+ *
+ *
+ */
+
+void GDAPI godot_nativescript_set_method_ptrcall(void *p_gdnative_handle, const char *p_name, const char *p_function_name, godot_instance_ptrcall_method p_method) {
+	String *s = (String *)p_gdnative_handle;
+
+	Map<StringName, NativeScriptDesc>::Element *E = NSL->library_classes[*s].find(p_name);
+	ERR_FAIL_COND_MSG(!E, "Attempted to set a ptrcall function for a method on a non-existent class.");
+
+	Map<StringName, NativeScriptDesc::Method>::Element *method = E->get().methods.find(p_function_name);
+	ERR_FAIL_COND_MSG(!method, "Attempted to set a ptrcall function for a non-existent method.");
+
+	if (method->get().ptrcall.free_func) {
+		method->get().ptrcall.free_func(method->get().ptrcall.method_data);
+	}
+	method->get().ptrcall = p_method;
+}
+
+godot_int GDAPI godot_nativescript_get_method_index(const godot_string_name *p_function_name) {
+	return NSL->get_method_index(*(StringName *)p_function_name);
+}
+
+static _FORCE_INLINE_ const NativeScriptDesc::Method *_get_ptrcall_method(Object *p_instance, godot_int p_method_index, void *&r_userdata) {
+	if (!p_instance) {
+		return NULL;
+	}
+
+	ScriptInstance *si = p_instance->get_script_instance();
+	if (!si || si->get_language() != NSL) {
+		return NULL;
+	}
+
+	NativeScriptInstance *nsi = (NativeScriptInstance *)si;
+	const NativeScriptDesc *desc = nsi->get_script_desc();
+	if (!desc || p_method_index < 0 || p_method_index >= (godot_int)desc->ptrcall_methods.size()) {
+		return NULL;
+	}
+
+	r_userdata = nsi->userdata;
+	return desc->ptrcall_methods[p_method_index];
+}
+
+godot_bool GDAPI godot_nativescript_ptrcall(godot_object *p_instance, godot_int p_method_index, const void **p_args, void *r_ret) {
+	void *userdata;
+	const NativeScriptDesc::Method *method = _get_ptrcall_method((Object *)p_instance, p_method_index, userdata);
+	if (!method) {
+		return false;
+	}
+
+	method->ptrcall.method(p_instance, method->ptrcall.method_data, userdata, p_args, r_ret);
+	return true;
+}
+
+godot_int GDAPI godot_nativescript_ptrcall_batch(godot_object **p_instances, godot_int p_instance_count, godot_int p_method_index, const void **p_args) {
+	godot_int called = 0;
+
+	for (godot_int i = 0; i < p_instance_count; i++) {
+		void *userdata;
+		const NativeScriptDesc::Method *method = _get_ptrcall_method((Object *)p_instances[i], p_method_index, userdata);
+		if (!method) {
+			continue;
+		}
+
+		method->ptrcall.method(p_instances[i], method->ptrcall.method_data, userdata, p_args, NULL);
+		called++;
+	}
+
+	return called;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -113,6 +113,7 @@ void NativeScript::_placeholder_erased(PlaceHolderScriptInstance *p_placeholder)
 
 void NativeScript::set_class_name(String p_class_name) {
 	class_name = p_class_name;
+	script_desc_cache = NULL;
 }
 
 String NativeScript::get_class_name() const {
@@ -129,6 +130,7 @@ void NativeScript::set_library(Ref<GDNativeLibrary> p_library) {
 	}
 	library = p_library;
 	lib_path = library->get_current_library_path();
+	script_desc_cache = NULL;
 
 #ifndef NO_THREADS
 	if (Thread::get_caller_id() != Thread::get_main_id()) {
@@ -266,13 +268,7 @@ Error NativeScript::reload(bool p_keep_state) {
 bool NativeScript::has_method(const StringName &p_method) const {
 	NativeScriptDesc *script_data = get_script_desc();
 
-	while (script_data) {
-		if (script_data->methods.has(p_method))
-			return true;
-
-		script_data = script_data->base_data;
-	}
-	return false;
+	return script_data && script_data->method_cache.has(p_method);
 }
 
 MethodInfo NativeScript::get_method_info(const StringName &p_method) const {
@@ -778,6 +774,8 @@ NativeScript::NativeScript() {
 	library = Ref<GDNative>();
 	lib_path = "";
 	class_name = "";
+	script_desc_cache = NULL;
+	script_desc_version = 0;
 }
 
 NativeScript::~NativeScript() {
@@ -957,32 +955,29 @@ Variant NativeScriptInstance::call(const StringName &p_method, const Variant **p
 
 	NativeScriptDesc *script_data = GET_SCRIPT_DESC();
 
-	while (script_data) {
-		Map<StringName, NativeScriptDesc::Method>::Element *E = script_data->methods.find(p_method);
-		if (E) {
-			godot_variant result;
+	const NativeScriptDesc::Method *const *M = script_data ? script_data->method_cache.getptr(p_method) : NULL;
+	if (M) {
+		const NativeScriptDesc::Method *method = *M;
+		godot_variant result;
 
 #ifdef DEBUG_ENABLED
-			current_method_call = p_method;
+		current_method_call = p_method;
 #endif
 
-			result = E->get().method.method((godot_object *)owner,
-					E->get().method.method_data,
-					userdata,
-					p_argcount,
-					(godot_variant **)p_args);
+		result = method->method.method((godot_object *)owner,
+				method->method.method_data,
+				userdata,
+				p_argcount,
+				(godot_variant **)p_args);
 
 #ifdef DEBUG_ENABLED
-			current_method_call = "";
+		current_method_call = "";
 #endif
 
-			Variant res = *(Variant *)&result;
-			godot_variant_destroy(&result);
-			r_error.error = Callable::CallError::CALL_OK;
-			return res;
-		}
-
-		script_data = script_data->base_data;
+		Variant res = *(Variant *)&result;
+		godot_variant_destroy(&result);
+		r_error.error = Callable::CallError::CALL_OK;
+		return res;
 	}
 
 	r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
@@ -1191,6 +1186,9 @@ void NativeScriptLanguage::_unload_stuff(bool p_reload) {
 			for (Map<StringName, NativeScriptDesc::Method>::Element *M = C->get().methods.front(); M; M = M->next()) {
 				if (M->get().method.free_func)
 					M->get().method.free_func(M->get().method.method_data);
+
+				if (M->get().ptrcall.free_func)
+					M->get().ptrcall.free_func(M->get().ptrcall.method_data);
 			}
 
 			// free constructor/destructor
@@ -1209,6 +1207,7 @@ void NativeScriptLanguage::_unload_stuff(bool p_reload) {
 		Ref<GDNative> gdn = E->get();
 
 		library_classes.erase(lib_path);
+		library_classes_version++;
 
 		if (gdn.is_valid() && gdn->get_library().is_valid()) {
 			Ref<GDNativeLibrary> lib = gdn->get_library();
@@ -1224,8 +1223,60 @@ void NativeScriptLanguage::_unload_stuff(bool p_reload) {
 	}
 }
 
+void NativeScriptLanguage::_build_method_tables(const String &p_lib_path) {
+	MutexLock lock(mutex);
+
+	Map<String, Map<StringName, NativeScriptDesc>>::Element *L = library_classes.find(p_lib_path);
+	ERR_FAIL_COND(!L);
+
+	for (Map<StringName, NativeScriptDesc>::Element *C = L->get().front(); C; C = C->next()) {
+		NativeScriptDesc &desc = C->get();
+		desc.method_cache.clear();
+		desc.ptrcall_methods.clear();
+
+		// most derived first, so a method only takes a slot no override took yet
+		for (const NativeScriptDesc *d = &desc; d; d = d->base_data) {
+			for (const Map<StringName, NativeScriptDesc::Method>::Element *M = d->methods.front(); M; M = M->next()) {
+				if (desc.method_cache.has(M->key())) {
+					continue;
+				}
+				desc.method_cache.set(M->key(), &M->get());
+
+				if (!M->get().ptrcall.method) {
+					continue;
+				}
+
+				uint32_t idx = get_method_index(M->key(), true);
+				while (desc.ptrcall_methods.size() <= idx) {
+					desc.ptrcall_methods.push_back(NULL);
+				}
+				desc.ptrcall_methods[idx] = &M->get();
+			}
+		}
+	}
+}
+
+int NativeScriptLanguage::get_method_index(const StringName &p_method, bool p_create) {
+	MutexLock lock(mutex);
+
+	const int *idx = method_indices.getptr(p_method);
+	if (idx) {
+		return *idx;
+	}
+
+	if (!p_create) {
+		return -1;
+	}
+
+	// indices are never reused, so native code can keep them across library reloads
+	int new_idx = method_indices.size();
+	method_indices.set(p_method, new_idx);
+	return new_idx;
+}
+
 NativeScriptLanguage::NativeScriptLanguage() {
 	NativeScriptLanguage::singleton = this;
+	library_classes_version = 1;
 #ifndef NO_THREADS
 	has_objects_to_register = false;
 #endif
@@ -1692,6 +1743,7 @@ void NativeScriptLanguage::init_library(const Ref<GDNativeLibrary> &lib) {
 		library_gdnatives.insert(lib_path, gdn);
 
 		library_classes.insert(lib_path, Map<StringName, NativeScriptDesc>());
+		library_classes_version++;
 
 		if (!library_script_users.has(lib_path))
 			library_script_users.insert(lib_path, Set<NativeScript *>());
@@ -1704,6 +1756,7 @@ void NativeScriptLanguage::init_library(const Ref<GDNativeLibrary> &lib) {
 			ERR_PRINT(String("No " + _init_call_name + " in \"" + lib_path + "\" found").utf8().get_data());
 		} else {
 			((void (*)(godot_string *))proc_ptr)((godot_string *)&lib_path);
+			_build_method_tables(lib_path);
 		}
 	} else {
 		// already initialized. Nice.
@@ -1893,6 +1946,7 @@ void NativeReloadNode::_notification(int p_what) {
 				}
 
 				NSL->library_classes.insert(L->key(), Map<StringName, NativeScriptDesc>());
+				NSL->library_classes_version++;
 
 				// here the library registers all the classes and stuff.
 
@@ -1902,6 +1956,7 @@ void NativeReloadNode::_notification(int p_what) {
 					ERR_PRINT(String("No godot_nativescript_init in \"" + L->key() + "\" found").utf8().get_data());
 				} else {
 					((void (*)(void *))proc_ptr)((void *)&L->key());
+					NSL->_build_method_tables(L->key());
 				}
 
 				for (Map<String, Set<NativeScript *>>::Element *U = NSL->library_script_users.front(); U; U = U->next()) {
@@ -33,6 +33,8 @@
 
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/hash_map.h"
+#include "core/local_vector.h"
 #include "core/oa_hash_map.h"
 #include "core/ordered_hash_map.h"
 #include "core/os/mutex.h"
@@ -49,6 +51,7 @@ struct NativeScriptDesc {
 
 	struct Method {
 		godot_instance_method method;
+		godot_instance_ptrcall_method ptrcall;
 		MethodInfo info;
 		int rpc_mode;
 		uint16_t rpc_method_id;
@@ -86,6 +89,11 @@ struct NativeScriptDesc {
 
 	bool is_tool;
 
+	// Built once the library is initialized, both include the methods of the
+	// base classes, with overrides taking precedence.
+	HashMap<StringName, const Method *> method_cache;
+	LocalVector<const Method *> ptrcall_methods; // Indexed by NativeScriptLanguage::get_method_index().
+
 	inline NativeScriptDesc() :
 			rpc_count(0),
 			methods(),
@@ -121,6 +129,11 @@ class NativeScript : public Script {
 
 	String class_name;
 
+	// Resolving the desc takes two map lookups, cache it until the library
+	// classes change.
+	mutable NativeScriptDesc *script_desc_cache;
+	mutable uint32_t script_desc_version;
+
 	String script_class_name;
 	String script_class_icon_path;
 
@@ -213,6 +226,8 @@ class NativeScriptInstance : public ScriptInstance {
 public:
 	void *userdata;
 
+	_FORCE_INLINE_ NativeScriptDesc *get_script_desc() const { return script->get_script_desc(); }
+
 	virtual bool set(const StringName &p_name, const Variant &p_value);
 	virtual bool get(const StringName &p_name, Variant &r_ret) const;
 	virtual void get_property_list(List<PropertyInfo> *p_properties) const;
@@ -260,6 +275,9 @@ private:
 	int lang_idx;
 
 	void _unload_stuff(bool p_reload = false);
+	void _build_method_tables(const String &p_lib_path);
+
+	HashMap<StringName, int> method_indices;
 
 	Mutex mutex;
 #ifndef NO_THREADS
@@ -300,6 +318,7 @@ public:
 	// These two maps must only be touched on the main thread
 	Map<String, Map<StringName, NativeScriptDesc>> library_classes;
 	Map<String, Ref<GDNative>> library_gdnatives;
+	uint32_t library_classes_version; // Bumped whenever descs may have been freed.
 
 	Map<String, Set<NativeScript *>> library_script_users;
 
@@ -324,6 +343,8 @@ public:
 
 	_FORCE_INLINE_ void set_language_index(int p_idx) { lang_idx = p_idx; }
 
+	int get_method_index(const StringName &p_method, bool p_create = false);
+
 #ifndef NO_THREADS
 	virtual void thread_enter();
 	virtual void thread_exit();
@@ -388,8 +409,14 @@ public:
 };
 
 inline NativeScriptDesc *NativeScript::get_script_desc() const {
+	if (script_desc_cache && script_desc_version == NativeScriptLanguage::singleton->library_classes_version) {
+		return script_desc_cache;
+	}
+
 	Map<StringName, NativeScriptDesc>::Element *E = NativeScriptLanguage::singleton->library_classes[lib_path].find(class_name);
-	return E ? &E->get() : NULL;
+	script_desc_cache = E ? &E->get() : NULL;
+	script_desc_version = NativeScriptLanguage::singleton->library_classes_version;
+	return script_desc_cache;
 }
 
 class NativeReloadNode : public Node {
@@ -31,6 +31,7 @@
 #include "gd_navigation_server.h"
 
 #include "core/os/mutex.h"
+#include "core/project_settings.h"
 
 #ifndef _3D_DISABLED
 #include "navigation_mesh_generator.h"
@@ -116,9 +117,20 @@
 GdNavigationServer::GdNavigationServer() :
 		NavigationServer3D(),
 		active(true) {
+
+	max_path_queries_per_frame = GLOBAL_DEF("navigation/3d/max_path_queries_per_frame", 256);
+	ProjectSettings::get_singleton()->set_custom_property_info("navigation/3d/max_path_queries_per_frame", PropertyInfo(Variant::INT, "navigation/3d/max_path_queries_per_frame", PROPERTY_HINT_RANGE, "1,4096,1,or_greater"));
+	use_hierarchical_paths = GLOBAL_DEF("navigation/3d/use_hierarchical_paths", true);
+	path_cache_size = GLOBAL_DEF("navigation/3d/path_cache_size", 64);
+	ProjectSettings::get_singleton()->set_custom_property_info("navigation/3d/path_cache_size", PropertyInfo(Variant::INT, "navigation/3d/path_cache_size", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"));
 }
 
 GdNavigationServer::~GdNavigationServer() {
+	_finish_path_queries();
+	for (Map<int64_t, PathQuery *>::Element *E = path_queries.front(); E; E = E->next()) {
+		memdelete(E->get());
+	}
+	path_queries.clear();
 	flush_queries();
 }
 
@@ -134,6 +146,8 @@ RID GdNavigationServer::map_create() const {
 	auto mut_this = const_cast<GdNavigationServer *>(this);
 	MutexLock lock(mut_this->operations_mutex);
 	NavMap *space = memnew(NavMap);
+	space->set_use_hierarchical_paths(use_hierarchical_paths);
+	space->set_path_cache_size(path_cache_size);
 	RID rid = map_owner.make_rid(space);
 	space->set_self(rid);
 	return rid;
@@ -236,6 +250,107 @@ RID GdNavigationServer::map_get_closest_point_owner(RID p_map, const Vector3 &p_
 	return map->get_closest_point_owner(p_point);
 }
 
+int64_t GdNavigationServer::map_query_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, const Callable &p_callback) const {
+	auto mut_this = const_cast<GdNavigationServer *>(this);
+	MutexLock lock(mut_this->path_queries_mutex);
+
+	PathQuery *query = memnew(PathQuery);
+	query->map = p_map;
+	query->origin = p_origin;
+	query->destination = p_destination;
+	query->optimize = p_optimize;
+	query->callback = p_callback;
+
+	int64_t id = ++mut_this->last_path_query_id;
+	mut_this->path_queries[id] = query;
+	mut_this->pending_path_queries.push_back(id);
+	return id;
+}
+
+bool GdNavigationServer::path_query_is_done(int64_t p_query) const {
+	auto mut_this = const_cast<GdNavigationServer *>(this);
+	MutexLock lock(mut_this->path_queries_mutex);
+
+	const Map<int64_t, PathQuery *>::Element *E = path_queries.find(p_query);
+	ERR_FAIL_COND_V_MSG(E == NULL, false, "Invalid path query.");
+	return E->get()->done;
+}
+
+Vector<Vector3> GdNavigationServer::path_query_get_result(int64_t p_query) const {
+	auto mut_this = const_cast<GdNavigationServer *>(this);
+	MutexLock lock(mut_this->path_queries_mutex);
+
+	Map<int64_t, PathQuery *>::Element *E = mut_this->path_queries.find(p_query);
+	ERR_FAIL_COND_V_MSG(E == NULL, Vector<Vector3>(), "Invalid path query.");
+	ERR_FAIL_COND_V_MSG(!E->get()->done, Vector<Vector3>(), "The path query is not done yet.");
+
+	Vector<Vector3> path = E->get()->path;
+	memdelete(E->get());
+	mut_this->path_queries.erase(E);
+	return path;
+}
+
+void GdNavigationServer::_run_path_query(uint32_t p_index, void *p_unused) {
+	PathQuery *query = running_path_queries[p_index];
+	if (query->nav_map) {
+		query->path = query->nav_map->get_path(query->origin, query->destination, query->optimize);
+	}
+}
+
+void GdNavigationServer::_start_path_queries() {
+	ERR_FAIL_COND(path_query_task != ThreadWorkPool::INVALID_TASK_ID);
+
+	{
+		MutexLock lock(path_queries_mutex);
+		const int count = MIN((int)pending_path_queries.size(), max_path_queries_per_frame);
+		for (int i(0); i < count; i++) {
+			const int64_t id = pending_path_queries[i];
+			PathQuery *query = path_queries[id];
+			query->nav_map = map_owner.getornull(query->map);
+			running_path_queries.push_back(query);
+			running_path_query_ids.push_back(id);
+		}
+		// Over the budget, the rest waits for the next frames.
+		pending_path_queries.erase(pending_path_queries.begin(), pending_path_queries.begin() + count);
+	}
+
+	if (running_path_queries.size()) {
+		path_query_task = ThreadWorkPool::get_singleton()->add_group_task(running_path_queries.size(), this, &GdNavigationServer::_run_path_query, (void *)NULL, 1);
+	}
+}
+
+void GdNavigationServer::_finish_path_queries() {
+	if (path_query_task == ThreadWorkPool::INVALID_TASK_ID) {
+		return;
+	}
+	ThreadWorkPool::get_singleton()->wait_for_task(path_query_task);
+	path_query_task = ThreadWorkPool::INVALID_TASK_ID;
+
+	for (size_t i(0); i < running_path_queries.size(); i++) {
+		PathQuery *query = running_path_queries[i];
+		if (query->callback.is_null()) {
+			MutexLock lock(path_queries_mutex);
+			query->done = true; // Polled with `path_query_get_result`.
+			continue;
+		}
+
+		if (query->callback.is_custom() || ObjectDB::get_instance(query->callback.get_object_id())) {
+			Variant id = running_path_query_ids[i];
+			Variant path = query->path;
+			const Variant *vp[2] = { &id, &path };
+			Variant ret;
+			Callable::CallError call_error;
+			query->callback.call(vp, 2, ret, call_error);
+		}
+
+		MutexLock lock(path_queries_mutex);
+		path_queries.erase(running_path_query_ids[i]);
+		memdelete(query);
+	}
+	running_path_queries.clear();
+	running_path_query_ids.clear();
+}
+
 RID GdNavigationServer::region_create() const {
 	auto mut_this = const_cast<GdNavigationServer *>(this);
 	MutexLock lock(mut_this->operations_mutex);
@@ -481,20 +596,23 @@ void GdNavigationServer::flush_queries() {
 }
 
 void GdNavigationServer::process(real_t p_delta_time) {
+	// The queries of the previous frame must be done before the maps change.
+	_finish_path_queries();
+
 	flush_queries();
 
-	if (!active) {
-		return;
+	if (active) {
+		// In c++ we can't be sure that this is performed in the main thread
+		// even with mutable functions.
+		MutexLock lock(operations_mutex);
+		for (int i(0); i < active_maps.size(); i++) {
+			active_maps[i]->sync();
+			active_maps[i]->step(p_delta_time);
+			active_maps[i]->dispatch_callbacks();
+		}
 	}
 
-	// In c++ we can't be sure that this is performed in the main thread
-	// even with mutable functions.
-	MutexLock lock(operations_mutex);
-	for (int i(0); i < active_maps.size(); i++) {
-		active_maps[i]->sync();
-		active_maps[i]->step(p_delta_time);
-		active_maps[i]->dispatch_callbacks();
-	}
+	_start_path_queries();
 }
 
 #undef COMMAND_1
@@ -31,8 +31,10 @@
 #ifndef GD_NAVIGATION_SERVER_H
 #define GD_NAVIGATION_SERVER_H
 
+#include "core/map.h"
 #include "core/rid.h"
 #include "core/rid_owner.h"
+#include "core/thread_work_pool.h"
 #include "servers/navigation_server_3d.h"
 
 #include "nav_map.h"
@@ -81,6 +83,37 @@ class GdNavigationServer : public NavigationServer3D {
 	bool active;
 	Vector<NavMap *> active_maps;
 
+	struct PathQuery {
+		RID map;
+		Vector3 origin;
+		Vector3 destination;
+		bool optimize = false;
+		Callable callback;
+
+		const NavMap *nav_map = NULL;
+		Vector<Vector3> path;
+		bool done = false;
+	};
+
+	/// Protects the path queries, they can be submitted from any thread.
+	Mutex path_queries_mutex;
+	int64_t last_path_query_id = 0;
+	Map<int64_t, PathQuery *> path_queries;
+	std::vector<int64_t> pending_path_queries;
+	/// Queries running on the `ThreadWorkPool` until the next `process`. The
+	/// maps are only changed by the commands, so they don't change meanwhile.
+	std::vector<PathQuery *> running_path_queries;
+	std::vector<int64_t> running_path_query_ids;
+	ThreadWorkPool::TaskID path_query_task = ThreadWorkPool::INVALID_TASK_ID;
+	int max_path_queries_per_frame;
+
+	bool use_hierarchical_paths;
+	int path_cache_size;
+
+	void _run_path_query(uint32_t p_index, void *p_unused);
+	void _start_path_queries();
+	void _finish_path_queries();
+
 public:
 	GdNavigationServer();
 	virtual ~GdNavigationServer();
@@ -107,6 +140,10 @@ public:
 	virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const;
 	virtual RID map_get_closest_point_owner(RID p_map, const Vector3 &p_point) const;
 
+	virtual int64_t map_query_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, const Callable &p_callback = Callable()) const;
+	virtual bool path_query_is_done(int64_t p_query) const;
+	virtual Vector<Vector3> path_query_get_result(int64_t p_query) const;
+
 	virtual RID region_create() const;
 	COMMAND_2(region_set_map, RID, p_region, RID, p_map);
 	COMMAND_2(region_set_transform, RID, p_region, Transform, p_transform);
@@ -30,7 +30,7 @@
 
 #include "nav_map.h"
 
-#include "core/os/threaded_array_processor.h"
+#include "core/thread_work_pool.h"
 #include "nav_region.h"
 #include "rvo_agent.h"
 #include <algorithm>
@@ -41,12 +41,46 @@
 
 #define USE_ENTRY_POINT
 
+/// The maximum number of polygons of the clusters used by the hierarchical path search.
+#define PATH_CLUSTER_MAX_POLYGONS 64
+
+static _FORCE_INLINE_ real_t aabb_distance_squared(const AABB &p_aabb, const Vector3 &p_point) {
+	const Vector3 end = p_aabb.position + p_aabb.size;
+	real_t d = 0;
+	for (int i = 0; i < 3; i++) {
+		if (p_point[i] < p_aabb.position[i]) {
+			d += (p_aabb.position[i] - p_point[i]) * (p_aabb.position[i] - p_point[i]);
+		} else if (p_point[i] > end[i]) {
+			d += (p_point[i] - end[i]) * (p_point[i] - end[i]);
+		}
+	}
+	return d;
+}
+
+static Vector3 get_closest_point_on_polygon(const gd::Polygon *p_polygon, const Vector3 &p_point) {
+	Vector3 closest;
+	float closest_d = 1e20;
+	for (size_t point_id = 2; point_id < p_polygon->points.size(); point_id++) {
+		Face3 f(p_polygon->points[point_id - 2].pos, p_polygon->points[point_id - 1].pos, p_polygon->points[point_id].pos);
+		Vector3 spoint = f.get_closest_point_to(p_point);
+		float dpoint = spoint.distance_to(p_point);
+		if (dpoint < closest_d) {
+			closest = spoint;
+			closest_d = dpoint;
+		}
+	}
+	return closest;
+}
+
 NavMap::NavMap() :
 		up(0, 1, 0),
 		cell_size(0.3),
 		edge_connection_margin(5.0),
 		regenerate_polygons(true),
 		regenerate_links(true),
+		use_hierarchical_paths(true),
+		path_cache_tick(0),
+		path_cache_size(64),
 		agents_dirty(false),
 		deltatime(0.0),
 		map_update_id(0) {}
@@ -66,6 +100,14 @@ void NavMap::set_edge_connection_margin(float p_edge_connection_margin) {
 	regenerate_links = true;
 }
 
+void NavMap::set_path_cache_size(uint32_t p_size) {
+	MutexLock lock(path_cache_mutex);
+	path_cache_size = p_size;
+	if (path_cache.size() > path_cache_size) {
+		path_cache.clear();
+	}
+}
+
 gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	const int x = int(Math::floor(p_pos.x / cell_size));
 	const int y = int(Math::floor(p_pos.y / cell_size));
@@ -85,34 +127,10 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	const gd::Polygon *end_poly = NULL;
 	Vector3 begin_point;
 	Vector3 end_point;
-	float begin_d = 1e20;
-	float end_d = 1e20;
 
 	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each point cast a face and check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-
-			Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 spoint = f.get_closest_point_to(p_origin);
-			float dpoint = spoint.distance_to(p_origin);
-			if (dpoint < begin_d) {
-				begin_d = dpoint;
-				begin_poly = &p;
-				begin_point = spoint;
-			}
-
-			spoint = f.get_closest_point_to(p_destination);
-			dpoint = spoint.distance_to(p_destination);
-			if (dpoint < end_d) {
-				end_d = dpoint;
-				end_poly = &p;
-				end_point = spoint;
-			}
-		}
-	}
+	begin_poly = get_closest_polygon(p_origin, &begin_point);
+	end_poly = get_closest_polygon(p_destination, &end_point);
 
 	if (!begin_poly || !end_poly) {
 		// No path
@@ -129,156 +147,78 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	}
 
 	std::vector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.reserve(polygons.size() * 0.75);
 
 	// The elements indices in the `navigation_polys`.
 	int least_cost_id(-1);
-	List<uint32_t> open_list;
 	bool found_route = false;
-
-	navigation_polys.push_back(gd::NavigationPoly(begin_poly));
-	{
-		least_cost_id = 0;
-		gd::NavigationPoly *least_cost_poly = &navigation_polys[least_cost_id];
-		least_cost_poly->self_id = least_cost_id;
-		least_cost_poly->entry = begin_point;
-	}
-
-	open_list.push_back(0);
-
-	const gd::Polygon *reachable_end = NULL;
-	float reachable_d = 1e30;
 	bool is_reachable = true;
 
-	while (found_route == false) {
-
-		{
-			// Takes the current least_cost_poly neighbors and compute the traveled_distance of each
-			for (size_t i = 0; i < navigation_polys[least_cost_id].poly->edges.size(); i++) {
-				gd::NavigationPoly *least_cost_poly = &navigation_polys[least_cost_id];
-
-				const gd::Edge &edge = least_cost_poly->poly->edges[i];
-				if (!edge.other_polygon)
-					continue;
-
-#ifdef USE_ENTRY_POINT
-				Vector3 edge_line[2] = {
-					least_cost_poly->poly->points[i].pos,
-					least_cost_poly->poly->points[(i + 1) % least_cost_poly->poly->points.size()].pos
-				};
-
-				const Vector3 new_entry = Geometry::get_closest_point_to_segment(least_cost_poly->entry, edge_line);
-				const float new_distance = least_cost_poly->entry.distance_to(new_entry) + least_cost_poly->traveled_distance;
-#else
-				const float new_distance = least_cost_poly->poly->center.distance_to(edge.other_polygon->center) + least_cost_poly->traveled_distance;
-#endif
-
-				auto it = std::find(
-						navigation_polys.begin(),
-						navigation_polys.end(),
-						gd::NavigationPoly(edge.other_polygon));
-
-				if (it != navigation_polys.end()) {
-					// Oh this was visited already, can we win the cost?
-					if (it->traveled_distance > new_distance) {
-
-						it->prev_navigation_poly_id = least_cost_id;
-						it->back_navigation_edge = edge.other_edge;
-						it->traveled_distance = new_distance;
-#ifdef USE_ENTRY_POINT
-						it->entry = new_entry;
-#endif
-					}
-				} else {
-					// Add to open neighbours
-
-					navigation_polys.push_back(gd::NavigationPoly(edge.other_polygon));
-					gd::NavigationPoly *np = &navigation_polys[navigation_polys.size() - 1];
-
-					np->self_id = navigation_polys.size() - 1;
-					np->prev_navigation_poly_id = least_cost_id;
-					np->back_navigation_edge = edge.other_edge;
-					np->traveled_distance = new_distance;
-#ifdef USE_ENTRY_POINT
-					np->entry = new_entry;
-#endif
-					open_list.push_back(navigation_polys.size() - 1);
-				}
-			}
-		}
-
-		// Removes the least cost polygon from the open list so we can advance.
-		open_list.erase(least_cost_id);
-
-		if (open_list.size() == 0) {
-			// When the open list is empty at this point the End Polygon is not reachable
-			// so use the further reachable polygon
-			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
-			is_reachable = false;
-			if (reachable_end == NULL) {
-				// The path is not found and there is not a way out.
+	const gd::Polygon *query_end_poly = end_poly;
+	if (path_cache_size > 0) {
+		MutexLock lock(path_cache_mutex);
+		for (size_t i(0); i < path_cache.size(); i++) {
+			PathCacheEntry &entry = path_cache[i];
+			if (entry.begin_poly == begin_poly && entry.end_poly == end_poly) {
+				entry.last_used = ++path_cache_tick;
+				navigation_polys = entry.navigation_polys;
+				is_reachable = entry.reachable;
+				found_route = true;
 				break;
 			}
+		}
+	}
 
-			// Set as end point the furthest reachable point.
-			end_poly = reachable_end;
-			end_d = 1e20;
-			for (size_t point_id = 2; point_id < end_poly->points.size(); point_id++) {
-				Face3 f(end_poly->points[point_id - 2].pos, end_poly->points[point_id - 1].pos, end_poly->points[point_id].pos);
-				Vector3 spoint = f.get_closest_point_to(p_destination);
-				float dpoint = spoint.distance_to(p_destination);
-				if (dpoint < end_d) {
-					end_point = spoint;
-					end_d = dpoint;
-				}
+	if (found_route) {
+		least_cost_id = navigation_polys.size() - 1;
+		navigation_polys[0].entry = begin_point;
+		if (!is_reachable) {
+			// The route goes as close as possible to the destination.
+			end_poly = navigation_polys[least_cost_id].poly;
+			end_point = get_closest_point_on_polygon(end_poly, p_destination);
+		}
+	} else {
+		if (use_hierarchical_paths && begin_poly->cluster != end_poly->cluster) {
+			// Search the clusters first, then the polygons of the clusters along the way.
+			std::vector<uint8_t> corridor;
+			if (find_cluster_corridor(begin_poly->cluster, end_poly->cluster, corridor)) {
+				found_route = find_polygon_route(begin_poly, begin_point, end_poly, end_point, p_destination, &corridor, navigation_polys, least_cost_id, is_reachable);
 			}
+		}
 
-			// Reset open and navigation_polys
-			gd::NavigationPoly np = navigation_polys[0];
+		if (!found_route) {
 			navigation_polys.clear();
-			navigation_polys.push_back(np);
-			open_list.clear();
-			open_list.push_back(0);
-
-			reachable_end = NULL;
-
-			continue;
+			found_route = find_polygon_route(begin_poly, begin_point, end_poly, end_point, p_destination, NULL, navigation_polys, least_cost_id, is_reachable);
 		}
 
-		// Now take the new least_cost_poly from the open list.
-		least_cost_id = -1;
-		float least_cost = 1e30;
-
-		for (auto element = open_list.front(); element != NULL; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
-			float cost = np->traveled_distance;
-#ifdef USE_ENTRY_POINT
-			cost += np->entry.distance_to(end_point);
-#else
-			cost += np->poly->center.distance_to(end_point);
-#endif
-			if (cost < least_cost) {
-				least_cost_id = np->self_id;
-				least_cost = cost;
+		if (found_route && path_cache_size > 0) {
+			// Only keep the polygons on the route, from the begin to the end.
+			PathCacheEntry entry;
+			entry.begin_poly = begin_poly;
+			entry.end_poly = query_end_poly;
+			entry.reachable = is_reachable;
+			for (int np_id = least_cost_id; np_id != -1; np_id = navigation_polys[np_id].prev_navigation_poly_id) {
+				entry.navigation_polys.push_back(navigation_polys[np_id]);
 			}
-		}
-
-		// Stores the further reachable end polygon, in case our goal is not reachable.
-		if (is_reachable) {
-			float d = navigation_polys[least_cost_id].entry.distance_to(p_destination);
-			if (reachable_d > d) {
-				reachable_d = d;
-				reachable_end = navigation_polys[least_cost_id].poly;
+			std::reverse(entry.navigation_polys.begin(), entry.navigation_polys.end());
+			for (size_t i(0); i < entry.navigation_polys.size(); i++) {
+				entry.navigation_polys[i].self_id = i;
+				entry.navigation_polys[i].prev_navigation_poly_id = int(i) - 1;
 			}
-		}
-
-		ERR_BREAK(least_cost_id == -1);
 
-		// Check if we reached the end
-		if (navigation_polys[least_cost_id].poly == end_poly) {
-			// Yep, done!!
-			found_route = true;
-			break;
+			MutexLock lock(path_cache_mutex);
+			entry.last_used = ++path_cache_tick;
+			if (path_cache.size() < path_cache_size) {
+				path_cache.push_back(entry);
+			} else {
+				// Replace the least recently used.
+				size_t oldest = 0;
+				for (size_t i(1); i < path_cache.size(); i++) {
+					if (path_cache[i].last_used < path_cache[oldest].last_used) {
+						oldest = i;
+					}
+				}
+				path_cache[oldest] = entry;
+			}
 		}
 	}
 
@@ -401,6 +341,162 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	return Vector<Vector3>();
 }
 
+bool NavMap::find_polygon_route(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *&r_end_poly, Vector3 &r_end_point, const Vector3 &p_destination, const std::vector<uint8_t> *p_corridor, std::vector<gd::NavigationPoly> &r_navigation_polys, int &r_least_cost_id, bool &r_reachable) const {
+
+	r_navigation_polys.reserve(p_corridor ? polygons.size() / 8 : polygons.size() * 0.75);
+
+	List<uint32_t> open_list;
+	bool found_route = false;
+
+	r_navigation_polys.push_back(gd::NavigationPoly(p_begin_poly));
+	{
+		r_least_cost_id = 0;
+		gd::NavigationPoly *least_cost_poly = &r_navigation_polys[r_least_cost_id];
+		least_cost_poly->self_id = r_least_cost_id;
+		least_cost_poly->entry = p_begin_point;
+	}
+
+	open_list.push_back(0);
+
+	const gd::Polygon *reachable_end = NULL;
+	float reachable_d = 1e30;
+	bool is_reachable = true;
+
+	while (found_route == false) {
+
+		{
+			// Takes the current least_cost_poly neighbors and compute the traveled_distance of each
+			for (size_t i = 0; i < r_navigation_polys[r_least_cost_id].poly->edges.size(); i++) {
+				gd::NavigationPoly *least_cost_poly = &r_navigation_polys[r_least_cost_id];
+
+				const gd::Edge &edge = least_cost_poly->poly->edges[i];
+				if (!edge.other_polygon)
+					continue;
+
+				if (p_corridor && !(*p_corridor)[edge.other_polygon->cluster])
+					continue;
+
+#ifdef USE_ENTRY_POINT
+				Vector3 edge_line[2] = {
+					least_cost_poly->poly->points[i].pos,
+					least_cost_poly->poly->points[(i + 1) % least_cost_poly->poly->points.size()].pos
+				};
+
+				const Vector3 new_entry = Geometry::get_closest_point_to_segment(least_cost_poly->entry, edge_line);
+				const float new_distance = least_cost_poly->entry.distance_to(new_entry) + least_cost_poly->traveled_distance;
+#else
+				const float new_distance = least_cost_poly->poly->center.distance_to(edge.other_polygon->center) + least_cost_poly->traveled_distance;
+#endif
+
+				auto it = std::find(
+						r_navigation_polys.begin(),
+						r_navigation_polys.end(),
+						gd::NavigationPoly(edge.other_polygon));
+
+				if (it != r_navigation_polys.end()) {
+					// Oh this was visited already, can we win the cost?
+					if (it->traveled_distance > new_distance) {
+
+						it->prev_navigation_poly_id = r_least_cost_id;
+						it->back_navigation_edge = edge.other_edge;
+						it->traveled_distance = new_distance;
+#ifdef USE_ENTRY_POINT
+						it->entry = new_entry;
+#endif
+					}
+				} else {
+					// Add to open neighbours
+
+					r_navigation_polys.push_back(gd::NavigationPoly(edge.other_polygon));
+					gd::NavigationPoly *np = &r_navigation_polys[r_navigation_polys.size() - 1];
+
+					np->self_id = r_navigation_polys.size() - 1;
+					np->prev_navigation_poly_id = r_least_cost_id;
+					np->back_navigation_edge = edge.other_edge;
+					np->traveled_distance = new_distance;
+#ifdef USE_ENTRY_POINT
+					np->entry = new_entry;
+#endif
+					open_list.push_back(r_navigation_polys.size() - 1);
+				}
+			}
+		}
+
+		// Removes the least cost polygon from the open list so we can advance.
+		open_list.erase(r_least_cost_id);
+
+		if (open_list.size() == 0 && p_corridor) {
+			// Let the caller search all the polygons.
+			break;
+		}
+
+		if (open_list.size() == 0) {
+			// When the open list is empty at this point the End Polygon is not reachable
+			// so use the further reachable polygon
+			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
+			is_reachable = false;
+			if (reachable_end == NULL) {
+				// The path is not found and there is not a way out.
+				break;
+			}
+
+			// Set as end point the furthest reachable point.
+			r_end_poly = reachable_end;
+			r_end_point = get_closest_point_on_polygon(r_end_poly, p_destination);
+
+			// Reset open and navigation_polys
+			gd::NavigationPoly np = r_navigation_polys[0];
+			r_navigation_polys.clear();
+			r_navigation_polys.push_back(np);
+			open_list.clear();
+			open_list.push_back(0);
+
+			reachable_end = NULL;
+
+			continue;
+		}
+
+		// Now take the new least_cost_poly from the open list.
+		r_least_cost_id = -1;
+		float least_cost = 1e30;
+
+		for (auto element = open_list.front(); element != NULL; element = element->next()) {
+			gd::NavigationPoly *np = &r_navigation_polys[element->get()];
+			float cost = np->traveled_distance;
+#ifdef USE_ENTRY_POINT
+			cost += np->entry.distance_to(r_end_point);
+#else
+			cost += np->poly->center.distance_to(r_end_point);
+#endif
+			if (cost < least_cost) {
+				r_least_cost_id = np->self_id;
+				least_cost = cost;
+			}
+		}
+
+		// Stores the further reachable end polygon, in case our goal is not reachable.
+		if (is_reachable) {
+			float d = r_navigation_polys[r_least_cost_id].entry.distance_to(p_destination);
+			if (reachable_d > d) {
+				reachable_d = d;
+				reachable_end = r_navigation_polys[r_least_cost_id].poly;
+			}
+		}
+
+		ERR_BREAK(r_least_cost_id == -1);
+
+		// Check if we reached the end
+		if (r_navigation_polys[r_least_cost_id].poly == r_end_poly) {
+			// Yep, done!!
+			found_route = true;
+			break;
+		}
+	}
+
+	r_reachable = is_reachable;
+	return found_route;
+}
+
 Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
 
 	bool use_collision = p_use_collision;
@@ -409,7 +505,7 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 
 	// Find the initial poly and the end poly on this map.
 	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
+		const gd::Polygon &p = *polygons[i];
 
 		// For each point cast a face and check the distance to the segment
 		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
@@ -458,85 +554,83 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 }
 
 Vector3 NavMap::get_closest_point(const Vector3 &p_point) const {
-	// TODO this is really not optimal, please redesign the API to directly return all this data
 
 	Vector3 closest_point;
-	real_t closest_point_d = 1e20;
-
-	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each point cast a face and check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-
-			const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t d = inters.distance_to(p_point);
-			if (d < closest_point_d) {
-				closest_point = inters;
-				closest_point_d = d;
-			}
-		}
-	}
-
+	get_closest_polygon(p_point, &closest_point);
 	return closest_point;
 }
 
 Vector3 NavMap::get_closest_point_normal(const Vector3 &p_point) const {
-	// TODO this is really not optimal, please redesign the API to directly return all this data
 
-	Vector3 closest_point;
 	Vector3 closest_point_normal;
-	real_t closest_point_d = 1e20;
-
-	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each point cast a face and check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-
-			const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t d = inters.distance_to(p_point);
-			if (d < closest_point_d) {
-				closest_point = inters;
-				closest_point_normal = f.get_plane().normal;
-				closest_point_d = d;
-			}
-		}
-	}
-
+	get_closest_polygon(p_point, NULL, &closest_point_normal);
 	return closest_point_normal;
 }
 
 RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
-	// TODO this is really not optimal, please redesign the API to directly return all this data
 
-	Vector3 closest_point;
-	RID closest_point_owner;
+	const gd::Polygon *p = get_closest_polygon(p_point);
+	return p ? p->owner->get_self() : RID();
+}
+
+const gd::Polygon *NavMap::get_closest_polygon(const Vector3 &p_point, Vector3 *r_point, Vector3 *r_normal) const {
+
+	const gd::Polygon *closest_poly = NULL;
 	real_t closest_point_d = 1e20;
 
-	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
+	if (polygon_bvh.empty()) {
+		return NULL;
+	}
 
-		// For each point cast a face and check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+	// Branch and bound, nearest child first so the bound shrinks quickly.
+	int stack[64];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
 
-			const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t d = inters.distance_to(p_point);
-			if (d < closest_point_d) {
-				closest_point = inters;
-				closest_point_owner = p.owner->get_self();
-				closest_point_d = d;
+	while (stack_size) {
+		const PolygonBVHNode &node = polygon_bvh[stack[--stack_size]];
+		if (aabb_distance_squared(node.aabb, p_point) >= closest_point_d * closest_point_d) {
+			continue;
+		}
+
+		if (node.left < 0) {
+			for (int i = node.begin; i < node.begin + node.count; i++) {
+				const gd::Polygon &p = *polygons[polygon_bvh_indices[i]];
+
+				// For each point cast a face and check the distance to the point
+				for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+
+					const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+					const Vector3 inters = f.get_closest_point_to(p_point);
+					const real_t d = inters.distance_to(p_point);
+					if (d < closest_point_d) {
+						closest_poly = &p;
+						closest_point_d = d;
+						if (r_point) {
+							*r_point = inters;
+						}
+						if (r_normal) {
+							*r_normal = f.get_plane().normal;
+						}
+					}
+				}
 			}
+			continue;
+		}
+
+		ERR_FAIL_COND_V(stack_size + 2 > 64, closest_poly);
+		const real_t left_d = aabb_distance_squared(polygon_bvh[node.left].aabb, p_point);
+		const real_t right_d = aabb_distance_squared(polygon_bvh[node.right].aabb, p_point);
+		if (left_d < right_d) {
+			stack[stack_size++] = node.right;
+			stack[stack_size++] = node.left;
+		} else {
+			stack[stack_size++] = node.left;
+			stack[stack_size++] = node.right;
 		}
 	}
 
-	return closest_point_owner;
+	return closest_poly;
 }
 
 void NavMap::add_region(NavRegion *p_region) {
@@ -603,7 +697,8 @@ void NavMap::sync() {
 	}
 
 	if (regenerate_links) {
-		// Copy all region polygons in the map.
+		// The regions keep their polygons, and the links between them, from
+		// their last change: only the links between the regions are redone.
 		int count = 0;
 		for (size_t r(0); r < regions.size(); r++) {
 			count += regions[r]->get_polygons().size();
@@ -612,79 +707,38 @@ void NavMap::sync() {
 		polygons.resize(count);
 		count = 0;
 
+		std::vector<gd::FreeEdge> free_edges;
 		for (size_t r(0); r < regions.size(); r++) {
-			std::copy(
-					regions[r]->get_polygons().data(),
-					regions[r]->get_polygons().data() + regions[r]->get_polygons().size(),
-					polygons.begin() + count);
-
-			count += regions[r]->get_polygons().size();
-		}
-
-		// Connects the `Edges` of all the `Polygons` of all `Regions` each other.
-		Map<gd::EdgeKey, gd::Connection> connections;
-
-		for (size_t poly_id(0); poly_id < polygons.size(); poly_id++) {
-			gd::Polygon &poly(polygons[poly_id]);
-
-			for (size_t p(0); p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
-
-				Map<gd::EdgeKey, gd::Connection>::Element *connection = connections.find(ek);
-				if (!connection) {
-					// Nothing yet
-					gd::Connection c;
-					c.A = &poly;
-					c.A_edge = p;
-					c.B = NULL;
-					c.B_edge = -1;
-					connections[ek] = c;
-
-				} else if (connection->get().B == NULL) {
-					CRASH_COND(connection->get().A == NULL); // Unreachable
-
-					// Connect the two Polygons by this edge
-					connection->get().B = &poly;
-					connection->get().B_edge = p;
-
-					connection->get().A->edges[connection->get().A_edge].this_edge = connection->get().A_edge;
-					connection->get().A->edges[connection->get().A_edge].other_polygon = connection->get().B;
-					connection->get().A->edges[connection->get().A_edge].other_edge = connection->get().B_edge;
+			std::vector<gd::Polygon> &region_polygons = regions[r]->get_polygons();
+			for (size_t p(0); p < region_polygons.size(); p++) {
+				polygons[count++] = &region_polygons[p];
+			}
 
-					connection->get().B->edges[connection->get().B_edge].this_edge = connection->get().B_edge;
-					connection->get().B->edges[connection->get().B_edge].other_polygon = connection->get().A;
-					connection->get().B->edges[connection->get().B_edge].other_edge = connection->get().A_edge;
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT("Attempted to merge a navigation mesh triangle edge with another already-merged edge. This happens when the Navigation3D's `cell_size` is different from the one used to generate the navigation mesh. This will cause navigation problem.");
-				}
+			const std::vector<gd::FreeEdge> &region_free_edges = regions[r]->get_free_edges();
+			for (size_t e(0); e < region_free_edges.size(); e++) {
+				// Drop the link made at the previous sync, the other region may be gone.
+				region_free_edges[e].poly->edges[region_free_edges[e].edge_id] = gd::Edge();
+				free_edges.push_back(region_free_edges[e]);
 			}
 		}
 
-		// Takes all the free edges.
-		std::vector<gd::FreeEdge> free_edges;
-		free_edges.reserve(connections.size());
-
-		for (auto connection_element = connections.front(); connection_element; connection_element = connection_element->next()) {
-			if (connection_element->get().B == NULL) {
-				CRASH_COND(connection_element->get().A == NULL); // Unreachable
-				CRASH_COND(connection_element->get().A_edge < 0); // Unreachable
-
-				// This is a free edge
-				uint32_t id(free_edges.size());
-				free_edges.push_back(gd::FreeEdge());
-				free_edges[id].is_free = true;
-				free_edges[id].poly = connection_element->get().A;
-				free_edges[id].edge_id = connection_element->get().A_edge;
-				uint32_t point_0(free_edges[id].edge_id);
-				uint32_t point_1((free_edges[id].edge_id + 1) % free_edges[id].poly->points.size());
-				Vector3 pos_0 = free_edges[id].poly->points[point_0].pos;
-				Vector3 pos_1 = free_edges[id].poly->points[point_1].pos;
-				Vector3 relative = pos_1 - pos_0;
-				free_edges[id].edge_center = (pos_0 + pos_1) / 2.0;
-				free_edges[id].edge_dir = relative.normalized();
-				free_edges[id].edge_len_squared = relative.length_squared();
+		// Connects the free `Edges` of the `Regions` sharing the same points.
+		Map<gd::EdgeKey, uint32_t> connections;
+
+		for (uint32_t i(0); i < free_edges.size(); i++) {
+			gd::FreeEdge &edge = free_edges[i];
+			const gd::EdgeKey ek(edge.poly->points[edge.edge_id].key, edge.poly->points[(edge.edge_id + 1) % edge.poly->points.size()].key);
+
+			Map<gd::EdgeKey, uint32_t>::Element *connection = connections.find(ek);
+			if (!connection) {
+				// Nothing yet
+				connections[ek] = i;
+			} else if (free_edges[connection->get()].is_free) {
+				// Connect the two Polygons by this edge
+				link_free_edges(free_edges[connection->get()], edge);
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT("Attempted to merge a navigation mesh triangle edge with another already-merged edge. This happens when the Navigation3D's `cell_size` is different from the one used to generate the navigation mesh. This will cause navigation problem.");
 			}
 		}
 
@@ -694,6 +748,19 @@ void NavMap::sync() {
 		// In front of tolerance
 #define IFO_TOLLERANCE 0.5
 
+		// Spatial hash of the remaining free edges, cells as big as the margin
+		// so only the edges in the neighbor cells can be close enough.
+		std::vector<std::pair<uint64_t, uint32_t>> edge_cells;
+		if (edge_connection_margin > CMP_EPSILON) {
+			edge_cells.reserve(free_edges.size());
+			for (uint32_t i(0); i < free_edges.size(); i++) {
+				if (free_edges[i].is_free) {
+					edge_cells.push_back(std::make_pair(get_edge_cell_key(free_edges[i].edge_center, 0, 0, 0), i));
+				}
+			}
+			std::sort(edge_cells.begin(), edge_cells.end());
+		}
+
 		// Find the compatible near edges.
 		//
 		// Note:
@@ -701,48 +768,57 @@ void NavMap::sync() {
 		// to be connected, create new polygons to remove that small gap is
 		// not really useful and would result in wasteful computation during
 		// connection, integration and path finding.
-		for (size_t i(0); i < free_edges.size(); i++) {
-			if (!free_edges[i].is_free) {
+		for (size_t c(0); c < edge_cells.size(); c++) {
+			gd::FreeEdge &edge = free_edges[edge_cells[c].second];
+			if (!edge.is_free) {
 				continue;
 			}
-			gd::FreeEdge &edge = free_edges[i];
-			for (size_t y(0); y < free_edges.size(); y++) {
-				gd::FreeEdge &other_edge = free_edges[y];
-				if (i == y || !other_edge.is_free || edge.poly->owner == other_edge.poly->owner) {
-					continue;
-				}
 
-				Vector3 rel_centers = other_edge.edge_center - edge.edge_center;
-				if (ecm_squared > rel_centers.length_squared() // Are enough closer?
-						&& ABS(edge.edge_len_squared - other_edge.edge_len_squared) < LEN_TOLLERANCE // Are the same length?
-						&& ABS(edge.edge_dir.dot(other_edge.edge_dir)) > DIR_TOLLERANCE // Are aligned?
-						&& ABS(rel_centers.normalized().dot(edge.edge_dir)) < IFO_TOLLERANCE // Are one in front the other?
-				) {
-					// The edges can be connected
-					edge.is_free = false;
-					other_edge.is_free = false;
-
-					edge.poly->edges[edge.edge_id].this_edge = edge.edge_id;
-					edge.poly->edges[edge.edge_id].other_edge = other_edge.edge_id;
-					edge.poly->edges[edge.edge_id].other_polygon = other_edge.poly;
-
-					other_edge.poly->edges[other_edge.edge_id].this_edge = other_edge.edge_id;
-					other_edge.poly->edges[other_edge.edge_id].other_edge = edge.edge_id;
-					other_edge.poly->edges[other_edge.edge_id].other_polygon = edge.poly;
+			for (int n(0); n < 27 && edge.is_free; n++) {
+				const uint64_t cell_key = get_edge_cell_key(edge.edge_center, n % 3 - 1, (n / 3) % 3 - 1, n / 9 - 1);
+				auto it = std::lower_bound(edge_cells.begin(), edge_cells.end(), std::make_pair(cell_key, uint32_t(0)));
+				for (; it != edge_cells.end() && it->first == cell_key; ++it) {
+					gd::FreeEdge &other_edge = free_edges[it->second];
+					if (&other_edge == &edge || !other_edge.is_free || edge.poly->owner == other_edge.poly->owner) {
+						continue;
+					}
+
+					Vector3 rel_centers = other_edge.edge_center - edge.edge_center;
+					if (ecm_squared > rel_centers.length_squared() // Are enough closer?
+							&& ABS(edge.edge_len_squared - other_edge.edge_len_squared) < LEN_TOLLERANCE // Are the same length?
+							&& ABS(edge.edge_dir.dot(other_edge.edge_dir)) > DIR_TOLLERANCE // Are aligned?
+							&& ABS(rel_centers.normalized().dot(edge.edge_dir)) < IFO_TOLLERANCE // Are one in front the other?
+					) {
+						// The edges can be connected
+						link_free_edges(edge, other_edge);
+						break;
+					}
 				}
 			}
 		}
 	}
 
 	if (regenerate_links) {
+		build_polygon_bvh();
+		build_path_clusters();
+
+		// The cached routes point to the old polygons.
+		MutexLock lock(path_cache_mutex);
+		path_cache.clear();
+
 		map_update_id = map_update_id + 1 % 9999999;
 	}
 
 	if (agents_dirty) {
-		std::vector<RVO::Agent *> raw_agents;
+		raw_agents.clear();
 		raw_agents.reserve(agents.size());
 		for (size_t i(0); i < agents.size(); i++)
 			raw_agents.push_back(agents[i]->get_agent());
+	}
+
+	// The agents move every frame, a tree built only when they are added or
+	// removed would return the neighbors of their old positions.
+	if (agents_dirty || controlled_agents.size() > 0) {
 		rvo.buildAgentTree(raw_agents);
 	}
 
@@ -751,6 +827,213 @@ void NavMap::sync() {
 	agents_dirty = false;
 }
 
+uint64_t NavMap::get_edge_cell_key(const Vector3 &p_pos, int p_offset_x, int p_offset_y, int p_offset_z) const {
+	gd::PointKey p;
+	p.key = 0;
+	p.x = int(Math::floor(p_pos.x / edge_connection_margin)) + p_offset_x;
+	p.y = int(Math::floor(p_pos.y / edge_connection_margin)) + p_offset_y;
+	p.z = int(Math::floor(p_pos.z / edge_connection_margin)) + p_offset_z;
+	return p.key;
+}
+
+void NavMap::link_free_edges(gd::FreeEdge &p_edge, gd::FreeEdge &p_other_edge) {
+	p_edge.is_free = false;
+	p_other_edge.is_free = false;
+
+	p_edge.poly->edges[p_edge.edge_id].this_edge = p_edge.edge_id;
+	p_edge.poly->edges[p_edge.edge_id].other_edge = p_other_edge.edge_id;
+	p_edge.poly->edges[p_edge.edge_id].other_polygon = p_other_edge.poly;
+
+	p_other_edge.poly->edges[p_other_edge.edge_id].this_edge = p_other_edge.edge_id;
+	p_other_edge.poly->edges[p_other_edge.edge_id].other_edge = p_edge.edge_id;
+	p_other_edge.poly->edges[p_other_edge.edge_id].other_polygon = p_edge.poly;
+}
+
+void NavMap::build_polygon_bvh() {
+
+	polygon_bvh.clear();
+	polygon_bvh_indices.resize(polygons.size());
+	if (polygons.empty()) {
+		return;
+	}
+
+	std::vector<AABB> aabbs(polygons.size());
+	std::vector<Vector3> centers(polygons.size());
+	for (size_t i(0); i < polygons.size(); i++) {
+		const gd::Polygon &p = *polygons[i];
+		AABB aabb;
+		for (size_t point_id = 0; point_id < p.points.size(); point_id++) {
+			if (point_id == 0) {
+				aabb.position = p.points[0].pos;
+			} else {
+				aabb.expand_to(p.points[point_id].pos);
+			}
+		}
+		aabbs[i] = aabb;
+		centers[i] = aabb.position + aabb.size * 0.5;
+		polygon_bvh_indices[i] = i;
+	}
+
+	polygon_bvh.reserve(polygons.size() / 2 + 1);
+	build_polygon_bvh_node(aabbs, centers, 0, polygons.size());
+}
+
+int NavMap::build_polygon_bvh_node(const std::vector<AABB> &p_aabbs, const std::vector<Vector3> &p_centers, int p_begin, int p_count) {
+
+	const int node_id = polygon_bvh.size();
+	polygon_bvh.push_back(PolygonBVHNode());
+
+	AABB aabb = p_aabbs[polygon_bvh_indices[p_begin]];
+	AABB centers_aabb(p_centers[polygon_bvh_indices[p_begin]], Vector3());
+	for (int i = p_begin + 1; i < p_begin + p_count; i++) {
+		aabb.merge_with(p_aabbs[polygon_bvh_indices[i]]);
+		centers_aabb.expand_to(p_centers[polygon_bvh_indices[i]]);
+	}
+	polygon_bvh[node_id].aabb = aabb;
+
+	if (p_count <= 4) {
+		polygon_bvh[node_id].begin = p_begin;
+		polygon_bvh[node_id].count = p_count;
+		return node_id;
+	}
+
+	// Median split along the longest axis of the centers, keeps the tree balanced.
+	const int axis = centers_aabb.get_longest_axis_index();
+	const int half = p_count / 2;
+	std::nth_element(
+			polygon_bvh_indices.begin() + p_begin,
+			polygon_bvh_indices.begin() + p_begin + half,
+			polygon_bvh_indices.begin() + p_begin + p_count,
+			[&p_centers, axis](uint32_t a, uint32_t b) { return p_centers[a][axis] < p_centers[b][axis]; });
+
+	const int left = build_polygon_bvh_node(p_aabbs, p_centers, p_begin, half);
+	const int right = build_polygon_bvh_node(p_aabbs, p_centers, p_begin + half, p_count - half);
+	polygon_bvh[node_id].left = left;
+	polygon_bvh[node_id].right = right;
+	return node_id;
+}
+
+void NavMap::build_path_clusters() {
+	path_clusters.clear();
+
+	const uint32_t unassigned = UINT32_MAX;
+	for (size_t i(0); i < polygons.size(); i++) {
+		polygons[i]->cluster = unassigned;
+	}
+
+	// Flood the links from each polygon not yet in a cluster, so the polygons
+	// of a cluster are always connected.
+	std::vector<gd::Polygon *> stack;
+	for (size_t i(0); i < polygons.size(); i++) {
+		if (polygons[i]->cluster != unassigned) {
+			continue;
+		}
+
+		const uint32_t cluster_id = path_clusters.size();
+		path_clusters.push_back(PathCluster());
+
+		uint32_t count(0);
+		Vector3 center;
+
+		stack.clear();
+		stack.push_back(polygons[i]);
+		polygons[i]->cluster = cluster_id;
+
+		size_t next(0);
+		while (next < stack.size()) {
+			gd::Polygon *poly = stack[next++];
+			center += poly->center;
+			count++;
+
+			for (size_t e(0); e < poly->edges.size() && stack.size() < PATH_CLUSTER_MAX_POLYGONS; e++) {
+				gd::Polygon *other = poly->edges[e].other_polygon;
+				if (other && other->cluster == unassigned) {
+					other->cluster = cluster_id;
+					stack.push_back(other);
+				}
+			}
+		}
+
+		path_clusters[cluster_id].center = center / count;
+	}
+
+	for (size_t i(0); i < polygons.size(); i++) {
+		const gd::Polygon *poly = polygons[i];
+		for (size_t e(0); e < poly->edges.size(); e++) {
+			const gd::Polygon *other = poly->edges[e].other_polygon;
+			if (!other || other->cluster == poly->cluster) {
+				continue;
+			}
+
+			std::vector<uint32_t> &neighbors = path_clusters[poly->cluster].neighbors;
+			if (std::find(neighbors.begin(), neighbors.end(), other->cluster) == neighbors.end()) {
+				neighbors.push_back(other->cluster);
+			}
+		}
+	}
+}
+
+bool NavMap::find_cluster_corridor(uint32_t p_begin_cluster, uint32_t p_end_cluster, std::vector<uint8_t> &r_corridor) const {
+	struct ClusterNode {
+		float traveled_distance;
+		int prev;
+		bool closed;
+	};
+
+	std::vector<ClusterNode> nodes(path_clusters.size(), { 1e30, -1, false });
+	std::vector<std::pair<float, uint32_t>> open_heap;
+
+	const Vector3 &end_center = path_clusters[p_end_cluster].center;
+
+	nodes[p_begin_cluster].traveled_distance = 0;
+	open_heap.push_back(std::make_pair(-path_clusters[p_begin_cluster].center.distance_to(end_center), p_begin_cluster));
+
+	bool found = false;
+	while (open_heap.size() > 0) {
+		std::pop_heap(open_heap.begin(), open_heap.end());
+		const uint32_t id = open_heap.back().second;
+		open_heap.pop_back();
+
+		if (nodes[id].closed) {
+			continue;
+		}
+		nodes[id].closed = true;
+
+		if (id == p_end_cluster) {
+			found = true;
+			break;
+		}
+
+		const PathCluster &cluster = path_clusters[id];
+		for (size_t n(0); n < cluster.neighbors.size(); n++) {
+			const uint32_t other = cluster.neighbors[n];
+			const float distance = nodes[id].traveled_distance + cluster.center.distance_to(path_clusters[other].center);
+			if (!nodes[other].closed && distance < nodes[other].traveled_distance) {
+				nodes[other].traveled_distance = distance;
+				nodes[other].prev = id;
+				open_heap.push_back(std::make_pair(-(distance + path_clusters[other].center.distance_to(end_center)), other));
+				std::push_heap(open_heap.begin(), open_heap.end());
+			}
+		}
+	}
+
+	if (!found) {
+		return false;
+	}
+
+	// The clusters along the way and their neighbors, the route between the
+	// cluster centers is only an approximation of the one between the polygons.
+	r_corridor.assign(path_clusters.size(), 0);
+	for (int id = p_end_cluster; id != -1; id = nodes[id].prev) {
+		r_corridor[id] = 1;
+		const std::vector<uint32_t> &neighbors = path_clusters[id].neighbors;
+		for (size_t n(0); n < neighbors.size(); n++) {
+			r_corridor[neighbors[n]] = 1;
+		}
+	}
+	return true;
+}
+
 void NavMap::compute_single_step(uint32_t index, RvoAgent **agent) {
 	(*(agent + index))->get_agent()->computeNeighbors(&rvo);
 	(*(agent + index))->get_agent()->computeNewVelocity(deltatime);
@@ -759,7 +1042,7 @@ void NavMap::compute_single_step(uint32_t index, RvoAgent **agent) {
 void NavMap::step(real_t p_deltatime) {
 	deltatime = p_deltatime;
 	if (controlled_agents.size() > 0) {
-		thread_process_array(
+		ThreadWorkPool::get_singleton()->do_work(
 				controlled_agents.size(),
 				this,
 				&NavMap::compute_single_step,
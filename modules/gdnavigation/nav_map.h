@@ -33,7 +33,9 @@
 
 #include "nav_rid.h"
 
+#include "core/math/aabb.h"
 #include "core/math/math_defs.h"
+#include "core/os/mutex.h"
 #include "nav_utils.h"
 #include <KdTree.h>
 
@@ -62,12 +64,52 @@ class NavMap : public NavRid {
 
 	std::vector<NavRegion *> regions;
 
-	/// Map polygons
-	std::vector<gd::Polygon> polygons;
+	/// Map polygons, owned by the regions.
+	std::vector<gd::Polygon *> polygons;
+
+	/// Bounding volume hierarchy over the `polygons`, rebuilt with the links,
+	/// so the closest polygon queries don't have to test all of them.
+	struct PolygonBVHNode {
+		AABB aabb;
+		/// Children of inner nodes, -1 on leaves.
+		int left = -1;
+		int right = -1;
+		/// Leaves: range in `polygon_bvh_indices`.
+		int begin = 0;
+		int count = 0;
+	};
+	std::vector<PolygonBVHNode> polygon_bvh;
+	std::vector<uint32_t> polygon_bvh_indices;
+
+	/// Connected groups of polygons, built with the links. Long path queries
+	/// first search a corridor of clusters, then only the polygons in it.
+	struct PathCluster {
+		Vector3 center;
+		std::vector<uint32_t> neighbors;
+	};
+	std::vector<PathCluster> path_clusters;
+	bool use_hierarchical_paths;
+
+	/// The polygon route of the recent queries, by their begin and end polygon.
+	struct PathCacheEntry {
+		const gd::Polygon *begin_poly;
+		const gd::Polygon *end_poly;
+		/// False when `end_poly` wasn't reachable and the route goes to the closest polygon.
+		bool reachable;
+		std::vector<gd::NavigationPoly> navigation_polys;
+		uint64_t last_used;
+	};
+	mutable std::vector<PathCacheEntry> path_cache;
+	mutable uint64_t path_cache_tick;
+	mutable Mutex path_cache_mutex;
+	uint32_t path_cache_size;
 
 	/// Rvo world
 	RVO::KdTree rvo;
 
+	/// The agents as given to the `rvo` tree, kept between the frames.
+	std::vector<RVO::Agent *> raw_agents;
+
 	/// Is agent array modified?
 	bool agents_dirty;
 
@@ -125,6 +167,18 @@ public:
 	void set_agent_as_controlled(RvoAgent *agent);
 	void remove_agent_as_controlled(RvoAgent *agent);
 
+	void set_use_hierarchical_paths(bool p_enabled) {
+		use_hierarchical_paths = p_enabled;
+	}
+	bool get_use_hierarchical_paths() const {
+		return use_hierarchical_paths;
+	}
+
+	void set_path_cache_size(uint32_t p_size);
+	uint32_t get_path_cache_size() const {
+		return path_cache_size;
+	}
+
 	uint32_t get_map_update_id() const {
 		return map_update_id;
 	}
@@ -135,6 +189,14 @@ public:
 
 private:
 	void compute_single_step(uint32_t index, RvoAgent **agent);
+	uint64_t get_edge_cell_key(const Vector3 &p_pos, int p_offset_x, int p_offset_y, int p_offset_z) const;
+	static void link_free_edges(gd::FreeEdge &p_edge, gd::FreeEdge &p_other_edge);
+	void build_polygon_bvh();
+	int build_polygon_bvh_node(const std::vector<AABB> &p_aabbs, const std::vector<Vector3> &p_centers, int p_begin, int p_count);
+	void build_path_clusters();
+	bool find_cluster_corridor(uint32_t p_begin_cluster, uint32_t p_end_cluster, std::vector<uint8_t> &r_corridor) const;
+	bool find_polygon_route(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *&r_end_poly, Vector3 &r_end_point, const Vector3 &p_destination, const std::vector<uint8_t> *p_corridor, std::vector<gd::NavigationPoly> &r_navigation_polys, int &r_least_cost_id, bool &r_reachable) const;
+	const gd::Polygon *get_closest_polygon(const Vector3 &p_point, Vector3 *r_point = NULL, Vector3 *r_normal = NULL) const;
 	void clip_path(const std::vector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly) const;
 };
 
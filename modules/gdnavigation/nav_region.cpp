@@ -69,6 +69,7 @@ void NavRegion::update_polygons() {
 		return;
 	}
 	polygons.clear();
+	free_edges.clear();
 	polygons_dirty = false;
 
 	if (map == NULL) {
@@ -133,4 +134,74 @@ void NavRegion::update_polygons() {
 			p.center = center / float(mesh_poly.size());
 		}
 	}
+
+	update_links();
+}
+
+void NavRegion::update_links() {
+	// Connects the `Edges` of the `Polygons` of this region each other.
+	Map<gd::EdgeKey, gd::Connection> connections;
+
+	for (size_t poly_id(0); poly_id < polygons.size(); poly_id++) {
+		gd::Polygon &poly(polygons[poly_id]);
+
+		for (size_t p(0); p < poly.points.size(); p++) {
+			int next_point = (p + 1) % poly.points.size();
+			gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			Map<gd::EdgeKey, gd::Connection>::Element *connection = connections.find(ek);
+			if (!connection) {
+				// Nothing yet
+				gd::Connection c;
+				c.A = &poly;
+				c.A_edge = p;
+				c.B = NULL;
+				c.B_edge = -1;
+				connections[ek] = c;
+
+			} else if (connection->get().B == NULL) {
+				CRASH_COND(connection->get().A == NULL); // Unreachable
+
+				// Connect the two Polygons by this edge
+				connection->get().B = &poly;
+				connection->get().B_edge = p;
+
+				connection->get().A->edges[connection->get().A_edge].this_edge = connection->get().A_edge;
+				connection->get().A->edges[connection->get().A_edge].other_polygon = connection->get().B;
+				connection->get().A->edges[connection->get().A_edge].other_edge = connection->get().B_edge;
+
+				connection->get().B->edges[connection->get().B_edge].this_edge = connection->get().B_edge;
+				connection->get().B->edges[connection->get().B_edge].other_polygon = connection->get().A;
+				connection->get().B->edges[connection->get().B_edge].other_edge = connection->get().A_edge;
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT("Attempted to merge a navigation mesh triangle edge with another already-merged edge. This happens when the Navigation3D's `cell_size` is different from the one used to generate the navigation mesh. This will cause navigation problem.");
+			}
+		}
+	}
+
+	// Takes all the free edges.
+	free_edges.reserve(connections.size());
+
+	for (auto connection_element = connections.front(); connection_element; connection_element = connection_element->next()) {
+		if (connection_element->get().B == NULL) {
+			CRASH_COND(connection_element->get().A == NULL); // Unreachable
+			CRASH_COND(connection_element->get().A_edge < 0); // Unreachable
+
+			// This is a free edge
+			uint32_t id(free_edges.size());
+			free_edges.push_back(gd::FreeEdge());
+			free_edges[id].is_free = true;
+			free_edges[id].poly = connection_element->get().A;
+			free_edges[id].edge_id = connection_element->get().A_edge;
+			uint32_t point_0(free_edges[id].edge_id);
+			uint32_t point_1((free_edges[id].edge_id + 1) % free_edges[id].poly->points.size());
+			Vector3 pos_0 = free_edges[id].poly->points[point_0].pos;
+			Vector3 pos_1 = free_edges[id].poly->points[point_1].pos;
+			Vector3 relative = pos_1 - pos_0;
+			free_edges[id].edge_center = (pos_0 + pos_1) / 2.0;
+			free_edges[id].edge_dir = relative.normalized();
+			free_edges[id].edge_len_squared = relative.length_squared();
+		}
+	}
 }
@@ -54,6 +54,10 @@ class NavRegion : public NavRid {
 	/// Cache
 	std::vector<gd::Polygon> polygons;
 
+	/// The edges not shared by two polygons of this region, the map links
+	/// them with the other regions.
+	std::vector<gd::FreeEdge> free_edges;
+
 public:
 	NavRegion();
 
@@ -80,10 +84,19 @@ public:
 		return polygons;
 	}
 
+	std::vector<gd::Polygon> &get_polygons() {
+		return polygons;
+	}
+
+	std::vector<gd::FreeEdge> const &get_free_edges() const {
+		return free_edges;
+	}
+
 	bool sync();
 
 private:
 	void update_polygons();
+	void update_links();
 };
 
 #endif // NAV_REGION_H
@@ -109,6 +109,9 @@ struct Polygon {
 
 	/// The center of this `Polygon`
 	Vector3 center;
+
+	/// The cluster of the map this `Polygon` is in, set when the map links it.
+	uint32_t cluster;
 };
 
 struct Connection {
@@ -34,6 +34,7 @@
 
 #include "core/math/quick_hull.h"
 #include "core/os/thread.h"
+#include "core/thread_work_pool.h"
 #include "scene/3d/collision_shape_3d.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/physics_body_3d.h"
@@ -277,15 +278,31 @@ void NavigationMeshGenerator::_parse_geometry(Transform p_accumulated_transform,
 	}
 }
 
-void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh) {
+void NavigationMeshGenerator::_parse_source_geometry(Ref<NavigationMesh> p_nav_mesh, Node *p_node, Vector<float> &p_verticies, Vector<int> &p_indices) {
 
-	Vector<Vector3> nav_vertices;
+	List<Node *> parse_nodes;
+
+	if (p_nav_mesh->get_source_geometry_mode() == NavigationMesh::SOURCE_GEOMETRY_NAVMESH_CHILDREN) {
+		parse_nodes.push_back(p_node);
+	} else {
+		p_node->get_tree()->get_nodes_in_group(p_nav_mesh->get_source_group_name(), &parse_nodes);
+	}
+
+	Transform navmesh_xform = Object::cast_to<Node3D>(p_node)->get_transform().affine_inverse();
+	for (const List<Node *>::Element *E = parse_nodes.front(); E; E = E->next()) {
+		int geometry_type = p_nav_mesh->get_parsed_geometry_type();
+		uint32_t collision_mask = p_nav_mesh->get_collision_mask();
+		bool recurse_children = p_nav_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
+		_parse_geometry(navmesh_xform, E->get(), p_verticies, p_indices, geometry_type, collision_mask, recurse_children);
+	}
+}
+
+void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
 
 	for (int i = 0; i < p_detail_mesh->nverts; i++) {
 		const float *v = &p_detail_mesh->verts[i * 3];
-		nav_vertices.push_back(Vector3(v[0], v[1], v[2]));
+		r_vertices.push_back(Vector3(v[0], v[1], v[2]));
 	}
-	p_nav_mesh->set_vertices(nav_vertices);
 
 	for (int i = 0; i < p_detail_mesh->nmeshes; i++) {
 		const unsigned int *m = &p_detail_mesh->meshes[i * 4];
@@ -300,7 +317,7 @@ void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(con
 			nav_indices.write[0] = ((int)(bverts + tris[j * 4 + 0]));
 			nav_indices.write[1] = ((int)(bverts + tris[j * 4 + 2]));
 			nav_indices.write[2] = ((int)(bverts + tris[j * 4 + 1]));
-			p_nav_mesh->add_polygon(nav_indices);
+			r_polygons.push_back(nav_indices);
 		}
 	}
 }
@@ -316,7 +333,10 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
 		rcPolyMesh *poly_mesh,
 		rcPolyMeshDetail *detail_mesh,
 		Vector<float> &vertices,
-		Vector<int> &indices) {
+		Vector<int> &indices,
+		const AABB &p_tile_bounds,
+		Vector<Vector3> &r_vertices,
+		Vector<Vector<int>> &r_polygons) {
 	rcContext ctx;
 
 #ifdef TOOLS_ENABLED
@@ -356,6 +376,19 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
 	cfg.bmax[1] = bmax[1];
 	cfg.bmax[2] = bmax[2];
 
+	if (!p_tile_bounds.has_no_surface()) {
+		// Rasterize a border around the tile so polygons meet their neighbours at the
+		// tile edges, Recast removes the border again when building the regions.
+		cfg.borderSize = cfg.walkableRadius + 3;
+		const float border = cfg.borderSize * cfg.cs;
+		const Vector3 tile_end = p_tile_bounds.position + p_tile_bounds.size;
+
+		cfg.bmin[0] = p_tile_bounds.position.x - border;
+		cfg.bmin[2] = p_tile_bounds.position.z - border;
+		cfg.bmax[0] = tile_end.x + border;
+		cfg.bmax[2] = tile_end.z + border;
+	}
+
 #ifdef TOOLS_ENABLED
 	if (ep)
 		ep->step(TTR("Calculating grid size..."), 2);
@@ -421,11 +454,11 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
 
 	if (p_nav_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
 		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, 0, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
 	} else if (p_nav_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, 0, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
 	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, 0, cfg.minRegionArea));
+		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea));
 	}
 
 #ifdef TOOLS_ENABLED
@@ -461,7 +494,7 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
 		ep->step(TTR("Converting to native navigation mesh..."), 10);
 #endif
 
-	_convert_detail_mesh_to_native_navigation_mesh(detail_mesh, p_nav_mesh);
+	_convert_detail_mesh_to_native_navigation_mesh(detail_mesh, r_vertices, r_polygons);
 
 	rcFreePolyMesh(poly_mesh);
 	poly_mesh = 0;
@@ -497,21 +530,7 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 	Vector<float> vertices;
 	Vector<int> indices;
 
-	List<Node *> parse_nodes;
-
-	if (p_nav_mesh->get_source_geometry_mode() == NavigationMesh::SOURCE_GEOMETRY_NAVMESH_CHILDREN) {
-		parse_nodes.push_back(p_node);
-	} else {
-		p_node->get_tree()->get_nodes_in_group(p_nav_mesh->get_source_group_name(), &parse_nodes);
-	}
-
-	Transform navmesh_xform = Object::cast_to<Node3D>(p_node)->get_transform().affine_inverse();
-	for (const List<Node *>::Element *E = parse_nodes.front(); E; E = E->next()) {
-		int geometry_type = p_nav_mesh->get_parsed_geometry_type();
-		uint32_t collision_mask = p_nav_mesh->get_collision_mask();
-		bool recurse_children = p_nav_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
-		_parse_geometry(navmesh_xform, E->get(), vertices, indices, geometry_type, collision_mask, recurse_children);
-	}
+	_parse_source_geometry(p_nav_mesh, p_node, vertices, indices);
 
 	if (vertices.size() > 0 && indices.size() > 0) {
 
@@ -521,6 +540,9 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 		rcPolyMesh *poly_mesh = NULL;
 		rcPolyMeshDetail *detail_mesh = NULL;
 
+		Vector<Vector3> nav_vertices;
+		Vector<Vector<int>> nav_polygons;
+
 		_build_recast_navigation_mesh(
 				p_nav_mesh,
 #ifdef TOOLS_ENABLED
@@ -532,7 +554,15 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 				poly_mesh,
 				detail_mesh,
 				vertices,
-				indices);
+				indices,
+				AABB(),
+				nav_vertices,
+				nav_polygons);
+
+		p_nav_mesh->set_vertices(nav_vertices);
+		for (int i = 0; i < nav_polygons.size(); i++) {
+			p_nav_mesh->add_polygon(nav_polygons[i]);
+		}
 
 		rcFreeHeightField(hf);
 		hf = 0;
@@ -559,6 +589,193 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 #endif
 }
 
+void NavigationMeshGenerator::_bake_tile(uint32_t p_index, BakeTilesData *p_data) {
+
+	BakeTile &tile = p_data->tiles.write[p_index];
+
+	// Only rasterize the triangles touching the tile or its border.
+	const float border = (Math::ceil(p_data->nav_mesh->get_agent_radius() / p_data->nav_mesh->get_cell_size()) + 3) * p_data->nav_mesh->get_cell_size();
+	const float from_x = tile.bounds.position.x - border;
+	const float from_z = tile.bounds.position.z - border;
+	const float to_x = tile.bounds.position.x + tile.bounds.size.x + border;
+	const float to_z = tile.bounds.position.z + tile.bounds.size.z + border;
+
+	const float *verts = p_data->vertices->ptr();
+	const int *tris = p_data->indices->ptr();
+	const int ntris = p_data->indices->size() / 3;
+
+	Vector<int> tile_indices;
+	for (int i = 0; i < ntris; i++) {
+		const float *a = &verts[tris[i * 3 + 0] * 3];
+		const float *b = &verts[tris[i * 3 + 1] * 3];
+		const float *c = &verts[tris[i * 3 + 2] * 3];
+
+		if (MAX(a[0], MAX(b[0], c[0])) < from_x || MIN(a[0], MIN(b[0], c[0])) > to_x ||
+				MAX(a[2], MAX(b[2], c[2])) < from_z || MIN(a[2], MIN(b[2], c[2])) > to_z) {
+			continue;
+		}
+
+		tile_indices.push_back(tris[i * 3 + 0]);
+		tile_indices.push_back(tris[i * 3 + 1]);
+		tile_indices.push_back(tris[i * 3 + 2]);
+	}
+
+	if (tile_indices.size() == 0) {
+		return;
+	}
+
+	Vector<float> tile_vertices = *p_data->vertices;
+
+	rcHeightfield *hf = NULL;
+	rcCompactHeightfield *chf = NULL;
+	rcContourSet *cset = NULL;
+	rcPolyMesh *poly_mesh = NULL;
+	rcPolyMeshDetail *detail_mesh = NULL;
+
+	_build_recast_navigation_mesh(
+			p_data->nav_mesh,
+#ifdef TOOLS_ENABLED
+			NULL,
+#endif
+			hf,
+			chf,
+			cset,
+			poly_mesh,
+			detail_mesh,
+			tile_vertices,
+			tile_indices,
+			tile.bounds,
+			tile.vertices,
+			tile.polygons);
+}
+
+void NavigationMeshGenerator::bake_tiles(Ref<NavigationMesh> p_nav_mesh, Node *p_node, float p_tile_size, const AABB &p_changed_aabb) {
+
+	ERR_FAIL_COND(!p_nav_mesh.is_valid());
+	ERR_FAIL_COND(p_node == NULL);
+
+	// Keep tiles aligned to the cell grid, so neighbouring tiles share their edge vertices.
+	const float cell_size = p_nav_mesh->get_cell_size();
+	ERR_FAIL_COND_MSG(cell_size <= 0, "The cell size of the navigation mesh must be greater than zero.");
+	const float tile_size = MAX(1.0f, Math::round(p_tile_size / cell_size)) * cell_size;
+
+	Vector<float> vertices;
+	Vector<int> indices;
+
+	_parse_source_geometry(p_nav_mesh, p_node, vertices, indices);
+
+	const bool full_bake = p_changed_aabb.has_no_surface();
+
+	AABB bounds;
+	for (int i = 0; i < vertices.size() / 3; i++) {
+		Vector3 v(vertices[i * 3 + 0], vertices[i * 3 + 1], vertices[i * 3 + 2]);
+		if (i == 0) {
+			bounds.position = v;
+		} else {
+			bounds.expand_to(v);
+		}
+	}
+
+	Vector2i from;
+	Vector2i to;
+	if (full_bake) {
+		from = Vector2i(Math::floor(bounds.position.x / tile_size), Math::floor(bounds.position.z / tile_size));
+		to = Vector2i(Math::floor((bounds.position.x + bounds.size.x) / tile_size), Math::floor((bounds.position.z + bounds.size.z) / tile_size));
+	} else {
+		from = Vector2i(Math::floor(p_changed_aabb.position.x / tile_size), Math::floor(p_changed_aabb.position.z / tile_size));
+		to = Vector2i(Math::floor((p_changed_aabb.position.x + p_changed_aabb.size.x) / tile_size), Math::floor((p_changed_aabb.position.z + p_changed_aabb.size.z) / tile_size));
+	}
+
+	BakeTilesData data;
+	data.nav_mesh = p_nav_mesh;
+	data.vertices = &vertices;
+	data.indices = &indices;
+
+	if (vertices.size() > 0 && indices.size() > 0) {
+		for (int y = from.y; y <= to.y; y++) {
+			for (int x = from.x; x <= to.x; x++) {
+				BakeTile tile;
+				tile.bounds = AABB(Vector3(x * tile_size, bounds.position.y, y * tile_size), Vector3(tile_size, bounds.size.y, tile_size));
+				data.tiles.push_back(tile);
+			}
+		}
+	}
+
+	if (data.tiles.size() > 0) {
+		ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+		pool->wait_for_task(pool->add_group_task(data.tiles.size(), this, &NavigationMeshGenerator::_bake_tile, &data, 1));
+	}
+
+	// Keep the polygons of the tiles that were not rebaked, and drop the
+	// vertices that are no longer used by any of them.
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+
+	if (!full_bake) {
+		Vector<Vector3> old_vertices = p_nav_mesh->get_vertices();
+		Vector<int> remap;
+		remap.resize(old_vertices.size());
+		for (int i = 0; i < remap.size(); i++) {
+			remap.write[i] = -1;
+		}
+
+		for (int i = 0; i < p_nav_mesh->get_polygon_count(); i++) {
+			Vector<int> polygon = p_nav_mesh->get_polygon(i);
+			if (polygon.size() == 0) {
+				continue;
+			}
+
+			Vector3 center;
+			bool valid = true;
+			for (int j = 0; j < polygon.size(); j++) {
+				if (polygon[j] < 0 || polygon[j] >= old_vertices.size()) {
+					valid = false;
+					break;
+				}
+				center += old_vertices[polygon[j]];
+			}
+			if (!valid) {
+				continue;
+			}
+			center /= polygon.size();
+
+			Vector2i tile(Math::floor(center.x / tile_size), Math::floor(center.z / tile_size));
+			if (tile.x >= from.x && tile.x <= to.x && tile.y >= from.y && tile.y <= to.y) {
+				continue;
+			}
+
+			for (int j = 0; j < polygon.size(); j++) {
+				if (remap[polygon[j]] == -1) {
+					remap.write[polygon[j]] = nav_vertices.size();
+					nav_vertices.push_back(old_vertices[polygon[j]]);
+				}
+				polygon.write[j] = remap[polygon[j]];
+			}
+			nav_polygons.push_back(polygon);
+		}
+	}
+
+	for (int i = 0; i < data.tiles.size(); i++) {
+		const BakeTile &tile = data.tiles[i];
+		const int offset = nav_vertices.size();
+
+		nav_vertices.append_array(tile.vertices);
+		for (int j = 0; j < tile.polygons.size(); j++) {
+			Vector<int> polygon = tile.polygons[j];
+			for (int k = 0; k < polygon.size(); k++) {
+				polygon.write[k] += offset;
+			}
+			nav_polygons.push_back(polygon);
+		}
+	}
+
+	p_nav_mesh->clear_polygons();
+	p_nav_mesh->set_vertices(nav_vertices);
+	for (int i = 0; i < nav_polygons.size(); i++) {
+		p_nav_mesh->add_polygon(nav_polygons[i]);
+	}
+}
+
 void NavigationMeshGenerator::clear(Ref<NavigationMesh> p_nav_mesh) {
 	if (p_nav_mesh.is_valid()) {
 		p_nav_mesh->clear_polygons();
@@ -568,6 +785,7 @@ void NavigationMeshGenerator::clear(Ref<NavigationMesh> p_nav_mesh) {
 
 void NavigationMeshGenerator::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("bake", "nav_mesh", "root_node"), &NavigationMeshGenerator::bake);
+	ClassDB::bind_method(D_METHOD("bake_tiles", "nav_mesh", "root_node", "tile_size", "changed_aabb"), &NavigationMeshGenerator::bake_tiles, DEFVAL(AABB()));
 	ClassDB::bind_method(D_METHOD("clear", "nav_mesh"), &NavigationMeshGenerator::clear);
 }
 
@@ -46,15 +46,31 @@ class NavigationMeshGenerator : public Object {
 
 	static NavigationMeshGenerator *singleton;
 
+	struct BakeTile {
+		AABB bounds; // Without the border, which is added when baking.
+		Vector<Vector3> vertices;
+		Vector<Vector<int>> polygons;
+	};
+
+	struct BakeTilesData {
+		Ref<NavigationMesh> nav_mesh;
+		const Vector<float> *vertices;
+		const Vector<int> *indices;
+		Vector<BakeTile> tiles;
+	};
+
+	void _bake_tile(uint32_t p_index, BakeTilesData *p_data);
+
 protected:
 	static void _bind_methods();
 
 	static void _add_vertex(const Vector3 &p_vec3, Vector<float> &p_verticies);
 	static void _add_mesh(const Ref<Mesh> &p_mesh, const Transform &p_xform, Vector<float> &p_verticies, Vector<int> &p_indices);
 	static void _add_faces(const PackedVector3Array &p_faces, const Transform &p_xform, Vector<float> &p_verticies, Vector<int> &p_indices);
+	static void _parse_source_geometry(Ref<NavigationMesh> p_nav_mesh, Node *p_node, Vector<float> &p_verticies, Vector<int> &p_indices);
 	static void _parse_geometry(Transform p_accumulated_transform, Node *p_node, Vector<float> &p_verticies, Vector<int> &p_indices, int p_generate_from, uint32_t p_collision_mask, bool p_recurse_children);
 
-	static void _convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh);
+	static void _convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
 	static void _build_recast_navigation_mesh(
 			Ref<NavigationMesh> p_nav_mesh,
 #ifdef TOOLS_ENABLED
@@ -66,7 +82,10 @@ protected:
 			rcPolyMesh *poly_mesh,
 			rcPolyMeshDetail *detail_mesh,
 			Vector<float> &vertices,
-			Vector<int> &indices);
+			Vector<int> &indices,
+			const AABB &p_tile_bounds,
+			Vector<Vector3> &r_vertices,
+			Vector<Vector<int>> &r_polygons);
 
 public:
 	static NavigationMeshGenerator *get_singleton();
@@ -75,6 +94,7 @@ public:
 	~NavigationMeshGenerator();
 
 	void bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node);
+	void bake_tiles(Ref<NavigationMesh> p_nav_mesh, Node *p_node, float p_tile_size, const AABB &p_changed_aabb = AABB());
 	void clear(Ref<NavigationMesh> p_nav_mesh);
 };
 
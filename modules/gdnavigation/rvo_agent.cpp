@@ -72,6 +72,7 @@ void RvoAgent::dispatch_callback() {
 	Object *obj = ObjectDB::get_instance(callback.id);
 	if (obj == NULL) {
 		callback.id = ObjectID();
+		return;
 	}
 
 	Callable::CallError responseCallError;
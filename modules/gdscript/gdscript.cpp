@@ -39,7 +39,9 @@
 #include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
+#include "gdscript_compiled_cache.h"
 #include "gdscript_compiler.h"
+#include "gdscript_sampler.h"
 
 ///////////////////////////
 
@@ -308,6 +310,8 @@ bool GDScript::get_property_default_value(const StringName &p_property, Variant
 
 ScriptInstance *GDScript::instance_create(Object *p_this) {
 
+	MemoryTagScope memory_tag(Memory::TAG_SCRIPTS);
+
 	GDScript *top = this;
 	while (top->_base)
 		top = top->_base;
@@ -530,6 +534,8 @@ void GDScript::_set_subclass_path(Ref<GDScript> &p_sc, const String &p_path) {
 
 Error GDScript::reload(bool p_keep_state) {
 
+	MemoryTagScope memory_tag(Memory::TAG_SCRIPTS);
+
 	bool has_instances;
 	{
 		MutexLock lock(GDScriptLanguage::singleton->lock);
@@ -805,6 +811,30 @@ Error GDScript::load_byte_code(const String &p_path) {
 	ERR_FAIL_COND_V(bytecode.size() == 0, ERR_PARSE_ERROR);
 	path = p_path;
 
+	valid = false;
+
+	if (GDScriptCompiledCache::is_compiled_buffer(bytecode)) {
+
+		Vector<uint8_t> tokens;
+		if (GDScriptCompiledCache::load(this, bytecode, tokens) == OK) {
+
+			valid = true;
+
+			for (Map<StringName, Ref<GDScript>>::Element *E = subclasses.front(); E; E = E->next()) {
+
+				_set_subclass_path(E->get(), path);
+			}
+
+			_init_rpc_methods_properties();
+
+			return OK;
+		}
+
+		//can't be used in this build, parse the tokens saved along
+		bytecode = tokens;
+		ERR_FAIL_COND_V(bytecode.size() == 0, ERR_PARSE_ERROR);
+	}
+
 	String basedir = path;
 
 	if (basedir == "")
@@ -813,7 +843,6 @@ Error GDScript::load_byte_code(const String &p_path) {
 	if (basedir != "")
 		basedir = basedir.get_base_dir();
 
-	valid = false;
 	GDScriptParser parser;
 	Error err = parser.parse_bytecode(bytecode, basedir, get_path());
 	if (err) {
@@ -1538,6 +1567,20 @@ void GDScriptLanguage::init() {
 
 		_add_global(E->get().name, E->get().ptr);
 	}
+
+#ifdef DEBUG_ENABLED
+	sampler = memnew(GDScriptSampler);
+	EngineDebugger::Profiler sampler_profiler(
+			sampler,
+			[](void *p_user, bool p_enable, const Array &p_opts) {
+				((GDScriptSampler *)p_user)->toggle(p_enable, p_opts);
+			},
+			nullptr,
+			[](void *p_user, float p_frame_time, float p_idle_time, float p_physics_time, float p_physics_frame_time) {
+				((GDScriptSampler *)p_user)->tick(p_frame_time, p_idle_time, p_physics_time, p_physics_frame_time);
+			});
+	EngineDebugger::register_profiler("gdscript_sampler", sampler_profiler);
+#endif
 }
 
 String GDScriptLanguage::get_type() const {
@@ -1554,6 +1597,14 @@ Error GDScriptLanguage::execute_file(const String &p_path) {
 	return OK;
 }
 void GDScriptLanguage::finish() {
+
+#ifdef DEBUG_ENABLED
+	if (sampler) {
+		EngineDebugger::unregister_profiler("gdscript_sampler");
+		memdelete(sampler);
+		sampler = NULL;
+	}
+#endif
 }
 
 void GDScriptLanguage::profiling_start() {
@@ -2204,6 +2255,10 @@ GDScriptLanguage::GDScriptLanguage() {
 	script_frame_time = 0;
 
 	_debug_call_stack_pos = 0;
+	_call_stack_version.store(0);
+#ifdef DEBUG_ENABLED
+	sampler = NULL;
+#endif
 	int dmcs = GLOBAL_DEF("debug/settings/gdscript/max_call_stack", 1024);
 	ProjectSettings::get_singleton()->set_custom_property_info("debug/settings/gdscript/max_call_stack", PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "1024,4096,1,or_greater")); //minimum is 1024
 
@@ -74,6 +74,7 @@ class GDScript : public Script {
 	friend class GDScriptCompiler;
 	friend class GDScriptFunctions;
 	friend class GDScriptLanguage;
+	friend class GDScriptCompiledCache;
 
 	Ref<GDScriptNativeClass> native;
 	Ref<GDScript> base;
@@ -343,6 +344,8 @@ struct GDScriptWarning {
 };
 #endif // DEBUG_ENABLED
 
+class GDScriptSampler;
+
 class GDScriptLanguage : public ScriptLanguage {
 
 	static GDScriptLanguage *singleton;
@@ -367,6 +370,21 @@ class GDScriptLanguage : public ScriptLanguage {
 	int _debug_call_stack_pos;
 	int _debug_max_call_stack;
 	CallLevel *_call_stack;
+	// Odd while the main thread is changing the call stack, so the sampler
+	// can tell its copy was torn.
+	std::atomic<uint32_t> _call_stack_version;
+
+#ifdef DEBUG_ENABLED
+	GDScriptSampler *sampler;
+#endif
+
+	_FORCE_INLINE_ void _begin_call_stack_change() {
+		_call_stack_version.store(_call_stack_version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+	}
+	_FORCE_INLINE_ void _end_call_stack_change() {
+		_call_stack_version.store(_call_stack_version.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
 
 	void _add_global(const StringName &p_name, const Variant &p_value);
 
@@ -406,12 +424,14 @@ public:
 			return;
 		}
 
+		_begin_call_stack_change();
 		_call_stack[_debug_call_stack_pos].stack = p_stack;
 		_call_stack[_debug_call_stack_pos].instance = p_instance;
 		_call_stack[_debug_call_stack_pos].function = p_function;
 		_call_stack[_debug_call_stack_pos].ip = p_ip;
 		_call_stack[_debug_call_stack_pos].line = p_line;
 		_debug_call_stack_pos++;
+		_end_call_stack_change();
 	}
 
 	_FORCE_INLINE_ void exit_function() {
@@ -429,9 +449,14 @@ public:
 			return;
 		}
 
+		_begin_call_stack_change();
 		_debug_call_stack_pos--;
+		_end_call_stack_change();
 	}
 
+	// Safe to call from any thread, returns -1 if the stack changed meanwhile.
+	int debug_sample_call_stack(GDScriptFunction **r_functions, int p_max) const;
+
 	virtual Vector<StackInfo> debug_get_current_stack_info() {
 		if (Thread::get_main_id() != Thread::get_caller_id())
 			return Vector<StackInfo>();
@@ -0,0 +1,937 @@
+/*************************************************************************/
+/*  gdscript_compiled_cache.cpp                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "gdscript_compiled_cache.h"
+
+#include "core/io/marshalls.h"
+#include "core/version.h"
+#include "core/version_hash.gen.h"
+#include "gdscript_functions.h"
+
+uint32_t GDScriptCompiledCache::_get_engine_signature() {
+
+	//the bytecode refers to opcodes, operators, types and built-in functions by value
+	uint32_t hash = hash_djb2(VERSION_FULL_BUILD);
+	hash = hash_djb2_one_32(hash_djb2(VERSION_HASH), hash);
+	hash = hash_djb2_one_32(GDScriptFunction::OPCODE_END, hash);
+	hash = hash_djb2_one_32(Variant::VARIANT_MAX, hash);
+	hash = hash_djb2_one_32(Variant::OP_MAX, hash);
+	hash = hash_djb2_one_32(GDScriptFunctions::FUNC_MAX, hash);
+	return hash;
+}
+
+bool GDScriptCompiledCache::_get_address_operands(const Vector<int> &p_code, Vector<int> &r_operands) {
+
+	//same layouts as read by GDScriptFunction::call
+	const int *code = p_code.ptr();
+	int size = p_code.size();
+	int ip = 0;
+
+	while (ip < size) {
+
+		int len = 1;
+		uint32_t fixed = 0; //bit n is set when operand n is an address
+		int list_from = 0;
+		int list_count = 0; //addresses following each other from list_from
+
+		switch (code[ip]) {
+			case GDScriptFunction::OPCODE_OPERATOR:
+			case GDScriptFunction::OPCODE_OPERATOR_INT:
+			case GDScriptFunction::OPCODE_OPERATOR_FLOAT:
+			case GDScriptFunction::OPCODE_OPERATOR_VECTOR2:
+			case GDScriptFunction::OPCODE_OPERATOR_VECTOR3: {
+				len = 5;
+				fixed = (1 << 2) | (1 << 3) | (1 << 4);
+			} break;
+			case GDScriptFunction::OPCODE_EXTENDS_TEST:
+			case GDScriptFunction::OPCODE_SET:
+			case GDScriptFunction::OPCODE_GET:
+			case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+			case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+			case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+			case GDScriptFunction::OPCODE_CAST_TO_SCRIPT: {
+				len = 4;
+				fixed = (1 << 1) | (1 << 2) | (1 << 3);
+			} break;
+			case GDScriptFunction::OPCODE_IS_BUILTIN: {
+				len = 4;
+				fixed = (1 << 1) | (1 << 3);
+			} break;
+			case GDScriptFunction::OPCODE_SET_NAMED: {
+				len = 5;
+				fixed = (1 << 1) | (1 << 3);
+			} break;
+			case GDScriptFunction::OPCODE_GET_NAMED: {
+				len = 5;
+				fixed = (1 << 1) | (1 << 4);
+			} break;
+			case GDScriptFunction::OPCODE_SET_MEMBER:
+			case GDScriptFunction::OPCODE_GET_MEMBER: {
+				len = 4;
+				fixed = (1 << 2);
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN: {
+				len = 3;
+				fixed = (1 << 1) | (1 << 2);
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+			case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+			case GDScriptFunction::OPCODE_YIELD_RESUME:
+			case GDScriptFunction::OPCODE_RETURN: {
+				len = 2;
+				fixed = (1 << 1);
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+			case GDScriptFunction::OPCODE_CAST_TO_BUILTIN: {
+				len = 4;
+				fixed = (1 << 2) | (1 << 3);
+			} break;
+			case GDScriptFunction::OPCODE_CONSTRUCT:
+			case GDScriptFunction::OPCODE_CALL_BUILT_IN:
+			case GDScriptFunction::OPCODE_CALL_SELF_BASE: {
+				ERR_FAIL_COND_V(ip + 2 >= size || code[ip + 2] < 0, false);
+				len = 4 + code[ip + 2];
+				list_from = 3;
+				list_count = code[ip + 2] + 1;
+			} break;
+			case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY: {
+				ERR_FAIL_COND_V(ip + 1 >= size || code[ip + 1] < 0, false);
+				len = 3 + code[ip + 1];
+				list_from = 2;
+				list_count = code[ip + 1] + 1;
+			} break;
+			case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY: {
+				ERR_FAIL_COND_V(ip + 1 >= size || code[ip + 1] < 0, false);
+				len = 3 + code[ip + 1] * 2;
+				list_from = 2;
+				list_count = code[ip + 1] * 2 + 1;
+			} break;
+			case GDScriptFunction::OPCODE_CALL:
+			case GDScriptFunction::OPCODE_CALL_RETURN: {
+				ERR_FAIL_COND_V(ip + 1 >= size || code[ip + 1] < 0, false);
+				len = 6 + code[ip + 1];
+				fixed = (1 << 3);
+				list_from = 5;
+				list_count = code[ip + 1] + 1;
+			} break;
+			case GDScriptFunction::OPCODE_YIELD_SIGNAL:
+			case GDScriptFunction::OPCODE_ASSERT: {
+				len = 3;
+				fixed = (1 << 1) | (1 << 2);
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+				len = 3;
+				fixed = (1 << 1);
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_BEGIN:
+			case GDScriptFunction::OPCODE_ITERATE: {
+				len = 5;
+				fixed = (1 << 1) | (1 << 2) | (1 << 4);
+			} break;
+			case GDScriptFunction::OPCODE_JUMP:
+			case GDScriptFunction::OPCODE_LINE: {
+				len = 2;
+			} break;
+			case GDScriptFunction::OPCODE_YIELD:
+			case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+			case GDScriptFunction::OPCODE_BREAKPOINT:
+			case GDScriptFunction::OPCODE_END: {
+				len = 1;
+			} break;
+			default: {
+				return false;
+			}
+		}
+
+		ERR_FAIL_COND_V(ip + len > size, false);
+
+		for (int i = 1; fixed >> i; i++) {
+			if (fixed & (1 << i)) {
+				r_operands.push_back(ip + i);
+			}
+		}
+		for (int i = 0; i < list_count; i++) {
+			r_operands.push_back(ip + list_from + i);
+		}
+
+		ip += len;
+	}
+
+	return true;
+}
+
+bool GDScriptCompiledCache::_is_plain_value(const Variant &p_value) {
+
+	switch (p_value.get_type()) {
+		case Variant::OBJECT:
+		case Variant::_RID:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL: {
+			return false;
+		}
+		case Variant::ARRAY: {
+			Array array = p_value;
+			for (int i = 0; i < array.size(); i++) {
+				if (!_is_plain_value(array[i])) {
+					return false;
+				}
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dict = p_value;
+			const Variant *K = NULL;
+			while ((K = dict.next(K))) {
+				if (!_is_plain_value(*K) || !_is_plain_value(dict[*K])) {
+					return false;
+				}
+			}
+		} break;
+		default: {
+		}
+	}
+
+	return true;
+}
+
+/* Loading */
+
+void GDScriptCompiledCache::_create_classes(LoadState &p_state, GDScript *p_script, const Dictionary &p_class, const String &p_inner) {
+
+	p_state.classes[p_inner] = p_script;
+
+	Dictionary subclasses = p_class["subclasses"];
+	const Variant *K = NULL;
+	while ((K = subclasses.next(K))) {
+
+		StringName name = *K;
+		Ref<GDScript> subclass;
+		subclass.instance();
+		subclass->_owner = p_script;
+		subclass->fully_qualified_name = p_script->fully_qualified_name + "::" + name;
+		p_script->subclasses.insert(name, subclass);
+
+		_create_classes(p_state, subclass.ptr(), subclasses[*K], p_inner.empty() ? String(name) : p_inner + "::" + name);
+	}
+}
+
+bool GDScriptCompiledCache::_load_script_ref(LoadState &p_state, const Variant &p_ref, Ref<Script> &r_script) {
+
+	r_script = Ref<Script>();
+	if (p_ref.get_type() == Variant::NIL) {
+		return true;
+	}
+
+	Array ref = p_ref;
+	ERR_FAIL_COND_V(ref.size() != 2, false);
+	String path = ref[0];
+	String inner = ref[1];
+
+	if (path.empty()) {
+		//a class of the file being loaded
+		Map<String, GDScript *>::Element *E = p_state.classes.find(inner);
+		ERR_FAIL_COND_V(!E, false);
+		r_script = Ref<GDScript>(E->get());
+		return true;
+	}
+
+	r_script = ResourceLoader::load(path);
+	if (r_script.is_null()) {
+		return false;
+	}
+	if (inner.empty()) {
+		return true;
+	}
+
+	Ref<GDScript> gdscript = r_script;
+	Vector<String> names = inner.split("::");
+	for (int i = 0; i < names.size() && gdscript.is_valid(); i++) {
+		const Map<StringName, Ref<GDScript>>::Element *E = gdscript->subclasses.find(names[i]);
+		gdscript = E ? E->get() : Ref<GDScript>();
+	}
+	if (gdscript.is_null()) {
+		return false;
+	}
+
+	r_script = gdscript;
+	return true;
+}
+
+bool GDScriptCompiledCache::_load_constant(LoadState &p_state, const Variant &p_constant, Variant &r_value) {
+
+	Array constant = p_constant;
+	ERR_FAIL_COND_V(constant.size() != 2, false);
+
+	switch (int(constant[0])) {
+		case CONSTANT_VALUE: {
+			r_value = constant[1];
+		} break;
+		case CONSTANT_NATIVE: {
+			StringName name = constant[1];
+			const Map<StringName, int>::Element *E = GDScriptLanguage::get_singleton()->get_global_map().find(name);
+			if (!E) {
+				return false;
+			}
+			r_value = GDScriptLanguage::get_singleton()->get_global_array()[E->get()];
+		} break;
+		case CONSTANT_SCRIPT: {
+			Ref<Script> script;
+			if (!_load_script_ref(p_state, constant[1], script)) {
+				return false;
+			}
+			r_value = script;
+		} break;
+		case CONSTANT_RESOURCE: {
+			RES res = ResourceLoader::load(constant[1]);
+			if (res.is_null()) {
+				return false;
+			}
+			r_value = res;
+		} break;
+		default: {
+			ERR_FAIL_V(false);
+		}
+	}
+
+	return true;
+}
+
+bool GDScriptCompiledCache::_load_data_type(LoadState &p_state, const Variant &p_type, GDScriptDataType &r_type) {
+
+	Array type = p_type;
+	ERR_FAIL_COND_V(type.size() != 5, false);
+
+	r_type.has_type = type[0];
+	r_type.kind = decltype(r_type.kind)(int(type[1]));
+	r_type.builtin_type = Variant::Type(int(type[2]));
+	r_type.native_type = type[3];
+	return _load_script_ref(p_state, type[4], r_type.script_type);
+}
+
+GDScriptFunction *GDScriptCompiledCache::_load_function(LoadState &p_state, GDScript *p_script, const Dictionary &p_function) {
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+
+	//globals are saved by name, their index depends on what this build registers
+	Vector<int> code = p_function["code"];
+	Array globals = p_function["globals"];
+	Vector<int> operands;
+	ERR_FAIL_COND_V(code.empty() || !_get_address_operands(code, operands), NULL);
+
+	int *w = code.ptrw();
+	for (int i = 0; i < operands.size(); i++) {
+
+		int address = w[operands[i]];
+		if (((address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) != GDScriptFunction::ADDR_TYPE_GLOBAL) {
+			continue;
+		}
+
+		int idx = address & GDScriptFunction::ADDR_MASK;
+		ERR_FAIL_INDEX_V(idx, globals.size(), NULL);
+		const Map<StringName, int>::Element *E = language->get_global_map().find(globals[idx]);
+		if (!E) {
+			print_verbose("GDScript: Global '" + String(globals[idx]) + "' used by compiled script '" + p_state.root->get_path() + "' doesn't exist.");
+			return NULL;
+		}
+		w[operands[i]] = E->get() | (GDScriptFunction::ADDR_TYPE_GLOBAL << GDScriptFunction::ADDR_BITS);
+	}
+
+	Array constants = p_function["constants"];
+	Vector<Variant> constant_values;
+	constant_values.resize(constants.size());
+	for (int i = 0; i < constants.size(); i++) {
+		if (!_load_constant(p_state, constants[i], constant_values.write[i])) {
+			return NULL;
+		}
+	}
+
+	Array argument_types = p_function["argument_types"];
+	Vector<GDScriptDataType> argument_data_types;
+	argument_data_types.resize(argument_types.size());
+	for (int i = 0; i < argument_types.size(); i++) {
+		if (!_load_data_type(p_state, argument_types[i], argument_data_types.write[i])) {
+			return NULL;
+		}
+	}
+
+	GDScriptDataType return_type;
+	if (!_load_data_type(p_state, p_function["return_type"], return_type)) {
+		return NULL;
+	}
+
+	Vector<int> validated_types = p_function["inline_cache_validated_types"];
+	ERR_FAIL_COND_V(validated_types.size() != int(p_function["inline_cache_count"]), NULL);
+
+	GDScriptFunction *gdfunc = memnew(GDScriptFunction);
+
+	gdfunc->name = p_function["name"];
+	gdfunc->_static = p_function["static"];
+	gdfunc->rpc_mode = MultiplayerAPI::RPCMode(int(p_function["rpc_mode"]));
+	gdfunc->argument_types = argument_data_types;
+	gdfunc->return_type = return_type;
+
+#ifdef TOOLS_ENABLED
+	Array argument_names = p_function["argument_names"];
+	for (int i = 0; i < argument_names.size(); i++) {
+		gdfunc->arg_names.push_back(argument_names[i]);
+	}
+	gdfunc->_named_globals_ptr = NULL;
+	gdfunc->_named_globals_count = 0;
+#endif
+
+	gdfunc->constants = constant_values;
+	gdfunc->_constant_count = gdfunc->constants.size();
+	gdfunc->_constants_ptr = gdfunc->_constant_count ? gdfunc->constants.ptrw() : NULL;
+
+	Array global_names = p_function["global_names"];
+	for (int i = 0; i < global_names.size(); i++) {
+		gdfunc->global_names.push_back(global_names[i]);
+	}
+	gdfunc->_global_names_count = gdfunc->global_names.size();
+	gdfunc->_global_names_ptr = gdfunc->_global_names_count ? gdfunc->global_names.ptr() : NULL;
+
+	gdfunc->code = code;
+	gdfunc->_code_ptr = gdfunc->code.ptr();
+	gdfunc->_code_size = gdfunc->code.size();
+
+	Vector<int> default_arguments = p_function["default_arguments"];
+	if (default_arguments.size()) {
+		gdfunc->default_arguments = default_arguments;
+		gdfunc->_default_arg_count = default_arguments.size() - 1;
+		gdfunc->_default_arg_ptr = gdfunc->default_arguments.ptr();
+	} else {
+		gdfunc->_default_arg_count = 0;
+		gdfunc->_default_arg_ptr = NULL;
+	}
+
+	gdfunc->_argument_count = p_function["argument_count"];
+	gdfunc->_stack_size = p_function["stack_size"];
+	gdfunc->_call_size = p_function["call_size"];
+	gdfunc->_initial_line = p_function["initial_line"];
+	gdfunc->_inline_cache_count = p_function["inline_cache_count"];
+	gdfunc->_inline_caches = gdfunc->_inline_cache_count ? memnew_arr(GDScriptFunction::InlineCacheSlot, gdfunc->_inline_cache_count) : NULL;
+	for (int i = 0; i < gdfunc->_inline_cache_count; i++) {
+		gdfunc->_inline_caches[i].validated_type = Variant::Type(validated_types[i]);
+	}
+	gdfunc->_script = p_script;
+	gdfunc->source = p_state.root->get_path();
+
+#ifdef DEBUG_ENABLED
+	gdfunc->func_cname = (String(gdfunc->source) + " - " + String(gdfunc->name)).utf8();
+	gdfunc->_func_cname = gdfunc->func_cname.get_data();
+#endif
+
+	return gdfunc;
+}
+
+bool GDScriptCompiledCache::_load_class(LoadState &p_state, GDScript *p_script, const Dictionary &p_class) {
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+
+	p_script->tool = p_class["tool"];
+	p_script->name = p_class["name"];
+
+	StringName native = p_class["native"];
+	if (native != StringName()) {
+		const Map<StringName, int>::Element *E = language->get_global_map().find(native);
+		if (!E) {
+			return false;
+		}
+		p_script->native = language->get_global_array()[E->get()];
+		ERR_FAIL_COND_V(p_script->native.is_null(), false);
+	}
+
+	Ref<Script> base;
+	if (!_load_script_ref(p_state, p_class["base"], base)) {
+		return false;
+	}
+	if (base.is_valid()) {
+		p_script->base = base;
+		ERR_FAIL_COND_V(p_script->base.is_null(), false);
+		p_script->_base = p_script->base.ptr();
+	}
+
+	Array members = p_class["members"];
+	for (int i = 0; i < members.size(); i++) {
+		p_script->members.insert(members[i]);
+	}
+
+	Dictionary member_indices = p_class["member_indices"];
+	const Variant *K = NULL;
+	while ((K = member_indices.next(K))) {
+
+		Array info = member_indices[*K];
+		ERR_FAIL_COND_V(info.size() != 5, false);
+
+		GDScript::MemberInfo minfo;
+		minfo.index = info[0];
+		minfo.setter = info[1];
+		minfo.getter = info[2];
+		minfo.rpc_mode = MultiplayerAPI::RPCMode(int(info[3]));
+		if (!_load_data_type(p_state, info[4], minfo.data_type)) {
+			return false;
+		}
+		p_script->member_indices[*K] = minfo;
+	}
+
+	Dictionary member_info = p_class["member_info"];
+	K = NULL;
+	while ((K = member_info.next(K))) {
+		p_script->member_info[*K] = PropertyInfo::from_dict(member_info[*K]);
+	}
+
+	Dictionary constants = p_class["constants"];
+	K = NULL;
+	while ((K = constants.next(K))) {
+		Variant value;
+		if (!_load_constant(p_state, constants[*K], value)) {
+			return false;
+		}
+		p_script->constants[*K] = value;
+	}
+
+	Dictionary signals = p_class["signals"];
+	K = NULL;
+	while ((K = signals.next(K))) {
+		Array arguments = signals[*K];
+		Vector<StringName> &signal = p_script->_signals[*K];
+		for (int i = 0; i < arguments.size(); i++) {
+			signal.push_back(arguments[i]);
+		}
+	}
+
+	Array functions = p_class["functions"];
+	for (int i = 0; i < functions.size(); i++) {
+		GDScriptFunction *function = _load_function(p_state, p_script, functions[i]);
+		if (!function) {
+			return false;
+		}
+		p_script->member_functions[function->get_name()] = function;
+	}
+
+	Map<StringName, GDScriptFunction *>::Element *init = p_script->member_functions.find("_init");
+	p_script->initializer = init ? init->get() : NULL;
+
+	Dictionary subclasses = p_class["subclasses"];
+	K = NULL;
+	while ((K = subclasses.next(K))) {
+		Map<StringName, Ref<GDScript>>::Element *E = p_script->subclasses.find(*K);
+		ERR_FAIL_COND_V(!E, false);
+		if (!_load_class(p_state, E->get().ptr(), subclasses[*K])) {
+			return false;
+		}
+	}
+
+	p_script->valid = true;
+	return true;
+}
+
+void GDScriptCompiledCache::_clear_class(GDScript *p_script) {
+
+	for (Map<StringName, Ref<GDScript>>::Element *E = p_script->subclasses.front(); E; E = E->next()) {
+		_clear_class(E->get().ptr());
+	}
+	for (Map<StringName, GDScriptFunction *>::Element *E = p_script->member_functions.front(); E; E = E->next()) {
+		memdelete(E->get());
+	}
+
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->_base = NULL;
+	p_script->members.clear();
+	p_script->constants.clear();
+	p_script->member_functions.clear();
+	p_script->member_indices.clear();
+	p_script->member_info.clear();
+	p_script->subclasses.clear();
+	p_script->_signals.clear();
+	p_script->initializer = NULL;
+	p_script->valid = false;
+}
+
+bool GDScriptCompiledCache::is_compiled_buffer(const Vector<uint8_t> &p_buffer) {
+
+	return p_buffer.size() >= HEADER_SIZE && p_buffer[0] == 'G' && p_buffer[1] == 'D' && p_buffer[2] == 'S' && p_buffer[3] == 'P';
+}
+
+Error GDScriptCompiledCache::load(GDScript *p_script, const Vector<uint8_t> &p_buffer, Vector<uint8_t> &r_tokens) {
+
+	ERR_FAIL_COND_V(!is_compiled_buffer(p_buffer), ERR_INVALID_DATA);
+
+	const uint8_t *buf = p_buffer.ptr();
+	uint32_t token_len = decode_uint32(&buf[12]);
+	ERR_FAIL_COND_V(token_len > uint32_t(p_buffer.size() - HEADER_SIZE), ERR_INVALID_DATA);
+
+	r_tokens.resize(token_len);
+	copymem(r_tokens.ptrw(), &buf[HEADER_SIZE], token_len);
+
+	if (decode_uint32(&buf[4]) != FORMAT_VERSION || decode_uint32(&buf[8]) != _get_engine_signature()) {
+		print_verbose("GDScript: Compiled script '" + p_script->get_path() + "' comes from another engine build, parsing it instead.");
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	if (EngineDebugger::is_active()) {
+		//stack and profiler information only comes from the compiler
+		return ERR_UNAVAILABLE;
+	}
+
+	Variant compiled;
+	int offset = HEADER_SIZE + token_len;
+	Error err = decode_variant(compiled, &buf[offset], p_buffer.size() - offset);
+	ERR_FAIL_COND_V(err != OK || compiled.get_type() != Variant::DICTIONARY, ERR_INVALID_DATA);
+
+	_clear_class(p_script);
+	p_script->_owner = NULL;
+	p_script->fully_qualified_name = p_script->path;
+
+	LoadState state;
+	state.root = p_script;
+	_create_classes(state, p_script, compiled, String());
+
+	if (!_load_class(state, p_script, compiled)) {
+		_clear_class(p_script);
+		print_verbose("GDScript: Compiled script '" + p_script->get_path() + "' refers to something this build doesn't have, parsing it instead.");
+		return ERR_CANT_RESOLVE;
+	}
+
+	return OK;
+}
+
+/* Saving */
+
+#ifdef TOOLS_ENABLED
+
+void GDScriptCompiledCache::_register_classes(SaveState &p_state, const GDScript *p_script, const String &p_inner) {
+
+	p_state.classes[p_script] = p_inner;
+
+	for (const Map<StringName, Ref<GDScript>>::Element *E = p_script->subclasses.front(); E; E = E->next()) {
+		_register_classes(p_state, E->get().ptr(), p_inner.empty() ? String(E->key()) : p_inner + "::" + String(E->key()));
+	}
+}
+
+Variant GDScriptCompiledCache::_save_script_ref(SaveState &p_state, const Ref<Script> &p_script) {
+
+	if (p_script.is_null()) {
+		return Variant();
+	}
+
+	String path;
+	String inner;
+
+	const GDScript *gdscript = Object::cast_to<GDScript>(p_script.ptr());
+	if (gdscript) {
+
+		const Map<const GDScript *, String>::Element *E = p_state.classes.find(gdscript);
+		if (E) {
+			inner = E->get();
+		} else {
+			const GDScript *root = gdscript;
+			while (root->_owner) {
+				inner = inner.empty() ? String(root->name) : String(root->name) + "::" + inner;
+				root = root->_owner;
+			}
+			path = root->get_path();
+
+			if (path == p_state.path) {
+				//the editor's copy of the file being saved
+				path = String();
+				bool found = false;
+				for (E = p_state.classes.front(); E && !found; E = E->next()) {
+					found = E->get() == inner;
+				}
+				if (!found) {
+					p_state.failed = true;
+				}
+			} else if (path.empty() || path.find("::") != -1) {
+				p_state.failed = true;
+			}
+		}
+	} else {
+		path = p_script->get_path();
+		if (path.empty() || path.find("::") != -1) {
+			p_state.failed = true;
+		}
+	}
+
+	Array ref;
+	ref.push_back(path);
+	ref.push_back(inner);
+	return ref;
+}
+
+Variant GDScriptCompiledCache::_save_constant(SaveState &p_state, const Variant &p_value) {
+
+	Array constant;
+	constant.resize(2);
+	constant[0] = CONSTANT_VALUE;
+
+	if (p_value.get_type() != Variant::OBJECT) {
+		if (!_is_plain_value(p_value)) {
+			p_state.failed = true;
+		}
+		constant[1] = p_value;
+		return constant;
+	}
+
+	Object *obj = p_value;
+	if (!obj) {
+		return constant;
+	}
+
+	GDScriptNativeClass *native = Object::cast_to<GDScriptNativeClass>(obj);
+	Script *script = Object::cast_to<Script>(obj);
+	Resource *res = Object::cast_to<Resource>(obj);
+
+	if (native) {
+		constant[0] = CONSTANT_NATIVE;
+		constant[1] = native->get_name();
+	} else if (script) {
+		constant[0] = CONSTANT_SCRIPT;
+		constant[1] = _save_script_ref(p_state, Ref<Script>(script));
+	} else if (res && !res->get_path().empty() && res->get_path().find("::") == -1) {
+		constant[0] = CONSTANT_RESOURCE;
+		constant[1] = res->get_path();
+	} else {
+		p_state.failed = true;
+	}
+
+	return constant;
+}
+
+Variant GDScriptCompiledCache::_save_data_type(SaveState &p_state, const GDScriptDataType &p_type) {
+
+	Array type;
+	type.push_back(p_type.has_type);
+	type.push_back(int(p_type.kind));
+	type.push_back(int(p_type.builtin_type));
+	type.push_back(p_type.native_type);
+	type.push_back(_save_script_ref(p_state, p_type.script_type));
+	return type;
+}
+
+Dictionary GDScriptCompiledCache::_save_function(SaveState &p_state, const GDScriptFunction *p_function) {
+
+	//globals are saved by name, the editor registers more of them than an exported project
+	Vector<int> code = p_function->code;
+	Vector<int> operands;
+	if (!_get_address_operands(code, operands)) {
+		p_state.failed = true;
+		return Dictionary();
+	}
+
+	Array globals;
+	int *w = code.ptrw();
+	for (int i = 0; i < operands.size(); i++) {
+
+		int address = w[operands[i]];
+		int idx = address & GDScriptFunction::ADDR_MASK;
+		StringName name;
+
+		switch ((address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) {
+			case GDScriptFunction::ADDR_TYPE_GLOBAL: {
+				if (idx >= p_state.global_names.size()) {
+					p_state.failed = true;
+					return Dictionary();
+				}
+				name = p_state.global_names[idx];
+			} break;
+			case GDScriptFunction::ADDR_TYPE_NAMED_GLOBAL: {
+				//autoloads are named globals in the editor only
+				if (idx >= p_function->named_globals.size()) {
+					p_state.failed = true;
+					return Dictionary();
+				}
+				name = p_function->named_globals[idx];
+			} break;
+			default: {
+				continue;
+			}
+		}
+
+		int pos = globals.find(name);
+		if (pos == -1) {
+			pos = globals.size();
+			globals.push_back(name);
+		}
+		w[operands[i]] = pos | (GDScriptFunction::ADDR_TYPE_GLOBAL << GDScriptFunction::ADDR_BITS);
+	}
+
+	Array argument_types;
+	for (int i = 0; i < p_function->argument_types.size(); i++) {
+		argument_types.push_back(_save_data_type(p_state, p_function->argument_types[i]));
+	}
+
+	Array argument_names;
+	for (int i = 0; i < p_function->arg_names.size(); i++) {
+		argument_names.push_back(p_function->arg_names[i]);
+	}
+
+	Array constants;
+	for (int i = 0; i < p_function->constants.size(); i++) {
+		constants.push_back(_save_constant(p_state, p_function->constants[i]));
+	}
+
+	Array global_names;
+	for (int i = 0; i < p_function->global_names.size(); i++) {
+		global_names.push_back(p_function->global_names[i]);
+	}
+
+	Dictionary function;
+	function["name"] = p_function->name;
+	function["static"] = p_function->_static;
+	function["rpc_mode"] = int(p_function->rpc_mode);
+	function["argument_types"] = argument_types;
+	function["return_type"] = _save_data_type(p_state, p_function->return_type);
+	function["argument_names"] = argument_names;
+	function["constants"] = constants;
+	function["global_names"] = global_names;
+	function["globals"] = globals;
+	function["code"] = code;
+	function["default_arguments"] = p_function->default_arguments;
+	function["argument_count"] = p_function->_argument_count;
+	function["stack_size"] = p_function->_stack_size;
+	function["call_size"] = p_function->_call_size;
+	function["initial_line"] = p_function->_initial_line;
+	function["inline_cache_count"] = p_function->_inline_cache_count;
+	Vector<int> validated_types;
+	validated_types.resize(p_function->_inline_cache_count);
+	for (int i = 0; i < p_function->_inline_cache_count; i++) {
+		validated_types.write[i] = p_function->_inline_caches[i].validated_type;
+	}
+	function["inline_cache_validated_types"] = validated_types;
+	return function;
+}
+
+Dictionary GDScriptCompiledCache::_save_class(SaveState &p_state, const GDScript *p_script) {
+
+	Dictionary data;
+	data["name"] = p_script->name;
+	data["tool"] = p_script->tool;
+	data["native"] = p_script->native.is_valid() ? p_script->native->get_name() : StringName();
+	data["base"] = _save_script_ref(p_state, p_script->base);
+
+	Array members;
+	for (const Set<StringName>::Element *E = p_script->members.front(); E; E = E->next()) {
+		members.push_back(E->get());
+	}
+	data["members"] = members;
+
+	Dictionary member_indices;
+	for (const Map<StringName, GDScript::MemberInfo>::Element *E = p_script->member_indices.front(); E; E = E->next()) {
+		Array info;
+		info.push_back(E->get().index);
+		info.push_back(E->get().setter);
+		info.push_back(E->get().getter);
+		info.push_back(int(E->get().rpc_mode));
+		info.push_back(_save_data_type(p_state, E->get().data_type));
+		member_indices[E->key()] = info;
+	}
+	data["member_indices"] = member_indices;
+
+	Dictionary member_info;
+	for (const Map<StringName, PropertyInfo>::Element *E = p_script->member_info.front(); E; E = E->next()) {
+		member_info[E->key()] = Dictionary(E->get());
+	}
+	data["member_info"] = member_info;
+
+	Dictionary constants;
+	for (const Map<StringName, Variant>::Element *E = p_script->constants.front(); E; E = E->next()) {
+		constants[E->key()] = _save_constant(p_state, E->get());
+	}
+	data["constants"] = constants;
+
+	Dictionary signals;
+	for (const Map<StringName, Vector<StringName>>::Element *E = p_script->_signals.front(); E; E = E->next()) {
+		Array arguments;
+		for (int i = 0; i < E->get().size(); i++) {
+			arguments.push_back(E->get()[i]);
+		}
+		signals[E->key()] = arguments;
+	}
+	data["signals"] = signals;
+
+	Array functions;
+	for (const Map<StringName, GDScriptFunction *>::Element *E = p_script->member_functions.front(); E; E = E->next()) {
+		functions.push_back(_save_function(p_state, E->get()));
+	}
+	data["functions"] = functions;
+
+	Dictionary subclasses;
+	for (const Map<StringName, Ref<GDScript>>::Element *E = p_script->subclasses.front(); E; E = E->next()) {
+		subclasses[E->key()] = _save_class(p_state, E->get().ptr());
+	}
+	data["subclasses"] = subclasses;
+
+	return data;
+}
+
+Vector<uint8_t> GDScriptCompiledCache::save(const Ref<GDScript> &p_script, const Vector<uint8_t> &p_tokens) {
+
+	ERR_FAIL_COND_V(p_script.is_null() || !p_script->is_valid(), Vector<uint8_t>());
+
+	SaveState state;
+	state.path = p_script->path;
+	_register_classes(state, p_script.ptr(), String());
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	state.global_names.resize(language->get_global_array_size());
+	for (const Map<StringName, int>::Element *E = language->get_global_map().front(); E; E = E->next()) {
+		state.global_names.write[E->get()] = E->key();
+	}
+
+	Dictionary compiled = _save_class(state, p_script.ptr());
+	if (state.failed) {
+		print_verbose("GDScript: '" + state.path + "' refers to values that can't be saved compiled, exporting its tokens only.");
+		return Vector<uint8_t>();
+	}
+
+	int len;
+	Error err = encode_variant(compiled, NULL, len);
+	ERR_FAIL_COND_V(err != OK, Vector<uint8_t>());
+
+	Vector<uint8_t> buffer;
+	buffer.resize(HEADER_SIZE + p_tokens.size() + len);
+	uint8_t *w = buffer.ptrw();
+
+	w[0] = 'G';
+	w[1] = 'D';
+	w[2] = 'S';
+	w[3] = 'P';
+	encode_uint32(FORMAT_VERSION, &w[4]);
+	encode_uint32(_get_engine_signature(), &w[8]);
+	encode_uint32(p_tokens.size(), &w[12]);
+	copymem(&w[HEADER_SIZE], p_tokens.ptr(), p_tokens.size());
+	encode_variant(compiled, &w[HEADER_SIZE + p_tokens.size()], len);
+
+	return buffer;
+}
+
+#endif // TOOLS_ENABLED
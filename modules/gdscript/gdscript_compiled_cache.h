@@ -0,0 +1,99 @@
+/*************************************************************************/
+/*  gdscript_compiled_cache.h                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GDSCRIPT_COMPILED_CACHE_H
+#define GDSCRIPT_COMPILED_CACHE_H
+
+#include "gdscript.h"
+
+// Compiled form of a script, written by the exporter so loading skips the
+// parser and the compiler. The token stream is stored next to it and is used
+// instead whenever the compiled data can't be used as is: a different engine
+// build, a global that doesn't exist at runtime, or an attached debugger.
+
+class GDScriptCompiledCache {
+
+	enum {
+		FORMAT_VERSION = 2,
+		HEADER_SIZE = 16
+	};
+
+	enum ConstantKind {
+		CONSTANT_VALUE,
+		CONSTANT_NATIVE,
+		CONSTANT_SCRIPT,
+		CONSTANT_RESOURCE,
+	};
+
+	struct LoadState {
+		GDScript *root;
+		Map<String, GDScript *> classes; // By inner class path, empty for the root.
+	};
+
+	static uint32_t _get_engine_signature();
+	static bool _get_address_operands(const Vector<int> &p_code, Vector<int> &r_operands);
+	static bool _is_plain_value(const Variant &p_value);
+
+	static void _create_classes(LoadState &p_state, GDScript *p_script, const Dictionary &p_class, const String &p_inner);
+	static bool _load_script_ref(LoadState &p_state, const Variant &p_ref, Ref<Script> &r_script);
+	static bool _load_constant(LoadState &p_state, const Variant &p_constant, Variant &r_value);
+	static bool _load_data_type(LoadState &p_state, const Variant &p_type, GDScriptDataType &r_type);
+	static GDScriptFunction *_load_function(LoadState &p_state, GDScript *p_script, const Dictionary &p_function);
+	static bool _load_class(LoadState &p_state, GDScript *p_script, const Dictionary &p_class);
+	static void _clear_class(GDScript *p_script);
+
+#ifdef TOOLS_ENABLED
+	struct SaveState {
+		String path;
+		Map<const GDScript *, String> classes; // By inner class path, empty for the root.
+		Vector<StringName> global_names; // Name of each entry in the global array.
+		bool failed = false;
+	};
+
+	static void _register_classes(SaveState &p_state, const GDScript *p_script, const String &p_inner);
+	static Variant _save_script_ref(SaveState &p_state, const Ref<Script> &p_script);
+	static Variant _save_constant(SaveState &p_state, const Variant &p_value);
+	static Variant _save_data_type(SaveState &p_state, const GDScriptDataType &p_type);
+	static Dictionary _save_function(SaveState &p_state, const GDScriptFunction *p_function);
+	static Dictionary _save_class(SaveState &p_state, const GDScript *p_script);
+#endif
+
+public:
+	static bool is_compiled_buffer(const Vector<uint8_t> &p_buffer);
+	// Restores p_script from p_buffer. Whatever the result, r_tokens gets the
+	// token stream so the caller can fall back to parsing it.
+	static Error load(GDScript *p_script, const Vector<uint8_t> &p_buffer, Vector<uint8_t> &r_tokens);
+#ifdef TOOLS_ENABLED
+	// p_script must be compiled, returns an empty buffer if it can't be saved.
+	static Vector<uint8_t> save(const Ref<GDScript> &p_script, const Vector<uint8_t> &p_tokens);
+#endif
+};
+
+#endif // GDSCRIPT_COMPILED_CACHE_H
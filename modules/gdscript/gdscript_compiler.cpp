@@ -74,6 +74,72 @@ void GDScriptCompiler::_set_error(const String &p_error, const GDScriptParser::N
 	}
 }
 
+GDScriptFunction::Opcode GDScriptCompiler::_get_operator_opcode(Variant::Operator p_op, const GDScriptParser::DataType &p_a, const GDScriptParser::DataType &p_b) const {
+
+	//the typed opcodes check the operand types again when running, so this only has to pick the likely path
+	if (!p_a.has_type || !p_b.has_type || p_a.is_meta_type || p_b.is_meta_type) {
+		return GDScriptFunction::OPCODE_OPERATOR;
+	}
+	if (p_a.kind != GDScriptParser::DataType::BUILTIN || p_b.kind != GDScriptParser::DataType::BUILTIN) {
+		return GDScriptFunction::OPCODE_OPERATOR;
+	}
+
+	Variant::Type a = p_a.builtin_type;
+	Variant::Type b = p_b.builtin_type;
+
+	if (p_op == Variant::OP_IN || p_op == Variant::OP_NOT || p_op == Variant::OP_SHIFT_LEFT || p_op == Variant::OP_SHIFT_RIGHT) {
+		return GDScriptFunction::OPCODE_OPERATOR;
+	}
+
+	if (a == Variant::INT && b == Variant::INT) {
+		return GDScriptFunction::OPCODE_OPERATOR_INT;
+	}
+
+	bool numeric_a = a == Variant::INT || a == Variant::FLOAT;
+	bool numeric_b = b == Variant::INT || b == Variant::FLOAT;
+	if (numeric_a && numeric_b) {
+		return GDScriptFunction::OPCODE_OPERATOR_FLOAT;
+	}
+
+	if ((a == Variant::VECTOR2 || a == Variant::VECTOR3) && (b == a || numeric_b)) {
+		return a == Variant::VECTOR2 ? GDScriptFunction::OPCODE_OPERATOR_VECTOR2 : GDScriptFunction::OPCODE_OPERATOR_VECTOR3;
+	}
+
+	return GDScriptFunction::OPCODE_OPERATOR;
+}
+
+// Returns the base type of a builtin method call when the base and every argument are known to
+// have exactly the types of the method signature, VARIANT_MAX otherwise.
+Variant::Type GDScriptCompiler::_get_validated_call_type(const GDScriptParser::OperatorNode *p_call) const {
+
+	GDScriptParser::DataType base = p_call->arguments[0]->get_datatype();
+	if (!base.has_type || base.is_meta_type || base.kind != GDScriptParser::DataType::BUILTIN || base.builtin_type == Variant::NIL || base.builtin_type == Variant::OBJECT) {
+		return Variant::VARIANT_MAX;
+	}
+
+	const StringName &method = static_cast<const GDScriptParser::IdentifierNode *>(p_call->arguments[1])->name;
+	if (Variant::get_builtin_method_id(base.builtin_type, method) < 0) {
+		return Variant::VARIANT_MAX;
+	}
+
+	Vector<Variant::Type> arg_types = Variant::get_method_argument_types(base.builtin_type, method);
+	if (arg_types.size() != p_call->arguments.size() - 2) {
+		return Variant::VARIANT_MAX; //default arguments still have to be filled in
+	}
+
+	for (int i = 0; i < arg_types.size(); i++) {
+		if (arg_types[i] == Variant::NIL) {
+			continue;
+		}
+		GDScriptParser::DataType arg = p_call->arguments[i + 2]->get_datatype();
+		if (!arg.has_type || arg.is_meta_type || arg.kind != GDScriptParser::DataType::BUILTIN || arg.builtin_type != arg_types[i]) {
+			return Variant::VARIANT_MAX;
+		}
+	}
+
+	return base.builtin_type;
+}
+
 bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level) {
 
 	ERR_FAIL_COND_V(on->arguments.size() != 1, false);
@@ -82,7 +148,9 @@ bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptPa
 	if (src_address_a < 0)
 		return false;
 
-	codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
+	GDScriptParser::DataType type = on->arguments[0]->get_datatype();
+
+	codegen.opcodes.push_back(_get_operator_opcode(op, type, type)); // perform operator
 	codegen.opcodes.push_back(op); //which operator
 	codegen.opcodes.push_back(src_address_a); // argument 1
 	codegen.opcodes.push_back(src_address_a); // argument 2 (repeated)
@@ -104,7 +172,7 @@ bool GDScriptCompiler::_create_binary_operator(CodeGen &codegen, const GDScriptP
 	if (src_address_b < 0)
 		return false;
 
-	codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
+	codegen.opcodes.push_back(_get_operator_opcode(op, on->arguments[0]->get_datatype(), on->arguments[1]->get_datatype())); // perform operator
 	codegen.opcodes.push_back(op); //which operator
 	codegen.opcodes.push_back(src_address_a); // argument 1
 	codegen.opcodes.push_back(src_address_b); // argument 2 (unary only takes one parameter)
@@ -243,6 +311,7 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 				codegen.opcodes.push_back(codegen.get_name_map_pos(identifier)); // argument 2 (unary only takes one parameter)
 				int dst_addr = (p_stack_level) | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
 				codegen.opcodes.push_back(dst_addr); // append the stack level as destination address of the opcode
+				codegen.opcodes.push_back(codegen.add_inline_cache());
 				codegen.alloc_stack(p_stack_level);
 				return dst_addr;
 			}
@@ -270,6 +339,12 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 
 					if (scr->constants.has(identifier)) {
 
+						const Variant &value = scr->constants[identifier];
+						if (scr == owner && value.get_type() != Variant::OBJECT) {
+							//constants of this file are compiled along with the function, so the value can be embedded (objects could create reference cycles)
+							return codegen.get_constant_pos(value) | (GDScriptFunction::ADDR_TYPE_LOCAL_CONSTANT << GDScriptFunction::ADDR_BITS);
+						}
+
 						//int idx=scr->constants[identifier];
 						int idx = codegen.get_name_map_pos(identifier);
 						return idx | (GDScriptFunction::ADDR_TYPE_CLASS_CONSTANT << GDScriptFunction::ADDR_BITS); //argument (stack root)
@@ -658,6 +733,7 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 
 						codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL : GDScriptFunction::OPCODE_CALL_RETURN); // perform operator
 						codegen.opcodes.push_back(on->arguments.size() - 2);
+						codegen.opcodes.push_back(codegen.add_inline_cache(_get_validated_call_type(on)));
 						codegen.alloc_call(on->arguments.size() - 2);
 						for (int i = 0; i < arguments.size(); i++)
 							codegen.opcodes.push_back(arguments[i]);
@@ -752,6 +828,9 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 					codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED : GDScriptFunction::OPCODE_GET); // perform operator
 					codegen.opcodes.push_back(from); // argument 1
 					codegen.opcodes.push_back(index); // argument 2 (unary only takes one parameter)
+					if (named) {
+						codegen.opcodes.push_back(codegen.add_inline_cache());
+					}
 
 				} break;
 				case GDScriptParser::OperatorNode::OP_AND: {
@@ -1016,6 +1095,7 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 							// recover and assign at the end, this allows stuff like
 							// position.x+=2.0
 							// in Node2D
+							setchain.push_back(codegen.add_inline_cache());
 							setchain.push_back(prev_pos);
 							setchain.push_back(codegen.get_name_map_pos(assign_property));
 							setchain.push_back(GDScriptFunction::OPCODE_SET_MEMBER);
@@ -1054,6 +1134,9 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 							codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED : GDScriptFunction::OPCODE_GET);
 							codegen.opcodes.push_back(prev_pos);
 							codegen.opcodes.push_back(key_idx);
+							if (named) {
+								codegen.opcodes.push_back(codegen.add_inline_cache());
+							}
 							slevel++;
 							codegen.alloc_stack(slevel);
 							int dst_pos = (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS) | slevel;
@@ -1062,6 +1145,9 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 
 							//add in reverse order, since it will be reverted
 
+							if (named) {
+								setchain.push_back(codegen.add_inline_cache());
+							}
 							setchain.push_back(dst_pos);
 							setchain.push_back(key_idx);
 							setchain.push_back(prev_pos);
@@ -1101,6 +1187,9 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 						codegen.opcodes.push_back(prev_pos);
 						codegen.opcodes.push_back(set_index);
 						codegen.opcodes.push_back(set_value);
+						if (named) {
+							codegen.opcodes.push_back(codegen.add_inline_cache());
+						}
 
 						for (int i = 0; i < setchain.size(); i++) {
 
@@ -1123,6 +1212,7 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 						codegen.opcodes.push_back(GDScriptFunction::OPCODE_SET_MEMBER);
 						codegen.opcodes.push_back(codegen.get_name_map_pos(name));
 						codegen.opcodes.push_back(src_address);
+						codegen.opcodes.push_back(codegen.add_inline_cache());
 
 						return GDScriptFunction::ADDR_TYPE_NIL << GDScriptFunction::ADDR_BITS;
 					} else {
@@ -1261,6 +1351,19 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 	}
 }
 
+Error GDScriptCompiler::_parse_unreachable_block(CodeGen &codegen, const GDScriptParser::BlockNode *p_block, int p_stack_level, int p_break_addr, int p_continue_addr) {
+
+	//still compiled so it reports the same errors, then dropped
+	int from = codegen.opcodes.size();
+	int line = codegen.current_line;
+
+	Error err = _parse_block(codegen, p_block, p_stack_level, p_break_addr, p_continue_addr);
+
+	codegen.opcodes.resize(from);
+	codegen.current_line = line;
+	return err;
+}
+
 Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::BlockNode *p_block, int p_stack_level, int p_break_addr, int p_continue_addr) {
 
 	codegen.push_stack_identifiers();
@@ -1361,6 +1464,22 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 
 					case GDScriptParser::ControlFlowNode::CF_IF: {
 
+						if (cf->arguments[0]->type == GDScriptParser::Node::TYPE_CONSTANT) {
+							//only the branch that can run is kept
+							bool condition = static_cast<const GDScriptParser::ConstantNode *>(cf->arguments[0])->value.booleanize();
+
+							Error err = condition ? _parse_block(codegen, cf->body, p_stack_level, p_break_addr, p_continue_addr) : _parse_unreachable_block(codegen, cf->body, p_stack_level, p_break_addr, p_continue_addr);
+							if (err)
+								return err;
+
+							if (cf->body_else) {
+								Error err2 = condition ? _parse_unreachable_block(codegen, cf->body_else, p_stack_level, p_break_addr, p_continue_addr) : _parse_block(codegen, cf->body_else, p_stack_level, p_break_addr, p_continue_addr);
+								if (err2)
+									return err2;
+							}
+							break;
+						}
+
 						int ret2 = _parse_expression(codegen, cf->arguments[0], p_stack_level, false);
 						if (ret2 < 0)
 							return ERR_PARSE_ERROR;
@@ -1446,6 +1565,14 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 					} break;
 					case GDScriptParser::ControlFlowNode::CF_WHILE: {
 
+						bool constant_condition = cf->arguments[0]->type == GDScriptParser::Node::TYPE_CONSTANT;
+						if (constant_condition && !static_cast<const GDScriptParser::ConstantNode *>(cf->arguments[0])->value.booleanize()) {
+							Error err = _parse_unreachable_block(codegen, cf->body, p_stack_level, 0, 0); //inside a loop, so break and continue are valid
+							if (err)
+								return err;
+							break;
+						}
+
 						codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP);
 						codegen.opcodes.push_back(codegen.opcodes.size() + 3);
 						int break_addr = codegen.opcodes.size();
@@ -1453,12 +1580,14 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 						codegen.opcodes.push_back(0);
 						int continue_addr = codegen.opcodes.size();
 
-						int ret2 = _parse_expression(codegen, cf->arguments[0], p_stack_level, false);
-						if (ret2 < 0)
-							return ERR_PARSE_ERROR;
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-						codegen.opcodes.push_back(ret2);
-						codegen.opcodes.push_back(break_addr);
+						if (!constant_condition) {
+							int ret2 = _parse_expression(codegen, cf->arguments[0], p_stack_level, false);
+							if (ret2 < 0)
+								return ERR_PARSE_ERROR;
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+							codegen.opcodes.push_back(ret2);
+							codegen.opcodes.push_back(break_addr);
+						}
 						Error err = _parse_block(codegen, cf->body, p_stack_level, break_addr, continue_addr);
 						if (err)
 							return err;
@@ -1579,6 +1708,7 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 	codegen.stack_max = 0;
 	codegen.current_line = 0;
 	codegen.call_max = 0;
+	codegen.inline_cache_count = 0;
 	codegen.debug_stack = EngineDebugger::is_active();
 	Vector<StringName> argnames;
 
@@ -1763,6 +1893,11 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 	gdfunc->_argument_count = p_func ? p_func->arguments.size() : 0;
 	gdfunc->_stack_size = codegen.stack_max;
 	gdfunc->_call_size = codegen.call_max;
+	gdfunc->_inline_cache_count = codegen.inline_cache_count;
+	gdfunc->_inline_caches = codegen.inline_cache_count ? memnew_arr(GDScriptFunction::InlineCacheSlot, codegen.inline_cache_count) : NULL;
+	for (int i = 0; i < codegen.inline_cache_count; i++) {
+		gdfunc->_inline_caches[i].validated_type = codegen.inline_cache_validated_types[i];
+	}
 	gdfunc->name = func_name;
 #ifdef DEBUG_ENABLED
 	if (EngineDebugger::is_active()) {
@@ -1845,6 +1980,7 @@ Error GDScriptCompiler::_parse_class_level(GDScript *p_script, const GDScriptPar
 		memdelete(E->get());
 	}
 	p_script->member_functions.clear();
+	GDScriptFunction::invalidate_inline_caches(); //members and functions of a live script are about to change
 	p_script->member_indices.clear();
 	p_script->member_info.clear();
 	p_script->_signals.clear();
@@ -260,6 +260,30 @@ int GDScriptLanguage::debug_get_stack_level_count() const {
 
 	return _debug_call_stack_pos;
 }
+
+int GDScriptLanguage::debug_sample_call_stack(GDScriptFunction **r_functions, int p_max) const {
+
+	if (!_call_stack) {
+		return 0;
+	}
+
+	uint32_t version = _call_stack_version.load(std::memory_order_acquire);
+	if (version & 1) {
+		return -1;
+	}
+
+	int depth = MIN(_debug_call_stack_pos, p_max);
+	for (int i = 0; i < depth; i++) {
+		r_functions[i] = _call_stack[i].function;
+	}
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (_call_stack_version.load(std::memory_order_relaxed) != version) {
+		return -1;
+	}
+
+	return depth;
+}
 int GDScriptLanguage::debug_get_stack_level_line(int p_level) const {
 
 	if (_debug_parse_err_line >= 0)
@@ -30,9 +30,11 @@
 
 #include "gdscript_function.h"
 
+#include "core/core_string_names.h"
 #include "core/os/os.h"
 #include "gdscript.h"
 #include "gdscript_functions.h"
+#include "gdscript_sampler.h"
 
 Variant *GDScriptFunction::_get_variant(int p_address, GDScriptInstance *p_instance, GDScript *p_script, Variant &self, Variant &static_ref, Variant *p_stack, String &r_error) const {
 
@@ -160,6 +162,131 @@ static String _get_var_type(const Variant *p_var) {
 }
 #endif // DEBUG_ENABLED
 
+// Fast paths for the typed operator opcodes. They return false when the operands
+// are not of the expected types or the operation needs the error reporting of
+// Variant::evaluate (such as a division by zero), the caller then falls back to it.
+
+static _FORCE_INLINE_ bool _evaluate_int_operator(Variant::Operator p_op, const Variant &p_a, const Variant &p_b, Variant &r_dst) {
+
+	if (unlikely(p_a.get_type() != Variant::INT || p_b.get_type() != Variant::INT)) {
+		return false;
+	}
+
+	int64_t a = p_a;
+	int64_t b = p_b;
+
+	switch (p_op) {
+		case Variant::OP_ADD: r_dst = a + b; break;
+		case Variant::OP_SUBTRACT: r_dst = a - b; break;
+		case Variant::OP_MULTIPLY: r_dst = a * b; break;
+		case Variant::OP_DIVIDE: {
+			if (b == 0) {
+				return false;
+			}
+			r_dst = a / b;
+		} break;
+		case Variant::OP_MODULE: {
+			if (b == 0) {
+				return false;
+			}
+			r_dst = a % b;
+		} break;
+		case Variant::OP_NEGATE: r_dst = -a; break;
+		case Variant::OP_POSITIVE: r_dst = a; break;
+		case Variant::OP_BIT_AND: r_dst = a & b; break;
+		case Variant::OP_BIT_OR: r_dst = a | b; break;
+		case Variant::OP_BIT_XOR: r_dst = a ^ b; break;
+		case Variant::OP_BIT_NEGATE: r_dst = ~a; break;
+		case Variant::OP_EQUAL: r_dst = a == b; break;
+		case Variant::OP_NOT_EQUAL: r_dst = a != b; break;
+		case Variant::OP_LESS: r_dst = a < b; break;
+		case Variant::OP_LESS_EQUAL: r_dst = a <= b; break;
+		case Variant::OP_GREATER: r_dst = a > b; break;
+		case Variant::OP_GREATER_EQUAL: r_dst = a >= b; break;
+		default: return false;
+	}
+
+	return true;
+}
+
+static _FORCE_INLINE_ bool _evaluate_float_operator(Variant::Operator p_op, const Variant &p_a, const Variant &p_b, Variant &r_dst) {
+
+	Variant::Type type_a = p_a.get_type();
+	Variant::Type type_b = p_b.get_type();
+
+	//int with int must stay an int, so at least one side has to be a float
+	if (unlikely((type_a != Variant::FLOAT && type_a != Variant::INT) || (type_b != Variant::FLOAT && type_b != Variant::INT) || (type_a != Variant::FLOAT && type_b != Variant::FLOAT))) {
+		return false;
+	}
+
+	double a = p_a;
+	double b = p_b;
+
+	switch (p_op) {
+		case Variant::OP_ADD: r_dst = a + b; break;
+		case Variant::OP_SUBTRACT: r_dst = a - b; break;
+		case Variant::OP_MULTIPLY: r_dst = a * b; break;
+		case Variant::OP_DIVIDE: {
+			if (b == 0) {
+				return false;
+			}
+			r_dst = a / b;
+		} break;
+		case Variant::OP_NEGATE: r_dst = -a; break;
+		case Variant::OP_POSITIVE: r_dst = a; break;
+		case Variant::OP_EQUAL: r_dst = a == b; break;
+		case Variant::OP_NOT_EQUAL: r_dst = a != b; break;
+		case Variant::OP_LESS: r_dst = a < b; break;
+		case Variant::OP_LESS_EQUAL: r_dst = a <= b; break;
+		case Variant::OP_GREATER: r_dst = a > b; break;
+		case Variant::OP_GREATER_EQUAL: r_dst = a >= b; break;
+		default: return false;
+	}
+
+	return true;
+}
+
+template <class T>
+static _FORCE_INLINE_ bool _evaluate_vector_operator(Variant::Operator p_op, Variant::Type p_type, const Variant &p_a, const Variant &p_b, Variant &r_dst) {
+
+	if (unlikely(p_a.get_type() != p_type)) {
+		return false;
+	}
+
+	T a = p_a;
+	Variant::Type type_b = p_b.get_type();
+
+	if (type_b == p_type) {
+		T b = p_b;
+
+		switch (p_op) {
+			case Variant::OP_ADD: r_dst = a + b; break;
+			case Variant::OP_SUBTRACT: r_dst = a - b; break;
+			case Variant::OP_MULTIPLY: r_dst = a * b; break;
+			case Variant::OP_DIVIDE: r_dst = a / b; break;
+			case Variant::OP_NEGATE: r_dst = -a; break;
+			case Variant::OP_POSITIVE: r_dst = a; break;
+			case Variant::OP_EQUAL: r_dst = a == b; break;
+			case Variant::OP_NOT_EQUAL: r_dst = a != b; break;
+			default: return false;
+		}
+
+	} else if (type_b == Variant::FLOAT || type_b == Variant::INT) {
+		real_t b = p_b;
+
+		switch (p_op) {
+			case Variant::OP_MULTIPLY: r_dst = a * b; break;
+			case Variant::OP_DIVIDE: r_dst = a / b; break;
+			default: return false;
+		}
+
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
 String GDScriptFunction::_get_call_error(const Callable::CallError &p_err, const String &p_where, const Variant **argptrs) const {
 
 	String err_text;
@@ -190,10 +317,392 @@ String GDScriptFunction::_get_call_error(const Callable::CallError &p_err, const
 	return err_text;
 }
 
+std::atomic<uint32_t> GDScriptFunction::inline_cache_version(1);
+
+void GDScriptFunction::InlineCacheSlot::publish(const InlineCache &p_cache) {
+
+	uint32_t index = used.fetch_add(1, std::memory_order_relaxed);
+	if (index >= INLINE_CACHE_MAX_ENTRIES) {
+		return;
+	}
+
+	entries[index] = p_cache;
+	current.store(index + 1, std::memory_order_release);
+}
+
+// Returns the native accessor of a property when ClassDB::get_property/set_property
+// would end up calling it directly, null otherwise.
+static MethodBind *_get_native_property_accessor(const StringName &p_class, const StringName &p_property, bool p_setter) {
+
+	const ClassDB::ClassInfo *check = ClassDB::classes.getptr(p_class);
+	while (check) {
+		const ClassDB::PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			if (psg->index >= 0) {
+				return NULL; //indexed properties go through Object::call
+			}
+			return p_setter ? psg->_setptr : psg->_getptr;
+		}
+
+		if (!p_setter && (check->constant_map.has(p_property) || check->method_map.has(p_property) || check->signal_map.has(p_property))) {
+			return NULL;
+		}
+
+		check = check->inherits_ptr;
+	}
+
+	return NULL;
+}
+
+bool GDScriptFunction::_get_inline_cache_owner(const Variant *p_base, Object *&r_object, GDScriptInstance *&r_instance, ObjectID &r_script) const {
+
+	if (p_base->get_type() != Variant::OBJECT) {
+		return false;
+	}
+
+	r_object = p_base->operator Object *();
+	if (unlikely(!r_object)) {
+		return false;
+	}
+#ifdef DEBUG_ENABLED
+	//same check as the regular path, so freed instances still report the proper error
+	if (EngineDebugger::is_active() && !p_base->is_ref() && !p_base->get_validated_object()) {
+		return false;
+	}
+#endif
+
+	ScriptInstance *si = r_object->get_script_instance();
+	if (!si) {
+		r_instance = NULL;
+		r_script = ObjectID();
+		return true;
+	}
+
+	if (si->is_placeholder() || si->get_language() != GDScriptLanguage::get_singleton()) {
+		return false;
+	}
+
+	r_instance = static_cast<GDScriptInstance *>(si);
+	r_script = r_instance->script->get_instance_id();
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_call_builtin(InlineCacheSlot *p_slot, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, Callable::CallError &r_err) const {
+
+	Variant::Type type = p_base->get_type();
+	const InlineCache *cache = p_slot->get();
+	InlineCache resolved;
+
+	if (!cache || cache->kind != InlineCache::KIND_BUILTIN || cache->builtin_type != type) {
+
+		if (p_slot->is_full()) {
+			return false;
+		}
+
+		resolved.kind = InlineCache::KIND_BUILTIN;
+		resolved.builtin_type = type;
+		resolved.builtin_method = Variant::get_builtin_method_id(type, p_method);
+		if (resolved.builtin_method < 0) {
+			return false; //vararg methods of Callable and Signal
+		}
+		if (type == p_slot->validated_type) {
+			resolved.validated_method = Variant::get_validated_builtin_method(type, resolved.builtin_method);
+			resolved.builtin_arg_types = Variant::get_method_argument_types(type, p_method);
+		}
+
+		p_slot->publish(resolved);
+		cache = &resolved;
+	}
+
+	bool validated = cache->validated_method != nullptr;
+#ifdef DEBUG_ENABLED
+	//release builds trust the compiler, here mistakes still get reported by the regular path
+	if (validated) {
+		validated = p_argcount == cache->builtin_arg_types.size();
+		for (int i = 0; validated && i < p_argcount; i++) {
+			validated = cache->builtin_arg_types[i] == Variant::NIL || cache->builtin_arg_types[i] == p_args[i]->get_type();
+		}
+	}
+#endif
+
+	if (validated) {
+		Variant ret;
+		cache->validated_method(ret, *p_base, p_args);
+		r_err.error = Callable::CallError::CALL_OK;
+		if (r_ret) {
+			*r_ret = ret;
+		}
+	} else {
+		p_base->call_builtin(cache->builtin_method, p_args, p_argcount, r_ret, r_err);
+	}
+
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_call(InlineCacheSlot *p_slot, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, Callable::CallError &r_err) const {
+
+	if (p_base->get_type() != Variant::OBJECT) {
+		return _inline_cache_call_builtin(p_slot, p_base, p_method, p_args, p_argcount, r_ret, r_err);
+	}
+
+	Object *object;
+	GDScriptInstance *instance;
+	ObjectID script;
+	if (!_get_inline_cache_owner(p_base, object, instance, script)) {
+		return false;
+	}
+
+	const InlineCache *cache = p_slot->get();
+	InlineCache resolved;
+
+	if (!cache || cache->version != inline_cache_version.load(std::memory_order_relaxed) || cache->script != script || cache->class_name != object->get_class_name()) {
+
+		if (p_slot->is_full() || p_method == CoreStringNames::get_singleton()->_free) {
+			return false;
+		}
+
+		resolved.class_name = object->get_class_name();
+		resolved.script = script;
+		resolved.version = inline_cache_version.load(std::memory_order_relaxed);
+
+		const GDScript *sptr = instance ? instance->script.ptr() : NULL;
+		while (sptr) {
+			const Map<StringName, GDScriptFunction *>::Element *E = sptr->member_functions.find(p_method);
+			if (E) {
+				resolved.kind = InlineCache::KIND_FUNCTION;
+				resolved.function = E->get();
+				break;
+			}
+			sptr = sptr->_base;
+		}
+
+		if (!resolved.function) {
+			resolved.method = ClassDB::get_method(resolved.class_name, p_method);
+			if (!resolved.method) {
+				return false;
+			}
+		}
+
+		p_slot->publish(resolved);
+		cache = &resolved;
+	}
+
+	r_err.error = Callable::CallError::CALL_OK;
+
+	if (cache->kind == InlineCache::KIND_FUNCTION) {
+		Variant ret = cache->function->call(instance, p_args, p_argcount, r_err);
+		if (r_ret) {
+			*r_ret = ret;
+		}
+	} else {
+		Variant ret = cache->method->call(object, p_args, p_argcount, r_err);
+		if (r_ret) {
+			*r_ret = ret;
+		}
+	}
+
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_get(InlineCacheSlot *p_slot, const Variant *p_base, const StringName &p_name, Variant &r_ret) const {
+
+	Object *object;
+	GDScriptInstance *instance;
+	ObjectID script;
+	if (!_get_inline_cache_owner(p_base, object, instance, script)) {
+		return false;
+	}
+
+	const InlineCache *cache = p_slot->get();
+	InlineCache resolved;
+
+	if (!cache || cache->version != inline_cache_version.load(std::memory_order_relaxed) || cache->script != script || cache->class_name != object->get_class_name()) {
+
+		if (p_slot->is_full()) {
+			return false;
+		}
+
+		resolved.class_name = object->get_class_name();
+		resolved.script = script;
+		resolved.version = inline_cache_version.load(std::memory_order_relaxed);
+
+		if (instance) {
+			//only cache what GDScriptInstance::get resolves the same way every time
+			const GDScript *gdscript = instance->script.ptr();
+			const Map<StringName, GDScript::MemberInfo>::Element *E = gdscript->member_indices.find(p_name);
+			if (E) {
+				if (E->get().getter) {
+					return false;
+				}
+				resolved.kind = InlineCache::KIND_MEMBER;
+				resolved.member_index = E->get().index;
+			} else {
+				for (const GDScript *sptr = gdscript; sptr; sptr = sptr->_base) {
+					if (sptr->constants.has(p_name) || sptr->member_functions.has(GDScriptLanguage::get_singleton()->strings._get)) {
+						return false;
+					}
+				}
+			}
+		}
+
+		if (resolved.kind != InlineCache::KIND_MEMBER) {
+			resolved.method = _get_native_property_accessor(resolved.class_name, p_name, false);
+			if (!resolved.method) {
+				return false;
+			}
+		}
+
+		p_slot->publish(resolved);
+		cache = &resolved;
+	}
+
+	if (cache->kind == InlineCache::KIND_MEMBER) {
+		r_ret = instance->members[cache->member_index];
+	} else {
+		Callable::CallError ce;
+		r_ret = cache->method->call(object, NULL, 0, ce);
+	}
+
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_set(InlineCacheSlot *p_slot, const Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid) const {
+
+	Object *object;
+	GDScriptInstance *instance;
+	ObjectID script;
+	if (!_get_inline_cache_owner(p_base, object, instance, script)) {
+		return false;
+	}
+#ifdef TOOLS_ENABLED
+	//Object::set marks the object as edited, let it do so the first time
+	if (!object->is_edited()) {
+		return false;
+	}
+#endif
+
+	const InlineCache *cache = p_slot->get();
+	InlineCache resolved;
+
+	if (!cache || cache->version != inline_cache_version.load(std::memory_order_relaxed) || cache->script != script || cache->class_name != object->get_class_name()) {
+
+		if (p_slot->is_full()) {
+			return false;
+		}
+
+		resolved.class_name = object->get_class_name();
+		resolved.script = script;
+		resolved.version = inline_cache_version.load(std::memory_order_relaxed);
+
+		if (instance) {
+			//only cache what GDScriptInstance::set resolves the same way every time
+			const GDScript *gdscript = instance->script.ptr();
+			const Map<StringName, GDScript::MemberInfo>::Element *E = gdscript->member_indices.find(p_name);
+			if (E) {
+				if (E->get().setter) {
+					return false;
+				}
+				resolved.kind = InlineCache::KIND_MEMBER;
+				resolved.member_index = E->get().index;
+				resolved.member_type = E->get().data_type;
+			} else {
+				for (const GDScript *sptr = gdscript; sptr; sptr = sptr->_base) {
+					if (sptr->member_functions.has(GDScriptLanguage::get_singleton()->strings._set)) {
+						return false;
+					}
+				}
+			}
+		}
+
+		if (resolved.kind != InlineCache::KIND_MEMBER) {
+			resolved.method = _get_native_property_accessor(resolved.class_name, p_name, true);
+			if (!resolved.method) {
+				return false;
+			}
+		}
+
+		p_slot->publish(resolved);
+		cache = &resolved;
+	}
+
+	if (cache->kind == InlineCache::KIND_MEMBER) {
+		if (!cache->member_type.is_type(p_value)) {
+			return false; //needs a conversion, left to GDScriptInstance::set
+		}
+		instance->members.write[cache->member_index] = p_value;
+		r_valid = true;
+	} else {
+		Callable::CallError ce;
+		const Variant *arg[1] = { &p_value };
+		cache->method->call(object, arg, 1, ce);
+		r_valid = ce.error == Callable::CallError::CALL_OK;
+	}
+
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_get_member(InlineCacheSlot *p_slot, Object *p_owner, const StringName &p_name, Variant &r_ret) const {
+
+	const InlineCache *cache = p_slot->get();
+	InlineCache resolved;
+
+	if (!cache || cache->class_name != p_owner->get_class_name()) {
+
+		if (p_slot->is_full()) {
+			return false;
+		}
+
+		resolved.class_name = p_owner->get_class_name();
+		resolved.method = _get_native_property_accessor(resolved.class_name, p_name, false);
+		if (!resolved.method) {
+			return false;
+		}
+
+		p_slot->publish(resolved);
+		cache = &resolved;
+	}
+
+	Callable::CallError ce;
+	r_ret = cache->method->call(p_owner, NULL, 0, ce);
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_set_member(InlineCacheSlot *p_slot, Object *p_owner, const StringName &p_name, const Variant &p_value, bool &r_valid) const {
+
+	const InlineCache *cache = p_slot->get();
+	InlineCache resolved;
+
+	if (!cache || cache->class_name != p_owner->get_class_name()) {
+
+		if (p_slot->is_full()) {
+			return false;
+		}
+
+		resolved.class_name = p_owner->get_class_name();
+		resolved.method = _get_native_property_accessor(resolved.class_name, p_name, true);
+		if (!resolved.method) {
+			return false;
+		}
+
+		p_slot->publish(resolved);
+		cache = &resolved;
+	}
+
+	Callable::CallError ce;
+	const Variant *arg[1] = { &p_value };
+	cache->method->call(p_owner, arg, 1, ce);
+	r_valid = ce.error == Callable::CallError::CALL_OK;
+	return true;
+}
+
 #if defined(__GNUC__)
 #define OPCODES_TABLE                         \
 	static const void *switch_table_ops[] = { \
 		&&OPCODE_OPERATOR,                    \
+		&&OPCODE_OPERATOR_INT,                \
+		&&OPCODE_OPERATOR_FLOAT,              \
+		&&OPCODE_OPERATOR_VECTOR2,            \
+		&&OPCODE_OPERATOR_VECTOR3,            \
 		&&OPCODE_EXTENDS_TEST,                \
 		&&OPCODE_IS_BUILTIN,                  \
 		&&OPCODE_SET,                         \
@@ -286,6 +795,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	GDScript *script;
 	int ip = 0;
 	int line = _initial_line;
+	bool stack_moved = false; //handed over to a function state on yield
 
 	if (p_state) {
 		//use existing (supplied) state (yielded)
@@ -445,6 +955,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		OPCODE_SWITCH(_code_ptr[ip]) {
 
 			OPCODE(OPCODE_OPERATOR) {
+			generic_operator:
 
 				CHECK_SPACE(5);
 
@@ -481,6 +992,74 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_INT) {
+
+				CHECK_SPACE(5);
+
+				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+
+				if (unlikely(!_evaluate_int_operator(op, *a, *b, *dst))) {
+					goto generic_operator;
+				}
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_FLOAT) {
+
+				CHECK_SPACE(5);
+
+				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+
+				if (unlikely(!_evaluate_float_operator(op, *a, *b, *dst))) {
+					goto generic_operator;
+				}
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VECTOR2) {
+
+				CHECK_SPACE(5);
+
+				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+
+				if (unlikely(!_evaluate_vector_operator<Vector2>(op, Variant::VECTOR2, *a, *b, *dst))) {
+					goto generic_operator;
+				}
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VECTOR3) {
+
+				CHECK_SPACE(5);
+
+				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+
+				if (unlikely(!_evaluate_vector_operator<Vector3>(op, Variant::VECTOR3, *a, *b, *dst))) {
+					goto generic_operator;
+				}
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_EXTENDS_TEST) {
 
 				CHECK_SPACE(4);
@@ -640,7 +1219,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 			OPCODE(OPCODE_SET_NAMED) {
 
-				CHECK_SPACE(3);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(dst, 1);
 				GET_VARIANT_PTR(value, 3);
@@ -650,8 +1229,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_index = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_cache_count);
+
 				bool valid;
-				dst->set_named(*index, *value, &valid);
+				if (!_inline_cache_set(&_inline_caches[cache_index], dst, *index, *value, valid)) {
+					dst->set_named(*index, *value, &valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -660,29 +1244,38 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
 
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 1);
-				GET_VARIANT_PTR(dst, 3);
+				GET_VARIANT_PTR(dst, 4);
 
 				int indexname = _code_ptr[ip + 2];
 
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
+				int cache_index = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_cache_count);
+				InlineCacheSlot *cache = &_inline_caches[cache_index];
+
+				bool valid = true;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, &valid);
+				Variant ret;
+				if (!_inline_cache_get(cache, src, *index, ret)) {
+					ret = src->get_named(*index, &valid);
+				}
 
 #else
-				*dst = src->get_named(*index, &valid);
+				if (!_inline_cache_get(cache, src, *index, *dst)) {
+					*dst = src->get_named(*index, &valid);
+				}
 #endif
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -695,23 +1288,28 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_MEMBER) {
 
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 				int indexname = _code_ptr[ip + 1];
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 				GET_VARIANT_PTR(src, 2);
 
+				int cache_index = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_cache_count);
+
 				bool valid;
 #ifndef DEBUG_ENABLED
-				ClassDB::set_property(p_instance->owner, *index, *src, &valid);
+				if (!_inline_cache_set_member(&_inline_caches[cache_index], p_instance->owner, *index, *src, valid)) {
+					ClassDB::set_property(p_instance->owner, *index, *src, &valid);
+				}
 #else
-				bool ok = ClassDB::set_property(p_instance->owner, *index, *src, &valid);
+				bool ok = _inline_cache_set_member(&_inline_caches[cache_index], p_instance->owner, *index, *src, valid) || ClassDB::set_property(p_instance->owner, *index, *src, &valid);
 				if (!ok) {
 					err_text = "Internal error setting property: " + String(*index);
 					OPCODE_BREAK;
@@ -720,28 +1318,33 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_MEMBER) {
 
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 				int indexname = _code_ptr[ip + 1];
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 				GET_VARIANT_PTR(dst, 2);
 
+				int cache_index = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_cache_count);
+
 #ifndef DEBUG_ENABLED
-				ClassDB::get_property(p_instance->owner, *index, *dst);
+				if (!_inline_cache_get_member(&_inline_caches[cache_index], p_instance->owner, *index, *dst)) {
+					ClassDB::get_property(p_instance->owner, *index, *dst);
+				}
 #else
-				bool ok = ClassDB::get_property(p_instance->owner, *index, *dst);
+				bool ok = _inline_cache_get_member(&_inline_caches[cache_index], p_instance->owner, *index, *dst) || ClassDB::get_property(p_instance->owner, *index, *dst);
 				if (!ok) {
 					err_text = "Internal error getting property: " + String(*index);
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -1064,18 +1667,20 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_CALL_RETURN)
 			OPCODE(OPCODE_CALL) {
 
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 				bool call_ret = _code_ptr[ip] == OPCODE_CALL_RETURN;
 
 				int argc = _code_ptr[ip + 1];
-				GET_VARIANT_PTR(base, 2);
-				int nameg = _code_ptr[ip + 3];
+				int cache_index = _code_ptr[ip + 2];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_cache_count);
+				GET_VARIANT_PTR(base, 3);
+				int nameg = _code_ptr[ip + 4];
 
 				GD_ERR_BREAK(nameg < 0 || nameg >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[nameg];
 
 				GD_ERR_BREAK(argc < 0);
-				ip += 4;
+				ip += 5;
 				CHECK_SPACE(argc + 1);
 				Variant **argptrs = call_args;
 
@@ -1093,13 +1698,15 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 #endif
 				Callable::CallError err;
+				Variant *ret = NULL;
 				if (call_ret) {
 
-					GET_VARIANT_PTR(ret, argc);
-					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
-				} else {
+					GET_VARIANT_PTR(dst, argc);
+					ret = dst;
+				}
 
-					base->call_ptr(*methodname, (const Variant **)argptrs, argc, NULL, err);
+				if (!_inline_cache_call(&_inline_caches[cache_index], base, *methodname, (const Variant **)argptrs, argc, ret, err)) {
+					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
 				}
 #ifdef DEBUG_ENABLED
 				if (GDScriptLanguage::get_singleton()->profiling) {
@@ -1277,11 +1884,18 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 				gdfs->function = this;
 
-				gdfs->state.stack.resize(alloca_size);
-				//copy variant stack
-				for (int i = 0; i < _stack_size; i++) {
-					memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+				if (p_state) {
+					//resuming already runs on a state's stack, pass the buffer along
+					gdfs->state.stack = p_state->stack;
+					p_state->stack = Vector<uint8_t>();
+				} else {
+					//variants are relocatable, so move them out of the alloca stack instead of copying
+					gdfs->state.stack.resize(alloca_size);
+					if (_stack_size) {
+						memcpy(gdfs->state.stack.ptrw(), stack, sizeof(Variant) * _stack_size);
+					}
 				}
+				stack_moved = true;
 				gdfs->state.stack_size = _stack_size;
 				gdfs->state.self = self;
 				gdfs->state.alloca_size = alloca_size;
@@ -1332,7 +1946,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						OPCODE_BREAK;
 					}
 
-					Error err = obj->connect_compat(signal, gdfs.ptr(), "_signal_callback", varray(gdfs), Object::CONNECT_ONESHOT);
+					Error err = obj->connect(signal, Callable(memnew(GDScriptFunctionStateCallable(gdfs))), Vector<Variant>(), Object::CONNECT_ONESHOT);
 					if (err != OK) {
 						err_text = "Error connecting to signal: " + signal + " during yield().";
 						OPCODE_BREAK;
@@ -1341,7 +1955,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Object *obj = argobj->operator Object *();
 					String signal = argname->operator String();
 
-					obj->connect_compat(signal, gdfs.ptr(), "_signal_callback", varray(gdfs), Object::CONNECT_ONESHOT);
+					obj->connect(signal, Callable(memnew(GDScriptFunctionStateCallable(gdfs))), Vector<Variant>(), Object::CONNECT_ONESHOT);
 #endif
 				}
 
@@ -1626,7 +2240,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			GDScriptLanguage::get_singleton()->exit_function();
 #endif
 
-		if (_stack_size) {
+		if (_stack_size && !stack_moved) {
 			//free stack
 			for (int i = 0; i < _stack_size; i++)
 				stack[i].~Variant();
@@ -1764,6 +2378,8 @@ GDScriptFunction::GDScriptFunction() :
 
 	_stack_size = 0;
 	_call_size = 0;
+	_inline_caches = NULL;
+	_inline_cache_count = 0;
 	rpc_mode = MultiplayerAPI::RPC_MODE_DISABLED;
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -1789,35 +2405,47 @@ GDScriptFunction::GDScriptFunction() :
 }
 
 GDScriptFunction::~GDScriptFunction() {
+
+	if (_inline_caches) {
+		memdelete_arr(_inline_caches);
+	}
+
 #ifdef DEBUG_ENABLED
 
 	MutexLock lock(GDScriptLanguage::get_singleton()->lock);
 
 	GDScriptLanguage::get_singleton()->function_list.remove(&function_list);
+	if (GDScriptLanguage::get_singleton()->sampler) {
+		GDScriptLanguage::get_singleton()->sampler->function_freed(this);
+	}
 #endif
 }
 
 /////////////////////
 
+Variant GDScriptFunctionState::_get_signal_result(const Variant **p_args, int p_argcount) {
+
+	if (p_argcount == 0) {
+		return Variant();
+	} else if (p_argcount == 1) {
+		return *p_args[0];
+	}
+
+	Array args;
+	for (int i = 0; i < p_argcount; i++) {
+		args.push_back(*p_args[i]);
+	}
+	return args;
+}
+
 Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 
-	Variant arg;
 	r_error.error = Callable::CallError::CALL_OK;
 
 	if (p_argcount == 0) {
 		r_error.error = Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
 		r_error.argument = 1;
 		return Variant();
-	} else if (p_argcount == 1) {
-		//noooneee
-	} else if (p_argcount == 2) {
-		arg = *p_args[0];
-	} else {
-		Array extra_args;
-		for (int i = 0; i < p_argcount - 1; i++) {
-			extra_args.push_back(*p_args[i]);
-		}
-		arg = extra_args;
 	}
 
 	Ref<GDScriptFunctionState> self = *p_args[p_argcount - 1];
@@ -1829,7 +2457,55 @@ Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_ar
 		return Variant();
 	}
 
-	return resume(arg);
+	return resume(_get_signal_result(p_args, p_argcount - 1));
+}
+
+bool GDScriptFunctionStateCallable::_compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
+
+	return static_cast<const GDScriptFunctionStateCallable *>(p_a)->state == static_cast<const GDScriptFunctionStateCallable *>(p_b)->state;
+}
+
+bool GDScriptFunctionStateCallable::_compare_less(const CallableCustom *p_a, const CallableCustom *p_b) {
+
+	return static_cast<const GDScriptFunctionStateCallable *>(p_a)->state.ptr() < static_cast<const GDScriptFunctionStateCallable *>(p_b)->state.ptr();
+}
+
+uint32_t GDScriptFunctionStateCallable::hash() const {
+
+	return hash_djb2_one_64((uint64_t)state->get_instance_id());
+}
+
+String GDScriptFunctionStateCallable::get_as_text() const {
+
+	return "GDScriptFunctionState::resume";
+}
+
+CallableCustom::CompareEqualFunc GDScriptFunctionStateCallable::get_compare_equal_func() const {
+
+	return _compare_equal;
+}
+
+CallableCustom::CompareLessFunc GDScriptFunctionStateCallable::get_compare_less_func() const {
+
+	return _compare_less;
+}
+
+ObjectID GDScriptFunctionStateCallable::get_object() const {
+
+	return state->get_instance_id();
+}
+
+void GDScriptFunctionStateCallable::call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const {
+
+	r_call_error.error = Callable::CallError::CALL_OK;
+
+	//hold a reference, the oneshot connection owning this may go away while resuming
+	Ref<GDScriptFunctionState> s = state;
+	r_return_value = s->resume(GDScriptFunctionState::_get_signal_result(p_arguments, p_argcount));
+}
+
+GDScriptFunctionStateCallable::GDScriptFunctionStateCallable(const Ref<GDScriptFunctionState> &p_state) :
+		state(p_state) {
 }
 
 bool GDScriptFunctionState::is_valid(bool p_extended_check) const {
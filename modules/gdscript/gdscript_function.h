@@ -39,6 +39,8 @@
 #include "core/string_name.h"
 #include "core/variant.h"
 
+#include <atomic>
+
 class GDScriptInstance;
 class GDScript;
 
@@ -154,8 +156,13 @@ struct GDScriptDataType {
 
 class GDScriptFunction {
 public:
+	//operand layouts are also walked by GDScriptCompiledCache, keep both in sync
 	enum Opcode {
 		OPCODE_OPERATOR,
+		OPCODE_OPERATOR_INT, //same layout as OPCODE_OPERATOR, emitted when the compiler knows the operand types
+		OPCODE_OPERATOR_FLOAT,
+		OPCODE_OPERATOR_VECTOR2,
+		OPCODE_OPERATOR_VECTOR3,
 		OPCODE_EXTENDS_TEST,
 		OPCODE_IS_BUILTIN,
 		OPCODE_SET,
@@ -223,6 +230,7 @@ public:
 
 private:
 	friend class GDScriptCompiler;
+	friend class GDScriptCompiledCache;
 
 	StringName source;
 
@@ -265,10 +273,76 @@ private:
 
 	List<StackDebug> stack_debug;
 
+	// Monomorphic caches for the named access and call opcodes, each of these
+	// sites owns a slot. Entries are guarded by the receiver's class and script,
+	// and are never written again once published, so functions running on
+	// several threads at the same time only ever switch between whole entries.
+	// A site that keeps missing runs out of entries and stays uncached.
+
+	enum {
+		INLINE_CACHE_MAX_ENTRIES = 4
+	};
+
+	struct InlineCache {
+		enum Kind {
+			KIND_METHOD_BIND, // Native method, or native property accessor for named access.
+			KIND_FUNCTION,
+			KIND_MEMBER, // Script member variable without setter or getter.
+			KIND_BUILTIN, // Method of a builtin type, guarded by the type alone.
+		};
+
+		Kind kind = KIND_METHOD_BIND;
+		StringName class_name;
+		ObjectID script; // Not set when the receiver has no script.
+		uint32_t version = 0;
+		MethodBind *method = nullptr;
+		GDScriptFunction *function = nullptr;
+		int member_index = -1;
+		GDScriptDataType member_type;
+		Variant::Type builtin_type = Variant::NIL;
+		int builtin_method = -1;
+		Variant::ValidatedBuiltInMethod validated_method = nullptr; // Set when the compiler proved the arguments.
+		Vector<Variant::Type> builtin_arg_types;
+	};
+
+	struct InlineCacheSlot {
+		std::atomic<uint32_t> used;
+		std::atomic<uint32_t> current; // One past the published entry, zero when empty.
+		InlineCache entries[INLINE_CACHE_MAX_ENTRIES];
+		// Set by the compiler on builtin calls whose base and argument types it proved
+		// to match the method signature, calls on that base type then skip the checks.
+		Variant::Type validated_type = Variant::VARIANT_MAX;
+
+		const InlineCache *get() const {
+			uint32_t c = current.load(std::memory_order_acquire);
+			return c ? &entries[c - 1] : nullptr;
+		}
+		bool is_full() const { return used.load(std::memory_order_relaxed) >= INLINE_CACHE_MAX_ENTRIES; }
+		void publish(const InlineCache &p_cache);
+
+		InlineCacheSlot() :
+				used(0),
+				current(0) {}
+	};
+
+	InlineCacheSlot *_inline_caches;
+	int _inline_cache_count;
+
+	static std::atomic<uint32_t> inline_cache_version;
+
+	bool _get_inline_cache_owner(const Variant *p_base, Object *&r_object, GDScriptInstance *&r_instance, ObjectID &r_script) const;
+	bool _inline_cache_call(InlineCacheSlot *p_slot, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, Callable::CallError &r_err) const;
+	bool _inline_cache_call_builtin(InlineCacheSlot *p_slot, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, Callable::CallError &r_err) const;
+	bool _inline_cache_get(InlineCacheSlot *p_slot, const Variant *p_base, const StringName &p_name, Variant &r_ret) const;
+	bool _inline_cache_set(InlineCacheSlot *p_slot, const Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid) const;
+	bool _inline_cache_get_member(InlineCacheSlot *p_slot, Object *p_owner, const StringName &p_name, Variant &r_ret) const;
+	bool _inline_cache_set_member(InlineCacheSlot *p_slot, Object *p_owner, const StringName &p_name, const Variant &p_value, bool &r_valid) const;
+
 	_FORCE_INLINE_ Variant *_get_variant(int p_address, GDScriptInstance *p_instance, GDScript *p_script, Variant &self, Variant &static_ref, Variant *p_stack, String &r_error) const;
 	_FORCE_INLINE_ String _get_call_error(const Callable::CallError &p_err, const String &p_where, const Variant **argptrs) const;
 
 	friend class GDScriptLanguage;
+	friend class GDScriptSampler;
 
 	SelfList<GDScriptFunction> function_list;
 #ifdef DEBUG_ENABLED
@@ -321,6 +395,9 @@ public:
 	GDScript *get_script() const { return _script; }
 	StringName get_source() const { return source; }
 
+	// Called when compiled code is discarded while its script stays alive.
+	static void invalidate_inline_caches() { inline_cache_version.fetch_add(1, std::memory_order_relaxed); }
+
 	void debug_get_stack_member_state(int p_line, List<Pair<StringName, int>> *r_stackvars) const;
 
 	_FORCE_INLINE_ bool is_empty() const { return _code_size == 0; }
@@ -350,8 +427,10 @@ class GDScriptFunctionState : public Reference {
 
 	GDCLASS(GDScriptFunctionState, Reference);
 	friend class GDScriptFunction;
+	friend class GDScriptFunctionStateCallable;
 	GDScriptFunction *function;
 	GDScriptFunction::CallState state;
+	static Variant _get_signal_result(const Variant **p_args, int p_argcount);
 	Variant _signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Ref<GDScriptFunctionState> first_state;
 
@@ -365,4 +444,24 @@ public:
 	~GDScriptFunctionState();
 };
 
+// Connected by yield() to resume the state as soon as the signal is emitted,
+// without looking up "_signal_callback" and binding the state as an argument.
+class GDScriptFunctionStateCallable : public CallableCustom {
+
+	Ref<GDScriptFunctionState> state;
+
+	static bool _compare_equal(const CallableCustom *p_a, const CallableCustom *p_b);
+	static bool _compare_less(const CallableCustom *p_a, const CallableCustom *p_b);
+
+public:
+	virtual uint32_t hash() const;
+	virtual String get_as_text() const;
+	virtual CompareEqualFunc get_compare_equal_func() const;
+	virtual CompareLessFunc get_compare_less_func() const;
+	virtual ObjectID get_object() const;
+	virtual void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const;
+
+	GDScriptFunctionStateCallable(const Ref<GDScriptFunctionState> &p_state);
+};
+
 #endif // GDSCRIPT_FUNCTION_H
@@ -0,0 +1,220 @@
+/*************************************************************************/
+/*  gdscript_sampler.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#include "gdscript_sampler.h"
+
+#ifdef DEBUG_ENABLED
+
+#include "core/debugger/engine_debugger.h"
+#include "core/engine.h"
+#include "core/os/os.h"
+#include "gdscript.h"
+
+void GDScriptSampler::_thread_func(void *p_user) {
+
+	GDScriptSampler *sampler = (GDScriptSampler *)p_user;
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	GDScriptFunction *stack[MAX_SAMPLE_DEPTH];
+
+	while (!sampler->exit_thread.load()) {
+
+		OS::get_singleton()->delay_usec(sampler->interval_usec);
+
+		// Retry a few times when the stack changes while copied, skipping
+		// those would undercount code that calls many short functions.
+		int depth = -1;
+		for (int i = 0; i < 4 && depth < 0; i++) {
+			depth = language->debug_sample_call_stack(stack, MAX_SAMPLE_DEPTH);
+		}
+		if (depth < 0) {
+			continue;
+		}
+
+		MutexLock lock(sampler->mutex);
+
+		if (sampler->sample_depths.size() >= MAX_PENDING_SAMPLES) {
+			continue;
+		}
+
+		sampler->sample_depths.push_back(depth);
+		for (int i = 0; i < depth; i++) {
+			sampler->sample_functions.push_back(stack[i]);
+		}
+	}
+}
+
+int GDScriptSampler::_get_signature_id(const GDScriptFunction *p_function) {
+
+	if (!p_function) {
+		return -1; // Freed after it was sampled.
+	}
+
+	Map<const GDScriptFunction *, int>::Element *E = signature_ids.find(p_function);
+	if (E) {
+		return E->get();
+	}
+
+	int id = next_signature_id++;
+	signature_ids.insert(p_function, id);
+
+	Array msg;
+	msg.push_back(id);
+	msg.push_back(String(p_function->profile.signature));
+	EngineDebugger::get_singleton()->send_message("gdscript_sampler:function_signature", msg);
+
+	return id;
+}
+
+void GDScriptSampler::_write_node(uint32_t p_node, PackedInt32Array &r_tree, int &r_pos) const {
+
+	const Node &node = nodes[p_node];
+	int32_t *w = r_tree.ptrw();
+	w[r_pos++] = node.signature_id;
+	w[r_pos++] = node.count;
+	w[r_pos++] = node.child_count;
+
+	for (uint32_t child = node.first_child; child; child = nodes[child].next_sibling) {
+		_write_node(child, r_tree, r_pos);
+	}
+}
+
+void GDScriptSampler::toggle(bool p_enable, const Array &p_opts) {
+
+	if (thread) {
+		exit_thread.store(true);
+		Thread::wait_to_finish(thread);
+		memdelete(thread);
+		thread = nullptr;
+	}
+
+	MutexLock lock(mutex);
+
+	sample_functions.clear();
+	sample_depths.clear();
+	signature_ids.clear();
+	next_signature_id = 0;
+
+	if (!p_enable) {
+		return;
+	}
+
+	int frequency = p_opts.size() > 0 ? int(p_opts[0]) : int(DEFAULT_FREQUENCY);
+	interval_usec = 1000000 / CLAMP(frequency, 10, 10000);
+
+	exit_thread.store(false);
+	thread = Thread::create(_thread_func, this);
+}
+
+void GDScriptSampler::tick(float p_frame_time, float p_idle_time, float p_physics_time, float p_physics_frame_time) {
+
+	MutexLock lock(mutex);
+
+	// Fold the samples into a prefix tree, each node counts the samples that
+	// went through its stack.
+	nodes.clear();
+	nodes.push_back(Node());
+	nodes[0].count = sample_depths.size();
+
+	uint32_t ofs = 0;
+	for (uint32_t i = 0; i < sample_depths.size(); i++) {
+
+		uint32_t parent = 0;
+		for (uint32_t j = 0; j < sample_depths[i]; j++) {
+
+			int id = _get_signature_id(sample_functions[ofs + j]);
+
+			uint32_t child = nodes[parent].first_child;
+			while (child && nodes[child].signature_id != id) {
+				child = nodes[child].next_sibling;
+			}
+
+			if (!child) {
+				child = nodes.size();
+				Node node;
+				node.signature_id = id;
+				node.next_sibling = nodes[parent].first_child;
+				nodes.push_back(node);
+				nodes[parent].first_child = child;
+				nodes[parent].child_count++;
+			}
+
+			nodes[child].count++;
+			parent = child;
+		}
+		ofs += sample_depths[i];
+	}
+
+	sample_functions.clear();
+	sample_depths.clear();
+
+	// Three ints per node in depth first order: signature id, sample count
+	// and child count. The root stands for every sample, the ones that ran
+	// no script at all are its count minus the ones of its children.
+	PackedInt32Array tree;
+	tree.resize(nodes.size() * 3);
+	int pos = 0;
+	_write_node(0, tree, pos);
+
+	Array msg;
+	msg.push_back(Engine::get_singleton()->get_frames_drawn());
+	msg.push_back(p_frame_time);
+	msg.push_back(p_idle_time);
+	msg.push_back(p_physics_time);
+	msg.push_back(p_physics_frame_time);
+	msg.push_back(interval_usec);
+	msg.push_back(tree);
+	EngineDebugger::get_singleton()->send_message("gdscript_sampler:profile_frame", msg);
+}
+
+void GDScriptSampler::function_freed(const GDScriptFunction *p_function) {
+
+	MutexLock lock(mutex);
+
+	// A new function may get the same address, so forget this one entirely.
+	signature_ids.erase(p_function);
+	for (uint32_t i = 0; i < sample_functions.size(); i++) {
+		if (sample_functions[i] == p_function) {
+			sample_functions[i] = nullptr;
+		}
+	}
+}
+
+GDScriptSampler::GDScriptSampler() {
+
+	exit_thread.store(false);
+}
+
+GDScriptSampler::~GDScriptSampler() {
+
+	toggle(false, Array());
+}
+
+#endif // DEBUG_ENABLED
@@ -0,0 +1,97 @@
+/*************************************************************************/
+/*  gdscript_sampler.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#ifndef GDSCRIPT_SAMPLER_H
+#define GDSCRIPT_SAMPLER_H
+
+#ifdef DEBUG_ENABLED
+
+#include "core/local_vector.h"
+#include "core/map.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/variant.h"
+
+#include <atomic>
+
+class GDScriptFunction;
+
+// Statistical profiler, registered as the "gdscript_sampler" debugger profiler.
+// A thread of its own copies the call stack of the main thread at a fixed
+// rate, so calls run as fast as with profiling off. Every frame the samples
+// are folded into a tree of stacks with their hit count, which is what a flame
+// graph draws, and sent along with the frame times of the engine.
+class GDScriptSampler {
+
+	enum {
+		DEFAULT_FREQUENCY = 1000, // Samples per second.
+		MAX_SAMPLE_DEPTH = 128, // Deeper calls are counted in their caller.
+		MAX_PENDING_SAMPLES = 1 << 16, // Main thread stalled, stop collecting.
+	};
+
+	struct Node {
+		int signature_id = -1;
+		uint32_t count = 0;
+		uint32_t first_child = 0; // Zero is the root, which is never a child.
+		uint32_t next_sibling = 0;
+		uint32_t child_count = 0;
+	};
+
+	Thread *thread = nullptr;
+	std::atomic<bool> exit_thread;
+	uint32_t interval_usec = 1000000 / DEFAULT_FREQUENCY;
+
+	Mutex mutex;
+	LocalVector<GDScriptFunction *> sample_functions; // Frames of all pending samples, outermost first.
+	LocalVector<uint32_t> sample_depths;
+	Map<const GDScriptFunction *, int> signature_ids;
+	int next_signature_id = 0;
+
+	LocalVector<Node> nodes;
+
+	static void _thread_func(void *p_user);
+
+	int _get_signature_id(const GDScriptFunction *p_function);
+	void _write_node(uint32_t p_node, PackedInt32Array &r_tree, int &r_pos) const;
+
+public:
+	void toggle(bool p_enable, const Array &p_opts);
+	void tick(float p_frame_time, float p_idle_time, float p_physics_time, float p_physics_frame_time);
+
+	void function_freed(const GDScriptFunction *p_function);
+
+	GDScriptSampler();
+	~GDScriptSampler();
+};
+
+#endif // DEBUG_ENABLED
+
+#endif // GDSCRIPT_SAMPLER_H
@@ -776,6 +776,7 @@ Dictionary ExtendGDScriptParser::generate_api() const {
 
 Error ExtendGDScriptParser::parse(const String &p_code, const String &p_path) {
 	path = p_path;
+	code = p_code;
 	lines = p_code.split("\n");
 
 	Error err = GDScriptParser::parse(p_code, p_path.get_base_dir(), false, p_path, false, NULL, false);
@@ -253,6 +253,10 @@ void GDScriptLanguageProtocol::poll() {
 			}
 		}
 	}
+
+	if (_initialized) {
+		workspace->poll_pending_changes();
+	}
 }
 
 Error GDScriptLanguageProtocol::start(int p_port, const IP_Address &p_bind_ip) {
@@ -69,7 +69,9 @@ void GDScriptTextDocument::didChange(const Variant &p_param) {
 		evt.load(contentChanges[i]);
 		doc.text = evt.text;
 	}
-	sync_script_content(doc.uri, doc.text);
+	// Parsed later, so a burst of keystrokes only costs one parse.
+	String path = GDScriptLanguageProtocol::get_singleton()->get_workspace()->get_file_path(doc.uri);
+	GDScriptLanguageProtocol::get_singleton()->get_workspace()->queue_script_change(path, doc.text);
 }
 
 lsp::TextDocumentItem GDScriptTextDocument::load_document_item(const Variant &p_param) {
@@ -131,6 +133,7 @@ Array GDScriptTextDocument::documentSymbol(const Dictionary &p_params) {
 	String uri = params["uri"];
 	String path = GDScriptLanguageProtocol::get_singleton()->get_workspace()->get_file_path(uri);
 	Array arr;
+	GDScriptLanguageProtocol::get_singleton()->get_workspace()->flush_pending_change(path);
 	if (const Map<String, ExtendGDScriptParser *>::Element *parser = GDScriptLanguageProtocol::get_singleton()->get_workspace()->scripts.find(path)) {
 		Vector<lsp::DocumentedSymbolInformation> list;
 		parser->get()->get_symbols().symbol_tree_as_list(uri, list);
@@ -204,6 +207,7 @@ Array GDScriptTextDocument::completion(const Dictionary &p_params) {
 
 		arr = native_member_completions.duplicate();
 
+		GDScriptLanguageProtocol::get_singleton()->get_workspace()->flush_pending_changes();
 		for (Map<String, ExtendGDScriptParser *>::Element *E = GDScriptLanguageProtocol::get_singleton()->get_workspace()->scripts.front(); E; E = E->next()) {
 
 			ExtendGDScriptParser *script = E->get();
@@ -257,6 +261,7 @@ Dictionary GDScriptTextDocument::resolve(const Dictionary &p_params) {
 			}
 
 			if (!symbol) {
+				GDScriptLanguageProtocol::get_singleton()->get_workspace()->flush_pending_changes();
 				if (const Map<String, ExtendGDScriptParser *>::Element *E = GDScriptLanguageProtocol::get_singleton()->get_workspace()->scripts.find(class_name)) {
 					symbol = E->get()->get_member_symbol(member_name, inner_class_name);
 				}
@@ -144,6 +144,7 @@ void GDScriptWorkspace::list_script_files(const String &p_root_dir, List<String>
 }
 
 ExtendGDScriptParser *GDScriptWorkspace::get_parse_successed_script(const String &p_path) {
+	flush_pending_change(p_path);
 	const Map<String, ExtendGDScriptParser *>::Element *S = scripts.find(p_path);
 	if (!S) {
 		parse_local_script(p_path);
@@ -156,6 +157,7 @@ ExtendGDScriptParser *GDScriptWorkspace::get_parse_successed_script(const String
 }
 
 ExtendGDScriptParser *GDScriptWorkspace::get_parse_result(const String &p_path) {
+	flush_pending_change(p_path);
 	const Map<String, ExtendGDScriptParser *>::Element *S = parse_results.find(p_path);
 	if (!S) {
 		parse_local_script(p_path);
@@ -171,6 +173,7 @@ Array GDScriptWorkspace::symbol(const Dictionary &p_params) {
 	String query = p_params["query"];
 	Array arr;
 	if (!query.empty()) {
+		flush_pending_changes();
 		for (Map<String, ExtendGDScriptParser *>::Element *E = scripts.front(); E; E = E->next()) {
 			Vector<lsp::DocumentedSymbolInformation> script_symbols;
 			E->get()->get_symbols().symbol_tree_as_list(E->key(), script_symbols);
@@ -315,6 +318,15 @@ Error GDScriptWorkspace::initialize() {
 
 Error GDScriptWorkspace::parse_script(const String &p_path, const String &p_content) {
 
+	pending_changes.erase(p_path);
+
+	Map<String, ExtendGDScriptParser *>::Element *current = parse_results.find(p_path);
+	if (current && current->get()->get_code() == p_content) {
+		// Nothing changed since the last parse (e.g. didSave after didChange), diagnostics are already published.
+		const Map<String, ExtendGDScriptParser *>::Element *S = scripts.find(p_path);
+		return (S && S->get() == current->get()) ? OK : ERR_PARSE_ERROR;
+	}
+
 	ExtendGDScriptParser *parser = memnew(ExtendGDScriptParser);
 	Error err = parser->parse(p_content, p_path);
 	Map<String, ExtendGDScriptParser *>::Element *last_parser = parse_results.find(p_path);
@@ -338,6 +350,32 @@ Error GDScriptWorkspace::parse_script(const String &p_path, const String &p_cont
 	return err;
 }
 
+void GDScriptWorkspace::queue_script_change(const String &p_path, const String &p_content) {
+	pending_changes[p_path] = p_content;
+	last_change_msec = OS::get_singleton()->get_ticks_msec();
+}
+
+void GDScriptWorkspace::flush_pending_change(const String &p_path) {
+	Map<String, String>::Element *E = pending_changes.find(p_path);
+	if (E) {
+		String content = E->get();
+		parse_script(p_path, content);
+	}
+}
+
+void GDScriptWorkspace::flush_pending_changes() {
+	while (pending_changes.front()) {
+		flush_pending_change(pending_changes.front()->key());
+	}
+}
+
+void GDScriptWorkspace::poll_pending_changes() {
+	// Requests parse what they need when they need it, this only keeps diagnostics up to date once typing stops.
+	if (pending_changes.size() && OS::get_singleton()->get_ticks_msec() - last_change_msec >= LSP_REPARSE_DELAY_MSEC) {
+		flush_pending_changes();
+	}
+}
+
 Error GDScriptWorkspace::parse_local_script(const String &p_path) {
 	Error err;
 	String content = FileAccess::get_file_as_string(p_path, &err);
@@ -515,6 +553,7 @@ void GDScriptWorkspace::resolve_related_symbols(const lsp::TextDocumentPositionP
 			class_ptr = native_members.next(class_ptr);
 		}
 
+		flush_pending_changes();
 		for (Map<String, ExtendGDScriptParser *>::Element *E = scripts.front(); E; E = E->next()) {
 			const ExtendGDScriptParser *script = E->get();
 			const ClassMembers &members = script->get_members();
@@ -37,6 +37,8 @@
 #include "gdscript_extend_parser.h"
 #include "lsp.hpp"
 
+#define LSP_REPARSE_DELAY_MSEC 300
+
 class GDScriptWorkspace : public Reference {
 	GDCLASS(GDScriptWorkspace, Reference);
 
@@ -60,6 +62,10 @@ protected:
 
 	void list_script_files(const String &p_root_dir, List<String> &r_files);
 
+	// Edits not parsed yet, only the latest content of each file is kept.
+	Map<String, String> pending_changes;
+	uint64_t last_change_msec = 0;
+
 public:
 	String root;
 	String root_uri;
@@ -77,6 +83,11 @@ public:
 	Error parse_script(const String &p_path, const String &p_content);
 	Error parse_local_script(const String &p_path);
 
+	void queue_script_change(const String &p_path, const String &p_content);
+	void flush_pending_change(const String &p_path);
+	void flush_pending_changes();
+	void poll_pending_changes();
+
 	String get_file_path(const String &p_uri) const;
 	String get_file_uri(const String &p_path) const;
 
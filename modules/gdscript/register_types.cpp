@@ -35,6 +35,7 @@
 #include "core/os/dir_access.h"
 #include "core/os/file_access.h"
 #include "gdscript.h"
+#include "gdscript_compiled_cache.h"
 #include "gdscript_tokenizer.h"
 
 GDScriptLanguage *script_language_gd = NULL;
@@ -57,6 +58,20 @@ class EditorExportGDScript : public EditorExportPlugin {
 
 	GDCLASS(EditorExportGDScript, EditorExportPlugin);
 
+	Vector<uint8_t> _precompile(const String &p_path, const String &p_source, const Vector<uint8_t> &p_tokens) {
+
+		//compile a copy of its own, the one open in the editor may have unsaved changes
+		Ref<GDScript> script;
+		script.instance();
+		script->set_script_path(p_path);
+		script->set_source_code(p_source);
+		if (script->reload() != OK || !script->is_valid()) {
+			return Vector<uint8_t>();
+		}
+
+		return GDScriptCompiledCache::save(script, p_tokens);
+	}
+
 public:
 	virtual void _export_file(const String &p_path, const String &p_type, const Set<String> &p_features) {
 
@@ -81,6 +96,15 @@ public:
 		txt.parse_utf8((const char *)file.ptr(), file.size());
 		file = GDScriptTokenizerBuffer::parse_code_string(txt);
 
+		if (!file.empty() && script_mode == EditorExportPreset::MODE_SCRIPT_PRECOMPILED) {
+
+			//keeps the tokenized form if the script can't be saved compiled
+			Vector<uint8_t> compiled = _precompile(p_path, txt, file);
+			if (!compiled.empty()) {
+				file = compiled;
+			}
+		}
+
 		if (!file.empty()) {
 
 			if (script_mode == EditorExportPreset::MODE_SCRIPT_ENCRYPTED) {
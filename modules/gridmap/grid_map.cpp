@@ -32,6 +32,7 @@
 
 #include "core/io/marshalls.h"
 #include "core/message_queue.h"
+#include "core/thread_work_pool.h"
 #include "scene/3d/light_3d.h"
 #include "scene/resources/mesh_library.h"
 #include "scene/resources/surface_tool.h"
@@ -403,43 +404,10 @@ void GridMap::_octant_transform(const OctantKey &p_key) {
 	}
 }
 
-bool GridMap::_octant_update(const OctantKey &p_key) {
-	ERR_FAIL_COND_V(!octant_map.has(p_key), false);
-	Octant &g = *octant_map[p_key];
-	if (!g.dirty)
-		return false;
-
-	//erase body shapes
-	PhysicsServer3D::get_singleton()->body_clear_shapes(g.static_body);
-
-	//erase body shapes debug
-	if (g.collision_debug.is_valid()) {
-
-		RS::get_singleton()->mesh_clear(g.collision_debug);
-	}
-
-	//erase navigation
-	for (Map<IndexKey, Octant::NavMesh>::Element *E = g.navmesh_ids.front(); E; E = E->next()) {
-		NavigationServer3D::get_singleton()->free(E->get().region);
-	}
-	g.navmesh_ids.clear();
-
-	//erase multimeshes
-
-	for (int i = 0; i < g.multimesh_instances.size(); i++) {
-
-		RS::get_singleton()->free(g.multimesh_instances[i].instance);
-		RS::get_singleton()->free(g.multimesh_instances[i].multimesh);
-	}
-	g.multimesh_instances.clear();
+void GridMap::_octant_build(uint32_t p_index, OctantUpdateList *p_list) {
 
-	if (g.cells.size() == 0) {
-		//octant no longer needed
-		_octant_clean_up(p_key);
-		return true;
-	}
-
-	Vector<Vector3> col_debug;
+	OctantUpdate &u = p_list->updates[p_index];
+	const Octant &g = *u.octant;
 
 	/*
 	 * foreach item in this octant,
@@ -448,17 +416,20 @@ bool GridMap::_octant_update(const OctantKey &p_key) {
 	 */
 
 	Map<int, List<Pair<Transform, IndexKey>>> multimesh_items;
+	Vector3 ofs = _get_offset();
 
-	for (Set<IndexKey>::Element *E = g.cells.front(); E; E = E->next()) {
+	for (const Set<IndexKey>::Element *E = g.cells.front(); E; E = E->next()) {
 
-		ERR_CONTINUE(!cell_map.has(E->get()));
-		const Cell &c = cell_map[E->get()];
+		const Map<IndexKey, Cell>::Element *C = cell_map.find(E->get());
+		ERR_CONTINUE(!C);
+		const Cell &c = C->get();
 
-		if (!mesh_library.is_valid() || !mesh_library->has_item(c.item))
+		const Map<int, OctantItem>::Element *I = p_list->items.find(c.item);
+		if (!I)
 			continue;
+		const OctantItem &item = I->get();
 
 		Vector3 cellpos = Vector3(E->get().x, E->get().y, E->get().z);
-		Vector3 ofs = _get_offset();
 
 		Transform xform;
 
@@ -466,11 +437,7 @@ bool GridMap::_octant_update(const OctantKey &p_key) {
 		xform.set_origin(cellpos * cell_size + ofs);
 		xform.basis.scale(Vector3(cell_scale, cell_scale, cell_scale));
 		if (baked_meshes.size() == 0) {
-			if (mesh_library->get_item_mesh(c.item).is_valid()) {
-				if (!multimesh_items.has(c.item)) {
-					multimesh_items[c.item] = List<Pair<Transform, IndexKey>>();
-				}
-
+			if (item.mesh.is_valid()) {
 				Pair<Transform, IndexKey> p;
 				p.first = xform;
 				p.second = E->get();
@@ -478,80 +445,172 @@ bool GridMap::_octant_update(const OctantKey &p_key) {
 			}
 		}
 
-		Vector<MeshLibrary::ShapeData> shapes = mesh_library->get_item_shapes(c.item);
-		// add the item's shape at given xform to octant's static_body
-		for (int i = 0; i < shapes.size(); i++) {
-			// add the item's shape
-			if (!shapes[i].shape.is_valid())
+		// add the item's shapes at given xform, concave ones go into the octant's single concave shape
+		for (int i = 0; i < item.shapes.size(); i++) {
+			if (!item.shapes[i].shape.is_valid())
 				continue;
-			PhysicsServer3D::get_singleton()->body_add_shape(g.static_body, shapes[i].shape->get_rid(), xform * shapes[i].local_transform);
+
+			Transform shape_xform = xform * item.shapes[i].local_transform;
+			const Vector<Vector3> &faces = item.shape_faces[i];
+
+			if (faces.size()) {
+				int base = u.collision_faces.size();
+				u.collision_faces.resize(base + faces.size());
+				shape_xform.xform(faces.ptr(), u.collision_faces.ptrw() + base, faces.size());
+			} else {
+				MeshLibrary::ShapeData sd;
+				sd.shape = item.shapes[i].shape;
+				sd.local_transform = shape_xform;
+				u.shapes.push_back(sd);
+			}
+
 			if (g.collision_debug.is_valid()) {
-				shapes.write[i].shape->add_vertices_to_array(col_debug, xform * shapes[i].local_transform);
+				const Vector<Vector3> &lines = item.shape_debug_lines[i];
+				int base = u.collision_debug.size();
+				u.collision_debug.resize(base + lines.size());
+				shape_xform.xform(lines.ptr(), u.collision_debug.ptrw() + base, lines.size());
 			}
 		}
 
 		// add the item's navmesh at given xform to GridMap's Navigation ancestor
-		Ref<NavigationMesh> navmesh = mesh_library->get_item_navmesh(c.item);
-		if (navmesh.is_valid()) {
+		if (item.navmesh.is_valid()) {
 			Octant::NavMesh nm;
-			nm.xform = xform * mesh_library->get_item_navmesh_transform(c.item);
-
-			if (navigation) {
-				RID region = NavigationServer3D::get_singleton()->region_create();
-				NavigationServer3D::get_singleton()->region_set_navmesh(region, navmesh);
-				NavigationServer3D::get_singleton()->region_set_transform(region, navigation->get_global_transform() * nm.xform);
-				NavigationServer3D::get_singleton()->region_set_map(region, navigation->get_rid());
-				nm.region = region;
-			}
-			g.navmesh_ids[E->get()] = nm;
+			nm.xform = xform * item.navmesh_transform;
+			nm.navmesh = item.navmesh;
+			u.navmeshes[E->get()] = nm;
 		}
 	}
 
 	//update multimeshes, only if not baked
-	if (baked_meshes.size() == 0) {
+	for (Map<int, List<Pair<Transform, IndexKey>>>::Element *E = multimesh_items.front(); E; E = E->next()) {
+
+		OctantUpdate::MultimeshData md;
+		md.item = E->key();
+		md.buffer.resize(E->get().size() * 12);
+		float *w = md.buffer.ptrw();
+
+		int idx = 0;
+		for (List<Pair<Transform, IndexKey>>::Element *F = E->get().front(); F; F = F->next()) {
+
+			const Transform &t = F->get().first;
+			float *dataptr = &w[idx * 12];
+			for (int i = 0; i < 3; i++) {
+				dataptr[i * 4 + 0] = t.basis.elements[i][0];
+				dataptr[i * 4 + 1] = t.basis.elements[i][1];
+				dataptr[i * 4 + 2] = t.basis.elements[i][2];
+				dataptr[i * 4 + 3] = t.origin[i];
+			}
+#ifdef TOOLS_ENABLED
 
-		for (Map<int, List<Pair<Transform, IndexKey>>>::Element *E = multimesh_items.front(); E; E = E->next()) {
-			Octant::MultimeshInstance mmi;
+			Octant::MultimeshInstance::Item it;
+			it.index = idx;
+			it.transform = t;
+			it.key = F->get().second;
+			md.items.push_back(it);
+#endif
 
-			RID mm = RS::get_singleton()->multimesh_create();
-			RS::get_singleton()->multimesh_allocate(mm, E->get().size(), RS::MULTIMESH_TRANSFORM_3D);
-			RS::get_singleton()->multimesh_set_mesh(mm, mesh_library->get_item_mesh(E->key())->get_rid());
+			idx++;
+		}
 
-			int idx = 0;
-			for (List<Pair<Transform, IndexKey>>::Element *F = E->get().front(); F; F = F->next()) {
-				RS::get_singleton()->multimesh_instance_set_transform(mm, idx, F->get().first);
-#ifdef TOOLS_ENABLED
+		u.multimeshes.push_back(md);
+	}
+}
 
-				Octant::MultimeshInstance::Item it;
-				it.index = idx;
-				it.transform = F->get().first;
-				it.key = F->get().second;
-				mmi.items.push_back(it);
-#endif
+void GridMap::_octant_apply(OctantUpdate &p_update) {
 
-				idx++;
-			}
+	Octant &g = *p_update.octant;
 
-			RID instance = RS::get_singleton()->instance_create();
-			RS::get_singleton()->instance_set_base(instance, mm);
+	//erase body shapes
+	PhysicsServer3D::get_singleton()->body_clear_shapes(g.static_body);
 
-			if (is_inside_tree()) {
-				RS::get_singleton()->instance_set_scenario(instance, get_world()->get_scenario());
-				RS::get_singleton()->instance_set_transform(instance, get_global_transform());
-			}
+	//erase body shapes debug
+	if (g.collision_debug.is_valid()) {
+
+		RS::get_singleton()->mesh_clear(g.collision_debug);
+	}
+
+	if (p_update.collision_faces.size()) {
+		if (g.collision_shape.is_null()) {
+			g.collision_shape.instance();
+		}
+		g.collision_shape->set_faces(p_update.collision_faces);
+		PhysicsServer3D::get_singleton()->body_add_shape(g.static_body, g.collision_shape->get_rid());
+	} else {
+		g.collision_shape.unref();
+	}
+
+	for (int i = 0; i < p_update.shapes.size(); i++) {
+		PhysicsServer3D::get_singleton()->body_add_shape(g.static_body, p_update.shapes[i].shape->get_rid(), p_update.shapes[i].local_transform);
+	}
+
+	//navigation, keep the regions of cells that did not change
+	for (Map<IndexKey, Octant::NavMesh>::Element *E = p_update.navmeshes.front(); E; E = E->next()) {
+
+		Octant::NavMesh &nm = E->get();
+		Map<IndexKey, Octant::NavMesh>::Element *F = g.navmesh_ids.find(E->key());
+		if (F && F->get().navmesh == nm.navmesh && F->get().xform == nm.xform && (F->get().region.is_valid() || !navigation)) {
+			nm.region = F->get().region;
+			g.navmesh_ids.erase(F);
+			continue;
+		}
 
-			mmi.multimesh = mm;
-			mmi.instance = instance;
+		if (navigation) {
+			RID region = NavigationServer3D::get_singleton()->region_create();
+			NavigationServer3D::get_singleton()->region_set_navmesh(region, nm.navmesh);
+			NavigationServer3D::get_singleton()->region_set_transform(region, navigation->get_global_transform() * nm.xform);
+			NavigationServer3D::get_singleton()->region_set_map(region, navigation->get_rid());
+			nm.region = region;
+		}
+	}
 
-			g.multimesh_instances.push_back(mmi);
+	for (Map<IndexKey, Octant::NavMesh>::Element *E = g.navmesh_ids.front(); E; E = E->next()) {
+		if (E->get().region.is_valid()) {
+			NavigationServer3D::get_singleton()->free(E->get().region);
 		}
 	}
+	g.navmesh_ids = p_update.navmeshes;
+
+	//erase multimeshes
+
+	for (int i = 0; i < g.multimesh_instances.size(); i++) {
+
+		RS::get_singleton()->free(g.multimesh_instances[i].instance);
+		RS::get_singleton()->free(g.multimesh_instances[i].multimesh);
+	}
+	g.multimesh_instances.clear();
+
+	for (int i = 0; i < p_update.multimeshes.size(); i++) {
 
-	if (col_debug.size()) {
+		const OctantUpdate::MultimeshData &md = p_update.multimeshes[i];
+		Octant::MultimeshInstance mmi;
+
+		RID mm = RS::get_singleton()->multimesh_create();
+		RS::get_singleton()->multimesh_allocate(mm, md.buffer.size() / 12, RS::MULTIMESH_TRANSFORM_3D);
+		RS::get_singleton()->multimesh_set_mesh(mm, mesh_library->get_item_mesh(md.item)->get_rid());
+		RS::get_singleton()->multimesh_set_buffer(mm, md.buffer);
+#ifdef TOOLS_ENABLED
+		mmi.items = md.items;
+#endif
+
+		RID instance = RS::get_singleton()->instance_create();
+		RS::get_singleton()->instance_set_base(instance, mm);
+
+		if (is_inside_tree()) {
+			RS::get_singleton()->instance_set_scenario(instance, get_world()->get_scenario());
+			RS::get_singleton()->instance_set_transform(instance, get_global_transform());
+		}
+
+		mmi.multimesh = mm;
+		mmi.instance = instance;
+
+		g.multimesh_instances.push_back(mmi);
+	}
+
+	if (p_update.collision_debug.size()) {
 
 		Array arr;
 		arr.resize(RS::ARRAY_MAX);
-		arr[RS::ARRAY_VERTEX] = col_debug;
+		arr[RS::ARRAY_VERTEX] = p_update.collision_debug;
 
 		RS::get_singleton()->mesh_add_surface_from_arrays(g.collision_debug, RS::PRIMITIVE_LINES, arr);
 		SceneTree *st = SceneTree::get_singleton();
@@ -561,8 +620,6 @@ bool GridMap::_octant_update(const OctantKey &p_key) {
 	}
 
 	g.dirty = false;
-
-	return false;
 }
 
 void GridMap::_reset_physic_bodies_collision_filters() {
@@ -644,6 +701,7 @@ void GridMap::_octant_clean_up(const OctantKey &p_key) {
 		RS::get_singleton()->free(g.collision_debug_instance);
 
 	PhysicsServer3D::get_singleton()->free(g.static_body);
+	g.collision_shape.unref();
 
 	// Erase navigation
 	for (Map<IndexKey, Octant::NavMesh>::Element *E = g.navmesh_ids.front(); E; E = E->next()) {
@@ -795,16 +853,75 @@ void GridMap::_update_octants_callback() {
 		return;
 
 	List<OctantKey> to_delete;
+	OctantUpdateList list;
+	SceneTree *st = SceneTree::get_singleton();
+	bool debug_collisions = st && st->is_debugging_collisions_hint();
+
 	for (Map<OctantKey, Octant *>::Element *E = octant_map.front(); E; E = E->next()) {
 
-		if (_octant_update(E->key())) {
+		Octant *g = E->get();
+		if (!g->dirty)
+			continue;
+
+		if (g->cells.size() == 0) {
+			//octant no longer needed
+			_octant_clean_up(E->key());
 			to_delete.push_back(E->key());
+			continue;
 		}
+
+		OctantUpdate u;
+		u.key = E->key();
+		u.octant = g;
+		list.updates.push_back(u);
+
+		if (!mesh_library.is_valid())
+			continue;
+
+		//resources are only read here, the threads just place what they return
+		for (Set<IndexKey>::Element *F = g->cells.front(); F; F = F->next()) {
+
+			const Map<IndexKey, Cell>::Element *C = cell_map.find(F->get());
+			if (!C || list.items.has(C->get().item) || !mesh_library->has_item(C->get().item))
+				continue;
+
+			int item_id = C->get().item;
+			OctantItem item;
+			item.mesh = mesh_library->get_item_mesh(item_id);
+			item.shapes = mesh_library->get_item_shapes(item_id);
+			item.shape_faces.resize(item.shapes.size());
+			item.shape_debug_lines.resize(item.shapes.size());
+			for (int i = 0; i < item.shapes.size(); i++) {
+				Ref<ConcavePolygonShape3D> concave = item.shapes[i].shape;
+				if (concave.is_valid()) {
+					item.shape_faces.write[i] = concave->get_faces();
+				}
+				if (item.shapes[i].shape.is_valid() && debug_collisions) {
+					item.shape_debug_lines.write[i] = item.shapes.write[i].shape->get_debug_mesh_lines();
+				}
+			}
+			item.navmesh = mesh_library->get_item_navmesh(item_id);
+			item.navmesh_transform = mesh_library->get_item_navmesh_transform(item_id);
+			list.items[item_id] = item;
+		}
+	}
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0 && list.updates.size() > 1) {
+		pool->do_work(list.updates.size(), this, &GridMap::_octant_build, &list);
+	} else {
+		for (uint32_t i = 0; i < list.updates.size(); i++) {
+			_octant_build(i, &list);
+		}
+	}
+
+	for (uint32_t i = 0; i < list.updates.size(); i++) {
+		_octant_apply(list.updates[i]);
 	}
 
-	while (to_delete.front()) {
-		octant_map.erase(to_delete.front()->get());
-		to_delete.pop_back();
+	for (List<OctantKey>::Element *E = to_delete.front(); E; E = E->next()) {
+		memdelete(octant_map[E->get()]);
+		octant_map.erase(E->get());
 	}
 
 	_update_visibility();
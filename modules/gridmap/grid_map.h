@@ -31,8 +31,10 @@
 #ifndef GRID_MAP_H
 #define GRID_MAP_H
 
+#include "core/local_vector.h"
 #include "scene/3d/navigation_3d.h"
 #include "scene/3d/node_3d.h"
+#include "scene/resources/concave_polygon_shape_3d.h"
 #include "scene/resources/mesh_library.h"
 #include "scene/resources/multimesh.h"
 
@@ -93,6 +95,7 @@ class GridMap : public Node3D {
 		struct NavMesh {
 			RID region;
 			Transform xform;
+			Ref<NavigationMesh> navmesh;
 		};
 
 		struct MultimeshInstance {
@@ -114,6 +117,7 @@ class GridMap : public Node3D {
 
 		bool dirty;
 		RID static_body;
+		Ref<ConcavePolygonShape3D> collision_shape; //concave shapes of all cells, merged
 		Map<IndexKey, NavMesh> navmesh_ids;
 	};
 
@@ -180,7 +184,43 @@ class GridMap : public Node3D {
 	void _reset_physic_bodies_collision_filters();
 	void _octant_enter_world(const OctantKey &p_key);
 	void _octant_exit_world(const OctantKey &p_key);
-	bool _octant_update(const OctantKey &p_key);
+
+	//what an octant needs from each item, fetched once per update so octants can be built on threads
+	struct OctantItem {
+		Ref<Mesh> mesh;
+		Vector<MeshLibrary::ShapeData> shapes;
+		Vector<Vector<Vector3>> shape_faces; //only for concave shapes, merged into the octant shape
+		Vector<Vector<Vector3>> shape_debug_lines;
+		Ref<NavigationMesh> navmesh;
+		Transform navmesh_transform;
+	};
+
+	struct OctantUpdate {
+		OctantKey key;
+		Octant *octant;
+
+		struct MultimeshData {
+			int item;
+			Vector<float> buffer;
+#ifdef TOOLS_ENABLED
+			Vector<Octant::MultimeshInstance::Item> items;
+#endif
+		};
+
+		Vector<MultimeshData> multimeshes;
+		Vector<Vector3> collision_faces;
+		Vector<MeshLibrary::ShapeData> shapes; //can't be merged, local_transform is relative to the GridMap
+		Vector<Vector3> collision_debug;
+		Map<IndexKey, Octant::NavMesh> navmeshes;
+	};
+
+	struct OctantUpdateList {
+		LocalVector<OctantUpdate> updates;
+		Map<int, OctantItem> items;
+	};
+
+	void _octant_build(uint32_t p_index, OctantUpdateList *p_list);
+	void _octant_apply(OctantUpdate &p_update);
 	void _octant_clean_up(const OctantKey &p_key);
 	void _octant_transform(const OctantKey &p_key);
 	bool awaiting_update;
@@ -36,11 +36,26 @@
 #include <jpgd.h>
 #include <string.h>
 
-Error jpeg_load_image_from_buffer(Image *p_image, const uint8_t *p_buffer, int p_buffer_len) {
+// Feeds the decoder straight from the file, so the compressed data is never read into memory as a whole.
+class JPGDFileStream : public jpgd::jpeg_decoder_stream {
 
-	jpgd::jpeg_decoder_mem_stream mem_stream(p_buffer, p_buffer_len);
+	FileAccess *file;
+
+public:
+	virtual int read(jpgd::uint8 *p_buf, int p_max_bytes_to_read, bool *r_eof_flag) {
+		int read = file->get_buffer(p_buf, p_max_bytes_to_read);
+		*r_eof_flag = file->eof_reached();
+		return read;
+	}
+
+	JPGDFileStream(FileAccess *p_file) {
+		file = p_file;
+	}
+};
+
+static Error jpeg_load_image_from_stream(Image *p_image, jpgd::jpeg_decoder_stream *p_stream) {
 
-	jpgd::jpeg_decoder decoder(&mem_stream);
+	jpgd::jpeg_decoder decoder(p_stream);
 
 	if (decoder.get_error_code() != jpgd::JPGD_SUCCESS) {
 		return ERR_CANT_OPEN;
@@ -101,20 +116,21 @@ Error jpeg_load_image_from_buffer(Image *p_image, const uint8_t *p_buffer, int p
 	return OK;
 }
 
-Error ImageLoaderJPG::load_image(Ref<Image> p_image, FileAccess *f, bool p_force_linear, float p_scale) {
+Error jpeg_load_image_from_buffer(Image *p_image, const uint8_t *p_buffer, int p_buffer_len) {
 
-	Vector<uint8_t> src_image;
-	int src_image_len = f->get_len();
-	ERR_FAIL_COND_V(src_image_len == 0, ERR_FILE_CORRUPT);
-	src_image.resize(src_image_len);
+	jpgd::jpeg_decoder_mem_stream mem_stream(p_buffer, p_buffer_len);
+	return jpeg_load_image_from_stream(p_image, &mem_stream);
+}
 
-	uint8_t *w = src_image.ptrw();
+Error ImageLoaderJPG::load_image(Ref<Image> p_image, FileAccess *f, bool p_force_linear, float p_scale) {
 
-	f->get_buffer(&w[0], src_image_len);
+	ERR_FAIL_COND_V(f->get_len() == 0, ERR_FILE_CORRUPT);
 
-	f->close();
+	//decode scanlines as the data is read, instead of reading the whole file first
+	JPGDFileStream file_stream(f);
+	Error err = jpeg_load_image_from_stream(p_image.ptr(), &file_stream);
 
-	Error err = jpeg_load_image_from_buffer(p_image.ptr(), w, src_image_len);
+	f->close();
 
 	return err;
 }
@@ -32,6 +32,7 @@
 #define CRYPTO_MBEDTLS_H
 
 #include "core/crypto/crypto.h"
+#include "core/os/mutex.h"
 #include "core/resource.h"
 
 #include <mbedtls/ctr_drbg.h>
@@ -45,6 +46,7 @@ class CryptoKeyMbedTLS : public CryptoKey {
 private:
 	mbedtls_pk_context pkey;
 	int locks;
+	Mutex handshake_mutex; // Private key operations are not thread safe (e.g. RSA blinding), serializes threaded handshakes.
 
 public:
 	static CryptoKey *create();
@@ -42,6 +42,15 @@ int PacketPeerMbedDTLS::bio_send(void *ctx, const unsigned char *buf, size_t len
 
 	ERR_FAIL_COND_V(sp == NULL, 0);
 
+	if (sp->queued_io) {
+		Vector<uint8_t> packet;
+		packet.resize(len);
+		copymem(packet.ptrw(), buf, len);
+		MutexLock lock(sp->queued_io_mutex);
+		sp->queued_out.push_back(packet);
+		return len;
+	}
+
 	Error err = sp->base->put_packet((const uint8_t *)buf, len);
 	if (err == ERR_BUSY) {
 		return MBEDTLS_ERR_SSL_WANT_WRITE;
@@ -59,6 +68,21 @@ int PacketPeerMbedDTLS::bio_recv(void *ctx, unsigned char *buf, size_t len) {
 
 	ERR_FAIL_COND_V(sp == NULL, 0);
 
+	{
+		// Packets received during a threaded handshake are read first, even once it completed.
+		MutexLock lock(sp->queued_io_mutex);
+		if (sp->queued_in.size()) {
+			const Vector<uint8_t> &packet = sp->queued_in.front()->get();
+			int size = MIN((int)len, packet.size());
+			copymem(buf, packet.ptr(), size);
+			sp->queued_in.pop_front();
+			return size;
+		}
+		if (sp->queued_io) {
+			return MBEDTLS_ERR_SSL_WANT_READ;
+		}
+	}
+
 	int pc = sp->base->get_available_packet_count();
 	if (pc == 0) {
 		return MBEDTLS_ERR_SSL_WANT_READ;
@@ -79,6 +103,10 @@ int PacketPeerMbedDTLS::bio_recv(void *ctx, unsigned char *buf, size_t len) {
 void PacketPeerMbedDTLS::_cleanup() {
 
 	ssl_ctx->clear();
+	queued_io = false;
+	handshake_step_needed = false;
+	queued_in.clear();
+	queued_out.clear();
 	base = Ref<PacketPeer>();
 	status = STATUS_DISCONNECTED;
 }
@@ -93,9 +121,69 @@ int PacketPeerMbedDTLS::_set_cookie() {
 	return mbedtls_ssl_set_client_transport_id(ssl_ctx->get_context(), client_id, 18);
 }
 
+void PacketPeerMbedDTLS::_flush_queued_io() {
+
+	MutexLock lock(queued_io_mutex);
+	while (queued_out.size()) {
+		const Vector<uint8_t> &packet = queued_out.front()->get();
+		Error err = base->put_packet(packet.ptr(), packet.size());
+		if (err == ERR_BUSY) {
+			break;
+		}
+		queued_out.pop_front();
+	}
+	while (base->get_available_packet_count() > 0) {
+		const uint8_t *buffer;
+		int buffer_size = 0;
+		if (base->get_packet(&buffer, buffer_size) != OK) {
+			break;
+		}
+		Vector<uint8_t> packet;
+		packet.resize(buffer_size);
+		copymem(packet.ptrw(), buffer, buffer_size);
+		queued_in.push_back(packet);
+	}
+}
+
+bool PacketPeerMbedDTLS::_step_threaded_handshake(int &r_ret) {
+
+	_flush_queued_io();
+	if (ssl_ctx->is_handshake_step_pending()) {
+		return false;
+	}
+
+	if (ssl_ctx->finish_handshake_step(r_ret)) {
+		_flush_queued_io(); // Send what the step produced right away.
+		if (r_ret != MBEDTLS_ERR_SSL_WANT_READ && r_ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+			return true;
+		}
+		handshake_step_needed = r_ret == MBEDTLS_ERR_SSL_WANT_WRITE;
+	}
+
+	// Only wake a worker when there is something for the next step to do.
+	bool has_input = false;
+	{
+		MutexLock lock(queued_io_mutex);
+		has_input = queued_in.size() > 0;
+	}
+	if (handshake_step_needed || has_input || mbedtls_timing_get_delay(&timer) > 0) {
+		handshake_step_needed = false;
+		ssl_ctx->start_handshake_step();
+	}
+	return false;
+}
+
 Error PacketPeerMbedDTLS::_do_handshake() {
 	int ret = 0;
-	while ((ret = mbedtls_ssl_handshake(ssl_ctx->get_context())) != 0) {
+	if (queued_io) {
+		if (!_step_threaded_handshake(ret)) {
+			return OK;
+		}
+	} else {
+		ret = mbedtls_ssl_handshake(ssl_ctx->get_context());
+	}
+
+	if (ret != 0) {
 		if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
 			if (ret != MBEDTLS_ERR_SSL_HELLO_VERIFY_REQUIRED) {
 				ERR_PRINT("TLS handshake error: " + itos(ret));
@@ -109,6 +197,7 @@ Error PacketPeerMbedDTLS::_do_handshake() {
 		return OK;
 	}
 
+	queued_io = false;
 	status = STATUS_CONNECTED;
 	return OK;
 }
@@ -128,6 +217,8 @@ Error PacketPeerMbedDTLS::connect_to_peer(Ref<PacketPeerUDP> p_base, bool p_vali
 	mbedtls_ssl_set_bio(ssl_ctx->get_context(), this, bio_send, bio_recv, NULL);
 	mbedtls_ssl_set_timer_cb(ssl_ctx->get_context(), &timer, mbedtls_timing_set_delay, mbedtls_timing_get_delay);
 
+	queued_io = ssl_ctx->can_thread_handshake();
+	handshake_step_needed = true;
 	status = STATUS_HANDSHAKING;
 
 	if ((ret = _do_handshake()) != OK) {
@@ -157,6 +248,8 @@ Error PacketPeerMbedDTLS::accept_peer(Ref<PacketPeerUDP> p_base, Ref<CryptoKey>
 	mbedtls_ssl_set_bio(ssl_ctx->get_context(), this, bio_send, bio_recv, NULL);
 	mbedtls_ssl_set_timer_cb(ssl_ctx->get_context(), &timer, mbedtls_timing_set_delay, mbedtls_timing_get_delay);
 
+	queued_io = ssl_ctx->can_thread_handshake();
+	handshake_step_needed = true;
 	status = STATUS_HANDSHAKING;
 
 	if ((ret = _do_handshake()) != OK) {
@@ -264,6 +357,8 @@ void PacketPeerMbedDTLS::disconnect_from_peer() {
 	if (status != STATUS_CONNECTED && status != STATUS_HANDSHAKING)
 		return;
 
+	ssl_ctx->wait_handshake_step(); // Don't pull the context from under a worker thread.
+
 	if (status == STATUS_CONNECTED) {
 		int ret = 0;
 		// Send SSL close notification, blocking, but ignore other errors.
@@ -55,6 +55,16 @@ private:
 	static int bio_send(void *ctx, const unsigned char *buf, size_t len);
 	void _cleanup();
 
+	// While a threaded handshake runs, the worker only sees these queues, poll() moves them to and from base.
+	bool queued_io = false;
+	bool handshake_step_needed = false;
+	Mutex queued_io_mutex;
+	List<Vector<uint8_t>> queued_in;
+	List<Vector<uint8_t>> queued_out;
+
+	void _flush_queued_io();
+	bool _step_threaded_handshake(int &r_ret);
+
 protected:
 	Ref<SSLContextMbedTLS> ssl_ctx;
 	mbedtls_timing_delay_context timer;
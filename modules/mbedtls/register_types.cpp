@@ -35,8 +35,12 @@
 #include "packet_peer_mbed_dtls.h"
 #include "stream_peer_mbedtls.h"
 
+#include "core/project_settings.h"
+
 void register_mbedtls_types() {
 
+	SSLContextMbedTLS::threaded_handshakes = GLOBAL_DEF("network/ssl/threaded_handshakes", false);
+
 	CryptoMbedTLS::initialize_crypto();
 	StreamPeerMbedTLS::initialize_ssl();
 	PacketPeerMbedDTLS::initialize_dtls();
@@ -176,6 +176,7 @@ Error SSLContextMbedTLS::init_client(int p_transport, int p_authmode, Ref<X509Ce
 }
 
 void SSLContextMbedTLS::clear() {
+	wait_handshake_step();
 	if (!inited)
 		return;
 	mbedtls_ssl_free(&ssl);
@@ -194,6 +195,65 @@ void SSLContextMbedTLS::clear() {
 	inited = false;
 }
 
+bool SSLContextMbedTLS::threaded_handshakes = false;
+
+void SSLContextMbedTLS::_handshake_step(int p_unused) {
+
+	// Keys and cookies can be shared by many server contexts, mbedtls is built without MBEDTLS_THREADING_C.
+	if (pkey.is_valid()) {
+		pkey->handshake_mutex.lock();
+	}
+	if (cookies.is_valid()) {
+		cookies->handshake_mutex.lock();
+	}
+
+	handshake_ret = mbedtls_ssl_handshake(&ssl);
+
+	if (cookies.is_valid()) {
+		cookies->handshake_mutex.unlock();
+	}
+	if (pkey.is_valid()) {
+		pkey->handshake_mutex.unlock();
+	}
+}
+
+bool SSLContextMbedTLS::can_thread_handshake() const {
+
+	// Without worker threads the task would only run when waited on.
+	return threaded_handshakes && ThreadWorkPool::get_singleton() && ThreadWorkPool::get_singleton()->get_thread_count() > 0;
+}
+
+void SSLContextMbedTLS::start_handshake_step() {
+
+	ERR_FAIL_COND(!inited);
+	ERR_FAIL_COND(handshake_task != ThreadWorkPool::INVALID_TASK_ID);
+	handshake_task = ThreadWorkPool::get_singleton()->add_task(this, &SSLContextMbedTLS::_handshake_step, 0);
+}
+
+bool SSLContextMbedTLS::is_handshake_step_pending() const {
+
+	return handshake_task != ThreadWorkPool::INVALID_TASK_ID && !ThreadWorkPool::get_singleton()->is_task_completed(handshake_task);
+}
+
+bool SSLContextMbedTLS::finish_handshake_step(int &r_ret) {
+
+	if (handshake_task == ThreadWorkPool::INVALID_TASK_ID) {
+		return false;
+	}
+	wait_handshake_step();
+	r_ret = handshake_ret;
+	return true;
+}
+
+void SSLContextMbedTLS::wait_handshake_step() {
+
+	if (handshake_task == ThreadWorkPool::INVALID_TASK_ID) {
+		return;
+	}
+	ThreadWorkPool::get_singleton()->wait_for_task(handshake_task);
+	handshake_task = ThreadWorkPool::INVALID_TASK_ID;
+}
+
 mbedtls_ssl_context *SSLContextMbedTLS::get_context() {
 	ERR_FAIL_COND_V(!inited, NULL);
 	return &ssl;
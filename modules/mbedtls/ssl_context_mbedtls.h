@@ -34,6 +34,8 @@
 #include "crypto_mbedtls.h"
 
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
+#include "core/thread_work_pool.h"
 
 #include "core/reference.h"
 
@@ -55,6 +57,7 @@ protected:
 	mbedtls_entropy_context entropy;
 	mbedtls_ctr_drbg_context ctr_drbg;
 	mbedtls_ssl_cookie_ctx cookie_ctx;
+	Mutex handshake_mutex; // Cookie checks update a shared HMAC context.
 
 public:
 	Error setup();
@@ -69,11 +72,27 @@ class SSLContextMbedTLS : public Reference {
 protected:
 	bool inited;
 
+	ThreadWorkPool::TaskID handshake_task = ThreadWorkPool::INVALID_TASK_ID;
+	int handshake_ret = 0;
+
+	void _handshake_step(int p_unused);
+
 	static PackedByteArray _read_file(String p_path);
 
 public:
 	static void print_mbedtls_error(int p_ret);
 
+	// Set from "network/ssl/threaded_handshakes".
+	static bool threaded_handshakes;
+
+	// Handshake steps on the ThreadWorkPool, so the expensive public key operations don't stall the caller.
+	// The peer must not touch the context until finish_handshake_step() returned the result.
+	bool can_thread_handshake() const;
+	void start_handshake_step();
+	bool is_handshake_step_pending() const;
+	bool finish_handshake_step(int &r_ret);
+	void wait_handshake_step();
+
 	Ref<X509CertificateMbedTLS> certs;
 	mbedtls_entropy_context entropy;
 	mbedtls_ctr_drbg_context ctr_drbg;
@@ -71,16 +71,69 @@ int StreamPeerMbedTLS::bio_recv(void *ctx, unsigned char *buf, size_t len) {
 	return got;
 }
 
+Mutex StreamPeerMbedTLS::session_mutex;
+Map<String, mbedtls_ssl_session *> StreamPeerMbedTLS::session_cache;
+
+void StreamPeerMbedTLS::_resume_session() {
+
+	MutexLock lock(session_mutex);
+	Map<String, mbedtls_ssl_session *>::Element *E = session_cache.find(session_key);
+	if (E) {
+		// A stale session just means a full handshake.
+		mbedtls_ssl_set_session(ssl_ctx->get_context(), E->get());
+	}
+}
+
+void StreamPeerMbedTLS::_store_session() {
+
+	mbedtls_ssl_session *session = memnew(mbedtls_ssl_session);
+	mbedtls_ssl_session_init(session);
+	if (mbedtls_ssl_get_session(ssl_ctx->get_context(), session) != 0) {
+		mbedtls_ssl_session_free(session);
+		memdelete(session);
+		return;
+	}
+
+	MutexLock lock(session_mutex);
+	Map<String, mbedtls_ssl_session *>::Element *E = session_cache.find(session_key);
+	if (E) {
+		mbedtls_ssl_session_free(E->get());
+		memdelete(E->get());
+		E->get() = session;
+		return;
+	}
+	if (session_cache.size() >= MAX_CACHED_SESSIONS) {
+		mbedtls_ssl_session_free(session_cache.front()->get());
+		memdelete(session_cache.front()->get());
+		session_cache.erase(session_cache.front());
+	}
+	session_cache[session_key] = session;
+}
+
 void StreamPeerMbedTLS::_cleanup() {
 
 	ssl_ctx->clear();
+	session_key = String();
 	base = Ref<StreamPeer>();
 	status = STATUS_DISCONNECTED;
 }
 
 Error StreamPeerMbedTLS::_do_handshake() {
 	int ret = 0;
-	while ((ret = mbedtls_ssl_handshake(ssl_ctx->get_context())) != 0) {
+	if (!blocking_handshake && ssl_ctx->can_thread_handshake()) {
+		// Steps run on a worker thread, poll() picks up their result.
+		if (ssl_ctx->is_handshake_step_pending()) {
+			return OK;
+		}
+		if (!ssl_ctx->finish_handshake_step(ret)) {
+			ssl_ctx->start_handshake_step();
+			return OK;
+		}
+	} else {
+		ret = mbedtls_ssl_handshake(ssl_ctx->get_context());
+	}
+
+	while (ret != 0) {
 		if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
 			// An error occurred.
 			ERR_PRINT("TLS handshake error: " + itos(ret));
@@ -95,9 +148,13 @@ Error StreamPeerMbedTLS::_do_handshake() {
 			// Will retry via poll later
 			return OK;
 		}
+		ret = mbedtls_ssl_handshake(ssl_ctx->get_context());
 	}
 
 	status = STATUS_CONNECTED;
+	if (session_key != String()) {
+		_store_session();
+	}
 	return OK;
 }
 
@@ -114,6 +171,12 @@ Error StreamPeerMbedTLS::connect_to_stream(Ref<StreamPeer> p_base, bool p_valida
 	mbedtls_ssl_set_hostname(ssl_ctx->get_context(), p_for_hostname.utf8().get_data());
 	mbedtls_ssl_set_bio(ssl_ctx->get_context(), this, bio_send, bio_recv, NULL);
 
+	Ref<StreamPeerTCP> tcp = base;
+	if (p_for_hostname != String() && tcp.is_valid()) {
+		session_key = p_for_hostname + ":" + itos(tcp->get_connected_port()) + (p_validate_certs ? "" : ":unverified");
+		_resume_session();
+	}
+
 	status = STATUS_HANDSHAKING;
 
 	if (_do_handshake() != OK) {
@@ -141,7 +204,6 @@ Error StreamPeerMbedTLS::accept_stream(Ref<StreamPeer> p_base, Ref<CryptoKey> p_
 		return FAILED;
 	}
 
-	status = STATUS_CONNECTED;
 	return OK;
 }
 Error StreamPeerMbedTLS::put_data(const uint8_t *p_data, int p_bytes) {
@@ -292,6 +354,8 @@ void StreamPeerMbedTLS::disconnect_from_stream() {
 	if (status != STATUS_CONNECTED && status != STATUS_HANDSHAKING)
 		return;
 
+	ssl_ctx->wait_handshake_step(); // Don't pull the context from under a worker thread.
+
 	Ref<StreamPeerTCP> tcp = base;
 	if (tcp.is_valid() && tcp->get_status() == StreamPeerTCP::STATUS_CONNECTED) {
 		// We are still connected on the socket, try to send close notify.
@@ -321,4 +385,11 @@ void StreamPeerMbedTLS::finalize_ssl() {
 
 	available = false;
 	_create = NULL;
+
+	MutexLock lock(session_mutex);
+	for (Map<String, mbedtls_ssl_session *>::Element *E = session_cache.front(); E; E = E->next()) {
+		mbedtls_ssl_session_free(E->get());
+		memdelete(E->get());
+	}
+	session_cache.clear();
 }
@@ -32,6 +32,7 @@
 #define STREAM_PEER_OPEN_SSL_H
 
 #include "core/io/stream_peer_ssl.h"
+#include "core/os/mutex.h"
 #include "ssl_context_mbedtls.h"
 
 class StreamPeerMbedTLS : public StreamPeerSSL {
@@ -47,6 +48,17 @@ private:
 	static int bio_send(void *ctx, const unsigned char *buf, size_t len);
 	void _cleanup();
 
+	// Client sessions of previous connections, keyed by host and port, so reconnecting can skip the full handshake.
+	enum {
+		MAX_CACHED_SESSIONS = 64
+	};
+	static Mutex session_mutex;
+	static Map<String, mbedtls_ssl_session *> session_cache;
+	String session_key;
+
+	void _resume_session();
+	void _store_session();
+
 protected:
 	Ref<SSLContextMbedTLS> ssl_ctx;
 
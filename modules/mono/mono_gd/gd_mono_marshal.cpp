@@ -1115,7 +1115,7 @@ MonoArray *PackedInt32Array_to_mono_array(const PackedInt32Array &p_array) {
 	MonoArray *ret = mono_array_new(mono_domain_get(), CACHED_CLASS_RAW(int32_t), length);
 
 	int32_t *dst = (int32_t *)mono_array_addr(ret, int32_t, 0);
-	memcpy(dst, src, length);
+	memcpy(dst, src, length * sizeof(int32_t));
 
 	return ret;
 }
@@ -1129,7 +1129,7 @@ PackedInt32Array mono_array_to_PackedInt32Array(MonoArray *p_array) {
 	int32_t *dst = ret.ptrw();
 
 	const int32_t *src = (const int32_t *)mono_array_addr(p_array, int32_t, 0);
-	memcpy(dst, src, length);
+	memcpy(dst, src, length * sizeof(int32_t));
 
 	return ret;
 }
@@ -1141,7 +1141,7 @@ MonoArray *PackedInt64Array_to_mono_array(const PackedInt64Array &p_array) {
 	MonoArray *ret = mono_array_new(mono_domain_get(), CACHED_CLASS_RAW(int64_t), length);
 
 	int64_t *dst = (int64_t *)mono_array_addr(ret, int64_t, 0);
-	memcpy(dst, src, length);
+	memcpy(dst, src, length * sizeof(int64_t));
 
 	return ret;
 }
@@ -1155,7 +1155,7 @@ PackedInt64Array mono_array_to_PackedInt64Array(MonoArray *p_array) {
 	int64_t *dst = ret.ptrw();
 
 	const int64_t *src = (const int64_t *)mono_array_addr(p_array, int64_t, 0);
-	memcpy(dst, src, length);
+	memcpy(dst, src, length * sizeof(int64_t));
 
 	return ret;
 }
@@ -1193,7 +1193,7 @@ MonoArray *PackedFloat32Array_to_mono_array(const PackedFloat32Array &p_array) {
 	MonoArray *ret = mono_array_new(mono_domain_get(), CACHED_CLASS_RAW(float), length);
 
 	float *dst = (float *)mono_array_addr(ret, float, 0);
-	memcpy(dst, src, length);
+	memcpy(dst, src, length * sizeof(float));
 
 	return ret;
 }
@@ -1207,7 +1207,7 @@ PackedFloat32Array mono_array_to_PackedFloat32Array(MonoArray *p_array) {
 	float *dst = ret.ptrw();
 
 	const float *src = (const float *)mono_array_addr(p_array, float, 0);
-	memcpy(dst, src, length);
+	memcpy(dst, src, length * sizeof(float));
 
 	return ret;
 }
@@ -1219,7 +1219,7 @@ MonoArray *PackedFloat64Array_to_mono_array(const PackedFloat64Array &p_array) {
 	MonoArray *ret = mono_array_new(mono_domain_get(), CACHED_CLASS_RAW(double), length);
 
 	double *dst = (double *)mono_array_addr(ret, double, 0);
-	memcpy(dst, src, length);
+	memcpy(dst, src, length * sizeof(double));
 
 	return ret;
 }
@@ -1233,7 +1233,7 @@ PackedFloat64Array mono_array_to_PackedFloat64Array(MonoArray *p_array) {
 	double *dst = ret.ptrw();
 
 	const double *src = (const double *)mono_array_addr(p_array, double, 0);
-	memcpy(dst, src, length);
+	memcpy(dst, src, length * sizeof(double));
 
 	return ret;
 }
@@ -1276,7 +1276,7 @@ MonoArray *PackedColorArray_to_mono_array(const PackedColorArray &p_array) {
 
 	if constexpr (InteropLayout::MATCHES_Color) {
 		Color *dst = (Color *)mono_array_addr(ret, Color, 0);
-		memcpy(dst, src, length);
+		memcpy(dst, src, length * sizeof(Color));
 	} else {
 		for (int i = 0; i < length; i++) {
 			M_Color *raw = (M_Color *)mono_array_addr_with_size(ret, sizeof(M_Color), i);
@@ -1297,7 +1297,7 @@ PackedColorArray mono_array_to_PackedColorArray(MonoArray *p_array) {
 
 	if constexpr (InteropLayout::MATCHES_Color) {
 		const Color *src = (const Color *)mono_array_addr(p_array, Color, 0);
-		memcpy(dst, src, length);
+		memcpy(dst, src, length * sizeof(Color));
 	} else {
 		for (int i = 0; i < length; i++) {
 			dst[i] = MARSHALLED_IN(Color, (M_Color *)mono_array_addr_with_size(p_array, sizeof(M_Color), i));
@@ -1315,7 +1315,7 @@ MonoArray *PackedVector2Array_to_mono_array(const PackedVector2Array &p_array) {
 
 	if constexpr (InteropLayout::MATCHES_Vector2) {
 		Vector2 *dst = (Vector2 *)mono_array_addr(ret, Vector2, 0);
-		memcpy(dst, src, length);
+		memcpy(dst, src, length * sizeof(Vector2));
 	} else {
 		for (int i = 0; i < length; i++) {
 			M_Vector2 *raw = (M_Vector2 *)mono_array_addr_with_size(ret, sizeof(M_Vector2), i);
@@ -1336,7 +1336,7 @@ PackedVector2Array mono_array_to_PackedVector2Array(MonoArray *p_array) {
 
 	if constexpr (InteropLayout::MATCHES_Vector2) {
 		const Vector2 *src = (const Vector2 *)mono_array_addr(p_array, Vector2, 0);
-		memcpy(dst, src, length);
+		memcpy(dst, src, length * sizeof(Vector2));
 	} else {
 		for (int i = 0; i < length; i++) {
 			dst[i] = MARSHALLED_IN(Vector2, (M_Vector2 *)mono_array_addr_with_size(p_array, sizeof(M_Vector2), i));
@@ -1354,7 +1354,7 @@ MonoArray *PackedVector3Array_to_mono_array(const PackedVector3Array &p_array) {
 
 	if constexpr (InteropLayout::MATCHES_Vector3) {
 		Vector3 *dst = (Vector3 *)mono_array_addr(ret, Vector3, 0);
-		memcpy(dst, src, length);
+		memcpy(dst, src, length * sizeof(Vector3));
 	} else {
 		for (int i = 0; i < length; i++) {
 			M_Vector3 *raw = (M_Vector3 *)mono_array_addr_with_size(ret, sizeof(M_Vector3), i);
@@ -1375,7 +1375,7 @@ PackedVector3Array mono_array_to_PackedVector3Array(MonoArray *p_array) {
 
 	if constexpr (InteropLayout::MATCHES_Vector3) {
 		const Vector3 *src = (const Vector3 *)mono_array_addr(p_array, Vector3, 0);
-		memcpy(dst, src, length);
+		memcpy(dst, src, length * sizeof(Vector3));
 	} else {
 		for (int i = 0; i < length; i++) {
 			dst[i] = MARSHALLED_IN(Vector3, (M_Vector3 *)mono_array_addr_with_size(p_array, sizeof(M_Vector3), i));
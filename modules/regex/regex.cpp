@@ -45,6 +45,80 @@ static void _regex_free(void *ptr, void *user) {
 	memfree(ptr);
 }
 
+#define REGEX_JIT_STACK_START (32 * 1024)
+#define REGEX_JIT_STACK_MAX (1024 * 1024)
+
+// Match data, match context and JIT stack reused by every match on a thread.
+// Created with the default allocator, as they can outlive the engine memory on thread exit.
+struct RegExThreadData {
+	void *match_data = NULL;
+	uint32_t match_data_size = 0;
+	void *match_ctx = NULL;
+	void *jit_stack = NULL;
+
+	void prepare(uint32_t p_pairs) {
+
+		if (sizeof(CharType) == 2) {
+
+			if (!match_ctx) {
+				match_ctx = pcre2_match_context_create_16(NULL);
+				jit_stack = pcre2_jit_stack_create_16(REGEX_JIT_STACK_START, REGEX_JIT_STACK_MAX, NULL);
+				if (jit_stack) {
+					pcre2_jit_stack_assign_16((pcre2_match_context_16 *)match_ctx, NULL, jit_stack);
+				}
+			}
+			if (match_data_size < p_pairs) {
+				if (match_data) {
+					pcre2_match_data_free_16((pcre2_match_data_16 *)match_data);
+				}
+				match_data = pcre2_match_data_create_16(p_pairs, NULL);
+				match_data_size = p_pairs;
+			}
+
+		} else {
+
+			if (!match_ctx) {
+				match_ctx = pcre2_match_context_create_32(NULL);
+				jit_stack = pcre2_jit_stack_create_32(REGEX_JIT_STACK_START, REGEX_JIT_STACK_MAX, NULL);
+				if (jit_stack) {
+					pcre2_jit_stack_assign_32((pcre2_match_context_32 *)match_ctx, NULL, jit_stack);
+				}
+			}
+			if (match_data_size < p_pairs) {
+				if (match_data) {
+					pcre2_match_data_free_32((pcre2_match_data_32 *)match_data);
+				}
+				match_data = pcre2_match_data_create_32(p_pairs, NULL);
+				match_data_size = p_pairs;
+			}
+		}
+	}
+
+	~RegExThreadData() {
+
+		if (sizeof(CharType) == 2) {
+
+			if (match_data)
+				pcre2_match_data_free_16((pcre2_match_data_16 *)match_data);
+			if (match_ctx)
+				pcre2_match_context_free_16((pcre2_match_context_16 *)match_ctx);
+			if (jit_stack)
+				pcre2_jit_stack_free_16((pcre2_jit_stack_16 *)jit_stack);
+
+		} else {
+
+			if (match_data)
+				pcre2_match_data_free_32((pcre2_match_data_32 *)match_data);
+			if (match_ctx)
+				pcre2_match_context_free_32((pcre2_match_context_32 *)match_ctx);
+			if (jit_stack)
+				pcre2_jit_stack_free_32((pcre2_jit_stack_32 *)jit_stack);
+		}
+	}
+};
+
+static thread_local RegExThreadData regex_thread_data;
+
 int RegExMatch::_find(const Variant &p_name) const {
 
 	if (p_name.is_num()) {
@@ -176,6 +250,8 @@ void RegEx::_pattern_info(uint32_t what, void *where) const {
 
 void RegEx::clear() {
 
+	capture_count = 0;
+
 	if (sizeof(CharType) == 2) {
 
 		if (code) {
@@ -219,6 +295,9 @@ Error RegEx::compile(const String &p_pattern) {
 			return FAILED;
 		}
 
+		//if JIT is not available for this build or pattern, matching just uses the interpreter
+		pcre2_jit_compile_16((pcre2_code_16 *)code, PCRE2_JIT_COMPLETE);
+
 	} else {
 
 		pcre2_general_context_32 *gctx = (pcre2_general_context_32 *)general_ctx;
@@ -236,81 +315,60 @@ Error RegEx::compile(const String &p_pattern) {
 			ERR_PRINT(message.utf8());
 			return FAILED;
 		}
+
+		pcre2_jit_compile_32((pcre2_code_32 *)code, PCRE2_JIT_COMPLETE);
 	}
-	return OK;
-}
 
-Ref<RegExMatch> RegEx::search(const String &p_subject, int p_offset, int p_end) const {
+	_pattern_info(PCRE2_INFO_CAPTURECOUNT, &capture_count);
 
-	ERR_FAIL_COND_V(!is_valid(), NULL);
+	return OK;
+}
 
-	Ref<RegExMatch> result = memnew(RegExMatch);
+int RegEx::_match(const String &p_subject, int p_offset, int p_end, const size_t **r_ovector) const {
 
 	int length = p_subject.length();
 	if (p_end >= 0 && p_end < length)
 		length = p_end;
 
-	if (sizeof(CharType) == 2) {
-
-		pcre2_code_16 *c = (pcre2_code_16 *)code;
-		pcre2_general_context_16 *gctx = (pcre2_general_context_16 *)general_ctx;
-		pcre2_match_context_16 *mctx = pcre2_match_context_create_16(gctx);
-		PCRE2_SPTR16 s = (PCRE2_SPTR16)p_subject.c_str();
-
-		pcre2_match_data_16 *match = pcre2_match_data_create_from_pattern_16(c, gctx);
-
-		int res = pcre2_match_16(c, s, length, p_offset, 0, match, mctx);
-
-		if (res < 0) {
-			pcre2_match_data_free_16(match);
-			return NULL;
-		}
-
-		uint32_t size = pcre2_get_ovector_count_16(match);
-		PCRE2_SIZE *ovector = pcre2_get_ovector_pointer_16(match);
-
-		result->data.resize(size);
-
-		for (uint32_t i = 0; i < size; i++) {
+	RegExThreadData &td = regex_thread_data;
+	td.prepare(capture_count + 1);
 
-			result->data.write[i].start = ovector[i * 2];
-			result->data.write[i].end = ovector[i * 2 + 1];
-		}
+	if (sizeof(CharType) == 2) {
 
-		pcre2_match_data_free_16(match);
-		pcre2_match_context_free_16(mctx);
+		pcre2_match_data_16 *match = (pcre2_match_data_16 *)td.match_data;
+		int res = pcre2_match_16((pcre2_code_16 *)code, (PCRE2_SPTR16)p_subject.c_str(), length, p_offset, 0, match, (pcre2_match_context_16 *)td.match_ctx);
+		*r_ovector = pcre2_get_ovector_pointer_16(match);
+		return res;
 
 	} else {
 
-		pcre2_code_32 *c = (pcre2_code_32 *)code;
-		pcre2_general_context_32 *gctx = (pcre2_general_context_32 *)general_ctx;
-		pcre2_match_context_32 *mctx = pcre2_match_context_create_32(gctx);
-		PCRE2_SPTR32 s = (PCRE2_SPTR32)p_subject.c_str();
-
-		pcre2_match_data_32 *match = pcre2_match_data_create_from_pattern_32(c, gctx);
+		pcre2_match_data_32 *match = (pcre2_match_data_32 *)td.match_data;
+		int res = pcre2_match_32((pcre2_code_32 *)code, (PCRE2_SPTR32)p_subject.c_str(), length, p_offset, 0, match, (pcre2_match_context_32 *)td.match_ctx);
+		*r_ovector = pcre2_get_ovector_pointer_32(match);
+		return res;
+	}
+}
 
-		int res = pcre2_match_32(c, s, length, p_offset, 0, match, mctx);
+Ref<RegExMatch> RegEx::search(const String &p_subject, int p_offset, int p_end) const {
 
-		if (res < 0) {
-			pcre2_match_data_free_32(match);
-			pcre2_match_context_free_32(mctx);
+	ERR_FAIL_COND_V(!is_valid(), NULL);
 
-			return NULL;
-		}
+	const size_t *ovector;
+	int res = _match(p_subject, p_offset, p_end, &ovector);
 
-		uint32_t size = pcre2_get_ovector_count_32(match);
-		PCRE2_SIZE *ovector = pcre2_get_ovector_pointer_32(match);
+	if (res < 0) {
+		return NULL;
+	}
 
-		result->data.resize(size);
+	Ref<RegExMatch> result = memnew(RegExMatch);
 
-		for (uint32_t i = 0; i < size; i++) {
+	uint32_t size = capture_count + 1;
+	result->data.resize(size);
 
-			result->data.write[i].start = ovector[i * 2];
-			result->data.write[i].end = ovector[i * 2 + 1];
-		}
+	for (uint32_t i = 0; i < size; i++) {
 
-		pcre2_match_data_free_32(match);
-		pcre2_match_context_free_32(mctx);
+		result->data.write[i].start = ovector[i * 2];
+		result->data.write[i].end = ovector[i * 2 + 1];
 	}
 
 	result->subject = p_subject;
@@ -338,6 +396,32 @@ Ref<RegExMatch> RegEx::search(const String &p_subject, int p_offset, int p_end)
 	return result;
 }
 
+PackedStringArray RegEx::search_all_strings(const String &p_subject, int p_offset, int p_end) const {
+
+	ERR_FAIL_COND_V(!is_valid(), PackedStringArray());
+
+	PackedStringArray result;
+	int last_end = -1;
+	int offset = p_offset;
+
+	while (true) {
+		const size_t *ovector;
+		if (_match(p_subject, offset, p_end, &ovector) < 0) {
+			break;
+		}
+		int start = ovector[0];
+		int end = ovector[1];
+		if (last_end == end) {
+			break;
+		}
+		result.push_back(p_subject.substr(start, end - start));
+		last_end = end;
+		offset = end;
+	}
+
+	return result;
+}
+
 Array RegEx::search_all(const String &p_subject, int p_offset, int p_end) const {
 
 	int last_end = -1;
@@ -377,14 +461,16 @@ String RegEx::sub(const String &p_subject, const String &p_replacement, bool p_a
 
 	if (sizeof(CharType) == 2) {
 
+		RegExThreadData &td = regex_thread_data;
+		td.prepare(capture_count + 1);
+
 		pcre2_code_16 *c = (pcre2_code_16 *)code;
-		pcre2_general_context_16 *gctx = (pcre2_general_context_16 *)general_ctx;
-		pcre2_match_context_16 *mctx = pcre2_match_context_create_16(gctx);
+		pcre2_match_context_16 *mctx = (pcre2_match_context_16 *)td.match_ctx;
 		PCRE2_SPTR16 s = (PCRE2_SPTR16)p_subject.c_str();
 		PCRE2_SPTR16 r = (PCRE2_SPTR16)p_replacement.c_str();
 		PCRE2_UCHAR16 *o = (PCRE2_UCHAR16 *)output.ptrw();
 
-		pcre2_match_data_16 *match = pcre2_match_data_create_from_pattern_16(c, gctx);
+		pcre2_match_data_16 *match = (pcre2_match_data_16 *)td.match_data;
 
 		int res = pcre2_substitute_16(c, s, length, p_offset, flags, match, mctx, r, p_replacement.length(), o, &olength);
 
@@ -394,22 +480,21 @@ String RegEx::sub(const String &p_subject, const String &p_replacement, bool p_a
 			res = pcre2_substitute_16(c, s, length, p_offset, flags, match, mctx, r, p_replacement.length(), o, &olength);
 		}
 
-		pcre2_match_data_free_16(match);
-		pcre2_match_context_free_16(mctx);
-
 		if (res < 0)
 			return String();
 
 	} else {
 
+		RegExThreadData &td = regex_thread_data;
+		td.prepare(capture_count + 1);
+
 		pcre2_code_32 *c = (pcre2_code_32 *)code;
-		pcre2_general_context_32 *gctx = (pcre2_general_context_32 *)general_ctx;
-		pcre2_match_context_32 *mctx = pcre2_match_context_create_32(gctx);
+		pcre2_match_context_32 *mctx = (pcre2_match_context_32 *)td.match_ctx;
 		PCRE2_SPTR32 s = (PCRE2_SPTR32)p_subject.c_str();
 		PCRE2_SPTR32 r = (PCRE2_SPTR32)p_replacement.c_str();
 		PCRE2_UCHAR32 *o = (PCRE2_UCHAR32 *)output.ptrw();
 
-		pcre2_match_data_32 *match = pcre2_match_data_create_from_pattern_32(c, gctx);
+		pcre2_match_data_32 *match = (pcre2_match_data_32 *)td.match_data;
 
 		int res = pcre2_substitute_32(c, s, length, p_offset, flags, match, mctx, r, p_replacement.length(), o, &olength);
 
@@ -419,9 +504,6 @@ String RegEx::sub(const String &p_subject, const String &p_replacement, bool p_a
 			res = pcre2_substitute_32(c, s, length, p_offset, flags, match, mctx, r, p_replacement.length(), o, &olength);
 		}
 
-		pcre2_match_data_free_32(match);
-		pcre2_match_context_free_32(mctx);
-
 		if (res < 0)
 			return String();
 	}
@@ -486,6 +568,7 @@ RegEx::RegEx() {
 		general_ctx = pcre2_general_context_create_32(&_regex_malloc, &_regex_free, NULL);
 	}
 	code = NULL;
+	capture_count = 0;
 }
 
 RegEx::RegEx(const String &p_pattern) {
@@ -499,6 +582,7 @@ RegEx::RegEx(const String &p_pattern) {
 		general_ctx = pcre2_general_context_create_32(&_regex_malloc, &_regex_free, NULL);
 	}
 	code = NULL;
+	capture_count = 0;
 	compile(p_pattern);
 }
 
@@ -524,6 +608,7 @@ void RegEx::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("compile", "pattern"), &RegEx::compile);
 	ClassDB::bind_method(D_METHOD("search", "subject", "offset", "end"), &RegEx::search, DEFVAL(0), DEFVAL(-1));
 	ClassDB::bind_method(D_METHOD("search_all", "subject", "offset", "end"), &RegEx::search_all, DEFVAL(0), DEFVAL(-1));
+	ClassDB::bind_method(D_METHOD("search_all_strings", "subject", "offset", "end"), &RegEx::search_all_strings, DEFVAL(0), DEFVAL(-1));
 	ClassDB::bind_method(D_METHOD("sub", "subject", "replacement", "all", "offset", "end"), &RegEx::sub, DEFVAL(false), DEFVAL(0), DEFVAL(-1));
 	ClassDB::bind_method(D_METHOD("is_valid"), &RegEx::is_valid);
 	ClassDB::bind_method(D_METHOD("get_pattern"), &RegEx::get_pattern);
@@ -76,8 +76,10 @@ class RegEx : public Reference {
 	void *general_ctx;
 	void *code;
 	String pattern;
+	uint32_t capture_count;
 
 	void _pattern_info(uint32_t what, void *where) const;
+	int _match(const String &p_subject, int p_offset, int p_end, const size_t **r_ovector) const;
 
 protected:
 	static void _bind_methods();
@@ -89,6 +91,7 @@ public:
 
 	Ref<RegExMatch> search(const String &p_subject, int p_offset = 0, int p_end = -1) const;
 	Array search_all(const String &p_subject, int p_offset = 0, int p_end = -1) const;
+	PackedStringArray search_all_strings(const String &p_subject, int p_offset = 0, int p_end = -1) const;
 	String sub(const String &p_subject, const String &p_replacement, bool p_all = false, int p_offset = 0, int p_end = -1) const;
 
 	bool is_valid() const;
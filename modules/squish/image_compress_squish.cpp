@@ -30,8 +30,28 @@
 
 #include "image_compress_squish.h"
 
+#include "core/thread_work_pool.h"
+
 #include <squish.h>
 
+//strips of four rows are compressed on their own, so the strips of every mipmap can run on the work pool at once
+struct SquishCompressionRowTask {
+	const uint8_t *src;
+	uint8_t *dst;
+	int width;
+	int height; //up to four rows
+};
+
+struct SquishCompressionJob {
+	const SquishCompressionRowTask *tasks;
+	int flags;
+
+	void compress_row(uint32_t p_index, void *p_unused) {
+		const SquishCompressionRowTask &task = tasks[p_index];
+		squish::CompressImage(task.src, task.width, task.height, task.dst, flags);
+	}
+};
+
 void image_decompress_squish(Image *p_image) {
 	int w = p_image->get_width();
 	int h = p_image->get_height();
@@ -148,18 +168,43 @@ void image_compress_squish(Image *p_image, float p_lossy_quality, Image::UsedCha
 
 		int dst_ofs = 0;
 
+		Vector<SquishCompressionRowTask> tasks;
+
 		for (int i = 0; i <= mm_count; i++) {
 
 			int bw = w % 4 != 0 ? w + (4 - w % 4) : w;
 			int bh = h % 4 != 0 ? h + (4 - h % 4) : h;
 
 			int src_ofs = p_image->get_mipmap_offset(i);
-			squish::CompressImage(&rb[src_ofs], w, h, &wb[dst_ofs], squish_comp);
+			int row_size = squish::GetStorageRequirements(w, 4, squish_comp);
+
+			for (int y = 0; y < h; y += 4) {
+				SquishCompressionRowTask task;
+				task.src = &rb[src_ofs + y * w * 4];
+				task.dst = &wb[dst_ofs + (y / 4) * row_size];
+				task.width = w;
+				task.height = MIN(4, h - y);
+				tasks.push_back(task);
+			}
+
 			dst_ofs += (MAX(4, bw) * MAX(4, bh)) >> shift;
 			w = MAX(w / 2, 1);
 			h = MAX(h / 2, 1);
 		}
 
+		SquishCompressionJob job;
+		job.tasks = tasks.ptr();
+		job.flags = squish_comp;
+
+		ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+		if (pool && pool->get_thread_count() > 0) {
+			pool->do_work(tasks.size(), &job, &SquishCompressionJob::compress_row, (void *)NULL);
+		} else {
+			for (int i = 0; i < tasks.size(); i++) {
+				job.compress_row(i, NULL);
+			}
+		}
+
 		p_image->create(p_image->get_width(), p_image->get_height(), p_image->has_mipmaps(), target_format, data);
 	}
 }
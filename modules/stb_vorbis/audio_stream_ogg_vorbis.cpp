@@ -32,24 +32,17 @@
 
 #include "core/os/file_access.h"
 
-void AudioStreamPlaybackOGGVorbis::_mix_internal(AudioFrame *p_buffer, int p_frames) {
-
-	ERR_FAIL_COND(!active);
+int AudioStreamPlaybackOGGVorbis::_decode(AudioFrame *p_buffer, int p_frames) {
 
 	int todo = p_frames;
 
-	int start_buffer = 0;
-
-	while (todo && active) {
-		float *buffer = (float *)p_buffer;
-		if (start_buffer > 0) {
-			buffer = (buffer + start_buffer * 2);
-		}
-		int mixed = stb_vorbis_get_samples_float_interleaved(ogg_stream, 2, buffer, todo * 2);
+	while (todo) {
+		AudioFrame *buffer = p_buffer + (p_frames - todo);
+		int mixed = stb_vorbis_get_samples_float_interleaved(ogg_stream, 2, (float *)buffer, todo * 2);
 		if (vorbis_stream->channels == 1 && mixed > 0) {
 			//mix mono to stereo
-			for (int i = start_buffer; i < mixed; i++) {
-				p_buffer[i].r = p_buffer[i].l;
+			for (int i = 0; i < mixed; i++) {
+				buffer[i].r = buffer[i].l;
 			}
 		}
 		todo -= mixed;
@@ -60,19 +53,25 @@ void AudioStreamPlaybackOGGVorbis::_mix_internal(AudioFrame *p_buffer, int p_fra
 			bool is_not_empty = mixed > 0 || stb_vorbis_stream_length_in_samples(ogg_stream) > 0;
 			if (vorbis_stream->loop && is_not_empty) {
 				//loop
-				seek(vorbis_stream->loop_offset);
+				_seek_decoder(vorbis_stream->loop_offset);
 				loops++;
-				// we still have buffer to fill, start from this element in the next iteration.
-				start_buffer = p_frames - todo;
 			} else {
-				for (int i = p_frames - todo; i < p_frames; i++) {
-					p_buffer[i] = AudioFrame(0, 0);
-				}
-				active = false;
-				todo = 0;
+				break;
 			}
 		}
 	}
+
+	return p_frames - todo;
+}
+
+void AudioStreamPlaybackOGGVorbis::_seek_decoder(float p_time) {
+
+	if (p_time >= vorbis_stream->get_length()) {
+		p_time = 0;
+	}
+	frames_mixed = uint32_t(vorbis_stream->sample_rate * p_time);
+
+	stb_vorbis_seek(ogg_stream, frames_mixed);
 }
 
 float AudioStreamPlaybackOGGVorbis::get_stream_sampling_rate() {
@@ -91,10 +90,11 @@ void AudioStreamPlaybackOGGVorbis::start(float p_from_pos) {
 void AudioStreamPlaybackOGGVorbis::stop() {
 
 	active = false;
+	_decode_stop();
 }
 bool AudioStreamPlaybackOGGVorbis::is_playing() const {
 
-	return active;
+	return active && !_is_decode_finished();
 }
 
 int AudioStreamPlaybackOGGVorbis::get_loop_count() const {
@@ -104,22 +104,46 @@ int AudioStreamPlaybackOGGVorbis::get_loop_count() const {
 
 float AudioStreamPlaybackOGGVorbis::get_playback_position() const {
 
-	return float(frames_mixed) / vorbis_stream->sample_rate;
+	//the decoder is ahead by what is buffered
+	int64_t position = int64_t(frames_mixed) - int64_t(_get_decode_buffered());
+	int64_t loop_begin = int64_t(vorbis_stream->loop_offset * vorbis_stream->sample_rate);
+	if (position < 0 || (loops > 0 && position < loop_begin)) {
+		//still playing the end of the previous loop
+		position += int64_t(vorbis_stream->length * vorbis_stream->sample_rate) - loop_begin;
+	}
+	return float(MAX(position, int64_t(0))) / vorbis_stream->sample_rate;
 }
 void AudioStreamPlaybackOGGVorbis::seek(float p_time) {
 
 	if (!active)
 		return;
 
-	if (p_time >= vorbis_stream->get_length()) {
-		p_time = 0;
-	}
-	frames_mixed = uint32_t(vorbis_stream->sample_rate * p_time);
+	_decode_lock();
+	_seek_decoder(p_time);
+	_decode_restart();
+	_decode_unlock();
+}
+void AudioStreamPlaybackOGGVorbis::skip(float p_time) {
 
-	stb_vorbis_seek(ogg_stream, frames_mixed);
+	if (!active)
+		return;
+
+	float length = vorbis_stream->get_length();
+	float pos = get_playback_position() + p_time;
+	if (pos >= length) {
+		if (!vorbis_stream->loop || vorbis_stream->loop_offset >= length) {
+			active = false;
+			return;
+		}
+		float loop_length = length - vorbis_stream->loop_offset;
+		loops += int((pos - vorbis_stream->loop_offset) / loop_length);
+		pos = vorbis_stream->loop_offset + Math::fmod(pos - vorbis_stream->loop_offset, loop_length);
+	}
+	seek(pos);
 }
 
 AudioStreamPlaybackOGGVorbis::~AudioStreamPlaybackOGGVorbis() {
+	_decode_cleanup();
 	if (ogg_alloc.alloc_buffer) {
 		stb_vorbis_close(ogg_stream);
 		memfree(ogg_alloc.alloc_buffer);
@@ -148,6 +172,8 @@ Ref<AudioStreamPlayback> AudioStreamOGGVorbis::instance_playback() {
 		ERR_FAIL_COND_V(!ovs->ogg_stream, Ref<AudioStreamPlaybackOGGVorbis>());
 	}
 
+	ovs->_decode_setup(sample_rate);
+
 	return ovs;
 }
 
@@ -38,9 +38,9 @@
 
 class AudioStreamOGGVorbis;
 
-class AudioStreamPlaybackOGGVorbis : public AudioStreamPlaybackResampled {
+class AudioStreamPlaybackOGGVorbis : public AudioStreamPlaybackDecoded {
 
-	GDCLASS(AudioStreamPlaybackOGGVorbis, AudioStreamPlaybackResampled);
+	GDCLASS(AudioStreamPlaybackOGGVorbis, AudioStreamPlaybackDecoded);
 
 	stb_vorbis *ogg_stream;
 	stb_vorbis_alloc ogg_alloc;
@@ -52,8 +52,10 @@ class AudioStreamPlaybackOGGVorbis : public AudioStreamPlaybackResampled {
 
 	Ref<AudioStreamOGGVorbis> vorbis_stream;
 
+	void _seek_decoder(float p_time);
+
 protected:
-	virtual void _mix_internal(AudioFrame *p_buffer, int p_frames);
+	virtual int _decode(AudioFrame *p_buffer, int p_frames);
 	virtual float get_stream_sampling_rate();
 
 public:
@@ -65,6 +67,7 @@ public:
 
 	virtual float get_playback_position() const;
 	virtual void seek(float p_time);
+	virtual void skip(float p_time);
 
 	AudioStreamPlaybackOGGVorbis() {}
 	~AudioStreamPlaybackOGGVorbis();
@@ -44,7 +44,7 @@ SVGRasterizer::~SVGRasterizer() {
 	nsvgDeleteRasterizer(rasterizer);
 }
 
-SVGRasterizer ImageLoaderSVG::rasterizer;
+thread_local SVGRasterizer ImageLoaderSVG::rasterizer;
 
 inline void change_nsvg_paint_color(NSVGpaint *p_paint, const uint32_t p_old, const uint32_t p_new) {
 
@@ -86,33 +86,42 @@ void ImageLoaderSVG::set_convert_colors(Dictionary *p_replace_color) {
 				Color new_color = n_c;
 				replace_colors.old_colors.push_back(old_color.to_abgr32());
 				replace_colors.new_colors.push_back(new_color.to_abgr32());
+				replace_colors.hash = hash_djb2_one_32(old_color.to_abgr32(), replace_colors.hash);
+				replace_colors.hash = hash_djb2_one_32(new_color.to_abgr32(), replace_colors.hash);
 			}
 		}
 	} else {
 		replace_colors.old_colors.clear();
 		replace_colors.new_colors.clear();
+		replace_colors.hash = 5381;
 	}
 }
 
-Error ImageLoaderSVG::_create_image(Ref<Image> p_image, const Vector<uint8_t> *p_data, float p_scale, bool upsample, bool convert_colors) {
-	NSVGimage *svg_image;
-	const uint8_t *src_r = p_data->ptr();
-	svg_image = nsvgParse((char *)src_r, "px", 96);
+NSVGimage *ImageLoaderSVG::_parse(const Vector<uint8_t> *p_data, bool convert_colors) {
+
+	//nsvgParse() writes into the string it parses, so give it its own copy
+	Vector<uint8_t> source = *p_data;
+	NSVGimage *svg_image = nsvgParse((char *)source.ptrw(), "px", 96);
 	if (svg_image == NULL) {
 		ERR_PRINT("SVG Corrupted");
-		return ERR_FILE_CORRUPT;
+		return NULL;
 	}
 
 	if (convert_colors) {
 		_convert_colors(svg_image);
 	}
 
+	return svg_image;
+}
+
+Error ImageLoaderSVG::_rasterize(Ref<Image> p_image, NSVGimage *p_svg_image, float p_scale, bool upsample) {
+
 	const float upscale = upsample ? 2.0 : 1.0;
 
-	const int w = (int)(svg_image->width * p_scale * upscale);
+	const int w = (int)(p_svg_image->width * p_scale * upscale);
 	ERR_FAIL_COND_V_MSG(w > Image::MAX_WIDTH, ERR_PARAMETER_RANGE_ERROR, vformat("Can't create image from SVG with scale %s, the resulting image size exceeds max width.", rtos(p_scale)));
 
-	const int h = (int)(svg_image->height * p_scale * upscale);
+	const int h = (int)(p_svg_image->height * p_scale * upscale);
 	ERR_FAIL_COND_V_MSG(h > Image::MAX_HEIGHT, ERR_PARAMETER_RANGE_ERROR, vformat("Can't create image from SVG with scale %s, the resulting image size exceeds max height.", rtos(p_scale)));
 
 	Vector<uint8_t> dst_image;
@@ -120,18 +129,133 @@ Error ImageLoaderSVG::_create_image(Ref<Image> p_image, const Vector<uint8_t> *p
 
 	uint8_t *dw = dst_image.ptrw();
 
-	rasterizer.rasterize(svg_image, 0, 0, p_scale * upscale, (unsigned char *)dw, w, h, w * 4);
+	//the rasterizer is per thread, the parsed image is only read
+	rasterizer.rasterize(p_svg_image, 0, 0, p_scale * upscale, (unsigned char *)dw, w, h, w * 4);
 
 	p_image->create(w, h, false, Image::FORMAT_RGBA8, dst_image);
 	if (upsample) {
 		p_image->shrink_x2();
 	}
 
-	nsvgDelete(svg_image);
-
 	return OK;
 }
 
+void ImageLoaderSVG::_prune_cache() {
+
+	//drop everything not being rasterized right now, the working set is rebuilt quickly
+	cached_raster_bytes = 0;
+
+	List<CacheKey> unused;
+	const CacheKey *K = NULL;
+	while ((K = cache.next(K))) {
+		CachedSVG &cached = cache[*K];
+		cached.rasters.clear();
+		if (cached.users == 0) {
+			unused.push_back(*K);
+		}
+	}
+
+	for (List<CacheKey>::Element *E = unused.front(); E; E = E->next()) {
+		nsvgDelete(cache[E->get()].svg_image);
+		cache.erase(E->get());
+	}
+}
+
+void ImageLoaderSVG::clear_cache() {
+
+	MutexLock lock(cache_mutex);
+	_prune_cache();
+}
+
+Error ImageLoaderSVG::_create_image(Ref<Image> p_image, const Vector<uint8_t> *p_data, float p_scale, bool upsample, bool convert_colors) {
+
+	CacheKey key;
+	key.source_hash = hash_djb2_buffer(p_data->ptr(), p_data->size());
+	key.source_length = p_data->size();
+	key.colors_hash = convert_colors && replace_colors.old_colors.size() ? replace_colors.hash : 0;
+
+	NSVGimage *svg_image = NULL;
+	bool use_cache = true;
+
+	{
+		MutexLock lock(cache_mutex);
+
+		CachedSVG *cached = cache.getptr(key);
+		if (cached) {
+			if (cached->source.size() != p_data->size() || memcmp(cached->source.ptr(), p_data->ptr(), p_data->size()) != 0) {
+				use_cache = false; //hash collision, keep the cached one and don't share
+			} else {
+				for (int i = 0; i < cached->rasters.size(); i++) {
+					const CachedRaster &raster = cached->rasters[i];
+					if (raster.scale == p_scale && raster.upsample == upsample) {
+						//shares the data, copied on write only if the caller modifies it
+						p_image->create(raster.image->get_width(), raster.image->get_height(), false, Image::FORMAT_RGBA8, raster.image->get_data());
+						return OK;
+					}
+				}
+				cached->users++;
+				svg_image = cached->svg_image;
+			}
+		}
+	}
+
+	if (!svg_image) {
+		svg_image = _parse(p_data, convert_colors);
+		if (!svg_image) {
+			return ERR_FILE_CORRUPT;
+		}
+
+		if (use_cache) {
+			MutexLock lock(cache_mutex);
+
+			CachedSVG *cached = cache.getptr(key);
+			if (cached) {
+				//another thread parsed the same source meanwhile
+				nsvgDelete(svg_image);
+				svg_image = cached->svg_image;
+				cached->users++;
+			} else {
+				if (cache.size() >= MAX_CACHED_SVGS) {
+					_prune_cache();
+				}
+				CachedSVG &added = cache[key];
+				added.source = *p_data;
+				added.svg_image = svg_image;
+				added.users = 1;
+			}
+		}
+	}
+
+	Error err = _rasterize(p_image, svg_image, p_scale, upsample);
+
+	if (!use_cache) {
+		nsvgDelete(svg_image);
+		return err;
+	}
+
+	MutexLock lock(cache_mutex);
+
+	if (err == OK) {
+		uint32_t bytes = p_image->get_data().size();
+		if (cached_raster_bytes + bytes > MAX_CACHED_RASTER_BYTES) {
+			_prune_cache(); //this entry is still in use, so it stays
+		}
+		if (bytes <= MAX_CACHED_RASTER_BYTES) {
+			CachedRaster raster;
+			raster.scale = p_scale;
+			raster.upsample = upsample;
+			raster.image.instance();
+			raster.image->create(p_image->get_width(), p_image->get_height(), false, Image::FORMAT_RGBA8, p_image->get_data());
+			cache[key].rasters.push_back(raster);
+			cached_raster_bytes += bytes;
+		}
+	}
+
+	cache[key].users--;
+
+	return err;
+}
+
 Error ImageLoaderSVG::create_image_from_string(Ref<Image> p_image, const char *p_svg_str, float p_scale, bool upsample, bool convert_colors) {
 
 	size_t str_len = strlen(p_svg_str);
@@ -164,4 +288,7 @@ void ImageLoaderSVG::get_recognized_extensions(List<String> *p_extensions) const
 ImageLoaderSVG::ImageLoaderSVG() {
 }
 
-ImageLoaderSVG::ReplaceColors ImageLoaderSVG::replace_colors;
+ImageLoaderSVG::ReplaceColors ImageLoaderSVG::replace_colors = { List<uint32_t>(), List<uint32_t>(), 5381 };
+Mutex ImageLoaderSVG::cache_mutex;
+HashMap<ImageLoaderSVG::CacheKey, ImageLoaderSVG::CachedSVG, ImageLoaderSVG::CacheKeyHasher> ImageLoaderSVG::cache;
+uint32_t ImageLoaderSVG::cached_raster_bytes = 0;
@@ -31,7 +31,9 @@
 #ifndef IMAGE_LOADER_SVG_H
 #define IMAGE_LOADER_SVG_H
 
+#include "core/hash_map.h"
 #include "core/io/image_loader.h"
+#include "core/os/mutex.h"
 #include "core/ustring.h"
 
 /**
@@ -57,14 +59,63 @@ class ImageLoaderSVG : public ImageFormatLoader {
 	static struct ReplaceColors {
 		List<uint32_t> old_colors;
 		List<uint32_t> new_colors;
+		uint32_t hash;
 	} replace_colors;
-	static SVGRasterizer rasterizer;
+
+	// Parsed documents are kept per source (and color replacement), with the images
+	// rasterized from them at each scale, so neither is redone for the same icon.
+	enum {
+		MAX_CACHED_SVGS = 1024,
+		MAX_CACHED_RASTER_BYTES = 32 * 1024 * 1024,
+	};
+
+	struct CacheKey {
+		uint32_t source_hash;
+		uint32_t source_length;
+		uint32_t colors_hash; // 0 when colors are not replaced.
+
+		bool operator==(const CacheKey &p_key) const {
+			return source_hash == p_key.source_hash && source_length == p_key.source_length && colors_hash == p_key.colors_hash;
+		}
+	};
+
+	struct CacheKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const CacheKey &p_key) {
+			uint32_t hash = hash_djb2_one_32(p_key.source_hash);
+			hash = hash_djb2_one_32(p_key.source_length, hash);
+			return hash_djb2_one_32(p_key.colors_hash, hash);
+		}
+	};
+
+	struct CachedRaster {
+		float scale;
+		bool upsample;
+		Ref<Image> image;
+	};
+
+	struct CachedSVG {
+		Vector<uint8_t> source;
+		NSVGimage *svg_image = nullptr;
+		uint32_t users = 0; // Threads rasterizing it, it can't be freed meanwhile.
+		Vector<CachedRaster> rasters;
+	};
+
+	static Mutex cache_mutex;
+	static HashMap<CacheKey, CachedSVG, CacheKeyHasher> cache;
+	static uint32_t cached_raster_bytes;
+
+	static thread_local SVGRasterizer rasterizer;
 	static void _convert_colors(NSVGimage *p_svg_image);
+	static NSVGimage *_parse(const Vector<uint8_t> *p_data, bool convert_colors);
+	static Error _rasterize(Ref<Image> p_image, NSVGimage *p_svg_image, float p_scale, bool upsample);
+	static void _prune_cache();
 	static Error _create_image(Ref<Image> p_image, const Vector<uint8_t> *p_data, float p_scale, bool upsample, bool convert_colors = false);
 
 public:
 	static void set_convert_colors(Dictionary *p_replace_color = NULL);
+	// Safe to call from several threads at once, as long as set_convert_colors() is not called meanwhile.
 	static Error create_image_from_string(Ref<Image> p_image, const char *p_svg_str, float p_scale, bool upsample, bool convert_colors = false);
+	static void clear_cache();
 
 	virtual Error load_image(Ref<Image> p_image, FileAccess *f, bool p_force_linear, float p_scale);
 	virtual void get_recognized_extensions(List<String> *p_extensions) const;
@@ -43,4 +43,5 @@ void register_svg_types() {
 void unregister_svg_types() {
 
 	memdelete(image_loader_svg);
+	ImageLoaderSVG::clear_cache();
 }
@@ -32,6 +32,7 @@
 
 #include "core/os/os.h"
 #include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 
 #include "thirdparty/misc/yuv2rgb.h"
 
@@ -80,35 +81,63 @@ int VideoStreamPlaybackTheora::queue_page(ogg_page *page) {
 	return 0;
 }
 
+void VideoStreamPlaybackTheora::_convert_yuv_band(uint32_t p_band, const YUVConvertJob *p_job) {
+
+	int from = p_band * YUV_BAND_ROWS;
+	int rows = MIN((int)YUV_BAND_ROWS, p_job->size.y - from);
+
+	uint8_t *dst = p_job->dst + from * (p_job->size.x << 2);
+	const uint8_t *y = p_job->planes[0] + from * p_job->strides[0];
+	const uint8_t *u = p_job->planes[1] + (from >> p_job->chroma_shift) * p_job->strides[1];
+	const uint8_t *v = p_job->planes[2] + (from >> p_job->chroma_shift) * p_job->strides[2];
+
+	if (p_job->format == TH_PF_444) {
+		yuv444_2_rgb8888(dst, y, u, v, p_job->size.x, rows, p_job->strides[0], p_job->strides[1], p_job->size.x << 2);
+	} else if (p_job->format == TH_PF_422) {
+		yuv422_2_rgb8888(dst, y, u, v, p_job->size.x, rows, p_job->strides[0], p_job->strides[1], p_job->size.x << 2);
+	} else if (p_job->format == TH_PF_420) {
+		yuv420_2_rgb8888(dst, y, u, v, p_job->size.x, rows, p_job->strides[0], p_job->strides[1], p_job->size.x << 2);
+	}
+}
+
 void VideoStreamPlaybackTheora::video_write(void) {
 	th_ycbcr_buffer yuv;
 	th_decode_ycbcr_out(td, yuv);
 
+	//write into the buffer the renderer is not holding, so ptrw() does not have to copy it
+	frame_index = (frame_index + 1) % 2;
+	Vector<uint8_t> &frame = frame_data[frame_index];
+
 	int pitch = 4;
-	frame_data.resize(size.x * size.y * pitch);
+	frame.resize(size.x * size.y * pitch);
 	{
-		uint8_t *w = frame_data.ptrw();
-		char *dst = (char *)w;
-
 		//uv_offset=(ti.pic_x/2)+(yuv[1].stride)*(ti.pic_y/2);
 
-		if (px_fmt == TH_PF_444) {
-
-			yuv444_2_rgb8888((uint8_t *)dst, (uint8_t *)yuv[0].data, (uint8_t *)yuv[1].data, (uint8_t *)yuv[2].data, size.x, size.y, yuv[0].stride, yuv[1].stride, size.x << 2);
-
-		} else if (px_fmt == TH_PF_422) {
-
-			yuv422_2_rgb8888((uint8_t *)dst, (uint8_t *)yuv[0].data, (uint8_t *)yuv[1].data, (uint8_t *)yuv[2].data, size.x, size.y, yuv[0].stride, yuv[1].stride, size.x << 2);
-
-		} else if (px_fmt == TH_PF_420) {
+		YUVConvertJob job;
+		job.format = px_fmt;
+		job.dst = frame.ptrw();
+		job.chroma_shift = px_fmt == TH_PF_420 ? 1 : 0;
+		job.size = size;
+		for (int i = 0; i < 3; i++) {
+			job.planes[i] = (const uint8_t *)yuv[i].data;
+			job.strides[i] = yuv[i].stride;
+		}
 
-			yuv420_2_rgb8888((uint8_t *)dst, (uint8_t *)yuv[0].data, (uint8_t *)yuv[1].data, (uint8_t *)yuv[2].data, size.x, size.y, yuv[0].stride, yuv[1].stride, size.x << 2);
-		};
+		//rows are independent, so convert them in bands across the worker threads
+		uint32_t bands = (size.y + YUV_BAND_ROWS - 1) / YUV_BAND_ROWS;
+		ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+		if (pool && bands > 1) {
+			pool->do_work(bands, this, &VideoStreamPlaybackTheora::_convert_yuv_band, (const YUVConvertJob *)&job);
+		} else {
+			for (uint32_t i = 0; i < bands; i++) {
+				_convert_yuv_band(i, &job);
+			}
+		}
 
 		format = Image::FORMAT_RGBA8;
 	}
 
-	Ref<Image> img = memnew(Image(size.x, size.y, 0, Image::FORMAT_RGBA8, frame_data)); //zero copy image creation
+	Ref<Image> img = memnew(Image(size.x, size.y, 0, Image::FORMAT_RGBA8, frame)); //zero copy image creation
 
 	texture->update(img, true); //zero copy send to visual server
 
@@ -152,6 +181,7 @@ void VideoStreamPlaybackTheora::clear() {
 	vorbis_p = 0;
 	videobuf_ready = 0;
 	frames_pending = 0;
+	frame_index = 0;
 	videobuf_time = 0;
 	theora_eos = false;
 	vorbis_eos = false;
@@ -680,6 +710,7 @@ VideoStreamPlaybackTheora::VideoStreamPlaybackTheora() {
 	videobuf_ready = 0;
 	playing = false;
 	frames_pending = 0;
+	frame_index = 0;
 	videobuf_time = 0;
 	paused = false;
 
@@ -52,9 +52,23 @@ class VideoStreamPlaybackTheora : public VideoStreamPlayback {
 		MAX_FRAMES = 4,
 	};
 
+	enum {
+		YUV_BAND_ROWS = 32, // Even, so 4:2:0 chroma rows stay aligned to bands.
+	};
+
+	struct YUVConvertJob {
+		th_pixel_fmt format;
+		uint8_t *dst;
+		const uint8_t *planes[3];
+		int strides[3];
+		int chroma_shift;
+		Point2i size;
+	};
+
 	//Image frames[MAX_FRAMES];
 	Image::Format format;
-	Vector<uint8_t> frame_data;
+	Vector<uint8_t> frame_data[2]; // Alternated, so the renderer can hold the previous frame without a copy.
+	int frame_index;
 	int frames_pending;
 	FileAccess *file;
 	String file_name;
@@ -64,6 +78,7 @@ class VideoStreamPlaybackTheora : public VideoStreamPlayback {
 	int buffer_data();
 	int queue_page(ogg_page *page);
 	void video_write(void);
+	void _convert_yuv_band(uint32_t p_band, const YUVConvertJob *p_job);
 	float get_time() const;
 
 	bool theora_eos;
@@ -160,6 +160,7 @@ VisualScriptNodeInstance::VisualScriptNodeInstance() {
 
 	sequence_outputs = NULL;
 	input_ports = NULL;
+	inline_operator = Variant::OP_MAX;
 }
 
 VisualScriptNodeInstance::~VisualScriptNodeInstance() {
@@ -1556,27 +1557,22 @@ bool VisualScriptInstance::has_method(const StringName &p_method) const {
 //#define VSDEBUG(m_text) print_line(m_text)
 #define VSDEBUG(m_text)
 
-void VisualScriptInstance::_dependency_step(VisualScriptNodeInstance *node, int p_pass, int *pass_stack, const Variant **input_args, Variant **output_args, Variant *variant_stack, Callable::CallError &r_error, String &error_str, VisualScriptNodeInstance **r_error_node) {
+void VisualScriptInstance::_build_dependency_plan(VisualScriptNodeInstance *p_node, Set<VisualScriptNodeInstance *> &r_added, Vector<VisualScriptNodeInstance *> &r_plan) {
 
-	ERR_FAIL_COND(node->pass_idx == -1);
+	//same order the graph used to be walked in: dependencies first, each node once per step
+	for (int i = 0; i < p_node->dependencies.size(); i++) {
 
-	if (pass_stack[node->pass_idx] == p_pass)
-		return;
-
-	pass_stack[node->pass_idx] = p_pass;
-
-	if (!node->dependencies.empty()) {
-
-		int dc = node->dependencies.size();
-		VisualScriptNodeInstance **deps = node->dependencies.ptrw();
-
-		for (int i = 0; i < dc; i++) {
+		VisualScriptNodeInstance *dep = p_node->dependencies[i];
+		if (r_added.has(dep))
+			continue;
 
-			_dependency_step(deps[i], p_pass, pass_stack, input_args, output_args, variant_stack, r_error, error_str, r_error_node);
-			if (r_error.error != Callable::CallError::CALL_OK)
-				return;
-		}
+		r_added.insert(dep);
+		_build_dependency_plan(dep, r_added, r_plan);
+		r_plan.push_back(dep);
 	}
+}
+
+void VisualScriptInstance::_dependency_step(VisualScriptNodeInstance *node, const Variant **input_args, Variant **output_args, Variant *variant_stack, Callable::CallError &r_error, String &error_str) {
 
 	for (int i = 0; i < node->input_port_count; i++) {
 
@@ -1590,6 +1586,21 @@ void VisualScriptInstance::_dependency_step(VisualScriptNodeInstance *node, int
 			input_args[i] = &variant_stack[index];
 		}
 	}
+
+	if (node->inline_operator != Variant::OP_MAX) {
+		//built-in operator, no need to go through step()
+		bool valid;
+		if (node->input_port_count == 1) {
+			Variant::evaluate(node->inline_operator, *input_args[0], Variant(), variant_stack[node->output_ports[0]], valid);
+		} else {
+			Variant::evaluate(node->inline_operator, *input_args[0], *input_args[1], variant_stack[node->output_ports[0]], valid);
+		}
+
+		if (valid)
+			return;
+		//failed, let step() run it again to report the error
+	}
+
 	for (int i = 0; i < node->output_port_count; i++) {
 		output_args[i] = &variant_stack[node->output_ports[i]];
 	}
@@ -1598,9 +1609,6 @@ void VisualScriptInstance::_dependency_step(VisualScriptNodeInstance *node, int
 
 	node->step(input_args, output_args, VisualScriptNodeInstance::START_MODE_BEGIN_SEQUENCE, working_mem, r_error, error_str);
 	//ignore return
-	if (r_error.error != Callable::CallError::CALL_OK) {
-		*r_error_node = node;
-	}
 }
 
 Variant VisualScriptInstance::_call_internal(const StringName &p_method, void *p_stack, int p_stack_size, VisualScriptNodeInstance *p_node, int p_flow_stack_pos, int p_pass, bool p_resuming_yield, Callable::CallError &r_error) {
@@ -1616,7 +1624,6 @@ Variant VisualScriptInstance::_call_internal(const StringName &p_method, void *p
 	Variant **output_args = (Variant **)(input_args + max_input_args);
 	int flow_max = f->flow_stack_size;
 	int *flow_stack = flow_max ? (int *)(output_args + max_output_args) : (int *)NULL;
-	int *pass_stack = flow_stack ? (int *)(flow_stack + flow_max) : (int *)NULL;
 
 	String error_str;
 
@@ -1657,16 +1664,17 @@ Variant VisualScriptInstance::_call_internal(const StringName &p_method, void *p
 
 			//run dependencies first
 
-			if (!node->dependencies.empty()) {
+			if (!node->dependency_plan.empty()) {
 
-				int dc = node->dependencies.size();
-				VisualScriptNodeInstance **deps = node->dependencies.ptrw();
+				int dc = node->dependency_plan.size();
+				VisualScriptNodeInstance *const *deps = node->dependency_plan.ptr();
 
 				for (int i = 0; i < dc; i++) {
 
-					_dependency_step(deps[i], p_pass, pass_stack, input_args, output_args, variant_stack, r_error, error_str, &node);
+					_dependency_step(deps[i], input_args, output_args, variant_stack, r_error, error_str);
 					if (r_error.error != Callable::CallError::CALL_OK) {
 						error = true;
+						node = deps[i];
 						current_node_id = node->id;
 						break;
 					}
@@ -2016,7 +2024,6 @@ Variant VisualScriptInstance::call(const StringName &p_method, const Variant **p
 	total_stack_size += f->node_count * sizeof(bool);
 	total_stack_size += (max_input_args + max_output_args) * sizeof(Variant *); //arguments
 	total_stack_size += f->flow_stack_size * sizeof(int); //flow
-	total_stack_size += f->pass_stack_size * sizeof(int);
 
 	VSDEBUG("STACK SIZE: " + itos(total_stack_size));
 	VSDEBUG("STACK VARIANTS: : " + itos(f->max_stack));
@@ -2024,7 +2031,6 @@ Variant VisualScriptInstance::call(const StringName &p_method, const Variant **p
 	VSDEBUG("MAX INPUT: " + itos(max_input_args));
 	VSDEBUG("MAX OUTPUT: " + itos(max_output_args));
 	VSDEBUG("FLOW STACK SIZE: " + itos(f->flow_stack_size));
-	VSDEBUG("PASS STACK SIZE: " + itos(f->pass_stack_size));
 
 	void *stack = alloca(total_stack_size);
 
@@ -2034,14 +2040,11 @@ Variant VisualScriptInstance::call(const StringName &p_method, const Variant **p
 	Variant **output_args = (Variant **)(input_args + max_input_args);
 	int flow_max = f->flow_stack_size;
 	int *flow_stack = flow_max ? (int *)(output_args + max_output_args) : (int *)NULL;
-	int *pass_stack = flow_stack ? (int *)(flow_stack + flow_max) : (int *)NULL;
 
 	for (int i = 0; i < f->node_count; i++) {
 		sequence_bits[i] = false; //all starts as false
 	}
 
-	zeromem(pass_stack, f->pass_stack_size * sizeof(int));
-
 	Map<int, VisualScriptNodeInstance *>::Element *E = instances.find(f->node);
 	if (!E) {
 		r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
@@ -2197,7 +2200,6 @@ void VisualScriptInstance::create(const Ref<VisualScript> &p_script, Object *p_o
 		function.node = E->get().function_id;
 		function.max_stack = 0;
 		function.flow_stack_size = 0;
-		function.pass_stack_size = 0;
 		function.node_count = 0;
 
 		Map<StringName, int> local_var_indices;
@@ -2243,7 +2245,11 @@ void VisualScriptInstance::create(const Ref<VisualScript> &p_script, Object *p_o
 			instance->sequence_output_count = node->get_output_sequence_port_count();
 			instance->sequence_index = function.node_count++;
 			instance->sequence_outputs = NULL;
-			instance->pass_idx = -1;
+
+			VisualScriptOperator *op_node = Object::cast_to<VisualScriptOperator>(node.ptr());
+			if (op_node && instance->input_port_count >= 1 && instance->input_port_count <= 2 && instance->output_port_count == 1) {
+				instance->inline_operator = op_node->get_operator();
+			}
 
 			if (instance->input_port_count) {
 				instance->input_ports = memnew_arr(int, instance->input_port_count);
@@ -2320,10 +2326,6 @@ void VisualScriptInstance::create(const Ref<VisualScript> &p_script, Object *p_o
 
 			if (from->get_sequence_output_count() == 0 && to->dependencies.find(from) == -1) {
 				//if the node we are reading from has no output sequence, we must call step() before reading from it.
-				if (from->pass_idx == -1) {
-					from->pass_idx = function.pass_stack_size;
-					function.pass_stack_size++;
-				}
 				to->dependencies.push_back(from);
 			}
 
@@ -2373,6 +2375,17 @@ void VisualScriptInstance::create(const Ref<VisualScript> &p_script, Object *p_o
 			}
 		}
 
+		//fifth pass, flatten dependencies so steps don't walk the data graph at runtime
+
+		for (const Map<int, VisualScript::Function::NodeData>::Element *F = E->get().nodes.front(); F; F = F->next()) {
+
+			ERR_CONTINUE(!instances.has(F->key()));
+			VisualScriptNodeInstance *instance = instances[F->key()];
+
+			Set<VisualScriptNodeInstance *> added;
+			_build_dependency_plan(instance, added, instance->dependency_plan);
+		}
+
 		functions[E->key()] = function;
 	}
 }
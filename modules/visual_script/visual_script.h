@@ -119,12 +119,13 @@ class VisualScriptNodeInstance {
 	VisualScriptNodeInstance **sequence_outputs;
 	int sequence_output_count;
 	Vector<VisualScriptNodeInstance *> dependencies;
+	Vector<VisualScriptNodeInstance *> dependency_plan; // All dependencies, recursively, in the order they run.
 	int *input_ports;
 	int input_port_count;
 	int *output_ports;
 	int output_port_count;
 	int working_mem_idx;
-	int pass_idx;
+	Variant::Operator inline_operator; // Evaluated without step() when not OP_MAX.
 
 	VisualScriptNode *base;
 
@@ -398,7 +399,6 @@ class VisualScriptInstance : public ScriptInstance {
 		int max_stack;
 		int trash_pos;
 		int flow_stack_size;
-		int pass_stack_size;
 		int node_count;
 		int argument_count;
 	};
@@ -410,7 +410,8 @@ class VisualScriptInstance : public ScriptInstance {
 
 	StringName source;
 
-	void _dependency_step(VisualScriptNodeInstance *node, int p_pass, int *pass_stack, const Variant **input_args, Variant **output_args, Variant *variant_stack, Callable::CallError &r_error, String &error_str, VisualScriptNodeInstance **r_error_node);
+	static void _build_dependency_plan(VisualScriptNodeInstance *p_node, Set<VisualScriptNodeInstance *> &r_added, Vector<VisualScriptNodeInstance *> &r_plan);
+	void _dependency_step(VisualScriptNodeInstance *node, const Variant **input_args, Variant **output_args, Variant *variant_stack, Callable::CallError &r_error, String &error_str);
 	Variant _call_internal(const StringName &p_method, void *p_stack, int p_stack_size, VisualScriptNodeInstance *p_node, int p_flow_stack_pos, int p_pass, bool p_resuming_yield, Callable::CallError &r_error);
 
 	//Map<StringName,Function> functions;
@@ -33,6 +33,7 @@
 #include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 #include "servers/audio_server.h"
 
 #include "thirdparty/misc/yuv2rgb.h"
@@ -113,6 +114,7 @@ VideoStreamPlaybackWebm::VideoStreamPlaybackWebm() :
 		time(0.0),
 		video_frame_delay(0.0),
 		video_pos(0.0),
+		frame_index(0),
 		texture(memnew(ImageTexture)),
 		pcm(NULL) {}
 VideoStreamPlaybackWebm::~VideoStreamPlaybackWebm() {
@@ -140,7 +142,8 @@ bool VideoStreamPlaybackWebm::open_file(const String &p_file) {
 				audio = NULL;
 			}
 
-			frame_data.resize((webm->getWidth() * webm->getHeight()) << 2);
+			frame_data[0].resize((webm->getWidth() * webm->getHeight()) << 2);
+			frame_data[1].resize((webm->getWidth() * webm->getHeight()) << 2);
 			Ref<Image> img;
 			img.instance();
 			img->create(webm->getWidth(), webm->getHeight(), false, Image::FORMAT_RGBA8);
@@ -315,7 +318,9 @@ void VideoStreamPlaybackWebm::update(float p_delta) {
 
 					if (err == VPXDecoder::NO_ERROR && image.w == webm->getWidth() && image.h == webm->getHeight()) {
 
-						uint8_t *w = frame_data.ptrw();
+						//write into the buffer the renderer is not holding, so ptrw() does not have to copy it
+						frame_index = (frame_index + 1) % 2;
+						uint8_t *w = frame_data[frame_index].ptrw();
 						bool converted = false;
 
 						if (image.chromaShiftW == 0 && image.chromaShiftH == 0 && image.cs == VPX_CS_SRGB) {
@@ -336,20 +341,29 @@ void VideoStreamPlaybackWebm::update(float p_delta) {
 								bRow += image.linesize[1];
 							}
 							converted = true;
-						} else if (image.chromaShiftW == 1 && image.chromaShiftH == 1) {
-
-							yuv420_2_rgb8888(w, image.planes[0], image.planes[1], image.planes[2], image.w, image.h, image.linesize[0], image.linesize[1], image.w << 2);
-							//libyuv::I420ToARGB(image.planes[0], image.linesize[0], image.planes[2], image.linesize[2], image.planes[1], image.linesize[1], w.ptr(), image.w << 2, image.w, image.h);
-							converted = true;
-						} else if (image.chromaShiftW == 1 && image.chromaShiftH == 0) {
-
-							yuv422_2_rgb8888(w, image.planes[0], image.planes[1], image.planes[2], image.w, image.h, image.linesize[0], image.linesize[1], image.w << 2);
-							//libyuv::I422ToARGB(image.planes[0], image.linesize[0], image.planes[2], image.linesize[2], image.planes[1], image.linesize[1], w.ptr(), image.w << 2, image.w, image.h);
-							converted = true;
-						} else if (image.chromaShiftW == 0 && image.chromaShiftH == 0) {
+						} else if (image.chromaShiftW <= 1 && image.chromaShiftH <= image.chromaShiftW) {
+
+							// 4:2:0, 4:2:2 and 4:4:4. Rows are independent, so convert them in bands across the worker threads.
+							YUVConvertJob job;
+							job.dst = w;
+							job.chroma_shift_w = image.chromaShiftW;
+							job.chroma_shift_h = image.chromaShiftH;
+							job.width = image.w;
+							job.height = image.h;
+							for (int i = 0; i < 3; i++) {
+								job.planes[i] = image.planes[i];
+								job.strides[i] = image.linesize[i];
+							}
 
-							yuv444_2_rgb8888(w, image.planes[0], image.planes[1], image.planes[2], image.w, image.h, image.linesize[0], image.linesize[1], image.w << 2);
-							//libyuv::I444ToARGB(image.planes[0], image.linesize[0], image.planes[2], image.linesize[2], image.planes[1], image.linesize[1], w.ptr(), image.w << 2, image.w, image.h);
+							uint32_t bands = (image.h + YUV_BAND_ROWS - 1) / YUV_BAND_ROWS;
+							ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+							if (pool && bands > 1) {
+								pool->do_work(bands, this, &VideoStreamPlaybackWebm::_convert_yuv_band, (const YUVConvertJob *)&job);
+							} else {
+								for (uint32_t i = 0; i < bands; i++) {
+									_convert_yuv_band(i, &job);
+								}
+							}
 							converted = true;
 						} else if (image.chromaShiftW == 2 && image.chromaShiftH == 0) {
 
@@ -358,7 +372,7 @@ void VideoStreamPlaybackWebm::update(float p_delta) {
 						}
 
 						if (converted) {
-							Ref<Image> img = memnew(Image(image.w, image.h, 0, Image::FORMAT_RGBA8, frame_data));
+							Ref<Image> img = memnew(Image(image.w, image.h, 0, Image::FORMAT_RGBA8, frame_data[frame_index]));
 							texture->update(img); //Zero copy send to visual server
 							video_frame_done = true;
 						}
@@ -406,6 +420,28 @@ inline bool VideoStreamPlaybackWebm::has_enough_video_frames() const {
 	return false;
 }
 
+void VideoStreamPlaybackWebm::_convert_yuv_band(uint32_t p_band, const YUVConvertJob *p_job) {
+
+	int from = p_band * YUV_BAND_ROWS;
+	int rows = MIN((int)YUV_BAND_ROWS, p_job->height - from);
+
+	uint8_t *dst = p_job->dst + from * (p_job->width << 2);
+	const uint8_t *y = p_job->planes[0] + from * p_job->strides[0];
+	const uint8_t *u = p_job->planes[1] + (from >> p_job->chroma_shift_h) * p_job->strides[1];
+	const uint8_t *v = p_job->planes[2] + (from >> p_job->chroma_shift_h) * p_job->strides[2];
+
+	if (p_job->chroma_shift_h == 1) {
+		yuv420_2_rgb8888(dst, y, u, v, p_job->width, rows, p_job->strides[0], p_job->strides[1], p_job->width << 2);
+		//libyuv::I420ToARGB(image.planes[0], image.linesize[0], image.planes[2], image.linesize[2], image.planes[1], image.linesize[1], w.ptr(), image.w << 2, image.w, image.h);
+	} else if (p_job->chroma_shift_w == 1) {
+		yuv422_2_rgb8888(dst, y, u, v, p_job->width, rows, p_job->strides[0], p_job->strides[1], p_job->width << 2);
+		//libyuv::I422ToARGB(image.planes[0], image.linesize[0], image.planes[2], image.linesize[2], image.planes[1], image.linesize[1], w.ptr(), image.w << 2, image.w, image.h);
+	} else {
+		yuv444_2_rgb8888(dst, y, u, v, p_job->width, rows, p_job->strides[0], p_job->strides[1], p_job->width << 2);
+		//libyuv::I444ToARGB(image.planes[0], image.linesize[0], image.planes[2], image.linesize[2], image.planes[1], image.linesize[1], w.ptr(), image.w << 2, image.w, image.h);
+	}
+}
+
 bool VideoStreamPlaybackWebm::should_process(WebMFrame &video_frame) {
 	// FIXME: AudioServer output latency was fixed in af9bb0e, previously it used to
 	// systematically return 0. Now that it gives a proper latency, it broke this
@@ -61,7 +61,22 @@ class VideoStreamPlaybackWebm : public VideoStreamPlayback {
 	double delay_compensation;
 	double time, video_frame_delay, video_pos;
 
-	Vector<uint8_t> frame_data;
+	enum {
+		YUV_BAND_ROWS = 32, // Even, so 4:2:0 chroma rows stay aligned to bands.
+	};
+
+	struct YUVConvertJob {
+		uint8_t *dst;
+		const uint8_t *planes[3];
+		int strides[3];
+		int chroma_shift_w;
+		int chroma_shift_h;
+		int width;
+		int height;
+	};
+
+	Vector<uint8_t> frame_data[2]; // Alternated, so the renderer can hold the previous frame without a copy.
+	int frame_index;
 	Ref<ImageTexture> texture;
 
 	float *pcm;
@@ -98,6 +113,7 @@ public:
 	virtual int get_mix_rate() const;
 
 private:
+	void _convert_yuv_band(uint32_t p_band, const YUVConvertJob *p_job);
 	inline bool has_enough_video_frames() const;
 	bool should_process(WebMFrame &video_frame);
 
@@ -151,20 +151,54 @@ static Ref<Image> _webp_mem_loader_func(const uint8_t *p_png, int p_size) {
 
 Error ImageLoaderWEBP::load_image(Ref<Image> p_image, FileAccess *f, bool p_force_linear, float p_scale) {
 
-	Vector<uint8_t> src_image;
 	int src_image_len = f->get_len();
 	ERR_FAIL_COND_V(src_image_len == 0, ERR_FILE_CORRUPT);
-	src_image.resize(src_image_len);
 
-	uint8_t *w = src_image.ptrw();
+	//decode incrementally as chunks are read, straight into the image data,
+	//instead of reading the whole file first
+	const int CHUNK_SIZE = 16384;
+	uint8_t chunk[CHUNK_SIZE];
 
-	f->get_buffer(&w[0], src_image_len);
+	int read = f->get_buffer(chunk, MIN(CHUNK_SIZE, src_image_len));
 
+	WebPBitstreamFeatures features;
+	VP8StatusCode status = WebPGetFeatures(chunk, read, &features);
+	if (status != VP8_STATUS_OK) {
+		f->close();
+		ERR_FAIL_V(ERR_FILE_CORRUPT);
+	}
+
+	Vector<uint8_t> dst_image;
+	int stride = features.width * (features.has_alpha ? 4 : 3);
+	int datasize = stride * features.height;
+	dst_image.resize(datasize);
+
+	WebPIDecoder *idec = WebPINewRGB(features.has_alpha ? MODE_RGBA : MODE_RGB, dst_image.ptrw(), datasize, stride);
+	if (!idec) {
+		f->close();
+		ERR_FAIL_V(ERR_OUT_OF_MEMORY);
+	}
+
+	int remaining = src_image_len - read;
+	status = WebPIAppend(idec, chunk, read);
+
+	while (status == VP8_STATUS_SUSPENDED && remaining > 0) {
+		read = f->get_buffer(chunk, MIN(CHUNK_SIZE, remaining));
+		if (read <= 0) {
+			break;
+		}
+		remaining -= read;
+		status = WebPIAppend(idec, chunk, read);
+	}
+
+	WebPIDelete(idec);
 	f->close();
 
-	Error err = webp_load_image_from_buffer(p_image.ptr(), w, src_image_len);
+	ERR_FAIL_COND_V_MSG(status != VP8_STATUS_OK, ERR_FILE_CORRUPT, "Failed decoding WebP image.");
 
-	return err;
+	p_image->create(features.width, features.height, 0, features.has_alpha ? Image::FORMAT_RGBA8 : Image::FORMAT_RGB8, dst_image);
+
+	return OK;
 }
 
 void ImageLoaderWEBP::get_recognized_extensions(List<String> *p_extensions) const {
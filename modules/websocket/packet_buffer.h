@@ -92,8 +92,37 @@ public:
 		return OK;
 	}
 
+	// Like read_packet, but the payload is only copied into p_scratch when it wraps around the ring.
+	// The packet stays queued, and r_payload valid, until release_packet() is called.
+	Error peek_packet(const uint8_t **r_payload, uint8_t *p_scratch, int p_scratch_size, T *r_info, int &r_read) {
+		ERR_FAIL_COND_V(_packets.data_left() < 1, ERR_UNAVAILABLE);
+		_Packet p;
+		_packets.copy(&p, 0, 1);
+		ERR_FAIL_COND_V(_payload.data_left() < (int)p.size, ERR_BUG);
+
+		const uint8_t *payload = _payload.peek_contiguous(p.size);
+		if (!payload) {
+			ERR_FAIL_COND_V(p_scratch_size < (int)p.size, ERR_OUT_OF_MEMORY);
+			_payload.copy(p_scratch, 0, p.size);
+			payload = p_scratch;
+		}
+
+		r_read = p.size;
+		copymem(r_info, &p.info, sizeof(T));
+		*r_payload = payload;
+		return OK;
+	}
+
+	void release_packet() {
+		ERR_FAIL_COND(_packets.data_left() < 1);
+		_Packet p;
+		_packets.read(&p, 1);
+		_payload.advance_read(p.size);
+	}
+
+	// Drops the last p_size payload bytes written without packet information.
 	void discard_payload(int p_size) {
-		_packets.decrease_write(p_size);
+		_payload.decrease_write(p_size);
 	}
 
 	void resize(int p_pkt_shift, int p_buf_shift) {
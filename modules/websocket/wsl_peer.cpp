@@ -116,9 +116,38 @@ ssize_t wsl_send_callback(wslay_event_context_ptr ctx, const uint8_t *data, size
 		wslay_event_set_error(ctx, WSLAY_ERR_CALLBACK_FAILURE);
 		return -1;
 	}
+
+	// wslay sends the header and the payload separately, with no_delay that would be two TCP segments per frame.
+	if ((flags & WSLAY_MSG_MORE) && len <= sizeof(peer_data->out_header) - peer_data->out_header_len) {
+		copymem(peer_data->out_header + peer_data->out_header_len, data, len);
+		peer_data->out_header_len += len;
+		return len;
+	}
+
 	Ref<StreamPeer> conn = peer_data->conn;
 	int sent = 0;
-	Error err = conn->put_partial_data(data, len, sent);
+	Error err = OK;
+	int header_len = peer_data->out_header_len;
+	if (header_len) {
+		uint8_t buf[1400];
+		int payload_len = MIN((int)len, (int)sizeof(buf) - header_len);
+		copymem(buf, peer_data->out_header, header_len);
+		copymem(buf + header_len, data, payload_len);
+		err = conn->put_partial_data(buf, header_len + payload_len, sent);
+		if (err == OK) {
+			if (sent < header_len) {
+				// Keep the rest of the header, it must precede the payload.
+				movemem(peer_data->out_header, peer_data->out_header + sent, header_len - sent);
+				peer_data->out_header_len -= sent;
+				sent = 0;
+			} else {
+				peer_data->out_header_len = 0;
+				sent -= header_len;
+			}
+		}
+	} else {
+		err = conn->put_partial_data(data, len, sent);
+	}
 	if (err != OK) {
 		wslay_event_set_error(ctx, WSLAY_ERR_CALLBACK_FAILURE);
 		return -1;
@@ -140,6 +169,22 @@ int wsl_genmask_callback(wslay_event_context_ptr ctx, uint8_t *buf, size_t len,
 	return 0;
 }
 
+void wsl_frame_recv_start_callback(wslay_event_context_ptr ctx, const struct wslay_event_on_frame_recv_start_arg *arg, void *user_data) {
+	struct WSLPeer::PeerData *peer_data = (struct WSLPeer::PeerData *)user_data;
+	if (!peer_data->valid || peer_data->closing) {
+		return;
+	}
+	((WSLPeer *)peer_data->peer)->parse_frame_start(arg);
+}
+
+void wsl_frame_recv_chunk_callback(wslay_event_context_ptr ctx, const struct wslay_event_on_frame_recv_chunk_arg *arg, void *user_data) {
+	struct WSLPeer::PeerData *peer_data = (struct WSLPeer::PeerData *)user_data;
+	if (!peer_data->valid || peer_data->closing) {
+		return;
+	}
+	((WSLPeer *)peer_data->peer)->parse_frame_chunk(arg);
+}
+
 void wsl_msg_recv_callback(wslay_event_context_ptr ctx, const struct wslay_event_on_msg_recv_arg *arg, void *user_data) {
 	struct WSLPeer::PeerData *peer_data = (struct WSLPeer::PeerData *)user_data;
 	if (!peer_data->valid || peer_data->closing) {
@@ -163,12 +208,31 @@ wslay_event_callbacks wsl_callbacks = {
 	wsl_recv_callback,
 	wsl_send_callback,
 	wsl_genmask_callback,
-	NULL, /* on_frame_recv_start_callback */
-	NULL, /* on_frame_recv_callback */
+	wsl_frame_recv_start_callback,
+	wsl_frame_recv_chunk_callback,
 	NULL, /* on_frame_recv_end_callback */
 	wsl_msg_recv_callback
 };
 
+void WSLPeer::parse_frame_start(const wslay_event_on_frame_recv_start_arg *arg) {
+	// Control frames (close, ping, pong) can arrive between fragments and are still buffered by wslay.
+	_in_ctrl_frame = (arg->opcode & 0x8) != 0;
+}
+
+void WSLPeer::parse_frame_chunk(const wslay_event_on_frame_recv_chunk_arg *arg) {
+	if (_in_ctrl_frame || _in_msg_dropped || arg->data_length == 0) {
+		return;
+	}
+	if (_in_buffer.write_packet(arg->data, arg->data_length, NULL) != OK) {
+		// Drop what we already have of this message.
+		_in_buffer.discard_payload(_in_msg_size);
+		_in_msg_size = 0;
+		_in_msg_dropped = true;
+		return;
+	}
+	_in_msg_size += arg->data_length;
+}
+
 Error WSLPeer::parse_message(const wslay_event_on_msg_recv_arg *arg) {
 	uint8_t is_string = 0;
 	if (arg->opcode == WSLAY_TEXT_FRAME) {
@@ -194,8 +258,19 @@ Error WSLPeer::parse_message(const wslay_event_on_msg_recv_arg *arg) {
 		// Ping or pong
 		return ERR_SKIP;
 	}
-	_in_buffer.write_packet(arg->msg, arg->msg_length, &is_string);
-	return OK;
+
+	// The payload is already in _in_buffer, only the packet information is missing.
+	uint32_t size = _in_msg_size;
+	_in_msg_size = 0;
+	if (_in_msg_dropped) {
+		_in_msg_dropped = false;
+		return ERR_OUT_OF_MEMORY;
+	}
+	Error err = _in_buffer.write_packet(NULL, size, &is_string);
+	if (err != OK) {
+		_in_buffer.discard_payload(size);
+	}
+	return err;
 }
 
 void WSLPeer::make_context(PeerData *p_data, unsigned int p_in_buf_size, unsigned int p_in_pkt_size, unsigned int p_out_buf_size, unsigned int p_out_pkt_size) {
@@ -214,6 +289,7 @@ void WSLPeer::make_context(PeerData *p_data, unsigned int p_in_buf_size, unsigne
 	else
 		wslay_event_context_client_init(&(_data->ctx), &wsl_callbacks, _data);
 	wslay_event_config_set_max_recv_msg_length(_data->ctx, (1ULL << p_in_buf_size));
+	wslay_event_config_set_no_buffering(_data->ctx, 1);
 }
 
 void WSLPeer::set_write_mode(WriteMode p_mode) {
@@ -233,6 +309,18 @@ void WSLPeer::poll() {
 	}
 }
 
+bool WSLPeer::has_pending_io() const {
+
+	if (!_data) {
+		return false;
+	}
+	// The SSL layer may hold already decrypted data the socket no longer reports.
+	if (_data->conn.ptr() != _data->tcp.ptr()) {
+		return true;
+	}
+	return wslay_event_want_write(_data->ctx);
+}
+
 Error WSLPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
 
 	ERR_FAIL_COND_V(!is_connected_to_host(), FAILED);
@@ -256,14 +344,20 @@ Error WSLPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
 
 	ERR_FAIL_COND_V(!is_connected_to_host(), FAILED);
 
+	// The previous packet is only released now, the caller could still be reading it until this call.
+	if (_packet_held) {
+		_in_buffer.release_packet();
+		_packet_held = false;
+	}
+
 	if (_in_buffer.packets_left() == 0)
 		return ERR_UNAVAILABLE;
 
 	int read = 0;
-	uint8_t *rw = _packet_buffer.ptrw();
-	_in_buffer.read_packet(rw, _packet_buffer.size(), &_is_string, read);
+	Error err = _in_buffer.peek_packet(r_buffer, _packet_buffer.ptrw(), _packet_buffer.size(), &_is_string, read);
+	ERR_FAIL_COND_V(err != OK, err);
+	_packet_held = true;
 
-	*r_buffer = rw;
 	r_buffer_size = read;
 
 	return OK;
@@ -274,7 +368,7 @@ int WSLPeer::get_available_packet_count() const {
 	if (!is_connected_to_host())
 		return 0;
 
-	return _in_buffer.packets_left();
+	return _in_buffer.packets_left() - (_packet_held ? 1 : 0);
 }
 
 bool WSLPeer::was_string_packet() const {
@@ -302,6 +396,9 @@ void WSLPeer::close(int p_code, String p_reason) {
 
 	_in_buffer.clear();
 	_packet_buffer.resize(0);
+	_packet_held = false;
+	_in_msg_size = 0;
+	_in_msg_dropped = false;
 }
 
 IP_Address WSLPeer::get_connected_host() const {
@@ -332,6 +429,10 @@ void WSLPeer::invalidate() {
 WSLPeer::WSLPeer() {
 	_data = NULL;
 	_is_string = 0;
+	_packet_held = false;
+	_in_ctrl_frame = false;
+	_in_msg_dropped = false;
+	_in_msg_size = 0;
 	close_code = -1;
 	write_mode = WRITE_MODE_BINARY;
 }
@@ -60,6 +60,9 @@ public:
 		Ref<StreamPeerTCP> tcp;
 		int id;
 		wslay_event_context_ptr ctx;
+		// Frame header held back so it goes out in the same write as the start of its payload.
+		uint8_t out_header[16];
+		int out_header_len;
 
 		PeerData() {
 			polling = false;
@@ -71,6 +74,7 @@ public:
 			obj = NULL;
 			closing = false;
 			peer = NULL;
+			out_header_len = 0;
 		}
 	};
 
@@ -86,7 +90,14 @@ private:
 	// Our packet info is just a boolean (is_string), using uint8_t for it.
 	PacketBuffer<uint8_t> _in_buffer;
 
+	// Only used when a packet wraps around the ring, get_packet() points into _in_buffer otherwise.
 	Vector<uint8_t> _packet_buffer;
+	bool _packet_held;
+
+	// Data frames are written into _in_buffer chunk by chunk as wslay parses them.
+	bool _in_ctrl_frame;
+	bool _in_msg_dropped;
+	uint32_t _in_msg_size;
 
 	WriteMode write_mode;
 
@@ -94,6 +105,7 @@ public:
 	int close_code;
 	String close_reason;
 	void poll(); // Used by client and server.
+	bool has_pending_io() const; // True when poll() has work even if the socket is not readable.
 
 	virtual int get_available_packet_count() const;
 	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size);
@@ -112,6 +124,8 @@ public:
 	virtual void set_no_delay(bool p_enabled);
 
 	void make_context(PeerData *p_data, unsigned int p_in_buf_size, unsigned int p_in_pkt_size, unsigned int p_out_buf_size, unsigned int p_out_pkt_size);
+	void parse_frame_start(const wslay_event_on_frame_recv_start_arg *arg);
+	void parse_frame_chunk(const wslay_event_on_frame_recv_chunk_arg *arg);
 	Error parse_message(const wslay_event_on_msg_recv_arg *arg);
 	void invalidate();
 
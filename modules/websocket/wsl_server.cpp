@@ -165,21 +165,60 @@ Error WSLServer::listen(int p_port, const Vector<String> p_protocols, bool gd_mp
 	for (int i = 0; i < p_protocols.size(); i++) {
 		pw[i] = p_protocols[i].strip_edges();
 	}
-	return _server->listen(p_port, bind_ip);
+	Error err = _server->listen(p_port, bind_ip);
+	if (err != OK) {
+		return err;
+	}
+
+	_poller = Ref<NetSocketPoller>(NetSocketPoller::create());
+	if (_poller.is_valid() && _poller->add_socket(_server->get_socket(), NetSocket::POLL_TYPE_IN, NULL) != OK) {
+		_poller.unref(); // Fall back to polling every peer.
+	}
+	return OK;
+}
+
+void WSLServer::_wait_poller() {
+
+	_ready_peers.clear();
+	_accept_ready = false;
+
+	// Keep draining while the buffer comes back full.
+	int count = _poll_events.size();
+	while (count == _poll_events.size()) {
+		count = _poller->wait(_poll_events.ptrw(), _poll_events.size(), 0);
+		for (int i = 0; i < count; i++) {
+			int id = (int)(intptr_t)_poll_events[i].userdata;
+			if (id == 0) {
+				_accept_ready = true;
+			} else {
+				_ready_peers.insert(id);
+			}
+		}
+	}
 }
 
 void WSLServer::poll() {
 
+	if (_poller.is_valid()) {
+		_wait_poller();
+	}
+
 	List<int> remove_ids;
 	for (Map<int, Ref<WebSocketPeer>>::Element *E = _peer_map.front(); E; E = E->next()) {
 		Ref<WSLPeer> peer = (WSLPeer *)E->get().ptr();
-		peer->poll();
+		if (_poller.is_null() || _ready_peers.has(E->key()) || peer->has_pending_io()) {
+			peer->poll();
+		}
 		if (!peer->is_connected_to_host()) {
 			_on_disconnect(E->key(), peer->close_code != -1);
 			remove_ids.push_back(E->key());
 		}
 	}
 	for (List<int>::Element *E = remove_ids.front(); E; E = E->next()) {
+		if (_poller.is_valid() && _peer_sockets.has(E->get())) {
+			_poller->remove_socket(_peer_sockets[E->get()]);
+			_peer_sockets.erase(E->get());
+		}
 		_peer_map.erase(E->get());
 	}
 	remove_ids.clear();
@@ -210,6 +249,15 @@ void WSLServer::poll() {
 
 		_peer_map[id] = ws_peer;
 		remove_peers.push_back(ppeer);
+		if (_poller.is_valid()) {
+			Ref<NetSocket> sock = ppeer->tcp->get_socket();
+			if (_poller->add_socket(sock, NetSocket::POLL_TYPE_IN, (void *)(intptr_t)id) == OK) {
+				_peer_sockets[id] = sock;
+			} else {
+				_poller.unref(); // Fall back to polling every peer.
+				_peer_sockets.clear();
+			}
+		}
 		_on_connect(id, ppeer->protocol);
 	}
 	for (List<Ref<PendingPeer>>::Element *E = remove_peers.front(); E; E = E->next()) {
@@ -220,6 +268,9 @@ void WSLServer::poll() {
 	if (!_server->is_listening())
 		return;
 
+	if (_poller.is_valid() && !_accept_ready)
+		return;
+
 	while (_server->is_connection_available()) {
 		Ref<StreamPeerTCP> conn = _server->take_connection();
 		if (is_refusing_new_connections())
@@ -250,6 +301,9 @@ int WSLServer::get_max_packet_size() const {
 }
 
 void WSLServer::stop() {
+	_poller.unref();
+	_peer_sockets.clear();
+	_ready_peers.clear();
 	_server->stop();
 	for (Map<int, Ref<WebSocketPeer>>::Element *E = _peer_map.front(); E; E = E->next()) {
 		Ref<WSLPeer> peer = (WSLPeer *)E->get().ptr();
@@ -303,6 +357,8 @@ WSLServer::WSLServer() {
 	_out_buf_size = nearest_shift((int)GLOBAL_GET(WSS_OUT_BUF) - 1) + 10;
 	_out_pkt_size = nearest_shift((int)GLOBAL_GET(WSS_OUT_PKT) - 1);
 	_server.instance();
+	_poll_events.resize(256);
+	_accept_ready = false;
 }
 
 WSLServer::~WSLServer() {
@@ -80,6 +80,15 @@ private:
 	Ref<TCP_Server> _server;
 	Vector<String> _protocols;
 
+	// Listening socket (NULL userdata) and connected peers (their id), so poll() only touches ready peers.
+	Ref<NetSocketPoller> _poller;
+	Vector<NetSocketPoller::Event> _poll_events;
+	Map<int, Ref<NetSocket>> _peer_sockets;
+	Set<int> _ready_peers;
+	bool _accept_ready;
+
+	void _wait_poller();
+
 public:
 	Error set_buffers(int p_in_buffer, int p_in_packets, int p_out_buffer, int p_out_packets);
 	Error listen(int p_port, const Vector<String> p_protocols = Vector<String>(), bool gd_mp_api = false);
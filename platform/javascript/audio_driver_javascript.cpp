@@ -30,6 +30,8 @@
 
 #include "audio_driver_javascript.h"
 
+#include "core/os/os.h"
+
 #include <emscripten.h>
 
 AudioDriverJavaScript *AudioDriverJavaScript::singleton = NULL;
@@ -49,10 +51,58 @@ extern "C" EMSCRIPTEN_KEEPALIVE void audio_driver_process_capture(float sample)
 	AudioDriverJavaScript::singleton->process_capture(sample);
 }
 
+#ifndef NO_THREADS
+void AudioDriverJavaScript::thread_func(void *p_udata) {
+
+	AudioDriverJavaScript *ad = (AudioDriverJavaScript *)p_udata;
+	const uint32_t chunk = ad->buffer_length * ad->channel_count;
+
+	while (!ad->exit_thread.load()) {
+
+		uint32_t write = ad->ring_write.load(std::memory_order_relaxed);
+		uint32_t read = ad->ring_read.load(std::memory_order_acquire);
+
+		if (ad->ring_size - (write - read) < chunk) {
+			//the callback has not consumed enough yet
+			OS::get_singleton()->delay_usec(1000);
+			continue;
+		}
+
+		ad->lock();
+		ad->audio_server_process(ad->buffer_length, ad->mix_buffer);
+		ad->unlock();
+
+		for (uint32_t i = 0; i < chunk; i++) {
+			ad->ring_buffer[(write + i) % ad->ring_size] = float(ad->mix_buffer[i] >> 16) / 32768.f;
+		}
+		ad->ring_write.store(write + chunk, std::memory_order_release);
+	}
+}
+#endif
+
 void AudioDriverJavaScript::mix_to_js() {
 
-	int channel_count = get_total_channels_by_speaker_mode(get_speaker_mode());
 	int sample_count = memarr_len(internal_buffer) / channel_count;
+
+#ifndef NO_THREADS
+	if (thread) {
+		uint32_t count = sample_count * channel_count;
+		uint32_t read = ring_read.load(std::memory_order_relaxed);
+		uint32_t available = ring_write.load(std::memory_order_acquire) - read;
+		uint32_t to_copy = MIN(available, count);
+
+		for (uint32_t i = 0; i < to_copy; i++) {
+			internal_buffer[i] = ring_buffer[(read + i) % ring_size];
+		}
+		//underrun, play silence rather than block the browser thread
+		for (uint32_t i = to_copy; i < count; i++) {
+			internal_buffer[i] = 0;
+		}
+		ring_read.store(read + to_copy, std::memory_order_release);
+		return;
+	}
+#endif
+
 	int32_t *stream_buffer = reinterpret_cast<int32_t *>(internal_buffer);
 	audio_server_process(sample_count, stream_buffer);
 	for (int i = 0; i < sample_count * channel_count; i++) {
@@ -63,7 +113,9 @@ void AudioDriverJavaScript::mix_to_js() {
 void AudioDriverJavaScript::process_capture(float sample) {
 
 	int32_t sample32 = int32_t(sample * 32768.f) * (1U << 16);
+	lock();
 	input_buffer_write(sample32);
+	unlock();
 }
 
 Error AudioDriverJavaScript::init() {
@@ -79,7 +131,16 @@ Error AudioDriverJavaScript::init() {
 	});
 	/* clang-format on */
 
-	int channel_count = get_total_channels_by_speaker_mode(get_speaker_mode());
+	/* clang-format off */
+	mix_rate = EM_ASM_INT({
+		return Module.IDHandler.get($0)['context'].sampleRate;
+	}, _driver_id);
+	channel_count = EM_ASM_INT({
+		return Module.IDHandler.get($0)['context'].destination.channelCount;
+	}, _driver_id);
+	/* clang-format on */
+	channel_count = get_total_channels_by_speaker_mode(get_speaker_mode_by_total_channels(channel_count));
+
 	/* clang-format off */
 	buffer_length = EM_ASM_INT({
 		var ref = Module.IDHandler.get($0);
@@ -110,8 +171,18 @@ Error AudioDriverJavaScript::init() {
 			memdelete_arr(internal_buffer);
 		internal_buffer = memnew_arr(float, buffer_length *channel_count);
 	}
+	ERR_FAIL_COND_V(!internal_buffer, ERR_OUT_OF_MEMORY);
 
-	return internal_buffer ? OK : ERR_OUT_OF_MEMORY;
+#ifndef NO_THREADS
+	//power of two, so the free running positions stay consistent when they wrap around
+	ring_size = next_power_of_2(buffer_length * channel_count * RING_BUFFER_CHUNKS);
+	ring_buffer = memnew_arr(float, ring_size);
+	mix_buffer = memnew_arr(int32_t, buffer_length * channel_count);
+	ring_read.store(0);
+	ring_write.store(0);
+#endif
+
+	return OK;
 }
 
 void AudioDriverJavaScript::start() {
@@ -151,6 +222,11 @@ void AudioDriverJavaScript::start() {
 		};
 	}, _driver_id, internal_buffer);
 	/* clang-format on */
+
+#ifndef NO_THREADS
+	exit_thread.store(false);
+	thread = Thread::create(AudioDriverJavaScript::thread_func, this);
+#endif
 }
 
 void AudioDriverJavaScript::resume() {
@@ -165,33 +241,48 @@ void AudioDriverJavaScript::resume() {
 
 int AudioDriverJavaScript::get_mix_rate() const {
 
-	/* clang-format off */
-	return EM_ASM_INT({
-		const ref = Module.IDHandler.get($0);
-		return ref && ref['context'] ? ref['context'].sampleRate : 0;
-	}, _driver_id);
-	/* clang-format on */
+	return mix_rate;
 }
 
 AudioDriver::SpeakerMode AudioDriverJavaScript::get_speaker_mode() const {
 
-	/* clang-format off */
-	return get_speaker_mode_by_total_channels(EM_ASM_INT({
-		const ref = Module.IDHandler.get($0);
-		return ref && ref['context'] ? ref['context'].destination.channelCount : 0;
-	}, _driver_id));
-	/* clang-format on */
+	return get_speaker_mode_by_total_channels(channel_count);
 }
 
-// No locking, as threads are not supported.
 void AudioDriverJavaScript::lock() {
+
+#ifndef NO_THREADS
+	mutex.lock();
+#endif
 }
 
 void AudioDriverJavaScript::unlock() {
+
+#ifndef NO_THREADS
+	mutex.unlock();
+#endif
 }
 
 void AudioDriverJavaScript::finish() {
 
+#ifndef NO_THREADS
+	if (thread) {
+		exit_thread.store(true);
+		Thread::wait_to_finish(thread);
+		memdelete(thread);
+		thread = NULL;
+	}
+
+	if (ring_buffer) {
+		memdelete_arr(ring_buffer);
+		ring_buffer = NULL;
+	}
+	if (mix_buffer) {
+		memdelete_arr(mix_buffer);
+		mix_buffer = NULL;
+	}
+#endif
+
 	/* clang-format off */
 	EM_ASM({
 		Module.IDHandler.remove($0);
@@ -266,6 +357,15 @@ AudioDriverJavaScript::AudioDriverJavaScript() {
 	_driver_id = 0;
 	internal_buffer = NULL;
 	buffer_length = 0;
+	mix_rate = 0;
+	channel_count = 2;
+
+#ifndef NO_THREADS
+	ring_buffer = NULL;
+	mix_buffer = NULL;
+	ring_size = 0;
+	thread = NULL;
+#endif
 
 	singleton = this;
 }
@@ -31,8 +31,14 @@
 #ifndef AUDIO_DRIVER_JAVASCRIPT_H
 #define AUDIO_DRIVER_JAVASCRIPT_H
 
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "servers/audio_server.h"
 
+#ifndef NO_THREADS
+#include <atomic>
+#endif
+
 class AudioDriverJavaScript : public AudioDriver {
 
 	float *internal_buffer;
@@ -40,6 +46,29 @@ class AudioDriverJavaScript : public AudioDriver {
 	int _driver_id;
 	int buffer_length;
 
+	//queried once in init(), the audio context is not reachable from worker threads
+	int mix_rate;
+	int channel_count;
+
+#ifndef NO_THREADS
+	enum {
+		RING_BUFFER_CHUNKS = 3,
+	};
+
+	//mixed ahead of time by the audio thread, read by the script processor callback
+	float *ring_buffer;
+	int32_t *mix_buffer;
+	uint32_t ring_size;
+	std::atomic<uint32_t> ring_read;
+	std::atomic<uint32_t> ring_write;
+
+	Thread *thread;
+	Mutex mutex;
+	std::atomic<bool> exit_thread;
+
+	static void thread_func(void *p_udata);
+#endif
+
 public:
 	void mix_to_js();
 	void process_capture(float sample);
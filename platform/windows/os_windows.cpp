@@ -408,8 +408,30 @@ uint64_t OS_Windows::get_system_time_msecs() const {
 	return (uint64_t)(ret / WINDOWS_TICK - MSEC_TO_UNIX_EPOCH);
 }
 
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
 void OS_Windows::delay_usec(uint32_t p_usec) const {
 
+	// Sleep() rounds up to the scheduler tick, high resolution waitable timers
+	// (Windows 10 1803 and later) don't. Any thread may sleep, so each gets its own.
+	static thread_local HANDLE timer = NULL;
+	static thread_local bool timer_created = false;
+	if (!timer_created) {
+		timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		timer_created = true;
+	}
+
+	if (timer) {
+		LARGE_INTEGER due_time;
+		due_time.QuadPart = -int64_t(p_usec) * 10; // relative, in 100 ns units
+		if (SetWaitableTimer(timer, &due_time, 0, NULL, NULL, FALSE)) {
+			WaitForSingleObject(timer, INFINITE);
+			return;
+		}
+	}
+
 	if (p_usec < 1000)
 		Sleep(1);
 	else
@@ -33,6 +33,7 @@
 #include "core/engine.h"
 #include "scene/2d/area_2d.h"
 #include "scene/main/window.h"
+#include "servers/audio/audio_mix.h"
 
 void AudioStreamPlayer2D::_mix_audio() {
 
@@ -44,13 +45,43 @@ void AudioStreamPlayer2D::_mix_audio() {
 	if (setseek >= 0.0) {
 		stream_playback->start(setseek);
 		setseek = -1.0; //reset seek
+		if (voice_virtual_time >= 0) {
+			voice_virtual_time = 0;
+		}
 	}
 
 	//get data
 	AudioFrame *buffer = mix_buffer.ptrw();
 	int buffer_size = mix_buffer.size();
+	bool fade_out = stream_paused_fade_out;
 
-	if (stream_paused_fade_out) {
+	if (voice_virtual) {
+		if (voice_virtual_time >= 0) {
+			// Not heard, only advance the time without decoding or mixing
+			if (!stream_paused) {
+				voice_virtual_time += buffer_size * pitch_scale / AudioServer::get_singleton()->get_mix_rate();
+			}
+			stream_paused_fade_out = false;
+			output_ready = false;
+			return;
+		}
+		// Became virtual, fade out this step
+		voice_virtual_time = 0;
+		fade_out = true;
+	} else if (voice_virtual_time >= 0) {
+		// Audible again, continue from where it would be now
+		if (voice_virtual_time > 0) {
+			stream_playback->skip(voice_virtual_time);
+		}
+		voice_virtual_time = -1;
+		if (!stream_playback->is_playing()) {
+			active = false;
+			return;
+		}
+		stream_paused_fade_in = true;
+	}
+
+	if (fade_out) {
 		// Short fadeout ramp
 		buffer_size = MIN(buffer_size, 128);
 	}
@@ -84,10 +115,8 @@ void AudioStreamPlayer2D::_mix_audio() {
 		}
 
 		//mix!
-		AudioFrame target_volume = stream_paused_fade_out ? AudioFrame(0.f, 0.f) : current.vol;
+		AudioFrame target_volume = fade_out ? AudioFrame(0.f, 0.f) : current.vol;
 		AudioFrame vol_prev = stream_paused_fade_in ? AudioFrame(0.f, 0.f) : prev_outputs[i].vol;
-		AudioFrame vol_inc = (target_volume - vol_prev) / float(buffer_size);
-		AudioFrame vol = vol_prev;
 
 		int cc = AudioServer::get_singleton()->get_channel_count();
 
@@ -97,11 +126,7 @@ void AudioStreamPlayer2D::_mix_audio() {
 
 			AudioFrame *target = AudioServer::get_singleton()->thread_get_channel_mix_buffer(current.bus_index, 0);
 
-			for (int j = 0; j < buffer_size; j++) {
-
-				target[j] += buffer[j] * vol;
-				vol += vol_inc;
-			}
+			AudioMix::add_ramp(target, buffer, buffer_size, vol_prev, target_volume);
 
 		} else {
 			AudioFrame *targets[4];
@@ -119,13 +144,8 @@ void AudioStreamPlayer2D::_mix_audio() {
 			if (!valid)
 				continue;
 
-			for (int j = 0; j < buffer_size; j++) {
-
-				AudioFrame frame = buffer[j] * vol;
-				for (int k = 0; k < cc; k++) {
-					targets[k][j] += frame;
-				}
-				vol += vol_inc;
+			for (int k = 0; k < cc; k++) {
+				AudioMix::add_ramp(targets[k], buffer, buffer_size, vol_prev, target_volume);
 			}
 		}
 
@@ -134,6 +154,11 @@ void AudioStreamPlayer2D::_mix_audio() {
 
 	prev_output_count = output_count;
 
+	if (voice_virtual_time >= 0 && !stream_paused) {
+		// Rest of the step after the fadeout
+		voice_virtual_time += (mix_buffer.size() - buffer_size) * pitch_scale / AudioServer::get_singleton()->get_mix_rate();
+	}
+
 	//stream is no longer active, disable this.
 	if (!stream_playback->is_playing()) {
 		active = false;
@@ -157,6 +182,7 @@ void AudioStreamPlayer2D::_notification(int p_what) {
 	if (p_what == NOTIFICATION_EXIT_TREE) {
 
 		AudioServer::get_singleton()->remove_callback(_mix_audios, this);
+		AudioServer::get_singleton()->voice_remove(get_instance_id());
 	}
 
 	if (p_what == NOTIFICATION_PAUSED) {
@@ -258,6 +284,8 @@ void AudioStreamPlayer2D::_notification(int p_what) {
 			//_change_notify("playing"); //update property in editor
 		}
 
+		_update_voice();
+
 		//stop playing if no longer active
 		if (!active) {
 			set_physics_process_internal(false);
@@ -268,6 +296,26 @@ void AudioStreamPlayer2D::_notification(int p_what) {
 	}
 }
 
+void AudioStreamPlayer2D::_update_voice() {
+
+	if (!active) {
+		AudioServer::get_singleton()->voice_remove(get_instance_id());
+		voice_virtual = false;
+		return;
+	}
+
+	float volume = 0;
+	for (int i = 0; i < output_count; i++) {
+		volume = MAX(volume, MAX(outputs[i].vol.l, outputs[i].vol.r));
+	}
+
+	int bus_index = output_count ? outputs[0].bus_index : AudioServer::get_singleton()->thread_find_bus_index(bus);
+
+	// Decided on the last server update, so it applies a frame later
+	AudioServer::get_singleton()->voice_update(get_instance_id(), bus_index, priority, volume);
+	voice_virtual = AudioServer::get_singleton()->voice_is_virtual(get_instance_id());
+}
+
 void AudioStreamPlayer2D::set_stream(Ref<AudioStream> p_stream) {
 
 	AudioServer::get_singleton()->lock();
@@ -326,6 +374,7 @@ void AudioStreamPlayer2D::play(float p_from_pos) {
 		active = true;
 		setplay = p_from_pos;
 		output_ready = false;
+		voice_virtual = false;
 		set_physics_process_internal(true);
 	}
 }
@@ -343,6 +392,7 @@ void AudioStreamPlayer2D::stop() {
 		active = false;
 		set_physics_process_internal(false);
 		setplay = -1;
+		AudioServer::get_singleton()->voice_remove(get_instance_id());
 	}
 }
 
@@ -358,7 +408,11 @@ bool AudioStreamPlayer2D::is_playing() const {
 float AudioStreamPlayer2D::get_playback_position() {
 
 	if (stream_playback.is_valid()) {
-		return stream_playback->get_playback_position();
+		float position = stream_playback->get_playback_position();
+		if (voice_virtual_time > 0) {
+			position += voice_virtual_time;
+		}
+		return position;
 	}
 
 	return 0;
@@ -453,6 +507,16 @@ uint32_t AudioStreamPlayer2D::get_area_mask() const {
 	return area_mask;
 }
 
+void AudioStreamPlayer2D::set_priority(int p_priority) {
+
+	priority = p_priority;
+}
+
+int AudioStreamPlayer2D::get_priority() const {
+
+	return priority;
+}
+
 void AudioStreamPlayer2D::set_stream_paused(bool p_pause) {
 
 	if (p_pause != stream_paused) {
@@ -507,6 +571,9 @@ void AudioStreamPlayer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_area_mask", "mask"), &AudioStreamPlayer2D::set_area_mask);
 	ClassDB::bind_method(D_METHOD("get_area_mask"), &AudioStreamPlayer2D::get_area_mask);
 
+	ClassDB::bind_method(D_METHOD("set_priority", "priority"), &AudioStreamPlayer2D::set_priority);
+	ClassDB::bind_method(D_METHOD("get_priority"), &AudioStreamPlayer2D::get_priority);
+
 	ClassDB::bind_method(D_METHOD("set_stream_paused", "pause"), &AudioStreamPlayer2D::set_stream_paused);
 	ClassDB::bind_method(D_METHOD("get_stream_paused"), &AudioStreamPlayer2D::get_stream_paused);
 
@@ -522,6 +589,7 @@ void AudioStreamPlayer2D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "attenuation", PROPERTY_HINT_EXP_EASING, "attenuation"), "set_attenuation", "get_attenuation");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "bus", PROPERTY_HINT_ENUM, ""), "set_bus", "get_bus");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "area_mask", PROPERTY_HINT_LAYERS_2D_PHYSICS), "set_area_mask", "get_area_mask");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "priority"), "set_priority", "get_priority");
 
 	ADD_SIGNAL(MethodInfo("finished"));
 }
@@ -543,6 +611,9 @@ AudioStreamPlayer2D::AudioStreamPlayer2D() {
 	stream_paused = false;
 	stream_paused_fade_in = false;
 	stream_paused_fade_out = false;
+	priority = 0;
+	voice_virtual = false;
+	voice_virtual_time = -1;
 	AudioServer::get_singleton()->connect("bus_layout_changed", callable_mp(this, &AudioStreamPlayer2D::_bus_layout_changed));
 }
 
@@ -77,6 +77,10 @@ private:
 	bool stream_paused_fade_out;
 	StringName bus;
 
+	int priority;
+	volatile bool voice_virtual; //not heard, the audio thread only keeps track of the time
+	volatile float voice_virtual_time; //time played while virtual, -1 if real
+
 	void _mix_audio();
 	static void _mix_audios(void *self) { reinterpret_cast<AudioStreamPlayer2D *>(self)->_mix_audio(); }
 
@@ -84,6 +88,7 @@ private:
 	bool _is_active() const;
 
 	void _bus_layout_changed();
+	void _update_voice();
 
 	uint32_t area_mask;
 
@@ -126,6 +131,9 @@ public:
 	void set_area_mask(uint32_t p_mask);
 	uint32_t get_area_mask() const;
 
+	void set_priority(int p_priority);
+	int get_priority() const;
+
 	void set_stream_paused(bool p_pause);
 	bool get_stream_paused() const;
 
@@ -31,6 +31,7 @@
 #include "cpu_particles_2d.h"
 
 #include "core/core_string_names.h"
+#include "core/thread_work_pool.h"
 #include "scene/2d/gpu_particles_2d.h"
 #include "scene/main/canvas_item.h"
 #include "scene/resources/particles_material.h"
@@ -656,9 +657,13 @@ void CPUParticles2D::_particles_process(float p_delta) {
 
 	float system_phase = time / lifetime;
 
+	process_steps.resize(pcount);
+	process_deltas.resize(pcount);
+
 	for (int i = 0; i < pcount; i++) {
 
 		Particle &p = parray[i];
+		process_steps[i] = STEP_SKIP;
 
 		if (!emitting && !p.active)
 			continue;
@@ -684,6 +689,7 @@ void CPUParticles2D::_particles_process(float p_delta) {
 		restart_phase *= (1.0 - explosiveness_ratio);
 		float restart_time = restart_phase * lifetime;
 		bool restart = false;
+		ParticleStep step = STEP_SHADE;
 
 		if (time > prev_time) {
 			// restart_time >= prev_time is used so particles emit in the first frame they are processed
@@ -806,168 +812,204 @@ void CPUParticles2D::_particles_process(float p_delta) {
 		} else if (p.time > p.lifetime) {
 			p.active = false;
 		} else {
+			step = STEP_INTEGRATE;
+		}
 
-			uint32_t alt_seed = p.seed;
+		process_steps[i] = step;
+		process_deltas[i] = local_delta;
+	}
 
-			p.time += local_delta;
-			p.custom[1] = p.time / lifetime;
+	if (color_ramp.is_valid()) {
+		color_ramp->get_color_at_offset(0.0); //sorts the points, so the steps below only read them
+	}
 
-			float tex_linear_velocity = 0.0;
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->interpolate(p.custom[1]);
-			}
+	ProcessFrame frame;
+	frame.particles = parray;
+	frame.emission_xform = emission_xform;
 
-			float tex_orbit_velocity = 0.0;
-			if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
-				tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->interpolate(p.custom[1]);
-			}
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
 
-			float tex_angular_velocity = 0.0;
-			if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
-				tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->interpolate(p.custom[1]);
-			}
+	if (pcount >= PARALLEL_MIN_PARTICLES && pool && pool->get_thread_count() > 0) {
+		pool->do_work(pcount, this, &CPUParticles2D::_particle_step, &frame);
+	} else {
+		for (int i = 0; i < pcount; i++) {
+			_particle_step(i, &frame);
+		}
+	}
+}
 
-			float tex_linear_accel = 0.0;
-			if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
-				tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->interpolate(p.custom[1]);
-			}
+void CPUParticles2D::_particle_step(uint32_t p_index, ProcessFrame *p_frame) {
 
-			float tex_tangential_accel = 0.0;
-			if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
-				tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->interpolate(p.custom[1]);
-			}
+	ParticleStep step = ParticleStep(process_steps[p_index]);
+	if (step == STEP_SKIP) {
+		return;
+	}
 
-			float tex_radial_accel = 0.0;
-			if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
-				tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->interpolate(p.custom[1]);
-			}
+	Particle &p = p_frame->particles[p_index];
+	float local_delta = process_deltas[p_index];
+	const Transform2D &emission_xform = p_frame->emission_xform;
 
-			float tex_damping = 0.0;
-			if (curve_parameters[PARAM_DAMPING].is_valid()) {
-				tex_damping = curve_parameters[PARAM_DAMPING]->interpolate(p.custom[1]);
-			}
+	if (step == STEP_INTEGRATE) {
+		uint32_t alt_seed = p.seed;
 
-			float tex_angle = 0.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->interpolate(p.custom[1]);
-			}
-			float tex_anim_speed = 0.0;
-			if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
-				tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->interpolate(p.custom[1]);
-			}
+		p.time += local_delta;
+		p.custom[1] = p.time / lifetime;
 
-			float tex_anim_offset = 0.0;
-			if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->interpolate(p.custom[1]);
-			}
+		float tex_linear_velocity = 0.0;
+		if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+			tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->interpolate(p.custom[1]);
+		}
 
-			Vector2 force = gravity;
-			Vector2 pos = p.transform[2];
-
-			//apply linear acceleration
-			force += p.velocity.length() > 0.0 ? p.velocity.normalized() * (parameters[PARAM_LINEAR_ACCEL] + tex_linear_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_LINEAR_ACCEL]) : Vector2();
-			//apply radial acceleration
-			Vector2 org = emission_xform[2];
-			Vector2 diff = pos - org;
-			force += diff.length() > 0.0 ? diff.normalized() * (parameters[PARAM_RADIAL_ACCEL] + tex_radial_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_RADIAL_ACCEL]) : Vector2();
-			//apply tangential acceleration;
-			Vector2 yx = Vector2(diff.y, diff.x);
-			force += yx.length() > 0.0 ? (yx * Vector2(-1.0, 1.0)).normalized() * ((parameters[PARAM_TANGENTIAL_ACCEL] + tex_tangential_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_TANGENTIAL_ACCEL])) : Vector2();
-			//apply attractor forces
-			p.velocity += force * local_delta;
-			//orbit velocity
-			float orbit_amount = (parameters[PARAM_ORBIT_VELOCITY] + tex_orbit_velocity) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_ORBIT_VELOCITY]);
-			if (orbit_amount != 0.0) {
-				float ang = orbit_amount * local_delta * Math_PI * 2.0;
-				// Not sure why the ParticlesMaterial code uses a clockwise rotation matrix,
-				// but we use -ang here to reproduce its behavior.
-				Transform2D rot = Transform2D(-ang, Vector2());
-				p.transform[2] -= diff;
-				p.transform[2] += rot.basis_xform(diff);
-			}
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				p.velocity = p.velocity.normalized() * tex_linear_velocity;
-			}
+		float tex_orbit_velocity = 0.0;
+		if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
+			tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->interpolate(p.custom[1]);
+		}
 
-			if (parameters[PARAM_DAMPING] + tex_damping > 0.0) {
+		float tex_angular_velocity = 0.0;
+		if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
+			tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->interpolate(p.custom[1]);
+		}
 
-				float v = p.velocity.length();
-				float damp = (parameters[PARAM_DAMPING] + tex_damping) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_DAMPING]);
-				v -= damp * local_delta;
-				if (v < 0.0) {
-					p.velocity = Vector2();
-				} else {
-					p.velocity = p.velocity.normalized() * v;
-				}
-			}
-			float base_angle = (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, p.angle_rand, randomness[PARAM_ANGLE]);
-			base_angle += p.custom[1] * lifetime * (parameters[PARAM_ANGULAR_VELOCITY] + tex_angular_velocity) * Math::lerp(1.0f, rand_from_seed(alt_seed) * 2.0f - 1.0f, randomness[PARAM_ANGULAR_VELOCITY]);
-			p.rotation = Math::deg2rad(base_angle); //angle
-			float animation_phase = (parameters[PARAM_ANIM_OFFSET] + tex_anim_offset) * Math::lerp(1.0f, p.anim_offset_rand, randomness[PARAM_ANIM_OFFSET]) + p.custom[1] * (parameters[PARAM_ANIM_SPEED] + tex_anim_speed) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_ANIM_SPEED]);
-			p.custom[2] = animation_phase;
+		float tex_linear_accel = 0.0;
+		if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
+			tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->interpolate(p.custom[1]);
 		}
-		//apply color
-		//apply hue rotation
 
-		float tex_scale = 1.0;
-		if (curve_parameters[PARAM_SCALE].is_valid()) {
-			tex_scale = curve_parameters[PARAM_SCALE]->interpolate(p.custom[1]);
+		float tex_tangential_accel = 0.0;
+		if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
+			tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->interpolate(p.custom[1]);
 		}
 
-		float tex_hue_variation = 0.0;
-		if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
-			tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->interpolate(p.custom[1]);
+		float tex_radial_accel = 0.0;
+		if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
+			tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->interpolate(p.custom[1]);
 		}
 
-		float hue_rot_angle = (parameters[PARAM_HUE_VARIATION] + tex_hue_variation) * Math_PI * 2.0 * Math::lerp(1.0f, p.hue_rot_rand * 2.0f - 1.0f, randomness[PARAM_HUE_VARIATION]);
-		float hue_rot_c = Math::cos(hue_rot_angle);
-		float hue_rot_s = Math::sin(hue_rot_angle);
+		float tex_damping = 0.0;
+		if (curve_parameters[PARAM_DAMPING].is_valid()) {
+			tex_damping = curve_parameters[PARAM_DAMPING]->interpolate(p.custom[1]);
+		}
 
-		Basis hue_rot_mat;
-		{
-			Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
-			Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
-			Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
+		float tex_angle = 0.0;
+		if (curve_parameters[PARAM_ANGLE].is_valid()) {
+			tex_angle = curve_parameters[PARAM_ANGLE]->interpolate(p.custom[1]);
+		}
+		float tex_anim_speed = 0.0;
+		if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
+			tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->interpolate(p.custom[1]);
+		}
 
-			for (int j = 0; j < 3; j++) {
-				hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
-			}
+		float tex_anim_offset = 0.0;
+		if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
+			tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->interpolate(p.custom[1]);
 		}
 
-		if (color_ramp.is_valid()) {
-			p.color = color_ramp->get_color_at_offset(p.custom[1]) * color;
-		} else {
-			p.color = color;
+		Vector2 force = gravity;
+		Vector2 pos = p.transform[2];
+
+		//apply linear acceleration
+		force += p.velocity.length() > 0.0 ? p.velocity.normalized() * (parameters[PARAM_LINEAR_ACCEL] + tex_linear_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_LINEAR_ACCEL]) : Vector2();
+		//apply radial acceleration
+		Vector2 org = emission_xform[2];
+		Vector2 diff = pos - org;
+		force += diff.length() > 0.0 ? diff.normalized() * (parameters[PARAM_RADIAL_ACCEL] + tex_radial_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_RADIAL_ACCEL]) : Vector2();
+		//apply tangential acceleration;
+		Vector2 yx = Vector2(diff.y, diff.x);
+		force += yx.length() > 0.0 ? (yx * Vector2(-1.0, 1.0)).normalized() * ((parameters[PARAM_TANGENTIAL_ACCEL] + tex_tangential_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_TANGENTIAL_ACCEL])) : Vector2();
+		//apply attractor forces
+		p.velocity += force * local_delta;
+		//orbit velocity
+		float orbit_amount = (parameters[PARAM_ORBIT_VELOCITY] + tex_orbit_velocity) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_ORBIT_VELOCITY]);
+		if (orbit_amount != 0.0) {
+			float ang = orbit_amount * local_delta * Math_PI * 2.0;
+			// Not sure why the ParticlesMaterial code uses a clockwise rotation matrix,
+			// but we use -ang here to reproduce its behavior.
+			Transform2D rot = Transform2D(-ang, Vector2());
+			p.transform[2] -= diff;
+			p.transform[2] += rot.basis_xform(diff);
+		}
+		if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+			p.velocity = p.velocity.normalized() * tex_linear_velocity;
 		}
 
-		Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
-		p.color.r = color_rgb.x;
-		p.color.g = color_rgb.y;
-		p.color.b = color_rgb.z;
+		if (parameters[PARAM_DAMPING] + tex_damping > 0.0) {
+
+			float v = p.velocity.length();
+			float damp = (parameters[PARAM_DAMPING] + tex_damping) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_DAMPING]);
+			v -= damp * local_delta;
+			if (v < 0.0) {
+				p.velocity = Vector2();
+			} else {
+				p.velocity = p.velocity.normalized() * v;
+			}
+		}
+		float base_angle = (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, p.angle_rand, randomness[PARAM_ANGLE]);
+		base_angle += p.custom[1] * lifetime * (parameters[PARAM_ANGULAR_VELOCITY] + tex_angular_velocity) * Math::lerp(1.0f, rand_from_seed(alt_seed) * 2.0f - 1.0f, randomness[PARAM_ANGULAR_VELOCITY]);
+		p.rotation = Math::deg2rad(base_angle); //angle
+		float animation_phase = (parameters[PARAM_ANIM_OFFSET] + tex_anim_offset) * Math::lerp(1.0f, p.anim_offset_rand, randomness[PARAM_ANIM_OFFSET]) + p.custom[1] * (parameters[PARAM_ANIM_SPEED] + tex_anim_speed) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_ANIM_SPEED]);
+		p.custom[2] = animation_phase;
+	}
+	//apply color
+	//apply hue rotation
 
-		p.color *= p.base_color;
+	float tex_scale = 1.0;
+	if (curve_parameters[PARAM_SCALE].is_valid()) {
+		tex_scale = curve_parameters[PARAM_SCALE]->interpolate(p.custom[1]);
+	}
 
-		if (flags[FLAG_ALIGN_Y_TO_VELOCITY]) {
-			if (p.velocity.length() > 0.0) {
+	float tex_hue_variation = 0.0;
+	if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
+		tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->interpolate(p.custom[1]);
+	}
 
-				p.transform.elements[1] = p.velocity.normalized();
-				p.transform.elements[0] = p.transform.elements[1].tangent();
-			}
+	float hue_rot_angle = (parameters[PARAM_HUE_VARIATION] + tex_hue_variation) * Math_PI * 2.0 * Math::lerp(1.0f, p.hue_rot_rand * 2.0f - 1.0f, randomness[PARAM_HUE_VARIATION]);
+	float hue_rot_c = Math::cos(hue_rot_angle);
+	float hue_rot_s = Math::sin(hue_rot_angle);
 
-		} else {
-			p.transform.elements[0] = Vector2(Math::cos(p.rotation), -Math::sin(p.rotation));
-			p.transform.elements[1] = Vector2(Math::sin(p.rotation), Math::cos(p.rotation));
+	Basis hue_rot_mat;
+	{
+		Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
+		Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
+		Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
+
+		for (int j = 0; j < 3; j++) {
+			hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
 		}
+	}
 
-		//scale by scale
-		float base_scale = tex_scale * Math::lerp(parameters[PARAM_SCALE], 1.0f, p.scale_rand * randomness[PARAM_SCALE]);
-		if (base_scale < 0.000001) base_scale = 0.000001;
+	if (color_ramp.is_valid()) {
+		p.color = color_ramp->get_color_at_offset(p.custom[1]) * color;
+	} else {
+		p.color = color;
+	}
 
-		p.transform.elements[0] *= base_scale;
-		p.transform.elements[1] *= base_scale;
+	Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
+	p.color.r = color_rgb.x;
+	p.color.g = color_rgb.y;
+	p.color.b = color_rgb.z;
+
+	p.color *= p.base_color;
+
+	if (flags[FLAG_ALIGN_Y_TO_VELOCITY]) {
+		if (p.velocity.length() > 0.0) {
+
+			p.transform.elements[1] = p.velocity.normalized();
+			p.transform.elements[0] = p.transform.elements[1].tangent();
+		}
 
-		p.transform[2] += p.velocity * local_delta;
+	} else {
+		p.transform.elements[0] = Vector2(Math::cos(p.rotation), -Math::sin(p.rotation));
+		p.transform.elements[1] = Vector2(Math::sin(p.rotation), Math::cos(p.rotation));
 	}
+
+	//scale by scale
+	float base_scale = tex_scale * Math::lerp(parameters[PARAM_SCALE], 1.0f, p.scale_rand * randomness[PARAM_SCALE]);
+	if (base_scale < 0.000001) base_scale = 0.000001;
+
+	p.transform.elements[0] *= base_scale;
+	p.transform.elements[1] *= base_scale;
+
+	p.transform[2] += p.velocity * local_delta;
 }
 
 void CPUParticles2D::_update_particle_data_buffer() {
@@ -980,7 +1022,6 @@ void CPUParticles2D::_update_particle_data_buffer() {
 
 	float *w = particle_data.ptrw();
 	const Particle *r = particles.ptr();
-	float *ptr = w;
 
 	if (draw_order != DRAW_ORDER_INDEX) {
 		ow = particle_order.ptrw();
@@ -996,45 +1037,61 @@ void CPUParticles2D::_update_particle_data_buffer() {
 		}
 	}
 
-	for (int i = 0; i < pc; i++) {
-
-		int idx = order ? order[i] : i;
+	InstanceWrite write;
+	write.particles = r;
+	write.order = order;
+	write.data = w;
 
-		Transform2D t = r[idx].transform;
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
 
-		if (!local_coords) {
-			t = inv_emission_transform * t;
+	if (pc >= PARALLEL_MIN_PARTICLES && pool && pool->get_thread_count() > 0) {
+		pool->do_work(pc, this, &CPUParticles2D::_write_particle_instance, &write);
+	} else {
+		for (int i = 0; i < pc; i++) {
+			_write_particle_instance(i, &write);
 		}
+	}
+}
 
-		if (r[idx].active) {
+void CPUParticles2D::_write_particle_instance(uint32_t p_index, InstanceWrite *p_write) {
 
-			ptr[0] = t.elements[0][0];
-			ptr[1] = t.elements[1][0];
-			ptr[2] = 0;
-			ptr[3] = t.elements[2][0];
-			ptr[4] = t.elements[0][1];
-			ptr[5] = t.elements[1][1];
-			ptr[6] = 0;
-			ptr[7] = t.elements[2][1];
+	const Particle *r = p_write->particles;
+	int idx = p_write->order ? p_write->order[p_index] : p_index;
+	float *ptr = p_write->data + p_index * 16;
 
-		} else {
-			zeromem(ptr, sizeof(float) * 8);
-		}
 
-		Color c = r[idx].color;
+	Transform2D t = r[idx].transform;
+
+	if (!local_coords) {
+		t = inv_emission_transform * t;
+	}
 
-		ptr[8] = c.r;
-		ptr[9] = c.g;
-		ptr[10] = c.b;
-		ptr[11] = c.a;
+	if (r[idx].active) {
 
-		ptr[12] = r[idx].custom[0];
-		ptr[13] = r[idx].custom[1];
-		ptr[14] = r[idx].custom[2];
-		ptr[15] = r[idx].custom[3];
+		ptr[0] = t.elements[0][0];
+		ptr[1] = t.elements[1][0];
+		ptr[2] = 0;
+		ptr[3] = t.elements[2][0];
+		ptr[4] = t.elements[0][1];
+		ptr[5] = t.elements[1][1];
+		ptr[6] = 0;
+		ptr[7] = t.elements[2][1];
 
-		ptr += 16;
+	} else {
+		zeromem(ptr, sizeof(float) * 8);
 	}
+
+	Color c = r[idx].color;
+
+	ptr[8] = c.r;
+	ptr[9] = c.g;
+	ptr[10] = c.b;
+	ptr[11] = c.a;
+
+	ptr[12] = r[idx].custom[0];
+	ptr[13] = r[idx].custom[1];
+	ptr[14] = r[idx].custom[2];
+	ptr[15] = r[idx].custom[3];
 }
 
 void CPUParticles2D::_set_redraw(bool p_redraw) {
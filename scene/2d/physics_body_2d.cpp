@@ -40,6 +40,25 @@
 #include "scene/scene_string_names.h"
 
 void PhysicsBody2D::_notification(int p_what) {
+
+	switch (p_what) {
+
+		case NOTIFICATION_ENTER_TREE: {
+
+			//bodies only move on physics ticks, let the server blend their canvas transform between them
+			if (get_tree()->is_physics_interpolation_enabled()) {
+				RenderingServer::get_singleton()->canvas_item_set_interpolated(get_canvas_item(), true);
+			}
+		} break;
+		case NOTIFICATION_RESET_PHYSICS_INTERPOLATION: {
+
+			RenderingServer::get_singleton()->canvas_item_reset_physics_interpolation(get_canvas_item());
+		} break;
+		case NOTIFICATION_EXIT_TREE: {
+
+			RenderingServer::get_singleton()->canvas_item_set_interpolated(get_canvas_item(), false);
+		} break;
+	}
 }
 
 void PhysicsBody2D::_set_layers(uint32_t p_mask) {
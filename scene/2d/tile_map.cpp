@@ -325,6 +325,51 @@ void TileMap::_add_shape(int &shape_idx, const Quadrant &p_q, const Ref<Shape2D>
 	shape_idx++;
 }
 
+void TileMap::_quadrant_mesh_add_rect(QuadrantMesh &r_mesh, const Rect2 &p_rect, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose) {
+
+	//same placement as a texture rect command: flipping mirrors the tile in place, transposing swaps its size
+	bool flip_h = p_rect.size.x < 0;
+	bool flip_v = p_rect.size.y < 0;
+	Vector2 size = p_rect.size.abs();
+	if (p_transpose) {
+		SWAP(size.x, size.y);
+	}
+
+	static const Vector2 corners[4] = { Vector2(0, 0), Vector2(1, 0), Vector2(1, 1), Vector2(0, 1) };
+
+	int base = r_mesh.points.size();
+
+	for (int i = 0; i < 4; i++) {
+
+		Vector2 corner = corners[i];
+		Vector2 mirrored(flip_h ? 1.0 - corner.x : corner.x, flip_v ? 1.0 - corner.y : corner.y);
+
+		r_mesh.points.push_back(p_rect.position + size * mirrored);
+		r_mesh.uvs.push_back(p_src_rect.position + p_src_rect.size * (p_transpose ? Vector2(corner.y, corner.x) : corner));
+		r_mesh.colors.push_back(p_modulate);
+	}
+
+	static const int quad_indices[6] = { 0, 1, 2, 0, 2, 3 };
+	for (int i = 0; i < 6; i++) {
+		r_mesh.indices.push_back(base + quad_indices[i]);
+	}
+}
+
+void TileMap::_quadrant_mesh_flush(QuadrantMesh &r_mesh) {
+
+	if (r_mesh.indices.size()) {
+		RenderingServer::get_singleton()->canvas_item_add_triangle_array(r_mesh.canvas_item, r_mesh.indices, r_mesh.points, r_mesh.colors, r_mesh.uvs, Vector<int>(), Vector<float>(), r_mesh.texture, -1, r_mesh.normal_map);
+	}
+
+	r_mesh.canvas_item = RID();
+	r_mesh.texture = RID();
+	r_mesh.normal_map = RID();
+	r_mesh.points.clear();
+	r_mesh.uvs.clear();
+	r_mesh.colors.clear();
+	r_mesh.indices.clear();
+}
+
 void TileMap::update_dirty_quadrants() {
 
 	if (!pending_update)
@@ -391,6 +436,7 @@ void TileMap::update_dirty_quadrants() {
 		int prev_z_index = 0;
 		RID prev_canvas_item;
 		RID prev_debug_canvas_item;
+		QuadrantMesh mesh;
 
 		for (int i = 0; i < q.cells.size(); i++) {
 
@@ -547,10 +593,29 @@ void TileMap::update_dirty_quadrants() {
 			Color self_modulate = get_self_modulate();
 			modulate = Color(modulate.r * self_modulate.r, modulate.g * self_modulate.g,
 					modulate.b * self_modulate.b, modulate.a * self_modulate.a);
-			if (r == Rect2()) {
-				tex->draw_rect(canvas_item, rect, false, modulate, c.transpose, normal_map);
+			//plain textures are baked into one triangle array per run of cells, others know best how to draw themselves
+			bool bake = !clip_uv && (Object::cast_to<ImageTexture>(*tex) || Object::cast_to<StreamTexture>(*tex)) && tex->get_width() > 0 && tex->get_height() > 0;
+
+			if (bake) {
+				RID normal_rid = normal_map.is_valid() ? normal_map->get_rid() : RID();
+
+				if (mesh.canvas_item != canvas_item || mesh.texture != tex->get_rid() || mesh.normal_map != normal_rid) {
+					_quadrant_mesh_flush(mesh);
+					mesh.canvas_item = canvas_item;
+					mesh.texture = tex->get_rid();
+					mesh.normal_map = normal_rid;
+				}
+
+				Rect2 src_rect = r == Rect2() ? Rect2(0, 0, 1, 1) : Rect2(r.position / tex->get_size(), r.size / tex->get_size());
+				_quadrant_mesh_add_rect(mesh, rect, src_rect, modulate, c.transpose);
 			} else {
-				tex->draw_rect_region(canvas_item, rect, r, modulate, c.transpose, normal_map, Ref<Texture2D>(), Color(1, 1, 1, 1), RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT, RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT, clip_uv);
+				_quadrant_mesh_flush(mesh);
+
+				if (r == Rect2()) {
+					tex->draw_rect(canvas_item, rect, false, modulate, c.transpose, normal_map);
+				} else {
+					tex->draw_rect_region(canvas_item, rect, r, modulate, c.transpose, normal_map, Ref<Texture2D>(), Color(1, 1, 1, 1), RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT, RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT, clip_uv);
+				}
 			}
 
 			Vector<TileSet::ShapeData> shapes = tile_set->tile_get_shapes(c.id);
@@ -697,6 +762,8 @@ void TileMap::update_dirty_quadrants() {
 			}
 		}
 
+		_quadrant_mesh_flush(mesh);
+
 		dirty_quadrant_list.remove(dirty_quadrant_list.first());
 		quadrant_order_dirty = true;
 	}
@@ -176,6 +176,19 @@ private:
 				dirty_list(this) {}
 	};
 
+	//consecutive cells of a quadrant sharing a texture, drawn as a single triangle array
+	struct QuadrantMesh {
+
+		RID canvas_item;
+		RID texture;
+		RID normal_map;
+
+		Vector<Vector2> points;
+		Vector<Vector2> uvs;
+		Vector<Color> colors;
+		Vector<int> indices;
+	};
+
 	Map<PosKey, Quadrant> quadrant_map;
 
 	SelfList<Quadrant>::List dirty_quadrant_list;
@@ -203,6 +216,8 @@ private:
 	int occluder_light_mask;
 
 	void _fix_cell_transform(Transform2D &xform, const Cell &p_cell, const Vector2 &p_offset, const Size2 &p_sc);
+	void _quadrant_mesh_add_rect(QuadrantMesh &r_mesh, const Rect2 &p_rect, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose);
+	void _quadrant_mesh_flush(QuadrantMesh &r_mesh);
 
 	void _add_shape(int &shape_idx, const Quadrant &p_q, const Ref<Shape2D> &p_shape, const TileSet::ShapeData &p_shape_data, const Transform2D &p_xform, const Vector2 &p_metadata);
 
@@ -120,15 +120,15 @@ void Area3D::_body_enter_tree(ObjectID p_id) {
 	Node *node = Object::cast_to<Node>(obj);
 	ERR_FAIL_COND(!node);
 
-	Map<ObjectID, BodyState>::Element *E = body_map.find(p_id);
+	BodyState *E = body_map.getptr(p_id);
 	ERR_FAIL_COND(!E);
-	ERR_FAIL_COND(E->get().in_tree);
+	ERR_FAIL_COND(E->in_tree);
 
-	E->get().in_tree = true;
+	E->in_tree = true;
 	emit_signal(SceneStringNames::get_singleton()->body_entered, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
+	for (int i = 0; i < E->shapes.size(); i++) {
 
-		emit_signal(SceneStringNames::get_singleton()->body_shape_entered, p_id, node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+		emit_signal(SceneStringNames::get_singleton()->body_shape_entered, p_id, node, E->shapes[i].body_shape, E->shapes[i].area_shape);
 	}
 }
 
@@ -137,14 +137,14 @@ void Area3D::_body_exit_tree(ObjectID p_id) {
 	Object *obj = ObjectDB::get_instance(p_id);
 	Node *node = Object::cast_to<Node>(obj);
 	ERR_FAIL_COND(!node);
-	Map<ObjectID, BodyState>::Element *E = body_map.find(p_id);
+	BodyState *E = body_map.getptr(p_id);
 	ERR_FAIL_COND(!E);
-	ERR_FAIL_COND(!E->get().in_tree);
-	E->get().in_tree = false;
+	ERR_FAIL_COND(!E->in_tree);
+	E->in_tree = false;
 	emit_signal(SceneStringNames::get_singleton()->body_exited, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
+	for (int i = 0; i < E->shapes.size(); i++) {
 
-		emit_signal(SceneStringNames::get_singleton()->body_shape_exited, p_id, node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+		emit_signal(SceneStringNames::get_singleton()->body_shape_exited, p_id, node, E->shapes[i].body_shape, E->shapes[i].area_shape);
 	}
 }
 
@@ -156,7 +156,7 @@ void Area3D::_body_inout(int p_status, const RID &p_body, ObjectID p_instance, i
 	Object *obj = ObjectDB::get_instance(objid);
 	Node *node = Object::cast_to<Node>(obj);
 
-	Map<ObjectID, BodyState>::Element *E = body_map.find(objid);
+	BodyState *E = body_map.getptr(objid);
 
 	if (!body_in && !E) {
 		return; //likely removed from the tree
@@ -167,51 +167,51 @@ void Area3D::_body_inout(int p_status, const RID &p_body, ObjectID p_instance, i
 	if (body_in) {
 		if (!E) {
 
-			E = body_map.insert(objid, BodyState());
-			E->get().rc = 0;
-			E->get().in_tree = node && node->is_inside_tree();
+			E = &body_map.set(objid, BodyState())->value();
+			E->rc = 0;
+			E->in_tree = node && node->is_inside_tree();
 			if (node) {
 				node->connect(SceneStringNames::get_singleton()->tree_entered, callable_mp(this, &Area3D::_body_enter_tree), make_binds(objid));
 				node->connect(SceneStringNames::get_singleton()->tree_exiting, callable_mp(this, &Area3D::_body_exit_tree), make_binds(objid));
-				if (E->get().in_tree) {
+				if (E->in_tree) {
 					emit_signal(SceneStringNames::get_singleton()->body_entered, node);
 				}
 			}
 		}
-		E->get().rc++;
+		E->rc++;
 		if (node)
-			E->get().shapes.insert(ShapePair(p_body_shape, p_area_shape));
+			E->shapes.insert(ShapePair(p_body_shape, p_area_shape));
 
-		if (E->get().in_tree) {
+		if (E->in_tree) {
 			emit_signal(SceneStringNames::get_singleton()->body_shape_entered, objid, node, p_body_shape, p_area_shape);
 		}
 
 	} else {
 
-		E->get().rc--;
+		E->rc--;
 
 		if (node)
-			E->get().shapes.erase(ShapePair(p_body_shape, p_area_shape));
+			E->shapes.erase(ShapePair(p_body_shape, p_area_shape));
 
 		bool eraseit = false;
 
-		if (E->get().rc == 0) {
+		if (E->rc == 0) {
 
 			if (node) {
 				node->disconnect(SceneStringNames::get_singleton()->tree_entered, callable_mp(this, &Area3D::_body_enter_tree));
 				node->disconnect(SceneStringNames::get_singleton()->tree_exiting, callable_mp(this, &Area3D::_body_exit_tree));
-				if (E->get().in_tree)
+				if (E->in_tree)
 					emit_signal(SceneStringNames::get_singleton()->body_exited, obj);
 			}
 
 			eraseit = true;
 		}
-		if (node && E->get().in_tree) {
+		if (node && E->in_tree) {
 			emit_signal(SceneStringNames::get_singleton()->body_shape_exited, objid, obj, p_body_shape, p_area_shape);
 		}
 
 		if (eraseit)
-			body_map.erase(E);
+			body_map.erase(objid);
 	}
 
 	locked = false;
@@ -222,25 +222,27 @@ void Area3D::_clear_monitoring() {
 	ERR_FAIL_COND_MSG(locked, "This function can't be used during the in/out signal.");
 
 	{
-		Map<ObjectID, BodyState> bmcopy = body_map;
+		HashMap<ObjectID, BodyState> bmcopy = body_map;
 		body_map.clear();
 		//disconnect all monitored stuff
 
-		for (Map<ObjectID, BodyState>::Element *E = bmcopy.front(); E; E = E->next()) {
+		for (const ObjectID *K = bmcopy.next(NULL); K; K = bmcopy.next(K)) {
 
-			Object *obj = ObjectDB::get_instance(E->key());
+			const BodyState *E = bmcopy.getptr(*K);
+
+			Object *obj = ObjectDB::get_instance(*K);
 			Node *node = Object::cast_to<Node>(obj);
 
 			if (!node) //node may have been deleted in previous frame or at other legiminate point
 				continue;
 			//ERR_CONTINUE(!node);
 
-			if (!E->get().in_tree)
+			if (!E->in_tree)
 				continue;
 
-			for (int i = 0; i < E->get().shapes.size(); i++) {
+			for (int i = 0; i < E->shapes.size(); i++) {
 
-				emit_signal(SceneStringNames::get_singleton()->body_shape_exited, E->key(), node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+				emit_signal(SceneStringNames::get_singleton()->body_shape_exited, *K, node, E->shapes[i].body_shape, E->shapes[i].area_shape);
 			}
 
 			emit_signal(SceneStringNames::get_singleton()->body_exited, node);
@@ -252,25 +254,27 @@ void Area3D::_clear_monitoring() {
 
 	{
 
-		Map<ObjectID, AreaState> bmcopy = area_map;
+		HashMap<ObjectID, AreaState> bmcopy = area_map;
 		area_map.clear();
 		//disconnect all monitored stuff
 
-		for (Map<ObjectID, AreaState>::Element *E = bmcopy.front(); E; E = E->next()) {
+		for (const ObjectID *K = bmcopy.next(NULL); K; K = bmcopy.next(K)) {
+
+			const AreaState *E = bmcopy.getptr(*K);
 
-			Object *obj = ObjectDB::get_instance(E->key());
+			Object *obj = ObjectDB::get_instance(*K);
 			Node *node = Object::cast_to<Node>(obj);
 
 			if (!node) //node may have been deleted in previous frame or at other legiminate point
 				continue;
 			//ERR_CONTINUE(!node);
 
-			if (!E->get().in_tree)
+			if (!E->in_tree)
 				continue;
 
-			for (int i = 0; i < E->get().shapes.size(); i++) {
+			for (int i = 0; i < E->shapes.size(); i++) {
 
-				emit_signal(SceneStringNames::get_singleton()->area_shape_exited, E->key(), node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+				emit_signal(SceneStringNames::get_singleton()->area_shape_exited, *K, node, E->shapes[i].area_shape, E->shapes[i].self_shape);
 			}
 
 			emit_signal(SceneStringNames::get_singleton()->area_exited, obj);
@@ -313,15 +317,15 @@ void Area3D::_area_enter_tree(ObjectID p_id) {
 	Node *node = Object::cast_to<Node>(obj);
 	ERR_FAIL_COND(!node);
 
-	Map<ObjectID, AreaState>::Element *E = area_map.find(p_id);
+	AreaState *E = area_map.getptr(p_id);
 	ERR_FAIL_COND(!E);
-	ERR_FAIL_COND(E->get().in_tree);
+	ERR_FAIL_COND(E->in_tree);
 
-	E->get().in_tree = true;
+	E->in_tree = true;
 	emit_signal(SceneStringNames::get_singleton()->area_entered, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
+	for (int i = 0; i < E->shapes.size(); i++) {
 
-		emit_signal(SceneStringNames::get_singleton()->area_shape_entered, p_id, node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+		emit_signal(SceneStringNames::get_singleton()->area_shape_entered, p_id, node, E->shapes[i].area_shape, E->shapes[i].self_shape);
 	}
 }
 
@@ -330,14 +334,14 @@ void Area3D::_area_exit_tree(ObjectID p_id) {
 	Object *obj = ObjectDB::get_instance(p_id);
 	Node *node = Object::cast_to<Node>(obj);
 	ERR_FAIL_COND(!node);
-	Map<ObjectID, AreaState>::Element *E = area_map.find(p_id);
+	AreaState *E = area_map.getptr(p_id);
 	ERR_FAIL_COND(!E);
-	ERR_FAIL_COND(!E->get().in_tree);
-	E->get().in_tree = false;
+	ERR_FAIL_COND(!E->in_tree);
+	E->in_tree = false;
 	emit_signal(SceneStringNames::get_singleton()->area_exited, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
+	for (int i = 0; i < E->shapes.size(); i++) {
 
-		emit_signal(SceneStringNames::get_singleton()->area_shape_exited, p_id, node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+		emit_signal(SceneStringNames::get_singleton()->area_shape_exited, p_id, node, E->shapes[i].area_shape, E->shapes[i].self_shape);
 	}
 }
 
@@ -349,7 +353,7 @@ void Area3D::_area_inout(int p_status, const RID &p_area, ObjectID p_instance, i
 	Object *obj = ObjectDB::get_instance(objid);
 	Node *node = Object::cast_to<Node>(obj);
 
-	Map<ObjectID, AreaState>::Element *E = area_map.find(objid);
+	AreaState *E = area_map.getptr(objid);
 
 	if (!area_in && !E) {
 		return; //likely removed from the tree
@@ -360,52 +364,52 @@ void Area3D::_area_inout(int p_status, const RID &p_area, ObjectID p_instance, i
 	if (area_in) {
 		if (!E) {
 
-			E = area_map.insert(objid, AreaState());
-			E->get().rc = 0;
-			E->get().in_tree = node && node->is_inside_tree();
+			E = &area_map.set(objid, AreaState())->value();
+			E->rc = 0;
+			E->in_tree = node && node->is_inside_tree();
 			if (node) {
 				node->connect(SceneStringNames::get_singleton()->tree_entered, callable_mp(this, &Area3D::_area_enter_tree), make_binds(objid));
 				node->connect(SceneStringNames::get_singleton()->tree_exiting, callable_mp(this, &Area3D::_area_exit_tree), make_binds(objid));
-				if (E->get().in_tree) {
+				if (E->in_tree) {
 					emit_signal(SceneStringNames::get_singleton()->area_entered, node);
 				}
 			}
 		}
-		E->get().rc++;
+		E->rc++;
 		if (node)
-			E->get().shapes.insert(AreaShapePair(p_area_shape, p_self_shape));
+			E->shapes.insert(AreaShapePair(p_area_shape, p_self_shape));
 
-		if (!node || E->get().in_tree) {
+		if (!node || E->in_tree) {
 			emit_signal(SceneStringNames::get_singleton()->area_shape_entered, objid, node, p_area_shape, p_self_shape);
 		}
 
 	} else {
 
-		E->get().rc--;
+		E->rc--;
 
 		if (node)
-			E->get().shapes.erase(AreaShapePair(p_area_shape, p_self_shape));
+			E->shapes.erase(AreaShapePair(p_area_shape, p_self_shape));
 
 		bool eraseit = false;
 
-		if (E->get().rc == 0) {
+		if (E->rc == 0) {
 
 			if (node) {
 				node->disconnect(SceneStringNames::get_singleton()->tree_entered, callable_mp(this, &Area3D::_area_enter_tree));
 				node->disconnect(SceneStringNames::get_singleton()->tree_exiting, callable_mp(this, &Area3D::_area_exit_tree));
-				if (E->get().in_tree) {
+				if (E->in_tree) {
 					emit_signal(SceneStringNames::get_singleton()->area_exited, obj);
 				}
 			}
 
 			eraseit = true;
 		}
-		if (!node || E->get().in_tree) {
+		if (!node || E->in_tree) {
 			emit_signal(SceneStringNames::get_singleton()->area_shape_exited, objid, obj, p_area_shape, p_self_shape);
 		}
 
 		if (eraseit)
-			area_map.erase(E);
+			area_map.erase(objid);
 	}
 
 	locked = false;
@@ -422,8 +426,8 @@ Array Area3D::get_overlapping_bodies() const {
 	Array ret;
 	ret.resize(body_map.size());
 	int idx = 0;
-	for (const Map<ObjectID, BodyState>::Element *E = body_map.front(); E; E = E->next()) {
-		Object *obj = ObjectDB::get_instance(E->key());
+	for (const ObjectID *K = body_map.next(NULL); K; K = body_map.next(K)) {
+		Object *obj = ObjectDB::get_instance(*K);
 		if (!obj) {
 			ret.resize(ret.size() - 1); //ops
 		} else {
@@ -457,8 +461,8 @@ Array Area3D::get_overlapping_areas() const {
 	Array ret;
 	ret.resize(area_map.size());
 	int idx = 0;
-	for (const Map<ObjectID, AreaState>::Element *E = area_map.front(); E; E = E->next()) {
-		Object *obj = ObjectDB::get_instance(E->key());
+	for (const ObjectID *K = area_map.next(NULL); K; K = area_map.next(K)) {
+		Object *obj = ObjectDB::get_instance(*K);
 		if (!obj) {
 			ret.resize(ret.size() - 1); //ops
 		} else {
@@ -472,19 +476,19 @@ Array Area3D::get_overlapping_areas() const {
 bool Area3D::overlaps_area(Node *p_area) const {
 
 	ERR_FAIL_NULL_V(p_area, false);
-	const Map<ObjectID, AreaState>::Element *E = area_map.find(p_area->get_instance_id());
+	const AreaState *E = area_map.getptr(p_area->get_instance_id());
 	if (!E)
 		return false;
-	return E->get().in_tree;
+	return E->in_tree;
 }
 
 bool Area3D::overlaps_body(Node *p_body) const {
 
 	ERR_FAIL_NULL_V(p_body, false);
-	const Map<ObjectID, BodyState>::Element *E = body_map.find(p_body->get_instance_id());
+	const BodyState *E = body_map.getptr(p_body->get_instance_id());
 	if (!E)
 		return false;
-	return E->get().in_tree;
+	return E->in_tree;
 }
 void Area3D::set_collision_mask(uint32_t p_mask) {
 
@@ -31,6 +31,7 @@
 #ifndef AREA_3D_H
 #define AREA_3D_H
 
+#include "core/hash_map.h"
 #include "core/vset.h"
 #include "scene/3d/collision_object_3d.h"
 
@@ -92,7 +93,7 @@ private:
 		VSet<ShapePair> shapes;
 	};
 
-	Map<ObjectID, BodyState> body_map;
+	HashMap<ObjectID, BodyState> body_map;
 
 	void _area_inout(int p_status, const RID &p_area, ObjectID p_instance, int p_area_shape, int p_self_shape);
 
@@ -124,7 +125,7 @@ private:
 		VSet<AreaShapePair> shapes;
 	};
 
-	Map<ObjectID, AreaState> area_map;
+	HashMap<ObjectID, AreaState> area_map;
 	void _clear_monitoring();
 
 	bool audio_bus_override;
@@ -35,6 +35,7 @@
 #include "scene/3d/camera_3d.h"
 #include "scene/3d/listener_3d.h"
 #include "scene/main/window.h"
+#include "servers/audio/audio_mix.h"
 
 // Based on "A Novel Multichannel Panning Method for Standard and Arbitrary Loudspeaker Configurations" by Ramy Sadek and Chris Kyriakakis (2004)
 // Speaker-Placement Correction Amplitude Panning (SPCAP)
@@ -149,13 +150,43 @@ void AudioStreamPlayer3D::_mix_audio() {
 		stream_playback->start(setseek);
 		setseek = -1.0; //reset seek
 		started = true;
+		if (voice_virtual_time >= 0) {
+			voice_virtual_time = 0;
+		}
 	}
 
 	//get data
 	AudioFrame *buffer = mix_buffer.ptrw();
 	int buffer_size = mix_buffer.size();
+	bool fade_out = stream_paused_fade_out;
 
-	if (stream_paused_fade_out) {
+	if (voice_virtual) {
+		if (voice_virtual_time >= 0) {
+			// Not heard, only advance the time without decoding or mixing
+			if (!stream_paused && (output_count > 0 || out_of_range_mode == OUT_OF_RANGE_MIX)) {
+				voice_virtual_time += buffer_size * pitch_scale / AudioServer::get_singleton()->get_mix_rate();
+			}
+			stream_paused_fade_out = false;
+			output_ready = false;
+			return;
+		}
+		// Became virtual, fade out this step
+		voice_virtual_time = 0;
+		fade_out = true;
+	} else if (voice_virtual_time >= 0) {
+		// Audible again, continue from where it would be now
+		if (voice_virtual_time > 0) {
+			stream_playback->skip(voice_virtual_time);
+		}
+		voice_virtual_time = -1;
+		if (!stream_playback->is_playing()) {
+			active = false;
+			return;
+		}
+		stream_paused_fade_in = true;
+	}
+
+	if (fade_out) {
 		// Short fadeout ramp
 		buffer_size = MIN(buffer_size, 128);
 	}
@@ -211,7 +242,7 @@ void AudioStreamPlayer3D::_mix_audio() {
 		int buffers = AudioServer::get_singleton()->get_channel_count();
 
 		for (int k = 0; k < buffers; k++) {
-			AudioFrame target_volume = stream_paused_fade_out ? AudioFrame(0.f, 0.f) : current.vol[k];
+			AudioFrame target_volume = fade_out ? AudioFrame(0.f, 0.f) : current.vol[k];
 			AudioFrame vol_prev = stream_paused_fade_in ? AudioFrame(0.f, 0.f) : prev_outputs[i].vol[k];
 			AudioFrame vol_inc = (target_volume - vol_prev) / float(buffer_size);
 			AudioFrame vol = vol_prev;
@@ -271,21 +302,10 @@ void AudioStreamPlayer3D::_mix_audio() {
 				AudioFrame *rtarget = AudioServer::get_singleton()->thread_get_channel_mix_buffer(current.reverb_bus_index, k);
 
 				if (current.reverb_bus_index == prev_outputs[i].reverb_bus_index) {
-					AudioFrame rvol_inc = (current.reverb_vol[k] - prev_outputs[i].reverb_vol[k]) / float(buffer_size);
-					AudioFrame rvol = prev_outputs[i].reverb_vol[k];
-
-					for (int j = 0; j < buffer_size; j++) {
-
-						rtarget[j] += buffer[j] * rvol;
-						rvol += rvol_inc;
-					}
+					AudioMix::add_ramp(rtarget, buffer, buffer_size, prev_outputs[i].reverb_vol[k], current.reverb_vol[k]);
 				} else {
 
-					AudioFrame rvol = current.reverb_vol[k];
-					for (int j = 0; j < buffer_size; j++) {
-
-						rtarget[j] += buffer[j] * rvol;
-					}
+					AudioMix::add_scaled(rtarget, buffer, buffer_size, current.reverb_vol[k]);
 				}
 			}
 		}
@@ -295,6 +315,11 @@ void AudioStreamPlayer3D::_mix_audio() {
 
 	prev_output_count = output_count;
 
+	if (voice_virtual_time >= 0 && !stream_paused) {
+		// Rest of the step after the fadeout
+		voice_virtual_time += (mix_buffer.size() - buffer_size) * pitch_scale / AudioServer::get_singleton()->get_mix_rate();
+	}
+
 	//stream is no longer active, disable this.
 	if (!stream_playback->is_playing()) {
 		active = false;
@@ -352,6 +377,7 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 	if (p_what == NOTIFICATION_EXIT_TREE) {
 
 		AudioServer::get_singleton()->remove_callback(_mix_audios, this);
+		AudioServer::get_singleton()->voice_remove(get_instance_id());
 	}
 
 	if (p_what == NOTIFICATION_PAUSED) {
@@ -633,6 +659,8 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 			///_change_notify("playing"); //update property in editor
 		}
 
+		_update_voice();
+
 		//stop playing if no longer active
 		if (!active) {
 			set_physics_process_internal(false);
@@ -643,6 +671,32 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 	}
 }
 
+void AudioStreamPlayer3D::_update_voice() {
+
+	if (!active) {
+		AudioServer::get_singleton()->voice_remove(get_instance_id());
+		voice_virtual = false;
+		return;
+	}
+
+	float volume = 0;
+	int buffers = AudioServer::get_singleton()->get_channel_count();
+	for (int i = 0; i < output_count; i++) {
+		for (int k = 0; k < buffers; k++) {
+			volume = MAX(volume, MAX(outputs[i].vol[k].l, outputs[i].vol[k].r));
+			if (outputs[i].reverb_bus_index >= 0) {
+				volume = MAX(volume, MAX(outputs[i].reverb_vol[k].l, outputs[i].reverb_vol[k].r));
+			}
+		}
+	}
+
+	int bus_index = output_count ? outputs[0].bus_index : AudioServer::get_singleton()->thread_find_bus_index(bus);
+
+	// Decided on the last server update, so it applies a frame later
+	AudioServer::get_singleton()->voice_update(get_instance_id(), bus_index, priority, volume);
+	voice_virtual = AudioServer::get_singleton()->voice_is_virtual(get_instance_id());
+}
+
 void AudioStreamPlayer3D::set_stream(Ref<AudioStream> p_stream) {
 
 	AudioServer::get_singleton()->lock();
@@ -714,6 +768,7 @@ void AudioStreamPlayer3D::play(float p_from_pos) {
 		active = true;
 		setplay = p_from_pos;
 		output_ready = false;
+		voice_virtual = false;
 		set_physics_process_internal(true);
 	}
 }
@@ -731,6 +786,7 @@ void AudioStreamPlayer3D::stop() {
 		active = false;
 		set_physics_process_internal(false);
 		setplay = -1;
+		AudioServer::get_singleton()->voice_remove(get_instance_id());
 	}
 }
 
@@ -746,7 +802,11 @@ bool AudioStreamPlayer3D::is_playing() const {
 float AudioStreamPlayer3D::get_playback_position() {
 
 	if (stream_playback.is_valid()) {
-		return stream_playback->get_playback_position();
+		float position = stream_playback->get_playback_position();
+		if (voice_virtual_time > 0) {
+			position += voice_virtual_time;
+		}
+		return position;
 	}
 
 	return 0;
@@ -832,6 +892,16 @@ uint32_t AudioStreamPlayer3D::get_area_mask() const {
 	return area_mask;
 }
 
+void AudioStreamPlayer3D::set_priority(int p_priority) {
+
+	priority = p_priority;
+}
+
+int AudioStreamPlayer3D::get_priority() const {
+
+	return priority;
+}
+
 void AudioStreamPlayer3D::set_emission_angle_enabled(bool p_enable) {
 	emission_angle_enabled = p_enable;
 	update_gizmo();
@@ -980,6 +1050,9 @@ void AudioStreamPlayer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_area_mask", "mask"), &AudioStreamPlayer3D::set_area_mask);
 	ClassDB::bind_method(D_METHOD("get_area_mask"), &AudioStreamPlayer3D::get_area_mask);
 
+	ClassDB::bind_method(D_METHOD("set_priority", "priority"), &AudioStreamPlayer3D::set_priority);
+	ClassDB::bind_method(D_METHOD("get_priority"), &AudioStreamPlayer3D::get_priority);
+
 	ClassDB::bind_method(D_METHOD("set_emission_angle", "degrees"), &AudioStreamPlayer3D::set_emission_angle);
 	ClassDB::bind_method(D_METHOD("get_emission_angle"), &AudioStreamPlayer3D::get_emission_angle);
 
@@ -1022,6 +1095,7 @@ void AudioStreamPlayer3D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "out_of_range_mode", PROPERTY_HINT_ENUM, "Mix,Pause"), "set_out_of_range_mode", "get_out_of_range_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "bus", PROPERTY_HINT_ENUM, ""), "set_bus", "get_bus");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "area_mask", PROPERTY_HINT_LAYERS_2D_PHYSICS), "set_area_mask", "get_area_mask");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "priority"), "set_priority", "get_priority");
 	ADD_GROUP("Emission Angle", "emission_angle");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "emission_angle_enabled"), "set_emission_angle_enabled", "is_emission_angle_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "emission_angle_degrees", PROPERTY_HINT_RANGE, "0.1,90,0.1"), "set_emission_angle", "get_emission_angle");
@@ -1073,6 +1147,9 @@ AudioStreamPlayer3D::AudioStreamPlayer3D() {
 	stream_paused = false;
 	stream_paused_fade_in = false;
 	stream_paused_fade_out = false;
+	priority = 0;
+	voice_virtual = false;
+	voice_virtual_time = -1;
 
 	velocity_tracker.instance();
 	AudioServer::get_singleton()->connect("bus_layout_changed", callable_mp(this, &AudioStreamPlayer3D::_bus_layout_changed));
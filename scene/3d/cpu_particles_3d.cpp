@@ -30,6 +30,7 @@
 
 #include "cpu_particles_3d.h"
 
+#include "core/thread_work_pool.h"
 #include "scene/3d/camera_3d.h"
 #include "scene/3d/gpu_particles_3d.h"
 #include "scene/resources/particles_material.h"
@@ -621,9 +622,13 @@ void CPUParticles3D::_particles_process(float p_delta) {
 
 	float system_phase = time / lifetime;
 
+	process_steps.resize(pcount);
+	process_deltas.resize(pcount);
+
 	for (int i = 0; i < pcount; i++) {
 
 		Particle &p = parray[i];
+		process_steps[i] = STEP_SKIP;
 
 		if (!emitting && !p.active)
 			continue;
@@ -649,6 +654,7 @@ void CPUParticles3D::_particles_process(float p_delta) {
 		restart_phase *= (1.0 - explosiveness_ratio);
 		float restart_time = restart_phase * lifetime;
 		bool restart = false;
+		ParticleStep step = STEP_SHADE;
 
 		if (time > prev_time) {
 			// restart_time >= prev_time is used so particles emit in the first frame they are processed
@@ -804,216 +810,252 @@ void CPUParticles3D::_particles_process(float p_delta) {
 		} else if (p.time > p.lifetime) {
 			p.active = false;
 		} else {
+			step = STEP_INTEGRATE;
+		}
 
-			uint32_t alt_seed = p.seed;
+		process_steps[i] = step;
+		process_deltas[i] = local_delta;
+	}
 
-			p.time += local_delta;
-			p.custom[1] = p.time / lifetime;
+	if (color_ramp.is_valid()) {
+		color_ramp->get_color_at_offset(0.0); //sorts the points, so the steps below only read them
+	}
 
-			float tex_linear_velocity = 0.0;
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->interpolate(p.custom[1]);
-			}
+	ProcessFrame frame;
+	frame.particles = parray;
+	frame.emission_xform = emission_xform;
 
-			float tex_orbit_velocity = 0.0;
-			if (flags[FLAG_DISABLE_Z]) {
-				if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
-					tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->interpolate(p.custom[1]);
-				}
-			}
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
 
-			float tex_angular_velocity = 0.0;
-			if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
-				tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->interpolate(p.custom[1]);
-			}
+	if (pcount >= PARALLEL_MIN_PARTICLES && pool && pool->get_thread_count() > 0) {
+		pool->do_work(pcount, this, &CPUParticles3D::_particle_step, &frame);
+	} else {
+		for (int i = 0; i < pcount; i++) {
+			_particle_step(i, &frame);
+		}
+	}
+}
 
-			float tex_linear_accel = 0.0;
-			if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
-				tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->interpolate(p.custom[1]);
-			}
+void CPUParticles3D::_particle_step(uint32_t p_index, ProcessFrame *p_frame) {
 
-			float tex_tangential_accel = 0.0;
-			if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
-				tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->interpolate(p.custom[1]);
-			}
+	ParticleStep step = ParticleStep(process_steps[p_index]);
+	if (step == STEP_SKIP) {
+		return;
+	}
 
-			float tex_radial_accel = 0.0;
-			if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
-				tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->interpolate(p.custom[1]);
-			}
+	Particle &p = p_frame->particles[p_index];
+	float local_delta = process_deltas[p_index];
+	const Transform &emission_xform = p_frame->emission_xform;
 
-			float tex_damping = 0.0;
-			if (curve_parameters[PARAM_DAMPING].is_valid()) {
-				tex_damping = curve_parameters[PARAM_DAMPING]->interpolate(p.custom[1]);
-			}
+	if (step == STEP_INTEGRATE) {
+		uint32_t alt_seed = p.seed;
 
-			float tex_angle = 0.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->interpolate(p.custom[1]);
-			}
-			float tex_anim_speed = 0.0;
-			if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
-				tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->interpolate(p.custom[1]);
-			}
+		p.time += local_delta;
+		p.custom[1] = p.time / lifetime;
 
-			float tex_anim_offset = 0.0;
-			if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->interpolate(p.custom[1]);
-			}
+		float tex_linear_velocity = 0.0;
+		if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+			tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->interpolate(p.custom[1]);
+		}
 
-			Vector3 force = gravity;
-			Vector3 position = p.transform.origin;
-			if (flags[FLAG_DISABLE_Z]) {
-				position.z = 0.0;
+		float tex_orbit_velocity = 0.0;
+		if (flags[FLAG_DISABLE_Z]) {
+			if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
+				tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->interpolate(p.custom[1]);
 			}
-			//apply linear acceleration
-			force += p.velocity.length() > 0.0 ? p.velocity.normalized() * (parameters[PARAM_LINEAR_ACCEL] + tex_linear_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_LINEAR_ACCEL]) : Vector3();
-			//apply radial acceleration
-			Vector3 org = emission_xform.origin;
-			Vector3 diff = position - org;
-			force += diff.length() > 0.0 ? diff.normalized() * (parameters[PARAM_RADIAL_ACCEL] + tex_radial_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_RADIAL_ACCEL]) : Vector3();
-			//apply tangential acceleration;
-			if (flags[FLAG_DISABLE_Z]) {
+		}
 
-				Vector2 yx = Vector2(diff.y, diff.x);
-				Vector2 yx2 = (yx * Vector2(-1.0, 1.0)).normalized();
-				force += yx.length() > 0.0 ? Vector3(yx2.x, yx2.y, 0.0) * ((parameters[PARAM_TANGENTIAL_ACCEL] + tex_tangential_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_TANGENTIAL_ACCEL])) : Vector3();
+		float tex_angular_velocity = 0.0;
+		if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
+			tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->interpolate(p.custom[1]);
+		}
 
-			} else {
-				Vector3 crossDiff = diff.normalized().cross(gravity.normalized());
-				force += crossDiff.length() > 0.0 ? crossDiff.normalized() * ((parameters[PARAM_TANGENTIAL_ACCEL] + tex_tangential_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_TANGENTIAL_ACCEL])) : Vector3();
-			}
-			//apply attractor forces
-			p.velocity += force * local_delta;
-			//orbit velocity
-			if (flags[FLAG_DISABLE_Z]) {
-				float orbit_amount = (parameters[PARAM_ORBIT_VELOCITY] + tex_orbit_velocity) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_ORBIT_VELOCITY]);
-				if (orbit_amount != 0.0) {
-					float ang = orbit_amount * local_delta * Math_PI * 2.0;
-					// Not sure why the ParticlesMaterial code uses a clockwise rotation matrix,
-					// but we use -ang here to reproduce its behavior.
-					Transform2D rot = Transform2D(-ang, Vector2());
-					Vector2 rotv = rot.basis_xform(Vector2(diff.x, diff.y));
-					p.transform.origin -= Vector3(diff.x, diff.y, 0);
-					p.transform.origin += Vector3(rotv.x, rotv.y, 0);
-				}
-			}
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				p.velocity = p.velocity.normalized() * tex_linear_velocity;
-			}
-			if (parameters[PARAM_DAMPING] + tex_damping > 0.0) {
+		float tex_linear_accel = 0.0;
+		if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
+			tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->interpolate(p.custom[1]);
+		}
 
-				float v = p.velocity.length();
-				float damp = (parameters[PARAM_DAMPING] + tex_damping) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_DAMPING]);
-				v -= damp * local_delta;
-				if (v < 0.0) {
-					p.velocity = Vector3();
-				} else {
-					p.velocity = p.velocity.normalized() * v;
-				}
-			}
-			float base_angle = (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, p.angle_rand, randomness[PARAM_ANGLE]);
-			base_angle += p.custom[1] * lifetime * (parameters[PARAM_ANGULAR_VELOCITY] + tex_angular_velocity) * Math::lerp(1.0f, rand_from_seed(alt_seed) * 2.0f - 1.0f, randomness[PARAM_ANGULAR_VELOCITY]);
-			p.custom[0] = Math::deg2rad(base_angle); //angle
-			p.custom[2] = (parameters[PARAM_ANIM_OFFSET] + tex_anim_offset) * Math::lerp(1.0f, p.anim_offset_rand, randomness[PARAM_ANIM_OFFSET]) + p.custom[1] * (parameters[PARAM_ANIM_SPEED] + tex_anim_speed) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_ANIM_SPEED]); //angle
+		float tex_tangential_accel = 0.0;
+		if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
+			tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->interpolate(p.custom[1]);
 		}
-		//apply color
-		//apply hue rotation
 
-		float tex_scale = 1.0;
-		if (curve_parameters[PARAM_SCALE].is_valid()) {
-			tex_scale = curve_parameters[PARAM_SCALE]->interpolate(p.custom[1]);
+		float tex_radial_accel = 0.0;
+		if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
+			tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->interpolate(p.custom[1]);
 		}
 
-		float tex_hue_variation = 0.0;
-		if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
-			tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->interpolate(p.custom[1]);
+		float tex_damping = 0.0;
+		if (curve_parameters[PARAM_DAMPING].is_valid()) {
+			tex_damping = curve_parameters[PARAM_DAMPING]->interpolate(p.custom[1]);
 		}
 
-		float hue_rot_angle = (parameters[PARAM_HUE_VARIATION] + tex_hue_variation) * Math_PI * 2.0 * Math::lerp(1.0f, p.hue_rot_rand * 2.0f - 1.0f, randomness[PARAM_HUE_VARIATION]);
-		float hue_rot_c = Math::cos(hue_rot_angle);
-		float hue_rot_s = Math::sin(hue_rot_angle);
+		float tex_angle = 0.0;
+		if (curve_parameters[PARAM_ANGLE].is_valid()) {
+			tex_angle = curve_parameters[PARAM_ANGLE]->interpolate(p.custom[1]);
+		}
+		float tex_anim_speed = 0.0;
+		if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
+			tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->interpolate(p.custom[1]);
+		}
 
-		Basis hue_rot_mat;
-		{
-			Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
-			Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
-			Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
+		float tex_anim_offset = 0.0;
+		if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
+			tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->interpolate(p.custom[1]);
+		}
 
-			for (int j = 0; j < 3; j++) {
-				hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
-			}
+		Vector3 force = gravity;
+		Vector3 position = p.transform.origin;
+		if (flags[FLAG_DISABLE_Z]) {
+			position.z = 0.0;
 		}
+		//apply linear acceleration
+		force += p.velocity.length() > 0.0 ? p.velocity.normalized() * (parameters[PARAM_LINEAR_ACCEL] + tex_linear_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_LINEAR_ACCEL]) : Vector3();
+		//apply radial acceleration
+		Vector3 org = emission_xform.origin;
+		Vector3 diff = position - org;
+		force += diff.length() > 0.0 ? diff.normalized() * (parameters[PARAM_RADIAL_ACCEL] + tex_radial_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_RADIAL_ACCEL]) : Vector3();
+		//apply tangential acceleration;
+		if (flags[FLAG_DISABLE_Z]) {
+
+			Vector2 yx = Vector2(diff.y, diff.x);
+			Vector2 yx2 = (yx * Vector2(-1.0, 1.0)).normalized();
+			force += yx.length() > 0.0 ? Vector3(yx2.x, yx2.y, 0.0) * ((parameters[PARAM_TANGENTIAL_ACCEL] + tex_tangential_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_TANGENTIAL_ACCEL])) : Vector3();
 
-		if (color_ramp.is_valid()) {
-			p.color = color_ramp->get_color_at_offset(p.custom[1]) * color;
 		} else {
-			p.color = color;
+			Vector3 crossDiff = diff.normalized().cross(gravity.normalized());
+			force += crossDiff.length() > 0.0 ? crossDiff.normalized() * ((parameters[PARAM_TANGENTIAL_ACCEL] + tex_tangential_accel) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_TANGENTIAL_ACCEL])) : Vector3();
+		}
+		//apply attractor forces
+		p.velocity += force * local_delta;
+		//orbit velocity
+		if (flags[FLAG_DISABLE_Z]) {
+			float orbit_amount = (parameters[PARAM_ORBIT_VELOCITY] + tex_orbit_velocity) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_ORBIT_VELOCITY]);
+			if (orbit_amount != 0.0) {
+				float ang = orbit_amount * local_delta * Math_PI * 2.0;
+				// Not sure why the ParticlesMaterial code uses a clockwise rotation matrix,
+				// but we use -ang here to reproduce its behavior.
+				Transform2D rot = Transform2D(-ang, Vector2());
+				Vector2 rotv = rot.basis_xform(Vector2(diff.x, diff.y));
+				p.transform.origin -= Vector3(diff.x, diff.y, 0);
+				p.transform.origin += Vector3(rotv.x, rotv.y, 0);
+			}
+		}
+		if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+			p.velocity = p.velocity.normalized() * tex_linear_velocity;
 		}
+		if (parameters[PARAM_DAMPING] + tex_damping > 0.0) {
 
-		Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
-		p.color.r = color_rgb.x;
-		p.color.g = color_rgb.y;
-		p.color.b = color_rgb.z;
+			float v = p.velocity.length();
+			float damp = (parameters[PARAM_DAMPING] + tex_damping) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_DAMPING]);
+			v -= damp * local_delta;
+			if (v < 0.0) {
+				p.velocity = Vector3();
+			} else {
+				p.velocity = p.velocity.normalized() * v;
+			}
+		}
+		float base_angle = (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, p.angle_rand, randomness[PARAM_ANGLE]);
+		base_angle += p.custom[1] * lifetime * (parameters[PARAM_ANGULAR_VELOCITY] + tex_angular_velocity) * Math::lerp(1.0f, rand_from_seed(alt_seed) * 2.0f - 1.0f, randomness[PARAM_ANGULAR_VELOCITY]);
+		p.custom[0] = Math::deg2rad(base_angle); //angle
+		p.custom[2] = (parameters[PARAM_ANIM_OFFSET] + tex_anim_offset) * Math::lerp(1.0f, p.anim_offset_rand, randomness[PARAM_ANIM_OFFSET]) + p.custom[1] * (parameters[PARAM_ANIM_SPEED] + tex_anim_speed) * Math::lerp(1.0f, rand_from_seed(alt_seed), randomness[PARAM_ANIM_SPEED]); //angle
+	}
+	//apply color
+	//apply hue rotation
 
-		p.color *= p.base_color;
+	float tex_scale = 1.0;
+	if (curve_parameters[PARAM_SCALE].is_valid()) {
+		tex_scale = curve_parameters[PARAM_SCALE]->interpolate(p.custom[1]);
+	}
 
-		if (flags[FLAG_DISABLE_Z]) {
+	float tex_hue_variation = 0.0;
+	if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
+		tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->interpolate(p.custom[1]);
+	}
 
-			if (flags[FLAG_ALIGN_Y_TO_VELOCITY]) {
-				if (p.velocity.length() > 0.0) {
-					p.transform.basis.set_axis(1, p.velocity.normalized());
-				} else {
-					p.transform.basis.set_axis(1, p.transform.basis.get_axis(1));
-				}
-				p.transform.basis.set_axis(0, p.transform.basis.get_axis(1).cross(p.transform.basis.get_axis(2)).normalized());
-				p.transform.basis.set_axis(2, Vector3(0, 0, 1));
+	float hue_rot_angle = (parameters[PARAM_HUE_VARIATION] + tex_hue_variation) * Math_PI * 2.0 * Math::lerp(1.0f, p.hue_rot_rand * 2.0f - 1.0f, randomness[PARAM_HUE_VARIATION]);
+	float hue_rot_c = Math::cos(hue_rot_angle);
+	float hue_rot_s = Math::sin(hue_rot_angle);
+
+	Basis hue_rot_mat;
+	{
+		Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
+		Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
+		Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
+
+		for (int j = 0; j < 3; j++) {
+			hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
+		}
+	}
+
+	if (color_ramp.is_valid()) {
+		p.color = color_ramp->get_color_at_offset(p.custom[1]) * color;
+	} else {
+		p.color = color;
+	}
+
+	Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
+	p.color.r = color_rgb.x;
+	p.color.g = color_rgb.y;
+	p.color.b = color_rgb.z;
+
+	p.color *= p.base_color;
+
+	if (flags[FLAG_DISABLE_Z]) {
 
+		if (flags[FLAG_ALIGN_Y_TO_VELOCITY]) {
+			if (p.velocity.length() > 0.0) {
+				p.transform.basis.set_axis(1, p.velocity.normalized());
 			} else {
-				p.transform.basis.set_axis(0, Vector3(Math::cos(p.custom[0]), -Math::sin(p.custom[0]), 0.0));
-				p.transform.basis.set_axis(1, Vector3(Math::sin(p.custom[0]), Math::cos(p.custom[0]), 0.0));
-				p.transform.basis.set_axis(2, Vector3(0, 0, 1));
+				p.transform.basis.set_axis(1, p.transform.basis.get_axis(1));
 			}
+			p.transform.basis.set_axis(0, p.transform.basis.get_axis(1).cross(p.transform.basis.get_axis(2)).normalized());
+			p.transform.basis.set_axis(2, Vector3(0, 0, 1));
 
 		} else {
-			//orient particle Y towards velocity
-			if (flags[FLAG_ALIGN_Y_TO_VELOCITY]) {
-				if (p.velocity.length() > 0.0) {
-					p.transform.basis.set_axis(1, p.velocity.normalized());
-				} else {
-					p.transform.basis.set_axis(1, p.transform.basis.get_axis(1).normalized());
-				}
-				if (p.transform.basis.get_axis(1) == p.transform.basis.get_axis(0)) {
-					p.transform.basis.set_axis(0, p.transform.basis.get_axis(1).cross(p.transform.basis.get_axis(2)).normalized());
-					p.transform.basis.set_axis(2, p.transform.basis.get_axis(0).cross(p.transform.basis.get_axis(1)).normalized());
-				} else {
-					p.transform.basis.set_axis(2, p.transform.basis.get_axis(0).cross(p.transform.basis.get_axis(1)).normalized());
-					p.transform.basis.set_axis(0, p.transform.basis.get_axis(1).cross(p.transform.basis.get_axis(2)).normalized());
-				}
+			p.transform.basis.set_axis(0, Vector3(Math::cos(p.custom[0]), -Math::sin(p.custom[0]), 0.0));
+			p.transform.basis.set_axis(1, Vector3(Math::sin(p.custom[0]), Math::cos(p.custom[0]), 0.0));
+			p.transform.basis.set_axis(2, Vector3(0, 0, 1));
+		}
+
+	} else {
+		//orient particle Y towards velocity
+		if (flags[FLAG_ALIGN_Y_TO_VELOCITY]) {
+			if (p.velocity.length() > 0.0) {
+				p.transform.basis.set_axis(1, p.velocity.normalized());
 			} else {
-				p.transform.basis.orthonormalize();
+				p.transform.basis.set_axis(1, p.transform.basis.get_axis(1).normalized());
 			}
-
-			//turn particle by rotation in Y
-			if (flags[FLAG_ROTATE_Y]) {
-				Basis rot_y(Vector3(0, 1, 0), p.custom[0]);
-				p.transform.basis = p.transform.basis * rot_y;
+			if (p.transform.basis.get_axis(1) == p.transform.basis.get_axis(0)) {
+				p.transform.basis.set_axis(0, p.transform.basis.get_axis(1).cross(p.transform.basis.get_axis(2)).normalized());
+				p.transform.basis.set_axis(2, p.transform.basis.get_axis(0).cross(p.transform.basis.get_axis(1)).normalized());
+			} else {
+				p.transform.basis.set_axis(2, p.transform.basis.get_axis(0).cross(p.transform.basis.get_axis(1)).normalized());
+				p.transform.basis.set_axis(0, p.transform.basis.get_axis(1).cross(p.transform.basis.get_axis(2)).normalized());
 			}
+		} else {
+			p.transform.basis.orthonormalize();
 		}
 
-		//scale by scale
-		float base_scale = tex_scale * Math::lerp(parameters[PARAM_SCALE], 1.0f, p.scale_rand * randomness[PARAM_SCALE]);
-		if (base_scale < 0.000001) base_scale = 0.000001;
+		//turn particle by rotation in Y
+		if (flags[FLAG_ROTATE_Y]) {
+			Basis rot_y(Vector3(0, 1, 0), p.custom[0]);
+			p.transform.basis = p.transform.basis * rot_y;
+		}
+	}
 
-		p.transform.basis.scale(Vector3(1, 1, 1) * base_scale);
+	//scale by scale
+	float base_scale = tex_scale * Math::lerp(parameters[PARAM_SCALE], 1.0f, p.scale_rand * randomness[PARAM_SCALE]);
+	if (base_scale < 0.000001) base_scale = 0.000001;
 
-		if (flags[FLAG_DISABLE_Z]) {
-			p.velocity.z = 0.0;
-			p.transform.origin.z = 0.0;
-		}
+	p.transform.basis.scale(Vector3(1, 1, 1) * base_scale);
 
-		p.transform.origin += p.velocity * local_delta;
+	if (flags[FLAG_DISABLE_Z]) {
+		p.velocity.z = 0.0;
+		p.transform.origin.z = 0.0;
 	}
+
+	p.transform.origin += p.velocity * local_delta;
 }
 
 void CPUParticles3D::_update_particle_data_buffer() {
@@ -1026,7 +1068,6 @@ void CPUParticles3D::_update_particle_data_buffer() {
 
 	float *w = particle_data.ptrw();
 	const Particle *r = particles.ptr();
-	float *ptr = w;
 
 	if (draw_order != DRAW_ORDER_INDEX) {
 		ow = particle_order.ptrw();
@@ -1061,49 +1102,65 @@ void CPUParticles3D::_update_particle_data_buffer() {
 		}
 	}
 
-	for (int i = 0; i < pc; i++) {
-
-		int idx = order ? order[i] : i;
+	InstanceWrite write;
+	write.particles = r;
+	write.order = order;
+	write.data = w;
 
-		Transform t = r[idx].transform;
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
 
-		if (!local_coords) {
-			t = inv_emission_transform * t;
+	if (pc >= PARALLEL_MIN_PARTICLES && pool && pool->get_thread_count() > 0) {
+		pool->do_work(pc, this, &CPUParticles3D::_write_particle_instance, &write);
+	} else {
+		for (int i = 0; i < pc; i++) {
+			_write_particle_instance(i, &write);
 		}
+	}
 
-		if (r[idx].active) {
-			ptr[0] = t.basis.elements[0][0];
-			ptr[1] = t.basis.elements[0][1];
-			ptr[2] = t.basis.elements[0][2];
-			ptr[3] = t.origin.x;
-			ptr[4] = t.basis.elements[1][0];
-			ptr[5] = t.basis.elements[1][1];
-			ptr[6] = t.basis.elements[1][2];
-			ptr[7] = t.origin.y;
-			ptr[8] = t.basis.elements[2][0];
-			ptr[9] = t.basis.elements[2][1];
-			ptr[10] = t.basis.elements[2][2];
-			ptr[11] = t.origin.z;
-		} else {
-			zeromem(ptr, sizeof(float) * 12);
-		}
+	can_update = true;
+}
+
+void CPUParticles3D::_write_particle_instance(uint32_t p_index, InstanceWrite *p_write) {
 
-		Color c = r[idx].color;
+	const Particle *r = p_write->particles;
+	int idx = p_write->order ? p_write->order[p_index] : p_index;
+	float *ptr = p_write->data + p_index * 20;
 
-		ptr[12] = c.r;
-		ptr[13] = c.g;
-		ptr[14] = c.b;
-		ptr[15] = c.a;
 
-		ptr[16] = r[idx].custom[0];
-		ptr[17] = r[idx].custom[1];
-		ptr[18] = r[idx].custom[2];
-		ptr[19] = r[idx].custom[3];
+	Transform t = r[idx].transform;
 
-		ptr += 20;
+	if (!local_coords) {
+		t = inv_emission_transform * t;
 	}
 
-	can_update = true;
+	if (r[idx].active) {
+		ptr[0] = t.basis.elements[0][0];
+		ptr[1] = t.basis.elements[0][1];
+		ptr[2] = t.basis.elements[0][2];
+		ptr[3] = t.origin.x;
+		ptr[4] = t.basis.elements[1][0];
+		ptr[5] = t.basis.elements[1][1];
+		ptr[6] = t.basis.elements[1][2];
+		ptr[7] = t.origin.y;
+		ptr[8] = t.basis.elements[2][0];
+		ptr[9] = t.basis.elements[2][1];
+		ptr[10] = t.basis.elements[2][2];
+		ptr[11] = t.origin.z;
+	} else {
+		zeromem(ptr, sizeof(float) * 12);
+	}
+
+	Color c = r[idx].color;
+
+	ptr[12] = c.r;
+	ptr[13] = c.g;
+	ptr[14] = c.b;
+	ptr[15] = c.a;
+
+	ptr[16] = r[idx].custom[0];
+	ptr[17] = r[idx].custom[1];
+	ptr[18] = r[idx].custom[2];
+	ptr[19] = r[idx].custom[3];
 }
 
 void CPUParticles3D::_set_redraw(bool p_redraw) {
@@ -31,6 +31,7 @@
 #ifndef CPU_PARTICLES_H
 #define CPU_PARTICLES_H
 
+#include "core/local_vector.h"
 #include "core/rid.h"
 #include "scene/3d/visual_instance_3d.h"
 
@@ -175,7 +176,34 @@ private:
 	Vector3 gravity;
 
 	void _update_internal();
+	enum ParticleStep {
+		STEP_SKIP,
+		STEP_SHADE, //restarted or just expired, only color and transform are updated
+		STEP_INTEGRATE,
+	};
+
+	enum {
+		PARALLEL_MIN_PARTICLES = 256 //below this, spreading the steps over the thread pool costs more than it saves
+	};
+
+	struct ProcessFrame {
+		Particle *particles;
+		Transform emission_xform;
+	};
+
+	struct InstanceWrite {
+		const Particle *particles;
+		const int *order;
+		float *data;
+	};
+
+	//restarts draw from the global random generator, so they are decided serially and the rest of the step runs in parallel
+	LocalVector<uint8_t> process_steps;
+	LocalVector<float> process_deltas;
+
 	void _particles_process(float p_delta);
+	void _particle_step(uint32_t p_index, ProcessFrame *p_frame);
+	void _write_particle_instance(uint32_t p_index, InstanceWrite *p_write);
 	void _update_particle_data_buffer();
 
 	Mutex update_mutex;
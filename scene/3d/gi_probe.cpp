@@ -439,6 +439,10 @@ void GIProbe::bake(Node *p_from_node, bool p_create_visual_debug) {
 
 	baker.begin_bake(subdiv_value[subdiv], AABB(-extents, extents * 2.0));
 
+	//a full bake covers any pending region
+	pending_regions.clear();
+	update_cache = UpdateCache();
+
 	List<PlotMesh> mesh_list;
 
 	_find_meshes(p_from_node ? p_from_node : get_parent(), mesh_list);
@@ -509,6 +513,124 @@ void GIProbe::bake(Node *p_from_node, bool p_create_visual_debug) {
 	_change_notify(); //bake property may have changed
 }
 
+void GIProbe::update_region(const AABB &p_region) {
+
+	ERR_FAIL_COND_MSG(probe_data.is_null(), "GIProbe must be baked before regions of it can be updated.");
+
+	AABB region = p_region.intersection(get_aabb());
+	if (region.has_no_area()) {
+		return;
+	}
+
+	//merge with the pending regions it touches, so no cell is plotted twice
+	for (int i = 0; i < pending_regions.size(); i++) {
+		if (pending_regions[i].intersects(region)) {
+			region.merge_with(pending_regions[i]);
+			pending_regions.remove(i);
+			i = -1; //the merged region may touch others now
+		}
+	}
+
+	pending_regions.push_back(region);
+	set_process_internal(true);
+}
+
+bool GIProbe::is_region_update_pending() const {
+
+	return pending_regions.size() > 0;
+}
+
+void GIProbe::set_region_update_budget(float p_msec) {
+
+	region_update_budget = p_msec;
+}
+
+float GIProbe::get_region_update_budget() const {
+
+	return region_update_budget;
+}
+
+void GIProbe::_process_pending_regions() {
+
+	static const int subdiv_value[SUBDIV_MAX] = { 6, 7, 8, 9 };
+
+	if (pending_regions.empty() || probe_data.is_null()) {
+		pending_regions.clear();
+		set_process_internal(false);
+		return;
+	}
+
+	AABB bounds = get_aabb();
+	Vector3i octree_size = get_estimated_cell_size();
+
+	if (update_cache.data != probe_data) {
+		update_cache.data = probe_data;
+		update_cache.octree_cells = probe_data->get_octree_cells();
+		update_cache.data_cells = probe_data->get_data_cells();
+		update_cache.distance_field = probe_data->get_distance_field();
+	}
+
+	if (update_cache.octree_cells.empty() || probe_data->get_bounds() != bounds || probe_data->get_octree_size() != Vector3(octree_size.x, octree_size.y, octree_size.z)) {
+		WARN_PRINT("GIProbe data does not match its extents or subdivision, baking it again instead of updating regions.");
+		bake();
+		return;
+	}
+
+	List<PlotMesh> mesh_list;
+	_find_meshes(get_parent(), mesh_list);
+
+	uint64_t from_usec = OS::get_singleton()->get_ticks_usec();
+	uint64_t budget_usec = uint64_t(MAX(region_update_budget, 0.0) * 1000.0);
+
+	Transform to_cell_xform;
+	Vector<int> level_counts;
+
+	//a region can't be split, so at least one is updated every frame
+	while (pending_regions.size()) {
+
+		AABB region = pending_regions[0];
+		pending_regions.remove(0);
+
+		Voxelizer baker;
+		baker.begin_bake_update(subdiv_value[subdiv], bounds, region, update_cache.octree_cells, update_cache.data_cells);
+
+		for (List<PlotMesh>::Element *E = mesh_list.front(); E; E = E->next()) {
+
+			if (!region.intersects(E->get().local_xform.xform(E->get().mesh->get_aabb()))) {
+				continue;
+			}
+
+			baker.plot_mesh(E->get().local_xform, E->get().mesh, E->get().instance_materials, E->get().override_material);
+		}
+
+		baker.end_bake();
+
+		update_cache.octree_cells = baker.get_giprobe_octree_cells();
+		update_cache.data_cells = baker.get_giprobe_data_cells();
+		baker.update_sdf_3d_image(update_cache.distance_field);
+		to_cell_xform = baker.get_to_cell_space_xform();
+		level_counts = baker.get_giprobe_level_cell_count();
+
+		if (OS::get_singleton()->get_ticks_usec() - from_usec >= budget_usec) {
+			break;
+		}
+	}
+
+	//upload once, no matter how many regions were updated
+	probe_data->allocate(to_cell_xform, bounds, probe_data->get_octree_size(), update_cache.octree_cells, update_cache.data_cells, update_cache.distance_field, level_counts);
+
+	if (pending_regions.empty()) {
+		set_process_internal(false);
+	}
+}
+
+void GIProbe::_notification(int p_what) {
+
+	if (p_what == NOTIFICATION_INTERNAL_PROCESS) {
+		_process_pending_regions();
+	}
+}
+
 void GIProbe::_debug_bake() {
 
 	bake(NULL, true);
@@ -547,8 +669,15 @@ void GIProbe::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("debug_bake"), &GIProbe::_debug_bake);
 	ClassDB::set_method_flags(get_class_static(), _scs_create("debug_bake"), METHOD_FLAGS_DEFAULT | METHOD_FLAG_EDITOR);
 
+	ClassDB::bind_method(D_METHOD("update_region", "region"), &GIProbe::update_region);
+	ClassDB::bind_method(D_METHOD("is_region_update_pending"), &GIProbe::is_region_update_pending);
+
+	ClassDB::bind_method(D_METHOD("set_region_update_budget", "msec"), &GIProbe::set_region_update_budget);
+	ClassDB::bind_method(D_METHOD("get_region_update_budget"), &GIProbe::get_region_update_budget);
+
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "subdiv", PROPERTY_HINT_ENUM, "64,128,256,512"), "set_subdiv", "get_subdiv");
 	ADD_PROPERTY(PropertyInfo(Variant::VECTOR3, "extents"), "set_extents", "get_extents");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "region_update_budget", PROPERTY_HINT_RANGE, "0,33,0.1"), "set_region_update_budget", "get_region_update_budget");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "data", PROPERTY_HINT_RESOURCE_TYPE, "GIProbeData", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_DO_NOT_SHARE_ON_DUPLICATE), "set_probe_data", "get_probe_data");
 
 	BIND_ENUM_CONSTANT(SUBDIV_64);
@@ -562,6 +691,7 @@ GIProbe::GIProbe() {
 
 	subdiv = SUBDIV_128;
 	extents = Vector3(10, 10, 10);
+	region_update_budget = 2.0;
 
 	gi_probe = RS::get_singleton()->gi_probe_create();
 	set_disable_scale(true);
@@ -143,7 +143,21 @@ private:
 	void _find_meshes(Node *p_at_node, List<PlotMesh> &plot_meshes);
 	void _debug_bake();
 
+	float region_update_budget; //msec per frame
+	Vector<AABB> pending_regions;
+
+	//regions are updated from a CPU copy of the probe data, so it does not need to be read back every frame
+	struct UpdateCache {
+		Ref<GIProbeData> data;
+		Vector<uint8_t> octree_cells;
+		Vector<uint8_t> data_cells;
+		Vector<uint8_t> distance_field;
+	} update_cache;
+
+	void _process_pending_regions();
+
 protected:
+	void _notification(int p_what);
 	static void _bind_methods();
 
 public:
@@ -163,6 +177,12 @@ public:
 
 	void bake(Node *p_from_node = NULL, bool p_create_visual_debug = false);
 
+	void update_region(const AABB &p_region);
+	bool is_region_update_pending() const;
+
+	void set_region_update_budget(float p_msec);
+	float get_region_update_budget() const;
+
 	virtual AABB get_aabb() const;
 	virtual Vector<Face3> get_faces(uint32_t p_usage_flags) const;
 
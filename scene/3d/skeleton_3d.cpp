@@ -33,6 +33,7 @@
 #include "core/engine.h"
 #include "core/message_queue.h"
 #include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 #include "scene/3d/physics_body_3d.h"
 #include "scene/resources/surface_tool.h"
 
@@ -221,86 +222,142 @@ void Skeleton3D::_update_process_order() {
 	process_order_dirty = false;
 }
 
-void Skeleton3D::_notification(int p_what) {
+void Skeleton3D::_update_global_poses() {
 
-	switch (p_what) {
+	Bone *bonesptr = bones.ptrw();
+	int len = bones.size();
 
-		case NOTIFICATION_UPDATE_SKELETON: {
+	_update_process_order();
 
-			RenderingServer *vs = RenderingServer::get_singleton();
-			Bone *bonesptr = bones.ptrw();
-			int len = bones.size();
+	const int *order = process_order.ptr();
 
-			_update_process_order();
+	for (int i = 0; i < len; i++) {
 
-			const int *order = process_order.ptr();
+		Bone &b = bonesptr[order[i]];
 
-			for (int i = 0; i < len; i++) {
+		if (b.global_pose_override_amount >= 0.999) {
+			b.pose_global = b.global_pose_override;
+		} else {
+			if (b.disable_rest) {
+				if (b.enabled) {
 
-				Bone &b = bonesptr[order[i]];
+					Transform pose = b.pose;
+					if (b.custom_pose_enable) {
+						pose = b.custom_pose * pose;
+					}
+					if (b.parent >= 0) {
 
-				if (b.global_pose_override_amount >= 0.999) {
-					b.pose_global = b.global_pose_override;
+						b.pose_global = bonesptr[b.parent].pose_global * pose;
+					} else {
+
+						b.pose_global = pose;
+					}
 				} else {
-					if (b.disable_rest) {
-						if (b.enabled) {
 
-							Transform pose = b.pose;
-							if (b.custom_pose_enable) {
-								pose = b.custom_pose * pose;
-							}
-							if (b.parent >= 0) {
+					if (b.parent >= 0) {
 
-								b.pose_global = bonesptr[b.parent].pose_global * pose;
-							} else {
+						b.pose_global = bonesptr[b.parent].pose_global;
+					} else {
 
-								b.pose_global = pose;
-							}
-						} else {
+						b.pose_global = Transform();
+					}
+				}
 
-							if (b.parent >= 0) {
+			} else {
+				if (b.enabled) {
 
-								b.pose_global = bonesptr[b.parent].pose_global;
-							} else {
+					Transform pose = b.pose;
+					if (b.custom_pose_enable) {
+						pose = b.custom_pose * pose;
+					}
+					if (b.parent >= 0) {
 
-								b.pose_global = Transform();
-							}
-						}
+						b.pose_global = bonesptr[b.parent].pose_global * (b.rest * pose);
+					} else {
+
+						b.pose_global = b.rest * pose;
+					}
+				} else {
 
+					if (b.parent >= 0) {
+
+						b.pose_global = bonesptr[b.parent].pose_global * b.rest;
 					} else {
-						if (b.enabled) {
 
-							Transform pose = b.pose;
-							if (b.custom_pose_enable) {
-								pose = b.custom_pose * pose;
-							}
-							if (b.parent >= 0) {
+						b.pose_global = b.rest;
+					}
+				}
+			}
 
-								b.pose_global = bonesptr[b.parent].pose_global * (b.rest * pose);
-							} else {
+			if (b.global_pose_override_amount >= CMP_EPSILON) {
+				b.pose_global = b.pose_global.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+			}
+		}
 
-								b.pose_global = b.rest * pose;
-							}
-						} else {
+		if (b.global_pose_override_reset) {
+			b.global_pose_override_amount = 0.0;
+		}
+	}
 
-							if (b.parent >= 0) {
+	global_poses_ready = true;
+}
 
-								b.pose_global = bonesptr[b.parent].pose_global * b.rest;
-							} else {
+LocalVector<Skeleton3D *> Skeleton3D::dirty_skeletons;
+Mutex Skeleton3D::dirty_mutex;
 
-								b.pose_global = b.rest;
-							}
-						}
-					}
+void Skeleton3D::_compute_global_poses(uint32_t p_index, Skeleton3D **p_skeletons) {
 
-					if (b.global_pose_override_amount >= CMP_EPSILON) {
-						b.pose_global = b.pose_global.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
-					}
-				}
+	p_skeletons[p_index]->_update_global_poses();
+}
 
-				if (b.global_pose_override_reset) {
-					b.global_pose_override_amount = 0.0;
-				}
+// Skeletons made dirty during the frame have their poses computed together, spread over the
+// worker threads. Only bone data is touched here, bound nodes and skins are updated afterwards
+// by each skeleton on the main thread.
+void Skeleton3D::_update_dirty_global_poses() {
+
+	LocalVector<Skeleton3D *> batch;
+	{
+		MutexLock lock(dirty_mutex);
+		batch = dirty_skeletons;
+		dirty_skeletons.clear();
+	}
+
+	uint32_t bone_count = 0;
+	for (uint32_t i = 0; i < batch.size(); i++) {
+		bone_count += batch[i]->bones.size();
+	}
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0 && batch.size() > 1 && bone_count >= POSE_PARALLEL_MIN) {
+		pool->do_work(batch.size(), this, &Skeleton3D::_compute_global_poses, batch.ptr());
+	} else {
+		for (uint32_t i = 0; i < batch.size(); i++) {
+			batch[i]->_update_global_poses();
+		}
+	}
+}
+
+void Skeleton3D::_notification(int p_what) {
+
+	switch (p_what) {
+
+		case NOTIFICATION_UPDATE_SKELETON: {
+
+			if (!dirty)
+				break; // already updated on demand
+
+			RenderingServer *vs = RenderingServer::get_singleton();
+			Bone *bonesptr = bones.ptrw();
+			int len = bones.size();
+
+			if (!global_poses_ready)
+				_update_dirty_global_poses();
+			if (!global_poses_ready)
+				_update_global_poses();
+
+			for (int i = 0; i < len; i++) {
+
+				Bone &b = bonesptr[i];
 
 				for (List<ObjectID>::Element *E = b.nodes_bound.front(); E; E = E->next()) {
 
@@ -363,11 +420,26 @@ void Skeleton3D::_notification(int p_what) {
 					E->get()->skeleton_version = version;
 				}
 
+				// the skin is sent in one call, in the 3x4 layout the rendering server stores
+				Vector<float> buffer;
+				buffer.resize(bind_count * 12);
+				float *w = buffer.ptrw();
 				for (uint32_t i = 0; i < bind_count; i++) {
 					uint32_t bone_index = E->get()->skin_bone_indices_ptrs[i];
-					ERR_CONTINUE(bone_index >= (uint32_t)len);
-					vs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].pose_global * skin->get_bind_pose(i));
+					Transform xform;
+					if (bone_index < (uint32_t)len) {
+						xform = bonesptr[bone_index].pose_global * skin->get_bind_pose(i);
+					} else {
+						ERR_PRINT("Skin bind #" + itos(i) + " points to an invalid bone.");
+					}
+					for (int j = 0; j < 3; j++) {
+						*w++ = xform.basis.elements[j][0];
+						*w++ = xform.basis.elements[j][1];
+						*w++ = xform.basis.elements[j][2];
+						*w++ = xform.origin[j];
+					}
 				}
+				vs->skeleton_set_bone_transforms(skeleton, buffer);
 			}
 
 			dirty = false;
@@ -626,11 +698,16 @@ Transform Skeleton3D::get_bone_custom_pose(int p_bone) const {
 
 void Skeleton3D::_make_dirty() {
 
+	global_poses_ready = false;
+
 	if (dirty)
 		return;
 
 	MessageQueue::get_singleton()->push_notification(this, NOTIFICATION_UPDATE_SKELETON);
 	dirty = true;
+
+	MutexLock lock(dirty_mutex);
+	dirty_skeletons.push_back(this);
 }
 
 int Skeleton3D::get_process_order(int p_idx) {
@@ -943,12 +1020,18 @@ Skeleton3D::Skeleton3D() {
 
 	animate_physical_bones = true;
 	dirty = false;
+	global_poses_ready = false;
 	version = 1;
 	process_order_dirty = true;
 }
 
 Skeleton3D::~Skeleton3D() {
 
+	if (dirty) {
+		MutexLock lock(dirty_mutex);
+		dirty_skeletons.erase(this);
+	}
+
 	//some skins may remain bound
 	for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
 		E->get()->skeleton_node = nullptr;
@@ -31,6 +31,8 @@
 #ifndef SKELETON_3D_H
 #define SKELETON_3D_H
 
+#include "core/local_vector.h"
+#include "core/os/mutex.h"
 #include "core/rid.h"
 #include "scene/3d/node_3d.h"
 #include "scene/resources/skin.h"
@@ -123,8 +125,20 @@ private:
 	Vector<int> process_order;
 	bool process_order_dirty;
 
+	enum {
+		POSE_PARALLEL_MIN = 256 // total bones of the dirty skeletons
+	};
+
 	void _make_dirty();
 	bool dirty;
+	bool global_poses_ready;
+
+	static LocalVector<Skeleton3D *> dirty_skeletons;
+	static Mutex dirty_mutex;
+
+	void _update_global_poses();
+	void _compute_global_poses(uint32_t p_index, Skeleton3D **p_skeletons);
+	void _update_dirty_global_poses();
 
 	uint64_t version;
 
@@ -39,29 +39,33 @@
 #include "scene/3d/skeleton_3d.h"
 #include "servers/physics_server_3d.h"
 
-SoftBodyRenderingServerHandler::SoftBodyRenderingServerHandler() {}
+SoftBodyRenderingServerHandler::SoftBodyRenderingServerHandler() :
+		surface(0),
+		stride(0),
+		offset_vertices(0),
+		offset_normal(0),
+		write_buffer(NULL),
+		dirty_from(-1),
+		dirty_to(-1) {
+}
 
 void SoftBodyRenderingServerHandler::prepare(RID p_mesh, int p_surface) {
 	clear();
 
 	ERR_FAIL_COND(!p_mesh.is_valid());
 
-	mesh = p_mesh;
-	surface = p_surface;
-#ifndef _MSC_VER
-#warning Softbody is not working, needs to be redone considering that these functions no longer exist
-#endif
-#if 0
-	const uint32_t surface_format = RS::get_singleton()->mesh_surface_get_format(mesh, surface);
-	const int surface_vertex_len = RS::get_singleton()->mesh_surface_get_array_len(mesh, p_surface);
-	const int surface_index_len = RS::get_singleton()->mesh_surface_get_array_index_len(mesh, p_surface);
-	uint32_t surface_offsets[RS::ARRAY_MAX];
+	// Vertex attributes are interleaved in a single buffer, keep a copy of it and patch positions and normals in place.
+	RS::SurfaceData surface_data = RS::get_singleton()->mesh_get_surface(p_mesh, p_surface);
+	ERR_FAIL_COND_MSG(surface_data.format & (RS::ARRAY_COMPRESS_VERTEX | RS::ARRAY_COMPRESS_NORMAL), "Soft body meshes can't use compressed vertices or normals.");
 
-	buffer = RS::get_singleton()->mesh_surface_get_array(mesh, surface);
-	stride = RS::get_singleton()->mesh_surface_make_offsets_from_format(surface_format, surface_vertex_len, surface_index_len, surface_offsets);
+	uint32_t surface_offsets[RS::ARRAY_MAX];
+	stride = RS::get_singleton()->mesh_surface_make_offsets_from_format(surface_data.format, surface_data.vertex_count, surface_data.index_count, surface_offsets);
 	offset_vertices = surface_offsets[RS::ARRAY_VERTEX];
 	offset_normal = surface_offsets[RS::ARRAY_NORMAL];
-#endif
+	buffer = surface_data.vertex_data;
+
+	mesh = p_mesh;
+	surface = p_surface;
 }
 
 void SoftBodyRenderingServerHandler::clear() {
@@ -75,6 +79,8 @@ void SoftBodyRenderingServerHandler::clear() {
 
 void SoftBodyRenderingServerHandler::open() {
 	write_buffer = buffer.ptrw();
+	dirty_from = -1;
+	dirty_to = -1;
 }
 
 void SoftBodyRenderingServerHandler::close() {
@@ -82,14 +88,26 @@ void SoftBodyRenderingServerHandler::close() {
 }
 
 void SoftBodyRenderingServerHandler::commit_changes() {
-	RS::get_singleton()->mesh_surface_update_region(mesh, surface, 0, buffer);
+	if (dirty_from < 0) {
+		return;
+	}
+
+	const int from = dirty_from * stride;
+	const int to = (dirty_to + 1) * stride - 1;
+	if (from == 0 && to == buffer.size() - 1) {
+		RS::get_singleton()->mesh_surface_update_region(mesh, surface, 0, buffer);
+	} else {
+		RS::get_singleton()->mesh_surface_update_region(mesh, surface, from, buffer.subarray(from, to));
+	}
 }
 
 void SoftBodyRenderingServerHandler::set_vertex(int p_vertex_id, const void *p_vector3) {
+	_mark_dirty(p_vertex_id);
 	copymem(&write_buffer[p_vertex_id * stride + offset_vertices], p_vector3, sizeof(float) * 3);
 }
 
 void SoftBodyRenderingServerHandler::set_normal(int p_vertex_id, const void *p_vector3) {
+	_mark_dirty(p_vertex_id);
 	copymem(&write_buffer[p_vertex_id * stride + offset_normal], p_vector3, sizeof(float) * 3);
 }
 
@@ -491,7 +509,7 @@ void SoftBody3D::become_mesh_owner() {
 		Dictionary surface_lods = mesh->surface_get_lods(0);
 		uint32_t surface_format = mesh->surface_get_format(0);
 
-		surface_format &= ~(Mesh::ARRAY_COMPRESS_NORMAL);
+		surface_format &= ~(Mesh::ARRAY_COMPRESS_VERTEX | Mesh::ARRAY_COMPRESS_NORMAL);
 		surface_format |= Mesh::ARRAY_FLAG_USE_DYNAMIC_UPDATE;
 
 		Ref<ArrayMesh> soft_mesh;
@@ -47,6 +47,9 @@ class SoftBodyRenderingServerHandler {
 	uint32_t offset_normal;
 
 	uint8_t *write_buffer;
+	// Range of vertices written since open(), only this part of the buffer is uploaded.
+	int dirty_from;
+	int dirty_to;
 
 private:
 	SoftBodyRenderingServerHandler();
@@ -57,6 +60,15 @@ private:
 	void close();
 	void commit_changes();
 
+	_FORCE_INLINE_ void _mark_dirty(int p_vertex_id) {
+		if (dirty_from < 0 || p_vertex_id < dirty_from) {
+			dirty_from = p_vertex_id;
+		}
+		if (p_vertex_id > dirty_to) {
+			dirty_to = p_vertex_id;
+		}
+	}
+
 public:
 	void set_vertex(int p_vertex_id, const void *p_vector3);
 	void set_normal(int p_vertex_id, const void *p_vector3);
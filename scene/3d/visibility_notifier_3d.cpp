@@ -34,8 +34,22 @@
 #include "scene/3d/camera_3d.h"
 #include "scene/3d/physics_body_3d.h"
 #include "scene/animation/animation_player.h"
+#include "scene/animation/animation_tree.h"
 #include "scene/scene_string_names.h"
 
+static void _set_node_interval(Node *p_node, int p_interval) {
+
+	AnimationPlayer *ap = Object::cast_to<AnimationPlayer>(p_node);
+	if (ap) {
+		ap->set_update_interval(p_interval);
+	}
+
+	AnimationTree *at = Object::cast_to<AnimationTree>(p_node);
+	if (at) {
+		at->set_update_interval(p_interval);
+	}
+}
+
 void VisibilityNotifier3D::_enter_camera(Camera3D *p_camera) {
 
 	ERR_FAIL_COND(cameras.has(p_camera));
@@ -103,6 +117,32 @@ bool VisibilityNotifier3D::is_on_screen() const {
 	return cameras.size() != 0;
 }
 
+// Fraction of the viewport height covered by the bounding sphere of the AABB, largest over the cameras it's seen from.
+float VisibilityNotifier3D::_get_screen_size() const {
+
+	AABB world_aabb = get_global_transform().xform(aabb);
+	Vector3 center = world_aabb.position + world_aabb.size * 0.5;
+	real_t radius = world_aabb.size.length() * 0.5;
+
+	float size = 0;
+	for (Set<Camera3D *>::Element *E = cameras.front(); E; E = E->next()) {
+
+		Camera3D *camera = E->get();
+		if (camera->get_projection() == Camera3D::PROJECTION_ORTHOGONAL) {
+			size = MAX(size, radius * 2.0 / camera->get_size());
+			continue;
+		}
+
+		real_t distance = camera->get_camera_transform().origin.distance_to(center);
+		if (distance <= radius)
+			return 1.0; // camera is inside
+
+		size = MAX(size, radius / (distance * Math::tan(Math::deg2rad(camera->get_fov()) * 0.5)));
+	}
+
+	return MIN(size, 1.0);
+}
+
 void VisibilityNotifier3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("set_aabb", "rect"), &VisibilityNotifier3D::set_aabb);
@@ -133,6 +173,7 @@ void VisibilityEnabler3D::_screen_enter() {
 	}
 
 	visible = true;
+	_update_interval();
 }
 
 void VisibilityEnabler3D::_screen_exit() {
@@ -143,6 +184,7 @@ void VisibilityEnabler3D::_screen_exit() {
 	}
 
 	visible = false;
+	_update_interval();
 }
 
 void VisibilityEnabler3D::_find_nodes(Node *p_node) {
@@ -166,6 +208,13 @@ void VisibilityEnabler3D::_find_nodes(Node *p_node) {
 		}
 	}
 
+	{
+		AnimationTree *at = Object::cast_to<AnimationTree>(p_node);
+		if (at) {
+			add = true;
+		}
+	}
+
 	if (add) {
 
 		p_node->connect(SceneStringNames::get_singleton()->tree_exiting, callable_mp(this, &VisibilityEnabler3D::_node_removed), varray(p_node), CONNECT_ONESHOT);
@@ -195,6 +244,15 @@ void VisibilityEnabler3D::_notification(int p_what) {
 			from = from->get_parent();
 
 		_find_nodes(from);
+
+		update_interval = 0;
+		_update_interval();
+		set_process_internal(enabler[ENABLER_THROTTLE_ANIMATIONS]);
+	}
+
+	if (p_what == NOTIFICATION_INTERNAL_PROCESS) {
+
+		_update_interval();
 	}
 
 	if (p_what == NOTIFICATION_EXIT_TREE) {
@@ -206,6 +264,8 @@ void VisibilityEnabler3D::_notification(int p_what) {
 
 			if (!visible)
 				_change_node_state(E->key(), true);
+			if (enabler[ENABLER_THROTTLE_ANIMATIONS])
+				_set_node_interval(E->key(), 1);
 			E->key()->disconnect(SceneStringNames::get_singleton()->tree_exiting, callable_mp(this, &VisibilityEnabler3D::_node_removed));
 		}
 
@@ -238,19 +298,56 @@ void VisibilityEnabler3D::_node_removed(Node *p_node) {
 
 	if (!visible)
 		_change_node_state(p_node, true);
+	if (enabler[ENABLER_THROTTLE_ANIMATIONS])
+		_set_node_interval(p_node, 1);
 	nodes.erase(p_node);
 }
 
+// Animations covering less than throttle_screen_size of the screen update less often, down to once
+// every throttle_max_interval frames when they get very small or leave the screen.
+void VisibilityEnabler3D::_update_interval() {
+
+	if (!enabler[ENABLER_THROTTLE_ANIMATIONS] || !is_inside_tree() || Engine::get_singleton()->is_editor_hint())
+		return;
+
+	int interval = throttle_max_interval;
+	if (visible) {
+		float size = _get_screen_size();
+		if (size >= throttle_screen_size) {
+			interval = 1;
+		} else if (size > 0) {
+			interval = CLAMP(int(Math::ceil(throttle_screen_size / size)), 1, throttle_max_interval);
+		}
+	}
+
+	if (interval == update_interval)
+		return;
+
+	update_interval = interval;
+	for (Map<Node *, Variant>::Element *E = nodes.front(); E; E = E->next()) {
+		_set_node_interval(E->key(), interval);
+	}
+}
+
 void VisibilityEnabler3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("set_enabler", "enabler", "enabled"), &VisibilityEnabler3D::set_enabler);
 	ClassDB::bind_method(D_METHOD("is_enabler_enabled", "enabler"), &VisibilityEnabler3D::is_enabler_enabled);
 
+	ClassDB::bind_method(D_METHOD("set_throttle_screen_size", "size"), &VisibilityEnabler3D::set_throttle_screen_size);
+	ClassDB::bind_method(D_METHOD("get_throttle_screen_size"), &VisibilityEnabler3D::get_throttle_screen_size);
+	ClassDB::bind_method(D_METHOD("set_throttle_max_interval", "frames"), &VisibilityEnabler3D::set_throttle_max_interval);
+	ClassDB::bind_method(D_METHOD("get_throttle_max_interval"), &VisibilityEnabler3D::get_throttle_max_interval);
+
 	ADD_PROPERTYI(PropertyInfo(Variant::BOOL, "pause_animations"), "set_enabler", "is_enabler_enabled", ENABLER_PAUSE_ANIMATIONS);
 	ADD_PROPERTYI(PropertyInfo(Variant::BOOL, "freeze_bodies"), "set_enabler", "is_enabler_enabled", ENABLER_FREEZE_BODIES);
+	ADD_PROPERTYI(PropertyInfo(Variant::BOOL, "throttle_animations"), "set_enabler", "is_enabler_enabled", ENABLER_THROTTLE_ANIMATIONS);
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "throttle_screen_size", PROPERTY_HINT_RANGE, "0.001,1,0.001"), "set_throttle_screen_size", "get_throttle_screen_size");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "throttle_max_interval", PROPERTY_HINT_RANGE, "1,60,1"), "set_throttle_max_interval", "get_throttle_max_interval");
 
 	BIND_ENUM_CONSTANT(ENABLER_PAUSE_ANIMATIONS);
 	BIND_ENUM_CONSTANT(ENABLER_FREEZE_BODIES);
+	BIND_ENUM_CONSTANT(ENABLER_THROTTLE_ANIMATIONS);
 	BIND_ENUM_CONSTANT(ENABLER_MAX);
 }
 
@@ -258,6 +355,16 @@ void VisibilityEnabler3D::set_enabler(Enabler p_enabler, bool p_enable) {
 
 	ERR_FAIL_INDEX(p_enabler, ENABLER_MAX);
 	enabler[p_enabler] = p_enable;
+
+	if (p_enabler == ENABLER_THROTTLE_ANIMATIONS && is_inside_tree() && !Engine::get_singleton()->is_editor_hint()) {
+		set_process_internal(p_enable);
+		if (!p_enable) {
+			update_interval = 1;
+			for (Map<Node *, Variant>::Element *E = nodes.front(); E; E = E->next()) {
+				_set_node_interval(E->key(), 1);
+			}
+		}
+	}
 }
 bool VisibilityEnabler3D::is_enabler_enabled(Enabler p_enabler) const {
 
@@ -265,10 +372,35 @@ bool VisibilityEnabler3D::is_enabler_enabled(Enabler p_enabler) const {
 	return enabler[p_enabler];
 }
 
+void VisibilityEnabler3D::set_throttle_screen_size(float p_size) {
+
+	throttle_screen_size = p_size;
+}
+
+float VisibilityEnabler3D::get_throttle_screen_size() const {
+
+	return throttle_screen_size;
+}
+
+void VisibilityEnabler3D::set_throttle_max_interval(int p_frames) {
+
+	ERR_FAIL_COND(p_frames < 1);
+	throttle_max_interval = p_frames;
+}
+
+int VisibilityEnabler3D::get_throttle_max_interval() const {
+
+	return throttle_max_interval;
+}
+
 VisibilityEnabler3D::VisibilityEnabler3D() {
 
 	for (int i = 0; i < ENABLER_MAX; i++)
 		enabler[i] = true;
+	enabler[ENABLER_THROTTLE_ANIMATIONS] = false;
 
 	visible = false;
+	throttle_screen_size = 0.1;
+	throttle_max_interval = 4;
+	update_interval = 1;
 }
@@ -53,6 +53,8 @@ protected:
 	void _enter_camera(Camera3D *p_camera);
 	void _exit_camera(Camera3D *p_camera);
 
+	float _get_screen_size() const;
+
 public:
 	void set_aabb(const AABB &p_aabb);
 	AABB get_aabb() const;
@@ -69,6 +71,7 @@ public:
 	enum Enabler {
 		ENABLER_PAUSE_ANIMATIONS,
 		ENABLER_FREEZE_BODIES,
+		ENABLER_THROTTLE_ANIMATIONS,
 		ENABLER_MAX
 	};
 
@@ -84,7 +87,12 @@ protected:
 	void _node_removed(Node *p_node);
 	bool enabler[ENABLER_MAX];
 
+	float throttle_screen_size;
+	int throttle_max_interval;
+	int update_interval;
+
 	void _change_node_state(Node *p_node, bool p_enabled);
+	void _update_interval();
 
 	void _notification(int p_what);
 	static void _bind_methods();
@@ -93,6 +101,12 @@ public:
 	void set_enabler(Enabler p_enabler, bool p_enable);
 	bool is_enabler_enabled(Enabler p_enabler) const;
 
+	void set_throttle_screen_size(float p_size);
+	float get_throttle_screen_size() const;
+
+	void set_throttle_max_interval(int p_frames);
+	int get_throttle_max_interval() const;
+
 	VisibilityEnabler3D();
 };
 
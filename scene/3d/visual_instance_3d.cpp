@@ -30,6 +30,7 @@
 
 #include "visual_instance_3d.h"
 
+#include "scene/3d/physics_body_3d.h"
 #include "scene/scene_string_names.h"
 #include "servers/rendering_server.h"
 #include "skeleton_3d.h"
@@ -48,6 +49,27 @@ void VisualInstance3D::_update_visibility() {
 	RS::get_singleton()->instance_set_visible(get_instance(), is_visible_in_tree());
 }
 
+void VisualInstance3D::_update_physics_interpolation() {
+
+	//physics bodies only move on physics ticks, so anything they carry is blended between ticks by the server
+	bool interpolated = false;
+	if (get_tree()->is_physics_interpolation_enabled()) {
+		for (Node *p = get_parent(); p; p = p->get_parent()) {
+			if (Object::cast_to<PhysicsBody3D>(p)) {
+				interpolated = true;
+				break;
+			}
+		}
+	}
+
+	RenderingServer::get_singleton()->instance_set_interpolated(instance, interpolated);
+	if (interpolated) {
+		//start from where the node is, not from wherever the instance was last drawn
+		RenderingServer::get_singleton()->instance_set_transform(instance, get_global_transform());
+		RenderingServer::get_singleton()->instance_reset_physics_interpolation(instance);
+	}
+}
+
 void VisualInstance3D::_notification(int p_what) {
 
 	switch (p_what) {
@@ -62,13 +84,18 @@ void VisualInstance3D::_notification(int p_what) {
 			*/
 			ERR_FAIL_COND(get_world().is_null());
 			RenderingServer::get_singleton()->instance_set_scenario(instance, get_world()->get_scenario());
+			_update_physics_interpolation();
 			_update_visibility();
 
 		} break;
 		case NOTIFICATION_TRANSFORM_CHANGED: {
 
 			Transform gt = get_global_transform();
-			RenderingServer::get_singleton()->instance_set_transform(instance, gt);
+			get_tree()->instance_set_transform(instance, gt);
+		} break;
+		case NOTIFICATION_RESET_PHYSICS_INTERPOLATION: {
+
+			RenderingServer::get_singleton()->instance_reset_physics_interpolation(instance);
 		} break;
 		case NOTIFICATION_EXIT_WORLD: {
 
@@ -299,6 +326,7 @@ void GeometryInstance3D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "extra_cull_margin", PROPERTY_HINT_RANGE, "0,16384,0.01"), "set_extra_cull_margin", "get_extra_cull_margin");
 	ADD_PROPERTYI(PropertyInfo(Variant::BOOL, "use_in_baked_light"), "set_flag", "get_flag", FLAG_USE_BAKED_LIGHT);
 	ADD_PROPERTYI(PropertyInfo(Variant::BOOL, "use_dynamic_gi"), "set_flag", "get_flag", FLAG_USE_DYNAMIC_GI);
+	ADD_PROPERTYI(PropertyInfo(Variant::BOOL, "ignore_occlusion_culling"), "set_flag", "get_flag", FLAG_IGNORE_OCCLUSION_CULLING);
 
 	ADD_GROUP("LOD", "lod_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_min_distance", PROPERTY_HINT_RANGE, "0,32768,0.01"), "set_lod_min_distance", "get_lod_min_distance");
@@ -316,6 +344,7 @@ void GeometryInstance3D::_bind_methods() {
 	BIND_ENUM_CONSTANT(FLAG_USE_BAKED_LIGHT);
 	BIND_ENUM_CONSTANT(FLAG_USE_DYNAMIC_GI);
 	BIND_ENUM_CONSTANT(FLAG_DRAW_NEXT_FRAME_IF_VISIBLE);
+	BIND_ENUM_CONSTANT(FLAG_IGNORE_OCCLUSION_CULLING);
 	BIND_ENUM_CONSTANT(FLAG_MAX);
 }
 
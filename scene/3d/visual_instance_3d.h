@@ -49,6 +49,7 @@ class VisualInstance3D : public Node3D {
 
 protected:
 	void _update_visibility();
+	void _update_physics_interpolation();
 
 	void _notification(int p_what);
 	static void _bind_methods();
@@ -89,6 +90,7 @@ public:
 		FLAG_USE_BAKED_LIGHT = RS::INSTANCE_FLAG_USE_BAKED_LIGHT,
 		FLAG_USE_DYNAMIC_GI = RS::INSTANCE_FLAG_USE_DYNAMIC_GI,
 		FLAG_DRAW_NEXT_FRAME_IF_VISIBLE = RS::INSTANCE_FLAG_DRAW_NEXT_FRAME_IF_VISIBLE,
+		FLAG_IGNORE_OCCLUSION_CULLING = RS::INSTANCE_FLAG_IGNORE_OCCLUSION_CULLING,
 		FLAG_MAX = RS::INSTANCE_FLAG_MAX,
 	};
 
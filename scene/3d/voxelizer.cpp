@@ -447,6 +447,10 @@ void Voxelizer::_plot_face(int p_idx, int p_level, int p_x, int p_y, int p_z, co
 			if (nx < 0 || nx >= axis_cell_size[0] || ny < 0 || ny >= axis_cell_size[1] || nz < 0 || nz >= axis_cell_size[2])
 				continue;
 
+			//when updating a region, cells outside of it are kept as they are
+			if (nx + half <= region_from.x || nx >= region_to.x || ny + half <= region_from.y || ny >= region_to.y || nz + half <= region_from.z || nz >= region_to.z)
+				continue;
+
 			{
 				AABB test_aabb = aabb;
 				//test_aabb.grow_by(test_aabb.get_longest_axis_size()*0.05); //grow a bit to avoid numerical error in real-time
@@ -638,8 +642,8 @@ void Voxelizer::plot_mesh(const Transform &p_xform, Ref<Mesh> &p_mesh, const Vec
 					}
 				}
 
-				//test against original bounds
-				if (!fast_tri_box_overlap(original_bounds.position + original_bounds.size * 0.5, original_bounds.size * 0.5, vtxs))
+				//test against plot bounds
+				if (!fast_tri_box_overlap(plot_bounds.position + plot_bounds.size * 0.5, plot_bounds.size * 0.5, vtxs))
 					continue;
 				//plot
 				_plot_face(0, 0, 0, 0, 0, vtxs, normal, uvs, material, po2_bounds);
@@ -671,8 +675,8 @@ void Voxelizer::plot_mesh(const Transform &p_xform, Ref<Mesh> &p_mesh, const Vec
 					}
 				}
 
-				//test against original bounds
-				if (!fast_tri_box_overlap(original_bounds.position + original_bounds.size * 0.5, original_bounds.size * 0.5, vtxs))
+				//test against plot bounds
+				if (!fast_tri_box_overlap(plot_bounds.position + plot_bounds.size * 0.5, plot_bounds.size * 0.5, vtxs))
 					continue;
 				//plot face
 				_plot_face(0, 0, 0, 0, 0, vtxs, normal, uvs, material, po2_bounds);
@@ -865,9 +869,183 @@ void Voxelizer::begin_bake(int p_subdiv, const AABB &p_bounds) {
 	to_cell_space = to_grid * to_bounds.affine_inverse();
 
 	cell_size = po2_bounds.size[longest_axis] / axis_cell_size[longest_axis];
+
+	plot_bounds = original_bounds;
+	region_from = Vector3i();
+	region_to = Vector3i(axis_cell_size[0], axis_cell_size[1], axis_cell_size[2]);
+	updating_region = false;
+}
+
+bool Voxelizer::_prune_region(int p_idx, int p_level, int p_x, int p_y, int p_z) {
+
+	//returns true when nothing is left below this cell, so the parent can drop it
+
+	if (p_level == cell_subdiv) {
+		return true; //leaf inside the region, it will be plotted again
+	}
+
+	bool empty = true;
+	int half = (1 << cell_subdiv) >> (p_level + 1);
+
+	for (int i = 0; i < 8; i++) {
+
+		uint32_t child = bake_cells[p_idx].children[i];
+		if (child == CHILD_EMPTY)
+			continue;
+
+		int nx = p_x + ((i & 1) ? half : 0);
+		int ny = p_y + ((i & 2) ? half : 0);
+		int nz = p_z + ((i & 4) ? half : 0);
+
+		if (nx + half <= region_from.x || nx >= region_to.x || ny + half <= region_from.y || ny >= region_to.y || nz + half <= region_from.z || nz >= region_to.z) {
+			empty = false; //outside the region, keep
+			continue;
+		}
+
+		if (_prune_region(child, p_level + 1, nx, ny, nz)) {
+			bake_cells.write[p_idx].children[i] = CHILD_EMPTY;
+		} else {
+			empty = false;
+		}
+	}
+
+	return empty;
+}
+
+void Voxelizer::_compact() {
+
+	//pruning leaves unreferenced cells behind, remove them before sorting
+	uint32_t cell_count = bake_cells.size();
+
+	Vector<uint32_t> remap;
+	remap.resize(cell_count);
+	uint32_t *remapp = remap.ptrw();
+	for (uint32_t i = 0; i < cell_count; i++) {
+		remapp[i] = CHILD_EMPTY;
+	}
+
+	Vector<uint32_t> stack;
+	stack.push_back(0);
+	remapp[0] = 0;
+
+	while (stack.size()) {
+		uint32_t idx = stack[stack.size() - 1];
+		stack.resize(stack.size() - 1);
+
+		for (int i = 0; i < 8; i++) {
+			uint32_t child = bake_cells[idx].children[i];
+			if (child != CHILD_EMPTY && remapp[child] == CHILD_EMPTY) {
+				remapp[child] = 0; //mark as used, real index assigned below
+				stack.push_back(child);
+			}
+		}
+	}
+
+	uint32_t used_count = 0;
+	for (uint32_t i = 0; i < cell_count; i++) {
+		if (remapp[i] != CHILD_EMPTY) {
+			remapp[i] = used_count++;
+		}
+	}
+
+	Vector<Cell> new_bake_cells;
+	new_bake_cells.resize(used_count);
+	{
+		const Cell *bake_cellsp = bake_cells.ptr();
+		Cell *new_bake_cellsp = new_bake_cells.ptrw();
+
+		for (uint32_t i = 0; i < cell_count; i++) {
+			if (remapp[i] == CHILD_EMPTY) {
+				continue;
+			}
+			Cell &cell = new_bake_cellsp[remapp[i]];
+			cell = bake_cellsp[i];
+			for (int j = 0; j < 8; j++) {
+				if (cell.children[j] != CHILD_EMPTY) {
+					cell.children[j] = remapp[cell.children[j]];
+				}
+			}
+		}
+	}
+
+	bake_cells = new_bake_cells;
+}
+
+void Voxelizer::begin_bake_update(int p_subdiv, const AABB &p_bounds, const AABB &p_region, const Vector<uint8_t> &p_octree_cells, const Vector<uint8_t> &p_data_cells) {
+
+	begin_bake(p_subdiv, p_bounds);
+
+	uint32_t cell_count = p_octree_cells.size() / 32;
+	ERR_FAIL_COND(cell_count == 0);
+	ERR_FAIL_COND(p_data_cells.size() != (int)cell_count * 16);
+
+	//restore the cells from the exported octree, already fixed up (leaves have an alpha of 1, so fixing them up again keeps them)
+	bake_cells.resize(cell_count);
+	{
+		const uint32_t *children_cells = (const uint32_t *)p_octree_cells.ptr();
+		const uint32_t *dataptr = (const uint32_t *)p_data_cells.ptr();
+		Cell *cells = bake_cells.ptrw();
+
+		for (uint32_t i = 0; i < cell_count; i++) {
+
+			for (uint32_t j = 0; j < 8; j++) {
+				cells[i].children[j] = children_cells[i * 8 + j];
+			}
+
+			uint32_t position = dataptr[i * 4 + 0];
+			cells[i].x = position & 0x7FF;
+			cells[i].y = (position >> 11) & 0x3FF;
+			cells[i].z = position >> 21;
+
+			uint32_t rgba = dataptr[i * 4 + 1];
+			cells[i].albedo[0] = (rgba & 0xFF) / 255.0;
+			cells[i].albedo[1] = ((rgba >> 8) & 0xFF) / 255.0;
+			cells[i].albedo[2] = ((rgba >> 16) & 0xFF) / 255.0;
+			cells[i].alpha = (rgba >> 24) / 255.0;
+
+			Color emission = Color::from_rgbe9995(dataptr[i * 4 + 2]);
+			cells[i].emission[0] = emission.r;
+			cells[i].emission[1] = emission.g;
+			cells[i].emission[2] = emission.b;
+
+			uint32_t normal = dataptr[i * 4 + 3];
+			cells[i].normal[0] = int8_t(normal & 0xFF) / 127.0;
+			cells[i].normal[1] = int8_t((normal >> 8) & 0xFF) / 127.0;
+			cells[i].normal[2] = int8_t((normal >> 16) & 0xFF) / 127.0;
+		}
+
+		//cells are sorted by level, so parents always come first
+		cells[0].level = 0;
+		for (uint32_t i = 0; i < cell_count; i++) {
+			for (uint32_t j = 0; j < 8; j++) {
+				uint32_t child = cells[i].children[j];
+				if (child != CHILD_EMPTY) {
+					ERR_FAIL_COND(child <= i || child >= cell_count);
+					cells[child].level = cells[i].level + 1;
+				}
+			}
+		}
+	}
+
+	AABB region = to_cell_space.xform(p_region);
+	Vector3 region_end = region.position + region.size;
+
+	for (int i = 0; i < 3; i++) {
+		region_from[i] = CLAMP(int(Math::floor(region.position[i])), 0, axis_cell_size[i]);
+		region_to[i] = CLAMP(int(Math::ceil(region_end[i])), region_from[i], axis_cell_size[i]);
+	}
+
+	plot_bounds = to_cell_space.affine_inverse().xform(AABB(Vector3(region_from.x, region_from.y, region_from.z), Vector3(region_to.x - region_from.x, region_to.y - region_from.y, region_to.z - region_from.z)));
+	plot_bounds = plot_bounds.intersection(original_bounds);
+
+	_prune_region(0, 0, 0, 0, 0);
+	updating_region = true;
 }
 
 void Voxelizer::end_bake() {
+	if (updating_region) {
+		_compact();
+	}
 	if (!sorted) {
 		_sort();
 	}
@@ -1092,9 +1270,135 @@ Vector<uint8_t> Voxelizer::get_sdf_3d_image() const {
 		}
 	}
 
+	memdelete_arr(work_memory);
+
 	return image3d;
 }
 
+static uint32_t _get_box_distance(int p_x, int p_y, int p_z, const Vector3i &p_from, const Vector3i &p_to) {
+
+	int dx = MAX(MAX(p_from.x - p_x, p_x - (p_to.x - 1)), 0);
+	int dy = MAX(MAX(p_from.y - p_y, p_y - (p_to.y - 1)), 0);
+	int dz = MAX(MAX(p_from.z - p_z, p_z - (p_to.z - 1)), 0);
+
+	return uint32_t(Math::sqrt(float(dx * dx + dy * dy + dz * dz)));
+}
+
+void Voxelizer::update_sdf_3d_image(Vector<uint8_t> &r_image) const {
+
+	//only the distances affected by the updated region change, everything else is kept from the previous field
+
+	Vector3i octree_size = get_giprobe_octree_size();
+	uint32_t float_count = octree_size.x * octree_size.y * octree_size.z;
+
+	if (!updating_region || r_image.size() != (int)float_count) {
+		r_image = get_sdf_3d_image();
+		return;
+	}
+
+	//cells around the region are recomputed exactly, from a window large enough to contain
+	//every solid cell that is closer than the margin to them
+	Vector3i near_from;
+	Vector3i near_to;
+	Vector3i window_from;
+	Vector3i window_to;
+
+	for (int i = 0; i < 3; i++) {
+		near_from[i] = MAX(region_from[i] - SDF_UPDATE_MARGIN, 0);
+		near_to[i] = MIN(region_to[i] + SDF_UPDATE_MARGIN, octree_size[i]);
+		window_from[i] = MAX(near_from[i] - SDF_UPDATE_MARGIN, 0);
+		window_to[i] = MIN(near_to[i] + SDF_UPDATE_MARGIN, octree_size[i]);
+	}
+
+	Vector3i window_size = window_to - window_from;
+	uint32_t window_count = window_size.x * window_size.y * window_size.z;
+	if (window_count == 0) {
+		return;
+	}
+
+	float *work_memory = memnew_arr(float, window_count);
+	for (uint32_t i = 0; i < window_count; i++) {
+		work_memory[i] = INF;
+	}
+
+	uint32_t y_mult = window_size.x;
+	uint32_t z_mult = y_mult * window_size.y;
+
+	//plot solid cells, same as a full bake
+	{
+		const Cell *cells = bake_cells.ptr();
+		uint32_t cell_count = bake_cells.size();
+
+		for (uint32_t i = 0; i < cell_count; i++) {
+
+			if (cells[i].level < (cell_subdiv - 1)) {
+				continue; //do not care about this level
+			}
+
+			int x = int(cells[i].x) - window_from.x;
+			int y = int(cells[i].y) - window_from.y;
+			int z = int(cells[i].z) - window_from.z;
+
+			if (x < 0 || x >= window_size.x || y < 0 || y >= window_size.y || z < 0 || z >= window_size.z) {
+				continue;
+			}
+
+			work_memory[x + y * y_mult + z * z_mult] = 0;
+		}
+	}
+
+	for (int i = 0; i < window_size.x; i++) {
+		for (int j = 0; j < window_size.y; j++) {
+			edt(&work_memory[i + j * y_mult], z_mult, window_size.z);
+		}
+	}
+
+	for (int i = 0; i < window_size.x; i++) {
+		for (int j = 0; j < window_size.z; j++) {
+			edt(&work_memory[i + j * z_mult], y_mult, window_size.y);
+		}
+	}
+
+	for (int i = 0; i < window_size.y; i++) {
+		for (int j = 0; j < window_size.z; j++) {
+			edt(&work_memory[i * y_mult + j * z_mult], 1, window_size.x);
+		}
+	}
+
+	//the level above the leaves is plotted at its own coordinates, so new solid cells can also show up there
+	Vector3i parent_from = region_from / 2;
+	Vector3i parent_to = (region_to + Vector3i(1, 1, 1)) / 2;
+
+	uint8_t *w = r_image.ptrw();
+	uint32_t image_y_mult = octree_size.x;
+	uint32_t image_z_mult = image_y_mult * octree_size.y;
+
+	for (int z = 0; z < octree_size.z; z++) {
+		for (int y = 0; y < octree_size.y; y++) {
+			for (int x = 0; x < octree_size.x; x++) {
+
+				uint8_t &value = w[x + y * image_y_mult + z * image_z_mult];
+
+				if (x >= near_from.x && x < near_to.x && y >= near_from.y && y < near_to.y && z >= near_from.z && z < near_to.z) {
+					float dist = work_memory[(x - window_from.x) + (y - window_from.y) * y_mult + (z - window_from.z) * z_mult];
+					//anything farther than the margin may be closer to a cell outside the window
+					uint32_t d = uint32_t(Math::sqrt(MIN(dist, float(SDF_UPDATE_MARGIN * SDF_UPDATE_MARGIN))));
+					value = d == 0 ? 0 : MIN(d, 254) + 1;
+				} else if (value != 0) {
+					//far from the region, new geometry can only make the distance shorter
+					uint32_t d = MIN(_get_box_distance(x, y, z, region_from, region_to), _get_box_distance(x, y, z, parent_from, parent_to));
+					d = MAX(d, 1);
+					if (d + 1 < value) {
+						value = MIN(d, 254) + 1;
+					}
+				}
+			}
+		}
+	}
+
+	memdelete_arr(work_memory);
+}
+
 #undef INF
 
 void Voxelizer::_debug_mesh(int p_idx, int p_level, const AABB &p_aabb, Ref<MultiMesh> &p_multimesh, int &idx) {
@@ -1219,6 +1523,7 @@ Transform Voxelizer::get_to_cell_space_xform() const {
 }
 Voxelizer::Voxelizer() {
 	sorted = false;
+	updating_region = false;
 	color_scan_cell_width = 4;
 	bake_texture_size = 128;
 }
@@ -42,6 +42,10 @@ private:
 
 	};
 
+	enum {
+		SDF_UPDATE_MARGIN = 16 //cells around an updated region where the distance field is recomputed exactly
+	};
+
 	struct Cell {
 
 		uint32_t children[8];
@@ -102,8 +106,14 @@ private:
 	Map<Ref<Material>, MaterialCache> material_cache;
 	AABB original_bounds;
 	AABB po2_bounds;
+	AABB plot_bounds;
 	int axis_cell_size[3];
 
+	//plotting only happens inside these cells (in leaf units), the rest of the octree is kept when updating a region
+	Vector3i region_from;
+	Vector3i region_to;
+	bool updating_region;
+
 	Transform to_cell_space;
 
 	int color_scan_cell_width;
@@ -118,6 +128,8 @@ private:
 
 	void _plot_face(int p_idx, int p_level, int p_x, int p_y, int p_z, const Vector3 *p_vtx, const Vector3 *p_normal, const Vector2 *p_uv, const MaterialCache &p_material, const AABB &p_aabb);
 	void _fixup_plot(int p_idx, int p_level);
+	bool _prune_region(int p_idx, int p_level, int p_x, int p_y, int p_z);
+	void _compact();
 	void _debug_mesh(int p_idx, int p_level, const AABB &p_aabb, Ref<MultiMesh> &p_multimesh, int &idx);
 
 	bool sorted;
@@ -128,6 +140,8 @@ public:
 	void plot_mesh(const Transform &p_xform, Ref<Mesh> &p_mesh, const Vector<Ref<Material>> &p_materials, const Ref<Material> &p_override_material);
 	void end_bake();
 
+	void begin_bake_update(int p_subdiv, const AABB &p_bounds, const AABB &p_region, const Vector<uint8_t> &p_octree_cells, const Vector<uint8_t> &p_data_cells);
+
 	int get_gi_probe_octree_depth() const;
 	Vector3i get_giprobe_octree_size() const;
 	int get_giprobe_cell_count() const;
@@ -135,6 +149,7 @@ public:
 	Vector<uint8_t> get_giprobe_data_cells() const;
 	Vector<int> get_giprobe_level_cell_count() const;
 	Vector<uint8_t> get_sdf_3d_image() const;
+	void update_sdf_3d_image(Vector<uint8_t> &r_image) const;
 
 	Ref<MultiMesh> create_debug_multimesh();
 
@@ -32,6 +32,7 @@
 
 #include "core/engine.h"
 #include "core/message_queue.h"
+#include "core/thread_work_pool.h"
 #include "scene/scene_string_names.h"
 #include "servers/audio/audio_stream.h"
 
@@ -210,16 +211,24 @@ void AnimationPlayer::_notification(int p_what) {
 			if (animation_process_mode == ANIMATION_PROCESS_PHYSICS)
 				break;
 
-			if (processing)
-				_animation_process(get_process_delta_time());
+			if (processing && _is_update_frame(Engine::get_singleton()->get_idle_frames())) {
+				_animation_process(get_process_delta_time() + update_skipped_time);
+				update_skipped_time = 0;
+			} else if (processing) {
+				update_skipped_time += get_process_delta_time();
+			}
 		} break;
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
 
 			if (animation_process_mode == ANIMATION_PROCESS_IDLE)
 				break;
 
-			if (processing)
-				_animation_process(get_physics_process_delta_time());
+			if (processing && _is_update_frame(Engine::get_singleton()->get_physics_frames())) {
+				_animation_process(get_physics_process_delta_time() + update_skipped_time);
+				update_skipped_time = 0;
+			} else if (processing) {
+				update_skipped_time += get_physics_process_delta_time();
+			}
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
 
@@ -231,7 +240,7 @@ void AnimationPlayer::_notification(int p_what) {
 void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 
 	// Already cached?
-	if (p_anim->node_cache.size() == p_anim->animation->get_track_count())
+	if (p_anim->bindings.size() == p_anim->animation->get_track_count())
 		return;
 
 	Node *parent = get_node(root);
@@ -240,11 +249,12 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 
 	Animation *a = p_anim->animation.operator->();
 
-	p_anim->node_cache.resize(a->get_track_count());
+	p_anim->bindings.resize(a->get_track_count());
 
 	for (int i = 0; i < a->get_track_count(); i++) {
 
-		p_anim->node_cache.write[i] = NULL;
+		TrackBinding &binding = p_anim->bindings.write[i];
+		binding = TrackBinding();
 		RES resource;
 		Vector<StringName> leftover_path;
 		Node *child = parent->get_node_and_resource(a->track_get_path(i), resource, leftover_path);
@@ -274,46 +284,47 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 		if (!node_cache_map.has(key))
 			node_cache_map[key] = TrackNodeCache();
 
-		p_anim->node_cache.write[i] = &node_cache_map[key];
-		p_anim->node_cache[i]->path = a->track_get_path(i);
-		p_anim->node_cache[i]->node = child;
-		p_anim->node_cache[i]->resource = resource;
-		p_anim->node_cache[i]->node_2d = Object::cast_to<Node2D>(child);
+		TrackNodeCache *nc = &node_cache_map[key];
+		binding.node_cache = nc;
+		nc->path = a->track_get_path(i);
+		nc->node = child;
+		nc->resource = resource;
+		nc->node_2d = Object::cast_to<Node2D>(child);
 		if (a->track_get_type(i) == Animation::TYPE_TRANSFORM) {
 			// special cases and caches for transform tracks
 
 			// cache spatial
-			p_anim->node_cache[i]->spatial = Object::cast_to<Node3D>(child);
+			nc->spatial = Object::cast_to<Node3D>(child);
 			// cache skeleton
-			p_anim->node_cache[i]->skeleton = Object::cast_to<Skeleton3D>(child);
-			if (p_anim->node_cache[i]->skeleton) {
+			nc->skeleton = Object::cast_to<Skeleton3D>(child);
+			if (nc->skeleton) {
 				if (a->track_get_path(i).get_subname_count() == 1) {
 					StringName bone_name = a->track_get_path(i).get_subname(0);
 
-					p_anim->node_cache[i]->bone_idx = p_anim->node_cache[i]->skeleton->find_bone(bone_name);
-					if (p_anim->node_cache[i]->bone_idx < 0) {
+					nc->bone_idx = nc->skeleton->find_bone(bone_name);
+					if (nc->bone_idx < 0) {
 						// broken track (nonexistent bone)
-						p_anim->node_cache[i]->skeleton = NULL;
-						p_anim->node_cache[i]->spatial = NULL;
-						ERR_CONTINUE(p_anim->node_cache[i]->bone_idx < 0);
+						nc->skeleton = NULL;
+						nc->spatial = NULL;
+						ERR_CONTINUE(nc->bone_idx < 0);
 					}
 				} else {
 					// no property, just use spatialnode
-					p_anim->node_cache[i]->skeleton = NULL;
+					nc->skeleton = NULL;
 				}
 			}
 		}
 
 		if (a->track_get_type(i) == Animation::TYPE_VALUE) {
 
-			if (!p_anim->node_cache[i]->property_anim.has(a->track_get_path(i).get_concatenated_subnames())) {
+			if (!nc->property_anim.has(a->track_get_path(i).get_concatenated_subnames())) {
 
 				TrackNodeCache::PropertyAnim pa;
 				pa.subpath = leftover_path;
 				pa.object = resource.is_valid() ? (Object *)resource.ptr() : (Object *)child;
 				pa.special = SP_NONE;
-				pa.owner = p_anim->node_cache[i];
-				if (false && p_anim->node_cache[i]->node_2d) {
+				pa.owner = nc;
+				if (false && nc->node_2d) {
 
 					if (leftover_path.size() == 1 && leftover_path[0] == SceneStringNames::get_singleton()->transform_pos)
 						pa.special = SP_NODE2D_POS;
@@ -322,21 +333,25 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 					else if (leftover_path.size() == 1 && leftover_path[0] == SceneStringNames::get_singleton()->transform_scale)
 						pa.special = SP_NODE2D_SCALE;
 				}
-				p_anim->node_cache[i]->property_anim[a->track_get_path(i).get_concatenated_subnames()] = pa;
+				nc->property_anim[a->track_get_path(i).get_concatenated_subnames()] = pa;
 			}
+
+			binding.property_anim = &nc->property_anim[a->track_get_path(i).get_concatenated_subnames()];
 		}
 
 		if (a->track_get_type(i) == Animation::TYPE_BEZIER && leftover_path.size()) {
 
-			if (!p_anim->node_cache[i]->bezier_anim.has(a->track_get_path(i).get_concatenated_subnames())) {
+			if (!nc->bezier_anim.has(a->track_get_path(i).get_concatenated_subnames())) {
 
 				TrackNodeCache::BezierAnim ba;
 				ba.bezier_property = leftover_path;
 				ba.object = resource.is_valid() ? (Object *)resource.ptr() : (Object *)child;
-				ba.owner = p_anim->node_cache[i];
+				ba.owner = nc;
 
-				p_anim->node_cache[i]->bezier_anim[a->track_get_path(i).get_concatenated_subnames()] = ba;
+				nc->bezier_anim[a->track_get_path(i).get_concatenated_subnames()] = ba;
 			}
+
+			binding.bezier_anim = &nc->bezier_anim[a->track_get_path(i).get_concatenated_subnames()];
 		}
 	}
 }
@@ -344,20 +359,52 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim) {
 void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float p_time, float p_delta, float p_interp, bool p_is_current, bool p_seeked, bool p_started) {
 
 	_ensure_node_caches(p_anim);
-	ERR_FAIL_COND(p_anim->node_cache.size() != p_anim->animation->get_track_count());
+	ERR_FAIL_COND(p_anim->bindings.size() != p_anim->animation->get_track_count());
 
 	Animation *a = p_anim->animation.operator->();
 	bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
 
+	// Interpolate the transform tracks ahead into the pose buffer, in parallel when there are enough of them.
+	// Accumulating and applying the results stays serial, as tracks may share a node cache.
+	{
+		TrackBinding *bindings = p_anim->bindings.ptrw();
+		p_anim->pose_tracks.clear();
+
+		for (int i = 0; i < p_anim->bindings.size(); i++) {
+			bindings[i].pose = -1;
+			if (bindings[i].node_cache && bindings[i].node_cache->spatial && a->track_get_type(i) == Animation::TYPE_TRANSFORM && a->track_is_enabled(i) && a->track_get_key_count(i) > 0) {
+				bindings[i].pose = p_anim->pose_tracks.size();
+				p_anim->pose_tracks.push_back(i);
+			}
+		}
+
+		p_anim->poses.resize(p_anim->pose_tracks.size());
+
+		PoseJob job;
+		job.anim = p_anim;
+		job.bindings = bindings;
+		job.time = p_time;
+
+		ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+		if (pool && pool->get_thread_count() > 0 && p_anim->pose_tracks.size() >= POSE_PARALLEL_MIN) {
+			pool->do_work(p_anim->pose_tracks.size(), this, &AnimationPlayer::_interpolate_pose, job);
+		} else {
+			for (uint32_t i = 0; i < p_anim->pose_tracks.size(); i++) {
+				_interpolate_pose(i, job);
+			}
+		}
+	}
+
 	for (int i = 0; i < a->get_track_count(); i++) {
 
 		// If an animation changes this animation (or it animates itself)
 		// we need to recreate our animation cache
-		if (p_anim->node_cache.size() != a->get_track_count()) {
+		if (p_anim->bindings.size() != a->get_track_count()) {
 			_ensure_node_caches(p_anim);
 		}
 
-		TrackNodeCache *nc = p_anim->node_cache[i];
+		TrackBinding *binding = &p_anim->bindings.write[i];
+		TrackNodeCache *nc = binding->node_cache;
 
 		if (!nc)
 			continue; // no node cache for this track, skip it
@@ -379,11 +426,20 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 				Quat rot;
 				Vector3 scale;
 
-				Error err = a->transform_track_interpolate(i, p_time, &loc, &rot, &scale);
-				//ERR_CONTINUE(err!=OK); //used for testing, should be removed
+				if (binding->pose >= 0 && binding->pose < (int)p_anim->poses.size() && p_anim->pose_tracks[binding->pose] == i) {
+					const TrackPose &pose = p_anim->poses[binding->pose];
+					if (!pose.valid)
+						continue;
+					loc = pose.loc;
+					rot = pose.rot;
+					scale = pose.scale;
+				} else {
+					Error err = a->transform_track_interpolate(i, p_time, &loc, &rot, &scale, &binding->key_cursor);
+					//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 
-				if (err != OK)
-					continue;
+					if (err != OK)
+						continue;
+				}
 
 				if (nc->accum_pass != accum_pass) {
 					ERR_CONTINUE(cache_update_size >= NODE_CACHE_UPDATE_MAX);
@@ -408,10 +464,8 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 
 				//StringName property=a->track_get_path(i).get_property();
 
-				Map<StringName, TrackNodeCache::PropertyAnim>::Element *E = nc->property_anim.find(a->track_get_path(i).get_concatenated_subnames());
-				ERR_CONTINUE(!E); //should it continue, or create a new one?
-
-				TrackNodeCache::PropertyAnim *pa = &E->get();
+				TrackNodeCache::PropertyAnim *pa = binding->property_anim;
+				ERR_CONTINUE(!pa); //should it continue, or create a new one?
 
 				Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
 
@@ -459,7 +513,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 
 				if (update_mode == Animation::UPDATE_CONTINUOUS || update_mode == Animation::UPDATE_CAPTURE || (p_delta == 0 && update_mode == Animation::UPDATE_DISCRETE)) { //delta == 0 means seek
 
-					Variant value = a->value_track_interpolate(i, p_time);
+					Variant value = a->value_track_interpolate(i, p_time, &binding->key_cursor);
 
 					if (value == Variant())
 						continue;
@@ -585,10 +639,8 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 				if (!nc->node)
 					continue;
 
-				Map<StringName, TrackNodeCache::BezierAnim>::Element *E = nc->bezier_anim.find(a->track_get_path(i).get_concatenated_subnames());
-				ERR_CONTINUE(!E); //should it continue, or create a new one?
-
-				TrackNodeCache::BezierAnim *ba = &E->get();
+				TrackNodeCache::BezierAnim *ba = binding->bezier_anim;
+				ERR_CONTINUE(!ba); //should it continue, or create a new one?
 
 				float bezier = a->bezier_track_interpolate(i, p_time);
 				if (ba->accum_pass != accum_pass) {
@@ -768,6 +820,15 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, float
 	}
 }
 
+void AnimationPlayer::_interpolate_pose(uint32_t p_index, PoseJob p_job) {
+
+	int track = p_job.anim->pose_tracks[p_index];
+	TrackPose &pose = p_job.anim->poses[p_index];
+
+	Error err = p_job.anim->animation->transform_track_interpolate(track, p_job.time, &pose.loc, &pose.rot, &pose.scale, &p_job.bindings[track].key_cursor);
+	pose.valid = err == OK;
+}
+
 void AnimationPlayer::_animation_process_data(PlaybackData &cd, float p_delta, float p_blend, bool p_seeked, bool p_started) {
 
 	float delta = p_delta * speed_scale * cd.speed_scale;
@@ -1412,7 +1473,7 @@ void AnimationPlayer::clear_caches() {
 
 	for (Map<StringName, AnimationData>::Element *E = animation_set.front(); E; E = E->next()) {
 
-		E->get().node_cache.clear();
+		E->get().bindings.clear();
 	}
 
 	cache_update_size = 0;
@@ -1475,6 +1536,25 @@ AnimationPlayer::AnimationProcessMode AnimationPlayer::get_animation_process_mod
 	return animation_process_mode;
 }
 
+void AnimationPlayer::set_update_interval(int p_frames) {
+
+	ERR_FAIL_COND(p_frames < 1);
+	update_interval = p_frames;
+}
+
+int AnimationPlayer::get_update_interval() const {
+
+	return update_interval;
+}
+
+bool AnimationPlayer::_is_update_frame(uint64_t p_frame) const {
+
+	if (update_interval <= 1)
+		return true;
+	// offset by the instance so players sharing an interval don't all update on the same frame
+	return (p_frame + uint64_t(get_instance_id())) % update_interval == 0;
+}
+
 void AnimationPlayer::set_method_call_mode(AnimationMethodCallMode p_mode) {
 
 	method_call_mode = p_mode;
@@ -1498,6 +1578,7 @@ void AnimationPlayer::_set_process(bool p_process, bool p_force) {
 	}
 
 	processing = p_process;
+	update_skipped_time = 0;
 }
 
 void AnimationPlayer::animation_set_next(const StringName &p_animation, const StringName &p_next) {
@@ -1564,8 +1645,8 @@ AnimatedValuesBackup AnimationPlayer::backup_animated_values() {
 
 	AnimatedValuesBackup backup;
 
-	for (int i = 0; i < playback.current.from->node_cache.size(); i++) {
-		TrackNodeCache *nc = playback.current.from->node_cache[i];
+	for (int i = 0; i < playback.current.from->bindings.size(); i++) {
+		TrackNodeCache *nc = playback.current.from->bindings[i].node_cache;
 		if (!nc)
 			continue;
 
@@ -1653,6 +1734,9 @@ void AnimationPlayer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("set_speed_scale", "speed"), &AnimationPlayer::set_speed_scale);
 	ClassDB::bind_method(D_METHOD("get_speed_scale"), &AnimationPlayer::get_speed_scale);
+
+	ClassDB::bind_method(D_METHOD("set_update_interval", "frames"), &AnimationPlayer::set_update_interval);
+	ClassDB::bind_method(D_METHOD("get_update_interval"), &AnimationPlayer::get_update_interval);
 	ClassDB::bind_method(D_METHOD("get_playing_speed"), &AnimationPlayer::get_playing_speed);
 
 	ClassDB::bind_method(D_METHOD("set_autoplay", "name"), &AnimationPlayer::set_autoplay);
@@ -1689,6 +1773,7 @@ void AnimationPlayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "playback_default_blend_time", PROPERTY_HINT_RANGE, "0,4096,0.01"), "set_default_blend_time", "get_default_blend_time");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "playback_active", PROPERTY_HINT_NONE, "", 0), "set_active", "is_active");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "playback_speed", PROPERTY_HINT_RANGE, "-64,64,0.01"), "set_speed_scale", "get_speed_scale");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "playback_update_interval", PROPERTY_HINT_RANGE, "1,60,1"), "set_update_interval", "get_update_interval");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "method_call_mode", PROPERTY_HINT_ENUM, "Deferred,Immediate"), "set_method_call_mode", "get_method_call_mode");
 
 	ADD_SIGNAL(MethodInfo("animation_finished", PropertyInfo(Variant::STRING_NAME, "anim_name")));
@@ -1711,6 +1796,8 @@ AnimationPlayer::AnimationPlayer() {
 	cache_update_prop_size = 0;
 	cache_update_bezier_size = 0;
 	speed_scale = 1;
+	update_interval = 1;
+	update_skipped_time = 0;
 	end_reached = false;
 	end_notify = false;
 	animation_process_mode = ANIMATION_PROCESS_IDLE;
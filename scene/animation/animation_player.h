@@ -31,6 +31,7 @@
 #ifndef ANIMATION_PLAYER_H
 #define ANIMATION_PLAYER_H
 
+#include "core/local_vector.h"
 #include "scene/2d/node_2d.h"
 #include "scene/3d/node_3d.h"
 #include "scene/3d/skeleton_3d.h"
@@ -74,7 +75,8 @@ private:
 	enum {
 
 		NODE_CACHE_UPDATE_MAX = 1024,
-		BLEND_FROM_MAX = 3
+		BLEND_FROM_MAX = 3,
+		POSE_PARALLEL_MIN = 32
 	};
 
 	enum SpecialProperty {
@@ -185,13 +187,50 @@ private:
 	float speed_scale;
 	float default_blend_time;
 
+	int update_interval;
+	float update_skipped_time;
+	bool _is_update_frame(uint64_t p_frame) const;
+
+	// What each track of an animation writes to, resolved once by _ensure_node_caches()
+	struct TrackBinding {
+
+		TrackNodeCache *node_cache;
+		TrackNodeCache::PropertyAnim *property_anim;
+		TrackNodeCache::BezierAnim *bezier_anim;
+		int key_cursor; // last key found, lookups start from it
+		int pose; // index in AnimationData::poses, -1 if not interpolated ahead
+
+		TrackBinding() :
+				node_cache(NULL),
+				property_anim(NULL),
+				bezier_anim(NULL),
+				key_cursor(-1),
+				pose(-1) {}
+	};
+
+	struct TrackPose {
+
+		Vector3 loc;
+		Quat rot;
+		Vector3 scale;
+		bool valid;
+	};
+
 	struct AnimationData {
 		String name;
 		StringName next;
-		Vector<TrackNodeCache *> node_cache;
+		Vector<TrackBinding> bindings;
+		LocalVector<int> pose_tracks;
+		LocalVector<TrackPose> poses;
 		Ref<Animation> animation;
 	};
 
+	struct PoseJob {
+		AnimationData *anim;
+		TrackBinding *bindings;
+		float time;
+	};
+
 	Map<StringName, AnimationData> animation_set;
 	struct BlendKey {
 
@@ -255,6 +294,7 @@ private:
 	void _animation_process_animation(AnimationData *p_anim, float p_time, float p_delta, float p_interp, bool p_is_current = true, bool p_seeked = false, bool p_started = false);
 
 	void _ensure_node_caches(AnimationData *p_anim);
+	void _interpolate_pose(uint32_t p_index, PoseJob p_job);
 	void _animation_process_data(PlaybackData &cd, float p_delta, float p_blend, bool p_seeked, bool p_started);
 	void _animation_process2(float p_delta, bool p_started);
 	void _animation_update_transforms();
@@ -331,6 +371,9 @@ public:
 
 	void set_speed_scale(float p_speed);
 	float get_speed_scale() const;
+
+	void set_update_interval(int p_frames);
+	int get_update_interval() const;
 	float get_playing_speed() const;
 
 	void set_autoplay(const String &p_name);
@@ -33,6 +33,8 @@
 #include "animation_blend_tree.h"
 #include "core/engine.h"
 #include "core/method_bind_ext.gen.inc"
+#include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 #include "scene/scene_string_names.h"
 #include "servers/audio/audio_stream.h"
 
@@ -488,6 +490,7 @@ void AnimationTree::set_active(bool p_active) {
 
 	active = p_active;
 	started = active;
+	update_skipped_time = 0;
 
 	if (process_mode == ANIMATION_PROCESS_IDLE) {
 		set_process_internal(active);
@@ -534,6 +537,16 @@ AnimationTree::AnimationProcessMode AnimationTree::get_process_mode() const {
 	return process_mode;
 }
 
+void AnimationTree::set_update_interval(int p_frames) {
+
+	ERR_FAIL_COND(p_frames < 1);
+	update_interval = p_frames;
+}
+
+int AnimationTree::get_update_interval() const {
+	return update_interval;
+}
+
 void AnimationTree::_node_removed(Node *p_node) {
 	cache_valid = false;
 }
@@ -726,6 +739,7 @@ bool AnimationTree::_update_caches(AnimationPlayer *player) {
 
 	state.track_count = idx;
 
+	animation_bindings.clear();
 	cache_valid = true;
 
 	return true;
@@ -740,10 +754,11 @@ void AnimationTree::_clear_caches() {
 	playing_caches.clear();
 
 	track_cache.clear();
+	animation_bindings.clear();
 	cache_valid = false;
 }
 
-void AnimationTree::_process_graph(float p_delta) {
+bool AnimationTree::_prepare_graph() {
 
 	_update_properties(); //if properties need updating, update them
 
@@ -755,14 +770,14 @@ void AnimationTree::_process_graph(float p_delta) {
 		ERR_PRINT("AnimationTree: root AnimationNode is not set, disabling playback.");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	if (!has_node(animation_player)) {
 		ERR_PRINT("AnimationTree: no valid AnimationPlayer path set, disabling playback");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(get_node(animation_player));
@@ -793,15 +808,22 @@ void AnimationTree::_process_graph(float p_delta) {
 		ERR_PRINT("AnimationTree: path points to a node not an AnimationPlayer, disabling playback");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	if (!cache_valid) {
 		if (!_update_caches(player)) {
-			return;
+			return false;
 		}
 	}
 
+	state.player = player;
+
+	return true;
+}
+
+bool AnimationTree::_evaluate_graph(float p_delta) {
+
 	{ //setup
 
 		process_pass++;
@@ -810,7 +832,6 @@ void AnimationTree::_process_graph(float p_delta) {
 		state.invalid_reasons = "";
 		state.animation_states.clear(); //will need to be re-created
 		state.valid = true;
-		state.player = player;
 		state.last_pass = process_pass;
 		state.tree = this;
 
@@ -837,8 +858,47 @@ void AnimationTree::_process_graph(float p_delta) {
 	}
 
 	if (!state.valid) {
-		return; //state is not valid. do nothing.
+		return false; //state is not valid. do nothing.
 	}
+
+	return true;
+}
+
+Vector<AnimationTree::TrackBinding> AnimationTree::_get_animation_bindings(const Ref<Animation> &p_animation) {
+
+	const Vector<TrackBinding> *existing = animation_bindings.getptr(p_animation->get_instance_id());
+	if (existing && existing->size() == p_animation->get_track_count()) {
+		return *existing;
+	}
+
+	Vector<TrackBinding> bindings;
+	bindings.resize(p_animation->get_track_count());
+	TrackBinding *bindingsw = bindings.ptrw();
+
+	for (int i = 0; i < bindings.size(); i++) {
+
+		NodePath path = p_animation->track_get_path(i);
+
+		bindingsw[i].cache = NULL;
+		bindingsw[i].blend_idx = -1;
+		bindingsw[i].root_motion = root_motion_track == path;
+
+		ERR_CONTINUE(!track_cache.has(path));
+		ERR_CONTINUE(!state.track_map.has(path));
+
+		int blend_idx = state.track_map[path];
+		ERR_CONTINUE(blend_idx < 0 || blend_idx >= state.track_count);
+
+		bindingsw[i].cache = track_cache[path];
+		bindingsw[i].blend_idx = blend_idx;
+	}
+
+	animation_bindings[p_animation->get_instance_id()] = bindings;
+	return bindings;
+}
+
+void AnimationTree::_process_tracks(TrackPass p_pass) {
+
 	//apply value/transform/bezier blends to track caches and execute method/audio/animation tracks
 
 	{
@@ -854,25 +914,34 @@ void AnimationTree::_process_graph(float p_delta) {
 			float delta = as.delta;
 			bool seeked = as.seeked;
 
-			for (int i = 0; i < a->get_track_count(); i++) {
+			Vector<TrackBinding> bindings = _get_animation_bindings(a);
+			const TrackBinding *bindings_ptr = bindings.ptr();
+			int track_count = MIN(a->get_track_count(), bindings.size());
 
-				NodePath path = a->track_get_path(i);
+			for (int i = 0; i < track_count; i++) {
 
-				ERR_CONTINUE(!track_cache.has(path));
-
-				TrackCache *track = track_cache[path];
+				TrackCache *track = bindings_ptr[i].cache;
+				if (!track) {
+					continue; //reported when the bindings were made
+				}
 				if (track->type != a->track_get_type(i)) {
 					continue; //may happen should not
 				}
 
-				track->root_motion = root_motion_track == path;
-
-				ERR_CONTINUE(!state.track_map.has(path));
-				int blend_idx = state.track_map[path];
+				if (p_pass != TRACK_PASS_ALL) {
+					bool event = track->type == Animation::TYPE_METHOD || track->type == Animation::TYPE_AUDIO || track->type == Animation::TYPE_ANIMATION;
+					if (track->type == Animation::TYPE_VALUE) {
+						Animation::UpdateMode update_mode = a->value_track_get_update_mode(i);
+						event = update_mode != Animation::UPDATE_CONTINUOUS && update_mode != Animation::UPDATE_CAPTURE;
+					}
+					if (event != (p_pass == TRACK_PASS_EVENTS)) {
+						continue;
+					}
+				}
 
-				ERR_CONTINUE(blend_idx < 0 || blend_idx >= state.track_count);
+				track->root_motion = bindings_ptr[i].root_motion;
 
-				float blend = (*as.track_blends)[blend_idx];
+				float blend = (*as.track_blends)[bindings_ptr[i].blend_idx];
 
 				if (blend < CMP_EPSILON)
 					continue; //nothing to blend
@@ -1221,6 +1290,9 @@ void AnimationTree::_process_graph(float p_delta) {
 			}
 		}
 	}
+}
+
+void AnimationTree::_apply_tracks() {
 
 	{
 		// finally, set the tracks
@@ -1279,6 +1351,213 @@ void AnimationTree::_process_graph(float p_delta) {
 	}
 }
 
+void AnimationTree::_evaluate_ahead(float p_delta, uint64_t p_frame) {
+
+	evaluation_batch.clear();
+
+	float frame_delta = process_mode == ANIMATION_PROCESS_PHYSICS ? get_physics_process_delta_time() : get_process_delta_time();
+
+	for (uint32_t i = 0; i < instances.size(); i++) {
+
+		AnimationTree *t = instances[i];
+		if (!t->active || t->process_mode != process_mode || t->get_tree() != get_tree() || !t->can_process()) {
+			continue;
+		}
+		if (t->evaluated && t->evaluated_frame == p_frame) {
+			continue;
+		}
+		if (t != this && !t->_is_update_frame(p_frame)) {
+			continue; // throttled, skips this frame
+		}
+
+		t->evaluated = true;
+		t->evaluated_frame = p_frame;
+		t->evaluation_valid = false;
+		// p_delta already includes the time this tree skipped, the others add theirs
+		t->evaluation_delta = t == this ? p_delta : frame_delta + t->update_skipped_time;
+
+		//properties and caches may be rebuilt here, which is not thread-safe
+		if (t->_prepare_graph()) {
+			if (t->graph_scripted) {
+				t->evaluated = false; //scripted nodes are called on the main thread, on its own turn
+			} else {
+				evaluation_batch.push_back(t);
+			}
+		}
+	}
+
+	uint32_t count = evaluation_batch.size();
+	if (count == 0) {
+		return;
+	}
+
+	// Trees that share graph nodes must be evaluated one after the other, as nodes keep the state
+	// of the tree being processed. Group them by the lowest index of the trees they share nodes with.
+
+	LocalVector<uint32_t> group;
+	group.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		group[i] = i;
+	}
+
+	HashMap<ObjectID, uint32_t> node_owner;
+
+	for (uint32_t i = 0; i < count; i++) {
+
+		const LocalVector<ObjectID> &nodes = evaluation_batch[i]->graph_nodes;
+		for (uint32_t j = 0; j < nodes.size(); j++) {
+
+			const uint32_t *owner = node_owner.getptr(nodes[j]);
+			if (!owner) {
+				node_owner[nodes[j]] = i;
+				continue;
+			}
+
+			uint32_t a = *owner;
+			while (group[a] != a) {
+				a = group[a];
+			}
+			uint32_t b = i;
+			while (group[b] != b) {
+				b = group[b];
+			}
+			if (a != b) {
+				group[MAX(a, b)] = MIN(a, b);
+			}
+		}
+	}
+
+	LocalVector<uint32_t> group_fill;
+	group_fill.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		while (group[group[i]] != group[i]) {
+			group[i] = group[group[i]];
+		}
+		group[i] = group[group[i]];
+		group_fill[i] = 0;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		group_fill[group[i]]++;
+	}
+
+	evaluation_jobs.clear();
+	evaluation_order.resize(count);
+
+	LocalVector<uint32_t> group_job;
+	group_job.resize(count);
+
+	uint32_t from = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		if (group[i] != i) {
+			continue;
+		}
+		EvaluationJob job;
+		job.from = from;
+		job.to = from;
+		from += group_fill[i];
+		group_job[i] = evaluation_jobs.size();
+		evaluation_jobs.push_back(job);
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		EvaluationJob &job = evaluation_jobs[group_job[group[i]]];
+		evaluation_order[job.to++] = i;
+	}
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0 && evaluation_jobs.size() > 1) {
+		pool->do_work(evaluation_jobs.size(), this, &AnimationTree::_evaluate_job, (const EvaluationJob *)evaluation_jobs.ptr());
+	} else {
+		for (uint32_t i = 0; i < evaluation_jobs.size(); i++) {
+			_evaluate_job(i, evaluation_jobs.ptr());
+		}
+	}
+}
+
+void AnimationTree::_evaluate_job(uint32_t p_index, const EvaluationJob *p_jobs) {
+
+	const EvaluationJob &job = p_jobs[p_index];
+
+	for (uint32_t i = job.from; i < job.to; i++) {
+
+		AnimationTree *t = evaluation_batch[evaluation_order[i]];
+
+		t->evaluation_valid = t->_evaluate_graph(t->evaluation_delta);
+		if (!t->evaluation_valid) {
+			continue;
+		}
+
+		// blends point into the graph nodes, which the next tree in this group reuses before the events run
+		t->state_blends.resize(t->state.animation_states.size());
+		uint32_t idx = 0;
+		for (List<AnimationNode::AnimationState>::Element *E = t->state.animation_states.front(); E; E = E->next()) {
+			t->state_blends[idx] = *E->get().track_blends;
+			E->get().track_blends = &t->state_blends[idx];
+			idx++;
+		}
+
+		t->_process_tracks(TRACK_PASS_BLEND);
+	}
+}
+
+void AnimationTree::_process_graph_batched(float p_delta, uint64_t p_frame) {
+
+	if (!parallel_evaluation || graph_scripted) {
+		_process_graph(p_delta);
+		return;
+	}
+
+	if (!evaluated || evaluated_frame != p_frame) {
+		_evaluate_ahead(p_delta, p_frame);
+	}
+
+	if (!evaluated || evaluated_frame != p_frame) {
+		_process_graph(p_delta); //could not be evaluated ahead
+		return;
+	}
+
+	evaluated = false;
+
+	if (evaluation_valid) {
+		_process_tracks(TRACK_PASS_EVENTS);
+		_apply_tracks();
+	}
+}
+
+void AnimationTree::_process_graph(float p_delta) {
+
+	if (!_prepare_graph()) {
+		return;
+	}
+
+	if (!_evaluate_graph(p_delta)) {
+		return;
+	}
+
+	_process_tracks(TRACK_PASS_ALL);
+	_apply_tracks();
+}
+
+bool AnimationTree::_is_update_frame(uint64_t p_frame) const {
+
+	if (update_interval <= 1)
+		return true;
+	// offset by the instance so trees sharing an interval don't all update on the same frame
+	return (p_frame + uint64_t(get_instance_id())) % update_interval == 0;
+}
+
+void AnimationTree::_process_frame(float p_delta, uint64_t p_frame) {
+
+	bool evaluated_ahead = evaluated && evaluated_frame == p_frame;
+	if (!evaluated_ahead && !_is_update_frame(p_frame)) {
+		update_skipped_time += p_delta;
+		return;
+	}
+
+	float delta = p_delta + update_skipped_time;
+	update_skipped_time = 0;
+	_process_graph_batched(delta, p_frame);
+}
+
 void AnimationTree::advance(float p_time) {
 
 	_process_graph(p_time);
@@ -1287,14 +1566,16 @@ void AnimationTree::advance(float p_time) {
 void AnimationTree::_notification(int p_what) {
 
 	if (active && p_what == NOTIFICATION_INTERNAL_PHYSICS_PROCESS && process_mode == ANIMATION_PROCESS_PHYSICS) {
-		_process_graph(get_physics_process_delta_time());
+		_process_frame(get_physics_process_delta_time(), Engine::get_singleton()->get_physics_frames());
 	}
 
 	if (active && p_what == NOTIFICATION_INTERNAL_PROCESS && process_mode == ANIMATION_PROCESS_IDLE) {
-		_process_graph(get_process_delta_time());
+		_process_frame(get_process_delta_time(), Engine::get_singleton()->get_idle_frames());
 	}
 
 	if (p_what == NOTIFICATION_EXIT_TREE) {
+		instances.erase(this);
+		evaluated = false;
 		_clear_caches();
 		if (last_animation_player.is_valid()) {
 
@@ -1304,6 +1585,7 @@ void AnimationTree::_notification(int p_what) {
 			}
 		}
 	} else if (p_what == NOTIFICATION_ENTER_TREE) {
+		instances.push_back(this);
 		if (last_animation_player.is_valid()) {
 
 			Object *player = ObjectDB::get_instance(last_animation_player);
@@ -1382,6 +1664,7 @@ String AnimationTree::get_configuration_warning() const {
 
 void AnimationTree::set_root_motion_track(const NodePath &p_track) {
 	root_motion_track = p_track;
+	animation_bindings.clear();
 }
 
 NodePath AnimationTree::get_root_motion_track() const {
@@ -1403,6 +1686,11 @@ void AnimationTree::_tree_changed() {
 
 void AnimationTree::_update_properties_for_node(const String &p_base_path, Ref<AnimationNode> node) {
 
+	graph_nodes.push_back(node->get_instance_id());
+	if (node->get_script_instance()) {
+		graph_scripted = true;
+	}
+
 	if (!property_parent_map.has(p_base_path)) {
 		property_parent_map[p_base_path] = HashMap<StringName, StringName>();
 	}
@@ -1454,6 +1742,8 @@ void AnimationTree::_update_properties() {
 	property_parent_map.clear();
 	input_activity_map.clear();
 	input_activity_map_get.clear();
+	graph_nodes.clear();
+	graph_scripted = false;
 
 	if (root.is_valid()) {
 		_update_properties_for_node(SceneStringNames::get_singleton()->parameters_base_path, root);
@@ -1545,6 +1835,9 @@ void AnimationTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_process_mode", "mode"), &AnimationTree::set_process_mode);
 	ClassDB::bind_method(D_METHOD("get_process_mode"), &AnimationTree::get_process_mode);
 
+	ClassDB::bind_method(D_METHOD("set_update_interval", "frames"), &AnimationTree::set_update_interval);
+	ClassDB::bind_method(D_METHOD("get_update_interval"), &AnimationTree::get_update_interval);
+
 	ClassDB::bind_method(D_METHOD("set_animation_player", "root"), &AnimationTree::set_animation_player);
 	ClassDB::bind_method(D_METHOD("get_animation_player"), &AnimationTree::get_animation_player);
 
@@ -1563,6 +1856,7 @@ void AnimationTree::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "anim_player", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "AnimationPlayer"), "set_animation_player", "get_animation_player");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "active"), "set_active", "is_active");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_mode", PROPERTY_HINT_ENUM, "Physics,Idle,Manual"), "set_process_mode", "get_process_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "update_interval", PROPERTY_HINT_RANGE, "1,60,1"), "set_update_interval", "get_update_interval");
 	ADD_GROUP("Root Motion", "root_motion_");
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_motion_track"), "set_root_motion_track", "get_root_motion_track");
 
@@ -1580,7 +1874,20 @@ AnimationTree::AnimationTree() {
 	process_pass = 1;
 	started = true;
 	properties_dirty = true;
+	graph_scripted = false;
+	parallel_evaluation = GLOBAL_DEF("animation/trees/parallel_evaluation", true);
+	evaluated = false;
+	evaluation_valid = false;
+	evaluated_frame = 0;
+	evaluation_delta = 0;
+	update_interval = 1;
+	update_skipped_time = 0;
 }
 
 AnimationTree::~AnimationTree() {
 }
+
+LocalVector<AnimationTree *> AnimationTree::instances;
+LocalVector<AnimationTree *> AnimationTree::evaluation_batch;
+LocalVector<uint32_t> AnimationTree::evaluation_order;
+LocalVector<AnimationTree::EvaluationJob> AnimationTree::evaluation_jobs;
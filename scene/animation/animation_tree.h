@@ -32,6 +32,7 @@
 #define ANIMATION_GRAPH_PLAYER_H
 
 #include "animation_player.h"
+#include "core/local_vector.h"
 #include "scene/3d/node_3d.h"
 #include "scene/3d/skeleton_3d.h"
 #include "scene/resources/animation.h"
@@ -257,6 +258,16 @@ private:
 	HashMap<NodePath, TrackCache *> track_cache;
 	Set<TrackCache *> playing_caches;
 
+	// What each track of an animation blends into, made once per animation instead of looking paths up every pass
+	struct TrackBinding {
+		TrackCache *cache;
+		int blend_idx;
+		bool root_motion;
+	};
+
+	HashMap<ObjectID, Vector<TrackBinding>> animation_bindings;
+	Vector<TrackBinding> _get_animation_bindings(const Ref<Animation> &p_animation);
+
 	Ref<AnimationNode> root;
 
 	AnimationProcessMode process_mode;
@@ -270,8 +281,50 @@ private:
 
 	void _clear_caches();
 	bool _update_caches(AnimationPlayer *player);
+
+	enum TrackPass {
+		TRACK_PASS_ALL,
+		TRACK_PASS_BLEND, // tracks that only accumulate into caches
+		TRACK_PASS_EVENTS, // tracks that call into other objects
+	};
+
+	bool _prepare_graph();
+	bool _evaluate_graph(float p_delta);
+	void _process_tracks(TrackPass p_pass);
+	void _apply_tracks();
 	void _process_graph(float p_delta);
 
+	// Trees processed in the same mode and frame are evaluated ahead, all at once on the work pool.
+	// Each tree still runs its event tracks and applies its results on its own turn.
+	struct EvaluationJob {
+		uint32_t from;
+		uint32_t to;
+	};
+
+	static LocalVector<AnimationTree *> instances;
+	static LocalVector<AnimationTree *> evaluation_batch;
+	static LocalVector<uint32_t> evaluation_order;
+	static LocalVector<EvaluationJob> evaluation_jobs;
+
+	LocalVector<ObjectID> graph_nodes;
+	bool graph_scripted;
+	LocalVector<Vector<float>> state_blends;
+	bool parallel_evaluation;
+	bool evaluated;
+	bool evaluation_valid;
+	uint64_t evaluated_frame;
+
+	float evaluation_delta;
+
+	void _evaluate_ahead(float p_delta, uint64_t p_frame);
+	void _evaluate_job(uint32_t p_index, const EvaluationJob *p_jobs);
+	void _process_graph_batched(float p_delta, uint64_t p_frame);
+
+	int update_interval;
+	float update_skipped_time;
+	bool _is_update_frame(uint64_t p_frame) const;
+	void _process_frame(float p_delta, uint64_t p_frame);
+
 	uint64_t setup_pass;
 	uint64_t process_pass;
 
@@ -318,6 +371,9 @@ public:
 	void set_process_mode(AnimationProcessMode p_mode);
 	AnimationProcessMode get_process_mode() const;
 
+	void set_update_interval(int p_frames);
+	int get_update_interval() const;
+
 	void set_animation_player(const NodePath &p_player);
 	NodePath get_animation_player() const;
 
@@ -31,6 +31,7 @@
 #include "audio_stream_player.h"
 
 #include "core/engine.h"
+#include "servers/audio/audio_mix.h"
 
 void AudioStreamPlayer::_mix_to_bus(const AudioFrame *p_frames, int p_amount) {
 
@@ -59,9 +60,7 @@ void AudioStreamPlayer::_mix_to_bus(const AudioFrame *p_frames, int p_amount) {
 	for (int c = 0; c < 4; c++) {
 		if (!targets[c])
 			break;
-		for (int i = 0; i < p_amount; i++) {
-			targets[c][i] += p_frames[i];
-		}
+		AudioMix::add(targets[c], p_frames, p_amount);
 	}
 }
 
@@ -81,12 +80,8 @@ void AudioStreamPlayer::_mix_internal(bool p_fadeout) {
 	//multiply volume interpolating to avoid clicks if this changes
 	float target_volume = p_fadeout ? -80.0 : volume_db;
 	float vol = Math::db2linear(mix_volume_db);
-	float vol_inc = (Math::db2linear(target_volume) - vol) / float(buffer_size);
-
-	for (int i = 0; i < buffer_size; i++) {
-		buffer[i] *= vol;
-		vol += vol_inc;
-	}
+	float vol_to = Math::db2linear(target_volume);
+	AudioMix::scale_ramp(buffer, buffer_size, AudioFrame(vol, vol), AudioFrame(vol_to, vol_to));
 
 	//set volume for next mix
 	mix_volume_db = target_volume;
@@ -189,12 +184,8 @@ void AudioStreamPlayer::set_stream(Ref<AudioStream> p_stream) {
 		//multiply volume interpolating to avoid clicks if this changes
 		float target_volume = -80.0;
 		float vol = Math::db2linear(mix_volume_db);
-		float vol_inc = (Math::db2linear(target_volume) - vol) / float(buffer_size);
-
-		for (int i = 0; i < buffer_size; i++) {
-			buffer[i] *= vol;
-			vol += vol_inc;
-		}
+		float vol_to = Math::db2linear(target_volume);
+		AudioMix::scale_ramp(buffer, buffer_size, AudioFrame(vol, vol), AudioFrame(vol_to, vol_to));
 
 		use_fadeout = true;
 	}
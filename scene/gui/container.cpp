@@ -83,14 +83,55 @@ void Container::remove_child_notify(Node *p_child) {
 	queue_sort();
 }
 
-void Container::_sort_children() {
+SelfList<Container>::List Container::pending_sort_list;
 
-	if (!is_inside_tree())
-		return;
+void Container::_flush_pending_sorts() {
+
+	//sort in tree order, so a container resized by its parent's sort is only sorted once, with its final size
+	while (pending_sort_list.first()) {
+
+		Vector<Node *> nodes;
+		for (SelfList<Container> *E = pending_sort_list.first(); E; E = E->next()) {
+			nodes.push_back(E->self());
+		}
+
+		nodes.sort_custom<Node::Comparator>();
+
+		//sorting may free other containers
+		Vector<ObjectID> ids;
+		ids.resize(nodes.size());
+		for (int i = 0; i < nodes.size(); i++) {
+			ids.write[i] = nodes[i]->get_instance_id();
+		}
+
+		for (int i = 0; i < ids.size(); i++) {
+
+			Container *container = Object::cast_to<Container>(ObjectDB::get_instance(ids[i]));
+			if (container && container->pending_sort_element.in_list()) {
+				container->_sort();
+			}
+		}
+	}
+}
+
+void Container::_sort() {
 
 	notification(NOTIFICATION_SORT_CHILDREN);
 	emit_signal(SceneStringNames::get_singleton()->sort_children);
 	pending_sort = false;
+
+	if (pending_sort_element.in_list()) {
+		pending_sort_list.remove(&pending_sort_element);
+	}
+}
+
+void Container::_sort_children() {
+
+	//every queued container pushes a call, the first one to come up sorts all of them
+	if (!pending_sort_element.in_list())
+		return;
+
+	_flush_pending_sorts();
 }
 
 void Container::fit_child_in_rect(Control *p_child, const Rect2 &p_rect) {
@@ -142,6 +183,7 @@ void Container::queue_sort() {
 
 	MessageQueue::get_singleton()->push_call(this, "_sort_children");
 	pending_sort = true;
+	pending_sort_list.add_last(&pending_sort_element);
 }
 
 void Container::_notification(int p_what) {
@@ -152,6 +194,13 @@ void Container::_notification(int p_what) {
 			pending_sort = false;
 			queue_sort();
 		} break;
+		case NOTIFICATION_EXIT_TREE: {
+
+			//only containers inside the tree can be put in tree order
+			if (pending_sort_element.in_list()) {
+				pending_sort_list.remove(&pending_sort_element);
+			}
+		} break;
 		case NOTIFICATION_RESIZED: {
 
 			queue_sort();
@@ -193,7 +242,8 @@ void Container::_bind_methods() {
 	ADD_SIGNAL(MethodInfo("sort_children"));
 }
 
-Container::Container() {
+Container::Container() :
+		pending_sort_element(this) {
 
 	pending_sort = false;
 	// All containers should let mouse events pass by default.
@@ -31,6 +31,7 @@
 #ifndef CONTAINER_H
 #define CONTAINER_H
 
+#include "core/self_list.h"
 #include "scene/gui/control.h"
 
 class Container : public Control {
@@ -38,6 +39,12 @@ class Container : public Control {
 	GDCLASS(Container, Control);
 
 	bool pending_sort;
+	SelfList<Container> pending_sort_element;
+
+	static SelfList<Container>::List pending_sort_list;
+	static void _flush_pending_sorts();
+
+	void _sort();
 	void _sort_children();
 	void _child_minsize_changed();
 
@@ -614,6 +614,7 @@ void Control::_notification(int p_notification) {
 		} break;
 		case NOTIFICATION_THEME_CHANGED: {
 
+			data.theme_cache.version = 0; //the theme owner may have changed
 			minimum_size_changed();
 			update();
 		} break;
@@ -851,18 +852,38 @@ bool Control::_has_theme_item(Control *p_theme_owner, Window *p_theme_owner_wind
 	return false;
 }
 
+void Control::_validate_theme_cache() const {
+
+	if (data.theme_cache.version == Theme::get_change_version())
+		return;
+
+	data.theme_cache.icons.clear();
+	data.theme_cache.shaders.clear();
+	data.theme_cache.styles.clear();
+	data.theme_cache.fonts.clear();
+	data.theme_cache.colors.clear();
+	data.theme_cache.constants.clear();
+	data.theme_cache.version = Theme::get_change_version();
+}
+
 Ref<Texture2D> Control::get_theme_icon(const StringName &p_name, const StringName &p_type) const {
 
 	if (p_type == StringName() || p_type == get_class_name()) {
-
 		const Ref<Texture2D> *tex = data.icon_override.getptr(p_name);
 		if (tex)
 			return *tex;
-	}
 
-	StringName type = p_type ? p_type : get_class_name();
+		_validate_theme_cache();
+		const Ref<Texture2D> *cached = data.theme_cache.icons.getptr(p_name);
+		if (cached)
+			return *cached;
 
-	return get_icons(data.theme_owner, data.theme_owner_window, p_name, type);
+		Ref<Texture2D> ret = get_icons(data.theme_owner, data.theme_owner_window, p_name, get_class_name());
+		data.theme_cache.icons[p_name] = ret;
+		return ret;
+	}
+
+	return get_icons(data.theme_owner, data.theme_owner_window, p_name, p_type);
 }
 
 Ref<Texture2D> Control::get_icons(Control *p_theme_owner, Window *p_theme_owner_window, const StringName &p_name, const StringName &p_type) {
@@ -885,15 +906,21 @@ Ref<Texture2D> Control::get_icons(Control *p_theme_owner, Window *p_theme_owner_
 Ref<Shader> Control::get_theme_shader(const StringName &p_name, const StringName &p_type) const {
 
 	if (p_type == StringName() || p_type == get_class_name()) {
-
 		const Ref<Shader> *sdr = data.shader_override.getptr(p_name);
 		if (sdr)
 			return *sdr;
-	}
 
-	StringName type = p_type ? p_type : get_class_name();
+		_validate_theme_cache();
+		const Ref<Shader> *cached = data.theme_cache.shaders.getptr(p_name);
+		if (cached)
+			return *cached;
+
+		Ref<Shader> ret = get_shaders(data.theme_owner, data.theme_owner_window, p_name, get_class_name());
+		data.theme_cache.shaders[p_name] = ret;
+		return ret;
+	}
 
-	return get_shaders(data.theme_owner, data.theme_owner_window, p_name, type);
+	return get_shaders(data.theme_owner, data.theme_owner_window, p_name, p_type);
 }
 
 Ref<Shader> Control::get_shaders(Control *p_theme_owner, Window *p_theme_owner_window, const StringName &p_name, const StringName &p_type) {
@@ -919,11 +946,18 @@ Ref<StyleBox> Control::get_theme_stylebox(const StringName &p_name, const String
 		const Ref<StyleBox> *style = data.style_override.getptr(p_name);
 		if (style)
 			return *style;
-	}
 
-	StringName type = p_type ? p_type : get_class_name();
+		_validate_theme_cache();
+		const Ref<StyleBox> *cached = data.theme_cache.styles.getptr(p_name);
+		if (cached)
+			return *cached;
+
+		Ref<StyleBox> ret = get_styleboxs(data.theme_owner, data.theme_owner_window, p_name, get_class_name());
+		data.theme_cache.styles[p_name] = ret;
+		return ret;
+	}
 
-	return get_styleboxs(data.theme_owner, data.theme_owner_window, p_name, type);
+	return get_styleboxs(data.theme_owner, data.theme_owner_window, p_name, p_type);
 }
 
 Ref<StyleBox> Control::get_styleboxs(Control *p_theme_owner, Window *p_theme_owner_window, const StringName &p_name, const StringName &p_type) {
@@ -949,11 +983,18 @@ Ref<Font> Control::get_theme_font(const StringName &p_name, const StringName &p_
 		const Ref<Font> *font = data.font_override.getptr(p_name);
 		if (font)
 			return *font;
-	}
 
-	StringName type = p_type ? p_type : get_class_name();
+		_validate_theme_cache();
+		const Ref<Font> *cached = data.theme_cache.fonts.getptr(p_name);
+		if (cached)
+			return *cached;
+
+		Ref<Font> ret = get_fonts(data.theme_owner, data.theme_owner_window, p_name, get_class_name());
+		data.theme_cache.fonts[p_name] = ret;
+		return ret;
+	}
 
-	return get_fonts(data.theme_owner, data.theme_owner_window, p_name, type);
+	return get_fonts(data.theme_owner, data.theme_owner_window, p_name, p_type);
 }
 
 Ref<Font> Control::get_fonts(Control *p_theme_owner, Window *p_theme_owner_window, const StringName &p_name, const StringName &p_type) {
@@ -979,11 +1020,18 @@ Color Control::get_theme_color(const StringName &p_name, const StringName &p_typ
 		const Color *color = data.color_override.getptr(p_name);
 		if (color)
 			return *color;
-	}
 
-	StringName type = p_type ? p_type : get_class_name();
+		_validate_theme_cache();
+		const Color *cached = data.theme_cache.colors.getptr(p_name);
+		if (cached)
+			return *cached;
+
+		Color ret = get_colors(data.theme_owner, data.theme_owner_window, p_name, get_class_name());
+		data.theme_cache.colors[p_name] = ret;
+		return ret;
+	}
 
-	return get_colors(data.theme_owner, data.theme_owner_window, p_name, type);
+	return get_colors(data.theme_owner, data.theme_owner_window, p_name, p_type);
 }
 
 Color Control::get_colors(Control *p_theme_owner, Window *p_theme_owner_window, const StringName &p_name, const StringName &p_type) {
@@ -1008,11 +1056,18 @@ int Control::get_theme_constant(const StringName &p_name, const StringName &p_ty
 		const int *constant = data.constant_override.getptr(p_name);
 		if (constant)
 			return *constant;
-	}
 
-	StringName type = p_type ? p_type : get_class_name();
+		_validate_theme_cache();
+		const int *cached = data.theme_cache.constants.getptr(p_name);
+		if (cached)
+			return *cached;
+
+		int ret = get_constants(data.theme_owner, data.theme_owner_window, p_name, get_class_name());
+		data.theme_cache.constants[p_name] = ret;
+		return ret;
+	}
 
-	return get_constants(data.theme_owner, data.theme_owner_window, p_name, type);
+	return get_constants(data.theme_owner, data.theme_owner_window, p_name, p_type);
 }
 
 int Control::get_constants(Control *p_theme_owner, Window *p_theme_owner_window, const StringName &p_name, const StringName &p_type) {
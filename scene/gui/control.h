@@ -198,6 +198,23 @@ private:
 		HashMap<StringName, Color> color_override;
 		HashMap<StringName, int> constant_override;
 
+		//items already looked up for this control's own type, cleared on theme changes
+		struct ThemeCache {
+			uint32_t version;
+			HashMap<StringName, Ref<Texture2D>> icons;
+			HashMap<StringName, Ref<Shader>> shaders;
+			HashMap<StringName, Ref<StyleBox>> styles;
+			HashMap<StringName, Ref<Font>> fonts;
+			HashMap<StringName, Color> colors;
+			HashMap<StringName, int> constants;
+
+			ThemeCache() {
+				version = 0;
+			}
+		};
+
+		mutable ThemeCache theme_cache;
+
 	} data;
 
 	// used internally
@@ -234,6 +251,7 @@ private:
 	friend class Viewport;
 
 	void _update_minimum_size_cache();
+	void _validate_theme_cache() const;
 	friend class Window;
 	static void _propagate_theme_changed(Node *p_at, Control *p_owner, Window *p_owner_window, bool p_assign = true);
 
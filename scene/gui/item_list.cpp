@@ -45,6 +45,7 @@ void ItemList::add_item(const String &p_item, const Ref<Texture2D> &p_texture, b
 	item.disabled = false;
 	item.tooltip_enabled = true;
 	item.custom_bg = Color(0, 0, 0, 0);
+	item.text_size_valid = false;
 	items.push_back(item);
 
 	update();
@@ -64,6 +65,7 @@ void ItemList::add_icon_item(const Ref<Texture2D> &p_item, bool p_selectable) {
 	item.disabled = false;
 	item.tooltip_enabled = true;
 	item.custom_bg = Color(0, 0, 0, 0);
+	item.text_size_valid = false;
 	items.push_back(item);
 
 	update();
@@ -75,6 +77,7 @@ void ItemList::set_item_text(int p_idx, const String &p_text) {
 	ERR_FAIL_INDEX(p_idx, items.size());
 
 	items.write[p_idx].text = p_text;
+	items.write[p_idx].text_size_valid = false;
 	update();
 	shape_changed = true;
 }
@@ -818,6 +821,14 @@ void ItemList::_notification(int p_what) {
 		update();
 	}
 
+	if (p_what == NOTIFICATION_THEME_CHANGED) {
+		for (int i = 0; i < items.size(); i++) {
+			items.write[i].text_size_valid = false;
+		}
+		shape_changed = true;
+		update();
+	}
+
 	if (p_what == NOTIFICATION_DRAW) {
 
 		Ref<StyleBox> bg = get_theme_stylebox("bg");
@@ -891,7 +902,12 @@ void ItemList::_notification(int p_what) {
 
 				if (items[i].text != "") {
 
-					Size2 s = font->get_string_size(items[i].text);
+					if (!items[i].text_size_valid) {
+						items.write[i].text_size_cache = font->get_string_size(items[i].text);
+						items.write[i].text_size_valid = true;
+					}
+
+					Size2 s = items[i].text_size_cache;
 					//s.width=MIN(s.width,fixed_column_width);
 
 					if (icon_mode == ICON_MODE_TOP) {
@@ -1013,26 +1029,7 @@ void ItemList::_notification(int p_what) {
 
 		const Rect2 clip(-base_ofs, size); // visible frame, don't need to draw outside of there
 
-		int first_item_visible;
-		{
-			// do a binary search to find the first item whose rect reaches below clip.position.y
-			int lo = 0;
-			int hi = items.size();
-			while (lo < hi) {
-				const int mid = (lo + hi) / 2;
-				const Rect2 &rcache = items[mid].rect_cache;
-				if (rcache.position.y + rcache.size.y < clip.position.y) {
-					lo = mid + 1;
-				} else {
-					hi = mid;
-				}
-			}
-			// we might have ended up with column 2, or 3, ..., so let's find the first column
-			while (lo > 0 && items[lo - 1].rect_cache.position.y == items[lo].rect_cache.position.y) {
-				lo -= 1;
-			}
-			first_item_visible = lo;
-		}
+		int first_item_visible = _find_first_item_reaching(clip.position.y);
 
 		for (int i = first_item_visible; i < items.size(); i++) {
 
@@ -1133,7 +1130,7 @@ void ItemList::_notification(int p_what) {
 
 				int max_len = -1;
 
-				Vector2 size2 = font->get_string_size(items[i].text);
+				Vector2 size2 = items[i].text_size_valid ? items[i].text_size_cache : font->get_string_size(items[i].text);
 				if (fixed_column_width)
 					max_len = fixed_column_width;
 				else if (same_column_width)
@@ -1244,6 +1241,27 @@ void ItemList::_notification(int p_what) {
 	}
 }
 
+int ItemList::_find_first_item_reaching(float p_y) const {
+
+	// do a binary search to find the first item whose rect reaches below p_y
+	int lo = 0;
+	int hi = items.size();
+	while (lo < hi) {
+		const int mid = (lo + hi) / 2;
+		const Rect2 &rcache = items[mid].rect_cache;
+		if (rcache.position.y + rcache.size.y < p_y) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	// we might have ended up with column 2, or 3, ..., so let's find the first column
+	while (lo > 0 && lo < items.size() && items[lo - 1].rect_cache.position.y == items[lo].rect_cache.position.y) {
+		lo -= 1;
+	}
+	return lo;
+}
+
 void ItemList::_scroll_changed(double) {
 	update();
 }
@@ -1258,7 +1276,26 @@ int ItemList::get_item_at_position(const Point2 &p_pos, bool p_exact) const {
 	int closest = -1;
 	int closest_dist = 0x7FFFFFFF;
 
-	for (int i = 0; i < items.size(); i++) {
+	if (items.empty())
+		return closest;
+
+	// start one row above the position, rows before that one are farther away
+	int from = MIN(_find_first_item_reaching(pos.y), items.size() - 1);
+	while (from > 0 && items[from - 1].rect_cache.position.y == items[from].rect_cache.position.y) {
+		from--;
+	}
+	if (from > 0) {
+		from--;
+		while (from > 0 && items[from - 1].rect_cache.position.y == items[from].rect_cache.position.y) {
+			from--;
+		}
+	}
+
+	for (int i = from; i < items.size(); i++) {
+
+		float below = items[i].rect_cache.position.y - pos.y;
+		if (below > 0 && (p_exact || below > closest_dist))
+			break; // every item from here on is farther away
 
 		Rect2 rc = items[i].rect_cache;
 		if (i % current_columns == current_columns - 1) {
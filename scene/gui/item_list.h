@@ -69,6 +69,8 @@ private:
 
 		Rect2 rect_cache;
 		Rect2 min_rect_cache;
+		Size2 text_size_cache; //measuring text is the slow part of a layout, so it's only done when the text or font change
+		bool text_size_valid;
 
 		Size2 get_icon_size() const;
 
@@ -117,6 +119,7 @@ private:
 	Array _get_items() const;
 	void _set_items(const Array &p_items);
 
+	int _find_first_item_reaching(float p_y) const;
 	void _scroll_changed(double);
 	void _gui_input(const Ref<InputEvent> &p_event);
 
@@ -907,8 +907,7 @@ void RichTextLabel::_update_scroll() {
 			vscroll->hide();
 		}
 
-		main->first_invalid_line = 0; //invalidate ALL
-		_validate_line_caches(main);
+		_validate_line_caches(main); //the text width changed, so this lays out everything again
 	}
 }
 
@@ -960,7 +959,7 @@ void RichTextLabel::_notification(int p_what) {
 		} break;
 		case NOTIFICATION_RESIZED: {
 
-			main->first_invalid_line = 0; //invalidate ALL
+			//lines are only laid out again if the text width changed, see _validate_line_caches()
 			update();
 
 		} break;
@@ -975,6 +974,7 @@ void RichTextLabel::_notification(int p_what) {
 		} break;
 		case NOTIFICATION_THEME_CHANGED: {
 
+			main->first_invalid_line = 0; //fonts may have changed, invalidate ALL
 			update();
 
 		} break;
@@ -998,20 +998,11 @@ void RichTextLabel::_notification(int p_what) {
 
 			int ofs = vscroll->get_value();
 
-			//todo, change to binary search
-
-			int from_line = 0;
-			int total_chars = 0;
-			while (from_line < main->lines.size()) {
-
-				if (main->lines[from_line].height_accum_cache + _get_text_rect().get_position().y >= ofs)
-					break;
-				total_chars += main->lines[from_line].char_count;
-				from_line++;
-			}
-
+			int from_line = _find_first_visible_line(main, ofs - text_rect.get_position().y);
 			if (from_line >= main->lines.size())
 				break; //nothing to draw
+
+			int total_chars = main->lines[from_line].char_accum_cache - main->lines[from_line].char_count;
 			int y = (main->lines[from_line].height_accum_cache - main->lines[from_line].height_cache) - ofs;
 			Ref<Font> base_font = get_theme_font("normal_font");
 			Color base_color = get_theme_color("default_color");
@@ -1048,16 +1039,7 @@ void RichTextLabel::_find_click(ItemFrame *p_frame, const Point2i &p_click, Item
 	bool use_outline = get_theme_constant("shadow_as_outline");
 	Point2 shadow_ofs(get_theme_constant("shadow_offset_x"), get_theme_constant("shadow_offset_y"));
 
-	//todo, change to binary search
-	int from_line = 0;
-
-	while (from_line < p_frame->lines.size()) {
-
-		if (p_frame->lines[from_line].height_accum_cache >= ofs)
-			break;
-		from_line++;
-	}
-
+	int from_line = _find_first_visible_line(p_frame, ofs);
 	if (from_line >= p_frame->lines.size())
 		return;
 
@@ -1517,15 +1499,23 @@ bool RichTextLabel::_find_layout_subitem(Item *from, Item *to) {
 
 void RichTextLabel::_validate_line_caches(ItemFrame *p_frame) {
 
-	if (p_frame->first_invalid_line == p_frame->lines.size())
-		return;
-
-	//validate invalid lines
 	Size2 size = get_size();
 	if (fixed_width != -1) {
 		size.width = fixed_width;
 	}
 	Rect2 text_rect = _get_text_rect();
+
+	//line layouts only depend on the width, a new height just changes the scroll page
+	int width = text_rect.get_size().width - scroll_w;
+	if (p_frame == main && width != line_cache_width) {
+		line_cache_width = width;
+		p_frame->first_invalid_line = 0;
+	}
+
+	if (p_frame->first_invalid_line == p_frame->lines.size() && p_frame->first_invalid_accum_line >= p_frame->lines.size() && vscroll->get_page() == size.height)
+		return;
+
+	//validate invalid lines
 	Color font_color_shadow = get_theme_color("font_color_shadow");
 	bool use_outline = get_theme_constant("shadow_as_outline");
 	Point2 shadow_ofs(get_theme_constant("shadow_offset_x"), get_theme_constant("shadow_offset_y"));
@@ -1535,12 +1525,21 @@ void RichTextLabel::_validate_line_caches(ItemFrame *p_frame) {
 	for (int i = p_frame->first_invalid_line; i < p_frame->lines.size(); i++) {
 
 		int y = 0;
-		_process_line(p_frame, text_rect.get_position(), y, text_rect.get_size().width - scroll_w, i, PROCESS_CACHE, base_font, Color(), font_color_shadow, use_outline, shadow_ofs);
+		_process_line(p_frame, text_rect.get_position(), y, width, i, PROCESS_CACHE, base_font, Color(), font_color_shadow, use_outline, shadow_ofs);
 		p_frame->lines.write[i].height_cache = y;
-		p_frame->lines.write[i].height_accum_cache = y;
+	}
+
+	//lines before the first changed one keep their offsets
+	for (int i = MIN(p_frame->first_invalid_line, p_frame->first_invalid_accum_line); i < p_frame->lines.size(); i++) {
 
-		if (i > 0)
-			p_frame->lines.write[i].height_accum_cache += p_frame->lines[i - 1].height_accum_cache;
+		Line &l = p_frame->lines.write[i];
+		l.height_accum_cache = l.height_cache;
+		l.char_accum_cache = l.char_count;
+
+		if (i > 0) {
+			l.height_accum_cache += p_frame->lines[i - 1].height_accum_cache;
+			l.char_accum_cache += p_frame->lines[i - 1].char_accum_cache;
+		}
 	}
 
 	int total_height = 0;
@@ -1548,6 +1547,7 @@ void RichTextLabel::_validate_line_caches(ItemFrame *p_frame) {
 		total_height = p_frame->lines[p_frame->lines.size() - 1].height_accum_cache + get_theme_stylebox("normal")->get_minimum_size().height;
 
 	main->first_invalid_line = p_frame->lines.size();
+	main->first_invalid_accum_line = p_frame->lines.size();
 
 	updating_scroll = true;
 	vscroll->set_max(total_height);
@@ -1558,6 +1558,23 @@ void RichTextLabel::_validate_line_caches(ItemFrame *p_frame) {
 	updating_scroll = false;
 }
 
+int RichTextLabel::_find_first_visible_line(ItemFrame *p_frame, int p_ofs) const {
+
+	//accumulated heights only grow, so the first line ending past the offset can be searched for
+	int low = 0;
+	int high = p_frame->lines.size();
+	while (low < high) {
+		int middle = (low + high) / 2;
+		if (p_frame->lines[middle].height_accum_cache >= p_ofs) {
+			high = middle;
+		} else {
+			low = middle + 1;
+		}
+	}
+
+	return low;
+}
+
 void RichTextLabel::_invalidate_current_line(ItemFrame *p_frame) {
 
 	if (p_frame->lines.size() - 1 <= p_frame->first_invalid_line) {
@@ -1747,7 +1764,11 @@ bool RichTextLabel::remove_line(const int p_line) {
 	if (p_line == 0 && current->subitems.size() > 0)
 		main->lines.write[0].from = main;
 
-	main->first_invalid_line = 0;
+	//the lines after the removed one keep their layout, only their offsets move
+	if (main->first_invalid_line > p_line)
+		main->first_invalid_line--;
+	main->first_invalid_accum_line = MIN(main->first_invalid_accum_line, p_line);
+	update();
 
 	return true;
 }
@@ -2962,6 +2983,7 @@ RichTextLabel::RichTextLabel() {
 	updating_scroll = false;
 	scroll_active = true;
 	scroll_w = 0;
+	line_cache_width = -1;
 	scroll_updated = false;
 
 	vscroll = memnew(VScrollBar);
@@ -94,12 +94,14 @@ private:
 		int height_cache;
 		int height_accum_cache;
 		int char_count;
+		int char_accum_cache;
 		int minimum_width;
 		int maximum_width;
 
 		Line() {
 			from = NULL;
 			char_count = 0;
+			char_accum_cache = 0;
 		}
 	};
 
@@ -131,6 +133,7 @@ private:
 		bool cell;
 		Vector<Line> lines;
 		int first_invalid_line;
+		int first_invalid_accum_line; //lines from here keep their layout, but their accumulated offsets need updating
 		ItemFrame *parent_frame;
 
 		ItemFrame() {
@@ -138,6 +141,7 @@ private:
 			parent_frame = NULL;
 			cell = false;
 			parent_line = 0;
+			first_invalid_accum_line = 0;
 		}
 	};
 
@@ -316,6 +320,7 @@ private:
 	bool scroll_following;
 	bool scroll_active;
 	int scroll_w;
+	int line_cache_width;
 	bool scroll_updated;
 	bool updating_scroll;
 	int current_idx;
@@ -334,6 +339,7 @@ private:
 
 	void _invalidate_current_line(ItemFrame *p_frame);
 	void _validate_line_caches(ItemFrame *p_frame);
+	int _find_first_visible_line(ItemFrame *p_frame, int p_ofs) const;
 
 	void _add_item(Item *p_item, bool p_enter = false, bool p_ensure_newline = false);
 	void _remove_item(Item *p_item, const int p_line, const int p_subitem_line);
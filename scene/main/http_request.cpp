@@ -33,8 +33,97 @@
 void HTTPRequest::_redirect_request(const String &p_new_url) {
 }
 
+#define POOL_MAX_IDLE_PER_HOST 4
+#define POOL_IDLE_TIMEOUT_MSEC 15000
+
+Mutex HTTPRequest::pool_mutex;
+Map<String, List<HTTPRequest::PooledClient>> HTTPRequest::client_pool;
+
+String HTTPRequest::_get_pool_key() const {
+
+	return url + ":" + itos(port) + (use_ssl ? (validate_ssl ? ":ssl" : ":ssl_unverified") : "");
+}
+
+Ref<HTTPClient> HTTPRequest::_take_pooled_client(const String &p_key) {
+
+	MutexLock lock(pool_mutex);
+
+	Map<String, List<PooledClient>>::Element *E = client_pool.find(p_key);
+	if (!E) {
+		return Ref<HTTPClient>();
+	}
+
+	Ref<HTTPClient> found;
+	uint64_t now = OS::get_singleton()->get_ticks_msec();
+	// Most recently used last, it is the least likely to have been closed by the server.
+	while (E->get().size() && found.is_null()) {
+		PooledClient pc = E->get().back()->get();
+		E->get().pop_back();
+		if (now - pc.time > POOL_IDLE_TIMEOUT_MSEC) {
+			continue;
+		}
+		pc.client->poll();
+		if (pc.client->get_status() == HTTPClient::STATUS_CONNECTED) {
+			found = pc.client;
+		}
+	}
+
+	if (E->get().empty()) {
+		client_pool.erase(E);
+	}
+	return found;
+}
+
+void HTTPRequest::_pool_client(const String &p_key, const Ref<HTTPClient> &p_client) {
+
+	MutexLock lock(pool_mutex);
+
+	List<PooledClient> &list = client_pool[p_key];
+	if (list.size() >= POOL_MAX_IDLE_PER_HOST) {
+		list.pop_front(); // Closes the oldest.
+	}
+	PooledClient pc;
+	pc.client = p_client;
+	pc.time = OS::get_singleton()->get_ticks_msec();
+	list.push_back(pc);
+}
+
+void HTTPRequest::clear_connection_pool() {
+
+	MutexLock lock(pool_mutex);
+	client_pool.clear();
+}
+
+bool HTTPRequest::_can_keep_alive() const {
+
+	if (client->get_status() != HTTPClient::STATUS_CONNECTED) {
+		return false;
+	}
+	for (int i = 0; i < response_headers.size(); i++) {
+		if (response_headers[i].to_lower().begins_with("connection: close")) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool HTTPRequest::_retry_reused_connection() {
+
+	// The server may have closed an idle connection right before we used it, try once more on a new one.
+	if (!reused_connection || got_response) {
+		return false;
+	}
+	reused_connection = false;
+	request_sent = false;
+	client->close();
+	return client->connect_to_host(url, port, use_ssl, validate_ssl) == OK;
+}
+
 Error HTTPRequest::_request() {
 
+	if (reused_connection) {
+		return OK;
+	}
 	return client->connect_to_host(url, port, use_ssl, validate_ssl);
 }
 
@@ -108,6 +197,14 @@ Error HTTPRequest::request(const String &p_url, const Vector<String> &p_custom_h
 
 	requesting = true;
 
+	reused_connection = false;
+	Ref<HTTPClient> pooled = _take_pooled_client(_get_pool_key());
+	if (pooled.is_valid()) {
+		pooled->set_read_chunk_size(client->get_read_chunk_size());
+		client = pooled;
+		reused_connection = true;
+	}
+
 	if (use_threads) {
 
 		thread_done = false;
@@ -169,7 +266,17 @@ void HTTPRequest::cancel_request() {
 		memdelete(file);
 		file = NULL;
 	}
-	client->close();
+	if (keep_alive_on_done) {
+		// Hand the connection over to the pool and continue with a fresh client.
+		Ref<HTTPClient> fresh;
+		fresh.instance();
+		fresh->set_read_chunk_size(client->get_read_chunk_size());
+		_pool_client(_get_pool_key(), client);
+		client = fresh;
+		keep_alive_on_done = false;
+	} else {
+		client->close();
+	}
 	body.resize(0);
 	got_response = false;
 	response_code = -1;
@@ -216,6 +323,7 @@ bool HTTPRequest::_handle_response(bool *ret_value) {
 		if (new_request != "") {
 			// Process redirect
 			client->close();
+			reused_connection = false;
 			int new_redirs = redirections + 1; // Because _request() will clear it
 			Error err;
 			if (new_request.begins_with("http")) {
@@ -246,6 +354,9 @@ bool HTTPRequest::_update_connection() {
 
 	switch (client->get_status()) {
 		case HTTPClient::STATUS_DISCONNECTED: {
+			if (_retry_reused_connection()) {
+				return false;
+			}
 			call_deferred("_request_done", RESULT_CANT_CONNECT, 0, PackedStringArray(), PackedByteArray());
 			return true; // End it, since it's doing something
 		} break;
@@ -384,6 +495,9 @@ bool HTTPRequest::_update_connection() {
 
 		} break; // Request resulted in body: break which must be read
 		case HTTPClient::STATUS_CONNECTION_ERROR: {
+			if (_retry_reused_connection()) {
+				return false;
+			}
 			call_deferred("_request_done", RESULT_CONNECTION_ERROR, 0, PackedStringArray(), PackedByteArray());
 			return true;
 		} break;
@@ -398,6 +512,7 @@ bool HTTPRequest::_update_connection() {
 
 void HTTPRequest::_request_done(int p_status, int p_code, const PackedStringArray &headers, const PackedByteArray &p_data) {
 
+	keep_alive_on_done = p_status == RESULT_SUCCESS && requesting && _can_keep_alive();
 	cancel_request();
 	emit_signal("request_completed", p_status, p_code, headers, p_data);
 }
@@ -584,6 +699,8 @@ HTTPRequest::HTTPRequest() {
 	downloaded = 0;
 	body_size_limit = -1;
 	file = NULL;
+	reused_connection = false;
+	keep_alive_on_done = false;
 
 	timer = memnew(Timer);
 	timer->set_one_shot(true);
@@ -33,6 +33,7 @@
 
 #include "core/io/http_client.h"
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "node.h"
 #include "scene/main/timer.h"
@@ -90,6 +91,25 @@ private:
 
 	int redirections;
 
+	// Connections left open after a successful keep-alive response, shared by every HTTPRequest
+	// and keyed by host, port and SSL settings.
+	struct PooledClient {
+		Ref<HTTPClient> client;
+		uint64_t time;
+	};
+
+	static Mutex pool_mutex;
+	static Map<String, List<PooledClient>> client_pool;
+
+	bool reused_connection;
+	bool keep_alive_on_done;
+
+	String _get_pool_key() const;
+	static Ref<HTTPClient> _take_pooled_client(const String &p_key);
+	static void _pool_client(const String &p_key, const Ref<HTTPClient> &p_client);
+	bool _can_keep_alive() const;
+	bool _retry_reused_connection();
+
 	bool _update_connection();
 
 	int max_redirects;
@@ -145,6 +165,8 @@ public:
 	int get_downloaded_bytes() const;
 	int get_body_size() const;
 
+	static void clear_connection_pool();
+
 	HTTPRequest();
 	~HTTPRequest();
 };
@@ -50,6 +50,11 @@ VARIANT_ENUM_CAST(Node::PauseMode);
 
 int Node::orphan_node_count = 0;
 
+//bumped whenever a node inside the tree is renamed, or a child is added to or removed from one
+static uint64_t node_tree_version = 1;
+//paths remembered per node before its cache is flushed
+static const int MAX_NODE_CACHE_PATHS = 32;
+
 void Node::_notification(int p_notification) {
 
 	switch (p_notification) {
@@ -117,6 +122,7 @@ void Node::_notification(int p_notification) {
 				memdelete(data.path_cache);
 				data.path_cache = NULL;
 			}
+			data.node_cache.clear();
 		} break;
 		case NOTIFICATION_PATH_CHANGED: {
 
@@ -311,6 +317,11 @@ void Node::move_child(Node *p_child, int p_pos) {
 	ERR_FAIL_COND_MSG(p_child->data.parent != this, "Child is not a child of this node.");
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, move_child() failed. Consider using call_deferred(\"move_child\") instead (or \"popup\" if this is from a popup).");
 
+	if (_is_tree_change_deferred()) {
+		MessageQueue::get_singleton()->push_call(this, "move_child", p_child, p_pos);
+		return;
+	}
+
 	// Specifying one place beyond the end
 	// means the same as moving to the last position
 	if (p_pos == data.children.size())
@@ -420,20 +431,26 @@ void Node::set_pause_mode(PauseMode p_mode) {
 	data.pause_mode = p_mode;
 	if (!is_inside_tree())
 		return; //pointless
-	if ((data.pause_mode == PAUSE_MODE_INHERIT) == prev_inherits)
-		return; ///nothing changed
 
-	Node *owner = NULL;
+	if ((data.pause_mode == PAUSE_MODE_INHERIT) != prev_inherits) {
 
-	if (data.pause_mode == PAUSE_MODE_INHERIT) {
+		Node *owner = NULL;
 
-		if (data.parent)
-			owner = data.parent->data.pause_owner;
-	} else {
-		owner = this;
+		if (data.pause_mode == PAUSE_MODE_INHERIT) {
+
+			if (data.parent)
+				owner = data.parent->data.pause_owner;
+		} else {
+			owner = this;
+		}
+
+		_propagate_pause_owner(owner);
 	}
 
-	_propagate_pause_owner(owner);
+	if (data.tree->is_paused()) {
+		//whether this branch can process may have changed
+		propagate_notification(NOTIFICATION_PAUSE_MODE_CHANGED);
+	}
 }
 
 Node::PauseMode Node::get_pause_mode() const {
@@ -940,6 +957,22 @@ int Node::get_process_priority() const {
 	return data.process_priority;
 }
 
+void Node::set_process_thread_safe(bool p_enable) {
+
+	data.process_thread_safe = p_enable;
+}
+
+bool Node::is_process_thread_safe() const {
+
+	return data.process_thread_safe;
+}
+
+bool Node::_is_tree_change_deferred() const {
+
+	//thread-safe nodes are processing in parallel, the tree can't change until they are done
+	return data.tree && data.tree->is_threaded_processing();
+}
+
 void Node::set_process_input(bool p_enable) {
 
 	if (p_enable == data.input)
@@ -1003,6 +1036,9 @@ StringName Node::get_name() const {
 void Node::_set_name_nocheck(const StringName &p_name) {
 
 	data.name = p_name;
+	if (data.inside_tree) {
+		node_tree_version++;
+	}
 }
 
 String Node::invalid_character = ". : @ / \"";
@@ -1031,6 +1067,10 @@ void Node::set_name(const String &p_name) {
 		data.parent->_validate_child_name(this);
 	}
 
+	if (data.inside_tree) {
+		node_tree_version++;
+	}
+
 	propagate_notification(NOTIFICATION_PATH_CHANGED);
 
 	if (is_inside_tree()) {
@@ -1235,6 +1275,9 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name) {
 	p_child->data.pos = data.children.size();
 	data.children.push_back(p_child);
 	p_child->data.parent = this;
+	if (data.inside_tree) {
+		node_tree_version++;
+	}
 	p_child->notification(NOTIFICATION_PARENTED);
 
 	if (data.tree) {
@@ -1254,6 +1297,11 @@ void Node::add_child(Node *p_child, bool p_legible_unique_name) {
 	ERR_FAIL_COND_MSG(p_child->data.parent, "Can't add child '" + p_child->get_name() + "' to '" + get_name() + "', already has a parent '" + p_child->data.parent->get_name() + "'."); //Fail if node has a parent
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, add_node() failed. Consider using call_deferred(\"add_child\", child) instead.");
 
+	if (_is_tree_change_deferred()) {
+		MessageQueue::get_singleton()->push_call(this, "add_child", p_child, p_legible_unique_name);
+		return;
+	}
+
 	/* Validate name */
 	_validate_child_name(p_child, p_legible_unique_name);
 
@@ -1310,6 +1358,11 @@ void Node::remove_child(Node *p_child) {
 	ERR_FAIL_NULL(p_child);
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, remove_node() failed. Consider using call_deferred(\"remove_child\", child) instead.");
 
+	if (_is_tree_change_deferred()) {
+		MessageQueue::get_singleton()->push_call(this, "remove_child", p_child);
+		return;
+	}
+
 	int child_count = data.children.size();
 	Node **children = data.children.ptrw();
 	int idx = -1;
@@ -1343,6 +1396,9 @@ void Node::remove_child(Node *p_child) {
 	p_child->notification(NOTIFICATION_UNPARENTED);
 
 	data.children.remove(idx);
+	if (data.inside_tree) {
+		node_tree_version++;
+	}
 
 	//update pointer and size
 	child_count = data.children.size();
@@ -1391,6 +1447,35 @@ Node *Node::_get_child_by_name(const StringName &p_name) const {
 
 Node *Node::get_node_or_null(const NodePath &p_path) const {
 
+	//thread safe process callbacks run on the pool and may look up nodes concurrently,
+	//so the cache is only used from the main thread
+	if (!data.inside_tree || data.tree->is_threaded_processing()) {
+		return _get_node_uncached(p_path);
+	}
+
+	//any change that can affect a lookup from here bumps node_tree_version
+	if (data.node_cache_version != node_tree_version) {
+		data.node_cache.clear();
+		data.node_cache_version = node_tree_version;
+	}
+
+	Node *const *cached = data.node_cache.getptr(p_path);
+	if (cached) {
+		return *cached;
+	}
+
+	Node *node = _get_node_uncached(p_path);
+
+	if (data.node_cache.size() >= MAX_NODE_CACHE_PATHS) {
+		data.node_cache.clear();
+	}
+	data.node_cache.set(p_path, node);
+
+	return node;
+}
+
+Node *Node::_get_node_uncached(const NodePath &p_path) const {
+
 	if (p_path.is_empty()) {
 		return NULL;
 	}
@@ -1757,6 +1842,11 @@ void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 	if (data.grouped.has(p_identifier))
 		return;
 
+	if (_is_tree_change_deferred()) {
+		MessageQueue::get_singleton()->push_call(this, "add_to_group", p_identifier, p_persistent);
+		return;
+	}
+
 	GroupData gd;
 
 	if (data.tree) {
@@ -1774,6 +1864,11 @@ void Node::remove_from_group(const StringName &p_identifier) {
 
 	ERR_FAIL_COND(!data.grouped.has(p_identifier));
 
+	if (_is_tree_change_deferred()) {
+		MessageQueue::get_singleton()->push_call(this, "remove_from_group", p_identifier);
+		return;
+	}
+
 	Map<StringName, GroupData>::Element *E = data.grouped.find(p_identifier);
 
 	ERR_FAIL_COND(!E);
@@ -1887,6 +1982,11 @@ void Node::propagate_notification(int p_notification) {
 	data.blocked--;
 }
 
+void Node::reset_physics_interpolation() {
+
+	propagate_notification(NOTIFICATION_RESET_PHYSICS_INTERPOLATION);
+}
+
 void Node::propagate_call(const StringName &p_method, const Array &p_args, const bool p_parent_first) {
 
 	data.blocked++;
@@ -2690,6 +2790,11 @@ void Node::print_stray_nodes() {
 
 void Node::queue_delete() {
 
+	if (_is_tree_change_deferred()) {
+		MessageQueue::get_singleton()->push_call(this, "queue_free");
+		return;
+	}
+
 	if (is_inside_tree()) {
 		get_tree()->queue_delete(this);
 	} else {
@@ -2841,6 +2946,7 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_filename", "filename"), &Node::set_filename);
 	ClassDB::bind_method(D_METHOD("get_filename"), &Node::get_filename);
 	ClassDB::bind_method(D_METHOD("propagate_notification", "what"), &Node::propagate_notification);
+	ClassDB::bind_method(D_METHOD("reset_physics_interpolation"), &Node::reset_physics_interpolation);
 	ClassDB::bind_method(D_METHOD("propagate_call", "method", "args", "parent_first"), &Node::propagate_call, DEFVAL(Array()), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("set_physics_process", "enable"), &Node::set_physics_process);
 	ClassDB::bind_method(D_METHOD("get_physics_process_delta_time"), &Node::get_physics_process_delta_time);
@@ -2849,6 +2955,8 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_process", "enable"), &Node::set_process);
 	ClassDB::bind_method(D_METHOD("set_process_priority", "priority"), &Node::set_process_priority);
 	ClassDB::bind_method(D_METHOD("get_process_priority"), &Node::get_process_priority);
+	ClassDB::bind_method(D_METHOD("set_process_thread_safe", "enable"), &Node::set_process_thread_safe);
+	ClassDB::bind_method(D_METHOD("is_process_thread_safe"), &Node::is_process_thread_safe);
 	ClassDB::bind_method(D_METHOD("is_processing"), &Node::is_processing);
 	ClassDB::bind_method(D_METHOD("set_process_input", "enable"), &Node::set_process_input);
 	ClassDB::bind_method(D_METHOD("is_processing_input"), &Node::is_processing_input);
@@ -2945,6 +3053,8 @@ void Node::_bind_methods() {
 	BIND_CONSTANT(NOTIFICATION_PATH_CHANGED);
 	BIND_CONSTANT(NOTIFICATION_INTERNAL_PROCESS);
 	BIND_CONSTANT(NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
+	BIND_CONSTANT(NOTIFICATION_RESET_PHYSICS_INTERPOLATION);
+	BIND_CONSTANT(NOTIFICATION_PAUSE_MODE_CHANGED);
 
 	BIND_CONSTANT(NOTIFICATION_WM_MOUSE_ENTER);
 	BIND_CONSTANT(NOTIFICATION_WM_MOUSE_EXIT);
@@ -2985,6 +3095,7 @@ void Node::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "multiplayer", PROPERTY_HINT_RESOURCE_TYPE, "MultiplayerAPI", 0), "", "get_multiplayer");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "custom_multiplayer", PROPERTY_HINT_RESOURCE_TYPE, "MultiplayerAPI", 0), "set_custom_multiplayer", "get_custom_multiplayer");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_priority"), "set_process_priority", "get_process_priority");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "process_thread_safe"), "set_process_thread_safe", "is_process_thread_safe");
 
 	BIND_VMETHOD(MethodInfo("_process", PropertyInfo(Variant::FLOAT, "delta")));
 	BIND_VMETHOD(MethodInfo("_physics_process", PropertyInfo(Variant::FLOAT, "delta")));
@@ -3019,6 +3130,7 @@ Node::Node() {
 	data.process_priority = 0;
 	data.physics_process_internal = false;
 	data.idle_process_internal = false;
+	data.process_thread_safe = false;
 	data.inside_tree = false;
 	data.ready_notified = false;
 
@@ -3031,6 +3143,7 @@ Node::Node() {
 	data.pause_owner = NULL;
 	data.network_master = 1; //server by default
 	data.path_cache = NULL;
+	data.node_cache_version = 0;
 	data.parent_owned = false;
 	data.in_constructor = true;
 	data.viewport = NULL;
@@ -134,6 +134,7 @@ private:
 
 		bool physics_process_internal;
 		bool idle_process_internal;
+		bool process_thread_safe;
 
 		bool input;
 		bool unhandled_input;
@@ -147,6 +148,10 @@ private:
 
 		mutable NodePath *path_cache;
 
+		//get_node() results while inside the tree, valid as long as node_cache_version matches the tree version
+		mutable HashMap<NodePath, Node *> node_cache;
+		mutable uint64_t node_cache_version;
+
 	} data;
 
 	enum NameCasing {
@@ -158,9 +163,11 @@ private:
 	Ref<MultiplayerAPI> multiplayer;
 
 	void _print_tree_pretty(const String &prefix, const bool last);
+	bool _is_tree_change_deferred() const;
 	void _print_tree(const Node *p_node);
 
 	Node *_get_child_by_name(const StringName &p_name) const;
+	Node *_get_node_uncached(const NodePath &p_path) const;
 
 	void _replace_connections_target(Node *p_new_target);
 
@@ -243,6 +250,8 @@ public:
 		NOTIFICATION_INTERNAL_PROCESS = 25,
 		NOTIFICATION_INTERNAL_PHYSICS_PROCESS = 26,
 		NOTIFICATION_POST_ENTER_TREE = 27,
+		NOTIFICATION_RESET_PHYSICS_INTERPOLATION = 28,
+		NOTIFICATION_PAUSE_MODE_CHANGED = 29,
 		//keep these linked to node
 
 		NOTIFICATION_WM_MOUSE_ENTER = 1002,
@@ -339,6 +348,7 @@ public:
 	/* NOTIFICATIONS */
 
 	void propagate_notification(int p_notification);
+	void reset_physics_interpolation();
 
 	void propagate_call(const StringName &p_method, const Array &p_args = Array(), const bool p_parent_first = false);
 
@@ -360,6 +370,9 @@ public:
 	void set_process_priority(int p_priority);
 	int get_process_priority() const;
 
+	void set_process_thread_safe(bool p_enable);
+	bool is_process_thread_safe() const;
+
 	void set_process_input(bool p_enable);
 	bool is_processing_input() const;
 
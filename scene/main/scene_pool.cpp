@@ -0,0 +1,223 @@
+/*************************************************************************/
+/*  scene_pool.cpp                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "scene_pool.h"
+
+#include "core/core_string_names.h"
+
+void ScenePool::_take_snapshot(Node *p_node) {
+
+	NodeState ns;
+	ns.class_name = p_node->get_class_name();
+
+	List<PropertyInfo> plist;
+	p_node->get_property_list(&plist);
+
+	for (List<PropertyInfo>::Element *E = plist.front(); E; E = E->next()) {
+
+		if (!(E->get().usage & PROPERTY_USAGE_STORAGE) || E->get().name == CoreStringNames::get_singleton()->_script) {
+			continue;
+		}
+
+		Variant value = p_node->get(E->get().name);
+
+		if (value.get_type() == Variant::OBJECT) {
+			//only shared resources can be put back, local ones belong to each copy
+			Ref<Resource> res = value;
+			if (res.is_null() || res->is_local_to_scene()) {
+				continue;
+			}
+		}
+
+		ns.names.push_back(E->get().name);
+		ns.values.push_back(value);
+	}
+
+	snapshot.push_back(ns);
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_take_snapshot(p_node->get_child(i));
+	}
+}
+
+bool ScenePool::_restore(Node *p_node, int &r_index) {
+
+	if (r_index >= snapshot.size() || snapshot[r_index].class_name != p_node->get_class_name()) {
+		return false; //tree was changed since it was instanced
+	}
+
+	const NodeState &ns = snapshot[r_index];
+	r_index++;
+
+	for (int i = 0; i < ns.names.size(); i++) {
+		const Variant &value = ns.values[i];
+		if (value.get_type() == Variant::ARRAY || value.get_type() == Variant::DICTIONARY) {
+			p_node->set(ns.names[i], value.duplicate(true));
+		} else {
+			p_node->set(ns.names[i], value);
+		}
+	}
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		if (!_restore(p_node->get_child(i), r_index)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+Node *ScenePool::_instance() {
+
+	ERR_FAIL_COND_V_MSG(scene.is_null(), NULL, "ScenePool has no scene to instance.");
+
+	Node *node = scene->instance();
+	ERR_FAIL_COND_V(!node, NULL);
+
+	if (snapshot.empty()) {
+		_take_snapshot(node);
+	}
+
+	return node;
+}
+
+void ScenePool::set_scene(const Ref<PackedScene> &p_scene) {
+
+	if (scene == p_scene) {
+		return;
+	}
+
+	clear();
+	scene = p_scene;
+}
+
+Ref<PackedScene> ScenePool::get_scene() const {
+
+	return scene;
+}
+
+void ScenePool::set_max_size(int p_size) {
+
+	ERR_FAIL_COND(p_size < 0);
+	max_size = p_size;
+
+	while (parked.size() > max_size) {
+		memdelete(parked.back()->get());
+		parked.pop_back();
+	}
+}
+
+int ScenePool::get_max_size() const {
+
+	return max_size;
+}
+
+void ScenePool::prewarm(int p_count) {
+
+	ERR_FAIL_COND(p_count < 0);
+
+	while (parked.size() < MIN(p_count, max_size)) {
+		Node *node = _instance();
+		ERR_FAIL_COND(!node);
+		parked.push_back(node);
+	}
+}
+
+Node *ScenePool::acquire() {
+
+	if (parked.empty()) {
+		return _instance();
+	}
+
+	Node *node = parked.front()->get();
+	parked.pop_front();
+	return node;
+}
+
+void ScenePool::release(Node *p_node) {
+
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(scene.is_valid() && scene->get_path() != String() && p_node->get_filename() != scene->get_path(), "Node was not instanced from the pooled scene.");
+
+	//leaving the tree takes bodies and instances out of their space and scenario, the RIDs stay alive
+	if (p_node->get_parent()) {
+		p_node->get_parent()->remove_child(p_node);
+	}
+
+	int index = 0;
+	if (parked.size() >= max_size || !_restore(p_node, index) || index != snapshot.size()) {
+		memdelete(p_node);
+		return;
+	}
+
+	p_node->propagate_call("_pool_reset");
+	parked.push_back(p_node);
+}
+
+int ScenePool::get_available_count() const {
+
+	return parked.size();
+}
+
+void ScenePool::clear() {
+
+	while (parked.size()) {
+		memdelete(parked.front()->get());
+		parked.pop_front();
+	}
+	snapshot.clear();
+}
+
+void ScenePool::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("set_scene", "scene"), &ScenePool::set_scene);
+	ClassDB::bind_method(D_METHOD("get_scene"), &ScenePool::get_scene);
+	ClassDB::bind_method(D_METHOD("set_max_size", "size"), &ScenePool::set_max_size);
+	ClassDB::bind_method(D_METHOD("get_max_size"), &ScenePool::get_max_size);
+
+	ClassDB::bind_method(D_METHOD("prewarm", "count"), &ScenePool::prewarm);
+	ClassDB::bind_method(D_METHOD("acquire"), &ScenePool::acquire);
+	ClassDB::bind_method(D_METHOD("release", "node"), &ScenePool::release);
+	ClassDB::bind_method(D_METHOD("get_available_count"), &ScenePool::get_available_count);
+	ClassDB::bind_method(D_METHOD("clear"), &ScenePool::clear);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "scene", PROPERTY_HINT_RESOURCE_TYPE, "PackedScene"), "set_scene", "get_scene");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_size", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), "set_max_size", "get_max_size");
+}
+
+ScenePool::ScenePool() {
+
+	max_size = 64;
+}
+
+ScenePool::~ScenePool() {
+
+	clear();
+}
@@ -40,6 +40,8 @@
 #include "core/os/os.h"
 #include "core/print_string.h"
 #include "core/project_settings.h"
+#include "core/sort_array.h"
+#include "core/thread_work_pool.h"
 #include "node.h"
 #include "scene/debugger/scene_debugger.h"
 #include "scene/resources/dynamic_font.h"
@@ -49,8 +51,10 @@
 #include "scene/scene_string_names.h"
 #include "servers/display_server.h"
 #include "servers/navigation_server_3d.h"
+#include "servers/rendering_server.h"
 #include "servers/physics_server_2d.h"
 #include "servers/physics_server_3d.h"
+#include "timer.h"
 #include "window.h"
 
 #include <stdio.h>
@@ -67,15 +71,34 @@ void SceneTreeTimer::_bind_methods() {
 
 void SceneTreeTimer::set_time_left(float p_time) {
 	time_left = p_time;
+	if (queued) {
+		SceneTree::get_singleton()->_schedule_tree_timer(Ref<SceneTreeTimer>(this));
+	}
 }
 
 float SceneTreeTimer::get_time_left() const {
+	if (queued) {
+		return deadline - SceneTree::get_singleton()->get_timer_clock(process_pause ? SceneTree::TIMER_CLOCK_TREE : SceneTree::TIMER_CLOCK_TREE_UNPAUSED);
+	}
 	return time_left;
 }
 
 void SceneTreeTimer::set_pause_mode_process(bool p_pause_mode_process) {
 
-	process_pause = p_pause_mode_process;
+	if (process_pause == p_pause_mode_process) {
+		return;
+	}
+
+	if (queued) {
+		//moves to the other clock
+		time_left = get_time_left();
+		SceneTree::get_singleton()->unschedule_timer(process_pause ? SceneTree::TIMER_CLOCK_TREE : SceneTree::TIMER_CLOCK_TREE_UNPAUSED);
+		queued = false;
+		process_pause = p_pause_mode_process;
+		SceneTree::get_singleton()->_schedule_tree_timer(Ref<SceneTreeTimer>(this));
+	} else {
+		process_pause = p_pause_mode_process;
+	}
 }
 
 bool SceneTreeTimer::is_pause_mode_process() {
@@ -96,6 +119,120 @@ void SceneTreeTimer::release_connections() {
 SceneTreeTimer::SceneTreeTimer() {
 	time_left = 0;
 	process_pause = true;
+	queued = false;
+	deadline = 0;
+	queue_generation = 0;
+}
+
+void SceneTree::_push_timer_entry(TimerClock p_clock, const TimerEntry &p_entry) {
+
+	LocalVector<TimerEntry> &queue = timer_queue[p_clock];
+
+	if (timer_queue_stale[p_clock] > 256 && timer_queue_stale[p_clock] > queue.size() / 2) {
+		//mostly stopped or rescheduled timers, compact instead of letting them pile up until their deadline
+		uint32_t live = 0;
+		for (uint32_t i = 0; i < queue.size(); i++) {
+			if (_is_timer_entry_live(queue[i])) {
+				queue[live++] = queue[i];
+			}
+		}
+		queue.resize(live);
+		SortArray<TimerEntry, TimerEntryCompare> heap;
+		heap.make_heap(0, queue.size(), queue.ptr());
+		timer_queue_stale[p_clock] = 0;
+	}
+
+	queue.push_back(p_entry);
+	SortArray<TimerEntry, TimerEntryCompare> heap;
+	heap.push_heap(0, queue.size() - 1, 0, p_entry, queue.ptr());
+}
+
+bool SceneTree::_is_timer_entry_live(const TimerEntry &p_entry) const {
+
+	if (p_entry.tree_timer.is_valid()) {
+		return p_entry.tree_timer->queued && p_entry.tree_timer->queue_generation == p_entry.generation;
+	}
+
+	Timer *timer = Object::cast_to<Timer>(ObjectDB::get_instance(p_entry.timer));
+	return timer && timer->_is_scheduled(p_entry.generation);
+}
+
+void SceneTree::_process_timers(TimerClock p_clock, float p_time) {
+
+	timer_clock[p_clock] += p_time;
+	double clock = timer_clock[p_clock];
+
+	LocalVector<TimerEntry> &queue = timer_queue[p_clock];
+	if (queue.size() == 0 || queue[0].deadline >= clock) {
+		return;
+	}
+
+	//collect everything that expired first, so timers rescheduled from a timeout wait at least until the next frame
+	SortArray<TimerEntry, TimerEntryCompare> heap;
+	timers_expired.clear();
+	while (queue.size() && queue[0].deadline < clock) {
+		heap.pop_heap(0, queue.size(), queue.ptr());
+		timers_expired.push_back(queue[queue.size() - 1]);
+		queue.resize(queue.size() - 1);
+	}
+
+	for (uint32_t i = 0; i < timers_expired.size(); i++) {
+
+		const TimerEntry &entry = timers_expired[i];
+
+		if (!_is_timer_entry_live(entry)) {
+			if (timer_queue_stale[p_clock] > 0) {
+				timer_queue_stale[p_clock]--;
+			}
+			continue;
+		}
+
+		if (entry.tree_timer.is_valid()) {
+			Ref<SceneTreeTimer> stt = entry.tree_timer;
+			stt->queued = false;
+			stt->time_left = stt->deadline - clock;
+			stt->emit_signal("timeout");
+		} else {
+			Timer *timer = Object::cast_to<Timer>(ObjectDB::get_instance(entry.timer));
+			timer->_timeout();
+		}
+	}
+
+	timers_expired.clear();
+}
+
+void SceneTree::_schedule_tree_timer(const Ref<SceneTreeTimer> &p_timer) {
+
+	Ref<SceneTreeTimer> stt = p_timer;
+	TimerClock clock = stt->process_pause ? TIMER_CLOCK_TREE : TIMER_CLOCK_TREE_UNPAUSED;
+
+	if (stt->queued) {
+		//entry of the previous schedule remains in the queue, it will be skipped
+		timer_queue_stale[clock]++;
+	}
+
+	stt->queued = true;
+	stt->queue_generation++;
+	stt->deadline = timer_clock[clock] + stt->time_left;
+
+	TimerEntry entry;
+	entry.deadline = stt->deadline;
+	entry.generation = stt->queue_generation;
+	entry.tree_timer = stt;
+	_push_timer_entry(clock, entry);
+}
+
+void SceneTree::schedule_timer(TimerClock p_clock, double p_deadline, ObjectID p_timer, uint64_t p_generation) {
+
+	TimerEntry entry;
+	entry.deadline = p_deadline;
+	entry.generation = p_generation;
+	entry.timer = p_timer;
+	_push_timer_entry(p_clock, entry);
+}
+
+void SceneTree::unschedule_timer(TimerClock p_clock) {
+	timer_queue_stale[p_clock]++;
 }
 
 void SceneTree::tree_changed() {
@@ -131,11 +268,12 @@ SceneTree::Group *SceneTree::add_to_group(const StringName &p_group, Node *p_nod
 		E = group_map.insert(p_group, Group());
 	}
 
-	ERR_FAIL_COND_V_MSG(E->get().nodes.find(p_node) != -1, &E->get(), "Already in group: " + p_group + ".");
-	E->get().nodes.push_back(p_node);
-	//E->get().last_tree_version=0;
-	E->get().changed = true;
-	return &E->get();
+	Group &g = E->get();
+	ERR_FAIL_COND_V_MSG(g.indices.has(p_node->get_instance_id()), &g, "Already in group: " + p_group + ".");
+	//appended after the sorted part, only the new nodes need sorting later
+	g.indices[p_node->get_instance_id()] = g.nodes.size();
+	g.nodes.push_back(p_node);
+	return &g;
 }
 
 void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
@@ -143,9 +281,42 @@ void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
 	Map<StringName, Group>::Element *E = group_map.find(p_group);
 	ERR_FAIL_COND(!E);
 
-	E->get().nodes.erase(p_node);
-	if (E->get().nodes.empty())
+	Group &g = E->get();
+	const uint32_t *index = g.indices.getptr(p_node->get_instance_id());
+	ERR_FAIL_COND(!index);
+	uint32_t idx = *index;
+	g.indices.erase(p_node->get_instance_id());
+
+	if (g.lock == 0 && idx >= g.sorted_count) {
+		//not sorted yet, so order doesn't matter and the last node can take its place
+		uint32_t last = g.nodes.size() - 1;
+		if (idx != last) {
+			Node *moved = g.nodes[last];
+			g.nodes[idx] = moved;
+			if (moved) {
+				g.indices[moved->get_instance_id()] = idx;
+			}
+		}
+		g.nodes.resize(last);
+	} else {
+		//keep the order (or the array being iterated) intact, compacted on next update
+		g.nodes[idx] = NULL;
+		g.removed_count++;
+	}
+
+	if (g.lock == 0 && g.nodes.size() == g.removed_count) {
 		group_map.erase(E);
+	}
+}
+
+void SceneTree::_unlock_group(Map<StringName, Group>::Element *E) {
+
+	Group &g = E->get();
+	g.lock--;
+	//emptied while being iterated
+	if (g.lock == 0 && g.nodes.size() == g.removed_count) {
+		group_map.erase(E);
+	}
 }
 
 void SceneTree::make_group_changed(const StringName &p_group) {
@@ -157,6 +328,46 @@ void SceneTree::make_group_changed(const StringName &p_group) {
 void SceneTree::flush_transform_notifications() {
 
 	SelfList<Node> *n = xform_change_list.first();
+	if (!n) {
+		return;
+	}
+
+	//sort by depth, so parents compute their global transform before their children need it
+	int max_depth = 0;
+	uint32_t count = 0;
+	for (; n; n = n->next()) {
+		max_depth = MAX(max_depth, n->self()->data.depth);
+		count++;
+	}
+
+	xform_sort_offsets.resize(max_depth + 2);
+	for (uint32_t i = 0; i < xform_sort_offsets.size(); i++) {
+		xform_sort_offsets[i] = 0;
+	}
+	for (n = xform_change_list.first(); n; n = n->next()) {
+		xform_sort_offsets[MAX(n->self()->data.depth, 0) + 1]++;
+	}
+	for (uint32_t i = 1; i < xform_sort_offsets.size(); i++) {
+		xform_sort_offsets[i] += xform_sort_offsets[i - 1];
+	}
+
+	xform_sort.resize(count);
+	for (n = xform_change_list.first(); n; n = n->next()) {
+		xform_sort[xform_sort_offsets[MAX(n->self()->data.depth, 0)]++] = n;
+	}
+
+	//relink in that order, the list stays live in case nodes are freed from the notifications
+	for (uint32_t i = 0; i < count; i++) {
+		xform_change_list.remove(xform_sort[i]);
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		xform_change_list.add_last(xform_sort[i]);
+	}
+	xform_sort.clear();
+
+	xform_batching = true;
+
+	n = xform_change_list.first();
 	while (n) {
 
 		Node *node = n->self();
@@ -165,6 +376,24 @@ void SceneTree::flush_transform_notifications() {
 		n = nx;
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
 	}
+
+	xform_batching = false;
+
+	if (xform_batch_instances.size()) {
+		RS::get_singleton()->instances_set_transform(xform_batch_instances, xform_batch_transforms);
+		xform_batch_instances.clear();
+		xform_batch_transforms.clear();
+	}
+}
+
+void SceneTree::instance_set_transform(RID p_instance, const Transform &p_transform) {
+
+	if (xform_batching) {
+		xform_batch_instances.push_back(p_instance);
+		xform_batch_transforms.push_back(p_transform);
+	} else {
+		RS::get_singleton()->instance_set_transform(p_instance, p_transform);
+	}
 }
 
 void SceneTree::_flush_ugc() {
@@ -187,23 +416,98 @@ void SceneTree::_flush_ugc() {
 	ugc_locked = false;
 }
 
+//sorts the nodes appended after p_sorted_count and merges them into the sorted part,
+//returns the first position that changed
+template <class C>
+static uint32_t _sort_group_nodes(Node **p_nodes, uint32_t p_count, uint32_t p_sorted_count, LocalVector<Node *> &r_buffer) {
+
+	C compare;
+	SortArray<Node *, C> node_sort;
+	node_sort.sort(&p_nodes[p_sorted_count], p_count - p_sorted_count);
+
+	if (p_sorted_count == 0 || compare(p_nodes[p_sorted_count - 1], p_nodes[p_sorted_count])) {
+		return p_sorted_count; //new nodes all go after the existing ones, common when spawning
+	}
+
+	//sorted nodes before the first new one stay in place
+	uint32_t from = 0;
+	while (!compare(p_nodes[p_sorted_count], p_nodes[from])) {
+		from++;
+	}
+
+	r_buffer.resize(p_sorted_count - from);
+	for (uint32_t i = from; i < p_sorted_count; i++) {
+		r_buffer[i - from] = p_nodes[i];
+	}
+
+	uint32_t a = 0;
+	uint32_t b = p_sorted_count;
+	uint32_t w = from;
+	while (a < r_buffer.size() && b < p_count) {
+		if (compare(p_nodes[b], r_buffer[a])) {
+			p_nodes[w++] = p_nodes[b++];
+		} else {
+			p_nodes[w++] = r_buffer[a++];
+		}
+	}
+	while (a < r_buffer.size()) {
+		p_nodes[w++] = r_buffer[a++];
+	}
+
+	r_buffer.clear();
+	return from;
+}
+
 void SceneTree::_update_group_order(Group &g, bool p_use_priority) {
 
-	if (!g.changed)
-		return;
+	if (g.lock > 0)
+		return; //being iterated, sorted once done
 	if (g.nodes.empty())
 		return;
 
-	Node **nodes = g.nodes.ptrw();
-	int node_count = g.nodes.size();
+	uint32_t reindex_from = g.nodes.size();
 
-	if (p_use_priority) {
-		SortArray<Node *, Node::ComparatorWithPriority> node_sort;
-		node_sort.sort(nodes, node_count);
-	} else {
-		SortArray<Node *, Node::Comparator> node_sort;
-		node_sort.sort(nodes, node_count);
+	if (g.removed_count) {
+		uint32_t w = 0;
+		uint32_t sorted_count = 0;
+		for (uint32_t i = 0; i < g.nodes.size(); i++) {
+			if (!g.nodes[i]) {
+				reindex_from = MIN(reindex_from, i);
+				continue;
+			}
+			if (i < g.sorted_count) {
+				sorted_count++;
+			}
+			g.nodes[w++] = g.nodes[i];
+		}
+		g.nodes.resize(w);
+		g.sorted_count = sorted_count;
+		g.removed_count = 0;
 	}
+
+	if (g.changed || g.sorted_with_priority != p_use_priority) {
+		g.sorted_count = 0;
+	}
+
+	uint32_t node_count = g.nodes.size();
+	if (g.sorted_count < node_count) {
+		uint32_t from;
+		if (p_use_priority) {
+			from = _sort_group_nodes<Node::ComparatorWithPriority>(g.nodes.ptr(), node_count, g.sorted_count, group_sort_buffer);
+		} else {
+			from = _sort_group_nodes<Node::Comparator>(g.nodes.ptr(), node_count, g.sorted_count, group_sort_buffer);
+		}
+		reindex_from = MIN(reindex_from, from);
+	}
+
+	if (reindex_from < node_count) {
+		for (uint32_t i = reindex_from; i < node_count; i++) {
+			g.indices[g.nodes[i]->get_instance_id()] = i;
+		}
+	}
+
+	g.sorted_count = node_count;
+	g.sorted_with_priority = p_use_priority;
 	g.changed = false;
 }
 
@@ -242,48 +546,50 @@ void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_grou
 
 	_update_group_order(g);
 
-	Vector<Node *> nodes_copy = g.nodes;
-	Node **nodes = nodes_copy.ptrw();
-	int node_count = nodes_copy.size();
-
+	//iterated in place, removed nodes become NULL and added ones go past node_count
+	int node_count = g.nodes.size();
+	g.lock++;
 	call_lock++;
 
 	if (p_call_flags & GROUP_CALL_REVERSE) {
 
 		for (int i = node_count - 1; i >= 0; i--) {
 
-			if (call_lock && call_skip.has(nodes[i]))
+			Node *n = g.nodes[i];
+			if (!n || (call_lock && call_skip.has(n)))
 				continue;
 
 			if (p_call_flags & GROUP_CALL_REALTIME) {
 				if (p_call_flags & GROUP_CALL_MULTILEVEL)
-					nodes[i]->call_multilevel(p_function, VARIANT_ARG_PASS);
+					n->call_multilevel(p_function, VARIANT_ARG_PASS);
 				else
-					nodes[i]->call(p_function, VARIANT_ARG_PASS);
+					n->call(p_function, VARIANT_ARG_PASS);
 			} else
-				MessageQueue::get_singleton()->push_call(nodes[i], p_function, VARIANT_ARG_PASS);
+				MessageQueue::get_singleton()->push_call(n, p_function, VARIANT_ARG_PASS);
 		}
 
 	} else {
 
 		for (int i = 0; i < node_count; i++) {
 
-			if (call_lock && call_skip.has(nodes[i]))
+			Node *n = g.nodes[i];
+			if (!n || (call_lock && call_skip.has(n)))
 				continue;
 
 			if (p_call_flags & GROUP_CALL_REALTIME) {
 				if (p_call_flags & GROUP_CALL_MULTILEVEL)
-					nodes[i]->call_multilevel(p_function, VARIANT_ARG_PASS);
+					n->call_multilevel(p_function, VARIANT_ARG_PASS);
 				else
-					nodes[i]->call(p_function, VARIANT_ARG_PASS);
+					n->call(p_function, VARIANT_ARG_PASS);
 			} else
-				MessageQueue::get_singleton()->push_call(nodes[i], p_function, VARIANT_ARG_PASS);
+				MessageQueue::get_singleton()->push_call(n, p_function, VARIANT_ARG_PASS);
 		}
 	}
 
 	call_lock--;
 	if (call_lock == 0)
 		call_skip.clear();
+	_unlock_group(E);
 }
 
 void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_group, int p_notification) {
@@ -297,42 +603,44 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 
 	_update_group_order(g);
 
-	Vector<Node *> nodes_copy = g.nodes;
-	Node **nodes = nodes_copy.ptrw();
-	int node_count = nodes_copy.size();
-
+	//iterated in place, removed nodes become NULL and added ones go past node_count
+	int node_count = g.nodes.size();
+	g.lock++;
 	call_lock++;
 
 	if (p_call_flags & GROUP_CALL_REVERSE) {
 
 		for (int i = node_count - 1; i >= 0; i--) {
 
-			if (call_lock && call_skip.has(nodes[i]))
+			Node *n = g.nodes[i];
+			if (!n || (call_lock && call_skip.has(n)))
 				continue;
 
 			if (p_call_flags & GROUP_CALL_REALTIME)
-				nodes[i]->notification(p_notification);
+				n->notification(p_notification);
 			else
-				MessageQueue::get_singleton()->push_notification(nodes[i], p_notification);
+				MessageQueue::get_singleton()->push_notification(n, p_notification);
 		}
 
 	} else {
 
 		for (int i = 0; i < node_count; i++) {
 
-			if (call_lock && call_skip.has(nodes[i]))
+			Node *n = g.nodes[i];
+			if (!n || (call_lock && call_skip.has(n)))
 				continue;
 
 			if (p_call_flags & GROUP_CALL_REALTIME)
-				nodes[i]->notification(p_notification);
+				n->notification(p_notification);
 			else
-				MessageQueue::get_singleton()->push_notification(nodes[i], p_notification);
+				MessageQueue::get_singleton()->push_notification(n, p_notification);
 		}
 	}
 
 	call_lock--;
 	if (call_lock == 0)
 		call_skip.clear();
+	_unlock_group(E);
 }
 
 void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group, const String &p_name, const Variant &p_value) {
@@ -346,42 +654,44 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 
 	_update_group_order(g);
 
-	Vector<Node *> nodes_copy = g.nodes;
-	Node **nodes = nodes_copy.ptrw();
-	int node_count = nodes_copy.size();
-
+	//iterated in place, removed nodes become NULL and added ones go past node_count
+	int node_count = g.nodes.size();
+	g.lock++;
 	call_lock++;
 
 	if (p_call_flags & GROUP_CALL_REVERSE) {
 
 		for (int i = node_count - 1; i >= 0; i--) {
 
-			if (call_lock && call_skip.has(nodes[i]))
+			Node *n = g.nodes[i];
+			if (!n || (call_lock && call_skip.has(n)))
 				continue;
 
 			if (p_call_flags & GROUP_CALL_REALTIME)
-				nodes[i]->set(p_name, p_value);
+				n->set(p_name, p_value);
 			else
-				MessageQueue::get_singleton()->push_set(nodes[i], p_name, p_value);
+				MessageQueue::get_singleton()->push_set(n, p_name, p_value);
 		}
 
 	} else {
 
 		for (int i = 0; i < node_count; i++) {
 
-			if (call_lock && call_skip.has(nodes[i]))
+			Node *n = g.nodes[i];
+			if (!n || (call_lock && call_skip.has(n)))
 				continue;
 
 			if (p_call_flags & GROUP_CALL_REALTIME)
-				nodes[i]->set(p_name, p_value);
+				n->set(p_name, p_value);
 			else
-				MessageQueue::get_singleton()->push_set(nodes[i], p_name, p_value);
+				MessageQueue::get_singleton()->push_set(n, p_name, p_value);
 		}
 	}
 
 	call_lock--;
 	if (call_lock == 0)
 		call_skip.clear();
+	_unlock_group(E);
 }
 
 void SceneTree::call_group(const StringName &p_group, const StringName &p_function, VARIANT_ARG_DECLARE) {
@@ -417,6 +727,7 @@ bool SceneTree::iteration(float p_time) {
 
 	emit_signal("physics_frame");
 
+	_process_timers(TIMER_CLOCK_PHYSICS, p_time);
 	_notify_group_pause("physics_process_internal", Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
 	_notify_group_pause("physics_process", Node::NOTIFICATION_PHYSICS_PROCESS);
 	_flush_ugc();
@@ -453,6 +764,7 @@ bool SceneTree::idle(float p_time) {
 
 	flush_transform_notifications();
 
+	_process_timers(TIMER_CLOCK_IDLE, p_time);
 	_notify_group_pause("idle_process_internal", Node::NOTIFICATION_INTERNAL_PROCESS);
 	_notify_group_pause("idle_process", Node::NOTIFICATION_PROCESS);
 
@@ -467,30 +779,9 @@ bool SceneTree::idle(float p_time) {
 
 	//go through timers
 
-	List<Ref<SceneTreeTimer>>::Element *L = timers.back(); //last element
-
-	for (List<Ref<SceneTreeTimer>>::Element *E = timers.front(); E;) {
-
-		List<Ref<SceneTreeTimer>>::Element *N = E->next();
-		if (pause && !E->get()->is_pause_mode_process()) {
-			if (E == L) {
-				break; //break on last, so if new timers were added during list traversal, ignore them.
-			}
-			E = N;
-			continue;
-		}
-		float time_left = E->get()->get_time_left();
-		time_left -= p_time;
-		E->get()->set_time_left(time_left);
-
-		if (time_left < 0) {
-			E->get()->emit_signal("timeout");
-			timers.erase(E);
-		}
-		if (E == L) {
-			break; //break on last, so if new timers were added during list traversal, ignore them.
-		}
-		E = N;
+	_process_timers(TIMER_CLOCK_TREE, p_time);
+	if (!pause) {
+		_process_timers(TIMER_CLOCK_TREE_UNPAUSED, p_time);
 	}
 
 	flush_transform_notifications(); //additional transforms after timers update
@@ -546,10 +837,17 @@ void SceneTree::finish() {
 	}
 
 	// cleanup timers
-	for (List<Ref<SceneTreeTimer>>::Element *E = timers.front(); E; E = E->next()) {
-		E->get()->release_connections();
+	for (int i = 0; i < TIMER_CLOCK_MAX; i++) {
+		for (uint32_t j = 0; j < timer_queue[i].size(); j++) {
+			Ref<SceneTreeTimer> stt = timer_queue[i][j].tree_timer;
+			if (stt.is_valid()) {
+				stt->queued = false;
+				stt->release_connections();
+			}
+		}
+		timer_queue[i].clear();
+		timer_queue_stale[i] = 0;
 	}
-	timers.clear();
 }
 
 void SceneTree::quit(int p_exit_code) {
@@ -819,19 +1117,21 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 
 	_update_group_order(g, p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
 
-	//copy, so copy on write happens in case something is removed from process while being called
-	//performance is not lost because only if something is added/removed the vector is copied.
-	Vector<Node *> nodes_copy = g.nodes;
+	//iterated in place, removed nodes become NULL and added ones go past node_count
+	int node_count = g.nodes.size();
+	g.lock++;
+
+	uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
 
-	int node_count = nodes_copy.size();
-	Node **nodes = nodes_copy.ptrw();
+	//only user callbacks can opt in, internal processing is never thread-safe
+	bool threadable = p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS;
 
 	call_lock++;
 
 	for (int i = 0; i < node_count; i++) {
 
-		Node *n = nodes[i];
-		if (call_lock && call_skip.has(n))
+		Node *n = g.nodes[i];
+		if (!n || (call_lock && call_skip.has(n)))
 			continue;
 
 		if (!n->can_process())
@@ -839,13 +1139,66 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 		if (!n->can_process_notification(p_notification))
 			continue;
 
+		if (threadable && n->is_process_thread_safe()) {
+			threaded_process_nodes.push_back(n);
+			continue;
+		}
+
 		n->notification(p_notification);
 		//ERR_FAIL_COND(node_count != g.nodes.size());
 	}
 
+	g.threaded_process_usec = 0;
+
+	if (threaded_process_nodes.size()) {
+		uint64_t threaded_begin_usec = OS::get_singleton()->get_ticks_usec();
+
+		//nodes removed from the tree by the serial nodes above are skipped here too
+		threaded_process = true;
+		ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+		if (pool && pool->get_thread_count() > 0 && threaded_process_nodes.size() > 1) {
+			pool->do_work(threaded_process_nodes.size(), this, &SceneTree::_process_threaded_node, p_notification);
+		} else {
+			for (uint32_t i = 0; i < threaded_process_nodes.size(); i++) {
+				_process_threaded_node(i, p_notification);
+			}
+		}
+		threaded_process = false;
+		threaded_process_nodes.clear();
+
+		g.threaded_process_usec = OS::get_singleton()->get_ticks_usec() - threaded_begin_usec;
+	}
+
 	call_lock--;
 	if (call_lock == 0)
 		call_skip.clear();
+
+	g.process_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+	_unlock_group(E);
+}
+
+void SceneTree::_process_threaded_node(uint32_t p_index, int p_notification) {
+
+	Node *n = threaded_process_nodes[p_index];
+	if (call_skip.has(n)) {
+		return;
+	}
+
+	n->notification(p_notification);
+}
+
+float SceneTree::get_group_process_time(const StringName &p_group) const {
+
+	const Map<StringName, Group>::Element *E = group_map.find(p_group);
+	ERR_FAIL_COND_V_MSG(!E, 0, "Group '" + String(p_group) + "' does not exist.");
+	return USEC_TO_SEC(E->get().process_usec);
+}
+
+float SceneTree::get_group_threaded_process_time(const StringName &p_group) const {
+
+	const Map<StringName, Group>::Element *E = group_map.find(p_group);
+	ERR_FAIL_COND_V_MSG(!E, 0, "Group '" + String(p_group) + "' does not exist.");
+	return USEC_TO_SEC(E->get().threaded_process_usec);
 }
 
 /*
@@ -870,12 +1223,9 @@ void SceneTree::_call_input_pause(const StringName &p_group, const StringName &p
 
 	_update_group_order(g);
 
-	//copy, so copy on write happens in case something is removed from process while being called
-	//performance is not lost because only if something is added/removed the vector is copied.
-	Vector<Node *> nodes_copy = g.nodes;
-
-	int node_count = nodes_copy.size();
-	Node **nodes = nodes_copy.ptrw();
+	//iterated in place, removed nodes become NULL and added ones go past node_count
+	int node_count = g.nodes.size();
+	g.lock++;
 
 	Variant arg = p_input;
 	const Variant *v[1] = { &arg };
@@ -887,8 +1237,8 @@ void SceneTree::_call_input_pause(const StringName &p_group, const StringName &p
 		if (p_viewport->is_input_handled())
 			break;
 
-		Node *n = nodes[i];
-		if (call_lock && call_skip.has(n))
+		Node *n = g.nodes[i];
+		if (!n || (call_lock && call_skip.has(n)))
 			continue;
 
 		if (!n->can_process())
@@ -901,6 +1251,7 @@ void SceneTree::_call_input_pause(const StringName &p_group, const StringName &p
 	call_lock--;
 	if (call_lock == 0)
 		call_skip.clear();
+	_unlock_group(E);
 }
 Variant SceneTree::_call_group_flags(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 
@@ -963,16 +1314,19 @@ Array SceneTree::_get_nodes_in_group(const StringName &p_group) {
 		return ret;
 
 	_update_group_order(E->get()); //update order just in case
-	int nc = E->get().nodes.size();
+	const Group &g = E->get();
+	int nc = g.nodes.size() - g.removed_count;
 	if (nc == 0)
 		return ret;
 
 	ret.resize(nc);
 
-	Node **ptr = E->get().nodes.ptrw();
-	for (int i = 0; i < nc; i++) {
+	int idx = 0;
+	for (uint32_t i = 0; i < g.nodes.size(); i++) {
 
-		ret[i] = ptr[i];
+		if (g.nodes[i]) {
+			ret[idx++] = g.nodes[i];
+		}
 	}
 
 	return ret;
@@ -989,16 +1343,29 @@ void SceneTree::get_nodes_in_group(const StringName &p_group, List<Node *> *p_li
 		return;
 
 	_update_group_order(E->get()); //update order just in case
-	int nc = E->get().nodes.size();
-	if (nc == 0)
-		return;
-	Node **ptr = E->get().nodes.ptrw();
-	for (int i = 0; i < nc; i++) {
+	const Group &g = E->get();
+	for (uint32_t i = 0; i < g.nodes.size(); i++) {
 
-		p_list->push_back(ptr[i]);
+		if (g.nodes[i]) {
+			p_list->push_back(g.nodes[i]);
+		}
 	}
 }
 
+//the nodes in tree order without copying them, valid until the group changes,
+//entries can only be NULL if the group is being called while this is used
+Node *const *SceneTree::get_group_nodes(const StringName &p_group, int &r_count) {
+
+	r_count = 0;
+	Map<StringName, Group>::Element *E = group_map.find(p_group);
+	if (!E)
+		return NULL;
+
+	_update_group_order(E->get());
+	r_count = E->get().nodes.size();
+	return E->get().nodes.ptr();
+}
+
 void SceneTree::_flush_delete_queue() {
 
 	_THREAD_SAFE_METHOD_
@@ -1110,7 +1477,7 @@ Ref<SceneTreeTimer> SceneTree::create_timer(float p_delay_sec, bool p_process_pa
 	stt.instance();
 	stt->set_pause_mode_process(p_process_pause);
 	stt->set_time_left(p_delay_sec);
-	timers.push_back(stt);
+	_schedule_tree_timer(stt);
 	return stt;
 }
 
@@ -1235,6 +1602,8 @@ void SceneTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("create_timer", "time_sec", "pause_mode_process"), &SceneTree::create_timer, DEFVAL(true));
 
 	ClassDB::bind_method(D_METHOD("get_node_count"), &SceneTree::get_node_count);
+	ClassDB::bind_method(D_METHOD("get_group_process_time", "group"), &SceneTree::get_group_process_time);
+	ClassDB::bind_method(D_METHOD("get_group_threaded_process_time", "group"), &SceneTree::get_group_threaded_process_time);
 	ClassDB::bind_method(D_METHOD("get_frame"), &SceneTree::get_frame);
 	ClassDB::bind_method(D_METHOD("quit", "exit_code"), &SceneTree::quit, DEFVAL(-1));
 
@@ -1381,6 +1750,9 @@ SceneTree::SceneTree() {
 	debug_collisions_hint = false;
 	debug_navigation_hint = false;
 #endif
+	//bodies are never simulated in the editor, so there is nothing to interpolate there
+	physics_interpolation = GLOBAL_DEF("physics/common/physics_interpolation", false) && !Engine::get_singleton()->is_editor_hint();
+
 	debug_collisions_color = GLOBAL_DEF("debug/shapes/collision/shape_color", Color(0.0, 0.6, 0.7, 0.5));
 	debug_collision_contact_color = GLOBAL_DEF("debug/shapes/collision/contact_color", Color(1.0, 0.2, 0.1, 0.8));
 	debug_navigation_color = GLOBAL_DEF("debug/shapes/navigation/geometry_color", Color(0.1, 1.0, 0.7, 0.4));
@@ -1392,6 +1764,11 @@ SceneTree::SceneTree() {
 	physics_process_time = 1;
 	idle_process_time = 1;
 
+	for (int i = 0; i < TIMER_CLOCK_MAX; i++) {
+		timer_queue_stale[i] = 0;
+		timer_clock[i] = 0;
+	}
+
 	root = NULL;
 	pause = false;
 	current_frame = 0;
@@ -1402,6 +1779,8 @@ SceneTree::SceneTree() {
 	node_renamed_name = "node_renamed";
 	ugc_locked = false;
 	call_lock = 0;
+	threaded_process = false;
+	xform_batching = false;
 	root_lock = 0;
 	node_count = 0;
 
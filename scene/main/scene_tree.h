@@ -32,9 +32,11 @@
 #define SCENE_MAIN_LOOP_H
 
 #include "core/io/multiplayer_api.h"
+#include "core/local_vector.h"
 #include "core/os/main_loop.h"
 #include "core/os/thread_safe.h"
 #include "core/self_list.h"
+#include "core/spin_lock.h"
 #include "scene/resources/mesh.h"
 #include "scene/resources/world_2d.h"
 #include "scene/resources/world_3d.h"
@@ -54,6 +56,13 @@ class SceneTreeTimer : public Reference {
 	float time_left;
 	bool process_pause;
 
+	//set while waiting in the SceneTree timer queue, time_left is then derived from the deadline
+	bool queued;
+	double deadline;
+	uint64_t queue_generation;
+
+	friend class SceneTree;
+
 protected:
 	static void _bind_methods();
 
@@ -81,10 +90,24 @@ public:
 private:
 	struct Group {
 
-		Vector<Node *> nodes;
-		//uint64_t last_tree_version;
-		bool changed;
-		Group() { changed = false; };
+		LocalVector<Node *> nodes; //NULL entries are nodes removed while the group was being iterated
+		HashMap<ObjectID, uint32_t> indices; //position of each node in the array
+		uint32_t sorted_count; //nodes before this are in tree order, the rest were appended since
+		uint32_t removed_count;
+		int lock; //iterations in progress, nodes can't be moved
+		bool sorted_with_priority;
+		bool changed; //tree order changed, everything must be sorted again
+		uint64_t process_usec; //last notification of the whole group
+		uint64_t threaded_process_usec; //part of it spent on the thread-safe nodes
+		Group() {
+			sorted_count = 0;
+			removed_count = 0;
+			lock = 0;
+			sorted_with_priority = false;
+			changed = false;
+			process_usec = 0;
+			threaded_process_usec = 0;
+		};
 	};
 
 	Window *root;
@@ -100,6 +123,7 @@ private:
 	bool debug_navigation_hint;
 #endif
 	bool pause;
+	bool physics_interpolation;
 	int root_lock;
 
 	Map<StringName, Group> group_map;
@@ -132,11 +156,18 @@ private:
 
 	List<ObjectID> delete_queue;
 
+	//thread-safe nodes of a process group run in parallel after the others
+	LocalVector<Node *> threaded_process_nodes;
+	bool threaded_process;
+	void _process_threaded_node(uint32_t p_index, int p_notification);
+
 	Map<UGCall, Vector<Variant>> unique_group_calls;
 	bool ugc_locked;
 	void _flush_ugc();
 
-	_FORCE_INLINE_ void _update_group_order(Group &g, bool p_use_priority = false);
+	LocalVector<Node *> group_sort_buffer;
+	void _update_group_order(Group &g, bool p_use_priority = false);
+	void _unlock_group(Map<StringName, Group>::Element *E);
 	void _update_listener();
 
 	Array _get_nodes_in_group(const StringName &p_group);
@@ -156,7 +187,38 @@ private:
 	void _change_scene(Node *p_to);
 	//void _call_group(uint32_t p_call_flags,const StringName& p_group,const StringName& p_function,const Variant& p_arg1,const Variant& p_arg2);
 
-	List<Ref<SceneTreeTimer>> timers;
+public:
+	enum TimerClock {
+		TIMER_CLOCK_IDLE, //Timer nodes processing in idle
+		TIMER_CLOCK_PHYSICS, //Timer nodes processing in physics
+		TIMER_CLOCK_TREE, //SceneTreeTimers that process while paused
+		TIMER_CLOCK_TREE_UNPAUSED, //SceneTreeTimers that stop while paused
+		TIMER_CLOCK_MAX
+	};
+
+private:
+	//pending timers, kept as a min-heap by deadline per clock so a frame only touches the ones expiring.
+	//entries are never removed in place, a timer that is stopped or rescheduled bumps its generation instead.
+	struct TimerEntry {
+		double deadline;
+		uint64_t generation;
+		ObjectID timer;
+		Ref<SceneTreeTimer> tree_timer;
+	};
+
+	struct TimerEntryCompare {
+		_FORCE_INLINE_ bool operator()(const TimerEntry &p_a, const TimerEntry &p_b) const { return p_a.deadline > p_b.deadline; }
+	};
+
+	LocalVector<TimerEntry> timer_queue[TIMER_CLOCK_MAX];
+	uint32_t timer_queue_stale[TIMER_CLOCK_MAX];
+	double timer_clock[TIMER_CLOCK_MAX];
+	LocalVector<TimerEntry> timers_expired;
+
+	void _push_timer_entry(TimerClock p_clock, const TimerEntry &p_entry);
+	bool _is_timer_entry_live(const TimerEntry &p_entry) const;
+	void _process_timers(TimerClock p_clock, float p_time);
+	void _schedule_tree_timer(const Ref<SceneTreeTimer> &p_timer);
 
 	///network///
 
@@ -172,6 +234,7 @@ private:
 
 	static SceneTree *singleton;
 	friend class Node;
+	friend class SceneTreeTimer;
 
 	void tree_changed();
 	void node_added(Node *p_node);
@@ -193,6 +256,27 @@ private:
 	friend class Viewport;
 
 	SelfList<Node>::List xform_change_list;
+	SpinLock xform_change_lock;
+
+	_FORCE_INLINE_ void _add_xform_change(SelfList<Node> *p_xform_change) {
+		//thread-safe nodes may move themselves while processing in parallel
+		if (threaded_process) {
+			xform_change_lock.lock();
+			if (!p_xform_change->in_list()) {
+				xform_change_list.add(p_xform_change);
+			}
+			xform_change_lock.unlock();
+		} else if (!p_xform_change->in_list()) {
+			xform_change_list.add(p_xform_change);
+		}
+	}
+
+	//instance transforms set while flushing the notifications, sent in bulk
+	bool xform_batching;
+	Vector<RID> xform_batch_instances;
+	Vector<Transform> xform_batch_transforms;
+	LocalVector<SelfList<Node> *> xform_sort;
+	LocalVector<uint32_t> xform_sort_offsets;
 
 #ifdef DEBUG_ENABLED // No live editor in release build.
 	friend class LiveEditor;
@@ -257,6 +341,14 @@ public:
 	_FORCE_INLINE_ float get_physics_process_time() const { return physics_process_time; }
 	_FORCE_INLINE_ float get_idle_process_time() const { return idle_process_time; }
 
+	//while true, changes to the tree are deferred to the end of the frame
+	_FORCE_INLINE_ bool is_threaded_processing() const { return threaded_process; }
+
+	void instance_set_transform(RID p_instance, const Transform &p_transform);
+
+	float get_group_process_time(const StringName &p_group) const;
+	float get_group_threaded_process_time(const StringName &p_group) const;
+
 #ifdef TOOLS_ENABLED
 	bool is_node_being_edited(const Node *p_node) const;
 #else
@@ -266,6 +358,8 @@ public:
 	void set_pause(bool p_enabled);
 	bool is_paused() const;
 
+	bool is_physics_interpolation_enabled() const { return physics_interpolation; }
+
 	void set_camera(const RID &p_camera);
 	RID get_camera() const;
 
@@ -310,6 +404,7 @@ public:
 	void queue_delete(Object *p_object);
 
 	void get_nodes_in_group(const StringName &p_group, List<Node *> *p_list);
+	Node *const *get_group_nodes(const StringName &p_group, int &r_count);
 	bool has_group(const StringName &p_identifier) const;
 
 	//void change_scene(const String& p_path);
@@ -326,6 +421,11 @@ public:
 
 	Ref<SceneTreeTimer> create_timer(float p_delay_sec, bool p_process_pause = true);
 
+	//used by Timer and SceneTreeTimer
+	double get_timer_clock(TimerClock p_clock) const { return timer_clock[p_clock]; }
+	void schedule_timer(TimerClock p_clock, double p_deadline, ObjectID p_timer, uint64_t p_generation);
+	void unschedule_timer(TimerClock p_clock);
+
 	//used by Main::start, don't use otherwise
 	void add_current_scene(Node *p_current);
 
@@ -47,38 +47,71 @@ void Timer::_notification(int p_what) {
 				autostart = false;
 			}
 		} break;
-		case NOTIFICATION_INTERNAL_PROCESS: {
-			if (timer_process_mode == TIMER_PROCESS_PHYSICS || !is_processing_internal())
-				return;
-			time_left -= get_process_delta_time();
-
-			if (time_left < 0) {
-				if (!one_shot)
-					time_left += wait_time;
-				else
-					stop();
-
-				emit_signal("timeout");
-			}
-
+		case NOTIFICATION_ENTER_TREE:
+		case NOTIFICATION_PAUSED:
+		case NOTIFICATION_UNPAUSED:
+		case NOTIFICATION_PAUSE_MODE_CHANGED: {
+			_update_schedule();
 		} break;
-		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
-			if (timer_process_mode == TIMER_PROCESS_IDLE || !is_physics_processing_internal())
-				return;
-			time_left -= get_physics_process_delta_time();
-
-			if (time_left < 0) {
-				if (!one_shot)
-					time_left += wait_time;
-				else
-					stop();
-				emit_signal("timeout");
-			}
-
+		case NOTIFICATION_EXIT_TREE: {
+			_unschedule(); //time left is kept, it resumes when entering the tree again
 		} break;
 	}
 }
 
+SceneTree::TimerClock Timer::_get_clock() const {
+	return timer_process_mode == TIMER_PROCESS_PHYSICS ? SceneTree::TIMER_CLOCK_PHYSICS : SceneTree::TIMER_CLOCK_IDLE;
+}
+
+void Timer::_update_schedule() {
+
+	//same conditions under which the timer used to receive its process notification
+	bool run = processing && !paused && is_inside_tree() && can_process();
+
+	if (run == scheduled) {
+		return;
+	}
+
+	if (!run) {
+		_unschedule();
+		return;
+	}
+
+	SceneTree *tree = get_tree();
+	scheduled = true;
+	schedule_generation++;
+	deadline = tree->get_timer_clock(_get_clock()) + time_left;
+	tree->schedule_timer(_get_clock(), deadline, get_instance_id(), schedule_generation);
+}
+
+void Timer::_unschedule() {
+
+	if (!scheduled) {
+		return;
+	}
+
+	SceneTree *tree = get_tree();
+	time_left = deadline - tree->get_timer_clock(_get_clock());
+	tree->unschedule_timer(_get_clock());
+	scheduled = false;
+	schedule_generation++;
+}
+
+void Timer::_timeout() {
+
+	time_left = deadline - get_tree()->get_timer_clock(_get_clock());
+	scheduled = false;
+
+	if (!one_shot) {
+		time_left += wait_time;
+		_update_schedule();
+	} else {
+		stop();
+	}
+
+	emit_signal("timeout");
+}
+
 void Timer::set_wait_time(float p_time) {
 	ERR_FAIL_COND_MSG(p_time <= 0, "Time should be greater than zero.");
 	wait_time = p_time;
@@ -113,13 +146,14 @@ void Timer::start(float p_time) {
 	if (p_time > 0) {
 		set_wait_time(p_time);
 	}
+	_unschedule();
 	time_left = wait_time;
 	_set_process(true);
 }
 
 void Timer::stop() {
-	time_left = -1;
 	_set_process(false);
+	time_left = -1;
 	autostart = false;
 }
 
@@ -141,7 +175,11 @@ bool Timer::is_stopped() const {
 
 float Timer::get_time_left() const {
 
-	return time_left > 0 ? time_left : 0;
+	double left = time_left;
+	if (scheduled) {
+		left = deadline - get_tree()->get_timer_clock(_get_clock());
+	}
+	return left > 0 ? left : 0;
 }
 
 void Timer::set_timer_process_mode(TimerProcessMode p_mode) {
@@ -149,21 +187,10 @@ void Timer::set_timer_process_mode(TimerProcessMode p_mode) {
 	if (timer_process_mode == p_mode)
 		return;
 
-	switch (timer_process_mode) {
-		case TIMER_PROCESS_PHYSICS:
-			if (is_physics_processing_internal()) {
-				set_physics_process_internal(false);
-				set_process_internal(true);
-			}
-			break;
-		case TIMER_PROCESS_IDLE:
-			if (is_processing_internal()) {
-				set_process_internal(false);
-				set_physics_process_internal(true);
-			}
-			break;
-	}
+	//the remaining time carries over to the other clock
+	_unschedule();
 	timer_process_mode = p_mode;
+	_update_schedule();
 }
 
 Timer::TimerProcessMode Timer::get_timer_process_mode() const {
@@ -172,11 +199,8 @@ Timer::TimerProcessMode Timer::get_timer_process_mode() const {
 }
 
 void Timer::_set_process(bool p_process, bool p_force) {
-	switch (timer_process_mode) {
-		case TIMER_PROCESS_PHYSICS: set_physics_process_internal(p_process && !paused); break;
-		case TIMER_PROCESS_IDLE: set_process_internal(p_process && !paused); break;
-	}
 	processing = p_process;
+	_update_schedule();
 }
 
 void Timer::_bind_methods() {
@@ -224,4 +248,7 @@ Timer::Timer() {
 	time_left = -1;
 	processing = false;
 	paused = false;
+	scheduled = false;
+	deadline = 0;
+	schedule_generation = 0;
 }
@@ -32,6 +32,7 @@
 #define TIMER_H
 
 #include "scene/main/node.h"
+#include "scene/main/scene_tree.h"
 
 class Timer : public Node {
 
@@ -45,6 +46,11 @@ class Timer : public Node {
 
 	double time_left;
 
+	//while running, the timer waits in the SceneTree timer queue instead of processing every frame
+	bool scheduled;
+	double deadline;
+	uint64_t schedule_generation;
+
 protected:
 	void _notification(int p_what);
 	static void _bind_methods();
@@ -76,11 +82,19 @@ public:
 
 	void set_timer_process_mode(TimerProcessMode p_mode);
 	TimerProcessMode get_timer_process_mode() const;
+
+	//used by SceneTree
+	bool _is_scheduled(uint64_t p_generation) const { return scheduled && schedule_generation == p_generation; }
+	void _timeout();
+
 	Timer();
 
 private:
 	TimerProcessMode timer_process_mode;
 	void _set_process(bool p_process, bool p_force = false);
+	void _update_schedule();
+	void _unschedule();
+	SceneTree::TimerClock _get_clock() const;
 };
 
 VARIANT_ENUM_CAST(Timer::TimerProcessMode);
@@ -201,6 +201,10 @@ Viewport::GUI::GUI() {
 	tooltip = NULL;
 	tooltip_popup = NULL;
 	tooltip_label = NULL;
+
+	find_cache_valid = false;
+	find_cache_drag_preview = NULL;
+	find_cache_frame = 0;
 }
 
 /////////////////////////////////////
@@ -1720,9 +1724,40 @@ void Viewport::_gui_call_notification(Control *p_control, int p_what) {
 }
 Control *Viewport::_gui_find_control(const Point2 &p_global) {
 
+	if (gui.roots_order_dirty) {
+		gui.find_cache_valid = false;
+	}
+
 	//aca va subwindows
 	_gui_sort_roots();
 
+	uint64_t frame = Engine::get_singleton()->get_idle_frames();
+
+	if (gui.find_cache_valid && gui.find_cache_frame == frame && gui.find_cache_pos == p_global && gui.find_cache_drag_preview == gui.drag_preview) {
+		if (gui.find_cache_control.is_null()) {
+			return NULL;
+		}
+		Control *c = Object::cast_to<Control>(ObjectDB::get_instance(gui.find_cache_control));
+		if (c && c->is_visible_in_tree()) {
+			gui.focus_inv_xform = gui.find_cache_inv_xform;
+			return c;
+		}
+	}
+
+	Control *ret = _gui_find_control_uncached(p_global);
+
+	gui.find_cache_valid = true;
+	gui.find_cache_frame = frame;
+	gui.find_cache_pos = p_global;
+	gui.find_cache_drag_preview = gui.drag_preview;
+	gui.find_cache_control = ret ? ret->get_instance_id() : ObjectID();
+	gui.find_cache_inv_xform = gui.focus_inv_xform;
+
+	return ret;
+}
+
+Control *Viewport::_gui_find_control_uncached(const Point2 &p_global) {
+
 	for (List<Control *>::Element *E = gui.roots.back(); E; E = E->prev()) {
 
 		Control *sw = E->get();
@@ -2502,6 +2537,8 @@ void Viewport::_gui_unfocus_control(Control *p_control) {
 
 void Viewport::_gui_hid_control(Control *p_control) {
 
+	gui.find_cache_valid = false;
+
 	if (gui.mouse_focus == p_control) {
 		_drop_mouse_focus();
 	}
@@ -2528,6 +2565,8 @@ void Viewport::_gui_hid_control(Control *p_control) {
 
 void Viewport::_gui_remove_control(Control *p_control) {
 
+	gui.find_cache_valid = false;
+
 	if (gui.mouse_focus == p_control) {
 		gui.mouse_focus = NULL;
 		gui.forced_mouse_focus = false;
@@ -3078,6 +3117,18 @@ void Viewport::unhandled_input(const Ref<InputEvent> &p_event, bool p_local_coor
 						Object::cast_to<InputEventKey>(*ev) //to remember state
 
 						)) {
+			//picking only cares about where the mouse ended up, so consecutive motions are merged into one query
+			Ref<InputEventMouseMotion> mm = ev;
+			if (mm.is_valid() && physics_picking_events.size()) {
+				Ref<InputEventMouseMotion> last_mm = physics_picking_events.back()->get();
+				if (last_mm.is_valid()) {
+					Ref<InputEventMouseMotion> merged = last_mm->xformed_by(Transform2D()); //make a copy
+					if (merged->accumulate(mm)) {
+						physics_picking_events.back()->get() = merged;
+						return;
+					}
+				}
+			}
 			physics_picking_events.push_back(ev);
 		}
 	}
@@ -3191,6 +3242,61 @@ Viewport::MSAA Viewport::get_msaa() const {
 	return msaa;
 }
 
+void Viewport::_update_dynamic_resolution() {
+
+	RS::get_singleton()->viewport_set_dynamic_resolution(viewport, dynamic_resolution_enabled, dynamic_resolution_target_frame_time, dynamic_resolution_min_scale, dynamic_resolution_max_scale);
+}
+
+void Viewport::set_dynamic_resolution_enabled(bool p_enabled) {
+
+	dynamic_resolution_enabled = p_enabled;
+	_update_dynamic_resolution();
+}
+
+bool Viewport::is_dynamic_resolution_enabled() const {
+
+	return dynamic_resolution_enabled;
+}
+
+void Viewport::set_dynamic_resolution_target_frame_time(float p_msec) {
+
+	ERR_FAIL_COND(p_msec <= 0.0);
+	dynamic_resolution_target_frame_time = p_msec;
+	_update_dynamic_resolution();
+}
+
+float Viewport::get_dynamic_resolution_target_frame_time() const {
+
+	return dynamic_resolution_target_frame_time;
+}
+
+void Viewport::set_dynamic_resolution_min_scale(float p_scale) {
+
+	dynamic_resolution_min_scale = CLAMP(p_scale, 0.1, 1.0);
+	_update_dynamic_resolution();
+}
+
+float Viewport::get_dynamic_resolution_min_scale() const {
+
+	return dynamic_resolution_min_scale;
+}
+
+void Viewport::set_dynamic_resolution_max_scale(float p_scale) {
+
+	dynamic_resolution_max_scale = CLAMP(p_scale, 0.1, 1.0);
+	_update_dynamic_resolution();
+}
+
+float Viewport::get_dynamic_resolution_max_scale() const {
+
+	return dynamic_resolution_max_scale;
+}
+
+float Viewport::get_render_scale() const {
+
+	return RS::get_singleton()->viewport_get_render_scale(viewport);
+}
+
 void Viewport::set_debug_draw(DebugDraw p_debug_draw) {
 
 	debug_draw = p_debug_draw;
@@ -3377,6 +3483,16 @@ void Viewport::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_msaa", "msaa"), &Viewport::set_msaa);
 	ClassDB::bind_method(D_METHOD("get_msaa"), &Viewport::get_msaa);
 
+	ClassDB::bind_method(D_METHOD("set_dynamic_resolution_enabled", "enabled"), &Viewport::set_dynamic_resolution_enabled);
+	ClassDB::bind_method(D_METHOD("is_dynamic_resolution_enabled"), &Viewport::is_dynamic_resolution_enabled);
+	ClassDB::bind_method(D_METHOD("set_dynamic_resolution_target_frame_time", "msec"), &Viewport::set_dynamic_resolution_target_frame_time);
+	ClassDB::bind_method(D_METHOD("get_dynamic_resolution_target_frame_time"), &Viewport::get_dynamic_resolution_target_frame_time);
+	ClassDB::bind_method(D_METHOD("set_dynamic_resolution_min_scale", "scale"), &Viewport::set_dynamic_resolution_min_scale);
+	ClassDB::bind_method(D_METHOD("get_dynamic_resolution_min_scale"), &Viewport::get_dynamic_resolution_min_scale);
+	ClassDB::bind_method(D_METHOD("set_dynamic_resolution_max_scale", "scale"), &Viewport::set_dynamic_resolution_max_scale);
+	ClassDB::bind_method(D_METHOD("get_dynamic_resolution_max_scale"), &Viewport::get_dynamic_resolution_max_scale);
+	ClassDB::bind_method(D_METHOD("get_render_scale"), &Viewport::get_render_scale);
+
 	ClassDB::bind_method(D_METHOD("set_debug_draw", "debug_draw"), &Viewport::set_debug_draw);
 	ClassDB::bind_method(D_METHOD("get_debug_draw"), &Viewport::get_debug_draw);
 
@@ -3451,6 +3567,11 @@ void Viewport::_bind_methods() {
 	ADD_GROUP("Rendering", "");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "msaa", PROPERTY_HINT_ENUM, "Disabled,2x,4x,8x,16x,AndroidVR 2x,AndroidVR 4x"), "set_msaa", "get_msaa");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "debug_draw", PROPERTY_HINT_ENUM, "Disabled,Unshaded,Overdraw,Wireframe"), "set_debug_draw", "get_debug_draw");
+	ADD_GROUP("Dynamic Resolution", "dynamic_resolution_");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "dynamic_resolution_enabled"), "set_dynamic_resolution_enabled", "is_dynamic_resolution_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "dynamic_resolution_target_frame_time", PROPERTY_HINT_RANGE, "1,100,0.1"), "set_dynamic_resolution_target_frame_time", "get_dynamic_resolution_target_frame_time");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "dynamic_resolution_min_scale", PROPERTY_HINT_RANGE, "0.1,1,0.05"), "set_dynamic_resolution_min_scale", "get_dynamic_resolution_min_scale");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "dynamic_resolution_max_scale", PROPERTY_HINT_RANGE, "0.1,1,0.05"), "set_dynamic_resolution_max_scale", "get_dynamic_resolution_max_scale");
 	ADD_GROUP("Canvas Items", "canvas_item_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "canvas_item_default_texture_filter", PROPERTY_HINT_ENUM, "Nearest,Linear,MipmapLinear,MipmapNearest"), "set_default_canvas_item_texture_filter", "get_default_canvas_item_texture_filter");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "canvas_item_default_texture_repeat", PROPERTY_HINT_ENUM, "Disabled,Enabled,Mirror"), "set_default_canvas_item_texture_repeat", "get_default_canvas_item_texture_repeat");
@@ -3504,6 +3625,7 @@ void Viewport::_bind_methods() {
 	BIND_ENUM_CONSTANT(DEBUG_DRAW_DIRECTIONAL_SHADOW_ATLAS);
 	BIND_ENUM_CONSTANT(DEBUG_DRAW_SCENE_LUMINANCE);
 	BIND_ENUM_CONSTANT(DEBUG_DRAW_SSAO);
+	BIND_ENUM_CONSTANT(DEBUG_DRAW_OCCLUSION_BUFFER);
 
 	BIND_ENUM_CONSTANT(MSAA_DISABLED);
 	BIND_ENUM_CONSTANT(MSAA_2X);
@@ -3591,6 +3713,11 @@ Viewport::Viewport() {
 
 	msaa = MSAA_DISABLED;
 
+	dynamic_resolution_enabled = false;
+	dynamic_resolution_target_frame_time = 16.667;
+	dynamic_resolution_min_scale = 0.5;
+	dynamic_resolution_max_scale = 1.0;
+
 	debug_draw = DEBUG_DRAW_DISABLED;
 
 	snap_controls_to_pixels = true;
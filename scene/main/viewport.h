@@ -133,7 +133,8 @@ public:
 		DEBUG_DRAW_DIRECTIONAL_SHADOW_ATLAS,
 		DEBUG_DRAW_SCENE_LUMINANCE,
 		DEBUG_DRAW_SSAO,
-		DEBUG_DRAW_ROUGHNESS_LIMITER
+		DEBUG_DRAW_ROUGHNESS_LIMITER,
+		DEBUG_DRAW_OCCLUSION_BUFFER
 	};
 
 	enum DefaultCanvasItemTextureFilter {
@@ -271,6 +272,13 @@ private:
 	ShadowAtlasQuadrantSubdiv shadow_atlas_quadrant_subdiv[4];
 
 	MSAA msaa;
+
+	bool dynamic_resolution_enabled;
+	float dynamic_resolution_target_frame_time;
+	float dynamic_resolution_min_scale;
+	float dynamic_resolution_max_scale;
+	void _update_dynamic_resolution();
+
 	Ref<ViewportTexture> default_texture;
 	Set<ViewportTexture *> viewport_textures;
 
@@ -326,6 +334,13 @@ private:
 		Transform2D focus_inv_xform;
 		bool roots_order_dirty;
 		List<Control *> roots;
+		//last result of _gui_find_control, reused for lookups at the same position within a frame
+		bool find_cache_valid;
+		Point2 find_cache_pos;
+		ObjectID find_cache_control;
+		Transform2D find_cache_inv_xform;
+		Control *find_cache_drag_preview;
+		uint64_t find_cache_frame;
 		int canvas_sort_index; //for sorting items with canvas as root
 		bool dragging;
 		bool embed_subwindows_hint;
@@ -358,6 +373,7 @@ private:
 
 	void _gui_sort_roots();
 	Control *_gui_find_control(const Point2 &p_global);
+	Control *_gui_find_control_uncached(const Point2 &p_global);
 	Control *_gui_find_control_at_pos(CanvasItem *p_node, const Point2 &p_global, const Transform2D &p_xform, Transform2D &r_inv_xform);
 
 	void _gui_input_event(Ref<InputEvent> p_event);
@@ -503,6 +519,20 @@ public:
 	void set_msaa(MSAA p_msaa);
 	MSAA get_msaa() const;
 
+	void set_dynamic_resolution_enabled(bool p_enabled);
+	bool is_dynamic_resolution_enabled() const;
+
+	void set_dynamic_resolution_target_frame_time(float p_msec);
+	float get_dynamic_resolution_target_frame_time() const;
+
+	void set_dynamic_resolution_min_scale(float p_scale);
+	float get_dynamic_resolution_min_scale() const;
+
+	void set_dynamic_resolution_max_scale(float p_scale);
+	float get_dynamic_resolution_max_scale() const;
+
+	float get_render_scale() const;
+
 	Vector2 get_camera_coords(const Vector2 &p_viewport_coords) const;
 	Vector2 get_camera_rect_size() const;
 
@@ -125,6 +125,7 @@
 #include "scene/main/http_request.h"
 #include "scene/main/instance_placeholder.h"
 #include "scene/main/resource_preloader.h"
+#include "scene/main/scene_pool.h"
 #include "scene/main/scene_tree.h"
 #include "scene/main/timer.h"
 #include "scene/main/viewport.h"
@@ -620,6 +621,7 @@ void register_scene_types() {
 
 	ClassDB::register_virtual_class<Mesh>();
 	ClassDB::register_class<ArrayMesh>();
+	ResourceLoader::add_headless_stripped_property("ArrayMesh", "_surfaces"); //keeps vertex counts and AABBs, drops the buffers
 	ClassDB::register_class<MultiMesh>();
 	ClassDB::register_class<SurfaceTool>();
 	ClassDB::register_class<MeshDataTool>();
@@ -742,6 +744,7 @@ void register_scene_types() {
 
 	ClassDB::register_virtual_class<SceneState>();
 	ClassDB::register_class<PackedScene>();
+	ClassDB::register_class<ScenePool>();
 
 	ClassDB::register_class<SceneTree>();
 	ClassDB::register_virtual_class<SceneTreeTimer>(); //sorry, you can't create it
@@ -896,6 +899,7 @@ void register_scene_types() {
 void unregister_scene_types() {
 
 	SceneDebugger::deinitialize();
+	HTTPRequest::clear_connection_pool();
 	clear_default_theme();
 
 	ResourceLoader::remove_resource_format_loader(resource_loader_dynamic_font);
@@ -931,5 +935,6 @@ void unregister_scene_types() {
 
 	ParticlesMaterial::finish_shaders();
 	CanvasItemMaterial::finish_shaders();
+	StreamTexture::finish_streaming();
 	SceneStringNames::free();
 }
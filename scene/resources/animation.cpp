@@ -31,6 +31,7 @@
 #include "animation.h"
 #include "scene/scene_string_names.h"
 
+#include "core/io/marshalls.h"
 #include "core/math/geometry.h"
 
 #define ANIM_MIN_LENGTH 0.001
@@ -86,7 +87,12 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 			track_set_imported(track, p_value);
 		else if (what == "enabled")
 			track_set_enabled(track, p_value);
-		else if (what == "keys" || what == "key_values") {
+		else if (what == "compressed") {
+
+			ERR_FAIL_COND_V(track_get_type(track) != TYPE_TRANSFORM, false);
+			return _transform_track_set_compressed(static_cast<TransformTrack *>(tracks[track]), p_value);
+
+		} else if (what == "keys" || what == "key_values") {
 
 			if (track_get_type(track) == TYPE_TRANSFORM) {
 
@@ -97,6 +103,8 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 
 				const float *r = values.ptr();
 
+				tt->compressed = CompressedTransforms();
+
 				tt->transforms.resize(vcount / 12);
 
 				for (int i = 0; i < (vcount / 12); i++) {
@@ -369,7 +377,13 @@ bool Animation::_get(const StringName &p_name, Variant &r_ret) const {
 			r_ret = track_is_imported(track);
 		else if (what == "enabled")
 			r_ret = track_is_enabled(track);
-		else if (what == "keys") {
+		else if (what == "compressed") {
+
+			ERR_FAIL_COND_V(track_get_type(track) != TYPE_TRANSFORM, false);
+			r_ret = _transform_track_get_compressed(static_cast<const TransformTrack *>(tracks[track]));
+			return true;
+
+		} else if (what == "keys") {
 
 			if (track_get_type(track) == TYPE_TRANSFORM) {
 
@@ -607,7 +621,11 @@ void Animation::_get_property_list(List<PropertyInfo> *p_list) const {
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/loop_wrap", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/imported", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/enabled", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
-		p_list->push_back(PropertyInfo(Variant::ARRAY, "tracks/" + itos(i) + "/keys", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		if (tracks[i]->type == TYPE_TRANSFORM && static_cast<const TransformTrack *>(tracks[i])->is_compressed()) {
+			p_list->push_back(PropertyInfo(Variant::DICTIONARY, "tracks/" + itos(i) + "/compressed", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		} else {
+			p_list->push_back(PropertyInfo(Variant::ARRAY, "tracks/" + itos(i) + "/keys", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		}
 	}
 }
 
@@ -836,14 +854,22 @@ Error Animation::transform_track_get_key(int p_track, int p_key, Vector3 *r_loc,
 
 	TransformTrack *tt = static_cast<TransformTrack *>(t);
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, ERR_INVALID_PARAMETER);
-	ERR_FAIL_INDEX_V(p_key, tt->transforms.size(), ERR_INVALID_PARAMETER);
+
+	TransformKey key;
+	if (tt->is_compressed()) {
+		ERR_FAIL_INDEX_V(p_key, tt->compressed.size(), ERR_INVALID_PARAMETER);
+		key = tt->compressed.key(p_key).value;
+	} else {
+		ERR_FAIL_INDEX_V(p_key, tt->transforms.size(), ERR_INVALID_PARAMETER);
+		key = tt->transforms[p_key].value;
+	}
 
 	if (r_loc)
-		*r_loc = tt->transforms[p_key].value.loc;
+		*r_loc = key.loc;
 	if (r_rot)
-		*r_rot = tt->transforms[p_key].value.rot;
+		*r_rot = key.rot;
 	if (r_scale)
-		*r_scale = tt->transforms[p_key].value.scale;
+		*r_scale = key.scale;
 
 	return OK;
 }
@@ -855,6 +881,7 @@ int Animation::transform_track_insert_key(int p_track, float p_time, const Vecto
 	ERR_FAIL_COND_V(t->type != TYPE_TRANSFORM, -1);
 
 	TransformTrack *tt = static_cast<TransformTrack *>(t);
+	_transform_track_decompress(tt);
 
 	TKey<TransformKey> tkey;
 	tkey.time = p_time;
@@ -883,6 +910,7 @@ void Animation::track_remove_key(int p_track, int p_idx) {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_idx, tt->transforms.size());
 			tt->transforms.remove(p_idx);
 
@@ -936,6 +964,14 @@ int Animation::track_find_key(int p_track, float p_time, bool p_exact) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->is_compressed()) {
+				int k = _find_keys(tt->compressed, p_time);
+				if (k < 0 || k >= tt->compressed.size())
+					return -1;
+				if (tt->compressed.time(k) != p_time && p_exact)
+					return -1;
+				return k;
+			}
 			int k = _find(tt->transforms, p_time);
 			if (k < 0 || k >= tt->transforms.size())
 				return -1;
@@ -1121,6 +1157,8 @@ int Animation::track_get_key_count(int p_track) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->is_compressed())
+				return tt->compressed.size();
 			return tt->transforms.size();
 		} break;
 		case TYPE_VALUE: {
@@ -1164,12 +1202,20 @@ Variant Animation::track_get_key_value(int p_track, int p_key_idx) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
-			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), Variant());
+
+			TransformKey key;
+			if (tt->is_compressed()) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed.size(), Variant());
+				key = tt->compressed.key(p_key_idx).value;
+			} else {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), Variant());
+				key = tt->transforms[p_key_idx].value;
+			}
 
 			Dictionary d;
-			d["location"] = tt->transforms[p_key_idx].value.loc;
-			d["rotation"] = tt->transforms[p_key_idx].value.rot;
-			d["scale"] = tt->transforms[p_key_idx].value.scale;
+			d["location"] = key.loc;
+			d["rotation"] = key.rot;
+			d["scale"] = key.scale;
 
 			return d;
 		} break;
@@ -1240,6 +1286,10 @@ float Animation::track_get_key_time(int p_track, int p_key_idx) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->is_compressed()) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed.size(), -1);
+				return tt->compressed.time(p_key_idx);
+			}
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
 			return tt->transforms[p_key_idx].time;
 		} break;
@@ -1293,6 +1343,7 @@ void Animation::track_set_key_time(int p_track, int p_key_idx, float p_time) {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 			TKey<TransformKey> key = tt->transforms[p_key_idx];
 			key.time = p_time;
@@ -1365,6 +1416,10 @@ float Animation::track_get_key_transition(int p_track, int p_key_idx) const {
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			if (tt->is_compressed()) {
+				ERR_FAIL_INDEX_V(p_key_idx, tt->compressed.size(), -1);
+				return tt->compressed.transition(p_key_idx);
+			}
 			ERR_FAIL_INDEX_V(p_key_idx, tt->transforms.size(), -1);
 			return tt->transforms[p_key_idx].transition;
 		} break;
@@ -1409,6 +1464,7 @@ void Animation::track_set_key_value(int p_track, int p_key_idx, const Variant &p
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 
 			Dictionary d = p_value;
@@ -1495,6 +1551,7 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_tra
 		case TYPE_TRANSFORM: {
 
 			TransformTrack *tt = static_cast<TransformTrack *>(t);
+			_transform_track_decompress(tt);
 			ERR_FAIL_INDEX(p_key_idx, tt->transforms.size());
 			tt->transforms.write[p_key_idx].transition = p_transition;
 		} break;
@@ -1523,12 +1580,31 @@ void Animation::track_set_key_transition(int p_track, int p_key_idx, float p_tra
 }
 
 template <class K>
-int Animation::_find(const Vector<K> &p_keys, float p_time) const {
+int Animation::_find(const Vector<K> &p_keys, float p_time, int *r_cursor) const {
+
+	return _find_keys(KeyArray<K>(p_keys), p_time, r_cursor);
+}
+
+template <class A>
+int Animation::_find_keys(const A &p_keys, float p_time, int *r_cursor) const {
 
 	int len = p_keys.size();
 	if (len == 0)
 		return -2;
 
+	if (r_cursor && *r_cursor >= 0 && *r_cursor < len) {
+		//playback mostly stays on the same key or moves to the next one, check those before searching
+		int to = MIN(*r_cursor + 2, len);
+		for (int i = *r_cursor; i < to; i++) {
+			if (p_keys.time(i) > p_time && !Math::is_equal_approx(p_keys.time(i), p_time))
+				break;
+			if (i + 1 == len || (p_keys.time(i + 1) > p_time && !Math::is_equal_approx(p_keys.time(i + 1), p_time))) {
+				*r_cursor = i;
+				return i;
+			}
+		}
+	}
+
 	int low = 0;
 	int high = len - 1;
 	int middle = 0;
@@ -1538,23 +1614,26 @@ int Animation::_find(const Vector<K> &p_keys, float p_time) const {
 		ERR_PRINT("low > high, this may be a bug");
 #endif
 
-	const K *keys = &p_keys[0];
-
 	while (low <= high) {
 
 		middle = (low + high) / 2;
 
-		if (Math::is_equal_approx(p_time, keys[middle].time)) { //match
+		if (Math::is_equal_approx(p_time, p_keys.time(middle))) { //match
+			if (r_cursor)
+				*r_cursor = middle;
 			return middle;
-		} else if (p_time < keys[middle].time)
+		} else if (p_time < p_keys.time(middle))
 			high = middle - 1; //search low end of array
 		else
 			low = middle + 1; //search high end of array
 	}
 
-	if (keys[middle].time > p_time)
+	if (p_keys.time(middle) > p_time)
 		middle--;
 
+	if (r_cursor)
+		*r_cursor = middle;
+
 	return middle;
 }
 
@@ -1705,9 +1784,18 @@ float Animation::_cubic_interpolate(const float &p_pre_a, const float &p_a, cons
 }
 
 template <class T>
-T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const {
+T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_cursor) const {
+
+	return _interpolate_keys<T>(KeyArray<TKey<T>>(p_keys), p_time, p_interp, p_loop_wrap, p_ok, r_cursor);
+}
 
-	int len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+template <class T, class A>
+T Animation::_interpolate_keys(const A &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_cursor) const {
+
+	int len = p_keys.size();
+	if (len && p_keys.time(len - 1) > length) {
+		len = _find_keys(p_keys, length) + 1; // try to find last key (there may be more past the end)
+	}
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
@@ -1719,10 +1807,10 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, Interpola
 
 		if (p_ok)
 			*p_ok = true;
-		return p_keys[0].value;
+		return p_keys.key(0).value;
 	}
 
-	int idx = _find(p_keys, p_time);
+	int idx = _find_keys(p_keys, p_time, r_cursor);
 
 	ERR_FAIL_COND_V(idx == -2, T());
 
@@ -1738,8 +1826,8 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, Interpola
 			if ((idx + 1) < len) {
 
 				next = idx + 1;
-				float delta = p_keys[next].time - p_keys[idx].time;
-				float from = p_time - p_keys[idx].time;
+				float delta = p_keys.time(next) - p_keys.time(idx);
+				float from = p_time - p_keys.time(idx);
 
 				if (Math::is_zero_approx(delta))
 					c = 0;
@@ -1749,8 +1837,8 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, Interpola
 			} else {
 
 				next = 0;
-				float delta = (length - p_keys[idx].time) + p_keys[next].time;
-				float from = p_time - p_keys[idx].time;
+				float delta = (length - p_keys.time(idx)) + p_keys.time(next);
+				float from = p_time - p_keys.time(idx);
 
 				if (Math::is_zero_approx(delta))
 					c = 0;
@@ -1762,10 +1850,10 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, Interpola
 			// on loop, behind first key
 			idx = len - 1;
 			next = 0;
-			float endtime = (length - p_keys[idx].time);
+			float endtime = (length - p_keys.time(idx));
 			if (endtime < 0) // may be keys past the end
 				endtime = 0;
-			float delta = endtime + p_keys[next].time;
+			float delta = endtime + p_keys.time(next);
 			float from = endtime + p_time;
 
 			if (Math::is_zero_approx(delta))
@@ -1781,8 +1869,8 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, Interpola
 			if ((idx + 1) < len) {
 
 				next = idx + 1;
-				float delta = p_keys[next].time - p_keys[idx].time;
-				float from = p_time - p_keys[idx].time;
+				float delta = p_keys.time(next) - p_keys.time(idx);
+				float from = p_time - p_keys.time(idx);
 
 				if (Math::is_zero_approx(delta))
 					c = 0;
@@ -1809,11 +1897,11 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, Interpola
 	if (!result)
 		return T();
 
-	float tr = p_keys[idx].transition;
+	float tr = p_keys.transition(idx);
 
 	if (tr == 0 || idx == next) {
 		// don't interpolate if not needed
-		return p_keys[idx].value;
+		return p_keys.key(idx).value;
 	}
 
 	if (tr != 1.0) {
@@ -1825,11 +1913,11 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, Interpola
 
 		case INTERPOLATION_NEAREST: {
 
-			return p_keys[idx].value;
+			return p_keys.key(idx).value;
 		} break;
 		case INTERPOLATION_LINEAR: {
 
-			return _interpolate(p_keys[idx].value, p_keys[next].value, c);
+			return _interpolate(p_keys.key(idx).value, p_keys.key(next).value, c);
 		} break;
 		case INTERPOLATION_CUBIC: {
 			int pre = idx - 1;
@@ -1839,16 +1927,16 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, float p_time, Interpola
 			if (post >= len)
 				post = next;
 
-			return _cubic_interpolate(p_keys[pre].value, p_keys[idx].value, p_keys[next].value, p_keys[post].value, c);
+			return _cubic_interpolate(p_keys.key(pre).value, p_keys.key(idx).value, p_keys.key(next).value, p_keys.key(post).value, c);
 
 		} break;
-		default: return p_keys[idx].value;
+		default: return p_keys.key(idx).value;
 	}
 
 	// do a barrel roll
 }
 
-Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const {
+Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *r_cursor) const {
 
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
@@ -1858,7 +1946,11 @@ Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3
 
 	bool ok = false;
 
-	TransformKey tk = _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok);
+	TransformKey tk;
+	if (tt->is_compressed())
+		tk = _interpolate_keys<TransformKey>(tt->compressed, p_time, tt->interpolation, tt->loop_wrap, &ok, r_cursor);
+	else
+		tk = _interpolate(tt->transforms, p_time, tt->interpolation, tt->loop_wrap, &ok, r_cursor);
 
 	if (!ok)
 		return ERR_UNAVAILABLE;
@@ -1875,7 +1967,7 @@ Error Animation::transform_track_interpolate(int p_track, float p_time, Vector3
 	return OK;
 }
 
-Variant Animation::value_track_interpolate(int p_track, float p_time) const {
+Variant Animation::value_track_interpolate(int p_track, float p_time, int *r_cursor) const {
 
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), 0);
 	Track *t = tracks[p_track];
@@ -1884,7 +1976,7 @@ Variant Animation::value_track_interpolate(int p_track, float p_time) const {
 
 	bool ok = false;
 
-	Variant res = _interpolate(vt->values, p_time, (vt->update_mode == UPDATE_CONTINUOUS || vt->update_mode == UPDATE_CAPTURE) ? vt->interpolation : INTERPOLATION_NEAREST, vt->loop_wrap, &ok);
+	Variant res = _interpolate(vt->values, p_time, (vt->update_mode == UPDATE_CONTINUOUS || vt->update_mode == UPDATE_CAPTURE) ? vt->interpolation : INTERPOLATION_NEAREST, vt->loop_wrap, &ok, r_cursor);
 
 	if (ok) {
 
@@ -1994,27 +2086,33 @@ Animation::UpdateMode Animation::value_track_get_update_mode(int p_track) const
 template <class T>
 void Animation::_track_get_key_indices_in_range(const Vector<T> &p_array, float from_time, float to_time, List<int> *p_indices) const {
 
+	_keys_get_indices_in_range(KeyArray<T>(p_array), from_time, to_time, p_indices);
+}
+
+template <class A>
+void Animation::_keys_get_indices_in_range(const A &p_keys, float from_time, float to_time, List<int> *p_indices) const {
+
 	if (from_time != length && to_time == length)
 		to_time = length * 1.01; //include a little more if at the end
 
-	int to = _find(p_array, to_time);
+	int to = _find_keys(p_keys, to_time);
 
 	// can't really send the events == time, will be sent in the next frame.
 	// if event>=len then it will probably never be requested by the anim player.
 
-	if (to >= 0 && p_array[to].time >= to_time)
+	if (to >= 0 && p_keys.time(to) >= to_time)
 		to--;
 
 	if (to < 0)
 		return; // not bother
 
-	int from = _find(p_array, from_time);
+	int from = _find_keys(p_keys, from_time);
 
 	// position in the right first event.+
-	if (from < 0 || p_array[from].time < from_time)
+	if (from < 0 || p_keys.time(from) < from_time)
 		from++;
 
-	int max = p_array.size();
+	int max = p_keys.size();
 
 	for (int i = from; i <= to; i++) {
 
@@ -2050,8 +2148,13 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
 				case TYPE_TRANSFORM: {
 
 					const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-					_track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
-					_track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+					if (tt->is_compressed()) {
+						_keys_get_indices_in_range(tt->compressed, from_time, length, p_indices);
+						_keys_get_indices_in_range(tt->compressed, 0, to_time, p_indices);
+					} else {
+						_track_get_key_indices_in_range(tt->transforms, from_time, length, p_indices);
+						_track_get_key_indices_in_range(tt->transforms, 0, to_time, p_indices);
+					}
 
 				} break;
 				case TYPE_VALUE: {
@@ -2110,7 +2213,10 @@ void Animation::track_get_key_indices_in_range(int p_track, float p_time, float
 		case TYPE_TRANSFORM: {
 
 			const TransformTrack *tt = static_cast<const TransformTrack *>(t);
-			_track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
+			if (tt->is_compressed())
+				_keys_get_indices_in_range(tt->compressed, from_time, to_time, p_indices);
+			else
+				_track_get_key_indices_in_range(tt->transforms, from_time, to_time, p_indices);
 
 		} break;
 		case TYPE_VALUE: {
@@ -2810,6 +2916,9 @@ void Animation::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("clear"), &Animation::clear);
 	ClassDB::bind_method(D_METHOD("copy_track", "track_idx", "to_animation"), &Animation::copy_track);
 
+	ClassDB::bind_method(D_METHOD("compress"), &Animation::compress);
+	ClassDB::bind_method(D_METHOD("track_is_compressed", "track_idx"), &Animation::track_is_compressed);
+
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "length", PROPERTY_HINT_RANGE, "0.001,99999,0.001"), "set_length", "get_length");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "loop"), "set_loop", "has_loop");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "step", PROPERTY_HINT_RANGE, "0,4096,0.001"), "set_step", "get_step");
@@ -3019,6 +3128,8 @@ void Animation::_transform_track_optimize(int p_idx, float p_allowed_linear_err,
 	ERR_FAIL_INDEX(p_idx, tracks.size());
 	ERR_FAIL_COND(tracks[p_idx]->type != TYPE_TRANSFORM);
 	TransformTrack *tt = static_cast<TransformTrack *>(tracks[p_idx]);
+	if (tt->is_compressed())
+		return; // keys were already reduced before compressing
 	bool prev_erased = false;
 	TKey<TransformKey> first_erased;
 
@@ -3066,6 +3177,320 @@ void Animation::optimize(float p_allowed_linear_err, float p_allowed_angular_err
 	}
 }
 
+static _FORCE_INLINE_ uint16_t _quantize_key_value(real_t p_value, real_t p_min, real_t p_step) {
+
+	if (p_step == 0)
+		return 0;
+	return CLAMP(int(Math::round((p_value - p_min) / p_step)), 0, 65535);
+}
+
+// Smallest three: the largest component is dropped and rebuilt from the other three, which all fall
+// within +-1/sqrt(2) and get 15 bits each. The top bits of the first two hold which one was dropped.
+static void _compress_quat(const Quat &p_rot, uint16_t *r_dst) {
+
+	Quat q = p_rot.normalized();
+	real_t c[4] = { q.x, q.y, q.z, q.w };
+
+	int largest = 0;
+	for (int i = 1; i < 4; i++) {
+		if (Math::abs(c[i]) > Math::abs(c[largest]))
+			largest = i;
+	}
+	real_t sign = c[largest] < 0 ? -1 : 1; // q and -q are the same rotation, keep the dropped one positive
+
+	int j = 0;
+	for (int i = 0; i < 4; i++) {
+		if (i == largest)
+			continue;
+		real_t v = c[i] * sign * Math_SQRT2 * 0.5 + 0.5;
+		r_dst[j++] = CLAMP(int(Math::round(v * 32767.0)), 0, 32767);
+	}
+
+	r_dst[0] |= (largest & 1) << 15;
+	r_dst[1] |= (largest >> 1) << 15;
+}
+
+static _FORCE_INLINE_ Quat _decompress_quat(const uint16_t *p_src) {
+
+	int largest = (p_src[0] >> 15) | ((p_src[1] >> 15) << 1);
+	real_t c[4];
+	real_t sum = 0;
+
+	int j = 0;
+	for (int i = 0; i < 4; i++) {
+		if (i == largest)
+			continue;
+		real_t v = ((p_src[j++] & 0x7FFF) * (1.0 / 32767.0) * 2.0 - 1.0) * Math_SQRT12;
+		c[i] = v;
+		sum += v * v;
+	}
+	c[largest] = Math::sqrt(MAX(0, 1.0 - sum));
+
+	return Quat(c[0], c[1], c[2], c[3]);
+}
+
+Animation::TKey<Animation::TransformKey> Animation::CompressedTransforms::key(int p_idx) const {
+
+	const CompressedPage &page = pages.ptr()[p_idx / COMPRESSED_PAGE_KEYS];
+	const uint16_t *src = &data.ptr()[page.data_offset + (p_idx % COMPRESSED_PAGE_KEYS) * page.stride];
+
+	TKey<TransformKey> key;
+	key.time = page.time_begin + page.time_step * src[0];
+	src++;
+
+	if (page.flags & COMPRESSED_LOC_CONSTANT) {
+		key.value.loc = page.loc_min;
+	} else {
+		key.value.loc = page.loc_min + Vector3(src[0], src[1], src[2]) * page.loc_step;
+		src += 3;
+	}
+
+	if (page.flags & COMPRESSED_ROT_CONSTANT) {
+		key.value.rot = page.rot;
+	} else {
+		key.value.rot = _decompress_quat(src);
+		src += 3;
+	}
+
+	if (page.flags & COMPRESSED_SCALE_CONSTANT) {
+		key.value.scale = page.scale_min;
+	} else {
+		key.value.scale = page.scale_min + Vector3(src[0], src[1], src[2]) * page.scale_step;
+	}
+
+	return key;
+}
+
+void Animation::_transform_track_compress(TransformTrack *p_track) {
+
+	const Vector<TKey<TransformKey>> &keys = p_track->transforms;
+	int count = keys.size();
+
+	CompressedTransforms compressed;
+	compressed.key_count = count;
+
+	for (int from = 0; from < count; from += COMPRESSED_PAGE_KEYS) {
+
+		int to = MIN(from + COMPRESSED_PAGE_KEYS, count);
+
+		Vector3 loc_min = keys[from].value.loc;
+		Vector3 loc_max = loc_min;
+		Vector3 scale_min = keys[from].value.scale;
+		Vector3 scale_max = scale_min;
+		Quat rot = keys[from].value.rot.normalized();
+		bool rot_constant = true;
+
+		for (int i = from + 1; i < to; i++) {
+			const TransformKey &k = keys[i].value;
+			for (int j = 0; j < 3; j++) {
+				loc_min[j] = MIN(loc_min[j], k.loc[j]);
+				loc_max[j] = MAX(loc_max[j], k.loc[j]);
+				scale_min[j] = MIN(scale_min[j], k.scale[j]);
+				scale_max[j] = MAX(scale_max[j], k.scale[j]);
+			}
+			Quat r = k.rot.normalized();
+			if (rot.dot(r) < 0)
+				r = -r;
+			if (rot_constant && !rot.is_equal_approx(r))
+				rot_constant = false;
+		}
+
+		CompressedPage page;
+		page.time_begin = keys[from].time;
+		page.time_step = (keys[to - 1].time - page.time_begin) / 65535.0;
+		page.flags = 0;
+		page.loc_min = loc_min;
+		page.loc_step = (loc_max - loc_min) / 65535.0;
+		page.rot = rot;
+		page.scale_min = scale_min;
+		page.scale_step = (scale_max - scale_min) / 65535.0;
+
+		if (loc_max.is_equal_approx(loc_min))
+			page.flags |= COMPRESSED_LOC_CONSTANT;
+		if (rot_constant)
+			page.flags |= COMPRESSED_ROT_CONSTANT;
+		if (scale_max.is_equal_approx(scale_min))
+			page.flags |= COMPRESSED_SCALE_CONSTANT;
+
+		page.stride = CompressedPage::get_stride(page.flags);
+		page.data_offset = compressed.data.size();
+
+		compressed.data.resize(page.data_offset + (to - from) * page.stride);
+		uint16_t *dst = &compressed.data.ptrw()[page.data_offset];
+
+		for (int i = from; i < to; i++) {
+
+			const TransformKey &k = keys[i].value;
+			*dst++ = page.time_step > 0 ? _quantize_key_value(keys[i].time, page.time_begin, page.time_step) : 0;
+
+			if (!(page.flags & COMPRESSED_LOC_CONSTANT)) {
+				for (int j = 0; j < 3; j++)
+					*dst++ = _quantize_key_value(k.loc[j], page.loc_min[j], page.loc_step[j]);
+			}
+			if (!(page.flags & COMPRESSED_ROT_CONSTANT)) {
+				_compress_quat(k.rot, dst);
+				dst += 3;
+			}
+			if (!(page.flags & COMPRESSED_SCALE_CONSTANT)) {
+				for (int j = 0; j < 3; j++)
+					*dst++ = _quantize_key_value(k.scale[j], page.scale_min[j], page.scale_step[j]);
+			}
+		}
+
+		compressed.pages.push_back(page);
+	}
+
+	p_track->compressed = compressed;
+	p_track->transforms.clear();
+}
+
+void Animation::_transform_track_decompress(TransformTrack *p_track) {
+
+	if (!p_track->is_compressed())
+		return;
+
+	const CompressedTransforms &compressed = p_track->compressed;
+	p_track->transforms.resize(compressed.size());
+	TKey<TransformKey> *w = p_track->transforms.ptrw();
+	for (int i = 0; i < compressed.size(); i++) {
+		w[i] = compressed.key(i);
+	}
+
+	p_track->compressed = CompressedTransforms();
+}
+
+// Page headers go in a float array, 19 values each. Strides and data offsets are rebuilt on load.
+Dictionary Animation::_transform_track_get_compressed(const TransformTrack *p_track) const {
+
+	const CompressedTransforms &compressed = p_track->compressed;
+
+	Vector<float> pages;
+	pages.resize(compressed.pages.size() * 19);
+	float *w = pages.ptrw();
+	for (int i = 0; i < compressed.pages.size(); i++) {
+		const CompressedPage &page = compressed.pages[i];
+		*w++ = page.time_begin;
+		*w++ = page.time_step;
+		*w++ = page.flags;
+		for (int j = 0; j < 3; j++)
+			*w++ = page.loc_min[j];
+		for (int j = 0; j < 3; j++)
+			*w++ = page.loc_step[j];
+		*w++ = page.rot.x;
+		*w++ = page.rot.y;
+		*w++ = page.rot.z;
+		*w++ = page.rot.w;
+		for (int j = 0; j < 3; j++)
+			*w++ = page.scale_min[j];
+		for (int j = 0; j < 3; j++)
+			*w++ = page.scale_step[j];
+	}
+
+	Vector<uint8_t> data;
+	data.resize(compressed.data.size() * 2);
+	uint8_t *d = data.ptrw();
+	for (int i = 0; i < compressed.data.size(); i++) {
+		d += encode_uint16(compressed.data[i], d);
+	}
+
+	Dictionary ret;
+	ret["key_count"] = compressed.key_count;
+	ret["pages"] = pages;
+	ret["data"] = data;
+	return ret;
+}
+
+bool Animation::_transform_track_set_compressed(TransformTrack *p_track, const Dictionary &p_compressed) {
+
+	ERR_FAIL_COND_V(!p_compressed.has("key_count") || !p_compressed.has("pages") || !p_compressed.has("data"), false);
+
+	CompressedTransforms compressed;
+	compressed.key_count = p_compressed["key_count"];
+	Vector<float> pages = p_compressed["pages"];
+	Vector<uint8_t> data = p_compressed["data"];
+
+	int page_count = (compressed.key_count + COMPRESSED_PAGE_KEYS - 1) / COMPRESSED_PAGE_KEYS;
+	ERR_FAIL_COND_V(compressed.key_count < 0 || pages.size() != page_count * 19, false);
+
+	const float *r = pages.ptr();
+	uint32_t data_size = 0;
+	compressed.pages.resize(page_count);
+	for (int i = 0; i < page_count; i++) {
+		CompressedPage &page = compressed.pages.write[i];
+		page.time_begin = *r++;
+		page.time_step = *r++;
+		page.flags = uint32_t(*r++);
+		for (int j = 0; j < 3; j++)
+			page.loc_min[j] = *r++;
+		for (int j = 0; j < 3; j++)
+			page.loc_step[j] = *r++;
+		page.rot.x = *r++;
+		page.rot.y = *r++;
+		page.rot.z = *r++;
+		page.rot.w = *r++;
+		for (int j = 0; j < 3; j++)
+			page.scale_min[j] = *r++;
+		for (int j = 0; j < 3; j++)
+			page.scale_step[j] = *r++;
+
+		page.stride = CompressedPage::get_stride(page.flags);
+		page.data_offset = data_size;
+		data_size += MIN(COMPRESSED_PAGE_KEYS, compressed.key_count - i * COMPRESSED_PAGE_KEYS) * page.stride;
+	}
+
+	ERR_FAIL_COND_V(uint32_t(data.size()) != data_size * 2, false);
+
+	compressed.data.resize(data_size);
+	const uint8_t *src = data.ptr();
+	for (uint32_t i = 0; i < data_size; i++) {
+		compressed.data.write[i] = decode_uint16(&src[i * 2]);
+	}
+
+	p_track->transforms.clear();
+	p_track->compressed = compressed;
+	return true;
+}
+
+void Animation::compress() {
+
+	for (int i = 0; i < tracks.size(); i++) {
+
+		if (tracks[i]->type != TYPE_TRANSFORM)
+			continue;
+
+		TransformTrack *tt = static_cast<TransformTrack *>(tracks[i]);
+		if (tt->is_compressed() || tt->transforms.empty())
+			continue;
+
+		// quantized rotations may flip sign between keys, which only slerp deals with
+		if (tt->interpolation == INTERPOLATION_CUBIC)
+			continue;
+
+		bool eased = false;
+		for (int j = 0; j < tt->transforms.size(); j++) {
+			if (tt->transforms[j].transition != 1.0) {
+				eased = true;
+				break;
+			}
+		}
+		if (eased)
+			continue; // transitions are not stored
+
+		_transform_track_compress(tt);
+	}
+
+	emit_changed();
+}
+
+bool Animation::track_is_compressed(int p_track) const {
+
+	ERR_FAIL_INDEX_V(p_track, tracks.size(), false);
+	Track *t = tracks[p_track];
+	if (t->type != TYPE_TRANSFORM)
+		return false;
+	return static_cast<TransformTrack *>(t)->is_compressed();
+}
+
 Animation::Animation() {
 
 	step = 0.1;
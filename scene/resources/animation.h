@@ -101,11 +101,69 @@ private:
 		Vector3 scale;
 	};
 
+	/* COMPRESSED TRANSFORM KEYS */
+
+	// Read-only form of a transform track made by compress(). Keys are split in pages and quantized to
+	// 16 bits against the range of each channel in the page, rotations are stored as their three smallest
+	// components. Channels that don't change within a page are kept once in the page instead of per key.
+	enum {
+		COMPRESSED_PAGE_KEYS = 64,
+		COMPRESSED_LOC_CONSTANT = 1,
+		COMPRESSED_ROT_CONSTANT = 2,
+		COMPRESSED_SCALE_CONSTANT = 4,
+	};
+
+	struct CompressedPage {
+
+		float time_begin;
+		float time_step;
+		uint32_t flags;
+		uint32_t stride; // values per key
+		uint32_t data_offset; // first value of the page in CompressedTransforms::data
+		Vector3 loc_min;
+		Vector3 loc_step;
+		Quat rot; // if COMPRESSED_ROT_CONSTANT
+		Vector3 scale_min;
+		Vector3 scale_step;
+
+		static _FORCE_INLINE_ uint32_t get_stride(uint32_t p_flags) {
+			uint32_t stride = 1; // time
+			if (!(p_flags & COMPRESSED_LOC_CONSTANT))
+				stride += 3;
+			if (!(p_flags & COMPRESSED_ROT_CONSTANT))
+				stride += 3;
+			if (!(p_flags & COMPRESSED_SCALE_CONSTANT))
+				stride += 3;
+			return stride;
+		}
+	};
+
+	struct CompressedTransforms {
+
+		int key_count;
+		Vector<CompressedPage> pages;
+		Vector<uint16_t> data;
+
+		// same accessors as KeyArray, keys are decoded on demand
+		_FORCE_INLINE_ int size() const { return key_count; }
+		_FORCE_INLINE_ float time(int p_idx) const {
+			const CompressedPage &page = pages.ptr()[p_idx / COMPRESSED_PAGE_KEYS];
+			return page.time_begin + page.time_step * data.ptr()[page.data_offset + (p_idx % COMPRESSED_PAGE_KEYS) * page.stride];
+		}
+		_FORCE_INLINE_ float transition(int p_idx) const { return 1.0; }
+		TKey<TransformKey> key(int p_idx) const;
+
+		CompressedTransforms() { key_count = 0; }
+	};
+
 	/* TRANSFORM TRACK */
 
 	struct TransformTrack : public Track {
 
 		Vector<TKey<TransformKey>> transforms;
+		CompressedTransforms compressed; // replaces transforms once compressed
+
+		_FORCE_INLINE_ bool is_compressed() const { return compressed.key_count > 0; }
 
 		TransformTrack() { type = TYPE_TRANSFORM; }
 	};
@@ -199,8 +257,28 @@ private:
 	template <class T, class V>
 	int _insert(float p_time, T &p_keys, const V &p_value);
 
+	// Key access for the search and interpolation templates, so compressed tracks share them.
+	template <class K>
+	struct KeyArray {
+
+		const K *keys;
+		int count;
+
+		_FORCE_INLINE_ int size() const { return count; }
+		_FORCE_INLINE_ float time(int p_idx) const { return keys[p_idx].time; }
+		_FORCE_INLINE_ float transition(int p_idx) const { return keys[p_idx].transition; }
+		_FORCE_INLINE_ const K &key(int p_idx) const { return keys[p_idx]; }
+
+		KeyArray(const Vector<K> &p_keys) {
+			keys = p_keys.ptr();
+			count = p_keys.size();
+		}
+	};
+
 	template <class K>
-	inline int _find(const Vector<K> &p_keys, float p_time) const;
+	inline int _find(const Vector<K> &p_keys, float p_time, int *r_cursor = NULL) const;
+	template <class A>
+	inline int _find_keys(const A &p_keys, float p_time, int *r_cursor = NULL) const;
 
 	_FORCE_INLINE_ Animation::TransformKey _interpolate(const Animation::TransformKey &p_a, const Animation::TransformKey &p_b, float p_c) const;
 
@@ -216,10 +294,19 @@ private:
 	_FORCE_INLINE_ float _cubic_interpolate(const float &p_pre_a, const float &p_a, const float &p_b, const float &p_post_b, float p_c) const;
 
 	template <class T>
-	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok) const;
+	_FORCE_INLINE_ T _interpolate(const Vector<TKey<T>> &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_cursor = NULL) const;
+	template <class T, class A>
+	_FORCE_INLINE_ T _interpolate_keys(const A &p_keys, float p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, int *r_cursor = NULL) const;
 
 	template <class T>
 	_FORCE_INLINE_ void _track_get_key_indices_in_range(const Vector<T> &p_array, float from_time, float to_time, List<int> *p_indices) const;
+	template <class A>
+	_FORCE_INLINE_ void _keys_get_indices_in_range(const A &p_keys, float from_time, float to_time, List<int> *p_indices) const;
+
+	void _transform_track_compress(TransformTrack *p_track);
+	void _transform_track_decompress(TransformTrack *p_track);
+	bool _transform_track_set_compressed(TransformTrack *p_track, const Dictionary &p_compressed);
+	Dictionary _transform_track_get_compressed(const TransformTrack *p_track) const;
 
 	_FORCE_INLINE_ void _value_track_get_key_indices_in_range(const ValueTrack *vt, float from_time, float to_time, List<int> *p_indices) const;
 	_FORCE_INLINE_ void _method_track_get_key_indices_in_range(const MethodTrack *mt, float from_time, float to_time, List<int> *p_indices) const;
@@ -342,9 +429,9 @@ public:
 	void track_set_interpolation_loop_wrap(int p_track, bool p_enable);
 	bool track_get_interpolation_loop_wrap(int p_track) const;
 
-	Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale) const;
+	Error transform_track_interpolate(int p_track, float p_time, Vector3 *r_loc, Quat *r_rot, Vector3 *r_scale, int *r_cursor = NULL) const;
 
-	Variant value_track_interpolate(int p_track, float p_time) const;
+	Variant value_track_interpolate(int p_track, float p_time, int *r_cursor = NULL) const;
 	void value_track_get_key_indices(int p_track, float p_time, float p_delta, List<int> *p_indices) const;
 	void value_track_set_update_mode(int p_track, UpdateMode p_mode);
 	UpdateMode value_track_get_update_mode(int p_track) const;
@@ -370,6 +457,9 @@ public:
 
 	void optimize(float p_allowed_linear_err = 0.05, float p_allowed_angular_err = 0.01, float p_max_optimizable_angle = Math_PI * 0.125);
 
+	void compress();
+	bool track_is_compressed(int p_track) const;
+
 	Animation();
 	~Animation();
 };
@@ -89,6 +89,31 @@ void AudioStreamPlaybackSample::seek(float p_time) {
 
 	offset = uint64_t(p_time * base->mix_rate) << MIX_FRAC_BITS;
 }
+void AudioStreamPlaybackSample::skip(float p_time) {
+
+	if (!active || base->format == AudioStreamSample::FORMAT_IMA_ADPCM)
+		return; //no seeking in ima-adpcm, resume from where it stopped
+
+	int64_t len = int64_t(base->get_length() * base->mix_rate);
+	int64_t pos = (offset >> MIX_FRAC_BITS) + sign * int64_t(p_time * base->mix_rate);
+
+	if (base->loop_mode == AudioStreamSample::LOOP_DISABLED || base->loop_end <= base->loop_begin) {
+		if (pos < 0 || pos >= len) {
+			active = false;
+			return;
+		}
+	} else if ((sign > 0 && pos >= base->loop_end) || (sign < 0 && pos < base->loop_begin)) {
+		//keep the direction, good enough for ping-pong as the voice is not heard
+		int64_t loop_len = base->loop_end - base->loop_begin;
+		pos = (pos - base->loop_begin) % loop_len;
+		if (pos < 0) {
+			pos += loop_len;
+		}
+		pos += base->loop_begin;
+	}
+
+	offset = pos << MIX_FRAC_BITS;
+}
 
 template <class Depth, bool is_stereo, bool is_ima_adpcm>
 void AudioStreamPlaybackSample::do_resample(const Depth *p_src, AudioFrame *p_dst, int64_t &offset, int32_t &increment, uint32_t amount, IMA_ADPCM_State *ima_adpcm) {
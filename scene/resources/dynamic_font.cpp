@@ -33,8 +33,10 @@
 
 #include "dynamic_font.h"
 
+#include "core/local_vector.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
+#include "core/os/threaded_array_processor.h"
 
 #include FT_STROKER_H
 
@@ -47,6 +49,12 @@ bool DynamicFontData::CacheID::operator<(CacheID right) const {
 
 Ref<DynamicFontAtSize> DynamicFontData::_get_dynamic_font_at_size(CacheID p_cache_id) {
 
+	if (distance_field && p_cache_id.outline_size == 0) {
+		//distance fields scale, so all sizes share one set of glyphs and one atlas
+		p_cache_id.size = DynamicFontAtSize::DISTANCE_FIELD_SIZE;
+		p_cache_id.distance_field = 1;
+	}
+
 	if (size_cache.has(p_cache_id)) {
 		return Ref<DynamicFontAtSize>(size_cache[p_cache_id]);
 	}
@@ -91,9 +99,12 @@ void DynamicFontData::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_font_path"), &DynamicFontData::get_font_path);
 	ClassDB::bind_method(D_METHOD("set_hinting", "mode"), &DynamicFontData::set_hinting);
 	ClassDB::bind_method(D_METHOD("get_hinting"), &DynamicFontData::get_hinting);
+	ClassDB::bind_method(D_METHOD("set_distance_field", "enable"), &DynamicFontData::set_distance_field);
+	ClassDB::bind_method(D_METHOD("is_distance_field"), &DynamicFontData::is_distance_field);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "antialiased"), "set_antialiased", "is_antialiased");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "hinting", PROPERTY_HINT_ENUM, "None,Light,Normal"), "set_hinting", "get_hinting");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "distance_field"), "set_distance_field", "is_distance_field");
 
 	BIND_ENUM_CONSTANT(HINTING_NONE);
 	BIND_ENUM_CONSTANT(HINTING_LIGHT);
@@ -106,6 +117,7 @@ DynamicFontData::DynamicFontData() {
 
 	antialiased = true;
 	force_autohinter = false;
+	distance_field = false;
 	hinting = DynamicFontData::HINTING_NORMAL;
 	font_mem = NULL;
 	font_mem_size = 0;
@@ -202,6 +214,11 @@ Error DynamicFontAtSize::_load() {
 		ERR_FAIL_V_MSG(ERR_FILE_CANT_OPEN, "Error loading font.");
 	}
 
+	if (id.distance_field) {
+		//scaling is done when drawing, oversampling would only make the fields bigger
+		oversampling = 1.0;
+	}
+
 	if (FT_HAS_COLOR(face) && face->num_fixed_sizes > 0) {
 		int best_match = 0;
 		int diff = ABS(id.size - ((int64_t)face->available_sizes[0].width));
@@ -224,6 +241,11 @@ Error DynamicFontAtSize::_load() {
 	linegap = 0;
 
 	valid = true;
+
+	if (id.distance_field && !FT_HAS_COLOR(face)) {
+		_prepare_distance_field_chars();
+	}
+
 	return OK;
 }
 
@@ -243,6 +265,16 @@ float DynamicFontAtSize::get_descent() const {
 	return descent;
 }
 
+float DynamicFontAtSize::get_scale(int p_size) const {
+
+	return id.distance_field ? float(p_size) / id.size : 1.0;
+}
+
+bool DynamicFontAtSize::is_distance_field() const {
+
+	return valid && id.distance_field && !FT_HAS_COLOR(face);
+}
+
 const Pair<const DynamicFontAtSize::Character *, DynamicFontAtSize *> DynamicFontAtSize::_find_char_with_font(CharType p_char, const Vector<Ref<DynamicFontAtSize>> &p_fallbacks) const {
 	const Character *chr = char_map.getptr(p_char);
 	ERR_FAIL_COND_V(!chr, (Pair<const Character *, DynamicFontAtSize *>(NULL, NULL)));
@@ -275,7 +307,7 @@ const Pair<const DynamicFontAtSize::Character *, DynamicFontAtSize *> DynamicFon
 	return Pair<const Character *, DynamicFontAtSize *>(chr, const_cast<DynamicFontAtSize *>(this));
 }
 
-Size2 DynamicFontAtSize::get_char_size(CharType p_char, CharType p_next, const Vector<Ref<DynamicFontAtSize>> &p_fallbacks) const {
+Size2 DynamicFontAtSize::get_char_size(CharType p_char, CharType p_next, int p_size, const Vector<Ref<DynamicFontAtSize>> &p_fallbacks) const {
 
 	if (!valid)
 		return Size2(1, 1);
@@ -285,16 +317,16 @@ Size2 DynamicFontAtSize::get_char_size(CharType p_char, CharType p_next, const V
 	const Character *ch = char_pair_with_font.first;
 	ERR_FAIL_COND_V(!ch, Size2());
 
-	Size2 ret(0, get_height());
+	Size2 ret(0, get_height() * get_scale(p_size));
 
 	if (ch->found) {
-		ret.x = ch->advance;
+		ret.x = ch->advance * char_pair_with_font.second->get_scale(p_size);
 	}
 
 	return ret;
 }
 
-float DynamicFontAtSize::draw_char(RID p_canvas_item, const Point2 &p_pos, CharType p_char, CharType p_next, const Color &p_modulate, const Vector<Ref<DynamicFontAtSize>> &p_fallbacks, bool p_advance_only, bool p_outline) const {
+float DynamicFontAtSize::draw_char(RID p_canvas_item, const Point2 &p_pos, CharType p_char, CharType p_next, int p_size, const Color &p_modulate, const Vector<Ref<DynamicFontAtSize>> &p_fallbacks, bool p_advance_only, bool p_outline) const {
 
 	if (!valid)
 		return 0;
@@ -326,20 +358,26 @@ float DynamicFontAtSize::draw_char(RID p_canvas_item, const Point2 &p_pos, CharT
 	if (ch->found) {
 		ERR_FAIL_COND_V(ch->texture_idx < -1 || ch->texture_idx >= font->textures.size(), 0);
 
+		float scale = font->get_scale(p_size);
+
 		if (!p_advance_only && ch->texture_idx != -1) {
 			Point2 cpos = p_pos;
-			cpos.x += ch->h_align;
-			cpos.y -= font->get_ascent();
-			cpos.y += ch->v_align;
+			cpos.x += ch->h_align * scale;
+			cpos.y -= font->get_ascent() * scale;
+			cpos.y += ch->v_align * scale;
 			Color modulate = p_modulate;
 			if (FT_HAS_COLOR(face)) {
 				modulate.r = modulate.g = modulate.b = 1.0;
 			}
 			RID texture = font->textures[ch->texture_idx].texture->get_rid();
-			RenderingServer::get_singleton()->canvas_item_add_texture_rect_region(p_canvas_item, Rect2(cpos, ch->rect.size), texture, ch->rect_uv, modulate, false, RID(), RID(), Color(1, 1, 1, 1), false);
+			if (font->is_distance_field()) {
+				RenderingServer::get_singleton()->canvas_item_add_distance_field_texture_rect_region(p_canvas_item, Rect2(cpos, ch->rect.size * scale), texture, ch->rect_uv, modulate);
+			} else {
+				RenderingServer::get_singleton()->canvas_item_add_texture_rect_region(p_canvas_item, Rect2(cpos, ch->rect.size * scale), texture, ch->rect_uv, modulate, false, RID(), RID(), Color(1, 1, 1, 1), false);
+			}
 		}
 
-		advance = ch->advance;
+		advance = ch->advance * scale;
 	}
 
 	return advance;
@@ -388,7 +426,7 @@ DynamicFontAtSize::TexturePosition DynamicFontAtSize::_find_texture_pos_for_glyp
 
 		const CharTexture &ct = textures[i];
 
-		if (ct.texture->get_format() != p_image_format)
+		if (ct.format != p_image_format)
 			continue;
 
 		if (mw > ct.texture_size || mh > ct.texture_size) //too big for this texture
@@ -438,6 +476,7 @@ DynamicFontAtSize::TexturePosition DynamicFontAtSize::_find_texture_pos_for_glyp
 
 		CharTexture tex;
 		tex.texture_size = texsize;
+		tex.format = p_image_format;
 		tex.imgdata.resize(texsize * texsize * p_color_size); //grayscale alpha
 
 		{
@@ -514,18 +553,7 @@ DynamicFontAtSize::Character DynamicFontAtSize::_bitmap_to_character(FT_Bitmap b
 		}
 	}
 
-	//blit to image and texture
-	{
-
-		Ref<Image> img = memnew(Image(tex.texture_size, tex.texture_size, 0, require_format, tex.imgdata));
-
-		if (tex.texture.is_null()) {
-			tex.texture.instance();
-			tex.texture->create_from_image(img);
-		} else {
-			tex.texture->update(img); //update
-		}
-	}
+	_update_char_texture(tex_pos.index);
 
 	// update height array
 
@@ -547,6 +575,190 @@ DynamicFontAtSize::Character DynamicFontAtSize::_bitmap_to_character(FT_Bitmap b
 	return chr;
 }
 
+void DynamicFontAtSize::_update_char_texture(int p_index) {
+
+	//blit to image and texture
+	CharTexture &tex = textures.write[p_index];
+
+	Ref<Image> img = memnew(Image(tex.texture_size, tex.texture_size, 0, tex.format, tex.imgdata));
+
+	if (tex.texture.is_null()) {
+		tex.texture.instance();
+		tex.texture->create_from_image(img);
+	} else {
+		tex.texture->update(img); //update
+	}
+}
+
+bool DynamicFontAtSize::_load_glyph_bitmap(CharType p_char, GlyphBitmap &r_glyph) {
+
+	if (FT_Get_Char_Index(face, p_char) == 0)
+		return false;
+
+	//hinting fits the outline to one pixel grid, but the field is drawn at every size
+	if (FT_Load_Char(face, p_char, FT_LOAD_DEFAULT | FT_LOAD_NO_HINTING) != 0)
+		return false;
+	if (FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL) != 0)
+		return false;
+
+	FT_GlyphSlot slot = face->glyph;
+	const FT_Bitmap &bitmap = slot->bitmap;
+	ERR_FAIL_COND_V(bitmap.pixel_mode != FT_PIXEL_MODE_GRAY, false);
+
+	r_glyph.char_code = p_char;
+	r_glyph.width = bitmap.width;
+	r_glyph.height = bitmap.rows;
+	r_glyph.xofs = slot->bitmap_left;
+	r_glyph.yofs = slot->bitmap_top;
+	r_glyph.advance = slot->advance.x / 64.0;
+
+	r_glyph.coverage.resize(r_glyph.width * r_glyph.height);
+	uint8_t *w = r_glyph.coverage.ptrw();
+	for (int i = 0; i < r_glyph.height; i++) {
+		for (int j = 0; j < r_glyph.width; j++) {
+			w[i * r_glyph.width + j] = bitmap.buffer[i * bitmap.pitch + j];
+		}
+	}
+
+	return true;
+}
+
+void DynamicFontAtSize::_generate_distance_field(uint32_t p_index, GlyphBitmap *p_glyphs) {
+
+	GlyphBitmap &glyph = p_glyphs[p_index];
+	if (glyph.width == 0 || glyph.height == 0)
+		return; //nothing to draw, keep only the advance
+
+	const int spread = DISTANCE_FIELD_SPREAD;
+	const int src_w = glyph.width;
+	const int src_h = glyph.height;
+	const uint8_t *src = glyph.coverage.ptr();
+
+	//the field reaches past the outline, so it needs room around the bitmap
+	int w = src_w + spread * 2;
+	int h = src_h + spread * 2;
+	glyph.distance.resize(w * h);
+	uint8_t *dst = glyph.distance.ptrw();
+
+	for (int y = 0; y < h; y++) {
+		for (int x = 0; x < w; x++) {
+
+			int sx = x - spread;
+			int sy = y - spread;
+			bool inside = sx >= 0 && sy >= 0 && sx < src_w && sy < src_h && src[sy * src_w + sx] >= 128;
+
+			//nearest pixel on the other side of the outline, within the spread
+			int nearest = (spread + 1) * (spread + 1);
+			for (int j = -spread; j <= spread; j++) {
+				int ny = sy + j;
+				for (int i = -spread; i <= spread; i++) {
+					int d = i * i + j * j;
+					if (d >= nearest)
+						continue;
+					int nx = sx + i;
+					bool other = nx >= 0 && ny >= 0 && nx < src_w && ny < src_h && src[ny * src_w + nx] >= 128;
+					if (other != inside) {
+						nearest = d;
+					}
+				}
+			}
+
+			float distance = Math::sqrt(float(nearest)) - 0.5;
+			if (!inside) {
+				distance = -distance;
+			}
+
+			dst[y * w + x] = uint8_t(CLAMP(0.5 + distance / (spread * 2.0), 0.0, 1.0) * 255.0);
+		}
+	}
+
+	glyph.width = w;
+	glyph.height = h;
+	glyph.xofs -= spread;
+	glyph.yofs += spread;
+}
+
+DynamicFontAtSize::Character DynamicFontAtSize::_distance_field_to_character(const GlyphBitmap &p_glyph) {
+
+	Character chr;
+	chr.found = true;
+	chr.texture_idx = -1;
+	chr.h_align = p_glyph.xofs;
+	chr.v_align = ascent - p_glyph.yofs;
+	chr.advance = p_glyph.advance;
+
+	if (p_glyph.distance.empty())
+		return chr;
+
+	int w = p_glyph.width;
+	int h = p_glyph.height;
+
+	int mw = w + rect_margin * 2;
+	int mh = h + rect_margin * 2;
+
+	ERR_FAIL_COND_V(mw > 4096, Character::not_found());
+	ERR_FAIL_COND_V(mh > 4096, Character::not_found());
+
+	TexturePosition tex_pos = _find_texture_pos_for_glyph(2, Image::FORMAT_LA8, mw, mh);
+	ERR_FAIL_COND_V(tex_pos.index < 0, Character::not_found());
+
+	CharTexture &tex = textures.write[tex_pos.index];
+
+	{
+		uint8_t *wr = tex.imgdata.ptrw();
+		const uint8_t *rd = p_glyph.distance.ptr();
+
+		for (int i = 0; i < h; i++) {
+			for (int j = 0; j < w; j++) {
+
+				int ofs = ((i + tex_pos.y + rect_margin) * tex.texture_size + j + tex_pos.x + rect_margin) * 2;
+				ERR_FAIL_COND_V(ofs >= tex.imgdata.size(), Character::not_found());
+				wr[ofs + 0] = 255; //grayscale as 1
+				wr[ofs + 1] = rd[i * w + j];
+			}
+		}
+	}
+
+	for (int k = tex_pos.x; k < tex_pos.x + mw; k++) {
+		tex.offsets.write[k] = tex_pos.y + mh;
+	}
+
+	chr.texture_idx = tex_pos.index;
+	chr.rect_uv = Rect2(tex_pos.x + rect_margin, tex_pos.y + rect_margin, w, h);
+	chr.rect = chr.rect_uv;
+	return chr;
+}
+
+void DynamicFontAtSize::_prepare_distance_field_chars() {
+
+	//printable ascii is wanted by almost any text, so make those fields up front on worker threads
+	//instead of one at a time while drawing, freetype itself is not thread safe so only the fields are
+	LocalVector<GlyphBitmap> glyphs;
+
+	for (CharType c = 32; c < 127; c++) {
+
+		GlyphBitmap glyph;
+		if (_load_glyph_bitmap(c, glyph)) {
+			glyphs.push_back(glyph);
+		} else {
+			char_map[c] = Character::not_found();
+		}
+	}
+
+	if (glyphs.size() == 0)
+		return;
+
+	thread_process_array(glyphs.size(), this, &DynamicFontAtSize::_generate_distance_field, glyphs.ptr());
+
+	for (uint32_t i = 0; i < glyphs.size(); i++) {
+		char_map[glyphs[i].char_code] = _distance_field_to_character(glyphs[i]);
+	}
+
+	for (int i = 0; i < textures.size(); i++) {
+		_update_char_texture(i);
+	}
+}
+
 DynamicFontAtSize::Character DynamicFontAtSize::_make_outline_char(CharType p_char) {
 	Character ret = Character::not_found();
 
@@ -587,6 +799,19 @@ void DynamicFontAtSize::_update_char(CharType p_char) {
 
 	Character character = Character::not_found();
 
+	if (is_distance_field()) {
+		GlyphBitmap glyph;
+		if (_load_glyph_bitmap(p_char, glyph)) {
+			_generate_distance_field(0, &glyph);
+			character = _distance_field_to_character(glyph);
+			if (character.texture_idx != -1) {
+				_update_char_texture(character.texture_idx);
+			}
+		}
+		char_map[p_char] = character;
+		return;
+	}
+
 	FT_GlyphSlot slot = face->glyph;
 
 	if (FT_Get_Char_Index(face, p_char) == 0) {
@@ -626,7 +851,7 @@ void DynamicFontAtSize::_update_char(CharType p_char) {
 }
 
 void DynamicFontAtSize::update_oversampling() {
-	if (oversampling == font_oversampling || !valid)
+	if (id.distance_field || oversampling == font_oversampling || !valid)
 		return;
 
 	FT_Done_FreeType(library);
@@ -766,6 +991,18 @@ void DynamicFontData::set_hinting(Hinting p_hinting) {
 	hinting = p_hinting;
 }
 
+bool DynamicFontData::is_distance_field() const {
+
+	return distance_field;
+}
+
+void DynamicFontData::set_distance_field(bool p_distance_field) {
+
+	if (distance_field == p_distance_field)
+		return;
+	distance_field = p_distance_field;
+}
+
 int DynamicFont::get_spacing(int p_type) const {
 
 	if (p_type == SPACING_TOP) {
@@ -802,7 +1039,7 @@ float DynamicFont::get_height() const {
 	if (!data_at_size.is_valid())
 		return 1;
 
-	return data_at_size->get_height() + spacing_top + spacing_bottom;
+	return data_at_size->get_height() * data_at_size->get_scale(cache_id.size) + spacing_top + spacing_bottom;
 }
 
 float DynamicFont::get_ascent() const {
@@ -810,7 +1047,7 @@ float DynamicFont::get_ascent() const {
 	if (!data_at_size.is_valid())
 		return 1;
 
-	return data_at_size->get_ascent() + spacing_top;
+	return data_at_size->get_ascent() * data_at_size->get_scale(cache_id.size) + spacing_top;
 }
 
 float DynamicFont::get_descent() const {
@@ -818,7 +1055,7 @@ float DynamicFont::get_descent() const {
 	if (!data_at_size.is_valid())
 		return 1;
 
-	return data_at_size->get_descent() + spacing_bottom;
+	return data_at_size->get_descent() * data_at_size->get_scale(cache_id.size) + spacing_bottom;
 }
 
 Size2 DynamicFont::get_char_size(CharType p_char, CharType p_next) const {
@@ -826,7 +1063,7 @@ Size2 DynamicFont::get_char_size(CharType p_char, CharType p_next) const {
 	if (!data_at_size.is_valid())
 		return Size2(1, 1);
 
-	Size2 ret = data_at_size->get_char_size(p_char, p_next, fallback_data_at_size);
+	Size2 ret = data_at_size->get_char_size(p_char, p_next, cache_id.size, fallback_data_at_size);
 	if (p_char == ' ')
 		ret.width += spacing_space + spacing_char;
 	else if (p_next)
@@ -837,7 +1074,7 @@ Size2 DynamicFont::get_char_size(CharType p_char, CharType p_next) const {
 
 bool DynamicFont::is_distance_field_hint() const {
 
-	return false;
+	return data_at_size.is_valid() && data_at_size->is_distance_field();
 }
 
 bool DynamicFont::has_outline() const {
@@ -855,7 +1092,7 @@ float DynamicFont::draw_char(RID p_canvas_item, const Point2 &p_pos, CharType p_
 
 	// If requested outline draw, but no outline is present, simply return advance without drawing anything
 	bool advance_only = p_outline && outline_cache_id.outline_size == 0;
-	return font_at_size->draw_char(p_canvas_item, p_pos, p_char, p_next, color, fallbacks, advance_only, p_outline) + spacing_char;
+	return font_at_size->draw_char(p_canvas_item, p_pos, p_char, p_next, cache_id.size, color, fallbacks, advance_only, p_outline) + spacing_char;
 }
 
 void DynamicFont::set_fallback(int p_idx, const Ref<DynamicFontData> &p_data) {
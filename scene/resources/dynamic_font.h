@@ -56,7 +56,8 @@ public:
 			struct {
 				uint32_t size : 16;
 				uint32_t outline_size : 8;
-				uint32_t unused : 8;
+				uint32_t distance_field : 1;
+				uint32_t unused : 7;
 			};
 			uint32_t key;
 		};
@@ -76,12 +77,15 @@ public:
 	void set_antialiased(bool p_antialiased);
 	Hinting get_hinting() const;
 	void set_hinting(Hinting p_hinting);
+	bool is_distance_field() const;
+	void set_distance_field(bool p_distance_field);
 
 private:
 	const uint8_t *font_mem;
 	int font_mem_size;
 	bool antialiased;
 	bool force_autohinter;
+	bool distance_field;
 	Hinting hinting;
 
 	String font_path;
@@ -114,6 +118,11 @@ class DynamicFontAtSize : public Reference {
 
 	_THREAD_SAFE_CLASS_
 
+	enum {
+		DISTANCE_FIELD_SIZE = 48, //every size of a distance field font is drawn from glyphs made at this one
+		DISTANCE_FIELD_SPREAD = 6
+	};
+
 	FT_Library library; /* handle to library     */
 	FT_Face face; /* handle to face object */
 	FT_StreamRec stream;
@@ -131,6 +140,7 @@ class DynamicFontAtSize : public Reference {
 
 		Vector<uint8_t> imgdata;
 		int texture_size;
+		Image::Format format;
 		Vector<int> offsets;
 		Ref<ImageTexture> texture;
 	};
@@ -161,10 +171,28 @@ class DynamicFontAtSize : public Reference {
 		int y;
 	};
 
+	struct GlyphBitmap {
+
+		CharType char_code;
+		int width;
+		int height;
+		int xofs;
+		int yofs;
+		float advance;
+		Vector<uint8_t> coverage;
+		Vector<uint8_t> distance;
+	};
+
 	const Pair<const Character *, DynamicFontAtSize *> _find_char_with_font(CharType p_char, const Vector<Ref<DynamicFontAtSize>> &p_fallbacks) const;
 	Character _make_outline_char(CharType p_char);
 	TexturePosition _find_texture_pos_for_glyph(int p_color_size, Image::Format p_image_format, int p_width, int p_height);
 	Character _bitmap_to_character(FT_Bitmap bitmap, int yofs, int xofs, float advance);
+	void _update_char_texture(int p_index);
+
+	bool _load_glyph_bitmap(CharType p_char, GlyphBitmap &r_glyph);
+	void _generate_distance_field(uint32_t p_index, GlyphBitmap *p_glyphs);
+	Character _distance_field_to_character(const GlyphBitmap &p_glyph);
+	void _prepare_distance_field_chars();
 
 	static unsigned long _ft_stream_io(FT_Stream stream, unsigned long offset, unsigned char *buffer, unsigned long count);
 	static void _ft_stream_close(FT_Stream stream);
@@ -187,10 +215,12 @@ public:
 
 	float get_ascent() const;
 	float get_descent() const;
+	float get_scale(int p_size) const;
+	bool is_distance_field() const;
 
-	Size2 get_char_size(CharType p_char, CharType p_next, const Vector<Ref<DynamicFontAtSize>> &p_fallbacks) const;
+	Size2 get_char_size(CharType p_char, CharType p_next, int p_size, const Vector<Ref<DynamicFontAtSize>> &p_fallbacks) const;
 
-	float draw_char(RID p_canvas_item, const Point2 &p_pos, CharType p_char, CharType p_next, const Color &p_modulate, const Vector<Ref<DynamicFontAtSize>> &p_fallbacks, bool p_advance_only = false, bool p_outline = false) const;
+	float draw_char(RID p_canvas_item, const Point2 &p_pos, CharType p_char, CharType p_next, int p_size, const Color &p_modulate, const Vector<Ref<DynamicFontAtSize>> &p_fallbacks, bool p_advance_only = false, bool p_outline = false) const;
 
 	void set_texture_flags(uint32_t p_flags);
 	void update_oversampling();
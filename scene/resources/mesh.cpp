@@ -157,7 +157,7 @@ void Mesh::generate_debug_mesh_indices(Vector<Vector3> &r_points) {
 
 bool Mesh::surface_is_softbody_friendly(int p_idx) const {
 	const uint32_t surface_format = surface_get_format(p_idx);
-	return (surface_format & Mesh::ARRAY_FLAG_USE_DYNAMIC_UPDATE && (!(surface_format & Mesh::ARRAY_COMPRESS_NORMAL)));
+	return (surface_format & Mesh::ARRAY_FLAG_USE_DYNAMIC_UPDATE && (!(surface_format & (Mesh::ARRAY_COMPRESS_VERTEX | Mesh::ARRAY_COMPRESS_NORMAL))));
 }
 
 Vector<Face3> Mesh::get_faces() const {
@@ -513,6 +513,7 @@ void Mesh::_bind_methods() {
 	BIND_ENUM_CONSTANT(ARRAY_FORMAT_WEIGHTS);
 	BIND_ENUM_CONSTANT(ARRAY_FORMAT_INDEX);
 
+	BIND_ENUM_CONSTANT(ARRAY_COMPRESS_VERTEX);
 	BIND_ENUM_CONSTANT(ARRAY_COMPRESS_NORMAL);
 	BIND_ENUM_CONSTANT(ARRAY_COMPRESS_TANGENT);
 	BIND_ENUM_CONSTANT(ARRAY_COMPRESS_COLOR);
@@ -521,6 +522,7 @@ void Mesh::_bind_methods() {
 	BIND_ENUM_CONSTANT(ARRAY_COMPRESS_INDEX);
 
 	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_2D_VERTICES);
+	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_OCTAHEDRAL_COMPRESSION);
 
 	BIND_ENUM_CONSTANT(ARRAY_COMPRESS_DEFAULT);
 
@@ -547,16 +549,19 @@ Vector<Ref<Shape3D>> Mesh::convex_decompose() const {
 
 	const Vector<Face3> faces = get_faces();
 
-	Vector<Vector<Face3>> decomposed = convex_composition_function(faces);
+	return create_convex_shapes(convex_composition_function(faces));
+}
+
+Vector<Ref<Shape3D>> Mesh::create_convex_shapes(const Vector<Vector<Face3>> &p_hulls) {
 
 	Vector<Ref<Shape3D>> ret;
 
-	for (int i = 0; i < decomposed.size(); i++) {
+	for (int i = 0; i < p_hulls.size(); i++) {
 		Set<Vector3> points;
-		for (int j = 0; j < decomposed[i].size(); j++) {
-			points.insert(decomposed[i][j].vertex[0]);
-			points.insert(decomposed[i][j].vertex[1]);
-			points.insert(decomposed[i][j].vertex[2]);
+		for (int j = 0; j < p_hulls[i].size(); j++) {
+			points.insert(p_hulls[i][j].vertex[0]);
+			points.insert(p_hulls[i][j].vertex[1]);
+			points.insert(p_hulls[i][j].vertex[2]);
 		}
 
 		Vector<Vector3> convex_points;
@@ -1138,6 +1143,8 @@ void ArrayMesh::add_surface(uint32_t p_format, PrimitiveType p_primitive, const
 
 void ArrayMesh::add_surface_from_arrays(PrimitiveType p_primitive, const Array &p_arrays, const Array &p_blend_shapes, const Dictionary &p_lods, uint32_t p_flags) {
 
+	MemoryTagScope memory_tag(Memory::TAG_MESHES);
+
 	ERR_FAIL_COND(p_arrays.size() != ARRAY_MAX);
 
 	RS::SurfaceData surface;
@@ -1358,6 +1365,70 @@ void ArrayMesh::regen_normalmaps() {
 	}
 }
 
+void ArrayMesh::generate_lods() {
+
+	if (surfaces.size() == 0) {
+		return;
+	}
+
+	Vector<RS::SurfaceData> surface_data;
+	for (int i = 0; i < surfaces.size(); i++) {
+
+		RS::SurfaceData sd = RS::get_singleton()->mesh_get_surface(mesh, i);
+
+		if (sd.primitive == RS::PRIMITIVE_TRIANGLES && sd.index_count > 0) {
+
+			Array arrays = surface_get_arrays(i);
+			Vector<Vector3> vertices = arrays[ARRAY_VERTEX];
+			Vector<int> indices = arrays[ARRAY_INDEX];
+			bool is_index_16 = sd.vertex_count <= 65536;
+
+			//every level halves the triangles, until simplifying no longer pays off
+			sd.lods.clear();
+			int index_count = indices.size();
+			float last_error = 0.0;
+
+			while (sd.lods.size() < 8 && index_count >= 64 * 3) {
+
+				float error = 0.0;
+				Vector<int> lod_indices = SurfaceTool::generate_lod(vertices, indices, (index_count / 6) * 3, &error);
+				if (lod_indices.size() == 0 || lod_indices.size() > index_count * 3 / 4) {
+					break;
+				}
+
+				RS::SurfaceData::LOD lod;
+				lod.edge_length = MAX(error, last_error + CMP_EPSILON); //must keep growing, the renderer picks them in order
+				lod.index_data.resize(lod_indices.size() * (is_index_16 ? 2 : 4));
+				uint8_t *w = lod.index_data.ptrw();
+				const int *r = lod_indices.ptr();
+				for (int j = 0; j < lod_indices.size(); j++) {
+					if (is_index_16) {
+						((uint16_t *)w)[j] = r[j];
+					} else {
+						((uint32_t *)w)[j] = r[j];
+					}
+				}
+
+				sd.lods.push_back(lod);
+				last_error = lod.edge_length;
+				index_count = lod_indices.size();
+			}
+		}
+
+		surface_data.push_back(sd);
+	}
+
+	Vector<Surface> old_surfaces = surfaces;
+	clear_surfaces();
+
+	for (int i = 0; i < surface_data.size(); i++) {
+		const RS::SurfaceData &sd = surface_data[i];
+		add_surface(sd.format, PrimitiveType(sd.primitive), sd.vertex_data, sd.vertex_count, sd.index_data, sd.index_count, sd.aabb, sd.blend_shapes, sd.bone_aabbs, sd.lods);
+		surface_set_name(i, old_surfaces[i].name);
+		surface_set_material(i, old_surfaces[i].material);
+	}
+}
+
 //dirty hack
 bool (*array_mesh_lightmap_unwrap_callback)(float p_texel_size, const float *p_vertices, const float *p_normals, int p_vertex_count, const int *p_indices, const int *p_face_materials, int p_index_count, float **r_uv, int **r_vertex, int *r_vertex_count, int **r_index, int *r_index_count, int *r_size_hint_x, int *r_size_hint_y) = NULL;
 
@@ -1407,10 +1478,17 @@ Error ArrayMesh::lightmap_unwrap(const Transform &p_base_transform, float p_texe
 		normals.resize((vertex_ofs + vc) * 3);
 		uv_index.resize(vertex_ofs + vc);
 
+		Vector<Vector3> xvertices = p_base_transform.xform(rvertices);
+		Vector<Vector3> xnormals;
+		xnormals.resize(vc);
+		p_base_transform.xform_normals(rn, xnormals.ptrw(), vc);
+		const Vector3 *xr = xvertices.ptr();
+		const Vector3 *xrn = xnormals.ptr();
+
 		for (int j = 0; j < vc; j++) {
 
-			Vector3 v = p_base_transform.xform(r[j]);
-			Vector3 n = p_base_transform.basis.xform(rn[j]).normalized();
+			const Vector3 &v = xr[j];
+			const Vector3 &n = xrn[j];
 
 			vertices.write[(j + vertex_ofs) * 3 + 0] = v.x;
 			vertices.write[(j + vertex_ofs) * 3 + 1] = v.y;
@@ -1568,6 +1646,8 @@ void ArrayMesh::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("create_outline", "margin"), &ArrayMesh::create_outline);
 	ClassDB::bind_method(D_METHOD("regen_normalmaps"), &ArrayMesh::regen_normalmaps);
 	ClassDB::set_method_flags(get_class_static(), _scs_create("regen_normalmaps"), METHOD_FLAGS_DEFAULT | METHOD_FLAG_EDITOR);
+	ClassDB::bind_method(D_METHOD("generate_lods"), &ArrayMesh::generate_lods);
+	ClassDB::set_method_flags(get_class_static(), _scs_create("generate_lods"), METHOD_FLAGS_DEFAULT | METHOD_FLAG_EDITOR);
 	ClassDB::bind_method(D_METHOD("lightmap_unwrap", "transform", "texel_size"), &ArrayMesh::lightmap_unwrap);
 	ClassDB::set_method_flags(get_class_static(), _scs_create("lightmap_unwrap"), METHOD_FLAGS_DEFAULT | METHOD_FLAG_EDITOR);
 	ClassDB::bind_method(D_METHOD("get_faces"), &ArrayMesh::get_faces);
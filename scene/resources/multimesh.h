@@ -72,6 +72,7 @@ protected:
 	Vector<Color> _get_custom_data_array() const;
 #endif
 	void set_buffer(const Vector<float> &p_buffer);
+	void set_buffer_range(int p_first_instance, const Vector<float> &p_buffer);
 	Vector<float> get_buffer() const;
 
 public:
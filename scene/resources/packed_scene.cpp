@@ -48,6 +48,8 @@ bool SceneState::can_instance() const {
 
 Node *SceneState::instance(GenEditState p_edit_state) const {
 
+	MemoryTagScope memory_tag(Memory::TAG_NODES);
+
 	// nodes where instancing failed (because something is missing)
 	List<Node *> stray_instances;
 
@@ -80,6 +82,16 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 
 	Node **ret_nodes = (Node **)alloca(sizeof(Node *) * nc);
 
+	//the plan is only used for runtime instancing, editing goes through the generic path
+	const PlanNode *plan_nodes = NULL;
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED) {
+		MutexLock lock(plan_mutex);
+		if (!plan_valid) {
+			_build_plan();
+		}
+		plan_nodes = plan.ptr();
+	}
+
 	bool gen_node_path_cache = p_edit_state != GEN_EDIT_STATE_DISABLED && node_path_cache.empty();
 
 	Map<Ref<Resource>, Ref<Resource>> resources_local_to_scene;
@@ -149,9 +161,9 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 				}
 #endif
 			}
-		} else if (ClassDB::is_class_enabled(snames[n.type])) {
+		} else if ((plan_nodes && plan_nodes[i].creation_func) || ClassDB::is_class_enabled(snames[n.type])) {
 			//node belongs to this scene and must be created
-			Object *obj = ClassDB::instance(snames[n.type]);
+			Object *obj = (plan_nodes && plan_nodes[i].creation_func) ? plan_nodes[i].creation_func() : ClassDB::instance(snames[n.type]);
 			if (!Object::cast_to<Node>(obj)) {
 				if (obj) {
 					memdelete(obj);
@@ -190,6 +202,12 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 
 				const NodeData::Property *nprops = &n.properties[0];
 
+				//setters can only be trusted if the node is of the class they were resolved for
+				const PlanNode *pn = NULL;
+				if (plan_nodes && plan_nodes[i].creation_func && node->get_class_name() == plan_nodes[i].class_name) {
+					pn = &plan_nodes[i];
+				}
+
 				for (int j = 0; j < nprop_count; j++) {
 
 					bool valid;
@@ -216,7 +234,7 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 
 						Variant value = props[nprops[j].value];
 
-						if (value.get_type() == Variant::OBJECT) {
+						if (pn ? pn->resources[j] : value.get_type() == Variant::OBJECT) {
 							//handle resources that are local to scene by duplicating them if needed
 							Ref<Resource> res = value;
 							if (res.is_valid()) {
@@ -250,7 +268,12 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 						} else if (p_edit_state == GEN_EDIT_STATE_INSTANCE) {
 							value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor
 						}
-						node->set(snames[nprops[j].name], value, &valid);
+
+						if (pn && pn->setters[j] && !node->get_script_instance()) {
+							ClassDB::set_property_direct(node, pn->setters[j], value, &valid);
+						} else {
+							node->set(snames[nprops[j].name], value, &valid);
+						}
 					}
 				}
 			}
@@ -352,6 +375,59 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+void SceneState::_build_plan() const {
+
+	int nc = nodes.size();
+	plan.resize(nc);
+
+	for (int i = 0; i < nc; i++) {
+
+		const NodeData &n = nodes[i];
+		PlanNode &pn = plan.write[i];
+
+		pn.creation_func = NULL;
+		pn.class_name = StringName();
+		pn.setters.clear();
+		pn.resources.clear();
+
+		if ((i == 0 && base_scene_idx >= 0) || n.instance >= 0 || n.type == TYPE_INSTANCED) {
+			continue; //the class is only known once the instanced scene is built
+		}
+		if (n.type < 0 || n.type >= names.size()) {
+			continue;
+		}
+
+		pn.creation_func = ClassDB::get_creation_func(names[n.type], &pn.class_name);
+		if (!pn.creation_func) {
+			continue;
+		}
+
+		int nprop_count = n.properties.size();
+		pn.setters.resize(nprop_count);
+		pn.resources.resize(nprop_count);
+
+		for (int j = 0; j < nprop_count; j++) {
+
+			const NodeData::Property &prop = n.properties[j];
+			const ClassDB::PropertySetGet *setter = NULL;
+			bool resource = false;
+
+			if (prop.name >= 0 && prop.name < names.size() && names[prop.name] != CoreStringNames::get_singleton()->_script) {
+				setter = ClassDB::get_property_setget(pn.class_name, names[prop.name]);
+			}
+			if (prop.value >= 0 && prop.value < variants.size() && variants[prop.value].get_type() == Variant::OBJECT) {
+				Ref<Resource> res = variants[prop.value];
+				resource = res.is_valid();
+			}
+
+			pn.setters.write[j] = setter;
+			pn.resources.write[j] = resource;
+		}
+	}
+
+	plan_valid = true;
+}
+
 static int _nm_get_string(const String &p_string, Map<StringName, int> &name_map) {
 
 	if (name_map.has(p_string))
@@ -932,6 +1008,7 @@ void SceneState::clear() {
 	node_paths.clear();
 	editable_instances.clear();
 	base_scene_idx = -1;
+	_invalidate_plan();
 }
 
 Ref<SceneState> SceneState::_get_base_scene_state() const {
@@ -1091,6 +1168,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 	ERR_FAIL_COND(!p_dictionary.has("conns"));
 	//ERR_FAIL_COND( !p_dictionary.has("path"));
 
+	_invalidate_plan();
+
 	int version = 1;
 	if (p_dictionary.has("version"))
 		version = p_dictionary["version"];
@@ -1565,6 +1644,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.index = p_index;
 
 	nodes.push_back(nd);
+	_invalidate_plan();
 
 	return nodes.size() - 1;
 }
@@ -1578,6 +1658,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value) {
 	prop.name = p_name;
 	prop.value = p_value;
 	nodes.write[p_node].properties.push_back(prop);
+	_invalidate_plan();
 }
 void SceneState::add_node_group(int p_node, int p_group) {
 
@@ -1657,6 +1738,7 @@ SceneState::SceneState() {
 
 	base_scene_idx = -1;
 	last_modified_time = 0;
+	plan_valid = false;
 }
 
 ////////////////
@@ -1708,6 +1790,25 @@ Node *PackedScene::instance(GenEditState p_edit_state) const {
 	return s;
 }
 
+Array PackedScene::instance_multiple(int p_count, GenEditState p_edit_state) const {
+
+	ERR_FAIL_COND_V(p_count < 0, Array());
+
+	Array ret;
+	ret.resize(p_count);
+
+	for (int i = 0; i < p_count; i++) {
+		Node *s = instance(p_edit_state);
+		if (!s) {
+			ret.resize(i);
+			break;
+		}
+		ret[i] = s;
+	}
+
+	return ret;
+}
+
 void PackedScene::replace_state(Ref<SceneState> p_by) {
 
 	state = p_by;
@@ -1741,6 +1842,7 @@ void PackedScene::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("pack", "path"), &PackedScene::pack);
 	ClassDB::bind_method(D_METHOD("instance", "edit_state"), &PackedScene::instance, DEFVAL(GEN_EDIT_STATE_DISABLED));
+	ClassDB::bind_method(D_METHOD("instance_multiple", "count", "edit_state"), &PackedScene::instance_multiple, DEFVAL(GEN_EDIT_STATE_DISABLED));
 	ClassDB::bind_method(D_METHOD("can_instance"), &PackedScene::can_instance);
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
@@ -31,6 +31,8 @@
 #ifndef PACKED_SCENE_H
 #define PACKED_SCENE_H
 
+#include "core/class_db.h"
+#include "core/os/mutex.h"
 #include "core/resource.h"
 #include "scene/main/node.h"
 
@@ -92,6 +94,22 @@ class SceneState : public Reference {
 
 	Vector<ConnectionData> connections;
 
+	//what instance() resolved for each node the last time, kept until the state changes
+	struct PlanNode {
+
+		ClassDB::CreationFunc creation_func;
+		StringName class_name;
+		Vector<const ClassDB::PropertySetGet *> setters; //one per property, NULL means use Object::set()
+		Vector<bool> resources; //property value is a resource, may need to be made local to scene
+	};
+
+	mutable Vector<PlanNode> plan;
+	mutable bool plan_valid;
+	mutable Mutex plan_mutex;
+
+	void _build_plan() const;
+	_FORCE_INLINE_ void _invalidate_plan() { plan_valid = false; }
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 
@@ -221,6 +239,7 @@ public:
 
 	bool can_instance() const;
 	Node *instance(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
+	Array instance_multiple(int p_count, GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
 
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
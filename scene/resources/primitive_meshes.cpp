@@ -46,16 +46,7 @@ void PrimitiveMesh::_update() const {
 
 	int pc = points.size();
 	ERR_FAIL_COND(pc == 0);
-	{
-
-		const Vector3 *r = points.ptr();
-		for (int i = 0; i < pc; i++) {
-			if (i == 0)
-				aabb.position = r[i];
-			else
-				aabb.expand_to(r[i]);
-		}
-	}
+	aabb.create_from_points(points.ptr(), pc);
 
 	Vector<int> indices = arr[RS::ARRAY_INDEX];
 
@@ -799,7 +799,7 @@ Error ResourceLoaderText::rename_dependencies(FileAccess *p_f, const String &p_p
 
 	String base_path = local_path.get_base_dir();
 
-	uint64_t tag_end = f->get_position();
+	uint64_t tag_end = stream.get_position();
 
 	while (true) {
 
@@ -861,7 +861,7 @@ Error ResourceLoaderText::rename_dependencies(FileAccess *p_f, const String &p_p
 
 			fw->store_line("[ext_resource path=\"" + path + "\" type=\"" + type + "\" id=" + itos(index) + "]");
 
-			tag_end = f->get_position();
+			tag_end = stream.get_position();
 		}
 	}
 
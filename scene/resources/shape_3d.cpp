@@ -43,10 +43,7 @@ void Shape3D::add_vertices_to_array(Vector<Vector3> &array, const Transform &p_x
 
 		int base = array.size();
 		array.resize(base + toadd.size());
-		Vector3 *w = array.ptrw();
-		for (int i = 0; i < toadd.size(); i++) {
-			w[i + base] = p_xform.xform(toadd[i]);
-		}
+		p_xform.xform(toadd.ptr(), array.ptrw() + base, toadd.size());
 	}
 }
 
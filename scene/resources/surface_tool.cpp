@@ -30,6 +30,7 @@
 
 #include "surface_tool.h"
 
+#include "core/local_vector.h"
 #include "core/method_bind_ext.gen.inc"
 
 #define _VERTEX_SNAP 0.0001
@@ -71,17 +72,25 @@ bool SurfaceTool::Vertex::operator==(const Vertex &p_vertex) const {
 	return true;
 }
 
+static _FORCE_INLINE_ uint32_t _hash_float(float p_value, uint32_t p_prev) {
+
+	// +0 and -0 compare equal, so they must hash the same.
+	return hash_djb2_one_32(p_value == 0 ? 0 : make_uint32_t(p_value), p_prev);
+}
+
 uint32_t SurfaceTool::VertexHasher::hash(const Vertex &p_vtx) {
 
-	uint32_t h = hash_djb2_buffer((const uint8_t *)&p_vtx.vertex, sizeof(real_t) * 3);
-	h = hash_djb2_buffer((const uint8_t *)&p_vtx.normal, sizeof(real_t) * 3, h);
-	h = hash_djb2_buffer((const uint8_t *)&p_vtx.binormal, sizeof(real_t) * 3, h);
-	h = hash_djb2_buffer((const uint8_t *)&p_vtx.tangent, sizeof(real_t) * 3, h);
-	h = hash_djb2_buffer((const uint8_t *)&p_vtx.uv, sizeof(real_t) * 2, h);
-	h = hash_djb2_buffer((const uint8_t *)&p_vtx.uv2, sizeof(real_t) * 2, h);
-	h = hash_djb2_buffer((const uint8_t *)&p_vtx.color, sizeof(real_t) * 4, h);
-	h = hash_djb2_buffer((const uint8_t *)p_vtx.bones.ptr(), p_vtx.bones.size() * sizeof(int), h);
-	h = hash_djb2_buffer((const uint8_t *)p_vtx.weights.ptr(), p_vtx.weights.size() * sizeof(float), h);
+	// Only what tells vertices apart most of the time is hashed, word by word.
+	// Everything hashed is also compared, so equal vertices always hash the same.
+	uint32_t h = 5381;
+	h = _hash_float(p_vtx.vertex.x, h);
+	h = _hash_float(p_vtx.vertex.y, h);
+	h = _hash_float(p_vtx.vertex.z, h);
+	h = _hash_float(p_vtx.normal.x, h);
+	h = _hash_float(p_vtx.normal.y, h);
+	h = _hash_float(p_vtx.normal.z, h);
+	h = _hash_float(p_vtx.uv.x, h);
+	h = _hash_float(p_vtx.uv.y, h);
 	return h;
 }
 
@@ -293,9 +302,9 @@ Array SurfaceTool::commit_to_arrays() {
 				Vector3 *w = array.ptrw();
 
 				int idx = 0;
-				for (List<Vertex>::Element *E = vertex_array.front(); E; E = E->next(), idx++) {
+				for (uint32_t n = 0; n < vertex_array.size(); n++, idx++) {
 
-					const Vertex &v = E->get();
+					const Vertex &v = vertex_array[n];
 
 					switch (i) {
 						case Mesh::ARRAY_VERTEX: {
@@ -319,9 +328,9 @@ Array SurfaceTool::commit_to_arrays() {
 				Vector2 *w = array.ptrw();
 
 				int idx = 0;
-				for (List<Vertex>::Element *E = vertex_array.front(); E; E = E->next(), idx++) {
+				for (uint32_t n = 0; n < vertex_array.size(); n++, idx++) {
 
-					const Vertex &v = E->get();
+					const Vertex &v = vertex_array[n];
 
 					switch (i) {
 
@@ -343,9 +352,9 @@ Array SurfaceTool::commit_to_arrays() {
 				float *w = array.ptrw();
 
 				int idx = 0;
-				for (List<Vertex>::Element *E = vertex_array.front(); E; E = E->next(), idx += 4) {
+				for (uint32_t n = 0; n < vertex_array.size(); n++, idx += 4) {
 
-					const Vertex &v = E->get();
+					const Vertex &v = vertex_array[n];
 
 					w[idx + 0] = v.tangent.x;
 					w[idx + 1] = v.tangent.y;
@@ -366,9 +375,9 @@ Array SurfaceTool::commit_to_arrays() {
 				Color *w = array.ptrw();
 
 				int idx = 0;
-				for (List<Vertex>::Element *E = vertex_array.front(); E; E = E->next(), idx++) {
+				for (uint32_t n = 0; n < vertex_array.size(); n++, idx++) {
 
-					const Vertex &v = E->get();
+					const Vertex &v = vertex_array[n];
 					w[idx] = v.color;
 				}
 
@@ -381,9 +390,9 @@ Array SurfaceTool::commit_to_arrays() {
 				int *w = array.ptrw();
 
 				int idx = 0;
-				for (List<Vertex>::Element *E = vertex_array.front(); E; E = E->next(), idx += 4) {
+				for (uint32_t n = 0; n < vertex_array.size(); n++, idx += 4) {
 
-					const Vertex &v = E->get();
+					const Vertex &v = vertex_array[n];
 
 					ERR_CONTINUE(v.bones.size() != 4);
 
@@ -402,9 +411,9 @@ Array SurfaceTool::commit_to_arrays() {
 				float *w = array.ptrw();
 
 				int idx = 0;
-				for (List<Vertex>::Element *E = vertex_array.front(); E; E = E->next(), idx += 4) {
+				for (uint32_t n = 0; n < vertex_array.size(); n++, idx += 4) {
 
-					const Vertex &v = E->get();
+					const Vertex &v = vertex_array[n];
 					ERR_CONTINUE(v.weights.size() != 4);
 
 					for (int j = 0; j < 4; j++) {
@@ -424,10 +433,8 @@ Array SurfaceTool::commit_to_arrays() {
 				array.resize(index_array.size());
 				int *w = array.ptrw();
 
-				int idx = 0;
-				for (List<int>::Element *E = index_array.front(); E; E = E->next(), idx++) {
-
-					w[idx] = E->get();
+				for (uint32_t n = 0; n < index_array.size(); n++) {
+					w[n] = index_array[n];
 				}
 
 				a[i] = array;
@@ -443,6 +450,8 @@ Array SurfaceTool::commit_to_arrays() {
 
 Ref<ArrayMesh> SurfaceTool::commit(const Ref<ArrayMesh> &p_existing, uint32_t p_flags) {
 
+	MemoryTagScope memory_tag(Memory::TAG_MESHES);
+
 	Ref<ArrayMesh> mesh;
 	if (p_existing.is_valid())
 		mesh = p_existing;
@@ -471,25 +480,47 @@ void SurfaceTool::index() {
 	if (index_array.size())
 		return; //already indexed
 
-	HashMap<Vertex, int, VertexHasher> indices;
-	List<Vertex> new_vertices;
+	// Flat open addressing table of new vertex indices, kept at most half full.
+	const uint32_t empty = 0xFFFFFFFF;
+	uint32_t capacity = next_power_of_2(MAX(vertex_array.size() * 2, 16u));
+	uint32_t mask = capacity - 1;
 
-	for (List<Vertex>::Element *E = vertex_array.front(); E; E = E->next()) {
+	LocalVector<uint32_t> table;
+	table.resize(capacity);
+	for (uint32_t i = 0; i < capacity; i++) {
+		table[i] = empty;
+	}
 
-		int *idxptr = indices.getptr(E->get());
-		int idx;
-		if (!idxptr) {
-			idx = indices.size();
-			new_vertices.push_back(E->get());
-			indices[E->get()] = idx;
-		} else {
-			idx = *idxptr;
+	LocalVector<Vertex> new_vertices;
+	LocalVector<uint32_t> hashes;
+	new_vertices.reserve(vertex_array.size());
+	hashes.reserve(vertex_array.size());
+	index_array.resize(vertex_array.size());
+
+	for (uint32_t i = 0; i < vertex_array.size(); i++) {
+
+		const Vertex &v = vertex_array[i];
+		uint32_t h = VertexHasher::hash(v);
+		uint32_t slot = h & mask;
+
+		while (true) {
+			uint32_t idx = table[slot];
+			if (idx == empty) {
+				idx = new_vertices.size();
+				table[slot] = idx;
+				new_vertices.push_back(v);
+				hashes.push_back(h);
+				index_array[i] = idx;
+				break;
+			}
+			if (hashes[idx] == h && new_vertices[idx] == v) {
+				index_array[i] = idx;
+				break;
+			}
+			slot = (slot + 1) & mask;
 		}
-
-		index_array.push_back(idx);
 	}
 
-	vertex_array.clear();
 	vertex_array = new_vertices;
 
 	format |= Mesh::ARRAY_FORMAT_INDEX;
@@ -499,24 +530,20 @@ void SurfaceTool::deindex() {
 
 	if (index_array.size() == 0)
 		return; //nothing to deindex
-	Vector<Vertex> varr;
-	varr.resize(vertex_array.size());
-	int idx = 0;
-	for (List<Vertex>::Element *E = vertex_array.front(); E; E = E->next()) {
 
-		varr.write[idx++] = E->get();
-	}
-	vertex_array.clear();
-	for (List<int>::Element *E = index_array.front(); E; E = E->next()) {
+	LocalVector<Vertex> varr;
+	varr.resize(index_array.size());
+	for (uint32_t i = 0; i < index_array.size(); i++) {
 
-		ERR_FAIL_INDEX(E->get(), varr.size());
-		vertex_array.push_back(varr[E->get()]);
+		ERR_FAIL_INDEX(index_array[i], (int)vertex_array.size());
+		varr[i] = vertex_array[index_array[i]];
 	}
+	vertex_array = varr;
 	format &= ~Mesh::ARRAY_FORMAT_INDEX;
 	index_array.clear();
 }
 
-void SurfaceTool::_create_list(const Ref<Mesh> &p_existing, int p_surface, List<Vertex> *r_vertex, List<int> *r_index, int &lformat) {
+void SurfaceTool::_create_list(const Ref<Mesh> &p_existing, int p_surface, LocalVector<Vertex> *r_vertex, LocalVector<int> *r_index, int &lformat) {
 
 	Array arr = p_existing->surface_get_arrays(p_surface);
 	ERR_FAIL_COND(arr.size() != RS::ARRAY_MAX);
@@ -608,7 +635,7 @@ Vector<SurfaceTool::Vertex> SurfaceTool::create_vertex_array_from_triangle_array
 	return ret;
 }
 
-void SurfaceTool::_create_list_from_arrays(Array arr, List<Vertex> *r_vertex, List<int> *r_index, int &lformat) {
+void SurfaceTool::_create_list_from_arrays(Array arr, LocalVector<Vertex> *r_vertex, LocalVector<int> *r_index, int &lformat) {
 
 	Vector<Vector3> varr = arr[RS::ARRAY_VERTEX];
 	Vector<Vector3> narr = arr[RS::ARRAY_NORMAL];
@@ -649,6 +676,10 @@ void SurfaceTool::_create_list_from_arrays(Array arr, List<Vertex> *r_vertex, Li
 		lformat |= RS::ARRAY_FORMAT_WEIGHTS;
 	}
 
+	r_vertex->reserve(r_vertex->size() + vc);
+
+	r_vertex->reserve(r_vertex->size() + vc);
+
 	for (int i = 0; i < vc; i++) {
 		Vertex v;
 		if (lformat & RS::ARRAY_FORMAT_VERTEX)
@@ -696,6 +727,7 @@ void SurfaceTool::_create_list_from_arrays(Array arr, List<Vertex> *r_vertex, Li
 
 		lformat |= RS::ARRAY_FORMAT_INDEX;
 		const int *iarr = idx.ptr();
+		r_index->reserve(r_index->size() + is);
 		for (int i = 0; i < is; i++) {
 			r_index->push_back(iarr[i]);
 		}
@@ -745,15 +777,16 @@ void SurfaceTool::append_from(const Ref<Mesh> &p_existing, int p_surface, const
 	}
 
 	int nformat;
-	List<Vertex> nvertices;
-	List<int> nindices;
+	LocalVector<Vertex> nvertices;
+	LocalVector<int> nindices;
 	_create_list(p_existing, p_surface, &nvertices, &nindices, nformat);
 	format |= nformat;
 	int vfrom = vertex_array.size();
 
-	for (List<Vertex>::Element *E = nvertices.front(); E; E = E->next()) {
+	vertex_array.reserve(vertex_array.size() + nvertices.size());
+	for (uint32_t i = 0; i < nvertices.size(); i++) {
 
-		Vertex v = E->get();
+		Vertex v = nvertices[i];
 		v.vertex = p_xform.xform(v.vertex);
 		if (nformat & RS::ARRAY_FORMAT_NORMAL) {
 			v.normal = p_xform.basis.xform(v.normal);
@@ -766,9 +799,10 @@ void SurfaceTool::append_from(const Ref<Mesh> &p_existing, int p_surface, const
 		vertex_array.push_back(v);
 	}
 
-	for (List<int>::Element *E = nindices.front(); E; E = E->next()) {
+	index_array.reserve(index_array.size() + nindices.size());
+	for (uint32_t i = 0; i < nindices.size(); i++) {
 
-		int dst_index = E->get() + vfrom;
+		int dst_index = nindices[i] + vfrom;
 		index_array.push_back(dst_index);
 	}
 	if (index_array.size() % 3) {
@@ -779,8 +813,10 @@ void SurfaceTool::append_from(const Ref<Mesh> &p_existing, int p_surface, const
 //mikktspace callbacks
 namespace {
 struct TangentGenerationContextUserData {
-	Vector<List<SurfaceTool::Vertex>::Element *> vertices;
-	Vector<List<int>::Element *> indices;
+	SurfaceTool::Vertex *vertices;
+	int vertex_count;
+	const int *indices;
+	int index_count;
 };
 } // namespace
 
@@ -788,10 +824,10 @@ int SurfaceTool::mikktGetNumFaces(const SMikkTSpaceContext *pContext) {
 
 	TangentGenerationContextUserData &triangle_data = *reinterpret_cast<TangentGenerationContextUserData *>(pContext->m_pUserData);
 
-	if (triangle_data.indices.size() > 0) {
-		return triangle_data.indices.size() / 3;
+	if (triangle_data.index_count > 0) {
+		return triangle_data.index_count / 3;
 	} else {
-		return triangle_data.vertices.size() / 3;
+		return triangle_data.vertex_count / 3;
 	}
 }
 int SurfaceTool::mikktGetNumVerticesOfFace(const SMikkTSpaceContext *pContext, const int iFace) {
@@ -802,13 +838,13 @@ void SurfaceTool::mikktGetPosition(const SMikkTSpaceContext *pContext, float fvP
 
 	TangentGenerationContextUserData &triangle_data = *reinterpret_cast<TangentGenerationContextUserData *>(pContext->m_pUserData);
 	Vector3 v;
-	if (triangle_data.indices.size() > 0) {
-		int index = triangle_data.indices[iFace * 3 + iVert]->get();
-		if (index < triangle_data.vertices.size()) {
-			v = triangle_data.vertices[index]->get().vertex;
+	if (triangle_data.index_count > 0) {
+		int index = triangle_data.indices[iFace * 3 + iVert];
+		if (index < triangle_data.vertex_count) {
+			v = triangle_data.vertices[index].vertex;
 		}
 	} else {
-		v = triangle_data.vertices[iFace * 3 + iVert]->get().vertex;
+		v = triangle_data.vertices[iFace * 3 + iVert].vertex;
 	}
 
 	fvPosOut[0] = v.x;
@@ -820,13 +856,13 @@ void SurfaceTool::mikktGetNormal(const SMikkTSpaceContext *pContext, float fvNor
 
 	TangentGenerationContextUserData &triangle_data = *reinterpret_cast<TangentGenerationContextUserData *>(pContext->m_pUserData);
 	Vector3 v;
-	if (triangle_data.indices.size() > 0) {
-		int index = triangle_data.indices[iFace * 3 + iVert]->get();
-		if (index < triangle_data.vertices.size()) {
-			v = triangle_data.vertices[index]->get().normal;
+	if (triangle_data.index_count > 0) {
+		int index = triangle_data.indices[iFace * 3 + iVert];
+		if (index < triangle_data.vertex_count) {
+			v = triangle_data.vertices[index].normal;
 		}
 	} else {
-		v = triangle_data.vertices[iFace * 3 + iVert]->get().normal;
+		v = triangle_data.vertices[iFace * 3 + iVert].normal;
 	}
 
 	fvNormOut[0] = v.x;
@@ -837,13 +873,13 @@ void SurfaceTool::mikktGetTexCoord(const SMikkTSpaceContext *pContext, float fvT
 
 	TangentGenerationContextUserData &triangle_data = *reinterpret_cast<TangentGenerationContextUserData *>(pContext->m_pUserData);
 	Vector2 v;
-	if (triangle_data.indices.size() > 0) {
-		int index = triangle_data.indices[iFace * 3 + iVert]->get();
-		if (index < triangle_data.vertices.size()) {
-			v = triangle_data.vertices[index]->get().uv;
+	if (triangle_data.index_count > 0) {
+		int index = triangle_data.indices[iFace * 3 + iVert];
+		if (index < triangle_data.vertex_count) {
+			v = triangle_data.vertices[index].uv;
 		}
 	} else {
-		v = triangle_data.vertices[iFace * 3 + iVert]->get().uv;
+		v = triangle_data.vertices[iFace * 3 + iVert].uv;
 	}
 
 	fvTexcOut[0] = v.x;
@@ -855,13 +891,13 @@ void SurfaceTool::mikktSetTSpaceDefault(const SMikkTSpaceContext *pContext, cons
 
 	TangentGenerationContextUserData &triangle_data = *reinterpret_cast<TangentGenerationContextUserData *>(pContext->m_pUserData);
 	Vertex *vtx = NULL;
-	if (triangle_data.indices.size() > 0) {
-		int index = triangle_data.indices[iFace * 3 + iVert]->get();
-		if (index < triangle_data.vertices.size()) {
-			vtx = &triangle_data.vertices[index]->get();
+	if (triangle_data.index_count > 0) {
+		int index = triangle_data.indices[iFace * 3 + iVert];
+		if (index < triangle_data.vertex_count) {
+			vtx = &triangle_data.vertices[index];
 		}
 	} else {
-		vtx = &triangle_data.vertices[iFace * 3 + iVert]->get();
+		vtx = &triangle_data.vertices[iFace * 3 + iVert];
 	}
 
 	if (vtx != NULL) {
@@ -887,19 +923,16 @@ void SurfaceTool::generate_tangents() {
 	SMikkTSpaceContext msc;
 	msc.m_pInterface = &mkif;
 
-	TangentGenerationContextUserData triangle_data;
-	triangle_data.vertices.resize(vertex_array.size());
-	int idx = 0;
-	for (List<Vertex>::Element *E = vertex_array.front(); E; E = E->next()) {
-		triangle_data.vertices.write[idx++] = E;
-		E->get().binormal = Vector3();
-		E->get().tangent = Vector3();
-	}
-	triangle_data.indices.resize(index_array.size());
-	idx = 0;
-	for (List<int>::Element *E = index_array.front(); E; E = E->next()) {
-		triangle_data.indices.write[idx++] = E;
+	for (uint32_t i = 0; i < vertex_array.size(); i++) {
+		vertex_array[i].binormal = Vector3();
+		vertex_array[i].tangent = Vector3();
 	}
+
+	TangentGenerationContextUserData triangle_data;
+	triangle_data.vertices = vertex_array.ptr();
+	triangle_data.vertex_count = vertex_array.size();
+	triangle_data.indices = index_array.ptr();
+	triangle_data.index_count = index_array.size();
 	msc.m_pUserData = &triangle_data;
 
 	bool res = genTangSpaceDefault(&msc);
@@ -916,6 +949,8 @@ void SurfaceTool::generate_normals(bool p_flip) {
 
 	deindex();
 
+	ERR_FAIL_COND(vertex_array.size() % 3 != 0);
+
 	HashMap<Vertex, Vector3, VertexHasher> vertex_hash;
 
 	int count = 0;
@@ -923,30 +958,26 @@ void SurfaceTool::generate_normals(bool p_flip) {
 	if (smooth_groups.has(0))
 		smooth = smooth_groups[0];
 
-	List<Vertex>::Element *B = vertex_array.front();
-	for (List<Vertex>::Element *E = B; E;) {
+	uint32_t vertex_count = vertex_array.size();
+	uint32_t group_from = 0;
+
+	for (uint32_t vi = 0; vi < vertex_count; vi += 3) {
 
-		List<Vertex>::Element *v[3];
-		v[0] = E;
-		v[1] = v[0]->next();
-		ERR_FAIL_COND(!v[1]);
-		v[2] = v[1]->next();
-		ERR_FAIL_COND(!v[2]);
-		E = v[2]->next();
+		Vertex *v = &vertex_array[vi];
 
 		Vector3 normal;
 		if (!p_flip)
-			normal = Plane(v[0]->get().vertex, v[1]->get().vertex, v[2]->get().vertex).normal;
+			normal = Plane(v[0].vertex, v[1].vertex, v[2].vertex).normal;
 		else
-			normal = Plane(v[2]->get().vertex, v[1]->get().vertex, v[0]->get().vertex).normal;
+			normal = Plane(v[2].vertex, v[1].vertex, v[0].vertex).normal;
 
 		if (smooth) {
 
 			for (int i = 0; i < 3; i++) {
 
-				Vector3 *lv = vertex_hash.getptr(v[i]->get());
+				Vector3 *lv = vertex_hash.getptr(v[i]);
 				if (!lv) {
-					vertex_hash.set(v[i]->get(), normal);
+					vertex_hash.set(v[i], normal);
 				} else {
 					(*lv) += normal;
 				}
@@ -955,31 +986,30 @@ void SurfaceTool::generate_normals(bool p_flip) {
 
 			for (int i = 0; i < 3; i++) {
 
-				v[i]->get().normal = normal;
+				v[i].normal = normal;
 			}
 		}
 		count += 3;
 
-		if (smooth_groups.has(count) || !E) {
+		uint32_t group_end = vi + 3;
+		if (smooth_groups.has(count) || group_end == vertex_count) {
 
 			if (vertex_hash.size()) {
 
-				while (B != E) {
+				for (; group_from < group_end; group_from++) {
 
-					Vector3 *lv = vertex_hash.getptr(B->get());
+					Vector3 *lv = vertex_hash.getptr(vertex_array[group_from]);
 					if (lv) {
-						B->get().normal = lv->normalized();
+						vertex_array[group_from].normal = lv->normalized();
 					}
-
-					B = B->next();
 				}
 
 			} else {
-				B = E;
+				group_from = group_end;
 			}
 
 			vertex_hash.clear();
-			if (E) {
+			if (group_end < vertex_count) {
 				smooth = smooth_groups[count];
 			}
 		}
@@ -993,6 +1023,511 @@ void SurfaceTool::generate_normals(bool p_flip) {
 	}
 }
 
+// Quadric error metric, stored as the symmetric 4x4 matrix of the summed squared plane distances.
+struct _LODQuadric {
+
+	double xx = 0, xy = 0, xz = 0, yy = 0, yz = 0, zz = 0;
+	double dx = 0, dy = 0, dz = 0, dd = 0;
+	double weight = 0;
+
+	void add_plane(const Vector3 &p_normal, double p_d, double p_weight) {
+
+		double nx = p_normal.x, ny = p_normal.y, nz = p_normal.z;
+		xx += nx * nx * p_weight;
+		xy += nx * ny * p_weight;
+		xz += nx * nz * p_weight;
+		yy += ny * ny * p_weight;
+		yz += ny * nz * p_weight;
+		zz += nz * nz * p_weight;
+		dx += nx * p_d * p_weight;
+		dy += ny * p_d * p_weight;
+		dz += nz * p_d * p_weight;
+		dd += p_d * p_d * p_weight;
+		weight += p_weight;
+	}
+
+	void add(const _LODQuadric &p_q) {
+
+		xx += p_q.xx;
+		xy += p_q.xy;
+		xz += p_q.xz;
+		yy += p_q.yy;
+		yz += p_q.yz;
+		zz += p_q.zz;
+		dx += p_q.dx;
+		dy += p_q.dy;
+		dz += p_q.dz;
+		dd += p_q.dd;
+		weight += p_q.weight;
+	}
+
+	double evaluate(const Vector3 &p_pos) const {
+
+		double x = p_pos.x, y = p_pos.y, z = p_pos.z;
+		return xx * x * x + 2.0 * xy * x * y + 2.0 * xz * x * z + yy * y * y + 2.0 * yz * y * z + zz * z * z + 2.0 * (dx * x + dy * y + dz * z) + dd;
+	}
+};
+
+struct _LODCollapse {
+
+	uint32_t from;
+	uint32_t to;
+	double error;
+
+	bool operator<(const _LODCollapse &p_other) const {
+		return error < p_other.error;
+	}
+};
+
+struct _LODVertexSort {
+
+	const Vector3 *vertices;
+
+	bool operator()(uint32_t p_a, uint32_t p_b) const {
+		const Vector3 &a = vertices[p_a];
+		const Vector3 &b = vertices[p_b];
+		if (a.x != b.x) {
+			return a.x < b.x;
+		}
+		if (a.y != b.y) {
+			return a.y < b.y;
+		}
+		return a.z < b.z;
+	}
+};
+
+enum {
+	_LOD_VERTEX_FREE,
+	_LOD_VERTEX_BORDER,
+	_LOD_VERTEX_LOCKED,
+};
+
+static uint64_t _lod_edge_key(uint64_t p_a, uint64_t p_b) {
+	return p_a < p_b ? (p_a << 32) | p_b : (p_b << 32) | p_a;
+}
+
+static bool _lod_is_border_edge(const LocalVector<uint64_t> &p_border_edges, uint32_t p_a, uint32_t p_b) {
+
+	uint64_t key = _lod_edge_key(p_a, p_b);
+	int64_t low = 0;
+	int64_t high = int64_t(p_border_edges.size()) - 1;
+	while (low <= high) {
+		int64_t middle = (low + high) / 2;
+		if (p_border_edges[middle] == key) {
+			return true;
+		} else if (p_border_edges[middle] < key) {
+			low = middle + 1;
+		} else {
+			high = middle - 1;
+		}
+	}
+	return false;
+}
+
+//finds the border edges (used by a single triangle) and which vertices can move freely, only along the border or not at all
+static void _lod_classify_vertices(const LocalVector<uint32_t> &p_indices, const LocalVector<uint8_t> &p_locked, LocalVector<uint8_t> &r_kind, LocalVector<uint64_t> &r_border_edges) {
+
+	LocalVector<uint64_t> edges;
+	edges.resize(p_indices.size());
+	for (uint32_t i = 0; i < p_indices.size(); i += 3) {
+		for (uint32_t j = 0; j < 3; j++) {
+			edges[i + j] = _lod_edge_key(p_indices[i + j], p_indices[i + (j + 1) % 3]);
+		}
+	}
+
+	SortArray<uint64_t> sorter;
+	sorter.sort(edges.ptr(), edges.size());
+
+	LocalVector<uint8_t> border_count;
+	border_count.resize(r_kind.size());
+	for (uint32_t i = 0; i < r_kind.size(); i++) {
+		r_kind[i] = p_locked[i] ? _LOD_VERTEX_LOCKED : _LOD_VERTEX_FREE;
+		border_count[i] = 0;
+	}
+
+	r_border_edges.clear();
+	uint32_t from = 0;
+	for (uint32_t i = 1; i <= edges.size(); i++) {
+		if (i < edges.size() && edges[i] == edges[from]) {
+			continue;
+		}
+		uint32_t a = edges[from] >> 32;
+		uint32_t b = edges[from] & 0xFFFFFFFF;
+		if (i - from == 1) {
+			r_border_edges.push_back(edges[from]);
+			border_count[a] = MIN(border_count[a] + 1, 255);
+			border_count[b] = MIN(border_count[b] + 1, 255);
+		} else if (i - from > 2) {
+			//non manifold
+			r_kind[a] = _LOD_VERTEX_LOCKED;
+			r_kind[b] = _LOD_VERTEX_LOCKED;
+		}
+		from = i;
+	}
+
+	for (uint32_t i = 0; i < r_kind.size(); i++) {
+		if (border_count[i] == 0 || r_kind[i] == _LOD_VERTEX_LOCKED) {
+			continue;
+		}
+		//corners, where borders meet, stay
+		r_kind[i] = border_count[i] == 2 ? _LOD_VERTEX_BORDER : _LOD_VERTEX_LOCKED;
+	}
+}
+
+//collapsing p_from into p_to must not flip or squash the triangles that remain around p_from
+static bool _lod_collapse_is_valid(const Vector3 *p_vertices, const LocalVector<uint32_t> &p_indices, const uint32_t *p_triangles, uint32_t p_count, uint32_t p_from, uint32_t p_to) {
+
+	for (uint32_t i = 0; i < p_count; i++) {
+
+		const uint32_t *tri = &p_indices[p_triangles[i] * 3];
+		if (tri[0] == p_to || tri[1] == p_to || tri[2] == p_to) {
+			continue; //this one goes away
+		}
+
+		Vector3 a = p_vertices[tri[0]];
+		Vector3 b = p_vertices[tri[1]];
+		Vector3 c = p_vertices[tri[2]];
+		Vector3 old_normal = (b - a).cross(c - a);
+
+		if (tri[0] == p_from) {
+			a = p_vertices[p_to];
+		} else if (tri[1] == p_from) {
+			b = p_vertices[p_to];
+		} else {
+			c = p_vertices[p_to];
+		}
+		Vector3 new_normal = (b - a).cross(c - a);
+
+		real_t len = old_normal.length() * new_normal.length();
+		if (len <= CMP_EPSILON2 || old_normal.dot(new_normal) < len * 0.5) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//the link condition, both ends of the edge must share no neighbours other than the ones opposite to it, or the surface folds
+static bool _lod_collapse_keeps_manifold(const LocalVector<uint32_t> &p_indices, const uint32_t *p_from_triangles, uint32_t p_from_count, const uint32_t *p_to_triangles, uint32_t p_to_count, uint32_t p_from, uint32_t p_to) {
+
+	uint32_t shared = 0;
+	for (uint32_t i = 0; i < p_from_count; i++) {
+		const uint32_t *tri = &p_indices[p_from_triangles[i] * 3];
+		if (tri[0] == p_to || tri[1] == p_to || tri[2] == p_to) {
+			shared++;
+		}
+	}
+
+	uint32_t common = 0;
+	for (uint32_t i = 0; i < p_from_count; i++) {
+		const uint32_t *tri_a = &p_indices[p_from_triangles[i] * 3];
+		for (uint32_t j = 0; j < 3; j++) {
+			uint32_t n = tri_a[j];
+			if (n == p_from || n == p_to) {
+				continue;
+			}
+			//count each neighbour of p_from once, through the first triangle it appears in
+			bool first = true;
+			for (uint32_t k = 0; k < i && first; k++) {
+				const uint32_t *prev = &p_indices[p_from_triangles[k] * 3];
+				first = prev[0] != n && prev[1] != n && prev[2] != n;
+			}
+			if (!first) {
+				continue;
+			}
+			for (uint32_t k = 0; k < p_to_count; k++) {
+				const uint32_t *tri_b = &p_indices[p_to_triangles[k] * 3];
+				if (tri_b[0] == n || tri_b[1] == n || tri_b[2] == n) {
+					common++;
+					break;
+				}
+			}
+		}
+	}
+
+	return common <= shared;
+}
+
+// Edge collapse simplification using quadric error metrics. Vertices are only ever moved onto existing
+// ones, so the result is an index array for the same vertex array. Vertices on open borders can only slide
+// along them, the ones on non manifold edges or attribute seams (several vertices sharing a position) stay.
+// When r_error is provided, it receives the largest deviation introduced, in mesh units.
+Vector<int> SurfaceTool::generate_lod(const Vector<Vector3> &p_vertices, const Vector<int> &p_indices, int p_target_index_count, float *r_error) {
+
+	ERR_FAIL_COND_V(p_indices.size() % 3 != 0, Vector<int>());
+
+	uint32_t vertex_count = p_vertices.size();
+	const Vector3 *vertices = p_vertices.ptr();
+
+	LocalVector<uint32_t> indices;
+	indices.resize(p_indices.size());
+	for (int i = 0; i < p_indices.size(); i++) {
+		ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_indices[i], vertex_count, Vector<int>());
+		indices[i] = p_indices[i];
+	}
+
+	LocalVector<uint8_t> locked;
+	locked.resize(vertex_count);
+	LocalVector<uint8_t> used;
+	used.resize(vertex_count);
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		locked[i] = 0;
+		used[i] = 0;
+	}
+	for (uint32_t i = 0; i < indices.size(); i++) {
+		used[indices[i]] = 1;
+	}
+
+	//weld positions, vertices sharing one are seams
+	LocalVector<uint32_t> position_id;
+	position_id.resize(vertex_count);
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		position_id[i] = i;
+	}
+	{
+		LocalVector<uint32_t> order;
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			if (used[i]) {
+				order.push_back(i);
+			}
+		}
+
+		SortArray<uint32_t, _LODVertexSort> sorter;
+		sorter.compare.vertices = vertices;
+		sorter.sort(order.ptr(), order.size());
+
+		uint32_t from = 0;
+		for (uint32_t i = 1; i <= order.size(); i++) {
+			if (i < order.size() && vertices[order[i]] == vertices[order[from]]) {
+				continue;
+			}
+			for (uint32_t j = from; j < i; j++) {
+				position_id[order[j]] = order[from];
+				if (i - from > 1) {
+					locked[order[j]] = 1;
+				}
+			}
+			from = i;
+		}
+	}
+
+	//quadrics are kept per position, so seams see the planes from both sides
+	LocalVector<_LODQuadric> quadrics;
+	quadrics.resize(vertex_count);
+	for (uint32_t i = 0; i < indices.size(); i += 3) {
+
+		const Vector3 &a = vertices[indices[i + 0]];
+		Vector3 normal = (vertices[indices[i + 1]] - a).cross(vertices[indices[i + 2]] - a);
+		real_t area = normal.length();
+		if (area <= CMP_EPSILON2) {
+			continue;
+		}
+		normal /= area;
+		double d = -normal.dot(a);
+
+		for (uint32_t j = 0; j < 3; j++) {
+			quadrics[position_id[indices[i + j]]].add_plane(normal, d, area);
+		}
+	}
+
+	LocalVector<uint8_t> kind;
+	LocalVector<uint64_t> border_edges;
+	kind.resize(vertex_count);
+	_lod_classify_vertices(indices, locked, kind, border_edges);
+
+	//planes perpendicular to the border keep its outline in place
+	for (uint32_t i = 0; i < indices.size(); i += 3) {
+
+		const Vector3 &a = vertices[indices[i + 0]];
+		Vector3 normal = (vertices[indices[i + 1]] - a).cross(vertices[indices[i + 2]] - a);
+		if (normal.length_squared() <= CMP_EPSILON2) {
+			continue;
+		}
+		normal.normalize();
+
+		for (uint32_t j = 0; j < 3; j++) {
+			uint32_t ia = indices[i + j];
+			uint32_t ib = indices[i + (j + 1) % 3];
+			if (!_lod_is_border_edge(border_edges, ia, ib)) {
+				continue;
+			}
+			Vector3 edge = vertices[ib] - vertices[ia];
+			Vector3 plane_normal = edge.cross(normal);
+			real_t len = plane_normal.length();
+			if (len <= CMP_EPSILON2) {
+				continue;
+			}
+			plane_normal /= len;
+			double d = -plane_normal.dot(vertices[ia]);
+			quadrics[position_id[ia]].add_plane(plane_normal, d, edge.length_squared());
+			quadrics[position_id[ib]].add_plane(plane_normal, d, edge.length_squared());
+		}
+	}
+
+	uint32_t target = MAX(p_target_index_count, 0);
+	double max_error = 0.0;
+
+	LocalVector<uint32_t> triangle_offsets;
+	LocalVector<uint32_t> triangles;
+	LocalVector<uint8_t> touched;
+	LocalVector<uint32_t> remap;
+	LocalVector<_LODCollapse> collapses;
+	triangle_offsets.resize(vertex_count + 1);
+	touched.resize(vertex_count);
+	remap.resize(vertex_count);
+
+	bool first_pass = true;
+
+	while (indices.size() > target) {
+
+		if (!first_pass) {
+			_lod_classify_vertices(indices, locked, kind, border_edges);
+		}
+		first_pass = false;
+
+		//vertex to triangle adjacency
+		for (uint32_t i = 0; i <= vertex_count; i++) {
+			triangle_offsets[i] = 0;
+		}
+		for (uint32_t i = 0; i < indices.size(); i++) {
+			triangle_offsets[indices[i] + 1]++;
+		}
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			triangle_offsets[i + 1] += triangle_offsets[i];
+		}
+		triangles.resize(indices.size());
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			touched[i] = 0;
+			remap[i] = i;
+		}
+		{
+			LocalVector<uint32_t> fill;
+			fill.resize(vertex_count);
+			for (uint32_t i = 0; i < vertex_count; i++) {
+				fill[i] = triangle_offsets[i];
+			}
+			for (uint32_t i = 0; i < indices.size(); i++) {
+				triangles[fill[indices[i]]++] = i / 3;
+			}
+		}
+
+		//cheapest valid collapse for every free vertex
+		collapses.clear();
+		for (uint32_t i = 0; i < vertex_count; i++) {
+
+			uint32_t count = triangle_offsets[i + 1] - triangle_offsets[i];
+			if (kind[i] == _LOD_VERTEX_LOCKED || count == 0) {
+				continue;
+			}
+			const uint32_t *adjacent = &triangles[triangle_offsets[i]];
+
+			_LODCollapse best;
+			best.from = i;
+			best.to = i;
+			best.error = 1e100;
+
+			for (uint32_t j = 0; j < count; j++) {
+				const uint32_t *tri = &indices[adjacent[j] * 3];
+				for (uint32_t k = 0; k < 3; k++) {
+					uint32_t to = tri[k];
+					if (to == i) {
+						continue;
+					}
+					if (kind[i] == _LOD_VERTEX_BORDER && !_lod_is_border_edge(border_edges, i, to)) {
+						continue; //border vertices can only slide along the border
+					}
+
+					const _LODQuadric &qa = quadrics[position_id[i]];
+					const _LODQuadric &qb = quadrics[position_id[to]];
+					double weight = qa.weight + qb.weight;
+					double error = weight > 0.0 ? (qa.evaluate(vertices[to]) + qb.evaluate(vertices[to])) / weight : 0.0;
+					if (error < best.error && _lod_collapse_is_valid(vertices, indices, adjacent, count, i, to) && _lod_collapse_keeps_manifold(indices, adjacent, count, &triangles[triangle_offsets[to]], triangle_offsets[to + 1] - triangle_offsets[to], i, to)) {
+						best.to = to;
+						best.error = error;
+					}
+				}
+			}
+
+			if (best.to != i) {
+				collapses.push_back(best);
+			}
+		}
+
+		if (collapses.size() == 0) {
+			break;
+		}
+
+		collapses.sort();
+
+		//apply as many as possible, as long as their neighbourhoods don't overlap
+		uint32_t remove_goal = indices.size() - target;
+		uint32_t removed = 0;
+		uint32_t applied = 0;
+
+		for (uint32_t i = 0; i < collapses.size() && removed < remove_goal; i++) {
+
+			const _LODCollapse &c = collapses[i];
+			const uint32_t *adjacent = &triangles[triangle_offsets[c.from]];
+			uint32_t count = triangle_offsets[c.from + 1] - triangle_offsets[c.from];
+
+			bool free = true;
+			for (uint32_t j = 0; j < count && free; j++) {
+				const uint32_t *tri = &indices[adjacent[j] * 3];
+				free = !touched[tri[0]] && !touched[tri[1]] && !touched[tri[2]];
+			}
+			if (!free) {
+				continue;
+			}
+
+			for (uint32_t j = 0; j < count; j++) {
+				const uint32_t *tri = &indices[adjacent[j] * 3];
+				if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) {
+					removed += 3;
+				}
+				touched[tri[0]] = 1;
+				touched[tri[1]] = 1;
+				touched[tri[2]] = 1;
+			}
+
+			remap[c.from] = c.to;
+			quadrics[position_id[c.to]].add(quadrics[position_id[c.from]]);
+			max_error = MAX(max_error, c.error);
+			applied++;
+		}
+
+		if (applied == 0) {
+			break;
+		}
+
+		uint32_t write = 0;
+		for (uint32_t i = 0; i < indices.size(); i += 3) {
+			uint32_t a = remap[indices[i + 0]];
+			uint32_t b = remap[indices[i + 1]];
+			uint32_t c = remap[indices[i + 2]];
+			if (a == b || b == c || c == a) {
+				continue;
+			}
+			indices[write++] = a;
+			indices[write++] = b;
+			indices[write++] = c;
+		}
+		indices.resize(write);
+	}
+
+	if (r_error) {
+		*r_error = Math::sqrt(max_error);
+	}
+
+	Vector<int> result;
+	result.resize(indices.size());
+	int *w = result.ptrw();
+	for (uint32_t i = 0; i < indices.size(); i++) {
+		w[i] = indices[i];
+	}
+
+	return result;
+}
+
 void SurfaceTool::set_material(const Ref<Material> &p_material) {
 
 	material = p_material;
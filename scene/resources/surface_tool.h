@@ -31,6 +31,7 @@
 #ifndef SURFACE_TOOL_H
 #define SURFACE_TOOL_H
 
+#include "core/local_vector.h"
 #include "scene/resources/mesh.h"
 
 #include "thirdparty/misc/mikktspace.h"
@@ -76,8 +77,8 @@ private:
 	int format;
 	Ref<Material> material;
 	//arrays
-	List<Vertex> vertex_array;
-	List<int> index_array;
+	LocalVector<Vertex> vertex_array;
+	LocalVector<int> index_array;
 	Map<int, bool> smooth_groups;
 
 	//memory
@@ -89,8 +90,8 @@ private:
 	Vector<float> last_weights;
 	Plane last_tangent;
 
-	void _create_list_from_arrays(Array arr, List<Vertex> *r_vertex, List<int> *r_index, int &lformat);
-	void _create_list(const Ref<Mesh> &p_existing, int p_surface, List<Vertex> *r_vertex, List<int> *r_index, int &lformat);
+	void _create_list_from_arrays(Array arr, LocalVector<Vertex> *r_vertex, LocalVector<int> *r_index, int &lformat);
+	void _create_list(const Ref<Mesh> &p_existing, int p_surface, LocalVector<Vertex> *r_vertex, LocalVector<int> *r_index, int &lformat);
 
 	//mikktspace callbacks
 	static int mikktGetNumFaces(const SMikkTSpaceContext *pContext);
@@ -126,11 +127,13 @@ public:
 	void generate_normals(bool p_flip = false);
 	void generate_tangents();
 
+	static Vector<int> generate_lod(const Vector<Vector3> &p_vertices, const Vector<int> &p_indices, int p_target_index_count, float *r_error = nullptr);
+
 	void set_material(const Ref<Material> &p_material);
 
 	void clear();
 
-	List<Vertex> &get_vertex_array() { return vertex_array; }
+	LocalVector<Vertex> &get_vertex_array() { return vertex_array; }
 
 	void create_from_triangle_arrays(const Array &p_arrays);
 	static Vector<Vertex> create_vertex_array_from_triangle_arrays(const Array &p_arrays);
@@ -32,8 +32,10 @@
 
 #include "core/core_string_names.h"
 #include "core/io/image_loader.h"
+#include "core/message_queue.h"
 #include "core/method_bind_ext.gen.inc"
 #include "core/os/os.h"
+#include "core/project_settings.h"
 #include "mesh.h"
 #include "scene/resources/bit_map.h"
 #include "servers/camera/camera_feed.h"
@@ -167,6 +169,8 @@ void ImageTexture::_reload_hook(const RID &p_hook) {
 
 void ImageTexture::create_from_image(const Ref<Image> &p_image) {
 
+	MemoryTagScope memory_tag(Memory::TAG_TEXTURES);
+
 	ERR_FAIL_COND(p_image.is_null());
 	w = p_image->get_width();
 	h = p_image->get_height();
@@ -379,7 +383,7 @@ Ref<Image> StreamTexture::load_image_from_file(FileAccess *f, int p_size_limit)
 
 			uint32_t size = f->get_32();
 
-			if (p_size_limit > 0 && i < (mipmaps - 1) && (sw > p_size_limit || sh > p_size_limit)) {
+			if (p_size_limit > 0 && i < mipmaps && (sw > p_size_limit || sh > p_size_limit)) {
 				//can't load this due to size limit
 				sw = MAX(sw >> 1, 1);
 				sh = MAX(sh >> 1, 1);
@@ -453,25 +457,25 @@ Ref<Image> StreamTexture::load_image_from_file(FileAccess *f, int p_size_limit)
 				}
 			}
 
-			image->create(w, h, true, mipmap_images[0]->get_format(), img_data);
+			image->create(mipmap_images[0]->get_width(), mipmap_images[0]->get_height(), true, mipmap_images[0]->get_format(), img_data);
 			return image;
 		}
 
 	} else if (data_format == DATA_FORMAT_IMAGE) {
 
 		int size = Image::get_image_data_size(w, h, format, mipmaps ? true : false);
+		size_t data_start = f->get_position();
 
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			int tw, th;
 			int ofs = Image::get_image_mipmap_offset_and_dimensions(w, h, format, i, tw, th);
 
-			if (p_size_limit > 0 && i < mipmaps && (p_size_limit > tw || p_size_limit > th)) {
-				if (ofs) {
-					f->seek(f->get_position() + ofs);
-				}
+			if (p_size_limit > 0 && i < mipmaps && (tw > p_size_limit || th > p_size_limit)) {
 				continue; //oops, size limit enforced, go to next
 			}
 
+			f->seek(data_start + ofs);
+
 			Vector<uint8_t> data;
 			data.resize(size - ofs);
 
@@ -525,6 +529,111 @@ void StreamTexture::_requested_normal(void *p_ud) {
 	request_normal_callback(stex);
 }
 
+Ref<Image> StreamTexture::_load_stream_image(const String &p_path, int p_size_limit) {
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V(!f, Ref<Image>());
+
+	uint8_t header[4];
+	f->get_buffer(header, 4);
+	if (header[0] != 'G' || header[1] != 'S' || header[2] != 'T' || header[3] != '2') {
+		memdelete(f);
+		ERR_FAIL_V_MSG(Ref<Image>(), "Stream texture file is corrupt (Bad header).");
+	}
+
+	//version, custom size, data format and reserved, already known from the first load
+	f->seek(f->get_position() + 8 * 4);
+
+	Ref<Image> image = load_image_from_file(f, p_size_limit);
+	memdelete(f);
+
+	return image;
+}
+
+void StreamTexture::_stream_thread_func(void *p_ud) {
+
+	while (true) {
+
+		stream_semaphore.wait();
+
+		stream_mutex.lock();
+		if (stream_exit) {
+			stream_mutex.unlock();
+			break;
+		}
+		if (stream_requests.empty()) {
+			stream_mutex.unlock();
+			continue;
+		}
+		StreamRequest request = stream_requests.front()->get();
+		stream_requests.pop_front();
+		stream_mutex.unlock();
+
+		Ref<Image> image = _load_stream_image(request.path, request.size);
+
+		//textures can only be replaced from the main thread, the object may also be gone by then
+		MessageQueue::get_singleton()->push_call(request.texture, "_stream_loaded", image);
+	}
+}
+
+void StreamTexture::_requested_stream(void *p_ud, int p_size) {
+
+	StreamTexture *st = (StreamTexture *)p_ud;
+
+	StreamRequest request;
+	request.texture = st->get_instance_id();
+	request.path = st->path_to_file;
+	request.size = p_size;
+
+	MutexLock lock(stream_mutex);
+
+	if (!stream_thread) {
+		stream_exit = false;
+		stream_thread = Thread::create(_stream_thread_func, nullptr);
+	}
+
+	stream_requests.push_back(request);
+	stream_semaphore.post();
+}
+
+void StreamTexture::_stream_loaded(const Ref<Image> &p_image) {
+
+	ERR_FAIL_COND(!texture.is_valid());
+
+	if (p_image.is_null() || p_image->empty()) {
+		//don't keep requesting a file that can't be read
+		RS::get_singleton()->texture_set_stream_callback(texture, 0, NULL, NULL);
+		ERR_FAIL_MSG("Failed streaming texture: " + path_to_file + ".");
+	}
+
+	RID new_texture = RS::get_singleton()->texture_2d_create(p_image);
+	RS::get_singleton()->texture_replace(texture, new_texture);
+	RS::get_singleton()->texture_set_size_override(texture, w, h);
+
+	alpha_cache.unref();
+}
+
+void StreamTexture::finish_streaming() {
+
+	if (stream_thread) {
+		stream_mutex.lock();
+		stream_exit = true;
+		stream_mutex.unlock();
+		stream_semaphore.post();
+		Thread::wait_to_finish(stream_thread);
+		memdelete(stream_thread);
+		stream_thread = nullptr;
+	}
+
+	stream_requests.clear();
+}
+
+Mutex StreamTexture::stream_mutex;
+Semaphore StreamTexture::stream_semaphore;
+List<StreamTexture::StreamRequest> StreamTexture::stream_requests;
+Thread *StreamTexture::stream_thread = nullptr;
+bool StreamTexture::stream_exit = false;
+
 StreamTexture::TextureFormatRequestCallback StreamTexture::request_3d_callback = NULL;
 StreamTexture::TextureFormatRoughnessRequestCallback StreamTexture::request_roughness_callback = NULL;
 StreamTexture::TextureFormatRequestCallback StreamTexture::request_normal_callback = NULL;
@@ -534,7 +643,7 @@ Image::Format StreamTexture::get_format() const {
 	return format;
 }
 
-Error StreamTexture::_load_data(const String &p_path, int &tw, int &th, int &tw_custom, int &th_custom, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit) {
+Error StreamTexture::_load_data(const String &p_path, int &tw, int &th, int &tw_custom, int &th_custom, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, bool &r_streamable, int p_size_limit) {
 
 	alpha_cache.unref();
 
@@ -580,10 +689,19 @@ Error StreamTexture::_load_data(const String &p_path, int &tw, int &th, int &tw_
 	r_request_normal = false;
 
 #endif
+	r_streamable = (df & FORMAT_BIT_STREAM) && (df & FORMAT_BIT_HAS_MIPMAPS);
+
 	if (!(df & FORMAT_BIT_STREAM)) {
 		p_size_limit = 0;
 	}
 
+	//full size, the image loaded may be smaller due to the size limit
+	size_t image_start = f->get_position();
+	f->get_32(); //data format
+	tw = f->get_16();
+	th = f->get_16();
+	f->seek(image_start);
+
 	image = load_image_from_file(f, p_size_limit);
 
 	memdelete(f);
@@ -595,8 +713,63 @@ Error StreamTexture::_load_data(const String &p_path, int &tw, int &th, int &tw_
 	return OK;
 }
 
+//headless mode only needs the size and format, the image data is never read
+Error StreamTexture::_load_metadata(const String &p_path) {
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V(!f, ERR_CANT_OPEN);
+
+	uint8_t header[4];
+	f->get_buffer(header, 4);
+	if (header[0] != 'G' || header[1] != 'S' || header[2] != 'T' || header[3] != '2') {
+		memdelete(f);
+		ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, "Stream texture file is corrupt (Bad header).");
+	}
+
+	uint32_t version = f->get_32();
+
+	if (version > FORMAT_VERSION) {
+		memdelete(f);
+		ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, "Stream texture file is too new.");
+	}
+	int tw_custom = f->get_32();
+	int th_custom = f->get_32();
+	//data format, mipmap limit and reserved
+	for (int i = 0; i < 5; i++) {
+		f->get_32();
+	}
+
+	f->get_32(); //image data format
+	int tw = f->get_16();
+	int th = f->get_16();
+	f->get_32(); //mipmaps
+	Image::Format image_format = Image::Format(f->get_32());
+
+	memdelete(f);
+
+	if (!texture.is_valid()) {
+		texture = RS::get_singleton()->texture_2d_placeholder_create();
+	}
+
+	w = tw_custom ? tw_custom : tw;
+	h = th_custom ? th_custom : th;
+	path_to_file = p_path;
+	format = image_format;
+	stream_max_size = 0;
+
+	_change_notify();
+	emit_changed();
+	return OK;
+}
+
 Error StreamTexture::load(const String &p_path) {
 
+	MemoryTagScope memory_tag(Memory::TAG_TEXTURES);
+
+	if (ResourceLoader::is_headless()) {
+		return _load_metadata(p_path);
+	}
+
 	int lw, lh, lwc, lhc;
 	Ref<Image> image;
 	image.instance();
@@ -605,26 +778,42 @@ Error StreamTexture::load(const String &p_path) {
 	bool request_normal;
 	bool request_roughness;
 	int mipmap_limit;
+	bool streamable;
+
+	//streamed textures start at the smallest size, the renderer requests larger ones as they are seen
+	bool streaming = GLOBAL_GET("rendering/quality/texture_streaming/enabled");
+	int size_limit = streaming ? int(GLOBAL_GET("rendering/quality/texture_streaming/min_size")) : 0;
 
-	Error err = _load_data(p_path, lw, lh, lwc, lhc, image, request_3d, request_normal, request_roughness, mipmap_limit);
+	Error err = _load_data(p_path, lw, lh, lwc, lhc, image, request_3d, request_normal, request_roughness, mipmap_limit, streamable, size_limit);
 	if (err)
 		return err;
 
+	streaming = streaming && streamable;
+
 	if (texture.is_valid()) {
 		RID new_texture = RS::get_singleton()->texture_2d_create(image);
 		RS::get_singleton()->texture_replace(texture, new_texture);
 	} else {
 		texture = RS::get_singleton()->texture_2d_create(image);
 	}
-	if (lwc || lhc) {
-		RS::get_singleton()->texture_set_size_override(texture, lwc, lhc);
-	}
 
 	w = lwc ? lwc : lw;
 	h = lhc ? lhc : lh;
 	path_to_file = p_path;
 	format = image->get_format();
 
+	if (lwc || lhc || streaming) {
+		RS::get_singleton()->texture_set_size_override(texture, w, h);
+	}
+
+	if (streaming) {
+		stream_max_size = MAX(lw, lh);
+		RS::get_singleton()->texture_set_stream_callback(texture, stream_max_size, _requested_stream, this);
+	} else {
+		stream_max_size = 0;
+		RS::get_singleton()->texture_set_stream_callback(texture, 0, NULL, NULL);
+	}
+
 	if (get_path() == String()) {
 		//temporarily set path if no path set for resource, helps find errors
 		RenderingServer::get_singleton()->texture_set_path(texture, p_path);
@@ -778,6 +967,7 @@ void StreamTexture::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("load", "path"), &StreamTexture::load);
 	ClassDB::bind_method(D_METHOD("get_load_path"), &StreamTexture::get_load_path);
+	ClassDB::bind_method(D_METHOD("_stream_loaded", "image"), &StreamTexture::_stream_loaded);
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "load_path", PROPERTY_HINT_FILE, "*.stex"), "load", "get_load_path");
 }
@@ -787,6 +977,7 @@ StreamTexture::StreamTexture() {
 	format = Image::FORMAT_MAX;
 	w = 0;
 	h = 0;
+	stream_max_size = 0;
 }
 
 StreamTexture::~StreamTexture() {
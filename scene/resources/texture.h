@@ -36,6 +36,8 @@
 #include "core/os/file_access.h"
 #include "core/os/mutex.h"
 #include "core/os/rw_lock.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/resource.h"
 #include "scene/resources/curve.h"
@@ -161,11 +163,13 @@ public:
 	};
 
 private:
-	Error _load_data(const String &p_path, int &tw, int &th, int &tw_custom, int &th_custom, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit = 0);
+	Error _load_data(const String &p_path, int &tw, int &th, int &tw_custom, int &th_custom, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, bool &r_streamable, int p_size_limit = 0);
+	Error _load_metadata(const String &p_path);
 	String path_to_file;
 	mutable RID texture;
 	Image::Format format;
 	int w, h;
+	int stream_max_size;
 	mutable Ref<BitMap> alpha_cache;
 
 	virtual void reload_from_file();
@@ -174,12 +178,30 @@ private:
 	static void _requested_roughness(void *p_ud, const String &p_normal_path, RS::TextureDetectRoughnessChannel p_roughness_channel);
 	static void _requested_normal(void *p_ud);
 
+	struct StreamRequest {
+		ObjectID texture;
+		String path;
+		int size;
+	};
+
+	static Mutex stream_mutex;
+	static Semaphore stream_semaphore;
+	static List<StreamRequest> stream_requests;
+	static Thread *stream_thread;
+	static bool stream_exit;
+
+	static Ref<Image> _load_stream_image(const String &p_path, int p_size_limit);
+	static void _stream_thread_func(void *p_ud);
+	static void _requested_stream(void *p_ud, int p_size);
+	void _stream_loaded(const Ref<Image> &p_image);
+
 protected:
 	static void _bind_methods();
 	void _validate_property(PropertyInfo &property) const;
 
 public:
 	static Ref<Image> load_image_from_file(FileAccess *p_file, int p_size_limit);
+	static void finish_streaming();
 
 	typedef void (*TextureFormatRequestCallback)(const Ref<StreamTexture> &);
 	typedef void (*TextureFormatRoughnessRequestCallback)(const Ref<StreamTexture> &, const String &p_normal_path, RS::TextureDetectRoughnessChannel p_roughness_channel);
@@ -34,6 +34,7 @@
 
 void Theme::_emit_theme_changed() {
 
+	change_version++;
 	emit_changed();
 }
 
@@ -312,7 +313,7 @@ void Theme::set_default_theme_font(const Ref<Font> &p_default_font) {
 	}
 
 	_change_notify();
-	emit_changed();
+	_emit_theme_changed();
 }
 
 Ref<Font> Theme::get_default_theme_font() const {
@@ -320,6 +321,7 @@ Ref<Font> Theme::get_default_theme_font() const {
 	return default_theme_font;
 }
 
+uint32_t Theme::change_version = 1;
 Ref<Theme> Theme::project_default_theme;
 Ref<Theme> Theme::default_theme;
 Ref<Texture2D> Theme::default_icon;
@@ -334,6 +336,7 @@ Ref<Theme> Theme::get_default() {
 void Theme::set_default(const Ref<Theme> &p_default) {
 
 	default_theme = p_default;
+	change_version++;
 }
 
 Ref<Theme> Theme::get_project_default() {
@@ -344,19 +347,23 @@ Ref<Theme> Theme::get_project_default() {
 void Theme::set_project_default(const Ref<Theme> &p_project_default) {
 
 	project_default_theme = p_project_default;
+	change_version++;
 }
 
 void Theme::set_default_icon(const Ref<Texture2D> &p_icon) {
 
 	default_icon = p_icon;
+	change_version++;
 }
 void Theme::set_default_style(const Ref<StyleBox> &p_style) {
 
 	default_style = p_style;
+	change_version++;
 }
 void Theme::set_default_font(const Ref<Font> &p_font) {
 
 	default_font = p_font;
+	change_version++;
 }
 
 void Theme::set_icon(const StringName &p_name, const StringName &p_type, const Ref<Texture2D> &p_icon) {
@@ -377,7 +384,7 @@ void Theme::set_icon(const StringName &p_name, const StringName &p_type, const R
 
 	if (new_value) {
 		_change_notify();
-		emit_changed();
+		_emit_theme_changed();
 	}
 }
 Ref<Texture2D> Theme::get_icon(const StringName &p_name, const StringName &p_type) const {
@@ -407,7 +414,7 @@ void Theme::clear_icon(const StringName &p_name, const StringName &p_type) {
 	icon_map[p_type].erase(p_name);
 
 	_change_notify();
-	emit_changed();
+	_emit_theme_changed();
 }
 
 void Theme::get_icon_list(StringName p_type, List<StringName> *p_list) const {
@@ -432,7 +439,7 @@ void Theme::set_shader(const StringName &p_name, const StringName &p_type, const
 
 	if (new_value) {
 		_change_notify();
-		emit_changed();
+		_emit_theme_changed();
 	}
 }
 
@@ -454,7 +461,7 @@ void Theme::clear_shader(const StringName &p_name, const StringName &p_type) {
 
 	shader_map[p_type].erase(p_name);
 	_change_notify();
-	emit_changed();
+	_emit_theme_changed();
 }
 
 void Theme::get_shader_list(const StringName &p_type, List<StringName> *p_list) const {
@@ -490,7 +497,7 @@ void Theme::set_stylebox(const StringName &p_name, const StringName &p_type, con
 
 	if (new_value)
 		_change_notify();
-	emit_changed();
+	_emit_theme_changed();
 }
 
 Ref<StyleBox> Theme::get_stylebox(const StringName &p_name, const StringName &p_type) const {
@@ -520,7 +527,7 @@ void Theme::clear_stylebox(const StringName &p_name, const StringName &p_type) {
 	style_map[p_type].erase(p_name);
 
 	_change_notify();
-	emit_changed();
+	_emit_theme_changed();
 }
 
 void Theme::get_stylebox_list(StringName p_type, List<StringName> *p_list) const {
@@ -565,7 +572,7 @@ void Theme::set_font(const StringName &p_name, const StringName &p_type, const R
 
 	if (new_value) {
 		_change_notify();
-		emit_changed();
+		_emit_theme_changed();
 	}
 }
 Ref<Font> Theme::get_font(const StringName &p_name, const StringName &p_type) const {
@@ -594,7 +601,7 @@ void Theme::clear_font(const StringName &p_name, const StringName &p_type) {
 
 	font_map[p_type].erase(p_name);
 	_change_notify();
-	emit_changed();
+	_emit_theme_changed();
 }
 
 void Theme::get_font_list(StringName p_type, List<StringName> *p_list) const {
@@ -620,7 +627,7 @@ void Theme::set_color(const StringName &p_name, const StringName &p_type, const
 
 	if (new_value) {
 		_change_notify();
-		emit_changed();
+		_emit_theme_changed();
 	}
 }
 
@@ -644,7 +651,7 @@ void Theme::clear_color(const StringName &p_name, const StringName &p_type) {
 
 	color_map[p_type].erase(p_name);
 	_change_notify();
-	emit_changed();
+	_emit_theme_changed();
 }
 
 void Theme::get_color_list(StringName p_type, List<StringName> *p_list) const {
@@ -669,7 +676,7 @@ void Theme::set_constant(const StringName &p_name, const StringName &p_type, int
 
 	if (new_value) {
 		_change_notify();
-		emit_changed();
+		_emit_theme_changed();
 	}
 }
 
@@ -694,7 +701,7 @@ void Theme::clear_constant(const StringName &p_name, const StringName &p_type) {
 
 	constant_map[p_type].erase(p_name);
 	_change_notify();
-	emit_changed();
+	_emit_theme_changed();
 }
 
 void Theme::get_constant_list(StringName p_type, List<StringName> *p_list) const {
@@ -762,7 +769,7 @@ void Theme::clear() {
 	constant_map.clear();
 
 	_change_notify();
-	emit_changed();
+	_emit_theme_changed();
 }
 
 void Theme::copy_default_theme() {
@@ -817,7 +824,7 @@ void Theme::copy_theme(const Ref<Theme> &p_other) {
 	shader_map = p_other->shader_map;
 
 	_change_notify();
-	emit_changed();
+	_emit_theme_changed();
 }
 
 void Theme::get_type_list(List<StringName> *p_list) const {
@@ -65,6 +65,7 @@ protected:
 	bool _get(const StringName &p_name, Variant &r_ret) const;
 	void _get_property_list(List<PropertyInfo> *p_list) const;
 
+	static uint32_t change_version;
 	static Ref<Theme> project_default_theme;
 	static Ref<Theme> default_theme;
 	static Ref<Texture2D> default_icon;
@@ -77,6 +78,8 @@ protected:
 
 public:
 	static Ref<Theme> get_default();
+	//changes whenever any theme changes, so lookups from them can be cached
+	static uint32_t get_change_version() { return change_version; }
 	static void set_default(const Ref<Theme> &p_default);
 
 	static Ref<Theme> get_project_default();
@@ -0,0 +1,235 @@
+/*************************************************************************/
+/*  audio_mix.cpp                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "audio_mix.h"
+
+#include "core/os/copymem.h"
+
+#if defined(AUDIO_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(AUDIO_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+// conversion of the plain loop, (v < 0 ? -1 : 1) * (ABS(v) << 11) is v * 2048
+#define AUDIO_INT32_SCALE float((1 << 20) - 1)
+#define AUDIO_INT32_SHIFT 11
+
+void AudioMix::add(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames) {
+
+	int i = 0;
+#if defined(AUDIO_SIMD_SSE2)
+	for (; i + 2 <= p_frames; i += 2) {
+		float *dst = &p_dst[i].l;
+		_mm_storeu_ps(dst, _mm_add_ps(_mm_loadu_ps(dst), _mm_loadu_ps(&p_src[i].l)));
+	}
+#elif defined(AUDIO_SIMD_NEON)
+	for (; i + 2 <= p_frames; i += 2) {
+		float *dst = &p_dst[i].l;
+		vst1q_f32(dst, vaddq_f32(vld1q_f32(dst), vld1q_f32(&p_src[i].l)));
+	}
+#endif
+	for (; i < p_frames; i++) {
+		p_dst[i] += p_src[i];
+	}
+}
+
+void AudioMix::add_scaled(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, const AudioFrame &p_volume) {
+
+	int i = 0;
+#if defined(AUDIO_SIMD_SSE2)
+	const __m128 vol = _mm_setr_ps(p_volume.l, p_volume.r, p_volume.l, p_volume.r);
+	for (; i + 2 <= p_frames; i += 2) {
+		float *dst = &p_dst[i].l;
+		_mm_storeu_ps(dst, _mm_add_ps(_mm_loadu_ps(dst), _mm_mul_ps(_mm_loadu_ps(&p_src[i].l), vol)));
+	}
+#elif defined(AUDIO_SIMD_NEON)
+	const float vol_values[4] = { p_volume.l, p_volume.r, p_volume.l, p_volume.r };
+	const float32x4_t vol = vld1q_f32(vol_values);
+	for (; i + 2 <= p_frames; i += 2) {
+		float *dst = &p_dst[i].l;
+		vst1q_f32(dst, vmlaq_f32(vld1q_f32(dst), vld1q_f32(&p_src[i].l), vol));
+	}
+#endif
+	for (; i < p_frames; i++) {
+		p_dst[i] += p_src[i] * p_volume;
+	}
+}
+
+void AudioMix::add_ramp(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, const AudioFrame &p_from, const AudioFrame &p_to) {
+
+	if (p_frames <= 0) {
+		return;
+	}
+
+	const AudioFrame inc = (p_to - p_from) / float(p_frames);
+	int i = 0;
+#if defined(AUDIO_SIMD_SSE2)
+	__m128 vol = _mm_setr_ps(p_from.l, p_from.r, p_from.l + inc.l, p_from.r + inc.r);
+	const __m128 vol_inc = _mm_setr_ps(inc.l * 2.0, inc.r * 2.0, inc.l * 2.0, inc.r * 2.0);
+	for (; i + 2 <= p_frames; i += 2) {
+		float *dst = &p_dst[i].l;
+		_mm_storeu_ps(dst, _mm_add_ps(_mm_loadu_ps(dst), _mm_mul_ps(_mm_loadu_ps(&p_src[i].l), vol)));
+		vol = _mm_add_ps(vol, vol_inc);
+	}
+#elif defined(AUDIO_SIMD_NEON)
+	const float vol_values[4] = { p_from.l, p_from.r, p_from.l + inc.l, p_from.r + inc.r };
+	float32x4_t vol = vld1q_f32(vol_values);
+	const float inc_values[4] = { inc.l * 2.0f, inc.r * 2.0f, inc.l * 2.0f, inc.r * 2.0f };
+	const float32x4_t vol_inc = vld1q_f32(inc_values);
+	for (; i + 2 <= p_frames; i += 2) {
+		float *dst = &p_dst[i].l;
+		vst1q_f32(dst, vmlaq_f32(vld1q_f32(dst), vld1q_f32(&p_src[i].l), vol));
+		vol = vaddq_f32(vol, vol_inc);
+	}
+#endif
+	AudioFrame vol_tail = p_from + inc * float(i);
+	for (; i < p_frames; i++) {
+		p_dst[i] += p_src[i] * vol_tail;
+		vol_tail += inc;
+	}
+}
+
+void AudioMix::scale_ramp(AudioFrame *p_buffer, int p_frames, const AudioFrame &p_from, const AudioFrame &p_to) {
+
+	if (p_frames <= 0) {
+		return;
+	}
+
+	const AudioFrame inc = (p_to - p_from) / float(p_frames);
+	int i = 0;
+#if defined(AUDIO_SIMD_SSE2)
+	__m128 vol = _mm_setr_ps(p_from.l, p_from.r, p_from.l + inc.l, p_from.r + inc.r);
+	const __m128 vol_inc = _mm_setr_ps(inc.l * 2.0, inc.r * 2.0, inc.l * 2.0, inc.r * 2.0);
+	for (; i + 2 <= p_frames; i += 2) {
+		float *buf = &p_buffer[i].l;
+		_mm_storeu_ps(buf, _mm_mul_ps(_mm_loadu_ps(buf), vol));
+		vol = _mm_add_ps(vol, vol_inc);
+	}
+#elif defined(AUDIO_SIMD_NEON)
+	const float vol_values[4] = { p_from.l, p_from.r, p_from.l + inc.l, p_from.r + inc.r };
+	float32x4_t vol = vld1q_f32(vol_values);
+	const float inc_values[4] = { inc.l * 2.0f, inc.r * 2.0f, inc.l * 2.0f, inc.r * 2.0f };
+	const float32x4_t vol_inc = vld1q_f32(inc_values);
+	for (; i + 2 <= p_frames; i += 2) {
+		float *buf = &p_buffer[i].l;
+		vst1q_f32(buf, vmulq_f32(vld1q_f32(buf), vol));
+		vol = vaddq_f32(vol, vol_inc);
+	}
+#endif
+	AudioFrame vol_tail = p_from + inc * float(i);
+	for (; i < p_frames; i++) {
+		p_buffer[i] *= vol_tail;
+		vol_tail += inc;
+	}
+}
+
+AudioFrame AudioMix::scale_peak(AudioFrame *p_buffer, int p_frames, float p_volume) {
+
+	AudioFrame peak(0, 0);
+	int i = 0;
+#if defined(AUDIO_SIMD_SSE2)
+	const __m128 vol = _mm_set1_ps(p_volume);
+	const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	__m128 peaks = _mm_setzero_ps();
+	for (; i + 2 <= p_frames; i += 2) {
+		float *buf = &p_buffer[i].l;
+		__m128 v = _mm_mul_ps(_mm_loadu_ps(buf), vol);
+		_mm_storeu_ps(buf, v);
+		peaks = _mm_max_ps(peaks, _mm_and_ps(v, abs_mask));
+	}
+	float peak_values[4];
+	_mm_storeu_ps(peak_values, peaks);
+	peak.l = MAX(peak_values[0], peak_values[2]);
+	peak.r = MAX(peak_values[1], peak_values[3]);
+#elif defined(AUDIO_SIMD_NEON)
+	float32x4_t peaks = vdupq_n_f32(0);
+	for (; i + 2 <= p_frames; i += 2) {
+		float *buf = &p_buffer[i].l;
+		float32x4_t v = vmulq_n_f32(vld1q_f32(buf), p_volume);
+		vst1q_f32(buf, v);
+		peaks = vmaxq_f32(peaks, vabsq_f32(v));
+	}
+	float peak_values[4];
+	vst1q_f32(peak_values, peaks);
+	peak.l = MAX(peak_values[0], peak_values[2]);
+	peak.r = MAX(peak_values[1], peak_values[3]);
+#endif
+	for (; i < p_frames; i++) {
+		p_buffer[i] *= p_volume;
+		peak.l = MAX(peak.l, ABS(p_buffer[i].l));
+		peak.r = MAX(peak.r, ABS(p_buffer[i].r));
+	}
+	return peak;
+}
+
+void AudioMix::clear(AudioFrame *p_buffer, int p_frames) {
+
+	zeromem((void *)p_buffer, sizeof(AudioFrame) * p_frames);
+}
+
+void AudioMix::convert_to_int32(int32_t *p_dst, int p_stride, const AudioFrame *p_src, int p_frames) {
+
+	int i = 0;
+#if defined(AUDIO_SIMD_SSE2)
+	const __m128 min = _mm_set1_ps(-1.0);
+	const __m128 max = _mm_set1_ps(1.0);
+	const __m128 scale = _mm_set1_ps(AUDIO_INT32_SCALE);
+	for (; i + 2 <= p_frames; i += 2) {
+		__m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&p_src[i].l), min), max);
+		__m128i s = _mm_slli_epi32(_mm_cvttps_epi32(_mm_mul_ps(v, scale)), AUDIO_INT32_SHIFT);
+		if (p_stride == 2) {
+			_mm_storeu_si128((__m128i *)&p_dst[i * 2], s);
+		} else {
+			_mm_storel_epi64((__m128i *)&p_dst[i * p_stride], s);
+			_mm_storel_epi64((__m128i *)&p_dst[(i + 1) * p_stride], _mm_unpackhi_epi64(s, s));
+		}
+	}
+#elif defined(AUDIO_SIMD_NEON)
+	const float32x4_t min = vdupq_n_f32(-1.0);
+	const float32x4_t max = vdupq_n_f32(1.0);
+	for (; i + 2 <= p_frames; i += 2) {
+		float32x4_t v = vminq_f32(vmaxq_f32(vld1q_f32(&p_src[i].l), min), max);
+		int32x4_t s = vshlq_n_s32(vcvtq_s32_f32(vmulq_n_f32(v, AUDIO_INT32_SCALE)), AUDIO_INT32_SHIFT);
+		if (p_stride == 2) {
+			vst1q_s32(&p_dst[i * 2], s);
+		} else {
+			vst1_s32(&p_dst[i * p_stride], vget_low_s32(s));
+			vst1_s32(&p_dst[(i + 1) * p_stride], vget_high_s32(s));
+		}
+	}
+#endif
+	for (; i < p_frames; i++) {
+		float l = CLAMP(p_src[i].l, -1.0, 1.0);
+		p_dst[i * p_stride + 0] = int32_t(l * AUDIO_INT32_SCALE) * (1 << AUDIO_INT32_SHIFT);
+		float r = CLAMP(p_src[i].r, -1.0, 1.0);
+		p_dst[i * p_stride + 1] = int32_t(r * AUDIO_INT32_SCALE) * (1 << AUDIO_INT32_SHIFT);
+	}
+}
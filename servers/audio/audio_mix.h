@@ -0,0 +1,67 @@
+/*************************************************************************/
+/*  audio_mix.h                                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef AUDIO_MIX_H
+#define AUDIO_MIX_H
+
+#include "core/math/audio_frame.h"
+
+// build with audio_simd=no (NO_AUDIO_SIMD) to always use the scalar loops
+#if !defined(NO_AUDIO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AUDIO_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define AUDIO_SIMD_NEON
+#endif
+#endif
+
+// Mixing loops shared by the audio server and the stream players. Two frames
+// are processed at a time when SSE2 or NEON are available. Volume ramps go
+// linearly from p_from to p_to, the frame after the last one gets p_to, the
+// same as the plain loops they replace.
+class AudioMix {
+public:
+	// p_dst[i] += p_src[i]
+	static void add(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames);
+	// p_dst[i] += p_src[i] * p_volume
+	static void add_scaled(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, const AudioFrame &p_volume);
+	// p_dst[i] += p_src[i] * volume, ramping the volume
+	static void add_ramp(AudioFrame *p_dst, const AudioFrame *p_src, int p_frames, const AudioFrame &p_from, const AudioFrame &p_to);
+	// p_buffer[i] *= volume, ramping the volume
+	static void scale_ramp(AudioFrame *p_buffer, int p_frames, const AudioFrame &p_from, const AudioFrame &p_to);
+	// p_buffer[i] *= p_volume, returns the peak of the result
+	static AudioFrame scale_peak(AudioFrame *p_buffer, int p_frames, float p_volume);
+	static void clear(AudioFrame *p_buffer, int p_frames);
+	// Clamps and converts to the 32 bit samples the drivers take, the left and
+	// right samples of each frame are written every p_stride samples.
+	static void convert_to_int32(int32_t *p_dst, int p_stride, const AudioFrame *p_src, int p_frames);
+};
+
+#endif // AUDIO_MIX_H
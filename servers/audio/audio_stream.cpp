@@ -35,6 +35,13 @@
 
 //////////////////////////////
 
+void AudioStreamPlayback::skip(float p_time) {
+
+	seek(get_playback_position() + p_time);
+}
+
+//////////////////////////////
+
 void AudioStreamPlaybackResampled::_begin_resample() {
 
 	//clear cubic interpolation history
@@ -96,6 +103,119 @@ void AudioStreamPlaybackResampled::mix(AudioFrame *p_buffer, float p_rate_scale,
 
 ////////////////////////////////
 
+bool AudioStreamPlaybackDecoded::_decode_needs_data() const {
+
+	return decode_active && !decode_ended && _get_decode_buffered() < decode_read_ahead;
+}
+
+void AudioStreamPlaybackDecoded::_decode_ahead(uint32_t p_frames) {
+
+	uint32_t capacity = decode_ring_mask + 1;
+
+	while (p_frames > 0 && !decode_ended) {
+
+		uint32_t write_pos = decode_write_pos;
+		uint32_t index = write_pos & decode_ring_mask;
+		uint32_t todo = MIN(p_frames, capacity - (write_pos - decode_read_pos));
+		todo = MIN(todo, capacity - index); //contiguous part of the ring
+		if (todo == 0) {
+			break;
+		}
+
+		int decoded = _decode(decode_ring + index, todo);
+		if (decoded <= 0) {
+			decode_ended = true;
+			break;
+		}
+
+		decode_write_pos = write_pos + decoded;
+		p_frames -= MIN(uint32_t(decoded), p_frames);
+	}
+}
+
+void AudioStreamPlaybackDecoded::_mix_internal(AudioFrame *p_buffer, int p_frames) {
+
+	uint32_t frames = p_frames;
+
+	if (_get_decode_buffered() < frames && !decode_ended) {
+		//read-ahead ran dry, decode what is missing here
+		decode_mutex.lock();
+		uint32_t buffered = _get_decode_buffered();
+		if (buffered < frames) {
+			_decode_ahead(frames - buffered);
+		}
+		decode_mutex.unlock();
+	}
+
+	uint32_t read_pos = decode_read_pos;
+	uint32_t todo = MIN(frames, uint32_t(decode_write_pos - read_pos));
+
+	for (uint32_t i = 0; i < todo; i++) {
+		p_buffer[i] = decode_ring[(read_pos + i) & decode_ring_mask];
+	}
+	decode_read_pos = read_pos + todo;
+
+	for (uint32_t i = todo; i < frames; i++) {
+		p_buffer[i] = AudioFrame(0, 0);
+	}
+}
+
+void AudioStreamPlaybackDecoded::_decode_setup(float p_sampling_rate) {
+
+	ERR_FAIL_COND(decode_ring);
+
+	decode_read_ahead = MAX(uint32_t(AudioServer::get_singleton()->get_decode_read_ahead() * p_sampling_rate), uint32_t(DECODE_CHUNK));
+	uint32_t capacity = next_power_of_2(decode_read_ahead + DECODE_CHUNK);
+	decode_ring = memnew_arr(AudioFrame, capacity);
+	decode_ring_mask = capacity - 1;
+
+	AudioServer::get_singleton()->decode_source_add(this);
+	decode_registered = true;
+}
+
+void AudioStreamPlaybackDecoded::_decode_cleanup() {
+
+	decode_active = false;
+
+	if (decode_registered) {
+		//also waits for a decode thread that may be using it
+		AudioServer::get_singleton()->decode_source_remove(this);
+		decode_registered = false;
+	}
+
+	if (decode_ring) {
+		memdelete_arr(decode_ring);
+		decode_ring = NULL;
+	}
+}
+
+void AudioStreamPlaybackDecoded::_decode_restart() {
+
+	decode_read_pos = 0;
+	decode_write_pos = 0;
+	decode_ended = false;
+	decode_active = decode_ring != NULL;
+}
+
+AudioStreamPlaybackDecoded::AudioStreamPlaybackDecoded() {
+
+	decode_ring = NULL;
+	decode_ring_mask = 0;
+	decode_read_ahead = 0;
+	decode_read_pos = 0;
+	decode_write_pos = 0;
+	decode_active = false;
+	decode_ended = false;
+	decode_registered = false;
+}
+
+AudioStreamPlaybackDecoded::~AudioStreamPlaybackDecoded() {
+
+	_decode_cleanup();
+}
+
+////////////////////////////////
+
 void AudioStream::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_length"), &AudioStream::get_length);
@@ -32,10 +32,13 @@
 #define AUDIO_STREAM_H
 
 #include "core/image.h"
+#include "core/os/mutex.h"
 #include "core/resource.h"
 #include "servers/audio/audio_filter_sw.h"
 #include "servers/audio_server.h"
 
+#include <atomic>
+
 class AudioStreamPlayback : public Reference {
 
 	GDCLASS(AudioStreamPlayback, Reference);
@@ -49,6 +52,7 @@ public:
 
 	virtual float get_playback_position() const = 0;
 	virtual void seek(float p_time) = 0;
+	virtual void skip(float p_time); //advance without mixing, wrapping around loops if supported
 
 	virtual void mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) = 0;
 };
@@ -79,6 +83,55 @@ public:
 	AudioStreamPlaybackResampled() { mix_offset = 0; }
 };
 
+// Compressed streams decode ahead on the AudioServer decode threads into a
+// ring buffer, so the mix only has to copy. If the read-ahead runs dry, or
+// there are no decode threads, the mix decodes what is missing by itself.
+class AudioStreamPlaybackDecoded : public AudioStreamPlaybackResampled {
+
+	GDCLASS(AudioStreamPlaybackDecoded, AudioStreamPlaybackResampled);
+
+	friend class AudioServer;
+
+	enum {
+		DECODE_CHUNK = 1024
+	};
+
+	Mutex decode_mutex;
+	AudioFrame *decode_ring;
+	uint32_t decode_ring_mask;
+	uint32_t decode_read_ahead;
+	std::atomic<uint32_t> decode_read_pos;
+	std::atomic<uint32_t> decode_write_pos;
+	std::atomic<bool> decode_active;
+	std::atomic<bool> decode_ended;
+	bool decode_registered;
+
+	bool _decode_needs_data() const;
+	void _decode_ahead(uint32_t p_frames);
+
+protected:
+	// Decodes up to p_frames from the decode position, returns 0 once the
+	// stream ended. Always called with the decode mutex locked.
+	virtual int _decode(AudioFrame *p_buffer, int p_frames) = 0;
+	virtual void _mix_internal(AudioFrame *p_buffer, int p_frames);
+
+	void _decode_setup(float p_sampling_rate);
+	void _decode_cleanup(); //call before freeing the decoder
+
+	//lock while moving the decode position, then restart to drop the read-ahead
+	void _decode_lock() { decode_mutex.lock(); }
+	void _decode_unlock() { decode_mutex.unlock(); }
+	void _decode_restart();
+	void _decode_stop() { decode_active = false; }
+
+	_FORCE_INLINE_ uint32_t _get_decode_buffered() const { return decode_write_pos - decode_read_pos; }
+	_FORCE_INLINE_ bool _is_decode_finished() const { return decode_ended && _get_decode_buffered() == 0; }
+
+public:
+	AudioStreamPlaybackDecoded();
+	~AudioStreamPlaybackDecoded();
+};
+
 class AudioStream : public Resource {
 
 	GDCLASS(AudioStream, Resource);
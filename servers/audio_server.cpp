@@ -31,12 +31,15 @@
 #include "audio_server.h"
 
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/profiling_zones.h"
 #include "core/io/resource_loader.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
 #include "scene/resources/audio_stream_sample.h"
 #include "servers/audio/audio_driver_dummy.h"
+#include "servers/audio/audio_mix.h"
+#include "servers/audio/audio_stream.h"
 #include "servers/audio/effects/audio_effect_compressor.h"
 
 #ifdef TOOLS_ENABLED
@@ -242,6 +245,10 @@ void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
 
 		if (to_mix == 0) {
 			_mix_step();
+			//wake up the decoders to refill what this step used
+			for (int i = 0; i < decode_threads.size(); i++) {
+				decode_semaphore.post();
+			}
 		}
 
 		int to_copy = MIN(to_mix, todo);
@@ -259,18 +266,7 @@ void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
 
 				const AudioFrame *buf = master->channels[k].buffer.ptr();
 
-				for (int j = 0; j < to_copy; j++) {
-
-					float l = CLAMP(buf[from + j].l, -1.0, 1.0);
-					int32_t vl = l * ((1 << 20) - 1);
-					int32_t vl2 = (vl < 0 ? -1 : 1) * (ABS(vl) << 11);
-					p_buffer[(from_buf + j) * (cs * 2) + k * 2 + 0] = vl2;
-
-					float r = CLAMP(buf[from + j].r, -1.0, 1.0);
-					int32_t vr = r * ((1 << 20) - 1);
-					int32_t vr2 = (vr < 0 ? -1 : 1) * (ABS(vr) << 11);
-					p_buffer[(from_buf + j) * (cs * 2) + k * 2 + 1] = vr2;
-				}
+				AudioMix::convert_to_int32(&p_buffer[from_buf * (cs * 2) + k * 2], cs * 2, &buf[from], to_copy);
 
 			} else {
 				for (int j = 0; j < to_copy; j++) {
@@ -292,6 +288,9 @@ void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
 
 void AudioServer::_mix_step() {
 
+	PROFILING_ZONE("AudioServer::_mix_step");
+	MemoryTagScope memory_tag(Memory::TAG_AUDIO);
+
 	bool solo_mode = false;
 
 	for (int i = 0; i < buses.size(); i++) {
@@ -337,135 +336,257 @@ void AudioServer::_mix_step() {
 		E->get().callback(E->get().userdata);
 	}
 
+	mix_solo_mode = solo_mode;
+
+	//resolve the sends and sort the buses in waves, every bus goes after the ones sending to it
+	for (int i = 0; i < buses.size(); i++) {
+		buses[i]->wave = 0;
+	}
+
+	int wave_count = 1;
 	for (int i = buses.size() - 1; i >= 0; i--) {
-		//go bus by bus
 		Bus *bus = buses[i];
+		bus->send_index = -1;
 
-		for (int k = 0; k < bus->channels.size(); k++) {
+		if (i > 0) {
+			//everything has a send save for master bus
+			Bus *send = buses[0];
+			Map<StringName, Bus *>::Element *E = bus_map.find(bus->send);
+			if (E && E->get()->index_cache < bus->index_cache) { //invalid sends go to master
+				send = E->get();
+			}
 
-			if (bus->channels[k].active && !bus->channels[k].used) {
-				//buffer was not used, but it's still active, so it must be cleaned
-				AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+			bus->send_index = send->index_cache;
+			send->wave = MAX(send->wave, bus->wave + 1);
+		}
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
+		wave_count = MAX(wave_count, bus->wave + 1);
+	}
 
-					buf[j] = AudioFrame(0, 0);
-				}
+	//only allocates when the bus layout grows
+	if (bus_wave_order.size() != buses.size()) {
+		bus_wave_order.resize(buses.size());
+	}
+	if (bus_wave_offsets.size() < wave_count + 1) {
+		bus_wave_offsets.resize(wave_count + 1);
+	}
+
+	int *offsets = bus_wave_offsets.ptrw();
+	for (int w = 0; w <= wave_count; w++) {
+		offsets[w] = 0;
+	}
+	for (int i = 0; i < buses.size(); i++) {
+		offsets[buses[i]->wave + 1]++;
+	}
+	for (int w = 0; w < wave_count; w++) {
+		offsets[w + 1] += offsets[w];
+	}
+	for (int i = buses.size() - 1; i >= 0; i--) {
+		int w = buses[i]->wave;
+		bus_wave_order.write[offsets[w]++] = i;
+	}
+	for (int w = wave_count; w > 0; w--) {
+		offsets[w] = offsets[w - 1];
+	}
+	offsets[0] = 0;
+
+	for (int w = 0; w < wave_count; w++) {
+
+		bus_work_next = offsets[w];
+		bus_work_end = offsets[w + 1];
+
+		int helpers = MIN(bus_threads.size(), bus_work_end - bus_work_next - 1);
+		for (int t = 0; t < helpers; t++) {
+			bus_work_semaphore.post();
+		}
+
+		_process_bus_work();
+
+		for (int t = 0; t < helpers; t++) {
+			bus_done_semaphore.wait();
+		}
+	}
+
+	mix_frames += buffer_size;
+	to_mix = buffer_size;
+}
+
+void AudioServer::_process_bus(int p_bus) {
+
+	Bus *bus = buses[p_bus];
+
+	//add the buses sending here, in the same order as a serial mix
+	for (int i = buses.size() - 1; i > p_bus; i--) {
+		Bus *source = buses[i];
+		if (source->send_index != p_bus) {
+			continue;
+		}
+
+		for (int k = 0; k < source->channels.size(); k++) {
+			if (source->channels[k].send_pending) {
+				AudioMix::add(thread_get_channel_mix_buffer(p_bus, k), source->channels[k].buffer.ptr(), buffer_size);
 			}
 		}
+	}
 
-		//process effects
-		if (!bus->bypass) {
-			for (int j = 0; j < bus->effects.size(); j++) {
+	for (int k = 0; k < bus->channels.size(); k++) {
 
-				if (!bus->effects[j].enabled)
-					continue;
+		if (bus->channels[k].active && !bus->channels[k].used) {
+			//buffer was not used, but it's still active, so it must be cleaned
+			AudioMix::clear(bus->channels.write[k].buffer.ptrw(), buffer_size);
+		}
+	}
+
+	//process effects
+	if (!bus->bypass) {
+		for (int j = 0; j < bus->effects.size(); j++) {
+
+			if (!bus->effects[j].enabled)
+				continue;
 
 #ifdef DEBUG_ENABLED
-				uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+			uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 #endif
 
-				for (int k = 0; k < bus->channels.size(); k++) {
+			for (int k = 0; k < bus->channels.size(); k++) {
 
-					if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence()))
-						continue;
-					bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), temp_buffer.write[k].ptrw(), buffer_size);
-				}
+				if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence()))
+					continue;
+				bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), bus->channels.write[k].temp_buffer.ptrw(), buffer_size);
+			}
 
-				//swap buffers, so internal buffer always has the right data
-				for (int k = 0; k < bus->channels.size(); k++) {
+			//swap buffers, so internal buffer always has the right data
+			for (int k = 0; k < bus->channels.size(); k++) {
 
-					if (!(buses[i]->channels[k].active || bus->channels[k].effect_instances[j]->process_silence()))
-						continue;
-					SWAP(bus->channels.write[k].buffer, temp_buffer.write[k]);
-				}
+				if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence()))
+					continue;
+				SWAP(bus->channels.write[k].buffer, bus->channels.write[k].temp_buffer);
+			}
 
 #ifdef DEBUG_ENABLED
-				bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
+			bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
 #endif
-			}
 		}
+	}
 
-		//process send
+	for (int k = 0; k < bus->channels.size(); k++) {
 
-		Bus *send = NULL;
+		bus->channels.write[k].send_pending = false;
 
-		if (i > 0) {
-			//everything has a send save for master bus
-			if (!bus_map.has(bus->send)) {
-				send = buses[0];
-			} else {
-				send = bus_map[bus->send];
-				if (send->index_cache >= bus->index_cache) { //invalid, send to master
-					send = buses[0];
-				}
+		if (!bus->channels[k].active)
+			continue;
+
+		AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+
+		float volume = Math::db2linear(bus->volume_db);
+
+		if (mix_solo_mode) {
+			if (!bus->soloed) {
+				volume = 0.0;
+			}
+		} else {
+			if (bus->mute) {
+				volume = 0.0;
 			}
 		}
 
-		for (int k = 0; k < bus->channels.size(); k++) {
+		//apply volume and compute peak
+		AudioFrame peak = AudioMix::scale_peak(buf, buffer_size, volume);
 
-			if (!bus->channels[k].active)
-				continue;
+		bus->channels.write[k].peak_volume = AudioFrame(Math::linear2db(peak.l + 0.0000000001), Math::linear2db(peak.r + 0.0000000001));
 
-			AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+		if (!bus->channels[k].used) {
+			//see if any audio is contained, because channel was not used
 
-			AudioFrame peak = AudioFrame(0, 0);
+			if (MAX(peak.r, peak.l) > Math::db2linear(channel_disable_threshold_db)) {
+				bus->channels.write[k].last_mix_with_audio = mix_frames;
+			} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
+				bus->channels.write[k].active = false;
+				continue; //went inactive, don't mix.
+			}
+		}
 
-			float volume = Math::db2linear(bus->volume_db);
+		//if not master bus, the send bus adds it
+		bus->channels.write[k].send_pending = bus->send_index >= 0;
+	}
+}
 
-			if (solo_mode) {
-				if (!bus->soloed) {
-					volume = 0.0;
-				}
-			} else {
-				if (bus->mute) {
-					volume = 0.0;
-				}
-			}
+void AudioServer::_process_bus_work() {
 
-			//apply volume and compute peak
-			for (uint32_t j = 0; j < buffer_size; j++) {
+	while (true) {
+		int index = bus_work_next.fetch_add(1);
+		if (index >= bus_work_end) {
+			break;
+		}
+		_process_bus(bus_wave_order[index]);
+	}
+}
 
-				buf[j] *= volume;
+void AudioServer::_decode_thread_function(void *p_user) {
 
-				float l = ABS(buf[j].l);
-				if (l > peak.l) {
-					peak.l = l;
-				}
-				float r = ABS(buf[j].r);
-				if (r > peak.r) {
-					peak.r = r;
-				}
-			}
+	AudioServer *as = (AudioServer *)p_user;
 
-			bus->channels.write[k].peak_volume = AudioFrame(Math::linear2db(peak.l + 0.0000000001), Math::linear2db(peak.r + 0.0000000001));
+	while (true) {
+		as->decode_semaphore.wait();
+		if (as->decode_threads_exit) {
+			break;
+		}
 
-			if (!bus->channels[k].used) {
-				//see if any audio is contained, because channel was not used
+		bool decoded = true;
+		while (decoded && !as->decode_threads_exit) {
+			decoded = false;
 
-				if (MAX(peak.r, peak.l) > Math::db2linear(channel_disable_threshold_db)) {
-					bus->channels.write[k].last_mix_with_audio = mix_frames;
-				} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
-					bus->channels.write[k].active = false;
-					continue; //went inactive, don't mix.
+			as->decode_sources_mutex.lock();
+			for (int i = 0; i < as->decode_sources.size(); i++) {
+				AudioStreamPlaybackDecoded *source = as->decode_sources[i];
+				if (!source->_decode_needs_data() || source->decode_mutex.try_lock() != OK) {
+					continue; //full, or another thread is on it
 				}
-			}
+				//once locked, removing it waits for this decode to finish
+				as->decode_sources_mutex.unlock();
 
-			if (send) {
-				//if not master bus, send
-				AudioFrame *target_buf = thread_get_channel_mix_buffer(send->index_cache, k);
+				source->_decode_ahead(AudioStreamPlaybackDecoded::DECODE_CHUNK);
+				source->decode_mutex.unlock();
+				decoded = true;
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					target_buf[j] += buf[j];
-				}
+				as->decode_sources_mutex.lock();
 			}
+			as->decode_sources_mutex.unlock();
 		}
 	}
+}
 
-	mix_frames += buffer_size;
-	to_mix = buffer_size;
+void AudioServer::decode_source_add(AudioStreamPlaybackDecoded *p_source) {
+
+	MutexLock lock(decode_sources_mutex);
+	decode_sources.push_back(p_source);
 }
 
+void AudioServer::decode_source_remove(AudioStreamPlaybackDecoded *p_source) {
+
+	decode_sources_mutex.lock();
+	decode_sources.erase(p_source);
+	decode_sources_mutex.unlock();
+
+	p_source->decode_mutex.lock();
+	p_source->decode_mutex.unlock();
+}
+
+void AudioServer::_bus_thread_function(void *p_user) {
+
+	AudioServer *as = (AudioServer *)p_user;
+
+	while (true) {
+		as->bus_work_semaphore.wait();
+		if (as->bus_threads_exit) {
+			break;
+		}
+		as->_process_bus_work();
+		as->bus_done_semaphore.post();
+	}
+}
+
+
 bool AudioServer::thread_has_channel_mix_buffer(int p_bus, int p_buffer) const {
 	if (p_bus < 0 || p_bus >= buses.size())
 		return false;
@@ -479,15 +600,15 @@ AudioFrame *AudioServer::thread_get_channel_mix_buffer(int p_bus, int p_buffer)
 	ERR_FAIL_INDEX_V(p_bus, buses.size(), NULL);
 	ERR_FAIL_INDEX_V(p_buffer, buses[p_bus]->channels.size(), NULL);
 
-	AudioFrame *data = buses.write[p_bus]->channels.write[p_buffer].buffer.ptrw();
+	//buses are processed from several threads, don't write to the vector
+	Bus *bus = buses[p_bus];
+	AudioFrame *data = bus->channels.write[p_buffer].buffer.ptrw();
 
-	if (!buses[p_bus]->channels[p_buffer].used) {
-		buses.write[p_bus]->channels.write[p_buffer].used = true;
-		buses.write[p_bus]->channels.write[p_buffer].active = true;
-		buses.write[p_bus]->channels.write[p_buffer].last_mix_with_audio = mix_frames;
-		for (uint32_t i = 0; i < buffer_size; i++) {
-			data[i] = AudioFrame(0, 0);
-		}
+	if (!bus->channels[p_buffer].used) {
+		bus->channels.write[p_buffer].used = true;
+		bus->channels.write[p_buffer].active = true;
+		bus->channels.write[p_buffer].last_mix_with_audio = mix_frames;
+		AudioMix::clear(data, buffer_size);
 	}
 
 	return data;
@@ -553,12 +674,14 @@ void AudioServer::set_bus_count(int p_count) {
 		buses.write[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].temp_buffer.resize(buffer_size);
 		}
 		buses[i]->name = attempt;
 		buses[i]->solo = false;
 		buses[i]->mute = false;
 		buses[i]->bypass = false;
 		buses[i]->volume_db = 0;
+		buses[i]->max_voices = 0;
 		if (i > 0) {
 			buses[i]->send = "Master";
 		}
@@ -625,12 +748,14 @@ void AudioServer::add_bus(int p_at_pos) {
 	bus->channels.resize(channel_count);
 	for (int j = 0; j < channel_count; j++) {
 		bus->channels.write[j].buffer.resize(buffer_size);
+		bus->channels.write[j].temp_buffer.resize(buffer_size);
 	}
 	bus->name = attempt;
 	bus->solo = false;
 	bus->mute = false;
 	bus->bypass = false;
 	bus->volume_db = 0;
+	bus->max_voices = 0;
 
 	bus_map[attempt] = bus;
 
@@ -810,6 +935,22 @@ bool AudioServer::is_bus_bypassing_effects(int p_bus) const {
 	return buses[p_bus]->bypass;
 }
 
+void AudioServer::set_bus_max_voices(int p_bus, int p_count) {
+
+	ERR_FAIL_INDEX(p_bus, buses.size());
+	ERR_FAIL_COND(p_count < 0);
+
+	MARK_EDITED
+
+	buses[p_bus]->max_voices = p_count;
+}
+int AudioServer::get_bus_max_voices(int p_bus) const {
+
+	ERR_FAIL_INDEX_V(p_bus, buses.size(), 0);
+
+	return buses[p_bus]->max_voices;
+}
+
 void AudioServer::_update_bus_effects(int p_bus) {
 
 	for (int i = 0; i < buses[p_bus]->channels.size(); i++) {
@@ -954,16 +1095,12 @@ float AudioServer::get_global_rate_scale() const {
 
 void AudioServer::init_channels_and_buffers() {
 	channel_count = get_channel_count();
-	temp_buffer.resize(channel_count);
-
-	for (int i = 0; i < temp_buffer.size(); i++) {
-		temp_buffer.write[i].resize(buffer_size);
-	}
 
 	for (int i = 0; i < buses.size(); i++) {
 		buses[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].temp_buffer.resize(buffer_size);
 		}
 	}
 }
@@ -977,6 +1114,32 @@ void AudioServer::init() {
 
 	init_channels_and_buffers();
 
+	int bus_thread_count = GLOBAL_DEF_RST("audio/bus_threads", 2);
+	ProjectSettings::get_singleton()->set_custom_property_info("audio/bus_threads", PropertyInfo(Variant::INT, "audio/bus_threads", PROPERTY_HINT_RANGE, "0,16,1"));
+	bus_thread_count = CLAMP(bus_thread_count, 0, MAX(OS::get_singleton()->get_processor_count() - 1, 0));
+
+	bus_threads_exit = false;
+	Thread::Settings bus_thread_settings;
+	bus_thread_settings.priority = Thread::PRIORITY_HIGH;
+	for (int i = 0; i < bus_thread_count; i++) {
+		Thread *thread = Thread::create(_bus_thread_function, this, bus_thread_settings);
+		ERR_CONTINUE(!thread);
+		bus_threads.push_back(thread);
+	}
+
+	decode_read_ahead = float(GLOBAL_DEF_RST("audio/decode_read_ahead_ms", 250)) / 1000.0;
+	ProjectSettings::get_singleton()->set_custom_property_info("audio/decode_read_ahead_ms", PropertyInfo(Variant::INT, "audio/decode_read_ahead_ms", PROPERTY_HINT_RANGE, "20,2000,1,or_greater"));
+	int decode_thread_count = GLOBAL_DEF_RST("audio/decode_threads", 1);
+	ProjectSettings::get_singleton()->set_custom_property_info("audio/decode_threads", PropertyInfo(Variant::INT, "audio/decode_threads", PROPERTY_HINT_RANGE, "0,8,1"));
+	decode_thread_count = CLAMP(decode_thread_count, 0, 8);
+
+	decode_threads_exit = false;
+	for (int i = 0; i < decode_thread_count; i++) {
+		Thread *thread = Thread::create(_decode_thread_function, this);
+		ERR_CONTINUE(!thread);
+		decode_threads.push_back(thread);
+	}
+
 	mix_count = 0;
 	set_bus_count(1);
 	set_bus_name(0, "Master");
@@ -1053,12 +1216,88 @@ void AudioServer::update() {
 	prof_time = 0;
 #endif
 
+	_update_voices();
+
 	for (Set<CallbackItem>::Element *E = update_callbacks.front(); E; E = E->next()) {
 
 		E->get().callback(E->get().userdata);
 	}
 }
 
+void AudioServer::_update_voices() {
+
+	if (voices.empty()) {
+		return;
+	}
+
+	float threshold = Math::db2linear(channel_disable_threshold_db);
+	bool limited = false;
+
+	for (Map<ObjectID, Voice>::Element *E = voices.front(); E; E = E->next()) {
+		Voice &voice = E->get();
+		voice.is_virtual = voice.volume < threshold;
+		if (!voice.is_virtual && voice.bus >= 0 && voice.bus < buses.size() && buses[voice.bus]->max_voices > 0) {
+			limited = true;
+		}
+	}
+
+	if (!limited) {
+		return;
+	}
+
+	// Keep the loudest voices of the highest priority on each limited bus.
+	for (int i = 0; i < buses.size(); i++) {
+
+		int max_voices = buses[i]->max_voices;
+		if (max_voices == 0) {
+			continue;
+		}
+
+		Vector<VoiceSort> audible;
+		for (Map<ObjectID, Voice>::Element *E = voices.front(); E; E = E->next()) {
+			if (E->get().bus == i && !E->get().is_virtual) {
+				VoiceSort vs;
+				vs.voice = &E->get();
+				audible.push_back(vs);
+			}
+		}
+
+		if (audible.size() <= max_voices) {
+			continue;
+		}
+
+		audible.sort();
+		for (int j = max_voices; j < audible.size(); j++) {
+			audible[j].voice->is_virtual = true;
+		}
+	}
+}
+
+void AudioServer::voice_update(ObjectID p_owner, int p_bus, int p_priority, float p_volume) {
+
+	Map<ObjectID, Voice>::Element *E = voices.find(p_owner);
+	if (!E) {
+		Voice voice;
+		voice.is_virtual = false; //real until the next update
+		E = voices.insert(p_owner, voice);
+	}
+
+	E->get().bus = p_bus;
+	E->get().priority = p_priority;
+	E->get().volume = p_volume;
+}
+
+void AudioServer::voice_remove(ObjectID p_owner) {
+
+	voices.erase(p_owner);
+}
+
+bool AudioServer::voice_is_virtual(ObjectID p_owner) const {
+
+	const Map<ObjectID, Voice>::Element *E = voices.find(p_owner);
+	return E && E->get().is_virtual;
+}
+
 void AudioServer::load_default_bus_layout() {
 
 	String layout_path = ProjectSettings::get_singleton()->get("audio/default_bus_layout");
@@ -1077,6 +1316,26 @@ void AudioServer::finish() {
 		AudioDriverManager::get_driver(i)->finish();
 	}
 
+	bus_threads_exit = true;
+	for (int i = 0; i < bus_threads.size(); i++) {
+		bus_work_semaphore.post();
+	}
+	for (int i = 0; i < bus_threads.size(); i++) {
+		Thread::wait_to_finish(bus_threads[i]);
+		memdelete(bus_threads[i]);
+	}
+	bus_threads.clear();
+
+	decode_threads_exit = true;
+	for (int i = 0; i < decode_threads.size(); i++) {
+		decode_semaphore.post();
+	}
+	for (int i = 0; i < decode_threads.size(); i++) {
+		Thread::wait_to_finish(decode_threads[i]);
+		memdelete(decode_threads[i]);
+	}
+	decode_threads.clear();
+
 	for (int i = 0; i < buses.size(); i++) {
 		memdelete(buses[i]);
 	}
@@ -1192,6 +1451,7 @@ void AudioServer::set_bus_layout(const Ref<AudioBusLayout> &p_bus_layout) {
 		bus->mute = p_bus_layout->buses[i].mute;
 		bus->bypass = p_bus_layout->buses[i].bypass;
 		bus->volume_db = p_bus_layout->buses[i].volume_db;
+		bus->max_voices = p_bus_layout->buses[i].max_voices;
 
 		for (int j = 0; j < p_bus_layout->buses[i].effects.size(); j++) {
 
@@ -1212,6 +1472,7 @@ void AudioServer::set_bus_layout(const Ref<AudioBusLayout> &p_bus_layout) {
 		buses[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].temp_buffer.resize(buffer_size);
 		}
 		_update_bus_effects(i);
 	}
@@ -1236,6 +1497,7 @@ Ref<AudioBusLayout> AudioServer::generate_bus_layout() const {
 		state->buses.write[i].solo = buses[i]->solo;
 		state->buses.write[i].bypass = buses[i]->bypass;
 		state->buses.write[i].volume_db = buses[i]->volume_db;
+		state->buses.write[i].max_voices = buses[i]->max_voices;
 		for (int j = 0; j < buses[i]->effects.size(); j++) {
 			AudioBusLayout::Bus::Effect fx;
 			fx.effect = buses[i]->effects[j].effect;
@@ -1307,6 +1569,9 @@ void AudioServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_bus_bypass_effects", "bus_idx", "enable"), &AudioServer::set_bus_bypass_effects);
 	ClassDB::bind_method(D_METHOD("is_bus_bypassing_effects", "bus_idx"), &AudioServer::is_bus_bypassing_effects);
 
+	ClassDB::bind_method(D_METHOD("set_bus_max_voices", "bus_idx", "count"), &AudioServer::set_bus_max_voices);
+	ClassDB::bind_method(D_METHOD("get_bus_max_voices", "bus_idx"), &AudioServer::get_bus_max_voices);
+
 	ClassDB::bind_method(D_METHOD("add_bus_effect", "bus_idx", "effect", "at_position"), &AudioServer::add_bus_effect, DEFVAL(-1));
 	ClassDB::bind_method(D_METHOD("remove_bus_effect", "bus_idx", "effect_idx"), &AudioServer::remove_bus_effect);
 
@@ -1368,6 +1633,12 @@ AudioServer::AudioServer() {
 	mix_time = 0;
 	mix_size = 0;
 	global_rate_scale = 1;
+	mix_solo_mode = false;
+	bus_work_next = 0;
+	bus_work_end = 0;
+	bus_threads_exit = false;
+	decode_threads_exit = false;
+	decode_read_ahead = 0.25;
 }
 
 AudioServer::~AudioServer() {
@@ -1402,6 +1673,8 @@ bool AudioBusLayout::_set(const StringName &p_name, const Variant &p_value) {
 			bus.volume_db = p_value;
 		} else if (what == "send") {
 			bus.send = p_value;
+		} else if (what == "max_voices") {
+			bus.max_voices = p_value;
 		} else if (what == "effect") {
 			int which = s.get_slice("/", 3).to_int();
 			if (bus.effects.size() <= which) {
@@ -1455,6 +1728,8 @@ bool AudioBusLayout::_get(const StringName &p_name, Variant &r_ret) const {
 			r_ret = bus.volume_db;
 		} else if (what == "send") {
 			r_ret = bus.send;
+		} else if (what == "max_voices") {
+			r_ret = bus.max_voices;
 		} else if (what == "effect") {
 			int which = s.get_slice("/", 3).to_int();
 			if (which < 0 || which >= bus.effects.size()) {
@@ -1491,6 +1766,7 @@ void AudioBusLayout::_get_property_list(List<PropertyInfo> *p_list) const {
 		p_list->push_back(PropertyInfo(Variant::BOOL, "bus/" + itos(i) + "/bypass_fx", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::FLOAT, "bus/" + itos(i) + "/volume_db", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::FLOAT, "bus/" + itos(i) + "/send", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		p_list->push_back(PropertyInfo(Variant::INT, "bus/" + itos(i) + "/max_voices", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 
 		for (int j = 0; j < buses[i].effects.size(); j++) {
 			p_list->push_back(PropertyInfo(Variant::OBJECT, "bus/" + itos(i) + "/effect/" + itos(j) + "/effect", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
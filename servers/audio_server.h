@@ -33,10 +33,15 @@
 
 #include "core/math/audio_frame.h"
 #include "core/object.h"
+#include "core/os/mutex.h"
 #include "core/os/os.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/variant.h"
 #include "servers/audio/audio_effect.h"
 
+#include <atomic>
+
 class AudioDriverDummy;
 class AudioStream;
 class AudioStreamSample;
@@ -144,6 +149,7 @@ public:
 };
 
 class AudioBusLayout;
+class AudioStreamPlaybackDecoded;
 
 class AudioServer : public Object {
 
@@ -196,14 +202,17 @@ private:
 		struct Channel {
 			bool used;
 			bool active;
+			bool send_pending; // Mixed this step, to be added to the send bus.
 			AudioFrame peak_volume;
 			Vector<AudioFrame> buffer;
+			Vector<AudioFrame> temp_buffer; // Effects write here, then it's swapped with buffer.
 			Vector<Ref<AudioEffectInstance>> effect_instances;
 			uint64_t last_mix_with_audio;
 			Channel() {
 				last_mix_with_audio = 0;
 				used = false;
 				active = false;
+				send_pending = false;
 				peak_volume = AudioFrame(0, 0);
 			}
 		};
@@ -222,9 +231,11 @@ private:
 		float volume_db;
 		StringName send;
 		int index_cache;
+		int send_index; // Resolved send of this mix step, -1 on the master bus.
+		int wave;
+		int max_voices; // Real voices of the players on this bus, 0 for no limit.
 	};
 
-	Vector<Vector<AudioFrame>> temp_buffer; //temp_buffer for each level
 	Vector<Bus *> buses;
 	Map<StringName, Bus *> bus_map;
 
@@ -236,6 +247,58 @@ private:
 
 	void _mix_step();
 
+	// Buses are processed in waves, the buses of a wave only send to the buses
+	// of the later waves, so their effects can run in parallel on the bus
+	// threads. Every bus adds the buses sending to it in index order, like a
+	// serial mix, so the output doesn't depend on the thread count.
+	Vector<int> bus_wave_order;
+	Vector<int> bus_wave_offsets;
+	bool mix_solo_mode;
+
+	Vector<Thread *> bus_threads;
+	Semaphore bus_work_semaphore;
+	Semaphore bus_done_semaphore;
+	std::atomic<int> bus_work_next;
+	int bus_work_end;
+	std::atomic<bool> bus_threads_exit;
+
+	// Voices of the players, only the most important audible ones of each bus
+	// are real, the others are virtual and only keep their playback position.
+	struct Voice {
+		int bus;
+		int priority;
+		float volume;
+		bool is_virtual;
+	};
+
+	struct VoiceSort {
+		Voice *voice;
+		bool operator<(const VoiceSort &p_other) const {
+			if (voice->priority == p_other.voice->priority) {
+				return voice->volume > p_other.voice->volume;
+			}
+			return voice->priority > p_other.voice->priority;
+		}
+	};
+
+	Map<ObjectID, Voice> voices;
+
+	void _update_voices();
+
+	// Compressed streams registered here are decoded ahead of the mix.
+	Vector<Thread *> decode_threads;
+	Semaphore decode_semaphore;
+	Mutex decode_sources_mutex;
+	Vector<AudioStreamPlaybackDecoded *> decode_sources;
+	std::atomic<bool> decode_threads_exit;
+	float decode_read_ahead;
+
+	static void _decode_thread_function(void *p_user);
+
+	static void _bus_thread_function(void *p_user);
+	void _process_bus_work();
+	void _process_bus(int p_bus);
+
 	struct CallbackItem {
 
 		AudioCallback callback;
@@ -301,6 +364,9 @@ public:
 	void set_bus_bypass_effects(int p_bus, bool p_enable);
 	bool is_bus_bypassing_effects(int p_bus) const;
 
+	void set_bus_max_voices(int p_bus, int p_count);
+	int get_bus_max_voices(int p_bus) const;
+
 	void add_bus_effect(int p_bus, const Ref<AudioEffect> &p_effect, int p_at_pos = -1);
 	void remove_bus_effect(int p_bus, int p_effect);
 
@@ -321,6 +387,15 @@ public:
 	void set_global_rate_scale(float p_scale);
 	float get_global_rate_scale() const;
 
+	void decode_source_add(AudioStreamPlaybackDecoded *p_source);
+	void decode_source_remove(AudioStreamPlaybackDecoded *p_source);
+	float get_decode_read_ahead() const { return decode_read_ahead; }
+
+	// Called by the players from the main thread, volume is linear.
+	void voice_update(ObjectID p_owner, int p_bus, int p_priority, float p_volume);
+	void voice_remove(ObjectID p_owner);
+	bool voice_is_virtual(ObjectID p_owner) const;
+
 	virtual void init();
 	virtual void finish();
 	virtual void update();
@@ -387,12 +462,14 @@ class AudioBusLayout : public Resource {
 
 		float volume_db;
 		StringName send;
+		int max_voices;
 
 		Bus() {
 			solo = false;
 			mute = false;
 			bypass = false;
 			volume_db = 0;
+			max_voices = 0;
 		}
 	};
 
@@ -52,6 +52,9 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_closest_point", "map", "to_point"), &NavigationServer3D::map_get_closest_point);
 	ClassDB::bind_method(D_METHOD("map_get_closest_point_normal", "map", "to_point"), &NavigationServer3D::map_get_closest_point_normal);
 	ClassDB::bind_method(D_METHOD("map_get_closest_point_owner", "map", "to_point"), &NavigationServer3D::map_get_closest_point_owner);
+	ClassDB::bind_method(D_METHOD("map_query_path", "map", "origin", "destination", "optimize", "callback"), &NavigationServer3D::map_query_path, DEFVAL(Callable()));
+	ClassDB::bind_method(D_METHOD("path_query_is_done", "query"), &NavigationServer3D::path_query_is_done);
+	ClassDB::bind_method(D_METHOD("path_query_get_result", "query"), &NavigationServer3D::path_query_get_result);
 
 	ClassDB::bind_method(D_METHOD("region_create"), &NavigationServer3D::region_create);
 	ClassDB::bind_method(D_METHOD("region_set_map", "region", "map"), &NavigationServer3D::region_set_map);
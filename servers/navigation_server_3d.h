@@ -95,6 +95,14 @@ public:
 	virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const = 0;
 	virtual RID map_get_closest_point_owner(RID p_map, const Vector3 &p_point) const = 0;
 
+	/// Queues a path query, run on worker threads between two `process` calls.
+	/// The result is sent to the callback when given, otherwise it has to be
+	/// picked up with `path_query_get_result`.
+	virtual int64_t map_query_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, const Callable &p_callback = Callable()) const = 0;
+	virtual bool path_query_is_done(int64_t p_query) const = 0;
+	/// Returns the path of a finished query and releases it.
+	virtual Vector<Vector3> path_query_get_result(int64_t p_query) const = 0;
+
 	/// Creates a new region.
 	virtual RID region_create() const = 0;
 
@@ -41,26 +41,39 @@ bool AreaPair2DSW::setup(real_t p_step) {
 		result = true;
 	}
 
-	if (result != colliding) {
+	process_collision = result != colliding;
 
-		if (result) {
+	return false; //never solved, pre_solve() applies the change
+}
+
+bool AreaPair2DSW::pre_solve(real_t p_step) {
+
+	//areas and their queries are shared between islands, so changes happen here
+	if (!process_collision) {
+		return false;
+	}
 
-			if (area->get_space_override_mode() != PhysicsServer2D::AREA_SPACE_OVERRIDE_DISABLED)
-				body->add_area(area);
-			if (area->has_monitor_callback())
-				area->add_body_to_query(body, body_shape, area_shape);
+	bool result = !colliding;
 
-		} else {
+	if (result) {
 
-			if (area->get_space_override_mode() != PhysicsServer2D::AREA_SPACE_OVERRIDE_DISABLED)
-				body->remove_area(area);
-			if (area->has_monitor_callback())
-				area->remove_body_from_query(body, body_shape, area_shape);
-		}
+		if (area->get_space_override_mode() != PhysicsServer2D::AREA_SPACE_OVERRIDE_DISABLED)
+			body->add_area(area);
+		if (area->has_monitor_callback())
+			area->add_body_to_query(body, body_shape, area_shape);
 
-		colliding = result;
+	} else {
+
+		if (area->get_space_override_mode() != PhysicsServer2D::AREA_SPACE_OVERRIDE_DISABLED)
+			body->remove_area(area);
+		if (area->has_monitor_callback())
+			area->remove_body_from_query(body, body_shape, area_shape);
 	}
 
+	colliding = result;
+
+	process_collision = false;
+
 	return false; //never do any post solving
 }
 
@@ -74,6 +87,7 @@ AreaPair2DSW::AreaPair2DSW(Body2DSW *p_body, int p_body_shape, Area2DSW *p_area,
 	body_shape = p_body_shape;
 	area_shape = p_area_shape;
 	colliding = false;
+	process_collision = false;
 	body->add_constraint(this, 0);
 	area->add_constraint(this);
 	if (p_body->get_mode() == PhysicsServer2D::BODY_MODE_KINEMATIC) //need to be active to process pair
@@ -104,28 +118,41 @@ bool Area2Pair2DSW::setup(real_t p_step) {
 		result = true;
 	}
 
-	if (result != colliding) {
+	process_collision = result != colliding;
+
+	return false; //never solved, pre_solve() applies the change
+}
+
+bool Area2Pair2DSW::pre_solve(real_t p_step) {
 
-		if (result) {
+	//areas and their queries are shared between islands, so changes happen here
+	if (!process_collision) {
+		return false;
+	}
 
-			if (area_b->has_area_monitor_callback() && area_a->is_monitorable())
-				area_b->add_area_to_query(area_a, shape_a, shape_b);
+	bool result = !colliding;
 
-			if (area_a->has_area_monitor_callback() && area_b->is_monitorable())
-				area_a->add_area_to_query(area_b, shape_b, shape_a);
+	if (result) {
 
-		} else {
+		if (area_b->has_area_monitor_callback() && area_a->is_monitorable())
+			area_b->add_area_to_query(area_a, shape_a, shape_b);
 
-			if (area_b->has_area_monitor_callback() && area_a->is_monitorable())
-				area_b->remove_area_from_query(area_a, shape_a, shape_b);
+		if (area_a->has_area_monitor_callback() && area_b->is_monitorable())
+			area_a->add_area_to_query(area_b, shape_b, shape_a);
 
-			if (area_a->has_area_monitor_callback() && area_b->is_monitorable())
-				area_a->remove_area_from_query(area_b, shape_b, shape_a);
-		}
+	} else {
 
-		colliding = result;
+		if (area_b->has_area_monitor_callback() && area_a->is_monitorable())
+			area_b->remove_area_from_query(area_a, shape_a, shape_b);
+
+		if (area_a->has_area_monitor_callback() && area_b->is_monitorable())
+			area_a->remove_area_from_query(area_b, shape_b, shape_a);
 	}
 
+	colliding = result;
+
+	process_collision = false;
+
 	return false; //never do any post solving
 }
 
@@ -139,6 +166,7 @@ Area2Pair2DSW::Area2Pair2DSW(Area2DSW *p_area_a, int p_shape_a, Area2DSW *p_area
 	shape_a = p_shape_a;
 	shape_b = p_shape_b;
 	colliding = false;
+	process_collision = false;
 	area_a->add_constraint(this);
 	area_b->add_constraint(this);
 }
@@ -229,6 +229,8 @@ real_t combine_friction(Body2DSW *A, Body2DSW *B) {
 
 bool BodyPair2DSW::setup(real_t p_step) {
 
+	contacts_setup = false;
+
 	//cannot collide
 	if (!A->test_collision_mask(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self()) || (A->get_mode() <= PhysicsServer2D::BODY_MODE_KINEMATIC && B->get_mode() <= PhysicsServer2D::BODY_MODE_KINEMATIC && A->get_max_contacts_reported() == 0 && B->get_max_contacts_reported() == 0)) {
 		collided = false;
@@ -245,7 +247,6 @@ bool BodyPair2DSW::setup(real_t p_step) {
 
 	_validate_contacts();
 
-	Vector2 offset_A = A->get_transform().get_origin();
 	Transform2D xform_Au = A->get_transform().untranslated();
 	Transform2D xform_A = xform_Au * A->get_shape_transform(shape_A);
 
@@ -355,6 +356,8 @@ bool BodyPair2DSW::setup(real_t p_step) {
 	}
 
 	cc = 0;
+	contacts_setup = true;
+	report_only = false;
 
 	real_t inv_dt = 1.0 / p_step;
 
@@ -375,39 +378,14 @@ bool BodyPair2DSW::setup(real_t p_step) {
 		}
 
 		c.active = true;
-#ifdef DEBUG_ENABLED
-		if (space->is_debugging_contacts()) {
-			space->add_debug_contact(global_A + offset_A);
-			space->add_debug_contact(global_B + offset_A);
-		}
-#endif
-		int gather_A = A->can_report_contacts();
-		int gather_B = B->can_report_contacts();
+		c.depth = depth;
 
 		c.rA = global_A;
 		c.rB = global_B - offset_B;
 
-		if (gather_A | gather_B) {
-
-			//Vector2 crB( -B->get_angular_velocity() * c.rB.y, B->get_angular_velocity() * c.rB.x );
-
-			global_A += offset_A;
-			global_B += offset_A;
-
-			if (gather_A) {
-				Vector2 crB(-B->get_angular_velocity() * c.rB.y, B->get_angular_velocity() * c.rB.x);
-				A->add_contact(global_A, -c.normal, depth, shape_A, global_B, shape_B, B->get_instance_id(), B->get_self(), crB + B->get_linear_velocity());
-			}
-			if (gather_B) {
-
-				Vector2 crA(-A->get_angular_velocity() * c.rA.y, A->get_angular_velocity() * c.rA.x);
-				B->add_contact(global_B, c.normal, depth, shape_B, global_A, shape_A, A->get_instance_id(), A->get_self(), crA + A->get_linear_velocity());
-			}
-		}
-
 		if ((A->get_mode() <= PhysicsServer2D::BODY_MODE_KINEMATIC && B->get_mode() <= PhysicsServer2D::BODY_MODE_KINEMATIC)) {
-			c.active = false;
-			collided = false;
+			//only reported, pre_solve() takes care of it
+			report_only = true;
 			continue;
 		}
 
@@ -455,6 +433,65 @@ bool BodyPair2DSW::setup(real_t p_step) {
 	return do_process;
 }
 
+bool BodyPair2DSW::pre_solve(real_t p_step) {
+
+	if (!collided || !contacts_setup) {
+		return false;
+	}
+
+	// contact query reporting and debug contacts, bodies reporting contacts may be shared with other islands
+
+	bool gather_A = A->can_report_contacts();
+	bool gather_B = B->can_report_contacts();
+#ifdef DEBUG_ENABLED
+	bool debug_contacts = space->is_debugging_contacts();
+#else
+	bool debug_contacts = false;
+#endif
+
+	if (gather_A || gather_B || debug_contacts) {
+
+		Vector2 offset_A = A->get_transform().get_origin();
+
+		for (int i = 0; i < contact_count; i++) {
+
+			Contact &c = contacts[i];
+			if (!c.active) {
+				continue;
+			}
+
+			Vector2 global_A = c.rA + offset_A;
+			Vector2 global_B = c.rB + offset_B + offset_A;
+
+			if (debug_contacts) {
+				space->add_debug_contact(global_A);
+				space->add_debug_contact(global_B);
+			}
+
+			if (gather_A) {
+				Vector2 crB(-B->get_angular_velocity() * c.rB.y, B->get_angular_velocity() * c.rB.x);
+				A->add_contact(global_A, -c.normal, c.depth, shape_A, global_B, shape_B, B->get_instance_id(), B->get_self(), crB + B->get_linear_velocity());
+			}
+			if (gather_B) {
+
+				Vector2 crA(-A->get_angular_velocity() * c.rA.y, A->get_angular_velocity() * c.rA.x);
+				B->add_contact(global_B, c.normal, c.depth, shape_B, global_A, shape_A, A->get_instance_id(), A->get_self(), crA + A->get_linear_velocity());
+			}
+		}
+	}
+
+	if (report_only) {
+		//both bodies are static or kinematic, nothing to solve
+		for (int i = 0; i < contact_count; i++) {
+			contacts[i].active = false;
+		}
+		collided = false;
+		return false;
+	}
+
+	return true;
+}
+
 void BodyPair2DSW::solve(real_t p_step) {
 
 	if (!collided)
@@ -523,6 +560,8 @@ BodyPair2DSW::BodyPair2DSW(Body2DSW *p_A, int p_shape_A, Body2DSW *p_B, int p_sh
 	contact_count = 0;
 	collided = false;
 	oneway_disabled = false;
+	contacts_setup = false;
+	report_only = false;
 }
 
 BodyPair2DSW::~BodyPair2DSW() {
@@ -30,89 +30,67 @@
 
 #include "broad_phase_2d_hash_grid.h"
 #include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 
 #define LARGE_ELEMENT_FI 1.01239812
 
-void BroadPhase2DHashGrid::_pair_attempt(Element *p_elem, Element *p_with) {
+bool BroadPhase2DHashGrid::_is_large(const Rect2 &p_rect) const {
 
-	Map<Element *, PairData *>::Element *E = p_elem->paired.find(p_with);
-
-	ERR_FAIL_COND(p_elem->_static && p_with->_static);
-
-	if (!E) {
-
-		PairData *pd = memnew(PairData);
-		p_elem->paired[p_with] = pd;
-		p_with->paired[p_elem] = pd;
-	} else {
-		E->get()->rc++;
-	}
+	Vector2 sz = (p_rect.size / cell_size * LARGE_ELEMENT_FI); //use magic number to avoid floating point issues
+	return sz.width * sz.height > large_object_min_surface;
 }
 
-void BroadPhase2DHashGrid::_unpair_attempt(Element *p_elem, Element *p_with) {
+bool BroadPhase2DHashGrid::_can_pair(const Element *p_elem, const Element *p_with) const {
 
-	Map<Element *, PairData *>::Element *E = p_elem->paired.find(p_with);
+	if (p_elem == p_with || p_elem->owner == p_with->owner)
+		return false; // do not pair against itself
+	if (p_elem->_static && p_with->_static)
+		return false;
 
-	ERR_FAIL_COND(!E); //this should really be paired..
+	return p_elem->aabb.intersects(p_with->aabb);
+}
 
-	E->get()->rc--;
+void BroadPhase2DHashGrid::_pair(Element *p_elem, Element *p_with) {
 
-	if (E->get()->rc == 0) {
+	ERR_FAIL_COND(p_elem->_static && p_with->_static);
 
-		if (E->get()->colliding) {
-			//uncollide
-			if (unpair_callback) {
-				unpair_callback(p_elem->owner, p_elem->subindex, p_with->owner, p_with->subindex, E->get()->ud, unpair_userdata);
-			}
-		}
+	PairData *pd = memnew(PairData);
+	p_elem->paired[p_with] = pd;
+	p_with->paired[p_elem] = pd;
 
-		memdelete(E->get());
-		p_elem->paired.erase(E);
-		p_with->paired.erase(p_elem);
+	if (pair_callback) {
+		pd->ud = pair_callback(p_elem->owner, p_elem->subindex, p_with->owner, p_with->subindex, pair_userdata);
 	}
 }
 
-void BroadPhase2DHashGrid::_check_motion(Element *p_elem) {
+void BroadPhase2DHashGrid::_unpair(Element *p_elem, Element *p_with) {
 
-	for (Map<Element *, PairData *>::Element *E = p_elem->paired.front(); E; E = E->next()) {
+	Map<Element *, PairData *, ElementCompare>::Element *E = p_elem->paired.find(p_with);
 
-		bool pairing = p_elem->aabb.intersects(E->key()->aabb);
+	ERR_FAIL_COND(!E); //this should really be paired..
 
-		if (pairing != E->get()->colliding) {
+	if (unpair_callback) {
+		unpair_callback(p_elem->owner, p_elem->subindex, p_with->owner, p_with->subindex, E->get()->ud, unpair_userdata);
+	}
 
-			if (pairing) {
+	memdelete(E->get());
+	p_elem->paired.erase(E);
+	p_with->paired.erase(p_elem);
+}
 
-				if (pair_callback) {
-					E->get()->ud = pair_callback(p_elem->owner, p_elem->subindex, E->key()->owner, E->key()->subindex, pair_userdata);
-				}
-			} else {
+void BroadPhase2DHashGrid::_set_moved(Element *p_elem) {
 
-				if (unpair_callback) {
-					unpair_callback(p_elem->owner, p_elem->subindex, E->key()->owner, E->key()->subindex, E->get()->ud, unpair_userdata);
-				}
-			}
+	if (p_elem->moved_index != NOT_MOVED)
+		return;
 
-			E->get()->colliding = pairing;
-		}
-	}
+	p_elem->moved_index = moved_elements.size();
+	moved_elements.push_back(p_elem);
 }
 
 void BroadPhase2DHashGrid::_enter_grid(Element *p_elem, const Rect2 &p_rect, bool p_static) {
 
-	Vector2 sz = (p_rect.size / cell_size * LARGE_ELEMENT_FI); //use magic number to avoid floating point issues
-	if (sz.width * sz.height > large_object_min_surface) {
-		//large object, do not use grid, must check against all elements
-		for (Map<ID, Element>::Element *E = element_map.front(); E; E = E->next()) {
-			if (E->key() == p_elem->self)
-				continue; // do not pair against itself
-			if (E->get().owner == p_elem->owner)
-				continue;
-			if (E->get()._static && p_static)
-				continue;
-
-			_pair_attempt(p_elem, &E->get());
-		}
-
+	if (_is_large(p_rect)) {
+		//large object, do not use grid, pairs are found against all elements
 		large_elements[p_elem].inc();
 		return;
 	}
@@ -140,8 +118,6 @@ void BroadPhase2DHashGrid::_enter_grid(Element *p_elem, const Rect2 &p_rect, boo
 				pb = pb->next;
 			}
 
-			bool entered = false;
-
 			if (!pb) {
 				//does not exist, create!
 				pb = memnew(PosBin);
@@ -151,65 +127,17 @@ void BroadPhase2DHashGrid::_enter_grid(Element *p_elem, const Rect2 &p_rect, boo
 			}
 
 			if (p_static) {
-				if (pb->static_object_set[p_elem].inc() == 1) {
-					entered = true;
-				}
+				pb->static_object_set[p_elem].inc();
 			} else {
-				if (pb->object_set[p_elem].inc() == 1) {
-
-					entered = true;
-				}
-			}
-
-			if (entered) {
-
-				for (Map<Element *, RC>::Element *E = pb->object_set.front(); E; E = E->next()) {
-
-					if (E->key()->owner == p_elem->owner)
-						continue;
-					_pair_attempt(p_elem, E->key());
-				}
-
-				if (!p_static) {
-
-					for (Map<Element *, RC>::Element *E = pb->static_object_set.front(); E; E = E->next()) {
-
-						if (E->key()->owner == p_elem->owner)
-							continue;
-						_pair_attempt(p_elem, E->key());
-					}
-				}
+				pb->object_set[p_elem].inc();
 			}
 		}
 	}
-
-	//pair separatedly with large elements
-
-	for (Map<Element *, RC>::Element *E = large_elements.front(); E; E = E->next()) {
-
-		if (E->key() == p_elem)
-			continue; // do not pair against itself
-		if (E->key()->owner == p_elem->owner)
-			continue;
-		if (E->key()->_static && p_static)
-			continue;
-
-		_pair_attempt(E->key(), p_elem);
-	}
 }
 
 void BroadPhase2DHashGrid::_exit_grid(Element *p_elem, const Rect2 &p_rect, bool p_static) {
 
-	Vector2 sz = (p_rect.size / cell_size * LARGE_ELEMENT_FI);
-	if (sz.width * sz.height > large_object_min_surface) {
-
-		//unpair all elements, instead of checking all, just check what is already paired, so we at least save from checking static vs static
-		Map<Element *, PairData *>::Element *E = p_elem->paired.front();
-		while (E) {
-			Map<Element *, PairData *>::Element *next = E->next();
-			_unpair_attempt(p_elem, E->key());
-			E = next;
-		}
+	if (_is_large(p_rect)) {
 
 		if (large_elements[p_elem].dec() == 0) {
 			large_elements.erase(p_elem);
@@ -242,39 +170,13 @@ void BroadPhase2DHashGrid::_exit_grid(Element *p_elem, const Rect2 &p_rect, bool
 
 			ERR_CONTINUE(!pb); //should exist!!
 
-			bool exited = false;
-
 			if (p_static) {
 				if (pb->static_object_set[p_elem].dec() == 0) {
-
 					pb->static_object_set.erase(p_elem);
-					exited = true;
 				}
 			} else {
 				if (pb->object_set[p_elem].dec() == 0) {
-
 					pb->object_set.erase(p_elem);
-					exited = true;
-				}
-			}
-
-			if (exited) {
-
-				for (Map<Element *, RC>::Element *E = pb->object_set.front(); E; E = E->next()) {
-
-					if (E->key()->owner == p_elem->owner)
-						continue;
-					_unpair_attempt(p_elem, E->key());
-				}
-
-				if (!p_static) {
-
-					for (Map<Element *, RC>::Element *E = pb->static_object_set.front(); E; E = E->next()) {
-
-						if (E->key()->owner == p_elem->owner)
-							continue;
-						_unpair_attempt(p_elem, E->key());
-					}
 				}
 			}
 
@@ -303,18 +205,6 @@ void BroadPhase2DHashGrid::_exit_grid(Element *p_elem, const Rect2 &p_rect, bool
 			}
 		}
 	}
-
-	for (Map<Element *, RC>::Element *E = large_elements.front(); E; E = E->next()) {
-		if (E->key() == p_elem)
-			continue; // do not pair against itself
-		if (E->key()->owner == p_elem->owner)
-			continue;
-		if (E->key()->_static && p_static)
-			continue;
-
-		//unpair from large elements
-		_unpair_attempt(p_elem, E->key());
-	}
 }
 
 BroadPhase2DHashGrid::ID BroadPhase2DHashGrid::create(CollisionObject2DSW *p_object, int p_subindex) {
@@ -327,6 +217,7 @@ BroadPhase2DHashGrid::ID BroadPhase2DHashGrid::create(CollisionObject2DSW *p_obj
 	e.subindex = p_subindex;
 	e.self = current;
 	e.pass = 0;
+	e.moved_index = NOT_MOVED;
 
 	element_map[current] = e;
 	return current;
@@ -342,21 +233,37 @@ void BroadPhase2DHashGrid::move(ID p_id, const Rect2 &p_aabb) {
 	if (p_aabb == e.aabb)
 		return;
 
-	if (p_aabb != Rect2()) {
+	//the grid is only touched when the covered cells change, large elements are not in it at all
+	bool same_cells = false;
+	if (p_aabb != Rect2() && e.aabb != Rect2()) {
 
-		_enter_grid(&e, p_aabb, e._static);
+		bool large = _is_large(p_aabb);
+		if (large != _is_large(e.aabb)) {
+			same_cells = false;
+		} else if (large) {
+			same_cells = true;
+		} else {
+			same_cells = (p_aabb.position / cell_size).floor() == (e.aabb.position / cell_size).floor() &&
+						 ((p_aabb.position + p_aabb.size) / cell_size).floor() == ((e.aabb.position + e.aabb.size) / cell_size).floor();
+		}
 	}
 
-	if (e.aabb != Rect2()) {
+	if (!same_cells) {
 
-		_exit_grid(&e, e.aabb, e._static);
-	}
+		if (p_aabb != Rect2()) {
 
-	e.aabb = p_aabb;
+			_enter_grid(&e, p_aabb, e._static);
+		}
+
+		if (e.aabb != Rect2()) {
 
-	_check_motion(&e);
+			_exit_grid(&e, e.aabb, e._static);
+		}
+	}
 
 	e.aabb = p_aabb;
+
+	_set_moved(&e);
 }
 void BroadPhase2DHashGrid::set_static(ID p_id, bool p_static) {
 
@@ -375,7 +282,7 @@ void BroadPhase2DHashGrid::set_static(ID p_id, bool p_static) {
 
 	if (e.aabb != Rect2()) {
 		_enter_grid(&e, e.aabb, e._static);
-		_check_motion(&e);
+		_set_moved(&e);
 	}
 }
 void BroadPhase2DHashGrid::remove(ID p_id) {
@@ -385,9 +292,19 @@ void BroadPhase2DHashGrid::remove(ID p_id) {
 
 	Element &e = E->get();
 
+	while (e.paired.front()) {
+		_unpair(&e, e.paired.front()->key());
+	}
+
 	if (e.aabb != Rect2())
 		_exit_grid(&e, e.aabb, e._static);
 
+	if (e.moved_index != NOT_MOVED) {
+		Element *last = moved_elements[moved_elements.size() - 1];
+		last->moved_index = e.moved_index;
+		moved_elements.remove_unordered(e.moved_index);
+	}
+
 	element_map.erase(p_id);
 }
 
@@ -624,7 +541,151 @@ void BroadPhase2DHashGrid::set_unpair_callback(UnpairCallback p_unpair_callback,
 	unpair_userdata = p_userdata;
 }
 
+void BroadPhase2DHashGrid::_find_pair_candidates(uint32_t p_index, void *p_userdata) {
+
+	//runs on threads, so the grid and the other elements must only be read here
+	Element *e = moved_elements[p_index];
+	LocalVector<Element *> &candidates = e->pair_candidates;
+	candidates.clear();
+
+	if (e->aabb == Rect2())
+		return;
+
+	if (_is_large(e->aabb)) {
+
+		for (const Map<ID, Element>::Element *E = element_map.front(); E; E = E->next()) {
+
+			const Element *other = &E->get();
+			if (other->aabb != Rect2() && _can_pair(e, other)) {
+				candidates.push_back(const_cast<Element *>(other));
+			}
+		}
+
+	} else {
+
+		Point2i from = (e->aabb.position / cell_size).floor();
+		Point2i to = ((e->aabb.position + e->aabb.size) / cell_size).floor();
+
+		for (int i = from.x; i <= to.x; i++) {
+
+			for (int j = from.y; j <= to.y; j++) {
+
+				PosKey pk;
+				pk.x = i;
+				pk.y = j;
+
+				const PosBin *pb = hash_table[pk.hash() % hash_table_size];
+
+				while (pb) {
+
+					if (pb->key == pk) {
+						break;
+					}
+
+					pb = pb->next;
+				}
+
+				ERR_CONTINUE(!pb); //should exist!!
+
+				for (const Map<Element *, RC>::Element *E = pb->object_set.front(); E; E = E->next()) {
+
+					if (_can_pair(e, E->key())) {
+						candidates.push_back(E->key());
+					}
+				}
+
+				if (!e->_static) {
+
+					for (const Map<Element *, RC>::Element *E = pb->static_object_set.front(); E; E = E->next()) {
+
+						if (_can_pair(e, E->key())) {
+							candidates.push_back(E->key());
+						}
+					}
+				}
+			}
+		}
+
+		//pair separatedly with large elements
+
+		for (const Map<Element *, RC>::Element *E = large_elements.front(); E; E = E->next()) {
+
+			if (_can_pair(e, E->key())) {
+				candidates.push_back(E->key());
+			}
+		}
+	}
+
+	//elements spanning several cells are found more than once
+	candidates.sort_custom<ElementCompare>();
+
+	uint32_t unique_count = 0;
+	for (uint32_t i = 0; i < candidates.size(); i++) {
+
+		if (unique_count == 0 || candidates[unique_count - 1] != candidates[i]) {
+			candidates[unique_count++] = candidates[i];
+		}
+	}
+	candidates.resize(unique_count);
+}
+
 void BroadPhase2DHashGrid::update() {
+
+	if (moved_elements.empty())
+		return;
+
+	moved_elements.sort_custom<ElementCompare>();
+	for (uint32_t i = 0; i < moved_elements.size(); i++) {
+		moved_elements[i]->moved_index = i;
+	}
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+
+	if (pool && moved_elements.size() >= PARALLEL_MIN_MOVED) {
+		pool->do_work(moved_elements.size(), this, &BroadPhase2DHashGrid::_find_pair_candidates, (void *)NULL);
+	} else {
+		for (uint32_t i = 0; i < moved_elements.size(); i++) {
+			_find_pair_candidates(i, NULL);
+		}
+	}
+
+	//merge serially, both the candidates and the existing pairs are sorted by ID, so the callbacks always happen in the same order
+
+	for (uint32_t i = 0; i < moved_elements.size(); i++) {
+
+		Element *e = moved_elements[i];
+		e->moved_index = NOT_MOVED;
+
+		const LocalVector<Element *> &candidates = e->pair_candidates;
+		ElementCompare compare;
+
+		Map<Element *, PairData *, ElementCompare>::Element *E = e->paired.front();
+		uint32_t c = 0;
+
+		while (E || c < candidates.size()) {
+
+			if (E && (c == candidates.size() || compare(E->key(), candidates[c]))) {
+
+				//no longer overlapping
+				Map<Element *, PairData *, ElementCompare>::Element *next = E->next();
+				_unpair(e, E->key());
+				E = next;
+
+			} else if (!E || compare(candidates[c], E->key())) {
+
+				//new overlap, unless the other element was moved too and already paired
+				_pair(e, candidates[c]);
+				c++;
+
+			} else {
+
+				E = E->next();
+				c++;
+			}
+		}
+	}
+
+	moved_elements.clear();
 }
 
 BroadPhase2DSW *BroadPhase2DHashGrid::_create() {
@@ -32,22 +32,31 @@
 #define BROAD_PHASE_2D_HASH_GRID_H
 
 #include "broad_phase_2d_sw.h"
+#include "core/local_vector.h"
 #include "core/map.h"
 
 class BroadPhase2DHashGrid : public BroadPhase2DSW {
 
+	enum {
+		NOT_MOVED = 0xFFFFFFFF,
+		PARALLEL_MIN_MOVED = 64 // below this, finding pairs on threads costs more than it saves
+	};
+
 	struct PairData {
 
-		bool colliding;
-		int rc;
 		void *ud;
 		PairData() {
-			colliding = false;
-			rc = 1;
 			ud = NULL;
 		}
 	};
 
+	struct Element;
+
+	// sorting by ID keeps pairs and callbacks in the same order on every run
+	struct ElementCompare {
+		_FORCE_INLINE_ bool operator()(const Element *p_a, const Element *p_b) const { return p_a->self < p_b->self; }
+	};
+
 	struct Element {
 
 		ID self;
@@ -56,7 +65,9 @@ class BroadPhase2DHashGrid : public BroadPhase2DSW {
 		Rect2 aabb;
 		int subindex;
 		uint64_t pass;
-		Map<Element *, PairData *> paired;
+		uint32_t moved_index;
+		Map<Element *, PairData *, ElementCompare> paired;
+		LocalVector<Element *> pair_candidates; // filled by the threads in update()
 	};
 
 	struct RC {
@@ -79,6 +90,7 @@ class BroadPhase2DHashGrid : public BroadPhase2DSW {
 
 	Map<ID, Element> element_map;
 	Map<Element *, RC> large_elements;
+	LocalVector<Element *> moved_elements; // pairs are only recomputed for these, in update()
 
 	ID current;
 
@@ -163,9 +175,13 @@ class BroadPhase2DHashGrid : public BroadPhase2DSW {
 	uint32_t hash_table_size;
 	PosBin **hash_table;
 
-	void _pair_attempt(Element *p_elem, Element *p_with);
-	void _unpair_attempt(Element *p_elem, Element *p_with);
-	void _check_motion(Element *p_elem);
+	_FORCE_INLINE_ bool _is_large(const Rect2 &p_rect) const;
+	_FORCE_INLINE_ bool _can_pair(const Element *p_elem, const Element *p_with) const;
+
+	void _pair(Element *p_elem, Element *p_with);
+	void _unpair(Element *p_elem, Element *p_with);
+	void _set_moved(Element *p_elem);
+	void _find_pair_candidates(uint32_t p_index, void *p_userdata);
 
 public:
 	virtual ID create(CollisionObject2DSW *p_object, int p_subindex = 0);
@@ -36,6 +36,7 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
 	ERR_FAIL_COND_MSG(m_object->get_space() && flushing_queries, "Can't change this state while flushing queries. Use call_deferred() or set_deferred() to change monitoring state instead.");
@@ -1321,10 +1322,14 @@ void PhysicsServer2DSW::init() {
 	doing_sync = false;
 	last_step = 0.001;
 	iterations = 8; // 8?
-	stepper = memnew(Step2DSW);
 	direct_state = memnew(PhysicsDirectBodyState2DSW);
 };
 
+void PhysicsServer2DSW::_step_space(uint32_t p_index, void *p_userdata) {
+
+	steppers[p_index]->step(stepping_spaces[p_index], last_step, iterations);
+}
+
 void PhysicsServer2DSW::step(real_t p_step) {
 
 	if (!active)
@@ -1339,12 +1344,28 @@ void PhysicsServer2DSW::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+
+	stepping_spaces.clear();
 	for (Set<const Space2DSW *>::Element *E = active_spaces.front(); E; E = E->next()) {
+		stepping_spaces.push_back((Space2DSW *)E->get());
+	}
+	while (steppers.size() < stepping_spaces.size()) {
+		steppers.push_back(memnew(Step2DSW));
+	}
 
-		stepper->step((Space2DSW *)E->get(), p_step, iterations);
-		island_count += E->get()->get_island_count();
-		active_objects += E->get()->get_active_objects();
-		collision_pairs += E->get()->get_collision_pairs();
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0 && stepping_spaces.size() > 1) {
+		pool->do_work(stepping_spaces.size(), this, &PhysicsServer2DSW::_step_space, (void *)NULL);
+	} else {
+		for (uint32_t i = 0; i < stepping_spaces.size(); i++) {
+			_step_space(i, NULL);
+		}
+	}
+
+	for (uint32_t i = 0; i < stepping_spaces.size(); i++) {
+		island_count += stepping_spaces[i]->get_island_count();
+		active_objects += stepping_spaces[i]->get_active_objects();
+		collision_pairs += stepping_spaces[i]->get_collision_pairs();
 	}
 };
 
@@ -1412,7 +1433,10 @@ void PhysicsServer2DSW::end_sync() {
 
 void PhysicsServer2DSW::finish() {
 
-	memdelete(stepper);
+	for (uint32_t i = 0; i < steppers.size(); i++) {
+		memdelete(steppers[i]);
+	}
+	steppers.clear();
 	memdelete(direct_state);
 };
 
@@ -31,6 +31,7 @@
 #ifndef PHYSICS_2D_SERVER_SW
 #define PHYSICS_2D_SERVER_SW
 
+#include "core/local_vector.h"
 #include "core/rid_owner.h"
 #include "joints_2d_sw.h"
 #include "servers/physics_server_2d.h"
@@ -57,9 +58,14 @@ class PhysicsServer2DSW : public PhysicsServer2D {
 
 	bool flushing_queries;
 
-	Step2DSW *stepper;
+	// Spaces share no bodies, so they are stepped in parallel, each one
+	// with its own stepper.
+	LocalVector<Step2DSW *> steppers;
+	LocalVector<Space2DSW *> stepping_spaces;
 	Set<const Space2DSW *> active_spaces;
 
+	void _step_space(uint32_t p_index, void *p_userdata);
+
 	PhysicsDirectBodyState2DSW *direct_state;
 
 	mutable RID_PtrOwner<Shape2DSW> shape_owner;
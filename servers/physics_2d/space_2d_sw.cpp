@@ -33,6 +33,7 @@
 #include "collision_solver_2d_sw.h"
 #include "core/os/os.h"
 #include "core/pair.h"
+#include "core/thread_work_pool.h"
 #include "physics_server_2d_sw.h"
 _FORCE_INLINE_ static bool _can_collide_with(CollisionObject2DSW *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
@@ -117,13 +118,20 @@ bool PhysicsDirectSpaceState2DSW::intersect_ray(const Vector2 &p_from, const Vec
 
 	ERR_FAIL_COND_V(space->locked, false);
 
+	int amount = space->broadphase->cull_segment(p_from, p_to, space->intersection_query_results, Space2DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_ray(p_from, p_to, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result, p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+}
+
+bool PhysicsDirectSpaceState2DSW::_intersect_ray(const Vector2 &p_from, const Vector2 &p_to, CollisionObject2DSW *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) const {
+
 	Vector2 begin, end;
 	Vector2 normal;
 	begin = p_from;
 	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, Space2DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = p_amount;
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -135,15 +143,15 @@ bool PhysicsDirectSpaceState2DSW::intersect_ray(const Vector2 &p_from, const Vec
 
 	for (int i = 0; i < amount; i++) {
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas))
+		if (!_can_collide_with(p_objects[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas))
 			continue;
 
-		if (p_exclude.has(space->intersection_query_results[i]->get_self()))
+		if (p_exclude.has(p_objects[i]->get_self()))
 			continue;
 
-		const CollisionObject2DSW *col_obj = space->intersection_query_results[i];
+		const CollisionObject2DSW *col_obj = p_objects[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_subindices[i];
 		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector2 local_from = inv_xform.xform(begin);
@@ -238,30 +246,44 @@ int PhysicsDirectSpaceState2DSW::intersect_shape(const RID &p_shape, const Trans
 	return cc;
 }
 
+_FORCE_INLINE_ static Rect2 _get_cast_motion_aabb(const Shape2DSW *p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin) {
+
+	Rect2 aabb = p_xform.xform(p_shape->get_aabb());
+	aabb = aabb.merge(Rect2(aabb.position + p_motion, aabb.size)); //motion
+	aabb = aabb.grow(p_margin);
+	return aabb;
+}
+
 bool PhysicsDirectSpaceState2DSW::cast_motion(const RID &p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin, real_t &p_closest_safe, real_t &p_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
 	Shape2DSW *shape = PhysicsServer2DSW::singletonsw->shape_owner.getornull(p_shape);
 	ERR_FAIL_COND_V(!shape, false);
 
-	Rect2 aabb = p_xform.xform(shape->get_aabb());
-	aabb = aabb.merge(Rect2(aabb.position + p_motion, aabb.size)); //motion
-	aabb = aabb.grow(p_margin);
+	Rect2 aabb = _get_cast_motion_aabb(shape, p_xform, p_motion, p_margin);
 
 	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, Space2DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
 
+	return _cast_motion(shape, p_xform, p_motion, p_margin, space->intersection_query_results, space->intersection_query_subindex_results, amount, p_closest_safe, p_closest_unsafe, p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+}
+
+bool PhysicsDirectSpaceState2DSW::_cast_motion(Shape2DSW *p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin, CollisionObject2DSW *const *p_objects, const int *p_subindices, int p_amount, real_t &p_closest_safe, real_t &p_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) const {
+
+	Shape2DSW *shape = p_shape;
+	int amount = p_amount;
+
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
 	for (int i = 0; i < amount; i++) {
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas))
+		if (!_can_collide_with(p_objects[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas))
 			continue;
 
-		if (p_exclude.has(space->intersection_query_results[i]->get_self()))
+		if (p_exclude.has(p_objects[i]->get_self()))
 			continue; //ignore excluded
 
-		const CollisionObject2DSW *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const CollisionObject2DSW *col_obj = p_objects[i];
+		int shape_idx = p_subindices[i];
 
 		Transform2D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
@@ -308,6 +330,118 @@ bool PhysicsDirectSpaceState2DSW::cast_motion(const RID &p_shape, const Transfor
 	return true;
 }
 
+void PhysicsDirectSpaceState2DSW::_intersect_ray_batch(uint32_t p_index, RayBatch *p_batch) {
+
+	uint32_t from = p_batch->offsets[p_index];
+	uint32_t amount = p_batch->offsets[p_index + 1] - from;
+
+	p_batch->hits[p_index] = _intersect_ray(p_batch->from[p_index], p_batch->to[p_index], p_batch->objects.ptr() + from, p_batch->subindices.ptr() + from, amount, p_batch->ray_results[p_index], *p_batch->exclude, p_batch->collision_mask, p_batch->collide_with_bodies, p_batch->collide_with_areas);
+}
+
+void PhysicsDirectSpaceState2DSW::_cast_motion_batch(uint32_t p_index, RayBatch *p_batch) {
+
+	uint32_t from = p_batch->offsets[p_index];
+	uint32_t amount = p_batch->offsets[p_index + 1] - from;
+
+	real_t &safe = p_batch->closest_safe[p_index];
+	real_t &unsafe = p_batch->closest_unsafe[p_index];
+	p_batch->hits[p_index] = _cast_motion(p_batch->shape, p_batch->xforms[p_index], p_batch->motions[p_index], p_batch->margin, p_batch->objects.ptr() + from, p_batch->subindices.ptr() + from, amount, safe, unsafe, *p_batch->exclude, p_batch->collision_mask, p_batch->collide_with_bodies, p_batch->collide_with_areas);
+	if (!p_batch->hits[p_index]) {
+		safe = 0;
+		unsafe = 0;
+	}
+}
+
+void PhysicsDirectSpaceState2DSW::_add_batch_candidates(RayBatch &r_batch, int p_amount) {
+
+	//the broadphase is not thread safe, so candidates are gathered first and only the narrow phase runs in parallel
+	r_batch.offsets.push_back(r_batch.objects.size());
+	for (int i = 0; i < p_amount; i++) {
+		r_batch.objects.push_back(space->intersection_query_results[i]);
+		r_batch.subindices.push_back(space->intersection_query_subindex_results[i]);
+	}
+}
+
+void PhysicsDirectSpaceState2DSW::_process_batch(uint32_t p_count, void (PhysicsDirectSpaceState2DSW::*p_method)(uint32_t, RayBatch *), RayBatch *p_batch) {
+
+	p_batch->offsets.push_back(p_batch->objects.size());
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (pool && p_count >= BATCH_PARALLEL_MIN) {
+		pool->do_work(p_count, this, p_method, p_batch);
+	} else {
+		for (uint32_t i = 0; i < p_count; i++) {
+			(this->*p_method)(i, p_batch);
+		}
+	}
+}
+
+int PhysicsDirectSpaceState2DSW::intersect_rays(const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	RayBatch batch;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.ray_results = r_results;
+	batch.hits = r_hits;
+	batch.exclude = &p_exclude;
+	batch.collision_mask = p_collision_mask;
+	batch.collide_with_bodies = p_collide_with_bodies;
+	batch.collide_with_areas = p_collide_with_areas;
+
+	for (int i = 0; i < p_count; i++) {
+		int amount = space->broadphase->cull_segment(p_from[i], p_to[i], space->intersection_query_results, Space2DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+		_add_batch_candidates(batch, amount);
+	}
+
+	_process_batch(p_count, &PhysicsDirectSpaceState2DSW::_intersect_ray_batch, &batch);
+
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_hits[i])
+			hit_count++;
+	}
+	return hit_count;
+}
+
+int PhysicsDirectSpaceState2DSW::cast_motions(const RID &p_shape, const Transform2D *p_xforms, const Vector2 *p_motions, int p_count, real_t p_margin, real_t *r_closest_safe, real_t *r_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	Shape2DSW *shape = PhysicsServer2DSW::singletonsw->shape_owner.getornull(p_shape);
+	ERR_FAIL_COND_V(!shape, 0);
+
+	LocalVector<bool> valid;
+	valid.resize(p_count);
+
+	RayBatch batch;
+	batch.shape = shape;
+	batch.xforms = p_xforms;
+	batch.motions = p_motions;
+	batch.margin = p_margin;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+	batch.hits = valid.ptr();
+	batch.exclude = &p_exclude;
+	batch.collision_mask = p_collision_mask;
+	batch.collide_with_bodies = p_collide_with_bodies;
+	batch.collide_with_areas = p_collide_with_areas;
+
+	for (int i = 0; i < p_count; i++) {
+		Rect2 aabb = _get_cast_motion_aabb(shape, p_xforms[i], p_motions[i], p_margin);
+		int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, Space2DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+		_add_batch_candidates(batch, amount);
+	}
+
+	_process_batch(p_count, &PhysicsDirectSpaceState2DSW::_cast_motion_batch, &batch);
+
+	int valid_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (valid[i])
+			valid_count++;
+	}
+	return valid_count;
+}
+
 bool PhysicsDirectSpaceState2DSW::collide_shape(RID p_shape, const Transform2D &p_shape_xform, const Vector2 &p_motion, real_t p_margin, Vector2 *r_results, int p_result_max, int &r_result_count, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
 	if (p_result_max <= 0)
@@ -1270,6 +1404,9 @@ void Space2DSW::setup() {
 		inertia_update_list.first()->self()->update_inertias();
 		inertia_update_list.remove(inertia_update_list.first());
 	}
+
+	//pair what was moved since the last step, so the new pairs are already solved in this one
+	broadphase->update();
 }
 
 void Space2DSW::update() {
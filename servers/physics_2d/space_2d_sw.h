@@ -38,6 +38,7 @@
 #include "broad_phase_2d_sw.h"
 #include "collision_object_2d_sw.h"
 #include "core/hash_map.h"
+#include "core/local_vector.h"
 #include "core/project_settings.h"
 #include "core/typedefs.h"
 
@@ -47,6 +48,43 @@ class PhysicsDirectSpaceState2DSW : public PhysicsDirectSpaceState2D {
 
 	int _intersect_point_impl(const Vector2 &p_point, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_point, bool p_filter_by_canvas = false, ObjectID p_canvas_instance_id = ObjectID());
 
+	enum {
+		BATCH_PARALLEL_MIN = 16 // smaller batches are not worth sending to threads
+	};
+
+	// shared by the ray and motion batches, each query only uses its own part
+	struct RayBatch {
+
+		const Vector2 *from = nullptr;
+		const Vector2 *to = nullptr;
+		RayResult *ray_results = nullptr;
+
+		Shape2DSW *shape = nullptr;
+		const Transform2D *xforms = nullptr;
+		const Vector2 *motions = nullptr;
+		real_t margin = 0;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+
+		bool *hits = nullptr;
+		const Set<RID> *exclude = nullptr;
+		uint32_t collision_mask = 0;
+		bool collide_with_bodies = true;
+		bool collide_with_areas = false;
+
+		LocalVector<CollisionObject2DSW *> objects;
+		LocalVector<int> subindices;
+		LocalVector<uint32_t> offsets;
+	};
+
+	bool _intersect_ray(const Vector2 &p_from, const Vector2 &p_to, CollisionObject2DSW *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) const;
+	bool _cast_motion(Shape2DSW *p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin, CollisionObject2DSW *const *p_objects, const int *p_subindices, int p_amount, real_t &p_closest_safe, real_t &p_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) const;
+
+	void _intersect_ray_batch(uint32_t p_index, RayBatch *p_batch);
+	void _cast_motion_batch(uint32_t p_index, RayBatch *p_batch);
+	void _add_batch_candidates(RayBatch &r_batch, int p_amount);
+	void _process_batch(uint32_t p_count, void (PhysicsDirectSpaceState2DSW::*p_method)(uint32_t, RayBatch *), RayBatch *p_batch);
+
 public:
 	Space2DSW *space;
 
@@ -56,6 +94,8 @@ public:
 	virtual int intersect_shape(const RID &p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual bool cast_motion(const RID &p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin, real_t &p_closest_safe, real_t &p_closest_unsafe, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual bool collide_shape(RID p_shape, const Transform2D &p_shape_xform, const Vector2 &p_motion, real_t p_margin, Vector2 *r_results, int p_result_max, int &r_result_count, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
+	virtual int intersect_rays(const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
+	virtual int cast_motions(const RID &p_shape, const Transform2D *p_xforms, const Vector2 *p_motions, int p_count, real_t p_margin, real_t *r_closest_safe, real_t *r_closest_unsafe, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual bool rest_info(RID p_shape, const Transform2D &p_shape_xform, const Vector2 &p_motion, real_t p_margin, ShapeRestInfo *r_info, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 
 	PhysicsDirectSpaceState2DSW();
@@ -30,6 +30,8 @@
 
 #include "step_2d_sw.h"
 #include "core/os/os.h"
+#include "core/safe_refcount.h"
+#include "core/thread_work_pool.h"
 
 void Step2DSW::_populate_island(Body2DSW *p_body, Body2DSW **p_island, Constraint2DSW **p_constraint_island) {
 
@@ -57,43 +59,40 @@ void Step2DSW::_populate_island(Body2DSW *p_body, Body2DSW **p_island, Constrain
 	}
 }
 
-bool Step2DSW::_setup_island(Constraint2DSW *p_island, real_t p_delta) {
+void Step2DSW::_setup_island(uint32_t p_island_index, void *p_userdata) {
 
-	Constraint2DSW *ci = p_island;
-	Constraint2DSW *prev_ci = NULL;
-	bool removed_root = false;
-	while (ci) {
-		bool process = ci->setup(p_delta);
-
-		if (!process) {
-			//remove from island if process fails
-			if (prev_ci) {
-				prev_ci->set_island_next(ci->get_island_next());
-			} else {
-				removed_root = true;
-				prev_ci = ci;
-			}
-		} else {
-			prev_ci = ci;
-		}
-		ci = ci->get_island_next();
+	for (uint32_t i = island_offsets[p_island_index]; i < island_offsets[p_island_index + 1]; i++) {
+		setup_results[i] = all_constraints[i]->setup(delta);
 	}
-
-	return removed_root;
 }
 
-void Step2DSW::_solve_island(Constraint2DSW *p_island, int p_iterations, real_t p_delta) {
+void Step2DSW::_solve_island(uint32_t p_island_index, void *p_userdata) {
+
+	Constraint2DSW *island = constraint_islands[p_island_index];
 
-	for (int i = 0; i < p_iterations; i++) {
+	for (int i = 0; i < iterations; i++) {
 
-		Constraint2DSW *ci = p_island;
+		Constraint2DSW *ci = island;
 		while (ci) {
-			ci->solve(p_delta);
+			ci->solve(delta);
 			ci = ci->get_island_next();
 		}
 	}
 }
 
+void Step2DSW::_process_islands(uint32_t p_island_count, void (Step2DSW::*p_method)(uint32_t, void *)) {
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+
+	if (pool && p_island_count > 1) {
+		pool->do_work(p_island_count, this, p_method, (void *)NULL);
+	} else {
+		for (uint32_t i = 0; i < p_island_count; i++) {
+			(this->*p_method)(i, NULL);
+		}
+	}
+}
+
 void Step2DSW::_check_suspend(Body2DSW *p_island, real_t p_delta) {
 
 	bool can_sleep = true;
@@ -133,8 +132,14 @@ void Step2DSW::_check_suspend(Body2DSW *p_island, real_t p_delta) {
 
 void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
+	MemoryTagScope memory_tag(Memory::TAG_PHYSICS);
+
 	p_space->lock(); // can't access space during this
 
+	_step = atomic_increment(&step_counter);
+	iterations = p_iterations;
+	delta = p_delta;
+
 	p_space->setup(); //update inertias, etc
 
 	const SelfList<Body2DSW>::List *body_list = &p_space->get_active_body_list();
@@ -217,41 +222,56 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SETUP CONSTRAINT ISLANDS */
 
+	all_constraints.clear();
+	island_offsets.clear();
+
 	{
 		Constraint2DSW *ci = constraint_island_list;
-		Constraint2DSW *prev_ci = NULL;
 		while (ci) {
 
-			if (_setup_island(ci, p_delta)) {
+			island_offsets.push_back(all_constraints.size());
+			for (Constraint2DSW *c = ci; c; c = c->get_island_next()) {
+				all_constraints.push_back(c);
+			}
+			ci = ci->get_island_list_next();
+		}
+		island_offsets.push_back(all_constraints.size());
+	}
+
+	setup_results.resize(all_constraints.size());
+
+	_process_islands(island_offsets.size() - 1, &Step2DSW::_setup_island);
+
+	/* PRE-SOLVE CONSTRAINT ISLANDS */
+
+	//serial and in island order, and only what's left to solve is linked back
 
-				//removed the root from the island graph because it is not to be processed
+	constraint_islands.clear();
 
-				Constraint2DSW *next = ci->get_island_next();
+	for (uint32_t i = 0; i < island_offsets.size() - 1; i++) {
 
-				if (next) {
-					//root from list being deleted no longer exists, replace by next
-					next->set_island_list_next(ci->get_island_list_next());
-					if (prev_ci) {
-						prev_ci->set_island_list_next(next);
-					} else {
-						constraint_island_list = next;
-					}
-					prev_ci = next;
-				} else {
+		Constraint2DSW *first = NULL;
+		Constraint2DSW *last = NULL;
 
-					//list is empty, just skip
-					if (prev_ci) {
-						prev_ci->set_island_list_next(ci->get_island_list_next());
+		for (uint32_t j = island_offsets[i]; j < island_offsets[i + 1]; j++) {
+
+			//remove from island if process fails
+			Constraint2DSW *c = all_constraints[j];
+			if (!c->pre_solve(delta) || !setup_results[j]) {
+				continue;
+			}
 
-					} else {
-						constraint_island_list = ci->get_island_list_next();
-					}
-				}
+			if (last) {
+				last->set_island_next(c);
 			} else {
-				prev_ci = ci;
+				first = c;
 			}
+			last = c;
+		}
 
-			ci = ci->get_island_list_next();
+		if (last) {
+			last->set_island_next(NULL);
+			constraint_islands.push_back(first);
 		}
 	}
 
@@ -263,14 +283,8 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
-	{
-		Constraint2DSW *ci = constraint_island_list;
-		while (ci) {
-			//iterating each island separatedly improves cache efficiency
-			_solve_island(ci, p_iterations, p_delta);
-			ci = ci->get_island_list_next();
-		}
-	}
+	//iterating each island separatedly improves cache efficiency
+	_process_islands(constraint_islands.size(), &Step2DSW::_solve_island);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -307,10 +321,13 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	p_space->update();
 	p_space->unlock();
-	_step++;
 }
 
+uint64_t Step2DSW::step_counter = 0;
+
 Step2DSW::Step2DSW() {
 
-	_step = 1;
+	_step = 0;
+	iterations = 0;
+	delta = 0;
 }
@@ -33,14 +33,29 @@
 
 #include "space_2d_sw.h"
 
+#include "core/local_vector.h"
+
 class Step2DSW {
 
+	static uint64_t step_counter; //shared by all steppers, so marks left by another one never match
 	uint64_t _step;
 
+	int iterations;
+	real_t delta;
+
+	// Islands share no dynamic body, so they are set up and solved in
+	// parallel. The constraints of each island are always processed in the
+	// same order, keeping results independent of the thread count.
+	LocalVector<Constraint2DSW *> all_constraints; //island after island
+	LocalVector<uint32_t> island_offsets; //first constraint of each island, plus the end
+	LocalVector<uint8_t> setup_results;
+	LocalVector<Constraint2DSW *> constraint_islands; //constraints left to solve, per island
+
 	void _populate_island(Body2DSW *p_body, Body2DSW **p_island, Constraint2DSW **p_constraint_island);
-	bool _setup_island(Constraint2DSW *p_island, real_t p_delta);
-	void _solve_island(Constraint2DSW *p_island, int p_iterations, real_t p_delta);
+	void _setup_island(uint32_t p_island_index, void *p_userdata);
+	void _solve_island(uint32_t p_island_index, void *p_userdata);
 	void _check_suspend(Body2DSW *p_island, real_t p_delta);
+	void _process_islands(uint32_t p_island_count, void (Step2DSW::*p_method)(uint32_t, void *));
 
 public:
 	void step(Space2DSW *p_space, real_t p_delta, int p_iterations);
@@ -48,6 +48,8 @@
 #define RELAXATION_TIMESTEPS 3
 #define MIN_VELOCITY 0.0001
 #define MAX_BIAS_ROTATION (Math_PI / 8)
+#define MAX_CACHED_CONTACT_STEPS 4
+#define CCD_MAX_ITERATIONS 16
 
 void BodyPair3DSW::_contact_added_callback(const Vector3 &p_point_A, const Vector3 &p_point_B, void *p_userdata) {
 
@@ -80,24 +82,31 @@ void BodyPair3DSW::contact_added_callback(const Vector3 &p_point_A, const Vector
 	contact.normal = (p_point_A - p_point_B).normalized();
 	contact.mass_normal = 0; // will be computed in setup()
 
-	// attempt to determine if the contact will be reused
+	// attempt to determine if the contact will be reused, the closest match on both bodies wins
 	real_t contact_recycle_radius = space->get_contact_recycle_radius();
+	real_t best_distance = contact_recycle_radius * contact_recycle_radius;
 
 	for (int i = 0; i < contact_count; i++) {
 
 		Contact &c = contacts[i];
-		if (c.local_A.distance_squared_to(local_A) < (contact_recycle_radius * contact_recycle_radius) &&
-				c.local_B.distance_squared_to(local_B) < (contact_recycle_radius * contact_recycle_radius)) {
+		real_t distance = MAX(c.local_A.distance_squared_to(local_A), c.local_B.distance_squared_to(local_B));
+		if (distance < best_distance) {
 
-			contact.acc_normal_impulse = c.acc_normal_impulse;
-			contact.acc_bias_impulse = c.acc_bias_impulse;
-			contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
-			contact.acc_tangent_impulse = c.acc_tangent_impulse;
+			best_distance = distance;
 			new_index = i;
-			break;
 		}
 	}
 
+	if (new_index < contact_count) {
+
+		Contact &c = contacts[new_index];
+		contact.acc_normal_impulse = c.acc_normal_impulse;
+		contact.acc_bias_impulse = c.acc_bias_impulse;
+		contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		// keep warm starting friction along the new tangent plane only
+		contact.acc_tangent_impulse = c.acc_tangent_impulse - contact.normal * contact.normal.dot(c.acc_tangent_impulse);
+	}
+
 	// figure out if the contact amount must be reduced to fit the new contact
 
 	if (new_index == MAX_CONTACTS) {
@@ -169,6 +178,24 @@ void BodyPair3DSW::validate_contacts() {
 	}
 }
 
+bool BodyPair3DSW::_can_reuse_contacts(const Transform &p_relative_xform, const Shape3DSW *p_shape_B) const {
+
+	if (!collided || contact_count == 0 || cached_steps >= MAX_CACHED_CONTACT_STEPS) {
+		return false;
+	}
+
+	// how far any point of shape B moved relative to shape A since the contacts were generated
+	Transform motion = cached_relative_xform.affine_inverse() * p_relative_xform;
+
+	AABB aabb = p_shape_B->get_aabb();
+	real_t radius = MAX(aabb.position.abs().length(), (aabb.position + aabb.size).abs().length());
+
+	Vector3 rotation_error = (motion.basis.get_axis(0) - Vector3(1, 0, 0)).abs() + (motion.basis.get_axis(1) - Vector3(0, 1, 0)).abs() + (motion.basis.get_axis(2) - Vector3(0, 0, 1)).abs();
+	real_t displacement = motion.origin.length() + rotation_error.length() * radius;
+
+	return displacement < space->get_contact_recycle_radius();
+}
+
 bool BodyPair3DSW::_test_ccd(real_t p_step, Body3DSW *p_A, int p_shape_A, const Transform &p_xform_A, Body3DSW *p_B, int p_shape_B, const Transform &p_xform_B) {
 
 	Vector3 motion = p_A->get_linear_velocity() * p_step;
@@ -178,34 +205,63 @@ bool BodyPair3DSW::_test_ccd(real_t p_step, Body3DSW *p_A, int p_shape_A, const
 
 	Vector3 mnormal = motion / mlen;
 
+	Shape3DSW *shape_A_ptr = p_A->get_shape(p_shape_A);
+	Shape3DSW *shape_B_ptr = p_B->get_shape(p_shape_B);
+
 	real_t min, max;
-	p_A->get_shape(p_shape_A)->project_range(mnormal, p_xform_A, min, max);
+	shape_A_ptr->project_range(mnormal, p_xform_A, min, max);
 	bool fast_object = mlen > (max - min) * 0.3; //going too fast in that direction
 
-	if (!fast_object) { //did it move enough in this direction to even attempt raycast? let's say it should move more than 1/3 the size of the object in that axis
+	if (!fast_object) { //did it move enough in this direction to even attempt ccd? let's say it should move more than 1/3 the size of the object in that axis
 		return false;
 	}
 
-	//cast a segment from support in motion normal, in the same direction of motion by motion length
-	//support is the worst case collision point, so real collision happened before
-	Vector3 s = p_A->get_shape(p_shape_A)->get_support(p_xform_A.basis.xform(mnormal).normalized());
-	Vector3 from = p_xform_A.xform(s);
-	Vector3 to = from + motion;
+	//conservative advancement along the motion: the shapes can't collide before A travels the distance between them,
+	//so keep advancing by that distance divided by how fast A closes it until they touch
+	AABB sweep_aabb = p_xform_A.xform(shape_A_ptr->get_aabb());
+	sweep_aabb.merge_with(AABB(sweep_aabb.position + motion, sweep_aabb.size));
+
+	real_t tolerance = (max - min) * 0.01;
+	real_t toi = 0;
+	bool hit = true; //running out of iterations still leaves a conservative time of impact
+
+	for (int i = 0; i < CCD_MAX_ITERATIONS; i++) {
+
+		Transform xform_A = p_xform_A;
+		xform_A.origin += motion * toi;
+
+		Vector3 point_A, point_B;
+		if (!CollisionSolver3DSW::solve_distance(shape_A_ptr, xform_A, shape_B_ptr, p_xform_B, point_A, point_B, sweep_aabb)) {
+			//overlapping, fine if it already happens at the start, the regular contacts handle it
+			hit = i > 0;
+			break;
+		}
+
+		Vector3 separation = point_B - point_A;
+		real_t distance = separation.length();
+
+		//only a hit while closing in, sliding along a surface that is nearly touched must keep its velocity
+		real_t closing_speed = distance > CMP_EPSILON ? motion.dot(separation / distance) : 0;
+		if (closing_speed <= CMP_EPSILON) {
+			return false; //moving away or parallel, can't hit during this step
+		}
 
-	Transform from_inv = p_xform_B.affine_inverse();
+		if (distance < tolerance) {
+			break;
+		}
 
-	Vector3 local_from = from_inv.xform(from - mnormal * mlen * 0.1); //start from a little inside the bounding box
-	Vector3 local_to = from_inv.xform(to);
+		toi += distance / closing_speed;
+		if (toi >= 1.0) {
+			return false;
+		}
+	}
 
-	Vector3 rpos, rnorm;
-	if (!p_B->get_shape(p_shape_B)->intersect_segment(local_from, local_to, rpos, rnorm)) {
+	if (!hit) {
 		return false;
 	}
 
 	//shorten the linear velocity so it does not hit, but gets close enough, next frame will hit softly or soft enough
-	Vector3 hitpos = p_xform_B.xform(rpos);
-
-	real_t newlen = hitpos.distance_to(from) - (max - min) * 0.01;
+	real_t newlen = MAX(mlen * toi - tolerance, (real_t)0.0);
 	p_A->set_linear_velocity((mnormal * newlen) / p_step);
 
 	return true;
@@ -247,8 +303,16 @@ bool BodyPair3DSW::setup(real_t p_step) {
 	Shape3DSW *shape_A_ptr = A->get_shape(shape_A);
 	Shape3DSW *shape_B_ptr = B->get_shape(shape_B);
 
-	bool collided = CollisionSolver3DSW::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
-	this->collided = collided;
+	// pairs that barely moved since the last narrowphase keep their validated contacts,
+	// this is limited to a few steps so resting contacts still pick up new points
+	Transform relative_xform = xform_A.affine_inverse() * xform_B;
+	if (_can_reuse_contacts(relative_xform, shape_B_ptr)) {
+		cached_steps++;
+	} else {
+		collided = CollisionSolver3DSW::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+		cached_relative_xform = relative_xform;
+		cached_steps = 0;
+	}
 
 	if (!collided) {
 
@@ -297,32 +361,11 @@ bool BodyPair3DSW::setup(real_t p_step) {
 		}
 
 		c.active = true;
-
-#ifdef DEBUG_ENABLED
-
-		if (space->is_debugging_contacts()) {
-			space->add_debug_contact(global_A + offset_A);
-			space->add_debug_contact(global_B + offset_A);
-		}
-#endif
+		c.depth = depth;
 
 		c.rA = global_A - A->get_center_of_mass();
 		c.rB = global_B - B->get_center_of_mass() - offset_B;
 
-		// contact query reporting...
-
-		if (A->can_report_contacts()) {
-			Vector3 crA = A->get_angular_velocity().cross(c.rA) + A->get_linear_velocity();
-			A->add_contact(global_A, -c.normal, depth, shape_A, global_B, shape_B, B->get_instance_id(), B->get_self(), crA);
-		}
-
-		if (B->can_report_contacts()) {
-			Vector3 crB = B->get_angular_velocity().cross(c.rB) + B->get_linear_velocity();
-			B->add_contact(global_B, c.normal, depth, shape_B, global_A, shape_A, A->get_instance_id(), A->get_self(), crB);
-		}
-
-		c.active = true;
-
 		// Precompute normal mass, tangent mass, and bias.
 		Vector3 inertia_A = A->get_inv_inertia_tensor().xform(c.rA.cross(c.normal));
 		Vector3 inertia_B = B->get_inv_inertia_tensor().xform(c.rB.cross(c.normal));
@@ -353,6 +396,57 @@ bool BodyPair3DSW::setup(real_t p_step) {
 	return true;
 }
 
+bool BodyPair3DSW::pre_solve(real_t p_step) {
+
+	if (!collided) {
+		return false;
+	}
+
+	// contact query reporting and debug contacts, bodies reporting contacts may be shared with other islands
+
+	bool report_A = A->can_report_contacts();
+	bool report_B = B->can_report_contacts();
+#ifdef DEBUG_ENABLED
+	bool debug_contacts = space->is_debugging_contacts();
+#else
+	bool debug_contacts = false;
+#endif
+
+	if (!report_A && !report_B && !debug_contacts) {
+		return true;
+	}
+
+	Vector3 offset_A = A->get_transform().get_origin();
+
+	for (int i = 0; i < contact_count; i++) {
+
+		Contact &c = contacts[i];
+		if (!c.active) {
+			continue;
+		}
+
+		Vector3 global_A = c.rA + A->get_center_of_mass();
+		Vector3 global_B = c.rB + B->get_center_of_mass() + offset_B;
+
+		if (debug_contacts) {
+			space->add_debug_contact(global_A + offset_A);
+			space->add_debug_contact(global_B + offset_A);
+		}
+
+		if (report_A) {
+			Vector3 crA = A->get_angular_velocity().cross(c.rA) + A->get_linear_velocity();
+			A->add_contact(global_A, -c.normal, c.depth, shape_A, global_B, shape_B, B->get_instance_id(), B->get_self(), crA);
+		}
+
+		if (report_B) {
+			Vector3 crB = B->get_angular_velocity().cross(c.rB) + B->get_linear_velocity();
+			B->add_contact(global_B, c.normal, c.depth, shape_B, global_A, shape_A, A->get_instance_id(), A->get_self(), crB);
+		}
+	}
+
+	return true;
+}
+
 void BodyPair3DSW::solve(real_t p_step) {
 
 	if (!collided)
@@ -486,6 +580,7 @@ BodyPair3DSW::BodyPair3DSW(Body3DSW *p_A, int p_shape_A, Body3DSW *p_B, int p_sh
 	B->add_constraint(this, 1);
 	contact_count = 0;
 	collided = false;
+	cached_steps = 0;
 }
 
 BodyPair3DSW::~BodyPair3DSW() {
@@ -77,17 +77,22 @@ class BodyPair3DSW : public Constraint3DSW {
 	int contact_count;
 	bool collided;
 
+	Transform cached_relative_xform; // shape B relative to shape A when the contacts were last generated
+	int cached_steps; // steps the contacts were reused without running the narrowphase
+
 	static void _contact_added_callback(const Vector3 &p_point_A, const Vector3 &p_point_B, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, const Vector3 &p_point_B);
 
 	void validate_contacts();
+	bool _can_reuse_contacts(const Transform &p_relative_xform, const Shape3DSW *p_shape_B) const;
 	bool _test_ccd(real_t p_step, Body3DSW *p_A, int p_shape_A, const Transform &p_xform_A, Body3DSW *p_B, int p_shape_B, const Transform &p_xform_B);
 
 	Space3DSW *space;
 
 public:
 	bool setup(real_t p_step);
+	bool pre_solve(real_t p_step);
 	void solve(real_t p_step);
 
 	BodyPair3DSW(Body3DSW *p_A, int p_shape_A, Body3DSW *p_B, int p_shape_B);
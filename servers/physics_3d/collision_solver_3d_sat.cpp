@@ -873,16 +873,20 @@ static void _collision_box_convex_polygon(const Shape3DSW *p_a, const Transform
 			return;
 	}
 
-	// A<->B edges
+	// A<->B edges, transform the edges of B only once
+	Vector3 *edge_dirs = (Vector3 *)alloca(sizeof(Vector3) * edge_count);
+	for (int j = 0; j < edge_count; j++) {
+
+		edge_dirs[j] = p_transform_b.basis.xform(vertices[edges[j].a] - vertices[edges[j].b]);
+	}
+
 	for (int i = 0; i < 3; i++) {
 
 		Vector3 e1 = p_transform_a.basis.get_axis(i);
 
 		for (int j = 0; j < edge_count; j++) {
 
-			Vector3 e2 = p_transform_b.basis.xform(vertices[edges[j].a]) - p_transform_b.basis.xform(vertices[edges[j].b]);
-
-			Vector3 axis = e1.cross(e2).normalized();
+			Vector3 axis = e1.cross(edge_dirs[j]).normalized();
 
 			if (!separator.test_axis(axis))
 				return;
@@ -1296,16 +1300,20 @@ static void _collision_convex_polygon_convex_polygon(const Shape3DSW *p_a, const
 			return;
 	}
 
-	// A<->B edges
+	// A<->B edges, transform the edges of B only once
+	Vector3 *edge_dirs_B = (Vector3 *)alloca(sizeof(Vector3) * edge_count_B);
+	for (int j = 0; j < edge_count_B; j++) {
+
+		edge_dirs_B[j] = p_transform_b.basis.xform(vertices_B[edges_B[j].a] - vertices_B[edges_B[j].b]);
+	}
+
 	for (int i = 0; i < edge_count_A; i++) {
 
-		Vector3 e1 = p_transform_a.basis.xform(vertices_A[edges_A[i].a]) - p_transform_a.basis.xform(vertices_A[edges_A[i].b]);
+		Vector3 e1 = p_transform_a.basis.xform(vertices_A[edges_A[i].a] - vertices_A[edges_A[i].b]);
 
 		for (int j = 0; j < edge_count_B; j++) {
 
-			Vector3 e2 = p_transform_b.basis.xform(vertices_B[edges_B[j].a]) - p_transform_b.basis.xform(vertices_B[edges_B[j].b]);
-
-			Vector3 axis = e1.cross(e2).normalized();
+			Vector3 axis = e1.cross(edge_dirs_B[j]).normalized();
 
 			if (!separator.test_axis(axis))
 				return;
@@ -76,7 +76,13 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	// setup() runs in parallel with the setup of other islands, so it must
+	// only modify this constraint and the bodies of its own island. Anything
+	// touching shared state (areas, contact reports, the space) goes in
+	// pre_solve(), which runs serially afterwards in island order. The
+	// constraint is solved only if both return true.
 	virtual bool setup(real_t p_step) = 0;
+	virtual bool pre_solve(real_t p_step) { return true; }
 	virtual void solve(real_t p_step) = 0;
 
 	virtual ~Constraint3DSW() {}
@@ -31,9 +31,12 @@
 #include "physics_server_3d_sw.h"
 
 #include "broad_phase_3d_basic.h"
+#include "broad_phase_bvh.h"
 #include "broad_phase_octree.h"
 #include "core/debugger/engine_debugger.h"
 #include "core/os/os.h"
+#include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 #include "joints/cone_twist_joint_3d_sw.h"
 #include "joints/generic_6dof_joint_3d_sw.h"
 #include "joints/hinge_joint_3d_sw.h"
@@ -1411,10 +1414,14 @@ void PhysicsServer3DSW::init() {
 	doing_sync = true;
 	last_step = 0.001;
 	iterations = 8; // 8?
-	stepper = memnew(Step3DSW);
 	direct_state = memnew(PhysicsDirectBodyState3DSW);
 };
 
+void PhysicsServer3DSW::_step_space(uint32_t p_index, void *p_userdata) {
+
+	steppers[p_index]->step(stepping_spaces[p_index], last_step, iterations);
+}
+
 void PhysicsServer3DSW::step(real_t p_step) {
 
 #ifndef _3D_DISABLED
@@ -1432,12 +1439,28 @@ void PhysicsServer3DSW::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+
+	stepping_spaces.clear();
 	for (Set<const Space3DSW *>::Element *E = active_spaces.front(); E; E = E->next()) {
+		stepping_spaces.push_back((Space3DSW *)E->get());
+	}
+	while (steppers.size() < stepping_spaces.size()) {
+		steppers.push_back(memnew(Step3DSW));
+	}
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	if (pool && pool->get_thread_count() > 0 && stepping_spaces.size() > 1) {
+		pool->do_work(stepping_spaces.size(), this, &PhysicsServer3DSW::_step_space, (void *)NULL);
+	} else {
+		for (uint32_t i = 0; i < stepping_spaces.size(); i++) {
+			_step_space(i, NULL);
+		}
+	}
 
-		stepper->step((Space3DSW *)E->get(), p_step, iterations);
-		island_count += E->get()->get_island_count();
-		active_objects += E->get()->get_active_objects();
-		collision_pairs += E->get()->get_collision_pairs();
+	for (uint32_t i = 0; i < stepping_spaces.size(); i++) {
+		island_count += stepping_spaces[i]->get_island_count();
+		active_objects += stepping_spaces[i]->get_active_objects();
+		collision_pairs += stepping_spaces[i]->get_collision_pairs();
 	}
 #endif
 }
@@ -1506,7 +1529,10 @@ void PhysicsServer3DSW::flush_queries() {
 
 void PhysicsServer3DSW::finish() {
 
-	memdelete(stepper);
+	for (uint32_t i = 0; i < steppers.size(); i++) {
+		memdelete(steppers[i]);
+	}
+	steppers.clear();
 	memdelete(direct_state);
 };
 
@@ -1575,7 +1601,17 @@ void PhysicsServer3DSW::_shape_col_cbk(const Vector3 &p_point_A, const Vector3 &
 PhysicsServer3DSW *PhysicsServer3DSW::singleton = NULL;
 PhysicsServer3DSW::PhysicsServer3DSW() {
 	singleton = this;
-	BroadPhase3DSW::create_func = BroadPhaseOctree::_create;
+
+	bool use_bvh = GLOBAL_DEF("physics/3d/godot_physics/use_bvh", true);
+	GLOBAL_DEF("physics/3d/godot_physics/bvh_collision_margin", 0.1);
+	ProjectSettings::get_singleton()->set_custom_property_info("physics/3d/godot_physics/bvh_collision_margin", PropertyInfo(Variant::FLOAT, "physics/3d/godot_physics/bvh_collision_margin", PROPERTY_HINT_RANGE, "0,1,0.01,or_greater"));
+
+	if (use_bvh) {
+		BroadPhase3DSW::create_func = BroadPhaseBVH::_create;
+	} else {
+		BroadPhase3DSW::create_func = BroadPhaseOctree::_create;
+	}
+
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
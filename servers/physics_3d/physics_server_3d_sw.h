@@ -31,6 +31,7 @@
 #ifndef PHYSICS_SERVER_SW
 #define PHYSICS_SERVER_SW
 
+#include "core/local_vector.h"
 #include "core/rid_owner.h"
 #include "joints_3d_sw.h"
 #include "servers/physics_server_3d.h"
@@ -54,9 +55,14 @@ class PhysicsServer3DSW : public PhysicsServer3D {
 
 	bool flushing_queries;
 
-	Step3DSW *stepper;
+	// Spaces share no bodies, so they are stepped in parallel, each one
+	// with its own stepper.
+	LocalVector<Step3DSW *> steppers;
+	LocalVector<Space3DSW *> stepping_spaces;
 	Set<const Space3DSW *> active_spaces;
 
+	void _step_space(uint32_t p_index, void *p_userdata);
+
 	PhysicsDirectBodyState3DSW *direct_state;
 
 	mutable RID_PtrOwner<Shape3DSW> shape_owner;
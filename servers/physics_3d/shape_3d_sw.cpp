@@ -34,6 +34,13 @@
 #include "core/math/quick_hull.h"
 #include "core/sort_array.h"
 
+#if defined(PHYSICS_SIMD_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define PHYSICS_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(PHYSICS_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
 #define _POINT_SNAP 0.001953125
 #define _EDGE_IS_VALID_SUPPORT_THRESHOLD 0.0002
 #define _FACE_IS_VALID_SUPPORT_THRESHOLD 0.9998
@@ -713,47 +720,25 @@ CapsuleShape3DSW::CapsuleShape3DSW() {
 
 void ConvexPolygonShape3DSW::project_range(const Vector3 &p_normal, const Transform &p_transform, real_t &r_min, real_t &r_max) const {
 
-	int vertex_count = mesh.vertices.size();
-	if (vertex_count == 0)
+	if (simd_vertices.size() == 0)
 		return;
 
-	const Vector3 *vrts = &mesh.vertices[0];
-
-	for (int i = 0; i < vertex_count; i++) {
-
-		real_t d = p_normal.dot(p_transform.xform(vrts[i]));
+	//project in local space, the transform only adds an offset
+	Vector3 local_normal = p_transform.basis.xform_inv(p_normal);
+	real_t distance = p_normal.dot(p_transform.origin);
 
-		if (i == 0 || d > r_max)
-			r_max = d;
-		if (i == 0 || d < r_min)
-			r_min = d;
-	}
+	simd_vertices.project_range(local_normal, r_min, r_max);
+	r_min += distance;
+	r_max += distance;
 }
 
 Vector3 ConvexPolygonShape3DSW::get_support(const Vector3 &p_normal) const {
 
-	Vector3 n = p_normal;
-
-	int vert_support_idx = -1;
-	real_t support_max = 0;
-
-	int vertex_count = mesh.vertices.size();
-	if (vertex_count == 0)
+	int vert_support_idx = simd_vertices.get_support_index(p_normal);
+	if (vert_support_idx == -1)
 		return Vector3();
 
-	const Vector3 *vrts = &mesh.vertices[0];
-
-	for (int i = 0; i < vertex_count; i++) {
-
-		real_t d = n.dot(vrts[i]);
-
-		if (i == 0 || d > support_max) {
-			support_max = d;
-			vert_support_idx = i;
-		}
-	}
-
-	return vrts[vert_support_idx];
+	return mesh.vertices[vert_support_idx];
 }
 
 void ConvexPolygonShape3DSW::get_supports(const Vector3 &p_normal, int p_max, Vector3 *r_supports, int &r_amount) const {
@@ -765,20 +750,12 @@ void ConvexPolygonShape3DSW::get_supports(const Vector3 &p_normal, int p_max, Ve
 	int ec = mesh.edges.size();
 
 	const Vector3 *vertices = mesh.vertices.ptr();
-	int vc = mesh.vertices.size();
 
 	//find vertex first
-	real_t max = 0;
-	int vtx = 0;
-
-	for (int i = 0; i < vc; i++) {
-
-		real_t d = p_normal.dot(vertices[i]);
-
-		if (i == 0 || d > max) {
-			max = d;
-			vtx = i;
-		}
+	int vtx = simd_vertices.get_support_index(p_normal);
+	if (vtx == -1) {
+		r_amount = 0;
+		return;
 	}
 
 	for (int i = 0; i < fc; i++) {
@@ -958,6 +935,8 @@ void ConvexPolygonShape3DSW::_setup(const Vector<Vector3> &p_vertices) {
 	if (err != OK)
 		ERR_PRINT("Failed to build QuickHull");
 
+	simd_vertices.set_vertices(mesh.vertices.ptr(), mesh.vertices.size());
+
 	AABB _aabb;
 
 	for (int i = 0; i < mesh.vertices.size(); i++) {
@@ -1106,6 +1085,93 @@ FaceShape3DSW::FaceShape3DSW() {
 	configure(AABB());
 }
 
+/* CONCAVE POLYGON SHAPE */
+
+static_assert(sizeof(ConcavePolygonShape3DSW::BVH) == 16, "Quantized BVH nodes must be 16 bytes.");
+
+// Query bounds laid out like a node (min xyz, max xyz, data), so a node is tested with
+// one saturated subtraction per side: node.min - query.max and query.min - node.max
+// are zero in every lane only when the boxes overlap. Unused lanes never saturate.
+struct _QuantizedQuery {
+
+	alignas(16) uint16_t max[8];
+	alignas(16) uint16_t min[8];
+};
+
+static _FORCE_INLINE_ uint16_t _quantize_bound(real_t p_value) {
+
+	return (uint16_t)CLAMP(p_value, (real_t)0.0, (real_t)65535.0);
+}
+
+static _FORCE_INLINE_ void _make_quantized_query(const uint16_t *p_min, const uint16_t *p_max, _QuantizedQuery &r_query) {
+
+	for (int i = 0; i < 8; i++) {
+		r_query.max[i] = 0xFFFF;
+		r_query.min[i] = 0;
+	}
+	for (int i = 0; i < 3; i++) {
+		r_query.max[i] = p_max[i];
+		r_query.min[i + 3] = p_min[i];
+	}
+}
+
+static _FORCE_INLINE_ bool _quantized_overlap(const ConcavePolygonShape3DSW::BVH &p_node, const _QuantizedQuery &p_query) {
+
+#if defined(PHYSICS_SIMD_SSE2)
+	__m128i node = _mm_loadu_si128((const __m128i *)&p_node);
+	__m128i over = _mm_or_si128(_mm_subs_epu16(node, _mm_load_si128((const __m128i *)p_query.max)), _mm_subs_epu16(_mm_load_si128((const __m128i *)p_query.min), node));
+	return _mm_movemask_epi8(_mm_cmpeq_epi16(over, _mm_setzero_si128())) == 0xFFFF;
+#elif defined(PHYSICS_SIMD_NEON)
+	uint16x8_t node = vld1q_u16((const uint16_t *)&p_node);
+	uint16x8_t over = vorrq_u16(vqsubq_u16(node, vld1q_u16(p_query.max)), vqsubq_u16(vld1q_u16(p_query.min), node));
+	uint64x2_t over64 = vreinterpretq_u64_u16(over);
+	return (vgetq_lane_u64(over64, 0) | vgetq_lane_u64(over64, 1)) == 0;
+#else
+	return p_node.min[0] <= p_query.max[0] && p_node.min[1] <= p_query.max[1] && p_node.min[2] <= p_query.max[2] &&
+		   p_node.max[0] >= p_query.min[3] && p_node.max[1] >= p_query.min[4] && p_node.max[2] >= p_query.min[5];
+#endif
+}
+
+static _FORCE_INLINE_ Vector3 _get_inv_motion(const Vector3 &p_motion) {
+
+	Vector3 inv;
+	for (int i = 0; i < 3; i++) {
+		inv[i] = p_motion[i] != 0 ? 1.0 / p_motion[i] : 0.0;
+	}
+	return inv;
+}
+
+// slab test of the segment p_from + p_motion * t, t in [0, p_t_max], against a box
+static _FORCE_INLINE_ bool _segment_intersects_box(const Vector3 &p_from, const Vector3 &p_motion, const Vector3 &p_inv_motion, const Vector3 &p_min, const Vector3 &p_max, real_t p_t_max) {
+
+	real_t t_min = 0;
+	real_t t_max = p_t_max;
+
+	for (int i = 0; i < 3; i++) {
+
+		if (p_motion[i] == 0) {
+			if (p_from[i] < p_min[i] || p_from[i] > p_max[i]) {
+				return false;
+			}
+			continue;
+		}
+
+		real_t t0 = (p_min[i] - p_from[i]) * p_inv_motion[i];
+		real_t t1 = (p_max[i] - p_from[i]) * p_inv_motion[i];
+		if (t0 > t1) {
+			SWAP(t0, t1);
+		}
+
+		t_min = MAX(t_min, t0);
+		t_max = MIN(t_max, t1);
+		if (t_min > t_max) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 Vector<Vector3> ConcavePolygonShape3DSW::get_faces() const {
 
 	Vector<Vector3> rfaces;
@@ -1171,28 +1237,67 @@ Vector3 ConcavePolygonShape3DSW::get_support(const Vector3 &p_normal) const {
 	return vptr[vert_support_idx];
 }
 
-void ConcavePolygonShape3DSW::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
-
-	const BVH *bvh = &p_params->bvh[p_idx];
+void ConcavePolygonShape3DSW::_quantize_aabb(const AABB &p_aabb, BVH &r_node) const {
 
-	/*
-	if (p_params->dir.dot(bvh->aabb.get_support(-p_params->dir))>p_params->min_d)
-		return; //test against whole AABB, which isn't very costly
-	*/
+	Vector3 from = (p_aabb.position - bvh_origin) * bvh_scale;
+	Vector3 to = (p_aabb.position + p_aabb.size - bvh_origin) * bvh_scale;
 
-	//printf("addr: %p\n",bvh);
-	if (!bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
+	for (int i = 0; i < 3; i++) {
 
-		return;
+		r_node.min[i] = _quantize_bound(Math::floor(from[i]));
+		r_node.max[i] = _quantize_bound(Math::ceil(to[i]));
 	}
+}
+
+void ConcavePolygonShape3DSW::_cull_segment(_SegmentCullParams *p_params) const {
+
+	AABB segment_aabb(p_params->from, Vector3());
+	segment_aabb.expand_to(p_params->to);
+
+	BVH segment_node;
+	_quantize_aabb(segment_aabb, segment_node);
+	_QuantizedQuery query;
+	_make_quantized_query(segment_node.min, segment_node.max, query);
+
+	//the slab test runs in quantized space, against nodes grown by one unit to absorb rounding
+	Vector3 from = (p_params->from - bvh_origin) * bvh_scale;
+	Vector3 motion = (p_params->to - p_params->from) * bvh_scale;
+	Vector3 inv_motion = _get_inv_motion(motion);
+	real_t length = p_params->from.distance_to(p_params->to);
+
+	int idx = 0;
+	while (idx < p_params->bvh_count) {
+
+		const BVH &node = p_params->bvh[idx];
+
+		bool hit = _quantized_overlap(node, query);
+		if (hit) {
+
+			real_t t_max = length > 0 ? MIN(1.0, p_params->min_d / length) : 1.0;
+			Vector3 node_min(node.min[0] - 1.0, node.min[1] - 1.0, node.min[2] - 1.0);
+			Vector3 node_max(node.max[0] + 1.0, node.max[1] + 1.0, node.max[2] + 1.0);
+			hit = _segment_intersects_box(from, motion, inv_motion, node_min, node_max, t_max);
+		}
+
+		if (node.data < 0) {
+			//branch, skip the whole subtree on a miss
+			idx = hit ? idx + 1 : ~node.data;
+			continue;
+		}
 
-	if (bvh->face_index >= 0) {
+		idx++;
+
+		if (!hit) {
+			continue;
+		}
+
+		const Face &f = p_params->faces[node.data];
 
 		Vector3 res;
 		Vector3 vertices[3] = {
-			p_params->vertices[p_params->faces[bvh->face_index].indices[0]],
-			p_params->vertices[p_params->faces[bvh->face_index].indices[1]],
-			p_params->vertices[p_params->faces[bvh->face_index].indices[2]]
+			p_params->vertices[f.indices[0]],
+			p_params->vertices[f.indices[1]],
+			p_params->vertices[f.indices[2]]
 		};
 
 		if (Geometry::segment_intersects_triangle(
@@ -1213,13 +1318,6 @@ void ConcavePolygonShape3DSW::_cull_segment(int p_idx, _SegmentCullParams *p_par
 				p_params->collisions++;
 			}
 		}
-
-	} else {
-
-		if (bvh->left >= 0)
-			_cull_segment(bvh->left, p_params);
-		if (bvh->right >= 0)
-			_cull_segment(bvh->right, p_params);
 	}
 }
 
@@ -1242,10 +1340,11 @@ bool ConcavePolygonShape3DSW::intersect_segment(const Vector3 &p_begin, const Ve
 	params.faces = fr;
 	params.vertices = vr;
 	params.bvh = br;
+	params.bvh_count = bvh.size();
 
 	params.min_d = 1e20;
 	// cull
-	_cull_segment(0, &params);
+	_cull_segment(&params);
 
 	if (params.collisions > 0) {
 
@@ -1268,34 +1367,38 @@ Vector3 ConcavePolygonShape3DSW::get_closest_point_to(const Vector3 &p_point) co
 	return Vector3();
 }
 
-void ConcavePolygonShape3DSW::_cull(int p_idx, _CullParams *p_params) const {
+void ConcavePolygonShape3DSW::_cull(_CullParams *p_params) const {
 
-	const BVH *bvh = &p_params->bvh[p_idx];
+	BVH aabb_node;
+	_quantize_aabb(p_params->aabb, aabb_node);
+	_QuantizedQuery query;
+	_make_quantized_query(aabb_node.min, aabb_node.max, query);
 
-	if (!p_params->aabb.intersects(bvh->aabb))
-		return;
+	int idx = 0;
+	while (idx < p_params->bvh_count) {
+
+		const BVH &node = p_params->bvh[idx];
+		bool hit = _quantized_overlap(node, query);
+
+		if (node.data < 0) {
+			//branch, skip the whole subtree on a miss
+			idx = hit ? idx + 1 : ~node.data;
+			continue;
+		}
+
+		idx++;
 
-	if (bvh->face_index >= 0) {
+		if (!hit) {
+			continue;
+		}
 
-		const Face *f = &p_params->faces[bvh->face_index];
+		const Face *f = &p_params->faces[node.data];
 		FaceShape3DSW *face = p_params->face;
 		face->normal = f->normal;
 		face->vertex[0] = p_params->vertices[f->indices[0]];
 		face->vertex[1] = p_params->vertices[f->indices[1]];
 		face->vertex[2] = p_params->vertices[f->indices[2]];
 		p_params->callback(p_params->userdata, face);
-
-	} else {
-
-		if (bvh->left >= 0) {
-
-			_cull(bvh->left, p_params);
-		}
-
-		if (bvh->right >= 0) {
-
-			_cull(bvh->right, p_params);
-		}
 	}
 }
 
@@ -1307,6 +1410,10 @@ void ConcavePolygonShape3DSW::cull(const AABB &p_local_aabb, Callback p_callback
 
 	AABB local_aabb = p_local_aabb;
 
+	//quantized bounds are clamped to the shape, so reject anything outside of it first
+	if (!local_aabb.intersects(get_aabb()))
+		return;
+
 	// unlock data
 	const Face *fr = faces.ptr();
 	const Vector3 *vr = vertices.ptr();
@@ -1320,11 +1427,12 @@ void ConcavePolygonShape3DSW::cull(const AABB &p_local_aabb, Callback p_callback
 	params.faces = fr;
 	params.vertices = vr;
 	params.bvh = br;
+	params.bvh_count = bvh.size();
 	params.callback = p_callback;
 	params.userdata = p_userdata;
 
 	// cull
-	_cull(0, &params);
+	_cull(&params);
 }
 
 Vector3 ConcavePolygonShape3DSW::get_moment_of_inertia(real_t p_mass) const {
@@ -1435,28 +1543,19 @@ _VolumeSW_BVH *_volume_sw_build_bvh(_VolumeSW_BVH_Element *p_elements, int p_siz
 
 void ConcavePolygonShape3DSW::_fill_bvh(_VolumeSW_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
 
-	int idx = p_idx;
+	int idx = p_idx++;
 
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
+	_quantize_aabb(p_bvh_tree->aabb, p_bvh_array[idx]);
 
 	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
+		//depth first, so the left child is the next node and the node after the subtree is the escape
 		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
-
-	} else {
-
-		p_bvh_array[p_idx].left = -1;
-	}
-
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
 		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
+		p_bvh_array[idx].data = ~p_idx;
 
 	} else {
 
-		p_bvh_array[p_idx].right = -1;
+		p_bvh_array[idx].data = p_bvh_tree->face_index;
 	}
 
 	memdelete(p_bvh_tree);
@@ -1464,6 +1563,10 @@ void ConcavePolygonShape3DSW::_fill_bvh(_VolumeSW_BVH *p_bvh_tree, BVH *p_bvh_ar
 
 void ConcavePolygonShape3DSW::_setup(Vector<Vector3> p_faces) {
 
+	faces.clear();
+	vertices.clear();
+	bvh.clear();
+
 	int src_face_count = p_faces.size();
 	if (src_face_count == 0) {
 		configure(AABB());
@@ -1511,7 +1614,12 @@ void ConcavePolygonShape3DSW::_setup(Vector<Vector3> p_faces) {
 	int count = 0;
 	_VolumeSW_BVH *bvh_tree = _volume_sw_build_bvh(bvh_arrayw, src_face_count, count);
 
-	bvh.resize(count + 1);
+	bvh_origin = _aabb.position;
+	for (int i = 0; i < 3; i++) {
+		bvh_scale[i] = _aabb.size[i] > CMP_EPSILON ? 65535.0 / _aabb.size[i] : 0.0;
+	}
+
+	bvh.resize(count);
 
 	BVH *bvh_arrayw2 = bvh.ptrw();
 
@@ -1565,8 +1673,115 @@ Vector3 HeightMapShape3DSW::get_support(const Vector3 &p_normal) const {
 	return get_aabb().get_support(p_normal);
 }
 
+Vector3 HeightMapShape3DSW::_get_vertex(int p_x, int p_z) const {
+
+	return Vector3(p_x * cell_size, heights[p_z * width + p_x], p_z * cell_size);
+}
+
+void HeightMapShape3DSW::_get_cell_triangles(int p_x, int p_z, Vector3 r_triangles[2][3]) const {
+
+	Vector3 v00 = _get_vertex(p_x, p_z);
+	Vector3 v10 = _get_vertex(p_x + 1, p_z);
+	Vector3 v01 = _get_vertex(p_x, p_z + 1);
+	Vector3 v11 = _get_vertex(p_x + 1, p_z + 1);
+
+	//both wound so the normal faces up
+	r_triangles[0][0] = v00;
+	r_triangles[0][1] = v10;
+	r_triangles[0][2] = v01;
+	r_triangles[1][0] = v10;
+	r_triangles[1][1] = v11;
+	r_triangles[1][2] = v01;
+}
+
+void HeightMapShape3DSW::_cull_segment(int p_level, int p_x, int p_z, _SegmentCullParams *p_params) const {
+
+	const MipLevel &level = mip_levels[p_level];
+	const MinMax &mm = mip_data[level.offset + p_z * level.width + p_x];
+
+	int cells_w = mip_levels[0].width;
+	int cells_d = mip_levels[0].depth;
+
+	Vector3 block_min((p_x << p_level) * cell_size, mm.min, (p_z << p_level) * cell_size);
+	Vector3 block_max(MIN((p_x + 1) << p_level, cells_w) * cell_size, mm.max, MIN((p_z + 1) << p_level, cells_d) * cell_size);
+
+	real_t t_max = p_params->length > 0 ? MIN(1.0, p_params->min_d / p_params->length) : 1.0;
+	if (!_segment_intersects_box(p_params->from, p_params->motion, p_params->inv_motion, block_min, block_max, t_max)) {
+		return;
+	}
+
+	if (p_level == 0) {
+
+		Vector3 triangles[2][3];
+		_get_cell_triangles(p_x, p_z, triangles);
+
+		for (int i = 0; i < 2; i++) {
+
+			Vector3 res;
+			if (!Geometry::segment_intersects_triangle(p_params->from, p_params->to, triangles[i][0], triangles[i][1], triangles[i][2], &res)) {
+				continue;
+			}
+
+			real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
+			if (d > 0 && d < p_params->min_d) {
+
+				p_params->min_d = d;
+				p_params->result = res;
+				p_params->normal = Plane(triangles[i][0], triangles[i][1], triangles[i][2]).normal;
+				p_params->collisions++;
+			}
+		}
+		return;
+	}
+
+	//visit the children closer to the segment start first, so later ones are clipped by the hit
+	const MipLevel &child_level = mip_levels[p_level - 1];
+	int first_x = p_params->motion.x < 0 ? 1 : 0;
+	int first_z = p_params->motion.z < 0 ? 1 : 0;
+
+	for (int i = 0; i < 2; i++) {
+
+		int z = p_z * 2 + (i ^ first_z);
+		if (z >= child_level.depth) {
+			continue;
+		}
+
+		for (int j = 0; j < 2; j++) {
+
+			int x = p_x * 2 + (j ^ first_x);
+			if (x >= child_level.width) {
+				continue;
+			}
+
+			_cull_segment(p_level - 1, x, z, p_params);
+		}
+	}
+}
+
 bool HeightMapShape3DSW::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
 
+	if (mip_levels.size() == 0)
+		return false;
+
+	_SegmentCullParams params;
+	params.from = p_begin;
+	params.to = p_end;
+	params.dir = (p_end - p_begin).normalized();
+	params.motion = p_end - p_begin;
+	params.inv_motion = _get_inv_motion(params.motion);
+	params.length = params.motion.length();
+	params.min_d = 1e20;
+	params.collisions = 0;
+
+	_cull_segment(mip_levels.size() - 1, 0, 0, &params);
+
+	if (params.collisions > 0) {
+
+		r_point = params.result;
+		r_normal = params.normal;
+		return true;
+	}
+
 	return false;
 }
 
@@ -1579,7 +1794,82 @@ Vector3 HeightMapShape3DSW::get_closest_point_to(const Vector3 &p_point) const {
 	return Vector3();
 }
 
+void HeightMapShape3DSW::_cull(int p_level, int p_x, int p_z, _CullParams *p_params) const {
+
+	const MipLevel &level = mip_levels[p_level];
+	const MinMax &mm = mip_data[level.offset + p_z * level.width + p_x];
+
+	if (mm.max < p_params->min_y || mm.min > p_params->max_y) {
+		return;
+	}
+
+	if (p_level == 0) {
+
+		Vector3 triangles[2][3];
+		_get_cell_triangles(p_x, p_z, triangles);
+
+		FaceShape3DSW *face = p_params->face;
+		for (int i = 0; i < 2; i++) {
+
+			face->vertex[0] = triangles[i][0];
+			face->vertex[1] = triangles[i][1];
+			face->vertex[2] = triangles[i][2];
+			face->normal = Plane(triangles[i][0], triangles[i][1], triangles[i][2]).normal;
+			p_params->callback(p_params->userdata, face);
+		}
+		return;
+	}
+
+	const MipLevel &child_level = mip_levels[p_level - 1];
+	int child_shift = p_level - 1;
+
+	for (int i = 0; i < 2; i++) {
+
+		int z = p_z * 2 + i;
+		if (z >= child_level.depth || (z << child_shift) > p_params->to_z || (((z + 1) << child_shift) - 1) < p_params->from_z) {
+			continue;
+		}
+
+		for (int j = 0; j < 2; j++) {
+
+			int x = p_x * 2 + j;
+			if (x >= child_level.width || (x << child_shift) > p_params->to_x || (((x + 1) << child_shift) - 1) < p_params->from_x) {
+				continue;
+			}
+
+			_cull(p_level - 1, x, z, p_params);
+		}
+	}
+}
+
 void HeightMapShape3DSW::cull(const AABB &p_local_aabb, Callback p_callback, void *p_userdata) const {
+
+	if (mip_levels.size() == 0)
+		return;
+
+	int cells_w = mip_levels[0].width;
+	int cells_d = mip_levels[0].depth;
+
+	Vector3 from = p_local_aabb.position / cell_size;
+	Vector3 to = (p_local_aabb.position + p_local_aabb.size) / cell_size;
+
+	if (to.x < 0 || to.z < 0 || from.x > cells_w || from.z > cells_d)
+		return;
+
+	FaceShape3DSW face; // use this to send in the callback
+
+	_CullParams params;
+	params.from_x = CLAMP((int)Math::floor(from.x), 0, cells_w - 1);
+	params.from_z = CLAMP((int)Math::floor(from.z), 0, cells_d - 1);
+	params.to_x = CLAMP((int)Math::floor(to.x), 0, cells_w - 1);
+	params.to_z = CLAMP((int)Math::floor(to.z), 0, cells_d - 1);
+	params.min_y = p_local_aabb.position.y;
+	params.max_y = p_local_aabb.position.y + p_local_aabb.size.y;
+	params.callback = p_callback;
+	params.userdata = p_userdata;
+	params.face = &face;
+
+	_cull(mip_levels.size() - 1, 0, 0, &params);
 }
 
 Vector3 HeightMapShape3DSW::get_moment_of_inertia(real_t p_mass) const {
@@ -1593,6 +1883,74 @@ Vector3 HeightMapShape3DSW::get_moment_of_inertia(real_t p_mass) const {
 			(p_mass / 3.0) * (extents.y * extents.y + extents.y * extents.y));
 }
 
+void HeightMapShape3DSW::_build_mips() {
+
+	mip_levels.clear();
+	mip_data.clear();
+
+	if (width < 2 || depth < 2)
+		return;
+
+	const real_t *r = heights.ptr();
+
+	MipLevel level;
+	level.width = width - 1;
+	level.depth = depth - 1;
+	level.offset = 0;
+	mip_data.resize(level.width * level.depth);
+
+	for (int i = 0; i < level.depth; i++) {
+
+		for (int j = 0; j < level.width; j++) {
+
+			real_t h00 = r[i * width + j];
+			real_t h10 = r[i * width + j + 1];
+			real_t h01 = r[(i + 1) * width + j];
+			real_t h11 = r[(i + 1) * width + j + 1];
+
+			MinMax &mm = mip_data[i * level.width + j];
+			mm.min = MIN(MIN(h00, h10), MIN(h01, h11));
+			mm.max = MAX(MAX(h00, h10), MAX(h01, h11));
+		}
+	}
+
+	mip_levels.push_back(level);
+
+	while (level.width > 1 || level.depth > 1) {
+
+		MipLevel next;
+		next.width = (level.width + 1) / 2;
+		next.depth = (level.depth + 1) / 2;
+		next.offset = mip_data.size();
+		mip_data.resize(next.offset + next.width * next.depth);
+
+		for (int i = 0; i < next.depth; i++) {
+
+			for (int j = 0; j < next.width; j++) {
+
+				MinMax &mm = mip_data[next.offset + i * next.width + j];
+				mm = mip_data[level.offset + (i * 2) * level.width + j * 2];
+
+				for (int k = 0; k < 4; k++) {
+
+					int z = i * 2 + (k >> 1);
+					int x = j * 2 + (k & 1);
+					if (x >= level.width || z >= level.depth) {
+						continue;
+					}
+
+					const MinMax &child = mip_data[level.offset + z * level.width + x];
+					mm.min = MIN(mm.min, child.min);
+					mm.max = MAX(mm.max, child.max);
+				}
+			}
+		}
+
+		mip_levels.push_back(next);
+		level = next;
+	}
+}
+
 void HeightMapShape3DSW::_setup(Vector<real_t> p_heights, int p_width, int p_depth, real_t p_cell_size) {
 
 	heights = p_heights;
@@ -1611,13 +1969,15 @@ void HeightMapShape3DSW::_setup(Vector<real_t> p_heights, int p_width, int p_dep
 			real_t h = r[i * width + j];
 
 			Vector3 pos(j * cell_size, h, i * cell_size);
-			if (i == 0 || j == 0)
+			if (i == 0 && j == 0)
 				aabb.position = pos;
 			else
 				aabb.expand_to(pos);
 		}
 	}
 
+	_build_mips();
+
 	configure(aabb);
 }
 
@@ -31,7 +31,9 @@
 #ifndef SHAPE_SW_H
 #define SHAPE_SW_H
 
+#include "core/local_vector.h"
 #include "core/math/geometry.h"
+#include "servers/physics_3d/simd_vertices_3d_sw.h"
 #include "servers/physics_server_3d.h"
 /*
 
@@ -261,11 +263,13 @@ public:
 struct ConvexPolygonShape3DSW : public Shape3DSW {
 
 	Geometry::MeshData mesh;
+	SIMDVertices3DSW simd_vertices;
 
 	void _setup(const Vector<Vector3> &p_vertices);
 
 public:
 	const Geometry::MeshData &get_mesh() const { return mesh; }
+	const SIMDVertices3DSW &get_simd_vertices() const { return simd_vertices; }
 
 	virtual PhysicsServer3D::ShapeType get_type() const { return PhysicsServer3D::SHAPE_CONVEX_POLYGON; }
 
@@ -299,16 +303,20 @@ struct ConcavePolygonShape3DSW : public ConcaveShape3DSW {
 	Vector<Face> faces;
 	Vector<Vector3> vertices;
 
+	// Quantized BVH node, bounds are stored in 1/65535ths of the BVH bounds, rounded
+	// outwards. Nodes are laid out depth first so the first child of a branch is the
+	// next node and traversal needs no stack: a leaf stores its face index, a branch
+	// stores ~escape, where escape is the node following its subtree.
 	struct BVH {
 
-		AABB aabb;
-		int left;
-		int right;
-
-		int face_index;
+		uint16_t min[3];
+		uint16_t max[3];
+		int32_t data;
 	};
 
 	Vector<BVH> bvh;
+	Vector3 bvh_origin;
+	Vector3 bvh_scale;
 
 	struct _CullParams {
 
@@ -318,6 +326,7 @@ struct ConcavePolygonShape3DSW : public ConcaveShape3DSW {
 		const Face *faces;
 		const Vector3 *vertices;
 		const BVH *bvh;
+		int bvh_count;
 		FaceShape3DSW *face;
 	};
 
@@ -328,6 +337,7 @@ struct ConcavePolygonShape3DSW : public ConcaveShape3DSW {
 		const Face *faces;
 		const Vector3 *vertices;
 		const BVH *bvh;
+		int bvh_count;
 		Vector3 dir;
 
 		Vector3 result;
@@ -336,8 +346,10 @@ struct ConcavePolygonShape3DSW : public ConcaveShape3DSW {
 		int collisions;
 	};
 
-	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
-	void _cull(int p_idx, _CullParams *p_params) const;
+	_FORCE_INLINE_ void _quantize_aabb(const AABB &p_aabb, BVH &r_node) const;
+
+	void _cull_segment(_SegmentCullParams *p_params) const;
+	void _cull(_CullParams *p_params) const;
 
 	void _fill_bvh(_VolumeSW_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
 
@@ -372,8 +384,56 @@ struct HeightMapShape3DSW : public ConcaveShape3DSW {
 	int depth;
 	real_t cell_size;
 
-	//void _cull_segment(int p_idx,_SegmentCullParams *p_params) const;
-	//void _cull(int p_idx,_CullParams *p_params) const;
+	// Min/max heights of blocks of 2^level x 2^level cells, level 0 holds the cells
+	// themselves and the last level a single block covering the whole map.
+	struct MinMax {
+
+		real_t min;
+		real_t max;
+	};
+
+	struct MipLevel {
+
+		int width;
+		int depth;
+		int offset;
+	};
+
+	LocalVector<MipLevel> mip_levels;
+	LocalVector<MinMax> mip_data;
+
+	struct _CullParams {
+
+		int from_x, from_z;
+		int to_x, to_z;
+		real_t min_y, max_y;
+		Callback callback;
+		void *userdata;
+		FaceShape3DSW *face;
+	};
+
+	struct _SegmentCullParams {
+
+		Vector3 from;
+		Vector3 to;
+		Vector3 dir;
+		Vector3 motion;
+		Vector3 inv_motion;
+		real_t length;
+
+		Vector3 result;
+		Vector3 normal;
+		real_t min_d;
+		int collisions;
+	};
+
+	_FORCE_INLINE_ Vector3 _get_vertex(int p_x, int p_z) const;
+	_FORCE_INLINE_ void _get_cell_triangles(int p_x, int p_z, Vector3 r_triangles[2][3]) const;
+
+	void _cull_segment(int p_level, int p_x, int p_z, _SegmentCullParams *p_params) const;
+	void _cull(int p_level, int p_x, int p_z, _CullParams *p_params) const;
+
+	void _build_mips();
 
 	void _setup(Vector<real_t> p_heights, int p_width, int p_depth, real_t p_cell_size);
 
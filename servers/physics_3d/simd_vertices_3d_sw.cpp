@@ -0,0 +1,246 @@
+/*************************************************************************/
+/*  simd_vertices_3d_sw.cpp                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "simd_vertices_3d_sw.h"
+
+#if defined(PHYSICS_SIMD_SSE)
+#include <xmmintrin.h>
+#elif defined(PHYSICS_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+void SIMDVertices3DSW::set_vertices(const Vector3 *p_vertices, int p_count) {
+
+	vertex_count = p_count;
+	int block_count = (p_count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	blocks.resize(block_count * BLOCK_FLOATS);
+
+	real_t *w = blocks.ptr();
+	for (int i = 0; i < block_count * BLOCK_SIZE; i++) {
+
+		const Vector3 &v = p_vertices[MIN(i, p_count - 1)];
+		real_t *block = &w[(i / BLOCK_SIZE) * BLOCK_FLOATS];
+		int lane = i % BLOCK_SIZE;
+		block[lane] = v.x;
+		block[BLOCK_SIZE + lane] = v.y;
+		block[BLOCK_SIZE * 2 + lane] = v.z;
+	}
+}
+
+int SIMDVertices3DSW::get_support_index(const Vector3 &p_normal) const {
+
+	if (vertex_count == 0)
+		return -1;
+
+	const real_t *r = blocks.ptr();
+	int block_count = blocks.size() / BLOCK_FLOATS;
+
+	real_t lane_max[BLOCK_SIZE];
+	real_t lane_index[BLOCK_SIZE]; // block index kept as float, exact up to 2^24 blocks
+
+#if defined(PHYSICS_SIMD_SSE)
+
+	__m128 nx = _mm_set1_ps(p_normal.x);
+	__m128 ny = _mm_set1_ps(p_normal.y);
+	__m128 nz = _mm_set1_ps(p_normal.z);
+
+	__m128 best = _mm_set1_ps(-Math_INF);
+	__m128 best_index = _mm_setzero_ps();
+	__m128 index = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0);
+
+	for (int i = 0; i < block_count; i++) {
+
+		const real_t *block = &r[i * BLOCK_FLOATS];
+		__m128 d = _mm_mul_ps(nx, _mm_loadu_ps(block));
+		d = _mm_add_ps(d, _mm_mul_ps(ny, _mm_loadu_ps(block + BLOCK_SIZE)));
+		d = _mm_add_ps(d, _mm_mul_ps(nz, _mm_loadu_ps(block + BLOCK_SIZE * 2)));
+
+		//strictly greater, so every lane keeps the first vertex found
+		__m128 greater = _mm_cmpgt_ps(d, best);
+		best = _mm_or_ps(_mm_and_ps(greater, d), _mm_andnot_ps(greater, best));
+		best_index = _mm_or_ps(_mm_and_ps(greater, index), _mm_andnot_ps(greater, best_index));
+		index = _mm_add_ps(index, one);
+	}
+
+	_mm_storeu_ps(lane_max, best);
+	_mm_storeu_ps(lane_index, best_index);
+
+#elif defined(PHYSICS_SIMD_NEON)
+
+	float32x4_t nx = vdupq_n_f32(p_normal.x);
+	float32x4_t ny = vdupq_n_f32(p_normal.y);
+	float32x4_t nz = vdupq_n_f32(p_normal.z);
+
+	float32x4_t best = vdupq_n_f32(-Math_INF);
+	float32x4_t best_index = vdupq_n_f32(0.0);
+	float32x4_t index = vdupq_n_f32(0.0);
+	const float32x4_t one = vdupq_n_f32(1.0);
+
+	for (int i = 0; i < block_count; i++) {
+
+		const real_t *block = &r[i * BLOCK_FLOATS];
+		float32x4_t d = vmulq_f32(nx, vld1q_f32(block));
+		d = vaddq_f32(d, vmulq_f32(ny, vld1q_f32(block + BLOCK_SIZE)));
+		d = vaddq_f32(d, vmulq_f32(nz, vld1q_f32(block + BLOCK_SIZE * 2)));
+
+		uint32x4_t greater = vcgtq_f32(d, best);
+		best = vbslq_f32(greater, d, best);
+		best_index = vbslq_f32(greater, index, best_index);
+		index = vaddq_f32(index, one);
+	}
+
+	vst1q_f32(lane_max, best);
+	vst1q_f32(lane_index, best_index);
+
+#else
+
+	for (int j = 0; j < BLOCK_SIZE; j++) {
+		lane_max[j] = -Math_INF;
+		lane_index[j] = 0;
+	}
+
+	for (int i = 0; i < block_count; i++) {
+
+		const real_t *block = &r[i * BLOCK_FLOATS];
+		for (int j = 0; j < BLOCK_SIZE; j++) {
+
+			real_t d = p_normal.x * block[j] + p_normal.y * block[BLOCK_SIZE + j] + p_normal.z * block[BLOCK_SIZE * 2 + j];
+			if (d > lane_max[j]) {
+				lane_max[j] = d;
+				lane_index[j] = i;
+			}
+		}
+	}
+
+#endif
+
+	//pick the best lane, the lowest vertex index wins ties like in a plain loop
+	int support = -1;
+	real_t support_max = 0;
+	for (int j = 0; j < BLOCK_SIZE; j++) {
+
+		int idx = int(lane_index[j]) * BLOCK_SIZE + j;
+		if (idx >= vertex_count)
+			continue;
+		if (support == -1 || lane_max[j] > support_max || (lane_max[j] == support_max && idx < support)) {
+			support = idx;
+			support_max = lane_max[j];
+		}
+	}
+
+	if (support == -1) {
+		//only possible with NaN normals, behave like a plain loop
+		support = 0;
+	}
+
+	return support;
+}
+
+void SIMDVertices3DSW::project_range(const Vector3 &p_normal, real_t &r_min, real_t &r_max) const {
+
+	if (vertex_count == 0)
+		return;
+
+	const real_t *r = blocks.ptr();
+	int block_count = blocks.size() / BLOCK_FLOATS;
+
+	real_t lane_min[BLOCK_SIZE];
+	real_t lane_max[BLOCK_SIZE];
+
+#if defined(PHYSICS_SIMD_SSE)
+
+	__m128 nx = _mm_set1_ps(p_normal.x);
+	__m128 ny = _mm_set1_ps(p_normal.y);
+	__m128 nz = _mm_set1_ps(p_normal.z);
+
+	__m128 min = _mm_set1_ps(Math_INF);
+	__m128 max = _mm_set1_ps(-Math_INF);
+
+	for (int i = 0; i < block_count; i++) {
+
+		const real_t *block = &r[i * BLOCK_FLOATS];
+		__m128 d = _mm_mul_ps(nx, _mm_loadu_ps(block));
+		d = _mm_add_ps(d, _mm_mul_ps(ny, _mm_loadu_ps(block + BLOCK_SIZE)));
+		d = _mm_add_ps(d, _mm_mul_ps(nz, _mm_loadu_ps(block + BLOCK_SIZE * 2)));
+
+		min = _mm_min_ps(min, d);
+		max = _mm_max_ps(max, d);
+	}
+
+	_mm_storeu_ps(lane_min, min);
+	_mm_storeu_ps(lane_max, max);
+
+#elif defined(PHYSICS_SIMD_NEON)
+
+	float32x4_t nx = vdupq_n_f32(p_normal.x);
+	float32x4_t ny = vdupq_n_f32(p_normal.y);
+	float32x4_t nz = vdupq_n_f32(p_normal.z);
+
+	float32x4_t min = vdupq_n_f32(Math_INF);
+	float32x4_t max = vdupq_n_f32(-Math_INF);
+
+	for (int i = 0; i < block_count; i++) {
+
+		const real_t *block = &r[i * BLOCK_FLOATS];
+		float32x4_t d = vmulq_f32(nx, vld1q_f32(block));
+		d = vaddq_f32(d, vmulq_f32(ny, vld1q_f32(block + BLOCK_SIZE)));
+		d = vaddq_f32(d, vmulq_f32(nz, vld1q_f32(block + BLOCK_SIZE * 2)));
+
+		min = vminq_f32(min, d);
+		max = vmaxq_f32(max, d);
+	}
+
+	vst1q_f32(lane_min, min);
+	vst1q_f32(lane_max, max);
+
+#else
+
+	for (int j = 0; j < BLOCK_SIZE; j++) {
+		lane_min[j] = Math_INF;
+		lane_max[j] = -Math_INF;
+	}
+
+	for (int i = 0; i < block_count; i++) {
+
+		const real_t *block = &r[i * BLOCK_FLOATS];
+		for (int j = 0; j < BLOCK_SIZE; j++) {
+
+			real_t d = p_normal.x * block[j] + p_normal.y * block[BLOCK_SIZE + j] + p_normal.z * block[BLOCK_SIZE * 2 + j];
+			lane_min[j] = MIN(lane_min[j], d);
+			lane_max[j] = MAX(lane_max[j], d);
+		}
+	}
+
+#endif
+
+	r_min = MIN(MIN(lane_min[0], lane_min[1]), MIN(lane_min[2], lane_min[3]));
+	r_max = MAX(MAX(lane_max[0], lane_max[1]), MAX(lane_max[2], lane_max[3]));
+}
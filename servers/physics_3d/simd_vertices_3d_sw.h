@@ -0,0 +1,71 @@
+/*************************************************************************/
+/*  simd_vertices_3d_sw.h                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SIMD_VERTICES_3D_SW_H
+#define SIMD_VERTICES_3D_SW_H
+
+#include "core/local_vector.h"
+#include "core/math/vector3.h"
+
+// build with physics_simd=no (NO_PHYSICS_SIMD) to always use the scalar loops
+#if !defined(NO_PHYSICS_SIMD) && !defined(REAL_T_IS_DOUBLE)
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PHYSICS_SIMD_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define PHYSICS_SIMD_NEON
+#endif
+#endif
+
+// Vertex set laid out for the support mapping and projection loops of convex shapes.
+// Vertices are stored in blocks of four, as xxxx yyyy zzzz, so four dot products
+// are computed at a time. The last block is padded by repeating the last vertex,
+// which never changes the result.
+class SIMDVertices3DSW {
+
+	enum {
+		BLOCK_SIZE = 4,
+		BLOCK_FLOATS = BLOCK_SIZE * 3,
+	};
+
+	LocalVector<real_t> blocks;
+	int vertex_count = 0;
+
+public:
+	void set_vertices(const Vector3 *p_vertices, int p_count);
+
+	_FORCE_INLINE_ int size() const { return vertex_count; }
+
+	// index of the first vertex furthest along p_normal, -1 if empty
+	int get_support_index(const Vector3 &p_normal) const;
+	// min and max of the vertices projected on p_normal, left untouched if empty
+	void project_range(const Vector3 &p_normal, real_t &r_min, real_t &r_max) const;
+};
+
+#endif // SIMD_VERTICES_3D_SW_H
@@ -38,6 +38,7 @@
 #include "broad_phase_3d_sw.h"
 #include "collision_object_3d_sw.h"
 #include "core/hash_map.h"
+#include "core/local_vector.h"
 #include "core/project_settings.h"
 #include "core/typedefs.h"
 
@@ -45,6 +46,44 @@ class PhysicsDirectSpaceState3DSW : public PhysicsDirectSpaceState3D {
 
 	GDCLASS(PhysicsDirectSpaceState3DSW, PhysicsDirectSpaceState3D);
 
+	enum {
+		BATCH_PARALLEL_MIN = 16 // smaller batches are not worth sending to threads
+	};
+
+	// shared by the ray and motion batches, each query only uses its own part
+	struct RayBatch {
+
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		RayResult *ray_results = nullptr;
+
+		Shape3DSW *shape = nullptr;
+		const Transform *xforms = nullptr;
+		const Vector3 *motions = nullptr;
+		const AABB *aabbs = nullptr;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+
+		bool *hits = nullptr;
+		const Set<RID> *exclude = nullptr;
+		uint32_t collision_mask = 0;
+		bool collide_with_bodies = true;
+		bool collide_with_areas = false;
+		bool pick_ray = false;
+
+		LocalVector<CollisionObject3DSW *> objects;
+		LocalVector<int> subindices;
+		LocalVector<uint32_t> offsets;
+	};
+
+	bool _intersect_ray(const Vector3 &p_from, const Vector3 &p_to, CollisionObject3DSW *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray) const;
+	bool _cast_motion(Shape3DSW *p_shape, const Transform &p_xform, const Vector3 &p_motion, const AABB &p_aabb, CollisionObject3DSW *const *p_objects, const int *p_subindices, int p_amount, real_t &p_closest_safe, real_t &p_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, ShapeRestInfo *r_info) const;
+
+	void _intersect_ray_batch(uint32_t p_index, RayBatch *p_batch);
+	void _cast_motion_batch(uint32_t p_index, RayBatch *p_batch);
+	void _add_batch_candidates(RayBatch &r_batch, int p_amount);
+	void _process_batch(uint32_t p_count, void (PhysicsDirectSpaceState3DSW::*p_method)(uint32_t, RayBatch *), RayBatch *p_batch);
+
 public:
 	Space3DSW *space;
 
@@ -53,6 +92,8 @@ public:
 	virtual int intersect_shape(const RID &p_shape, const Transform &p_xform, real_t p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual bool cast_motion(const RID &p_shape, const Transform &p_xform, const Vector3 &p_motion, real_t p_margin, real_t &p_closest_safe, real_t &p_closest_unsafe, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, ShapeRestInfo *r_info = NULL);
 	virtual bool collide_shape(RID p_shape, const Transform &p_shape_xform, real_t p_margin, Vector3 *r_results, int p_result_max, int &r_result_count, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
+	virtual int intersect_rays(const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, bool p_pick_ray = false);
+	virtual int cast_motions(const RID &p_shape, const Transform *p_xforms, const Vector3 *p_motions, int p_count, real_t p_margin, real_t *r_closest_safe, real_t *r_closest_unsafe, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual bool rest_info(RID p_shape, const Transform &p_shape_xform, real_t p_margin, ShapeRestInfo *r_info, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const;
 
@@ -31,7 +31,10 @@
 #include "step_3d_sw.h"
 #include "joints_3d_sw.h"
 
+#include "core/debugger/profiling_zones.h"
 #include "core/os/os.h"
+#include "core/safe_refcount.h"
+#include "core/thread_work_pool.h"
 
 void Step3DSW::_populate_island(Body3DSW *p_body, Body3DSW **p_island, Constraint3DSW **p_constraint_island) {
 
@@ -59,27 +62,26 @@ void Step3DSW::_populate_island(Body3DSW *p_body, Body3DSW **p_island, Constrain
 	}
 }
 
-void Step3DSW::_setup_island(Constraint3DSW *p_island, real_t p_delta) {
+void Step3DSW::_setup_island(uint32_t p_island_index, void *p_userdata) {
 
-	Constraint3DSW *ci = p_island;
-	while (ci) {
-		ci->setup(p_delta);
-		//todo remove from island if process fails
-		ci = ci->get_island_next();
+	for (uint32_t i = island_offsets[p_island_index]; i < island_offsets[p_island_index + 1]; i++) {
+		setup_results[i] = all_constraints[i]->setup(delta);
 	}
 }
 
-void Step3DSW::_solve_island(Constraint3DSW *p_island, int p_iterations, real_t p_delta) {
+void Step3DSW::_solve_island(uint32_t p_island_index, void *p_userdata) {
+
+	Constraint3DSW *p_island = constraint_islands[p_island_index];
 
 	int at_priority = 1;
 
 	while (p_island) {
 
-		for (int i = 0; i < p_iterations; i++) {
+		for (int i = 0; i < iterations; i++) {
 
 			Constraint3DSW *ci = p_island;
 			while (ci) {
-				ci->solve(p_delta);
+				ci->solve(delta);
 				ci = ci->get_island_next();
 			}
 		}
@@ -107,6 +109,19 @@ void Step3DSW::_solve_island(Constraint3DSW *p_island, int p_iterations, real_t
 	}
 }
 
+void Step3DSW::_process_islands(uint32_t p_island_count, void (Step3DSW::*p_method)(uint32_t, void *)) {
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+
+	if (pool && p_island_count > 1) {
+		pool->do_work(p_island_count, this, p_method, (void *)NULL);
+	} else {
+		for (uint32_t i = 0; i < p_island_count; i++) {
+			(this->*p_method)(i, NULL);
+		}
+	}
+}
+
 void Step3DSW::_check_suspend(Body3DSW *p_island, real_t p_delta) {
 
 	bool can_sleep = true;
@@ -146,8 +161,15 @@ void Step3DSW::_check_suspend(Body3DSW *p_island, real_t p_delta) {
 
 void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 
+	PROFILING_ZONE("Step3DSW::step");
+	MemoryTagScope memory_tag(Memory::TAG_PHYSICS);
+
 	p_space->lock(); // can't access space during this
 
+	_step = atomic_increment(&step_counter);
+	iterations = p_iterations;
+	delta = p_delta;
+
 	p_space->setup(); //update inertias, etc
 
 	const SelfList<Body3DSW>::List *body_list = &p_space->get_active_body_list();
@@ -230,13 +252,56 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SETUP CONSTRAINT ISLANDS */
 
+	all_constraints.clear();
+	island_offsets.clear();
+
 	{
 		Constraint3DSW *ci = constraint_island_list;
 		while (ci) {
 
-			_setup_island(ci, p_delta);
+			island_offsets.push_back(all_constraints.size());
+			for (Constraint3DSW *c = ci; c; c = c->get_island_next()) {
+				all_constraints.push_back(c);
+			}
 			ci = ci->get_island_list_next();
 		}
+		island_offsets.push_back(all_constraints.size());
+	}
+
+	setup_results.resize(all_constraints.size());
+
+	_process_islands(island_offsets.size() - 1, &Step3DSW::_setup_island);
+
+	/* PRE-SOLVE CONSTRAINT ISLANDS */
+
+	//serial and in island order, and only what's left to solve is linked back
+
+	constraint_islands.clear();
+
+	for (uint32_t i = 0; i < island_offsets.size() - 1; i++) {
+
+		Constraint3DSW *first = NULL;
+		Constraint3DSW *last = NULL;
+
+		for (uint32_t j = island_offsets[i]; j < island_offsets[i + 1]; j++) {
+
+			Constraint3DSW *c = all_constraints[j];
+			if (!c->pre_solve(delta) || !setup_results[j]) {
+				continue;
+			}
+
+			if (last) {
+				last->set_island_next(c);
+			} else {
+				first = c;
+			}
+			last = c;
+		}
+
+		if (last) {
+			last->set_island_next(NULL);
+			constraint_islands.push_back(first);
+		}
 	}
 
 	{ //profile
@@ -247,14 +312,8 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
-	{
-		Constraint3DSW *ci = constraint_island_list;
-		while (ci) {
-			//iterating each island separatedly improves cache efficiency
-			_solve_island(ci, p_iterations, p_delta);
-			ci = ci->get_island_list_next();
-		}
-	}
+	//iterating each island separatedly improves cache efficiency
+	_process_islands(constraint_islands.size(), &Step3DSW::_solve_island);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -290,10 +349,13 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 
 	p_space->update();
 	p_space->unlock();
-	_step++;
 }
 
+uint64_t Step3DSW::step_counter = 0;
+
 Step3DSW::Step3DSW() {
 
-	_step = 1;
+	_step = 0;
+	iterations = 0;
+	delta = 0;
 }
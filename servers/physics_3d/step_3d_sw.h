@@ -33,14 +33,29 @@
 
 #include "space_3d_sw.h"
 
+#include "core/local_vector.h"
+
 class Step3DSW {
 
+	static uint64_t step_counter; //shared by all steppers, so marks left by another one never match
 	uint64_t _step;
 
+	int iterations;
+	real_t delta;
+
+	// Islands share no dynamic body, so they are set up and solved in
+	// parallel. The constraints of each island are always processed in the
+	// same order, keeping results independent of the thread count.
+	LocalVector<Constraint3DSW *> all_constraints; //island after island
+	LocalVector<uint32_t> island_offsets; //first constraint of each island, plus the end
+	LocalVector<uint8_t> setup_results;
+	LocalVector<Constraint3DSW *> constraint_islands; //constraints left to solve, per island
+
 	void _populate_island(Body3DSW *p_body, Body3DSW **p_island, Constraint3DSW **p_constraint_island);
-	void _setup_island(Constraint3DSW *p_island, real_t p_delta);
-	void _solve_island(Constraint3DSW *p_island, int p_iterations, real_t p_delta);
+	void _setup_island(uint32_t p_island_index, void *p_userdata);
+	void _solve_island(uint32_t p_island_index, void *p_userdata);
 	void _check_suspend(Body3DSW *p_island, real_t p_delta);
+	void _process_islands(uint32_t p_island_count, void (Step3DSW::*p_method)(uint32_t, void *));
 
 public:
 	void step(Space3DSW *p_space, real_t p_delta, int p_iterations);
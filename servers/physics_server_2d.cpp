@@ -328,6 +328,125 @@ Array PhysicsDirectSpaceState2D::_cast_motion(const Ref<PhysicsShapeQueryParamet
 	return ret;
 }
 
+Dictionary PhysicsDirectSpaceState2D::_intersect_rays(const Vector<Vector2> &p_from, const Vector<Vector2> &p_to, const Vector<RID> &p_exclude, uint32_t p_layers, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	ERR_FAIL_COND_V(p_from.size() != p_to.size(), Dictionary());
+
+	int count = p_from.size();
+	Set<RID> exclude;
+	for (int i = 0; i < p_exclude.size(); i++)
+		exclude.insert(p_exclude[i]);
+
+	Vector<RayResult> results;
+	results.resize(count);
+	Vector<uint8_t> hits;
+	hits.resize(count);
+	Vector<bool> hit_flags;
+	hit_flags.resize(count);
+
+	intersect_rays(p_from.ptr(), p_to.ptr(), count, results.ptrw(), hit_flags.ptrw(), exclude, p_layers, p_collide_with_bodies, p_collide_with_areas);
+
+	Vector<Vector2> positions;
+	positions.resize(count);
+	Vector<Vector2> normals;
+	normals.resize(count);
+	Vector<int64_t> collider_ids;
+	collider_ids.resize(count);
+	Vector<int32_t> shapes;
+	shapes.resize(count);
+	Array rids;
+	rids.resize(count);
+	Array metadata;
+	metadata.resize(count);
+
+	for (int i = 0; i < count; i++) {
+
+		hits.write[i] = hit_flags[i];
+		if (!hit_flags[i]) {
+			positions.write[i] = Vector2();
+			normals.write[i] = Vector2();
+			collider_ids.write[i] = 0;
+			shapes.write[i] = 0;
+			continue;
+		}
+
+		const RayResult &r = results[i];
+		positions.write[i] = r.position;
+		normals.write[i] = r.normal;
+		collider_ids.write[i] = r.collider_id;
+		shapes.write[i] = r.shape;
+		rids[i] = r.rid;
+		metadata[i] = r.metadata;
+	}
+
+	Dictionary d;
+	d["hit"] = hits;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["collider_id"] = collider_ids;
+	d["shape"] = shapes;
+	d["rid"] = rids;
+	d["metadata"] = metadata;
+
+	return d;
+}
+
+Vector<float> PhysicsDirectSpaceState2D::_cast_motions(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, const Vector<Vector2> &p_origins, const Vector<Vector2> &p_motions) {
+
+	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Vector<float>());
+	ERR_FAIL_COND_V(p_origins.size() != p_motions.size(), Vector<float>());
+
+	int count = p_origins.size();
+
+	Vector<Transform2D> xforms;
+	xforms.resize(count);
+	for (int i = 0; i < count; i++) {
+		Transform2D xform = p_shape_query->transform;
+		xform.set_origin(p_origins[i]);
+		xforms.write[i] = xform;
+	}
+
+	Vector<float> closest_safe;
+	closest_safe.resize(count);
+	Vector<float> closest_unsafe;
+	closest_unsafe.resize(count);
+
+	cast_motions(p_shape_query->shape, xforms.ptr(), p_motions.ptr(), count, p_shape_query->margin, closest_safe.ptrw(), closest_unsafe.ptrw(), p_shape_query->exclude, p_shape_query->collision_mask, p_shape_query->collide_with_bodies, p_shape_query->collide_with_areas);
+
+	Vector<float> ret;
+	ret.resize(count * 2);
+	for (int i = 0; i < count; i++) {
+		ret.write[i * 2 + 0] = closest_safe[i];
+		ret.write[i * 2 + 1] = closest_unsafe[i];
+	}
+	return ret;
+}
+
+int PhysicsDirectSpaceState2D::intersect_rays(const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude, uint32_t p_collision_layer, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		r_hits[i] = intersect_ray(p_from[i], p_to[i], r_results[i], p_exclude, p_collision_layer, p_collide_with_bodies, p_collide_with_areas);
+		if (r_hits[i])
+			hit_count++;
+	}
+	return hit_count;
+}
+
+int PhysicsDirectSpaceState2D::cast_motions(const RID &p_shape, const Transform2D *p_xforms, const Vector2 *p_motions, int p_count, float p_margin, float *r_closest_safe, float *r_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_collision_layer, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	int valid_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (cast_motion(p_shape, p_xforms[i], p_motions[i], p_margin, r_closest_safe[i], r_closest_unsafe[i], p_exclude, p_collision_layer, p_collide_with_bodies, p_collide_with_areas)) {
+			valid_count++;
+		} else {
+			r_closest_safe[i] = 0;
+			r_closest_unsafe[i] = 0;
+		}
+	}
+	return valid_count;
+}
+
 Array PhysicsDirectSpaceState2D::_intersect_point_impl(const Vector2 &p_point, int p_max_results, const Vector<RID> &p_exclude, uint32_t p_layers, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_filter_by_canvas, ObjectID p_canvas_instance_id) {
 
 	Set<RID> exclude;
@@ -419,6 +538,8 @@ void PhysicsDirectSpaceState2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_ray", "from", "to", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &PhysicsDirectSpaceState2D::_intersect_ray, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_shape", "shape", "max_results"), &PhysicsDirectSpaceState2D::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "shape"), &PhysicsDirectSpaceState2D::_cast_motion);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "from", "to", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &PhysicsDirectSpaceState2D::_intersect_rays, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("cast_motions", "shape", "origins", "motions"), &PhysicsDirectSpaceState2D::_cast_motions);
 	ClassDB::bind_method(D_METHOD("collide_shape", "shape", "max_results"), &PhysicsDirectSpaceState2D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "shape"), &PhysicsDirectSpaceState2D::_get_rest_info);
 }
@@ -68,8 +68,6 @@
 #include "rendering_server.h"
 #include "servers/rendering/shader_types.h"
 
-ShaderTypes *shader_types = NULL;
-
 PhysicsServer3D *_createGodotPhysics3DCallback() {
 	return memnew(PhysicsServer3DSW);
 }
@@ -89,10 +87,6 @@ static bool has_server_feature_callback(const String &p_feature) {
 	return false;
 }
 
-void preregister_server_types() {
-	shader_types = memnew(ShaderTypes);
-}
-
 void register_server_types() {
 
 	OS::get_singleton()->set_has_server_feature_callback(has_server_feature_callback);
@@ -111,6 +105,7 @@ void register_server_types() {
 	ClassDB::register_virtual_class<AudioStream>();
 	ClassDB::register_virtual_class<AudioStreamPlayback>();
 	ClassDB::register_virtual_class<AudioStreamPlaybackResampled>();
+	ClassDB::register_virtual_class<AudioStreamPlaybackDecoded>();
 	ClassDB::register_class<AudioStreamMicrophone>();
 	ClassDB::register_class<AudioStreamRandomPitch>();
 	ClassDB::register_virtual_class<AudioEffect>();
@@ -187,7 +182,7 @@ void register_server_types() {
 
 void unregister_server_types() {
 
-	memdelete(shader_types);
+	ShaderTypes::finish();
 }
 
 void register_server_singletons() {
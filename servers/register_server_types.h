@@ -31,7 +31,6 @@
 #ifndef REGISTER_SERVER_TYPES_H
 #define REGISTER_SERVER_TYPES_H
 
-void preregister_server_types();
 void register_server_types();
 void unregister_server_types();
 
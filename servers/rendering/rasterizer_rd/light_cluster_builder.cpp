@@ -39,12 +39,18 @@ void LightClusterBuilder::begin(const Transform &p_view_transform, const CameraM
 	//reset counts
 	light_count = 0;
 	refprobe_count = 0;
+	decal_count = 0;
 	item_count = 0;
 	sort_id_count = 0;
 }
 
 void LightClusterBuilder::bake_cluster() {
 
+	if (use_compute) {
+		_bake_cluster_compute();
+		return;
+	}
+
 	float slice_depth = (z_near - z_far) / depth;
 
 	uint8_t *cluster_dataw = cluster_data.ptrw();
@@ -176,6 +182,142 @@ void LightClusterBuilder::bake_cluster() {
 	RD::get_singleton()->buffer_update(items_buffer, 0, offset * sizeof(uint32_t), ids_ptr, true);
 }
 
+void LightClusterBuilder::_bake_cluster_compute() {
+
+	uint32_t cell_count = width * height * depth;
+
+	//worst case every item touches every cell, the pointer bits cap it anyway
+	uint32_t index_max = MIN(uint64_t(MAX(item_count, 1u)) * cell_count, uint64_t(POINTER_MASK + 1));
+	if (index_max > compute.indices_max) {
+		compute.indices_max = nearest_power_of_2_templated(index_max);
+		RD::get_singleton()->free(items_buffer);
+		items_buffer = RD::get_singleton()->storage_buffer_create(sizeof(uint32_t) * compute.indices_max);
+	}
+
+	if (item_count > compute.items_buffer_max) {
+		compute.items_buffer_max = nearest_power_of_2_templated(item_count);
+		RD::get_singleton()->free(compute.items_buffer);
+		compute.items_buffer = RD::get_singleton()->storage_buffer_create(sizeof(ComputeItem) * compute.items_buffer_max);
+	}
+
+	compute.items.resize(item_count);
+	for (uint32_t i = 0; i < item_count; i++) {
+		const Item &item = items[i];
+		ComputeItem &ci = compute.items[i];
+		Vector3 end = item.aabb.position + item.aabb.size;
+		ci.aabb_min[0] = item.aabb.position.x;
+		ci.aabb_min[1] = item.aabb.position.y;
+		ci.aabb_min[2] = item.aabb.position.z;
+		ci.type = item.type;
+		ci.aabb_max[0] = end.x;
+		ci.aabb_max[1] = end.y;
+		ci.aabb_max[2] = end.z;
+		ci.index = item.index;
+	}
+
+	if (item_count) {
+		RD::get_singleton()->buffer_update(compute.items_buffer, 0, sizeof(ComputeItem) * item_count, compute.items.ptr(), true);
+	}
+
+	uint32_t zero = 0;
+	RD::get_singleton()->buffer_update(compute.counter_buffer, 0, sizeof(uint32_t), &zero, true);
+
+	//freeing any of the buffers or the texture also frees the set
+	if (!RD::get_singleton()->uniform_set_is_valid(compute.uniform_set)) {
+		Vector<RD::Uniform> uniforms;
+		{
+			RD::Uniform u;
+			u.type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 0;
+			u.ids.push_back(compute.items_buffer);
+			uniforms.push_back(u);
+		}
+		{
+			RD::Uniform u;
+			u.type = RD::UNIFORM_TYPE_IMAGE;
+			u.binding = 1;
+			u.ids.push_back(cluster_texture);
+			uniforms.push_back(u);
+		}
+		{
+			RD::Uniform u;
+			u.type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 2;
+			u.ids.push_back(items_buffer);
+			uniforms.push_back(u);
+		}
+		{
+			RD::Uniform u;
+			u.type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 3;
+			u.ids.push_back(compute.counter_buffer);
+			uniforms.push_back(u);
+		}
+		compute.uniform_set = RD::get_singleton()->uniform_set_create(uniforms, compute.shader.version_get_shader(compute.shader_version, 0), 0);
+	}
+
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			compute.push_constant.projection[i * 4 + j] = projection.matrix[i][j];
+		}
+	}
+	compute.push_constant.cluster_size[0] = width;
+	compute.push_constant.cluster_size[1] = height;
+	compute.push_constant.cluster_size[2] = depth;
+	compute.push_constant.item_count = item_count;
+	compute.push_constant.z_near = z_near;
+	compute.push_constant.slice_depth = (z_near - z_far) / depth;
+	compute.push_constant.index_max = compute.indices_max;
+	compute.push_constant.pad = 0;
+
+	RD::ComputeListID compute_list = RD::get_singleton()->compute_list_begin();
+	RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, compute.pipeline);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, compute.uniform_set, 0);
+	RD::get_singleton()->compute_list_set_push_constant(compute_list, &compute.push_constant, sizeof(ComputePushConstant));
+	RD::get_singleton()->compute_list_dispatch(compute_list, (width - 1) / 8 + 1, (height - 1) / 8 + 1, depth);
+	RD::get_singleton()->compute_list_end();
+}
+
+void LightClusterBuilder::set_use_compute(bool p_enable) {
+
+	if (p_enable && !RD::get_singleton()->texture_is_format_supported_for_usage(RD::DATA_FORMAT_R32G32B32A32_UINT, RD::TEXTURE_USAGE_SAMPLING_BIT | RD::TEXTURE_USAGE_STORAGE_BIT)) {
+		print_verbose("Light cluster: storage images not supported, falling back to CPU binning.");
+		p_enable = false;
+	}
+
+	if (use_compute == p_enable) {
+		return;
+	}
+
+	use_compute = p_enable;
+
+	if (use_compute && compute.shader_version.is_null()) {
+		Vector<String> modes;
+		modes.push_back("\n");
+		compute.shader.initialize(modes);
+		compute.shader_version = compute.shader.version_create();
+		compute.pipeline = RD::get_singleton()->compute_pipeline_create(compute.shader.version_get_shader(compute.shader_version, 0));
+
+		compute.items_buffer_max = 1024;
+		compute.items_buffer = RD::get_singleton()->storage_buffer_create(sizeof(ComputeItem) * compute.items_buffer_max);
+		compute.counter_buffer = RD::get_singleton()->storage_buffer_create(sizeof(uint32_t));
+		compute.indices_max = 1024; //matches the initial indices buffer
+	}
+
+	if (cluster_texture.is_valid()) {
+		//texture usage changed, recreate it
+		uint32_t w = width;
+		uint32_t h = height;
+		uint32_t d = depth;
+		width = 0;
+		setup(w, h, d);
+	}
+}
+
+bool LightClusterBuilder::is_using_compute() const {
+	return use_compute;
+}
+
 void LightClusterBuilder::setup(uint32_t p_width, uint32_t p_height, uint32_t p_depth) {
 
 	if (width == p_width && height == p_height && depth == p_depth) {
@@ -199,6 +341,9 @@ void LightClusterBuilder::setup(uint32_t p_width, uint32_t p_height, uint32_t p_
 		tf.height = height;
 		tf.depth = depth;
 		tf.usage_bits = RD::TEXTURE_USAGE_SAMPLING_BIT | RD::TEXTURE_USAGE_CAN_UPDATE_BIT;
+		if (use_compute) {
+			tf.usage_bits |= RD::TEXTURE_USAGE_STORAGE_BIT;
+		}
 
 		cluster_texture = RD::get_singleton()->texture_create(tf, RD::TextureView());
 	}
@@ -252,4 +397,10 @@ LightClusterBuilder::~LightClusterBuilder() {
 		memfree(sort_ids);
 		RD::get_singleton()->free(items_buffer);
 	}
+
+	if (compute.shader_version.is_valid()) {
+		RD::get_singleton()->free(compute.items_buffer);
+		RD::get_singleton()->free(compute.counter_buffer);
+		compute.shader.version_free(compute.shader_version);
+	}
 }
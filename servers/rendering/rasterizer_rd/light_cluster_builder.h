@@ -31,7 +31,9 @@
 #ifndef LIGHT_CLUSTER_BUILDER_H
 #define LIGHT_CLUSTER_BUILDER_H
 
+#include "core/local_vector.h"
 #include "servers/rendering/rasterizer_rd/rasterizer_storage_rd.h"
+#include "servers/rendering/rasterizer_rd/shaders/light_cluster.glsl.gen.h"
 
 class LightClusterBuilder {
 public:
@@ -124,6 +126,44 @@ private:
 	float z_far = 0;
 	float z_near = 0;
 
+	/* GPU binning, one invocation per cell, writes the cluster texture and indices directly */
+
+	struct ComputeItem {
+		float aabb_min[3];
+		uint32_t type;
+		float aabb_max[3];
+		uint32_t index;
+	};
+
+	struct ComputePushConstant {
+		float projection[16];
+		uint32_t cluster_size[3];
+		uint32_t item_count;
+		float z_near;
+		float slice_depth;
+		uint32_t index_max;
+		uint32_t pad;
+	};
+
+	struct Compute {
+		LightClusterShaderRD shader;
+		RID shader_version;
+		RID pipeline;
+		RID uniform_set;
+
+		LocalVector<ComputeItem> items;
+		RID items_buffer;
+		uint32_t items_buffer_max = 0;
+		RID counter_buffer;
+		uint32_t indices_max = 0;
+
+		ComputePushConstant push_constant;
+	} compute;
+
+	bool use_compute = false;
+
+	void _bake_cluster_compute();
+
 	_FORCE_INLINE_ void _add_item(const AABB &p_aabb, ItemType p_type, uint32_t p_index) {
 		if (unlikely(item_count == item_max)) {
 			item_max = nearest_power_of_2_templated(item_max + 1);
@@ -279,6 +319,9 @@ public:
 
 	void bake_cluster();
 
+	void set_use_compute(bool p_enable);
+	bool is_using_compute() const;
+
 	void setup(uint32_t p_width, uint32_t p_height, uint32_t p_depth);
 
 	RID get_cluster_texture() const;
@@ -106,13 +106,23 @@ void RasterizerCanvasRD::_update_specular_shininess(const Color &p_transform, ui
 
 RID RasterizerCanvasRD::_create_texture_binding(RID p_texture, RID p_normalmap, RID p_specular, RenderingServer::CanvasItemTextureFilter p_filter, RenderingServer::CanvasItemTextureRepeat p_repeat, RID p_multimesh) {
 
+	//textures drawn in 2D are always kept fully loaded when streaming
+	storage->texture_stream_pin(p_texture);
+	storage->texture_stream_pin(p_normalmap);
+	storage->texture_stream_pin(p_specular);
+
+	return _create_texture_binding_uniform_set(storage->texture_get_rd_texture(p_texture), storage->texture_get_rd_texture(p_normalmap), storage->texture_get_rd_texture(p_specular), p_filter, p_repeat);
+}
+
+RID RasterizerCanvasRD::_create_texture_binding_uniform_set(RID p_rd_texture, RID p_rd_normalmap, RID p_rd_specular, RenderingServer::CanvasItemTextureFilter p_filter, RenderingServer::CanvasItemTextureRepeat p_repeat) {
+
 	Vector<RD::Uniform> uniform_set;
 
 	{ // COLOR TEXTURE
 		RD::Uniform u;
 		u.type = RD::UNIFORM_TYPE_TEXTURE;
 		u.binding = 1;
-		RID texture = storage->texture_get_rd_texture(p_texture);
+		RID texture = p_rd_texture;
 		if (!texture.is_valid()) {
 			//use default white texture
 			texture = storage->texture_rd_get_default(RasterizerStorageRD::DEFAULT_RD_TEXTURE_WHITE);
@@ -125,7 +135,7 @@ RID RasterizerCanvasRD::_create_texture_binding(RID p_texture, RID p_normalmap,
 		RD::Uniform u;
 		u.type = RD::UNIFORM_TYPE_TEXTURE;
 		u.binding = 2;
-		RID texture = storage->texture_get_rd_texture(p_normalmap);
+		RID texture = p_rd_normalmap;
 		if (!texture.is_valid()) {
 			//use default normal texture
 			texture = storage->texture_rd_get_default(RasterizerStorageRD::DEFAULT_RD_TEXTURE_NORMAL);
@@ -138,7 +148,7 @@ RID RasterizerCanvasRD::_create_texture_binding(RID p_texture, RID p_normalmap,
 		RD::Uniform u;
 		u.type = RD::UNIFORM_TYPE_TEXTURE;
 		u.binding = 3;
-		RID texture = storage->texture_get_rd_texture(p_specular);
+		RID texture = p_rd_specular;
 		if (!texture.is_valid()) {
 			//use default white texture
 			texture = storage->texture_rd_get_default(RasterizerStorageRD::DEFAULT_RD_TEXTURE_WHITE);
@@ -496,6 +506,199 @@ Size2i RasterizerCanvasRD::_bind_texture_binding(TextureBindingID p_binding, RD:
 	}
 }
 
+int RasterizerCanvasRD::_texture_atlas_get_binding(TextureBindingID p_binding, Rect2i &r_rect) {
+
+	TextureBinding **texture_binding_ptr = bindings.texture_bindings.getptr(p_binding);
+	if (!texture_binding_ptr) {
+		return -1;
+	}
+	const TextureBindingKey &key = (*texture_binding_ptr)->key;
+
+	//the atlas only holds the color texture, and can't repeat
+	if (key.texture.is_null() || key.normalmap.is_valid() || key.specular.is_valid() || key.multimesh.is_valid()) {
+		return -1;
+	}
+	if (key.texture_repeat != RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED) {
+		return -1;
+	}
+	int filter_index;
+	if (key.texture_filter == RS::CANVAS_ITEM_TEXTURE_FILTER_NEAREST) {
+		filter_index = 0;
+	} else if (key.texture_filter == RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR) {
+		filter_index = 1;
+	} else {
+		return -1; //mipmapped filters need the original texture
+	}
+
+	RID rd_texture;
+	Size2i size;
+	uint32_t version;
+	if (!storage->texture_2d_get_atlas_source(key.texture, rd_texture, size, version)) {
+		return -1;
+	}
+	if (size.width > TEXTURE_ATLAS_MAX_TEXTURE_SIZE || size.height > TEXTURE_ATLAS_MAX_TEXTURE_SIZE) {
+		return -1;
+	}
+
+	uint64_t id = key.texture.get_id();
+	TextureAtlas::Entry *entry = texture_atlas.entries.getptr(id);
+
+	if (entry && entry->rect.size != size) {
+		//replaced by a texture of another size, its old space is reclaimed when the page is cleared
+		texture_atlas.entries.erase(id);
+		entry = NULL;
+	}
+
+	if (!entry) {
+		int page;
+		Point2i pos;
+		if (!_texture_atlas_allocate(size + Size2i(TEXTURE_ATLAS_PADDING * 2, TEXTURE_ATLAS_PADDING * 2), page, pos)) {
+			return -1;
+		}
+
+		TextureAtlas::Entry new_entry;
+		new_entry.page = page;
+		new_entry.rect = Rect2i(pos + Point2i(TEXTURE_ATLAS_PADDING, TEXTURE_ATLAS_PADDING), size);
+		new_entry.rd_texture = rd_texture;
+		new_entry.version = version;
+		entry = &texture_atlas.entries.set(id, new_entry)->value();
+
+		_texture_atlas_copy(rd_texture, *entry);
+
+	} else if (entry->rd_texture != rd_texture || entry->version != version) {
+		//contents changed, copy again in place
+		entry->rd_texture = rd_texture;
+		entry->version = version;
+		_texture_atlas_copy(rd_texture, *entry);
+	}
+
+	texture_atlas.pages[entry->page].last_used_frame = RasterizerRD::get_frame_number();
+	r_rect = entry->rect;
+
+	return entry->page * TEXTURE_ATLAS_FILTER_COUNT + filter_index;
+}
+
+bool RasterizerCanvasRD::_texture_atlas_allocate(const Size2i &p_size, int &r_page, Point2i &r_pos) {
+
+	for (int pass = 0; pass < 2; pass++) {
+
+		for (uint32_t i = 0; i < texture_atlas.pages.size(); i++) {
+			TextureAtlas::Page &page = texture_atlas.pages[i];
+
+			//shelf packing, use the first row tall enough with room left
+			for (uint32_t j = 0; j < page.shelves.size(); j++) {
+				TextureAtlas::Shelf &shelf = page.shelves[j];
+				if (shelf.height >= p_size.height && shelf.used_width + p_size.width <= TEXTURE_ATLAS_PAGE_SIZE) {
+					r_page = i;
+					r_pos = Point2i(shelf.used_width, shelf.y);
+					shelf.used_width += p_size.width;
+					return true;
+				}
+			}
+
+			if (page.used_height + p_size.height <= TEXTURE_ATLAS_PAGE_SIZE) {
+				TextureAtlas::Shelf shelf;
+				shelf.y = page.used_height;
+				shelf.height = p_size.height;
+				shelf.used_width = p_size.width;
+				page.shelves.push_back(shelf);
+				page.used_height += p_size.height;
+
+				r_page = i;
+				r_pos = Point2i(0, shelf.y);
+				return true;
+			}
+		}
+
+		if (pass > 0) {
+			break;
+		}
+
+		if (int(texture_atlas.pages.size()) < texture_atlas.max_pages) {
+
+			RD::TextureFormat tf;
+			tf.type = RD::TEXTURE_TYPE_2D;
+			tf.width = TEXTURE_ATLAS_PAGE_SIZE;
+			tf.height = TEXTURE_ATLAS_PAGE_SIZE;
+			tf.usage_bits = RD::TEXTURE_USAGE_SAMPLING_BIT | RD::TEXTURE_USAGE_CAN_COPY_TO_BIT;
+			tf.format = RD::DATA_FORMAT_R8G8B8A8_UNORM;
+
+			TextureAtlas::Page page;
+			page.texture = RD::get_singleton()->texture_create(tf, RD::TextureView());
+			ERR_FAIL_COND_V(page.texture.is_null(), false);
+			page.uniform_sets[0] = _create_texture_binding_uniform_set(page.texture, RID(), RID(), RS::CANVAS_ITEM_TEXTURE_FILTER_NEAREST, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED);
+			page.uniform_sets[1] = _create_texture_binding_uniform_set(page.texture, RID(), RID(), RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED);
+			texture_atlas.pages.push_back(page);
+
+		} else {
+
+			//out of pages, reuse the one unused for the longest time. Copies land before this frame's draws,
+			//so a page drawn from during this frame can't be overwritten.
+			uint64_t frame = RasterizerRD::get_frame_number();
+			int oldest = -1;
+			for (uint32_t i = 0; i < texture_atlas.pages.size(); i++) {
+				if (texture_atlas.pages[i].last_used_frame < frame && (oldest == -1 || texture_atlas.pages[i].last_used_frame < texture_atlas.pages[oldest].last_used_frame)) {
+					oldest = i;
+				}
+			}
+			if (oldest == -1) {
+				return false;
+			}
+			_texture_atlas_clear_page(oldest);
+		}
+	}
+
+	return false;
+}
+
+void RasterizerCanvasRD::_texture_atlas_copy(RID p_rd_texture, const TextureAtlas::Entry &p_entry) {
+
+	RID page = texture_atlas.pages[p_entry.page].texture;
+	const Point2i &pos = p_entry.rect.position;
+	const Size2i &size = p_entry.rect.size;
+
+	RD::get_singleton()->texture_copy(p_rd_texture, page, Vector3(), Vector3(pos.x, pos.y, 0), Vector3(size.width, size.height, 1), 0, 0, 0, 0);
+
+	//repeat the edges into the padding, same result as clamping when filtering
+	for (int i = 1; i <= TEXTURE_ATLAS_PADDING; i++) {
+		RD::get_singleton()->texture_copy(p_rd_texture, page, Vector3(0, 0, 0), Vector3(pos.x - i, pos.y, 0), Vector3(1, size.height, 1), 0, 0, 0, 0);
+		RD::get_singleton()->texture_copy(p_rd_texture, page, Vector3(size.width - 1, 0, 0), Vector3(pos.x + size.width - 1 + i, pos.y, 0), Vector3(1, size.height, 1), 0, 0, 0, 0);
+		RD::get_singleton()->texture_copy(p_rd_texture, page, Vector3(0, 0, 0), Vector3(pos.x, pos.y - i, 0), Vector3(size.width, 1, 1), 0, 0, 0, 0);
+		RD::get_singleton()->texture_copy(p_rd_texture, page, Vector3(0, size.height - 1, 0), Vector3(pos.x, pos.y + size.height - 1 + i, 0), Vector3(size.width, 1, 1), 0, 0, 0, 0);
+		for (int j = 1; j <= TEXTURE_ATLAS_PADDING; j++) {
+			RD::get_singleton()->texture_copy(p_rd_texture, page, Vector3(0, 0, 0), Vector3(pos.x - i, pos.y - j, 0), Vector3(1, 1, 1), 0, 0, 0, 0);
+			RD::get_singleton()->texture_copy(p_rd_texture, page, Vector3(size.width - 1, 0, 0), Vector3(pos.x + size.width - 1 + i, pos.y - j, 0), Vector3(1, 1, 1), 0, 0, 0, 0);
+			RD::get_singleton()->texture_copy(p_rd_texture, page, Vector3(0, size.height - 1, 0), Vector3(pos.x - i, pos.y + size.height - 1 + j, 0), Vector3(1, 1, 1), 0, 0, 0, 0);
+			RD::get_singleton()->texture_copy(p_rd_texture, page, Vector3(size.width - 1, size.height - 1, 0), Vector3(pos.x + size.width - 1 + i, pos.y + size.height - 1 + j, 0), Vector3(1, 1, 1), 0, 0, 0, 0);
+		}
+	}
+}
+
+void RasterizerCanvasRD::_texture_atlas_clear_page(int p_page) {
+
+	List<uint64_t> to_erase;
+	const uint64_t *K = NULL;
+	while ((K = texture_atlas.entries.next(K))) {
+		if (texture_atlas.entries[*K].page == p_page) {
+			to_erase.push_back(*K);
+		}
+	}
+	for (List<uint64_t>::Element *E = to_erase.front(); E; E = E->next()) {
+		texture_atlas.entries.erase(E->get());
+	}
+
+	TextureAtlas::Page &page = texture_atlas.pages[p_page];
+	page.shelves.clear();
+	page.used_height = 0;
+}
+
+Size2i RasterizerCanvasRD::_bind_texture_atlas(int p_atlas_binding, RD::DrawListID p_draw_list) {
+
+	const TextureAtlas::Page &page = texture_atlas.pages[p_atlas_binding / TEXTURE_ATLAS_FILTER_COUNT];
+	RD::get_singleton()->draw_list_bind_uniform_set(p_draw_list, page.uniform_sets[p_atlas_binding % TEXTURE_ATLAS_FILTER_COUNT], 0);
+	return Size2i(TEXTURE_ATLAS_PAGE_SIZE, TEXTURE_ATLAS_PAGE_SIZE);
+}
+
 ////////////////////
 void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_item, RD::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants) {
 
@@ -517,8 +720,8 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 	push_constant.color_texture_pixel_size[0] = 0;
 	push_constant.color_texture_pixel_size[1] = 0;
 
-	push_constant.pad[0] = 0;
-	push_constant.pad[1] = 0;
+	push_constant.batch_offset = 0;
+	push_constant.pad = 0;
 
 	push_constant.lights[0] = 0;
 	push_constant.lights[1] = 0;
@@ -574,6 +777,11 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 		base_flags |= light_count << FLAGS_LIGHT_COUNT_SHIFT;
 	}
 
+	if (light_count > 0) {
+		//lit items bind their own lights, so rects before them can't be drawn with the same state
+		_rect_batch_flush(p_draw_list, RECT_BATCH_BREAK_LIGHTING);
+	}
+
 	{
 
 		RID &canvas_item_state = light_count ? state_data->state_uniform_set_with_light : state_data->state_uniform_set;
@@ -618,6 +826,14 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 				}
 			}
 
+			{
+				RD::Uniform u;
+				u.type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+				u.binding = 7;
+				u.ids.push_back(rect_batch.buffer);
+				uniforms.push_back(u);
+			}
+
 			//validate and update lighs if they are being used
 
 			if (light_count > 0) {
@@ -706,26 +922,72 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 
 				const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
 
-				//bind pipeline
-				{
-					RID pipeline = pipeline_variants->variants[light_mode][PIPELINE_VARIANT_QUAD].get_render_pipeline(RD::INVALID_ID, p_framebuffer_format);
-					RD::get_singleton()->draw_list_bind_render_pipeline(p_draw_list, pipeline);
+				if (rect->specular_shininess.a < 0.999) {
+					push_constant.flags |= FLAGS_DEFAULT_SPECULAR_MAP_USED;
 				}
 
-				//bind textures
+				if (rect->flags & CANVAS_RECT_DISTANCE_FIELD) {
+					push_constant.flags |= FLAGS_USE_DISTANCE_FIELD;
+				}
 
-				Size2 texpixel_size;
-				{
-					texpixel_size = _bind_texture_binding(rect->texture_binding.binding_id, p_draw_list, push_constant.flags);
-					texpixel_size.x = 1.0 / texpixel_size.x;
-					texpixel_size.y = 1.0 / texpixel_size.y;
+				_update_specular_shininess(rect->specular_shininess, &push_constant.specular_shininess);
+
+				//clipped UVs need the source rect in the fragment shader, which is per draw
+				bool use_batch = rect_batch.enabled && light_count == 0 && !(rect->flags & CANVAS_RECT_CLIP_UV);
+
+				if (use_batch && rect_batch.frame_used == rect_batch.max_rects) {
+					//out of room for this frame, draw it on its own
+					_rect_batch_flush(p_draw_list, RECT_BATCH_BREAK_BUFFER_FULL);
+					use_batch = false;
 				}
 
-				if (rect->specular_shininess.a < 0.999) {
-					push_constant.flags |= FLAGS_DEFAULT_SPECULAR_MAP_USED;
+				//the atlas changes what UV means, so only the built-in shader can read from it
+				int atlas_binding = -1;
+				Rect2i atlas_rect;
+				if (use_batch && texture_atlas.enabled && pipeline_variants == &shader.pipeline_variants && !(rect->flags & CANVAS_RECT_DISTANCE_FIELD)) {
+					atlas_binding = _texture_atlas_get_binding(rect->texture_binding.binding_id, atlas_rect);
+					if (atlas_binding >= 0 && (rect->flags & CANVAS_RECT_REGION) && !Rect2(Point2(), atlas_rect.size).encloses(rect->source)) {
+						atlas_binding = -1; //region reads outside the texture, relies on clamping
+					}
 				}
 
-				_update_specular_shininess(rect->specular_shininess, &push_constant.specular_shininess);
+				if (rect_batch.count > 0) {
+					bool same_texture = atlas_binding >= 0 ? rect_batch.atlas_binding == atlas_binding : (rect_batch.atlas_binding < 0 && rect_batch.texture_binding == rect->texture_binding.binding_id);
+					if (!use_batch) {
+						_rect_batch_flush(p_draw_list, RECT_BATCH_BREAK_STATE);
+					} else if (!same_texture) {
+						_rect_batch_flush(p_draw_list, RECT_BATCH_BREAK_TEXTURE);
+					} else if (rect_batch.pipeline_variants != pipeline_variants || rect_batch.base_flags != push_constant.flags || rect_batch.specular_shininess != push_constant.specular_shininess) {
+						_rect_batch_flush(p_draw_list, RECT_BATCH_BREAK_STATE);
+					}
+				}
+
+				uint32_t base_rect_flags = push_constant.flags;
+
+				Size2 texpixel_size;
+
+				if (use_batch && rect_batch.count > 0) {
+					//pipeline and textures are the same as the rects before, already bound
+					texpixel_size = rect_batch.texpixel_size;
+				} else {
+					//bind pipeline
+					{
+						RID pipeline = pipeline_variants->variants[light_mode][PIPELINE_VARIANT_QUAD].get_render_pipeline(RD::INVALID_ID, p_framebuffer_format);
+						RD::get_singleton()->draw_list_bind_render_pipeline(p_draw_list, pipeline);
+					}
+
+					//bind textures
+
+					{
+						if (atlas_binding >= 0) {
+							texpixel_size = _bind_texture_atlas(atlas_binding, p_draw_list);
+						} else {
+							texpixel_size = _bind_texture_binding(rect->texture_binding.binding_id, p_draw_list, push_constant.flags);
+						}
+						texpixel_size.x = 1.0 / texpixel_size.x;
+						texpixel_size.y = 1.0 / texpixel_size.y;
+					}
+				}
 
 				Rect2 src_rect;
 				Rect2 dst_rect;
@@ -734,7 +996,12 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 					push_constant.color_texture_pixel_size[0] = texpixel_size.x;
 					push_constant.color_texture_pixel_size[1] = texpixel_size.y;
 
-					src_rect = (rect->flags & CANVAS_RECT_REGION) ? Rect2(rect->source.position * texpixel_size, rect->source.size * texpixel_size) : Rect2(0, 0, 1, 1);
+					if (atlas_binding >= 0) {
+						Rect2 region = (rect->flags & CANVAS_RECT_REGION) ? Rect2(rect->source.position + atlas_rect.position, rect->source.size) : Rect2(atlas_rect);
+						src_rect = Rect2(region.position * texpixel_size, region.size * texpixel_size);
+					} else {
+						src_rect = (rect->flags & CANVAS_RECT_REGION) ? Rect2(rect->source.position * texpixel_size, rect->source.size * texpixel_size) : Rect2(0, 0, 1, 1);
+					}
 					dst_rect = Rect2(rect->rect.position, rect->rect.size);
 
 					if (dst_rect.size.width < 0) {
@@ -778,6 +1045,47 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 					texpixel_size = Vector2(1, 1);
 				}
 
+				if (use_batch) {
+
+					if (rect_batch.count == 0) {
+						rect_batch.texture_binding = rect->texture_binding.binding_id;
+						rect_batch.atlas_binding = atlas_binding;
+						rect_batch.texpixel_size = texpixel_size;
+						rect_batch.pipeline_variants = pipeline_variants;
+						rect_batch.base_flags = base_rect_flags;
+						rect_batch.flags = push_constant.flags;
+						rect_batch.specular_shininess = push_constant.specular_shininess;
+						rect_batch.from = rect_batch.frame_used;
+					}
+
+					RectInstance instance;
+					for (int j = 0; j < 6; j++) {
+						instance.world[j] = push_constant.world[j];
+					}
+					instance.pad[0] = 0;
+					instance.pad[1] = 0;
+
+					instance.modulation[0] = rect->modulate.r * base_color.r;
+					instance.modulation[1] = rect->modulate.g * base_color.g;
+					instance.modulation[2] = rect->modulate.b * base_color.b;
+					instance.modulation[3] = rect->modulate.a * base_color.a;
+
+					instance.src_rect[0] = src_rect.position.x;
+					instance.src_rect[1] = src_rect.position.y;
+					instance.src_rect[2] = src_rect.size.width;
+					instance.src_rect[3] = src_rect.size.height;
+
+					instance.dst_rect[0] = dst_rect.position.x;
+					instance.dst_rect[1] = dst_rect.position.y;
+					instance.dst_rect[2] = dst_rect.size.width;
+					instance.dst_rect[3] = dst_rect.size.height;
+
+					rect_batch.pending.push_back(instance);
+					rect_batch.frame_used++;
+					rect_batch.count++;
+					break;
+				}
+
 				push_constant.modulation[0] = rect->modulate.r * base_color.r;
 				push_constant.modulation[1] = rect->modulate.g * base_color.g;
 				push_constant.modulation[2] = rect->modulate.b * base_color.b;
@@ -799,6 +1107,7 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 				RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 				RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
+				rect_batch.frame_stats.draw_calls++;
 
 			} break;
 
@@ -806,6 +1115,8 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 
 				const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(c);
 
+				_rect_batch_flush(p_draw_list, RECT_BATCH_BREAK_COMMAND);
+
 				//bind pipeline
 				{
 					RID pipeline = pipeline_variants->variants[light_mode][PIPELINE_VARIANT_NINEPATCH].get_render_pipeline(RD::INVALID_ID, p_framebuffer_format);
@@ -878,6 +1189,7 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 				RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 				RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
+				rect_batch.frame_stats.draw_calls++;
 
 			} break;
 			case Item::Command::TYPE_POLYGON: {
@@ -886,6 +1198,8 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 
 				PolygonBuffers *pb = polygon_buffers.polygons.getptr(polygon->polygon.polygon_id);
 				ERR_CONTINUE(!pb);
+
+				_rect_batch_flush(p_draw_list, RECT_BATCH_BREAK_COMMAND);
 				//bind pipeline
 				{
 					static const PipelineVariant variant[RS::PRIMITIVE_MAX] = { PIPELINE_VARIANT_ATTRIBUTE_POINTS, PIPELINE_VARIANT_ATTRIBUTE_LINES, PIPELINE_VARIANT_ATTRIBUTE_LINES_STRIP, PIPELINE_VARIANT_ATTRIBUTE_TRIANGLES, PIPELINE_VARIANT_ATTRIBUTE_TRIANGLE_STRIP };
@@ -934,12 +1248,15 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 					RD::get_singleton()->draw_list_bind_index_array(p_draw_list, pb->indices);
 				}
 				RD::get_singleton()->draw_list_draw(p_draw_list, pb->indices.is_valid());
+				rect_batch.frame_stats.draw_calls++;
 
 			} break;
 			case Item::Command::TYPE_PRIMITIVE: {
 
 				const Item::CommandPrimitive *primitive = static_cast<const Item::CommandPrimitive *>(c);
 
+				_rect_batch_flush(p_draw_list, RECT_BATCH_BREAK_COMMAND);
+
 				//bind pipeline
 				{
 					static const PipelineVariant variant[4] = { PIPELINE_VARIANT_PRIMITIVE_POINTS, PIPELINE_VARIANT_PRIMITIVE_LINES, PIPELINE_VARIANT_PRIMITIVE_TRIANGLES, PIPELINE_VARIANT_PRIMITIVE_TRIANGLES };
@@ -973,6 +1290,7 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 				}
 				RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
+				rect_batch.frame_stats.draw_calls++;
 
 				if (primitive->point_count == 4) {
 					for (uint32_t j = 1; j < 3; j++) {
@@ -988,6 +1306,7 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 
 					RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
 					RD::get_singleton()->draw_list_draw(p_draw_list, true);
+					rect_batch.frame_stats.draw_calls++;
 				}
 
 			} break;
@@ -1295,6 +1614,8 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 
 					if (ci->ignore != reclip) {
 
+						_rect_batch_flush(p_draw_list, RECT_BATCH_BREAK_CLIP);
+
 						if (ci->ignore) {
 							RD::get_singleton()->draw_list_disable_scissor(p_draw_list);
 							reclip = true;
@@ -1354,6 +1675,8 @@ void RasterizerCanvasRD::_render_items(RID p_to_render_target, int p_item_count,
 
 		if (current_clip != ci->final_clip_owner) {
 
+			_rect_batch_flush(draw_list, RECT_BATCH_BREAK_CLIP);
+
 			current_clip = ci->final_clip_owner;
 
 			//setup clip
@@ -1369,6 +1692,8 @@ void RasterizerCanvasRD::_render_items(RID p_to_render_target, int p_item_count,
 
 		if (ci->material != prev_material) {
 
+			_rect_batch_flush(draw_list, RECT_BATCH_BREAK_MATERIAL);
+
 			MaterialData *material_data = NULL;
 			if (ci->material.is_valid()) {
 				material_data = (MaterialData *)storage->material_get_data(ci->material, RasterizerStorageRD::SHADER_TYPE_2D);
@@ -1394,7 +1719,58 @@ void RasterizerCanvasRD::_render_items(RID p_to_render_target, int p_item_count,
 		prev_material = ci->material;
 	}
 
+	_rect_batch_flush(draw_list, RECT_BATCH_BREAK_NONE);
+
 	RD::get_singleton()->draw_list_end();
+
+	_rect_batch_upload();
+}
+
+void RasterizerCanvasRD::_rect_batch_flush(RD::DrawListID p_draw_list, RectBatchBreak p_reason) {
+
+	if (rect_batch.count == 0) {
+		return;
+	}
+
+	PushConstant push_constant;
+	memset(&push_constant, 0, sizeof(PushConstant));
+
+	//the shader takes the transform of each rect from the buffer, this one is only used by fragment code reading it
+	const RectInstance &first = rect_batch.pending[rect_batch.from - rect_batch.upload_from];
+	for (int i = 0; i < 6; i++) {
+		push_constant.world[i] = first.world[i];
+	}
+
+	push_constant.flags = rect_batch.flags | FLAGS_USE_RECT_BATCH;
+	push_constant.specular_shininess = rect_batch.specular_shininess;
+	push_constant.batch_offset = rect_batch.from;
+	push_constant.color_texture_pixel_size[0] = rect_batch.texpixel_size.x;
+	push_constant.color_texture_pixel_size[1] = rect_batch.texpixel_size.y;
+
+	RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
+	RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
+	RD::get_singleton()->draw_list_draw(p_draw_list, true, rect_batch.count);
+
+	rect_batch.frame_stats.draw_calls++;
+	rect_batch.frame_stats.batches++;
+	rect_batch.frame_stats.batched_rects += rect_batch.count;
+	rect_batch.frame_stats.breaks[p_reason]++;
+
+	rect_batch.count = 0;
+}
+
+void RasterizerCanvasRD::_rect_batch_upload() {
+
+	if (rect_batch.pending.size() == 0) {
+		return;
+	}
+
+	//not synced with draw, so it lands at the beginning of the frame, before any draw list using it.
+	//regions are never written twice in a frame
+	RD::get_singleton()->buffer_update(rect_batch.buffer, rect_batch.upload_from * sizeof(RectInstance), rect_batch.pending.size() * sizeof(RectInstance), rect_batch.pending.ptr());
+
+	rect_batch.upload_from = rect_batch.frame_used;
+	rect_batch.pending.clear();
 }
 
 void RasterizerCanvasRD::canvas_render_items(RID p_to_render_target, Item *p_item_list, const Color &p_modulate, Light *p_light_list, const Transform2D &p_canvas_transform) {
@@ -1569,6 +1945,8 @@ RID RasterizerCanvasRD::light_create() {
 
 	CanvasLight canvas_light;
 	canvas_light.shadow.size = 0;
+	canvas_light.shadow.cache_valid = false;
+	canvas_light.shadow.cache_hash = 0;
 	return canvas_light_owner.make_rid(canvas_light);
 }
 
@@ -1630,13 +2008,59 @@ void RasterizerCanvasRD::light_set_use_shadow(RID p_rid, bool p_enable, int p_re
 	}
 
 	cl->shadow.size = p_resolution;
+	cl->shadow.cache_valid = false;
+}
+
+static _FORCE_INLINE_ uint64_t _hash_transform_2d(const Transform2D &p_xform, uint64_t p_prev) {
+	uint64_t h = p_prev;
+	for (int i = 0; i < 3; i++) {
+		h = hash_djb2_one_64(make_uint64_t(p_xform.elements[i].x), h);
+		h = hash_djb2_one_64(make_uint64_t(p_xform.elements[i].y), h);
+	}
+	return h;
 }
 
 void RasterizerCanvasRD::light_update_shadow(RID p_rid, const Transform2D &p_light_xform, int p_light_mask, float p_near, float p_far, LightOccluderInstance *p_occluders) {
 
 	CanvasLight *cl = canvas_light_owner.getornull(p_rid);
+	ERR_FAIL_COND(!cl);
 	ERR_FAIL_COND(cl->shadow.texture.is_null());
 
+	//keep only the occluders that can cast into this light, and hash them along with the light
+	shadow_occluders.clear();
+
+	Rect2 light_rect(-p_far, -p_far, p_far * 2.0, p_far * 2.0);
+	uint64_t hash = _hash_transform_2d(p_light_xform, 5381);
+	hash = hash_djb2_one_64(make_uint64_t(p_light_mask), hash);
+	hash = hash_djb2_one_64(make_uint64_t(p_near), hash);
+	hash = hash_djb2_one_64(make_uint64_t(p_far), hash);
+
+	for (LightOccluderInstance *instance = p_occluders; instance; instance = instance->next) {
+
+		OccluderPolygon *co = occluder_polygon_owner.getornull(instance->occluder);
+
+		if (!co || co->index_array.is_null() || !(p_light_mask & instance->light_mask)) {
+			continue;
+		}
+
+		if (!light_rect.intersects_transformed(p_light_xform * instance->xform_cache, instance->aabb_cache)) {
+			continue;
+		}
+
+		shadow_occluders.push_back(instance);
+
+		hash = hash_djb2_one_64(instance->occluder.get_id(), hash);
+		hash = hash_djb2_one_64(co->version, hash);
+		hash = _hash_transform_2d(instance->xform_cache, hash);
+	}
+
+	if (cl->shadow.cache_valid && cl->shadow.cache_hash == hash) {
+		return; //nothing affecting this light changed, the shadow map is still good
+	}
+
+	cl->shadow.cache_valid = true;
+	cl->shadow.cache_hash = hash;
+
 	for (int i = 0; i < 4; i++) {
 
 		//make sure it remains orthogonal, makes easy to read angle later
@@ -1680,18 +2104,11 @@ void RasterizerCanvasRD::light_update_shadow(RID p_rid, const Transform2D &p_lig
 		/*if (i == 0)
 			*p_xform_cache = projection;*/
 
-		LightOccluderInstance *instance = p_occluders;
-
-		while (instance) {
+		for (uint32_t j = 0; j < shadow_occluders.size(); j++) {
 
+			LightOccluderInstance *instance = shadow_occluders[j];
 			OccluderPolygon *co = occluder_polygon_owner.getornull(instance->occluder);
 
-			if (!co || co->index_array.is_null() || !(p_light_mask & instance->light_mask)) {
-
-				instance = instance->next;
-				continue;
-			}
-
 			_update_transform_2d_to_mat2x4(p_light_xform * instance->xform_cache, push_constant.modelview);
 
 			RD::get_singleton()->draw_list_bind_render_pipeline(draw_list, shadow_render.render_pipelines[co->cull_mode]);
@@ -1700,8 +2117,6 @@ void RasterizerCanvasRD::light_update_shadow(RID p_rid, const Transform2D &p_lig
 			RD::get_singleton()->draw_list_set_push_constant(draw_list, &push_constant, sizeof(ShadowRenderPushConstant));
 
 			RD::get_singleton()->draw_list_draw(draw_list, true);
-
-			instance = instance->next;
 		}
 
 		RD::get_singleton()->draw_list_end();
@@ -1713,6 +2128,7 @@ RID RasterizerCanvasRD::occluder_polygon_create() {
 	OccluderPolygon occluder;
 	occluder.point_count = 0;
 	occluder.cull_mode = RS::CANVAS_OCCLUDER_POLYGON_CULL_DISABLED;
+	occluder.version = 0;
 	return occluder_polygon_owner.make_rid(occluder);
 }
 
@@ -1721,6 +2137,8 @@ void RasterizerCanvasRD::occluder_polygon_set_shape_as_lines(RID p_occluder, con
 	OccluderPolygon *oc = occluder_polygon_owner.getornull(p_occluder);
 	ERR_FAIL_COND(!oc);
 
+	oc->version++;
+
 	if (oc->point_count != p_lines.size() && oc->vertex_array.is_valid()) {
 
 		RD::get_singleton()->free(oc->vertex_array);
@@ -1809,6 +2227,7 @@ void RasterizerCanvasRD::occluder_polygon_set_cull_mode(RID p_occluder, RS::Canv
 	OccluderPolygon *oc = occluder_polygon_owner.getornull(p_occluder);
 	ERR_FAIL_COND(!oc);
 	oc->cull_mode = p_mode;
+	oc->version++;
 }
 
 void RasterizerCanvasRD::ShaderData::set_code(const String &p_code) {
@@ -2195,8 +2614,56 @@ void RasterizerCanvasRD::set_time(double p_time) {
 	state.time = p_time;
 }
 
+int RasterizerCanvasRD::get_render_info(RS::RenderInfo p_info) {
+
+	const RectBatchStats &stats = rect_batch.last_frame_stats;
+
+	switch (p_info) {
+		case RS::INFO_2D_DRAW_CALLS_IN_FRAME: {
+			return stats.draw_calls;
+		} break;
+		case RS::INFO_2D_BATCHES_IN_FRAME: {
+			return stats.batches;
+		} break;
+		case RS::INFO_2D_BATCHED_RECTS_IN_FRAME: {
+			return stats.batched_rects;
+		} break;
+		case RS::INFO_2D_BATCH_BREAKS_TEXTURE: {
+			return stats.breaks[RECT_BATCH_BREAK_TEXTURE];
+		} break;
+		case RS::INFO_2D_BATCH_BREAKS_MATERIAL: {
+			return stats.breaks[RECT_BATCH_BREAK_MATERIAL];
+		} break;
+		case RS::INFO_2D_BATCH_BREAKS_CLIP: {
+			return stats.breaks[RECT_BATCH_BREAK_CLIP];
+		} break;
+		case RS::INFO_2D_BATCH_BREAKS_LIGHTING: {
+			return stats.breaks[RECT_BATCH_BREAK_LIGHTING];
+		} break;
+		case RS::INFO_2D_BATCH_BREAKS_STATE: {
+			return stats.breaks[RECT_BATCH_BREAK_STATE];
+		} break;
+		case RS::INFO_2D_BATCH_BREAKS_COMMAND: {
+			return stats.breaks[RECT_BATCH_BREAK_COMMAND];
+		} break;
+		case RS::INFO_2D_BATCH_BREAKS_BUFFER_FULL: {
+			return stats.breaks[RECT_BATCH_BREAK_BUFFER_FULL];
+		} break;
+		default: {
+		}
+	}
+
+	return 0;
+}
+
 void RasterizerCanvasRD::update() {
 	_dispose_bindings();
+
+	//called once all viewports were drawn, the batch buffer can be filled from the start again
+	rect_batch.last_frame_stats = rect_batch.frame_stats;
+	rect_batch.frame_stats = RectBatchStats();
+	rect_batch.frame_used = 0;
+	rect_batch.upload_from = 0;
 }
 
 RasterizerCanvasRD::RasterizerCanvasRD(RasterizerStorageRD *p_storage) {
@@ -2474,6 +2941,20 @@ RasterizerCanvasRD::RasterizerCanvasRD(RasterizerStorageRD *p_storage) {
 		shader.default_skeleton_texture_buffer = RD::get_singleton()->texture_buffer_create(32, RD::DATA_FORMAT_R32G32B32A32_SFLOAT);
 	}
 
+	{ //rect batching
+
+		rect_batch.enabled = GLOBAL_GET("rendering/quality/2d/use_batching");
+		rect_batch.max_rects = MAX(1, int(GLOBAL_GET("rendering/quality/2d/batching_max_rects")));
+		//always created, the item state uniform sets refer to it
+		rect_batch.buffer = RD::get_singleton()->storage_buffer_create(sizeof(RectInstance) * rect_batch.max_rects);
+	}
+
+	{ //texture atlas, only used by batched rects
+
+		texture_atlas.enabled = rect_batch.enabled && bool(GLOBAL_GET("rendering/quality/2d/use_texture_atlas"));
+		texture_atlas.max_pages = MAX(1, int(GLOBAL_GET("rendering/quality/2d/texture_atlas_max_pages")));
+	}
+
 	//create functions for shader and material
 	storage->shader_set_data_request_function(RasterizerStorageRD::SHADER_TYPE_2D, _create_shader_funcs);
 	storage->material_set_data_request_function(RasterizerStorageRD::SHADER_TYPE_2D, _create_material_funcs);
@@ -2552,6 +3033,13 @@ RasterizerCanvasRD::~RasterizerCanvasRD() {
 		RD::get_singleton()->free(shader.quad_index_array);
 		RD::get_singleton()->free(shader.quad_index_buffer);
 		//primitives are erase by dependency
+
+		RD::get_singleton()->free(rect_batch.buffer);
+
+		//page uniform sets are erased by dependency
+		for (uint32_t i = 0; i < texture_atlas.pages.size(); i++) {
+			RD::get_singleton()->free(texture_atlas.pages[i].texture);
+		}
 	}
 
 	//pipelines don't need freeing, they are all gone after shaders are gone
@@ -31,6 +31,7 @@
 #ifndef RASTERIZER_CANVAS_RD_H
 #define RASTERIZER_CANVAS_RD_H
 
+#include "core/local_vector.h"
 #include "servers/rendering/rasterizer.h"
 #include "servers/rendering/rasterizer_rd/rasterizer_storage_rd.h"
 #include "servers/rendering/rasterizer_rd/render_pipeline_vertex_format_cache_rd.h"
@@ -81,7 +82,10 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 		FLAGS_LIGHT_COUNT_SHIFT = 20,
 
 		FLAGS_DEFAULT_NORMAL_MAP_USED = (1 << 26),
-		FLAGS_DEFAULT_SPECULAR_MAP_USED = (1 << 27)
+		FLAGS_DEFAULT_SPECULAR_MAP_USED = (1 << 27),
+
+		FLAGS_USE_RECT_BATCH = (1 << 28),
+		FLAGS_USE_DISTANCE_FIELD = (1 << 29)
 
 	};
 
@@ -270,6 +274,7 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 	} bindings;
 
 	RID _create_texture_binding(RID p_texture, RID p_normalmap, RID p_specular, RenderingServer::CanvasItemTextureFilter p_filter, RenderingServer::CanvasItemTextureRepeat p_repeat, RID p_multimesh);
+	RID _create_texture_binding_uniform_set(RID p_rd_texture, RID p_rd_normalmap, RID p_rd_specular, RenderingServer::CanvasItemTextureFilter p_filter, RenderingServer::CanvasItemTextureRepeat p_repeat);
 	void _dispose_bindings();
 
 	struct {
@@ -277,6 +282,55 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 		RS::CanvasItemTextureRepeat default_repeat;
 	} default_samplers;
 
+	/***********************/
+	/**** TEXTURE ATLAS ****/
+	/***********************/
+
+	// Small textures drawn by batched rects are copied into shared pages the first time they are drawn,
+	// so rects using different textures can still be drawn together.
+
+	enum {
+		TEXTURE_ATLAS_PAGE_SIZE = 2048,
+		TEXTURE_ATLAS_MAX_TEXTURE_SIZE = 256,
+		TEXTURE_ATLAS_PADDING = 1, //edge pixels are repeated around each texture, so linear filtering does not bleed
+		TEXTURE_ATLAS_FILTER_COUNT = 2, //only nearest and linear, pages have no mipmaps
+	};
+
+	struct TextureAtlas {
+
+		struct Shelf {
+			int y = 0;
+			int height = 0;
+			int used_width = 0;
+		};
+
+		struct Page {
+			RID texture;
+			RID uniform_sets[TEXTURE_ATLAS_FILTER_COUNT];
+			LocalVector<Shelf> shelves;
+			int used_height = 0;
+			uint64_t last_used_frame = 0;
+		};
+
+		struct Entry {
+			int page = 0;
+			Rect2i rect; //without padding
+			RID rd_texture;
+			uint32_t version = 0;
+		};
+
+		bool enabled = false;
+		int max_pages = 0;
+		LocalVector<Page> pages;
+		HashMap<uint64_t, Entry> entries; //by texture RID id
+	} texture_atlas;
+
+	int _texture_atlas_get_binding(TextureBindingID p_binding, Rect2i &r_rect);
+	bool _texture_atlas_allocate(const Size2i &p_size, int &r_page, Point2i &r_pos);
+	void _texture_atlas_copy(RID p_rd_texture, const TextureAtlas::Entry &p_entry);
+	void _texture_atlas_clear_page(int p_page);
+	Size2i _bind_texture_atlas(int p_atlas_binding, RenderingDevice::DrawListID p_draw_list);
+
 	/******************/
 	/**** POLYGONS ****/
 	/******************/
@@ -318,6 +372,9 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 			RID texture;
 			RID depth;
 			RID fb;
+			//hash of everything the last render depended on, the shadow map is only redrawn when it changes
+			bool cache_valid;
+			uint64_t cache_hash;
 		} shadow;
 	};
 
@@ -338,8 +395,11 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 		RID vertex_array;
 		RID index_buffer;
 		RID index_array;
+		uint64_t version; //increased every time the shape or cull mode changes
 	};
 
+	LocalVector<LightOccluderInstance *> shadow_occluders;
+
 	struct LightUniform {
 		float matrix[8]; //light to texture coordinate matrix
 		float shadow_matrix[8]; //light to shadow coordinate matrix
@@ -437,7 +497,8 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 				float ninepatch_margins[4];
 				float dst_rect[4];
 				float src_rect[4];
-				float pad[2];
+				uint32_t batch_offset; //first rect in the batch buffer, when FLAGS_USE_RECT_BATCH is set
+				uint32_t pad;
 			};
 			//primitive
 			struct {
@@ -455,6 +516,66 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 		float skeleton_inverse[16];
 	};
 
+	/********************/
+	/**** RECT BATCH ****/
+	/********************/
+
+	//consecutive rects sharing texture, material and state are drawn as instances of a single quad,
+	//reading what changes between them from a storage buffer filled during the frame
+
+	struct RectInstance {
+		float world[6];
+		uint32_t pad[2];
+		float modulation[4];
+		float dst_rect[4];
+		float src_rect[4];
+	};
+
+	enum RectBatchBreak {
+		RECT_BATCH_BREAK_NONE,
+		RECT_BATCH_BREAK_TEXTURE,
+		RECT_BATCH_BREAK_MATERIAL,
+		RECT_BATCH_BREAK_CLIP,
+		RECT_BATCH_BREAK_LIGHTING,
+		RECT_BATCH_BREAK_STATE,
+		RECT_BATCH_BREAK_COMMAND,
+		RECT_BATCH_BREAK_BUFFER_FULL,
+		RECT_BATCH_BREAK_MAX
+	};
+
+	struct RectBatchStats {
+		uint32_t draw_calls = 0;
+		uint32_t batches = 0;
+		uint32_t batched_rects = 0;
+		uint32_t breaks[RECT_BATCH_BREAK_MAX] = {};
+	};
+
+	struct {
+		bool enabled = false;
+		RID buffer;
+		uint32_t max_rects = 0;
+		uint32_t frame_used = 0; //rects written this frame, regions are never reused within a frame
+		uint32_t upload_from = 0;
+		LocalVector<RectInstance> pending; //rects not uploaded yet, starting at upload_from
+
+		//batch being recorded
+		TextureBindingID texture_binding = 0;
+		int atlas_binding = -1; //page * TEXTURE_ATLAS_FILTER_COUNT + filter when drawing from the texture atlas
+		Size2 texpixel_size;
+		PipelineVariants *pipeline_variants = nullptr;
+		uint32_t base_flags = 0; //flags before binding the texture, to compare with the next rect
+		uint32_t flags = 0;
+		uint32_t specular_shininess = 0;
+		uint32_t from = 0;
+		uint32_t count = 0;
+
+		RectBatchStats frame_stats;
+		RectBatchStats last_frame_stats;
+	} rect_batch;
+
+	void _rect_batch_flush(RenderingDevice::DrawListID p_draw_list, RectBatchBreak p_reason);
+	void _rect_batch_upload();
+
 	Item *items[MAX_RENDER_ITEMS];
 
 	Size2i _bind_texture_binding(TextureBindingID p_binding, RenderingDevice::DrawListID p_draw_list, uint32_t &flags);
@@ -492,6 +613,7 @@ public:
 	void draw_window_margins(int *p_margins, RID *p_margin_textures) {}
 
 	void set_time(double p_time);
+	int get_render_info(RS::RenderInfo p_info);
 	void update();
 	bool free(RID p_rid);
 	RasterizerCanvasRD(RasterizerStorageRD *p_storage);
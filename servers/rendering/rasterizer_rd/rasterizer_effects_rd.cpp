@@ -250,6 +250,43 @@ void RasterizerEffectsRD::gaussian_glow(RID p_source_rd_texture, RID p_framebuff
 	RD::get_singleton()->draw_list_end();
 }
 
+void RasterizerEffectsRD::gaussian_glow_compute(RID p_source_rd_texture, RID p_dest_texture, const Size2i &p_size, float p_strength, bool p_first_pass, float p_luminance_cap, float p_exposure, float p_bloom, float p_hdr_bleed_treshold, float p_hdr_bleed_scale, RID p_auto_exposure, float p_auto_exposure_grey) {
+
+	zeromem(&glow.push_constant, sizeof(GlowPushConstant));
+
+	bool use_auto_exposure = p_first_pass && p_auto_exposure.is_valid();
+	GlowMode glow_mode = use_auto_exposure ? GLOW_MODE_GAUSSIAN_AUTO_EXPOSURE : GLOW_MODE_GAUSSIAN;
+
+	glow.push_constant.size[0] = p_size.x;
+	glow.push_constant.size[1] = p_size.y;
+	glow.push_constant.pixel_size[0] = 1.0 / p_size.x;
+	glow.push_constant.pixel_size[1] = 1.0 / p_size.y;
+
+	glow.push_constant.glow_strength = p_strength;
+	glow.push_constant.glow_bloom = p_bloom;
+	glow.push_constant.glow_hdr_threshold = p_hdr_bleed_treshold;
+	glow.push_constant.glow_hdr_scale = p_hdr_bleed_scale;
+	glow.push_constant.glow_exposure = p_exposure;
+	glow.push_constant.glow_luminance_cap = p_luminance_cap;
+	glow.push_constant.glow_auto_exposure_grey = p_auto_exposure_grey;
+	glow.push_constant.first_pass = p_first_pass;
+
+	RD::ComputeListID compute_list = RD::get_singleton()->compute_list_begin();
+	RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, glow.pipelines[glow_mode]);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, _get_compute_uniform_set_from_texture(p_source_rd_texture), 0);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, _get_uniform_set_from_image(p_dest_texture), 1);
+	if (use_auto_exposure) {
+		RD::get_singleton()->compute_list_bind_uniform_set(compute_list, _get_compute_uniform_set_from_texture(p_auto_exposure), 2);
+	}
+	RD::get_singleton()->compute_list_set_push_constant(compute_list, &glow.push_constant, sizeof(GlowPushConstant));
+
+	int32_t x_groups = (p_size.x - 1) / 8 + 1;
+	int32_t y_groups = (p_size.y - 1) / 8 + 1;
+
+	RD::get_singleton()->compute_list_dispatch(compute_list, x_groups, y_groups, 1);
+	RD::get_singleton()->compute_list_end();
+}
+
 void RasterizerEffectsRD::make_mipmap(RID p_source_rd_texture, RID p_dest_framebuffer, const Vector2 &p_pixel_size) {
 
 	zeromem(&blur.push_constant, sizeof(BlurPushConstant));
@@ -309,6 +346,10 @@ void RasterizerEffectsRD::tonemapper(RID p_source_color, RID p_dst_framebuffer,
 
 	tonemap.push_constant.use_color_correction = p_settings.use_color_correction;
 
+	tonemap.push_constant.use_upscale = p_settings.use_upscale;
+	tonemap.push_constant.source_size[0] = p_settings.source_size.x;
+	tonemap.push_constant.source_size[1] = p_settings.source_size.y;
+
 	RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(p_dst_framebuffer, RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_DISCARD);
 	RD::get_singleton()->draw_list_bind_render_pipeline(draw_list, tonemap.pipelines[mode].get_render_pipeline(RD::INVALID_ID, RD::get_singleton()->framebuffer_get_format(p_dst_framebuffer)));
 	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, _get_uniform_set_from_texture(p_source_color), 0);
@@ -707,6 +748,93 @@ void RasterizerEffectsRD::roughness_limit(RID p_source_normal, RID p_roughness,
 	RD::get_singleton()->compute_list_end();
 }
 
+void RasterizerEffectsRD::occlusion_build_hiz(RID p_depth_texture, const Size2i &p_depth_size, const Vector<RID> &p_hiz_mipmaps) {
+
+	occlusion.hiz_push_constant.source_size[0] = p_depth_size.x;
+	occlusion.hiz_push_constant.source_size[1] = p_depth_size.y;
+
+	RD::ComputeListID compute_list = RD::get_singleton()->compute_list_begin();
+
+	for (int i = 0; i < p_hiz_mipmaps.size(); i++) {
+
+		if (i == 0) {
+			RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, occlusion.pipelines[OCCLUSION_HIZ_FIRST]);
+			RD::get_singleton()->compute_list_bind_uniform_set(compute_list, _get_compute_uniform_set_from_texture(p_depth_texture), 0);
+		} else {
+			if (i == 1) {
+				RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, occlusion.pipelines[OCCLUSION_HIZ_REDUCE]);
+			}
+
+			RD::get_singleton()->compute_list_bind_uniform_set(compute_list, _get_uniform_set_from_image(p_hiz_mipmaps[i - 1]), 0);
+		}
+		RD::get_singleton()->compute_list_bind_uniform_set(compute_list, _get_uniform_set_from_image(p_hiz_mipmaps[i]), 1);
+
+		occlusion.hiz_push_constant.dest_size[0] = MAX(1, occlusion.hiz_push_constant.source_size[0] >> 1);
+		occlusion.hiz_push_constant.dest_size[1] = MAX(1, occlusion.hiz_push_constant.source_size[1] >> 1);
+
+		RD::get_singleton()->compute_list_set_push_constant(compute_list, &occlusion.hiz_push_constant, sizeof(OcclusionHiZPushConstant));
+
+		int x_groups = (occlusion.hiz_push_constant.dest_size[0] - 1) / 8 + 1;
+		int y_groups = (occlusion.hiz_push_constant.dest_size[1] - 1) / 8 + 1;
+
+		RD::get_singleton()->compute_list_dispatch(compute_list, x_groups, y_groups, 1);
+		RD::get_singleton()->compute_list_add_barrier(compute_list);
+
+		// shrink after dispatch
+		occlusion.hiz_push_constant.source_size[0] = occlusion.hiz_push_constant.dest_size[0];
+		occlusion.hiz_push_constant.source_size[1] = occlusion.hiz_push_constant.dest_size[1];
+	}
+
+	RD::get_singleton()->compute_list_end();
+}
+
+void RasterizerEffectsRD::occlusion_cull(RID p_hiz_texture, const Size2i &p_hiz_size, int p_hiz_levels, RID p_instance_buffer, RID p_visibility_buffer, uint32_t p_instance_count, const CameraMatrix &p_view_projection) {
+
+	RID buffers_uniform_set;
+	if (occlusion_buffers_uniform_set_cache.has(p_instance_buffer)) {
+		buffers_uniform_set = occlusion_buffers_uniform_set_cache[p_instance_buffer];
+	}
+
+	if (!RD::get_singleton()->uniform_set_is_valid(buffers_uniform_set)) {
+		Vector<RD::Uniform> uniforms;
+		{
+			RD::Uniform u;
+			u.type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 0;
+			u.ids.push_back(p_instance_buffer);
+			uniforms.push_back(u);
+		}
+		{
+			RD::Uniform u;
+			u.type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 1;
+			u.ids.push_back(p_visibility_buffer);
+			uniforms.push_back(u);
+		}
+		//both buffers are always reallocated together, so the instance buffer is enough as key
+		buffers_uniform_set = RD::get_singleton()->uniform_set_create(uniforms, occlusion.shader.version_get_shader(occlusion.shader_version, OCCLUSION_CULL), 1);
+		occlusion_buffers_uniform_set_cache[p_instance_buffer] = buffers_uniform_set;
+	}
+
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			occlusion.cull_push_constant.view_projection[i * 4 + j] = p_view_projection.matrix[i][j];
+		}
+	}
+	occlusion.cull_push_constant.hiz_size[0] = p_hiz_size.x;
+	occlusion.cull_push_constant.hiz_size[1] = p_hiz_size.y;
+	occlusion.cull_push_constant.hiz_levels = p_hiz_levels;
+	occlusion.cull_push_constant.instance_count = p_instance_count;
+
+	RD::ComputeListID compute_list = RD::get_singleton()->compute_list_begin();
+	RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, occlusion.pipelines[OCCLUSION_CULL]);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, _get_compute_uniform_set_from_texture(p_hiz_texture, true), 0);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, buffers_uniform_set, 1);
+	RD::get_singleton()->compute_list_set_push_constant(compute_list, &occlusion.cull_push_constant, sizeof(OcclusionCullPushConstant));
+	RD::get_singleton()->compute_list_dispatch(compute_list, (p_instance_count - 1) / 64 + 1, 1, 1);
+	RD::get_singleton()->compute_list_end();
+}
+
 void RasterizerEffectsRD::cubemap_roughness(RID p_source_rd_texture, RID p_dest_framebuffer, uint32_t p_face_id, uint32_t p_sample_count, float p_roughness, float p_size) {
 
 	zeromem(&roughness.push_constant, sizeof(CubemapRoughnessPushConstant));
@@ -889,6 +1017,21 @@ RasterizerEffectsRD::RasterizerEffectsRD() {
 		}
 	}
 
+	{
+		// Initialize glow
+		Vector<String> glow_modes;
+		glow_modes.push_back("\n");
+		glow_modes.push_back("\n#define GLOW_USE_AUTO_EXPOSURE\n");
+
+		glow.shader.initialize(glow_modes);
+
+		glow.shader_version = glow.shader.version_create();
+
+		for (int i = 0; i < GLOW_MODE_MAX; i++) {
+			glow.pipelines[i] = RD::get_singleton()->compute_pipeline_create(glow.shader.version_get_shader(glow.shader_version, i));
+		}
+	}
+
 	{
 		// Initialize copier
 		Vector<String> copy_modes;
@@ -989,6 +1132,22 @@ RasterizerEffectsRD::RasterizerEffectsRD() {
 		roughness_limiter.pipeline = RD::get_singleton()->compute_pipeline_create(roughness_limiter.shader.version_get_shader(roughness_limiter.shader_version, 0));
 	}
 
+	{
+		// Initialize occlusion culling
+		Vector<String> occlusion_modes;
+		occlusion_modes.push_back("\n#define MODE_HIZ_FIRST\n");
+		occlusion_modes.push_back("\n");
+		occlusion_modes.push_back("\n#define MODE_CULL\n");
+
+		occlusion.shader.initialize(occlusion_modes);
+
+		occlusion.shader_version = occlusion.shader.version_create();
+
+		for (int i = 0; i < OCCLUSION_MAX; i++) {
+			occlusion.pipelines[i] = RD::get_singleton()->compute_pipeline_create(occlusion.shader.version_get_shader(occlusion.shader_version, i));
+		}
+	}
+
 	{
 		//Initialize cubemap downsampler
 		Vector<String> cubemap_downsampler_modes;
@@ -1083,12 +1242,14 @@ RasterizerEffectsRD::~RasterizerEffectsRD() {
 	roughness.shader.version_free(roughness.shader_version);
 	tonemap.shader.version_free(tonemap.shader_version);
 	luminance_reduce.shader.version_free(luminance_reduce.shader_version);
+	glow.shader.version_free(glow.shader_version);
 	copy.shader.version_free(copy.shader_version);
 	bokeh.shader.version_free(bokeh.shader_version);
 	ssao.minify_shader.version_free(ssao.minify_shader_version);
 	ssao.gather_shader.version_free(ssao.gather_shader_version);
 	ssao.blur_shader.version_free(ssao.blur_shader_version);
 	roughness_limiter.shader.version_free(roughness_limiter.shader_version);
+	occlusion.shader.version_free(occlusion.shader_version);
 	cubemap_downsampler.shader.version_free(cubemap_downsampler.shader_version);
 	filter.shader.version_free(filter.shader_version);
 }
@@ -39,7 +39,9 @@
 #include "servers/rendering/rasterizer_rd/shaders/cubemap_downsampler.glsl.gen.h"
 #include "servers/rendering/rasterizer_rd/shaders/cubemap_filter.glsl.gen.h"
 #include "servers/rendering/rasterizer_rd/shaders/cubemap_roughness.glsl.gen.h"
+#include "servers/rendering/rasterizer_rd/shaders/glow.glsl.gen.h"
 #include "servers/rendering/rasterizer_rd/shaders/luminance_reduce.glsl.gen.h"
+#include "servers/rendering/rasterizer_rd/shaders/occlusion_cull.glsl.gen.h"
 #include "servers/rendering/rasterizer_rd/shaders/roughness_limiter.glsl.gen.h"
 #include "servers/rendering/rasterizer_rd/shaders/ssao.glsl.gen.h"
 #include "servers/rendering/rasterizer_rd/shaders/ssao_blur.glsl.gen.h"
@@ -156,6 +158,10 @@ class RasterizerEffectsRD {
 		float exposure;
 		float white;
 		float auto_exposure_grey;
+
+		uint32_t source_size[2];
+		uint32_t use_upscale;
+		uint32_t pad;
 	};
 
 	struct Tonemap {
@@ -189,6 +195,35 @@ class RasterizerEffectsRD {
 		RID pipelines[LUMINANCE_REDUCE_MAX];
 	} luminance_reduce;
 
+	enum GlowMode {
+		GLOW_MODE_GAUSSIAN,
+		GLOW_MODE_GAUSSIAN_AUTO_EXPOSURE,
+		GLOW_MODE_MAX
+	};
+
+	struct GlowPushConstant {
+		int32_t size[2];
+		float pixel_size[2];
+
+		float glow_strength;
+		float glow_bloom;
+		float glow_hdr_threshold;
+		float glow_hdr_scale;
+
+		float glow_exposure;
+		float glow_luminance_cap;
+		float glow_auto_exposure_grey;
+		uint32_t first_pass;
+	};
+
+	struct Glow {
+
+		GlowPushConstant push_constant;
+		GlowShaderRD shader;
+		RID shader_version;
+		RID pipelines[GLOW_MODE_MAX];
+	} glow;
+
 	struct CopyToDPPushConstant {
 		float bias;
 		float z_far;
@@ -335,6 +370,35 @@ class RasterizerEffectsRD {
 
 	} roughness_limiter;
 
+	enum OcclusionMode {
+		OCCLUSION_HIZ_FIRST,
+		OCCLUSION_HIZ_REDUCE,
+		OCCLUSION_CULL,
+		OCCLUSION_MAX
+	};
+
+	struct OcclusionHiZPushConstant {
+		int32_t source_size[2];
+		int32_t dest_size[2];
+	};
+
+	struct OcclusionCullPushConstant {
+		float view_projection[16];
+		int32_t hiz_size[2];
+		uint32_t hiz_levels;
+		uint32_t instance_count;
+	};
+
+	struct Occlusion {
+
+		OcclusionHiZPushConstant hiz_push_constant;
+		OcclusionCullPushConstant cull_push_constant;
+		OcclusionCullShaderRD shader;
+		RID shader_version;
+		RID pipelines[OCCLUSION_MAX];
+
+	} occlusion;
+
 	struct CubemapDownsamplerPushConstant {
 		uint32_t face_size;
 		float pad[3];
@@ -387,6 +451,7 @@ class RasterizerEffectsRD {
 
 	Map<RID, RID> image_to_uniform_set_cache;
 	Map<RID, RID> texture_to_compute_uniform_set_cache;
+	Map<RID, RID> occlusion_buffers_uniform_set_cache;
 
 	RID _get_uniform_set_from_image(RID p_texture);
 	RID _get_uniform_set_from_texture(RID p_texture, bool p_use_mipmaps = false);
@@ -399,6 +464,8 @@ public:
 	void copy_to_rect(RID p_source_rd_texture, RID p_dest_framebuffer, const Rect2 &p_rect, bool p_flip_y = false, bool p_force_luminance = false);
 	void gaussian_blur(RID p_source_rd_texture, RID p_framebuffer_half, RID p_rd_texture_half, RID p_dest_framebuffer, const Vector2 &p_pixel_size, const Rect2 &p_region);
 	void gaussian_glow(RID p_source_rd_texture, RID p_framebuffer_half, RID p_rd_texture_half, RID p_dest_framebuffer, const Vector2 &p_pixel_size, float p_strength = 1.0, bool p_first_pass = false, float p_luminance_cap = 16.0, float p_exposure = 1.0, float p_bloom = 0.0, float p_hdr_bleed_treshold = 1.0, float p_hdr_bleed_scale = 1.0, RID p_auto_exposure = RID(), float p_auto_exposure_grey = 1.0);
+	//same result as gaussian_glow(), in a single compute pass and without the intermediate texture; p_dest_texture must be a storage texture of p_size
+	void gaussian_glow_compute(RID p_source_rd_texture, RID p_dest_texture, const Size2i &p_size, float p_strength = 1.0, bool p_first_pass = false, float p_luminance_cap = 16.0, float p_exposure = 1.0, float p_bloom = 0.0, float p_hdr_bleed_treshold = 1.0, float p_hdr_bleed_scale = 1.0, RID p_auto_exposure = RID(), float p_auto_exposure_grey = 1.0);
 
 	void cubemap_roughness(RID p_source_rd_texture, RID p_dest_framebuffer, uint32_t p_face_id, uint32_t p_sample_count, float p_roughness, float p_size);
 	void make_mipmap(RID p_source_rd_texture, RID p_framebuffer_half, const Vector2 &p_pixel_size);
@@ -439,6 +506,9 @@ public:
 
 		bool use_color_correction = false;
 		RID color_correction_texture;
+
+		bool use_upscale = false; //source is smaller than the destination (dynamic resolution), use a sharper filter
+		Vector2i source_size;
 	};
 
 	void tonemapper(RID p_source_color, RID p_dst_framebuffer, const TonemapSettings &p_settings);
@@ -446,6 +516,8 @@ public:
 	void generate_ssao(RID p_depth_buffer, RID p_normal_buffer, const Size2i &p_depth_buffer_size, RID p_depth_mipmaps_texture, const Vector<RID> &depth_mipmaps, RID p_ao1, bool p_half_size, RID p_ao2, RID p_upscale_buffer, float p_intensity, float p_radius, float p_bias, const CameraMatrix &p_projection, RS::EnvironmentSSAOQuality p_quality, RS::EnvironmentSSAOBlur p_blur, float p_edge_sharpness);
 
 	void roughness_limit(RID p_source_normal, RID p_roughness, const Size2i &p_size, float p_curve);
+	void occlusion_build_hiz(RID p_depth_texture, const Size2i &p_depth_size, const Vector<RID> &p_hiz_mipmaps);
+	void occlusion_cull(RID p_hiz_texture, const Size2i &p_hiz_size, int p_hiz_levels, RID p_instance_buffer, RID p_visibility_buffer, uint32_t p_instance_count, const CameraMatrix &p_view_projection);
 	void cubemap_downsample(RID p_source_cubemap, RID p_dest_cubemap, const Size2i &p_size);
 	void cubemap_filter(RID p_source_cubemap, Vector<RID> p_dest_cubemap, bool p_use_array);
 	void render_sky(RD::DrawListID p_list, float p_time, RID p_fb, RID p_samplers, RID p_lights, RenderPipelineVertexFormatCacheRD *p_pipeline, RID p_uniform_set, RID p_texture_set, const CameraMatrix &p_camera, const Basis &p_orientation, float p_multiplier, const Vector3 &p_position);
@@ -30,6 +30,8 @@
 
 #include "rasterizer_rd.h"
 
+#include "core/project_settings.h"
+
 void RasterizerRD::prepare_for_blitting_render_targets() {
 	RD::get_singleton()->prepare_screen_for_drawing();
 }
@@ -150,13 +152,10 @@ void RasterizerRD::initialize() {
 	}
 }
 
-ThreadWorkPool RasterizerRD::thread_work_pool;
 uint32_t RasterizerRD::frame = 1;
 
 void RasterizerRD::finalize() {
 
-	thread_work_pool.finish();
-
 	memdelete(scene);
 	memdelete(canvas);
 	memdelete(storage);
@@ -168,9 +167,12 @@ void RasterizerRD::finalize() {
 }
 
 RasterizerRD::RasterizerRD() {
-	thread_work_pool.init();
 	time = 0;
 
+	if (GLOBAL_DEF("rendering/shader_compiler/shader_cache/enabled", true)) {
+		ShaderRD::set_shader_cache_dir(OS::get_singleton()->get_user_data_dir().plus_file("shader_cache"));
+	}
+
 	storage = memnew(RasterizerStorageRD);
 	canvas = memnew(RasterizerCanvasRD(storage));
 	scene = memnew(RasterizerSceneHighEndRD(storage));
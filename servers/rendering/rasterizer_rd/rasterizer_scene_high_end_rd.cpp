@@ -30,6 +30,8 @@
 
 #include "rasterizer_scene_high_end_rd.h"
 #include "core/project_settings.h"
+#include "core/thread_work_pool.h"
+#include "rasterizer_rd.h"
 #include "servers/rendering/rendering_device.h"
 #include "servers/rendering/rendering_server_raster.h"
 
@@ -83,6 +85,7 @@ void RasterizerSceneHighEndRD::ShaderData::set_code(const String &p_code) {
 
 	code = p_code;
 	valid = false;
+	compiling = false;
 	ubo_size = 0;
 	uniforms.clear();
 	uses_screen_texture = false;
@@ -93,9 +96,9 @@ void RasterizerSceneHighEndRD::ShaderData::set_code(const String &p_code) {
 
 	ShaderCompilerRD::GeneratedCode gen_code;
 
-	int blend_mode = BLEND_MODE_MIX;
+	int blend_modei = BLEND_MODE_MIX;
 	int depth_testi = DEPTH_TEST_ENABLED;
-	int cull = CULL_BACK;
+	int culli = CULL_BACK;
 
 	uses_point_size = false;
 	uses_alpha = false;
@@ -104,7 +107,7 @@ void RasterizerSceneHighEndRD::ShaderData::set_code(const String &p_code) {
 	uses_discard = false;
 	uses_roughness = false;
 	uses_normal = false;
-	bool wireframe = false;
+	wireframe = false;
 
 	unshaded = false;
 	uses_vertex = false;
@@ -120,10 +123,10 @@ void RasterizerSceneHighEndRD::ShaderData::set_code(const String &p_code) {
 
 	ShaderCompilerRD::IdentifierActions actions;
 
-	actions.render_mode_values["blend_add"] = Pair<int *, int>(&blend_mode, BLEND_MODE_ADD);
-	actions.render_mode_values["blend_mix"] = Pair<int *, int>(&blend_mode, BLEND_MODE_MIX);
-	actions.render_mode_values["blend_sub"] = Pair<int *, int>(&blend_mode, BLEND_MODE_SUB);
-	actions.render_mode_values["blend_mul"] = Pair<int *, int>(&blend_mode, BLEND_MODE_MUL);
+	actions.render_mode_values["blend_add"] = Pair<int *, int>(&blend_modei, BLEND_MODE_ADD);
+	actions.render_mode_values["blend_mix"] = Pair<int *, int>(&blend_modei, BLEND_MODE_MIX);
+	actions.render_mode_values["blend_sub"] = Pair<int *, int>(&blend_modei, BLEND_MODE_SUB);
+	actions.render_mode_values["blend_mul"] = Pair<int *, int>(&blend_modei, BLEND_MODE_MUL);
 
 	actions.render_mode_values["depth_draw_never"] = Pair<int *, int>(&depth_drawi, DEPTH_DRAW_DISABLED);
 	actions.render_mode_values["depth_draw_opaque"] = Pair<int *, int>(&depth_drawi, DEPTH_DRAW_OPAQUE);
@@ -131,9 +134,9 @@ void RasterizerSceneHighEndRD::ShaderData::set_code(const String &p_code) {
 
 	actions.render_mode_values["depth_test_disabled"] = Pair<int *, int>(&depth_testi, DEPTH_TEST_DISABLED);
 
-	actions.render_mode_values["cull_disabled"] = Pair<int *, int>(&cull, CULL_DISABLED);
-	actions.render_mode_values["cull_front"] = Pair<int *, int>(&cull, CULL_FRONT);
-	actions.render_mode_values["cull_back"] = Pair<int *, int>(&cull, CULL_BACK);
+	actions.render_mode_values["cull_disabled"] = Pair<int *, int>(&culli, CULL_DISABLED);
+	actions.render_mode_values["cull_front"] = Pair<int *, int>(&culli, CULL_FRONT);
+	actions.render_mode_values["cull_back"] = Pair<int *, int>(&culli, CULL_BACK);
 
 	actions.render_mode_flags["unshaded"] = &unshaded;
 	actions.render_mode_flags["wireframe"] = &wireframe;
@@ -173,6 +176,8 @@ void RasterizerSceneHighEndRD::ShaderData::set_code(const String &p_code) {
 
 	depth_draw = DepthDraw(depth_drawi);
 	depth_test = DepthTest(depth_testi);
+	blend_mode = BlendMode(blend_modei);
+	cull = Cull(culli);
 
 #if 0
 	print_line("**compiling shader:");
@@ -188,12 +193,38 @@ void RasterizerSceneHighEndRD::ShaderData::set_code(const String &p_code) {
 	print_line("\n**light_code:\n" + gen_code.light);
 #endif
 	scene_singleton->shader.scene_shader.version_set_code(version, gen_code.uniforms, gen_code.vertex_global, gen_code.vertex, gen_code.fragment_global, gen_code.light, gen_code.fragment, gen_code.defines);
-	ERR_FAIL_COND(!scene_singleton->shader.scene_shader.version_is_valid(version));
 
 	ubo_size = gen_code.uniform_total_size;
 	ubo_offsets = gen_code.uniform_offsets;
 	texture_uniforms = gen_code.texture_uniforms;
 
+	if (!scene_singleton->shader.scene_shader.version_is_ready(version)) {
+		//compiling in the background, the default material is used until it's done
+		compiling = true;
+		return;
+	}
+
+	update_pipelines();
+}
+
+bool RasterizerSceneHighEndRD::ShaderData::poll_compilation() {
+
+	RasterizerSceneHighEndRD *scene_singleton = (RasterizerSceneHighEndRD *)RasterizerSceneHighEndRD::singleton;
+
+	if (compiling && scene_singleton->shader.scene_shader.version_is_ready(version)) {
+		compiling = false;
+		update_pipelines();
+	}
+
+	return valid;
+}
+
+void RasterizerSceneHighEndRD::ShaderData::update_pipelines() {
+
+	RasterizerSceneHighEndRD *scene_singleton = (RasterizerSceneHighEndRD *)RasterizerSceneHighEndRD::singleton;
+
+	ERR_FAIL_COND(!scene_singleton->shader.scene_shader.version_is_valid(version));
+
 	//blend modes
 
 	RD::PipelineColorBlendState::Attachment blend_attachment;
@@ -395,6 +426,7 @@ Variant RasterizerSceneHighEndRD::ShaderData::get_default_parameter(const String
 
 RasterizerSceneHighEndRD::ShaderData::ShaderData() {
 	valid = false;
+	compiling = false;
 	uses_screen_texture = false;
 }
 
@@ -479,6 +511,11 @@ void RasterizerSceneHighEndRD::MaterialData::update_parameters(const Map<StringN
 		return;
 	}
 
+	if (!shader_data->valid) {
+		//shader still compiling, the uniform set will be created when the material is first drawn
+		return;
+	}
+
 	Vector<RD::Uniform> uniforms;
 
 	{
@@ -728,35 +765,11 @@ void RasterizerSceneHighEndRD::_fill_instances(RenderList::Element **p_elements,
 
 /// RENDERING ///
 
-void RasterizerSceneHighEndRD::_render_list(RenderingDevice::DrawListID p_draw_list, RenderingDevice::FramebufferFormatID p_framebuffer_Format, RenderList::Element **p_elements, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, bool p_no_gi, RID p_radiance_uniform_set, RID p_render_buffers_uniform_set) {
+void RasterizerSceneHighEndRD::_render_list_resolve(RenderingDevice::FramebufferFormatID p_framebuffer_format, RenderList::Element **p_elements, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode) {
 
-	RD::DrawListID draw_list = p_draw_list;
-	RD::FramebufferFormatID framebuffer_format = p_framebuffer_Format;
+	//pipelines, vertex arrays and uniform sets are created lazily, so this part must not run in threads
 
-	//global scope bindings
-	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, render_base_uniform_set, SCENE_UNIFORM_SET);
-	if (p_radiance_uniform_set.is_valid()) {
-		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, p_radiance_uniform_set, RADIANCE_UNIFORM_SET);
-	} else {
-		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, default_radiance_uniform_set, RADIANCE_UNIFORM_SET);
-	}
-	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, view_dependant_uniform_set, VIEW_DEPENDANT_UNIFORM_SET);
-	if (p_render_buffers_uniform_set.is_valid()) {
-		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, p_render_buffers_uniform_set, RENDER_BUFFERS_UNIFORM_SET);
-	} else {
-		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, default_render_buffers_uniform_set, RENDER_BUFFERS_UNIFORM_SET);
-	}
-	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, default_vec4_xform_uniform_set, TRANSFORMS_UNIFORM_SET);
-
-	MaterialData *prev_material = nullptr;
-
-	RID prev_vertex_array_rd;
-	RID prev_index_array_rd;
-	RID prev_pipeline_rd;
-	RID prev_xforms_uniform_set;
-
-	PushConstant push_constant;
-	zeromem(&push_constant, sizeof(PushConstant));
+	render_list_draws.clear();
 
 	for (int i = 0; i < p_element_count; i++) {
 
@@ -855,15 +868,19 @@ void RasterizerSceneHighEndRD::_render_list(RenderingDevice::DrawListID p_draw_l
 		RD::VertexFormatID vertex_format = -1;
 		RID vertex_array_rd;
 		RID index_array_rd;
+		uint32_t instances = 1;
+		RID mesh;
 
 		switch (e->instance->base_type) {
 			case RS::INSTANCE_MESH: {
-				storage->mesh_surface_get_arrays_and_format(e->instance->base, e->surface_index, pipeline->get_vertex_input_mask(), vertex_array_rd, index_array_rd, vertex_format);
+				mesh = e->instance->base;
+				storage->mesh_surface_get_arrays_and_format(mesh, e->surface_index, pipeline->get_vertex_input_mask(), vertex_array_rd, index_array_rd, vertex_format, e->lod_index);
 			} break;
 			case RS::INSTANCE_MULTIMESH: {
-				RID mesh = storage->multimesh_get_mesh(e->instance->base);
+				mesh = storage->multimesh_get_mesh(e->instance->base);
 				ERR_CONTINUE(!mesh.is_valid()); //should be a bug
-				storage->mesh_surface_get_arrays_and_format(mesh, e->surface_index, pipeline->get_vertex_input_mask(), vertex_array_rd, index_array_rd, vertex_format);
+				storage->mesh_surface_get_arrays_and_format(mesh, e->surface_index, pipeline->get_vertex_input_mask(), vertex_array_rd, index_array_rd, vertex_format, e->lod_index);
+				instances = storage->multimesh_get_instances_to_draw(e->instance->base);
 			} break;
 			case RS::INSTANCE_IMMEDIATE: {
 				ERR_CONTINUE(true); //should be a bug
@@ -876,63 +893,169 @@ void RasterizerSceneHighEndRD::_render_list(RenderingDevice::DrawListID p_draw_l
 			}
 		}
 
-		if (prev_vertex_array_rd != vertex_array_rd) {
-			RD::get_singleton()->draw_list_bind_vertex_array(draw_list, vertex_array_rd);
-			prev_vertex_array_rd = vertex_array_rd;
+		RID pipeline_rd = pipeline->get_render_pipeline(vertex_format, p_framebuffer_format);
+		if (pipeline_rd.is_null()) {
+			continue;
+		}
+
+		bool can_instance = e->instance->base_type == RS::INSTANCE_MESH;
+
+		if (can_instance && render_list_draws.size()) {
+			//elements are sorted by surface, so identical consecutive meshes become a single instanced draw,
+			//the shader adds the instance index to the element index to find each one's data
+			RenderListDraw &prev = render_list_draws[render_list_draws.size() - 1];
+			if (prev.can_instance && prev.element_index + prev.instances == (uint32_t)i && prev.pipeline == pipeline_rd && prev.vertex_array == vertex_array_rd && prev.index_array == index_array_rd && prev.xforms_uniform_set == xforms_uniform_set && prev.material_uniform_set == material->uniform_set) {
+				prev.instances++;
+				continue;
+			}
 		}
 
-		if (prev_index_array_rd != index_array_rd) {
-			if (index_array_rd.is_valid()) {
-				RD::get_singleton()->draw_list_bind_index_array(draw_list, index_array_rd);
+		RenderListDraw draw;
+		draw.pipeline = pipeline_rd;
+		draw.vertex_array = vertex_array_rd;
+		draw.index_array = index_array_rd;
+		draw.xforms_uniform_set = xforms_uniform_set;
+		draw.material_uniform_set = material->uniform_set;
+		draw.element_index = i;
+		draw.instances = instances;
+		draw.can_instance = can_instance;
+
+		uint32_t format = storage->mesh_surface_get_format(mesh, e->surface_index);
+		draw.vertex_aabb = (format & RS::ARRAY_COMPRESS_VERTEX) ? storage->mesh_surface_get_aabb(mesh, e->surface_index) : AABB(Vector3(), Vector3(1, 1, 1));
+		draw.flags = 0;
+		if (format & RS::ARRAY_FLAG_USE_OCTAHEDRAL_COMPRESSION) {
+			if (format & RS::ARRAY_COMPRESS_NORMAL) {
+				draw.flags |= DRAW_CALL_FLAGS_OCTAHEDRAL_NORMAL;
+			}
+			if (format & RS::ARRAY_COMPRESS_TANGENT) {
+				draw.flags |= DRAW_CALL_FLAGS_OCTAHEDRAL_TANGENT;
 			}
-			prev_index_array_rd = index_array_rd;
 		}
 
-		RID pipeline_rd = pipeline->get_render_pipeline(vertex_format, framebuffer_format);
+		render_list_draws.push_back(draw);
+	}
+}
+
+void RasterizerSceneHighEndRD::_render_list_record(RenderingDevice::DrawListID p_draw_list, uint32_t p_from, uint32_t p_to, RID p_radiance_uniform_set, RID p_render_buffers_uniform_set) {
 
-		if (pipeline_rd != prev_pipeline_rd) {
+	RD::DrawListID draw_list = p_draw_list;
+
+	//global scope bindings
+	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, render_base_uniform_set, SCENE_UNIFORM_SET);
+	if (p_radiance_uniform_set.is_valid()) {
+		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, p_radiance_uniform_set, RADIANCE_UNIFORM_SET);
+	} else {
+		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, default_radiance_uniform_set, RADIANCE_UNIFORM_SET);
+	}
+	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, view_dependant_uniform_set, VIEW_DEPENDANT_UNIFORM_SET);
+	if (p_render_buffers_uniform_set.is_valid()) {
+		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, p_render_buffers_uniform_set, RENDER_BUFFERS_UNIFORM_SET);
+	} else {
+		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, default_render_buffers_uniform_set, RENDER_BUFFERS_UNIFORM_SET);
+	}
+	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, default_vec4_xform_uniform_set, TRANSFORMS_UNIFORM_SET);
+
+	RID prev_material_uniform_set;
+	RID prev_vertex_array_rd;
+	RID prev_index_array_rd;
+	RID prev_pipeline_rd;
+	RID prev_xforms_uniform_set;
+
+	PushConstant push_constant;
+	zeromem(&push_constant, sizeof(PushConstant));
+
+	for (uint32_t i = p_from; i < p_to; i++) {
+
+		const RenderListDraw &draw = render_list_draws[i];
+
+		if (prev_vertex_array_rd != draw.vertex_array) {
+			RD::get_singleton()->draw_list_bind_vertex_array(draw_list, draw.vertex_array);
+			prev_vertex_array_rd = draw.vertex_array;
+		}
+
+		if (prev_index_array_rd != draw.index_array) {
+			if (draw.index_array.is_valid()) {
+				RD::get_singleton()->draw_list_bind_index_array(draw_list, draw.index_array);
+			}
+			prev_index_array_rd = draw.index_array;
+		}
+
+		if (draw.pipeline != prev_pipeline_rd) {
 			// checking with prev shader does not make so much sense, as
 			// the pipeline may still be different.
-			RD::get_singleton()->draw_list_bind_render_pipeline(draw_list, pipeline_rd);
-			prev_pipeline_rd = pipeline_rd;
+			RD::get_singleton()->draw_list_bind_render_pipeline(draw_list, draw.pipeline);
+			prev_pipeline_rd = draw.pipeline;
 		}
 
-		if (xforms_uniform_set.is_valid() && prev_xforms_uniform_set != xforms_uniform_set) {
-			RD::get_singleton()->draw_list_bind_uniform_set(draw_list, xforms_uniform_set, TRANSFORMS_UNIFORM_SET);
-			prev_xforms_uniform_set = xforms_uniform_set;
+		if (draw.xforms_uniform_set.is_valid() && prev_xforms_uniform_set != draw.xforms_uniform_set) {
+			RD::get_singleton()->draw_list_bind_uniform_set(draw_list, draw.xforms_uniform_set, TRANSFORMS_UNIFORM_SET);
+			prev_xforms_uniform_set = draw.xforms_uniform_set;
 		}
 
-		if (material != prev_material) {
-			//update uniform set
-			if (material->uniform_set.is_valid()) {
-				RD::get_singleton()->draw_list_bind_uniform_set(draw_list, material->uniform_set, MATERIAL_UNIFORM_SET);
-			}
-
-			prev_material = material;
+		if (draw.material_uniform_set.is_valid() && draw.material_uniform_set != prev_material_uniform_set) {
+			RD::get_singleton()->draw_list_bind_uniform_set(draw_list, draw.material_uniform_set, MATERIAL_UNIFORM_SET);
+			prev_material_uniform_set = draw.material_uniform_set;
 		}
 
-		push_constant.index = i;
+		push_constant.index = draw.element_index; //index into the instance buffer, which covers the whole list
+		push_constant.vertex_position[0] = draw.vertex_aabb.position.x;
+		push_constant.vertex_position[1] = draw.vertex_aabb.position.y;
+		push_constant.vertex_position[2] = draw.vertex_aabb.position.z;
+		push_constant.vertex_size[0] = draw.vertex_aabb.size.x;
+		push_constant.vertex_size[1] = draw.vertex_aabb.size.y;
+		push_constant.vertex_size[2] = draw.vertex_aabb.size.z;
+		push_constant.flags = draw.flags;
 		RD::get_singleton()->draw_list_set_push_constant(draw_list, &push_constant, sizeof(PushConstant));
 
-		switch (e->instance->base_type) {
-			case RS::INSTANCE_MESH: {
-				RD::get_singleton()->draw_list_draw(draw_list, index_array_rd.is_valid());
-			} break;
-			case RS::INSTANCE_MULTIMESH: {
-				uint32_t instances = storage->multimesh_get_instances_to_draw(e->instance->base);
-				RD::get_singleton()->draw_list_draw(draw_list, index_array_rd.is_valid(), instances);
-			} break;
-			case RS::INSTANCE_IMMEDIATE: {
+		RD::get_singleton()->draw_list_draw(draw_list, draw.index_array.is_valid(), draw.instances);
+	}
+}
 
-			} break;
-			case RS::INSTANCE_PARTICLES: {
+void RasterizerSceneHighEndRD::_render_list_thread_record(uint32_t p_index, RenderListThreadData *p_data) {
 
-			} break;
-			default: {
-				ERR_CONTINUE(true); //should be a bug
-			}
+	uint32_t from = p_index * p_data->draw_count / p_data->split_count;
+	uint32_t to = (p_index + 1) * p_data->draw_count / p_data->split_count;
+	_render_list_record(p_data->split_ids[p_index], from, to, p_data->radiance_uniform_set, p_data->render_buffers_uniform_set);
+}
+
+void RasterizerSceneHighEndRD::_render_list(RenderingDevice::DrawListID p_draw_list, RenderingDevice::FramebufferFormatID p_framebuffer_Format, RenderList::Element **p_elements, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, bool p_no_gi, RID p_radiance_uniform_set, RID p_render_buffers_uniform_set) {
+
+	_render_list_resolve(p_framebuffer_Format, p_elements, p_element_count, p_reverse_cull, p_pass_mode);
+	_render_list_record(p_draw_list, 0, render_list_draws.size(), p_radiance_uniform_set, p_render_buffers_uniform_set);
+}
+
+void RasterizerSceneHighEndRD::_render_list_draw(RID p_framebuffer, RenderList::Element **p_elements, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, bool p_no_gi, RID p_radiance_uniform_set, RID p_render_buffers_uniform_set, RD::InitialAction p_initial_color_action, RD::FinalAction p_final_color_action, RD::InitialAction p_initial_depth_action, RD::FinalAction p_final_depth_action, const Vector<Color> &p_clear_color_values, float p_clear_depth, uint32_t p_clear_stencil, const Rect2 &p_region) {
+
+	_render_list_resolve(RD::get_singleton()->framebuffer_get_format(p_framebuffer), p_elements, p_element_count, p_reverse_cull, p_pass_mode);
+	uint32_t draw_count = render_list_draws.size();
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+	uint32_t split_count = 1;
+	if (render_list_split_min_elements > 0 && pool && pool->get_thread_count() > 0) {
+		split_count = MIN(pool->get_thread_count() + 1, draw_count / render_list_split_min_elements);
+	}
+
+	if (split_count > 1) {
+		//record the list in secondary command buffers, one per thread
+		RD::DrawListID *split_ids = (RD::DrawListID *)alloca(sizeof(RD::DrawListID) * split_count);
+		Error err = RD::get_singleton()->draw_list_begin_split(p_framebuffer, split_count, split_ids, p_initial_color_action, p_final_color_action, p_initial_depth_action, p_final_depth_action, p_clear_color_values, p_clear_depth, p_clear_stencil, p_region);
+		if (err == OK) {
+			RenderListThreadData thread_data;
+			thread_data.split_ids = split_ids;
+			thread_data.split_count = split_count;
+			thread_data.draw_count = draw_count;
+			thread_data.radiance_uniform_set = p_radiance_uniform_set;
+			thread_data.render_buffers_uniform_set = p_render_buffers_uniform_set;
+
+			pool->do_work(split_count, this, &RasterizerSceneHighEndRD::_render_list_thread_record, &thread_data);
+			RD::get_singleton()->draw_list_end();
+			return;
 		}
 	}
+
+	RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(p_framebuffer, p_initial_color_action, p_final_color_action, p_initial_depth_action, p_final_depth_action, p_clear_color_values, p_clear_depth, p_clear_stencil, p_region);
+	_render_list_record(draw_list, 0, draw_count, p_radiance_uniform_set, p_render_buffers_uniform_set);
+	RD::get_singleton()->draw_list_end();
 }
 
 void RasterizerSceneHighEndRD::_setup_environment(RID p_environment, const CameraMatrix &p_cam_projection, const Transform &p_cam_transform, RID p_reflection_probe, bool p_no_fog, const Size2 &p_screen_pixel_size, RID p_shadow_atlas, bool p_flip_y, const Color &p_default_bg_color, float p_znear, float p_zfar, bool p_opaque_render_buffers) {
@@ -1058,7 +1181,61 @@ void RasterizerSceneHighEndRD::_setup_environment(RID p_environment, const Camer
 	RD::get_singleton()->buffer_update(scene_state.uniform_buffer, 0, sizeof(SceneState::UBO), &scene_state.ubo, true);
 }
 
-void RasterizerSceneHighEndRD::_add_geometry(InstanceBase *p_instance, uint32_t p_surface, RID p_material, PassMode p_pass_mode, uint32_t p_geometry_index) {
+void RasterizerSceneHighEndRD::_setup_lod(const CameraMatrix &p_projection, const Transform &p_transform, float p_resolution) {
+
+	scene_state.lod_camera_position = p_transform.origin;
+	scene_state.lod_orthogonal = p_projection.is_orthogonal();
+	//pixels covered by one unit, at unit distance when using perspective
+	scene_state.lod_pixels_per_unit = mesh_lod_threshold > 0.0 ? 0.5 * p_resolution * Math::abs(p_projection.matrix[1][1]) : 0.0;
+	scene_state.stream_pixels_per_unit = storage->is_texture_streaming_enabled() ? 0.5 * p_resolution * Math::abs(p_projection.matrix[1][1]) : 0.0;
+}
+
+float RasterizerSceneHighEndRD::_get_instance_camera_distance(const InstanceBase *p_instance) const {
+
+	//distance to the closest point of the bounds, so large objects keep their detail close to the camera
+	const AABB &aabb = p_instance->transformed_aabb;
+	const Vector3 &camera = scene_state.lod_camera_position;
+	Vector3 closest(CLAMP(camera.x, aabb.position.x, aabb.position.x + aabb.size.x), CLAMP(camera.y, aabb.position.y, aabb.position.y + aabb.size.y), CLAMP(camera.z, aabb.position.z, aabb.position.z + aabb.size.z));
+	return camera.distance_to(closest);
+}
+
+float RasterizerSceneHighEndRD::_get_instance_lod_pixels_per_unit(const InstanceBase *p_instance) const {
+
+	if (scene_state.lod_pixels_per_unit <= 0.0) {
+		return 0.0;
+	}
+
+	Vector3 scale = p_instance->transform.basis.get_scale_abs();
+	float pixels_per_unit = scene_state.lod_pixels_per_unit * MAX(scale.x, MAX(scale.y, scale.z));
+
+	if (!scene_state.lod_orthogonal) {
+		float distance = _get_instance_camera_distance(p_instance);
+		if (distance < CMP_EPSILON) {
+			return 0.0;
+		}
+		pixels_per_unit /= distance;
+	}
+
+	return pixels_per_unit;
+}
+
+float RasterizerSceneHighEndRD::_get_instance_stream_size(const InstanceBase *p_instance) const {
+
+	//pixels covered by the longest side of the instance, textures are assumed to be mapped once over it
+	float size = scene_state.stream_pixels_per_unit * p_instance->transformed_aabb.get_longest_axis_size();
+
+	if (!scene_state.lod_orthogonal) {
+		float distance = _get_instance_camera_distance(p_instance);
+		if (distance < CMP_EPSILON) {
+			return size > 0.0 ? 1e20 : 0.0; //camera inside, needs full resolution
+		}
+		size /= distance;
+	}
+
+	return size;
+}
+
+void RasterizerSceneHighEndRD::_add_geometry(InstanceBase *p_instance, uint32_t p_surface, RID p_material, PassMode p_pass_mode, uint32_t p_geometry_index, uint32_t p_lod) {
 
 	RID m_src;
 
@@ -1078,6 +1255,9 @@ void RasterizerSceneHighEndRD::_add_geometry(InstanceBase *p_instance, uint32_t
 
 	if (m_src.is_valid()) {
 		material = (MaterialData *)storage->material_get_data(m_src, RasterizerStorageRD::SHADER_TYPE_3D);
+		if (material && unlikely(material->shader_data->compiling)) {
+			material->shader_data->poll_compilation();
+		}
 		if (!material || !material->shader_data->valid) {
 			material = NULL;
 		}
@@ -1090,18 +1270,21 @@ void RasterizerSceneHighEndRD::_add_geometry(InstanceBase *p_instance, uint32_t
 
 	ERR_FAIL_COND(!material);
 
-	_add_geometry_with_material(p_instance, p_surface, material, m_src, p_pass_mode, p_geometry_index);
+	_add_geometry_with_material(p_instance, p_surface, material, m_src, p_pass_mode, p_geometry_index, p_lod);
 
 	while (material->next_pass.is_valid()) {
 
 		material = (MaterialData *)storage->material_get_data(material->next_pass, RasterizerStorageRD::SHADER_TYPE_3D);
+		if (material && unlikely(material->shader_data->compiling)) {
+			material->shader_data->poll_compilation();
+		}
 		if (!material || !material->shader_data->valid)
 			break;
-		_add_geometry_with_material(p_instance, p_surface, material, material->next_pass, p_pass_mode, p_geometry_index);
+		_add_geometry_with_material(p_instance, p_surface, material, material->next_pass, p_pass_mode, p_geometry_index, p_lod);
 	}
 }
 
-void RasterizerSceneHighEndRD::_add_geometry_with_material(InstanceBase *p_instance, uint32_t p_surface, MaterialData *p_material, RID p_material_rid, PassMode p_pass_mode, uint32_t p_geometry_index) {
+void RasterizerSceneHighEndRD::_add_geometry_with_material(InstanceBase *p_instance, uint32_t p_surface, MaterialData *p_material, RID p_material_rid, PassMode p_pass_mode, uint32_t p_geometry_index, uint32_t p_lod) {
 
 	bool has_read_screen_alpha = p_material->shader_data->uses_screen_texture || p_material->shader_data->uses_depth_texture || p_material->shader_data->uses_normal_texture;
 	bool has_base_alpha = (p_material->shader_data->uses_alpha || has_read_screen_alpha);
@@ -1124,6 +1307,10 @@ void RasterizerSceneHighEndRD::_add_geometry_with_material(InstanceBase *p_insta
 		scene_state.used_normal_texture = true;
 	}
 
+	if (p_material->streamed_textures.size() && (p_pass_mode == PASS_MODE_COLOR || p_pass_mode == PASS_MODE_COLOR_SPECULAR)) {
+		storage->texture_stream_request(p_material->streamed_textures, _get_instance_stream_size(p_instance));
+	}
+
 	if (p_pass_mode != PASS_MODE_COLOR && p_pass_mode != PASS_MODE_COLOR_SPECULAR) {
 
 		if (has_blend_alpha || has_read_screen_alpha || (has_base_alpha && !p_material->shader_data->uses_depth_pre_pass) || p_material->shader_data->depth_draw == ShaderData::DEPTH_DRAW_DISABLED || p_material->shader_data->depth_test == ShaderData::DEPTH_TEST_DISABLED || p_instance->cast_shadows == RS::SHADOW_CASTING_SETTING_OFF) {
@@ -1153,6 +1340,7 @@ void RasterizerSceneHighEndRD::_add_geometry_with_material(InstanceBase *p_insta
 	e->instance = p_instance;
 	e->material = p_material;
 	e->surface_index = p_surface;
+	e->lod_index = p_lod;
 	e->sort_key = 0;
 
 	if (e->material->last_pass != render_pass) {
@@ -1212,13 +1400,15 @@ void RasterizerSceneHighEndRD::_fill_render_list(InstanceBase **p_cull_result, i
 				}
 
 				const RID *inst_materials = inst->materials.ptr();
+				float lod_pixels_per_unit = _get_instance_lod_pixels_per_unit(inst);
 
 				for (uint32_t j = 0; j < surface_count; j++) {
 
 					RID material = inst_materials[j].is_valid() ? inst_materials[j] : materials[j];
+					uint32_t lod = lod_pixels_per_unit > 0.0 ? storage->mesh_surface_get_lod(inst->base, j, lod_pixels_per_unit, mesh_lod_threshold) : 0;
 
 					uint32_t surface_index = storage->mesh_surface_get_render_pass_index(inst->base, j, render_pass, &geometry_index);
-					_add_geometry(inst, j, material, p_pass_mode, surface_index);
+					_add_geometry(inst, j, material, p_pass_mode, surface_index, lod);
 				}
 
 				//mesh->last_pass=frame;
@@ -1245,10 +1435,14 @@ void RasterizerSceneHighEndRD::_fill_render_list(InstanceBase **p_cull_result, i
 					continue; //nothing to do
 				}
 
+				float lod_pixels_per_unit = _get_instance_lod_pixels_per_unit(inst);
+
 				for (uint32_t j = 0; j < surface_count; j++) {
 
+					uint32_t lod = lod_pixels_per_unit > 0.0 ? storage->mesh_surface_get_lod(mesh, j, lod_pixels_per_unit, mesh_lod_threshold) : 0;
+
 					uint32_t surface_index = storage->mesh_surface_get_multimesh_render_pass_index(mesh, j, render_pass, &geometry_index);
-					_add_geometry(inst, j, materials[j], p_pass_mode, surface_index);
+					_add_geometry(inst, j, materials[j], p_pass_mode, surface_index, lod);
 				}
 
 			} break;
@@ -1776,8 +1970,20 @@ void RasterizerSceneHighEndRD::_render_scene(RID p_render_buffer, const Transfor
 
 	_update_render_base_uniform_set(); //may have changed due to the above (light buffer enlarged, as an example)
 
-	render_list.clear();
-	_fill_render_list(p_cull_result, p_cull_count, PASS_MODE_COLOR, render_buffer == nullptr);
+	//no new cull happened since the last color pass of this viewport (stereo right eye), reuse its list
+	bool reuse_render_list = render_list_reuse.valid && render_list_reuse.scene_pass == get_scene_pass() && render_list_reuse.render_buffer == p_render_buffer && render_list_reuse.cull_result == p_cull_result && render_list_reuse.cull_count == p_cull_count && !p_reflection_probe.is_valid();
+
+	if (!reuse_render_list) {
+		render_list.clear();
+		_setup_lod(p_cam_projection, p_cam_transform, screen_size.y);
+		_fill_render_list(p_cull_result, p_cull_count, PASS_MODE_COLOR, render_buffer == nullptr);
+
+		render_list_reuse.valid = !p_reflection_probe.is_valid();
+		render_list_reuse.scene_pass = get_scene_pass();
+		render_list_reuse.render_buffer = p_render_buffer;
+		render_list_reuse.cull_result = p_cull_result;
+		render_list_reuse.cull_count = p_cull_count;
+	}
 
 	RID radiance_uniform_set;
 	bool draw_sky = false;
@@ -1841,7 +2047,9 @@ void RasterizerSceneHighEndRD::_render_scene(RID p_render_buffer, const Transfor
 
 	_setup_view_dependant_uniform_set(p_shadow_atlas, p_reflection_atlas);
 
-	render_list.sort_by_key(false);
+	if (!reuse_render_list) {
+		render_list.sort_by_key(false);
+	}
 
 	_fill_instances(render_list.elements, render_list.element_count, false);
 
@@ -1855,16 +2063,16 @@ void RasterizerSceneHighEndRD::_render_scene(RID p_render_buffer, const Transfor
 	if (depth_pre_pass) { //depth pre pass
 		RENDER_TIMESTAMP("Render Depth Pre-Pass");
 
-		RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(depth_framebuffer, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_CONTINUE, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_CONTINUE, depth_pass_clear);
-		_render_list(draw_list, RD::get_singleton()->framebuffer_get_format(depth_framebuffer), render_list.elements, render_list.element_count, false, depth_pass_mode, render_buffer == nullptr, radiance_uniform_set, RID());
-		RD::get_singleton()->draw_list_end();
+		_render_list_draw(depth_framebuffer, render_list.elements, render_list.element_count, false, depth_pass_mode, render_buffer == nullptr, radiance_uniform_set, RID(), RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_CONTINUE, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_CONTINUE, depth_pass_clear);
 	}
 
 	if (p_render_buffer.is_valid() && p_environment.is_valid() && environment_is_ssao_enabled(p_environment)) {
+		RENDER_TIMESTAMP("SSAO");
 		_process_ssao(p_render_buffer, p_environment, render_buffer->normal_buffer, p_cam_projection);
 	}
 
 	if (p_render_buffer.is_valid() && screen_space_roughness_limiter_is_active()) {
+		RENDER_TIMESTAMP("Roughness Limiter");
 		storage->get_effects()->roughness_limit(render_buffer->normal_buffer, render_buffer->roughness_buffer, Size2(render_buffer->width, render_buffer->height), screen_space_roughness_limiter_get_curve());
 	}
 
@@ -1883,12 +2091,11 @@ void RasterizerSceneHighEndRD::_render_scene(RID p_render_buffer, const Transfor
 		//regular forward for now
 		Vector<Color> c;
 		c.push_back(clear_color.to_linear());
-		RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(opaque_framebuffer, keep_color ? RD::INITIAL_ACTION_KEEP : RD::INITIAL_ACTION_CLEAR, will_continue ? RD::FINAL_ACTION_CONTINUE : RD::FINAL_ACTION_READ, depth_pre_pass ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_CLEAR, will_continue ? RD::FINAL_ACTION_CONTINUE : RD::FINAL_ACTION_READ, c, 1.0, 0);
-		_render_list(draw_list, RD::get_singleton()->framebuffer_get_format(opaque_framebuffer), render_list.elements, render_list.element_count, false, PASS_MODE_COLOR, render_buffer == nullptr, radiance_uniform_set, render_buffers_uniform_set);
-		RD::get_singleton()->draw_list_end();
+		_render_list_draw(opaque_framebuffer, render_list.elements, render_list.element_count, false, PASS_MODE_COLOR, render_buffer == nullptr, radiance_uniform_set, render_buffers_uniform_set, keep_color ? RD::INITIAL_ACTION_KEEP : RD::INITIAL_ACTION_CLEAR, will_continue ? RD::FINAL_ACTION_CONTINUE : RD::FINAL_ACTION_READ, depth_pre_pass ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_CLEAR, will_continue ? RD::FINAL_ACTION_CONTINUE : RD::FINAL_ACTION_READ, c, 1.0, 0);
 	}
 
 	if (debug_giprobes) {
+		RENDER_TIMESTAMP("Debug GI Probes");
 		//debug giprobes
 		bool will_continue = (can_continue || draw_sky);
 		CameraMatrix dc;
@@ -1929,9 +2136,7 @@ void RasterizerSceneHighEndRD::_render_scene(RID p_render_buffer, const Transfor
 	_fill_instances(&render_list.elements[render_list.max_elements - render_list.alpha_element_count], render_list.alpha_element_count, false);
 
 	{
-		RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(alpha_framebuffer, can_continue ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ, can_continue ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ);
-		_render_list(draw_list, RD::get_singleton()->framebuffer_get_format(alpha_framebuffer), &render_list.elements[render_list.max_elements - render_list.alpha_element_count], render_list.alpha_element_count, false, PASS_MODE_COLOR, render_buffer == nullptr, radiance_uniform_set, render_buffers_uniform_set);
-		RD::get_singleton()->draw_list_end();
+		_render_list_draw(alpha_framebuffer, &render_list.elements[render_list.max_elements - render_list.alpha_element_count], render_list.alpha_element_count, false, PASS_MODE_COLOR, render_buffer == nullptr, radiance_uniform_set, render_buffers_uniform_set, can_continue ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ, can_continue ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ);
 	}
 
 	//_render_list
@@ -2005,7 +2210,7 @@ void RasterizerSceneHighEndRD::_render_scene(RID p_render_buffer, const Transfor
 	//disable all stuff
 #endif
 }
-void RasterizerSceneHighEndRD::_render_shadow(RID p_framebuffer, InstanceBase **p_cull_result, int p_cull_count, const CameraMatrix &p_projection, const Transform &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool p_use_dp_flip) {
+void RasterizerSceneHighEndRD::_render_shadow(RID p_framebuffer, InstanceBase **p_cull_result, int p_cull_count, const CameraMatrix &p_projection, const Transform &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool p_use_dp_flip, float p_lod_resolution, bool p_clear) {
 
 	RENDER_TIMESTAMP("Setup Rendering Shadow");
 
@@ -2020,9 +2225,11 @@ void RasterizerSceneHighEndRD::_render_shadow(RID p_framebuffer, InstanceBase **
 	_setup_environment(RID(), p_projection, p_transform, RID(), true, Vector2(1, 1), RID(), true, Color(), 0, p_zfar);
 
 	render_list.clear();
+	render_list_reuse.valid = false;
 
 	PassMode pass_mode = p_use_dp ? PASS_MODE_SHADOW_DP : PASS_MODE_SHADOW;
 
+	_setup_lod(p_projection, p_transform, p_lod_resolution);
 	_fill_render_list(p_cull_result, p_cull_count, pass_mode, true);
 
 	_setup_view_dependant_uniform_set(RID(), RID());
@@ -2035,9 +2242,7 @@ void RasterizerSceneHighEndRD::_render_shadow(RID p_framebuffer, InstanceBase **
 
 	{
 		//regular forward for now
-		RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(p_framebuffer, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ);
-		_render_list(draw_list, RD::get_singleton()->framebuffer_get_format(p_framebuffer), render_list.elements, render_list.element_count, p_use_dp_flip, pass_mode, true, RID(), RID());
-		RD::get_singleton()->draw_list_end();
+		_render_list_draw(p_framebuffer, render_list.elements, render_list.element_count, p_use_dp_flip, pass_mode, true, RID(), RID(), RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ, p_clear ? RD::INITIAL_ACTION_CLEAR : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ);
 	}
 }
 
@@ -2055,8 +2260,11 @@ void RasterizerSceneHighEndRD::_render_material(const Transform &p_cam_transform
 	_setup_environment(RID(), p_cam_projection, p_cam_transform, RID(), true, Vector2(1, 1), RID(), false, Color(), 0, 0);
 
 	render_list.clear();
+	render_list_reuse.valid = false;
 
 	PassMode pass_mode = PASS_MODE_DEPTH_MATERIAL;
+	scene_state.lod_pixels_per_unit = 0.0; //always bake full detail
+	scene_state.stream_pixels_per_unit = 0.0;
 	_fill_render_list(p_cull_result, p_cull_count, pass_mode, true);
 
 	_setup_view_dependant_uniform_set(RID(), RID());
@@ -2075,9 +2283,7 @@ void RasterizerSceneHighEndRD::_render_material(const Transform &p_cam_transform
 		clear.push_back(Color(0, 0, 0, 0));
 		clear.push_back(Color(0, 0, 0, 0));
 		clear.push_back(Color(0, 0, 0, 0));
-		RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(p_framebuffer, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ, clear, 1.0, 0, p_region);
-		_render_list(draw_list, RD::get_singleton()->framebuffer_get_format(p_framebuffer), render_list.elements, render_list.element_count, true, pass_mode, true, RID(), RID());
-		RD::get_singleton()->draw_list_end();
+		_render_list_draw(p_framebuffer, render_list.elements, render_list.element_count, true, pass_mode, true, RID(), RID(), RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ, clear, 1.0, 0, p_region);
 	}
 }
 
@@ -2243,25 +2449,48 @@ void RasterizerSceneHighEndRD::_update_render_base_uniform_set() {
 
 void RasterizerSceneHighEndRD::_setup_view_dependant_uniform_set(RID p_shadow_atlas, RID p_reflection_atlas) {
 
-	if (view_dependant_uniform_set.is_valid() && RD::get_singleton()->uniform_set_is_valid(view_dependant_uniform_set)) {
-		RD::get_singleton()->free(view_dependant_uniform_set);
+	RID ref_texture = p_reflection_atlas.is_valid() ? reflection_atlas_get_texture(p_reflection_atlas) : RID();
+	if (!ref_texture.is_valid()) {
+		ref_texture = storage->texture_rd_get_default(RasterizerStorageRD::DEFAULT_RD_TEXTURE_CUBEMAP_ARRAY_BLACK);
+	}
+
+	RID shadow_texture;
+	if (p_shadow_atlas.is_valid()) {
+		shadow_texture = shadow_atlas_get_texture(p_shadow_atlas);
+	}
+	if (!shadow_texture.is_valid()) {
+		shadow_texture = storage->texture_rd_get_default(RasterizerStorageRD::DEFAULT_RD_TEXTURE_WHITE);
 	}
 
-	//default render buffer and scene state uniform set
+	//uniform sets are freed by RD along with the textures they use, so a stale entry just fails the validity check
+	uint64_t frame = RasterizerRD::get_frame_number();
+	int oldest = 0;
+	for (int i = 0; i < VIEW_DEPENDANT_UNIFORM_SET_CACHE_SIZE; i++) {
+		ViewDependantUniformSet &vd = view_dependant_uniform_set_cache[i];
+		if (vd.reflection_texture == ref_texture && vd.shadow_texture == shadow_texture && vd.uniform_set.is_valid() && RD::get_singleton()->uniform_set_is_valid(vd.uniform_set)) {
+			vd.last_used_frame = frame;
+			view_dependant_uniform_set = vd.uniform_set;
+			return;
+		}
+		if (vd.last_used_frame < view_dependant_uniform_set_cache[oldest].last_used_frame) {
+			oldest = i;
+		}
+	}
+
+	//not cached, replace the least recently used entry
+
+	ViewDependantUniformSet &vd = view_dependant_uniform_set_cache[oldest];
+	if (vd.uniform_set.is_valid() && RD::get_singleton()->uniform_set_is_valid(vd.uniform_set)) {
+		RD::get_singleton()->free(vd.uniform_set);
+	}
 
 	Vector<RD::Uniform> uniforms;
 
 	{
-
-		RID ref_texture = p_reflection_atlas.is_valid() ? reflection_atlas_get_texture(p_reflection_atlas) : RID();
 		RD::Uniform u;
 		u.binding = 0;
 		u.type = RD::UNIFORM_TYPE_TEXTURE;
-		if (ref_texture.is_valid()) {
-			u.ids.push_back(ref_texture);
-		} else {
-			u.ids.push_back(storage->texture_rd_get_default(RasterizerStorageRD::DEFAULT_RD_TEXTURE_CUBEMAP_ARRAY_BLACK));
-		}
+		u.ids.push_back(ref_texture);
 		uniforms.push_back(u);
 	}
 
@@ -2269,18 +2498,15 @@ void RasterizerSceneHighEndRD::_setup_view_dependant_uniform_set(RID p_shadow_at
 		RD::Uniform u;
 		u.binding = 1;
 		u.type = RD::UNIFORM_TYPE_TEXTURE;
-		RID texture;
-		if (p_shadow_atlas.is_valid()) {
-			texture = shadow_atlas_get_texture(p_shadow_atlas);
-		}
-		if (!texture.is_valid()) {
-			texture = storage->texture_rd_get_default(RasterizerStorageRD::DEFAULT_RD_TEXTURE_WHITE);
-		}
-		u.ids.push_back(texture);
+		u.ids.push_back(shadow_texture);
 		uniforms.push_back(u);
 	}
 
-	view_dependant_uniform_set = RD::get_singleton()->uniform_set_create(uniforms, default_shader_rd, VIEW_DEPENDANT_UNIFORM_SET);
+	vd.reflection_texture = ref_texture;
+	vd.shadow_texture = shadow_texture;
+	vd.uniform_set = RD::get_singleton()->uniform_set_create(uniforms, default_shader_rd, VIEW_DEPENDANT_UNIFORM_SET);
+	vd.last_used_frame = frame;
+	view_dependant_uniform_set = vd.uniform_set;
 }
 
 void RasterizerSceneHighEndRD::_render_buffers_clear_uniform_set(RenderBufferDataHighEnd *rb) {
@@ -2641,6 +2867,15 @@ RasterizerSceneHighEndRD::RasterizerSceneHighEndRD(RasterizerStorageRD *p_storag
 		storage->material_set_shader(wireframe_material, wireframe_material_shader);
 	}
 
+	//the materials above are used as fallback, so any other material shader can compile in the background
+	shader.scene_shader.set_async_compilation(GLOBAL_DEF("rendering/shader_compiler/async_compilation/enabled", true));
+
+	mesh_lod_threshold = GLOBAL_DEF("rendering/quality/mesh_lod/threshold_pixels", 1.0);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/mesh_lod/threshold_pixels", PropertyInfo(Variant::FLOAT, "rendering/quality/mesh_lod/threshold_pixels", PROPERTY_HINT_RANGE, "0,16,0.01"));
+
+	render_list_split_min_elements = GLOBAL_DEF("rendering/threads/render_list_split_min_elements", 512);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/threads/render_list_split_min_elements", PropertyInfo(Variant::INT, "rendering/threads/render_list_split_min_elements", PROPERTY_HINT_RANGE, "0,16384,1"));
+
 	{
 		default_vec4_xform_buffer = RD::get_singleton()->storage_buffer_create(256);
 		Vector<RD::Uniform> uniforms;
@@ -2689,15 +2924,19 @@ RasterizerSceneHighEndRD::RasterizerSceneHighEndRD(RasterizerStorageRD *p_storag
 		default_render_buffers_uniform_set = RD::get_singleton()->uniform_set_create(uniforms, default_shader_rd, RENDER_BUFFERS_UNIFORM_SET);
 	}
 
+	cluster_builder.set_use_compute(GLOBAL_DEF("rendering/quality/light_cluster/use_compute", true));
 	cluster_builder.setup(16, 8, 24);
 }
 
 RasterizerSceneHighEndRD::~RasterizerSceneHighEndRD() {
 	directional_shadow_atlas_set_size(0);
 
-	//clear base uniform set if still valid
-	if (view_dependant_uniform_set.is_valid() && RD::get_singleton()->uniform_set_is_valid(view_dependant_uniform_set)) {
-		RD::get_singleton()->free(view_dependant_uniform_set);
+	//clear view dependant uniform sets if still valid
+	for (int i = 0; i < VIEW_DEPENDANT_UNIFORM_SET_CACHE_SIZE; i++) {
+		RID uniform_set = view_dependant_uniform_set_cache[i].uniform_set;
+		if (uniform_set.is_valid() && RD::get_singleton()->uniform_set_is_valid(uniform_set)) {
+			RD::get_singleton()->free(uniform_set);
+		}
 	}
 
 	RD::get_singleton()->free(default_render_buffers_uniform_set);
@@ -31,6 +31,7 @@
 #ifndef RASTERIZER_SCENE_HIGHEND_RD_H
 #define RASTERIZER_SCENE_HIGHEND_RD_H
 
+#include "core/local_vector.h"
 #include "servers/rendering/rasterizer_rd/light_cluster_builder.h"
 #include "servers/rendering/rasterizer_rd/rasterizer_scene_rd.h"
 #include "servers/rendering/rasterizer_rd/rasterizer_storage_rd.h"
@@ -126,6 +127,11 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 
 		DepthDraw depth_draw;
 		DepthTest depth_test;
+		BlendMode blend_mode;
+		Cull cull;
+		bool wireframe;
+
+		bool compiling; //variants are being compiled in the background, pipelines are not set up yet
 
 		bool uses_point_size;
 		bool uses_alpha;
@@ -148,6 +154,9 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 		uint64_t last_pass = 0;
 		uint32_t index = 0;
 
+		void update_pipelines();
+		bool poll_compilation();
+
 		virtual void set_code(const String &p_Code);
 		virtual void set_default_texture_param(const StringName &p_name, RID p_texture);
 		virtual void get_param_list(List<PropertyInfo> *p_param_list) const;
@@ -188,9 +197,16 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 
 	/* Push Constant */
 
+	enum {
+		DRAW_CALL_FLAGS_OCTAHEDRAL_NORMAL = (1 << 0),
+		DRAW_CALL_FLAGS_OCTAHEDRAL_TANGENT = (1 << 1),
+	};
+
 	struct PushConstant {
+		float vertex_position[3];
 		uint32_t index;
-		uint32_t pad[3];
+		float vertex_size[3];
+		uint32_t flags;
 	};
 
 	/* Framebuffer */
@@ -226,6 +242,20 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 	RID render_base_uniform_set;
 	RID view_dependant_uniform_set;
 
+	//the few shadow/reflection atlas combinations in use keep their uniform sets instead of creating one per render
+	enum {
+		VIEW_DEPENDANT_UNIFORM_SET_CACHE_SIZE = 8
+	};
+
+	struct ViewDependantUniformSet {
+		RID reflection_texture;
+		RID shadow_texture;
+		RID uniform_set;
+		uint64_t last_used_frame = 0;
+	};
+
+	ViewDependantUniformSet view_dependant_uniform_set_cache[VIEW_DEPENDANT_UNIFORM_SET_CACHE_SIZE];
+
 	virtual void _base_uniforms_changed();
 	void _render_buffers_clear_uniform_set(RenderBufferDataHighEnd *rb);
 	virtual void _render_buffers_uniform_set_changed(RID p_render_buffers);
@@ -386,6 +416,13 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 		bool used_sss = false;
 		uint32_t current_shader_index = 0;
 		uint32_t current_material_index = 0;
+
+		//mesh LOD selection for the current pass, no pixels per unit means full detail
+		Vector3 lod_camera_position;
+		float lod_pixels_per_unit = 0.0;
+		bool lod_orthogonal = false;
+		//same, for texture streaming requests
+		float stream_pixels_per_unit = 0.0;
 	} scene_state;
 
 	/* Render List */
@@ -413,6 +450,7 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 				uint64_t sort_key;
 			};
 			uint32_t surface_index;
+			uint32_t lod_index;
 		};
 
 		Element *base_elements;
@@ -527,6 +565,16 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 
 	RenderList render_list;
 
+	// The right eye of a stereo pair renders the cull result already prepared for the left eye,
+	// so the color pass list filled and sorted for it can be drawn again as is.
+	struct RenderListReuse {
+		bool valid = false;
+		uint64_t scene_pass = 0;
+		RID render_buffer;
+		InstanceBase **cull_result = nullptr;
+		int cull_count = 0;
+	} render_list_reuse;
+
 	static RasterizerSceneHighEndRD *singleton;
 	uint64_t render_pass;
 	double time;
@@ -563,15 +611,50 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 	void _setup_gi_probes(RID *p_gi_probe_probe_cull_result, int p_gi_probe_probe_cull_count, const Transform &p_camera_transform);
 
 	void _fill_instances(RenderList::Element **p_elements, int p_element_count, bool p_for_depth);
+	//draw state resolved serially, so the draw list can be recorded from several threads
+	struct RenderListDraw {
+		RID pipeline;
+		RID vertex_array;
+		RID index_array;
+		RID xforms_uniform_set;
+		RID material_uniform_set;
+		uint32_t element_index; //first element, consecutive elements with the same state are drawn as instances
+		uint32_t instances;
+		bool can_instance;
+		AABB vertex_aabb; //to decode compressed positions
+		uint32_t flags;
+	};
+
+	struct RenderListThreadData {
+		RD::DrawListID *split_ids;
+		uint32_t split_count;
+		uint32_t draw_count;
+		RID radiance_uniform_set;
+		RID render_buffers_uniform_set;
+	};
+
+	LocalVector<RenderListDraw> render_list_draws;
+	uint32_t render_list_split_min_elements = 512;
+
+	void _render_list_resolve(RenderingDevice::FramebufferFormatID p_framebuffer_format, RenderList::Element **p_elements, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode);
+	void _render_list_record(RenderingDevice::DrawListID p_draw_list, uint32_t p_from, uint32_t p_to, RID p_radiance_uniform_set, RID p_render_buffers_uniform_set);
+	void _render_list_thread_record(uint32_t p_index, RenderListThreadData *p_data);
 	void _render_list(RenderingDevice::DrawListID p_draw_list, RenderingDevice::FramebufferFormatID p_framebuffer_Format, RenderList::Element **p_elements, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, bool p_no_gi, RID p_radiance_uniform_set, RID p_render_buffers_uniform_set);
-	_FORCE_INLINE_ void _add_geometry(InstanceBase *p_instance, uint32_t p_surface, RID p_material, PassMode p_pass_mode, uint32_t p_geometry_index);
-	_FORCE_INLINE_ void _add_geometry_with_material(InstanceBase *p_instance, uint32_t p_surface, MaterialData *p_material, RID p_material_rid, PassMode p_pass_mode, uint32_t p_geometry_index);
+	void _render_list_draw(RID p_framebuffer, RenderList::Element **p_elements, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, bool p_no_gi, RID p_radiance_uniform_set, RID p_render_buffers_uniform_set, RD::InitialAction p_initial_color_action, RD::FinalAction p_final_color_action, RD::InitialAction p_initial_depth_action, RD::FinalAction p_final_depth_action, const Vector<Color> &p_clear_color_values = Vector<Color>(), float p_clear_depth = 1.0, uint32_t p_clear_stencil = 0, const Rect2 &p_region = Rect2());
+	_FORCE_INLINE_ void _add_geometry(InstanceBase *p_instance, uint32_t p_surface, RID p_material, PassMode p_pass_mode, uint32_t p_geometry_index, uint32_t p_lod);
+	_FORCE_INLINE_ void _add_geometry_with_material(InstanceBase *p_instance, uint32_t p_surface, MaterialData *p_material, RID p_material_rid, PassMode p_pass_mode, uint32_t p_geometry_index, uint32_t p_lod);
+
+	float mesh_lod_threshold = 1.0;
+	void _setup_lod(const CameraMatrix &p_projection, const Transform &p_transform, float p_resolution);
+	_FORCE_INLINE_ float _get_instance_camera_distance(const InstanceBase *p_instance) const;
+	_FORCE_INLINE_ float _get_instance_lod_pixels_per_unit(const InstanceBase *p_instance) const;
+	_FORCE_INLINE_ float _get_instance_stream_size(const InstanceBase *p_instance) const;
 
 	void _fill_render_list(InstanceBase **p_cull_result, int p_cull_count, PassMode p_pass_mode, bool p_no_gi);
 
 protected:
 	virtual void _render_scene(RID p_render_buffer, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_ortogonal, InstanceBase **p_cull_result, int p_cull_count, RID *p_light_cull_result, int p_light_cull_count, RID *p_reflection_probe_cull_result, int p_reflection_probe_cull_count, RID *p_gi_probe_cull_result, int p_gi_probe_cull_count, RID p_environment, RID p_camera_effects, RID p_shadow_atlas, RID p_reflection_atlas, RID p_reflection_probe, int p_reflection_probe_pass, const Color &p_default_bg_color);
-	virtual void _render_shadow(RID p_framebuffer, InstanceBase **p_cull_result, int p_cull_count, const CameraMatrix &p_projection, const Transform &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool p_use_dp_flip);
+	virtual void _render_shadow(RID p_framebuffer, InstanceBase **p_cull_result, int p_cull_count, const CameraMatrix &p_projection, const Transform &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool p_use_dp_flip, float p_lod_resolution, bool p_clear);
 	virtual void _render_material(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_ortogonal, InstanceBase **p_cull_result, int p_cull_count, RID p_framebuffer, const Rect2i &p_region);
 
 public:
@@ -348,6 +348,7 @@ void RasterizerSceneRD::_update_dirty_skys() {
 		}
 
 		sky->reflection.dirty = true;
+		sky->processing_layer = -1; //reflection data may have been recreated
 
 		Sky *next = sky->dirty_list;
 		sky->dirty_list = nullptr;
@@ -710,8 +711,14 @@ void RasterizerSceneRD::_update_sky(RID p_environment, const CameraMatrix &p_pro
 
 	float multiplier = environment_get_bg_energy(p_environment);
 
-	// Update radiance cubemap
-	if (sky->reflection.dirty) {
+	// Update radiance cubemap. With QUALITY mode, layers are filtered over several frames,
+	// a change arriving in the middle is picked up once the current update is done.
+	if (sky->reflection.dirty && sky->processing_layer == -1) {
+		sky->reflection.dirty = false;
+		sky->processing_layer = 0;
+	}
+
+	if (sky->processing_layer == 0) {
 
 		static const Vector3 view_normals[6] = {
 			Vector3(+1, 0, 0),
@@ -784,27 +791,31 @@ void RasterizerSceneRD::_update_sky(RID p_environment, const CameraMatrix &p_pro
 			storage->get_effects()->render_sky(cubemap_draw_list, time, sky->reflection.layers[0].mipmaps[0].framebuffers[i], sky_scene_state.sampler_uniform_set, sky_scene_state.light_uniform_set, pipeline, material->uniform_set, texture_uniform_set, cm, local_view.basis, multiplier, p_transform.origin);
 			RD::get_singleton()->draw_list_end();
 		}
-		if (sky_use_cubemap_array) {
-			if (sky->mode == RS::SKY_MODE_QUALITY) {
-				for (int i = 1; i < sky->reflection.layers.size(); i++) {
-					_create_reflection_importance_sample(sky->reflection, sky_use_cubemap_array, 10, i);
-				}
-			} else {
-				_create_reflection_fast_filter(sky->reflection, sky_use_cubemap_array);
-			}
 
-			_update_reflection_mipmaps(sky->reflection);
-		} else {
-			if (sky->mode == RS::SKY_MODE_QUALITY) {
-				for (int i = 1; i < sky->reflection.layers[0].mipmaps.size(); i++) {
-					_create_reflection_importance_sample(sky->reflection, sky_use_cubemap_array, 10, i);
-				}
-			} else {
-				_create_reflection_fast_filter(sky->reflection, sky_use_cubemap_array);
+		sky->processing_layer = 1;
+	}
+
+	if (sky->processing_layer > 0) {
+		bool done = true;
+
+		if (sky->mode == RS::SKY_MODE_QUALITY) {
+			int layer_count = sky_use_cubemap_array ? sky->reflection.layers.size() : sky->reflection.layers[0].mipmaps.size();
+			int budget = sky_filter_layers_per_frame > 0 ? sky_filter_layers_per_frame : layer_count;
+			for (int i = 0; i < budget && sky->processing_layer < layer_count; i++) {
+				_create_reflection_importance_sample(sky->reflection, sky_use_cubemap_array, 10, sky->processing_layer);
+				sky->processing_layer++;
 			}
+			done = sky->processing_layer >= layer_count;
+		} else {
+			_create_reflection_fast_filter(sky->reflection, sky_use_cubemap_array);
 		}
 
-		sky->reflection.dirty = false;
+		if (done) {
+			if (sky_use_cubemap_array) {
+				_update_reflection_mipmaps(sky->reflection);
+			}
+			sky->processing_layer = -1;
+		}
 	}
 }
 
@@ -2050,7 +2061,7 @@ RasterizerSceneRD::ShadowCubemap *RasterizerSceneRD::_get_shadow_cubemap(int p_s
 			tf.height = p_size;
 			tf.type = RD::TEXTURE_TYPE_CUBE;
 			tf.array_layers = 6;
-			tf.usage_bits = RD::TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | RD::TEXTURE_USAGE_SAMPLING_BIT;
+			tf.usage_bits = RD::TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | RD::TEXTURE_USAGE_SAMPLING_BIT | RD::TEXTURE_USAGE_CAN_COPY_FROM_BIT | RD::TEXTURE_USAGE_CAN_COPY_TO_BIT;
 			sc.cubemap = RD::get_singleton()->texture_create(tf, RD::TextureView());
 		}
 
@@ -2077,7 +2088,7 @@ RasterizerSceneRD::ShadowMap *RasterizerSceneRD::_get_shadow_map(const Size2i &p
 			tf.format = RD::get_singleton()->texture_is_format_supported_for_usage(RD::DATA_FORMAT_D32_SFLOAT, RD::TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) ? RD::DATA_FORMAT_D32_SFLOAT : RD::DATA_FORMAT_X8_D24_UNORM_PACK32;
 			tf.width = p_size.width;
 			tf.height = p_size.height;
-			tf.usage_bits = RD::TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | RD::TEXTURE_USAGE_SAMPLING_BIT;
+			tf.usage_bits = RD::TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | RD::TEXTURE_USAGE_SAMPLING_BIT | RD::TEXTURE_USAGE_CAN_COPY_FROM_BIT | RD::TEXTURE_USAGE_CAN_COPY_TO_BIT;
 
 			sm.depth = RD::get_singleton()->texture_create(tf, RD::TextureView());
 		}
@@ -3167,6 +3178,180 @@ void RasterizerSceneRD::_free_render_buffer_data(RenderBuffers *rb) {
 		rb->ssao.ao_full = RID();
 		rb->ssao.depth_slices.clear();
 	}
+
+	if (rb->occlusion.hiz.is_valid()) {
+		RD::get_singleton()->free(rb->occlusion.hiz);
+		rb->occlusion.hiz = RID();
+		rb->occlusion.hiz_slices.clear();
+	}
+
+	if (rb->occlusion.instance_buffer.is_valid()) {
+		RD::get_singleton()->free(rb->occlusion.instance_buffer);
+		rb->occlusion.instance_buffer = RID();
+		rb->occlusion.instance_buffer_size = 0;
+	}
+
+	if (rb->occlusion.visibility_buffer.is_valid()) {
+		RD::get_singleton()->free(rb->occlusion.visibility_buffer);
+		RD::get_singleton()->free(rb->occlusion.visibility_readback);
+		rb->occlusion.visibility_buffer = RID();
+		rb->occlusion.visibility_readback = RID();
+		rb->occlusion.visibility_size = 0;
+	}
+
+	rb->occlusion.slots.clear();
+	rb->occlusion.visibility.clear();
+}
+
+int RasterizerSceneRD::_occlusion_cull_filter(RenderBuffers *rb, InstanceBase **p_cull_result, int p_cull_count) {
+
+	RenderBuffers::Occlusion &oc = rb->occlusion;
+	uint64_t frame = Engine::get_singleton()->get_frames_drawn();
+
+	if (oc.visibility_readback.is_valid()) {
+		uint64_t data_frame = 0;
+		Vector<uint8_t> data = RD::get_singleton()->readback_buffer_get_data(oc.visibility_readback, &data_frame);
+		if (data.size()) {
+			oc.visibility = data;
+			oc.visibility_frame = data_frame;
+		}
+	}
+
+	if (occlusion_cull_result.size() < p_cull_count) {
+		occlusion_cull_result.resize(p_cull_count);
+	}
+
+	InstanceBase **result = occlusion_cull_result.ptrw();
+	const uint32_t *visibility = (const uint32_t *)oc.visibility.ptr();
+	uint32_t visibility_count = oc.visibility.size() / sizeof(uint32_t);
+	const RenderBuffers::Occlusion::Slot *slots = oc.slots.ptr();
+	uint32_t slot_count = oc.slots.size();
+	int count = 0;
+
+	for (int i = 0; i < p_cull_count; i++) {
+
+		InstanceBase *inst = p_cull_result[i];
+		uint32_t id = inst->occlusion_id;
+
+		if (!inst->ignore_occlusion_culling && id < slot_count && id < visibility_count && visibility[id] == 0) {
+			const RenderBuffers::Occlusion::Slot &slot = slots[id];
+			//only trust results made for this same instance, while it stayed inside the frustum
+			if (slot.generation == inst->occlusion_generation && slot.last_tested + 1 >= frame && oc.visibility_frame >= slot.tested_since) {
+				continue;
+			}
+		}
+
+		result[count++] = inst;
+	}
+
+	return count;
+}
+
+void RasterizerSceneRD::_occlusion_cull_process(RenderBuffers *rb, InstanceBase **p_cull_result, int p_cull_count, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection) {
+
+	RenderBuffers::Occlusion &oc = rb->occlusion;
+	uint64_t frame = Engine::get_singleton()->get_frames_drawn();
+
+	uint32_t id_count = 0;
+	for (int i = 0; i < p_cull_count; i++) {
+		id_count = MAX(id_count, p_cull_result[i]->occlusion_id + 1);
+	}
+
+	if (oc.slots.size() < (int)id_count) {
+		oc.slots.resize(id_count);
+	}
+
+	if (occlusion_instance_data.size() < p_cull_count * 8) {
+		occlusion_instance_data.resize(p_cull_count * 8);
+	}
+
+	float *instance_data = occlusion_instance_data.ptrw();
+	RenderBuffers::Occlusion::Slot *slots = oc.slots.ptrw();
+	uint32_t tested = 0;
+
+	for (int i = 0; i < p_cull_count; i++) {
+
+		InstanceBase *inst = p_cull_result[i];
+		if (inst->ignore_occlusion_culling) {
+			continue;
+		}
+
+		RenderBuffers::Occlusion::Slot &slot = slots[inst->occlusion_id];
+		if (slot.generation != inst->occlusion_generation || slot.last_tested + 1 < frame) {
+			slot.generation = inst->occlusion_generation;
+			slot.tested_since = frame;
+		}
+		slot.last_tested = frame;
+
+		const AABB &aabb = inst->transformed_aabb;
+		float *d = &instance_data[tested * 8];
+		d[0] = aabb.position.x;
+		d[1] = aabb.position.y;
+		d[2] = aabb.position.z;
+		memcpy(&d[3], &inst->occlusion_id, sizeof(uint32_t));
+		d[4] = aabb.position.x + aabb.size.x;
+		d[5] = aabb.position.y + aabb.size.y;
+		d[6] = aabb.position.z + aabb.size.z;
+		d[7] = 0;
+		tested++;
+	}
+
+	if (tested == 0) {
+		return;
+	}
+
+	if (!oc.hiz.is_valid()) {
+		RD::TextureFormat tf;
+		tf.format = RD::DATA_FORMAT_R32_SFLOAT;
+		tf.width = MAX(1, rb->width >> 1);
+		tf.height = MAX(1, rb->height >> 1);
+		tf.mipmaps = Image::get_image_required_mipmaps(tf.width, tf.height, Image::FORMAT_RF) + 1;
+		tf.usage_bits = RD::TEXTURE_USAGE_SAMPLING_BIT | RD::TEXTURE_USAGE_STORAGE_BIT;
+		oc.hiz = RD::get_singleton()->texture_create(tf, RD::TextureView());
+		for (uint32_t i = 0; i < tf.mipmaps; i++) {
+			RID slice = RD::get_singleton()->texture_create_shared_from_slice(RD::TextureView(), oc.hiz, 0, i);
+			oc.hiz_slices.push_back(slice);
+		}
+		oc.hiz_size = Size2i(tf.width, tf.height);
+	}
+
+	if (oc.instance_buffer_size < tested) {
+		if (oc.instance_buffer.is_valid()) {
+			RD::get_singleton()->free(oc.instance_buffer);
+		}
+		oc.instance_buffer_size = next_power_of_2(tested);
+		oc.instance_buffer = RD::get_singleton()->storage_buffer_create(oc.instance_buffer_size * sizeof(float) * 8);
+	}
+
+	if (oc.visibility_size < id_count) {
+		if (oc.visibility_buffer.is_valid()) {
+			RD::get_singleton()->free(oc.visibility_buffer);
+			RD::get_singleton()->free(oc.visibility_readback);
+		}
+		oc.visibility_size = next_power_of_2(id_count);
+
+		//start with everything visible, results for new ids are unknown
+		Vector<uint8_t> initial;
+		initial.resize(oc.visibility_size * sizeof(uint32_t));
+		memset(initial.ptrw(), 0xFF, initial.size());
+		oc.visibility_buffer = RD::get_singleton()->storage_buffer_create(initial.size(), initial);
+		oc.visibility_readback = RD::get_singleton()->readback_buffer_create(initial.size());
+		oc.visibility.clear();
+	}
+
+	RENDER_TIMESTAMP("Occlusion Culling");
+
+	RD::get_singleton()->buffer_update(oc.instance_buffer, 0, tested * sizeof(float) * 8, instance_data, true);
+
+	storage->get_effects()->occlusion_build_hiz(rb->depth_texture, Size2i(rb->width, rb->height), oc.hiz_slices);
+
+	CameraMatrix correction;
+	correction.set_depth_correction(true);
+	CameraMatrix view_projection = correction * p_cam_projection * CameraMatrix(p_cam_transform.affine_inverse());
+
+	storage->get_effects()->occlusion_cull(oc.hiz, oc.hiz_size, oc.hiz_slices.size(), oc.instance_buffer, oc.visibility_buffer, tested, view_projection);
+
+	RD::get_singleton()->buffer_copy_to_readback(oc.visibility_buffer, oc.visibility_readback);
 }
 
 void RasterizerSceneRD::_process_ssao(RID p_render_buffers, RID p_environment, RID p_normal_buffer, const CameraMatrix &p_projection) {
@@ -3308,7 +3493,15 @@ void RasterizerSceneRD::_render_buffers_post_process_and_tonemap(RID p_render_bu
 			int vp_w = rb->blur[1].mipmaps[i].width;
 			int vp_h = rb->blur[1].mipmaps[i].height;
 
-			if (i == 0) {
+			if (glow_use_compute) {
+				//both directions in one pass, blur[0] isn't needed as intermediate
+				RID source = i == 0 ? rb->texture : rb->blur[1].mipmaps[i - 1].texture;
+				RID luminance_texture;
+				if (i == 0 && env->auto_exposure && rb->luminance.current.is_valid()) {
+					luminance_texture = rb->luminance.current;
+				}
+				storage->get_effects()->gaussian_glow_compute(source, rb->blur[1].mipmaps[i].texture, Size2i(vp_w, vp_h), env->glow_strength, i == 0, env->glow_hdr_luminance_cap, env->exposure, env->glow_bloom, env->glow_hdr_bleed_threshold, env->glow_hdr_bleed_scale, luminance_texture, env->auto_exp_scale);
+			} else if (i == 0) {
 				RID luminance_texture;
 				if (env->auto_exposure && rb->luminance.current.is_valid()) {
 					luminance_texture = rb->luminance.current;
@@ -3354,6 +3547,13 @@ void RasterizerSceneRD::_render_buffers_post_process_and_tonemap(RID p_render_bu
 			tonemap.exposure = env->exposure;
 		}
 
+		Size2 rtsize = storage->render_target_get_size(rb->render_target);
+		if (rb->width < rtsize.width || rb->height < rtsize.height) {
+			//rendered at a lower resolution (dynamic resolution), the tonemapper upscales to the render target
+			tonemap.use_upscale = true;
+			tonemap.source_size = Vector2i(rb->width, rb->height);
+		}
+
 		storage->get_effects()->tonemapper(rb->texture, storage->render_target_get_rd_framebuffer(rb->render_target), tonemap);
 	}
 
@@ -3403,6 +3603,11 @@ void RasterizerSceneRD::_render_buffers_debug_draw(RID p_render_buffers, RID p_s
 		effects->copy_to_rect(_render_buffers_get_roughness_texture(p_render_buffers), storage->render_target_get_rd_framebuffer(rb->render_target), Rect2(Vector2(), rtsize), false, true);
 	}
 
+	if (debug_draw == RS::VIEWPORT_DEBUG_DRAW_OCCLUSION_BUFFER && rb->occlusion.hiz.is_valid()) {
+		Size2 rtsize = storage->render_target_get_size(rb->render_target);
+		effects->copy_to_rect(rb->occlusion.hiz, storage->render_target_get_rd_framebuffer(rb->render_target), Rect2(Vector2(), rtsize), false, true);
+	}
+
 	if (debug_draw == RS::VIEWPORT_DEBUG_DRAW_NORMAL_BUFFER && _render_buffers_get_normal_texture(p_render_buffers).is_valid()) {
 		Size2 rtsize = storage->render_target_get_size(rb->render_target);
 		effects->copy_to_rect(_render_buffers_get_normal_texture(p_render_buffers), storage->render_target_get_rd_framebuffer(rb->render_target), Rect2(Vector2(), rtsize));
@@ -3484,17 +3689,62 @@ void RasterizerSceneRD::render_scene(RID p_render_buffers, const Transform &p_ca
 		clear_color = storage->get_default_clear_color();
 	}
 
-	_render_scene(p_render_buffers, p_cam_transform, p_cam_projection, p_cam_ortogonal, p_cull_result, p_cull_count, p_light_cull_result, p_light_cull_count, p_reflection_probe_cull_result, p_reflection_probe_cull_count, p_gi_probe_cull_result, p_gi_probe_cull_count, p_environment, p_camera_effects, p_shadow_atlas, p_reflection_atlas, p_reflection_probe, p_reflection_probe_pass, clear_color);
+	RenderBuffers *occlusion_rb = nullptr;
+	InstanceBase **cull_result = p_cull_result;
+	int cull_count = p_cull_count;
+
+	if (occlusion_culling && p_render_buffers.is_valid()) {
+		//skip what was found hidden in previous frames, everything is still tested again below
+		occlusion_rb = render_buffers_owner.getornull(p_render_buffers);
+		cull_count = _occlusion_cull_filter(occlusion_rb, p_cull_result, p_cull_count);
+		cull_result = occlusion_cull_result.ptrw();
+	}
+
+	_render_scene(p_render_buffers, p_cam_transform, p_cam_projection, p_cam_ortogonal, cull_result, cull_count, p_light_cull_result, p_light_cull_count, p_reflection_probe_cull_result, p_reflection_probe_cull_count, p_gi_probe_cull_result, p_gi_probe_cull_count, p_environment, p_camera_effects, p_shadow_atlas, p_reflection_atlas, p_reflection_probe, p_reflection_probe_pass, clear_color);
+
+	if (occlusion_rb) {
+		_occlusion_cull_process(occlusion_rb, p_cull_result, p_cull_count, p_cam_transform, p_cam_projection);
+	}
 
 	if (p_render_buffers.is_valid()) {
 		RENDER_TIMESTAMP("Tonemap");
 
 		_render_buffers_post_process_and_tonemap(p_render_buffers, p_environment, p_camera_effects, p_cam_projection);
+
+		RENDER_TIMESTAMP("Debug Draw");
 		_render_buffers_debug_draw(p_render_buffers, p_shadow_atlas);
 	}
 }
 
-void RasterizerSceneRD::render_shadow(RID p_light, RID p_shadow_atlas, int p_pass, InstanceBase **p_cull_result, int p_cull_count) {
+void RasterizerSceneRD::_light_instance_update_static_shadow(LightInstance *p_light_instance, const Size2i &p_size, bool p_cubemap) {
+
+	LightInstance::StaticShadow &ss = p_light_instance->static_shadow;
+
+	if (ss.depth.is_valid() && ss.size == p_size && ss.cubemap == p_cubemap) {
+		return;
+	}
+
+	if (ss.depth.is_valid()) {
+		RD::get_singleton()->free(ss.depth);
+	}
+
+	RD::TextureFormat tf;
+	tf.format = RD::get_singleton()->texture_is_format_supported_for_usage(RD::DATA_FORMAT_D32_SFLOAT, RD::TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) ? RD::DATA_FORMAT_D32_SFLOAT : RD::DATA_FORMAT_X8_D24_UNORM_PACK32;
+	tf.width = p_size.width;
+	tf.height = p_size.height;
+	if (p_cubemap) {
+		tf.type = RD::TEXTURE_TYPE_CUBE;
+		tf.array_layers = 6;
+	}
+	tf.usage_bits = RD::TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | RD::TEXTURE_USAGE_CAN_COPY_FROM_BIT | RD::TEXTURE_USAGE_CAN_COPY_TO_BIT;
+
+	ss.depth = RD::get_singleton()->texture_create(tf, RD::TextureView());
+	ss.size = p_size;
+	ss.cubemap = p_cubemap;
+	ss.version = 0; //must redraw
+}
+
+void RasterizerSceneRD::render_shadow(RID p_light, RID p_shadow_atlas, int p_pass, InstanceBase **p_cull_result, int p_cull_count, int p_static_count, uint64_t p_static_version) {
 
 	LightInstance *light_instance = light_instance_owner.getornull(p_light);
 	ERR_FAIL_COND(!light_instance);
@@ -3513,6 +3763,13 @@ void RasterizerSceneRD::render_shadow(RID p_light, RID p_shadow_atlas, int p_pas
 	bool render_cubemap = false;
 	bool finalize_cubemap = false;
 
+	//static casters of atlas shadows are cached, directional shadows follow the camera so they are always redrawn
+	bool use_static_cache = false;
+	bool static_last_pass = false;
+	Size2i render_size;
+	Size2i static_size;
+	Vector3 static_offset;
+
 	CameraMatrix light_projection;
 	Transform light_transform;
 
@@ -3603,6 +3860,8 @@ void RasterizerSceneRD::render_shadow(RID p_light, RID p_shadow_atlas, int p_pas
 		bias = storage->light_get_param(light_instance->light, RS::LIGHT_PARAM_SHADOW_BIAS);
 		normal_bias = storage->light_get_param(light_instance->light, RS::LIGHT_PARAM_SHADOW_NORMAL_BIAS);
 
+		use_static_cache = shadow_static_cache;
+
 		if (storage->light_get_type(light_instance->light) == RS::LIGHT_OMNI) {
 
 			if (storage->light_omni_get_shadow_mode(light_instance->light) == RS::LIGHT_OMNI_SHADOW_CUBE) {
@@ -3617,6 +3876,10 @@ void RasterizerSceneRD::render_shadow(RID p_light, RID p_shadow_atlas, int p_pas
 				render_cubemap = true;
 				finalize_cubemap = p_pass == 5;
 
+				render_size = Size2i(shadow_size / 2, shadow_size / 2);
+				static_size = render_size;
+				static_last_pass = p_pass == 5;
+
 			} else {
 
 				light_projection = light_instance->shadow_transform[0].camera;
@@ -3631,6 +3894,12 @@ void RasterizerSceneRD::render_shadow(RID p_light, RID p_shadow_atlas, int p_pas
 				ShadowMap *shadow_map = _get_shadow_map(atlas_rect.size);
 				render_fb = shadow_map->fb;
 				render_texture = shadow_map->depth;
+
+				//both paraboloids share the cache, one above the other
+				render_size = atlas_rect.size;
+				static_size = Size2i(atlas_rect.size.width, atlas_rect.size.height * 2);
+				static_offset.y = p_pass * atlas_rect.size.height;
+				static_last_pass = p_pass == 1;
 			}
 
 		} else if (storage->light_get_type(light_instance->light) == RS::LIGHT_SPOT) {
@@ -3641,12 +3910,48 @@ void RasterizerSceneRD::render_shadow(RID p_light, RID p_shadow_atlas, int p_pas
 			ShadowMap *shadow_map = _get_shadow_map(atlas_rect.size);
 			render_fb = shadow_map->fb;
 			render_texture = shadow_map->depth;
+
+			render_size = atlas_rect.size;
+			static_size = atlas_rect.size;
+			static_last_pass = true;
 		}
 	}
 
+	//cubemap faces are biased when converted to paraboloids
+	float render_bias = render_cubemap ? 0 : bias;
+	float render_normal_bias = render_cubemap ? 0 : normal_bias;
+	float lod_resolution = render_cubemap ? atlas_rect.size.height / 2 : atlas_rect.size.height;
+
+	if (use_static_cache) {
+
+		if (p_pass == 0) {
+			_light_instance_update_static_shadow(light_instance, static_size, render_cubemap);
+			light_instance->static_shadow_redraw = light_instance->static_shadow.version != p_static_version;
+		}
+
+		RID static_depth = light_instance->static_shadow.depth;
+		int layer = render_cubemap ? p_pass : 0;
+		Vector3 size(render_size.width, render_size.height, 1);
+
+		if (light_instance->static_shadow_redraw) {
+			_render_shadow(render_fb, p_cull_result, p_static_count, light_projection, light_transform, zfar, render_bias, render_normal_bias, using_dual_paraboloid, using_dual_paraboloid_flip, lod_resolution, true);
+			RD::get_singleton()->texture_copy(render_texture, static_depth, Vector3(), static_offset, size, 0, 0, layer, layer, true);
+			if (static_last_pass) {
+				light_instance->static_shadow.version = p_static_version;
+			}
+		} else {
+			RD::get_singleton()->texture_copy(static_depth, render_texture, static_offset, Vector3(), size, 0, 0, layer, layer, true);
+		}
+
+		//dynamic casters are depth tested against the static ones
+		if (p_cull_count > p_static_count) {
+			_render_shadow(render_fb, p_cull_result + p_static_count, p_cull_count - p_static_count, light_projection, light_transform, zfar, render_bias, render_normal_bias, using_dual_paraboloid, using_dual_paraboloid_flip, lod_resolution, false);
+		}
+	} else {
+		_render_shadow(render_fb, p_cull_result, p_cull_count, light_projection, light_transform, zfar, render_bias, render_normal_bias, using_dual_paraboloid, using_dual_paraboloid_flip, lod_resolution, true);
+	}
+
 	if (render_cubemap) {
-		//rendering to cubemap
-		_render_shadow(render_fb, p_cull_result, p_cull_count, light_projection, light_transform, zfar, 0, 0, false, false);
 		if (finalize_cubemap) {
 			//reblit
 			atlas_rect.size.height /= 2;
@@ -3655,10 +3960,6 @@ void RasterizerSceneRD::render_shadow(RID p_light, RID p_shadow_atlas, int p_pas
 			storage->get_effects()->copy_cubemap_to_dp(render_texture, atlas_fb, atlas_rect, light_projection.get_z_near(), light_projection.get_z_far(), bias, true);
 		}
 	} else {
-		//render shadow
-
-		_render_shadow(render_fb, p_cull_result, p_cull_count, light_projection, light_transform, zfar, bias, normal_bias, using_dual_paraboloid, using_dual_paraboloid_flip);
-
 		//copy to atlas
 		storage->get_effects()->copy_to_rect(render_texture, atlas_fb, atlas_rect, true);
 
@@ -3758,6 +4059,10 @@ bool RasterizerSceneRD::free(RID p_rid) {
 			shadow_atlas->shadow_owners.erase(p_rid);
 		}
 
+		if (light_instance->static_shadow.depth.is_valid()) {
+			RD::get_singleton()->free(light_instance->static_shadow.depth);
+		}
+
 		light_instance_owner.free(p_rid);
 
 	} else if (shadow_atlas_owner.owns(p_rid)) {
@@ -3807,6 +4112,7 @@ RasterizerSceneRD::RasterizerSceneRD(RasterizerStorageRD *p_storage) {
 	roughness_layers = GLOBAL_GET("rendering/quality/reflections/roughness_layers");
 	sky_ggx_samples_quality = GLOBAL_GET("rendering/quality/reflections/ggx_samples");
 	sky_use_cubemap_array = GLOBAL_GET("rendering/quality/reflections/texture_array_reflections");
+	sky_filter_layers_per_frame = GLOBAL_GET("rendering/quality/reflections/sky_filter_layers_per_frame");
 	//	sky_use_cubemap_array = false;
 
 	uint32_t textures_per_stage = RD::get_singleton()->limit_get(RD::LIMIT_MAX_TEXTURES_PER_SHADER_STAGE);
@@ -4012,6 +4318,9 @@ RasterizerSceneRD::RasterizerSceneRD(RasterizerStorageRD *p_storage) {
 	screen_space_roughness_limiter = GLOBAL_GET("rendering/quality/filters/screen_space_roughness_limiter");
 	screen_space_roughness_limiter_curve = GLOBAL_GET("rendering/quality/filters/screen_space_roughness_limiter_curve");
 	glow_bicubic_upscale = int(GLOBAL_GET("rendering/quality/glow/upscale_mode")) > 0;
+	glow_use_compute = GLOBAL_GET("rendering/quality/glow/use_compute");
+	occlusion_culling = GLOBAL_GET("rendering/quality/occlusion_culling/enabled");
+	shadow_static_cache = GLOBAL_GET("rendering/quality/shadow_atlas/cache_static_casters");
 }
 
 RasterizerSceneRD::~RasterizerSceneRD() {
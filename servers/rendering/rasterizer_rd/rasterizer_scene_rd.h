@@ -79,7 +79,7 @@ protected:
 	virtual RenderBufferData *_create_render_buffer_data() = 0;
 
 	virtual void _render_scene(RID p_render_buffer, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_ortogonal, InstanceBase **p_cull_result, int p_cull_count, RID *p_light_cull_result, int p_light_cull_count, RID *p_reflection_probe_cull_result, int p_reflection_probe_cull_count, RID *p_gi_probe_cull_result, int p_gi_probe_cull_count, RID p_environment, RID p_camera_effects, RID p_shadow_atlas, RID p_reflection_atlas, RID p_reflection_probe, int p_reflection_probe_pass, const Color &p_default_color) = 0;
-	virtual void _render_shadow(RID p_framebuffer, InstanceBase **p_cull_result, int p_cull_count, const CameraMatrix &p_projection, const Transform &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool use_dp_flip) = 0;
+	virtual void _render_shadow(RID p_framebuffer, InstanceBase **p_cull_result, int p_cull_count, const CameraMatrix &p_projection, const Transform &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool use_dp_flip, float p_lod_resolution, bool p_clear) = 0;
 	virtual void _render_material(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_ortogonal, InstanceBase **p_cull_result, int p_cull_count, RID p_framebuffer, const Rect2i &p_region) = 0;
 
 	virtual void _debug_giprobe(RID p_gi_probe, RenderingDevice::DrawListID p_draw_list, RID p_framebuffer, const CameraMatrix &p_camera_with_transform, bool p_lighting, bool p_emission, float p_alpha);
@@ -260,6 +260,7 @@ private:
 		ReflectionData reflection;
 		bool dirty = false;
 		Sky *dirty_list = nullptr;
+		int processing_layer = -1; //radiance update in progress, next layer to filter (0 renders the cubemap)
 
 		//State to track when radiance cubemap needs updating
 		SkyMaterialData *prev_material;
@@ -275,6 +276,7 @@ private:
 
 	uint32_t sky_ggx_samples_quality;
 	bool sky_use_cubemap_array;
+	int sky_filter_layers_per_frame; //0 filters all layers at once
 
 	mutable RID_Owner<Sky> sky_owner;
 
@@ -598,6 +600,16 @@ private:
 
 		Set<RID> shadow_atlases; //shadow atlases where this light is registered
 
+		//depth of the static casters alone, dynamic ones are drawn over a copy of it
+		struct StaticShadow {
+			RID depth;
+			Size2i size;
+			bool cubemap = false;
+			uint64_t version = 0;
+		} static_shadow;
+
+		bool static_shadow_redraw = false;
+
 		LightInstance() {}
 	};
 
@@ -662,6 +674,7 @@ private:
 	RS::EnvironmentSSAOQuality ssao_quality = RS::ENV_SSAO_QUALITY_MEDIUM;
 	bool ssao_half_size = false;
 	bool glow_bicubic_upscale = false;
+	bool glow_use_compute = true;
 
 	static uint64_t auto_exposure_counter;
 
@@ -733,6 +746,29 @@ private:
 			RID ao[2];
 			RID ao_full; //when using half-size
 		} ssao;
+
+		struct Occlusion {
+			RID hiz; //farthest depth pyramid, mipmap 0 is half the render size
+			Vector<RID> hiz_slices;
+			Size2i hiz_size;
+
+			RID instance_buffer; //bounds of the instances tested this frame
+			uint32_t instance_buffer_size = 0;
+
+			RID visibility_buffer; //one result per occlusion id, written by the GPU
+			RID visibility_readback;
+			uint32_t visibility_size = 0;
+
+			struct Slot {
+				uint32_t generation = 0;
+				uint64_t tested_since = 0; //first frame of the current run of consecutive tests
+				uint64_t last_tested = 0;
+			};
+
+			Vector<Slot> slots;
+			Vector<uint8_t> visibility; //latest results read back from the GPU
+			uint64_t visibility_frame = 0; //frame those results were recorded in
+		} occlusion;
 	};
 
 	bool screen_space_roughness_limiter = false;
@@ -745,10 +781,20 @@ private:
 	void _allocate_luminance_textures(RenderBuffers *rb);
 
 	void _render_buffers_debug_draw(RID p_render_buffers, RID p_shadow_atlas);
+
+	bool occlusion_culling = false;
+	Vector<InstanceBase *> occlusion_cull_result;
+	Vector<float> occlusion_instance_data;
+
+	int _occlusion_cull_filter(RenderBuffers *rb, InstanceBase **p_cull_result, int p_cull_count);
+	void _occlusion_cull_process(RenderBuffers *rb, InstanceBase **p_cull_result, int p_cull_count, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection);
 	void _render_buffers_post_process_and_tonemap(RID p_render_buffers, RID p_environment, RID p_camera_effects, const CameraMatrix &p_projection);
 
 	uint64_t scene_pass = 0;
 	uint64_t shadow_atlas_realloc_tolerance_msec = 500;
+	bool shadow_static_cache = true;
+
+	void _light_instance_update_static_shadow(LightInstance *p_light_instance, const Size2i &p_size, bool p_cubemap);
 
 public:
 	/* SHADOW ATLAS API */
@@ -1080,7 +1126,7 @@ public:
 
 	void render_scene(RID p_render_buffers, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_ortogonal, InstanceBase **p_cull_result, int p_cull_count, RID *p_light_cull_result, int p_light_cull_count, RID *p_reflection_probe_cull_result, int p_reflection_probe_cull_count, RID *p_gi_probe_cull_result, int p_gi_probe_cull_count, RID p_environment, RID p_shadow_atlas, RID p_camera_effects, RID p_reflection_atlas, RID p_reflection_probe, int p_reflection_probe_pass);
 
-	void render_shadow(RID p_light, RID p_shadow_atlas, int p_pass, InstanceBase **p_cull_result, int p_cull_count);
+	void render_shadow(RID p_light, RID p_shadow_atlas, int p_pass, InstanceBase **p_cull_result, int p_cull_count, int p_static_count, uint64_t p_static_version);
 
 	void render_material(const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_ortogonal, InstanceBase **p_cull_result, int p_cull_count, RID p_framebuffer, const Rect2i &p_region);
 
@@ -662,6 +662,7 @@ void RasterizerStorageRD::_texture_2d_update(RID p_texture, const Ref<Image> &p_
 	Ref<Image> validated = _validate_texture_format(p_image, f);
 
 	RD::get_singleton()->texture_update(tex->rd_texture, p_layer, validated->get_data(), !p_immediate);
+	tex->update_version++;
 }
 
 void RasterizerStorageRD::texture_2d_update_immediate(RID p_texture, const Ref<Image> &p_image, int p_layer) {
@@ -796,10 +797,14 @@ void RasterizerStorageRD::texture_replace(RID p_texture, RID p_by_texture) {
 
 	Vector<RID> proxies_to_update = tex->proxies;
 	Vector<RID> proxies_to_redirect = by_tex->proxies;
+	Texture::Stream stream = tex->stream;
 
 	*tex = *by_tex;
 
 	tex->proxies = proxies_to_update; //restore proxies, so they can be updated
+	tex->stream = stream; //keep streaming, this is how new resolutions arrive
+	tex->stream.pending_size = 0;
+	texture_streaming.textures.erase(p_by_texture);
 
 	for (int i = 0; i < proxies_to_update.size(); i++) {
 		texture_proxy_update(proxies_to_update[i], p_texture);
@@ -845,6 +850,123 @@ void RasterizerStorageRD::texture_set_detect_roughness_callback(RID p_texture, R
 	tex->detect_roughness_callback_ud = p_userdata;
 	tex->detect_roughness_callback = p_callback;
 }
+void RasterizerStorageRD::texture_set_stream_callback(RID p_texture, int p_max_size, RS::TextureStreamCallback p_callback, void *p_userdata) {
+	Texture *tex = texture_owner.getornull(p_texture);
+	ERR_FAIL_COND(!tex);
+	ERR_FAIL_COND(tex->type != Texture::TYPE_2D);
+
+	tex->stream.callback = p_callback;
+	tex->stream.callback_ud = p_userdata;
+	tex->stream.max_size = p_max_size;
+	tex->stream.pending_size = 0;
+
+	if (p_callback) {
+		texture_streaming.textures.insert(p_texture);
+	} else {
+		texture_streaming.textures.erase(p_texture);
+	}
+}
+
+void RasterizerStorageRD::texture_stream_request(const Vector<RID> &p_textures, float p_size) {
+
+	for (int i = 0; i < p_textures.size(); i++) {
+		Texture *tex = texture_owner.getornull(p_textures[i]);
+		if (!tex || !tex->stream.callback) {
+			continue;
+		}
+		tex->stream.requested_size = MAX(tex->stream.requested_size, p_size);
+	}
+}
+
+void RasterizerStorageRD::texture_stream_pin(RID p_texture) {
+	Texture *tex = texture_owner.getornull(p_texture);
+	if (tex) {
+		tex->stream.pinned = true;
+	}
+}
+
+uint64_t RasterizerStorageRD::_get_texture_stream_mem(const Texture *p_texture, int p_size) const {
+
+	//scale the current size, the aspect ratio is kept by every mipmap
+	int current = next_power_of_2(MAX(p_texture->width, p_texture->height));
+	int w = MAX(1, p_texture->width * p_size / current);
+	int h = MAX(1, p_texture->height * p_size / current);
+
+	return Image::get_image_data_size(w, h, p_texture->validated_format, p_texture->mipmaps > 1);
+}
+
+void RasterizerStorageRD::_update_texture_streaming() {
+
+	texture_streaming.frame++;
+	texture_streaming.mem_used = 0;
+	texture_streaming.pending_requests = 0;
+
+	if (texture_streaming.textures.empty()) {
+		return;
+	}
+
+	//find out the size every texture should have from what the renderer requested,
+	//sizes are powers of 2 as loading picks the largest mipmap that fits
+	int largest = 0;
+	for (Set<RID>::Element *E = texture_streaming.textures.front(); E; E = E->next()) {
+		Texture *tex = texture_owner.getornull(E->get());
+		ERR_CONTINUE(!tex);
+
+		Texture::Stream &stream = tex->stream;
+		int max_size = next_power_of_2(stream.max_size);
+		int min_size = MIN(texture_streaming.min_size, max_size);
+
+		if (stream.pinned) {
+			stream.wanted_size = max_size;
+		} else if (stream.requested_size > 0) {
+			stream.wanted_size = CLAMP(int(next_power_of_2(uint32_t(Math::ceil(stream.requested_size)))), min_size, max_size);
+			stream.last_used_frame = texture_streaming.frame;
+		} else if (stream.wanted_size == 0 || texture_streaming.frame - stream.last_used_frame > TextureStreaming::KEEP_FRAMES) {
+			stream.wanted_size = min_size;
+		}
+		stream.requested_size = 0;
+
+		largest = MAX(largest, stream.wanted_size);
+	}
+
+	//when over budget, lower the largest textures first (pinned ones can't be lowered)
+	int size_cap = largest;
+	while (size_cap > texture_streaming.min_size) {
+		uint64_t total = 0;
+		for (Set<RID>::Element *E = texture_streaming.textures.front(); E; E = E->next()) {
+			Texture *tex = texture_owner.getornull(E->get());
+			ERR_CONTINUE(!tex);
+			total += _get_texture_stream_mem(tex, tex->stream.pinned ? tex->stream.wanted_size : MIN(tex->stream.wanted_size, size_cap));
+		}
+		if (total <= texture_streaming.budget) {
+			break;
+		}
+		size_cap >>= 1;
+	}
+
+	int requests = 0;
+	for (Set<RID>::Element *E = texture_streaming.textures.front(); E; E = E->next()) {
+		Texture *tex = texture_owner.getornull(E->get());
+		ERR_CONTINUE(!tex);
+
+		Texture::Stream &stream = tex->stream;
+		int size = stream.pinned ? stream.wanted_size : MIN(stream.wanted_size, MAX(size_cap, texture_streaming.min_size));
+		int current = next_power_of_2(MAX(tex->width, tex->height));
+
+		texture_streaming.mem_used += _get_texture_stream_mem(tex, current);
+
+		if (stream.pending_size == 0 && size != current && requests < TextureStreaming::MAX_REQUESTS_PER_FRAME) {
+			//the callback reloads the texture in the background and replaces it when done
+			stream.pending_size = size;
+			stream.callback(stream.callback_ud, size);
+			requests++;
+		}
+
+		if (stream.pending_size != 0) {
+			texture_streaming.pending_requests++;
+		}
+	}
+}
 void RasterizerStorageRD::texture_debug_usage(List<RS::TextureInfo> *r_info) {
 }
 
@@ -1663,6 +1785,8 @@ void RasterizerStorageRD::MaterialData::update_uniform_buffer(const Map<StringNa
 void RasterizerStorageRD::MaterialData::update_textures(const Map<StringName, Variant> &p_parameters, const Map<StringName, RID> &p_default_textures, const Vector<ShaderCompilerRD::GeneratedCode::Texture> &p_texture_uniforms, RID *p_textures, bool p_use_linear_color) {
 
 	RasterizerStorageRD *singleton = (RasterizerStorageRD *)RasterizerStorage::base_singleton;
+
+	streamed_textures.clear();
 #ifdef TOOLS_ENABLED
 	Texture *roughness_detect_texture = nullptr;
 	RS::TextureDetectRoughnessChannel roughness_channel = RS::TEXTURE_DETECT_ROUGNHESS_R;
@@ -1715,6 +1839,14 @@ void RasterizerStorageRD::MaterialData::update_textures(const Map<StringName, Va
 			if (tex) {
 
 				rd_texture = (srgb && tex->rd_texture_srgb.is_valid()) ? tex->rd_texture_srgb : tex->rd_texture;
+
+				if (tex->stream.callback) {
+					if (p_use_linear_color) {
+						streamed_textures.push_back(texture); //3D, resolution is requested when drawn
+					} else {
+						tex->stream.pinned = true;
+					}
+				}
 #ifdef TOOLS_ENABLED
 				if (tex->detect_3d_callback && p_use_linear_color) {
 					tex->detect_3d_callback(tex->detect_3d_callback_ud);
@@ -1808,6 +1940,8 @@ void RasterizerStorageRD::mesh_add_surface(RID p_mesh, const RS::SurfaceData &p_
 
 						if (p_surface.format & RS::ARRAY_FLAG_USE_2D_VERTICES) {
 							stride += sizeof(float) * 2;
+						} else if (p_surface.format & RS::ARRAY_COMPRESS_VERTEX) {
+							stride += sizeof(uint16_t) * 4;
 						} else {
 							stride += sizeof(float) * 3;
 						}
@@ -1818,7 +1952,7 @@ void RasterizerStorageRD::mesh_add_surface(RID p_mesh, const RS::SurfaceData &p_
 						if (p_surface.format & RS::ARRAY_COMPRESS_NORMAL) {
 							stride += sizeof(int8_t) * 4;
 						} else {
-							stride += sizeof(float) * 4;
+							stride += sizeof(float) * 3;
 						}
 
 					} break;
@@ -2259,6 +2393,9 @@ void RasterizerStorageRD::_mesh_surface_generate_version_for_input_mask(Mesh::Su
 					if (s->format & RS::ARRAY_FLAG_USE_2D_VERTICES) {
 						vd.format = RD::DATA_FORMAT_R32G32_SFLOAT;
 						stride += sizeof(float) * 2;
+					} else if (s->format & RS::ARRAY_COMPRESS_VERTEX) {
+						vd.format = RD::DATA_FORMAT_R16G16B16A16_UNORM; //relative to the surface AABB, decoded in the shader
+						stride += sizeof(uint16_t) * 4;
 					} else {
 						vd.format = RD::DATA_FORMAT_R32G32B32_SFLOAT;
 						stride += sizeof(float) * 3;
@@ -2268,18 +2405,18 @@ void RasterizerStorageRD::_mesh_surface_generate_version_for_input_mask(Mesh::Su
 				case RS::ARRAY_NORMAL: {
 
 					if (s->format & RS::ARRAY_COMPRESS_NORMAL) {
-						vd.format = RD::DATA_FORMAT_R8G8B8A8_SNORM;
+						vd.format = (s->format & RS::ARRAY_FLAG_USE_OCTAHEDRAL_COMPRESSION) ? RD::DATA_FORMAT_R16G16_SNORM : RD::DATA_FORMAT_R8G8B8A8_SNORM;
 						stride += sizeof(int8_t) * 4;
 					} else {
-						vd.format = RD::DATA_FORMAT_R32G32B32A32_SFLOAT;
-						stride += sizeof(float) * 4;
+						vd.format = RD::DATA_FORMAT_R32G32B32_SFLOAT;
+						stride += sizeof(float) * 3;
 					}
 
 				} break;
 				case RS::ARRAY_TANGENT: {
 
 					if (s->format & RS::ARRAY_COMPRESS_TANGENT) {
-						vd.format = RD::DATA_FORMAT_R8G8B8A8_SNORM;
+						vd.format = (s->format & RS::ARRAY_FLAG_USE_OCTAHEDRAL_COMPRESSION) ? RD::DATA_FORMAT_R16G16_SNORM : RD::DATA_FORMAT_R8G8B8A8_SNORM;
 						stride += sizeof(int8_t) * 4;
 					} else {
 						vd.format = RD::DATA_FORMAT_R32G32B32A32_SFLOAT;
@@ -2803,6 +2940,29 @@ void RasterizerStorageRD::multimesh_set_buffer(RID p_multimesh, const Vector<flo
 	}
 }
 
+void RasterizerStorageRD::multimesh_set_buffer_range(RID p_multimesh, int p_first_instance, const Vector<float> &p_buffer) {
+	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
+	ERR_FAIL_COND(!multimesh);
+	ERR_FAIL_COND(multimesh->stride_cache == 0);
+	ERR_FAIL_COND_MSG(p_buffer.size() % multimesh->stride_cache != 0, "Buffer size must be a multiple of the instance stride.");
+	int count = p_buffer.size() / multimesh->stride_cache;
+	if (count == 0) {
+		return;
+	}
+	ERR_FAIL_COND(p_first_instance < 0 || p_first_instance + count > multimesh->instances);
+
+	//the range is written to the CPU cache and only the regions it touches are uploaded
+	_multimesh_make_local(multimesh);
+
+	copymem(multimesh->data_cache.ptrw() + p_first_instance * multimesh->stride_cache, p_buffer.ptr(), p_buffer.size() * sizeof(float));
+
+	uint32_t from_region = p_first_instance / MULTIMESH_DIRTY_REGION_SIZE;
+	uint32_t to_region = (p_first_instance + count - 1) / MULTIMESH_DIRTY_REGION_SIZE;
+	for (uint32_t i = from_region; i <= to_region; i++) {
+		_multimesh_mark_dirty(multimesh, i * MULTIMESH_DIRTY_REGION_SIZE, true);
+	}
+}
+
 Vector<float> RasterizerStorageRD::multimesh_get_buffer(RID p_multimesh) const {
 	MultiMesh *multimesh = multimesh_owner.getornull(p_multimesh);
 	ERR_FAIL_COND_V(!multimesh, Vector<float>());
@@ -2879,13 +3039,20 @@ void RasterizerStorageRD::_update_dirty_multimeshes() {
 					//if there too many dirty regions, or represent the majority of regions, just copy all, else transfer cost piles up too much
 					RD::get_singleton()->buffer_update(multimesh->buffer, 0, MIN(visible_region_count * region_size, multimesh->instances * multimesh->stride_cache * sizeof(float)), data, false);
 				} else {
-					//not that many regions? update them all
-					for (uint32_t i = 0; i < visible_region_count; i++) {
-						if (multimesh->data_cache_dirty_regions[i]) {
-							uint64_t offset = i * region_size;
-							uint64_t size = multimesh->stride_cache * multimesh->instances * sizeof(float);
-							RD::get_singleton()->buffer_update(multimesh->buffer, offset, MIN(region_size, size - offset), &data[i * region_size], false);
+					//not that many regions? update them, merging contiguous runs into a single transfer
+					uint64_t size = multimesh->stride_cache * multimesh->instances * sizeof(float);
+					uint32_t i = 0;
+					while (i < visible_region_count) {
+						if (!multimesh->data_cache_dirty_regions[i]) {
+							i++;
+							continue;
 						}
+						uint32_t from = i;
+						while (i < visible_region_count && multimesh->data_cache_dirty_regions[i]) {
+							i++;
+						}
+						uint64_t offset = from * region_size;
+						RD::get_singleton()->buffer_update(multimesh->buffer, offset, MIN((i - from) * region_size, size - offset), &data[from * MULTIMESH_DIRTY_REGION_SIZE * multimesh->stride_cache], false);
 					}
 				}
 
@@ -2993,6 +3160,22 @@ void RasterizerStorageRD::skeleton_bone_set_transform(RID p_skeleton, int p_bone
 	_skeleton_make_dirty(skeleton);
 }
 
+void RasterizerStorageRD::skeleton_set_bone_transforms(RID p_skeleton, const Vector<float> &p_buffer) {
+
+	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
+
+	ERR_FAIL_COND(!skeleton);
+	ERR_FAIL_COND(skeleton->use_2d);
+	ERR_FAIL_COND(p_buffer.size() != skeleton->size * 12);
+
+	if (skeleton->size == 0)
+		return;
+
+	skeleton->data = p_buffer; // same layout, so the buffer is shared and uploaded as-is
+
+	_skeleton_make_dirty(skeleton);
+}
+
 Transform RasterizerStorageRD::skeleton_bone_get_transform(RID p_skeleton, int p_bone) const {
 
 	Skeleton *skeleton = skeleton_owner.getornull(p_skeleton);
@@ -3559,6 +3742,13 @@ void RasterizerStorageRD::gi_probe_allocate(RID p_gi_probe, const Transform &p_t
 	GIProbe *gi_probe = gi_probe_owner.getornull(p_gi_probe);
 	ERR_FAIL_COND(!gi_probe);
 
+	//region updates keep the size, so the distance field texture can be updated in place
+	RID reuse_sdf_texture;
+	if (gi_probe->sdf_texture.is_valid() && gi_probe->octree_size == p_octree_size && p_octree_cells.size() && p_octree_cells.size() % 32 == 0 && p_data_cells.size() * 2 == p_octree_cells.size() && p_distance_field.size()) {
+		reuse_sdf_texture = gi_probe->sdf_texture;
+		gi_probe->sdf_texture = RID();
+	}
+
 	if (gi_probe->octree_buffer.is_valid()) {
 		RD::get_singleton()->free(gi_probe->octree_buffer);
 		RD::get_singleton()->free(gi_probe->data_buffer);
@@ -3592,7 +3782,10 @@ void RasterizerStorageRD::gi_probe_allocate(RID p_gi_probe, const Transform &p_t
 		gi_probe->data_buffer = RD::get_singleton()->storage_buffer_create(p_data_cells.size(), p_data_cells);
 		gi_probe->data_buffer_size = p_data_cells.size();
 
-		if (p_distance_field.size()) {
+		if (reuse_sdf_texture.is_valid()) {
+			gi_probe->sdf_texture = reuse_sdf_texture;
+			RD::get_singleton()->texture_update(gi_probe->sdf_texture, 0, p_distance_field);
+		} else if (p_distance_field.size()) {
 			RD::TextureFormat tf;
 			tf.format = RD::DATA_FORMAT_R8_UNORM;
 			tf.width = gi_probe->octree_size.x;
@@ -4291,6 +4484,26 @@ void RasterizerStorageRD::update_dirty_resources() {
 	_update_queued_materials();
 	_update_dirty_multimeshes();
 	_update_dirty_skeletons();
+	_update_texture_streaming();
+}
+
+int RasterizerStorageRD::get_render_info(RS::RenderInfo p_info) {
+
+	switch (p_info) {
+		case RS::INFO_TEXTURE_STREAMING_MEM_USED: {
+			return texture_streaming.mem_used;
+		} break;
+		case RS::INFO_TEXTURE_STREAMING_TEXTURE_COUNT: {
+			return texture_streaming.textures.size();
+		} break;
+		case RS::INFO_TEXTURE_STREAMING_PENDING_REQUESTS: {
+			return texture_streaming.pending_requests;
+		} break;
+		default: {
+		}
+	}
+
+	return 0;
 }
 
 bool RasterizerStorageRD::has_os_feature(const String &p_feature) const {
@@ -4324,6 +4537,8 @@ bool RasterizerStorageRD::free(RID p_rid) {
 
 		ERR_FAIL_COND_V(t->is_render_target, false);
 
+		texture_streaming.textures.erase(p_rid);
+
 		if (RD::get_singleton()->texture_is_valid(t->rd_texture_srgb)) {
 			//erase this first, as it's a dependency of the one below
 			RD::get_singleton()->free(t->rd_texture_srgb);
@@ -4457,6 +4672,11 @@ RasterizerStorageRD::RasterizerStorageRD() {
 	}
 
 	material_update_list = NULL;
+
+	texture_streaming.enabled = GLOBAL_GET("rendering/quality/texture_streaming/enabled");
+	texture_streaming.budget = uint64_t(int(GLOBAL_GET("rendering/quality/texture_streaming/budget_mb"))) * 1024 * 1024;
+	texture_streaming.min_size = next_power_of_2(MAX(int(GLOBAL_GET("rendering/quality/texture_streaming/min_size")), 1));
+
 	{ //create default textures
 
 		RD::TextureFormat tformat;
@@ -66,6 +66,8 @@ public:
 		void update_uniform_buffer(const Map<StringName, ShaderLanguage::ShaderNode::Uniform> &p_uniforms, const uint32_t *p_uniform_offsets, const Map<StringName, Variant> &p_parameters, uint8_t *p_buffer, uint32_t p_buffer_size, bool p_use_linear_color);
 		void update_textures(const Map<StringName, Variant> &p_parameters, const Map<StringName, RID> &p_default_textures, const Vector<ShaderCompilerRD::GeneratedCode::Texture> &p_texture_uniforms, RID *p_textures, bool p_use_linear_color);
 
+		Vector<RID> streamed_textures; //filled by update_textures, so the renderer can request their resolution
+
 		virtual void set_render_priority(int p_priority) = 0;
 		virtual void set_next_pass(RID p_pass) = 0;
 		virtual void update_parameters(const Map<StringName, Variant> &p_parameters, bool p_uniform_dirty, bool p_textures_dirty) = 0;
@@ -132,6 +134,8 @@ private:
 		bool is_render_target;
 		bool is_proxy;
 
+		uint32_t update_version = 0; //bumped when the contents change in place
+
 		Ref<Image> image_cache_2d;
 		String path;
 
@@ -146,6 +150,17 @@ private:
 
 		RS::TextureDetectRoughnessCallback detect_roughness_callback = nullptr;
 		void *detect_roughness_callback_ud = nullptr;
+
+		struct Stream {
+			RS::TextureStreamCallback callback = nullptr;
+			void *callback_ud = nullptr;
+			int max_size = 0; //largest side when fully loaded
+			float requested_size = 0; //largest side requested by the renderer since the last update
+			int wanted_size = 0;
+			int pending_size = 0; //requested from the callback, not loaded yet
+			uint64_t last_used_frame = 0;
+			bool pinned = false; //used in 2D, always fully loaded
+		} stream;
 	};
 
 	struct TextureToRDFormat {
@@ -170,6 +185,25 @@ private:
 
 	Ref<Image> _validate_texture_format(const Ref<Image> &p_image, TextureToRDFormat &r_format);
 
+	struct TextureStreaming {
+		enum {
+			KEEP_FRAMES = 120, //frames a resolution is kept after the texture was last seen
+			MAX_REQUESTS_PER_FRAME = 4
+		};
+
+		bool enabled = false;
+		uint64_t budget = 0;
+		int min_size = 64;
+		uint64_t frame = 0;
+		Set<RID> textures;
+
+		uint64_t mem_used = 0;
+		int pending_requests = 0;
+	} texture_streaming;
+
+	uint64_t _get_texture_stream_mem(const Texture *p_texture, int p_size) const;
+	void _update_texture_streaming();
+
 	RID default_rd_textures[DEFAULT_RD_TEXTURE_MAX];
 	RID default_rd_samplers[RS::CANVAS_ITEM_TEXTURE_FILTER_MAX][RS::CANVAS_ITEM_TEXTURE_REPEAT_MAX];
 
@@ -527,6 +561,11 @@ public:
 	virtual void texture_set_detect_3d_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata);
 	virtual void texture_set_detect_normal_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata);
 	virtual void texture_set_detect_roughness_callback(RID p_texture, RS::TextureDetectRoughnessCallback p_callback, void *p_userdata);
+	virtual void texture_set_stream_callback(RID p_texture, int p_max_size, RS::TextureStreamCallback p_callback, void *p_userdata);
+
+	void texture_stream_request(const Vector<RID> &p_textures, float p_size);
+	void texture_stream_pin(RID p_texture);
+	_FORCE_INLINE_ bool is_texture_streaming_enabled() const { return texture_streaming.enabled; }
 
 	virtual void texture_debug_usage(List<RS::TextureInfo> *r_info);
 
@@ -549,6 +588,22 @@ public:
 		return (p_srgb && tex->rd_texture_srgb.is_valid()) ? tex->rd_texture_srgb : tex->rd_texture;
 	}
 
+	//used by the canvas texture atlas, only plain RGBA8 2D textures can be copied into it
+	_FORCE_INLINE_ bool texture_2d_get_atlas_source(RID p_texture, RID &r_rd_texture, Size2i &r_size, uint32_t &r_version) {
+		Texture *tex = texture_owner.getornull(p_texture);
+
+		if (!tex || tex->type != Texture::TYPE_2D || tex->is_render_target || tex->rd_format != RD::DATA_FORMAT_R8G8B8A8_UNORM) {
+			return false;
+		}
+		if (tex->width_2d != tex->width || tex->height_2d != tex->height) {
+			return false; //size override, drawn scaled
+		}
+		r_rd_texture = tex->rd_texture;
+		r_size = Size2i(tex->width, tex->height);
+		r_version = tex->update_version;
+		return true;
+	}
+
 	_FORCE_INLINE_ Size2i texture_2d_get_size(RID p_texture) {
 		if (p_texture.is_null()) {
 			return Size2i();
@@ -663,14 +718,46 @@ public:
 		return mesh->surfaces[p_surface_index]->primitive;
 	}
 
-	_FORCE_INLINE_ void mesh_surface_get_arrays_and_format(RID p_mesh, uint32_t p_surface_index, uint32_t p_input_mask, RID &r_vertex_array_rd, RID &r_index_array_rd, RD::VertexFormatID &r_vertex_format) {
+	_FORCE_INLINE_ uint32_t mesh_surface_get_format(RID p_mesh, uint32_t p_surface_index) {
+		Mesh *mesh = mesh_owner.getornull(p_mesh);
+		ERR_FAIL_COND_V(!mesh, 0);
+		ERR_FAIL_UNSIGNED_INDEX_V(p_surface_index, mesh->surface_count, 0);
+
+		return mesh->surfaces[p_surface_index]->format;
+	}
+
+	//compressed vertices are relative to these bounds
+	_FORCE_INLINE_ AABB mesh_surface_get_aabb(RID p_mesh, uint32_t p_surface_index) {
+		Mesh *mesh = mesh_owner.getornull(p_mesh);
+		ERR_FAIL_COND_V(!mesh, AABB());
+		ERR_FAIL_UNSIGNED_INDEX_V(p_surface_index, mesh->surface_count, AABB());
+
+		return mesh->surfaces[p_surface_index]->aabb;
+	}
+
+	//0 is the full detail surface, p_pixels_per_unit converts the error of each level to pixels
+	_FORCE_INLINE_ uint32_t mesh_surface_get_lod(RID p_mesh, uint32_t p_surface_index, float p_pixels_per_unit, float p_threshold) {
+		Mesh *mesh = mesh_owner.getornull(p_mesh);
+		ERR_FAIL_COND_V(!mesh, 0);
+		ERR_FAIL_UNSIGNED_INDEX_V(p_surface_index, mesh->surface_count, 0);
+
+		Mesh::Surface *s = mesh->surfaces[p_surface_index];
+
+		uint32_t lod = 0;
+		while (lod < s->lod_count && s->lods[lod].edge_length * p_pixels_per_unit <= p_threshold) {
+			lod++;
+		}
+		return lod;
+	}
+
+	_FORCE_INLINE_ void mesh_surface_get_arrays_and_format(RID p_mesh, uint32_t p_surface_index, uint32_t p_input_mask, RID &r_vertex_array_rd, RID &r_index_array_rd, RD::VertexFormatID &r_vertex_format, uint32_t p_lod = 0) {
 		Mesh *mesh = mesh_owner.getornull(p_mesh);
 		ERR_FAIL_COND(!mesh);
 		ERR_FAIL_UNSIGNED_INDEX(p_surface_index, mesh->surface_count);
 
 		Mesh::Surface *s = mesh->surfaces[p_surface_index];
 
-		r_index_array_rd = s->index_array;
+		r_index_array_rd = (p_lod > 0 && p_lod <= s->lod_count) ? s->lods[p_lod - 1].index_array : s->index_array;
 
 		s->version_lock.lock();
 
@@ -749,6 +836,7 @@ public:
 	Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const;
 
 	void multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_buffer);
+	void multimesh_set_buffer_range(RID p_multimesh, int p_first_instance, const Vector<float> &p_buffer);
 	Vector<float> multimesh_get_buffer(RID p_multimesh) const;
 
 	void multimesh_set_visible_instances(RID p_multimesh, int p_visible);
@@ -818,6 +906,7 @@ public:
 	void skeleton_set_world_transform(RID p_skeleton, bool p_enable, const Transform &p_world_transform);
 	int skeleton_get_bone_count(RID p_skeleton) const;
 	void skeleton_bone_set_transform(RID p_skeleton, int p_bone, const Transform &p_transform);
+	void skeleton_set_bone_transforms(RID p_skeleton, const Vector<float> &p_buffer);
 	Transform skeleton_bone_get_transform(RID p_skeleton, int p_bone) const;
 	void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform);
 	Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const;
@@ -1112,7 +1201,7 @@ public:
 	void render_info_end_capture() {}
 	int get_captured_render_info(RS::RenderInfo p_info) { return 0; }
 
-	int get_render_info(RS::RenderInfo p_info) { return 0; }
+	int get_render_info(RS::RenderInfo p_info);
 	String get_video_adapter_name() const { return String(); }
 	String get_video_adapter_vendor() const { return String(); }
 
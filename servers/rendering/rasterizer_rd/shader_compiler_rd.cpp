@@ -671,6 +671,7 @@ String ShaderCompilerRD::_dump_node_code(const SL::Node *p_node, int p_level, Ge
 
 			if (p_assigning && p_actions.write_flag_pointers.has(vnode->name)) {
 				*p_actions.write_flag_pointers[vnode->name] = true;
+				used_write_flags.insert(vnode->name);
 			}
 
 			if (p_default_actions.usage_defines.has(vnode->name) && !used_name_defines.has(vnode->name)) {
@@ -777,6 +778,7 @@ String ShaderCompilerRD::_dump_node_code(const SL::Node *p_node, int p_level, Ge
 
 			if (p_assigning && p_actions.write_flag_pointers.has(anode->name)) {
 				*p_actions.write_flag_pointers[anode->name] = true;
+				used_write_flags.insert(anode->name);
 			}
 
 			if (p_default_actions.usage_defines.has(anode->name) && !used_name_defines.has(anode->name)) {
@@ -1037,8 +1039,56 @@ String ShaderCompilerRD::_dump_node_code(const SL::Node *p_node, int p_level, Ge
 	return code;
 }
 
+void ShaderCompilerRD::_apply_cached(const CachedCode &p_cached, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+
+	for (int i = 0; i < p_cached.render_modes.size(); i++) {
+		const StringName &mode = p_cached.render_modes[i];
+
+		if (p_actions->render_mode_flags.has(mode)) {
+			*p_actions->render_mode_flags[mode] = true;
+		}
+
+		if (p_actions->render_mode_values.has(mode)) {
+			Pair<int *, int> &p = p_actions->render_mode_values[mode];
+			*p.first = p.second;
+		}
+	}
+
+	for (int i = 0; i < p_cached.usage_flags.size(); i++) {
+		if (p_actions->usage_flag_pointers.has(p_cached.usage_flags[i])) {
+			*p_actions->usage_flag_pointers[p_cached.usage_flags[i]] = true;
+		}
+	}
+
+	for (int i = 0; i < p_cached.write_flags.size(); i++) {
+		if (p_actions->write_flag_pointers.has(p_cached.write_flags[i])) {
+			*p_actions->write_flag_pointers[p_cached.write_flags[i]] = true;
+		}
+	}
+
+	if (p_actions->uniforms) {
+		for (const Map<StringName, ShaderLanguage::ShaderNode::Uniform>::Element *E = p_cached.uniforms.front(); E; E = E->next()) {
+			p_actions->uniforms->insert(E->key(), E->get());
+		}
+	}
+
+	r_gen_code = p_cached.gen_code;
+}
+
+void ShaderCompilerRD::clear_cache() {
+	code_cache.clear();
+}
+
 Error ShaderCompilerRD::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
 
+	{
+		const CachedCode *cached = code_cache.getptr(p_code);
+		if (cached && cached->mode == p_mode) {
+			_apply_cached(*cached, p_actions, r_gen_code);
+			return OK;
+		}
+	}
+
 	Error err = parser.compile(p_code, ShaderTypes::get_singleton()->get_functions(p_mode), ShaderTypes::get_singleton()->get_modes(p_mode), ShaderTypes::get_singleton()->get_types());
 
 	if (err != OK) {
@@ -1064,11 +1114,29 @@ Error ShaderCompilerRD::compile(RS::ShaderMode p_mode, const String &p_code, Ide
 	used_name_defines.clear();
 	used_rmode_defines.clear();
 	used_flag_pointers.clear();
+	used_write_flags.clear();
 
 	shader = parser.get_shader();
 	function = NULL;
 	_dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
 
+	if (code_cache.size() >= MAX_CACHED_CODE) {
+		code_cache.clear();
+	}
+
+	CachedCode cached;
+	cached.mode = p_mode;
+	cached.gen_code = r_gen_code;
+	cached.render_modes = shader->render_modes;
+	for (Set<StringName>::Element *E = used_flag_pointers.front(); E; E = E->next()) {
+		cached.usage_flags.push_back(E->get());
+	}
+	for (Set<StringName>::Element *E = used_write_flags.front(); E; E = E->next()) {
+		cached.write_flags.push_back(E->get());
+	}
+	cached.uniforms = shader->uniforms;
+	code_cache.set(p_code, cached);
+
 	return OK;
 }
 
@@ -31,6 +31,7 @@
 #ifndef SHADER_COMPILER_RD_H
 #define SHADER_COMPILER_RD_H
 
+#include "core/hash_map.h"
 #include "core/pair.h"
 #include "servers/rendering/shader_language.h"
 #include "servers/rendering/shader_types.h"
@@ -108,14 +109,36 @@ private:
 
 	Set<StringName> used_name_defines;
 	Set<StringName> used_flag_pointers;
+	Set<StringName> used_write_flags;
 	Set<StringName> used_rmode_defines;
 	Set<StringName> internal_functions;
 
 	DefaultIdentifierActions actions;
 
+	//results of previous compilations, keyed by shader code, so identical code is only parsed and generated once.
+	//the side effects on the caller's IdentifierActions are stored by name and replayed on a hit.
+	struct CachedCode {
+		RS::ShaderMode mode;
+		GeneratedCode gen_code;
+		Vector<StringName> render_modes;
+		Vector<StringName> usage_flags;
+		Vector<StringName> write_flags;
+		Map<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	};
+
+	enum {
+		MAX_CACHED_CODE = 1024
+	};
+
+	HashMap<String, CachedCode> code_cache;
+
+	void _apply_cached(const CachedCode &p_cached, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+
 public:
 	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
+	void clear_cache();
+
 	void initialize(DefaultIdentifierActions p_actions);
 	ShaderCompilerRD();
 };
@@ -30,7 +30,10 @@
 
 #include "shader_rd.h"
 
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
 #include "core/string_builder.h"
+#include "core/thread_work_pool.h"
 #include "rasterizer_rd.h"
 #include "servers/rendering/rendering_device.h"
 
@@ -192,9 +195,80 @@ RID ShaderRD::version_create() {
 	version.valid = false;
 	version.initialize_needed = true;
 	version.variants = NULL;
+	version.compile_task = ThreadWorkPool::INVALID_TASK_ID;
 	return version_owner.make_rid(version);
 }
 
+#define SHADER_CACHE_MAGIC 0x43534447 // "GDSC"
+#define SHADER_CACHE_VERSION 1
+
+String ShaderRD::shader_cache_dir;
+
+String ShaderRD::_get_cache_key(const String *p_sources) const {
+
+	StringBuilder builder;
+	builder.append(itos(SHADER_CACHE_VERSION));
+	for (int i = 0; i < RD::SHADER_STAGE_MAX; i++) {
+		builder.append("\n#stage " + itos(i) + "\n");
+		builder.append(p_sources[i]);
+	}
+
+	return builder.as_string().md5_text();
+}
+
+bool ShaderRD::_load_from_cache(const String &p_key, Vector<RD::ShaderStageData> &r_stages) const {
+
+	FileAccess *f = FileAccess::open(cache_dir.plus_file(p_key + ".cache"), FileAccess::READ);
+	if (!f) {
+		return false;
+	}
+
+	bool valid = f->get_32() == SHADER_CACHE_MAGIC && f->get_32() == SHADER_CACHE_VERSION;
+	uint32_t stage_count = valid ? f->get_32() : 0;
+	valid = valid && stage_count > 0 && stage_count <= RD::SHADER_STAGE_MAX;
+
+	for (uint32_t i = 0; i < stage_count && valid; i++) {
+		RD::ShaderStageData stage;
+		uint32_t stage_type = f->get_32();
+		uint32_t size = f->get_32();
+		if (stage_type >= RD::SHADER_STAGE_MAX || size == 0 || size > f->get_len() - f->get_position()) {
+			valid = false;
+			break;
+		}
+		stage.shader_stage = RD::ShaderStage(stage_type);
+		stage.spir_v.resize(size);
+		valid = f->get_buffer(stage.spir_v.ptrw(), size) == int(size);
+		r_stages.push_back(stage);
+	}
+
+	f->close();
+	memdelete(f);
+
+	if (!valid) {
+		r_stages.clear();
+	}
+
+	return valid;
+}
+
+void ShaderRD::_save_to_cache(const String &p_key, const Vector<RD::ShaderStageData> &p_stages) const {
+
+	FileAccess *f = FileAccess::open(cache_dir.plus_file(p_key + ".cache"), FileAccess::WRITE);
+	ERR_FAIL_COND(!f);
+
+	f->store_32(SHADER_CACHE_MAGIC);
+	f->store_32(SHADER_CACHE_VERSION);
+	f->store_32(p_stages.size());
+	for (int i = 0; i < p_stages.size(); i++) {
+		f->store_32(p_stages[i].shader_stage);
+		f->store_32(p_stages[i].spir_v.size());
+		f->store_buffer(p_stages[i].spir_v.ptr(), p_stages[i].spir_v.size());
+	}
+
+	f->close();
+	memdelete(f);
+}
+
 void ShaderRD::_clear_version(Version *p_version) {
 	//clear versions if they exist
 	if (p_version->variants) {
@@ -216,6 +290,8 @@ void ShaderRD::_compile_variant(uint32_t p_variant, Version *p_version) {
 	RD::ShaderStage current_stage = RD::SHADER_STAGE_VERTEX;
 	bool build_ok = true;
 
+	String sources[RD::SHADER_STAGE_MAX];
+
 	if (!is_compute) {
 		//vertex stage
 
@@ -244,21 +320,11 @@ void ShaderRD::_compile_variant(uint32_t p_variant, Version *p_version) {
 
 		builder.append(vertex_code3.get_data()); //fourth of vertex
 
-		current_source = builder.as_string();
-		RD::ShaderStageData stage;
-		stage.spir_v = RD::get_singleton()->shader_compile_from_source(RD::SHADER_STAGE_VERTEX, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
-		if (stage.spir_v.size() == 0) {
-			build_ok = false;
-		} else {
-
-			stage.shader_stage = RD::SHADER_STAGE_VERTEX;
-			stages.push_back(stage);
-		}
+		sources[RD::SHADER_STAGE_VERTEX] = builder.as_string();
 	}
 
-	if (!is_compute && build_ok) {
+	if (!is_compute) {
 		//fragment stage
-		current_stage = RD::SHADER_STAGE_FRAGMENT;
 
 		StringBuilder builder;
 
@@ -289,21 +355,11 @@ void ShaderRD::_compile_variant(uint32_t p_variant, Version *p_version) {
 
 		builder.append(fragment_code4.get_data()); //fourth part of fragment
 
-		current_source = builder.as_string();
-		RD::ShaderStageData stage;
-		stage.spir_v = RD::get_singleton()->shader_compile_from_source(RD::SHADER_STAGE_FRAGMENT, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
-		if (stage.spir_v.size() == 0) {
-			build_ok = false;
-		} else {
-
-			stage.shader_stage = RD::SHADER_STAGE_FRAGMENT;
-			stages.push_back(stage);
-		}
+		sources[RD::SHADER_STAGE_FRAGMENT] = builder.as_string();
 	}
 
 	if (is_compute) {
 		//compute stage
-		current_stage = RD::SHADER_STAGE_COMPUTE;
 
 		StringBuilder builder;
 
@@ -330,14 +386,38 @@ void ShaderRD::_compile_variant(uint32_t p_variant, Version *p_version) {
 
 		builder.append(compute_code3.get_data()); //fourth of compute
 
-		current_source = builder.as_string();
+		sources[RD::SHADER_STAGE_COMPUTE] = builder.as_string();
+	}
+
+	String cache_key;
+	if (cache_dir != String()) {
+		cache_key = _get_cache_key(sources);
+		if (_load_from_cache(cache_key, stages)) {
+			RID shader = RD::get_singleton()->shader_create(stages);
+			if (shader.is_valid()) {
+				MutexLock lock(variant_set_mutex);
+				p_version->variants[p_variant] = shader;
+				return;
+			}
+			stages.clear(); //cache is unusable, compile again
+		}
+	}
+
+	for (int i = 0; i < RD::SHADER_STAGE_MAX && build_ok; i++) {
+		if (sources[i].empty()) {
+			continue;
+		}
+
+		current_stage = RD::ShaderStage(i);
+		current_source = sources[i];
+
 		RD::ShaderStageData stage;
-		stage.spir_v = RD::get_singleton()->shader_compile_from_source(RD::SHADER_STAGE_COMPUTE, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
+		stage.spir_v = RD::get_singleton()->shader_compile_from_source(current_stage, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
 		if (stage.spir_v.size() == 0) {
 			build_ok = false;
 		} else {
 
-			stage.shader_stage = RD::SHADER_STAGE_COMPUTE;
+			stage.shader_stage = current_stage;
 			stages.push_back(stage);
 		}
 	}
@@ -354,6 +434,9 @@ void ShaderRD::_compile_variant(uint32_t p_variant, Version *p_version) {
 	}
 
 	RID shader = RD::get_singleton()->shader_create(stages);
+	if (shader.is_valid() && cache_key != String()) {
+		_save_to_cache(cache_key, stages);
+	}
 	{
 		MutexLock lock(variant_set_mutex);
 		p_version->variants[p_variant] = shader;
@@ -362,21 +445,36 @@ void ShaderRD::_compile_variant(uint32_t p_variant, Version *p_version) {
 
 void ShaderRD::_compile_version(Version *p_version) {
 
+	if (p_version->compile_task != ThreadWorkPool::INVALID_TASK_ID) {
+		_finish_compile_version(p_version);
+	}
+
 	_clear_version(p_version);
 
 	p_version->valid = false;
 	p_version->dirty = false;
 
 	p_version->variants = memnew_arr(RID, variant_defines.size());
-#if 1
 
-	RasterizerRD::thread_work_pool.do_work(variant_defines.size(), this, &ShaderRD::_compile_variant, p_version);
-#else
-	for (int i = 0; i < variant_defines.size(); i++) {
-
-		_compile_variant(i, p_version);
+	if (async_compilation) {
+		p_version->compile_task = ThreadWorkPool::get_singleton()->add_group_task(variant_defines.size(), this, &ShaderRD::_compile_variant, p_version, 1);
+		return;
 	}
-#endif
+
+	ThreadWorkPool::get_singleton()->do_work(variant_defines.size(), this, &ShaderRD::_compile_variant, p_version);
+
+	_validate_version(p_version);
+}
+
+void ShaderRD::_finish_compile_version(Version *p_version) {
+
+	ThreadWorkPool::get_singleton()->wait_for_task(p_version->compile_task);
+	p_version->compile_task = ThreadWorkPool::INVALID_TASK_ID;
+
+	_validate_version(p_version);
+}
+
+void ShaderRD::_validate_version(Version *p_version) {
 
 	bool all_valid = true;
 	for (int i = 0; i < variant_defines.size(); i++) {
@@ -407,6 +505,11 @@ void ShaderRD::version_set_code(RID p_version, const String &p_uniforms, const S
 
 	Version *version = version_owner.getornull(p_version);
 	ERR_FAIL_COND(!version);
+
+	if (version->compile_task != ThreadWorkPool::INVALID_TASK_ID) {
+		_finish_compile_version(version); //code is in use by the compilation
+	}
+
 	version->vertex_globals = p_vertex_globals.utf8();
 	version->vertex_code = p_vertex_code.utf8();
 	version->fragment_light = p_fragment_light.utf8();
@@ -420,7 +523,7 @@ void ShaderRD::version_set_code(RID p_version, const String &p_uniforms, const S
 	}
 
 	version->dirty = true;
-	if (version->initialize_needed) {
+	if (version->initialize_needed || async_compilation) {
 		_compile_version(version);
 		version->initialize_needed = false;
 	}
@@ -432,6 +535,11 @@ void ShaderRD::version_set_compute_code(RID p_version, const String &p_uniforms,
 
 	Version *version = version_owner.getornull(p_version);
 	ERR_FAIL_COND(!version);
+
+	if (version->compile_task != ThreadWorkPool::INVALID_TASK_ID) {
+		_finish_compile_version(version); //code is in use by the compilation
+	}
+
 	version->compute_globals = p_compute_globals.utf8();
 	version->compute_code = p_compute_code.utf8();
 	version->uniforms = p_uniforms.utf8();
@@ -442,7 +550,7 @@ void ShaderRD::version_set_compute_code(RID p_version, const String &p_uniforms,
 	}
 
 	version->dirty = true;
-	if (version->initialize_needed) {
+	if (version->initialize_needed || async_compilation) {
 		_compile_version(version);
 		version->initialize_needed = false;
 	}
@@ -456,13 +564,38 @@ bool ShaderRD::version_is_valid(RID p_version) {
 		_compile_version(version);
 	}
 
+	if (version->compile_task != ThreadWorkPool::INVALID_TASK_ID) {
+		_finish_compile_version(version);
+	}
+
 	return version->valid;
 }
 
+bool ShaderRD::version_is_ready(RID p_version) {
+	Version *version = version_owner.getornull(p_version);
+	ERR_FAIL_COND_V(!version, false);
+
+	if (version->dirty) {
+		_compile_version(version);
+	}
+
+	if (version->compile_task != ThreadWorkPool::INVALID_TASK_ID) {
+		if (!ThreadWorkPool::get_singleton()->is_task_completed(version->compile_task)) {
+			return false;
+		}
+		_finish_compile_version(version);
+	}
+
+	return true;
+}
+
 bool ShaderRD::version_free(RID p_version) {
 
 	if (version_owner.owns(p_version)) {
 		Version *version = version_owner.getornull(p_version);
+		if (version->compile_task != ThreadWorkPool::INVALID_TASK_ID) {
+			_finish_compile_version(version);
+		}
 		_clear_version(version);
 		version_owner.free(p_version);
 	} else {
@@ -472,6 +605,14 @@ bool ShaderRD::version_free(RID p_version) {
 	return true;
 }
 
+void ShaderRD::set_async_compilation(bool p_enable) {
+	async_compilation = p_enable;
+}
+
+void ShaderRD::set_shader_cache_dir(const String &p_dir) {
+	shader_cache_dir = p_dir;
+}
+
 void ShaderRD::initialize(const Vector<String> &p_variant_defines, const String &p_general_defines) {
 	ERR_FAIL_COND(variant_defines.size());
 	ERR_FAIL_COND(p_variant_defines.size() == 0);
@@ -480,6 +621,18 @@ void ShaderRD::initialize(const Vector<String> &p_variant_defines, const String
 
 		variant_defines.push_back(p_variant_defines[i].utf8());
 	}
+
+	if (shader_cache_dir != String()) {
+		cache_dir = shader_cache_dir.plus_file(name);
+
+		DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+		Error err = da->make_dir_recursive(cache_dir);
+		memdelete(da);
+		if (err != OK) {
+			WARN_PRINT("Can't create shader cache folder, disabling it: " + cache_dir);
+			cache_dir = String();
+		}
+	}
 }
 
 ShaderRD::~ShaderRD() {
@@ -35,7 +35,9 @@
 #include "core/map.h"
 #include "core/os/mutex.h"
 #include "core/rid_owner.h"
+#include "core/thread_work_pool.h"
 #include "core/variant.h"
+#include "servers/rendering/rendering_device.h"
 
 #include <stdio.h>
 /**
@@ -64,6 +66,7 @@ class ShaderRD {
 		bool valid;
 		bool dirty;
 		bool initialize_needed;
+		ThreadWorkPool::TaskID compile_task; //pending asynchronous compilation, if any
 	};
 
 	Mutex variant_set_mutex;
@@ -72,6 +75,18 @@ class ShaderRD {
 
 	void _clear_version(Version *p_version);
 	void _compile_version(Version *p_version);
+	void _finish_compile_version(Version *p_version);
+	void _validate_version(Version *p_version);
+
+	bool async_compilation = false;
+
+	//spir-v disk cache, keyed by the hash of the full source of all stages
+	static String shader_cache_dir;
+	String cache_dir;
+
+	String _get_cache_key(const String *p_sources) const;
+	bool _load_from_cache(const String &p_key, Vector<RD::ShaderStageData> &r_stages) const;
+	void _save_to_cache(const String &p_key, const Vector<RD::ShaderStageData> &p_stages) const;
 
 	RID_Owner<Version> version_owner;
 
@@ -118,6 +133,10 @@ public:
 			_compile_version(version);
 		}
 
+		if (version->compile_task != ThreadWorkPool::INVALID_TASK_ID) {
+			_finish_compile_version(version); //blocks, use version_is_ready() to avoid it
+		}
+
 		if (!version->valid) {
 			return RID();
 		}
@@ -126,9 +145,16 @@ public:
 	}
 
 	bool version_is_valid(RID p_version);
+	bool version_is_ready(RID p_version);
 
 	bool version_free(RID p_version);
 
+	//when enabled, setting the code of a version compiles its variants in the background.
+	//version_is_ready() can be used to poll, other version functions block until done.
+	void set_async_compilation(bool p_enable);
+
+	static void set_shader_cache_dir(const String &p_dir);
+
 	void initialize(const Vector<String> &p_variant_defines, const String &p_general_defines = "");
 	virtual ~ShaderRD();
 };
@@ -42,6 +42,8 @@ VERTEX_SHADER_GLOBALS
 void main() {
 
 	vec4 instance_custom = vec4(0.0);
+	mat4 world_matrix = mat4(vec4(draw_data.world_x, 0.0, 0.0), vec4(draw_data.world_y, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0), vec4(draw_data.world_ofs, 0.0, 1.0));
+
 #ifdef USE_PRIMITIVE
 
 	//weird bug,
@@ -77,14 +79,25 @@ void main() {
 	vec2 vertex_base_arr[4] = vec2[](vec2(0.0, 0.0), vec2(0.0, 1.0), vec2(1.0, 1.0), vec2(1.0, 0.0));
 	vec2 vertex_base = vertex_base_arr[gl_VertexIndex];
 
-	vec2 uv = draw_data.src_rect.xy + abs(draw_data.src_rect.zw) * ((draw_data.flags & FLAGS_TRANSPOSE_RECT) != 0 ? vertex_base.yx : vertex_base.xy);
+	vec4 src_rect = draw_data.src_rect;
+	vec4 dst_rect = draw_data.dst_rect;
 	vec4 color = draw_data.modulation;
-	vec2 vertex = draw_data.dst_rect.xy + abs(draw_data.dst_rect.zw) * mix(vertex_base, vec2(1.0, 1.0) - vertex_base, lessThan(draw_data.src_rect.zw, vec2(0.0, 0.0)));
-	uvec4 bones = uvec4(0, 0, 0, 0);
 
+#ifndef USE_NINEPATCH
+	if (bool(draw_data.flags & FLAGS_USE_RECT_BATCH)) {
+		RectInstance instance = rect_batch.data[draw_data.batch_offset + gl_InstanceIndex];
+		src_rect = instance.src_rect;
+		dst_rect = instance.dst_rect;
+		color = instance.modulation;
+		world_matrix = mat4(vec4(instance.world_x, 0.0, 0.0), vec4(instance.world_y, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0), vec4(instance.world_ofs, 0.0, 1.0));
+	}
 #endif
 
-	mat4 world_matrix = mat4(vec4(draw_data.world_x, 0.0, 0.0), vec4(draw_data.world_y, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0), vec4(draw_data.world_ofs, 0.0, 1.0));
+	vec2 uv = src_rect.xy + abs(src_rect.zw) * ((draw_data.flags & FLAGS_TRANSPOSE_RECT) != 0 ? vertex_base.yx : vertex_base.xy);
+	vec2 vertex = dst_rect.xy + abs(dst_rect.zw) * mix(vertex_base, vec2(1.0, 1.0) - vertex_base, lessThan(src_rect.zw, vec2(0.0, 0.0)));
+	uvec4 bones = uvec4(0, 0, 0, 0);
+
+#endif
 
 #if 0
 	if (draw_data.flags & FLAGS_INSTANCING_ENABLED) {
@@ -341,7 +354,15 @@ void main() {
 
 #endif
 
-	color *= texture(sampler2D(color_texture, texture_sampler), uv);
+	vec4 tex_color = texture(sampler2D(color_texture, texture_sampler), uv);
+
+	if (bool(draw_data.flags & FLAGS_USE_DISTANCE_FIELD)) {
+		//alpha holds the distance to the edge, 0.5 being on it
+		float width = fwidth(tex_color.a) * 0.5;
+		tex_color.a = smoothstep(0.5 - width, 0.5 + width, tex_color.a);
+	}
+
+	color *= tex_color;
 
 	uint light_count = (draw_data.flags >> FLAGS_LIGHT_COUNT_SHIFT) & 0xF; //max 16 lights
 
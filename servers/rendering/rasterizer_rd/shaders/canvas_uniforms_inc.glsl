@@ -22,6 +22,9 @@
 #define FLAGS_DEFAULT_NORMAL_MAP_USED (1 << 26)
 #define FLAGS_DEFAULT_SPECULAR_MAP_USED (1 << 27)
 
+#define FLAGS_USE_RECT_BATCH (1 << 28)
+#define FLAGS_USE_DISTANCE_FIELD (1 << 29)
+
 // In vulkan, sets should always be ordered using the following logic:
 // Lower Sets: Sets that change format and layout less often
 // Higher sets: Sets that change format and layout very often
@@ -45,7 +48,8 @@ layout(push_constant, binding = 0, std430) uniform DrawData {
 	vec4 ninepatch_margins;
 	vec4 dst_rect; //for built-in rect and UV
 	vec4 src_rect;
-	vec2 pad;
+	uint batch_offset;
+	uint pad;
 
 #endif
 	vec2 color_texture_pixel_size;
@@ -92,6 +96,23 @@ layout(set = 2, binding = 2, std140) uniform SkeletonData {
 }
 skeleton_data;
 
+// Batched rects, indexed by batch_offset + instance
+
+struct RectInstance {
+	vec2 world_x;
+	vec2 world_y;
+	vec2 world_ofs;
+	uvec2 pad;
+	vec4 modulation;
+	vec4 dst_rect;
+	vec4 src_rect;
+};
+
+layout(set = 2, binding = 7, std430) restrict readonly buffer RectBatch {
+	RectInstance data[];
+}
+rect_batch;
+
 #ifdef USE_LIGHTING
 
 #define LIGHT_FLAGS_BLEND_MASK (3 << 16)
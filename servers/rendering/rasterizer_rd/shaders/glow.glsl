@@ -0,0 +1,117 @@
+/* clang-format off */
+[compute]
+
+#version 450
+
+VERSION_DEFINES
+
+#define BLOCK_SIZE 8
+#define BLUR_RADIUS 2
+
+layout(local_size_x = BLOCK_SIZE, local_size_y = BLOCK_SIZE, local_size_z = 1) in;
+/* clang-format on */
+
+// Same filter as MODE_GAUSSIAN_GLOW in blur.glsl, but both directions are done in
+// one dispatch: the horizontal pass is kept in shared memory instead of being
+// written to and read back from a half size texture.
+
+layout(set = 0, binding = 0) uniform sampler2D source_color;
+
+layout(rgba16f, set = 1, binding = 0) uniform restrict writeonly image2D dest_glow;
+
+#ifdef GLOW_USE_AUTO_EXPOSURE
+layout(set = 2, binding = 0) uniform sampler2D source_auto_exposure;
+#endif
+
+layout(push_constant, binding = 1, std430) uniform Params {
+	ivec2 size;
+	vec2 pixel_size;
+
+	float glow_strength;
+	float glow_bloom;
+	float glow_hdr_threshold;
+	float glow_hdr_scale;
+
+	float glow_exposure;
+	float glow_luminance_cap;
+	float glow_auto_exposure_grey;
+	bool first_pass;
+}
+params;
+
+#define TILE_ROWS (BLOCK_SIZE + BLUR_RADIUS * 2)
+
+//horizontally blurred rows for this block, plus the ones above and below the vertical pass reads
+shared vec4 tile[TILE_ROWS][BLOCK_SIZE];
+
+#define GLOW_ADD(m_ofs, m_mult)                                                  \
+	{                                                                            \
+		vec2 ofs = uv + m_ofs * pix_size;                                        \
+		vec4 c = textureLod(source_color, ofs, 0.0) * m_mult;                    \
+		if (any(lessThan(ofs, vec2(0.0))) || any(greaterThan(ofs, vec2(1.0)))) { \
+			c *= 0.0;                                                            \
+		}                                                                        \
+		color += c;                                                              \
+	}
+
+vec4 glow_horizontal(ivec2 p_pos) {
+
+	vec2 uv = (vec2(p_pos) + 0.5) * params.pixel_size;
+	vec2 pix_size = params.pixel_size * 0.5; //reading from larger buffer, so use more samples
+
+	vec4 color = textureLod(source_color, uv, 0.0) * 0.174938;
+	GLOW_ADD(vec2(1.0, 0.0), 0.165569);
+	GLOW_ADD(vec2(2.0, 0.0), 0.140367);
+	GLOW_ADD(vec2(3.0, 0.0), 0.106595);
+	GLOW_ADD(vec2(-1.0, 0.0), 0.165569);
+	GLOW_ADD(vec2(-2.0, 0.0), 0.140367);
+	GLOW_ADD(vec2(-3.0, 0.0), 0.106595);
+	color *= params.glow_strength;
+
+	if (params.first_pass) {
+#ifdef GLOW_USE_AUTO_EXPOSURE
+
+		color /= texelFetch(source_auto_exposure, ivec2(0, 0), 0).r / params.glow_auto_exposure_grey;
+#endif
+		color *= params.glow_exposure;
+
+		float luminance = max(color.r, max(color.g, color.b));
+		float feedback = max(smoothstep(params.glow_hdr_threshold, params.glow_hdr_threshold + params.glow_hdr_scale, luminance), params.glow_bloom);
+
+		color = min(color * feedback, vec4(params.glow_luminance_cap));
+	}
+
+	return color;
+}
+
+void main() {
+
+	ivec2 block_pos = ivec2(gl_WorkGroupID.xy) * BLOCK_SIZE;
+
+	for (uint i = gl_LocalInvocationIndex; i < TILE_ROWS * BLOCK_SIZE; i += BLOCK_SIZE * BLOCK_SIZE) {
+		ivec2 tile_pos = ivec2(i % BLOCK_SIZE, i / BLOCK_SIZE);
+		ivec2 pos = block_pos + ivec2(tile_pos.x, tile_pos.y - BLUR_RADIUS);
+		//rows outside the texture contribute nothing, same as the bounds check in the vertical raster pass
+		tile[tile_pos.y][tile_pos.x] = (pos.y >= 0 && pos.y < params.size.y) ? glow_horizontal(pos) : vec4(0.0);
+	}
+
+	groupMemoryBarrier();
+	barrier();
+
+	ivec2 pos = ivec2(gl_GlobalInvocationID.xy);
+	if (any(greaterThanEqual(pos, params.size))) { //too large, do nothing
+		return;
+	}
+
+	uvec2 local = gl_LocalInvocationID.xy;
+	uint row = local.y + BLUR_RADIUS;
+
+	vec4 color = tile[row][local.x] * 0.288713;
+	color += tile[row + 1][local.x] * 0.233062;
+	color += tile[row + 2][local.x] * 0.122581;
+	color += tile[row - 1][local.x] * 0.233062;
+	color += tile[row - 2][local.x] * 0.122581;
+	color *= params.glow_strength;
+
+	imageStore(dest_glow, pos, color);
+}
@@ -0,0 +1,145 @@
+/* clang-format off */
+[compute]
+
+#version 450
+
+VERSION_DEFINES
+
+layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+/* clang-format on */
+
+#define CLUSTER_COUNTER_SHIFT 20
+#define CLUSTER_ITEM_TYPES 4
+
+struct Item {
+	vec4 aabb_min; //w contains the item type, as uint bits
+	vec4 aabb_max; //w contains the item index, as uint bits
+};
+
+layout(set = 0, binding = 0, std430) restrict readonly buffer Items {
+	Item data[];
+}
+items;
+
+layout(rgba32ui, set = 0, binding = 1) uniform restrict writeonly uimage3D cluster_texture;
+
+layout(set = 0, binding = 2, std430) restrict writeonly buffer Indices {
+	uint data[];
+}
+indices;
+
+layout(set = 0, binding = 3, std430) restrict buffer Counter {
+	uint total;
+}
+counter;
+
+layout(push_constant, binding = 1, std430) uniform Params {
+	mat4 projection;
+	uvec3 cluster_size;
+	uint item_count;
+	float z_near;
+	float slice_depth;
+	uint index_max;
+	uint pad;
+}
+params;
+
+vec2 project(vec3 p_pos) {
+	vec4 clip = params.projection * vec4(p_pos, 1.0);
+	return clip.xy / clip.w;
+}
+
+//same test as the CPU builder, so both paths produce the same cells
+bool item_in_cell(Item p_item, ivec3 p_cell) {
+
+	vec3 aabb_min = p_item.aabb_min.xyz;
+	vec3 aabb_max = p_item.aabb_max.xyz;
+
+	int from_slice = int(floor((params.z_near - aabb_max.z) / params.slice_depth));
+	int to_slice = int(floor((params.z_near - aabb_min.z) / params.slice_depth));
+
+	if (p_cell.z < from_slice || p_cell.z > to_slice) {
+		return false;
+	}
+
+	float limit_near = min(params.z_near - params.slice_depth * float(p_cell.z), aabb_max.z);
+	float limit_far = max(params.z_near - params.slice_depth * float(p_cell.z + 1), aabb_min.z);
+
+	vec2 near_min = project(vec3(aabb_min.xy, limit_near));
+	vec2 near_max = project(vec3(aabb_max.xy, limit_near));
+	vec2 far_min = project(vec3(aabb_min.xy, limit_far));
+	vec2 far_max = project(vec3(aabb_max.xy, limit_far));
+
+	vec2 size = vec2(params.cluster_size.xy);
+
+	ivec2 near_from = ivec2(floor(vec2(near_min.x * 0.5 + 0.5, -near_max.y * 0.5 + 0.5) * size));
+	ivec2 near_to = ivec2(floor(vec2(near_max.x * 0.5 + 0.5, -near_min.y * 0.5 + 0.5) * size));
+	ivec2 far_from = ivec2(floor(vec2(far_min.x * 0.5 + 0.5, -far_max.y * 0.5 + 0.5) * size));
+	ivec2 far_to = ivec2(floor(vec2(far_max.x * 0.5 + 0.5, -far_min.y * 0.5 + 0.5) * size));
+
+	ivec2 from = min(near_from, far_from);
+	ivec2 to = max(near_to, far_to);
+
+	return all(greaterThanEqual(p_cell.xy, from)) && all(lessThanEqual(p_cell.xy, to));
+}
+
+void main() {
+
+	ivec3 cell = ivec3(gl_GlobalInvocationID.xyz);
+	if (any(greaterThanEqual(uvec3(cell), params.cluster_size))) { //too large, do nothing
+		return;
+	}
+
+	/* Step 1, count items per type */
+
+	uint counts[CLUSTER_ITEM_TYPES] = uint[](0u, 0u, 0u, 0u);
+
+	for (uint i = 0; i < params.item_count; i++) {
+		Item item = items.data[i];
+		if (item_in_cell(item, cell)) {
+			counts[floatBitsToUint(item.aabb_min.w)]++;
+		}
+	}
+
+	/* Step 2, reserve room for the lists of this cell */
+
+	uint total = counts[0] + counts[1] + counts[2] + counts[3];
+	uint offset = 0;
+
+	if (total > 0) {
+		offset = atomicAdd(counter.total, total);
+		if (offset + total > params.index_max) {
+			//out of room, leave the cell empty rather than write past the end
+			counts = uint[](0u, 0u, 0u, 0u);
+			total = 0;
+		}
+	}
+
+	uint pointers[CLUSTER_ITEM_TYPES];
+	for (int i = 0; i < CLUSTER_ITEM_TYPES; i++) {
+		pointers[i] = offset;
+		offset += counts[i];
+	}
+
+	/* Step 3, place item lists */
+
+	if (total > 0) {
+		uint written[CLUSTER_ITEM_TYPES] = uint[](0u, 0u, 0u, 0u);
+
+		for (uint i = 0; i < params.item_count; i++) {
+			Item item = items.data[i];
+			if (item_in_cell(item, cell)) {
+				uint type = floatBitsToUint(item.aabb_min.w);
+				indices.data[pointers[type] + written[type]] = floatBitsToUint(item.aabb_max.w);
+				written[type]++;
+			}
+		}
+	}
+
+	uvec4 cell_data;
+	for (int i = 0; i < CLUSTER_ITEM_TYPES; i++) {
+		cell_data[i] = pointers[i] | (counts[i] << CLUSTER_COUNTER_SHIFT);
+	}
+
+	imageStore(cluster_texture, cell, cell_data);
+}
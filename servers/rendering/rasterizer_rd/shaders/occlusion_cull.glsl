@@ -0,0 +1,146 @@
+/* clang-format off */
+[compute]
+
+#version 450
+
+VERSION_DEFINES
+
+#ifdef MODE_CULL
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+#else
+layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+#endif
+/* clang-format on */
+
+#ifdef MODE_CULL
+
+layout(set = 0, binding = 0) uniform sampler2D hiz_texture;
+
+struct InstanceBounds {
+	vec4 aabb_min; //w contains the occlusion id, as uint bits
+	vec4 aabb_max;
+};
+
+layout(set = 1, binding = 0, std430) restrict readonly buffer Instances {
+	InstanceBounds data[];
+}
+instances;
+
+layout(set = 1, binding = 1, std430) restrict writeonly buffer Visibility {
+	uint data[];
+}
+visibility;
+
+layout(push_constant, binding = 1, std430) uniform Params {
+	mat4 view_projection;
+	ivec2 hiz_size; //size of the first mipmap
+	uint hiz_levels;
+	uint instance_count;
+}
+params;
+
+#else
+
+#ifdef MODE_HIZ_FIRST
+layout(set = 0, binding = 0) uniform sampler2D source_depth;
+#else
+layout(r32f, set = 0, binding = 0) uniform restrict readonly image2D source_image;
+#endif
+
+layout(r32f, set = 1, binding = 0) uniform restrict writeonly image2D dest_image;
+
+layout(push_constant, binding = 1, std430) uniform Params {
+	ivec2 source_size;
+	ivec2 dest_size;
+}
+params;
+
+float load_depth(ivec2 p_pos) {
+#ifdef MODE_HIZ_FIRST
+	return texelFetch(source_depth, p_pos, 0).r;
+#else
+	return imageLoad(source_image, p_pos).r;
+#endif
+}
+
+#endif
+
+void main() {
+
+#ifdef MODE_CULL
+
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= params.instance_count) {
+		return;
+	}
+
+	InstanceBounds bounds = instances.data[index];
+	uint id = floatBitsToUint(bounds.aabb_min.w);
+
+	vec2 rect_min = vec2(1.0);
+	vec2 rect_max = vec2(0.0);
+	float min_depth = 1.0;
+	bool visible = false;
+
+	for (int i = 0; i < 8; i++) {
+		vec3 corner = mix(bounds.aabb_min.xyz, bounds.aabb_max.xyz, vec3(float(i & 1), float((i >> 1) & 1), float((i >> 2) & 1)));
+		vec4 clip = params.view_projection * vec4(corner, 1.0);
+		if (clip.w <= 0.0 || clip.z < 0.0) {
+			//crosses the near plane, can't be tested
+			visible = true;
+			break;
+		}
+
+		vec3 ndc = clip.xyz / clip.w;
+		vec2 uv = ndc.xy * 0.5 + 0.5;
+		rect_min = min(rect_min, uv);
+		rect_max = max(rect_max, uv);
+		min_depth = min(min_depth, ndc.z);
+	}
+
+	if (!visible) {
+		rect_min = clamp(rect_min, vec2(0.0), vec2(1.0));
+		rect_max = clamp(rect_max, vec2(0.0), vec2(1.0));
+
+		//pick the level where the rect covers at most 2x2 texels
+		vec2 rect_size = (rect_max - rect_min) * vec2(params.hiz_size);
+		int lod = int(clamp(ceil(log2(max(max(rect_size.x, rect_size.y), 1.0))), 0.0, float(params.hiz_levels - 1)));
+		ivec2 lod_size = max(params.hiz_size >> lod, ivec2(1));
+
+		ivec2 from = clamp(ivec2(rect_min * vec2(lod_size)), ivec2(0), lod_size - 1);
+		ivec2 to = clamp(ivec2(rect_max * vec2(lod_size)), ivec2(0), lod_size - 1);
+
+		float max_depth = 0.0;
+		for (int y = from.y; y <= to.y; y++) {
+			for (int x = from.x; x <= to.x; x++) {
+				max_depth = max(max_depth, texelFetch(hiz_texture, ivec2(x, y), lod).r);
+			}
+		}
+
+		visible = min_depth <= max_depth;
+	}
+
+	visibility.data[id] = visible ? 1u : 0u;
+
+#else
+
+	ivec2 pos = ivec2(gl_GlobalInvocationID.xy);
+	if (any(greaterThanEqual(pos, params.dest_size))) { //too large, do nothing
+		return;
+	}
+
+	//keep the farthest depth of every source texel this one covers, odd sizes make it overlap its neighbours
+	ivec2 from = (pos * params.source_size) / params.dest_size;
+	ivec2 to = min(((pos + 1) * params.source_size + params.dest_size - 1) / params.dest_size, params.source_size);
+
+	float depth = 0.0;
+	for (int y = from.y; y < to.y; y++) {
+		for (int x = from.x; x < to.x; x++) {
+			depth = max(depth, load_depth(ivec2(x, y)));
+		}
+	}
+
+	imageStore(dest_image, pos, vec4(depth));
+
+#endif
+}
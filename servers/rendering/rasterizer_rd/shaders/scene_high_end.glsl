@@ -78,6 +78,15 @@ layout(location = 8) out float dp_clip;
 
 #endif
 
+vec3 oct_to_vec3(vec2 p_oct) {
+
+	vec3 v = vec3(p_oct, 1.0 - abs(p_oct.x) - abs(p_oct.y));
+	float t = max(-v.z, 0.0);
+	v.x += v.x >= 0.0 ? -t : t;
+	v.y += v.y >= 0.0 ? -t : t;
+	return normalize(v);
+}
+
 void main() {
 
 	instance_index = draw_call.instance_index;
@@ -120,16 +129,26 @@ void main() {
 		world_normal_matrix = world_normal_matrix * mat3(matrix);
 
 	} else {
-		//not a multimesh, instances are for multiple draw calls
+		//not a multimesh, instances are consecutive elements merged into a single draw call
 		instance_index += gl_InstanceIndex;
+		world_matrix = instances.data[instance_index].transform;
+		world_normal_matrix = mat3(instances.data[instance_index].normal_transform);
 	}
 
-	vec3 vertex = vertex_attrib;
+	vec3 vertex = draw_call.vertex_position + vertex_attrib * draw_call.vertex_size;
 	vec3 normal = normal_attrib;
+	if (bool(draw_call.flags & DRAW_CALL_FLAGS_OCTAHEDRAL_NORMAL)) {
+		normal = oct_to_vec3(normal_attrib.xy);
+	}
 
 #if defined(TANGENT_USED) || defined(NORMALMAP_USED) || defined(LIGHT_ANISOTROPY_USED)
 	vec3 tangent = tangent_attrib.xyz;
 	float binormalf = tangent_attrib.a;
+	if (bool(draw_call.flags & DRAW_CALL_FLAGS_OCTAHEDRAL_TANGENT)) {
+		//the binormal sign is stored in the sign of y, which is remapped to 0.5-1 so it's never zero
+		binormalf = tangent_attrib.y < 0.0 ? -1.0 : 1.0;
+		tangent = oct_to_vec3(vec2(tangent_attrib.x, abs(tangent_attrib.y) * 4.0 - 3.0));
+	}
 	vec3 binormal = normalize(cross(normal, tangent) * binormalf);
 #endif
 
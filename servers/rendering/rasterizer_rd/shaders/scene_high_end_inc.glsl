@@ -1,9 +1,14 @@
 #define M_PI 3.14159265359
 #define ROUGHNESS_MAX_LOD 5
 
+#define DRAW_CALL_FLAGS_OCTAHEDRAL_NORMAL (1 << 0)
+#define DRAW_CALL_FLAGS_OCTAHEDRAL_TANGENT (1 << 1)
+
 layout(push_constant, binding = 0, std430) uniform DrawCall {
+	vec3 vertex_position; //compressed vertices are relative to the surface bounds, identity otherwise
 	uint instance_index;
-	uint pad[3]; //16 bits minimum size
+	vec3 vertex_size;
+	uint flags;
 }
 draw_call;
 
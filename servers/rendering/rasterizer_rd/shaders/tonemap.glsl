@@ -48,6 +48,10 @@ layout(push_constant, binding = 1, std430) uniform Params {
 	float exposure;
 	float white;
 	float auto_exposure_grey;
+
+	uvec2 source_size;
+	bool use_upscale;
+	uint pad;
 }
 params;
 
@@ -255,8 +259,43 @@ vec3 apply_color_correction(vec3 color, sampler3D correction_tex) {
 	return texture(correction_tex, color).rgb;
 }
 
+// Catmull-Rom filter done with 9 bilinear taps, keeps the upscaled image sharper than plain bilinear
+vec3 texture_catmull_rom(sampler2D tex, vec2 uv, vec2 tex_size) {
+	vec2 sample_pos = uv * tex_size;
+	vec2 tex_pos1 = floor(sample_pos - 0.5f) + 0.5f;
+	vec2 f = sample_pos - tex_pos1;
+
+	vec2 wt0 = f * (-0.5f + f * (1.0f - 0.5f * f));
+	vec2 wt1 = 1.0f + f * f * (-2.5f + 1.5f * f);
+	vec2 wt2 = f * (0.5f + f * (2.0f - 1.5f * f));
+	vec2 wt3 = f * f * (-0.5f + 0.5f * f);
+
+	vec2 wt12 = wt1 + wt2;
+	vec2 tex_pos0 = (tex_pos1 - 1.0f) / tex_size;
+	vec2 tex_pos3 = (tex_pos1 + 2.0f) / tex_size;
+	vec2 tex_pos12 = (tex_pos1 + wt2 / wt12) / tex_size;
+
+	vec3 result = vec3(0.0f);
+	result += textureLod(tex, vec2(tex_pos0.x, tex_pos0.y), 0.0f).rgb * wt0.x * wt0.y;
+	result += textureLod(tex, vec2(tex_pos12.x, tex_pos0.y), 0.0f).rgb * wt12.x * wt0.y;
+	result += textureLod(tex, vec2(tex_pos3.x, tex_pos0.y), 0.0f).rgb * wt3.x * wt0.y;
+	result += textureLod(tex, vec2(tex_pos0.x, tex_pos12.y), 0.0f).rgb * wt0.x * wt12.y;
+	result += textureLod(tex, vec2(tex_pos12.x, tex_pos12.y), 0.0f).rgb * wt12.x * wt12.y;
+	result += textureLod(tex, vec2(tex_pos3.x, tex_pos12.y), 0.0f).rgb * wt3.x * wt12.y;
+	result += textureLod(tex, vec2(tex_pos0.x, tex_pos3.y), 0.0f).rgb * wt0.x * wt3.y;
+	result += textureLod(tex, vec2(tex_pos12.x, tex_pos3.y), 0.0f).rgb * wt12.x * wt3.y;
+	result += textureLod(tex, vec2(tex_pos3.x, tex_pos3.y), 0.0f).rgb * wt3.x * wt3.y;
+
+	return max(result, vec3(0.0f)); //negative lobes can ring below zero around bright edges
+}
+
 void main() {
-	vec3 color = textureLod(source_color, uv_interp, 0.0f).rgb;
+	vec3 color;
+	if (params.use_upscale) {
+		color = texture_catmull_rom(source_color, uv_interp, vec2(params.source_size));
+	} else {
+		color = textureLod(source_color, uv_interp, 0.0f).rgb;
+	}
 
 	// Exposure
 
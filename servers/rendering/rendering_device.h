@@ -625,6 +625,26 @@ public:
 	virtual Error buffer_update(RID p_buffer, uint32_t p_offset, uint32_t p_size, const void *p_data, bool p_sync_with_draw = false) = 0; //this function can be used from any thread and it takes effect at the beginning of the frame, unless sync with draw is used, which is used to mix updates with draw calls
 	virtual Vector<uint8_t> buffer_get_data(RID p_buffer) = 0; //this causes stall, only use to retrieve large buffers for saving
 
+	/**************************/
+	/**** READBACK BUFFERS ****/
+	/**************************/
+
+	//readback buffers keep one host visible copy per frame in flight, so GPU data can be retrieved without stalling
+	virtual RID readback_buffer_create(uint32_t p_size_bytes) = 0;
+	virtual Error buffer_copy_to_readback(RID p_buffer, RID p_readback_buffer) = 0; //records the copy at the current point of the frame (outside draw or compute lists)
+	virtual Vector<uint8_t> readback_buffer_get_data(RID p_readback_buffer, uint64_t *r_frame = nullptr) = 0; //returns the newest copy the GPU is known to have finished (get_frame_delay() frames old) and the frame it was recorded in, or empty if none yet
+
+	/***********************/
+	/**** ASYNC UPLOADS ****/
+	/***********************/
+
+	//async uploads can be queued from any thread, they are copied on a transfer queue (when available) within a per frame byte budget,
+	//so big uploads don't stall the frame. The resource must not be used until the upload is done, which is when the callback is called
+	//(from the rendering thread) and upload_is_done() returns true. Both return 0 on failure.
+	virtual uint64_t buffer_update_async(RID p_buffer, uint32_t p_offset, uint32_t p_size, const void *p_data, const Callable &p_callback = Callable()) = 0;
+	virtual uint64_t texture_update_async(RID p_texture, uint32_t p_layer, const Vector<uint8_t> &p_data, const Callable &p_callback = Callable()) = 0; //p_data must contain the whole layer, like texture_update()
+	virtual bool upload_is_done(uint64_t p_upload) = 0;
+
 	/*************************/
 	/**** RENDER PIPELINE ****/
 	/*************************/
@@ -1015,6 +1035,18 @@ public:
 
 	virtual int limit_get(Limit p_limit) = 0;
 
+	/************************/
+	/**** PIPELINE CACHE ****/
+	/************************/
+
+	// Driver pipeline cache, persisted across runs.
+	// Data obtained from pipeline_cache_get_data() (i.e. generated on a machine with the same GPU and driver)
+	// can be fed to pipeline_cache_prewarm() to avoid compiling pipelines on first use.
+	virtual Vector<uint8_t> pipeline_cache_get_data() = 0;
+	virtual Error pipeline_cache_prewarm(const Vector<uint8_t> &p_data) = 0;
+	virtual Error pipeline_cache_save() = 0;
+	virtual void pipeline_cache_clear() = 0;
+
 	//methods below not exposed, used by RenderingDeviceRD
 	virtual void prepare_screen_for_drawing() = 0;
 
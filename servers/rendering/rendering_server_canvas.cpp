@@ -416,8 +416,88 @@ void RenderingServerCanvas::canvas_item_set_transform(RID p_item, const Transfor
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
 
+	if (canvas_item->interpolated) {
+		//applied when drawing, blended with the transform of the previous tick
+		if (canvas_item->xform_curr == p_transform)
+			return;
+
+		canvas_item->xform_curr = p_transform;
+		canvas_item->interpolation_stale = false;
+		if (!canvas_item->interpolation_item.in_list()) {
+			item_interpolation_list.add(&canvas_item->interpolation_item);
+		}
+		return;
+	}
+
 	canvas_item->xform = p_transform;
 }
+
+void RenderingServerCanvas::canvas_item_set_interpolated(RID p_item, bool p_interpolated) {
+
+	Item *canvas_item = canvas_item_owner.getornull(p_item);
+	ERR_FAIL_COND(!canvas_item);
+
+	if (canvas_item->interpolated == p_interpolated)
+		return;
+
+	canvas_item->interpolated = p_interpolated;
+
+	if (p_interpolated) {
+		canvas_item->xform_curr = canvas_item->xform;
+		canvas_item->xform_prev = canvas_item->xform;
+		return;
+	}
+
+	if (canvas_item->interpolation_item.in_list()) {
+		item_interpolation_list.remove(&canvas_item->interpolation_item);
+	}
+	canvas_item->xform = canvas_item->xform_curr;
+}
+
+void RenderingServerCanvas::canvas_item_reset_physics_interpolation(RID p_item) {
+
+	Item *canvas_item = canvas_item_owner.getornull(p_item);
+	ERR_FAIL_COND(!canvas_item);
+
+	if (!canvas_item->interpolated)
+		return;
+
+	canvas_item->xform_prev = canvas_item->xform_curr;
+	canvas_item->xform = canvas_item->xform_curr;
+}
+
+bool RenderingServerCanvas::update_interpolation_tick() {
+
+	SelfList<Item> *E = item_interpolation_list.first();
+	while (E) {
+
+		SelfList<Item> *N = E->next();
+		Item *canvas_item = E->self();
+
+		//the new tick starts where the last one ended
+		canvas_item->xform_prev = canvas_item->xform_curr;
+
+		if (canvas_item->interpolation_stale) {
+			//resting for a whole tick, xform already reached xform_curr
+			item_interpolation_list.remove(E);
+		} else {
+			canvas_item->interpolation_stale = true;
+		}
+
+		E = N;
+	}
+
+	return item_interpolation_list.first() != NULL;
+}
+
+void RenderingServerCanvas::update_interpolation_frame(float p_fraction) {
+
+	for (SelfList<Item> *E = item_interpolation_list.first(); E; E = E->next()) {
+
+		Item *canvas_item = E->self();
+		canvas_item->xform = canvas_item->xform_prev.interpolate_with(canvas_item->xform_curr, p_fraction);
+	}
+}
 void RenderingServerCanvas::canvas_item_set_clip(RID p_item, bool p_clip) {
 
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
@@ -752,6 +832,21 @@ void RenderingServerCanvas::canvas_item_add_texture_rect_region(RID p_item, cons
 	}
 }
 
+void RenderingServerCanvas::canvas_item_add_distance_field_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate) {
+
+	Item *canvas_item = canvas_item_owner.getornull(p_item);
+	ERR_FAIL_COND(!canvas_item);
+
+	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
+	ERR_FAIL_COND(!rect);
+	rect->modulate = p_modulate;
+	rect->rect = p_rect;
+	rect->texture_binding.create(canvas_item->texture_filter, canvas_item->texture_repeat, p_texture, RID(), RID(), RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT, RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT, RID());
+	rect->specular_shininess = Color(1, 1, 1, 1);
+	rect->source = p_src_rect;
+	rect->flags = RasterizerCanvas::CANVAS_RECT_REGION | RasterizerCanvas::CANVAS_RECT_DISTANCE_FIELD;
+}
+
 void RenderingServerCanvas::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector2 &p_topleft, const Vector2 &p_bottomright, RS::NinePatchAxisMode p_x_axis_mode, RS::NinePatchAxisMode p_y_axis_mode, bool p_draw_center, const Color &p_modulate, RID p_normal_map, RID p_specular_map, const Color &p_specular_color_shininess, RenderingServer::CanvasItemTextureFilter p_filter, RenderingServer::CanvasItemTextureRepeat p_repeat) {
 
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
@@ -30,6 +30,8 @@
 
 #include "rendering_server_raster.h"
 
+#include "core/debugger/profiling_zones.h"
+#include "core/engine.h"
 #include "core/io/marshalls.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
@@ -94,27 +96,63 @@ void RenderingServerRaster::request_frame_drawn_callback(Object *p_where, const
 	frame_drawn_callbacks.push_back(fdc);
 }
 
+void RenderingServerRaster::tick() {
+
+	bool scene_interpolating = RSG::scene->update_interpolation_tick();
+	bool canvas_interpolating = RSG::canvas->update_interpolation_tick();
+
+	if (scene_interpolating || canvas_interpolating) {
+		//transforms keep moving even if nothing is set during this tick
+		changes++;
+	}
+}
+
 void RenderingServerRaster::draw(bool p_swap_buffers, double frame_step) {
 
+	PROFILING_ZONE("RenderingServer::draw");
+	MemoryTagScope memory_tag(Memory::TAG_RENDERING);
+
 	//needs to be done before changes is reset to 0, to not force the editor to redraw
 	RS::get_singleton()->emit_signal("frame_pre_draw");
 
 	changes = 0;
 
+	//blend physics interpolated transforms between the last two ticks
+	float interpolation_fraction = Engine::get_singleton()->get_physics_interpolation_fraction();
+	RSG::scene->update_interpolation_frame(interpolation_fraction);
+	RSG::canvas->update_interpolation_frame(interpolation_fraction);
+
 	RSG::rasterizer->begin_frame(frame_step);
 
 	TIMESTAMP_BEGIN()
 
-	RSG::scene_render->update(); //update scenes stuff before updating instances
+	{
+		PROFILING_ZONE("RenderingServer::draw update instances");
+
+		RSG::scene_render->update(); //update scenes stuff before updating instances
 
-	RSG::scene->update_dirty_instances(); //update scene stuff
+		RSG::scene->update_dirty_instances(); //update scene stuff
+	}
 
-	RSG::scene->render_probes();
-	RSG::viewport->draw_viewports();
-	RSG::canvas_render->update();
+	{
+		PROFILING_ZONE("RenderingServer::draw render probes");
+		RSG::scene->render_probes();
+	}
+	{
+		PROFILING_ZONE("RenderingServer::draw viewports");
+		RSG::viewport->draw_viewports();
+	}
+	{
+		PROFILING_ZONE("RenderingServer::draw canvas update");
+		RSG::canvas_render->update();
+	}
 
 	_draw_margins();
-	RSG::rasterizer->end_frame(p_swap_buffers);
+
+	{
+		PROFILING_ZONE("RenderingServer::draw end frame");
+		RSG::rasterizer->end_frame(p_swap_buffers);
+	}
 
 	while (frame_drawn_callbacks.front()) {
 
@@ -175,6 +213,10 @@ void RenderingServerRaster::finish() {
 
 int RenderingServerRaster::get_render_info(RenderInfo p_info) {
 
+	if (p_info >= INFO_2D_DRAW_CALLS_IN_FRAME && p_info <= INFO_2D_BATCH_BREAKS_BUFFER_FULL) {
+		return RSG::canvas_render->get_render_info(p_info);
+	}
+
 	return RSG::storage->get_render_info(p_info);
 }
 
@@ -182,6 +182,7 @@ public:
 	BIND3(texture_set_detect_3d_callback, RID, TextureDetectCallback, void *)
 	BIND3(texture_set_detect_normal_callback, RID, TextureDetectCallback, void *)
 	BIND3(texture_set_detect_roughness_callback, RID, TextureDetectRoughnessCallback, void *)
+	BIND4(texture_set_stream_callback, RID, int, TextureStreamCallback, void *)
 
 	BIND2(texture_set_path, RID, const String &)
 	BIND1RC(String, texture_get_path, RID)
@@ -269,6 +270,7 @@ public:
 	BIND2RC(Color, multimesh_instance_get_custom_data, RID, int)
 
 	BIND2(multimesh_set_buffer, RID, const Vector<float> &)
+	BIND3(multimesh_set_buffer_range, RID, int, const Vector<float> &)
 	BIND1RC(Vector<float>, multimesh_get_buffer, RID)
 
 	BIND2(multimesh_set_visible_instances, RID, int)
@@ -295,6 +297,7 @@ public:
 	BIND3(skeleton_allocate, RID, int, bool)
 	BIND1RC(int, skeleton_get_bone_count, RID)
 	BIND3(skeleton_bone_set_transform, RID, int, const Transform &)
+	BIND2(skeleton_set_bone_transforms, RID, const Vector<float> &)
 	BIND2RC(Transform, skeleton_bone_get_transform, RID, int)
 	BIND3(skeleton_bone_set_transform_2d, RID, int, const Transform2D &)
 	BIND2RC(Transform2D, skeleton_bone_get_transform_2d, RID, int)
@@ -489,6 +492,8 @@ public:
 	BIND2(viewport_set_shadow_atlas_size, RID, int)
 	BIND3(viewport_set_shadow_atlas_quadrant_subdivision, RID, int, int)
 	BIND2(viewport_set_msaa, RID, ViewportMSAA)
+	BIND5(viewport_set_dynamic_resolution, RID, bool, float, float, float)
+	BIND1R(float, viewport_get_render_scale, RID)
 
 	BIND2R(int, viewport_get_render_info, RID, ViewportRenderInfo)
 	BIND2(viewport_set_debug_draw, RID, ViewportDebugDraw)
@@ -558,6 +563,7 @@ public:
 	BIND0R(RID, scenario_create)
 
 	BIND2(scenario_set_debug, RID, ScenarioDebugMode)
+	BIND2(scenario_set_spatial_index, RID, ScenarioSpatialIndex)
 	BIND2(scenario_set_environment, RID, RID)
 	BIND2(scenario_set_camera_effects, RID, RID)
 	BIND2(scenario_set_fallback_environment, RID, RID)
@@ -569,6 +575,9 @@ public:
 	BIND2(instance_set_scenario, RID, RID)
 	BIND2(instance_set_layer_mask, RID, uint32_t)
 	BIND2(instance_set_transform, RID, const Transform &)
+	BIND2(instances_set_transform, const Vector<RID> &, const Vector<Transform> &)
+	BIND2(instance_set_interpolated, RID, bool)
+	BIND1(instance_reset_physics_interpolation, RID)
 	BIND2(instance_attach_object_instance_id, RID, ObjectID)
 	BIND3(instance_set_blend_shape_weight, RID, int, float)
 	BIND3(instance_set_surface_material, RID, int, RID)
@@ -615,6 +624,8 @@ public:
 	BIND2(canvas_item_set_update_when_visible, RID, bool)
 
 	BIND2(canvas_item_set_transform, RID, const Transform2D &)
+	BIND2(canvas_item_set_interpolated, RID, bool)
+	BIND1(canvas_item_reset_physics_interpolation, RID)
 	BIND2(canvas_item_set_clip, RID, bool)
 	BIND2(canvas_item_set_distance_field_mode, RID, bool)
 	BIND3(canvas_item_set_custom_rect, RID, bool, const Rect2 &)
@@ -633,6 +644,7 @@ public:
 	BIND4(canvas_item_add_circle, RID, const Point2 &, float, const Color &)
 	BIND11(canvas_item_add_texture_rect, RID, const Rect2 &, RID, bool, const Color &, bool, RID, RID, const Color &, CanvasItemTextureFilter, CanvasItemTextureRepeat)
 	BIND12(canvas_item_add_texture_rect_region, RID, const Rect2 &, RID, const Rect2 &, const Color &, bool, RID, RID, const Color &, bool, CanvasItemTextureFilter, CanvasItemTextureRepeat)
+	BIND5(canvas_item_add_distance_field_texture_rect_region, RID, const Rect2 &, RID, const Rect2 &, const Color &)
 	BIND15(canvas_item_add_nine_patch, RID, const Rect2 &, const Rect2 &, RID, const Vector2 &, const Vector2 &, NinePatchAxisMode, NinePatchAxisMode, bool, const Color &, RID, RID, const Color &, CanvasItemTextureFilter, CanvasItemTextureRepeat)
 	BIND11(canvas_item_add_primitive, RID, const Vector<Point2> &, const Vector<Color> &, const Vector<Point2> &, RID, float, RID, RID, const Color &, CanvasItemTextureFilter, CanvasItemTextureRepeat)
 	BIND10(canvas_item_add_polygon, RID, const Vector<Point2> &, const Vector<Color> &, const Vector<Point2> &, RID, RID, RID, const Color &, CanvasItemTextureFilter, CanvasItemTextureRepeat)
@@ -704,6 +716,7 @@ public:
 
 	virtual void request_frame_drawn_callback(Object *p_where, const StringName &p_method, const Variant &p_userdata);
 
+	virtual void tick();
 	virtual void draw(bool p_swap_buffers, double frame_step);
 	virtual void sync();
 	virtual bool has_changed() const;
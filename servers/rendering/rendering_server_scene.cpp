@@ -31,6 +31,8 @@
 #include "rendering_server_scene.h"
 
 #include "core/os/os.h"
+#include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 #include "rendering_server_globals.h"
 #include "rendering_server_raster.h"
 
@@ -112,7 +114,7 @@ void RenderingServerScene::camera_set_use_vertical_aspect(RID p_camera, bool p_e
 
 /* SCENARIO API */
 
-void *RenderingServerScene::_instance_pair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int) {
+void *RenderingServerScene::_instance_pair(void *p_self, SpatialPartitionID, Instance *p_A, int, SpatialPartitionID, Instance *p_B, int) {
 
 	//RenderingServerScene *self = (RenderingServerScene*)p_self;
 	Instance *A = p_A;
@@ -137,6 +139,9 @@ void *RenderingServerScene::_instance_pair(void *p_self, OctreeElementID, Instan
 		if (geom->can_cast_shadows) {
 
 			light->shadow_dirty = true;
+			if (!A->shadow_dynamic) {
+				light->static_shadow_dirty = true;
+			}
 		}
 		geom->lighting_dirty = true;
 
@@ -196,7 +201,7 @@ void *RenderingServerScene::_instance_pair(void *p_self, OctreeElementID, Instan
 
 	return NULL;
 }
-void RenderingServerScene::_instance_unpair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int, void *udata) {
+void RenderingServerScene::_instance_unpair(void *p_self, SpatialPartitionID, Instance *p_A, int, SpatialPartitionID, Instance *p_B, int, void *udata) {
 
 	//RenderingServerScene *self = (RenderingServerScene*)p_self;
 	Instance *A = p_A;
@@ -219,6 +224,9 @@ void RenderingServerScene::_instance_unpair(void *p_self, OctreeElementID, Insta
 
 		if (geom->can_cast_shadows) {
 			light->shadow_dirty = true;
+			if (!A->shadow_dynamic) {
+				light->static_shadow_dirty = true;
+			}
 		}
 		geom->lighting_dirty = true;
 
@@ -269,6 +277,20 @@ void RenderingServerScene::_instance_unpair(void *p_self, OctreeElementID, Insta
 	}
 }
 
+RenderingServerScene::SpatialPartitioningScene *RenderingServerScene::_create_spatial_partitioning(RS::ScenarioSpatialIndex p_index) {
+
+	SpatialPartitioningScene *sps;
+	if (p_index == RS::SCENARIO_SPATIAL_INDEX_BVH) {
+		sps = memnew(SpatialPartitioningSceneBVH);
+	} else {
+		sps = memnew(SpatialPartitioningSceneOctree);
+	}
+
+	sps->set_pair_callback(_instance_pair, this);
+	sps->set_unpair_callback(_instance_unpair, this);
+	return sps;
+}
+
 RID RenderingServerScene::scenario_create() {
 
 	Scenario *scenario = memnew(Scenario);
@@ -276,8 +298,8 @@ RID RenderingServerScene::scenario_create() {
 	RID scenario_rid = scenario_owner.make_rid(scenario);
 	scenario->self = scenario_rid;
 
-	scenario->octree.set_pair_callback(_instance_pair, this);
-	scenario->octree.set_unpair_callback(_instance_unpair, this);
+	scenario->spatial_index = GLOBAL_GET("rendering/quality/spatial_partitioning/use_bvh") ? RS::SCENARIO_SPATIAL_INDEX_BVH : RS::SCENARIO_SPATIAL_INDEX_OCTREE;
+	scenario->sps = _create_spatial_partitioning(scenario->spatial_index);
 	scenario->reflection_probe_shadow_atlas = RSG::scene_render->shadow_atlas_create();
 	RSG::scene_render->shadow_atlas_set_size(scenario->reflection_probe_shadow_atlas, 1024); //make enough shadows for close distance, don't bother with rest
 	RSG::scene_render->shadow_atlas_set_quadrant_subdivision(scenario->reflection_probe_shadow_atlas, 0, 4);
@@ -295,6 +317,32 @@ void RenderingServerScene::scenario_set_debug(RID p_scenario, RS::ScenarioDebugM
 	scenario->debug = p_debug_mode;
 }
 
+void RenderingServerScene::scenario_set_spatial_index(RID p_scenario, RS::ScenarioSpatialIndex p_index) {
+
+	Scenario *scenario = scenario_owner.getornull(p_scenario);
+	ERR_FAIL_COND(!scenario);
+	ERR_FAIL_INDEX(p_index, RS::SCENARIO_SPATIAL_INDEX_MAX);
+
+	if (scenario->spatial_index == p_index) {
+		return;
+	}
+
+	// take everything out of the old index (which unpairs it), it will be reinserted on the next update
+	for (SelfList<Instance> *E = scenario->instances.first(); E; E = E->next()) {
+
+		Instance *instance = E->self();
+		if (instance->spatial_partition_id) {
+			scenario->sps->erase(instance->spatial_partition_id);
+			instance->spatial_partition_id = 0;
+			_instance_queue_update(instance, true, false);
+		}
+	}
+
+	memdelete(scenario->sps);
+	scenario->spatial_index = p_index;
+	scenario->sps = _create_spatial_partitioning(p_index);
+}
+
 void RenderingServerScene::scenario_set_environment(RID p_scenario, RID p_environment) {
 
 	Scenario *scenario = scenario_owner.getornull(p_scenario);
@@ -346,6 +394,14 @@ RID RenderingServerScene::instance_create() {
 	RID instance_rid = instance_owner.make_rid(instance);
 	instance->self = instance_rid;
 
+	if (occlusion_id_free_list.size()) {
+		instance->occlusion_id = occlusion_id_free_list[occlusion_id_free_list.size() - 1];
+		occlusion_id_free_list.resize(occlusion_id_free_list.size() - 1);
+	} else {
+		instance->occlusion_id = occlusion_id_count++;
+	}
+	instance->occlusion_generation = ++occlusion_generation;
+
 	return instance_rid;
 }
 
@@ -359,9 +415,9 @@ void RenderingServerScene::instance_set_base(RID p_instance, RID p_base) {
 	if (instance->base_type != RS::INSTANCE_NONE) {
 		//free anything related to that base
 
-		if (scenario && instance->octree_id) {
-			scenario->octree.erase(instance->octree_id); //make dependencies generated by the octree go away
-			instance->octree_id = 0;
+		if (scenario && instance->spatial_partition_id) {
+			scenario->sps->erase(instance->spatial_partition_id); //make dependencies generated by the spatial index go away
+			instance->spatial_partition_id = 0;
 		}
 
 		switch (instance->base_type) {
@@ -516,9 +572,9 @@ void RenderingServerScene::instance_set_scenario(RID p_instance, RID p_scenario)
 
 		instance->scenario->instances.remove(&instance->scenario_item);
 
-		if (instance->octree_id) {
-			instance->scenario->octree.erase(instance->octree_id); //make dependencies generated by the octree go away
-			instance->octree_id = 0;
+		if (instance->spatial_partition_id) {
+			instance->scenario->sps->erase(instance->spatial_partition_id); //make dependencies generated by the spatial index go away
+			instance->spatial_partition_id = 0;
 		}
 
 		switch (instance->base_type) {
@@ -612,7 +668,7 @@ void RenderingServerScene::instance_set_transform(RID p_instance, const Transfor
 	Instance *instance = instance_owner.getornull(p_instance);
 	ERR_FAIL_COND(!instance);
 
-	if (instance->transform == p_transform)
+	if ((instance->interpolated ? instance->transform_curr : instance->transform) == p_transform)
 		return; //must be checked to avoid worst evil
 
 #ifdef DEBUG_ENABLED
@@ -628,9 +684,76 @@ void RenderingServerScene::instance_set_transform(RID p_instance, const Transfor
 	}
 
 #endif
+
+	if (instance->interpolated) {
+		//applied when drawing, blended with the transform of the previous tick
+		instance->transform_curr = p_transform;
+		instance->interpolation_stale = false;
+		if (!instance->interpolation_item.in_list()) {
+			_instance_interpolation_list.add(&instance->interpolation_item);
+		}
+		return;
+	}
+
 	instance->transform = p_transform;
 	_instance_queue_update(instance, true);
 }
+
+void RenderingServerScene::instances_set_transform(const Vector<RID> &p_instances, const Vector<Transform> &p_transforms) {
+
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	const RID *instances = p_instances.ptr();
+	const Transform *transforms = p_transforms.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		if (!instance_owner.owns(instances[i])) {
+			continue; //freed after being queued
+		}
+		RenderingServerScene::instance_set_transform(instances[i], transforms[i]);
+	}
+}
+
+void RenderingServerScene::instance_set_interpolated(RID p_instance, bool p_interpolated) {
+
+	Instance *instance = instance_owner.getornull(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	if (instance->interpolated == p_interpolated)
+		return;
+
+	instance->interpolated = p_interpolated;
+
+	if (p_interpolated) {
+		instance->transform_curr = instance->transform;
+		instance->transform_prev = instance->transform;
+		return;
+	}
+
+	if (instance->interpolation_item.in_list()) {
+		_instance_interpolation_list.remove(&instance->interpolation_item);
+	}
+
+	if (instance->transform != instance->transform_curr) {
+		instance->transform = instance->transform_curr;
+		_instance_queue_update(instance, true);
+	}
+}
+
+void RenderingServerScene::instance_reset_physics_interpolation(RID p_instance) {
+
+	Instance *instance = instance_owner.getornull(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	if (!instance->interpolated)
+		return;
+
+	instance->transform_prev = instance->transform_curr;
+
+	if (instance->transform != instance->transform_curr) {
+		instance->transform = instance->transform_curr;
+		_instance_queue_update(instance, true);
+	}
+}
 void RenderingServerScene::instance_attach_object_instance_id(RID p_instance, ObjectID p_id) {
 
 	Instance *instance = instance_owner.getornull(p_instance);
@@ -680,26 +803,26 @@ void RenderingServerScene::instance_set_visible(RID p_instance, bool p_visible)
 
 	switch (instance->base_type) {
 		case RS::INSTANCE_LIGHT: {
-			if (RSG::storage->light_get_type(instance->base) != RS::LIGHT_DIRECTIONAL && instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << RS::INSTANCE_LIGHT, p_visible ? RS::INSTANCE_GEOMETRY_MASK : 0);
+			if (RSG::storage->light_get_type(instance->base) != RS::LIGHT_DIRECTIONAL && instance->spatial_partition_id && instance->scenario) {
+				instance->scenario->sps->set_pairable(instance->spatial_partition_id, p_visible, 1 << RS::INSTANCE_LIGHT, p_visible ? RS::INSTANCE_GEOMETRY_MASK : 0);
 			}
 
 		} break;
 		case RS::INSTANCE_REFLECTION_PROBE: {
-			if (instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << RS::INSTANCE_REFLECTION_PROBE, p_visible ? RS::INSTANCE_GEOMETRY_MASK : 0);
+			if (instance->spatial_partition_id && instance->scenario) {
+				instance->scenario->sps->set_pairable(instance->spatial_partition_id, p_visible, 1 << RS::INSTANCE_REFLECTION_PROBE, p_visible ? RS::INSTANCE_GEOMETRY_MASK : 0);
 			}
 
 		} break;
 		case RS::INSTANCE_LIGHTMAP_CAPTURE: {
-			if (instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << RS::INSTANCE_LIGHTMAP_CAPTURE, p_visible ? RS::INSTANCE_GEOMETRY_MASK : 0);
+			if (instance->spatial_partition_id && instance->scenario) {
+				instance->scenario->sps->set_pairable(instance->spatial_partition_id, p_visible, 1 << RS::INSTANCE_LIGHTMAP_CAPTURE, p_visible ? RS::INSTANCE_GEOMETRY_MASK : 0);
 			}
 
 		} break;
 		case RS::INSTANCE_GI_PROBE: {
-			if (instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << RS::INSTANCE_GI_PROBE, p_visible ? (RS::INSTANCE_GEOMETRY_MASK | (1 << RS::INSTANCE_LIGHT)) : 0);
+			if (instance->spatial_partition_id && instance->scenario) {
+				instance->scenario->sps->set_pairable(instance->spatial_partition_id, p_visible, 1 << RS::INSTANCE_GI_PROBE, p_visible ? (RS::INSTANCE_GEOMETRY_MASK | (1 << RS::INSTANCE_LIGHT)) : 0);
 			}
 
 		} break;
@@ -799,7 +922,7 @@ Vector<ObjectID> RenderingServerScene::instances_cull_aabb(const AABB &p_aabb, R
 
 	int culled = 0;
 	Instance *cull[1024];
-	culled = scenario->octree.cull_aabb(p_aabb, cull, 1024);
+	culled = scenario->sps->cull_aabb(p_aabb, cull, 1024);
 
 	for (int i = 0; i < culled; i++) {
 
@@ -822,7 +945,7 @@ Vector<ObjectID> RenderingServerScene::instances_cull_ray(const Vector3 &p_from,
 
 	int culled = 0;
 	Instance *cull[1024];
-	culled = scenario->octree.cull_segment(p_from, p_from + p_to * 10000, cull, 1024);
+	culled = scenario->sps->cull_segment(p_from, p_from + p_to * 10000, cull, 1024);
 
 	for (int i = 0; i < culled; i++) {
 		Instance *instance = cull[i];
@@ -845,7 +968,7 @@ Vector<ObjectID> RenderingServerScene::instances_cull_convex(const Vector<Plane>
 	int culled = 0;
 	Instance *cull[1024];
 
-	culled = scenario->octree.cull_convex(p_convex, cull, 1024);
+	culled = scenario->sps->cull_convex(p_convex, cull, 1024);
 
 	for (int i = 0; i < culled; i++) {
 
@@ -881,14 +1004,14 @@ void RenderingServerScene::instance_geometry_set_flag(RID p_instance, RS::Instan
 				return;
 			}
 
-			if (instance->octree_id != 0) {
-				//remove from octree, it needs to be re-paired
-				instance->scenario->octree.erase(instance->octree_id);
-				instance->octree_id = 0;
+			if (instance->spatial_partition_id != 0) {
+				//remove from spatial index, it needs to be re-paired
+				instance->scenario->sps->erase(instance->spatial_partition_id);
+				instance->spatial_partition_id = 0;
 				_instance_queue_update(instance, true, true);
 			}
 
-			//once out of octree, can be changed
+			//once out of spatial index, can be changed
 			instance->dynamic_gi = p_enabled;
 
 		} break;
@@ -896,6 +1019,11 @@ void RenderingServerScene::instance_geometry_set_flag(RID p_instance, RS::Instan
 
 			instance->redraw_if_visible = p_enabled;
 
+		} break;
+		case RS::INSTANCE_FLAG_IGNORE_OCCLUSION_CULLING: {
+
+			instance->ignore_occlusion_culling = p_enabled;
+
 		} break;
 		default: {
 		}
@@ -933,6 +1061,7 @@ void RenderingServerScene::_update_instance(Instance *p_instance) {
 
 		RSG::scene_render->light_instance_set_transform(light->instance, p_instance->transform);
 		light->shadow_dirty = true;
+		light->static_shadow_dirty = true;
 	}
 
 	if (p_instance->base_type == RS::INSTANCE_REFLECTION_PROBE) {
@@ -965,9 +1094,21 @@ void RenderingServerScene::_update_instance(Instance *p_instance) {
 		//make sure lights are updated if it casts shadow
 
 		if (geom->can_cast_shadows) {
+			//a static caster that moves leaves the cached static shadows, it's drawn on top of them until it rests again
+			bool was_static = !p_instance->shadow_dynamic;
+
 			for (List<Instance *>::Element *E = geom->lighting.front(); E; E = E->next()) {
 				InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
 				light->shadow_dirty = true;
+				if (was_static) {
+					light->static_shadow_dirty = true;
+				}
+			}
+
+			p_instance->shadow_dynamic = true;
+			p_instance->shadow_dynamic_frame = shadow_caster_frame;
+			if (!p_instance->shadow_dynamic_item.in_list()) {
+				_instance_shadow_dynamic_list.add(&p_instance->shadow_dynamic_item);
 			}
 		}
 
@@ -994,7 +1135,7 @@ void RenderingServerScene::_update_instance(Instance *p_instance) {
 		return;
 	}
 
-	if (p_instance->octree_id == 0) {
+	if (p_instance->spatial_partition_id == 0) {
 
 		uint32_t base_type = 1 << p_instance->base_type;
 		uint32_t pairable_mask = 0;
@@ -1012,8 +1153,8 @@ void RenderingServerScene::_update_instance(Instance *p_instance) {
 			pairable = true;
 		}
 
-		// not inside octree
-		p_instance->octree_id = p_instance->scenario->octree.create(p_instance, new_aabb, 0, pairable, base_type, pairable_mask);
+		// not inside spatial index
+		p_instance->spatial_partition_id = p_instance->scenario->sps->create(p_instance, new_aabb, 0, pairable, base_type, pairable_mask);
 
 	} else {
 
@@ -1022,7 +1163,7 @@ void RenderingServerScene::_update_instance(Instance *p_instance) {
 			return;
 		*/
 
-		p_instance->scenario->octree.move(p_instance->octree_id, new_aabb);
+		p_instance->scenario->sps->move(p_instance->spatial_partition_id, new_aabb);
 	}
 }
 
@@ -1334,15 +1475,104 @@ void RenderingServerScene::_update_instance_lightmap_captures(Instance *p_instan
 	}
 }
 
-bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario) {
+void RenderingServerScene::_cull_job_process(uint32_t p_index, CullJob **p_jobs) {
+
+	CullJob *job = p_jobs[p_index];
+	SpatialPartitioningScene *sps = job->scenario->sps;
+
+	if (job->result.size() == 0) {
+		job->result.resize(1024);
+	}
+
+	// the spatial index stops at the buffer size, so grow it and try again until everything fits
+	while (true) {
+		job->result_count = sps->cull_convex(job->planes, job->result.ptrw(), job->result.size(), job->mask);
+		if (job->result_count < job->result.size()) {
+			break;
+		}
+		job->result.resize(job->result.size() * 2);
+	}
+
+	job->animated_material_found = false;
+	job->static_count = 0;
+
+	if (!job->shadow_casters_only) {
+		return;
+	}
+
+	Instance **result = job->result.ptrw();
+
+	for (int i = 0; i < job->result_count; i++) {
+
+		Instance *instance = result[i];
+		if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
+			job->result_count--;
+			SWAP(result[i], result[job->result_count]);
+			i--;
+			continue;
+		}
+
+		if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
+			job->animated_material_found = true;
+		}
+	}
+
+	//move the casters of the static shadow layer to the front, animated materials redraw every frame so they never belong there
+	job->static_count = 0;
+
+	for (int i = 0; i < job->result_count; i++) {
+
+		Instance *instance = result[i];
+		if (!instance->shadow_dynamic && !static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
+			SWAP(result[i], result[job->static_count]);
+			job->static_count++;
+		}
+	}
+}
+
+void RenderingServerScene::_cull_jobs_run(Scenario *p_scenario, CullJob **p_jobs, int p_job_count) {
+
+	ThreadWorkPool *pool = ThreadWorkPool::get_singleton();
+
+	if (p_job_count > 1 && pool && pool->get_thread_count() > 0 && p_scenario->sps->is_cull_thread_safe()) {
+		pool->do_work(p_job_count, this, &RenderingServerScene::_cull_job_process, p_jobs);
+	} else {
+		for (int i = 0; i < p_job_count; i++) {
+			_cull_job_process(i, p_jobs);
+		}
+	}
+}
+
+RenderingServerScene::ShadowPass &RenderingServerScene::_shadow_pass_add(Instance *p_light, int p_pass, Scenario *p_scenario) {
+
+	if (shadow_pass_count == shadow_passes.size()) {
+		shadow_passes.resize(MAX(16, shadow_passes.size() * 2));
+	}
+
+	ShadowPass &sp = shadow_passes.write[shadow_pass_count++];
+	sp.light = p_light;
+	sp.pass = p_pass;
+	sp.cull.scenario = p_scenario;
+	sp.cull.mask = RS::INSTANCE_GEOMETRY_MASK;
+	sp.cull.shadow_casters_only = true;
+	sp.projection = CameraMatrix();
+	sp.transform = Transform();
+	sp.far = 0;
+	sp.split = 0;
+	sp.bias_scale = 1.0;
+	sp.directional = false;
+	sp.restore_transform = false;
+
+	return sp;
+}
+
+void RenderingServerScene::_light_instance_setup_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, Scenario *p_scenario, bool p_caster_range_found, float p_caster_z_min, float p_caster_z_max) {
 
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
 	Transform light_transform = p_instance->transform;
 	light_transform.orthonormalize(); //scale does not count on lights
 
-	bool animated_material_found = false;
-
 	switch (RSG::storage->light_get_type(p_instance->base)) {
 
 		case RS::LIGHT_DIRECTIONAL: {
@@ -1357,46 +1587,10 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 
 			RS::LightDirectionalShadowDepthRangeMode depth_range_mode = RSG::storage->light_directional_get_shadow_depth_range_mode(p_instance->base);
 
-			if (depth_range_mode == RS::LIGHT_DIRECTIONAL_SHADOW_DEPTH_RANGE_OPTIMIZED) {
-				//optimize min/max
-				Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
-				int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, RS::INSTANCE_GEOMETRY_MASK);
-				Plane base(p_cam_transform.origin, -p_cam_transform.basis.get_axis(2));
-				//check distance max and min
-
-				bool found_items = false;
-				float z_max = -1e20;
-				float z_min = 1e20;
-
-				for (int i = 0; i < cull_count; i++) {
-
-					Instance *instance = instance_shadow_cull_result[i];
-					if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-						continue;
-					}
-
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
-
-					float max, min;
-					instance->transformed_aabb.project_range_in_plane(base, min, max);
-
-					if (max > z_max) {
-						z_max = max;
-					}
-
-					if (min < z_min) {
-						z_min = min;
-					}
-
-					found_items = true;
-				}
-
-				if (found_items) {
-					min_distance = MAX(min_distance, z_min);
-					max_distance = MIN(max_distance, z_max);
-				}
+			if (depth_range_mode == RS::LIGHT_DIRECTIONAL_SHADOW_DEPTH_RANGE_OPTIMIZED && p_caster_range_found) {
+				//optimize min/max, using the casters found in the camera frustum
+				min_distance = MAX(min_distance, p_caster_z_min);
+				max_distance = MIN(max_distance, p_caster_z_max);
 			}
 
 			float range = max_distance - min_distance;
@@ -1425,8 +1619,6 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 
 			for (int i = 0; i < splits; i++) {
 
-				RENDER_TIMESTAMP("Culling Directional Light split" + itos(i));
-
 				// setup a camera matrix for that range!
 				CameraMatrix camera_matrix;
 
@@ -1545,9 +1737,11 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 					}
 				}
 
-				//now that we now all ranges, we can proceed to make the light frustum planes, for culling octree
+				//now that we now all ranges, we can proceed to make the light frustum planes, for culling
+
+				ShadowPass &sp = _shadow_pass_add(p_instance, i, p_scenario);
 
-				Vector<Plane> light_frustum_planes;
+				Vector<Plane> &light_frustum_planes = sp.cull.planes;
 				light_frustum_planes.resize(6);
 
 				//right/left
@@ -1560,46 +1754,23 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 				light_frustum_planes.write[4] = Plane(z_vec, z_max + 1e6);
 				light_frustum_planes.write[5] = Plane(-z_vec, -z_min); // z_min is ok, since casters further than far-light plane are not needed
 
-				int cull_count = p_scenario->octree.cull_convex(light_frustum_planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, RS::INSTANCE_GEOMETRY_MASK);
-
 				// a pre pass will need to be needed to determine the actual z-near to be used
 
-				Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
-
-				for (int j = 0; j < cull_count; j++) {
-
-					float min, max;
-					Instance *instance = instance_shadow_cull_result[j];
-					if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-						cull_count--;
-						SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-						j--;
-						continue;
-					}
-
-					instance->transformed_aabb.project_range_in_plane(Plane(z_vec, 0), min, max);
-					instance->depth = near_plane.distance_to(instance->transform.origin);
-					instance->depth_layer = 0;
-					if (max > z_max)
-						z_max = max;
-				}
-
-				{
-
-					CameraMatrix ortho_camera;
-					real_t half_x = (x_max_cam - x_min_cam) * 0.5;
-					real_t half_y = (y_max_cam - y_min_cam) * 0.5;
-
-					ortho_camera.set_orthogonal(-half_x, half_x, -half_y, half_y, 0, (z_max - z_min_cam));
-
-					Transform ortho_transform;
-					ortho_transform.basis = transform.basis;
-					ortho_transform.origin = x_vec * (x_min_cam + half_x) + y_vec * (y_min_cam + half_y) + z_vec * z_max;
-
-					RSG::scene_render->light_instance_set_shadow_transform(light->instance, ortho_camera, ortho_transform, 0, distances[i + 1], i, bias_scale);
-				}
-
-				RSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+				sp.near_plane = Plane(light_transform.origin, -light_transform.basis.get_axis(2));
+				sp.transform.basis = transform.basis;
+				sp.split = distances[i + 1];
+				sp.bias_scale = bias_scale;
+
+				sp.directional = true;
+				sp.x_vec = x_vec;
+				sp.y_vec = y_vec;
+				sp.z_vec = z_vec;
+				sp.x_min_cam = x_min_cam;
+				sp.x_max_cam = x_max_cam;
+				sp.y_min_cam = y_min_cam;
+				sp.y_max_cam = y_max_cam;
+				sp.z_min_cam = z_min_cam;
+				sp.z_max = z_max;
 			}
 
 		} break;
@@ -1611,13 +1782,13 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 
 				for (int i = 0; i < 2; i++) {
 
-					//using this one ensures that raster deferred will have it
-					RENDER_TIMESTAMP("Culling Shadow Paraboloid" + itos(i));
-
 					float radius = RSG::storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
 
 					float z = i == 0 ? -1 : 1;
-					Vector<Plane> planes;
+
+					ShadowPass &sp = _shadow_pass_add(p_instance, i, p_scenario);
+
+					Vector<Plane> &planes = sp.cull.planes;
 					planes.resize(5);
 					planes.write[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
 					planes.write[1] = light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius));
@@ -1625,28 +1796,9 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 					planes.write[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
 					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
 
-					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, RS::INSTANCE_GEOMETRY_MASK);
-					Plane near_plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
-
-					for (int j = 0; j < cull_count; j++) {
-
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							cull_count--;
-							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-							j--;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-
-							instance->depth = near_plane.distance_to(instance->transform.origin);
-							instance->depth_layer = 0;
-						}
-					}
-
-					RSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, i);
-					RSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+					sp.near_plane = Plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
+					sp.transform = light_transform;
+					sp.far = radius;
 				}
 			} else { //shadow cube
 
@@ -1656,9 +1808,6 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 
 				for (int i = 0; i < 6; i++) {
 
-					RENDER_TIMESTAMP("Culling Shadow Cube side" + itos(i));
-					//using this one ensures that raster deferred will have it
-
 					static const Vector3 view_normals[6] = {
 						Vector3(+1, 0, 0),
 						Vector3(-1, 0, 0),
@@ -1678,73 +1827,78 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 
 					Transform xform = light_transform * Transform().looking_at(view_normals[i], view_up[i]);
 
-					Vector<Plane> planes = cm.get_projection_planes(xform);
-
-					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, RS::INSTANCE_GEOMETRY_MASK);
+					ShadowPass &sp = _shadow_pass_add(p_instance, i, p_scenario);
 
-					Plane near_plane(xform.origin, -xform.basis.get_axis(2));
-					for (int j = 0; j < cull_count; j++) {
-
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							cull_count--;
-							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-							j--;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							instance->depth = near_plane.distance_to(instance->transform.origin);
-							instance->depth_layer = 0;
-						}
-					}
-
-					RSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i);
-					RSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+					sp.cull.planes = cm.get_projection_planes(xform);
+					sp.near_plane = Plane(xform.origin, -xform.basis.get_axis(2));
+					sp.projection = cm;
+					sp.transform = xform;
+					sp.far = radius;
+					//restore the regular DP matrix after the last face
+					sp.restore_transform = i == 5;
 				}
-
-				//restore the regular DP matrix
-				RSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, 0);
 			}
 
 		} break;
 		case RS::LIGHT_SPOT: {
 
-			RENDER_TIMESTAMP("Culling Spot Light");
-
 			float radius = RSG::storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
 			float angle = RSG::storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_SPOT_ANGLE);
 
 			CameraMatrix cm;
 			cm.set_perspective(angle * 2.0, 1.0, 0.01, radius);
 
-			Vector<Plane> planes = cm.get_projection_planes(light_transform);
-			int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, RS::INSTANCE_GEOMETRY_MASK);
+			ShadowPass &sp = _shadow_pass_add(p_instance, 0, p_scenario);
 
-			Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
-			for (int j = 0; j < cull_count; j++) {
+			sp.cull.planes = cm.get_projection_planes(light_transform);
+			sp.near_plane = Plane(light_transform.origin, -light_transform.basis.get_axis(2));
+			sp.projection = cm;
+			sp.transform = light_transform;
+			sp.far = radius;
 
-				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-					cull_count--;
-					SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-					j--;
-				} else {
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
-					instance->depth = near_plane.distance_to(instance->transform.origin);
-					instance->depth_layer = 0;
-				}
-			}
+		} break;
+	}
+}
 
-			RSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0);
-			RSG::scene_render->render_shadow(light->instance, p_shadow_atlas, 0, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+void RenderingServerScene::_shadow_pass_render(ShadowPass &p_pass, RID p_shadow_atlas) {
 
-		} break;
+	InstanceLightData *light = static_cast<InstanceLightData *>(p_pass.light->base_data);
+
+	Instance **cull_result = p_pass.cull.result.ptrw();
+	int cull_count = p_pass.cull.result_count;
+
+	for (int j = 0; j < cull_count; j++) {
+
+		Instance *instance = cull_result[j];
+
+		if (p_pass.directional) {
+			float min, max;
+			instance->transformed_aabb.project_range_in_plane(Plane(p_pass.z_vec, 0), min, max);
+			if (max > p_pass.z_max)
+				p_pass.z_max = max;
+		}
+
+		instance->depth = p_pass.near_plane.distance_to(instance->transform.origin);
+		instance->depth_layer = 0;
+	}
+
+	if (p_pass.directional) {
+
+		real_t half_x = (p_pass.x_max_cam - p_pass.x_min_cam) * 0.5;
+		real_t half_y = (p_pass.y_max_cam - p_pass.y_min_cam) * 0.5;
+
+		p_pass.projection.set_orthogonal(-half_x, half_x, -half_y, half_y, 0, (p_pass.z_max - p_pass.z_min_cam));
+		p_pass.transform.origin = p_pass.x_vec * (p_pass.x_min_cam + half_x) + p_pass.y_vec * (p_pass.y_min_cam + half_y) + p_pass.z_vec * p_pass.z_max;
 	}
 
-	return animated_material_found;
+	RSG::scene_render->light_instance_set_shadow_transform(light->instance, p_pass.projection, p_pass.transform, p_pass.far, p_pass.split, p_pass.pass, p_pass.bias_scale);
+	RSG::scene_render->render_shadow(light->instance, p_shadow_atlas, p_pass.pass, (RasterizerScene::InstanceBase **)cull_result, cull_count, p_pass.cull.static_count, light->static_version);
+
+	if (p_pass.restore_transform) {
+		Transform light_transform = p_pass.light->transform;
+		light_transform.orthonormalize();
+		RSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, p_pass.far, 0, 0);
+	}
 }
 
 void RenderingServerScene::render_camera(RID p_render_buffers, RID p_camera, RID p_scenario, Size2 p_viewport_size, RID p_shadow_atlas) {
@@ -1904,7 +2058,14 @@ void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const
 	float z_far = p_cam_projection.get_z_far();
 
 	/* STEP 2 - CULL */
-	instance_cull_count = scenario->octree.cull_convex(planes, instance_cull_result, MAX_INSTANCE_CULL);
+	camera_cull.scenario = scenario;
+	camera_cull.planes = planes;
+
+	CullJob *camera_job = &camera_cull;
+	_cull_jobs_run(scenario, &camera_job, 1);
+
+	instance_cull_result = camera_cull.result.ptrw();
+	instance_cull_count = camera_cull.result_count;
 	light_cull_count = 0;
 
 	reflection_probe_cull_count = 0;
@@ -1922,7 +2083,72 @@ void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const
 	/* STEP 3 - PROCESS PORTALS, VALIDATE ROOMS */
 	//removed, will replace with culling
 
-	/* STEP 4 - REMOVE FURTHER CULLED OBJECTS, ADD LIGHTS */
+	/* STEP 4 - FIND DIRECTIONAL LIGHTS WITH SHADOWS */
+
+	Instance **lights_with_shadow = (Instance **)alloca(sizeof(Instance *) * scenario->directional_lights.size());
+	int directional_shadow_count = 0;
+	bool need_caster_range = false;
+
+	for (List<Instance *>::Element *E = scenario->directional_lights.front(); E; E = E->next()) {
+
+		if (!E->get()->visible || !E->get()->base_data)
+			continue;
+
+		if (p_using_shadows && p_shadow_atlas.is_valid() && RSG::storage->light_has_shadow(E->get()->base)) {
+			lights_with_shadow[directional_shadow_count++] = E->get();
+			if (RSG::storage->light_directional_get_shadow_depth_range_mode(E->get()->base) == RS::LIGHT_DIRECTIONAL_SHADOW_DEPTH_RANGE_OPTIMIZED) {
+				need_caster_range = true;
+			}
+		}
+	}
+
+	// optimized directional shadows fit their depth range to the casters in the camera frustum,
+	// which are all in the camera cull result at this point
+	bool caster_range_found = false;
+	float caster_z_max = -1e20;
+	float caster_z_min = 1e20;
+
+	if (need_caster_range) {
+
+		Plane base(p_cam_transform.origin, -p_cam_transform.basis.get_axis(2));
+
+		for (int i = 0; i < instance_cull_count; i++) {
+
+			Instance *instance = instance_cull_result[i];
+			if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
+				continue;
+			}
+
+			float max, min;
+			instance->transformed_aabb.project_range_in_plane(base, min, max);
+
+			if (max > caster_z_max) {
+				caster_z_max = max;
+			}
+
+			if (min < caster_z_min) {
+				caster_z_min = min;
+			}
+
+			caster_range_found = true;
+		}
+	}
+
+	/* STEP 5 - REMOVE FURTHER CULLED OBJECTS, ADD LIGHTS */
+
+	// there can't be more lights or probes than culled instances, so size the buffers once
+	if (light_cull_result.size() < instance_cull_count) {
+		light_cull_result.resize(instance_cull_count);
+	}
+	if (light_instance_cull_result.size() < instance_cull_count + scenario->directional_lights.size()) {
+		light_instance_cull_result.resize(instance_cull_count + scenario->directional_lights.size());
+	}
+	if (reflection_probe_instance_cull_result.size() < instance_cull_count) {
+		reflection_probe_instance_cull_result.resize(instance_cull_count);
+	}
+	if (gi_probe_instance_cull_result.size() < instance_cull_count) {
+		gi_probe_instance_cull_result.resize(instance_cull_count);
+	}
 
 	for (int i = 0; i < instance_cull_count; i++) {
 
@@ -1934,46 +2160,40 @@ void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const
 			//failure
 		} else if (ins->base_type == RS::INSTANCE_LIGHT && ins->visible) {
 
-			if (light_cull_count < MAX_LIGHTS_CULLED) {
-
-				InstanceLightData *light = static_cast<InstanceLightData *>(ins->base_data);
-
-				if (!light->geometries.empty()) {
-					//do not add this light if no geometry is affected by it..
-					light_cull_result[light_cull_count] = ins;
-					light_instance_cull_result[light_cull_count] = light->instance;
-					if (p_shadow_atlas.is_valid() && RSG::storage->light_has_shadow(ins->base)) {
-						RSG::scene_render->light_instance_mark_visible(light->instance); //mark it visible for shadow allocation later
-					}
+			InstanceLightData *light = static_cast<InstanceLightData *>(ins->base_data);
 
-					light_cull_count++;
+			if (!light->geometries.empty()) {
+				//do not add this light if no geometry is affected by it..
+				light_cull_result.write[light_cull_count] = ins;
+				light_instance_cull_result.write[light_cull_count] = light->instance;
+				if (p_shadow_atlas.is_valid() && RSG::storage->light_has_shadow(ins->base)) {
+					RSG::scene_render->light_instance_mark_visible(light->instance); //mark it visible for shadow allocation later
 				}
+
+				light_cull_count++;
 			}
 		} else if (ins->base_type == RS::INSTANCE_REFLECTION_PROBE && ins->visible) {
 
-			if (reflection_probe_cull_count < MAX_REFLECTION_PROBES_CULLED) {
-
-				InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(ins->base_data);
+			InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(ins->base_data);
 
-				if (p_reflection_probe != reflection_probe->instance) {
-					//avoid entering The Matrix
+			if (p_reflection_probe != reflection_probe->instance) {
+				//avoid entering The Matrix
 
-					if (!reflection_probe->geometries.empty()) {
-						//do not add this light if no geometry is affected by it..
-
-						if (reflection_probe->reflection_dirty || RSG::scene_render->reflection_probe_instance_needs_redraw(reflection_probe->instance)) {
-							if (!reflection_probe->update_list.in_list()) {
-								reflection_probe->render_step = 0;
-								reflection_probe_render_list.add_last(&reflection_probe->update_list);
-							}
+				if (!reflection_probe->geometries.empty()) {
+					//do not add this light if no geometry is affected by it..
 
-							reflection_probe->reflection_dirty = false;
+					if (reflection_probe->reflection_dirty || RSG::scene_render->reflection_probe_instance_needs_redraw(reflection_probe->instance)) {
+						if (!reflection_probe->update_list.in_list()) {
+							reflection_probe->render_step = 0;
+							reflection_probe_render_list.add_last(&reflection_probe->update_list);
 						}
 
-						if (RSG::scene_render->reflection_probe_instance_has_reflection(reflection_probe->instance)) {
-							reflection_probe_instance_cull_result[reflection_probe_cull_count] = reflection_probe->instance;
-							reflection_probe_cull_count++;
-						}
+						reflection_probe->reflection_dirty = false;
+					}
+
+					if (RSG::scene_render->reflection_probe_instance_has_reflection(reflection_probe->instance)) {
+						reflection_probe_instance_cull_result.write[reflection_probe_cull_count] = reflection_probe->instance;
+						reflection_probe_cull_count++;
 					}
 				}
 			}
@@ -1985,10 +2205,8 @@ void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const
 				gi_probe_update_list.add(&gi_probe->update_element);
 			}
 
-			if (gi_probe_cull_count < MAX_GI_PROBES_CULLED) {
-				gi_probe_instance_cull_result[gi_probe_cull_count] = gi_probe->probe_instance;
-				gi_probe_cull_count++;
-			}
+			gi_probe_instance_cull_result.write[gi_probe_cull_count] = gi_probe->probe_instance;
+			gi_probe_cull_count++;
 
 		} else if (((1 << ins->base_type) & RS::INSTANCE_GEOMETRY_MASK) && ins->visible && ins->cast_shadows != RS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
 
@@ -2073,34 +2291,23 @@ void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const
 		}
 	}
 
-	/* STEP 5 - PROCESS LIGHTS */
+	/* STEP 6 - PROCESS LIGHTS */
 
-	RID *directional_light_ptr = &light_instance_cull_result[light_cull_count];
+	RID *directional_light_ptr = light_instance_cull_result.ptrw() + light_cull_count;
 	directional_light_count = 0;
+	shadow_pass_count = 0;
 
 	// directional lights
 	{
 
-		Instance **lights_with_shadow = (Instance **)alloca(sizeof(Instance *) * scenario->directional_lights.size());
-		int directional_shadow_count = 0;
-
 		for (List<Instance *>::Element *E = scenario->directional_lights.front(); E; E = E->next()) {
 
-			if (light_cull_count + directional_light_count >= MAX_LIGHTS_CULLED) {
-				break;
-			}
-
 			if (!E->get()->visible)
 				continue;
 
 			InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
 
-			//check shadow..
-
 			if (light) {
-				if (p_using_shadows && p_shadow_atlas.is_valid() && RSG::storage->light_has_shadow(E->get()->base)) {
-					lights_with_shadow[directional_shadow_count++] = E->get();
-				}
 				//add to list
 				directional_light_ptr[directional_light_count++] = light->instance;
 			}
@@ -2110,11 +2317,7 @@ void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const
 
 		for (int i = 0; i < directional_shadow_count; i++) {
 
-			RENDER_TIMESTAMP(">Rendering Directional Light " + itos(i));
-
-			_light_instance_update_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario);
-
-			RENDER_TIMESTAMP("<Rendering Directional Light " + itos(i));
+			_light_instance_setup_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, scenario, caster_range_found, caster_z_min, caster_z_max);
 		}
 	}
 
@@ -2208,17 +2411,52 @@ void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const
 				light->last_version++;
 				light->shadow_dirty = false;
 			}
+			if (light->static_shadow_dirty) {
+				light->static_version++;
+				light->static_shadow_dirty = false;
+			}
 
 			bool redraw = RSG::scene_render->shadow_atlas_update_light(p_shadow_atlas, light->instance, coverage, light->last_version);
 
 			if (redraw) {
 				//must redraw!
-				RENDER_TIMESTAMP(">Rendering Light " + itos(i));
-				light->shadow_dirty = _light_instance_update_shadow(ins, p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario);
-				RENDER_TIMESTAMP("<Rendering Light " + itos(i));
+				_light_instance_setup_shadow(ins, p_cam_transform, p_cam_projection, p_cam_orthogonal, scenario, false, 0, 0);
 			}
 		}
 	}
+
+	/* STEP 7 - CULL AND RENDER SHADOWS */
+
+	if (shadow_pass_count == 0) {
+		return;
+	}
+
+	RENDER_TIMESTAMP("Culling Shadows");
+
+	if (cull_job_queue.size() < shadow_pass_count) {
+		cull_job_queue.resize(shadow_pass_count);
+	}
+
+	CullJob **jobs = cull_job_queue.ptrw();
+	for (int i = 0; i < shadow_pass_count; i++) {
+		jobs[i] = &shadow_passes.write[i].cull;
+	}
+
+	_cull_jobs_run(scenario, jobs, shadow_pass_count);
+
+	for (int i = 0; i < shadow_pass_count; i++) {
+
+		ShadowPass &sp = shadow_passes.write[i];
+
+		RENDER_TIMESTAMP(">Rendering Shadow Pass " + itos(i));
+		_shadow_pass_render(sp, p_shadow_atlas);
+		RENDER_TIMESTAMP("<Rendering Shadow Pass " + itos(i));
+
+		if (!sp.directional && sp.cull.animated_material_found) {
+			// animated casters need the shadow redrawn next frame too
+			static_cast<InstanceLightData *>(sp.light->base_data)->shadow_dirty = true;
+		}
+	}
 }
 
 void RenderingServerScene::_render_scene(RID p_render_buffers, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, RID p_force_camera_effects, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass) {
@@ -2244,7 +2482,7 @@ void RenderingServerScene::_render_scene(RID p_render_buffers, const Transform p
 	/* PROCESS GEOMETRY AND DRAW SCENE */
 
 	RENDER_TIMESTAMP("Render Scene ");
-	RSG::scene_render->render_scene(p_render_buffers, p_cam_transform, p_cam_projection, p_cam_orthogonal, (RasterizerScene::InstanceBase **)instance_cull_result, instance_cull_count, light_instance_cull_result, light_cull_count + directional_light_count, reflection_probe_instance_cull_result, reflection_probe_cull_count, gi_probe_instance_cull_result, gi_probe_cull_count, environment, camera_effects, p_shadow_atlas, p_reflection_probe.is_valid() ? RID() : scenario->reflection_atlas, p_reflection_probe, p_reflection_probe_pass);
+	RSG::scene_render->render_scene(p_render_buffers, p_cam_transform, p_cam_projection, p_cam_orthogonal, (RasterizerScene::InstanceBase **)instance_cull_result, instance_cull_count, light_instance_cull_result.ptrw(), light_cull_count + directional_light_count, reflection_probe_instance_cull_result.ptrw(), reflection_probe_cull_count, gi_probe_instance_cull_result.ptrw(), gi_probe_cull_count, environment, camera_effects, p_shadow_atlas, p_reflection_probe.is_valid() ? RID() : scenario->reflection_atlas, p_reflection_probe, p_reflection_probe_pass);
 }
 
 void RenderingServerScene::render_empty_scene(RID p_render_buffers, RID p_scenario, RID p_shadow_atlas) {
@@ -2343,6 +2581,7 @@ void RenderingServerScene::render_probes() {
 	SelfList<InstanceReflectionProbeData> *ref_probe = reflection_probe_render_list.first();
 
 	bool busy = false;
+	int always_steps = 0;
 
 	while (ref_probe) {
 
@@ -2366,14 +2605,17 @@ void RenderingServerScene::render_probes() {
 			} break;
 			case RS::REFLECTION_PROBE_UPDATE_ALWAYS: {
 
-				int step = 0;
+				// steps are shared by all of them, a probe not done keeps its step for the next frame
 				bool done = false;
-				while (!done) {
-					done = _render_reflection_probe_step(ref_probe->self()->owner, step);
-					step++;
+				while (!done && (reflection_probe_steps_per_frame == 0 || always_steps < reflection_probe_steps_per_frame)) {
+					done = _render_reflection_probe_step(ref_probe->self()->owner, ref_probe->self()->render_step);
+					ref_probe->self()->render_step++;
+					always_steps++;
 				}
 
-				reflection_probe_render_list.remove(ref_probe);
+				if (done) {
+					reflection_probe_render_list.remove(ref_probe);
+				}
 			} break;
 		}
 
@@ -2542,36 +2784,38 @@ void RenderingServerScene::render_probes() {
 			update_lights = true;
 		}
 
-		instance_cull_count = 0;
-		for (List<InstanceGIProbeData::PairInfo>::Element *E = probe->dynamic_geometries.front(); E; E = E->next()) {
-			if (instance_cull_count < MAX_INSTANCE_CULL) {
-				Instance *ins = E->get().geometry;
-				if (!ins->visible) {
-					continue;
-				}
-				InstanceGeometryData *geom = (InstanceGeometryData *)ins->base_data;
+		if (gi_probe_update_instances.size() < probe->dynamic_geometries.size()) {
+			gi_probe_update_instances.resize(probe->dynamic_geometries.size());
+		}
 
-				if (geom->gi_probes_dirty) {
-					//giprobes may be dirty, so update
-					int l = 0;
-					//only called when reflection probe AABB enter/exit this geometry
-					ins->gi_probe_instances.resize(geom->gi_probes.size());
+		int update_instance_count = 0;
+		for (List<InstanceGIProbeData::PairInfo>::Element *E = probe->dynamic_geometries.front(); E; E = E->next()) {
+			Instance *ins = E->get().geometry;
+			if (!ins->visible) {
+				continue;
+			}
+			InstanceGeometryData *geom = (InstanceGeometryData *)ins->base_data;
 
-					for (List<Instance *>::Element *F = geom->gi_probes.front(); F; F = F->next()) {
+			if (geom->gi_probes_dirty) {
+				//giprobes may be dirty, so update
+				int l = 0;
+				//only called when reflection probe AABB enter/exit this geometry
+				ins->gi_probe_instances.resize(geom->gi_probes.size());
 
-						InstanceGIProbeData *gi_probe2 = static_cast<InstanceGIProbeData *>(F->get()->base_data);
+				for (List<Instance *>::Element *F = geom->gi_probes.front(); F; F = F->next()) {
 
-						ins->gi_probe_instances.write[l++] = gi_probe2->probe_instance;
-					}
+					InstanceGIProbeData *gi_probe2 = static_cast<InstanceGIProbeData *>(F->get()->base_data);
 
-					geom->gi_probes_dirty = false;
+					ins->gi_probe_instances.write[l++] = gi_probe2->probe_instance;
 				}
 
-				instance_cull_result[instance_cull_count++] = E->get().geometry;
+				geom->gi_probes_dirty = false;
 			}
+
+			gi_probe_update_instances.write[update_instance_count++] = E->get().geometry;
 		}
 
-		RSG::scene_render->gi_probe_update(probe->probe_instance, update_lights, probe->light_instances, instance_cull_count, (RasterizerScene::InstanceBase **)instance_cull_result);
+		RSG::scene_render->gi_probe_update(probe->probe_instance, update_lights, probe->light_instances, update_instance_count, (RasterizerScene::InstanceBase **)gi_probe_update_instances.ptrw());
 
 		gi_probe_update_list.remove(gi_probe);
 
@@ -2749,6 +2993,7 @@ void RenderingServerScene::_update_dirty_instance(Instance *p_instance) {
 				for (List<Instance *>::Element *E = geom->lighting.front(); E; E = E->next()) {
 					InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
 					light->shadow_dirty = true;
+					light->static_shadow_dirty = true;
 				}
 
 				geom->can_cast_shadows = can_cast_shadows;
@@ -2772,10 +3017,76 @@ void RenderingServerScene::_update_dirty_instance(Instance *p_instance) {
 	p_instance->update_dependencies = false;
 }
 
+bool RenderingServerScene::update_interpolation_tick() {
+
+	SelfList<Instance> *E = _instance_interpolation_list.first();
+	while (E) {
+
+		SelfList<Instance> *N = E->next();
+		Instance *instance = E->self();
+
+		//the new tick starts where the last one ended
+		instance->transform_prev = instance->transform_curr;
+
+		if (instance->interpolation_stale) {
+			//resting for a whole tick, transform already reached transform_curr
+			_instance_interpolation_list.remove(E);
+		} else {
+			instance->interpolation_stale = true;
+		}
+
+		E = N;
+	}
+
+	return _instance_interpolation_list.first() != NULL;
+}
+
+void RenderingServerScene::update_interpolation_frame(float p_fraction) {
+
+	for (SelfList<Instance> *E = _instance_interpolation_list.first(); E; E = E->next()) {
+
+		Instance *instance = E->self();
+
+		Transform xform = instance->transform_prev.interpolate_with(instance->transform_curr, p_fraction);
+		if (xform != instance->transform) {
+			instance->transform = xform;
+			_instance_queue_update(instance, true);
+		}
+	}
+}
+
 void RenderingServerScene::update_dirty_instances() {
 
 	RSG::storage->update_dirty_resources();
 
+	shadow_caster_frame++;
+
+	//casters that stopped moving go back into the static shadow layer of their lights
+	SelfList<Instance> *E = _instance_shadow_dynamic_list.first();
+	while (E) {
+
+		SelfList<Instance> *N = E->next();
+		Instance *instance = E->self();
+
+		if (shadow_caster_frame - instance->shadow_dynamic_frame > SHADOW_CASTER_SETTLE_FRAMES) {
+			instance->shadow_dynamic = false;
+			_instance_shadow_dynamic_list.remove(E);
+
+			if ((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
+				InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(instance->base_data);
+				if (geom->can_cast_shadows) {
+					for (List<Instance *>::Element *F = geom->lighting.front(); F; F = F->next()) {
+						InstanceLightData *light = static_cast<InstanceLightData *>(F->get()->base_data);
+						light->shadow_dirty = true;
+						light->static_shadow_dirty = true;
+					}
+				}
+			}
+		}
+
+		E = N;
+	}
+
 	while (_instance_update_list.first()) {
 
 		_update_dirty_instance(_instance_update_list.first()->self());
@@ -2818,6 +3129,8 @@ bool RenderingServerScene::free(RID p_rid) {
 
 		update_dirty_instances(); //in case something changed this
 
+		occlusion_id_free_list.push_back(instance->occlusion_id);
+
 		instance_owner.free(p_rid);
 		memdelete(instance);
 	} else {
@@ -2833,6 +3146,20 @@ RenderingServerScene::RenderingServerScene() {
 
 	render_pass = 1;
 	singleton = this;
+
+	shadow_caster_frame = 0;
+
+	occlusion_id_count = 0;
+	occlusion_generation = 0;
+
+	instance_cull_count = 0;
+	instance_cull_result = NULL;
+	shadow_pass_count = 0;
+	light_cull_count = 0;
+	directional_light_count = 0;
+	reflection_probe_cull_count = 0;
+	gi_probe_cull_count = 0;
+	reflection_probe_steps_per_frame = GLOBAL_GET("rendering/quality/reflections/probe_update_steps_per_frame");
 }
 
 RenderingServerScene::~RenderingServerScene() {
@@ -33,6 +33,7 @@
 
 #include "servers/rendering/rasterizer.h"
 
+#include "core/math/bvh.h"
 #include "core/math/geometry.h"
 #include "core/math/octree.h"
 #include "core/os/semaphore.h"
@@ -45,12 +46,9 @@ class RenderingServerScene {
 public:
 	enum {
 
-		MAX_INSTANCE_CULL = 65536,
-		MAX_LIGHTS_CULLED = 4096,
-		MAX_REFLECTION_PROBES_CULLED = 4096,
-		MAX_GI_PROBES_CULLED = 4096,
 		MAX_ROOM_CULL = 32,
 		MAX_EXTERIOR_PORTALS = 128,
+		SHADOW_CASTER_SETTLE_FRAMES = 30, // frames a caster must rest before it goes back into the static shadow layer
 	};
 
 	uint64_t render_pass;
@@ -107,12 +105,78 @@ public:
 
 	struct Instance;
 
+	/* SPATIAL PARTITIONING */
+
+	typedef uint32_t SpatialPartitionID;
+
+	class SpatialPartitioningScene {
+	public:
+		typedef void *(*PairCallback)(void *, SpatialPartitionID, Instance *, int, SpatialPartitionID, Instance *, int);
+		typedef void (*UnpairCallback)(void *, SpatialPartitionID, Instance *, int, SpatialPartitionID, Instance *, int, void *);
+
+		virtual SpatialPartitionID create(Instance *p_userdata, const AABB &p_aabb = AABB(), int p_subindex = 0, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t p_pairable_mask = 1) = 0;
+		virtual void erase(SpatialPartitionID p_id) = 0;
+		virtual void move(SpatialPartitionID p_id, const AABB &p_aabb) = 0;
+		virtual void set_pairable(SpatialPartitionID p_id, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t p_pairable_mask = 1) = 0;
+
+		virtual int cull_convex(const Vector<Plane> &p_convex, Instance **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF) = 0;
+		virtual int cull_aabb(const AABB &p_aabb, Instance **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF) = 0;
+		virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, Instance **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF) = 0;
+
+		virtual void set_pair_callback(PairCallback p_callback, void *p_userdata) = 0;
+		virtual void set_unpair_callback(UnpairCallback p_callback, void *p_userdata) = 0;
+
+		// whether the cull_* functions can be called from several threads at once
+		virtual bool is_cull_thread_safe() const { return false; }
+
+		virtual ~SpatialPartitioningScene() {}
+	};
+
+	class SpatialPartitioningSceneOctree : public SpatialPartitioningScene {
+
+		Octree<Instance, true> octree;
+
+	public:
+		virtual SpatialPartitionID create(Instance *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) { return octree.create(p_userdata, p_aabb, p_subindex, p_pairable, p_pairable_type, p_pairable_mask); }
+		virtual void erase(SpatialPartitionID p_id) { octree.erase(p_id); }
+		virtual void move(SpatialPartitionID p_id, const AABB &p_aabb) { octree.move(p_id, p_aabb); }
+		virtual void set_pairable(SpatialPartitionID p_id, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) { octree.set_pairable(p_id, p_pairable, p_pairable_type, p_pairable_mask); }
+
+		virtual int cull_convex(const Vector<Plane> &p_convex, Instance **p_result_array, int p_result_max, uint32_t p_mask) { return octree.cull_convex(p_convex, p_result_array, p_result_max, p_mask); }
+		virtual int cull_aabb(const AABB &p_aabb, Instance **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) { return octree.cull_aabb(p_aabb, p_result_array, p_result_max, p_subindex_array, p_mask); }
+		virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, Instance **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) { return octree.cull_segment(p_from, p_to, p_result_array, p_result_max, p_subindex_array, p_mask); }
+
+		virtual void set_pair_callback(PairCallback p_callback, void *p_userdata) { octree.set_pair_callback(p_callback, p_userdata); }
+		virtual void set_unpair_callback(UnpairCallback p_callback, void *p_userdata) { octree.set_unpair_callback(p_callback, p_userdata); }
+	};
+
+	class SpatialPartitioningSceneBVH : public SpatialPartitioningScene {
+
+		BVH<Instance, true> bvh;
+
+	public:
+		virtual SpatialPartitionID create(Instance *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) { return bvh.create(p_userdata, p_aabb, p_subindex, p_pairable, p_pairable_type, p_pairable_mask); }
+		virtual void erase(SpatialPartitionID p_id) { bvh.erase(p_id); }
+		virtual void move(SpatialPartitionID p_id, const AABB &p_aabb) { bvh.move(p_id, p_aabb); }
+		virtual void set_pairable(SpatialPartitionID p_id, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) { bvh.set_pairable(p_id, p_pairable, p_pairable_type, p_pairable_mask); }
+
+		virtual int cull_convex(const Vector<Plane> &p_convex, Instance **p_result_array, int p_result_max, uint32_t p_mask) { return bvh.cull_convex(p_convex, p_result_array, p_result_max, p_mask); }
+		virtual int cull_aabb(const AABB &p_aabb, Instance **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) { return bvh.cull_aabb(p_aabb, p_result_array, p_result_max, p_subindex_array, p_mask); }
+		virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, Instance **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) { return bvh.cull_segment(p_from, p_to, p_result_array, p_result_max, p_subindex_array, p_mask); }
+
+		virtual void set_pair_callback(PairCallback p_callback, void *p_userdata) { bvh.set_pair_callback(p_callback, p_userdata); }
+		virtual void set_unpair_callback(UnpairCallback p_callback, void *p_userdata) { bvh.set_unpair_callback(p_callback, p_userdata); }
+
+		virtual bool is_cull_thread_safe() const { return true; }
+	};
+
 	struct Scenario {
 
 		RS::ScenarioDebugMode debug;
 		RID self;
 
-		Octree<Instance, true> octree;
+		RS::ScenarioSpatialIndex spatial_index;
+		SpatialPartitioningScene *sps;
 
 		List<Instance *> directional_lights;
 		RID environment;
@@ -123,17 +187,29 @@ public:
 
 		SelfList<Instance>::List instances;
 
-		Scenario() { debug = RS::SCENARIO_DEBUG_DISABLED; }
+		Scenario() {
+			debug = RS::SCENARIO_DEBUG_DISABLED;
+			spatial_index = RS::SCENARIO_SPATIAL_INDEX_OCTREE;
+			sps = NULL;
+		}
+		~Scenario() {
+			if (sps) {
+				memdelete(sps);
+			}
+		}
 	};
 
 	mutable RID_PtrOwner<Scenario> scenario_owner;
 
-	static void *_instance_pair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int);
-	static void _instance_unpair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int, void *);
+	static void *_instance_pair(void *p_self, SpatialPartitionID, Instance *p_A, int, SpatialPartitionID, Instance *p_B, int);
+	static void _instance_unpair(void *p_self, SpatialPartitionID, Instance *p_A, int, SpatialPartitionID, Instance *p_B, int, void *);
+
+	SpatialPartitioningScene *_create_spatial_partitioning(RS::ScenarioSpatialIndex p_index);
 
 	virtual RID scenario_create();
 
 	virtual void scenario_set_debug(RID p_scenario, RS::ScenarioDebugMode p_debug_mode);
+	virtual void scenario_set_spatial_index(RID p_scenario, RS::ScenarioSpatialIndex p_index);
 	virtual void scenario_set_environment(RID p_scenario, RID p_environment);
 	virtual void scenario_set_camera_effects(RID p_scenario, RID p_fx);
 	virtual void scenario_set_fallback_environment(RID p_scenario, RID p_environment);
@@ -150,7 +226,7 @@ public:
 
 		RID self;
 		//scenario stuff
-		OctreeElementID octree_id;
+		SpatialPartitionID spatial_partition_id;
 		Scenario *scenario;
 		SelfList<Instance> scenario_item;
 
@@ -160,6 +236,18 @@ public:
 
 		SelfList<Instance> update_item;
 
+		//physics interpolation, transform is blended from transform_prev to transform_curr when drawing
+		bool interpolated;
+		bool interpolation_stale; //not moved since the last tick, leaves the list on the next one
+		Transform transform_curr;
+		Transform transform_prev;
+		SelfList<Instance> interpolation_item;
+
+		//shadow caching, casters that moved recently are drawn over the cached static shadow of a light instead of into it
+		bool shadow_dynamic;
+		uint64_t shadow_dynamic_frame; //last frame it moved
+		SelfList<Instance> shadow_dynamic_item;
+
 		AABB *custom_aabb; // <Zylann> would using aabb directly with a bool be better?
 		float extra_margin;
 		ObjectID object_id;
@@ -193,9 +281,11 @@ public:
 
 		Instance() :
 				scenario_item(this),
-				update_item(this) {
+				update_item(this),
+				interpolation_item(this),
+				shadow_dynamic_item(this) {
 
-			octree_id = 0;
+			spatial_partition_id = 0;
 			scenario = NULL;
 
 			update_aabb = false;
@@ -216,6 +306,12 @@ public:
 			base_data = NULL;
 
 			custom_aabb = NULL;
+
+			interpolated = false;
+			interpolation_stale = false;
+
+			shadow_dynamic = false;
+			shadow_dynamic_frame = 0;
 		}
 
 		~Instance() {
@@ -228,6 +324,9 @@ public:
 	};
 
 	SelfList<Instance>::List _instance_update_list;
+	SelfList<Instance>::List _instance_interpolation_list;
+	SelfList<Instance>::List _instance_shadow_dynamic_list;
+	uint64_t shadow_caster_frame;
 	void _instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_dependencies = false);
 
 	struct InstanceGeometryData : public InstanceBaseData {
@@ -280,6 +379,7 @@ public:
 	};
 
 	SelfList<InstanceReflectionProbeData>::List reflection_probe_render_list;
+	int reflection_probe_steps_per_frame; //for UPDATE_ALWAYS probes, 0 renders them whole every frame
 
 	struct InstanceLightData : public InstanceBaseData {
 
@@ -293,6 +393,8 @@ public:
 		List<Instance *>::Element *D; // directional light in scenario
 
 		bool shadow_dirty;
+		bool static_shadow_dirty; // static casters changed, implies shadow_dirty
+		uint64_t static_version;
 
 		List<PairInfo> geometries;
 
@@ -301,6 +403,8 @@ public:
 		InstanceLightData() {
 
 			shadow_dirty = true;
+			static_shadow_dirty = true;
+			static_version = 0;
 			D = NULL;
 			last_version = 0;
 			baked_light = NULL;
@@ -368,26 +472,110 @@ public:
 		}
 	};
 
+	/* CULLING */
+
+	// A single convex cull, several of them are run in parallel when the spatial index allows it.
+	// The result buffer is kept between frames and grows as needed, so nothing is ever dropped.
+	struct CullJob {
+
+		Scenario *scenario;
+		Vector<Plane> planes;
+		uint32_t mask;
+		bool shadow_casters_only; // keep only visible geometry that casts shadows
+		bool animated_material_found;
+
+		Vector<Instance *> result;
+		int result_count;
+		int static_count; // shadow casters that belong in the cached static layer come first in result
+
+		CullJob() {
+			scenario = NULL;
+			mask = 0xFFFFFFFF;
+			shadow_casters_only = false;
+			animated_material_found = false;
+			result_count = 0;
+			static_count = 0;
+		}
+	};
+
+	// One shadow map render (a directional split, a paraboloid or cube face, or a spot light).
+	// Culling for all passes of a frame happens at once, then each pass is rendered in order.
+	struct ShadowPass {
+
+		Instance *light;
+		int pass;
+		CullJob cull;
+		Plane near_plane;
+
+		CameraMatrix projection;
+		Transform transform;
+		float far;
+		float split;
+		float bias_scale;
+
+		// directional splits fit the far side of the ortho camera to the casters found
+		bool directional;
+		Vector3 x_vec, y_vec, z_vec;
+		float x_min_cam, x_max_cam;
+		float y_min_cam, y_max_cam;
+		float z_min_cam, z_max;
+
+		// omni cube shadows restore the paraboloid transform once all faces are done
+		bool restore_transform;
+
+		ShadowPass() {
+			light = NULL;
+			pass = 0;
+			far = 0;
+			split = 0;
+			bias_scale = 1.0;
+			directional = false;
+			x_min_cam = x_max_cam = 0;
+			y_min_cam = y_max_cam = 0;
+			z_min_cam = z_max = 0;
+			restore_transform = false;
+		}
+	};
+
+	CullJob camera_cull;
 	int instance_cull_count;
-	Instance *instance_cull_result[MAX_INSTANCE_CULL];
-	Instance *instance_shadow_cull_result[MAX_INSTANCE_CULL]; //used for generating shadowmaps
-	Instance *light_cull_result[MAX_LIGHTS_CULLED];
-	RID light_instance_cull_result[MAX_LIGHTS_CULLED];
+	Instance **instance_cull_result;
+
+	Vector<ShadowPass> shadow_passes;
+	int shadow_pass_count;
+	Vector<CullJob *> cull_job_queue;
+
+	Vector<Instance *> light_cull_result;
+	Vector<RID> light_instance_cull_result;
 	int light_cull_count;
 	int directional_light_count;
-	RID reflection_probe_instance_cull_result[MAX_REFLECTION_PROBES_CULLED];
+	Vector<RID> reflection_probe_instance_cull_result;
 	int reflection_probe_cull_count;
-	RID gi_probe_instance_cull_result[MAX_GI_PROBES_CULLED];
+	Vector<RID> gi_probe_instance_cull_result;
 	int gi_probe_cull_count;
 
+	Vector<Instance *> gi_probe_update_instances;
+
+	void _cull_job_process(uint32_t p_index, CullJob **p_jobs);
+	void _cull_jobs_run(Scenario *p_scenario, CullJob **p_jobs, int p_job_count);
+	ShadowPass &_shadow_pass_add(Instance *p_light, int p_pass, Scenario *p_scenario);
+
 	RID_PtrOwner<Instance> instance_owner;
 
+	//occlusion ids are small and reused, so renderers can keep per instance results in flat arrays
+	Vector<uint32_t> occlusion_id_free_list;
+	uint32_t occlusion_id_count;
+	uint32_t occlusion_generation;
+
 	virtual RID instance_create();
 
 	virtual void instance_set_base(RID p_instance, RID p_base);
 	virtual void instance_set_scenario(RID p_instance, RID p_scenario);
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask);
 	virtual void instance_set_transform(RID p_instance, const Transform &p_transform);
+	virtual void instances_set_transform(const Vector<RID> &p_instances, const Vector<Transform> &p_transforms);
+	virtual void instance_set_interpolated(RID p_instance, bool p_interpolated);
+	virtual void instance_reset_physics_interpolation(RID p_instance);
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id);
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight);
 	virtual void instance_set_surface_material(RID p_instance, int p_surface, RID p_material);
@@ -418,7 +606,8 @@ public:
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
 
-	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario);
+	void _light_instance_setup_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, Scenario *p_scenario, bool p_caster_range_found, float p_caster_z_min, float p_caster_z_max);
+	void _shadow_pass_render(ShadowPass &p_pass, RID p_shadow_atlas);
 
 	bool _render_reflection_probe_step(Instance *p_instance, int p_step);
 	void _prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, RID p_force_camera_effects, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, bool p_using_shadows = true);
@@ -429,6 +618,9 @@ public:
 	void render_camera(RID p_render_buffers, Ref<ARVRInterface> &p_interface, ARVRInterface::Eyes p_eye, RID p_camera, RID p_scenario, Size2 p_viewport_size, RID p_shadow_atlas);
 	void update_dirty_instances();
 
+	bool update_interpolation_tick(); //returns true if anything still has to be interpolated
+	void update_interpolation_frame(float p_fraction);
+
 	void render_probes();
 
 	bool free(RID p_rid);
@@ -79,6 +79,73 @@ void RenderingServerViewport::_draw_3d(Viewport *p_viewport, ARVRInterface::Eyes
 	RENDER_TIMESTAMP("<End Rendering 3D Scene");
 }
 
+Size2i RenderingServerViewport::_viewport_get_render_size(Viewport *p_viewport) const {
+
+	float scale = p_viewport->dynamic_resolution.scale;
+	if (scale >= 1.0) {
+		return p_viewport->size;
+	}
+	return Size2i(MAX(1, int(p_viewport->size.width * scale)), MAX(1, int(p_viewport->size.height * scale)));
+}
+
+void RenderingServerViewport::_viewport_configure_render_buffers(Viewport *p_viewport) {
+
+	Size2i render_size = _viewport_get_render_size(p_viewport);
+	RSG::scene_render->render_buffers_configure(p_viewport->render_buffers, p_viewport->render_target, render_size.width, render_size.height, p_viewport->msaa);
+}
+
+void RenderingServerViewport::_viewport_update_dynamic_resolution(Viewport *p_viewport) {
+
+	Viewport::DynamicResolution &dr = p_viewport->dynamic_resolution;
+
+	//results arrive a few frames late, and only once per frame
+	uint64_t frame = RSG::storage->get_captured_timestamps_frame();
+	if (frame == dr.measured_frame || frame < dr.change_frame) {
+		return; //nothing new, or still measuring the previous size
+	}
+	dr.measured_frame = frame;
+
+	uint64_t begin = 0;
+	uint64_t end = 0;
+	for (uint32_t i = 0; i < RSG::storage->get_captured_timestamps_count(); i++) {
+		String name = RSG::storage->get_captured_timestamp_name(i);
+		if (name == dr.begin_timestamp) {
+			begin = RSG::storage->get_captured_timestamp_gpu_time(i);
+		} else if (name == dr.end_timestamp) {
+			end = RSG::storage->get_captured_timestamp_gpu_time(i);
+		}
+	}
+
+	if (begin == 0 || end <= begin) {
+		return; //not drawn in that frame (or timestamps not supported)
+	}
+
+	float time = double(end - begin) / 1000000.0; //nsec -> msec
+	dr.gpu_time = dr.samples == 0 ? time : Math::lerp(dr.gpu_time, time, 0.2f);
+	dr.samples++;
+	if (dr.samples < 4) {
+		return; //let it settle
+	}
+
+	//GPU time is mostly proportional to the pixel count, grow only when there is clear headroom so it does not bounce back and forth
+	const float step = 0.05;
+	float goal = dr.gpu_time > dr.target_frame_time ? dr.target_frame_time : dr.target_frame_time * 0.9;
+	float scale = Math::floor(dr.scale * Math::sqrt(goal / dr.gpu_time) / step) * step;
+	scale = CLAMP(scale, dr.min_scale, dr.max_scale);
+
+	if (dr.gpu_time > dr.target_frame_time ? scale >= dr.scale : scale <= dr.scale) {
+		return;
+	}
+
+	dr.scale = scale;
+	dr.gpu_time = 0.0;
+	dr.samples = 0;
+	dr.change_frame = Engine::get_singleton()->get_frames_drawn();
+	if (p_viewport->render_buffers.is_valid()) {
+		_viewport_configure_render_buffers(p_viewport);
+	}
+}
+
 void RenderingServerViewport::_draw_viewport(Viewport *p_viewport, ARVRInterface::Eyes p_eye) {
 
 	/* Camera should always be BEFORE any other 3D */
@@ -113,7 +180,7 @@ void RenderingServerViewport::_draw_viewport(Viewport *p_viewport, ARVRInterface
 	if ((scenario_draw_canvas_bg || can_draw_3d) && !p_viewport->render_buffers.is_valid()) {
 		//wants to draw 3D but there is no render buffer, create
 		p_viewport->render_buffers = RSG::scene_render->render_buffers_create();
-		RSG::scene_render->render_buffers_configure(p_viewport->render_buffers, p_viewport->render_target, p_viewport->size.width, p_viewport->size.height, p_viewport->msaa);
+		_viewport_configure_render_buffers(p_viewport);
 	}
 
 	RSG::storage->render_target_request_clear(p_viewport->render_target, bgcolor);
@@ -407,9 +474,18 @@ void RenderingServerViewport::draw_viewports() {
 			RSG::scene_render->set_debug_draw_mode(vp->debug_draw);
 			RSG::storage->render_info_begin_capture();
 
+			if (vp->dynamic_resolution.enabled) {
+				_viewport_update_dynamic_resolution(vp);
+				RSG::storage->capture_timestamp(vp->dynamic_resolution.begin_timestamp);
+			}
+
 			// render standard mono camera
 			_draw_viewport(vp);
 
+			if (vp->dynamic_resolution.enabled) {
+				RSG::storage->capture_timestamp(vp->dynamic_resolution.end_timestamp);
+			}
+
 			RSG::storage->render_info_end_capture();
 			vp->render_info[RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME] = RSG::storage->get_captured_render_info(RS::INFO_OBJECTS_IN_FRAME);
 			vp->render_info[RS::VIEWPORT_RENDER_INFO_VERTICES_IN_FRAME] = RSG::storage->get_captured_render_info(RS::INFO_VERTICES_IN_FRAME);
@@ -491,7 +567,7 @@ void RenderingServerViewport::viewport_set_size(RID p_viewport, int p_width, int
 			RSG::scene_render->free(viewport->render_buffers);
 			viewport->render_buffers = RID();
 		} else {
-			RSG::scene_render->render_buffers_configure(viewport->render_buffers, viewport->render_target, viewport->size.width, viewport->size.height, viewport->msaa);
+			_viewport_configure_render_buffers(viewport);
 		}
 	}
 }
@@ -721,10 +797,46 @@ void RenderingServerViewport::viewport_set_msaa(RID p_viewport, RS::ViewportMSAA
 	}
 	viewport->msaa = p_msaa;
 	if (viewport->render_buffers.is_valid()) {
-		RSG::scene_render->render_buffers_configure(viewport->render_buffers, viewport->render_target, viewport->size.width, viewport->size.height, p_msaa);
+		_viewport_configure_render_buffers(viewport);
 	}
 }
 
+void RenderingServerViewport::viewport_set_dynamic_resolution(RID p_viewport, bool p_enabled, float p_target_frame_time, float p_min_scale, float p_max_scale) {
+
+	Viewport *viewport = viewport_owner.getornull(p_viewport);
+	ERR_FAIL_COND(!viewport);
+	ERR_FAIL_COND(p_target_frame_time <= 0.0);
+
+	Viewport::DynamicResolution &dr = viewport->dynamic_resolution;
+	dr.enabled = p_enabled;
+	dr.target_frame_time = p_target_frame_time;
+	dr.max_scale = CLAMP(p_max_scale, 0.1, 1.0);
+	dr.min_scale = CLAMP(p_min_scale, 0.1, dr.max_scale);
+	dr.begin_timestamp = "Viewport " + itos(p_viewport.get_id()) + " Begin";
+	dr.end_timestamp = "Viewport " + itos(p_viewport.get_id()) + " End";
+
+	float scale = p_enabled ? CLAMP(dr.scale, dr.min_scale, dr.max_scale) : 1.0;
+	dr.gpu_time = 0.0;
+	dr.samples = 0;
+	dr.change_frame = Engine::get_singleton()->get_frames_drawn();
+
+	if (scale != dr.scale) {
+		dr.scale = scale;
+		if (viewport->render_buffers.is_valid()) {
+			_viewport_configure_render_buffers(viewport);
+		}
+	}
+}
+
+float RenderingServerViewport::viewport_get_render_scale(RID p_viewport) {
+
+	Viewport *viewport = viewport_owner.getornull(p_viewport);
+	if (!viewport)
+		return 1.0; //there should be a lock here..
+
+	return viewport->dynamic_resolution.scale;
+}
+
 int RenderingServerViewport::viewport_get_render_info(RID p_viewport, RS::ViewportRenderInfo p_info) {
 
 	ERR_FAIL_INDEX_V(p_info, RS::VIEWPORT_RENDER_INFO_MAX, -1);
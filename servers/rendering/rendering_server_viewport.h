@@ -60,6 +60,22 @@ public:
 
 		RS::ViewportMSAA msaa;
 
+		//3D is rendered at a fraction of the size, adjusted to keep the GPU time of the viewport close to the target
+		struct DynamicResolution {
+			bool enabled = false;
+			float target_frame_time = 16.667; //msec
+			float min_scale = 0.5;
+			float max_scale = 1.0;
+			float scale = 1.0;
+
+			float gpu_time = 0.0; //msec, smoothed
+			int samples = 0;
+			uint64_t measured_frame = 0;
+			uint64_t change_frame = 0;
+			String begin_timestamp;
+			String end_timestamp;
+		} dynamic_resolution;
+
 		DisplayServer::WindowID viewport_to_screen;
 		Rect2 viewport_to_screen_rect;
 		bool viewport_render_direct_to_screen;
@@ -155,6 +171,10 @@ private:
 	void _draw_3d(Viewport *p_viewport, ARVRInterface::Eyes p_eye);
 	void _draw_viewport(Viewport *p_viewport, ARVRInterface::Eyes p_eye = ARVRInterface::EYE_MONO);
 
+	Size2i _viewport_get_render_size(Viewport *p_viewport) const;
+	void _viewport_configure_render_buffers(Viewport *p_viewport);
+	void _viewport_update_dynamic_resolution(Viewport *p_viewport);
+
 public:
 	RID viewport_create();
 
@@ -192,6 +212,8 @@ public:
 	void viewport_set_shadow_atlas_quadrant_subdivision(RID p_viewport, int p_quadrant, int p_subdiv);
 
 	void viewport_set_msaa(RID p_viewport, RS::ViewportMSAA p_msaa);
+	void viewport_set_dynamic_resolution(RID p_viewport, bool p_enabled, float p_target_frame_time, float p_min_scale, float p_max_scale);
+	virtual float viewport_get_render_scale(RID p_viewport);
 
 	virtual int viewport_get_render_info(RID p_viewport, RS::ViewportRenderInfo p_info);
 	virtual void viewport_set_debug_draw(RID p_viewport, RS::ViewportDebugDraw p_draw);
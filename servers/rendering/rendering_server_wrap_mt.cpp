@@ -29,6 +29,7 @@
 /*************************************************************************/
 
 #include "rendering_server_wrap_mt.h"
+#include "core/debugger/profiling_zones.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
 #include "servers/display_server.h"
@@ -62,6 +63,10 @@ void RenderingServerWrapMT::thread_loop() {
 
 	server_thread = Thread::get_caller_id();
 
+#ifdef DEBUG_ENABLED
+	ProfilingZones::set_thread_name("Rendering");
+#endif
+
 	DisplayServer::get_singleton()->make_rendering_thread();
 
 	rendering_server->init();
@@ -70,7 +75,7 @@ void RenderingServerWrapMT::thread_loop() {
 	draw_thread_up = true;
 	while (!exit) {
 		// flush commands one by one, until exit is requested
-		command_queue.wait_and_flush_one();
+		command_queue.wait_and_flush();
 	}
 
 	command_queue.flush_all(); // flush all
@@ -98,6 +103,12 @@ void RenderingServerWrapMT::draw(bool p_swap_buffers, double frame_step) {
 
 		atomic_increment(&draw_pending);
 		command_queue.push(this, &RenderingServerWrapMT::thread_draw, p_swap_buffers, frame_step);
+
+		if (frame_batch_open) {
+			// publish the frame, and start collecting the next one
+			command_queue.end_batch();
+			command_queue.begin_batch();
+		}
 	} else {
 
 		rendering_server->draw(p_swap_buffers, frame_step);
@@ -118,6 +129,11 @@ void RenderingServerWrapMT::init() {
 			OS::get_singleton()->delay_usec(1000);
 		}
 		print_verbose("RenderingServerWrapMT: Finished render thread");
+
+		if (batch_frame_commands) {
+			command_queue.begin_batch();
+			frame_batch_open = true;
+		}
 	} else {
 
 		rendering_server->init();
@@ -128,6 +144,10 @@ void RenderingServerWrapMT::finish() {
 
 	if (thread) {
 
+		if (frame_batch_open) {
+			command_queue.end_batch();
+			frame_batch_open = false;
+		}
 		command_queue.push(this, &RenderingServerWrapMT::thread_exit);
 		Thread::wait_to_finish(thread);
 		memdelete(thread);
@@ -159,6 +179,7 @@ void RenderingServerWrapMT::finish() {
 	instance_free_cached_ids();
 	canvas_free_cached_ids();
 	canvas_item_free_cached_ids();
+	canvas_light_free_cached_ids();
 	canvas_light_occluder_free_cached_ids();
 	canvas_occluder_polygon_free_cached_ids();
 }
@@ -182,6 +203,8 @@ RenderingServerWrapMT::RenderingServerWrapMT(RenderingServer *p_contained, bool
 	draw_pending = 0;
 	draw_thread_up = false;
 	pool_max_size = GLOBAL_GET("memory/limits/multithreaded_server/rid_pool_prealloc");
+	batch_frame_commands = GLOBAL_DEF("rendering/threads/batch_main_thread_commands", false);
+	frame_batch_open = false;
 
 	if (!p_create_thread) {
 		server_thread = Thread::get_caller_id();
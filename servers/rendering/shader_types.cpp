@@ -45,6 +45,25 @@ const Set<String> &ShaderTypes::get_types() {
 }
 
 ShaderTypes *ShaderTypes::singleton = NULL;
+Mutex ShaderTypes::singleton_mutex;
+
+ShaderTypes *ShaderTypes::get_singleton() {
+
+	MutexLock lock(singleton_mutex);
+	if (!singleton) {
+		memnew(ShaderTypes);
+	}
+	return singleton;
+}
+
+void ShaderTypes::finish() {
+
+	MutexLock lock(singleton_mutex);
+	if (singleton) {
+		memdelete(singleton);
+		singleton = NULL;
+	}
+}
 
 static ShaderLanguage::BuiltInInfo constt(ShaderLanguage::DataType p_type) {
 
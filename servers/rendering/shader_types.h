@@ -32,6 +32,7 @@
 #define SHADERTYPES_H
 
 #include "core/ordered_hash_map.h"
+#include "core/os/mutex.h"
 #include "servers/rendering_server.h"
 #include "shader_language.h"
 
@@ -46,11 +47,13 @@ class ShaderTypes {
 	Map<RS::ShaderMode, Type> shader_modes;
 
 	static ShaderTypes *singleton;
+	static Mutex singleton_mutex;
 
 	Set<String> shader_types;
 
 public:
-	static ShaderTypes *get_singleton() { return singleton; }
+	static ShaderTypes *get_singleton(); //created on first use, only shader compilation needs it
+	static void finish();
 
 	const Map<StringName, ShaderLanguage::FunctionInfo> &get_functions(RS::ShaderMode p_mode);
 	const Vector<StringName> &get_modes(RS::ShaderMode p_mode);
@@ -112,6 +112,93 @@ Array RenderingServer::_instances_cull_convex_bind(const Array &p_convex, RID p_
 	return to_array(ids);
 }
 
+Vector<RenderingServer::FrameProfileTime> RenderingServer::get_frame_profile_times() {
+
+	Vector<FrameProfileArea> areas = get_frame_profile();
+	Vector<FrameProfileTime> times;
+	Vector<int> open_scopes;
+
+	for (int i = 0; i < areas.size(); i++) {
+
+		const String &name = areas[i].name;
+
+		if (name.begins_with("<")) {
+			ERR_CONTINUE(open_scopes.empty());
+			FrameProfileTime &scope = times.write[open_scopes[open_scopes.size() - 1]];
+			scope.gpu_msec = areas[i].gpu_msec - scope.gpu_msec;
+			scope.cpu_msec = areas[i].cpu_msec - scope.cpu_msec;
+			open_scopes.resize(open_scopes.size() - 1);
+			continue;
+		}
+
+		FrameProfileTime t;
+		t.depth = open_scopes.size();
+
+		if (name.begins_with(">")) {
+			//holds the start time until the scope is closed
+			t.name = name.substr(1, name.length());
+			t.gpu_msec = areas[i].gpu_msec;
+			t.cpu_msec = areas[i].cpu_msec;
+			open_scopes.push_back(times.size());
+		} else {
+			//lasts until the next timestamp
+			t.name = name;
+			t.gpu_msec = i + 1 < areas.size() ? areas[i + 1].gpu_msec - areas[i].gpu_msec : 0;
+			t.cpu_msec = i + 1 < areas.size() ? areas[i + 1].cpu_msec - areas[i].cpu_msec : 0;
+		}
+
+		times.push_back(t);
+	}
+
+	//scopes left open have no end time
+	for (int i = 0; i < open_scopes.size(); i++) {
+		times.write[open_scopes[i]].gpu_msec = 0;
+		times.write[open_scopes[i]].cpu_msec = 0;
+	}
+
+	return times;
+}
+
+float RenderingServer::get_frame_profile_area_gpu_msec(const String &p_area) {
+
+	Vector<FrameProfileTime> times = get_frame_profile_times();
+	float total = 0;
+	for (int i = 0; i < times.size(); i++) {
+		if (times[i].name == p_area) {
+			total += times[i].gpu_msec;
+		}
+	}
+	return total;
+}
+
+float RenderingServer::get_frame_profile_area_cpu_msec(const String &p_area) {
+
+	Vector<FrameProfileTime> times = get_frame_profile_times();
+	float total = 0;
+	for (int i = 0; i < times.size(); i++) {
+		if (times[i].name == p_area) {
+			total += times[i].cpu_msec;
+		}
+	}
+	return total;
+}
+
+Array RenderingServer::_get_frame_profile_times_bind() {
+
+	Vector<FrameProfileTime> times = get_frame_profile_times();
+	Array ret;
+	ret.resize(times.size());
+	for (int i = 0; i < times.size(); i++) {
+		Dictionary d;
+		d["name"] = times[i].name;
+		d["depth"] = times[i].depth;
+		d["gpu_msec"] = times[i].gpu_msec;
+		d["cpu_msec"] = times[i].cpu_msec;
+		ret[i] = d;
+	}
+	return ret;
+}
+
 RID RenderingServer::get_test_texture() {
 
 	if (test_texture.is_valid()) {
@@ -329,6 +416,41 @@ RID RenderingServer::get_white_texture() {
 #define SMALL_VEC2 Vector2(0.00001, 0.00001)
 #define SMALL_VEC3 Vector3(0.00001, 0.00001, 0.00001)
 
+//octahedral encoding, maps unit vectors to the -1..1 square
+static Vector2 _vec3_to_oct(const Vector3 &p_vec) {
+
+	float l = Math::abs(p_vec.x) + Math::abs(p_vec.y) + Math::abs(p_vec.z);
+	if (l == 0) {
+		return Vector2();
+	}
+
+	Vector3 n = p_vec / l;
+	if (n.z >= 0) {
+		return Vector2(n.x, n.y);
+	}
+
+	return Vector2((1.0 - Math::abs(n.y)) * (n.x >= 0 ? 1.0 : -1.0), (1.0 - Math::abs(n.x)) * (n.y >= 0 ? 1.0 : -1.0));
+}
+
+static Vector3 _oct_to_vec3(const Vector2 &p_oct) {
+
+	Vector3 v(p_oct.x, p_oct.y, 1.0 - Math::abs(p_oct.x) - Math::abs(p_oct.y));
+	float t = MAX(-v.z, 0.0);
+	v.x += v.x >= 0 ? -t : t;
+	v.y += v.y >= 0 ? -t : t;
+	return v.normalized();
+}
+
+static _FORCE_INLINE_ int16_t _float_to_snorm16(float p_value) {
+
+	return int16_t(CLAMP(Math::round(p_value * 32767.0), -32767.0, 32767.0));
+}
+
+static _FORCE_INLINE_ float _snorm16_to_float(int16_t p_value) {
+
+	return MAX(p_value / 32767.0, -1.0);
+}
+
 Error RenderingServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint32_t *p_offsets, uint32_t p_stride, Vector<uint8_t> &r_vertex_array, int p_vertex_array_len, Vector<uint8_t> &r_index_array, int p_index_array_len, AABB &r_aabb, Vector<AABB> &r_bone_aabb) {
 
 	uint8_t *vw = r_vertex_array.ptrw();
@@ -387,20 +509,44 @@ Error RenderingServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint
 					// setting vertices means regenerating the AABB
 					AABB aabb;
 
-					{
+					for (int i = 0; i < p_vertex_array_len; i++) {
+
+						if (i == 0) {
+
+							aabb = AABB(src[i], SMALL_VEC3);
+						} else {
+
+							aabb.expand_to(src[i]);
+						}
+					}
+
+					if (p_format & ARRAY_COMPRESS_VERTEX) {
+
+						//quantized inside the AABB, the renderer gets it to decode them
+						Vector3 scale;
+						for (int j = 0; j < 3; j++) {
+							scale[j] = aabb.size[j] > 0 ? 65535.0 / aabb.size[j] : 0.0;
+						}
+
 						for (int i = 0; i < p_vertex_array_len; i++) {
 
-							float vector[3] = { src[i].x, src[i].y, src[i].z };
+							Vector3 pos = (src[i] - aabb.position) * scale;
+							uint16_t vector[4] = {
+								(uint16_t)CLAMP(Math::round(pos.x), 0, 65535),
+								(uint16_t)CLAMP(Math::round(pos.y), 0, 65535),
+								(uint16_t)CLAMP(Math::round(pos.z), 0, 65535),
+								0,
+							};
 
-							copymem(&vw[p_offsets[ai] + i * p_stride], vector, sizeof(float) * 3);
+							copymem(&vw[p_offsets[ai] + i * p_stride], vector, sizeof(uint16_t) * 4);
+						}
+					} else {
 
-							if (i == 0) {
+						for (int i = 0; i < p_vertex_array_len; i++) {
 
-								aabb = AABB(src[i], SMALL_VEC3);
-							} else {
+							float vector[3] = { src[i].x, src[i].y, src[i].z };
 
-								aabb.expand_to(src[i]);
-							}
+							copymem(&vw[p_offsets[ai] + i * p_stride], vector, sizeof(float) * 3);
 						}
 					}
 
@@ -419,7 +565,17 @@ Error RenderingServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint
 
 				// setting vertices means regenerating the AABB
 
-				if (p_format & ARRAY_COMPRESS_NORMAL) {
+				if ((p_format & ARRAY_COMPRESS_NORMAL) && (p_format & ARRAY_FLAG_USE_OCTAHEDRAL_COMPRESSION)) {
+
+					for (int i = 0; i < p_vertex_array_len; i++) {
+
+						Vector2 oct = _vec3_to_oct(src[i]);
+						int16_t vector[2] = { _float_to_snorm16(oct.x), _float_to_snorm16(oct.y) };
+
+						copymem(&vw[p_offsets[ai] + i * p_stride], vector, 4);
+					}
+
+				} else if (p_format & ARRAY_COMPRESS_NORMAL) {
 
 					for (int i = 0; i < p_vertex_array_len; i++) {
 
@@ -453,7 +609,19 @@ Error RenderingServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint
 
 				const real_t *src = array.ptr();
 
-				if (p_format & ARRAY_COMPRESS_TANGENT) {
+				if ((p_format & ARRAY_COMPRESS_TANGENT) && (p_format & ARRAY_FLAG_USE_OCTAHEDRAL_COMPRESSION)) {
+
+					for (int i = 0; i < p_vertex_array_len; i++) {
+
+						//y is remapped to 0.5-1 so it can hold the binormal sign, even when zero
+						Vector2 oct = _vec3_to_oct(Vector3(src[i * 4 + 0], src[i * 4 + 1], src[i * 4 + 2]));
+						float y = (oct.y * 0.5 + 0.5) * 0.5 + 0.5;
+						int16_t xy[2] = { _float_to_snorm16(oct.x), _float_to_snorm16(src[i * 4 + 3] < 0 ? -y : y) };
+
+						copymem(&vw[p_offsets[ai] + i * p_stride], xy, 4);
+					}
+
+				} else if (p_format & ARRAY_COMPRESS_TANGENT) {
 
 					for (int i = 0; i < p_vertex_array_len; i++) {
 						int8_t xyzw[4] = {
@@ -749,6 +917,10 @@ uint32_t RenderingServer::mesh_surface_make_offsets_from_format(uint32_t p_forma
 					elem_size = 8;
 				}
 
+				if ((p_format & ARRAY_COMPRESS_VERTEX) && !(p_format & ARRAY_FLAG_USE_2D_VERTICES)) {
+					elem_size = sizeof(uint16_t) * 4;
+				}
+
 			} break;
 			case RS::ARRAY_NORMAL: {
 
@@ -918,7 +1090,14 @@ Error RenderingServer::mesh_create_surface_data_from_arrays(SurfaceData *r_surfa
 					elem_size = (p_compress_format & ARRAY_FLAG_USE_2D_VERTICES) ? 2 : 3;
 				}
 
-				{
+				if ((p_compress_format & ARRAY_FLAG_USE_2D_VERTICES) || p_blend_shapes.size()) {
+					//blend shapes would need to share the quantization of the base vertices
+					p_compress_format &= ~ARRAY_COMPRESS_VERTEX;
+				}
+
+				if (p_compress_format & ARRAY_COMPRESS_VERTEX) {
+					elem_size = sizeof(uint16_t) * 4;
+				} else {
 					elem_size *= sizeof(float);
 				}
 
@@ -1041,6 +1220,7 @@ Error RenderingServer::mesh_create_surface_data_from_arrays(SurfaceData *r_surfa
 
 		List<Variant> keys;
 		p_lods.get_key_list(&keys);
+		keys.sort(); //the renderer expects them from finest to coarsest
 		for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
 			float distance = E->get();
 			ERR_CONTINUE(distance <= 0.0);
@@ -1102,7 +1282,7 @@ void RenderingServer::mesh_add_surface_from_arrays(RID p_mesh, PrimitiveType p_p
 	mesh_add_surface(p_mesh, sd);
 }
 
-Array RenderingServer::_get_array_from_surface(uint32_t p_format, Vector<uint8_t> p_vertex_data, int p_vertex_len, Vector<uint8_t> p_index_data, int p_index_len) const {
+Array RenderingServer::_get_array_from_surface(uint32_t p_format, Vector<uint8_t> p_vertex_data, int p_vertex_len, Vector<uint8_t> p_index_data, int p_index_len, const AABB &p_aabb) const {
 
 	uint32_t offsets[ARRAY_MAX];
 
@@ -1127,7 +1307,9 @@ Array RenderingServer::_get_array_from_surface(uint32_t p_format, Vector<uint8_t
 					elem_size = 3;
 				}
 
-				{
+				if ((p_format & ARRAY_COMPRESS_VERTEX) && !(p_format & ARRAY_FLAG_USE_2D_VERTICES)) {
+					elem_size = sizeof(uint16_t) * 4;
+				} else {
 					elem_size *= sizeof(float);
 				}
 
@@ -1247,7 +1429,17 @@ Array RenderingServer::_get_array_from_surface(uint32_t p_format, Vector<uint8_t
 					Vector<Vector3> arr_3d;
 					arr_3d.resize(p_vertex_len);
 
-					{
+					if (p_format & ARRAY_COMPRESS_VERTEX) {
+
+						Vector3 *w = arr_3d.ptrw();
+						Vector3 scale = p_aabb.size / 65535.0;
+
+						for (int j = 0; j < p_vertex_len; j++) {
+
+							const uint16_t *v = (const uint16_t *)&r[j * total_elem_size + offsets[i]];
+							w[j] = p_aabb.position + Vector3(v[0], v[1], v[2]) * scale;
+						}
+					} else {
 
 						Vector3 *w = arr_3d.ptrw();
 
@@ -1266,7 +1458,16 @@ Array RenderingServer::_get_array_from_surface(uint32_t p_format, Vector<uint8_t
 				Vector<Vector3> arr;
 				arr.resize(p_vertex_len);
 
-				if (p_format & ARRAY_COMPRESS_NORMAL) {
+				if ((p_format & ARRAY_COMPRESS_NORMAL) && (p_format & ARRAY_FLAG_USE_OCTAHEDRAL_COMPRESSION)) {
+
+					Vector3 *w = arr.ptrw();
+
+					for (int j = 0; j < p_vertex_len; j++) {
+
+						const int16_t *v = (const int16_t *)&r[j * total_elem_size + offsets[i]];
+						w[j] = _oct_to_vec3(Vector2(_snorm16_to_float(v[0]), _snorm16_to_float(v[1])));
+					}
+				} else if (p_format & ARRAY_COMPRESS_NORMAL) {
 
 					Vector3 *w = arr.ptrw();
 					const float multiplier = 1.f / 127.f;
@@ -1293,7 +1494,20 @@ Array RenderingServer::_get_array_from_surface(uint32_t p_format, Vector<uint8_t
 			case RS::ARRAY_TANGENT: {
 				Vector<float> arr;
 				arr.resize(p_vertex_len * 4);
-				if (p_format & ARRAY_COMPRESS_TANGENT) {
+				if ((p_format & ARRAY_COMPRESS_TANGENT) && (p_format & ARRAY_FLAG_USE_OCTAHEDRAL_COMPRESSION)) {
+					float *w = arr.ptrw();
+
+					for (int j = 0; j < p_vertex_len; j++) {
+
+						const int16_t *v = (const int16_t *)&r[j * total_elem_size + offsets[i]];
+						float y = _snorm16_to_float(v[1]);
+						Vector3 tangent = _oct_to_vec3(Vector2(_snorm16_to_float(v[0]), Math::abs(y) * 4.0 - 3.0));
+						w[j * 4 + 0] = tangent.x;
+						w[j * 4 + 1] = tangent.y;
+						w[j * 4 + 2] = tangent.z;
+						w[j * 4 + 3] = y < 0 ? -1.0 : 1.0;
+					}
+				} else if (p_format & ARRAY_COMPRESS_TANGENT) {
 					float *w = arr.ptrw();
 
 					for (int j = 0; j < p_vertex_len; j++) {
@@ -1494,7 +1708,7 @@ Dictionary RenderingServer::mesh_surface_get_lods(RID p_mesh, int p_surface) con
 			const uint16_t *rptr = (const uint16_t *)r;
 			int *w = lods.ptrw();
 			for (uint32_t j = 0; j < lc; j++) {
-				w[j] = rptr[i];
+				w[j] = rptr[j];
 			}
 		} else {
 			uint32_t lc = sd.lods[i].index_data.size() / 4;
@@ -1503,7 +1717,7 @@ Dictionary RenderingServer::mesh_surface_get_lods(RID p_mesh, int p_surface) con
 			const uint32_t *rptr = (const uint32_t *)r;
 			int *w = lods.ptrw();
 			for (uint32_t j = 0; j < lc; j++) {
-				w[j] = rptr[i];
+				w[j] = rptr[j];
 			}
 		}
 
@@ -1531,7 +1745,7 @@ Array RenderingServer::mesh_surface_get_blend_shape_arrays(RID p_mesh, int p_sur
 		Array blend_shape_array;
 		blend_shape_array.resize(blend_shape_data.size());
 		for (int i = 0; i < blend_shape_data.size(); i++) {
-			blend_shape_array.set(i, _get_array_from_surface(format, blend_shape_data[i], vertex_len, index_data, index_len));
+			blend_shape_array.set(i, _get_array_from_surface(format, blend_shape_data[i], vertex_len, index_data, index_len, sd.aabb));
 		}
 
 		return blend_shape_array;
@@ -1552,7 +1766,7 @@ Array RenderingServer::mesh_create_arrays_from_surface_data(const SurfaceData &p
 
 	uint32_t format = p_data.format;
 
-	return _get_array_from_surface(format, vertex_data, vertex_len, index_data, index_len);
+	return _get_array_from_surface(format, vertex_data, vertex_len, index_data, index_len, p_data.aabb);
 }
 #if 0
 Array RenderingServer::_mesh_surface_get_skeleton_aabb_bind(RID p_mesh, int p_surface) const {
@@ -1631,6 +1845,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("multimesh_set_visible_instances", "multimesh", "visible"), &RenderingServer::multimesh_set_visible_instances);
 	ClassDB::bind_method(D_METHOD("multimesh_get_visible_instances", "multimesh"), &RenderingServer::multimesh_get_visible_instances);
 	ClassDB::bind_method(D_METHOD("multimesh_set_buffer", "multimesh", "buffer"), &RenderingServer::multimesh_set_buffer);
+	ClassDB::bind_method(D_METHOD("multimesh_set_buffer_range", "multimesh", "first_instance", "buffer"), &RenderingServer::multimesh_set_buffer_range);
 	ClassDB::bind_method(D_METHOD("multimesh_get_buffer", "multimesh"), &RenderingServer::multimesh_get_buffer);
 #ifndef _3D_DISABLED
 	ClassDB::bind_method(D_METHOD("immediate_create"), &RenderingServer::immediate_create);
@@ -1652,6 +1867,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("skeleton_allocate", "skeleton", "bones", "is_2d_skeleton"), &RenderingServer::skeleton_allocate, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("skeleton_get_bone_count", "skeleton"), &RenderingServer::skeleton_get_bone_count);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_set_transform", "skeleton", "bone", "transform"), &RenderingServer::skeleton_bone_set_transform);
+	ClassDB::bind_method(D_METHOD("skeleton_set_bone_transforms", "skeleton", "buffer"), &RenderingServer::skeleton_set_bone_transforms);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_get_transform", "skeleton", "bone"), &RenderingServer::skeleton_bone_get_transform);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_set_transform_2d", "skeleton", "bone", "transform"), &RenderingServer::skeleton_bone_set_transform_2d);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_get_transform_2d", "skeleton", "bone"), &RenderingServer::skeleton_bone_get_transform_2d);
@@ -1790,6 +2006,8 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("viewport_set_shadow_atlas_size", "viewport", "size"), &RenderingServer::viewport_set_shadow_atlas_size);
 	ClassDB::bind_method(D_METHOD("viewport_set_shadow_atlas_quadrant_subdivision", "viewport", "quadrant", "subdivision"), &RenderingServer::viewport_set_shadow_atlas_quadrant_subdivision);
 	ClassDB::bind_method(D_METHOD("viewport_set_msaa", "viewport", "msaa"), &RenderingServer::viewport_set_msaa);
+	ClassDB::bind_method(D_METHOD("viewport_set_dynamic_resolution", "viewport", "enabled", "target_frame_time", "min_scale", "max_scale"), &RenderingServer::viewport_set_dynamic_resolution);
+	ClassDB::bind_method(D_METHOD("viewport_get_render_scale", "viewport"), &RenderingServer::viewport_get_render_scale);
 	ClassDB::bind_method(D_METHOD("viewport_get_render_info", "viewport", "info"), &RenderingServer::viewport_get_render_info);
 	ClassDB::bind_method(D_METHOD("viewport_set_debug_draw", "viewport", "draw"), &RenderingServer::viewport_set_debug_draw);
 
@@ -1815,6 +2033,7 @@ void RenderingServer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("scenario_create"), &RenderingServer::scenario_create);
 	ClassDB::bind_method(D_METHOD("scenario_set_debug", "scenario", "debug_mode"), &RenderingServer::scenario_set_debug);
+	ClassDB::bind_method(D_METHOD("scenario_set_spatial_index", "scenario", "spatial_index"), &RenderingServer::scenario_set_spatial_index);
 	ClassDB::bind_method(D_METHOD("scenario_set_environment", "scenario", "environment"), &RenderingServer::scenario_set_environment);
 	ClassDB::bind_method(D_METHOD("scenario_set_fallback_environment", "scenario", "environment"), &RenderingServer::scenario_set_fallback_environment);
 
@@ -1826,6 +2045,8 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_set_scenario", "instance", "scenario"), &RenderingServer::instance_set_scenario);
 	ClassDB::bind_method(D_METHOD("instance_set_layer_mask", "instance", "mask"), &RenderingServer::instance_set_layer_mask);
 	ClassDB::bind_method(D_METHOD("instance_set_transform", "instance", "transform"), &RenderingServer::instance_set_transform);
+	ClassDB::bind_method(D_METHOD("instance_set_interpolated", "instance", "interpolated"), &RenderingServer::instance_set_interpolated);
+	ClassDB::bind_method(D_METHOD("instance_reset_physics_interpolation", "instance"), &RenderingServer::instance_reset_physics_interpolation);
 	ClassDB::bind_method(D_METHOD("instance_attach_object_instance_id", "instance", "id"), &RenderingServer::instance_attach_object_instance_id);
 	ClassDB::bind_method(D_METHOD("instance_set_blend_shape_weight", "instance", "shape", "weight"), &RenderingServer::instance_set_blend_shape_weight);
 	ClassDB::bind_method(D_METHOD("instance_set_surface_material", "instance", "surface", "material"), &RenderingServer::instance_set_surface_material);
@@ -1858,6 +2079,8 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("canvas_item_set_visible", "item", "visible"), &RenderingServer::canvas_item_set_visible);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_light_mask", "item", "mask"), &RenderingServer::canvas_item_set_light_mask);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_transform", "item", "transform"), &RenderingServer::canvas_item_set_transform);
+	ClassDB::bind_method(D_METHOD("canvas_item_set_interpolated", "item", "interpolated"), &RenderingServer::canvas_item_set_interpolated);
+	ClassDB::bind_method(D_METHOD("canvas_item_reset_physics_interpolation", "item"), &RenderingServer::canvas_item_reset_physics_interpolation);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_clip", "item", "clip"), &RenderingServer::canvas_item_set_clip);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_distance_field_mode", "item", "enabled"), &RenderingServer::canvas_item_set_distance_field_mode);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_custom_rect", "item", "use_custom_rect", "rect"), &RenderingServer::canvas_item_set_custom_rect, DEFVAL(Rect2()));
@@ -1870,6 +2093,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("canvas_item_add_circle", "item", "pos", "radius", "color"), &RenderingServer::canvas_item_add_circle);
 	ClassDB::bind_method(D_METHOD("canvas_item_add_texture_rect", "item", "rect", "texture", "tile", "modulate", "transpose", "normal_map"), &RenderingServer::canvas_item_add_texture_rect, DEFVAL(false), DEFVAL(Color(1, 1, 1)), DEFVAL(false), DEFVAL(RID()));
 	ClassDB::bind_method(D_METHOD("canvas_item_add_texture_rect_region", "item", "rect", "texture", "src_rect", "modulate", "transpose", "normal_map", "clip_uv"), &RenderingServer::canvas_item_add_texture_rect_region, DEFVAL(Color(1, 1, 1)), DEFVAL(false), DEFVAL(RID()), DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("canvas_item_add_distance_field_texture_rect_region", "item", "rect", "texture", "src_rect", "modulate"), &RenderingServer::canvas_item_add_distance_field_texture_rect_region, DEFVAL(Color(1, 1, 1)));
 	ClassDB::bind_method(D_METHOD("canvas_item_add_nine_patch", "item", "rect", "source", "texture", "topleft", "bottomright", "x_axis_mode", "y_axis_mode", "draw_center", "modulate", "normal_map"), &RenderingServer::canvas_item_add_nine_patch, DEFVAL(NINE_PATCH_STRETCH), DEFVAL(NINE_PATCH_STRETCH), DEFVAL(true), DEFVAL(Color(1, 1, 1)), DEFVAL(RID()));
 	ClassDB::bind_method(D_METHOD("canvas_item_add_primitive", "item", "points", "colors", "uvs", "texture", "width", "normal_map"), &RenderingServer::canvas_item_add_primitive, DEFVAL(1.0), DEFVAL(RID()));
 	ClassDB::bind_method(D_METHOD("canvas_item_add_polygon", "item", "points", "colors", "uvs", "texture", "normal_map", "antialiased"), &RenderingServer::canvas_item_add_polygon, DEFVAL(Vector<Point2>()), DEFVAL(RID()), DEFVAL(RID()), DEFVAL(false));
@@ -1933,6 +2157,12 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_render_info", "info"), &RenderingServer::get_render_info);
 	ClassDB::bind_method(D_METHOD("get_video_adapter_name"), &RenderingServer::get_video_adapter_name);
 	ClassDB::bind_method(D_METHOD("get_video_adapter_vendor"), &RenderingServer::get_video_adapter_vendor);
+
+	ClassDB::bind_method(D_METHOD("set_frame_profiling_enabled", "enable"), &RenderingServer::set_frame_profiling_enabled);
+	ClassDB::bind_method(D_METHOD("get_frame_profile_frame"), &RenderingServer::get_frame_profile_frame);
+	ClassDB::bind_method(D_METHOD("get_frame_profile_times"), &RenderingServer::_get_frame_profile_times_bind);
+	ClassDB::bind_method(D_METHOD("get_frame_profile_area_gpu_msec", "area"), &RenderingServer::get_frame_profile_area_gpu_msec);
+	ClassDB::bind_method(D_METHOD("get_frame_profile_area_cpu_msec", "area"), &RenderingServer::get_frame_profile_area_cpu_msec);
 #ifndef _3D_DISABLED
 
 	ClassDB::bind_method(D_METHOD("make_sphere_mesh", "latitudes", "longitudes", "radius"), &RenderingServer::make_sphere_mesh);
@@ -1996,6 +2226,7 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(ARRAY_FORMAT_WEIGHTS);
 	BIND_ENUM_CONSTANT(ARRAY_FORMAT_INDEX);
 
+	BIND_ENUM_CONSTANT(ARRAY_COMPRESS_VERTEX);
 	BIND_ENUM_CONSTANT(ARRAY_COMPRESS_NORMAL);
 	BIND_ENUM_CONSTANT(ARRAY_COMPRESS_TANGENT);
 	BIND_ENUM_CONSTANT(ARRAY_COMPRESS_COLOR);
@@ -2004,6 +2235,7 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(ARRAY_COMPRESS_INDEX);
 	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_2D_VERTICES);
 	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_DYNAMIC_UPDATE);
+	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_OCTAHEDRAL_COMPRESSION);
 	BIND_ENUM_CONSTANT(ARRAY_COMPRESS_DEFAULT);
 
 	BIND_ENUM_CONSTANT(PRIMITIVE_POINTS);
@@ -2098,6 +2330,7 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(VIEWPORT_DEBUG_DRAW_SCENE_LUMINANCE);
 	BIND_ENUM_CONSTANT(VIEWPORT_DEBUG_DRAW_SSAO);
 	BIND_ENUM_CONSTANT(VIEWPORT_DEBUG_DRAW_ROUGHNESS_LIMITER);
+	BIND_ENUM_CONSTANT(VIEWPORT_DEBUG_DRAW_OCCLUSION_BUFFER);
 
 	BIND_ENUM_CONSTANT(SKY_MODE_QUALITY);
 	BIND_ENUM_CONSTANT(SKY_MODE_REALTIME);
@@ -2154,6 +2387,10 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(SCENARIO_DEBUG_OVERDRAW);
 	BIND_ENUM_CONSTANT(SCENARIO_DEBUG_SHADELESS);
 
+	BIND_ENUM_CONSTANT(SCENARIO_SPATIAL_INDEX_OCTREE);
+	BIND_ENUM_CONSTANT(SCENARIO_SPATIAL_INDEX_BVH);
+	BIND_ENUM_CONSTANT(SCENARIO_SPATIAL_INDEX_MAX);
+
 	BIND_ENUM_CONSTANT(INSTANCE_NONE);
 	BIND_ENUM_CONSTANT(INSTANCE_MESH);
 	BIND_ENUM_CONSTANT(INSTANCE_MULTIMESH);
@@ -2169,6 +2406,7 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INSTANCE_FLAG_USE_BAKED_LIGHT);
 	BIND_ENUM_CONSTANT(INSTANCE_FLAG_USE_DYNAMIC_GI);
 	BIND_ENUM_CONSTANT(INSTANCE_FLAG_DRAW_NEXT_FRAME_IF_VISIBLE);
+	BIND_ENUM_CONSTANT(INSTANCE_FLAG_IGNORE_OCCLUSION_CULLING);
 	BIND_ENUM_CONSTANT(INSTANCE_FLAG_MAX);
 
 	BIND_ENUM_CONSTANT(SHADOW_CASTING_SETTING_OFF);
@@ -2219,6 +2457,19 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_VIDEO_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_TEXTURE_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_VERTEX_MEM_USED);
+	BIND_ENUM_CONSTANT(INFO_TEXTURE_STREAMING_MEM_USED);
+	BIND_ENUM_CONSTANT(INFO_TEXTURE_STREAMING_TEXTURE_COUNT);
+	BIND_ENUM_CONSTANT(INFO_TEXTURE_STREAMING_PENDING_REQUESTS);
+	BIND_ENUM_CONSTANT(INFO_2D_DRAW_CALLS_IN_FRAME);
+	BIND_ENUM_CONSTANT(INFO_2D_BATCHES_IN_FRAME);
+	BIND_ENUM_CONSTANT(INFO_2D_BATCHED_RECTS_IN_FRAME);
+	BIND_ENUM_CONSTANT(INFO_2D_BATCH_BREAKS_TEXTURE);
+	BIND_ENUM_CONSTANT(INFO_2D_BATCH_BREAKS_MATERIAL);
+	BIND_ENUM_CONSTANT(INFO_2D_BATCH_BREAKS_CLIP);
+	BIND_ENUM_CONSTANT(INFO_2D_BATCH_BREAKS_LIGHTING);
+	BIND_ENUM_CONSTANT(INFO_2D_BATCH_BREAKS_STATE);
+	BIND_ENUM_CONSTANT(INFO_2D_BATCH_BREAKS_COMMAND);
+	BIND_ENUM_CONSTANT(INFO_2D_BATCH_BREAKS_BUFFER_FULL);
 
 	BIND_ENUM_CONSTANT(FEATURE_SHADERS);
 	BIND_ENUM_CONSTANT(FEATURE_MULTITHREADED);
@@ -2309,6 +2560,7 @@ RenderingServer::RenderingServer() {
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/shadow_atlas/quadrant_1_subdiv", PropertyInfo(Variant::INT, "rendering/quality/shadow_atlas/quadrant_1_subdiv", PROPERTY_HINT_ENUM, "Disabled,1 Shadow,4 Shadows,16 Shadows,64 Shadows,256 Shadows,1024 Shadows"));
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/shadow_atlas/quadrant_2_subdiv", PropertyInfo(Variant::INT, "rendering/quality/shadow_atlas/quadrant_2_subdiv", PROPERTY_HINT_ENUM, "Disabled,1 Shadow,4 Shadows,16 Shadows,64 Shadows,256 Shadows,1024 Shadows"));
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/shadow_atlas/quadrant_3_subdiv", PropertyInfo(Variant::INT, "rendering/quality/shadow_atlas/quadrant_3_subdiv", PROPERTY_HINT_ENUM, "Disabled,1 Shadow,4 Shadows,16 Shadows,64 Shadows,256 Shadows,1024 Shadows"));
+	GLOBAL_DEF("rendering/quality/shadow_atlas/cache_static_casters", true);
 
 	GLOBAL_DEF("rendering/quality/shadows/filter_mode", 1);
 	GLOBAL_DEF("rendering/quality/shadows/filter_mode.mobile", 0);
@@ -2320,6 +2572,10 @@ RenderingServer::RenderingServer() {
 	GLOBAL_DEF("rendering/quality/reflections/ggx_samples", 1024);
 	GLOBAL_DEF("rendering/quality/reflections/ggx_samples.mobile", 128);
 	GLOBAL_DEF("rendering/quality/reflections/fast_filter_high_quality", false);
+	GLOBAL_DEF("rendering/quality/reflections/sky_filter_layers_per_frame", 2);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/reflections/sky_filter_layers_per_frame", PropertyInfo(Variant::INT, "rendering/quality/reflections/sky_filter_layers_per_frame", PROPERTY_HINT_RANGE, "0,16,1"));
+	GLOBAL_DEF("rendering/quality/reflections/probe_update_steps_per_frame", 7);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/reflections/probe_update_steps_per_frame", PropertyInfo(Variant::INT, "rendering/quality/reflections/probe_update_steps_per_frame", PROPERTY_HINT_RANGE, "0,64,1"));
 	GLOBAL_DEF("rendering/quality/reflection_atlas/reflection_size", 256);
 	GLOBAL_DEF("rendering/quality/reflection_atlas/reflection_size.mobile", 128);
 	GLOBAL_DEF("rendering/quality/reflection_atlas/reflection_count", 64);
@@ -2359,6 +2615,24 @@ RenderingServer::RenderingServer() {
 	GLOBAL_DEF("rendering/quality/glow/upscale_mode", 1);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/glow/upscale_mode", PropertyInfo(Variant::INT, "rendering/quality/glow/upscale_mode", PROPERTY_HINT_ENUM, "Linear (Fast),Bicubic (Slower)"));
 	GLOBAL_DEF("rendering/quality/glow/upscale_mode.mobile", 0);
+	GLOBAL_DEF("rendering/quality/glow/use_compute", true);
+
+	GLOBAL_DEF("rendering/quality/spatial_partitioning/use_bvh", false);
+
+	GLOBAL_DEF("rendering/quality/occlusion_culling/enabled", false);
+
+	GLOBAL_DEF_RST("rendering/quality/texture_streaming/enabled", false);
+	GLOBAL_DEF("rendering/quality/texture_streaming/budget_mb", 512);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/texture_streaming/budget_mb", PropertyInfo(Variant::INT, "rendering/quality/texture_streaming/budget_mb", PROPERTY_HINT_RANGE, "16,16384,1,or_greater"));
+	GLOBAL_DEF("rendering/quality/texture_streaming/min_size", 64);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/texture_streaming/min_size", PropertyInfo(Variant::INT, "rendering/quality/texture_streaming/min_size", PROPERTY_HINT_RANGE, "1,1024,1"));
+
+	GLOBAL_DEF_RST("rendering/quality/2d/use_batching", true);
+	GLOBAL_DEF_RST("rendering/quality/2d/batching_max_rects", 65536);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/2d/batching_max_rects", PropertyInfo(Variant::INT, "rendering/quality/2d/batching_max_rects", PROPERTY_HINT_RANGE, "1024,1048576,1,or_greater"));
+	GLOBAL_DEF_RST("rendering/quality/2d/use_texture_atlas", false);
+	GLOBAL_DEF_RST("rendering/quality/2d/texture_atlas_max_pages", 4);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/2d/texture_atlas_max_pages", PropertyInfo(Variant::INT, "rendering/quality/2d/texture_atlas_max_pages", PROPERTY_HINT_RANGE, "1,64,1"));
 }
 
 RenderingServer::~RenderingServer() {
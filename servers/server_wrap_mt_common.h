@@ -40,35 +40,53 @@
 		}                                                                       \
 	}
 
-#define FUNCRID(m_type)                                                                    \
-	List<RID> m_type##_id_pool;                                                            \
-	int m_type##allocn() {                                                                 \
-		for (int i = 0; i < pool_max_size; i++) {                                          \
-			m_type##_id_pool.push_back(server_name->m_type##_create());                    \
-		}                                                                                  \
-		return 0;                                                                          \
-	}                                                                                      \
-	void m_type##_free_cached_ids() {                                                      \
-		while (m_type##_id_pool.size()) {                                                  \
-			server_name->free(m_type##_id_pool.front()->get());                            \
-			m_type##_id_pool.pop_front();                                                  \
-		}                                                                                  \
-	}                                                                                      \
-	virtual RID m_type##_create() {                                                        \
-		if (Thread::get_caller_id() != server_thread) {                                    \
-			RID rid;                                                                       \
-			MutexLock lock(alloc_mutex);                                                   \
-			if (m_type##_id_pool.size() == 0) {                                            \
-				int ret;                                                                   \
-				command_queue.push_and_ret(this, &ServerNameWrapMT::m_type##allocn, &ret); \
-				SYNC_DEBUG                                                                 \
-			}                                                                              \
-			rid = m_type##_id_pool.front()->get();                                         \
-			m_type##_id_pool.pop_front();                                                  \
-			return rid;                                                                    \
-		} else {                                                                           \
-			return server_name->m_type##_create();                                         \
-		}                                                                                  \
+#define FUNCRID(m_type)                                                                             \
+	List<RID> m_type##_id_pool;                                                                     \
+	bool m_type##_refill_pending = false;                                                           \
+	int m_type##allocn() {                                                                          \
+		List<RID> rids;                                                                             \
+		for (int i = 0; i < MAX(pool_max_size, 1); i++) {                                           \
+			rids.push_back(server_name->m_type##_create());                                         \
+		}                                                                                           \
+		MutexLock lock(alloc_mutex);                                                                \
+		for (List<RID>::Element *E = rids.front(); E; E = E->next()) {                              \
+			m_type##_id_pool.push_back(E->get());                                                   \
+		}                                                                                           \
+		m_type##_refill_pending = false;                                                            \
+		return 0;                                                                                   \
+	}                                                                                               \
+	void m_type##_free_cached_ids() {                                                               \
+		while (m_type##_id_pool.size()) {                                                           \
+			server_name->free(m_type##_id_pool.front()->get());                                     \
+			m_type##_id_pool.pop_front();                                                           \
+		}                                                                                           \
+	}                                                                                               \
+	virtual RID m_type##_create() {                                                                 \
+		if (Thread::get_caller_id() != server_thread) {                                             \
+			alloc_mutex.lock();                                                                     \
+			while (m_type##_id_pool.size() == 0) {                                                  \
+				/* the refill did not arrive in time, wait for one */                               \
+				alloc_mutex.unlock();                                                               \
+				int ret;                                                                            \
+				command_queue.push_and_ret(this, &ServerNameWrapMT::m_type##allocn, &ret);          \
+				SYNC_DEBUG                                                                          \
+				alloc_mutex.lock();                                                                 \
+			}                                                                                       \
+			RID rid = m_type##_id_pool.front()->get();                                              \
+			m_type##_id_pool.pop_front();                                                           \
+			/* refill ahead of time, without waiting for the server thread */                       \
+			bool refill = !m_type##_refill_pending && m_type##_id_pool.size() <= pool_max_size / 2; \
+			if (refill) {                                                                           \
+				m_type##_refill_pending = true;                                                     \
+			}                                                                                       \
+			alloc_mutex.unlock();                                                                   \
+			if (refill) {                                                                           \
+				command_queue.push(this, &ServerNameWrapMT::m_type##allocn);                        \
+			}                                                                                       \
+			return rid;                                                                             \
+		} else {                                                                                    \
+			return server_name->m_type##_create();                                                  \
+		}                                                                                           \
 	}
 
 #define FUNC1RID(m_type, m_arg1)                                                               \